@@ -347,3 +347,198 @@ void TFT_eSPI::setTouch(uint16_t *parameters){
   touchCalibration_invert_x = parameters[4] & 0x02;
   touchCalibration_invert_y = parameters[4] & 0x04;
 }
+
+/***************************************************************************************
+**                         Asynchronous conversion sets
+***************************************************************************************/
+// One set is a single full-duplex transaction in the XPT2046's 16-clocks-per-conversion
+// mode, as getTouchRaw() uses it: each command byte is sent while the low bits of the
+// previous result come in. Pressure (Z1, Z2), then per position four X and four Y
+// conversions of which the last is kept (the first ones settle the input), then the
+// pressure again. All commands keep the power-down mode, so PENIRQ stays enabled.
+#define TOUCH_ASYNC_CONVERSIONS (4 + 8 * TOUCH_ASYNC_SAMPLES)
+#define TOUCH_ASYNC_BYTES       (2 * TOUCH_ASYNC_CONVERSIONS + 1)
+
+#if defined (ESP32_DMA) && defined (CONFIG_IDF_TARGET_ESP32S3)
+
+static spi_device_handle_t touchHAL = nullptr;
+static spi_transaction_t touchTrans;
+DMA_ATTR static uint8_t touchTx[TOUCH_ASYNC_BYTES];
+DMA_ATTR static uint8_t touchRx[TOUCH_ASYNC_BYTES];
+static uint32_t touchDisplayClock = 0;     // SPI clock register of the display transaction
+static volatile bool touchTftSelected = false;
+
+// The panel keeps its chip select low between DMA stripes (startWrite()), so the
+// transaction callbacks release it around the conversions and put it back after.
+// They run in the SPI interrupt: direct register writes only.
+static void IRAM_ATTR touchAsyncPre(spi_transaction_t *t)
+{
+  #if defined (TFT_CS) && (TFT_CS >= 0)
+    #if (TFT_CS >= 32)
+      touchTftSelected = !(GPIO.out1.val & (1 << (TFT_CS - 32)));
+    #else
+      touchTftSelected = !(GPIO.out & (1 << TFT_CS));
+    #endif
+    CS_H;
+  #endif
+  #if (TOUCH_CS >= 32)
+    GPIO.out1_w1tc.val = (1 << (TOUCH_CS - 32));
+  #else
+    GPIO.out_w1tc = (1 << TOUCH_CS);
+  #endif
+}
+
+// Puts the bus back the way the display's register-level writes expect it: the
+// display clock and mode, and DMA stopped (see dma_end_callback()).
+static void IRAM_ATTR touchAsyncPost(spi_transaction_t *t)
+{
+  #if (TOUCH_CS >= 32)
+    GPIO.out1_w1ts.val = (1 << (TOUCH_CS - 32));
+  #else
+    GPIO.out_w1ts = (1 << TOUCH_CS);
+  #endif
+  WRITE_PERI_REG(SPI_DMA_CONF_REG(spi_host), 0);
+  WRITE_PERI_REG(SPI_CLOCK_REG(SPI_PORT), touchDisplayClock);
+  if (touchTftSelected) {
+    SET_BUS_WRITE_MODE;
+    CS_L;
+  }
+  else {
+    SET_BUS_READ_MODE;
+  }
+  *_spi_cmd = SPI_UPDATE;
+  while (*_spi_cmd & SPI_UPDATE);
+}
+
+/***************************************************************************************
+** Function name:           initTouchAsync
+** Description:             add the touch controller as a device on the DMA bus
+***************************************************************************************/
+bool TFT_eSPI::initTouchAsync(void)
+{
+  if (_touchAsync) return true;
+  if (!DMA_Enabled || TOUCH_CS < 0) return false;
+
+  // The clock the display transaction runs at, restored after each set
+  begin_tft_write();
+  touchDisplayClock = READ_PERI_REG(SPI_CLOCK_REG(SPI_PORT));
+  end_tft_write();
+
+  uint8_t cmd[TOUCH_ASYNC_CONVERSIONS];
+  uint8_t n = 0;
+  cmd[n++] = 0xb0; cmd[n++] = 0xc0;
+  for (uint8_t s = 0; s < TOUCH_ASYNC_SAMPLES; s++) {
+    for (uint8_t i = 0; i < 4; i++) cmd[n++] = 0xd0;
+    for (uint8_t i = 0; i < 4; i++) cmd[n++] = 0x90;
+  }
+  cmd[n++] = 0xb0; cmd[n++] = 0xc0;
+  memset(touchTx, 0, sizeof(touchTx));
+  for (uint8_t k = 0; k < TOUCH_ASYNC_CONVERSIONS; k++) touchTx[2 * k] = cmd[k];
+
+  spi_device_interface_config_t devcfg = {
+    .command_bits = 0,
+    .address_bits = 0,
+    .dummy_bits = 0,
+    .mode = SPI_MODE0,
+    .duty_cycle_pos = 0,
+    .cs_ena_pretrans = 0,
+    .cs_ena_posttrans = 0,
+    .clock_speed_hz = SPI_TOUCH_FREQUENCY,
+    .input_delay_ns = 0,
+    .spics_io_num = -1,         // Driven by the callbacks, shared with getTouchRaw()
+    .flags = 0,
+    .queue_size = 1,            // One set at a time
+    .pre_cb = touchAsyncPre,
+    .post_cb = touchAsyncPost
+  };
+  if (spi_bus_add_device(spi_host, &devcfg, &touchHAL) != ESP_OK) return false;
+
+  _touchAsync = true;
+  _touchAsyncPending = false;
+  _touchAsyncFresh = false;
+  return true;
+}
+
+/***************************************************************************************
+** Function name:           startTouchAsync
+** Description:             queue one conversion set, returns at once
+***************************************************************************************/
+bool TFT_eSPI::startTouchAsync(void)
+{
+  if (!_touchAsync || _touchAsyncPending) return false;
+
+  memset(&touchTrans, 0, sizeof(touchTrans));
+  touchTrans.length = TOUCH_ASYNC_BYTES * 8;
+  touchTrans.tx_buffer = touchTx;
+  touchTrans.rx_buffer = touchRx;
+  if (spi_device_queue_trans(touchHAL, &touchTrans, 0) != ESP_OK) return false;
+  _touchAsyncPending = true;
+  return true;
+}
+
+/***************************************************************************************
+** Function name:           getTouchAsync
+** Description:             collect a finished conversion set
+***************************************************************************************/
+bool TFT_eSPI::getTouchAsync(TouchRawSet *set, bool wait)
+{
+  if (!_touchAsync) return false;
+  if (wait) waitTouchAsync();
+  else touchAsyncBusy();
+  if (!_touchAsyncFresh) return false;
+  _touchAsyncFresh = false;
+
+  // Result k: 7 bits after its command byte, 5 bits in the byte sent with the next command
+  uint16_t r[TOUCH_ASYNC_CONVERSIONS];
+  for (uint8_t k = 0; k < TOUCH_ASYNC_CONVERSIONS; k++) {
+    r[k] = (touchRx[2 * k + 1] << 5) | (0x1f & (touchRx[2 * k + 2] >> 3));
+  }
+  // Pressure as getTouchRawZ()
+  int16_t z1 = 0xFFF + r[0] - r[1];
+  int16_t z2 = 0xFFF + r[TOUCH_ASYNC_CONVERSIONS - 2] - r[TOUCH_ASYNC_CONVERSIONS - 1];
+  set->z1 = (z1 == 4095 || z1 < 0) ? 0 : z1;
+  set->z2 = (z2 == 4095 || z2 < 0) ? 0 : z2;
+  for (uint8_t s = 0; s < TOUCH_ASYNC_SAMPLES; s++) {
+    set->x[s] = r[2 + 8 * s + 3];
+    set->y[s] = r[2 + 8 * s + 7];
+  }
+  return true;
+}
+
+/***************************************************************************************
+** Function name:           touchAsyncBusy
+** Description:             poll the queued conversion set
+***************************************************************************************/
+bool TFT_eSPI::touchAsyncBusy(void)
+{
+  if (!_touchAsyncPending) return false;
+  spi_transaction_t *done;
+  if (spi_device_get_trans_result(touchHAL, &done, 0) != ESP_OK) return true;
+  _touchAsyncPending = false;
+  _touchAsyncFresh = true;
+  return false;
+}
+
+/***************************************************************************************
+** Function name:           waitTouchAsync
+** Description:             wait until the queued conversion set has finished
+***************************************************************************************/
+void TFT_eSPI::waitTouchAsync(void)
+{
+  if (!_touchAsyncPending) return;
+  spi_transaction_t *done;
+  if (spi_device_get_trans_result(touchHAL, &done, portMAX_DELAY) == ESP_OK) {
+    _touchAsyncPending = false;
+    _touchAsyncFresh = true;
+  }
+}
+
+#else // Asynchronous sampling needs the ESP32-S3 DMA bus
+
+bool TFT_eSPI::initTouchAsync(void) { return false; }
+bool TFT_eSPI::startTouchAsync(void) { return false; }
+bool TFT_eSPI::getTouchAsync(TouchRawSet *set, bool wait) { return false; }
+void TFT_eSPI::waitTouchAsync(void) {}
+bool TFT_eSPI::touchAsyncBusy(void) { return false; }
+
+#endif
@@ -1,6 +1,10 @@
  // Coded by Bodmer 10/2/18, see license in root directory.
  // This is part of the TFT_eSPI class and is associated with the Touch Screen handlers
 
+#ifndef TOUCH_ASYNC_SAMPLES
+  #define TOUCH_ASYNC_SAMPLES 5 // Raw positions per asynchronous conversion set
+#endif
+
  public:
            // Get raw x,y ADC values from touch controller
   uint8_t  getTouchRaw(uint16_t *x, uint16_t *y);
@@ -22,6 +26,27 @@
            // Set the screen calibration values
   void     setTouch(uint16_t *data);
 
+           // Asynchronous sampling (ESP32-S3 with DMA): a whole set of XPT2046 conversions, pressure
+           // before and after TOUCH_ASYNC_SAMPLES raw positions, is queued as one SPI transaction on the
+           // DMA bus. It runs after the display transfer in flight without the CPU waiting for either;
+           // dmaWait() and dmaBusy() include it. Use from the task that pushes the display DMA.
+  struct TouchRawSet {
+    uint16_t z1;                          // Pressure before the positions, 0 if not touched
+    uint16_t z2;                          // Pressure after them (0 or low: finger lifting)
+    uint16_t x[TOUCH_ASYNC_SAMPLES];      // Raw positions, as getTouchRaw()
+    uint16_t y[TOUCH_ASYNC_SAMPLES];
+  };
+           // Attach the touch controller to the DMA bus, call after initDMA(). Returns false without DMA
+  bool     initTouchAsync(void);
+           // Queue a conversion set. Returns false if one is still in flight or async sampling is off
+  bool     startTouchAsync(void);
+           // Copy the set that completed since the last call; with wait, block until the queued set is done.
+           // Returns false if there is no new set (the previous one remains the latest)
+  bool     getTouchAsync(TouchRawSet *set, bool wait = false);
+           // Block until no conversion set is in flight
+  void     waitTouchAsync(void);
+  bool     touchAsyncEnabled(void) { return _touchAsync; }
+
  private:
            // Legacy support only - deprecated TODO: delete
   void     spi_begin_touch();
@@ -31,6 +56,9 @@
   inline void begin_touch_read_write() __attribute__((always_inline));
   inline void end_touch_read_write()   __attribute__((always_inline));
 
+           // Collects a finished conversion set without waiting; true while one is still in flight
+  bool     touchAsyncBusy(void);
+
            // Private function to validate a touch, allow settle time and reduce spurious coordinates
   uint8_t  validTouch(uint16_t *x, uint16_t *y, uint16_t threshold = 600);
 
@@ -38,5 +66,9 @@
   uint16_t touchCalibration_x0 = 300, touchCalibration_x1 = 3600, touchCalibration_y0 = 300, touchCalibration_y1 = 3600;
   uint8_t  touchCalibration_rotate = 1, touchCalibration_invert_x = 2, touchCalibration_invert_y = 0;
 
+  bool     _touchAsync = false;        // Touch controller attached to the DMA bus
+  bool     _touchAsyncPending = false; // A conversion set is queued or running
+  bool     _touchAsyncFresh = false;   // A completed set not yet returned by getTouchAsync()
+
   uint32_t _pressTime;        // Press and hold time-out
   uint16_t _pressX, _pressY;  // For future use (last sampled calibrated coordinates)
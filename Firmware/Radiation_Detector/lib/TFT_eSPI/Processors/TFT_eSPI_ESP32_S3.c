@@ -32,6 +32,20 @@
 #ifdef ESP32_DMA
   // DMA SPA handle
   spi_device_handle_t dmaHAL;
+
+  // Queued images (pushImageDMAQueued): address window commands and pixels as one chain of
+  // transactions per slot. A transaction's user field selects DC: 0 command, 1 data, a slot
+  // pointer the pixels of that slot (data, then the completion callback runs).
+  #define DMA_TRANS_PER_IMAGE 6 // CASET, x0 x1, PASET, y0 y1, RAMWR, pixels
+  struct DmaImageSlot {
+    spi_transaction_t trans[DMA_TRANS_PER_IMAGE];
+    void (*done)(void *arg);
+    void *arg;
+  };
+  static DmaImageSlot dmaSlots[TFT_DMA_QUEUE_DEPTH];
+  static uint8_t dmaSlotNext = 0;
+  static uint8_t dmaImages = 0;  // Queued images whose pixel transaction is not collected yet
+  #define DMA_IMAGE_TRANS(t) ((uintptr_t)(t)->user > 1)
   #ifdef CONFIG_IDF_TARGET_ESP32
     #define DMA_CHANNEL 1
     #ifdef USE_HSPI_PORT
@@ -590,6 +604,9 @@ void TFT_eSPI::pushPixels(const void* data_in, uint32_t len){
 ***************************************************************************************/
 bool TFT_eSPI::dmaBusy(void)
 {
+#if defined (TOUCH_CS)
+  if (touchAsyncBusy()) return true; // A queued touch conversion set also occupies the bus
+#endif
   if (!DMA_Enabled || !spiBusyCheck) return false;
 
   spi_transaction_t *rtrans;
@@ -598,7 +615,9 @@ bool TFT_eSPI::dmaBusy(void)
   for (int i = 0; i < checks; ++i)
   {
     ret = spi_device_get_trans_result(dmaHAL, &rtrans, 0);
-    if (ret == ESP_OK) spiBusyCheck--;
+    if (ret != ESP_OK) break; // Results come back in order, the rest are still queued
+    spiBusyCheck--;
+    if (DMA_IMAGE_TRANS(rtrans)) dmaImages--;
   }
 
   //Serial.print("spiBusyCheck=");Serial.println(spiBusyCheck);
@@ -613,6 +632,9 @@ bool TFT_eSPI::dmaBusy(void)
 ***************************************************************************************/
 void TFT_eSPI::dmaWait(void)
 {
+#if defined (TOUCH_CS)
+  waitTouchAsync(); // Register-level writes must not start under a touch conversion set
+#endif
   if (!DMA_Enabled || !spiBusyCheck) return;
   spi_transaction_t *rtrans;
   esp_err_t ret;
@@ -622,6 +644,126 @@ void TFT_eSPI::dmaWait(void)
     assert(ret == ESP_OK);
   }
   spiBusyCheck = 0;
+  dmaImages = 0;
+}
+
+
+/***************************************************************************************
+** Function name:           dmaQueued
+** Description:             Number of queued images still in flight
+***************************************************************************************/
+uint8_t TFT_eSPI::dmaQueued(void)
+{
+  if (dmaImages) dmaBusy(); // Collect the finished ones
+  return dmaImages;
+}
+
+
+/***************************************************************************************
+** Function name:           dmaWaitQueued
+** Description:             Wait until no more than "images" queued images are in flight
+***************************************************************************************/
+void TFT_eSPI::dmaWaitQueued(uint8_t images)
+{
+  spi_transaction_t *rtrans;
+  while (dmaImages > images && spiBusyCheck)
+  {
+    if (spi_device_get_trans_result(dmaHAL, &rtrans, portMAX_DELAY) != ESP_OK) break;
+    spiBusyCheck--;
+    if (DMA_IMAGE_TRANS(rtrans)) dmaImages--;
+  }
+}
+
+
+/***************************************************************************************
+** Function name:           pushImageDMAQueued
+** Description:             Queue address window and pixels, returns without waiting
+***************************************************************************************/
+// Fixed const data assumed, will NOT clip or swap bytes. w*h must be less than 32768.
+bool TFT_eSPI::pushImageDMAQueued(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t const* image,
+                                  void (*done)(void *arg), void *arg)
+{
+  if ((w <= 0) || (h <= 0) || (!DMA_Enabled)) return false;
+  uint32_t len = w * h;
+  if (len > 0x7FFF) return false; // One DMA transaction: 64Kbytes maximum
+
+#if defined (TOUCH_CS)
+  // A touch conversion set queued now could be served between the transactions of this chain
+  // and raise the TFT chip select mid-command; once the chain is queued the driver serves this
+  // device (added to the bus first) before the touch device.
+  waitTouchAsync();
+#endif
+
+  // Reuse the oldest slot once its transactions are back; results return in queue order
+  while (spiBusyCheck > (TFT_DMA_QUEUE_DEPTH - 1) * DMA_TRANS_PER_IMAGE)
+  {
+    spi_transaction_t *rtrans;
+    if (spi_device_get_trans_result(dmaHAL, &rtrans, portMAX_DELAY) != ESP_OK) return false;
+    spiBusyCheck--;
+    if (DMA_IMAGE_TRANS(rtrans)) dmaImages--;
+  }
+
+  DmaImageSlot *slot = &dmaSlots[dmaSlotNext];
+  dmaSlotNext = (dmaSlotNext + 1) % TFT_DMA_QUEUE_DEPTH;
+  slot->done = done;
+  slot->arg = arg;
+
+  int32_t x1 = x + w - 1;
+  int32_t y1 = y + h - 1;
+#ifdef CGRAM_OFFSET
+  x += colstart; x1 += colstart;
+  y += rowstart; y1 += rowstart;
+#endif
+  // Register-level window writes would no longer match the panel's window
+  addr_row = 0xFFFF;
+  addr_col = 0xFFFF;
+
+  static const uint8_t cmds[3] = { TFT_CASET, TFT_PASET, TFT_RAMWR };
+  const int32_t from[2] = { x, y };
+  const int32_t to[2]   = { x1, y1 };
+  memset(slot->trans, 0, sizeof(slot->trans));
+  for (uint8_t c = 0; c < 3; c++) {
+    spi_transaction_t *t = &slot->trans[2 * c];
+    t->flags = SPI_TRANS_USE_TXDATA;
+    t->length = 8;
+    t->tx_data[0] = cmds[c];
+    t->user = (void *)0;
+    if (c == 2) break;
+    t++;
+    t->flags = SPI_TRANS_USE_TXDATA;
+    t->length = 32;
+    t->tx_data[0] = from[c] >> 8; t->tx_data[1] = from[c];
+    t->tx_data[2] = to[c] >> 8;   t->tx_data[3] = to[c];
+    t->user = (void *)1;
+  }
+  spi_transaction_t *pixels = &slot->trans[DMA_TRANS_PER_IMAGE - 1];
+  pixels->tx_buffer = image;
+  pixels->length = len * 16;
+  pixels->user = (void *)slot;
+
+  for (uint8_t i = 0; i < DMA_TRANS_PER_IMAGE; i++) {
+    esp_err_t ret = spi_device_queue_trans(dmaHAL, &slot->trans[i], portMAX_DELAY);
+    assert(ret == ESP_OK);
+    spiBusyCheck++;
+  }
+  dmaImages++;
+  return true;
+}
+
+
+/***************************************************************************************
+** Function name:           pushImageDMAQueued
+** Description:             As above, swapping the image bytes in place if requested
+***************************************************************************************/
+bool TFT_eSPI::pushImageDMAQueued(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* image,
+                                  void (*done)(void *arg), void *arg)
+{
+  if ((w <= 0) || (h <= 0) || (!DMA_Enabled) || (w * h > 0x7FFF)) return false;
+  if (_swapBytes) {
+    uint32_t len = w * h;
+    for (uint32_t i = 0; i < len; i++) (image[i] = image[i] << 8 | image[i] >> 8);
+  }
+  return pushImageDMAQueued(x, y, w, h, (uint16_t const*)image, done, arg);
 }
 
 
@@ -807,7 +949,7 @@ void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t
 // The DMA functions here work with SPI only (not parallel)
 /***************************************************************************************
 ** Function name:           dc_callback
-** Description:             Toggles DC line during transaction (not used)
+** Description:             Sets the DC line before each transaction (0 command, else data)
 ***************************************************************************************/
 extern "C" void dc_callback();
 
@@ -826,6 +968,10 @@ extern "C" void dma_end_callback();
 void IRAM_ATTR dma_end_callback(spi_transaction_t *spi_tx)
 {
   WRITE_PERI_REG(SPI_DMA_CONF_REG(spi_host), 0);
+  if (DMA_IMAGE_TRANS(spi_tx)) {
+    DmaImageSlot *slot = (DmaImageSlot *)spi_tx->user;
+    if (slot->done) slot->done(slot->arg);
+  }
 }
 
 /***************************************************************************************
@@ -867,8 +1013,8 @@ bool TFT_eSPI::initDMA(bool ctrl_cs)
     .input_delay_ns = 0,
     .spics_io_num = pin,
     .flags = SPI_DEVICE_NO_DUMMY, //0,
-    .queue_size = 1,            // Not using queues
-    .pre_cb = 0, //dc_callback, //Callback to handle D/C line (not used)
+    .queue_size = TFT_DMA_QUEUE_DEPTH * DMA_TRANS_PER_IMAGE, // Queued images
+    .pre_cb = dc_callback,      // DC per transaction, the queued window commands need it
     .post_cb = dma_end_callback //Callback to end transmission
   };
   ret = spi_bus_initialize(spi_host, &buscfg, DMA_CHANNEL);
@@ -878,6 +1024,7 @@ bool TFT_eSPI::initDMA(bool ctrl_cs)
 
   DMA_Enabled = true;
   spiBusyCheck = 0;
+  dmaImages = 0;
   return true;
 }
 
@@ -136,6 +136,9 @@ SPI3_HOST = 2
   #define ESP32_DMA
   // Code to check if DMA is busy, used by SPI DMA + transaction + endWrite functions
   #define DMA_BUSY_CHECK  dmaWait()
+  #ifndef TFT_DMA_QUEUE_DEPTH
+    #define TFT_DMA_QUEUE_DEPTH 2 // Images in flight for pushImageDMAQueued()
+  #endif
 #else
   #define DMA_BUSY_CHECK
 #endif
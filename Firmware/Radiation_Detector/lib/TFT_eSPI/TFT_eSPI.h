@@ -795,6 +795,22 @@ class TFT_eSPI : public Print { friend class TFT_eSprite; // Sprite class has ac
   bool     dmaBusy(void); // returns true if DMA is still in progress
   void     dmaWait(void); // wait until DMA is complete
 
+#if defined (ESP32_DMA) && defined (CONFIG_IDF_TARGET_ESP32S3)
+           // Queue an image without waiting for the ones in flight: the address window commands and the
+           // pixels go to the SPI driver as one chain, so consecutive images stream back to back. Up to
+           // TFT_DMA_QUEUE_DEPTH images are in flight; the call only waits when all of them are. done(arg)
+           // runs in the SPI interrupt once the pixels of this image are sent, the image must not change
+           // before that. Const data as pushImageDMA(const), w*h below 32768. Call between startWrite()
+           // and endWrite(). Returns false if the image was not queued.
+  bool     pushImageDMAQueued(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t const* data,
+                              void (*done)(void *arg) = nullptr, void *arg = nullptr);
+           // As above, but swaps the bytes of data in place first if setSwapBytes(true) was called
+  bool     pushImageDMAQueued(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* data,
+                              void (*done)(void *arg) = nullptr, void *arg = nullptr);
+  uint8_t  dmaQueued(void);                 // Queued images still in flight
+  void     dmaWaitQueued(uint8_t images);   // Wait until no more than "images" are in flight
+#endif
+
   bool     DMA_Enabled = false;   // Flag for DMA enabled state
   uint8_t  spiBusyCheck = 0;      // Number of ESP32 transfer buffers to check
 
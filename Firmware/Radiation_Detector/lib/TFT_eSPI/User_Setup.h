@@ -206,9 +206,12 @@
 
 // ###### EDIT THE PIN NUMBERS IN THE LINES FOLLOWING TO SUIT YOUR ESP32 SETUP   ######
 
-// For ESP32 Dev board (only tested with ILI9341 display)
-// The hardware SPI can be mapped to any pins
-#define USE_HSPI_PORT
+// Radiation Detector PCB (ESP32-S3, ST7796S panel, XPT2046 touch, microSD).
+// GPIO 10-13 are the IO MUX pins of SPI2 (FSPI, the default port), so the DMA
+// driver bypasses the GPIO matrix and its extra input delay on MISO reads
+// (panel readback, SD). It was on SPI3 (USE_HSPI_PORT) before, routed through
+// the matrix.
+//#define USE_HSPI_PORT
 #define TFT_MISO 13
 #define TFT_MOSI 11
 #define TFT_SCLK 12
@@ -356,6 +359,12 @@
 // With a ST7735 display more than 27MHz may not work (spurious pixels and lines)
 // With an ILI9163 display 27 MHz works OK.
 
+// Radiation Detector PCB profile. Each clock can be overridden from the build
+// flags (e.g. -DSPI_FREQUENCY=40000000) for a board revision that does not run
+// the default. Check a board with the "display check" serial command: it
+// writes a test pattern at SPI_FREQUENCY, reads it back at SPI_READ_FREQUENCY
+// and times full frames. With a pattern mismatch, lower SPI_FREQUENCY one step
+// (80 -> 40 MHz; the ESP32 divides 80 MHz down by whole numbers).
 // #define SPI_FREQUENCY   1000000
 // #define SPI_FREQUENCY   5000000
 // #define SPI_FREQUENCY  10000000
@@ -363,13 +372,19 @@
 //#define SPI_FREQUENCY  27000000
 //#define SPI_FREQUENCY  40000000
 //#define SPI_FREQUENCY  55000000 // STM32 SPI1 only (SPI2 maximum is 27MHz)
+#ifndef SPI_FREQUENCY
 #define SPI_FREQUENCY  80000000
+#endif
 
 // Optional reduced SPI frequency for reading TFT
+#ifndef SPI_READ_FREQUENCY
 #define SPI_READ_FREQUENCY  20000000
+#endif
 
 // The XPT2046 requires a lower SPI clock rate of 2.5MHz so we define that here:
+#ifndef SPI_TOUCH_FREQUENCY
 #define SPI_TOUCH_FREQUENCY  2500000
+#endif
 
 // The ESP32 has 2 free SPI ports i.e. VSPI and HSPI, the VSPI is the default.
 // If the VSPI port is in use and pins are not accessible (e.g. TTGO T-Beam)
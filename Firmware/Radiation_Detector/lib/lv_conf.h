@@ -19,6 +19,20 @@
 
 #include <stdint.h>
 
+/*Demo builds (lvgl_demo.h): -DLVGL_DEMO=1 runs lv_demo_benchmark, 2 lv_demo_stress
+ *instead of the application UI. They switch on the demo, the log the benchmark
+ *reports through and the extra widgets the stress test creates.*/
+#if defined(LVGL_DEMO) && LVGL_DEMO == 1
+    #define LV_DEMO_BUILD_BENCHMARK 1
+#else
+    #define LV_DEMO_BUILD_BENCHMARK 0
+#endif
+#if defined(LVGL_DEMO) && LVGL_DEMO == 2
+    #define LV_DEMO_BUILD_STRESS 1
+#else
+    #define LV_DEMO_BUILD_STRESS 0
+#endif
+
 /*====================
    COLOR SETTINGS
  *====================*/
@@ -45,25 +59,54 @@
    MEMORY SETTINGS
  *=========================*/
 
-/*1: use custom malloc/free, 0: use the built-in `lv_mem_alloc()` and `lv_mem_free()`*/
-#define LV_MEM_CUSTOM 0
+/*1: use custom malloc/free, 0: use the built-in `lv_mem_alloc()` and `lv_mem_free()`
+ *The custom allocator (src/lvgl_heap.cpp) serves small blocks from internal-RAM pools and
+ *large ones from PSRAM, so the object tree is not limited by one fixed pool.*/
+#ifndef LV_MEM_CUSTOM
+    #define LV_MEM_CUSTOM 1
+#endif
 #if LV_MEM_CUSTOM == 0
+    /*LV_MEM_PSRAM 1: the pool is allocated in PSRAM, which leaves the internal RAM to the DMA draw
+     *buffers and allows larger image caches. Internal RAM is faster for the object tree, so this is
+     *off unless internal RAM runs short. Requires PSRAM: the pool allocation is not checked.*/
+    #ifndef LV_MEM_PSRAM
+        #define LV_MEM_PSRAM 0
+    #endif
+
     /*Size of the memory available for `lv_mem_alloc()` in bytes (>= 2kB)*/
-    #define LV_MEM_SIZE (48U * 1024U)          /*[bytes]*/
+    #if LV_MEM_PSRAM
+        #define LV_MEM_SIZE (128U * 1024U)         /*[bytes]*/
+    #else
+        #define LV_MEM_SIZE (48U * 1024U)          /*[bytes]*/
+    #endif
 
     /*Set an address for the memory pool instead of allocating it as a normal array. Can be in external SRAM too.*/
     #define LV_MEM_ADR 0     /*0: unused*/
     /*Instead of an address give a memory allocator that will be called to get a memory pool for LVGL. E.g. my_malloc*/
-    #if LV_MEM_ADR == 0
+    #if LV_MEM_ADR == 0 && LV_MEM_PSRAM
+        #define LV_MEM_POOL_INCLUDE "esp_heap_caps.h"
+        #define LV_MEM_POOL_ALLOC(size) heap_caps_malloc((size), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)
+    #elif LV_MEM_ADR == 0
         #undef LV_MEM_POOL_INCLUDE
         #undef LV_MEM_POOL_ALLOC
     #endif
 
 #else       /*LV_MEM_CUSTOM*/
-    #define LV_MEM_CUSTOM_INCLUDE <stdlib.h>   /*Header for the dynamic memory function*/
-    #define LV_MEM_CUSTOM_ALLOC   malloc
-    #define LV_MEM_CUSTOM_FREE    free
-    #define LV_MEM_CUSTOM_REALLOC realloc
+    /*The hooks live in the application (src/lvgl_heap.h), which is not on LVGL's include path*/
+    #define LV_MEM_CUSTOM_INCLUDE <stddef.h>   /*Header for the dynamic memory function*/
+    #define LV_MEM_CUSTOM_ALLOC   lvglHeapAlloc
+    #define LV_MEM_CUSTOM_FREE    lvglHeapFree
+    #define LV_MEM_CUSTOM_REALLOC lvglHeapRealloc
+    #include <stddef.h>
+    #ifdef __cplusplus
+    extern "C" {
+    #endif
+    void * lvglHeapAlloc(size_t size);
+    void lvglHeapFree(void * ptr);
+    void * lvglHeapRealloc(void * ptr, size_t size);
+    #ifdef __cplusplus
+    }
+    #endif
 #endif     /*LV_MEM_CUSTOM*/
 
 /*Number of the intermediate memory buffer used during rendering and other internal processing mechanisms.
@@ -144,7 +187,10 @@
  *With complex image decoders (e.g. PNG or JPG) caching can save the continuous open/decode of images.
  *However the opened images might consume additional RAM.
  *0: to disable caching*/
-#define LV_IMG_CACHE_DEF_SIZE 0
+/*The SquareLine assets are 8 true-colour C arrays, so an entry costs a decoder descriptor, not pixels.
+ *One entry per asset keeps the navigation icons (shared by every screen) and the large splash and
+ *selection images open across screen switches. "imgcache" reports the hit rate.*/
+#define LV_IMG_CACHE_DEF_SIZE 8
 
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
@@ -155,6 +201,7 @@
  *LV_GRAD_CACHE_DEF_SIZE sets the size of this cache in bytes.
  *If the cache is too small the map will be allocated only while it's required for the drawing.
  *0 mean no caching.*/
+/*No style in the SquareLine project uses a gradient; enable this if one is added.*/
 #define LV_GRAD_CACHE_DEF_SIZE 0
 
 /*Allow dithering the gradients (to achieve visual smooth color gradients on limited color depth display)
@@ -229,8 +276,8 @@
  * Logging
  *-----------*/
 
-/*Enable the log module*/
-#define LV_USE_LOG 0
+/*Enable the log module (the benchmark build reports its results through it)*/
+#define LV_USE_LOG LV_DEMO_BUILD_BENCHMARK
 #if LV_USE_LOG
 
     /*How important log should be added:
@@ -407,7 +454,7 @@
 #define LV_FONT_FMT_TXT_LARGE 0
 
 /*Enables/disables support for compressed fonts.*/
-#define LV_USE_FONT_COMPRESSED 0
+#define LV_USE_FONT_COMPRESSED 1
 
 /*Enable subpixel rendering*/
 #define LV_USE_FONT_SUBPX 0
@@ -520,7 +567,7 @@
  *----------*/
 #define LV_USE_ANIMIMG    1
 
-#define LV_USE_CALENDAR   0
+#define LV_USE_CALENDAR   LV_DEMO_BUILD_STRESS
 #if LV_USE_CALENDAR
     #define LV_CALENDAR_WEEK_STARTS_MONDAY 0
     #if LV_CALENDAR_WEEK_STARTS_MONDAY
@@ -536,7 +583,7 @@
 
 #define LV_USE_CHART      1
 
-#define LV_USE_COLORWHEEL 0
+#define LV_USE_COLORWHEEL LV_DEMO_BUILD_STRESS
 
 #define LV_USE_IMGBTN     1
 
@@ -544,13 +591,13 @@
 
 #define LV_USE_LED        1
 
-#define LV_USE_LIST       0
+#define LV_USE_LIST       LV_DEMO_BUILD_STRESS
 
 #define LV_USE_MENU       0
 
-#define LV_USE_METER      0
+#define LV_USE_METER      LV_DEMO_BUILD_STRESS
 
-#define LV_USE_MSGBOX     0
+#define LV_USE_MSGBOX     LV_DEMO_BUILD_STRESS
 
 #define LV_USE_SPAN       0
 #if LV_USE_SPAN
@@ -562,11 +609,11 @@
 
 #define LV_USE_SPINNER    1
 
-#define LV_USE_TABVIEW    0
+#define LV_USE_TABVIEW    LV_DEMO_BUILD_STRESS
 
-#define LV_USE_TILEVIEW   0
+#define LV_USE_TILEVIEW   LV_DEMO_BUILD_STRESS
 
-#define LV_USE_WIN        0
+#define LV_USE_WIN        LV_DEMO_BUILD_STRESS
 
 /*-----------
  * Themes
@@ -701,8 +748,8 @@
  * Others
  *----------*/
 
-/*1: Enable API to take snapshot for object*/
-#define LV_USE_SNAPSHOT 0
+/*1: Enable API to take snapshot for object (static screen backdrops, ui_backdrop.h)*/
+#define LV_USE_SNAPSHOT 1
 
 /*1: Enable Monkey test*/
 #define LV_USE_MONKEY 0
@@ -758,14 +805,14 @@
 #define LV_USE_DEMO_KEYPAD_AND_ENCODER 0
 
 /*Benchmark your system*/
-#define LV_USE_DEMO_BENCHMARK 0
+#define LV_USE_DEMO_BENCHMARK LV_DEMO_BUILD_BENCHMARK
 #if LV_USE_DEMO_BENCHMARK
 /*Use RGB565A8 images with 16 bit color depth instead of ARGB8565*/
 #define LV_DEMO_BENCHMARK_RGB565A8 0
 #endif
 
 /*Stress test for LVGL*/
-#define LV_USE_DEMO_STRESS 0
+#define LV_USE_DEMO_STRESS LV_DEMO_BUILD_STRESS
 
 /*Music player demo*/
 #define LV_USE_DEMO_MUSIC 0
@@ -17,6 +17,7 @@
  *********************/
 #define IDLE_MEAS_PERIOD 500 /*[ms]*/
 #define DEF_PERIOD 500
+#define HEAP_MIN_CAPACITY 8
 
 /**********************
  *      TYPEDEFS
@@ -25,16 +26,29 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static bool lv_timer_exec(lv_timer_t * timer);
+static void lv_timer_exec(lv_timer_t * timer);
 static uint32_t lv_timer_time_remaining(lv_timer_t * timer);
+static bool heap_before(const lv_timer_t * a, const lv_timer_t * b);
+static void heap_sift_up(uint32_t i);
+static void heap_sift_down(uint32_t i);
+static bool heap_insert(lv_timer_t * timer);
+static void heap_remove(lv_timer_t * timer);
+static void heap_update(lv_timer_t * timer);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static bool lv_timer_run = false;
 static uint8_t idle_last = 0;
-static bool timer_deleted;
-static bool timer_created;
+static bool timer_act_deleted;
+
+/*Running timers in a binary min-heap ordered by their next run (last_run + period), ties going to
+ *the one that has not run in the current lv_timer_handler() call. Paused timers are not in it.
+ *The linked list still owns the timers and serves lv_timer_get_next().*/
+static lv_timer_t ** heap;
+static uint32_t heap_size;
+static uint32_t heap_capacity;
+static uint32_t handler_gen;
 
 /**********************
  *      MACROS
@@ -55,6 +69,9 @@ static bool timer_created;
 void _lv_timer_core_init(void)
 {
     _lv_ll_init(&LV_GC_ROOT(_lv_timer_ll), sizeof(lv_timer_t));
+    heap = NULL;
+    heap_size = 0;
+    heap_capacity = 0;
 
     /*Initially enable the lv_timer handling*/
     lv_timer_enable(true);
@@ -95,40 +112,19 @@ uint32_t LV_ATTRIBUTE_TIMER_HANDLER lv_timer_handler(void)
         }
     }
 
-    /*Run all timer from the list*/
-    lv_timer_t * next;
-    do {
-        timer_deleted             = false;
-        timer_created             = false;
-        LV_GC_ROOT(_lv_timer_act) = _lv_ll_get_head(&LV_GC_ROOT(_lv_timer_ll));
-        while(LV_GC_ROOT(_lv_timer_act)) {
-            /*The timer might be deleted if it runs only once ('repeat_count = 1')
-             *So get next element until the current is surely valid*/
-            next = _lv_ll_get_next(&LV_GC_ROOT(_lv_timer_ll), LV_GC_ROOT(_lv_timer_act));
-
-            if(lv_timer_exec(LV_GC_ROOT(_lv_timer_act))) {
-                /*If a timer was created or deleted then this or the next item might be corrupted*/
-                if(timer_created || timer_deleted) {
-                    TIMER_TRACE("Start from the first timer again because a timer was created or deleted");
-                    break;
-                }
-            }
-
-            LV_GC_ROOT(_lv_timer_act) = next; /*Load the next timer*/
-        }
-    } while(LV_GC_ROOT(_lv_timer_act));
-
-    uint32_t time_till_next = LV_NO_TIMER_READY;
-    next = _lv_ll_get_head(&LV_GC_ROOT(_lv_timer_ll));
-    while(next) {
-        if(!next->paused) {
-            uint32_t delay = lv_timer_time_remaining(next);
-            if(delay < time_till_next)
-                time_till_next = delay;
-        }
-
-        next = _lv_ll_get_next(&LV_GC_ROOT(_lv_timer_ll), next); /*Find the next timer*/
+    /*Run the due timers from the top of the heap, each at most once per call. Once the top has
+     *already run in this call, no timer that has not is due (it would be on top); a timer made
+     *ready by another one's callback after it ran waits for the next call, which is immediate.*/
+    handler_gen++;
+    while(heap_size > 0) {
+        lv_timer_t * timer = heap[0];
+        if(timer->exec_gen == handler_gen || lv_timer_time_remaining(timer) != 0) break;
+        LV_GC_ROOT(_lv_timer_act) = timer;
+        lv_timer_exec(timer);
     }
+    LV_GC_ROOT(_lv_timer_act) = NULL;
+
+    uint32_t time_till_next = heap_size > 0 ? lv_timer_time_remaining(heap[0]) : LV_NO_TIMER_READY;
 
     busy_time += lv_tick_elaps(handler_start);
     uint32_t idle_period_time = lv_tick_elaps(idle_period_start);
@@ -178,8 +174,14 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
     new_timer->paused = 0;
     new_timer->last_run = lv_tick_get();
     new_timer->user_data = user_data;
+    new_timer->exec_gen = handler_gen - 1;
+    new_timer->heap_index = LV_TIMER_NOT_SCHEDULED;
 
-    timer_created = true;
+    if(!heap_insert(new_timer)) {
+        _lv_ll_remove(&LV_GC_ROOT(_lv_timer_ll), new_timer);
+        lv_mem_free(new_timer);
+        return NULL;
+    }
 
     return new_timer;
 }
@@ -200,8 +202,9 @@ void lv_timer_set_cb(lv_timer_t * timer, lv_timer_cb_t timer_cb)
  */
 void lv_timer_del(lv_timer_t * timer)
 {
+    heap_remove(timer);
     _lv_ll_remove(&LV_GC_ROOT(_lv_timer_ll), timer);
-    timer_deleted = true;
+    if(timer == LV_GC_ROOT(_lv_timer_act)) timer_act_deleted = true;
 
     lv_mem_free(timer);
 }
@@ -213,11 +216,14 @@ void lv_timer_del(lv_timer_t * timer)
 void lv_timer_pause(lv_timer_t * timer)
 {
     timer->paused = true;
+    heap_remove(timer);
 }
 
 void lv_timer_resume(lv_timer_t * timer)
 {
-    timer->paused = false;
+    if(!timer->paused) return;
+    /*Without room in the heap it stays paused rather than never running silently*/
+    if(heap_insert(timer)) timer->paused = false;
 }
 
 /**
@@ -228,6 +234,7 @@ void lv_timer_resume(lv_timer_t * timer)
 void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 {
     timer->period = period;
+    heap_update(timer);
 }
 
 /**
@@ -237,6 +244,7 @@ void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 void lv_timer_ready(lv_timer_t * timer)
 {
     timer->last_run = lv_tick_get() - timer->period - 1;
+    heap_update(timer);
 }
 
 /**
@@ -257,6 +265,7 @@ void lv_timer_set_repeat_count(lv_timer_t * timer, int32_t repeat_count)
 void lv_timer_reset(lv_timer_t * timer)
 {
     timer->last_run = lv_tick_get();
+    heap_update(timer);
 }
 
 /**
@@ -293,37 +302,31 @@ lv_timer_t * lv_timer_get_next(lv_timer_t * timer)
  **********************/
 
 /**
- * Execute timer if its remaining time is zero
+ * Execute a due timer (the top of the heap) and reschedule it
  * @param timer pointer to lv_timer
- * @return true: execute, false: not executed
  */
-static bool lv_timer_exec(lv_timer_t * timer)
+static void lv_timer_exec(lv_timer_t * timer)
 {
-    if(timer->paused) return false;
-
-    bool exec = false;
-    if(lv_timer_time_remaining(timer) == 0) {
-        /* Decrement the repeat count before executing the timer_cb.
-         * If any timer is deleted `if(timer->repeat_count == 0)` is not executed below
-         * but at least the repeat count is zero and the timer can be deleted in the next round*/
-        int32_t original_repeat_count = timer->repeat_count;
-        if(timer->repeat_count > 0) timer->repeat_count--;
-        timer->last_run = lv_tick_get();
-        TIMER_TRACE("calling timer callback: %p", *((void **)&timer->timer_cb));
-        if(timer->timer_cb && original_repeat_count != 0) timer->timer_cb(timer);
-        TIMER_TRACE("timer callback %p finished", *((void **)&timer->timer_cb));
-        LV_ASSERT_MEM_INTEGRITY();
-        exec = true;
-    }
+    /* Decrement the repeat count before executing the timer_cb.
+     * If the timer is deleted `if(timer->repeat_count == 0)` is not executed below*/
+    int32_t original_repeat_count = timer->repeat_count;
+    if(timer->repeat_count > 0) timer->repeat_count--;
+    timer->last_run = lv_tick_get();
+    timer->exec_gen = handler_gen;
+    heap_update(timer); /*Before the callback, which may change the timers*/
 
-    if(timer_deleted == false) { /*The timer might be deleted by itself as well*/
+    timer_act_deleted = false;
+    TIMER_TRACE("calling timer callback: %p", *((void **)&timer->timer_cb));
+    if(timer->timer_cb && original_repeat_count != 0) timer->timer_cb(timer);
+    TIMER_TRACE("timer callback %p finished", *((void **)&timer->timer_cb));
+    LV_ASSERT_MEM_INTEGRITY();
+
+    if(timer_act_deleted == false) { /*The timer might be deleted by itself as well*/
         if(timer->repeat_count == 0) { /*The repeat count is over, delete the timer*/
             TIMER_TRACE("deleting timer with %p callback because the repeat count is over", *((void **)&timer->timer_cb));
             lv_timer_del(timer);
         }
     }
-
-    return exec;
 }
 
 /**
@@ -339,3 +342,89 @@ static uint32_t lv_timer_time_remaining(lv_timer_t * timer)
         return 0;
     return timer->period - elp;
 }
+
+/**
+ * Heap order: the earlier next run first; for equal ones the timer that ran in an earlier
+ * lv_timer_handler() call. Both compare as differences, so tick and call counters may wrap
+ * (periods up to 2^31 ms).
+ */
+static bool heap_before(const lv_timer_t * a, const lv_timer_t * b)
+{
+    int32_t diff = (int32_t)((a->last_run + a->period) - (b->last_run + b->period));
+    if(diff != 0) return diff < 0;
+    return (int32_t)(a->exec_gen - b->exec_gen) < 0;
+}
+
+static void heap_sift_up(uint32_t i)
+{
+    lv_timer_t * timer = heap[i];
+    while(i > 0) {
+        uint32_t parent = (i - 1) / 2;
+        if(!heap_before(timer, heap[parent])) break;
+        heap[i] = heap[parent];
+        heap[i]->heap_index = i;
+        i = parent;
+    }
+    heap[i] = timer;
+    timer->heap_index = i;
+}
+
+static void heap_sift_down(uint32_t i)
+{
+    lv_timer_t * timer = heap[i];
+    while(true) {
+        uint32_t child = 2 * i + 1;
+        if(child >= heap_size) break;
+        if(child + 1 < heap_size && heap_before(heap[child + 1], heap[child])) child++;
+        if(!heap_before(heap[child], timer)) break;
+        heap[i] = heap[child];
+        heap[i]->heap_index = i;
+        i = child;
+    }
+    heap[i] = timer;
+    timer->heap_index = i;
+}
+
+/**
+ * Schedule a timer that is not in the heap
+ * @return false if the heap could not grow
+ */
+static bool heap_insert(lv_timer_t * timer)
+{
+    if(timer->heap_index != LV_TIMER_NOT_SCHEDULED) return true;
+    if(heap_size == heap_capacity) {
+        uint32_t capacity = heap_capacity ? heap_capacity * 2 : HEAP_MIN_CAPACITY;
+        lv_timer_t ** grown = lv_mem_realloc(heap, capacity * sizeof(lv_timer_t *));
+        LV_ASSERT_MALLOC(grown);
+        if(grown == NULL) return false;
+        heap = grown;
+        heap_capacity = capacity;
+    }
+    heap[heap_size] = timer;
+    heap_size++;
+    heap_sift_up(heap_size - 1);
+    return true;
+}
+
+static void heap_remove(lv_timer_t * timer)
+{
+    uint32_t i = timer->heap_index;
+    if(i == LV_TIMER_NOT_SCHEDULED) return;
+    timer->heap_index = LV_TIMER_NOT_SCHEDULED;
+    heap_size--;
+    if(i == heap_size) return;
+    heap[i] = heap[heap_size];
+    heap[i]->heap_index = i;
+    heap_update(heap[i]);
+}
+
+/**
+ * Restore the heap order after the next run of a scheduled timer changed
+ */
+static void heap_update(lv_timer_t * timer)
+{
+    uint32_t i = timer->heap_index;
+    if(i == LV_TIMER_NOT_SCHEDULED) return;
+    if(i > 0 && heap_before(timer, heap[(i - 1) / 2])) heap_sift_up(i);
+    else heap_sift_down(i);
+}
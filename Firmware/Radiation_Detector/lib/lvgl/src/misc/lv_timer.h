@@ -26,6 +26,7 @@ extern "C" {
 #endif
 
 #define LV_NO_TIMER_READY 0xFFFFFFFF
+#define LV_TIMER_NOT_SCHEDULED 0xFFFFFFFF
 
 /**********************
  *      TYPEDEFS
@@ -48,6 +49,8 @@ typedef struct _lv_timer_t {
     void * user_data; /**< Custom user data*/
     int32_t repeat_count; /**< 1: One time;  -1 : infinity;  n>0: residual times*/
     uint32_t paused : 1;
+    uint32_t heap_index; /**< Position in the scheduling heap, LV_TIMER_NOT_SCHEDULED while paused*/
+    uint32_t exec_gen;   /**< lv_timer_handler() call the timer last ran in*/
 } lv_timer_t;
 
 /**********************
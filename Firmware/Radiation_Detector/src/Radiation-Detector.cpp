@@ -8,72 +8,164 @@
  * The PCNT polling is now performed every 100ms with an accumulator so that high‐frequency pulses are less likely to be missed.
  */
 
-// Debug configuration
-// Uncomment the line below to enable debug output at compile time
-#define DEBUG
-
-// Runtime debug flag - can be toggled via serial command
-bool debugEnabled = true;  // Set to true by default to see debug output immediately
-
-#ifdef DEBUG
-    #define DEBUG_TIMESTAMP() do { \
-        if (debugEnabled) { \
-            unsigned long ms = millis(); \
-            unsigned int seconds = ms / 1000; \
-            unsigned int minutes = seconds / 60; \
-            unsigned int hours = minutes / 60; \
-            unsigned int days = hours / 24; \
-            seconds %= 60; \
-            minutes %= 60; \
-            hours %= 24; \
-            char timestamp[20]; \
-            snprintf(timestamp, sizeof(timestamp), "[%d:%02d:%02d.%03d] ", \
-                    (int)days * 24 + (int)hours, (int)minutes, (int)seconds, (int)(ms % 1000)); \
-            Serial.print(timestamp); \
-        } \
-    } while(0)
-    
-    #define DEBUG_PRINT(x) do { if (debugEnabled) { DEBUG_TIMESTAMP(); Serial.print(x); } } while(0)
-    #define DEBUG_PRINTLN(x) do { if (debugEnabled) { DEBUG_TIMESTAMP(); Serial.println(x); } } while(0)
-    #define DEBUG_PRINTF(...) do { if (debugEnabled) { DEBUG_TIMESTAMP(); Serial.printf(__VA_ARGS__); } } while(0)
-#else
-    #define DEBUG_TIMESTAMP()
-    #define DEBUG_PRINT(x)
-    #define DEBUG_PRINTLN(x)
-    #define DEBUG_PRINTF(...)
-#endif
-
 /*******************************************************************************
  * Includes
  ******************************************************************************/ 
-#include <lvgl.h>
-#include <TFT_eSPI.h>
-#include "ui.h"           // Declarations for UI objects and functions
+#include "debug.h"        // DEBUG_PRINT* macros shared with the other modules
 #include <WiFi.h>
 #include <time.h>
 #include <Preferences.h>
-#include "dashboard.h"    // Function getDashboardPage()
+#include "dashboard.h"    // sendDashboardPage(): gzip dashboard served from flash
 #include <WebServer.h>
 #include <ElegantOTA.h>
-#include <ESPmDNS.h>      // Include mDNS support
-#include "driver/pcnt.h"  // ESP32 pulse counter driver
 #include <ArduinoJson.h>
 #include "radiation_data.h" // Export radiation data to other modules
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/semphr.h"
+#include "config.h"       // Build-time feature switches
+#include "pulse_capture.h" // Per-pulse timestamp capture (GPIO ISR + SPSC ring)
+#include "pulse_width.h"   // RMT pulse-width histogram and window check ("pulsewidth")
+#include "pulse_recorder.h" // Raw pulse trace recording and replay ("pulsetrace")
+#include "pulse_injector.h" // RMT pulse trains looped back to the input, counting acceptance test ("inject")
+#include "tube_health.h"    // Inter-arrival histogram, live dead time and tube failure checks ("tube", /api/tube)
+#include "anomaly_capture.h" // CUSUM rate anomaly detector with event-triggered pulse traces ("anomaly", /api/anomaly)
+#include "counter_channel.h" // One GM tube per PCNT unit, extended to 32 bits
+#include "counter_range.h" // Seamless switching to a high-range tube ("counters")
+#include "tube_profile.h"  // Parameters of the high-range tube (COUNTER2_TUBE)
+#include "dead_time.h"    // Non-paralyzable dead-time correction
+#include "rate_window.h"  // O(1) multi-window sliding sums over 1-second buckets
+#include "adaptive_rate.h" // Change-point driven adaptive integration window
+#include "ring_history.h" // Chart histories with O(1) push and max
+#include "history_store.h" // Multi-resolution (s/min/h) count history in PSRAM
+#include "history_log.h"   // Persistent per-second log on the microSD card
+#include "log_storage.h"   // The log's medium: SD, raw flash partition or LittleFS ("storagebench")
+#include "log_compaction.h" // The log folded into 1-minute and 1-hour summaries, per-resolution retention ("logcompact")
+#include "usb_drive.h"     // Read-only USB drive with the log for bulk download ("usbdrive")
+#include "spi_bus.h"       // Arbitration of the SPI bus shared by TFT, touch and SD
+#include "fixed_format.h"  // Float-to-text without printf for labels, JSON and exporters
+#include "seqlock.h"       // Wait-free snapshot publication from pulseTask to uiTask
+#include "wifi_manager.h"  // Event-driven WiFi connection with reconnect backoff
+#include "wifi_power.h"    // Modem sleep between telemetry and dashboard wake windows ("power wifi")
+#include "energy_meter.h"  // Estimated charge per subsystem ("energy", /api/sysinfo)
+#include "ble_service.h"   // GATT readout for a phone nearby: rate, counts, alarm, history ("ble")
+#include "espnow_link.h"   // ESP-NOW ring relay and hub table without an access point ("espnow", /api/nodes)
+#include "time_sync.h"     // Mesh time shared by the ESP-NOW units ("timesync")
+#include "source_locator.h" // Source position from the ring's rates on the hub ("locate", /api/source)
+#include "udp_stream.h"    // Per-second multicast records for any number of LAN listeners ("udp")
+#include "modbus_server.h" // Modbus TCP register block for SCADA masters ("modbus")
+#include "ethernet_link.h" // W5500 wired link for fixed installs; WiFi off while it is up ("eth")
+#include "live_events.h"   // Server-Sent Events push of live values to the dashboard
+#include "json_arena.h"    // Shared heap-free arena for every JsonDocument
+#include "web_arena.h"     // Per-request arena for response bodies
+#include "history_api.h"   // /api/history packed binary download
+#include "spectrum_export.h" // /api/spectrum as N42, CSV or raw counts
+#include "telemetry.h"     // Batched line-protocol uploads with an offline flash queue
+#include "gps_survey.h"    // GPS on a UART and geo-tagged survey records ("gps", "survey")
+#include "spectrum.h"      // Pulse-height histogram of the scintillation channel
+#include "spectrum_adc.h"  // ADC1 continuous-mode acquisition feeding the spectrum
+#include "sipm_gain.h"       // SiPM gain correction from temperature or a held peak ("gain")
+#include "isotope_id.h"      // Isotope alarms from template matching on the spectrum ("isotope")
+#include "spectrum_analysis.h" // Energy calibration and Cs-137 / K-40 peak fits
+#include "spectrum_session.h" // Named spectrum sessions, checkpoints and background
+#include "spectrum_dose.h" // Energy-compensated dose rate from the spectrum (G(E))
+#include "coincidence.h"   // Geiger / scintillator coincidence tagging
+#include "measurement.h"   // Hardware-independent rate, dose and chart-interval logic
+#include "rate_ewma.h"     // 10 s ... 24 h exponentially weighted rate averages
+#include "rate_prior.h"    // Last session's background as the rate prior right after boot
+#include "rate_estimator.h" // Candidate rate estimators side by side on the same buckets ("estimators")
+#include "bench.h"         // Cycle-counter benchmarks of the hot paths ("bench")
+#include "sysinfo.h"       // Task stack, CPU load and heap sampling ("perf", /api/sysinfo)
+#include "trace.h"         // Cycle-stamped event trace of the hot paths ("trace", /api/trace)
+#include "settings_store.h" // Cached settings with deferred, coalesced NVS commits
+#include "device_config.h"  // Typed configuration snapshot read by every task
+#include "dose_checkpoint.h" // Dose, counters and charts preserved across reboots
+#include "power_fail.h"      // Dose and unsynced log records flushed as the supply fails ("powerfail")
+#include "background_store.h" // Background rate saved for the next boot's rate prior
+#include "alarm_sequencer.h" // esp_timer driven buzzer patterns per alarm level
+#include "status_led.h"      // Rate and alarm coloured status LED, RMT frames from a timer ("led")
+#include "alarm_rules.h"     // Multi-level, confidence-bound alarm rules
+#include "power_profile.h"   // esp_pm frequency scaling and the power benchmark
+#include "logger_mode.h"     // Deep-sleep logging with ULP pulse counting ("logger")
+#include "campaign.h"        // Scheduled acquisition windows and upload slots ("campaign")
+#include "battery_monitor.h" // Calibrated battery divider, state of charge, runtime
+#include "ui_wake.h"        // uiTask waits for touch, data or the next LVGL deadline ("uiwake")
+#include "hv_control.h"     // Timer-paced PI regulation of the tube high voltage ("hv")
+#include "plateau_scan.h"   // AUTO plateau scan and operating point ("plateau", /api/plateau)
+#include "calibration.h"    // Reference-source calibration with precision-based stopping ("calibrate", /api/calibration)
+#include "https_service.h"  // TLS front end with session resumption and keep-alive ("tls", /api/tls)
+#include "web_rate_limit.h" // Per-client token buckets and 429 for the web API ("webrate")
+#include "config_api.h"     // Bulk provisioning: typed config at /api/config, "config set/commit"
+#include "event_journal.h"  // Alarm and reset journal in RTC memory, spilled to NVS ("events")
+#include "json_body.h"      // Raw-chunk JSON POST bodies parsed into a filtered arena document
+#include "ota_guard.h"      // Paced OTA writes, SHA-256 read-back and rollback ("ota", /api/ota)
+#include "ota_stream.h"     // Compressed / delta firmware uploads at /ota/stream
+#include "fleet_ota.h"      // Manifest-polled staged rollout with resumable downloads ("fleet")
+#include "card_update.h"    // Signed firmware image installed from the microSD card at boot ("cardupdate")
+#include "provisioning_portal.h" // First-time setup access point with a captive page ("portal")
+#include "mdns_service.h"   // Per-device mDNS name and _http._tcp service with TXT metadata
+#include "web_service.h"    // HTTP server, route registry, shared headers and the web task
+#include "metrics.h"        // Prometheus text exposition at /metrics
+#include "serial_link.h"    // Non-blocking serial input, COBS/CRC framed commands and streams
+#include "time_base.h"      // 64-bit monotonic clock and SNTP-disciplined UTC for all records ("time")
+#include "boot_report.h"    // Counting-first boot, phase timings and crash-loop safe mode ("boot")
+#include "supervisor.h"     // TWDT heartbeats, stalled-task restarts and the reset log ("supervisor")
+#include "spsc_ring.h"      // PCNT readings from the sampling task to pulseTask
+#include "latency_histogram.h" // Pulse sampling jitter and hand-over latency ("latency")
+#include "flash_stall.h"    // Time the flash cache is off for flash writes ("latency")
+#include "latency_probe.h"  // Injected pulse train to label, flush and alarm tone ("latency e2e", /api/latency)
+#include "scaler.h"         // Hardware-gated preset-time / preset-count runs ("scaler", /api/scaler)
+#include "search_mode.h"    // Hot-spot search: short-window rate to buzzer pitch ("search")
+#include "syslog_sink.h"    // Debug output batched to a remote syslog collector
+#include "job_wheel.h"      // Periodic background jobs on one task ("jobs")
+#include "command_bus.h"    // Typed commands to the task that owns the state they change
+
+// The panel and its UI, compiled out of the headless logger build (HEADLESS)
+#if !HEADLESS
+#include <lvgl.h>
+#include <TFT_eSPI.h>
+#include "ui.h"           // Declarations for UI objects and functions
+#include "display_port.h"  // LVGL display + touch driver on the shared TFT_eSPI instance
+#include "label_binding.h" // Redraw labels only when the displayed value changes
+#include "source_map_view.h" // Map of the source estimate over ui_Chart1
+#include "screen_mirror.h" // Shadow frame buffer and tile-diff stream of the panel (/screen)
+#include "survey_track_view.h" // Breadcrumb dose-rate track over ui_Chart3 ("survey track")
+#include "spectrum_view.h" // Incremental spectrum plot on ui_Chart4
+#include "spectrum_waterfall.h" // Spectrum slices over time, scrolled on ui_Chart4 ("spectrum waterfall")
+#include "timeseries_view.h" // Zoomable history plot over ui_Chart1
+#include "tube_health_view.h" // Tube diagnostics over the voltage screen
+#include "calibration_view.h" // CAL panel over the settings screen
+#include "blend_rgb565.h"   // Word-wide RGB565 fill blending for LVGL
+#include "render_split.h"   // Large blends shared with the other core (experimental)
+#include "digit_sprites.h"  // Pre-rendered glyphs of the large dose-rate readout
+#include "readout_sprite.h" // Dose readouts pushed to the panel by changed columns
+#include "display_power.h"   // Backlight dimming, screen-off and render suspension
+#include "img_cache_stats.h" // LVGL image cache hit-rate measurement ("imgcache")
+#include "asset_pack.h"     // Memory-mapped image asset partition and its LVGL decoder ("assets")
+#include "ui_screens.h"     // SquareLine screens built on first use, widget pointers detached on delete
+#include "ui_style_share.h" // Local styles of the generated screens replaced by shared ones
+#include "ui_flatten.h"     // Layout-only containers of the main and chart screens dissolved
+#include "ui_backdrop.h"    // Static layer of the main and chart screens drawn from a PSRAM image
+#include "lvgl_demo.h"      // LVGL benchmark / stress demo builds (LVGL_DEMO)
+#include "event_journal_view.h" // Event list and alarm ACK on the settings screen
+#include "wifi_scan_view.h" // Scanned network list on the settings screen
+#include "search_view.h"    // Full-screen search readout over the main screen
+#include "ui_async.h"       // Widget requests from other tasks, applied by uiTask ("uiwake")
+#endif
+
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include <atomic>
+
+// Runtime debug flag - can be toggled via serial command
+std::atomic<bool> debugEnabled(true);  // Set to true by default to see debug output immediately
 
 /*******************************************************************************
  * Definitions & Constants
  ******************************************************************************/ 
-static const uint16_t SCREEN_WIDTH  = 480;
-static const uint16_t SCREEN_HEIGHT = 320;
-
 static const uint8_t GEIGER_PULSE_PIN = 9;   ///< GPIO pin connected to the Geiger counter output
 static const uint8_t BUZZER_PIN       = 38;    ///< GPIO pin for LEDC buzzer output
 
-static const float CONVERSION_FACTOR = 1.0f; ///< Factor to convert CPM to µSv/h
-
 // Chart settings:
 // Chart1: 20 segments, each representing a 3-minute average (1 hour total)
 const int CHART1_SEGMENTS         = 20;
@@ -83,25 +175,25 @@ static const int CHART1_INTERVAL_SECONDS = 180; // 3 minutes = 180 s
 const int CHART3_SEGMENTS         = 24;
 static const int CHART3_INTERVAL_SECONDS = 3600; // 1 hour = 3600 s
 
-// Alarm tone parameters (in Hz and ms)
-#define ALARM_FREQ1 1000
-#define ALARM_FREQ2 1500
-#define ALARM_TONE_DURATION 200   ///< Tone duration in ms
-#define ALARM_PAUSE_DURATION 50   ///< Pause between tones in ms
+static const uint8_t BUZZER_LEDC_CHANNEL = 0; ///< LEDC channel of the alarm sequencer
+static const uint8_t BACKLIGHT_LEDC_CHANNEL = 2; ///< Channels 0/1 share a timer; 2 keeps its own frequency
+static const uint8_t HV_LEDC_CHANNEL = 4;        ///< Timer of channels 4/5 runs at the boost frequency
+static const uint8_t STATUS_LED_LEDC_CHANNEL = 6; ///< Plain status LED only; timer of channels 6/7
+static const float HV_STEP_V = 5.0f;             ///< +/- buttons on the voltage screen
 
 // PCNT parameters – note the PCNT hardware counter is 16-bit
-static const pcnt_unit_t PCNT_UNIT = PCNT_UNIT_0;
-static const int PULSE_HISTORY_SIZE = 60;   ///< 60 one-second intervals in a ring buffer
+// The main tube's counter resets to 0 and raises an event here; with
+// PULSE_EVENT_WAKE that event is also what wakes the sampling task
+static const int16_t PCNT_HIGH_LIMIT = PULSE_EVENT_WAKE ? PULSE_EVENT_COUNTS : 32767;
+static_assert(PCNT_HIGH_LIMIT > 0 && PCNT_HIGH_LIMIT <= 32767, "PCNT limit is a positive 16-bit count");
+static_assert(COUNTER_CHANNELS >= 1 && COUNTER_CHANNELS <= 2, "one main tube and at most one high-range tube");
 
-// LVGL display buffer and UI chart series
-static lv_disp_draw_buf_t draw_buf;
-static lv_color_t buf[ SCREEN_WIDTH * SCREEN_HEIGHT / 10 ];
 
-// Ring buffers for chart data
-float chart1Buffer[CHART1_SEGMENTS] = {0.0f}; ///< 3‑minute averages for Chart1
-float chart3Buffer[CHART3_SEGMENTS] = {0.0f}; ///< 1‑hour averages for Chart3
-static int chart1Index = 0;  ///< Write index for Chart1
-static int chart3Index = 0;  ///< Write index for Chart3
+// Ring buffers for chart data (index 0 = oldest interval)
+RingHistory<float, CHART1_SEGMENTS> chart1History; ///< 3‑minute averages for Chart1
+RingHistory<float, CHART3_SEGMENTS> chart3History; ///< 1‑hour averages for Chart3
+static_assert(CHART1_SEGMENTS == DOSE_CHECKPOINT_HOURLY && CHART3_SEGMENTS == DOSE_CHECKPOINT_DAILY,
+              "dose checkpoint must hold both chart histories");
 
 // Maximum values for dynamic chart scaling
 static float chart1MaxValue = 1.0f; ///< Maximum value for Chart1, initialized to 1.0 minimum
@@ -110,16 +202,22 @@ static float chart3MaxValue = 1.0f; ///< Maximum value for Chart3, initialized t
 // Scale factor for chart values (LVGL charts only support integers)
 static const int CHART_SCALE_FACTOR = 100; ///< Multiply µSv/h by 100 to preserve 2 decimal places
 
-// Accumulators for chart intervals
-static float chart1AccumulatedCpm = 0.0f;
-static float chart3AccumulatedCpm = 0.0f;
-static float chart1ElapsedSec     = 0.0f;
-static float chart3ElapsedSec     = 0.0f;
+// Chart intervals on UTC-aligned boundaries, summed by pulseTask from the
+// exact second counts and handed to uiTask in the pulse snapshot
+enum ChartIntervalId { CHART_INTERVAL_1H = 0, CHART_INTERVAL_24H, CHART_INTERVAL_COUNT };
+static AlignedIntervalCounter chartIntervalCounters[CHART_INTERVAL_COUNT] = {
+    AlignedIntervalCounter(CHART1_INTERVAL_SECONDS), AlignedIntervalCounter(CHART3_INTERVAL_SECONDS)};
+static AlignedInterval closedChartIntervals[CHART_INTERVAL_COUNT]; ///< pulseTask: last closed of each
+static uint32_t chartIntervalsClosed[CHART_INTERVAL_COUNT];       ///< pulseTask: closes since boot
 
+#if !HEADLESS
 static lv_chart_series_t* chart1Series = nullptr;
 static lv_chart_series_t* chart3Series = nullptr;
 
-// UI objects declared in ui.h
+// UI objects declared in ui.h. Screens other than the startup screen are built
+// on first navigation and Settings / Voltage are deleted when left
+// (ui_screens.h): every pointer below is NULL while its screen does not exist,
+// and is set by the screen's created hook rather than read once at boot.
 extern lv_obj_t* ui_CurrentRad;
 extern lv_obj_t* ui_AverageRad;
 extern lv_obj_t* ui_MaximumRad;
@@ -129,8 +227,7 @@ extern lv_obj_t* ui_Chart3;
 extern lv_obj_t* ui_CurrentAlarm;    ///< Current radiation alarm threshold label
 extern lv_obj_t* ui_CumulativeAlarm; ///< Cumulative dose alarm threshold label
 
-extern lv_obj_t* ui_Startup_screen;       ///< Startup screen (shown while connecting)
-extern lv_obj_t* ui_InitialScreen; ///< Screen shown after connection attempt
+extern lv_obj_t* ui_Chart4;
 extern lv_obj_t* ui_OnStartup;     ///< Checkbox for auto–connect on startup
 extern lv_obj_t* ui_CurrentSpinbox;    ///< Spinbox for current alarm value
 extern lv_obj_t* ui_CumulativeSpinbox;  ///< Spinbox for cumulative alarm value
@@ -139,134 +236,264 @@ extern lv_obj_t* ui_SSID;
 extern lv_obj_t* ui_PASSWORD;
 extern lv_obj_t* ui_WIFIINFO;
 extern lv_obj_t* ui_Connect;
+extern lv_obj_t* ui_Keyboard;
+#endif
+
+// Radiation measurement variables (uiTask only; other tasks read getDoseSnapshot())
+static float currentuSvHr      = 0.0f; ///< Instantaneous dose rate (µSv/h)
+static float averageuSvHr      = 0.0f; ///< Average dose rate (µSv/h)
+static float maxuSvHr          = 0.0f; ///< Maximum dose rate (µSv/h)
+static float cumulativemSv     = 0.0f; ///< Cumulative dose (mSv), read from the dose accumulator
 
-// Radiation measurement variables
-float currentuSvHr      = 0.0f; ///< Instantaneous dose rate (µSv/h)
-float averageuSvHr      = 0.0f; ///< Average dose rate (µSv/h)
-float maxuSvHr          = 0.0f; ///< Maximum dose rate (µSv/h)
-float cumulativemSv     = 0.0f; ///< Cumulative dose (mSv)
+static float rawCpm            = 0.0f; ///< CPM as counted (before dead-time correction)
+static float correctedCpm      = 0.0f; ///< CPM after non-paralyzable dead-time correction
+static PrecisionMeasurement precisionRun; ///< Run started with "measure"
+static SeqLock<DoseSnapshot> doseSnapshotLock; ///< The values above, published by uiTask
+static TelemetryPerf lastPerf = {};   ///< Performance block queued last (reportPerformance)
+static uint32_t lastPerfMs = 0;
 
 unsigned long totalCounts = 0;   ///< Total pulse count (software accumulation)
 unsigned long startTime   = 0;     ///< Measurement start time (ms)
 unsigned long lastLoop    = 0;     ///< Last loop time (ms)
 
-// For pulse history: we store the number of pulses counted in each 1-second interval
-static int pulseHistory[PULSE_HISTORY_SIZE] = {0};
-static int pulseHistoryIndex                = 0;
-// PCNT hardware returns a 16-bit value
-static int16_t lastPCNTCount16 = 0; 
-// We now poll the PCNT counter every 100ms
-static unsigned long lastPulsePollTime = 0;
-// And we accumulate differences over a 1-second period
-static int pulseDiffAccumulator = 0;
-static unsigned long pulseAccumulationTime = 0;
-
-// LEDC buzzer alarm variables
-bool alarmToneToggle = false;
-unsigned long lastAlarmMillis = 0;
-
-// New global flag to disable the alarm (set to disabled by default)
-bool alarmDisabled = true;
-
-// Preferences for WiFi settings
-Preferences preferences;
-static String wifi_ip = "";
-
-// OTA support
-WebServer server(80);
-bool otaInitialized = false;
-// Flag to track if user has acknowledged the OTA warning
-bool otaWarningAcknowledged = false;
-
-// Add this to the global variables section
-static const int SMOOTHING_WINDOW_SIZE = 5;  // Size of moving average window
-static float currentReadingsWindow[SMOOTHING_WINDOW_SIZE] = {0};
-static int currentReadingIndex = 0;
-
-// Battery monitoring variables
-// Disable battery monitoring since the device is USB powered
-// const int BATTERY_VOLTAGE_PIN = 34;        // ADC pin connected to the battery voltage divider
-// const float BATTERY_LOW_THRESHOLD = 3.3;   // Voltage threshold for low battery warning
-// const float BATTERY_CRITICAL_THRESHOLD = 3.0; // Voltage threshold for critical battery warning
-// const unsigned long BATTERY_CHECK_INTERVAL = 60000; // Check battery every minute (in milliseconds)
-// unsigned long lastBatteryCheckTime = 0;
-// bool batteryLowWarningDisplayed = false;
-// bool batteryCriticalWarningDisplayed = false;
-
-// Add to global declarations
-static const unsigned long DISPLAY_TIMEOUT = 300000;  // 5 minutes in milliseconds
-static unsigned long lastUserInteractionTime = 0;
-static bool isDisplayDimmed = false;
-static uint8_t normalBrightness = 128;  // Adjust this value as needed
-static uint8_t dimmedBrightness = 20;   // Adjust this value as needed
+// For pulse history: we store the number of pulses counted in each 1-second interval.
+// Running sums give the 10 s / 60 s / 300 s windows without rescanning the buckets.
+static RateWindows pulseHistory;
+// Dose-rate estimator: long window while stable, collapses on a Poisson-significant change
+static AdaptiveRateEstimator adaptiveRate;
+// Per-poll counts into 1-second buckets for both estimators above (pulseTask only)
+static PulseAccumulator pulseAccumulator(pulseHistory, adaptiveRate);
+// Cumulative dose summed from the same buckets (pulseTask only; the other
+// tasks read the copy in doseAccumulatorLock through getDoseSnapshot())
+static DoseAccumulator doseAccumulator;
+static SeqLock<DoseAccumulator> doseAccumulatorLock;
+// 10 s ... 24 h exponentially weighted rates from the same buckets (pulseTask only)
+static RateEwma rateEwma;
+// Candidate estimators compared on the same buckets (RATE_ESTIMATOR_SET; pulseTask only)
+static SlidingWindowEstimator estimatorWindow10(RATE_WINDOW_10S);
+static SlidingWindowEstimator estimatorWindow60(RATE_WINDOW_60S);
+static SlidingWindowEstimator estimatorWindow300(RATE_WINDOW_300S);
+static AdaptiveWindowEstimator estimatorAdaptive;
+static EwmaEstimator estimatorEwma(RATE_ESTIMATOR_TAU_S);
+static BayesEstimator estimatorBayes(RATE_ESTIMATOR_TAU_S, 0.0f, 0.0f);
+static KalmanEstimator estimatorKalman(RATE_ESTIMATOR_KALMAN_DRIFT);
+static RateEstimatorBank rateEstimators;
+// Long-term history: 1 s for 1 h, 1 min for 1 week, 1 h for 1 year (PSRAM)
+HistoryStore historyStore;
+// Gamma spectrum of the scintillation probe (PSRAM); pulseTask bins the
+// acquisition task's events into it after coincidence gating
+Spectrum spectrum;
+// pulseTask runs before the spectrum session is restored; binning waits for it
+static std::atomic<bool> spectrumBinning(false);
+static CoincidenceGate coincidenceGate(COINCIDENCE_WINDOW_US);
+static volatile uint8_t coincidenceMode = COINCIDENCE_MODE_DEFAULT;
+struct CoincidenceStats {
+    uint32_t events;      ///< Scintillation pulses classified
+    uint32_t coincident;  ///< ... with a Geiger pulse within the window
+    uint32_t binned;      ///< ... that passed the gate into the spectrum
+    uint32_t geiger;      ///< Geiger timestamps fed to the gate
+    uint32_t piledUp;     ///< Binned pulses flagged as pile-up ("spectrum pileup flag")
+};
+static CoincidenceStats coincidenceStats = {0, 0, 0, 0, 0};
+// Channel 0 is the main tube; channel 1 the optional high-range tube (COUNTER_CHANNELS)
+static CounterChannel counterChannels[COUNTER_CHANNELS];
+static const uint8_t HIGH_RANGE_CHANNEL = COUNTER_CHANNELS - 1; ///< Only meaningful with two channels
+static CounterRange counterRange(COUNTER_RANGE_UP, COUNTER_RANGE_DOWN); ///< pulseTask only
+static RateWindows channelWindows[COUNTER_CHANNELS]; ///< Raw counts per tube, pulseTask only
+typedef TubeParams<COUNTER2_TUBE> HighRangeTube;
+
+static char wifi_ip[16] = "";  ///< Dotted quad while connected, of whichever link is up
+
+// Flag to track if user has acknowledged the OTA warning (web task only)
+static bool otaWarningAcknowledged = false;
+
+#if !HEADLESS
+// Battery indicator on the main screen (created at runtime, not in the SquareLine project)
+static lv_obj_t* batteryLabel = NULL;
+static char batteryShown[24] = ""; ///< Shown by batteryLabel (static text), cleared when it is recreated
+
+// Scaler result on the main screen (created at runtime like the battery indicator)
+static lv_obj_t* scalerLabel = NULL;
+static char scalerShown[32] = "";  ///< Shown by scalerLabel (static text)
+#endif
+
+// Text of the WiFi info label on the settings screen, kept while that screen is deleted
+static char wifiInfoText[64] = "Disconnected";
 
 // Core-specific task handles
+TaskHandle_t pulseSampleTaskHandle = NULL;
 TaskHandle_t pulseTaskHandle = NULL;
 TaskHandle_t uiTaskHandle = NULL;
+// Set while uiTask is inside lv_timer_handler(); LVGL cannot be re-entered
+// after a task was deleted in there, so a stall then reboots instead
+static volatile bool uiInLvgl = false;
+
+// Cores and priorities are set in config.h (task topology); the web server and
+// the SD log run on the network core (web_service.h, history_log.h)
+static const uint32_t PULSE_SAMPLE_TASK_STACK = 3072;
+static const uint32_t PULSE_TASK_STACK  = 4096;
+static const uint32_t UI_TASK_STACK     = 8192;
+
+// /api/data is serialised into fixed buffers (its document into the shared
+// JSON arena) to keep long uptimes free of heap fragmentation. There is one
+// buffer per variant (JSON or MessagePack, with or without the chart arrays),
+// each kept with the ETag it was built for, so clients asking for different
+// variants in the same second do not rebuild each other's body. Allocated on
+// first use, in PSRAM when there is some. Web task only.
+static const size_t API_JSON_BUFFER_SIZE = 3072; ///< Serialised response (~1.2 KB with a measurement running)
+static const uint8_t API_BODY_VARIANTS = 4;
+
+struct ApiBodyCache {
+    char* body;
+    size_t length;
+    char tag[40];       ///< ETag of the body, empty if none
+    uint32_t builds;
+    uint32_t hits;
+};
+static ApiBodyCache apiBodies[API_BODY_VARIANTS];
+
+// Guards the chart histories, which uiTask writes and the web task serialises
+static SemaphoreHandle_t chartDataMutex = NULL;
+static uint32_t chartDataVersion = 0; ///< Bumped under chartDataMutex on every chart change
+static uint32_t chart1Version = 0;    ///< Same, hourly chart only (/api/data/hourly ETag)
+static uint32_t chart3Version = 0;    ///< Same, daily chart only (/api/data/daily ETag)
 
-// Mutex for thread-safe data access
-SemaphoreHandle_t dataMutex = NULL;
+// Pulse statistics published by pulseTask once per second. The rate state above
+// is owned by pulseTask; other tasks only read copies through the seqlock, so
+// pulse polling never waits on rendering, web requests or serial output.
+struct PulseSnapshot {
+    uint32_t totalCounts;              ///< Counts since boot
+    uint32_t lastSecondCounts;         ///< Counts in the most recent second
+    uint32_t secondsClosed;            ///< 1-second buckets closed since boot
+    float adaptiveCpm;                 ///< Raw CPM over the adaptive window
+    uint16_t adaptiveWindowSeconds;    ///< Current adaptive window length
+    uint32_t adaptiveCounts;           ///< Counts inside the adaptive window
+    uint32_t adaptiveChanges;          ///< Change points detected since boot
+    float windowCpm[RATE_WINDOW_COUNT]; ///< Raw CPM over the 10 s / 60 s / 300 s windows
+    float channelCpm[COUNTER_CHANNELS]; ///< Raw CPM of each tube over 60 s (COUNTER_CHANNELS > 1)
+    uint32_t rangeSwitches;            ///< Changes between the tubes since boot
+    bool highRange;                    ///< The counts are the high-range tube's
+    float ewmaCpm[RATE_EWMA_COUNT];    ///< Raw CPM of the exponentially weighted averages
+    float ewmaSigmaCpm[RATE_EWMA_COUNT];
+    float estimatorCps[RateEstimatorBank::MAX];           ///< Candidate estimators, in bank order
+    float estimatorSigmaCps[RateEstimatorBank::MAX];
+    RateEstimatorBank::Cost estimatorCost[RateEstimatorBank::MAX];
+    AlignedInterval chartInterval[CHART_INTERVAL_COUNT]; ///< Last closed chart interval of each chart
+    uint32_t chartIntervalsClosed[CHART_INTERVAL_COUNT]; ///< Changes when one closes
+    PulseCaptureStats capture;         ///< Timestamp capture, as of the second's close
+};
+static SeqLock<PulseSnapshot> pulseSnapshotLock;
+static PulseSnapshot pulseStats;       ///< uiTask's latest consistent copy
+static RatePrior startupPrior;         ///< Armed in setup(), then uiTask only
 
 // Ring buffer for real-time pulse data
 #define PULSE_BUFFER_SIZE 20  // 20 samples at 50ms = 1 second of data
 struct PulseData {
-    int16_t count;
+    uint32_t count;
     unsigned long timestamp;
 };
 PulseData pulseBuffer[PULSE_BUFFER_SIZE];
 int pulseBufferIndex = 0;
 
 // Function prototypes for core-specific tasks
+void pulseSampleTask(void *parameter);
 void pulseTask(void *parameter);
+static void onGeigerTimestamp(uint32_t timestampUs, void* context);
+static void binSpectrumEvents();
+static void loadCoincidenceSettings();
 void uiTask(void *parameter);
+static bool startUiTask();
+static bool restartUiTask();
 
 /*******************************************************************************
  * Function Prototypes
  ******************************************************************************/ 
 void initSerial();
+#if !HEADLESS
 void initTFT();
 void initLVGL();
+#endif
 void assignChartSeries();
 void clearCharts();
 void initPulseCounter();
-void initBuzzer();
-void playAlarmTone(uint32_t freq);
-void stopAlarmTone();
-void updatePulseHistory();
+uint32_t readPulseCount32();
 int getRealTimeCPM();
-void updateRealTimeStats(float cpm, float dtSec);
-void updateLabels();
-void accumulateCharts(float cpm, float dtSec);
+float getWindowCPM(RateWindowId window);
+static void publishPulseSnapshot(uint32_t lastSecondCounts);
+static void refreshPulseStats();
+static void powerBenchCounts(uint32_t* counts, uint32_t* seconds);
+static void prepareLoggerSleep();
+void updateRealTimeStats(float cpm, const DeviceConfig& config);
+static void publishDoseSnapshot();
+static void publishModbusRegisters(const DoseSnapshot& dose);
+static float readCumulativeMsv();
+static void printPrecisionMeasurement(Print& out, const PrecisionMeasurement& run, const DeviceConfig& config);
+static void restoreDoseCheckpoint(const DoseCheckpoint& checkpoint);
+static void collectDoseCheckpoint(DoseCheckpoint& checkpoint);
+static bool collectBackground(BackgroundRecord& record);
+void accumulateCharts(const DeviceConfig& config);
+#if !HEADLESS
+void attachLabelBindings();
+void updateLabels(const DeviceConfig& config);
+static void updateMainLabels(const DeviceConfig& config, uint32_t now);
+static void updateVoltageLabels(const DeviceConfig& config, uint32_t now);
+static void updateSpectrumAnnotation();
+static void updatePlateauView();
+static void updateOtaProgress();
 void drawChart1();
 void drawChart3();
+template <size_t N>
+static void pushChartPoint(lv_obj_t* chart, lv_chart_series_t* series, const RingHistory<float, N>& history);
 void updateChartYAxis(lv_obj_t* chart, lv_chart_series_t* series, float maxValue);
 static void chart_draw_event_cb(lv_event_t * e);
-bool connectToWiFi(const char* ssid, const char* password);
-static void connect_btn_event_cb(lv_event_t *e);
+#endif
+static void onWifiStateChanged(WifiState state);
+static void onEthLinkChanged(EthLinkState state);
+static void registerWebRoutes();
+static void printApiBodyCache(Print& out);
+static void printRateEstimators(Print& out);
+static float searchReferenceCps();
+static void readSerialStatus(SerialStatusPayload& out);
+static void readBleReadings(BleReadings& out);
+static void readEspNowReadings(EspNowReadings& out);
+static void readUdpStreamReadings(UdpStreamReadings& out);
+static void readPulseTraceState(PulseTraceHeader& header);
 void tryAutoConnect();
+static void checkAlarms(bool secondClosed);
+static void setWifiInfo(const char* text);
+#if !HEADLESS
+static void connect_btn_event_cb(lv_event_t *e);
+static void wifiNetworkSelected(const WifiNetwork& network);
 static void wifi_connect_timer_cb(lv_timer_t * timer);
 static void onstartup_checkbox_event_cb(lv_event_t * e);
 static void alarms_checkbox_event_cb(lv_event_t * e);
 static void spinbox_changed_event_cb(lv_event_t * e);
 void saveAlarmSettings();
-void loadAlarmSettings();
-void checkAlarms();
-// void checkBatteryLevel(); // Battery monitoring disabled - USB powered
+void applyConfigToWidgets();
+static void createBatteryLabel();
+static void createScalerLabel();
+static void updateScalerLabel();
+static void registerScreenHooks();
+#endif
+void checkBatteryLevel();
 // Make this static to avoid multiple definition conflicts with dashboard.cpp
 static String getRadiationDataJson();
 // Export function that can be called from other files
 String getRadiationDataJsonExport();
-void managePower();
-void restoreDisplayBrightness();
-static void touch_event_cb(lv_event_t * e);
+#if !HEADLESS
+bool managePower(const DeviceConfig& config);
 void setupPowerManagement();
+#endif
 // Function to serve the OTA warning page
 void serveOtaWarningPage();
+static void runBenchmarks();
 
 // Function to process serial commands
 void processSerialCommands() {
-    if (Serial.available()) {
-        String command = Serial.readStringUntil('\n');
+    // Lines are collected by the serial link task; nothing here waits for input
+    char line[SERIAL_LINE_MAX];
+    if (serialLinkReadLine(line)) {
+        String command = line;
         command.trim();
         
         if (command == "debug on") {
@@ -277,6 +504,1049 @@ void processSerialCommands() {
             debugEnabled = false;
             Serial.println("Debug output disabled");
         }
+        else if (command == "jobs") {
+            printJobWheel(Serial);
+        }
+        else if (command == "debug stats") {
+            printDebugLog(Serial);
+            printSyslogSink(Serial);
+        }
+        else if (command.startsWith("deadtime")) {
+            String arg = command.substring(8);
+            arg.trim();
+            if (arg.length() > 0) {
+                float tau = arg.toFloat();
+                if (tau >= 0.0f && tau < 10000.0f) {
+                    DeviceConfig config = getDeviceConfig();
+                    config.deadTimeUs = tau;
+                    setDeviceConfig(config);
+                } else {
+                    Serial.println("Dead time must be between 0 and 10000 us");
+                }
+            }
+            Serial.printf("Dead time: %.1f us\n", getDeviceConfig().deadTimeUs);
+        }
+        else if (command.startsWith("cpmfactor")) {
+            String arg = command.substring(9);
+            arg.trim();
+            if (arg.length() > 0) {
+                float factor = arg.toFloat();
+                if (factor > 0.0f) {
+                    DeviceConfig config = getDeviceConfig();
+                    config.cpmPerUsvH = factor;
+                    setDeviceConfig(config);
+                } else {
+                    Serial.println("Conversion factor must be positive (CPM per uSv/h)");
+                }
+            }
+            Serial.printf("Conversion factor: %.2f CPM per uSv/h\n", getDeviceConfig().cpmPerUsvH);
+        }
+        else if (command.startsWith("dose")) {
+            if (command == "dose save") {
+                Serial.println(doseCheckpointSave() ? "Dose checkpoint written" : "Dose checkpoint write failed");
+            }
+            DoseCheckpointStats ckpt = getDoseCheckpointStats();
+            Serial.printf("Dose checkpoint: sequence %lu, %lu written, %lu failed, restored at boot: %s\n",
+                          (unsigned long)ckpt.sequence, (unsigned long)ckpt.writes,
+                          (unsigned long)ckpt.failures, ckpt.restored ? "yes" : "no");
+            if (ckpt.lastWriteMs) {
+                Serial.printf("Last write %lu s ago, every %d s\n",
+                              (unsigned long)((millis() - ckpt.lastWriteMs) / 1000), DOSE_CHECKPOINT_INTERVAL_S);
+            }
+        }
+        else if (command.startsWith("measure")) {
+            // "measure <percent> [max seconds]" runs until the 95 % interval is
+            // +/- percent of the rate; "measure stop"; "measure" shows the run
+            String args = command.substring(7);
+            args.trim();
+            if (args == "stop") {
+                precisionRun.stop();
+            } else if (args.length() > 0) {
+                float percent = 0.0f;
+                unsigned long maxSeconds = 0;
+                if (sscanf(args.c_str(), "%f %lu", &percent, &maxSeconds) >= 1 && percent > 0.0f && percent < 100.0f) {
+                    precisionRun.start(pulseStats.totalCounts, pulseStats.secondsClosed, percent / 100.0f,
+                                       (uint32_t)maxSeconds);
+                } else {
+                    Serial.println("Usage: measure <percent> [max seconds] | measure stop");
+                }
+            }
+            publishDoseSnapshot();
+            printPrecisionMeasurement(Serial, precisionRun, getDeviceConfig());
+        }
+        else if (command.startsWith("clicks")) {
+            if (command == "clicks on" || command == "clicks off") {
+                DeviceConfig config = getDeviceConfig();
+                config.clicksEnabled = command == "clicks on";
+                setDeviceConfig(config);
+            }
+            AlarmClickStats clicks = getAlarmClickStats();
+            Serial.printf("Clicks: %s, 1 per %lu pulse(s), %lu played%s\n", getDeviceConfig().clicksEnabled ? "ON" : "OFF",
+                          (unsigned long)clicks.divider, (unsigned long)clicks.played,
+                          pulseCaptureActive() ? "" : " (pulse capture disabled)");
+        }
+#if !HEADLESS
+        else if (command.startsWith("display")) {
+            if (command == "display off") {
+                displayPowerOff();
+            } else if (command == "display on") {
+                displayPowerWake();
+            } else if (command == "display direct" || command == "display stripes") {
+                if (!displayPortSetDirect(command == "display direct")) {
+                    Serial.println("Direct mode unavailable (no PSRAM framebuffer or no DMA)");
+                }
+            } else if (command == "display bench") {
+                displayPortBenchModes(Serial, 10);
+            } else if (command == "display check") {
+                // Takes the panel for about a second; LVGL redraws the screen afterwards
+                displayPortCheck(Serial);
+                lv_obj_invalidate(lv_scr_act());
+            }
+            DisplayPowerStats display = getDisplayPowerStats();
+            Serial.printf("Display: %s (backlight %s, %s), off %lu time(s) for %lu s, %lu wake(s)\n",
+                          displayPowerStateName(display.state), display.backlightPwm ? "PWM" : "fixed",
+                          displayPortDirect() ? "direct mode" : "stripes",
+                          (unsigned long)display.offCount, (unsigned long)(display.offMs / 1000),
+                          (unsigned long)display.wakeCount);
+        }
+        else if (command.startsWith("imgcache")) {
+            // "imgcache on|off|reset|size <entries>": switch screens while on to see the misses
+            String args = command.substring(8);
+            args.trim();
+            if (args == "on") imageCacheStatsEnable(true);
+            else if (args == "off") imageCacheStatsEnable(false);
+            else if (args == "reset") imageCacheStatsReset();
+            else if (args.startsWith("size")) imageCacheSetEntries((uint16_t)args.substring(4).toInt());
+            printImageCacheStats(Serial);
+        }
+        else if (command == "assets") {
+            printAssetPack(Serial);
+        }
+#endif
+        else if (command == "uiwake") {
+            printUiWakeStats(Serial);
+#if !HEADLESS
+            printUiAsyncStats(Serial);
+#endif
+        }
+        else if (command.startsWith("hv")) {
+            // "hv on|off|reset|target <V>"; the target is stored in the configuration
+            String args = command.substring(2);
+            args.trim();
+            if (args == "on" || args == "off") hvSetEnabled(args == "on");
+            else if (args == "reset") hvReset();
+            else if (args.startsWith("target")) {
+                DeviceConfig config = getDeviceConfig();
+                config.hvTargetV = args.substring(6).toFloat();
+                setDeviceConfig(config);
+            }
+            printHvStatus(Serial);
+        }
+        else if (command == "ota") {
+            printOtaStatus(Serial);
+        }
+        else if (command == "portal") {
+            printProvisioningPortal(Serial);
+        }
+        else if (command == "portal open") {
+            Serial.println(provisioningPortalStart() ? "Setup portal opening" : "Setup portal not opened");
+        }
+        else if (command == "portal stop") {
+            provisioningPortalStop();
+            Serial.println("Setup portal closing");
+        }
+        else if (command.startsWith("cardupdate")) {
+            if (command == "cardupdate run") {
+                cardUpdateCheck(); // Restarts if it installed an image
+            }
+            printCardUpdate(Serial);
+        }
+        else if (command.startsWith("plateau")) {
+            // "plateau start|stop"; handled on the next UI pass
+            String args = command.substring(7);
+            args.trim();
+            if (args == "start") plateauScanRequestStart();
+            else if (args == "stop") plateauScanRequestStop();
+            if (args.length() > 0) Serial.printf("Plateau scan: %s queued\n", args.c_str());
+            printPlateauScan(Serial);
+        }
+        else if (command.startsWith("calibrate")) {
+            // "calibrate background|start <uSv/h>|stop"; handled on the next UI pass
+            String args = command.substring(9);
+            args.trim();
+            if (args == "background") {
+                calibrationRequestBackground();
+            } else if (args.startsWith("start")) {
+                float reference = args.substring(5).toFloat();
+                if (reference > 0.0f) calibrationRequestStart(reference);
+                else Serial.println("Usage: calibrate start <reference uSv/h>");
+            } else if (args == "stop") {
+                calibrationRequestStop();
+            } else if (args.length() > 0) {
+                Serial.println("Usage: calibrate background | start <reference uSv/h> | stop");
+            }
+            printCalibration(Serial);
+        }
+        else if (command == "tls") {
+            printHttpsService(Serial);
+        }
+        else if (command == "tls forget") {
+            httpsServiceForgetIdentity();
+            Serial.println("TLS key and certificate deleted; a new pair is created on the next boot");
+        }
+        else if (command == "webrate") {
+            printWebRateLimit(Serial);
+        }
+        else if (command == "time") {
+            printTimeBase(Serial);
+        }
+        else if (command == "wifiscan") {
+            printWifiScan(Serial);
+            wifiManagerScan();
+            Serial.println("Scan requested; \"wifiscan\" again shows the new results");
+        }
+        else if (command == "boot") {
+            printBootReport(Serial);
+            printWifiStats(Serial);
+        }
+        else if (command == "supervisor") {
+            printSupervisor(Serial);
+        }
+        else if (command == "events") {
+            printEventJournal(Serial, 16);
+        }
+        else if (command == "alarm ack") {
+            Serial.println(eventJournalAcknowledge(JOURNAL_SOURCE_SERIAL) ? "Alarm acknowledged" : "No alarm is sounding");
+        }
+        else if (command == "latency") {
+            printPulseLatency(Serial);
+        }
+        else if (command == "latency reset") {
+            Command cmd = {};
+            cmd.type = COMMAND_RESET_LATENCY;
+            Serial.println(commandPost(COMMAND_TARGET_PULSE, cmd) ? "Pulse latency statistics reset"
+                                                                  : "Command queue full, try again");
+        }
+        else if (command.startsWith("scaler")) {
+            // "scaler", "scaler time <s>", "scaler count <n> [max s]", "scaler stop"
+            String args = command.substring(6);
+            args.trim();
+            bool started = false;
+            if (args.startsWith("time ")) {
+                float seconds = args.substring(5).toFloat();
+                started = seconds > 0.0f && scalerStartTime((uint64_t)(seconds * 1e6 + 0.5));
+            } else if (args.startsWith("count ")) {
+                String rest = args.substring(6);
+                rest.trim();
+                int space = rest.indexOf(' ');
+                long counts = (space < 0 ? rest : rest.substring(0, space)).toInt();
+                float limit = space < 0 ? 0.0f : rest.substring(space + 1).toFloat();
+                started = counts > 0 && scalerStartCount((uint32_t)counts, (uint64_t)(limit * 1e6 + 0.5));
+            } else if (args == "stop") {
+                scalerStop();
+            } else if (args.length() > 0) {
+                Serial.println("Usage: scaler [time <s> | count <n> [max s] | stop]");
+            }
+            if (args.startsWith("time ") || args.startsWith("count ")) {
+                Serial.println(started ? "Scaler started, \"scaler\" shows the progress"
+                                       : "Cannot start the scaler (running, no SCALER_GATE_PIN or out of range)");
+            }
+            printScaler(Serial);
+        }
+        else if (command.startsWith("search")) {
+            // "search", "search on", "search off"
+            String args = command.substring(6);
+            args.trim();
+            if (args == "on") {
+                if (!searchModeStart(searchReferenceCps())) {
+                    Serial.println("Cannot start the search (no pulse capture)");
+                }
+#if !HEADLESS
+                else {
+                    uiScreenLoad(UI_SCREEN_MAIN); // The readout sits over the main screen
+                }
+#endif
+            } else if (args == "off") {
+                searchModeStop();
+            } else if (args.length() > 0) {
+                Serial.println("Usage: search [on | off]");
+            }
+            printSearchMode(Serial);
+        }
+        else if (command.startsWith("latency e2e")) {
+            // "latency e2e", "latency e2e bench [trials]", "latency e2e stop", "latency e2e reset"
+            String args = command.substring(11);
+            args.trim();
+            if (args.startsWith("bench")) {
+                long trials = args.length() > 5 ? args.substring(5).toInt() : 5;
+                if (latencyProbeStartBench(trials > 0 && trials < 256 ? (uint8_t)trials : 5)) {
+                    Serial.println("Latency bench started, \"latency e2e\" shows the progress");
+                } else {
+                    Serial.println("Cannot start (running, injector busy or missing, or the rate alarm is off)");
+                }
+            } else if (args == "stop") {
+                latencyProbeStopBench();
+            } else if (args == "reset") {
+                Serial.println(latencyProbeReset() ? "End-to-end latency statistics reset"
+                                                   : "A trace or the bench is running, try again");
+            } else if (args.length() > 0) {
+                Serial.println("Usage: latency e2e [bench [trials] | stop | reset]");
+            }
+            if (args.length() == 0 || args.startsWith("bench") || args == "stop") printLatencyProbe(Serial);
+        }
+        else if (command == "counters") {
+            printCounters(Serial);
+        }
+        else if (command == "pulsewidth") {
+            printPulseWidth(Serial);
+        }
+        else if (command == "pulsewidth reset") {
+            Command cmd = {};
+            cmd.type = COMMAND_RESET_PULSE_WIDTH;
+            Serial.println(commandPost(COMMAND_TARGET_PULSE, cmd) ? "Pulse width statistics reset"
+                                                                  : "Command queue full, try again");
+        }
+        else if (command == "tube") {
+            printTubeHealth(Serial);
+        }
+        else if (command == "tube reset") {
+            Serial.println(tubeHealthRequestReset() ? "Tube health statistics reset" : "Command queue full, try again");
+        }
+        else if (command == "led") {
+            printStatusLed(Serial);
+        }
+        else if (command.startsWith("led brightness ")) {
+            int value = command.substring(15).toInt();
+            statusLedSetBrightness((uint8_t)constrain(value, 0, 255));
+            Serial.printf("Status LED brightness %d\n", constrain(value, 0, 255));
+        }
+        else if (command == "anomaly") {
+            printAnomaly(Serial);
+        }
+        else if (command == "anomaly arm" || command == "anomaly disarm") {
+            anomalyArm(command == "anomaly arm");
+            Serial.println(command == "anomaly arm" ? "Event capture armed" : "Event capture disarmed");
+        }
+        else if (command == "anomaly reset") {
+            Serial.println(anomalyRequestReset() ? "Anomaly detector relearning the background"
+                                                 : "Command queue full, try again");
+        }
+        else if (command.startsWith("pulsetrace")) {
+            // "pulsetrace": state and files, "record <name>", "stop", "replay <name> [speed]"
+            String args = command.substring(10);
+            args.trim();
+            if (args.length() == 0) {
+                printPulseRecorder(Serial);
+            } else if (args.startsWith("record ")) {
+                String name = args.substring(7);
+                name.trim();
+                Serial.println(pulseRecorderStart(name.c_str()) ? "Pulse trace recording started"
+                                                                : "Cannot record (busy, bad name or no storage)");
+            } else if (args == "stop") {
+                pulseRecorderStop();
+                Serial.println("Pulse trace recording stopping");
+            } else if (args.startsWith("replay ")) {
+                String rest = args.substring(7);
+                rest.trim();
+                int space = rest.indexOf(' ');
+                String name = space < 0 ? rest : rest.substring(0, space);
+                float speed = space < 0 ? 0.0f : rest.substring(space + 1).toFloat();
+                Serial.println(pulseReplayStart(name.c_str(), speed) ? "Pulse trace replay started"
+                                                                     : "Cannot replay (busy, bad name or no storage)");
+            } else {
+                Serial.println("Usage: pulsetrace [record <name> | stop | replay <name> [speed]]");
+            }
+        }
+        else if (command == "battery") {
+            printBatteryStatus(Serial);
+        }
+#if !HEADLESS
+        else if (command == "screens") {
+            printUiScreens(Serial);
+        }
+        else if (command.startsWith("screens styles")) {
+            // "screens styles on|off" rebuilds the active screen with or without
+            // shared styles before the redraw is timed
+            String args = command.substring(14);
+            args.trim();
+            if (args == "on" || args == "off") {
+                uiStyleShareSetEnabled(args == "on");
+                uiScreenRebuild(uiScreenActive());
+            }
+            uiStyleDrawBench(Serial, 10);
+            printUiScreens(Serial);
+        }
+        else if (command.startsWith("screens flat")) {
+            // "screens flat on|off": the same comparison for the flattened tree
+            String args = command.substring(12);
+            args.trim();
+            if (args == "on" || args == "off") {
+                uiFlattenSetEnabled(args == "on");
+                uiScreenRebuild(uiScreenActive());
+            }
+            uiStyleDrawBench(Serial, 10);
+            printUiScreens(Serial);
+        }
+        else if (command.startsWith("screens backdrop")) {
+            // "screens backdrop on|off": the same comparison with the static layer drawn live
+            String args = command.substring(16);
+            args.trim();
+            if (args == "on" || args == "off") {
+                uiBackdropSetEnabled(args == "on");
+                uiScreenRebuild(uiScreenActive());
+            }
+            uiStyleDrawBench(Serial, 10);
+            printUiScreens(Serial);
+        }
+        else if (command.startsWith("blend")) {
+            // "blend": self-test and timing, "blend on|off" switches the backend
+            String args = command.substring(5);
+            args.trim();
+            if (args == "on" || args == "off") blend565SetEnabled(args == "on");
+            else blend565SelfTest(Serial);
+            Serial.printf("RGB565 blend backend: %s\n", blend565Enabled() ? "on" : "off (LVGL scalar)");
+        }
+        else if (command.startsWith("render split")) {
+            // "render split": correctness checks and timing, "render split on|off" switches it
+            String args = command.substring(12);
+            args.trim();
+            if (args == "on" || args == "off") {
+                if (!renderSplitSetEnabled(args == "on")) Serial.println("Render split: worker could not be started");
+            } else {
+                renderSplitCheck(Serial);
+                renderSplitBench(Serial, 10);
+            }
+            RenderSplitStats split = getRenderSplitStats();
+            Serial.printf("Render split %s: %lu of %lu blends split, %lu taken back, worker %lu px in %lu us\n",
+                          split.enabled ? "on" : "off", (unsigned long)split.split, (unsigned long)split.blends,
+                          (unsigned long)split.stolen, (unsigned long)split.workerPixels,
+                          (unsigned long)split.workerUs);
+        }
+#endif
+        else if (command == "config") {
+            printDeviceConfig(Serial);
+            if (configStagedFields()) {
+                Serial.printf("%u field(s) staged; \"config commit\" applies them\n",
+                              (unsigned)__builtin_popcount(configStagedFields()));
+            }
+        }
+        else if (command.startsWith("config ")) {
+            // "config json", "config set <key> <value>", "config commit", "config discard":
+            // factory provisioning, the same fields and checks as PUT /api/config
+            String args = command.substring(7);
+            args.trim();
+            if (args == "json") {
+                Serial.println(getConfigJson());
+            } else if (args.startsWith("set ")) {
+                String rest = args.substring(4);
+                rest.trim();
+                int space = rest.indexOf(' ');
+                String key = space < 0 ? rest : rest.substring(0, space);
+                String value = space < 0 ? String("") : rest.substring(space + 1);
+                const char* error = configStage(key.c_str(), value.c_str());
+                if (error) Serial.printf("Config: %s: %s\n", key.c_str(), error);
+                else Serial.printf("Config: %s staged\n", key.c_str());
+            } else if (args == "commit") {
+                const char* error = configCommitStaged();
+                if (error) Serial.printf("Config: %s\n", error);
+                else Serial.println("Config: applied and stored");
+            } else if (args == "discard") {
+                configDiscardStaged();
+                Serial.println("Config: staged fields discarded");
+            } else {
+                Serial.println("Usage: config json | set <key> <value> | commit | discard");
+            }
+        }
+        else if (command == "history") {
+            Serial.printf("History store: %s\n", historyStore.ready() ? "READY" : "NOT ALLOCATED");
+            const char* levelNames[HISTORY_LEVEL_COUNT] = {"1s", "1min", "1h"};
+            for (int l = 0; l < HISTORY_LEVEL_COUNT; l++) {
+                HistoryBucket summary;
+                HistoryLevel level = (HistoryLevel)l;
+                Serial.printf("  %-4s: %u/%lu buckets", levelNames[l], (unsigned)historyStore.count(level),
+                              (unsigned long)HistoryStore::capacity(level));
+                if (historyStore.summarizeRecent(level, 1, &summary)) {
+                    Serial.printf(", last mean %.2f cps (min %lu, max %lu)", summary.meanCps(),
+                                  (unsigned long)summary.minCps, (unsigned long)summary.maxCps);
+                }
+                Serial.println();
+            }
+        }
+        else if (command == "log") {
+            HistoryLogStats log = getHistoryLogStats();
+            Serial.printf("History log: %s\n", log.mounted ? "MOUNTED" : "NOT AVAILABLE");
+            if (log.mounted) {
+                Serial.printf("  %lu records in %lu blocks, %lu dropped, %lu write errors, %lu recovered\n",
+                              (unsigned long)log.records, (unsigned long)log.blocks,
+                              (unsigned long)log.dropped, (unsigned long)log.writeErrors,
+                              (unsigned long)log.recovered);
+                Serial.printf("  %s, %lu blocks buffered, %lu chunk writes, %lu column bytes since boot\n",
+                              log.storage, (unsigned long)log.buffered,
+                              (unsigned long)log.syncs, (unsigned long)log.payloadBytes);
+                if (log.writeUs) {
+                    Serial.printf("  %.2f MB/s over %lu block bytes written and synced\n",
+                                  (double)log.writtenBytes / log.writeUs, (unsigned long)log.writtenBytes);
+                }
+            }
+        }
+        else if (command.startsWith("logger")) {
+            // "logger", "logger on [interval s]", "logger off"
+            String args = command.substring(6);
+            args.trim();
+            if (args.startsWith("on")) {
+                long seconds = args.length() > 2 ? args.substring(2).toInt() : LOGGER_INTERVAL_S;
+                Serial.println("Entering logger mode; reset the device to leave it");
+                debugLogFlush(200);
+                // Returns only if the mode cannot start
+                Serial.printf("Logger mode not started: %s\n", loggerModeEnter(seconds > 0 ? (uint32_t)seconds : 0));
+            } else if (args == "off") {
+                loggerModeExit();
+            } else if (args.length() > 0) {
+                Serial.println("Usage: logger [on [interval s]|off]");
+            }
+            printLoggerMode(Serial);
+        }
+        else if (command == "campaign" || command == "campaign on" || command == "campaign off") {
+            // Windows and slots: "config set campaign_windows ..." / "campaign_uploads ..."
+            if (command != "campaign") {
+                CampaignSchedule schedule = campaignSchedule();
+                schedule.enabled = command == "campaign on";
+                if (!campaignSetSchedule(schedule)) Serial.println("Campaign: not saved");
+            }
+            printCampaign(Serial);
+        }
+        else if (command == "logbench") {
+            historyLogBenchmark(Serial);
+        }
+        else if (command == "storagebench") {
+            logStorageBenchmark(Serial);
+        }
+        else if (command == "logcompact") {
+            printLogCompaction(Serial);
+        }
+        else if (command.startsWith("powerfail")) {
+            if (command == "powerfail test") {
+                powerFailTest(Serial);
+            }
+            printPowerFail(Serial);
+        }
+        else if (command == "logflush") {
+            flushHistoryLog();
+            Serial.println("History log flush requested");
+        }
+        else if (command == "gps") {
+            printGpsSurvey(Serial);
+        }
+        else if (command.startsWith("survey")) {
+            // "survey on|off" starts or pauses recording, "survey track [on|off]" the breadcrumb view
+            String args = command.substring(6);
+            args.trim();
+            if (args == "on" || args == "off") {
+                gpsSurveySetActive(args == "on");
+            }
+#if !HEADLESS
+            else if (args.startsWith("track")) {
+                if (args == "track on") surveyTrackViewSetShown(true);
+                else if (args == "track off") surveyTrackViewSetShown(false);
+                printSurveyTrackView(Serial);
+                return;
+            }
+#endif
+            printGpsSurvey(Serial);
+        }
+        else if (command.startsWith("usbdrive")) {
+            // "usbdrive on" presents a fresh snapshot of the log, "usbdrive off" withdraws it
+            String arg = command.substring(8);
+            arg.trim();
+            if (arg == "on" || arg == "off") {
+                if (!usbDriveShow(arg == "on")) Serial.println("USB drive: not available");
+            }
+            printUsbDrive(Serial);
+        }
+        else if (command == "logdump") {
+            size_t exported = exportHistoryLogCsv(Serial);
+            Serial.printf("# %u records\n", (unsigned)exported);
+        }
+        else if (command.startsWith("telemetry")) {
+            // "telemetry <url> [token]" sets the InfluxDB write URL, "telemetry off" clears it
+            String args = command.substring(9);
+            args.trim();
+            if (args == "off") {
+                telemetryConfigure("", "");
+            } else if (args.length() > 0) {
+                int space = args.indexOf(' ');
+                String url = space < 0 ? args : args.substring(0, space);
+                String token = space < 0 ? String("") : args.substring(space + 1);
+                token.trim();
+                telemetryConfigure(url, token);
+            }
+            TelemetryStats tel = getTelemetryStats();
+            Serial.printf("Telemetry: %s, storage %s\n", tel.configured ? "CONFIGURED" : "OFF",
+                          tel.storage ? "OK" : "UNAVAILABLE");
+            Serial.printf("  %lu queued, %lu sent, %lu dropped, %lu failures, last status %d\n",
+                          (unsigned long)tel.queued, (unsigned long)tel.sent,
+                          (unsigned long)tel.dropped, (unsigned long)tel.failures, tel.lastStatus);
+            if (lastPerfMs) {
+                Serial.printf("  last perf block %lu s ago: jitter p99 <%u us (max %u), log flush %u kB/s, "
+                              "heap %u.%u%% fragmented (min free %u KB)\n",
+                              (unsigned long)((millis() - lastPerfMs) / 1000), lastPerf.jitterP99Us,
+                              lastPerf.jitterMaxUs, lastPerf.flushKBps, lastPerf.heapFragPermille / 10,
+                              lastPerf.heapFragPermille % 10, lastPerf.heapMinFreeKb);
+                Serial.printf("  HTTP p95 <%u ms (max %u), %u log lines dropped, dead time %u.%u%%\n",
+                              lastPerf.httpP95Ms, lastPerf.httpMaxMs, lastPerf.logDropped,
+                              lastPerf.deadTimePermille / 10, lastPerf.deadTimePermille % 10);
+            }
+        }
+        else if (command.startsWith("fleet")) {
+            // "fleet <manifest url>" enables pull updates, "fleet off" disables them, "fleet check" polls now
+            String args = command.substring(5);
+            args.trim();
+            if (args == "off") {
+                fleetOtaConfigure("");
+            } else if (args == "check") {
+                fleetOtaCheckNow();
+            } else if (args.length() > 0) {
+                fleetOtaConfigure(args);
+            }
+            printFleetStatus(Serial);
+        }
+        else if (command.startsWith("session")) {
+            // "session", "session start <name>", "session stop", "session save <name>",
+            // "session background <name>|off", "session list"
+            String args = command.substring(7);
+            args.trim();
+            bool ok = true;
+            if (args.startsWith("start ")) {
+                ok = spectrumSessionStart(args.substring(6).c_str());
+            } else if (args == "stop") {
+                ok = spectrumSessionStop();
+            } else if (args.startsWith("save ")) {
+                ok = spectrumSessionSave(args.substring(5).c_str());
+            } else if (args == "background off") {
+                spectrumSessionClearBackground();
+            } else if (args.startsWith("background ")) {
+                ok = spectrumSessionLoadBackground(args.substring(11).c_str());
+            } else if (args == "list") {
+                listSpectrumSessions(Serial);
+            }
+            if (!ok) Serial.println("Session command failed (name: 1-20 of A-Z a-z 0-9 - _)");
+            SpectrumSessionInfo session = getSpectrumSessionInfo();
+            Serial.printf("Session: %s '%s'%s, %.1f s live / %lu s real, storage %s\n",
+                          session.active ? "RUNNING" : "STOPPED", session.name,
+                          session.resumed ? " (resumed)" : "", session.liveMs / 1000.0f,
+                          (unsigned long)session.realSeconds,
+                          session.storage ? (session.onSd ? "SD" : "LittleFS") : "NONE");
+            if (session.background) {
+                Serial.printf("  Background '%s', %.1f s live\n", session.backgroundName,
+                              session.backgroundLiveMs / 1000.0f);
+            }
+        }
+        else if (command.startsWith("coincidence")) {
+            // "coincidence", "coincidence off|veto|require [window_us]"
+            String args = command.substring(11);
+            args.trim();
+            int mode = -1;
+            if (args.startsWith("off")) mode = COINCIDENCE_OFF;
+            else if (args.startsWith("veto")) mode = COINCIDENCE_VETO;
+            else if (args.startsWith("require")) mode = COINCIDENCE_REQUIRE;
+            // The gate belongs to pulseTask; it takes the change on its next poll
+            uint8_t shownMode = coincidenceMode;
+            uint32_t shownWindowUs = coincidenceGate.window();
+            if (mode >= 0) {
+                int space = args.indexOf(' ');
+                long windowUs = space > 0 ? args.substring(space + 1).toInt() : 0;
+                Command cmd = {};
+                cmd.type = COMMAND_SET_COINCIDENCE;
+                cmd.arg.coincidence.mode = (uint8_t)mode;
+                cmd.arg.coincidence.windowUs = windowUs > 0 && windowUs <= 10000 ? (uint32_t)windowUs : 0;
+                if (commandPost(COMMAND_TARGET_PULSE, cmd)) {
+                    shownMode = (uint8_t)mode;
+                    if (cmd.arg.coincidence.windowUs) shownWindowUs = cmd.arg.coincidence.windowUs;
+                    Preferences prefs;
+                    prefs.begin("spectrum", false);
+                    prefs.putUChar("coinc_mode", shownMode);
+                    prefs.putUInt("coinc_us", shownWindowUs);
+                    prefs.end();
+                } else {
+                    Serial.println("Coincidence: command queue full, not changed");
+                }
+            }
+            static const char* modeNames[] = {"OFF (tag only)", "VETO", "REQUIRE"};
+            CoincidenceStats stats = coincidenceStats;
+            Serial.printf("Coincidence: %s, window %lu us\n", modeNames[shownMode], (unsigned long)shownWindowUs);
+            Serial.printf("  %lu scintillation pulses, %lu coincident, %lu binned, %lu Geiger\n",
+                          (unsigned long)stats.events, (unsigned long)stats.coincident,
+                          (unsigned long)stats.binned, (unsigned long)stats.geiger);
+            // Chance of a random Geiger pulse inside +-window of any given pulse
+            Serial.printf("  Accidental fraction at %.0f CPM: %.4f%%\n", correctedCpm,
+                          100.0f * 2.0f * shownWindowUs * 1e-6f * correctedCpm / 60.0f);
+        }
+        else if (command.startsWith("gain")) {
+            // "gain", "gain off|temp|peak|both", "gain peak <channel>" (0: calibrated line)
+            String args = command.substring(4);
+            args.trim();
+            if (args == "off") setSipmGainMode(SIPM_GAIN_OFF);
+            else if (args == "temp") setSipmGainMode(SIPM_GAIN_TEMPERATURE);
+            else if (args == "both") setSipmGainMode(SIPM_GAIN_BOTH);
+            else if (args == "peak") setSipmGainMode(SIPM_GAIN_PEAK);
+            else if (args.startsWith("peak ")) setSipmGainPeak(args.substring(5).toFloat());
+            printSipmGain(Serial);
+        }
+        else if (command.startsWith("isotope")) {
+            // "isotope", "isotope relearn"
+            if (command == "isotope relearn") isotopeIdRelearn();
+            printIsotopeId(Serial);
+        }
+        else if (command.startsWith("spectrum")) {
+            // "spectrum", "spectrum clear", "spectrum bench", "spectrum threshold <codes>",
+            // "spectrum cal <c0> <c1> [c2]", "spectrum cal auto",
+            // "spectrum dose", "spectrum dose cal", "spectrum dose model <uSv/count> <b1> <b2> [min keV]",
+            // "spectrum waterfall [on|off]", "spectrum pileup off|flag|reject",
+            // "spectrum shaping off|on|<rise us> <flat us> <decay us>"
+            String args = command.substring(8);
+            args.trim();
+#if !HEADLESS
+            if (args.startsWith("waterfall")) {
+                if (args == "waterfall on") spectrumWaterfallSetShown(true);
+                else if (args == "waterfall off") spectrumWaterfallSetShown(false);
+                printSpectrumWaterfall(Serial);
+                return;
+            }
+#endif
+            if (args.startsWith("dose")) {
+                if (args == "dose cal") {
+                    if (!spectrumDoseCalibrate()) Serial.println("Dose calibration needs 30 s of both rates (Cs-137 field)");
+                } else if (args.startsWith("dose model ")) {
+                    SpectrumDoseModel model = getSpectrumDoseModel();
+                    if (sscanf(args.c_str() + 11, "%f %f %f %f", &model.usvPerCount662, &model.b1, &model.b2,
+                               &model.minKeV) >= 3 && model.usvPerCount662 > 0.0f) {
+                        setSpectrumDoseModel(model);
+                    } else {
+                        Serial.println("Usage: spectrum dose model <uSv/count at 662 keV> <b1> <b2> [min keV]");
+                    }
+                }
+                printSpectrumDose(Serial);
+                return;
+            }
+            if (args == "cal auto") {
+                if (!calibrateFromReferenceLines()) Serial.println("Calibration needs both Cs-137 and K-40 peaks");
+            } else if (args.startsWith("cal ")) {
+                EnergyCalibration cal = {0.0f, 0.0f, 0.0f};
+                if (sscanf(args.c_str() + 4, "%f %f %f", &cal.c0, &cal.c1, &cal.c2) >= 2 && cal.valid()) {
+                    setEnergyCalibration(cal);
+                } else {
+                    Serial.println("Usage: spectrum cal <c0> <c1> [c2] (keV, c1 > 0)");
+                }
+            } else if (args == "clear") {
+                spectrum.clear();
+            } else if (args == "bench") {
+                runSpectrumBenchmark(Serial);
+            } else if (args.startsWith("threshold")) {
+                int threshold = args.substring(9).toInt();
+                if (threshold > 0 && threshold < 4096) setSpectrumThreshold(threshold);
+            } else if (args == "pileup off") {
+                setSpectrumPileUp(PILEUP_OFF);
+            } else if (args == "pileup flag") {
+                setSpectrumPileUp(PILEUP_FLAG);
+            } else if (args == "pileup reject") {
+                setSpectrumPileUp(PILEUP_REJECT);
+            } else if (args.startsWith("shaping")) {
+                SpectrumShaping shaping = getSpectrumShaping();
+                unsigned rise, flat, decay;
+                bool parsed = true;
+                if (args == "shaping off") {
+                    shaping.enabled = false;
+                } else if (args == "shaping on") {
+                    shaping.enabled = true;
+                } else if (sscanf(args.c_str() + 7, "%u %u %u", &rise, &flat, &decay) == 3 &&
+                           rise <= 0xFFFF && flat <= 0xFFFF && decay <= 0xFFFF) {
+                    shaping = {true, (uint16_t)rise, (uint16_t)flat, (uint16_t)decay};
+                } else {
+                    parsed = false;
+                    if (args != "shaping") Serial.println("Usage: spectrum shaping off|on|<rise us> <flat us> <decay us>");
+                }
+                if (parsed && !setSpectrumShaping(shaping)) Serial.println("Shaping: trapezoid too long for the delay line");
+            }
+            SpectrumAcqStats acq = getSpectrumAcqStats();
+            Serial.printf("Spectrum: %s (%s), %u channels, %lu counts\n", acq.running ? "RUNNING" : "STOPPED",
+                          spectrumSourceName(), spectrum.channels(), (unsigned long)spectrum.total());
+            Serial.printf("  %lu samples, %lu pulses, %lu overruns, baseline %u at %lu S/s\n",
+                          (unsigned long)acq.samples, (unsigned long)acq.pulses,
+                          (unsigned long)acq.overruns, acq.baseline, (unsigned long)acq.sampleRate);
+            SpectrumShaping shaping = getSpectrumShaping();
+            if (shaping.enabled) {
+                Serial.printf("  Shaping: trapezoid, rise %u us, flat %u us, decay %u us%s\n", shaping.riseUs,
+                              shaping.flatUs, shaping.decayUs, acq.shaping ? "" : " (pending)");
+            } else {
+                Serial.println("  Shaping: off (raw max-hold)");
+            }
+            static const char* pileUpNames[] = {"off", "flag", "reject"};
+            uint32_t liveMs = spectrum.liveMs(), realMs = spectrum.realMs();
+            Serial.printf("  Pile-up %s: %lu found (%lu binned flagged); live %.1f s of %.1f s real, dead %.2f%%\n",
+                          pileUpNames[acq.pileUpMode], (unsigned long)acq.pileUps,
+                          (unsigned long)coincidenceStats.piledUp, liveMs / 1000.0f, realMs / 1000.0f,
+                          realMs > liveMs ? 100.0f * (realMs - liveMs) / realMs : 0.0f);
+            if (liveMs) {
+                Serial.printf("  Rate %.1f cps per live second (%.1f per real second)\n",
+                              spectrum.total() * 1000.0f / liveMs, realMs ? spectrum.total() * 1000.0f / realMs : 0.0f);
+            }
+            EnergyCalibration cal = getEnergyCalibration();
+            Serial.printf("  Calibration: E = %.3f + %.4f*ch + %.3g*ch^2 keV\n", cal.c0, cal.c1, cal.c2);
+            SpectrumAnalysis analysis = getSpectrumAnalysis();
+            for (uint8_t i = 0; i < SPECTRUM_LINE_COUNT; i++) {
+                const SpectrumLineResult& line = analysis.lines[i];
+                if (!line.isotope) continue;
+                if (!line.found) {
+                    Serial.printf("  %s: not found\n", line.isotope);
+                    continue;
+                }
+                Serial.printf("  %s: ch %.1f = %.1f keV, FWHM %.1f keV, net %.0f +- %.0f\n", line.isotope,
+                              line.centroid, line.energyKeV, line.fwhmKeV, line.netCounts, line.netError);
+            }
+        }
+        else if (command.startsWith("bench")) {
+            // "bench" times the hot paths and prints a table; "bench json" prints
+            // the last report (taking one first if needed) for build comparisons
+            BenchReport report;
+            bool json = command.substring(5).indexOf("json") >= 0;
+            if (!json || !getBenchReport(report)) {
+                Serial.println("Running benchmarks (the display flickers while frames are timed)...");
+                // Cycle counts convert to time at one clock; hold it for the run
+                PowerMode mode = powerProfileMode();
+                powerProfileSetMode(POWER_MODE_FIXED_MAX);
+                runBenchmarks();
+                powerProfileSetMode(mode);
+                getBenchReport(report);
+            }
+            if (json) {
+                Serial.println(getBenchReportJson(report));
+            } else {
+                printBenchReport(report, Serial);
+            }
+        }
+        else if (command.startsWith("ble")) {
+            // "ble", "ble on|off"
+            String args = command.substring(3);
+            args.trim();
+            if (args == "on" || args == "off") {
+                if (!bleServiceSetEnabled(args == "on")) Serial.println("BLE not available");
+            } else if (args.length() > 0) {
+                Serial.println("Usage: ble [on|off]");
+            }
+            printBleService(Serial);
+        }
+        else if (command.startsWith("udp")) {
+            if (command == "udp on" || command == "udp off") {
+                udpStreamSetEnabled(command == "udp on");
+            } else if (command != "udp") {
+                Serial.println("Usage: udp [on|off]");
+            }
+            printUdpStream(Serial);
+        }
+        else if (command == "modbus") {
+            printModbusServer(Serial);
+        }
+        else if (command == "eth") {
+            printEthernetLink(Serial);
+        }
+        else if (command.startsWith("espnow")) {
+            // "espnow", "espnow off|node|hub [channel]"
+            String args = command.substring(6);
+            args.trim();
+            if (args.length() > 0) {
+                int space = args.indexOf(' ');
+                String name = space < 0 ? args : args.substring(0, space);
+                long channel = space < 0 ? 0 : args.substring(space + 1).toInt();
+                int match = -1;
+                for (uint8_t r = 0; r < ESPNOW_ROLE_COUNT; r++) {
+                    if (name == espNowRoleName(r)) match = r;
+                }
+                if (match < 0 || channel < 0 || channel > 13) {
+                    Serial.println("Usage: espnow [off|node|hub [channel 1-13]]");
+                } else if (!espNowSetRole((EspNowRole)match, (uint8_t)channel)) {
+                    Serial.println("ESP-NOW not available");
+                }
+            }
+            printEspNowLink(Serial);
+        }
+        else if (command == "timesync") {
+            printTimeSync(Serial);
+        }
+        else if (command.startsWith("locate")) {
+            // "locate", "locate pos <mac|self> <x> <y>", "locate clear <mac|self>", "locate reset", "locate map"
+            String args = command.substring(6);
+            args.trim();
+            bool place = args.startsWith("pos ");
+            if (place || args.startsWith("clear ")) {
+                args = args.substring(place ? 4 : 6);
+                args.trim();
+                uint8_t mac[6];
+                float x = 0.0f, y = 0.0f;
+                bool parsed;
+                int used = 0;
+                if (args.startsWith("self")) {
+                    memcpy(mac, sourceLocatorSelf(), 6);
+                    used = 4;
+                    parsed = true;
+                } else {
+                    unsigned int b[6] = {};
+                    parsed = sscanf(args.c_str(), "%x:%x:%x:%x:%x:%x%n", &b[0], &b[1], &b[2], &b[3], &b[4], &b[5],
+                                    &used) == 6;
+                    for (uint8_t i = 0; i < 6; i++) mac[i] = (uint8_t)b[i];
+                }
+                if (parsed && place) parsed = sscanf(args.c_str() + used, "%f %f", &x, &y) == 2;
+                if (!parsed) {
+                    Serial.println("Usage: locate pos <AA:BB:CC:DD:EE:FF|self> <x m> <y m>, locate clear <mac|self>");
+                } else if (!sourceLocatorSetPosition(mac, place, x, y)) {
+                    Serial.println(place ? "No free detector slot" : "No position for that detector");
+                }
+            } else if (args == "reset") {
+                sourceLocatorReset();
+#if !HEADLESS
+            } else if (args == "map") {
+                sourceMapViewSetShown(!sourceMapViewShown());
+                uiScreenLoad(UI_SCREEN_CHARTS1H);
+#endif
+            } else if (args.length() > 0) {
+                Serial.println("Usage: locate [pos|clear|reset|map]");
+            }
+            printSourceLocator(Serial);
+        }
+        else if (command.startsWith("energy")) {
+            // "energy", "energy coef", "energy coef <name> <value>", "energy coef reset"
+            String args = command.substring(6);
+            args.trim();
+            bool coefficients = args.startsWith("coef");
+            if (coefficients) {
+                args = args.substring(4);
+                args.trim();
+                int space = args.indexOf(' ');
+                if (args == "reset") {
+                    energyResetCoefficients();
+                } else if (space > 0 && !energySetCoefficient(args.substring(0, space).c_str(),
+                                                              args.substring(space + 1).toFloat())) {
+                    Serial.println("Unknown coefficient or negative value");
+                } else if (args.length() > 0 && space <= 0) {
+                    Serial.println("Usage: energy coef [<name> <value> | reset]");
+                }
+            }
+            printEnergyMeter(Serial, coefficients);
+        }
+        else if (command.startsWith("power wifi")) {
+            // "power wifi [awake|modem|scheduled]"
+            String name = command.substring(10);
+            name.trim();
+            if (name.length() > 0) {
+                int match = -1;
+                for (uint8_t p = 0; p < WIFI_POWER_POLICY_COUNT; p++) {
+                    if (name == wifiPowerPolicyName(p)) match = p;
+                }
+                if (match < 0) {
+                    Serial.println("Usage: power wifi [awake|modem|scheduled]");
+                } else {
+                    wifiPowerSetPolicy((WifiPowerPolicy)match);
+                }
+            }
+            printWifiPower(Serial);
+        }
+        else if (command.startsWith("power")) {
+            // "power", "power max|min|dfs", "power bench [seconds per mode]"
+            String args = command.substring(5);
+            args.trim();
+            if (args.startsWith("bench")) {
+                long seconds = args.length() > 5 ? args.substring(5).toInt() : 60;
+                if (seconds <= 0) seconds = 60;
+                if (startPowerBench((uint32_t)seconds, powerBenchCounts)) {
+                    Serial.printf("Power bench started: %ld s per mode, read the supply meter as each mode starts\n",
+                                  seconds);
+                } else {
+                    Serial.println("Power bench already running");
+                }
+            } else if (args.length() > 0) {
+                int match = -1;
+                for (uint8_t m = 0; m < POWER_MODE_COUNT; m++) {
+                    if (args == powerModeName(m)) match = m;
+                }
+                if (match < 0) {
+                    Serial.println("Usage: power [max|min|dfs|bench [seconds]|wifi [policy]]");
+                } else if (getPowerBenchReport().running || !powerProfileSetMode((PowerMode)match)) {
+                    Serial.println("Mode not available (bench running or no esp_pm)");
+                }
+            }
+            printPowerProfile(Serial);
+            printWifiPower(Serial);
+        }
+        else if (command.startsWith("inject")) {
+            // "inject", "inject bench", "inject fixed <hz> [s]", "inject poisson <cpm> [s]",
+            // "inject burst <pulses> <spacing us> <period ms> [s]", "inject stop"
+            String args = command.substring(6);
+            args.trim();
+            PulsePatternParams params = {};
+            float values[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+            uint8_t given = 0;
+            String rest = args.indexOf(' ') < 0 ? String() : args.substring(args.indexOf(' ') + 1);
+            while (rest.length() > 0 && given < 4) {
+                rest.trim();
+                int space = rest.indexOf(' ');
+                values[given++] = (space < 0 ? rest : rest.substring(0, space)).toFloat();
+                rest = space < 0 ? String() : rest.substring(space + 1);
+            }
+            bool started = false;
+            bool usage = false;
+            if (args == "bench") {
+                started = pulseInjectStartBench();
+            } else if (args == "stop") {
+                pulseInjectStop();
+            } else if (args.startsWith("fixed ") || args.startsWith("poisson ")) {
+                params.type = args.startsWith("fixed") ? PULSE_PATTERN_FIXED : PULSE_PATTERN_POISSON;
+                params.rate = values[0];
+                started = pulseInjectStart(params, given > 1 ? (uint32_t)values[1] : PULSE_INJECT_STEP_S);
+            } else if (args.startsWith("burst ") && given >= 3) {
+                params.type = PULSE_PATTERN_BURST;
+                params.rate = values[0];
+                params.spacingUs = (uint32_t)values[1];
+                params.periodMs = (uint32_t)values[2];
+                started = pulseInjectStart(params, given > 3 ? (uint32_t)values[3] : PULSE_INJECT_STEP_S);
+            } else if (args.length() > 0) {
+                usage = true;
+            }
+            if (usage) {
+                Serial.println("Usage: inject [bench | fixed <hz> [s] | poisson <cpm> [s] | "
+                               "burst <pulses> <spacing us> <period ms> [s] | stop]");
+            } else if (args.length() > 0 && args != "stop") {
+                Serial.println(started ? "Pulse injection started, \"inject\" shows the progress"
+                                       : "Cannot inject (running, no PULSE_INJECT_PIN or bad parameters)");
+            }
+            printPulseInjector(Serial);
+        }
+        else if (command.startsWith("trace")) {
+            // "trace on|off|clear|dump"; convert a dump with tools/trace_to_perfetto.py
+            String args = command.substring(5);
+            args.trim();
+            if (args == "on") traceSetRecording(true);
+            else if (args == "off") traceSetRecording(false);
+            else if (args == "clear") traceClear();
+            if (args == "dump") {
+                traceDump(Serial);
+            } else {
+                uint32_t recorded = traceHead.load();
+                Serial.printf("Trace: %s, %lu events recorded, %u kept\n",
+                              traceRecording ? "RECORDING" : (TRACE_ENABLED ? "PAUSED" : "COMPILED OUT"),
+                              (unsigned long)recorded,
+                              (unsigned)(recorded < TRACE_RING_SIZE ? recorded : TRACE_RING_SIZE));
+            }
+        }
+        else if (command == "estimators") {
+            printRateEstimators(Serial);
+        }
+        else if (command == "perf") {
+            printSysInfo(Serial);
+            printCommandBus(Serial);
+            printJsonBody(Serial);
+            printJsonArena(Serial);
+            printWebArena(Serial);
+            printApiBodyCache(Serial);
+        }
         else if (command == "status") {
             Serial.println("=== Radiation Detector Status ===");
             Serial.printf("Debug: %s\n", debugEnabled ? "ON" : "OFF");
@@ -284,35 +1554,57 @@ void processSerialCommands() {
             Serial.printf("Average radiation: %.3f µSv/h\n", averageuSvHr);
             Serial.printf("Maximum radiation: %.3f µSv/h\n", maxuSvHr);
             Serial.printf("Cumulative dose: %.3f mSv\n", cumulativemSv);
-            Serial.printf("Total counts: %lu\n", totalCounts);
-            Serial.printf("CPM: %d\n", getRealTimeCPM());
-            Serial.printf("Alarms: %s\n", alarmDisabled ? "DISABLED" : "ENABLED");
-            Serial.printf("WiFi: %s\n", WiFi.status() == WL_CONNECTED ? "CONNECTED" : "DISCONNECTED");
-            if (WiFi.status() == WL_CONNECTED) {
-                Serial.printf("IP: %s\n", wifi_ip.c_str());
+            Serial.printf("Total counts: %lu\n", (unsigned long)pulseStats.totalCounts);
+            Serial.printf("CPM: %d (corrected %.1f, dead time %.1f us)\n", getRealTimeCPM(), correctedCpm, getDeviceConfig().deadTimeUs);
+            Serial.printf("Adaptive window: %u s (%lu changes)\n", pulseStats.adaptiveWindowSeconds,
+                          (unsigned long)pulseStats.adaptiveChanges);
+            static const char* const PRIOR_STATES[] = {"none saved", "active", "released", "contradicted"};
+            Serial.printf("Rate prior: %s", PRIOR_STATES[startupPrior.state()]);
+            if (startupPrior.state() != RatePrior::NONE) {
+                Serial.printf(", %.1f CPM worth %.0f s", 60.0f * startupPrior.priorCps(), startupPrior.priorSeconds());
+            }
+            if (startupPrior.active()) {
+                Serial.printf(", posterior %.1f +/- %.1f CPM", 60.0f * startupPrior.cps(),
+                              60.0f * startupPrior.sigmaCps());
+            } else if (startupPrior.state() != RatePrior::NONE) {
+                Serial.printf(", until %lu s", (unsigned long)startupPrior.releasedAt());
+            }
+            Serial.println();
+            Serial.printf("CPM 10s/60s/300s: %.1f / %.1f / %.1f\n", getWindowCPM(RATE_WINDOW_10S),
+                          getWindowCPM(RATE_WINDOW_60S), getWindowCPM(RATE_WINDOW_300S));
+            Serial.print("Averages (uSv/h):");
+            DoseSnapshot dose = getDoseSnapshot();
+            for (uint8_t i = 0; i < RATE_EWMA_COUNT; i++) {
+                Serial.printf(" %s %.3f", RateEwma::name((RateEwmaId)i), dose.averagesUsvH[i]);
+            }
+            Serial.println();
+            if (pulseCaptureActive()) {
+                const PulseCaptureStats& capture = pulseStats.capture;
+                Serial.printf("Captured pulses: %lu (dropped %lu, last interval %lu us)\n",
+                              (unsigned long)capture.captured, (unsigned long)capture.dropped,
+                              (unsigned long)capture.lastIntervalUs);
+            }
+            AlarmStatus alarm = getAlarmStatus();
+            Serial.printf("Alarms: %s, level %s%s (causes 0x%02x)\n",
+                          getDeviceConfig().alarmEnabled ? "ENABLED" : "DISABLED", alarmLevelName(alarm.level),
+                          alarmSoundingLevel() ? ", SOUNDING" : "", alarm.causes);
+            Serial.printf("Alarm rate: %.3f uSv/h (%.3f .. %.3f)", alarm.rateUsvH, alarm.rateLowerUsvH,
+                          alarm.rateUpperUsvH);
+            if (alarm.secondsToDoseAlarm >= 0.0f) {
+                Serial.printf(", dose threshold in %.1f h", alarm.secondsToDoseAlarm / 3600.0f);
+            }
+            Serial.println();
+            Serial.printf("WiFi: %s\n", wifiManagerState() == WIFI_STATE_CONNECTED ? "CONNECTED"
+                                         : wifiManagerSuspended()                     ? "OFF"
+                                                                                      : "DISCONNECTED");
+            if (networkOnline()) {
+                Serial.printf("IP: %s (%s.local)\n", wifi_ip, mdnsHostname());
             }
         }
     }
 }
 
-/*******************************************************************************
- * Buzzer & LEDC Alarm Functions
- ******************************************************************************/ 
-void initBuzzer() {
-    ledcSetup(0, 2000, 8);  // Default frequency 2000 Hz
-    ledcAttachPin(BUZZER_PIN, 0);
-    ledcWrite(0, 0);
-}
-
-void playAlarmTone(uint32_t freq) {
-    ledcSetup(0, freq, 8);
-    ledcWrite(0, 128);
-}
-
-void stopAlarmTone() {
-    ledcWrite(0, 0);
-}
-
+#if !HEADLESS
 /*******************************************************************************
  * Alarm Checkbox Event Callback
  ******************************************************************************/ 
@@ -320,44 +1612,22 @@ static void alarms_checkbox_event_cb(lv_event_t * e) {
     lv_obj_t * checkbox = lv_event_get_target(e);
     bool isChecked = lv_obj_has_state(checkbox, LV_STATE_CHECKED);
     
-    // Update the global state
-    alarmDisabled = !isChecked;
-    
     DEBUG_PRINTF("Checkbox state changed: %s (alarm %s)\n", 
                 isChecked ? "CHECKED" : "UNCHECKED",
-                alarmDisabled ? "DISABLED" : "ENABLED");
+                isChecked ? "ENABLED" : "DISABLED");
     
-    // Save all alarm settings including the enabled state
+    // Save all alarm settings including the enabled state; pulseTask silences
+    // the buzzer on its next poll once the configuration says disabled
     saveAlarmSettings();
-    
-    // If alarms are disabled, make sure to stop any active tones
-    if (alarmDisabled) {
-        stopAlarmTone();
-    }
 }
 
 /**
  * @brief Callback for when spinbox values change
  * 
- * This handler saves the alarm settings whenever a spinbox value changes.
+ * This handler writes the new threshold to the device configuration; the
+ * alarm labels on the main screen follow the configuration in updateLabels().
  */
 static void spinbox_changed_event_cb(lv_event_t * e) {
-    lv_obj_t * spinbox = lv_event_get_target(e);
-    char buffer[16];
-    
-    // Update corresponding alarm label when spinbox value changes
-    if (spinbox == ui_CurrentSpinbox && ui_CurrentAlarm) {
-        int32_t currentValue = lv_spinbox_get_value(ui_CurrentSpinbox);
-        snprintf(buffer, sizeof(buffer), "%.1f", (float)currentValue / 10.0f);
-        lv_label_set_text(ui_CurrentAlarm, buffer);
-    } 
-    else if (spinbox == ui_CumulativeSpinbox && ui_CumulativeAlarm) {
-        int32_t cumulativeValue = lv_spinbox_get_value(ui_CumulativeSpinbox);
-        snprintf(buffer, sizeof(buffer), "%.1f", (float)cumulativeValue / 10.0f);
-        lv_label_set_text(ui_CumulativeAlarm, buffer);
-    }
-    
-    // Save the updated spinbox values and current alarm state
     saveAlarmSettings();
     DEBUG_PRINTLN("Spinbox value changed, alarm settings saved");
 }
@@ -372,220 +1642,284 @@ void saveAlarmSettings() {
         return;
     }
 
-    preferences.begin("settings", false);
-    
-    // Save current alarm threshold from spinbox
-    int32_t currentValue = lv_spinbox_get_value(ui_CurrentSpinbox);
-    preferences.putInt("currentAlarm", currentValue);
-    
-    // Save cumulative alarm threshold from spinbox
-    int32_t cumulativeValue = lv_spinbox_get_value(ui_CumulativeSpinbox);
-    preferences.putInt("cumulativeAlarm", cumulativeValue);
+    // The widgets are read only here, when the user changed one of them. The
+    // configuration is the source of truth for everything else, and the
+    // settings task writes NVS once the values have stopped changing
+    DeviceConfig config = getDeviceConfig();
+    config.currentAlarmX10 = lv_spinbox_get_value(ui_CurrentSpinbox);
+    config.cumulativeAlarmX10 = lv_spinbox_get_value(ui_CumulativeSpinbox);
+    config.alarmEnabled = lv_obj_has_state(ui_EnableAlarmsCheckbox, LV_STATE_CHECKED);
+    setDeviceConfig(config);
     
-    // Save alarm enabled state
-    bool isAlarmEnabled = !alarmDisabled;
-    preferences.putBool("alarmEnabled", isAlarmEnabled);
-    
-    // Always flush to ensure data is written
-    preferences.end();
-    
-    DEBUG_PRINTF("Alarm settings saved: Current=%.1f µSv/h, Cumulative=%.1f mSv, Alarms %s\n", 
-                 (float)currentValue / 10.0f, 
-                 (float)cumulativeValue / 10.0f, 
-                 alarmDisabled ? "DISABLED" : "ENABLED");
+    DEBUG_PRINTF("Alarm settings updated: Current=%.1f µSv/h, Cumulative=%.1f mSv, Alarms %s\n", 
+                 config.currentAlarmUsvH(), 
+                 config.cumulativeAlarmMsv(), 
+                 config.alarmEnabled ? "ENABLED" : "DISABLED");
 }
 
-void loadAlarmSettings() {
-    // Check if the UI components are initialized
-    if (!ui_EnableAlarmsCheckbox || !ui_CurrentSpinbox || !ui_CumulativeSpinbox) {
-        DEBUG_PRINTLN("ERROR: Cannot load alarm settings - UI not initialized!");
-        return;
+/**
+ * @brief Shows the device configuration on the settings widgets.
+ *
+ * Called when the settings screen is built and again whenever the configuration
+ * revision changes (e.g. from a serial command); a no-op while the screen does
+ * not exist. Setting a spinbox value or a checkbox state from code sends no
+ * VALUE_CHANGED event, so this never loops back.
+ */
+void applyConfigToWidgets() {
+    if (!ui_EnableAlarmsCheckbox || !ui_CurrentSpinbox || !ui_CumulativeSpinbox || !ui_OnStartup) {
+        return; // Settings screen not built
     }
 
-    preferences.begin("settings", true);
-    
-    // Load current alarm threshold - default 5.0 µSv/h (50 in spinbox format for xxx.x)
-    int32_t currentValue = preferences.getInt("currentAlarm", 50);
-    lv_spinbox_set_value(ui_CurrentSpinbox, currentValue);
-    
-    // Load cumulative alarm threshold - default 1.0 mSv (10 in spinbox format for xxx.x)
-    int32_t cumulativeValue = preferences.getInt("cumulativeAlarm", 10);
-    lv_spinbox_set_value(ui_CumulativeSpinbox, cumulativeValue);
-    
-    // Load alarm enabled state
-    bool isAlarmEnabled = preferences.getBool("alarmEnabled", false); // Default disabled
-    alarmDisabled = !isAlarmEnabled;
-    
-    DEBUG_PRINTF("Loaded preferences value alarmEnabled = %s\n", isAlarmEnabled ? "true" : "false");
+    DeviceConfig config = getDeviceConfig();
+    lv_spinbox_set_value(ui_CurrentSpinbox, config.currentAlarmX10);
+    lv_spinbox_set_value(ui_CumulativeSpinbox, config.cumulativeAlarmX10);
     
-    // Update the checkbox state
-    if (isAlarmEnabled) {
-        DEBUG_PRINTLN("Setting checkbox to CHECKED state");
+    if (config.alarmEnabled) {
         lv_obj_add_state(ui_EnableAlarmsCheckbox, LV_STATE_CHECKED);
     } else {
-        DEBUG_PRINTLN("Setting checkbox to UNCHECKED state");
         lv_obj_clear_state(ui_EnableAlarmsCheckbox, LV_STATE_CHECKED);
     }
     
-    // Update alarm threshold labels on the main screen
-    char buffer[16];
-    if (ui_CurrentAlarm) {
-        snprintf(buffer, sizeof(buffer), "%.1f", (float)currentValue / 10.0f);
-        lv_label_set_text(ui_CurrentAlarm, buffer);
-    }
-    
-    if (ui_CumulativeAlarm) {
-        snprintf(buffer, sizeof(buffer), "%.1f", (float)cumulativeValue / 10.0f);
-        lv_label_set_text(ui_CumulativeAlarm, buffer);
+    if (config.wifiAutoConnect) {
+        lv_obj_add_state(ui_OnStartup, LV_STATE_CHECKED);
+    } else {
+        lv_obj_clear_state(ui_OnStartup, LV_STATE_CHECKED);
     }
-    
-    preferences.end();
-    
-    DEBUG_PRINTF("Alarm settings loaded: Current=%.1f µSv/h, Cumulative=%.1f mSv, Alarms %s\n", 
-                 (float)currentValue / 10.0f, 
-                 (float)cumulativeValue / 10.0f, 
-                 alarmDisabled ? "DISABLED" : "ENABLED");
 }
 
+#endif // !HEADLESS
+
 /*******************************************************************************
  * Alarm Checker Function
  ******************************************************************************/ 
-void checkAlarms() {
-    // Check if alarm is disabled. If so, ensure no tone is played.
-    if(alarmDisabled) {
-        stopAlarmTone();
-        return;
-    }
-
-    // Get thresholds from spinboxes 
-    // For UI format "xxx.x" - spinbox value 1234 represents 123.4 µSv/h or 123.4 mSv
-    int32_t currentValueRaw = lv_spinbox_get_value(ui_CurrentSpinbox);
-    int32_t cumulativeValueRaw = lv_spinbox_get_value(ui_CumulativeSpinbox);
-    
-    // Convert from spinbox format to actual values
-    // The spinbox format is "xxx.x" so divide by 10 to get the actual value
-    float currentThreshold = (float)currentValueRaw / 10.0f;
-    float cumulativeThreshold = (float)cumulativeValueRaw / 10.0f;
+static AlarmEngine alarmEngine;                 ///< pulseTask only
+static uint8_t journaledAlarmLevel = ALARM_LEVEL_NONE; ///< pulseTask only
+static SeqLock<AlarmStatus> alarmStatusLock;   ///< Last evaluation, for the UI, serial and web
 
-    bool condition = (currentuSvHr > currentThreshold) || (cumulativemSv > cumulativeThreshold);
-    
-    // Debug output - uncomment when troubleshooting alarms
-    static unsigned long lastDebugPrint = 0;
-    if (millis() - lastDebugPrint > 5000) { // Print every 5 seconds to avoid flooding serial
-        DEBUG_PRINTF("Alarm check: Current %.3f/%.3f µSv/h, Cumulative %.3f/%.3f mSv, Alarm %s\n", 
-                     currentuSvHr, currentThreshold, 
-                     cumulativemSv, cumulativeThreshold,
-                     condition ? "TRIGGERED" : "inactive");
-        lastDebugPrint = millis();
-    }
-    
-    unsigned long now = millis();
-    if (condition) {
-        if (now - lastAlarmMillis >= (ALARM_TONE_DURATION + ALARM_PAUSE_DURATION)) {
-            stopAlarmTone();
-            playAlarmTone(alarmToneToggle ? ALARM_FREQ1 : ALARM_FREQ2);
-            alarmToneToggle = !alarmToneToggle;
-            lastAlarmMillis = now;
+/**
+ * @brief Runs the alarm rules and sets the buzzer pattern (pulseTask, every poll).
+ *
+ * The rules are evaluated incrementally on each closed second, straight from
+ * pulseTask's rate windows, so the alarm follows the counts even while uiTask
+ * is busy. The cumulative dose is integrated on uiTask; it changes slowly
+ * enough that a stalled UI only delays the dose rules, never the tone itself,
+ * which the sequencer times on its own. Disabling alarms silences the buzzer
+ * on the next poll. Level changes are journaled whether alarms sound or not;
+ * the journal only touches RTC memory here.
+ *
+ * @param secondClosed A 1-second bucket was closed by this poll
+ */
+static void checkAlarms(bool secondClosed) {
+    DeviceConfig config = getDeviceConfig();
+    if (secondClosed) {
+        AlarmThresholds thresholds = AlarmThresholds::fromAlarm(config.currentAlarmUsvH(), config.cumulativeAlarmMsv(),
+                                                                ALARM_WARN_FRACTION, ALARM_DANGER_FACTOR);
+        const AlarmStatus& status = alarmEngine.update(pulseHistory, adaptiveRate, (float)doseAccumulator.msv(),
+                                                       config.deadTimeSec, config.cpmPerUsvH, thresholds,
+                                                       isotopeIdAlarmLevel());
+        alarmStatusLock.publish(status);
+        if (status.level != journaledAlarmLevel) {
+            uint8_t type = status.level == ALARM_LEVEL_NONE     ? JOURNAL_ALARM_CLEARED
+                           : status.level > journaledAlarmLevel ? JOURNAL_ALARM_RAISED
+                                                                : JOURNAL_ALARM_LOWERED;
+            eventJournalRecord(type, type == JOURNAL_ALARM_CLEARED ? journaledAlarmLevel : status.level,
+                               status.causes, status.rateUsvH);
+            journaledAlarmLevel = status.level;
         }
-    } else {
-        stopAlarmTone();
+        float warnUsvH = thresholds.rateUsvH[ALARM_LEVEL_WARN];
+        statusLedSetState(config.alarmEnabled ? status.level : ALARM_LEVEL_NONE,
+                          warnUsvH > 0.0f ? status.rateUsvH / warnUsvH : 0.0f, anomalyActive());
     }
+    alarmSetLevel(config.alarmEnabled ? alarmEngine.status().level : ALARM_LEVEL_NONE);
+    
+    // Clicks are compressed to the recent rate once per second
+    alarmSetClicks(config.clicksEnabled);
+    if (secondClosed) alarmSetClickRate(pulseHistory.cpm(RATE_WINDOW_10S) / 60.0f);
+}
+
+/**
+ * @brief Last alarm evaluation (any task).
+ */
+static AlarmStatus getAlarmStatus() {
+    AlarmStatus status;
+    memset(&status, 0, sizeof(status));
+    alarmStatusLock.read(status);
+    return status;
 }
 
 /*******************************************************************************
  * PCNT (Pulse Counter) Functions
  ******************************************************************************/ 
+/**
+ * @brief Limit hook of the main tube: PULSE_EVENT_COUNTS more pulses, time for a reading.
+ */
+static void IRAM_ATTR wakeSamplerFromLimit() {
+    BaseType_t woken = pdFALSE;
+    if (pulseSampleTaskHandle) vTaskNotifyGiveFromISR(pulseSampleTaskHandle, &woken);
+    if (woken) portYIELD_FROM_ISR();
+}
+
+/**
+ * @brief Starts counting on every channel. The limit ISRs are allocated on the
+ *        calling core (pulseSampleTask's, TASK_CORE_MEASUREMENT).
+ */
 void initPulseCounter() {
-    pcnt_config_t pcnt_config = {};
-    pcnt_config.pulse_gpio_num = GEIGER_PULSE_PIN;
-    pcnt_config.ctrl_gpio_num  = PCNT_PIN_NOT_USED;
-    pcnt_config.channel        = PCNT_CHANNEL_0;
-    pcnt_config.unit           = PCNT_UNIT;
-    pcnt_config.pos_mode       = PCNT_COUNT_INC;
-    pcnt_config.neg_mode       = PCNT_COUNT_DIS;
-    pcnt_config.lctrl_mode     = PCNT_MODE_KEEP;
-    pcnt_config.hctrl_mode     = PCNT_MODE_KEEP;
-    pcnt_config.counter_h_lim  = 32767;
-    pcnt_config.counter_l_lim  = 0;
+    // Glitch filter: pulses shorter than PULSE_WIDTH_MIN_US (boost converter spikes) are not counted
+    counterChannels[0].begin(0, GEIGER_PULSE_PIN, PCNT_HIGH_LIMIT, PULSE_WIDTH_PCNT_FILTER_CYCLES,
+                             PULSE_EVENT_WAKE ? wakeSamplerFromLimit : nullptr);
+    if (COUNTER_CHANNELS > 1) {
+        // Read with every sample, so the full 16-bit range is plenty
+        counterChannels[HIGH_RANGE_CHANNEL].begin(1, COUNTER2_PIN, 32767, PULSE_WIDTH_PCNT_FILTER_CYCLES, nullptr);
+    }
+}
 
-    pcnt_unit_config(&pcnt_config);
-    // Optionally adjust filter settings: set filter value (in clock cycles) and enable filter.
-    pcnt_set_filter_value(PCNT_UNIT, 10);
-    pcnt_filter_enable(PCNT_UNIT);
+/**
+ * @brief Returns the main tube's count since initPulseCounter() as a monotonic 32-bit value.
+ */
+uint32_t readPulseCount32() {
+    return counterChannels[0].read32();
+}
 
-    pcnt_counter_pause(PCNT_UNIT);
-    pcnt_counter_clear(PCNT_UNIT);
-    pcnt_counter_resume(PCNT_UNIT);
+/**
+ * @brief Returns the total counts per minute based on the pulse history.
+ *
+ * Reads the 60-second window from the last snapshot published by pulseTask, so
+ * this is O(1) and never touches the live rate state. If the window is not yet full, it
+ * extrapolates based on the available seconds to give an accurate CPM estimate.
+ *
+ * @return int Counts per minute (CPM)
+ */
+int getRealTimeCPM() {
+    return (int)pulseStats.windowCpm[RATE_WINDOW_60S];
+}
 
-    lastPCNTCount16 = 0;
-    lastPulsePollTime = millis();
-    pulseAccumulationTime = millis();
-    pulseDiffAccumulator = 0;
+/**
+ * @brief Returns the CPM over one of the sliding windows (10 s, 60 s or 300 s).
+ */
+float getWindowCPM(RateWindowId window) {
+    return pulseStats.windowCpm[window];
+}
 
-    DEBUG_PRINTLN("PCNT initialized on GEIGER_PULSE_PIN.");
+/**
+ * @brief Background the search pitch is relative to: the rate shown when it
+ *        starts (uiTask).
+ */
+static float searchReferenceCps() {
+    return rawCpm / 60.0f;
 }
 
 /**
- * @brief Polls the PCNT counter every 100 ms and accumulates pulse differences.
- *
- * Every 100ms, the PCNT value is read and the difference (since the last read)
- * is added to an accumulator. Once 1 second has passed, the accumulated difference
- * is stored into a 60-second ring buffer.
+ * @brief CPU cycle counter for the estimator bank's cost accounting.
  */
-void updatePulseHistory() {
-    unsigned long now = millis();
+static uint32_t estimatorCycles() {
+    return ESP.getCycleCount();
+}
 
-    // Poll every 100 ms
-    if (now - lastPulsePollTime >= 100) {
-        int16_t currentCount16 = 0;
-        pcnt_get_counter_value(PCNT_UNIT, &currentCount16);
-        int diff = currentCount16 - lastPCNTCount16;
-        // Ignore any negative differences (e.g., due to wrap-around or reset)
-        if(diff < 0) {
-            diff = 0;
-        }
-        lastPCNTCount16 = currentCount16;
-        pulseDiffAccumulator += diff;
-        lastPulsePollTime = now;
+/**
+ * @brief Fills the estimator bank from RATE_ESTIMATOR_SET; the Bayes estimator
+ *        starts from the rate prior. In setup(), before pulseTask.
+ */
+static void initRateEstimators() {
+    RateEstimator* const CANDIDATES[] = {&estimatorWindow10, &estimatorWindow60, &estimatorWindow300,
+                                         &estimatorAdaptive, &estimatorEwma,     &estimatorBayes,
+                                         &estimatorKalman};
+    if (startupPrior.state() != RatePrior::NONE) {
+        estimatorBayes.setPrior(startupPrior.priorCps(), startupPrior.priorSeconds());
     }
+    for (uint8_t i = 0; i < sizeof(CANDIDATES) / sizeof(CANDIDATES[0]); i++) {
+        if (RATE_ESTIMATOR_SET & (1 << i)) rateEstimators.add(CANDIDATES[i]);
+    }
+}
 
-    // Every 1 second, update the ring buffer with the accumulated difference
-    if (now - pulseAccumulationTime >= 1000) {
-        pulseHistory[pulseHistoryIndex] = pulseDiffAccumulator;
-        pulseHistoryIndex = (pulseHistoryIndex + 1) % PULSE_HISTORY_SIZE;
-        totalCounts += pulseDiffAccumulator;
-        pulseDiffAccumulator = 0;
-        pulseAccumulationTime = now;
+/**
+ * @brief "estimators": every candidate's rate and its cost per second (uiTask).
+ */
+static void printRateEstimators(Print& out) {
+    if (rateEstimators.count() == 0) {
+        out.println("Rate estimators: none (RATE_ESTIMATOR_SET)");
+        return;
+    }
+    out.printf("Rate estimators after %lu s (shown: adaptive, %.1f CPM)\n", (unsigned long)pulseStats.secondsClosed,
+               pulseStats.adaptiveCpm);
+    out.println("Estimator         CPM    1-sigma   Cycles last / max / avg");
+    for (uint8_t i = 0; i < rateEstimators.count(); i++) {
+        const RateEstimatorBank::Cost& cost = pulseStats.estimatorCost[i];
+        out.printf("%-12s %8.2f %10.2f   %5lu / %5lu / %5lu\n", rateEstimators.at(i).name(),
+                   60.0f * pulseStats.estimatorCps[i], 60.0f * pulseStats.estimatorSigmaCps[i],
+                   (unsigned long)cost.lastCycles, (unsigned long)cost.maxCycles,
+                   (unsigned long)(pulseStats.secondsClosed ? cost.totalCycles / pulseStats.secondsClosed : 0));
     }
 }
 
 /**
- * @brief Returns the total counts per minute based on the pulse history.
- *
- * This function computes the counts per minute by summing the pulses in the 
- * 60-second history buffer. If the buffer is not yet full, it extrapolates
- * based on the available data to give an accurate CPM estimate.
- *
- * @return int Counts per minute (CPM)
+ * @brief Publishes the rate state after a completed second (pulseTask only).
  */
-int getRealTimeCPM() {
-    int sum = 0;
-    int validSeconds = 0;
-    
-    // Count pulses and valid seconds in history buffer
-    for (int i = 0; i < PULSE_HISTORY_SIZE; i++) {
-        if (pulseHistory[i] >= 0) {  // Valid entries
-            sum += pulseHistory[i];
-            validSeconds++;
-        }
+static void publishPulseSnapshot(uint32_t lastSecondCounts) {
+    static uint32_t secondsClosed = 0;
+    PulseSnapshot snap;
+    snap.totalCounts = totalCounts;
+    snap.lastSecondCounts = lastSecondCounts;
+    snap.secondsClosed = ++secondsClosed;
+    snap.adaptiveCpm = adaptiveRate.cpm();
+    snap.adaptiveWindowSeconds = adaptiveRate.windowSeconds();
+    snap.adaptiveCounts = adaptiveRate.windowCounts();
+    snap.adaptiveChanges = adaptiveRate.changeCount();
+    for (int w = 0; w < RATE_WINDOW_COUNT; w++) {
+        snap.windowCpm[w] = pulseHistory.cpm((RateWindowId)w);
     }
-    
-    // If we don't have a full minute of data yet, extrapolate
-    if (validSeconds < PULSE_HISTORY_SIZE && validSeconds > 0) {
-        return (int)((float)sum * ((float)PULSE_HISTORY_SIZE / (float)validSeconds));
+    for (uint8_t c = 0; c < COUNTER_CHANNELS; c++) {
+        snap.channelCpm[c] = channelWindows[c].cpm(RATE_WINDOW_60S);
     }
-    
-    return sum;
+    snap.rangeSwitches = counterRange.switches();
+    snap.highRange = counterRange.highRange();
+    for (uint8_t i = 0; i < RATE_EWMA_COUNT; i++) {
+        snap.ewmaCpm[i] = rateEwma.cpm((RateEwmaId)i);
+        snap.ewmaSigmaCpm[i] = rateEwma.sigmaCpm((RateEwmaId)i);
+    }
+    for (uint8_t i = 0; i < rateEstimators.count(); i++) {
+        snap.estimatorCps[i] = rateEstimators.at(i).cps();
+        snap.estimatorSigmaCps[i] = rateEstimators.at(i).sigmaCps();
+        snap.estimatorCost[i] = rateEstimators.cost(i);
+    }
+    memcpy(snap.chartInterval, closedChartIntervals, sizeof(snap.chartInterval));
+    memcpy(snap.chartIntervalsClosed, chartIntervalsClosed, sizeof(snap.chartIntervalsClosed));
+    snap.capture = getPulseCaptureStats();
+    pulseSnapshotLock.publish(snap);
+    serialLinkSecond(snap.secondsClosed, lastSecondCounts, snap.totalCounts);
+    udpStreamSecond(snap.secondsClosed, lastSecondCounts, snap.totalCounts);
+}
+
+/**
+ * @brief Refreshes pulseStats from the latest snapshot; keeps the previous copy
+ *        if pulseTask was mid-publish on every attempt.
+ */
+static void refreshPulseStats() {
+    pulseSnapshotLock.read(pulseStats);
+}
+
+/**
+ * @brief Counts and closed seconds for the power benchmark (any task).
+ */
+static void powerBenchCounts(uint32_t* counts, uint32_t* seconds) {
+    PulseSnapshot snap;
+    memset(&snap, 0, sizeof(snap));
+    pulseSnapshotLock.read(snap);
+    *counts = snap.totalCounts;
+    *seconds = snap.secondsClosed;
+}
+
+/**
+ * @brief Before logger mode sleeps: saves the dose and writes out the history log.
+ */
+static void prepareLoggerSleep() {
+    doseCheckpointSave();
+    backgroundStoreSave();
+    flushHistoryLog();
+    // The logger task writes the buffered blocks; give it up to 2 s
+    for (uint8_t i = 0; i < 20 && getHistoryLogStats().buffered > 0; i++) {
+        vTaskDelay(pdMS_TO_TICKS(100));
+    }
+    debugLogFlush(200);
 }
 
 /*******************************************************************************
@@ -596,20 +1930,19 @@ int getRealTimeCPM() {
  */
 void clearCharts() {
     // Reset all buffers and accumulators
-    memset(chart1Buffer, 0, sizeof(chart1Buffer));
-    memset(chart3Buffer, 0, sizeof(chart3Buffer));
-    
-    chart1Index = 0;
-    chart3Index = 0;
-    chart1AccumulatedCpm = 0.0f;
-    chart3AccumulatedCpm = 0.0f;
-    chart1ElapsedSec = 0.0f;
-    chart3ElapsedSec = 0.0f;
+    xSemaphoreTake(chartDataMutex, portMAX_DELAY);
+    chart1History.clear();
+    chart3History.clear();
+    chartDataVersion++;
+    chart1Version++;
+    chart3Version++;
+    xSemaphoreGive(chartDataMutex);
     
     // Reset maximum values for dynamic scaling
     chart1MaxValue = 1.0f;
     chart3MaxValue = 1.0f;
     
+#if !HEADLESS
     // Clear LVGL chart objects if they exist
     if (chart1Series && ui_Chart1) {
         lv_chart_set_all_value(ui_Chart1, chart1Series, 0);
@@ -620,100 +1953,98 @@ void clearCharts() {
         lv_chart_set_all_value(ui_Chart3, chart3Series, 0);
         lv_chart_refresh(ui_Chart3);
     }
+#endif
+}
+
+/**
+ * @brief Dose rate (µSv/h) of a closed chart interval: its exact counts over
+ *        its live seconds, dead-time corrected.
+ */
+static float chartIntervalValue(const AlignedInterval& interval, const DeviceConfig& config) {
+    return correctDeadTimeCpm(interval.cps() * 60.0f, config.deadTimeSec) * config.usvHPerCpm;
 }
 
 /**
- * @brief Accumulates CPM values for chart intervals.
+ * @brief Takes the chart intervals pulseTask closed since the last pass.
  *
- * Called every loop() after real-time CPM is computed. When a chart interval
- * (3 minutes for Chart1 or 1 hour for Chart3) is reached, the average is computed,
- * stored in the corresponding ring buffer, and the chart is redrawn.
+ * Called every loop() after the pulse snapshot is copied. pulseTask closes the
+ * intervals (3 minutes for Chart1, 1 hour for Chart3) on UTC-aligned
+ * boundaries; each new one is stored in the corresponding ring buffer and its
+ * bar is updated. Closes are minutes apart, so the snapshot never skips one.
  *
- * @param cpm   Current counts per minute.
- * @param dtSec Time delta in seconds.
- */
-void accumulateCharts(float cpm, float dtSec) {
-    // Accumulate for Chart1 (1-hour chart with 3-minute intervals)
-    chart1AccumulatedCpm += (cpm * dtSec);
-    chart1ElapsedSec += dtSec;
-    
-    if (chart1ElapsedSec >= CHART1_INTERVAL_SECONDS) {
-        // Compute average CPM for this interval
-        float avgCpm = chart1AccumulatedCpm / chart1ElapsedSec;
-        float value = avgCpm / CONVERSION_FACTOR; // Convert to µSv/h
+ * @param config Configuration snapshot of this loop (conversion factor, dead time).
+ */
+void accumulateCharts(const DeviceConfig& config) {
+    static uint32_t chart1Taken = 0;
+    static uint32_t chart3Taken = 0;
+    
+    // Chart1 (1-hour chart with 3-minute intervals)
+    if (pulseStats.chartIntervalsClosed[CHART_INTERVAL_1H] != chart1Taken) {
+        chart1Taken = pulseStats.chartIntervalsClosed[CHART_INTERVAL_1H];
+        const AlignedInterval& interval = pulseStats.chartInterval[CHART_INTERVAL_1H];
+        float value = chartIntervalValue(interval, config);
         
-        // Store in buffer and update chart
-        if (chart1Index < CHART1_SEGMENTS) {
-            // Still filling the buffer with initial values
-            chart1Buffer[chart1Index] = value;
-            chart1Index++;
-        } else {
-            // Buffer is full, shift values left and add new value at the end
-            memmove(chart1Buffer, chart1Buffer + 1, (CHART1_SEGMENTS - 1) * sizeof(float));
-            chart1Buffer[CHART1_SEGMENTS - 1] = value;
-        }
+        // Store in the ring (evicts the oldest interval once full)
+        xSemaphoreTake(chartDataMutex, portMAX_DELAY);
+        chart1History.push(value);
+        chartDataVersion++;
+        chart1Version++;
+        xSemaphoreGive(chartDataMutex);
         
-        // Update max value for dynamic scaling
-        chart1MaxValue = 1.0f; // Reset to minimum
-        for (int i = 0; i < chart1Index; i++) {
-            if (chart1Buffer[i] > chart1MaxValue) {
-                chart1MaxValue = chart1Buffer[i];
+        // One telemetry record per closed 3-minute interval, stamped with its aligned start
+        DoseSnapshot dose = getDoseSnapshot();
+        telemetryRecord(interval.start, interval.utc, value, value * config.cpmPerUsvH, interval.liveSeconds,
+                        dose.averagesUsvH[RATE_EWMA_1H], dose.averagesUsvH[RATE_EWMA_24H]);
+        
+        // Rescale (full redraw) only when the maximum leaves the hysteresis
+        // band of the axis; otherwise only the new bar is redrawn. A hidden
+        // chart is drawn from the ring when it is shown.
+        float axisMax = chartAxisTop(chart1MaxValue, chart1History.max());
+        bool rescale = axisMax != chart1MaxValue;
+        chart1MaxValue = axisMax;
+#if !HEADLESS
+        if (uiScreenShown(UI_SCREEN_CHARTS1H)) {
+            if (rescale) {
+                drawChart1();
+            } else {
+                pushChartPoint(ui_Chart1, chart1Series, chart1History);
             }
         }
-        
-        // Add 20% headroom to max value and round to next whole number
-        chart1MaxValue = ceil(chart1MaxValue * 1.2f);
-        if (chart1MaxValue < 1.0f) chart1MaxValue = 1.0f;
-        
-        // Draw updated chart
-        drawChart1();
-        
-        // Reset accumulators for next interval
-        chart1AccumulatedCpm = 0.0f;
-        chart1ElapsedSec = 0.0f;
+#else
+        (void)rescale;
+#endif
     }
     
-    // Accumulate for Chart3 (24-hour chart with 1-hour intervals)
-    chart3AccumulatedCpm += (cpm * dtSec);
-    chart3ElapsedSec += dtSec;
-    
-    if (chart3ElapsedSec >= CHART3_INTERVAL_SECONDS) {
-        // Compute average CPM for this interval
-        float avgCpm = chart3AccumulatedCpm / chart3ElapsedSec;
-        float value = avgCpm / CONVERSION_FACTOR; // Convert to µSv/h
+    // Chart3 (24-hour chart with 1-hour intervals)
+    if (pulseStats.chartIntervalsClosed[CHART_INTERVAL_24H] != chart3Taken) {
+        chart3Taken = pulseStats.chartIntervalsClosed[CHART_INTERVAL_24H];
+        float value = chartIntervalValue(pulseStats.chartInterval[CHART_INTERVAL_24H], config);
         
-        // Store in buffer and update chart
-        if (chart3Index < CHART3_SEGMENTS) {
-            // Still filling the buffer with initial values
-            chart3Buffer[chart3Index] = value;
-            chart3Index++;
-        } else {
-            // Buffer is full, shift values left and add new value at the end
-            memmove(chart3Buffer, chart3Buffer + 1, (CHART3_SEGMENTS - 1) * sizeof(float));
-            chart3Buffer[CHART3_SEGMENTS - 1] = value;
-        }
+        // Store in the ring (evicts the oldest interval once full)
+        xSemaphoreTake(chartDataMutex, portMAX_DELAY);
+        chart3History.push(value);
+        chartDataVersion++;
+        chart3Version++;
+        xSemaphoreGive(chartDataMutex);
         
-        // Update max value for dynamic scaling
-        chart3MaxValue = 1.0f; // Reset to minimum
-        for (int i = 0; i < chart3Index; i++) {
-            if (chart3Buffer[i] > chart3MaxValue) {
-                chart3MaxValue = chart3Buffer[i];
+        float axisMax = chartAxisTop(chart3MaxValue, chart3History.max());
+        bool rescale = axisMax != chart3MaxValue;
+        chart3MaxValue = axisMax;
+#if !HEADLESS
+        if (uiScreenShown(UI_SCREEN_CHARTS24H)) {
+            if (rescale) {
+                drawChart3();
+            } else {
+                pushChartPoint(ui_Chart3, chart3Series, chart3History);
             }
         }
-        
-        // Add 20% headroom to max value and round to next whole number
-        chart3MaxValue = ceil(chart3MaxValue * 1.2f);
-        if (chart3MaxValue < 1.0f) chart3MaxValue = 1.0f;
-        
-        // Draw updated chart
-        drawChart3();
-        
-        // Reset accumulators for next interval
-        chart3AccumulatedCpm = 0.0f;
-        chart3ElapsedSec = 0.0f;
+#else
+        (void)rescale;
+#endif
     }
 }
 
+#if !HEADLESS
 /**
  * @brief Updates the Y-axis scale of a chart based on the maximum value.
  * 
@@ -769,6 +2100,17 @@ void updateChartYAxis(lv_obj_t* chart, lv_chart_series_t* series, float maxValue
                  maxValue, scaledMax, majorTicks, minorTicks);
 }
 
+/**
+ * @brief Chart position of the newest interval, or -1 if there is none. The
+ *        positions follow the ring storage, so a closing interval replaces
+ *        one bar in place instead of shifting all of them.
+ */
+static int32_t newestChartPoint(lv_obj_t* chart) {
+    if (chart == ui_Chart1 && !chart1History.empty()) return (chart1History.pushCount() - 1) % CHART1_SEGMENTS;
+    if (chart == ui_Chart3 && !chart3History.empty()) return (chart3History.pushCount() - 1) % CHART3_SEGMENTS;
+    return -1;
+}
+
 /**
  * @brief Event callback for chart drawing to handle custom axis labels.
  * 
@@ -778,9 +2120,18 @@ void updateChartYAxis(lv_obj_t* chart, lv_chart_series_t* series, float maxValue
 static void chart_draw_event_cb(lv_event_t * e) {
     lv_obj_t * chart = lv_event_get_target(e);
     lv_obj_draw_part_dsc_t * dsc = lv_event_get_draw_part_dsc(e);
+    if(!dsc) return;
+    
+    // The bars wrap around (circular update mode); the newest one is lighter
+    if(dsc->type == LV_CHART_DRAW_PART_BAR && dsc->rect_dsc) {
+        if((int32_t)dsc->id == newestChartPoint(chart)) {
+            dsc->rect_dsc->bg_color = lv_color_lighten(dsc->rect_dsc->bg_color, LV_OPA_50);
+        }
+        return;
+    }
     
     // Only process axis tick drawing
-    if(!dsc || dsc->type != LV_CHART_DRAW_PART_TICK_LABEL) return;
+    if(dsc->type != LV_CHART_DRAW_PART_TICK_LABEL) return;
     
     // Only process y-axis labels
     if(dsc->id != LV_CHART_AXIS_PRIMARY_Y || !dsc->text) return;
@@ -790,356 +2141,783 @@ static void chart_draw_event_cb(lv_event_t * e) {
     float realValue = (float)value / CHART_SCALE_FACTOR;
     
     // Format the label with 1 decimal place
-    snprintf(dsc->text, dsc->text_length, "%.1f", realValue);
+    formatFixed<1>(dsc->text, dsc->text_length, realValue);
 }
 
+#endif // !HEADLESS
+
 /**
- * @brief Initialize the chart system with proper settings.
+ * @brief Resets the chart data. The LVGL charts are set up by setupChart()
+ *        when their screens are built.
  */
 void assignChartSeries() {
-    // Get the chart series pointers
-    chart1Series = lv_chart_get_series_next(ui_Chart1, NULL);
-    chart3Series = lv_chart_get_series_next(ui_Chart3, NULL);
-    
-    if (!chart1Series)
-        DEBUG_PRINTLN("Warning: ui_Chart1 has no series!");
-    if (!chart3Series)
-        DEBUG_PRINTLN("Warning: ui_Chart3 has no series!");
-    
     // Reset maximum values for dynamic scaling
     chart1MaxValue = 1.0f;
     chart3MaxValue = 1.0f;
     
-    // Configure Chart1 (1-hour chart with 3-minute intervals)
-    if (ui_Chart1) {
-        // First, reset the chart completely
-        lv_chart_remove_series(ui_Chart1, chart1Series);
-        chart1Series = lv_chart_add_series(ui_Chart1, lv_color_hex(0x89DE10), LV_CHART_AXIS_PRIMARY_Y);
-        
-        // Set chart type and point count before setting range
-        lv_chart_set_type(ui_Chart1, LV_CHART_TYPE_BAR);
-        lv_chart_set_point_count(ui_Chart1, CHART1_SEGMENTS);
-        lv_chart_set_div_line_count(ui_Chart1, 5, 5);
-        
-        // Set initial Y range (will be updated dynamically later)
-        // Apply the scale factor for integer representation
-        updateChartYAxis(ui_Chart1, chart1Series, chart1MaxValue);
-        
-        // Add event handler for custom axis labels
-        lv_obj_add_event_cb(ui_Chart1, chart_draw_event_cb, LV_EVENT_DRAW_PART_BEGIN, NULL);
-        
-        // Initialize all data points to zero
-        for (int i = 0; i < CHART1_SEGMENTS; i++) {
-            lv_chart_set_value_by_id(ui_Chart1, chart1Series, i, 0);
-        }
-        
-        // Improve bar appearance
-        lv_obj_set_style_size(ui_Chart1, 0, LV_PART_INDICATOR);
-    }
+    // Initialize all data structures with zeros
+    xSemaphoreTake(chartDataMutex, portMAX_DELAY);
+    chart1History.clear();
+    chart3History.clear();
+    xSemaphoreGive(chartDataMutex);
     
-    // Configure Chart3 (24-hour chart with 1-hour intervals)
-    if (ui_Chart3) {
-        // First, reset the chart completely
-        lv_chart_remove_series(ui_Chart3, chart3Series);
-        chart3Series = lv_chart_add_series(ui_Chart3, lv_color_hex(0xE0C810), LV_CHART_AXIS_PRIMARY_Y);
-        
-        // Set chart type and point count before setting range
-        lv_chart_set_type(ui_Chart3, LV_CHART_TYPE_BAR);
-        lv_chart_set_point_count(ui_Chart3, CHART3_SEGMENTS);
-        lv_chart_set_div_line_count(ui_Chart3, 5, 5);
-        
-        // Set initial Y range (will be updated dynamically later)
-        // Apply the scale factor for integer representation
-        updateChartYAxis(ui_Chart3, chart3Series, chart3MaxValue);
-        
-        // Add event handler for custom axis labels
-        lv_obj_add_event_cb(ui_Chart3, chart_draw_event_cb, LV_EVENT_DRAW_PART_BEGIN, NULL);
-        
-        // Initialize all data points to zero
-        for (int i = 0; i < CHART3_SEGMENTS; i++) {
-            lv_chart_set_value_by_id(ui_Chart3, chart3Series, i, 0);
-        }
-        
-        // Improve bar appearance
-        lv_obj_set_style_size(ui_Chart3, 0, LV_PART_INDICATOR);
-    }
+    DEBUG_PRINTLN("Chart data initialized with dynamic Y-axis scaling.");
+}
+
+#if !HEADLESS
+/**
+ * @brief Replaces the SquareLine series of a freshly built chart with a bar
+ *        series of @p points zeroed points; drawChart1/3() fill it afterwards.
+ * @return the new series
+ */
+static lv_chart_series_t* setupChart(lv_obj_t* chart, uint16_t points, lv_color_t color, float maxValue) {
+    // First, reset the chart completely
+    lv_chart_series_t* series = lv_chart_get_series_next(chart, NULL);
+    if (series) lv_chart_remove_series(chart, series);
+    series = lv_chart_add_series(chart, color, LV_CHART_AXIS_PRIMARY_Y);
     
-    // Initialize all data structures with zeros
-    memset(chart1Buffer, 0, sizeof(chart1Buffer));
-    memset(chart3Buffer, 0, sizeof(chart3Buffer));
+    // Set chart type and point count before setting range
+    lv_chart_set_type(chart, LV_CHART_TYPE_BAR);
+    lv_chart_set_point_count(chart, points);
+    lv_chart_set_update_mode(chart, LV_CHART_UPDATE_MODE_CIRCULAR); // Single bars invalidate only their column
+    lv_chart_set_div_line_count(chart, 5, 5);
+    
+    // Y range from the current maximum (updated dynamically later); the scale
+    // factor gives the integer representation
+    updateChartYAxis(chart, series, maxValue);
     
-    chart1Index = 0;
-    chart3Index = 0;
-    chart1AccumulatedCpm = 0.0f;
-    chart3AccumulatedCpm = 0.0f;
-    chart1ElapsedSec = 0.0f;
-    chart3ElapsedSec = 0.0f;
+    // Add event handler for custom axis labels
+    lv_obj_add_event_cb(chart, chart_draw_event_cb, LV_EVENT_DRAW_PART_BEGIN, NULL);
     
-    // Refresh the charts to apply changes
-    if (ui_Chart1) lv_chart_refresh(ui_Chart1);
-    if (ui_Chart3) lv_chart_refresh(ui_Chart3);
+    // Initialize all data points to zero
+    lv_chart_set_all_value(chart, series, 0);
     
-    DEBUG_PRINTLN("Chart series assigned and initialized with dynamic Y-axis scaling.");
+    // Improve bar appearance
+    lv_obj_set_style_size(chart, 0, LV_PART_INDICATOR);
+    return series;
+}
+
+/**
+ * @brief Writes every retained interval of @p history to its bar position and
+ *        repaints the chart once.
+ */
+template <size_t N>
+static void fillChart(lv_obj_t* chart, lv_chart_series_t* series, const RingHistory<float, N>& history) {
+    lv_coord_t* points = lv_chart_get_y_array(chart, series);
+    for (size_t i = 0; i < N; i++) points[i] = 0;
+    uint32_t oldest = history.pushCount() - (uint32_t)history.size();
+    for (size_t i = 0; i < history.size(); i++) {
+        // Scale the float value to an integer for the chart
+        points[(oldest + i) % N] = (lv_coord_t)(history[i] * CHART_SCALE_FACTOR);
+    }
+    lv_chart_refresh(chart);
+}
+
+/**
+ * @brief Writes the newest interval of @p history into its bar. Only that
+ *        column and the previously newest one (highlight) are invalidated.
+ */
+template <size_t N>
+static void pushChartPoint(lv_obj_t* chart, lv_chart_series_t* series, const RingHistory<float, N>& history) {
+    if (!chart || !series || history.empty()) return;
+    uint16_t newest = (history.pushCount() - 1) % N;
+    lv_chart_set_value_by_id(chart, series, newest, (lv_coord_t)(history.newest() * CHART_SCALE_FACTOR));
+    if (history.size() > 1) {
+        uint16_t previous = (newest + N - 1) % N;
+        lv_chart_set_value_by_id(chart, series, previous, lv_chart_get_y_array(chart, series)[previous]);
+    }
 }
 
 /**
- * @brief Draws Chart1 using the current ring buffer values.
+ * @brief Redraws Chart1 completely (axis and every bar) from the ring buffer.
  */
 void drawChart1() {
     if (!chart1Series || !ui_Chart1) return;
-    
-    // First, update the Y-axis range to fit the data
     updateChartYAxis(ui_Chart1, chart1Series, chart1MaxValue);
-    
-    // Clear the chart first 
-    for (int i = 0; i < CHART1_SEGMENTS; i++) {
-        lv_chart_set_value_by_id(ui_Chart1, chart1Series, i, 0);
-    }
-    
-    // Only set values if we have collected data
-    if (chart1Index > 0) {
-        // Set values from our buffer
-        for (int i = 0; i < chart1Index; i++) {
-            float value = chart1Buffer[i];
-            // Scale the float value to an integer for the chart
-            lv_coord_t scaledValue = (lv_coord_t)(value * CHART_SCALE_FACTOR);
-            lv_chart_set_value_by_id(ui_Chart1, chart1Series, i, scaledValue);
-        }
-    }
-    
-    // Refresh the chart display
-    lv_chart_refresh(ui_Chart1);
+    fillChart(ui_Chart1, chart1Series, chart1History);
 }
 
 /**
- * @brief Draws Chart3 using the current ring buffer values.
+ * @brief Redraws Chart3 completely (axis and every bar) from the ring buffer.
  */
 void drawChart3() {
     if (!chart3Series || !ui_Chart3) return;
-    
-    // First, update the Y-axis range to fit the data
     updateChartYAxis(ui_Chart3, chart3Series, chart3MaxValue);
-    
-    // Clear the chart first
-    for (int i = 0; i < CHART3_SEGMENTS; i++) {
-        lv_chart_set_value_by_id(ui_Chart3, chart3Series, i, 0);
+    fillChart(ui_Chart3, chart3Series, chart3History);
+}
+
+#endif // !HEADLESS
+
+/*******************************************************************************
+ * Core-specific Task Functions
+ ******************************************************************************/
+/**
+ * @brief One PCNT reading of the sampling task, handed to pulseTask.
+ */
+struct PulseSample {
+    uint32_t ms;       ///< millis() of the reading, the bucket clock
+    uint32_t count;    ///< readPulseCount32()
+    uint32_t highCount; ///< High-range tube's count (COUNTER_CHANNELS > 1)
+    uint32_t us;       ///< esp_timer of the reading, for the hand-over latency
+};
+
+// 32 readings cover 1.6 s of pulseTask being held off
+static SpscRing<PulseSample, 32> pulseSamples;
+static LatencyHistogram sampleJitter;      ///< Sampling task wake-up past its deadline
+static LatencyHistogram processLatency;    ///< Reading to pulseTask processing it
+static volatile bool latencyResetPending = false; ///< Set by pulseTask, cleared by the sampling task
+static bool pulsesInjected = false;        ///< pulseTask: the pulse injector is running, dose on hold
+static uint32_t sampleWakeEvents = 0;      ///< Readings woken by the PCNT limit (PULSE_EVENT_WAKE)
+static uint32_t sampleWakeTicks = 0;       ///< ... by the bucket deadline or the fixed period
+
+/**
+ * @brief Replays a PulseSample through the accumulator as if read right now.
+ */
+class SampleMeasurementHal : public MeasurementHal {
+public:
+    PulseSample sample;
+    uint32_t nowMs() override { return sample.ms; }
+    uint32_t pulseCount() override { return sample.count; }
+};
+
+/**
+ * @brief Capture stage: reads PCNT and nothing else.
+ *
+ * With PULSE_EVENT_WAKE it sleeps until the PCNT limit event (every
+ * PULSE_EVENT_COUNTS pulses) or the close of the 1-second bucket, and reads at
+ * most every PULSE_POLL_MS; otherwise it reads every PULSE_POLL_MS. Jitter is
+ * measured on the timed readings only.
+ *
+ * Runs at PULSE_SAMPLE_PRIORITY on TASK_CORE_MEASUREMENT, away from the WiFi and
+ * lwIP tasks, so the readings (and with them the 1-second buckets) keep their
+ * cadence while the network is busy. The PCNT overflow ISR and the per-pulse
+ * capture ISR are installed from here and so serviced on the same core.
+ */
+/**
+ * @brief Capture ISR hook: the click and the search ring, both IRAM.
+ */
+static void IRAM_ATTR onCaptureIsr(uint32_t timestampUs) {
+    alarmClickFromIsr(timestampUs);
+    searchModeFromIsr(timestampUs);
+}
+
+void pulseSampleTask(void *parameter) {
+    initPulseCounter();
+
+    if (PULSE_CAPTURE_ENABLED) {
+        // Audible clicks and the search tone's pulse times come straight from the capture ISR
+        if (initPulseCapture(GEIGER_PULSE_PIN)) pulseCaptureSetIsrHook(onCaptureIsr);
+    }
+    if (PULSE_WIDTH_ENABLED) initPulseWidth(GEIGER_PULSE_PIN);
+    // Shares the PCNT ISR service installed above, on this core
+    if (SCALER_GATE_PIN >= 0 && !initScaler(GEIGER_PULSE_PIN, PULSE_WIDTH_PCNT_FILTER_CYCLES)) {
+        DEBUG_PRINTLN("WARNING: Scaler not available");
     }
+    bootReportCountingStarted();
     
-    // Only set values if we have collected data
-    if (chart3Index > 0) {
-        // Set values from our buffer
-        for (int i = 0; i < chart3Index; i++) {
-            float value = chart3Buffer[i];
-            // Scale the float value to an integer for the chart
-            lv_coord_t scaledValue = (lv_coord_t)(value * CHART_SCALE_FACTOR);
-            lv_chart_set_value_by_id(ui_Chart3, chart3Series, i, scaledValue);
+    // Not restartable: the counter and its ISRs belong to this task; a stall reboots
+    supervisorAttach("sample", SUPERVISOR_PULSE_STALL_MS, nullptr);
+    DEBUG_PRINTF("Pulse sampling task started on Core %d\n", xPortGetCoreID());
+
+#if !PULSE_EVENT_WAKE
+    const TickType_t period = pdMS_TO_TICKS(PULSE_POLL_MS);
+    TickType_t lastWake = xTaskGetTickCount();
+#endif
+    int64_t deadlineUs = esp_timer_get_time();
+    uint32_t bucketStartMs = millis(); ///< Mirrors PulseAccumulator: a bucket closes 1000 ms after the last close
+    bool onDeadline = true;            ///< This reading was due at deadlineUs (not woken by pulses)
+    while (true) {
+        PulseSample sample;
+        sample.count = readPulseCount32();
+        sample.highCount = COUNTER_CHANNELS > 1 ? counterChannels[HIGH_RANGE_CHANNEL].read32() : 0;
+        sample.ms = millis();
+        int64_t nowUs = esp_timer_get_time();
+        sample.us = (uint32_t)nowUs;
+        pulseSamples.push(sample);
+        xTaskNotifyGive(pulseTaskHandle);
+
+        if (latencyResetPending) {
+            sampleJitter.reset();
+            latencyResetPending = false;
+        }
+        if (onDeadline) sampleJitter.add(nowUs > deadlineUs ? (uint32_t)(nowUs - deadlineUs) : 0);
+        supervisorHeartbeat();
+
+#if PULSE_EVENT_WAKE
+        // Sleep until PULSE_EVENT_COUNTS more pulses or the end of the bucket;
+        // one tick more, so the bucket has surely closed when the wait times out
+        if (sample.ms - bucketStartMs >= 1000) bucketStartMs = sample.ms;
+        int32_t dueMs = (int32_t)(bucketStartMs + 1000 - millis());
+        if (dueMs < 0) dueMs = 0;
+        deadlineUs = esp_timer_get_time() + dueMs * 1000LL;
+        onDeadline = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(dueMs) + 1) == 0;
+        if (onDeadline) {
+            sampleWakeTicks++;
+        } else {
+            // A high rate: no more readings than polling would take
+            sampleWakeEvents++;
+            uint32_t sinceMs = millis() - sample.ms;
+            if (sinceMs < PULSE_POLL_MS) vTaskDelay(pdMS_TO_TICKS(PULSE_POLL_MS - sinceMs));
         }
+#else
+        // Fixed cadence; after a missed period the deadline starts over from now
+        vTaskDelayUntil(&lastWake, period);
+        sampleWakeTicks++;
+        deadlineUs += PULSE_POLL_MS * 1000LL;
+        if (esp_timer_get_time() - deadlineUs > PULSE_POLL_MS * 1000LL) deadlineUs = esp_timer_get_time();
+#endif
     }
-    
-    // Refresh the chart display
-    lv_chart_refresh(ui_Chart3);
 }
 
-/*******************************************************************************
- * WiFi Connection Helper
- ******************************************************************************/ 
-bool connectToWiFi(const char* ssid, const char* password) {
-    WiFi.mode(WIFI_STA);
-    WiFi.begin(ssid, password);
-    const int max_attempts = 20;
-    int attempts = 0;
-    while (WiFi.status() != WL_CONNECTED && attempts < max_attempts) {
-        delay(500);
-        attempts++;
+/**
+ * @brief Applies the commands queued for pulseTask (serial and web), in order.
+ */
+static void applyPulseCommands() {
+    Command cmd;
+    while (commandReceive(COMMAND_TARGET_PULSE, cmd)) {
+        switch (cmd.type) {
+            case COMMAND_SET_COINCIDENCE:
+                if (cmd.arg.coincidence.windowUs) coincidenceGate.setWindow(cmd.arg.coincidence.windowUs);
+                coincidenceMode = cmd.arg.coincidence.mode <= COINCIDENCE_REQUIRE ? cmd.arg.coincidence.mode
+                                                                                   : COINCIDENCE_OFF;
+                break;
+            case COMMAND_RESET_LATENCY:
+                // The jitter histogram is the sampling task's
+                processLatency.reset();
+                latencyResetPending = true;
+                break;
+            case COMMAND_RESET_PULSE_WIDTH:
+                resetPulseWidthStats();
+                break;
+            case COMMAND_SET_INJECTING:
+                pulsesInjected = cmd.arg.injecting;
+                break;
+            case COMMAND_RESET_TUBE_HEALTH:
+                tubeHealthReset();
+                break;
+            case COMMAND_RESET_ANOMALY:
+                anomalyReset();
+                break;
+            default:
+                break;
+        }
     }
-    return (WiFi.status() == WL_CONNECTED);
 }
 
-/*******************************************************************************
- * Core-specific Task Functions
- ******************************************************************************/
+/**
+ * @brief Processing stage: accumulates the readings, feeds the stores, bins the
+ *        spectrum and evaluates the alarms.
+ *
+ * Woken by each reading; it runs below the sampling task, so a slow pass delays
+ * only its own work. The readings carry their time, so the buckets do not
+ * depend on when this task gets to them.
+ */
 void pulseTask(void *parameter) {
-    // Configure PCNT for this core
-    pcnt_config_t pcnt_config = {};
-    pcnt_config.pulse_gpio_num = GEIGER_PULSE_PIN;
-    pcnt_config.ctrl_gpio_num  = PCNT_PIN_NOT_USED;
-    pcnt_config.channel        = PCNT_CHANNEL_0;
-    pcnt_config.unit           = PCNT_UNIT;
-    pcnt_config.pos_mode       = PCNT_COUNT_INC;
-    pcnt_config.neg_mode       = PCNT_COUNT_DIS;
-    pcnt_config.lctrl_mode     = PCNT_MODE_KEEP;
-    pcnt_config.hctrl_mode     = PCNT_MODE_KEEP;
-    pcnt_config.counter_h_lim  = 32767;
-    pcnt_config.counter_l_lim  = 0;
-
-    pcnt_unit_config(&pcnt_config);
-    pcnt_set_filter_value(PCNT_UNIT, 10);
-    pcnt_filter_enable(PCNT_UNIT);
-    pcnt_counter_pause(PCNT_UNIT);
-    pcnt_counter_clear(PCNT_UNIT);
-    pcnt_counter_resume(PCNT_UNIT);
-
-    DEBUG_PRINTLN("Pulse counting task started on Core 0");
-
-    int16_t lastCount = 0;
-    const TickType_t xDelay = pdMS_TO_TICKS(50); // 50ms polling interval
+    supervisorAttach("pulse", SUPERVISOR_PULSE_STALL_MS, nullptr);
+    DEBUG_PRINTF("Pulse processing task started on Core %d\n", xPortGetCoreID());
+
+    SampleMeasurementHal hal;
+    bool started = false;
 
     while (true) {
-        int16_t currentCount = 0;
-        pcnt_get_counter_value(PCNT_UNIT, &currentCount);
-        
-        int16_t diff = currentCount - lastCount;
-        if (diff < 0) diff = 0; // Handle counter wrap-around
-        
-        // Debug significant pulse activity
-        if (diff > 5) {
-            DEBUG_PRINTF("Pulse burst: %d counts detected\n", diff);
-        }
-        
-        // Store in ring buffer with mutex protection
-        if (xSemaphoreTake(dataMutex, portMAX_DELAY)) {
-            pulseBuffer[pulseBufferIndex].count = diff;
-            pulseBuffer[pulseBufferIndex].timestamp = millis();
+        // Each reading wakes it; the timeout is only a backstop
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(PULSE_EVENT_WAKE ? 2000 : PULSE_POLL_MS * 4));
+        supervisorHeartbeat();
+        TRACE_EVENT(TRACE_PULSE_POLL_BEGIN, 0, 0);
+        applyPulseCommands();
+        pulseRecorderPoll(millis());
+
+        bool secondClosed = false;
+        uint32_t pollCounts = 0;
+        while (pulseSamples.pop(hal.sample)) {
+            processLatency.add((uint32_t)esp_timer_get_time() - hal.sample.us);
+            // With a high-range tube the pipeline counts whichever tube the range picks
+            if (COUNTER_CHANNELS > 1) {
+                if (!started) counterRange.begin(hal.sample.count, hal.sample.highCount);
+                hal.sample.count = counterRange.merge(hal.sample.count, hal.sample.highCount);
+            }
+            // Recorded as the pipeline consumes it, so a replay sees the same input
+            pulseRecorderSample(hal.sample.ms, hal.sample.count);
+            // The first reading is the reference (PCNT was cleared before it)
+            if (!started) {
+                pulseAccumulator.begin(hal);
+                started = true;
+                continue;
+            }
+            // Monotonic 32-bit count: PCNT wraps are accounted for by the overflow epoch
+            bool closed = false;
+            uint32_t diff = pulseAccumulator.poll(hal, &closed);
+            pollCounts += diff;
             
-            // Also maintain the traditional pulse history for compatibility with existing code
-            // and to ensure we have a full minute of data for accurate CPM
-            static unsigned long lastSecondTimestamp = 0;
-            static int currentSecondAccumulator = 0;
+            // Significant pulse activity goes to the trace; printing here would skew the poll timing
+            if (diff > 5) {
+                TRACE_EVENT(TRACE_PULSE_BURST, diff, 0);
+            }
             
-            // Add to current second accumulator
-            currentSecondAccumulator += diff;
+            // Store in ring buffer; this state is private to pulseTask
+            pulseBuffer[pulseBufferIndex].count = diff;
+            pulseBuffer[pulseBufferIndex].timestamp = hal.sample.ms;
+            pulseBufferIndex = (pulseBufferIndex + 1) % PULSE_BUFFER_SIZE;
             
-            // If we've passed a second boundary, update the pulse history
-            unsigned long now = millis();
-            if (now - lastSecondTimestamp >= 1000) {
-                pulseHistory[pulseHistoryIndex] = currentSecondAccumulator;
-                pulseHistoryIndex = (pulseHistoryIndex + 1) % PULSE_HISTORY_SIZE;
-                totalCounts += currentSecondAccumulator;
-                
-                // Debug output for high pulse counts
-                if (currentSecondAccumulator > 10) {
-                    DEBUG_PRINTF("High pulse count: %d counts in last second\n", currentSecondAccumulator);
+            // A second closed: the rate windows have the bucket, now the stores and the snapshot
+            if (closed) {
+                secondClosed = true;
+                uint32_t secondCounts = pulseAccumulator.lastSecondCounts();
+                uint32_t nowSeconds = hal.sample.ms / 1000;
+                historyStore.addSecond(nowSeconds, secondCounts);
+                // Counting starts before the SD log is mounted; the boot flag goes
+                // on the first record the log takes
+                static bool firstLogRecord = true;
+                uint16_t logFlags = (firstLogRecord ? LOG_FLAG_BOOT : 0) | (pulsesInjected ? LOG_FLAG_INJECTED : 0);
+                if (logHistoryRecord(nowSeconds, secondCounts, 1, logFlags)) {
+                    firstLogRecord = false;
+                }
+                totalCounts = pulseAccumulator.totalCounts();
+                DeviceConfig config = getDeviceConfig();
+                if (COUNTER_CHANNELS > 1) {
+                    counterRange.configure(config.deadTimeSec, HighRangeTube::DEAD_TIME_US * 1e-6f,
+                                           config.usvHPerCpm > 0.0f
+                                               ? 1.0f / (HighRangeTube::CPM_PER_USVH * config.usvHPerCpm) : 1.0f);
+                    if (counterRange.closeSecond()) {
+                        TRACE_EVENT(TRACE_PULSE_RANGE, counterRange.highRange(), 0);
+                    }
+                    for (uint8_t c = 0; c < COUNTER_CHANNELS; c++) {
+                        channelWindows[c].push(counterRange.lastSecondCounts(c));
+                    }
                 }
-                
-                currentSecondAccumulator = 0;
-                lastSecondTimestamp = now;
+                // Injected test pulses are no dose
+                if (!pulsesInjected) {
+                    doseAccumulator.addSecond(secondCounts, config.deadTimeSec, config.usvHPerCpm);
+                    doseAccumulatorLock.publish(doseAccumulator);
+                    gpsSurveySecond(nowSeconds, hal.sample.ms, secondCounts, config.deadTimeSec, config.usvHPerCpm);
+                }
+                tubeHealthSecond(secondCounts, pulsesInjected);
+                anomalyCaptureSecond(secondCounts, pulsesInjected, hal.sample.ms);
+                if (!pulsesInjected) rateEwma.addSecond(secondCounts);
+                // Same buckets as the adaptive window, injected seconds included
+                rateEstimators.addSecond(secondCounts, estimatorCycles);
+                // Chart intervals close on UTC boundaries; injected seconds are not live time
+                for (uint8_t i = 0; i < CHART_INTERVAL_COUNT; i++) {
+                    if (chartIntervalCounters[i].addSecond(nowSeconds, timeBaseUtcAt(nowSeconds), secondCounts,
+                                                           !pulsesInjected, &closedChartIntervals[i])) {
+                        chartIntervalsClosed[i]++;
+                    }
+                }
+                publishPulseSnapshot(secondCounts);
+                TRACE_EVENT(TRACE_PULSE_SECOND, secondCounts, 0);
             }
-            
-            pulseBufferIndex = (pulseBufferIndex + 1) % PULSE_BUFFER_SIZE;
-            xSemaphoreGive(dataMutex);
         }
         
-        lastCount = currentCount;
-        vTaskDelay(xDelay);
+        // Drain per-pulse timestamps captured by the ISR since the last poll. Every
+        // Geiger pulse stamped before the watermark is in the ring by now.
+        uint32_t watermarkUs = (uint32_t)esp_timer_get_time();
+        if (pulseCaptureActive()) {
+            drainPulseCapture(onGeigerTimestamp, nullptr);
+        }
+        drainPulseWidths();
+        coincidenceGate.setWatermark(watermarkUs);
+        binSpectrumEvents();
+        if (secondClosed) {
+            // Spectral dose against the GM rate of the same minute
+            DeviceConfig config = getDeviceConfig();
+            spectrumDoseCloseSecond(correctDeadTimeCpm(pulseHistory.cpm(RATE_WINDOW_60S), config.deadTimeSec) *
+                                    config.usvHPerCpm);
+        }
+        
+        // Alarm evaluation lives here, next to the counts, not in the UI loop
+        checkAlarms(secondClosed);
+        if (secondClosed) uiWakeNotify(UI_WAKE_DATA); // Snapshot and alarm status are published
+        TRACE_EVENT(TRACE_PULSE_POLL_END, pollCounts, 0);
     }
 }
 
-void uiTask(void *parameter) {
-    const TickType_t xDelay = pdMS_TO_TICKS(50); // 50ms UI update interval
-    unsigned long lastTimeUpdate = 0;
-    
-    DEBUG_PRINTLN("UI task started on Core 1");
-    
-    // Give UI components time to initialize fully
-    vTaskDelay(pdMS_TO_TICKS(500));
-    
-    // Load alarm settings once UI is fully initialized
-    DEBUG_PRINTLN("UI task: Loading alarm settings now that UI is fully initialized");
-    
-    // Load spinbox values from preferences
-    preferences.begin("settings", true);
-    
-    // Get alarm thresholds with proper defaults
-    int32_t currentValue = preferences.getInt("currentAlarm", 50);  // Default 5.0 µSv/h
-    int32_t cumulativeValue = preferences.getInt("cumulativeAlarm", 10);  // Default 1.0 mSv
-    
-    // Get alarm enabled state again (redundant but safer)
-    bool alarmEnabled = preferences.getBool("alarmEnabled", false);
-    
-    preferences.end();
-    
-    DEBUG_PRINTF("UI task: Loaded alarm values: Current=%d, Cumulative=%d, Enabled=%s\n", 
-                 currentValue, cumulativeValue, alarmEnabled ? "true" : "false");
-    
-    // Set spinbox values
-    lv_spinbox_set_value(ui_CurrentSpinbox, currentValue);
-    lv_spinbox_set_value(ui_CumulativeSpinbox, cumulativeValue);
-    
-    // Ensure alarm checkbox state is properly set
-    if (alarmEnabled) {
-        DEBUG_PRINTLN("UI task: Setting alarm checkbox to CHECKED state");
-        lv_obj_add_state(ui_EnableAlarmsCheckbox, LV_STATE_CHECKED);
-        alarmDisabled = false;
+static void printLatencyHistogram(Print& out, const char* name, const LatencyHistogram& h) {
+    out.printf("  %-8s %lu samples, mean %lu us, p50 <%lu us, p99 <%lu us, max %lu us\n    ", name,
+               (unsigned long)h.count(), (unsigned long)h.meanUs(), (unsigned long)h.percentileUs(500),
+               (unsigned long)h.percentileUs(990), (unsigned long)h.maxUs());
+    for (uint8_t b = 0; b < LatencyHistogram::BUCKETS; b++) {
+        if (h.bucket(b)) out.printf("<%lu:%lu ", 2UL << b, (unsigned long)h.bucket(b));
+    }
+    out.println();
+}
+
+/**
+ * @brief "latency": how late the PCNT readings are taken and how long they wait
+ *        for pulseTask, with the task placement. "latency reset" starts over.
+ */
+static void printPulseLatency(Print& out) {
+    if (PULSE_EVENT_WAKE) {
+        out.printf("Pulse pipeline: sampling every %u pulses or 1 s (at most every %u ms)", (unsigned)PULSE_EVENT_COUNTS,
+                   (unsigned)PULSE_POLL_MS);
     } else {
-        DEBUG_PRINTLN("UI task: Setting alarm checkbox to UNCHECKED state");
-        lv_obj_clear_state(ui_EnableAlarmsCheckbox, LV_STATE_CHECKED);
-        alarmDisabled = true;
+        out.printf("Pulse pipeline: sampling every %u ms", (unsigned)PULSE_POLL_MS);
     }
-    
-    // Force LVGL to process all UI updates
-    lv_timer_handler();
-    
-    while (true) {
-        // Process LVGL tasks
-        lv_timer_handler();
-        
-        // Check for serial commands
-        processSerialCommands();
-        
-        unsigned long now = millis();
-        
-        // Update radiation data with mutex protection
-        if (xSemaphoreTake(dataMutex, portMAX_DELAY)) {
-            // Use the traditional pulse history which tracks a full minute
-            // This ensures we have the correct CPM calculation
-            int cpm = getRealTimeCPM();
-            
-            // Calculate time delta since last update
-            static unsigned long lastUpdateTime = millis();
-            float dtSec = (float)(now - lastUpdateTime) / 1000.0f;
-            lastUpdateTime = now;
-            
-            // Log significant changes in radiation levels
-            static float lastCPM = 0;
-            if (abs(cpm - lastCPM) > 10) {
-                DEBUG_PRINTF("CPM change: %d → %d (%.2f µSv/h)\n", (int)lastCPM, cpm, cpm / CONVERSION_FACTOR);
+    out.printf(" on core %d (priority %u), processing on core %d (priority %u), UI core %d, network core %d\n",
+               TASK_CORE_MEASUREMENT, (unsigned)PULSE_SAMPLE_PRIORITY, TASK_CORE_MEASUREMENT,
+               (unsigned)PULSE_PROCESS_PRIORITY, TASK_CORE_UI, TASK_CORE_NETWORK);
+    uint32_t uptimeS = millis() / 1000;
+    out.printf("  wakeups: %lu by pulses, %lu by time (%.2f per second)\n", (unsigned long)sampleWakeEvents,
+               (unsigned long)sampleWakeTicks, uptimeS ? (float)(sampleWakeEvents + sampleWakeTicks) / uptimeS : 0.0f);
+    printLatencyHistogram(out, "jitter", sampleJitter);
+    printLatencyHistogram(out, "handoff", processLatency);
+    out.printf("  %lu readings dropped (pulseTask behind)\n", (unsigned long)pulseSamples.dropped());
+    printFlashStalls(out);
+    if (pulseCaptureActive()) {
+        const PulseCaptureStats& capture = pulseStats.capture;
+        out.printf("  %lu pulses captured with the flash cache off, %lu timestamps dropped\n",
+                   (unsigned long)capture.duringFlash, (unsigned long)capture.dropped);
+    }
+}
+
+static uint16_t saturate16(uint64_t value) {
+    return value > 0xFFFF ? 0xFFFF : (uint16_t)value;
+}
+
+/**
+ * @brief Queues a performance block (telemetryPerf) every
+ *        TELEMETRY_PERF_INTERVAL_S. Latencies are since boot, drops and the
+ *        log throughput over the period. UI task loop.
+ */
+static void reportPerformance(uint32_t nowMs) {
+    static uint32_t writtenBase = 0;
+    static uint64_t writeUsBase = 0;
+    static uint32_t droppedBase = 0;
+    if (TELEMETRY_PERF_INTERVAL_S == 0 || nowMs - lastPerfMs < TELEMETRY_PERF_INTERVAL_S * 1000UL) return;
+    lastPerfMs = nowMs;
+
+    TelemetryPerf perf;
+    perf.jitterP99Us = saturate16(sampleJitter.percentileUs(990));
+    perf.jitterMaxUs = saturate16(sampleJitter.maxUs());
+
+    // Bytes per microsecond are MB/s
+    HistoryLogStats log = getHistoryLogStats();
+    uint64_t writeUs = log.writeUs - writeUsBase;
+    perf.flushKBps = writeUs ? saturate16((uint64_t)(log.writtenBytes - writtenBase) * 1000 / writeUs) : 0;
+    writtenBase = log.writtenBytes;
+    writeUsBase = log.writeUs;
+
+    SysInfoSample sys = getSysInfoSample();
+    perf.heapFragPermille = sys.heapFree && sys.heapLargest <= sys.heapFree
+                                ? saturate16(1000 - (uint64_t)sys.heapLargest * 1000 / sys.heapFree)
+                                : 0;
+    perf.heapMinFreeKb = saturate16(sys.heapMinFree / 1024);
+
+    WebLatencyHistogram http = webServiceLatency();
+    perf.httpP95Ms = saturate16(http.percentileUs(950) / 1000);
+    perf.httpMaxMs = saturate16(http.maxUs() / 1000);
+
+    uint32_t dropped = getDebugLogStats().dropped;
+    perf.logDropped = saturate16(dropped - droppedBase);
+    droppedBase = dropped;
+
+    DoseSnapshot dose = getDoseSnapshot();
+    perf.deadTimePermille = dose.correctedCpm > dose.rawCpm
+                                ? saturate16(lroundf(1000.0f * (1.0f - dose.rawCpm / dose.correctedCpm)))
+                                : 0;
+
+    bool utc = timeBaseUtcValid();
+    telemetryPerf(utc ? timeBaseUtcSeconds() : timeBaseSeconds(), utc, perf);
+    lastPerf = perf;
+}
+
+/**
+ * @brief "counters": the PCNT channels, their tubes and the active range.
+ */
+static void printCounters(Print& out) {
+    PulseSnapshot snap = pulseStats;
+    DeviceConfig config = getDeviceConfig();
+    for (uint8_t c = 0; c < COUNTER_CHANNELS; c++) {
+        const CounterChannel& channel = counterChannels[c];
+        bool high = c > 0;
+        out.printf("Channel %u: PCNT unit %u, GPIO %u, %s tube %s, %.1f CPM per uSv/h, dead time %.0f us%s\n", c,
+                   channel.unit(), channel.pin(), high ? "high-range" : "main",
+                   high ? HighRangeTube::NAME : ActiveTube::NAME,
+                   high ? HighRangeTube::CPM_PER_USVH : 1.0f / config.usvHPerCpm,
+                   high ? HighRangeTube::DEAD_TIME_US : config.deadTimeUs, channel.active() ? "" : " (not running)");
+        if (COUNTER_CHANNELS > 1) out.printf("  %.1f CPM raw over 60 s\n", snap.channelCpm[c]);
+    }
+    if (COUNTER_CHANNELS > 1) {
+        out.printf("Range: %s tube counted, %lu switches (up at %.0f%% busy, down below %.0f%%)\n",
+                   snap.highRange ? "high-range" : "main", (unsigned long)snap.rangeSwitches,
+                   COUNTER_RANGE_UP * 100.0f, COUNTER_RANGE_DOWN * 100.0f);
+    }
+}
+
+static void onGeigerTimestamp(uint32_t timestampUs, void* context) {
+    coincidenceGate.addReference(timestampUs);
+    coincidenceStats.geiger++;
+    serialLinkPulse(timestampUs);
+    pulseRecorderPulse(timestampUs);
+    if (!pulsesInjected) tubeHealthPulse(timestampUs);
+    statusLedPulse();
+}
+
+/**
+ * @brief Gates queued scintillation pulses against the Geiger stream and bins them.
+ *
+ * Runs on pulseTask after the Geiger drain, which makes this the spectrum's only
+ * writer. A pulse the gate cannot decide yet (Geiger stream not past its window)
+ * stays queued with everything behind it until the next poll.
+ */
+static void binSpectrumEvents() {
+    if (!spectrumBinning.load(std::memory_order_acquire) || !spectrum.ready()) return;
+    spectrum.beginBatch();
+    bool accumulate = spectrum.accumulating();
+    uint32_t liveMs = takeSpectrumLiveMs();
+    uint32_t realMs = takeSpectrumRealMs();
+    if (accumulate) {
+        spectrum.addLiveMs(liveMs);
+        spectrum.addRealMs(realMs);
+    }
+    spectrumDoseBatch(accumulate ? liveMs : 0);
+    isotopeIdAddLiveMs(liveMs);
+
+    uint8_t mode = coincidenceMode;
+    SpectrumEvent event;
+    uint32_t binned = 0;
+    bool heldBack = false;
+    while (peekSpectrumEvent(event)) {
+        int tag = coincidenceGate.classify(event.timestampUs);
+        if (tag < 0) {
+            heldBack = true;
+            break;
+        }
+        popSpectrumEvent(event);
+        coincidenceStats.events++;
+        if (tag) coincidenceStats.coincident++;
+
+        bool keep = mode == COINCIDENCE_OFF || (mode == COINCIDENCE_VETO && !tag) ||
+                    (mode == COINCIDENCE_REQUIRE && tag);
+        if (keep) isotopeIdAdd(spectrum.channelOf(event.height)); // Also while a session is paused
+        if (keep && accumulate) {
+            uint16_t channel = spectrum.add(event.height);
+            spectrumDoseAdd(channel);
+            sipmGainObserve(channel);
+            coincidenceStats.binned++;
+            if (event.flags & PULSE_FLAG_PILEUP) coincidenceStats.piledUp++;
+            binned++;
+        }
+    }
+    if (binned || heldBack) TRACE_EVENT(TRACE_SPECTRUM_BIN, binned, heldBack);
+}
+
+static void loadCoincidenceSettings() {
+    Preferences prefs;
+    prefs.begin("spectrum", true);
+    uint8_t mode = prefs.getUChar("coinc_mode", COINCIDENCE_MODE_DEFAULT);
+    coincidenceMode = mode <= COINCIDENCE_REQUIRE ? mode : COINCIDENCE_OFF;
+    coincidenceGate.setWindow(prefs.getUInt("coinc_us", COINCIDENCE_WINDOW_US));
+    prefs.end();
+}
+
+static bool startUiTask() {
+    return xTaskCreatePinnedToCore(
+        uiTask,             // Task function
+        "UITask",           // Task name
+        UI_TASK_STACK,      // Stack size (larger for UI)
+        NULL,               // Parameters
+        UI_TASK_PRIORITY,   // Priority
+        &uiTaskHandle,      // Task handle
+        TASK_CORE_UI        // Core ID
+    ) == pdPASS;
+}
+
+/**
+ * @brief Supervisor restart of a stalled uiTask (supervisor.h). Counting,
+ *        alarms and the web server run on other tasks and carry on.
+ */
+static bool restartUiTask() {
+    if (!uiTaskHandle || uiInLvgl) return false;
+    TaskHandle_t stalled = uiTaskHandle;
+    sysInfoReplaceTask(stalled, nullptr);
+    vTaskDelete(stalled);
+    if (!startUiTask()) return false;
+    sysInfoReplaceTask(nullptr, uiTaskHandle);
+    return true;
+}
+
+void uiTask(void *parameter) {
+    unsigned long lastTimeUpdate = 0;
+    
+    DEBUG_PRINTF("UI task started on Core %d\n", xPortGetCoreID());
+    uiWakeBegin(xTaskGetCurrentTaskHandle());
+    supervisorAttach("ui", SUPERVISOR_UI_STALL_MS, restartUiTask);
+    
+#if !HEADLESS
+    // Give UI components time to initialize fully
+    vTaskDelay(pdMS_TO_TICKS(500));
+    
+    // The settings widgets were set from the configuration in setup()
+    uint32_t shownConfigRevision = deviceConfigRevision();
+    
+    // Force LVGL to process all UI updates
+    uiInLvgl = true;
+    lv_timer_handler();
+    uiInLvgl = false;
+    
+    // Cleared by managePower() while the screen is off
+    bool rendering = true;
+#endif
+    
+    while (true) {
+        supervisorHeartbeat();
+        
+#if !HEADLESS
+        // Widget updates queued by other tasks, before this pass reads or
+        // changes any widget
+        uiInLvgl = true;
+        uiAsyncDrain();
+        uiInLvgl = false;
+#endif
+        
+        // Check for serial commands
+        processSerialCommands();
+        
+        unsigned long now = millis();
+        
+        // One configuration snapshot per pass; the widgets follow changes made
+        // elsewhere (serial commands) instead of being read back
+        DeviceConfig config = getDeviceConfig();
+#if !HEADLESS
+        if (deviceConfigRevision() != shownConfigRevision) {
+            shownConfigRevision = deviceConfigRevision();
+            applyConfigToWidgets();
+        }
+#endif
+        
+        // Copy the latest pulse snapshot; never waits on pulseTask
+        TRACE_EVENT(TRACE_UI_UPDATE_BEGIN, 0, 0);
+        refreshPulseStats();
+        {
+            // The adaptive estimator integrates up to 300 s while the rate is stable
+            // and drops to a few seconds when a significant change is detected
+            rawCpm = pulseStats.adaptiveCpm;
+            
+            // Right after boot its window is short: the posterior over it, with the
+            // last session's background as the prior, until the window outgrows it
+            static uint8_t priorState = startupPrior.state();
+            if (startupPrior.update(pulseStats.adaptiveCounts, pulseStats.adaptiveWindowSeconds,
+                                    pulseStats.secondsClosed, RATE_PRIOR_CONFLICT_Z)) {
+                rawCpm = 60.0f * startupPrior.cps();
+            }
+            if (startupPrior.state() != priorState) {
+                priorState = startupPrior.state();
+                DEBUG_PRINTF("Rate prior %s after %lu s\n",
+                             priorState == RatePrior::CONFLICT ? "contradicted" : "released",
+                             (unsigned long)startupPrior.releasedAt());
+            }
+            int cpm = (int)rawCpm;
+            
+            // Dead-time correction stage between the raw counts and the dose pipeline
+            correctedCpm = correctDeadTimeCpm(rawCpm, config.deadTimeSec);
+            
+            // Log significant changes in radiation levels
+            static float lastCPM = 0;
+            if (abs(cpm - lastCPM) > 10) {
+                DEBUG_PRINTF("CPM change: %d → %d (%.2f µSv/h)\n", (int)lastCPM, cpm, cpm * config.usvHPerCpm);
                 lastCPM = cpm;
             }
             
             // Update real-time stats
-            updateRealTimeStats((float)cpm, dtSec);
-            updateLabels();
-            accumulateCharts((float)cpm, dtSec);
-            checkAlarms();
-            
-            xSemaphoreGive(dataMutex);
+            updateRealTimeStats(correctedCpm, config);
+#if !HEADLESS
+            updateLabels(config);
+#endif
+            accumulateCharts(config);
+        }
+        TRACE_EVENT(TRACE_UI_UPDATE_END, 0, 0);
+        
+        // Plateau scan steps follow the same pulse snapshot
+        plateauScanLoop(now, pulseStats.totalCounts);
+        calibrationLoop(now, pulseStats.totalCounts);
+        configApiLoop(now);
+        
+        // Slow SiPM gain correction (temperature, peak position)
+        sipmGainLoop(now);
+        
+        // A new firmware image is confirmed once the pulse pipeline has kept up
+        otaGuardConfirm(now, pulseStats.secondsClosed);
+        
+        sourceLocatorUpdate(now);
+        
+#if !HEADLESS
+        // Waterfall slices and survey points are recorded whether or not anything is shown
+        spectrumWaterfallUpdate(now);
+        surveyTrackViewUpdate(now);
+        
+        // Live spectrum and history plot (only while shown)
+        if (rendering) {
+            if (!spectrumWaterfallShown()) spectrumViewUpdate(now); // Covered by the waterfall otherwise
+            if (uiScreenShown(UI_SCREEN_SPECTRUM)) updateSpectrumAnnotation();
+            timeSeriesViewUpdate(now, 60.0f * config.usvHPerCpm);
+            tubeHealthViewUpdate(now);
+            searchViewUpdate(now);
+            sourceMapViewUpdate(now);
+            calibrationViewUpdate(now);
+            eventJournalViewUpdate(now);
+            wifiScanViewUpdate(now);
+            if (uiScreenShown(UI_SCREEN_VOLTAGE)) updatePlateauView();
+            updateOtaProgress();
+            screenMirrorUiLoop();
         }
         
-        // Update power management
-        managePower();
+        updateScalerLabel();
+        
+        // Dim / screen-off state; also wakes the display on touch or alarm
+        rendering = managePower(config);
+#endif
+        
+        // Battery indicator and low-charge handling
+        checkBatteryLevel();
+        
+        // Advance the WiFi state machine; connection attempts never block this loop
+        wifiManagerLoop(now);
+        ethernetLinkLoop(now);
+        provisioningPortalLoop(now);
+        campaignLoop(now, getAlarmStatus().level != ALARM_LEVEL_NONE);
+        reportPerformance(now);
+        wifiPowerLoop(now);
+        
+        // Keeps the RTC memory copy of the UTC mapping fresh for a soft reset
+        timeBaseLoop();
+        
+        // A boot that stays up clears the failed-boot counter
+        bootReportLoop(now);
         
-        // Update WiFi info every second if connected
-        if (WiFi.status() == WL_CONNECTED && (now - lastTimeUpdate >= 1000)) {
+        // Update WiFi info every second if online. The clock comes from the
+        // time base mapping, which the SNTP callback disciplines; nothing here
+        // waits for a sync, and the label is only set when its text changed.
+        if (networkOnline() && (now - lastTimeUpdate >= 1000)) {
             lastTimeUpdate = now;
-            struct tm timeinfo;
-            if (getLocalTime(&timeinfo)) {
-                char timeStr[64];
-                strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M:%S", &timeinfo);
-                String info = String("IP: ") + wifi_ip + "\nTime: " + timeStr + " UTC";
-                lv_label_set_text(ui_WIFIINFO, info.c_str());
+            char clock[24];
+            char info[sizeof(wifiInfoText)];
+            if (timeBaseFormatUtc(clock, sizeof(clock))) {
+                snprintf(info, sizeof(info), "IP: %s\nTime: %s UTC", wifi_ip, clock);
             } else {
-                String info = String("IP: ") + wifi_ip + "\nTime: NTP Failed";
-                lv_label_set_text(ui_WIFIINFO, info.c_str());
-                DEBUG_PRINTLN("NTP time sync failed");
+                // Not synced yet; SNTP keeps retrying in the background
+                snprintf(info, sizeof(info), "IP: %s\nTime: syncing", wifi_ip);
             }
+            if (strcmp(info, wifiInfoText) != 0) setWifiInfo(info);
         }
         
-        // Handle OTA updates
-        if (otaInitialized) {
-            server.handleClient();
+        // LVGL last, so the widgets changed above are drawn in this pass; what
+        // it returns is the time until its next timer is due
+        uint32_t idleMs = UI_TASK_MAX_SLEEP_MS;
+#if !HEADLESS
+        if (rendering) {
+            TRACE_EVENT(TRACE_LVGL_BEGIN, 0, 0);
+            uiInLvgl = true;
+            idleMs = lv_timer_handler();
+            uiInLvgl = false;
+            TRACE_EVENT(TRACE_LVGL_END, 0, 0);
         }
         
-        vTaskDelay(xDelay);
+        // Sleep until a touch, the next second's data or that deadline
+        if (uiWakeWait(idleMs) & UI_WAKE_TOUCH) displayPortReadTouchNow();
+#else
+        // Sleep until the next second's data or that deadline
+        uiWakeWait(idleMs);
+#endif
     }
 }
 
@@ -1147,6 +2925,14 @@ void uiTask(void *parameter) {
  * setup() and loop()
  ******************************************************************************/ 
 void setup() {
+    // A logger-mode batch wake stores the ULP's intervals and sleeps again here
+    loggerModeResume();
+    initFlashStallMonitor(); // Before the first NVS write
+    
+    // Timed from here; notes a crash loop from the previous boots in RTC memory
+    bootReportBegin();
+    bootPhase(BOOT_PHASE_EARLY);
+    
     initSerial();
     
     // Print startup debug information
@@ -1154,483 +2940,1659 @@ void setup() {
     Serial.println("Debug output is enabled");
     DEBUG_PRINTLN("DEBUG macro is working if you see this message");
     
+    // UTC is known from the first record after a soft reset (kept in RTC memory)
+    initTimeBase();
+    
+    // A new image stays unconfirmed until the measurement has run for a while
+    otaGuardBegin();
+    
+    // TWDT and the reset log; the tasks attach themselves as they start
+    if (!initSupervisor()) {
+        DEBUG_PRINTLN("WARNING: Task watchdog not configured");
+    }
+    
+    // Settings are read from NVS once here and served from RAM afterwards
+    if (!initSettingsStore()) {
+        DEBUG_PRINTLN("WARNING: Settings changes will not be saved");
+    }
+    // Typed configuration built from them once; every task reads this snapshot
+    if (!initDeviceConfig()) {
+        DEBUG_PRINTLN("WARNING: Configuration writes are not serialised");
+    }
+    // Events that survived the reset in RTC memory, then this boot's reset
+    initEventJournal();
+    // The tube voltage settles while the rest starts; the target comes from the configuration
+    if (!initHvControl(HV_PWM_PIN, HV_FEEDBACK_PIN, HV_LEDC_CHANNEL)) {
+        DEBUG_PRINTLN("WARNING: HV regulation not running");
+    }
+    initCalibration(); // Publishes the stored calibration
+    
+    // Counting first: pulseTask is started before the display, SD card and
+    // network, which take seconds after a power cycle. Only what it writes to
+    // is set up before it.
+    bootPhase(BOOT_PHASE_COUNTING);
+    
+    // Chart histories are read by the web task while uiTask appends to them
+    chartDataMutex = xSemaphoreCreateMutex();
+    supervisorWatchLock(chartDataMutex);
+    
+    // Allocate the long-term history in PSRAM before the pulse task feeds it
+    if (!historyStore.begin()) {
+        DEBUG_PRINTLN("WARNING: History store allocation failed (PSRAM missing?)");
+    }
+    
+    // Initialize pulse buffer and history
+    memset(pulseBuffer, 0, sizeof(pulseBuffer));
+    pulseHistory.clear();
+    adaptiveRate.clear();
+    pulseBufferIndex = 0;
+    
+    // Zero the chart data; the charts draw it when their screens are built
+    assignChartSeries();
+    
+    // The capture ISR starts clicks through it
+    if (!initAlarmSequencer(BUZZER_PIN, BUZZER_LEDC_CHANNEL)) {
+        DEBUG_PRINTLN("WARNING: Alarm sequencer not available");
+    }
+    if (!initSearchMode()) {
+        DEBUG_PRINTLN("WARNING: Search mode not available");
+    }
+    if (STATUS_LED_PIN >= 0 && !initStatusLed(STATUS_LED_LEDC_CHANNEL)) {
+        DEBUG_PRINTLN("WARNING: Status LED not available");
+    }
+    // Read by the coincidence gate on pulseTask
+    loadCoincidenceSettings();
+    // Serial and web changes to pulseTask state go through its queue
+    if (!initCommandBus()) {
+        DEBUG_PRINTLN("WARNING: Command bus not available");
+    }
+    
+    startTime = millis();
+    lastLoop = startTime;
+    
+    // Battery sampling, dose checkpoints and the sysinfo sampler run as its jobs
+    if (!initJobWheel()) {
+        DEBUG_PRINTLN("WARNING: Background jobs not running");
+    }
+    
+    // Cumulative dose, counters and chart histories continue from the last
+    // checkpoint, or from the image flushed as the supply failed; the charts
+    // are drawn from them once their screens exist
+    powerFailLoad();
+    DoseCheckpoint checkpoint;
+    if (doseCheckpointLoad(&checkpoint)) {
+        restoreDoseCheckpoint(checkpoint);
+    }
+    if (!initDoseCheckpoint(collectDoseCheckpoint)) {
+        DEBUG_PRINTLN("WARNING: Dose will not be checkpointed");
+    }
+    
+    // The last session's background seeds the rate shown in the first minutes
+    BackgroundRecord background;
+    if (backgroundStoreLoad(background)) {
+        float spread = RATE_PRIOR_SPREAD * background.cps;
+        startupPrior.begin(background.cps, sqrtf(background.sigmaCps * background.sigmaCps + spread * spread),
+                           RATE_PRIOR_MAX_SECONDS);
+        DEBUG_PRINTF("Rate prior: %.1f CPM, worth %.0f s\n", 60.0f * startupPrior.priorCps(),
+                     startupPrior.priorSeconds());
+    }
+    if (!initBackgroundStore(collectBackground)) {
+        DEBUG_PRINTLN("WARNING: Background rate will not be saved");
+    }
+    initRateEstimators();
+    
+    // Processing first: the sampling task hands every reading to it
+    xTaskCreatePinnedToCore(
+        pulseTask,           // Task function
+        "PulseTask",         // Task name
+        PULSE_TASK_STACK,   // Stack size
+        NULL,               // Parameters
+        PULSE_PROCESS_PRIORITY, // Above the UI, below the sampling and HV control
+        &pulseTaskHandle,   // Task handle
+        TASK_CORE_MEASUREMENT // Away from the WiFi / lwIP core
+    );
+    xTaskCreatePinnedToCore(
+        pulseSampleTask,
+        "PulseSample",
+        PULSE_SAMPLE_TASK_STACK,
+        NULL,
+        PULSE_SAMPLE_PRIORITY,
+        &pulseSampleTaskHandle,
+        TASK_CORE_MEASUREMENT
+    );
+    
+    // The radio and DHCP come up in the background while the display starts
+    bootPhase(BOOT_PHASE_NETWORK);
+    
+    // Routes are attached when WiFi first connects
+    registerWebRoutes();
+    
+    // WiFi events are handled asynchronously; status changes update ui_WIFIINFO
+    wifiManagerBegin(onWifiStateChanged);
+    // A cable with a link takes over from WiFi; on top of the stack WiFi started
+    initEthernetLink(onEthLinkChanged);
+    // Debug output to DEBUG_SYSLOG_HOST while connected, if one is set
+    initSyslogSink();
+    initWifiPower();
+    // Detector ring over ESP-NOW, started here only if "espnow node|hub" was saved
+    initEspNowLink(readEspNowReadings);
+    // Source localisation from the detector positions set with "locate pos" (hub)
+    initSourceLocator(readEspNowReadings);
+    // One multicast datagram per second serves every listener ("udp on")
+    initUdpStream(readUdpStreamReadings);
+    // SCADA masters poll the register block each dose snapshot encodes
+    initModbusServer();
+    // SNTP waits for a connection itself and then keeps disciplining UTC
+    timeBaseStartSntp();
+    
+    bootPhase(BOOT_PHASE_DISPLAY);
+    
+    // Battery sampling starts before the UI, which only shows the indicator if it runs
+    if (!initBatteryMonitor()) {
+        DEBUG_PRINTLN("WARNING: Battery monitor not running (BATTERY_ADC_PIN)");
+    }
+    
+    // The panel, touch controller and SD card share one SPI bus
+    spiBusInit();
+    supervisorWatchLock(spiBusMutex());
+    
+#if !HEADLESS
     initTFT();
     
-    // Initialize LVGL BEFORE setting the startup screen
-    initLVGL();
+#if LVGL_DEMO
+    lvglDemoRun(); // Demo build: LVGL's demo instead of the firmware, never returns
+#endif
+    
+    // Builds and shows only the startup screen; the others follow on first use
+    initLVGL();
+    
+    // Force LVGL to process UI changes
+    lv_timer_handler();
+#endif
+    
+    // Optional subsystems; after repeated failed boots they stay off so the
+    // detector keeps counting and can be reached for an update
+    bootPhase(BOOT_PHASE_STORAGE);
+    
+    // A signed image on the card is installed before anything else starts,
+    // also in safe mode, which is when a unit most needs one
+    cardUpdateCheck();
+    
+    if (bootSafeMode()) {
+        DEBUG_PRINTLN("WARNING: Safe mode after repeated failed boots (\"boot\" for details)");
+    } else {
+        // Mount the SD log; the card shares the TFT SPI bus, so this follows initTFT()
+        if (!initHistoryLog()) {
+            DEBUG_PRINTLN("WARNING: History log unavailable (no SD card?)");
+        } else {
+            if (!initLogCompaction()) {
+                DEBUG_PRINTLN("WARNING: History log will not be compacted");
+            }
+            if (USB_DRIVE_ENABLED && !initUsbDrive()) {
+                DEBUG_PRINTLN("WARNING: USB drive not registered (needs a USB-OTG build)");
+            }
+        }
+        
+        // Scintillation spectrum: histogram in PSRAM, any checkpointed session restored
+        // into it, then the ADC DMA engine that fills it
+        if (!spectrum.begin(SPECTRUM_CHANNELS, spectrumSampleBits())) {
+            DEBUG_PRINTLN("WARNING: Spectrum histogram not allocated");
+        } else if (!initSpectrumSession(spectrum)) {
+            DEBUG_PRINTLN("WARNING: Spectrum sessions will not be saved");
+        }
+        if (!initPulseRecorder(readPulseTraceState)) {
+            DEBUG_PRINTLN("WARNING: Pulse traces cannot be recorded");
+        }
+        initAnomalyCapture();
+        spectrumBinning.store(true, std::memory_order_release);
+        if (!initSpectrumAdc(spectrum)) {
+            DEBUG_PRINTLN("WARNING: Spectrum acquisition not running");
+        }
+        if (!initSpectrumAnalysis(spectrum)) {
+            DEBUG_PRINTLN("WARNING: Spectrum peak analysis not running");
+        }
+        if (!initSipmGain(spectrum)) {
+            DEBUG_PRINTLN("WARNING: SiPM gain correction not available");
+        }
+#if !HEADLESS
+        if (!initSpectrumWaterfall(spectrum)) {
+            DEBUG_PRINTLN("WARNING: Spectrum waterfall not allocated");
+        }
+#endif
+        if (!initSpectrumDose(spectrum)) {
+            DEBUG_PRINTLN("WARNING: Spectral dose not available");
+        }
+        if (!initIsotopeId(spectrum)) {
+            DEBUG_PRINTLN("WARNING: Isotope identification not running");
+        }
+        
+        // Per-interval telemetry; uploads start once WiFi and NTP are up
+        if (!initTelemetry()) {
+            DEBUG_PRINTLN("WARNING: Telemetry queue unavailable (LittleFS?)");
+        }
+        // Replays logger-mode intervals into the log and telemetry, and
+        // ends an upload wake
+        initLoggerMode(prepareLoggerSleep);
+        // Windows and upload slots; the loop sleeps in logger mode between them
+        initCampaign();
+        // Geo-tagged survey records once a GPS is wired (GPS_RX_PIN)
+        if (GPS_RX_PIN >= 0) {
+            if (!initGpsSurvey()) {
+                DEBUG_PRINTLN("WARNING: GPS survey not running");
+            }
+#if !HEADLESS
+            else if (!initSurveyTrackView()) {
+                DEBUG_PRINTLN("WARNING: Survey track not allocated");
+            }
+#endif
+        }
+        // Pull updates from a fleet manifest; polls start once WiFi is up
+        if (!initFleetOta()) {
+            DEBUG_PRINTLN("WARNING: Fleet OTA not running");
+        }
+    }
+    
+    // The dose and the log have stored what a power-fail flush saved; the area is reused
+    if (POWER_FAIL_PIN >= 0 && !initPowerFail()) {
+        DEBUG_PRINTLN("WARNING: Power-fail flush not armed");
+    }
+    
+    bootPhase(BOOT_PHASE_SERVICES);
+    
+    // Clock profile first: the display power states hand it the screen-off hint
+    if (!initPowerProfile()) {
+        DEBUG_PRINTLN("WARNING: Power profile not applied, running at the boot clock");
+    }
+    if (PULSE_INJECT_PIN >= 0 && !initPulseInjector(GEIGER_PULSE_PIN, powerBenchCounts)) {
+        DEBUG_PRINTLN("WARNING: Pulse injector not available");
+    }
+    initLatencyProbe(powerBenchCounts);
+    
+#if !HEADLESS
+    // Set up power management
+    setupPowerManagement();
+#else
+    // Nothing is ever shown: the screen-off clock applies from the start
+    powerProfileSetScreenOff(true);
+#endif
+
+    // The settings widgets are initialised from the configuration when that
+    // screen is built (settingsScreenCreated)
+    DeviceConfig config = getDeviceConfig();
+    DEBUG_PRINTF("Loaded settings: onStartup=%s, alarmEnabled=%s\n", 
+                config.wifiAutoConnect ? "true" : "false", 
+                config.alarmEnabled ? "true" : "false");
+    
+    // First-time setup: no network saved yet
+    if (wifiManagerSavedSsid(nullptr).length() == 0) provisioningPortalStart();
+    
+    // Start WiFi timer if auto-connect is enabled
+    if (config.wifiAutoConnect) {
+#if !HEADLESS
+        DEBUG_PRINTLN("Auto-connect enabled, starting WiFi timer");
+        lv_timer_create(wifi_connect_timer_cb, 2000, NULL);
+#else
+        tryAutoConnect(); // No screen to show first
+#endif
+    }
+    
+    startUiTask();
+    
+    // Serial commands and the binary streams; without it the UI task reads the port itself
+    if (!serialLinkBegin(&spectrum, readSerialStatus)) {
+        DEBUG_PRINTLN("WARNING: Serial link task not running");
+    }
+    
+    // Stack, CPU and heap sampling for /api/sysinfo and "perf"
+    if (!initSysInfo()) {
+        DEBUG_PRINTLN("WARNING: Performance sampling not running");
+    }
+    sysInfoWatchTask(pulseSampleTaskHandle, PULSE_SAMPLE_TASK_STACK);
+    sysInfoWatchTask(pulseTaskHandle, PULSE_TASK_STACK);
+    sysInfoWatchTask(uiTaskHandle, UI_TASK_STACK);
+    if (!initEnergyMeter()) {
+        DEBUG_PRINTLN("WARNING: Energy accounting not running");
+    }
+    
+    // Phone readout over BLE, started here only if "ble on" was saved
+    initBleService(historyStore, readBleReadings);
+    
+    bootReportComplete();
+    printBootReport(Serial);
+    DEBUG_PRINTLN("Setup completed.");
+}
+
+void loop() {
+    // The tasks do the work; loopTask supervises them
+    supervisorLoop(millis());
+    eventJournalLoop(millis()); // Flash writes stay off the alarm path
+    loggerModeLoop(millis());
+    vTaskDelay(pdMS_TO_TICKS(SUPERVISOR_INTERVAL_MS));
+}
+
+/*******************************************************************************
+ * Benchmarks
+ ******************************************************************************/ 
+static volatile uint32_t benchSink; ///< Keeps benchmarked results from being optimised away
+
+static void benchRadiationJson(void*) {
+    benchSink += getRadiationDataJson().length();
+}
+
+#if !HEADLESS
+static void benchRedraw(void*) {
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    displayPortFlushWait(); // Count the last stripe's transfer too
+}
+
+static void benchCurrentRad(void*) {
+    lv_obj_invalidate(ui_CurrentRad);
+    lv_refr_now(NULL);
+    displayPortFlushWait();
+}
+
+#if READOUT_SPRITES
+static void benchCurrentRadUpdate(void*) {
+    // The last digit changes, as most dose-rate updates do
+    static bool toggle = false;
+    toggle = !toggle;
+    readoutSpriteSetText(ui_CurrentRad, toggle ? "0.12" : "0.13");
+    lv_refr_now(NULL); // Only does work when the update fell back to LVGL
+    displayPortFlushWait();
+}
+#endif
+
+static void benchFlush(void*) {
+    displayPortPushFrame();
+}
+#endif
+
+static void benchDashboardPage(void*) {
+    readDashboardPage();
+}
+
+static void benchPreferencesWrite(void*) {
+    // Same begin/put/end sequence as the settings writes, in a scratch namespace
+    Preferences prefs;
+    prefs.begin("bench", false);
+    prefs.putUInt("n", benchSink++);
+    prefs.end();
+}
+
+/**
+ * @brief Times the hot paths and publishes the report (runs on the UI task).
+ *
+ * Each screen is loaded and drawn once untimed (first layout, image decode),
+ * then fully invalidated and redrawn with lv_refr_now(), which is the redraw
+ * lv_timer_handler() performs when the whole screen is dirty. Screens not
+ * built yet are built first. The screen shown before the run is restored at
+ * the end (rebuilt if it is deleted on leave). The headless build times
+ * only what does not draw.
+ */
+static void runBenchmarks() {
+#if !HEADLESS
+    static const struct {
+        const char* name;
+        UiScreenId screen;
+    } screens[] = {
+        {"redraw_initial", UI_SCREEN_INITIAL},
+        {"redraw_main", UI_SCREEN_MAIN},
+        {"redraw_charts1h", UI_SCREEN_CHARTS1H},
+        {"redraw_charts24h", UI_SCREEN_CHARTS24H},
+        {"redraw_spectrum", UI_SCREEN_SPECTRUM},
+        {"redraw_voltage", UI_SCREEN_VOLTAGE},
+        {"redraw_settings", UI_SCREEN_SETTINGS},
+    };
+    const uint32_t frameBytes = (uint32_t)DISPLAY_WIDTH * DISPLAY_HEIGHT * sizeof(lv_color_t);
+#endif
+
+    benchBegin();
+    benchRun("radiation_json", benchRadiationJson, NULL, 20);
+    benchRun("dashboard_page", benchDashboardPage, NULL, 20, readDashboardPage());
+
+#if !HEADLESS
+    UiScreenId previousId = uiScreenActive();
+    lv_obj_t* previous = lv_scr_act();
+    for (size_t i = 0; i < sizeof(screens) / sizeof(screens[0]); i++) {
+        uiScreenLoad(screens[i].screen);
+        lv_refr_now(NULL);
+        benchRun(screens[i].name, benchRedraw, NULL, 5, frameBytes);
+    }
+#if RGB565_FAST_BLEND
+    // The main screen (semi-transparent panels) once more on LVGL's scalar blend
+    bool blendWasEnabled = blend565Enabled();
+    uiScreenLoad(UI_SCREEN_MAIN);
+    blend565SetEnabled(false);
+    benchRun("redraw_main_scalar_blend", benchRedraw, NULL, 5, frameBytes);
+    blend565SetEnabled(blendWasEnabled);
+#endif
+#if DIGIT_SPRITES
+    // A dose-rate update: the big readout alone, from the sprites and through LVGL's glyph path
+    uiScreenLoad(UI_SCREEN_MAIN);
+    bool spritesWereEnabled = digitSpritesEnabled();
+    digitSpritesSetEnabled(true);
+    lv_refr_now(NULL);
+    benchRun("redraw_current_rad", benchCurrentRad, NULL, 20);
+    digitSpritesSetEnabled(false);
+    lv_refr_now(NULL);
+    benchRun("redraw_current_rad_glyphs", benchCurrentRad, NULL, 20);
+    digitSpritesSetEnabled(spritesWereEnabled);
+#endif
+#if READOUT_SPRITES
+    // The same update through the readout frame, then as an LVGL redraw
+    uiScreenLoad(UI_SCREEN_MAIN);
+    lv_refr_now(NULL);
+    bool framesWereEnabled = readoutSpriteEnabled();
+    readoutSpriteSetEnabled(true);
+    benchRun("update_current_rad_direct", benchCurrentRadUpdate, NULL, 20);
+    readoutSpriteSetEnabled(false);
+    benchRun("update_current_rad_lvgl", benchCurrentRadUpdate, NULL, 20);
+    readoutSpriteSetEnabled(framesWereEnabled);
+    attachLabelBindings(); // Back to the measured values on the next update
+#endif
+    benchRun("flush_frame", benchFlush, NULL, 10, frameBytes);
+    if (previousId != UI_SCREEN_COUNT) {
+        uiScreenLoad(previousId);
+    } else {
+        lv_scr_load(previous);
+    }
+    lv_obj_invalidate(lv_scr_act());
+#endif
+
+    benchRun("prefs_write", benchPreferencesWrite, NULL, 10);
+    httpsServiceBench();
+    benchEnd();
+}
+
+/*******************************************************************************
+ * Other Functions (Initialization, UI Setup, etc.)
+ ******************************************************************************/ 
+void initSerial() {
+    Serial.begin(115200);
+    delay(50);  // Short delay to allow serial to initialize
+    Serial.flush();  // Flush any pending data
+    initDebugLog();  // Writes out what was logged before
+    DEBUG_PRINTLN("Initializing Serial...");
+}
+
+#if !HEADLESS
+void initTFT() {
+    displayPortBegin();
+}
+
+void initLVGL() {
+    lv_init();
+    assetPackBegin(); // Before any screen asks for an image size
+    displayPortRegister();
+
+    uint32_t startMs = millis();
+    ui_init();
+    uiScreensBegin();
+    registerScreenHooks();
+    DEBUG_PRINTF("LVGL initialized + startup screen created in %lu ms.\n", (unsigned long)(millis() - startMs));
+}
+
+#endif // !HEADLESS
+
+static DoseStats doseStats; ///< uiTask only; seeded from the dose checkpoint in setup()
+
+/**
+ * @brief Publishes the uiTask dose values for the other tasks.
+ */
+static void publishDoseSnapshot() {
+    DoseSnapshot snap;
+    snap.currentUsvH = currentuSvHr;
+    snap.averageUsvH = averageuSvHr;
+    snap.maximumUsvH = maxuSvHr;
+    snap.rawCpm = rawCpm;
+    snap.correctedCpm = correctedCpm;
+    snap.currentError = doseStats.currentError;
+    snap.averageError = doseStats.averageError;
+    snap.measurement = precisionRun;
+    DeviceConfig config = getDeviceConfig();
+    for (uint8_t i = 0; i < RATE_EWMA_COUNT; i++) {
+        float raw = pulseStats.ewmaCpm[i];
+        float corrected = correctDeadTimeCpm(raw, config.deadTimeSec);
+        snap.averagesUsvH[i] = corrected * config.usvHPerCpm;
+        snap.averagesSigmaUsvH[i] = raw > 0.0f ? pulseStats.ewmaSigmaCpm[i] * corrected / raw * config.usvHPerCpm : 0.0f;
+    }
+    doseSnapshotLock.publish(snap);
+    publishModbusRegisters(snap);
+}
+
+/**
+ * @brief Encodes the Modbus register block from the snapshot just published (uiTask).
+ */
+static void publishModbusRegisters(const DoseSnapshot& dose) {
+    if (!MODBUS_ENABLED) return;
+    ModbusReadings r;
+    r.doseRateUsvH = dose.currentUsvH;
+    r.averageUsvH = dose.averageUsvH;
+    r.maximumUsvH = dose.maximumUsvH;
+    r.cumulativeMsv = readCumulativeMsv();
+    r.cpm = dose.correctedCpm;
+    r.cpmRaw = dose.rawCpm;
+    r.doseRateSigmaUsvH = dose.currentError.sigma;
+    r.totalCounts = pulseStats.totalCounts;
+    r.lastSecondCounts = pulseStats.lastSecondCounts;
+    r.secondsClosed = pulseStats.secondsClosed;
+    AlarmStatus alarm = getAlarmStatus();
+    r.alarmLevel = alarm.level;
+    r.alarmBits = alarm.causes;
+    if (alarmSoundingLevel() != ALARM_LEVEL_NONE) r.alarmBits |= 1 << 8;
+    if (getDeviceConfig().alarmEnabled) r.alarmBits |= 1 << 9;
+
+    HvStatus hv = getHvStatus();
+    BatteryStatus battery = getBatteryStatus();
+    bool wifi = WiFi.status() == WL_CONNECTED;
+    r.healthBits = 0;
+    if (hv.running && hv.state == HV_STATE_REGULATING) r.healthBits |= MODBUS_HEALTH_HV_OK;
+    if (hv.fault != HV_FAULT_NONE) r.healthBits |= MODBUS_HEALTH_HV_FAULT;
+    if (battery.level != BATTERY_LEVEL_OK) r.healthBits |= MODBUS_HEALTH_BATTERY_LOW;
+    if (pulseStats.highRange) r.healthBits |= MODBUS_HEALTH_HIGH_RANGE;
+    if (timeBaseUtcValid()) r.healthBits |= MODBUS_HEALTH_UTC_VALID;
+    if (wifi) r.healthBits |= MODBUS_HEALTH_WIFI;
+    if (ethernetLinkOnline()) r.healthBits |= MODBUS_HEALTH_ETHERNET;
+    r.batteryPct = battery.state == BATTERY_STATE_NOT_CONFIGURED || battery.state == BATTERY_STATE_ABSENT
+                       ? 0xFFFF
+                       : (uint16_t)battery.percent;
+    r.hvVolts = hv.running && hv.measuredV > 0.0f ? (uint16_t)lroundf(hv.measuredV) : 0;
+    r.rssiDbm = wifi ? WiFi.RSSI() : 0;
+    r.uptimeS = millis() / 1000;
+    r.freeHeapKb = (uint16_t)(ESP.getFreeHeap() / 1024);
+    modbusServerPublish(r);
+}
+
+/**
+ * @brief Cumulative dose from the accumulator pulseTask last published. Any task, lock-free.
+ */
+static float readCumulativeMsv() {
+    DoseAccumulator dose;
+    doseAccumulatorLock.read(dose);
+    return (float)dose.msv();
+}
+
+DoseSnapshot getDoseSnapshot() {
+    DoseSnapshot snap;
+    memset(&snap, 0, sizeof(snap));
+    doseSnapshotLock.read(snap);
+    snap.cumulativeMsv = readCumulativeMsv(); // Evaluated on read, not integrated by uiTask
+    return snap;
+}
+
+/**
+ * @brief "measure": state and result of a precision-targeted measurement.
+ */
+static void printPrecisionMeasurement(Print& out, const PrecisionMeasurement& run, const DeviceConfig& config) {
+    static const char* const STATES[] = {"IDLE", "RUNNING", "PRECISION REACHED", "TIME LIMIT", "STOPPED"};
+    if (run.state() == PrecisionMeasurement::IDLE) {
+        out.println("Measurement: none (measure <percent> [max seconds])");
+        return;
+    }
+    RateUncertainty r = run.interval(config.deadTimeSec, 60.0f * config.usvHPerCpm);
+    out.printf("Measurement: %s, %lu counts in %lu s, target +/-%.1f%% (~%lu counts)\n", STATES[run.state()],
+               (unsigned long)run.counts(), (unsigned long)run.seconds(), run.target() * 100.0f,
+               (unsigned long)run.countsNeeded());
+    out.printf("  %.4f +/- %.4f uSv/h (1 sigma), 95%% interval %.4f .. %.4f (+/-%.1f%%)\n", r.rate, r.sigma,
+               r.lower, r.upper, r.relative() * 100.0f);
+}
+
+void updateRealTimeStats(float cpm, const DeviceConfig& config) {
+    // uiTask's copies feed the labels; the snapshot goes to the other tasks
+    uint32_t elapsedMs = millis() - startTime;
+    doseStats.update(cpm, pulseStats.totalCounts, elapsedMs, config.usvHPerCpm);
+    // While the rate prior applies, the interval is the posterior's
+    uint32_t windowCounts = pulseStats.adaptiveCounts;
+    float windowSeconds = pulseStats.adaptiveWindowSeconds;
+    if (startupPrior.active()) {
+        windowCounts = (uint32_t)lroundf(startupPrior.effectiveCounts());
+        windowSeconds = startupPrior.effectiveSeconds();
+    }
+    doseStats.updateUncertainty(windowCounts, windowSeconds, pulseStats.totalCounts, elapsedMs, config.deadTimeSec,
+                                config.usvHPerCpm);
+    if (precisionRun.update(pulseStats.totalCounts, pulseStats.secondsClosed)) {
+        printPrecisionMeasurement(Serial, precisionRun, config);
+    }
+    
+    currentuSvHr = doseStats.current;
+    averageuSvHr = doseStats.average;
+    maxuSvHr = doseStats.maximum;
+    cumulativemSv = readCumulativeMsv();
+    publishDoseSnapshot();
+}
+
+/*******************************************************************************
+ * Dose Checkpoint
+ ******************************************************************************/ 
+/**
+ * @brief Continues the measurement of the last checkpoint (setup() only,
+ *        before pulseTask and uiTask run).
+ */
+static void restoreDoseCheckpoint(const DoseCheckpoint& checkpoint) {
+    pulseAccumulator.restoreTotalCounts(checkpoint.totalCounts);
+    totalCounts = checkpoint.totalCounts;
+    startTime -= checkpoint.elapsedMs; // Average over the whole measurement
+    publishPulseSnapshot(0);
+
+    doseAccumulator.restore(checkpoint.cumulativemSv);
+    doseAccumulatorLock.publish(doseAccumulator);
+    doseStats.maximum = checkpoint.maxuSvHr;
+    cumulativemSv = checkpoint.cumulativemSv;
+    maxuSvHr = checkpoint.maxuSvHr;
+    publishDoseSnapshot();
+
+    xSemaphoreTake(chartDataMutex, portMAX_DELAY);
+    chart1History.clear();
+    for (uint8_t i = 0; i < checkpoint.hourlyCount; i++) chart1History.push(checkpoint.hourly[i]);
+    chart3History.clear();
+    for (uint8_t i = 0; i < checkpoint.dailyCount; i++) chart3History.push(checkpoint.daily[i]);
+    chartDataVersion++;
+    chart1Version++;
+    chart3Version++;
+    xSemaphoreGive(chartDataMutex);
+    chart1MaxValue = chartScaleMax(chart1History.max());
+    chart3MaxValue = chartScaleMax(chart3History.max());
+#if !HEADLESS
+    drawChart1();
+    drawChart3();
+#endif
+
+    DEBUG_PRINTF("Dose checkpoint %lu restored: %.4f mSv, %lu counts, %u/%u chart intervals\n",
+                 (unsigned long)checkpoint.sequence, checkpoint.cumulativemSv,
+                 (unsigned long)checkpoint.totalCounts, checkpoint.hourlyCount, checkpoint.dailyCount);
+}
+
+/**
+ * @brief The session's 1-hour average rate as its background, unless an alarm
+ *        sounds or pulses are injected. Runs on the job task or before logger sleep.
+ */
+static bool collectBackground(BackgroundRecord& record) {
+    if (alarmSoundingLevel() != ALARM_LEVEL_NONE || pulseInjectRunning()) return false;
+    PulseSnapshot snap;
+    if (!pulseSnapshotLock.read(snap)) return false;
+    record.cps = snap.ewmaCpm[RATE_EWMA_1H] / 60.0f;
+    record.sigmaCps = snap.ewmaSigmaCpm[RATE_EWMA_1H] / 60.0f;
+    record.seconds = snap.secondsClosed;
+    record.utcMs = timeBaseUtcValid() ? timeBaseUtcUs() / 1000 : 0;
+    return true;
+}
+
+/**
+ * @brief Fills a checkpoint from the live values. Runs on the checkpoint task or the web task.
+ */
+static void collectDoseCheckpoint(DoseCheckpoint& checkpoint) {
+    PulseSnapshot pulse;
+    memset(&pulse, 0, sizeof(pulse));
+    pulseSnapshotLock.read(pulse);
+    checkpoint.totalCounts = pulse.totalCounts;
+    checkpoint.elapsedMs = millis() - startTime;
+    DoseSnapshot dose = getDoseSnapshot();
+    checkpoint.cumulativemSv = dose.cumulativeMsv;
+    checkpoint.maxuSvHr = dose.maximumUsvH;
+
+    xSemaphoreTake(chartDataMutex, portMAX_DELAY);
+    checkpoint.hourlyCount = (uint8_t)chart1History.size();
+    for (size_t i = 0; i < chart1History.size(); i++) checkpoint.hourly[i] = chart1History[i];
+    checkpoint.dailyCount = (uint8_t)chart3History.size();
+    for (size_t i = 0; i < chart3History.size(); i++) checkpoint.daily[i] = chart3History[i];
+    xSemaphoreGive(chartDataMutex);
+}
+
+#if !HEADLESS
+// Main screen value labels: precision and minimum redraw interval per widget
+static LabelBinding currentRadLabel(2, 250);
+static LabelBinding averageRadLabel(2, 1000);
+static LabelBinding maximumRadLabel(2, 250);
+static LabelBinding cumulativeRadLabel(2, 1000);
+static LabelBinding currentAlarmLabel(1, 0);     ///< Threshold labels follow the configuration at once
+static LabelBinding cumulativeAlarmLabel(1, 0);
+static LabelBinding currentVoltageLabel(2, 250, " V");
+static LabelBinding targetVoltageLabel(2, 0, " V");
+// Half-width of the interval of the dose rate; the fonts have no plus-minus glyph
+static LabelBinding currentErrorLabel(2, 1000, " (95%)", "+/- ");
+
+/**
+ * @brief Creates the uncertainty label under the dose-rate readout (not part of the generated screen).
+ */
+static void createCurrentErrorLabel() {
+    lv_obj_t* label = lv_label_create(ui_MainScreen);
+    lv_obj_set_style_text_color(label, lv_color_hex(0xA0A0A0), 0);
+    lv_label_set_text(label, "");
+    lv_obj_align_to(label, ui_CurrentRad, LV_ALIGN_OUT_BOTTOM_LEFT, 4, 0);
+    uiBackdropKeepLive(label);
+    currentErrorLabel.attach(label);
+}
+
+/**
+ * @brief Binds the value labels to their widgets. Called when the main screen is built.
+ */
+void attachLabelBindings() {
+#if READOUT_SPRITES
+    // Labels without a frame are set through LVGL as usual
+    currentRadLabel.attach(ui_CurrentRad, readoutSpriteSetText);
+    averageRadLabel.attach(ui_AverageRad, readoutSpriteSetText);
+    maximumRadLabel.attach(ui_MaximumRad, readoutSpriteSetText);
+    cumulativeRadLabel.attach(ui_CumulativeRad, readoutSpriteSetText);
+#else
+    currentRadLabel.attach(ui_CurrentRad);
+    averageRadLabel.attach(ui_AverageRad);
+    maximumRadLabel.attach(ui_MaximumRad);
+    cumulativeRadLabel.attach(ui_CumulativeRad);
+#endif
+    currentAlarmLabel.attach(ui_CurrentAlarm);
+    cumulativeAlarmLabel.attach(ui_CumulativeAlarm);
+}
+
+/*******************************************************************************
+ * Screen Hooks
+ *
+ * Each hook attaches the application to the widgets of a screen that was just
+ * built, or detaches it before the screen is deleted. The generated widget
+ * globals of a deleted screen would dangle; the ones used here are cleared.
+ ******************************************************************************/
+static void mainScreenCreated(lv_obj_t* screen) {
+    bool currentRadFrame = false;
+#if READOUT_SPRITES
+    // Widest values kept in a frame; longer ones are drawn by LVGL meanwhile
+    currentRadFrame = readoutSpriteAttach(ui_CurrentRad, "8888.88");
+    if (!currentRadFrame) DEBUG_PRINTLN("Readout frame unavailable for the dose rate");
+    readoutSpriteAttach(ui_AverageRad, "888.88");
+    readoutSpriteAttach(ui_MaximumRad, "888.88");
+    readoutSpriteAttach(ui_CumulativeRad, "888.88");
+#endif
+    attachLabelBindings();
+    createCurrentErrorLabel();
+#if DIGIT_SPRITES
+    // The two draw hooks would both replace the label's text drawing
+    if (!currentRadFrame && !digitSpritesAttach(ui_CurrentRad, " -.0123456789")) {
+        DEBUG_PRINTLN("Digit sprites unavailable, drawing glyphs");
+    }
+#endif
+    createBatteryLabel();
+    createScalerLabel();
+    // Everything else on the screen is drawn once into its backdrop
+    lv_obj_t* live[] = {ui_CurrentRad,   ui_AverageRad,      ui_MaximumRad, ui_CumulativeRad,
+                        ui_CurrentAlarm, ui_CumulativeAlarm, batteryLabel,  scalerLabel};
+    for (lv_obj_t* obj : live) uiBackdropKeepLive(obj);
+    // Long press on the dose rate; hidden at the bake, so drawn as usual when shown
+    searchViewAttach(screen, ui_CurrentRad, searchReferenceCps);
+}
+
+static void mainScreenDestroyed(lv_obj_t* screen) {
+    currentRadLabel.attach(nullptr);
+    averageRadLabel.attach(nullptr);
+    maximumRadLabel.attach(nullptr);
+    cumulativeRadLabel.attach(nullptr);
+    currentAlarmLabel.attach(nullptr);
+    cumulativeAlarmLabel.attach(nullptr);
+    currentErrorLabel.attach(nullptr);
+    ui_CurrentRad = ui_AverageRad = ui_MaximumRad = ui_CumulativeRad = NULL;
+    ui_CurrentAlarm = ui_CumulativeAlarm = NULL;
+    batteryLabel = NULL;
+    scalerLabel = NULL;
+}
+
+/**
+ * @brief Swipe left / right on a chart screen: next / previous chart screen.
+ *
+ * Gestures bubble up from the widget under the finger; the history plot
+ * keeps its own swipes (it does not bubble them).
+ */
+static void chartSwipeCb(lv_event_t* e) {
+    static const UiScreenId charts[] = {UI_SCREEN_CHARTS1H, UI_SCREEN_CHARTS24H, UI_SCREEN_SPECTRUM};
+    static const uint8_t count = sizeof(charts) / sizeof(charts[0]);
+    lv_indev_t* indev = lv_indev_get_act();
+    if (!indev) return;
+    lv_dir_t dir = lv_indev_get_gesture_dir(indev);
+    if (dir != LV_DIR_LEFT && dir != LV_DIR_RIGHT) return;
+
+    UiScreenId active = uiScreenActive();
+    for (uint8_t i = 0; i < count; i++) {
+        if (charts[i] != active) continue;
+        uint8_t next = dir == LV_DIR_LEFT ? (i + 1) % count : (i + count - 1) % count;
+        lv_indev_wait_release(indev); // The same swipe must not act on the new screen
+        uiScreenLoad(charts[next]);
+        return;
+    }
+}
+
+static void charts1hCreated(lv_obj_t* screen) {
+    chart1Series = setupChart(ui_Chart1, CHART1_SEGMENTS, lv_color_hex(0x89DE10), chart1MaxValue);
+    timeSeriesViewAttach(screen, ui_Chart1, &historyStore); // Tap the chart to open it
+    sourceMapViewAttach(ui_Chart1); // Long press for the source map
+    lv_obj_add_event_cb(screen, chartSwipeCb, LV_EVENT_GESTURE, NULL);
+}
+
+static void charts1hDestroyed(lv_obj_t* screen) {
+    sourceMapViewAttach(nullptr);
+    chart1Series = nullptr;
+    ui_Chart1 = NULL;
+}
+
+static void charts24hCreated(lv_obj_t* screen) {
+    chart3Series = setupChart(ui_Chart3, CHART3_SEGMENTS, lv_color_hex(0xE0C810), chart3MaxValue);
+    surveyTrackViewAttach(ui_Chart3); // Long press for the survey track
+    lv_obj_add_event_cb(screen, chartSwipeCb, LV_EVENT_GESTURE, NULL);
+}
+
+static void charts24hDestroyed(lv_obj_t* screen) {
+    surveyTrackViewAttach(nullptr);
+    chart3Series = nullptr;
+    ui_Chart3 = NULL;
+}
+
+static void spectrumScreenCreated(lv_obj_t* screen) {
+    spectrumViewAttach(ui_Chart4, &spectrum);
+    spectrumWaterfallAttach(ui_Chart4);
+    lv_obj_add_event_cb(screen, chartSwipeCb, LV_EVENT_GESTURE, NULL);
+}
+
+static void spectrumScreenDestroyed(lv_obj_t* screen) {
+    spectrumViewAttach(nullptr, &spectrum);
+    spectrumWaterfallAttach(nullptr);
+    ui_Chart4 = NULL;
+}
+
+static void settingsScreenCreated(lv_obj_t* screen) {
+    lv_obj_add_event_cb(ui_Connect, connect_btn_event_cb, LV_EVENT_CLICKED, NULL);
+    lv_obj_add_event_cb(ui_OnStartup, onstartup_checkbox_event_cb, LV_EVENT_VALUE_CHANGED, NULL);
+    lv_obj_add_event_cb(ui_EnableAlarmsCheckbox, alarms_checkbox_event_cb, LV_EVENT_VALUE_CHANGED, NULL);
+    lv_obj_add_event_cb(ui_CurrentSpinbox, spinbox_changed_event_cb, LV_EVENT_VALUE_CHANGED, NULL);
+    lv_obj_add_event_cb(ui_CumulativeSpinbox, spinbox_changed_event_cb, LV_EVENT_VALUE_CHANGED, NULL);
+    applyConfigToWidgets();
+    lv_label_set_text_static(ui_WIFIINFO, wifiInfoText);
+    calibrationViewAttach(screen, 50); // Below the navigation bar
+    eventJournalViewAttach(screen, 50);
+    wifiScanViewAttach(screen, 50, wifiNetworkSelected);
+}
+
+static void settingsScreenDestroyed(lv_obj_t* screen) {
+    ui_Connect = ui_OnStartup = ui_EnableAlarmsCheckbox = NULL;
+    ui_CurrentSpinbox = ui_CumulativeSpinbox = NULL;
+    ui_SSID = ui_PASSWORD = ui_WIFIINFO = ui_Keyboard = NULL;
+}
+
+/**
+ * @brief +/- on the voltage screen: moves the stored HV target by the user data (volts).
+ */
+static void hv_step_event_cb(lv_event_t* e) {
+    lv_event_code_t code = lv_event_get_code(e);
+    if (code != LV_EVENT_CLICKED && code != LV_EVENT_LONG_PRESSED_REPEAT) return;
+    if (plateauScanRunning()) return; // The scan stores its own operating point
+    float step = (float)(intptr_t)lv_event_get_user_data(e);
+    DeviceConfig config = getDeviceConfig();
+    config.hvTargetV += step;
+    setDeviceConfig(config); // Clamped to HV_MIN_V ... HV_MAX_V
+}
+
+/**
+ * @brief AUTO on the voltage screen: starts a plateau scan, or stops the running one.
+ */
+static void auto_calibrate_event_cb(lv_event_t* e) {
+    if (lv_event_get_code(e) != LV_EVENT_CLICKED) return;
+    if (plateauScanRunning()) {
+        plateauScanRequestStop();
+    } else {
+        plateauScanRequestStart();
+    }
+}
+
+static lv_chart_series_t* plateauSeries = nullptr; ///< Rate per step on ui_Chart2
+static uint32_t shownPlateauVersion = 0;
+static uint32_t spectrumAnnotationRuns = UINT32_MAX; ///< Analysis pass shown on the spectrum screen
+
+static void voltageScreenCreated(lv_obj_t* screen) {
+    lv_obj_add_event_cb(ui_MoreVoltage, hv_step_event_cb, LV_EVENT_ALL, (void*)(intptr_t)HV_STEP_V);
+    lv_obj_add_event_cb(ui_LessVoltage, hv_step_event_cb, LV_EVENT_ALL, (void*)(intptr_t)-HV_STEP_V);
+    lv_obj_add_event_cb(ui_AutoCalibrate, auto_calibrate_event_cb, LV_EVENT_CLICKED, NULL);
+    // The SquareLine series points at a static demo curve; the scan gets its own
+    lv_chart_remove_series(ui_Chart2, lv_chart_get_series_next(ui_Chart2, NULL));
+    plateauSeries = lv_chart_add_series(ui_Chart2, lv_color_hex(0x25FF00), LV_CHART_AXIS_PRIMARY_Y);
+    lv_chart_set_range(ui_Chart2, LV_CHART_AXIS_PRIMARY_Y, 0, 100);
+    shownPlateauVersion = UINT32_MAX;
+    targetVoltageLabel.attach(ui_TargetVoltage);
+    tubeHealthViewAttach(screen, ui_Chart2, 50); // Tap the plateau chart; below the navigation bar
+    if (getHvStatus().running) {
+        currentVoltageLabel.attach(ui_CurrentVoltage);
+    } else {
+        lv_label_set_text(ui_CurrentVoltage, "--- V"); // Fixed supply, nothing measured
+    }
+}
+
+static void voltageScreenDestroyed(lv_obj_t* screen) {
+    currentVoltageLabel.attach(nullptr);
+    targetVoltageLabel.attach(nullptr);
+    plateauSeries = nullptr;
+    ui_MoreVoltage = ui_LessVoltage = ui_CurrentVoltage = ui_TargetVoltage = NULL;
+    ui_AutoCalibrate = ui_Label26 = ui_Chart2 = NULL;
+}
+
+/*
+ * Shown hooks: a screen gets no updates while hidden, so each one redraws
+ * its widgets from the data model as it is loaded.
+ */
+static void mainScreenShown(lv_obj_t* screen) {
+    currentRadLabel.invalidate();
+    averageRadLabel.invalidate();
+    maximumRadLabel.invalidate();
+    cumulativeRadLabel.invalidate();
+    currentErrorLabel.invalidate();
+    currentAlarmLabel.invalidate();
+    cumulativeAlarmLabel.invalidate();
+    updateMainLabels(getDeviceConfig(), millis());
+}
+
+static void charts1hShown(lv_obj_t* screen) {
+    drawChart1();
+}
+
+static void charts24hShown(lv_obj_t* screen) {
+    drawChart3();
+}
+
+static void spectrumScreenShown(lv_obj_t* screen) {
+    spectrumAnnotationRuns = UINT32_MAX;
+    updateSpectrumAnnotation();
+}
+
+static void voltageScreenShown(lv_obj_t* screen) {
+    currentVoltageLabel.invalidate();
+    targetVoltageLabel.invalidate();
+    updateVoltageLabels(getDeviceConfig(), millis());
+    shownPlateauVersion = UINT32_MAX;
+    updatePlateauView();
+}
+
+static void registerScreenHooks() {
+    uiScreenSetHooks(UI_SCREEN_MAIN, mainScreenCreated, mainScreenDestroyed);
+    uiScreenSetHooks(UI_SCREEN_CHARTS1H, charts1hCreated, charts1hDestroyed);
+    uiScreenSetHooks(UI_SCREEN_CHARTS24H, charts24hCreated, charts24hDestroyed);
+    uiScreenSetHooks(UI_SCREEN_SPECTRUM, spectrumScreenCreated, spectrumScreenDestroyed);
+    uiScreenSetHooks(UI_SCREEN_SETTINGS, settingsScreenCreated, settingsScreenDestroyed);
+    uiScreenSetHooks(UI_SCREEN_VOLTAGE, voltageScreenCreated, voltageScreenDestroyed);
+    uiScreenSetShowHook(UI_SCREEN_MAIN, mainScreenShown);
+    uiScreenSetShowHook(UI_SCREEN_CHARTS1H, charts1hShown);
+    uiScreenSetShowHook(UI_SCREEN_CHARTS24H, charts24hShown);
+    uiScreenSetShowHook(UI_SCREEN_SPECTRUM, spectrumScreenShown);
+    uiScreenSetShowHook(UI_SCREEN_VOLTAGE, voltageScreenShown);
+#if UI_DELETE_RARE_SCREENS
+    uiScreenSetDeleteOnLeave(UI_SCREEN_SETTINGS, true);
+    uiScreenSetDeleteOnLeave(UI_SCREEN_VOLTAGE, true);
+#endif
+}
+
+/**
+ * @brief Main screen values and alarm thresholds.
+ */
+static void updateMainLabels(const DeviceConfig& config, uint32_t now) {
+    if (currentRadLabel.update(currentuSvHr, now)) latencyProbeLabel(ui_CurrentRad, pulseStats.totalCounts);
+    averageRadLabel.update(averageuSvHr, now);
+    maximumRadLabel.update(maxuSvHr, now);
+    cumulativeRadLabel.update(cumulativemSv, now);
+    currentErrorLabel.update(doseStats.currentError.halfWidth(), now);
+    
+    // Alarm threshold labels on the main screen (redrawn only when they change)
+    currentAlarmLabel.update(config.currentAlarmUsvH(), now);
+    cumulativeAlarmLabel.update(config.cumulativeAlarmMsv(), now);
+}
+
+/**
+ * @brief Voltage screen values; a plateau scan shows its step.
+ */
+static void updateVoltageLabels(const DeviceConfig& config, uint32_t now) {
+    HvStatus hv = getHvStatus();
+    currentVoltageLabel.update(hv.measuredV, now);
+    targetVoltageLabel.update(hv.overridden ? hv.targetV : config.hvTargetV, now);
+}
+
+/**
+ * @brief Updates the labels of the shown screen; the others catch up in their shown hooks.
+ */
+void updateLabels(const DeviceConfig& config) {
+    uint32_t now = millis();
+    if (uiScreenShown(UI_SCREEN_MAIN) && !searchViewShown()) updateMainLabels(config, now); // Covered while searching
+    if (uiScreenShown(UI_SCREEN_VOLTAGE)) updateVoltageLabels(config, now);
+}
+
+/**
+ * @brief Shows a firmware upload's progress on top of every screen; the
+ *        measurement keeps running underneath.
+ */
+static void updateOtaProgress() {
+    static lv_obj_t* otaLabel = nullptr;
+    static char shown[48] = "";
+    static uint32_t failedSinceMs = 0;
+    OtaStatus ota = getOtaStatus();
+    char text[48] = "";
+    if (ota.state == OTA_RECEIVING) {
+        if (ota.total) {
+            snprintf(text, sizeof(text), "Updating %u%%", (unsigned)(100ULL * ota.written / ota.total));
+        } else {
+            snprintf(text, sizeof(text), "Updating %lu KB", (unsigned long)(ota.written / 1024));
+        }
+    } else if (ota.state == OTA_VERIFYING) {
+        strlcpy(text, "Verifying update", sizeof(text));
+    } else if (ota.state == OTA_READY) {
+        strlcpy(text, "Update verified, restarting", sizeof(text));
+    } else if (ota.state == OTA_FAILED) {
+        // Shown for a while, then the screen is left alone until the next upload
+        if (!failedSinceMs) failedSinceMs = millis();
+        if (millis() - failedSinceMs < 10000) snprintf(text, sizeof(text), "Update failed: %s", ota.error);
+    }
+    if (ota.state != OTA_FAILED) failedSinceMs = 0;
+    if (strcmp(text, shown) == 0) return;
+    strlcpy(shown, text, sizeof(shown));
+    if (!otaLabel) {
+        otaLabel = lv_label_create(lv_layer_top());
+        lv_obj_align(otaLabel, LV_ALIGN_TOP_MID, 0, 4);
+        lv_obj_set_style_text_color(otaLabel, lv_color_white(), 0);
+        lv_obj_set_style_bg_color(otaLabel, lv_color_hex(0x161616), 0);
+        lv_obj_set_style_bg_opa(otaLabel, LV_OPA_80, 0);
+        lv_obj_set_style_pad_hor(otaLabel, 6, 0);
+    }
+    lv_label_set_text_static(otaLabel, shown);
+    if (text[0]) {
+        lv_obj_clear_flag(otaLabel, LV_OBJ_FLAG_HIDDEN);
+    } else {
+        lv_obj_add_flag(otaLabel, LV_OBJ_FLAG_HIDDEN);
+    }
+}
+
+/**
+ * @brief Plots the plateau scan on the voltage screen: rate per step relative
+ *        to the highest one, and the progress on the AUTO button.
+ */
+static void updatePlateauView() {
+    uint32_t version = plateauScanVersion();
+    if (!plateauSeries || version == shownPlateauVersion) return;
+    shownPlateauVersion = version;
+    PlateauScanStatus scan = getPlateauScanStatus();
+
+    bool running = scan.state == PLATEAU_SETTLING || scan.state == PLATEAU_COUNTING;
+    if (running) {
+        lv_label_set_text_fmt(ui_Label26, "%u/%u", (unsigned)(scan.count + 1), (unsigned)scan.steps);
+    } else {
+        lv_label_set_text(ui_Label26, "AUTO");
+    }
+
+    uint16_t points = scan.steps > 2 ? scan.steps : 2;
+    lv_chart_set_point_count(ui_Chart2, points);
+    float maxRate = 0.0f;
+    for (uint8_t i = 0; i < scan.count; i++) {
+        if (scan.points[i].rate() > maxRate) maxRate = scan.points[i].rate();
+    }
+    for (uint16_t i = 0; i < points; i++) {
+        lv_coord_t value = LV_CHART_POINT_NONE;
+        if (i < scan.count && maxRate > 0.0f) value = (lv_coord_t)lroundf(scan.points[i].rate() * 100.0f / maxRate);
+        lv_chart_set_value_by_id(ui_Chart2, plateauSeries, i, value);
+    }
+    lv_chart_refresh(ui_Chart2);
+}
+
+/**
+ * @brief Shows the fitted reference lines on the spectrum screen after each analysis pass.
+ */
+static void updateSpectrumAnnotation() {
+    static uint32_t shownCounts = UINT32_MAX;
+    SpectrumAnalysis analysis = getSpectrumAnalysis();
+    if (analysis.runs == spectrumAnnotationRuns && analysis.totalCounts == shownCounts) return;
+    spectrumAnnotationRuns = analysis.runs;
+    shownCounts = analysis.totalCounts;
+
+    char text[96];
+    size_t length = 0;
+    text[0] = '\0';
+    for (uint8_t i = 0; i < SPECTRUM_LINE_COUNT; i++) {
+        const SpectrumLineResult& line = analysis.lines[i];
+        if (!line.found || length >= sizeof(text)) continue;
+        length += snprintf(text + length, sizeof(text) - length, "%s%s %.0f keV (%.1f%%)",
+                           length ? "\n" : "", line.isotope, line.energyKeV,
+                           100.0f * line.fwhmKeV / line.energyKeV);
+    }
+    spectrumViewSetAnnotation(text);
+}
+
+#endif // !HEADLESS
+
+/*******************************************************************************
+ * WiFi/OTA Code
+ ******************************************************************************/ 
+// The OTA warning page. Constant, so it is sent from flash without building
+// anything on the heap.
+static const char OTA_WARNING_PAGE[] PROGMEM = R"HTML(<!DOCTYPE html><html><head><meta charset='UTF-8'><meta name='viewport' content='width=device-width, initial-scale=1'>
+<title>OTA Update Warning</title>
+<style>
+body { font-family: 'Segoe UI', Tahoma, Geneva, Verdana, sans-serif; margin: 0; padding: 20px; text-align: center; background-color: #0f1317; color: #fff; }
+.warning-container { max-width: 600px; margin: 0 auto; background-color: #262a36; padding: 20px; border-radius: 10px; box-shadow: 0 4px 8px rgba(0,0,0,0.3); }
+h1 { color: #D8C12C; }
+.warning-icon { margin-bottom: 20px; }
+.warning-text { color: #fff; text-align: left; margin: 20px 0; line-height: 1.5; }
+.btn-container { display: flex; justify-content: center; gap: 20px; margin-top: 20px; }
+.btn { display: inline-flex; justify-content: center; align-items: center; background-color: #D8C12C; color: #0f1317; padding: 12px 24px; text-decoration: none; border-radius: 5px; font-weight: bold; border: none; cursor: pointer; font-size: 16px; min-width: 200px; height: 50px; box-sizing: border-box; }
+.btn:hover { background-color: #7274ee; color: #fff; }
+.back-btn { background-color: #262a36; color: #fff; border: 1px solid #7274ee; }
+.back-btn:hover { background-color: #7274ee; }
+form { display: inline-block; margin: 0; }
+button.btn { width: 100%; }
+strong { color: #D8C12C; }
+ul { color: #fff; }
+</style>
+</head><body>
+<div class='warning-container'>
+<div class='warning-icon'><svg xmlns='http://www.w3.org/2000/svg' width='64' height='64' viewBox='0 0 24 24'><path fill='#D8C12C' d='M12 2C6.48 2 2 6.48 2 12s4.48 10 10 10 10-4.48 10-10S17.52 2 12 2zm1 15h-2v-2h2v2zm0-4h-2V7h2v6z'/></svg></div>
+<h1>WARNING: FIRMWARE UPDATE</h1>
+<div class='warning-text'>
+<p><strong>Uploading incorrect firmware can brick your device!</strong></p>
+<p>Please ensure that:</p>
+<ul style='text-align: left;'>
+<li>You are uploading firmware specifically built for the Radiation Detector</li>
+<li>The firmware version is compatible with your hardware</li>
+<li>You have a stable power connection during the update</li>
+<li>Your WiFi connection is stable during the update</li>
+</ul>
+<p>If the update fails, you may need to manually update the firmware using a USB connection.</p>
+</div>
+<div class='btn-container'>
+<a href='/' class='btn back-btn'>Cancel</a>
+<form method='post' action='/acknowledge-ota' style='width: 200px;'><button type='submit' class='btn'>I Understand, Proceed</button></form>
+</div>
+</div></body></html>)HTML";
+
+static void serveOtaWarningPage(WebServer& server) {
+    server.send_P(200, "text/html", OTA_WARNING_PAGE);
+}
+
+/**
+ * @brief Dashboard, OTA warning page and ElegantOTA with its upload hooks.
+ */
+static void attachPageRoutes(WebServer& server) {
+    // Reset acknowledgment flag when server initializes
+    otaWarningAcknowledged = false;
+    
+    // Add route for the dashboard (pre-compressed, served from flash)
+    server.on("/", [](){
+        sendDashboardPage(webServer());
+    });
     
-    // IMPORTANT: Set the startup screen IMMEDIATELY to avoid flicker
-    // This overrides the default screen set in ui_init()
-    lv_scr_load(ui_Startup_screen);
+    // Chart script of the dashboard, from flash so the page works offline
+    server.on(dashboardChartsPath(), HTTP_GET, [](){
+        sendDashboardCharts(webServer());
+    });
     
-    // Create mutex for thread-safe data access
-    dataMutex = xSemaphoreCreateMutex();
+    // Service worker and manifest: the dashboard opens from the browser's cache
+    server.on("/sw.js", HTTP_GET, [](){
+        sendDashboardWorker(webServer());
+    });
+    server.on("/manifest.webmanifest", HTTP_GET, [](){
+        sendDashboardManifest(webServer());
+    });
     
-    // Initialize pulse buffer and history
-    memset(pulseBuffer, 0, sizeof(pulseBuffer));
-    memset(pulseHistory, 0, sizeof(pulseHistory));
-    pulseBufferIndex = 0;
-    pulseHistoryIndex = 0;
+    // Add a dedicated route for the warning page
+    server.on("/warning", HTTP_GET, []() {
+        serveOtaWarningPage(webServer());
+    });
     
-    // Initialize and validate charts
-    assignChartSeries();
+    // Add a route to handle the acknowledgment form submission
+    server.on("/acknowledge-ota", HTTP_POST, []() {
+        otaWarningAcknowledged = true;
+        webServer().sendHeader("Location", "/update", true);
+        webServer().send(302, "text/plain", "");
+    });
     
-    // Additional validation for charts
-    if (ui_Chart1 && ui_Chart3) {
-        drawChart1();
-        drawChart3();
-        lv_timer_handler();
-        DEBUG_PRINTLN("Charts explicitly zeroed and drawn on screen.");
+    // Initialize ElegantOTA; the hooks checkpoint, pace and verify the upload
+    ElegantOTA.begin(&server);
+    otaGuardAttach(server);
+    otaStreamAttach(server); // Compressed and delta images for weak links
+    DEBUG_PRINTLN("OTA initialized with warning page.");
+}
+
+/**
+ * @brief Sets @p dst to @p value as JSON number text with D decimals
+ *        (fixed_format.h), skipping ArduinoJson's float serialisation.
+ *        NaN and infinity stay floats, which serialise as null.
+ */
+template <uint8_t D, typename TDestination>
+static void setFixed(TDestination dst, float value) {
+    char text[16];
+    size_t length = isfinite(value) ? formatFixed<D>(text, sizeof(text), value) : 0;
+    if (length) {
+        dst.set(serialized(text, length));
     } else {
-        DEBUG_PRINTLN("WARNING: Charts not properly initialized!");
+        dst.set(value);
     }
-    
-    initBuzzer();
+}
 
-    // Attach UI event callbacks
-    lv_obj_add_event_cb(ui_Connect, connect_btn_event_cb, LV_EVENT_CLICKED, NULL);
-    lv_obj_add_event_cb(ui_OnStartup, onstartup_checkbox_event_cb, LV_EVENT_VALUE_CHANGED, NULL);
-    lv_obj_add_event_cb(ui_EnableAlarmsCheckbox, alarms_checkbox_event_cb, LV_EVENT_VALUE_CHANGED, NULL);
-    lv_obj_add_event_cb(ui_CurrentSpinbox, spinbox_changed_event_cb, LV_EVENT_VALUE_CHANGED, NULL);
-    lv_obj_add_event_cb(ui_CumulativeSpinbox, spinbox_changed_event_cb, LV_EVENT_VALUE_CHANGED, NULL);
+template <uint8_t D>
+static void addFixed(JsonArray array, float value) {
+    setFixed<D>(array.add<JsonVariant>(), value);
+}
 
-    // Set up power management
-    setupPowerManagement();
+/**
+ * @brief Sends the hourly or @p daily chart array with a per-chart ETag.
+ */
+static void sendChartArray(WebServer& server, bool daily) {
+    xSemaphoreTake(chartDataMutex, portMAX_DELAY);
+    uint32_t version = daily ? chart3Version : chart1Version;
+    xSemaphoreGive(chartDataMutex);
+    char etag[24];
+    snprintf(etag, sizeof(etag), "\"%c%lu\"", daily ? 'd' : 'h', (unsigned long)version);
+    webSendHeaders(server, WEB_HEADERS_NO_CACHE);
+    if (webNotModified(server, etag)) return;
+    
+    JsonArenaLease lease;
+    JsonDocument doc(lease.allocator());
+    JsonArray data = doc.to<JsonArray>();
+    xSemaphoreTake(chartDataMutex, portMAX_DELAY);
+    if (daily) {
+        for (size_t i = 0; i < CHART3_SEGMENTS; i++) addFixed<2>(data, i < chart3History.size() ? chart3History[i] : 0.0f);
+    } else {
+        for (size_t i = 0; i < CHART1_SEGMENTS; i++) addFixed<2>(data, i < chart1History.size() ? chart1History[i] : 0.0f);
+    }
+    xSemaphoreGive(chartDataMutex);
+    webSendJson(server, 200, doc);
+}
+
+/**
+ * @brief Builds and reuses of the /api/data bodies ("perf").
+ */
+static void printApiBodyCache(Print& out) {
+    static const char* const NAMES[API_BODY_VARIANTS] = {"json", "json+charts", "msgpack", "msgpack+charts"};
+    out.print("API bodies:");
+    for (uint8_t i = 0; i < API_BODY_VARIANTS; i++) {
+        const ApiBodyCache& cache = apiBodies[i];
+        if (!cache.body) continue;
+        out.printf(" %s %lu built/%lu reused (%u B)", NAMES[i], (unsigned long)cache.builds,
+                   (unsigned long)cache.hits, (unsigned)cache.length);
+    }
+    out.println();
+}
 
-    // Restore saved settings and load alarms 
-    preferences.begin("settings", true);
+/**
+ * @brief /api/data and the diagnostics endpoints.
+ */
+static void attachApiRoutes(WebServer& server) {
+    // Add JSON API endpoint. The values change once per closed second and the
+    // chart arrays once per interval, so the ETag is built from those two
+    // counters and pollers within the same second share one serialised body.
+    server.on("/api/data", HTTP_GET, [](){
+        WebServer& server = webServer();
+        webSendHeaders(server, WEB_HEADERS_LIVE);
+        // Collectors ask for MessagePack; browsers and older clients get JSON
+        bool msgpack = server.header("Accept").indexOf("application/msgpack") >= 0;
+        // "?charts=0" leaves the arrays to /api/data/hourly and /api/data/daily;
+        // hourly_gen and daily_gen tell the client when to fetch them
+        bool charts = server.arg("charts") != "0";
+        char etag[40];
+        snprintf(etag, sizeof(etag), "\"%lu.%lu.%c%c\"", (unsigned long)getApiDataGeneration(),
+                 (unsigned long)getChartDataVersion(), msgpack ? 'm' : 'j', charts ? 'c' : 'v');
+        if (webNotModified(server, etag)) return;
+        ApiBodyCache& cache = apiBodies[(msgpack ? 2 : 0) + (charts ? 1 : 0)];
+        if (!cache.body) {
+            cache.body = (char*)heap_caps_malloc(API_JSON_BUFFER_SIZE, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+            if (!cache.body) cache.body = (char*)heap_caps_malloc(API_JSON_BUFFER_SIZE, MALLOC_CAP_8BIT);
+            if (!cache.body) {
+                server.send(503, "text/plain", "Out of memory");
+                return;
+            }
+        }
+        if (strcmp(etag, cache.tag) != 0) {
+            cache.length = writeRadiationData(cache.body, API_JSON_BUFFER_SIZE,
+                                              msgpack ? API_FORMAT_MSGPACK : API_FORMAT_JSON, charts);
+            strlcpy(cache.tag, cache.length ? etag : "", sizeof(cache.tag));
+            cache.builds++;
+        } else {
+            cache.hits++;
+        }
+        if (cache.length == 0) {
+            server.send(500, "text/plain", "Data too large");
+            return;
+        }
+        server.send_P(200, msgpack ? "application/msgpack" : "application/json", cache.body, cache.length);
+    });
     
-    // Load onStartup setting
-    bool onStartup = preferences.getBool("onstartup", false);
+    // The chart arrays on their own, revalidated per chart
+    server.on("/api/data/hourly", HTTP_GET, [](){
+        sendChartArray(webServer(), false);
+    });
+    server.on("/api/data/daily", HTTP_GET, [](){
+        sendChartArray(webServer(), true);
+    });
     
-    // Load alarm state explicitly
-    bool alarmEnabled = preferences.getBool("alarmEnabled", false); // Default is disabled
-    alarmDisabled = !alarmEnabled;
+    // Event trace dump, the same text as the serial "trace dump"
+    server.on("/api/trace", HTTP_GET, [](){
+        traceDumpHttp(webServer());
+    });
     
-    // Log the loaded settings
-    DEBUG_PRINTF("Loaded settings: onStartup=%s, alarmEnabled=%s\n", 
-                onStartup ? "true" : "false", 
-                alarmEnabled ? "true" : "false");
+    // Stack high-water marks, CPU load and heap state with their recent history
+    server.on("/api/sysinfo", HTTP_GET, [](){
+        webSendHeaders(webServer(), WEB_HEADERS_NO_CACHE);
+        WebArenaText body;
+        writeSysInfoJson(body);
+        webSendText(webServer(), 200, "application/json", body);
+    });
     
-    preferences.end();
+    // End-to-end latency histograms and the last certification run
+    server.on("/api/latency", HTTP_GET, [](){
+        webSendHeaders(webServer(), WEB_HEADERS_CORS);
+        JsonArenaLease lease;
+        JsonDocument doc(lease.allocator());
+        buildLatencyProbeJson(doc);
+        webSendJson(webServer(), 200, doc);
+    });
     
-    // Set UI checkbox states (but wait to update the spinbox values until UI task)
-    if (onStartup)
-        lv_obj_add_state(ui_OnStartup, LV_STATE_CHECKED);
-    else
-        lv_obj_clear_state(ui_OnStartup, LV_STATE_CHECKED);
+    // Scaler run in progress and the last results
+    server.on("/api/scaler", HTTP_GET, [](){
+        webSendHeaders(webServer(), WEB_HEADERS_NO_CACHE);
+        JsonArenaLease lease;
+        JsonDocument doc(lease.allocator());
+        buildScalerJson(doc);
+        webSendJson(webServer(), 200, doc);
+    });
     
-    // Force LVGL to process UI changes
-    lv_timer_handler();
-
-    // Start WiFi timer if auto-connect is enabled
-    if (onStartup) {
-        DEBUG_PRINTLN("Auto-connect enabled, starting WiFi timer");
-        lv_timer_create(wifi_connect_timer_cb, 2000, NULL);
-    }
+    // Last "bench" report, for comparing firmware builds
+    server.on("/api/bench", HTTP_GET, [](){
+        BenchReport report;
+        if (!getBenchReport(report)) {
+            webServer().send(404, "text/plain", "No benchmark run yet (serial \"bench\")");
+            return;
+        }
+        webSendHeaders(webServer(), WEB_HEADERS_CORS);
+        JsonArenaLease lease;
+        JsonDocument doc(lease.allocator());
+        buildBenchReportJson(report, doc);
+        webSendJson(webServer(), 200, doc);
+    });
+}
 
-    startTime = millis();
-    lastLoop = startTime;
-    
-    // Create tasks on specific cores
-    xTaskCreatePinnedToCore(
-        pulseTask,           // Task function
-        "PulseTask",         // Task name
-        4096,               // Stack size
-        NULL,               // Parameters
-        1,                  // Priority
-        &pulseTaskHandle,   // Task handle
-        0                   // Core ID (Core 0)
-    );
-    
-    xTaskCreatePinnedToCore(
-        uiTask,             // Task function
-        "UITask",           // Task name
-        8192,               // Stack size (larger for UI)
-        NULL,               // Parameters
-        1,                  // Priority
-        &uiTaskHandle,      // Task handle
-        1                   // Core ID (Core 1)
-    );
-    
-    DEBUG_PRINTLN("Setup completed.");
+/**
+ * @brief Copies the readings for a /metrics scrape (web task).
+ */
+static void readMetrics(MetricsReadings& out) {
+    PulseSnapshot pulse{};
+    pulseSnapshotLock.read(pulse);
+    DoseSnapshot dose = getDoseSnapshot();
+    out.doseRateUsvH = dose.currentUsvH;
+    out.doseRateSigmaUsvH = dose.currentError.sigma;
+    out.averageUsvH = dose.averageUsvH;
+    out.averageSigmaUsvH = dose.averageError.sigma;
+    memcpy(out.averagesUsvH, dose.averagesUsvH, sizeof(out.averagesUsvH));
+    out.maximumUsvH = dose.maximumUsvH;
+    out.cumulativeMsv = dose.cumulativeMsv;
+    out.cpm = dose.correctedCpm;
+    out.cpmRaw = dose.rawCpm;
+    out.totalCounts = pulse.totalCounts;
+    out.alarmLevel = getAlarmStatus().level;
+    out.sampleJitter = sampleJitter;
+    out.handoff = processLatency;
+    out.readingsDropped = pulseSamples.dropped();
 }
 
-void loop() {
-    // Main loop is now empty as tasks handle everything
-    vTaskDelay(pdMS_TO_TICKS(1000)); // Prevent watchdog trigger
+/**
+ * @brief Fills the serial link's STATUS frame (link task).
+ */
+static void readSerialStatus(SerialStatusPayload& out) {
+    PulseSnapshot pulse{};
+    pulseSnapshotLock.read(pulse);
+    out.uptimeSeconds = timeBaseSeconds();
+    out.totalCounts = pulse.totalCounts;
+    DoseSnapshot dose = getDoseSnapshot();
+    out.cpm = dose.correctedCpm;
+    out.doseRateUsvH = dose.currentUsvH;
+    out.cumulativeMsv = dose.cumulativeMsv;
+    out.alarmLevel = getAlarmStatus().level;
 }
 
-/*******************************************************************************
- * Other Functions (Initialization, UI Setup, etc.)
- ******************************************************************************/ 
-void initSerial() {
-    Serial.begin(115200);
-    delay(50);  // Short delay to allow serial to initialize
-    Serial.flush();  // Flush any pending data
-    DEBUG_PRINTLN("Initializing Serial...");
+/**
+ * @brief Fills the BLE rate and alarm records from the /api/data snapshots (BLE task).
+ */
+static void readBleReadings(BleReadings& out) {
+    PulseSnapshot pulse{};
+    pulseSnapshotLock.read(pulse);
+    DoseSnapshot dose = getDoseSnapshot();
+    out.rate.timestamp = timeBaseUtcSeconds();
+    out.rate.currentUsvH = dose.currentUsvH;
+    out.rate.currentSigma = dose.currentError.sigma;
+    out.rate.averageUsvH = dose.averageUsvH;
+    out.rate.cumulativeMsv = dose.cumulativeMsv;
+    out.rate.cpm = dose.correctedCpm;
+    out.rate.totalCounts = pulse.totalCounts;
+
+    AlarmStatus alarm = getAlarmStatus();
+    out.alarm.level = alarm.level;
+    out.alarm.causes = alarm.causes;
+    out.alarm.reserved = 0;
+    out.alarm.rateUpperUsvH = alarm.rateUpperUsvH;
+    out.alarm.secondsToDoseAlarm = alarm.secondsToDoseAlarm;
 }
 
-void initTFT() {
-    static TFT_eSPI tft(SCREEN_WIDTH, SCREEN_HEIGHT);
-    tft.begin();
-    tft.setRotation(1);
-    uint16_t calData[5] = {300, 3597, 187, 3579, 6};
-    tft.setTouch(calData);
-    DEBUG_PRINTLN("TFT initialized.");
+/**
+ * @brief Fills this unit's ESP-NOW frame fields (ESP-NOW task).
+ */
+static void readEspNowReadings(EspNowReadings& out) {
+    PulseSnapshot pulse{};
+    pulseSnapshotLock.read(pulse);
+    DoseSnapshot dose = getDoseSnapshot();
+    out.doseRateUsvH = dose.currentUsvH;
+    out.cpm = dose.correctedCpm;
+    out.totalCounts = pulse.totalCounts;
+    out.alarmLevel = getAlarmStatus().level;
+    BatteryStatus battery = getBatteryStatus();
+    out.batteryPct = battery.state == BATTERY_STATE_NOT_CONFIGURED || battery.state == BATTERY_STATE_ABSENT
+                         ? 255
+                         : (uint8_t)battery.percent;
 }
 
-void initLVGL() {
-    lv_init();
-    lv_disp_draw_buf_init(&draw_buf, buf, NULL, SCREEN_WIDTH * SCREEN_HEIGHT / 10);
-    static lv_disp_drv_t disp_drv;
-    lv_disp_drv_init(&disp_drv);
-    disp_drv.hor_res = SCREEN_WIDTH;
-    disp_drv.ver_res = SCREEN_HEIGHT;
-    disp_drv.flush_cb = [](lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p) {
-        static TFT_eSPI tftDisp(SCREEN_WIDTH, SCREEN_HEIGHT);
-        static bool initted = false;
-        if (!initted) {
-            tftDisp.begin();
-            tftDisp.setRotation(1);
-            initted = true;
-        }
-        uint32_t w = (area->x2 - area->x1 + 1);
-        uint32_t h = (area->y2 - area->y1 + 1);
-        tftDisp.startWrite();
-        tftDisp.setAddrWindow(area->x1, area->y1, w, h);
-        tftDisp.pushColors((uint16_t *)&color_p->full, w * h, true);
-        tftDisp.endWrite();
-        lv_disp_flush_ready(drv);
-    };
-    disp_drv.draw_buf = &draw_buf;
-    lv_disp_drv_register(&disp_drv);
-
-    static lv_indev_drv_t indev_drv;
-    lv_indev_drv_init(&indev_drv);
-    indev_drv.type = LV_INDEV_TYPE_POINTER;
-    indev_drv.read_cb = [](lv_indev_drv_t *drv, lv_indev_data_t *data) {
-        static TFT_eSPI tftTouch(SCREEN_WIDTH, SCREEN_HEIGHT);
-        static bool inittedTouch = false;
-        if (!inittedTouch) {
-            tftTouch.begin();
-            tftTouch.setRotation(1);
-            uint16_t cData[5] = {267, 3646, 198, 3669, 6};
-            tftTouch.setTouch(cData);
-            inittedTouch = true;
-        }
-        uint16_t x, y;
-        bool touched = tftTouch.getTouch(&y, &x, 600);
-        if (!touched)
-            data->state = LV_INDEV_STATE_REL;
-        else {
-            data->state = LV_INDEV_STATE_PR;
-            data->point.x = x;
-            data->point.y = y;
-        }
-    };
-    lv_indev_drv_register(&indev_drv);
+/**
+ * @brief Copies the rate and alarm level for a UDP stream record (UDP task).
+ */
+static void readUdpStreamReadings(UdpStreamReadings& out) {
+    DoseSnapshot dose = getDoseSnapshot();
+    out.cpm = dose.correctedCpm;
+    out.doseRateUsvH = dose.currentUsvH;
+    out.alarmLevel = getAlarmStatus().level;
+}
 
-    ui_init();
-    DEBUG_PRINTLN("LVGL initialized + UI created.");
+/**
+ * @brief Pipeline parameters and state for a pulse trace header (pulseTask).
+ */
+static void readPulseTraceState(PulseTraceHeader& header) {
+    DeviceConfig config = getDeviceConfig();
+    header.startUtc = timeBaseUtcSeconds();
+    header.deadTimeUs = config.deadTimeUs;
+    header.cpmPerUsvH = config.cpmPerUsvH;
+    header.rateAlarmUsvH = config.currentAlarmUsvH();
+    header.doseAlarmMsv = config.cumulativeAlarmMsv();
+    header.warnFraction = ALARM_WARN_FRACTION;
+    header.dangerFactor = ALARM_DANGER_FACTOR;
+    header.bucketStartMs = pulseAccumulator.secondStartMs();
+    header.bucketCounts = pulseAccumulator.secondCounts();
+    header.doseMsv = doseAccumulator.msv();
 }
 
-void updateRealTimeStats(float cpm, float dtSec) {
-    // Calculate raw value using the proper conversion factor
-    // CONVERSION_FACTOR is 153.8, so we divide CPM by this value to get µSv/h
-    float rawCurrentuSvHr = cpm / CONVERSION_FACTOR;
+/**
+ * @brief Registers every route group and web task hook; the service attaches
+ *        them when WiFi first connects. New endpoints are added here only.
+ */
+static void registerWebRoutes() {
+    webServiceRoutes(attachPageRoutes);
+    webServiceRoutes(attachApiRoutes);
+    // Push stream used by the dashboard instead of polling /api/data
+    webServiceRoutes(liveEventsAttach);
+    // Packed binary history for bulk downloads
+    webServiceRoutes([](WebServer& server) { historyApiAttach(server, historyStore); });
+    // Current or saved spectrum for analysis software
+    webServiceRoutes([](WebServer& server) { spectrumExportAttach(server, spectrum); });
+    // Plateau scan progress and start / stop
+    webServiceRoutes(plateauScanAttach);
+    // Reference-source calibration progress and background / start / stop
+    webServiceRoutes(calibrationAttach);
+    // TLS front end counters and certificate fingerprint
+    webServiceRoutes(httpsServiceAttach);
+    // Typed configuration for provisioning
+    webServiceRoutes(configApiAttach);
+    // Event journal and alarm acknowledgement
+    webServiceRoutes(eventJournalAttach);
+    // Inter-arrival histogram and tube checks
+    webServiceRoutes(tubeHealthAttach);
+    // Rate anomaly detector and its event traces
+    webServiceRoutes(anomalyAttach);
+    // Prometheus scrape target
+    webServiceRoutes([](WebServer& server) { metricsAttach(server, readMetrics); });
+    // Detector ring as heard by an ESP-NOW hub
+    webServiceRoutes(espNowAttach);
+    // Source estimate from the ring's rates (hub)
+    webServiceRoutes(sourceLocatorAttach);
+#if !HEADLESS
+    // What the panel shows, for remote support
+    webServiceRoutes(screenMirrorAttach);
+#endif
     
-    // Add to the smoothing window
-    currentReadingsWindow[currentReadingIndex] = rawCurrentuSvHr;
-    currentReadingIndex = (currentReadingIndex + 1) % SMOOTHING_WINDOW_SIZE;
+    webServicePoll(liveEventsLoop);
+    webServicePoll(otaGuardLoop); // Delayed reboot into a verified image (ElegantOTA's own is off)
+#if !HEADLESS
+    webServicePoll(screenMirrorLoop);
+#endif
+}
+
+/**
+ * @brief A link came up with an address: updates the info label and
+ *        (re)announces mDNS; the web service starts on the first connection.
+ */
+static void onNetworkUp(IPAddress ip) {
+    strlcpy(wifi_ip, ip.toString().c_str(), sizeof(wifi_ip));
     
-    // Calculate smoothed value (moving average)
-    float sum = 0.0f;
-    int validReadings = 0;
-    for (int i = 0; i < SMOOTHING_WINDOW_SIZE; i++) {
-        if (currentReadingsWindow[i] > 0 || i < currentReadingIndex) {
-            sum += currentReadingsWindow[i];
-            validReadings++;
-        }
-    }
-    // Avoid division by zero
-    currentuSvHr = (validReadings > 0) ? (sum / validReadings) : 0.0f;
+    // Started on the first connection, re-announced on every reconnect
+    mdnsServiceAnnounce();
     
-    // Update average using total counts since start
-    unsigned long now = millis();
-    float totalTimeMin = (float)(now - startTime) / 60000.0f;
-    if (totalTimeMin > 0.0f) {
-        float avgCPM = (float)totalCounts / totalTimeMin;
-        averageuSvHr = avgCPM / CONVERSION_FACTOR;
-    }
+    // SNTP runs since setup(); the clock shows up once it has synced
+    char info[sizeof(wifiInfoText)];
+    snprintf(info, sizeof(info), "IP: %s%s", wifi_ip, timeBaseUtcValid() ? "" : "\nTime: syncing");
+    setWifiInfo(info);
     
-    // Update maximum if current reading is higher (but only if it seems valid)
-    if (currentuSvHr > maxuSvHr && currentuSvHr < 100.0f) { // Sanity check upper limit
-        maxuSvHr = currentuSvHr;
+    // Listener and routes are set up once; reconnects keep them. The
+    // setup portal holds port 80: it closes, then starts them itself
+    if (provisioningPortalOpen()) {
+        provisioningPortalStop();
+        return;
     }
-    
-    // Calculate dose increment in µSv, then convert to mSv (1 mSv = 1000 µSv)
-    // Formula: (µSv/h) / (3600 sec/h) * dt / 1000
-    float doseIncrement_mSv = (currentuSvHr / 3600.0f) * dtSec / 1000.0f;
-    cumulativemSv += doseIncrement_mSv;
+    webServiceBegin();
+    if (HTTPS_ENABLED) httpsServiceBegin(); // Passes requests on to the server just started
 }
 
-void updateLabels() {
-    char buffer[16];
-    snprintf(buffer, sizeof(buffer), "%.2f", currentuSvHr);
-    lv_label_set_text(ui_CurrentRad, buffer);
-    snprintf(buffer, sizeof(buffer), "%.2f", averageuSvHr);
-    lv_label_set_text(ui_AverageRad, buffer);
-    snprintf(buffer, sizeof(buffer), "%.2f", maxuSvHr);
-    lv_label_set_text(ui_MaximumRad, buffer);
-    snprintf(buffer, sizeof(buffer), "%.2f", cumulativemSv);
-    lv_label_set_text(ui_CumulativeRad, buffer);
-    
-    // Update alarm threshold labels on the main screen
-    if (ui_CurrentSpinbox && ui_CurrentAlarm) {
-        int32_t currentValue = lv_spinbox_get_value(ui_CurrentSpinbox);
-        float currentThreshold = (float)currentValue / 10.0f;
-        snprintf(buffer, sizeof(buffer), "%.1f", currentThreshold);
-        lv_label_set_text(ui_CurrentAlarm, buffer);
+/**
+ * @brief WiFi state handler (runs on the UI task).
+ */
+static void onWifiStateChanged(WifiState state) {
+    syslogSinkSetOnline(networkOnline());
+    switch (state) {
+        case WIFI_STATE_CONNECTING:
+            setWifiInfo("Connecting...");
+            break;
+            
+        case WIFI_STATE_CONNECTED:
+            DEBUG_PRINTLN("WiFi connected.");
+            onNetworkUp(WiFi.localIP());
+            break;
+            
+        case WIFI_STATE_BACKOFF:
+            DEBUG_PRINTLN("WiFi connection failed.");
+            setWifiInfo("Disconnected\nRetrying");
+            break;
+            
+        case WIFI_STATE_IDLE:
+        default:
+            setWifiInfo(wifiManagerSuspended() ? (ethernetLinkOnline() ? "Off (Ethernet)" : "Off") : "Disconnected");
+            break;
     }
-    
-    if (ui_CumulativeSpinbox && ui_CumulativeAlarm) {
-        int32_t cumulativeValue = lv_spinbox_get_value(ui_CumulativeSpinbox);
-        float cumulativeThreshold = (float)cumulativeValue / 10.0f;
-        snprintf(buffer, sizeof(buffer), "%.1f", cumulativeThreshold);
-        lv_label_set_text(ui_CumulativeAlarm, buffer);
+}
+
+/**
+ * @brief Ethernet link handler (runs on the UI task): the services move to
+ *        the cable with WiFi off, and back to WiFi when the link drops.
+ */
+static void onEthLinkChanged(EthLinkState state) {
+    switch (state) {
+        case ETH_LINK_ONLINE:
+            wifiManagerSuspend(WIFI_SUSPEND_ETHERNET, true);
+            onNetworkUp(networkLocalIP());
+            break;
+            
+        case ETH_LINK_DOWN:
+            wifiManagerSuspend(WIFI_SUSPEND_ETHERNET, false); // Rejoins the network it had, if any
+            if (wifiManagerState() == WIFI_STATE_IDLE) setWifiInfo(wifiManagerSuspended() ? "Off" : "Disconnected");
+            break;
+            
+        case ETH_LINK_UP:
+        default:
+            break;
     }
+    syslogSinkSetOnline(networkOnline());
 }
 
-/*******************************************************************************
- * WiFi/OTA Code
- ******************************************************************************/ 
-// Function to serve the OTA warning page
-void serveOtaWarningPage() {
-    String warningPage = "<!DOCTYPE html><html><head><meta charset='UTF-8'><meta name='viewport' content='width=device-width, initial-scale=1'>";
-    warningPage += "<title>OTA Update Warning</title>";
-    warningPage += "<style>";
-    warningPage += "body { font-family: 'Segoe UI', Tahoma, Geneva, Verdana, sans-serif; margin: 0; padding: 20px; text-align: center; background-color: #0f1317; color: #fff; }";
-    warningPage += ".warning-container { max-width: 600px; margin: 0 auto; background-color: #262a36; padding: 20px; border-radius: 10px; box-shadow: 0 4px 8px rgba(0,0,0,0.3); }";
-    warningPage += "h1 { color: #D8C12C; }";
-    warningPage += ".warning-icon { margin-bottom: 20px; }";
-    warningPage += ".warning-text { color: #fff; text-align: left; margin: 20px 0; line-height: 1.5; }";
-    warningPage += ".btn-container { display: flex; justify-content: center; gap: 20px; margin-top: 20px; }";
-    warningPage += ".btn { display: inline-flex; justify-content: center; align-items: center; background-color: #D8C12C; color: #0f1317; padding: 12px 24px; text-decoration: none; border-radius: 5px; font-weight: bold; border: none; cursor: pointer; font-size: 16px; min-width: 200px; height: 50px; box-sizing: border-box; }";
-    warningPage += ".btn:hover { background-color: #7274ee; color: #fff; }";
-    warningPage += ".back-btn { background-color: #262a36; color: #fff; border: 1px solid #7274ee; }";
-    warningPage += ".back-btn:hover { background-color: #7274ee; }";
-    warningPage += "form { display: inline-block; margin: 0; }";
-    warningPage += "button.btn { width: 100%; }";
-    warningPage += "strong { color: #D8C12C; }";
-    warningPage += "ul { color: #fff; }";
-    warningPage += "</style>";
-    warningPage += "</head><body>";
-    warningPage += "<div class='warning-container'>";
-    warningPage += "<div class='warning-icon'><svg xmlns='http://www.w3.org/2000/svg' width='64' height='64' viewBox='0 0 24 24'><path fill='#D8C12C' d='M12 2C6.48 2 2 6.48 2 12s4.48 10 10 10 10-4.48 10-10S17.52 2 12 2zm1 15h-2v-2h2v2zm0-4h-2V7h2v6z'/></svg></div>";
-    warningPage += "<h1>WARNING: FIRMWARE UPDATE</h1>";
-    warningPage += "<div class='warning-text'>";
-    warningPage += "<p><strong>Uploading incorrect firmware can brick your device!</strong></p>";
-    warningPage += "<p>Please ensure that:</p>";
-    warningPage += "<ul style='text-align: left;'>";
-    warningPage += "<li>You are uploading firmware specifically built for the Radiation Detector</li>";
-    warningPage += "<li>The firmware version is compatible with your hardware</li>";
-    warningPage += "<li>You have a stable power connection during the update</li>";
-    warningPage += "<li>Your WiFi connection is stable during the update</li>";
-    warningPage += "</ul>";
-    warningPage += "<p>If the update fails, you may need to manually update the firmware using a USB connection.</p>";
-    warningPage += "</div>";
-    warningPage += "<div class='btn-container'>";
-    warningPage += "<a href='/' class='btn back-btn'>Cancel</a>";
-    warningPage += "<form method='post' action='/acknowledge-ota' style='width: 200px;'><button type='submit' class='btn'>I Understand, Proceed</button></form>";
-    warningPage += "</div>";
-    warningPage += "</div></body></html>";
-    
-    server.send(200, "text/html", warningPage);
-}
-
-// Update the WiFi/OTA initialization in connect_btn_event_cb
+/**
+ * @brief Shows @p text on the WiFi info label, or keeps it for when the
+ *        settings screen is built. uiTask only; other tasks post it with
+ *        uiAsyncCall() or uiAsyncSetLabel(&ui_WIFIINFO, ...).
+ */
+static void setWifiInfo(const char* text) {
+    strlcpy(wifiInfoText, text, sizeof(wifiInfoText));
+#if !HEADLESS
+    if (ui_WIFIINFO) lv_label_set_text_static(ui_WIFIINFO, wifiInfoText);
+#endif
+}
+
+#if !HEADLESS
 static void connect_btn_event_cb(lv_event_t *e) {
+    if (!ui_SSID || !ui_PASSWORD) return;
     const char* ssid = lv_textarea_get_text(ui_SSID);
     const char* password = lv_textarea_get_text(ui_PASSWORD);
     DEBUG_PRINTF("Attempting to connect to SSID: %s\n", ssid);
-    lv_label_set_text(ui_WIFIINFO, "Connecting");
     
-    if (connectToWiFi(ssid, password)) {
-        DEBUG_PRINTLN("WiFi connected.");
-        wifi_ip = WiFi.localIP().toString();
-        
-        // Initialize mDNS responder
-        if (MDNS.begin("radiation")) {
-            DEBUG_PRINTLN("mDNS responder started - Device accessible at http://radiation.local");
-        } else {
-            DEBUG_PRINTLN("Error setting up mDNS responder!");
-        }
-        
-        preferences.begin("wifi", false);
-        preferences.putString("ssid", ssid);
-        preferences.putString("password", password);
-        preferences.end();
-        configTime(0, 0, "pool.ntp.org", "time.nist.gov");
-        struct tm timeinfo;
-        if (getLocalTime(&timeinfo)) {
-            char timeStr[64];
-            strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M:%S", &timeinfo);
-            String info = String("IP: ") + wifi_ip + "\nTime: " + timeStr + " UTC";
-            lv_label_set_text(ui_WIFIINFO, info.c_str());
-        } else {
-            String info = String("IP: ") + wifi_ip + "\nTime: NTP Failed";
-            lv_label_set_text(ui_WIFIINFO, info.c_str());
-            DEBUG_PRINTLN("NTP time sync failed");
-        }
-        if (!otaInitialized) {
-            server.begin();
-            
-            // Reset acknowledgment flag when server initializes
-            otaWarningAcknowledged = false;
-            
-            // Add route for the dashboard
-            server.on("/", [](){
-                String dashboard = getDashboardPage();
-                server.send(200, "text/html", dashboard);
-            });
-            
-            // Add a dedicated route for the warning page
-            server.on("/warning", HTTP_GET, []() {
-                serveOtaWarningPage();
-            });
-            
-            // Add a route to handle the acknowledgment form submission
-            server.on("/acknowledge-ota", HTTP_POST, []() {
-                otaWarningAcknowledged = true;
-                server.sendHeader("Location", "/update", true);
-                server.send(302, "text/plain", "");
-            });
-            
-            // Initialize ElegantOTA
-            ElegantOTA.begin(&server);
-            otaInitialized = true;
-            DEBUG_PRINTLN("OTA initialized with warning page.");
-            
-            // Modify the dashboard to link to /warning instead of /update directly
-            server.on("/api/data", HTTP_GET, [](){
-                server.sendHeader("Access-Control-Allow-Origin", "*");
-                server.sendHeader("Access-Control-Allow-Methods", "GET");
-                server.sendHeader("Access-Control-Allow-Headers", "Content-Type");
-                server.sendHeader("Cache-Control", "no-cache, no-store, must-revalidate");
-                server.sendHeader("Pragma", "no-cache");
-                server.sendHeader("Expires", "0");
-                server.send(200, "application/json", getRadiationDataJsonExport());
-            });
-        }
-    } else {
-        DEBUG_PRINTLN("WiFi connection failed.");
-        lv_label_set_text(ui_WIFIINFO, "Disconnected\nFailed");
+    // Credentials are saved once the connection actually succeeds
+    wifiManagerConnect(ssid, password, true);
+}
+
+/**
+ * @brief A network picked from the scan list: an open one is joined right
+ *        away, a secured one fills the SSID and waits for the password.
+ */
+static void wifiNetworkSelected(const WifiNetwork& network) {
+    if (!ui_SSID || !ui_PASSWORD) return;
+    lv_textarea_set_text(ui_SSID, network.ssid);
+    lv_textarea_set_text(ui_PASSWORD, "");
+    if (!network.secure) {
+        DEBUG_PRINTF("Attempting to connect to SSID: %s\n", network.ssid);
+        wifiManagerConnect(network.ssid, "", true);
+        return;
     }
+    lv_obj_add_state(ui_PASSWORD, LV_STATE_FOCUSED);
+    _ui_keyboard_set_target(ui_Keyboard, ui_PASSWORD);
+    KeyboardPopup_Animation(ui_Keyboard, 0);
 }
+#endif
 
-// Modify the tryAutoConnect function similarly
 void tryAutoConnect() {
-    preferences.begin("wifi", true);
-    String storedSsid = preferences.getString("ssid", "");
-    String storedPassword = preferences.getString("password", "");
-    preferences.end();
-    
-    if (storedSsid.length() > 0) {
-        DEBUG_PRINTF("Found saved credentials. Trying to connect to: %s\n", storedSsid.c_str());
-        
-        // Update the info text while connecting
-        lv_label_set_text(ui_WIFIINFO, "Connecting...");
-        
-        // Process the UI update immediately
-        lv_timer_handler();
-        
-        if (connectToWiFi(storedSsid.c_str(), storedPassword.c_str())) {
-            DEBUG_PRINTLN("Auto WiFi connection successful.");
-            wifi_ip = WiFi.localIP().toString();
-            
-            // Initialize mDNS responder
-            if (MDNS.begin("radiation")) {
-                DEBUG_PRINTLN("mDNS responder started - Device accessible at http://radiation.local");
-            } else {
-                DEBUG_PRINTLN("Error setting up mDNS responder!");
-            }
-            
-            configTime(0, 0, "pool.ntp.org", "time.nist.gov");
-            struct tm timeinfo;
-            if (getLocalTime(&timeinfo)) {
-                char timeStr[64];
-                strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M:%S", &timeinfo);
-                String info = String("IP: ") + wifi_ip + "\nTime: " + timeStr + " UTC";
-                lv_label_set_text(ui_WIFIINFO, info.c_str());
-            } else {
-                String info = String("IP: ") + wifi_ip + "\nTime: NTP Failed";
-                lv_label_set_text(ui_WIFIINFO, info.c_str());
-                DEBUG_PRINTLN("NTP time sync failed");
-            }
-            
-            // Initialize OTA and web server if needed
-            if (!otaInitialized) {
-                server.begin();
-                // Reset acknowledgment flag when server initializes
-                otaWarningAcknowledged = false;
-                
-                // Add route for the dashboard 
-                server.on("/", [](){
-                    String dashboard = getDashboardPage();
-                    server.send(200, "text/html", dashboard);
-                });
-                
-                // Add a dedicated route for the warning page
-                server.on("/warning", HTTP_GET, []() {
-                    serveOtaWarningPage();
-                });
-                
-                // Add a route to handle the acknowledgment form submission
-                server.on("/acknowledge-ota", HTTP_POST, []() {
-                    otaWarningAcknowledged = true;
-                    server.sendHeader("Location", "/update", true);
-                    server.send(302, "text/plain", "");
-                });
-                
-                // Initialize ElegantOTA
-                ElegantOTA.begin(&server);
-                otaInitialized = true;
-                DEBUG_PRINTLN("OTA initialized with warning page.");
-                
-                // Add JSON API endpoint
-                server.on("/api/data", HTTP_GET, [](){
-                    server.sendHeader("Access-Control-Allow-Origin", "*");
-                    server.sendHeader("Access-Control-Allow-Methods", "GET");
-                    server.sendHeader("Access-Control-Allow-Headers", "Content-Type");
-                    server.sendHeader("Cache-Control", "no-cache, no-store, must-revalidate");
-                    server.sendHeader("Pragma", "no-cache");
-                    server.sendHeader("Expires", "0");
-                    server.send(200, "application/json", getRadiationDataJsonExport());
-                });
-            }
-        } else {
-            DEBUG_PRINTLN("Auto WiFi connection failed.");
-            lv_label_set_text(ui_WIFIINFO, "Disconnected\nFailed");
-        }
+    if (wifiManagerConnectSaved()) {
+        DEBUG_PRINTLN("Found saved credentials, connecting in the background.");
     } else {
         DEBUG_PRINTLN("No stored credentials found.");
-        lv_label_set_text(ui_WIFIINFO, "No credentials");
+        setWifiInfo("No credentials");
     }
     
-    // Only now load the initial screen after all connection attempts
-    DEBUG_PRINTLN("Loading InitialScreen after connection attempt");
-    lv_scr_load(ui_InitialScreen);
+#if !HEADLESS
+    // The connection completes asynchronously; show the initial screen right away
+    uiScreenLoad(UI_SCREEN_INITIAL);
 }
 
 static void wifi_connect_timer_cb(lv_timer_t * timer) {
     // Check if auto-connect is enabled
-    if(lv_obj_has_state(ui_OnStartup, LV_STATE_CHECKED)) {
+    if (getDeviceConfig().wifiAutoConnect) {
         DEBUG_PRINTLN("OnStartup enabled. Attempting auto WiFi connection...");
         tryAutoConnect(); // This function will handle screen transitions
     } else {
         DEBUG_PRINTLN("OnStartup disabled. Loading InitialScreen immediately.");
-        lv_scr_load(ui_InitialScreen);
+        uiScreenLoad(UI_SCREEN_INITIAL);
     }
     lv_timer_del(timer);
 }
@@ -1638,56 +4600,286 @@ static void wifi_connect_timer_cb(lv_timer_t * timer) {
 static void onstartup_checkbox_event_cb(lv_event_t * e) {
     lv_obj_t * checkbox = lv_event_get_target(e);
     bool checked = lv_obj_has_state(checkbox, LV_STATE_CHECKED);
-    preferences.begin("settings", false);
-    preferences.putBool("onstartup", checked);
-    preferences.end();
+    DeviceConfig config = getDeviceConfig();
+    config.wifiAutoConnect = checked;
+    setDeviceConfig(config);
     Serial.print("OnStartup checkbox state saved as: ");
     Serial.println(checked ? "ENABLED" : "DISABLED");
 }
 
-// Disable the battery check function implementation
+/**
+ * @brief Creates the battery indicator in the top-right corner of the main screen.
+ */
+static void createBatteryLabel() {
+    if (!ui_MainScreen || getBatteryStatus().state == BATTERY_STATE_NOT_CONFIGURED) return;
+    batteryLabel = lv_label_create(ui_MainScreen);
+    batteryShown[0] = '\0';
+    lv_obj_align(batteryLabel, LV_ALIGN_TOP_RIGHT, -8, 4);
+    lv_obj_set_style_text_color(batteryLabel, lv_color_white(), 0);
+    lv_label_set_text_static(batteryLabel, batteryShown);
+}
+
+/**
+ * @brief Creates the scaler result label in the top-left corner of the main screen.
+ */
+static void createScalerLabel() {
+    if (!ui_MainScreen || !scalerAvailable()) return;
+    scalerLabel = lv_label_create(ui_MainScreen);
+    scalerShown[0] = '\0';
+    lv_obj_align(scalerLabel, LV_ALIGN_TOP_LEFT, 8, 4);
+    lv_obj_set_style_text_color(scalerLabel, lv_color_white(), 0);
+    lv_label_set_text_static(scalerLabel, scalerShown);
+}
+
+/**
+ * @brief Follows the scaler run on uiTask.
+ */
+static void updateScalerLabel() {
+    if (!scalerLabel || !uiScreenShown(UI_SCREEN_MAIN)) return;
+    char text[sizeof(scalerShown)];
+    formatScalerLabel(text, sizeof(text));
+    if (strcmp(text, scalerShown) == 0) return;
+    strlcpy(scalerShown, text, sizeof(scalerShown));
+    lv_label_set_text_static(scalerLabel, scalerShown);
+}
+#else
+}
+#endif
+
+/**
+ * @brief Follows the battery status on uiTask: indicator text and the
+ *        low / critical transitions (a checkpoint before the cell browns out).
+ */
 void checkBatteryLevel() {
-    // Battery monitoring disabled - device is USB powered
-    return;
+    static uint8_t lastLevel = BATTERY_LEVEL_OK;
+    BatteryStatus battery = getBatteryStatus();
+    if (battery.state == BATTERY_STATE_NOT_CONFIGURED) return;
+
+    if (battery.level != lastLevel) {
+        if (battery.level == BATTERY_LEVEL_CRITICAL) {
+            DEBUG_PRINTF("Battery critical (%.2f V), saving a dose checkpoint\n", battery.volts);
+            doseCheckpointSave();
+        } else if (battery.level == BATTERY_LEVEL_LOW) {
+            DEBUG_PRINTF("Battery low (%.0f%%)\n", battery.percent);
+        }
+        lastLevel = battery.level;
+    }
+
+#if !HEADLESS
+    char text[24];
+    if (battery.state == BATTERY_STATE_ABSENT) {
+        strlcpy(text, "USB", sizeof(text));
+    } else if (battery.runtimeHours >= 0.0f) {
+        snprintf(text, sizeof(text), "%.0f%% %.0fh", battery.percent, battery.runtimeHours);
+    } else {
+        snprintf(text, sizeof(text), "%.0f%%%s", battery.percent,
+                 battery.state == BATTERY_STATE_CHARGING ? " +" : "");
+    }
+    if (batteryLabel && uiScreenShown(UI_SCREEN_MAIN) && strcmp(text, batteryShown) != 0) {
+        strlcpy(batteryShown, text, sizeof(batteryShown));
+        lv_label_set_text_static(batteryLabel, batteryShown);
+        lv_obj_set_style_text_color(batteryLabel,
+                                    battery.level == BATTERY_LEVEL_OK ? lv_color_white() : lv_palette_main(LV_PALETTE_RED), 0);
+    }
+#endif
 }
 
-// Update the getRadiationDataJson function to remove battery voltage
-static String getRadiationDataJson() {
-    // Create a JsonDocument - with newer ArduinoJson versions, we don't need to specify capacity
-    JsonDocument doc;
-    
-    // Add basic radiation data with field names matching what dashboard.js expects
-    doc["current"] = currentuSvHr;
-    doc["average"] = averageuSvHr;
-    doc["maximum"] = maxuSvHr;
-    doc["cumulative"] = cumulativemSv;
-    doc["total_counts"] = totalCounts;
-    
-    // Add timestamp (seconds since start)
-    doc["timestamp"] = millis() / 1000;
-    
-    // Battery monitoring disabled - device is USB powered
-    // #ifdef BATTERY_VOLTAGE_PIN
-    // int adcValue = analogRead(BATTERY_VOLTAGE_PIN);
-    // float batteryVoltage = (adcValue / 4095.0) * 3.3 * 2; 
-    // doc["battery_v"] = batteryVoltage;
-    // #endif
-    
-    // Add hourly data (chart1Buffer) - use field name 'hourly' to match dashboard.js
+/**
+ * @brief Adds the hourly (chart1History) and daily (chart3History) arrays to @p doc.
+ *
+ * Oldest first, padded with zeros like the on-device chart. Field names match dashboard.js.
+ */
+/**
+ * @brief Adds the per-chart generations and, with @p values, the chart arrays.
+ *
+ * A generation changes whenever its chart changes (an interval closed, clear,
+ * restore), so a client that has the arrays of a generation can skip them.
+ * With @p text the points go in as fixed 2-decimal JSON text (JSON output
+ * only; MessagePack needs them as floats).
+ */
+static void addChartData(JsonDocument& doc, bool values = true, bool text = true) {
+    xSemaphoreTake(chartDataMutex, portMAX_DELAY);
+    doc["hourly_gen"] = chart1Version;
+    doc["daily_gen"] = chart3Version;
+    if (!values) {
+        xSemaphoreGive(chartDataMutex);
+        return;
+    }
     JsonArray hourlyData = doc["hourly"].to<JsonArray>();
-    for (int i = 0; i < CHART1_SEGMENTS; i++) {
-        // Calculate the actual index in the ring buffer
-        int actualIndex = (chart1Index + i) % CHART1_SEGMENTS;
-        hourlyData.add(chart1Buffer[actualIndex]);
+    for (size_t i = 0; i < CHART1_SEGMENTS; i++) {
+        float value = i < chart1History.size() ? chart1History[i] : 0.0f;
+        if (text) addFixed<2>(hourlyData, value);
+        else hourlyData.add(value);
     }
     
-    // Add daily data (chart3Buffer) - use field name 'daily' to match dashboard.js
     JsonArray dailyData = doc["daily"].to<JsonArray>();
-    for (int i = 0; i < CHART3_SEGMENTS; i++) {
-        // Calculate the actual index in the ring buffer
-        int actualIndex = (chart3Index + i) % CHART3_SEGMENTS;
-        dailyData.add(chart3Buffer[actualIndex]);
+    for (size_t i = 0; i < CHART3_SEGMENTS; i++) {
+        float value = i < chart3History.size() ? chart3History[i] : 0.0f;
+        if (text) addFixed<2>(dailyData, value);
+        else dailyData.add(value);
+    }
+    xSemaphoreGive(chartDataMutex);
+}
+
+/**
+ * @brief Fills @p doc with the /api/data fields (live values, history summary and,
+ *        with @p charts, the chart arrays).
+ */
+static void buildRadiationData(JsonDocument& doc, bool charts = true, bool text = true) {
+    // Add basic radiation data with field names matching what dashboard.js expects
+    DoseSnapshot dose = getDoseSnapshot();
+    doc["current"] = dose.currentUsvH;
+    doc["average"] = dose.averageUsvH;
+    doc["maximum"] = dose.maximumUsvH;
+    doc["cumulative"] = dose.cumulativeMsv;
+    // Count-statistics uncertainty: 1-sigma and the 95 % interval
+    doc["current_sigma"] = dose.currentError.sigma;
+    JsonArray currentCi = doc["current_ci95"].to<JsonArray>();
+    currentCi.add(dose.currentError.lower);
+    currentCi.add(dose.currentError.upper);
+    doc["average_sigma"] = dose.averageError.sigma;
+    JsonArray averageCi = doc["average_ci95"].to<JsonArray>();
+    averageCi.add(dose.averageError.lower);
+    averageCi.add(dose.averageError.upper);
+    // Exponentially weighted averages by time constant, with their 1-sigma
+    JsonObject averages = doc["averages"].to<JsonObject>();
+    JsonObject averagesSigma = doc["averages_sigma"].to<JsonObject>();
+    for (uint8_t i = 0; i < RATE_EWMA_COUNT; i++) {
+        averages[RateEwma::name((RateEwmaId)i)] = dose.averagesUsvH[i];
+        averagesSigma[RateEwma::name((RateEwmaId)i)] = dose.averagesSigmaUsvH[i];
+    }
+    if (dose.measurement.state() != PrecisionMeasurement::IDLE) {
+        static const char* const STATES[] = {"idle", "running", "reached", "timeout", "stopped"};
+        DeviceConfig config = getDeviceConfig();
+        RateUncertainty run = dose.measurement.interval(config.deadTimeSec, 60.0f * config.usvHPerCpm);
+        JsonObject runObj = doc["measurement"].to<JsonObject>();
+        runObj["state"] = STATES[dose.measurement.state()];
+        runObj["target"] = dose.measurement.target();
+        runObj["counts"] = dose.measurement.counts();
+        runObj["seconds"] = dose.measurement.seconds();
+        runObj["rate"] = run.rate;
+        runObj["sigma"] = run.sigma;
+        runObj["lower"] = run.lower;
+        runObj["upper"] = run.upper;
+        runObj["relative"] = run.relative();
+    }
+    // Requests are served on the web task, so take a private copy of the pulse snapshot
+    PulseSnapshot pulse{};
+    pulseSnapshotLock.read(pulse);
+
+    doc["total_counts"] = pulse.totalCounts;
+    doc["cpm"] = dose.correctedCpm;
+    doc["cpm_raw"] = dose.rawCpm;
+    doc["usvh_per_cpm"] = getDeviceConfig().usvHPerCpm; // For rates from /api/history counts
+    float tauSec = getDeviceConfig().deadTimeSec;
+    doc["dead_time_us"] = tauSec * 1e6f;
+    doc["cpm_10s"] = correctDeadTimeCpm(pulse.windowCpm[RATE_WINDOW_10S], tauSec);
+    doc["cpm_300s"] = correctDeadTimeCpm(pulse.windowCpm[RATE_WINDOW_300S], tauSec);
+    doc["window_s"] = pulse.adaptiveWindowSeconds;
+    
+    AlarmStatus alarm = getAlarmStatus();
+    JsonObject alarmObj = doc["alarm"].to<JsonObject>();
+    alarmObj["level"] = alarmLevelName(alarm.level);
+    alarmObj["causes"] = alarm.causes;
+    alarmObj["rate_lower"] = alarm.rateLowerUsvH;
+    alarmObj["rate_upper"] = alarm.rateUpperUsvH;
+    if (alarm.secondsToDoseAlarm >= 0.0f) alarmObj["dose_eta_s"] = alarm.secondsToDoseAlarm;
+    if (alarm.isotopeLevel != ALARM_LEVEL_NONE) {
+        IsotopeIdStatus isotopes = getIsotopeIdStatus();
+        JsonArray identified = alarmObj["isotopes"].to<JsonArray>();
+        for (uint8_t i = 0; i < ISOTOPE_COUNT; i++) {
+            if (isotopes.isotopes[i].identified) identified.add(isotopes.isotopes[i].name);
+        }
+    }
+    
+    // Long-term history depth and last-hour summary from the multi-resolution store
+    JsonObject history = doc["history"].to<JsonObject>();
+    history["seconds"] = historyStore.count(HISTORY_LEVEL_SECOND);
+    history["minutes"] = historyStore.count(HISTORY_LEVEL_MINUTE);
+    history["hours"] = historyStore.count(HISTORY_LEVEL_HOUR);
+    HistoryBucket lastHour;
+    if (historyStore.summarizeRecent(HISTORY_LEVEL_MINUTE, 60, &lastHour)) {
+        history["hour_mean_cps"] = lastHour.meanCps();
+        history["hour_min_cps"] = lastHour.minCps;
+        history["hour_max_cps"] = lastHour.maxCps;
+    }
+    
+    // UTC (Unix seconds) once the time base has it, 0 before; uptime always
+    doc["timestamp"] = timeBaseUtcSeconds();
+    doc["uptime"] = timeBaseSeconds();
+    
+    // Battery state of charge and predicted runtime (absent when not configured)
+    BatteryStatus battery = getBatteryStatus();
+    if (battery.state != BATTERY_STATE_NOT_CONFIGURED) {
+        JsonObject batteryObj = doc["battery"].to<JsonObject>();
+        batteryObj["state"] = batteryStateName(battery.state);
+        if (battery.state != BATTERY_STATE_ABSENT) {
+            batteryObj["v"] = battery.volts;
+            batteryObj["pct"] = battery.percent;
+            batteryObj["pct_per_h"] = battery.pctPerHour;
+            if (battery.runtimeHours >= 0.0f) batteryObj["runtime_h"] = battery.runtimeHours;
+            batteryObj["low"] = battery.level != BATTERY_LEVEL_OK;
+        }
+    }
+    
+    // Spectrum calibration and reference-line fits from the analysis task
+    SpectrumAnalysis analysis = getSpectrumAnalysis();
+    JsonObject spectrumObj = doc["spectrum"].to<JsonObject>();
+    spectrumObj["counts"] = analysis.totalCounts;
+    SpectrumSessionInfo session = getSpectrumSessionInfo();
+    spectrumObj["live_s"] = session.liveMs / 1000.0f;
+    // Dead time and rejected pile-ups are not live; rates per live second
+    uint32_t spectrumLiveMs = spectrum.liveMs(), spectrumRealMs = spectrum.realMs();
+    spectrumObj["real_s"] = spectrumRealMs / 1000.0f;
+    spectrumObj["dead_pct"] = spectrumRealMs > spectrumLiveMs
+        ? 100.0f * (spectrumRealMs - spectrumLiveMs) / spectrumRealMs : 0.0f;
+    if (spectrumLiveMs) spectrumObj["cps"] = spectrum.total() * 1000.0f / spectrumLiveMs;
+    spectrumObj["pileups"] = getSpectrumAcqStats().pileUps;
+    if (session.name[0]) {
+        JsonObject sessionObj = spectrumObj["session"].to<JsonObject>();
+        sessionObj["name"] = session.name;
+        sessionObj["active"] = session.active;
+        sessionObj["real_s"] = session.realSeconds;
     }
+    if (session.background) spectrumObj["background"] = session.backgroundName;
+    JsonObject coincidence = spectrumObj["coincidence"].to<JsonObject>();
+    coincidence["mode"] = (uint8_t)coincidenceMode;
+    coincidence["window_us"] = coincidenceGate.window();
+    coincidence["events"] = coincidenceStats.events;
+    coincidence["coincident"] = coincidenceStats.coincident;
+    JsonArray cal = spectrumObj["cal"].to<JsonArray>();
+    cal.add(analysis.calibration.c0);
+    cal.add(analysis.calibration.c1);
+    cal.add(analysis.calibration.c2);
+    SpectrumDoseStatus dose = getSpectrumDoseStatus();
+    if (dose.builds) {
+        JsonObject doseObj = spectrumObj["dose"].to<JsonObject>();
+        doseObj["rate_usvh"] = dose.rateUsvH;
+        doseObj["gm_usvh"] = dose.gmRateUsvH;
+        doseObj["ratio"] = dose.ratio;
+        doseObj["integrated_usv"] = dose.integratedUsv;
+        doseObj["ready"] = dose.ready;
+    }
+    JsonArray peaks = spectrumObj["peaks"].to<JsonArray>();
+    for (uint8_t i = 0; i < SPECTRUM_LINE_COUNT; i++) {
+        const SpectrumLineResult& line = analysis.lines[i];
+        if (!line.found) continue;
+        JsonObject peak = peaks.add<JsonObject>();
+        peak["isotope"] = line.isotope;
+        peak["kev"] = line.energyKeV;
+        peak["channel"] = line.centroid;
+        peak["fwhm_kev"] = line.fwhmKeV;
+        peak["net"] = line.netCounts;
+        peak["net_err"] = line.netError;
+    }
+    
+    addChartData(doc, charts, text);
+}
+
+static String getRadiationDataJson() {
+    JsonArenaLease lease;
+    JsonDocument doc(lease.allocator());
+    buildRadiationData(doc);
     
     // Serialize to String - use buffer for better performance
     String jsonString;
@@ -1703,60 +4895,90 @@ String getRadiationDataJsonExport() {
     return getRadiationDataJson();
 }
 
-// Function to manage power
-void managePower() {
-    unsigned long now = millis();
+size_t writeRadiationData(char* out, size_t size, ApiFormat format, bool charts) {
+    // The document lives in the shared arena, so a request makes no heap allocation
+    JsonArenaLease lease;
+    JsonDocument doc(lease.allocator());
+    buildRadiationData(doc, charts, format != API_FORMAT_MSGPACK);
+    if (doc.overflowed()) {
+        DEBUG_PRINTLN("API JSON arena too small");
+        return 0;
+    }
     
-    // Check if it's time to dim the display
-    if (!isDisplayDimmed && (now - lastUserInteractionTime >= DISPLAY_TIMEOUT)) {
-        // Dim the display
-        // tft.setDimmer(dimmedBrightness);
-        isDisplayDimmed = true;
-        Serial.println("Display dimmed to save power");
+    if (format == API_FORMAT_MSGPACK) {
+        // Same fields as the JSON document, ~30% smaller and no float formatting
+        if (measureMsgPack(doc) > size) return 0;
+        return serializeMsgPack(doc, out, size);
     }
+    size_t length = serializeJson(doc, out, size);
+    // serializeJson() truncates silently; a full buffer means the output was cut
+    return length < size - 1 ? length : 0;
 }
 
-// Function to restore normal brightness
-void restoreDisplayBrightness() {
-    if (isDisplayDimmed) {
-        // tft.setDimmer(normalBrightness);
-        isDisplayDimmed = false;
-        Serial.println("Display brightness restored");
-    }
+size_t writeLiveRate(char* out, size_t size) {
+    JsonArenaLease lease;
+    JsonDocument doc(lease.allocator());
+    // Rounded to the dashboard's display precision so unchanged values are not re-sent
+    DoseSnapshot dose = getDoseSnapshot();
+    setFixed<2>(doc["current"], dose.currentUsvH);
+    setFixed<2>(doc["current_err"], dose.currentError.halfWidth());
+    setFixed<2>(doc["average"], dose.averageUsvH);
+    setFixed<2>(doc["maximum"], dose.maximumUsvH);
+    setFixed<2>(doc["cumulative"], dose.cumulativeMsv);
+    doc["cpm"] = lroundf(dose.correctedCpm);
+    
+    size_t length = serializeJson(doc, out, size);
+    return length < size - 1 ? length : 0;
 }
 
-// Touch event handler to track user interaction
-static void touch_event_cb(lv_event_t * e) {
-    lastUserInteractionTime = millis();
-    if (isDisplayDimmed) {
-        restoreDisplayBrightness();
-    }
+String getChartDataJsonExport() {
+    JsonArenaLease lease;
+    JsonDocument doc(lease.allocator());
+    addChartData(doc);
+    
+    String jsonString;
+    jsonString.reserve(measureJson(doc) + 1);
+    serializeJson(doc, jsonString);
+    return jsonString;
+}
+
+uint32_t getApiDataGeneration() {
+    PulseSnapshot pulse;
+    pulse.secondsClosed = 0;
+    pulseSnapshotLock.read(pulse);
+    return pulse.secondsClosed;
+}
+
+uint32_t getChartDataVersion() {
+    xSemaphoreTake(chartDataMutex, portMAX_DELAY);
+    uint32_t version = chartDataVersion;
+    xSemaphoreGive(chartDataMutex);
+    return version;
+}
+
+#if !HEADLESS
+/**
+ * @brief Advances the display power state once per uiTask pass.
+ *
+ * Idle time is LVGL's input inactivity, so a touch anywhere counts as
+ * interaction. An active alarm (at any level, while alarms are enabled) keeps
+ * the display on, or turns it back on.
+ * @return false while the screen is off and rendering is paused
+ */
+bool managePower(const DeviceConfig& config) {
+    bool alarmActive = config.alarmEnabled && getAlarmStatus().level != ALARM_LEVEL_NONE;
+    return displayPowerUpdate(lv_disp_get_inactive_time(NULL), config.displayTimeoutMs, alarmActive);
 }
 
-// Add this function to the initialization section in setup()
+/**
+ * @brief Sets up the backlight PWM; the idle timeout starts at boot.
+ */
 void setupPowerManagement() {
-    // Initialize power management
-    lastUserInteractionTime = millis();
-    
-    // Set initial display brightness
-    // Assuming TFT_eSPI library's setDimmer or setBrightness method
-    // This part may need to be adjusted based on your TFT library's functionality
-    // tft.setDimmer(normalBrightness);
-    
-    // Register touch event handler to track user interaction
-    // Attach to every UI element that users interact with
-    if (ui_EnableAlarmsCheckbox) {
-        lv_obj_add_event_cb(ui_EnableAlarmsCheckbox, touch_event_cb, LV_EVENT_PRESSED, NULL);
+    if (!initDisplayPower(DISPLAY_BACKLIGHT_PIN, BACKLIGHT_LEDC_CHANNEL)) {
+        DEBUG_PRINTLN("WARNING: Backlight PWM unavailable");
     }
-    if (ui_CurrentSpinbox) {
-        lv_obj_add_event_cb(ui_CurrentSpinbox, touch_event_cb, LV_EVENT_PRESSED, NULL);
-    }
-    if (ui_CumulativeSpinbox) {
-        lv_obj_add_event_cb(ui_CumulativeSpinbox, touch_event_cb, LV_EVENT_PRESSED, NULL);
-    }
-    if (ui_Connect) {
-        lv_obj_add_event_cb(ui_Connect, touch_event_cb, LV_EVENT_PRESSED, NULL);
-    }
-    
-    Serial.println("Power management initialized");
+    lv_disp_trig_activity(NULL);
+    DEBUG_PRINTF("Power management initialized (backlight %s)\n",
+                 DISPLAY_BACKLIGHT_PIN >= 0 ? "PWM" : "not controllable");
 }
+#endif // !HEADLESS
@@ -0,0 +1,99 @@
+#ifndef ADAPTIVE_RATE_H
+#define ADAPTIVE_RATE_H
+
+#include <math.h>
+#include <stdint.h>
+
+// Adaptive-window count-rate estimator over 1-second buckets.
+// While the rate is stable the integration window grows by one second per bucket
+// (up to MAX_SECONDS) for low noise. When the counts of the last TEST_SECONDS
+// differ from what the window before them predicts by more than Z_THRESHOLD
+// Poisson sigmas, the window collapses to those seconds so a step change shows
+// up within a few seconds. No Arduino dependencies (host-compilable).
+
+class AdaptiveRateEstimator {
+public:
+    static const uint16_t MAX_SECONDS  = 300; ///< Longest integration window
+    static const uint16_t TEST_SECONDS = 3;   ///< Recent seconds tested against the estimate
+    static const uint16_t MIN_SECONDS  = TEST_SECONDS; ///< Window length right after a change
+
+    explicit AdaptiveRateEstimator(float zThreshold = 4.0f) : zThreshold_(zThreshold) { clear(); }
+
+    void clear() {
+        for (uint16_t i = 0; i < MAX_SECONDS; i++) buckets_[i] = 0;
+        head_ = 0;
+        filled_ = 0;
+        window_ = 0;
+        windowSum_ = 0;
+        changes_ = 0;
+    }
+
+    /**
+     * @brief Adds one completed second and adapts the window. O(1) except after a
+     *        detected change, where the short window is re-summed (TEST_SECONDS).
+     */
+    void push(uint32_t countsThisSecond) {
+        // Rate predicted by the window as it stood before the tested seconds;
+        // the newest TEST_SECONDS - 1 are already in it and would pull the
+        // prediction towards the rate being tested
+        uint16_t prior = window_ > TEST_SECONDS - 1 ? window_ - (TEST_SECONDS - 1) : 0;
+        float expectedPerSec = prior ? (float)(windowSum_ - recentSum(TEST_SECONDS - 1)) / (float)prior : 0.0f;
+
+        // Grow the window by the new bucket (drop the oldest once at full length)
+        if (window_ >= MAX_SECONDS) {
+            windowSum_ -= buckets_[head_];
+        } else {
+            window_++;
+        }
+        buckets_[head_] = countsThisSecond;
+        head_ = (head_ + 1) % MAX_SECONDS;
+        if (filled_ < MAX_SECONDS) filled_++;
+        windowSum_ += countsThisSecond;
+
+        // Poisson change test: recent seconds vs. the prior window's prediction
+        if (filled_ >= TEST_SECONDS && window_ > TEST_SECONDS + MIN_SECONDS) {
+            uint32_t recent = recentSum(TEST_SECONDS);
+            float expected = expectedPerSec * TEST_SECONDS;
+            // Floor keeps the test meaningful near zero background
+            float sigma = sqrtf(expected > 1.0f ? expected : 1.0f);
+            if (fabsf((float)recent - expected) > zThreshold_ * sigma) {
+                window_ = MIN_SECONDS;
+                windowSum_ = recentSum(MIN_SECONDS);
+                changes_++;
+            }
+        }
+    }
+
+    /// Estimated counts per minute over the current adaptive window.
+    float cpm() const {
+        return window_ ? (float)windowSum_ * 60.0f / (float)window_ : 0.0f;
+    }
+
+    /// Current integration window length in seconds.
+    uint16_t windowSeconds() const { return window_; }
+
+    /// Counts inside the current window (for count-statistics uncertainty).
+    uint32_t windowCounts() const { return windowSum_; }
+
+    /// Number of change points detected since clear().
+    uint32_t changeCount() const { return changes_; }
+
+private:
+    uint32_t recentSum(uint16_t seconds) const {
+        uint32_t sum = 0;
+        for (uint16_t i = 1; i <= seconds && i <= filled_; i++) {
+            sum += buckets_[(head_ + MAX_SECONDS - i) % MAX_SECONDS];
+        }
+        return sum;
+    }
+
+    float zThreshold_;
+    uint32_t buckets_[MAX_SECONDS];
+    uint16_t head_;
+    uint16_t filled_;
+    uint16_t window_;
+    uint32_t windowSum_;
+    uint32_t changes_;
+};
+
+#endif // ADAPTIVE_RATE_H
@@ -0,0 +1,230 @@
+#ifndef ALARM_RULES_H
+#define ALARM_RULES_H
+
+#include <math.h>
+#include <stdint.h>
+#include "rate_window.h"
+#include "adaptive_rate.h"
+#include "dead_time.h"
+#include "count_statistics.h"
+
+// Alarm rule engine, evaluated once per closed 1-second bucket on pulseTask.
+// Rules (each maps to a level; the highest active one wins):
+//  - dose rate: warn / alarm / danger thresholds. A level is raised only when
+//    the lower Poisson confidence bound of the rate exceeds its threshold, and
+//    held until the upper bound falls below the threshold minus the hysteresis.
+//    The bounds come from the adaptive window and the 10 s window, so a high
+//    rate is confirmed within a second or two while a marginal one near
+//    background needs minutes of counts before it alarms.
+//  - cumulative dose: warn / alarm / danger thresholds (exact, no hysteresis).
+//  - rate of rise: the 10 s rate is confidently above a multiple of the 300 s
+//    baseline (warn).
+//  - time to threshold: at the current rate the cumulative alarm dose is
+//    reached within the prediction horizon (warn).
+//  - isotope: the level of the isotopes identified in the spectrum
+//    (isotope_id.h), passed in by the caller.
+// A threshold <= 0 disables its rule. No Arduino dependencies (host-compilable).
+
+enum AlarmLevel {
+    ALARM_LEVEL_NONE = 0,
+    ALARM_LEVEL_WARN,
+    ALARM_LEVEL_ALARM,
+    ALARM_LEVEL_DANGER,
+    ALARM_LEVEL_COUNT
+};
+
+enum AlarmCause {
+    ALARM_CAUSE_RATE      = 1 << 0,
+    ALARM_CAUSE_DOSE      = 1 << 1,
+    ALARM_CAUSE_RISE      = 1 << 2,
+    ALARM_CAUSE_PREDICTED = 1 << 3,
+    ALARM_CAUSE_ISOTOPE   = 1 << 4
+};
+
+inline const char* alarmLevelName(uint8_t level) {
+    static const char* NAMES[ALARM_LEVEL_COUNT] = {"none", "warn", "alarm", "danger"};
+    return level < ALARM_LEVEL_COUNT ? NAMES[level] : "?";
+}
+
+struct AlarmThresholds {
+    float rateUsvH[ALARM_LEVEL_COUNT]; ///< Per level, index 0 unused
+    float doseMsv[ALARM_LEVEL_COUNT];  ///< Per level, index 0 unused
+    float hysteresis;     ///< A rate level clears below threshold * (1 - hysteresis)
+    float confidenceZ;    ///< One-sided sigmas of the confidence bounds
+    float riseFactor;     ///< 10 s rate over the 300 s baseline that counts as a rise
+    float riseMinUsvH;    ///< Rises below this rate are ignored (background fluctuations)
+    float predictSeconds; ///< Horizon of the time-to-threshold warning
+
+    /**
+     * @brief Builds the levels around the user's alarm thresholds: warn at
+     *        @p warnFraction of them, danger at @p dangerFactor times them.
+     */
+    static AlarmThresholds fromAlarm(float rateAlarmUsvH, float doseAlarmMsv, float warnFraction,
+                                     float dangerFactor) {
+        AlarmThresholds t;
+        t.rateUsvH[ALARM_LEVEL_NONE] = 0.0f;
+        t.rateUsvH[ALARM_LEVEL_WARN] = rateAlarmUsvH * warnFraction;
+        t.rateUsvH[ALARM_LEVEL_ALARM] = rateAlarmUsvH;
+        t.rateUsvH[ALARM_LEVEL_DANGER] = rateAlarmUsvH * dangerFactor;
+        t.doseMsv[ALARM_LEVEL_NONE] = 0.0f;
+        t.doseMsv[ALARM_LEVEL_WARN] = doseAlarmMsv * warnFraction;
+        t.doseMsv[ALARM_LEVEL_ALARM] = doseAlarmMsv;
+        t.doseMsv[ALARM_LEVEL_DANGER] = doseAlarmMsv * dangerFactor;
+        t.hysteresis = 0.2f;
+        t.confidenceZ = 2.0f;
+        t.riseFactor = 3.0f;
+        t.riseMinUsvH = t.rateUsvH[ALARM_LEVEL_WARN] * 0.5f;
+        t.predictSeconds = 3600.0f;
+        return t;
+    }
+};
+
+/**
+ * @brief Result of the last evaluation. Trivially copyable (SeqLock).
+ */
+struct AlarmStatus {
+    uint8_t level;           ///< AlarmLevel
+    uint8_t causes;          ///< AlarmCause bits of the rules at that level or below
+    uint8_t rateLevel;
+    uint8_t doseLevel;
+    uint8_t isotopeLevel;
+    float rateUsvH;          ///< Point estimate (adaptive window)
+    float rateLowerUsvH;     ///< Lower confidence bound used for raising
+    float rateUpperUsvH;     ///< Upper confidence bound used for clearing
+    float secondsToDoseAlarm; ///< At the current rate; < 0 if not approaching
+    uint32_t evaluations;
+};
+
+class AlarmEngine {
+public:
+    static const uint16_t RISE_HOLD_SECONDS = 10;    ///< A detected rise is reported at least this long
+    static const uint16_t RISE_MIN_BASELINE_S = 60;  ///< Baseline seconds needed before rises count
+
+    AlarmEngine() { reset(); }
+
+    void reset() {
+        status_.level = ALARM_LEVEL_NONE;
+        status_.causes = 0;
+        status_.rateLevel = ALARM_LEVEL_NONE;
+        status_.doseLevel = ALARM_LEVEL_NONE;
+        status_.isotopeLevel = ALARM_LEVEL_NONE;
+        status_.rateUsvH = 0.0f;
+        status_.rateLowerUsvH = 0.0f;
+        status_.rateUpperUsvH = 0.0f;
+        status_.secondsToDoseAlarm = -1.0f;
+        status_.evaluations = 0;
+        riseHold_ = 0;
+    }
+
+    /**
+     * @brief Evaluates every rule for the bucket that just closed. O(levels).
+     * @param cumulativeMsv Dose integrated so far
+     * @param deadTimeSec   Tube dead time for the rate correction
+     * @param cpmPerUsvH    Conversion factor
+     * @param isotopeLevel  Level of the isotopes identified in the spectrum
+     */
+    const AlarmStatus& update(const RateWindows& windows, const AdaptiveRateEstimator& adaptive,
+                              float cumulativeMsv, float deadTimeSec, float cpmPerUsvH,
+                              const AlarmThresholds& t, uint8_t isotopeLevel = ALARM_LEVEL_NONE) {
+        float scale = 60.0f / cpmPerUsvH; // cps -> µSv/h
+        float z = t.confidenceZ;
+
+        // Confidence bounds of the rate over the adaptive and the 10 s window
+        float adaptiveLower, adaptiveUpper, fastLower, fastUpper;
+        bounds(adaptive.windowCounts(), adaptive.windowSeconds(), z, deadTimeSec, scale,
+               &adaptiveLower, &adaptiveUpper);
+        bounds(windows.sum(RATE_WINDOW_10S), windows.seconds(RATE_WINDOW_10S), z, deadTimeSec, scale,
+               &fastLower, &fastUpper);
+        float lower = adaptiveLower > fastLower ? adaptiveLower : fastLower;
+        float upper = adaptiveUpper;
+        float rate = correctDeadTimeCps(adaptive.cpm() / 60.0f, deadTimeSec) * scale;
+
+        // Dose rate: raise on the lower bound, hold until the upper bound is clear
+        uint8_t raise = ALARM_LEVEL_NONE;
+        uint8_t hold = ALARM_LEVEL_NONE;
+        for (uint8_t level = ALARM_LEVEL_WARN; level < ALARM_LEVEL_COUNT; level++) {
+            float threshold = t.rateUsvH[level];
+            if (threshold <= 0.0f) continue;
+            if (lower >= threshold) raise = level;
+            if (upper >= threshold * (1.0f - t.hysteresis)) hold = level;
+        }
+        uint8_t held = status_.rateLevel < hold ? status_.rateLevel : hold;
+        status_.rateLevel = raise > held ? raise : held;
+
+        // Cumulative dose
+        status_.doseLevel = ALARM_LEVEL_NONE;
+        for (uint8_t level = ALARM_LEVEL_WARN; level < ALARM_LEVEL_COUNT; level++) {
+            if (t.doseMsv[level] > 0.0f && cumulativeMsv >= t.doseMsv[level]) status_.doseLevel = level;
+        }
+
+        // Rate of rise against the 300 s baseline
+        bool rising = false;
+        if (windows.seconds(RATE_WINDOW_300S) >= RISE_MIN_BASELINE_S && fastLower >= t.riseMinUsvH &&
+            t.riseMinUsvH > 0.0f) {
+            float baseLower, baseUpper;
+            bounds(windows.sum(RATE_WINDOW_300S), windows.seconds(RATE_WINDOW_300S), z, deadTimeSec, scale,
+                   &baseLower, &baseUpper);
+            rising = fastLower > t.riseFactor * baseUpper;
+        }
+        if (rising) {
+            riseHold_ = RISE_HOLD_SECONDS;
+        } else if (riseHold_ > 0) {
+            riseHold_--;
+        }
+
+        // Time until the cumulative alarm dose at the current rate
+        status_.secondsToDoseAlarm = -1.0f;
+        float doseAlarm = t.doseMsv[ALARM_LEVEL_ALARM];
+        float msvPerSecond = rate / 3600.0f / 1000.0f;
+        if (doseAlarm > 0.0f && cumulativeMsv < doseAlarm && msvPerSecond > 0.0f) {
+            status_.secondsToDoseAlarm = (doseAlarm - cumulativeMsv) / msvPerSecond;
+        }
+        bool predicted = status_.secondsToDoseAlarm >= 0.0f && status_.secondsToDoseAlarm < t.predictSeconds;
+
+        uint8_t level = status_.rateLevel > status_.doseLevel ? status_.rateLevel : status_.doseLevel;
+        if ((riseHold_ > 0 || predicted) && level < ALARM_LEVEL_WARN) level = ALARM_LEVEL_WARN;
+        if (isotopeLevel > level) level = isotopeLevel;
+        status_.isotopeLevel = isotopeLevel;
+
+        status_.level = level;
+        status_.causes = 0;
+        if (status_.rateLevel != ALARM_LEVEL_NONE) status_.causes |= ALARM_CAUSE_RATE;
+        if (status_.doseLevel != ALARM_LEVEL_NONE) status_.causes |= ALARM_CAUSE_DOSE;
+        if (riseHold_ > 0) status_.causes |= ALARM_CAUSE_RISE;
+        if (predicted) status_.causes |= ALARM_CAUSE_PREDICTED;
+        if (isotopeLevel != ALARM_LEVEL_NONE) status_.causes |= ALARM_CAUSE_ISOTOPE;
+        status_.rateUsvH = rate;
+        status_.rateLowerUsvH = lower;
+        status_.rateUpperUsvH = upper;
+        status_.evaluations++;
+        return status_;
+    }
+
+    const AlarmStatus& status() const { return status_; }
+
+    /**
+     * @brief Approximate one-sided Poisson bounds of @p counts in @p seconds,
+     *        converted to dead-time corrected µSv/h.
+     *
+     * Uses the square-root approximation of count_statistics.h, which stays
+     * usable down to zero counts.
+     */
+    static void bounds(uint32_t counts, uint16_t seconds, float z, float deadTimeSec, float scale,
+                       float* lower, float* upper) {
+        if (seconds == 0) {
+            *lower = 0.0f;
+            *upper = INFINITY; // Nothing known yet: never clears, never raises
+            return;
+        }
+        float low, high;
+        poissonBounds(counts, z, &low, &high);
+        *lower = correctDeadTimeCps(low / seconds, deadTimeSec) * scale;
+        *upper = correctDeadTimeCps(high / seconds, deadTimeSec) * scale;
+    }
+
+private:
+    AlarmStatus status_;
+    uint16_t riseHold_;
+};
+
+#endif // ALARM_RULES_H
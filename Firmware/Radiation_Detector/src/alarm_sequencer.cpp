@@ -0,0 +1,258 @@
+/**
+ * @file alarm_sequencer.cpp
+ * @brief esp_timer driven buzzer patterns on a single LEDC channel.
+ *
+ * alarmSetLevel() is called from pulseTask only; the step state it shares
+ * with the timer callback is guarded by a spinlock. A stop that races with a
+ * callback already past the lock lets that one step play out: its timer then
+ * fires, sees the new level and continues with its pattern, so a cancelled
+ * tone lasts at most one step longer.
+ *
+ * Geiger clicks share the channel while no alarm sounds. A click is started
+ * from the pulse-capture ISR with a handful of register writes: the duty is set
+ * and the LEDC fade engine is told to ramp it back to zero after
+ * CLICK_PERIODS PWM periods, so the hardware ends the click on its own and no
+ * timer is needed in the ISR. Everything the ISR touches is in IRAM/DRAM, so
+ * clicks keep working while the flash cache is off. The ISR runs on the
+ * measurement core and the esp_timer task on the other one, so the ISR checks
+ * the sounding level and writes the click under the same spinlock that
+ * alarmSetLevel() changes the level under: once an alarm is set, no click can
+ * still be half-written when its first tone is. An alarm always takes
+ * precedence, clicks are skipped while one sounds.
+ *
+ * The search tone is a plain continuous tone whose frequency the search
+ * timer changes; it stands in for silence, so an alarm interrupts it and
+ * silence() puts it back.
+ */
+
+#include "alarm_sequencer.h"
+#include "latency_probe.h"
+#include "trace.h"
+#include "esp_timer.h"
+#include "hal/ledc_ll.h"
+#include "soc/ledc_struct.h"
+
+struct AlarmStep {
+    uint32_t frequency; ///< Hz, 0 for silence
+    uint32_t durationMs;
+};
+
+struct AlarmPattern {
+    const AlarmStep* steps;
+    size_t count;
+};
+
+static const AlarmStep WARN_STEPS[] = {
+    {2000, 60},
+    {0, 1940},
+};
+static const AlarmStep ALARM_STEPS[] = {
+    {1000, 200},
+    {0, 50},
+    {1500, 200},
+    {0, 50},
+};
+static const AlarmStep DANGER_STEPS[] = {
+    {1500, 100},
+    {2500, 100},
+};
+
+#define ALARM_PATTERN_OF(steps) {steps, sizeof(steps) / sizeof(steps[0])}
+
+// Indexed by AlarmLevel
+static const AlarmPattern ALARM_PATTERNS[ALARM_LEVEL_COUNT] = {
+    {nullptr, 0},
+    ALARM_PATTERN_OF(WARN_STEPS),
+    ALARM_PATTERN_OF(ALARM_STEPS),
+    ALARM_PATTERN_OF(DANGER_STEPS),
+};
+
+static const uint8_t ALARM_RESOLUTION_BITS = 8;
+static const uint32_t ALARM_DUTY = 128; ///< 50 % square wave
+
+static const uint32_t CLICK_FREQUENCY = 4000;     ///< Hz while clicks are enabled and no alarm sounds
+static const uint32_t CLICK_PERIODS = 4;          ///< PWM periods per click (1 ms at 4 kHz)
+static const uint32_t CLICK_MIN_INTERVAL_US = 2000; ///< Click plus silence, caps clicks at 500/s
+static const float CLICK_MAX_PER_SECOND = 50.0f;  ///< Rate compression target (~3 kCPM)
+
+static esp_timer_handle_t stepTimer = nullptr;
+static portMUX_TYPE alarmLock = portMUX_INITIALIZER_UNLOCKED;
+static uint8_t ledcChannel = 0;
+static volatile uint8_t soundingLevel = ALARM_LEVEL_NONE;
+static volatile bool ackRequested = false;
+static uint8_t acknowledgedLevel = ALARM_LEVEL_NONE; ///< pulseTask only
+static size_t stepIndex = 0;
+static int64_t soundingSinceUs = 0;         ///< Under alarmLock, with soundedUs
+static uint64_t soundedUs = 0;              ///< Finished alarm patterns, for the energy meter
+
+static volatile bool clicksEnabled = false;
+static volatile uint32_t clickDivider = 1;  ///< One click per this many pulses
+static uint32_t clickPulses = 0;            ///< ISR only
+static uint32_t lastClickUs = 0;            ///< ISR only
+static volatile uint32_t clicksPlayed = 0;
+
+static volatile uint32_t searchFrequency = 0; ///< Hz, 0 while the search tone is off
+
+/**
+ * @brief Mutes the channel, or plays the search tone while there is one; with
+ *        clicks enabled it is left tuned to the click tone.
+ */
+static void silence() {
+    uint32_t frequency = searchFrequency;
+    if (frequency) {
+        ledcChangeFrequency(ledcChannel, frequency, ALARM_RESOLUTION_BITS);
+        ledcWrite(ledcChannel, ALARM_DUTY);
+        return;
+    }
+    ledcWrite(ledcChannel, 0);
+    if (clicksEnabled) ledcChangeFrequency(ledcChannel, CLICK_FREQUENCY, ALARM_RESOLUTION_BITS);
+}
+
+/**
+ * @brief Drives the channel for step @p index of @p level's pattern and arms the timer for its end.
+ */
+static void playStep(uint8_t level, size_t index) {
+    const AlarmStep& step = ALARM_PATTERNS[level].steps[index];
+    if (step.frequency) {
+        ledcChangeFrequency(ledcChannel, step.frequency, ALARM_RESOLUTION_BITS);
+        ledcWrite(ledcChannel, ALARM_DUTY);
+    } else {
+        ledcWrite(ledcChannel, 0);
+    }
+    esp_timer_start_once(stepTimer, (uint64_t)step.durationMs * 1000);
+}
+
+static void stepTimerCallback(void* arg) {
+    portENTER_CRITICAL(&alarmLock);
+    uint8_t level = soundingLevel;
+    size_t index = 0;
+    if (level != ALARM_LEVEL_NONE) {
+        stepIndex = (stepIndex + 1) % ALARM_PATTERNS[level].count;
+        index = stepIndex;
+    }
+    portEXIT_CRITICAL(&alarmLock);
+
+    if (level != ALARM_LEVEL_NONE) {
+        playStep(level, index);
+    } else {
+        silence();
+    }
+}
+
+bool initAlarmSequencer(uint8_t pin, uint8_t channel) {
+    if (stepTimer) return true;
+    ledcChannel = channel;
+    ledcSetup(ledcChannel, ALARM_STEPS[0].frequency, ALARM_RESOLUTION_BITS);
+    ledcAttachPin(pin, ledcChannel);
+    ledcWrite(ledcChannel, 0);
+
+    esp_timer_create_args_t args = {};
+    args.callback = stepTimerCallback;
+    args.name = "alarm";
+    return esp_timer_create(&args, &stepTimer) == ESP_OK;
+}
+
+void alarmSetLevel(uint8_t level) {
+    if (level >= ALARM_LEVEL_COUNT) level = ALARM_LEVEL_DANGER;
+    if (ackRequested) {
+        ackRequested = false;
+        acknowledgedLevel = level;
+    }
+    if (level > acknowledgedLevel || level == ALARM_LEVEL_NONE) acknowledgedLevel = ALARM_LEVEL_NONE;
+    if (acknowledgedLevel != ALARM_LEVEL_NONE) level = ALARM_LEVEL_NONE;
+    if (!stepTimer || level == soundingLevel) return;
+
+    if (soundingLevel == ALARM_LEVEL_NONE) latencyProbeAlarm(); // First tone of an alarm
+    int64_t nowUs = esp_timer_get_time();
+    portENTER_CRITICAL(&alarmLock);
+    if (soundingLevel == ALARM_LEVEL_NONE) soundingSinceUs = nowUs;
+    else if (level == ALARM_LEVEL_NONE) soundedUs += nowUs - soundingSinceUs;
+    soundingLevel = level;
+    stepIndex = 0;
+    portEXIT_CRITICAL(&alarmLock);
+
+    esp_timer_stop(stepTimer); // ESP_ERR_INVALID_STATE if it was not armed
+    if (level != ALARM_LEVEL_NONE) {
+        playStep(level, 0);
+    } else {
+        silence();
+    }
+    TRACE_EVENT(TRACE_ALARM_STATE, level, 0);
+}
+
+uint8_t alarmSoundingLevel() {
+    return soundingLevel;
+}
+
+uint64_t alarmSoundingUs() {
+    int64_t nowUs = esp_timer_get_time();
+    portENTER_CRITICAL(&alarmLock);
+    uint64_t total = soundedUs + (soundingLevel != ALARM_LEVEL_NONE ? nowUs - soundingSinceUs : 0);
+    portEXIT_CRITICAL(&alarmLock);
+    return total;
+}
+
+bool alarmAcknowledge() {
+    if (soundingLevel == ALARM_LEVEL_NONE) return false;
+    ackRequested = true;
+    return true;
+}
+
+/**
+ * @brief Flattened: the ledc_ll_* helpers are plain static inline, and one
+ *        emitted out of line would sit in flash, out of reach while a flash
+ *        write has the cache off.
+ */
+void IRAM_ATTR __attribute__((flatten)) alarmClickFromIsr(uint32_t timestampUs) {
+    if (!clicksEnabled || searchFrequency) return; // The search tone carries the pulses
+    if (++clickPulses < clickDivider) return;
+    if (timestampUs - lastClickUs < CLICK_MIN_INTERVAL_US) return; // The next pulse clicks instead
+
+    portENTER_CRITICAL_ISR(&alarmLock);
+    if (soundingLevel != ALARM_LEVEL_NONE) {
+        portEXIT_CRITICAL_ISR(&alarmLock);
+        return;
+    }
+    clickPulses = 0;
+    lastClickUs = timestampUs;
+
+    // Arduino maps channels 0-7 to the low-speed group (the only one on the S3)
+    ledc_channel_t channel = (ledc_channel_t)(ledcChannel % 8);
+    ledc_ll_set_duty_int_part(&LEDC, LEDC_LOW_SPEED_MODE, channel, ALARM_DUTY);
+    ledc_ll_set_duty_direction(&LEDC, LEDC_LOW_SPEED_MODE, channel, LEDC_DUTY_DIR_DECREASE);
+    ledc_ll_set_duty_num(&LEDC, LEDC_LOW_SPEED_MODE, channel, 1);
+    ledc_ll_set_duty_cycle(&LEDC, LEDC_LOW_SPEED_MODE, channel, CLICK_PERIODS);
+    ledc_ll_set_duty_scale(&LEDC, LEDC_LOW_SPEED_MODE, channel, ALARM_DUTY);
+    ledc_ll_set_duty_start(&LEDC, LEDC_LOW_SPEED_MODE, channel, true);
+    ledc_ll_ls_channel_update(&LEDC, LEDC_LOW_SPEED_MODE, channel);
+    portEXIT_CRITICAL_ISR(&alarmLock);
+    clicksPlayed = clicksPlayed + 1;
+}
+
+void alarmSetClicks(bool enabled) {
+    if (enabled == clicksEnabled) return;
+    clicksEnabled = enabled;
+    if (soundingLevel == ALARM_LEVEL_NONE) silence();
+}
+
+void alarmSetClickRate(float countsPerSecond) {
+    uint32_t divider = (uint32_t)ceilf(countsPerSecond / CLICK_MAX_PER_SECOND);
+    clickDivider = divider > 1 ? divider : 1;
+}
+
+AlarmClickStats getAlarmClickStats() {
+    AlarmClickStats stats;
+    stats.enabled = clicksEnabled;
+    stats.divider = clickDivider;
+    stats.played = clicksPlayed;
+    return stats;
+}
+
+void alarmSetSearchTone(uint32_t frequency) {
+    if (frequency == searchFrequency) return;
+    portENTER_CRITICAL(&alarmLock);
+    searchFrequency = frequency;
+    bool alarm = soundingLevel != ALARM_LEVEL_NONE;
+    portEXIT_CRITICAL(&alarmLock);
+    if (stepTimer && !alarm) silence();
+}
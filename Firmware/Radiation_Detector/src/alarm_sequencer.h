@@ -0,0 +1,60 @@
+#ifndef ALARM_SEQUENCER_H
+#define ALARM_SEQUENCER_H
+
+#include <Arduino.h>
+#include "alarm_rules.h"
+
+// Buzzer alarm patterns generated from an esp_timer, independent of the UI loop.
+// Each alarm level has a table of steps (warn: a chirp every 2 s, alarm:
+// 1000 Hz / pause / 1500 Hz / pause, danger: a continuous fast warble); each
+// step's one-shot timer callback switches the LEDC channel to the next tone.
+// The channel is configured once, steps only change the frequency and duty.
+// The callbacks run on the esp_timer task, so chart redraws, WiFi connects or
+// HTTP requests on other tasks never stretch or freeze the tone.
+
+// Configures the LEDC channel on @p pin (silent) and creates the step timer.
+bool initAlarmSequencer(uint8_t pin, uint8_t channel);
+
+// Plays the pattern of @p level (ALARM_LEVEL_NONE: silent). Idempotent and
+// cheap, so it can be called on every evaluation. One caller task (pulseTask).
+void alarmSetLevel(uint8_t level);
+
+uint8_t alarmSoundingLevel();
+
+// Time an alarm pattern has sounded since boot, the current one included
+// (energy_meter.h). Any task.
+uint64_t alarmSoundingUs();
+
+// Silences the sounding alarm (any task). It stays silent while the level
+// stays at or below the acknowledged one; a higher level sounds again, and
+// once the alarm clears the next one sounds as usual. Takes effect on the
+// next alarmSetLevel(). @return false if nothing was sounding
+bool alarmAcknowledge();
+
+// Optional audible Geiger clicks on the same buzzer. With clicks enabled every
+// pulse, or every Nth one at high rates, plays a ~1 ms click started directly
+// from the pulse-capture ISR. Install alarmClickFromIsr() as the capture hook.
+struct AlarmClickStats {
+    bool enabled;
+    uint32_t divider;  ///< Pulses per click after rate compression
+    uint32_t played;   ///< Clicks since boot
+};
+
+// IRAM, ISR context; called for every captured pulse.
+void alarmClickFromIsr(uint32_t timestampUs);
+
+void alarmSetClicks(bool enabled);
+
+// Rate compression: sets the divider so at most ~50 clicks/s are played.
+// pulseTask calls it once per second with the recent count rate.
+void alarmSetClickRate(float countsPerSecond);
+
+AlarmClickStats getAlarmClickStats();
+
+// Continuous search tone (search_mode.h) on the same buzzer: @p frequency Hz,
+// 0 for silence. An alarm takes precedence and the search tone resumes when
+// it ends. Only reprograms the channel when the frequency changes. One caller
+// (the search timer).
+void alarmSetSearchTone(uint32_t frequency);
+
+#endif // ALARM_SEQUENCER_H
@@ -0,0 +1,228 @@
+/**
+ * @file anomaly_capture.cpp
+ * @brief Rate anomaly detector, event log, trace triggers, web endpoint and serial report.
+ *
+ * The detector and the open event belong to pulseTask, which tests each
+ * closed second in a few floating-point operations and publishes the status
+ * through a SeqLock. A trigger only hands the pre-trigger ring to the writer
+ * task (pulseRecorderTrigger) and queues the telemetry line; nothing on this
+ * path blocks or touches storage.
+ */
+
+#include "anomaly_capture.h"
+#include "command_bus.h"
+#include "pulse_recorder.h"
+#include "telemetry.h"
+#include "time_base.h"
+#include "seqlock.h"
+#include "debug.h"
+#include "json_body.h"
+#include "json_arena.h"
+#include "web_arena.h"
+#include <ArduinoJson.h>
+#include <atomic>
+
+// pulseTask state
+static PoissonCusum detector;
+static AnomalyEvent events[ANOMALY_EVENT_LOG]; ///< Newest first
+static uint8_t eventCount = 0;
+static uint32_t triggers = 0;
+
+static SeqLock<AnomalyStatus> statusLock;
+static std::atomic<uint32_t> eventVersion(0);
+static WebServer* anomalyServer = nullptr;
+
+void initAnomalyCapture() {
+    detector.configure({ANOMALY_SHIFT, ANOMALY_THRESHOLD, (float)ANOMALY_LEARN_TAU_S, ANOMALY_WARMUP_S, 0.05f});
+    anomalyArm(ANOMALY_CAPTURE_ENABLED);
+}
+
+/**
+ * @brief Copies the detector and the event log into the published status.
+ */
+static void publish() {
+    static AnomalyStatus s; // About 600 bytes, kept off the stack
+    s.armed = pulseRecorderArmed();
+    s.warm = detector.warm();
+    s.backgroundCps = detector.backgroundCps();
+    s.statistic = detector.statistic();
+    s.threshold = detector.params().threshold;
+    s.shift = detector.params().shift;
+    s.seconds = detector.seconds();
+    s.triggers = triggers;
+    s.eventCount = eventCount;
+    memcpy(s.events, events, sizeof(events));
+    statusLock.publish(s);
+}
+
+/**
+ * @brief Opens a new event at the front of the log and starts its trace.
+ */
+static void startEvent(uint32_t nowMs) {
+    memmove(events + 1, events, (ANOMALY_EVENT_LOG - 1) * sizeof(events[0]));
+    if (eventCount < ANOMALY_EVENT_LOG) eventCount++;
+    AnomalyEvent& e = events[0];
+    memset(&e, 0, sizeof(e));
+    e.startUtc = timeBaseUtcValid() ? timeBaseUtcSeconds() : 0;
+    e.startUptimeS = timeBaseSeconds();
+    e.backgroundCps = detector.backgroundCps();
+    e.active = true;
+    if (e.startUtc) snprintf(e.trace, sizeof(e.trace), "ev-%lu", (unsigned long)e.startUtc);
+    else snprintf(e.trace, sizeof(e.trace), "ev-up%lu", (unsigned long)e.startUptimeS);
+    e.captured = pulseRecorderTrigger(nowMs, e.trace);
+    triggers++;
+}
+
+void anomalyCaptureSecond(uint32_t counts, bool injected, uint32_t nowMs) {
+    if (injected) return;
+
+    CusumResult result = detector.addSecond(counts);
+    if (result == CUSUM_TRIGGERED) startEvent(nowMs);
+    if (result != CUSUM_QUIET && eventCount) {
+        AnomalyEvent& e = events[0];
+        e.seconds++;
+        e.counts += counts;
+        if (counts > e.peakCps) e.peakCps = counts;
+        if (detector.peak() > e.peakStatistic) e.peakStatistic = detector.peak();
+        // Keeps the trace going until ANOMALY_POST_S after the end, or starts
+        // it late if the recorder was busy at the trigger
+        if (result == CUSUM_ACTIVE) {
+            if (e.captured) pulseRecorderExtend(nowMs);
+            else e.captured = pulseRecorderTrigger(nowMs, e.trace);
+        }
+    }
+
+    if (result == CUSUM_TRIGGERED || result == CUSUM_ENDED) {
+        AnomalyEvent& e = events[0];
+        bool ended = result == CUSUM_ENDED;
+        if (ended) e.active = false;
+        uint32_t stamp = (e.startUtc ? e.startUtc : e.startUptimeS) + (ended ? e.seconds : 0);
+        telemetryEvent(stamp, e.startUtc != 0, e.peakCps, e.backgroundCps,
+                       (uint16_t)(e.seconds < 65535 ? e.seconds : 65535), ended);
+        DEBUG_PRINTF("Anomaly %s: %.1f cps peak over %.2f cps background, %lu s%s%s\n", ended ? "ended" : "triggered",
+                     e.peakCps, e.backgroundCps, (unsigned long)e.seconds, e.captured ? ", trace " : "", e.trace);
+        publish();
+        eventVersion++;
+        return;
+    }
+    // The statistic moves every second; the report needs no more than that
+    publish();
+}
+
+bool anomalyRequestReset() {
+    Command cmd = {};
+    cmd.type = COMMAND_RESET_ANOMALY;
+    return commandPost(COMMAND_TARGET_PULSE, cmd);
+}
+
+bool anomalyActive() {
+    return detector.active();
+}
+
+void anomalyReset() {
+    detector.reset();
+    if (eventCount && events[0].active) events[0].active = false;
+    publish();
+}
+
+void anomalyArm(bool armed) {
+    pulseRecorderArm(armed);
+}
+
+AnomalyStatus getAnomalyStatus() {
+    AnomalyStatus s;
+    if (!statusLock.read(s)) memset(&s, 0, sizeof(s));
+    return s;
+}
+
+uint32_t anomalyEventVersion() {
+    return eventVersion;
+}
+
+void buildAnomalyJson(JsonDocument& doc) {
+    static AnomalyStatus s; // Web task only
+    s = getAnomalyStatus();
+    doc["armed"] = pulseRecorderArmed();
+    doc["warm"] = s.warm;
+    doc["background_cps"] = s.backgroundCps;
+    doc["statistic"] = s.statistic;
+    doc["threshold"] = s.threshold;
+    doc["shift"] = s.shift;
+    doc["seconds"] = s.seconds;
+    doc["triggers"] = s.triggers;
+    doc["pre_s"] = ANOMALY_PRE_S;
+    doc["post_s"] = ANOMALY_POST_S;
+    JsonArray list = doc["events"].to<JsonArray>();
+    for (uint8_t i = 0; i < s.eventCount; i++) {
+        const AnomalyEvent& e = s.events[i];
+        JsonObject o = list.add<JsonObject>();
+        if (e.startUtc) o["start"] = e.startUtc;
+        o["uptime_s"] = e.startUptimeS;
+        o["seconds"] = e.seconds;
+        o["counts"] = e.counts;
+        o["background_cps"] = e.backgroundCps;
+        o["peak_cps"] = e.peakCps;
+        o["peak_statistic"] = e.peakStatistic;
+        o["active"] = e.active;
+        if (e.captured) o["trace"] = e.trace;
+    }
+}
+
+String getAnomalyJson() {
+    JsonArenaLease lease;
+    JsonDocument doc(lease.allocator());
+    buildAnomalyJson(doc);
+    String json;
+    serializeJson(doc, json);
+    return json;
+}
+
+/**
+ * @brief POST /api/anomaly with {"action":"arm|disarm|reset"} or ?action=...
+ */
+static void handleAnomalyControl(WebServer& server, JsonVariantConst body) {
+    String action = body["action"] | server.arg("action");
+    if (action == "arm" || action == "disarm") {
+        anomalyArm(action == "arm");
+        server.send(200, "text/plain", "OK");
+    } else if (action == "reset") {
+        if (!anomalyRequestReset()) {
+            server.send(503, "text/plain", "Command queue full");
+            return;
+        }
+        server.send(202, "text/plain", "Queued");
+    } else {
+        server.send(400, "text/plain", "action must be arm, disarm or reset");
+    }
+}
+
+void anomalyAttach(WebServer& server) {
+    anomalyServer = &server;
+    server.on("/api/anomaly", HTTP_GET, []() {
+        anomalyServer->sendHeader("Cache-Control", "no-store");
+        anomalyServer->sendHeader("Access-Control-Allow-Origin", "*");
+        JsonArenaLease lease;
+        JsonDocument doc(lease.allocator());
+        buildAnomalyJson(doc);
+        webSendJson(*anomalyServer, 200, doc);
+    });
+    jsonBodyOn(server, "/api/anomaly", JSON_BODY_ACTION_FILTER, handleAnomalyControl);
+}
+
+void printAnomaly(Print& out) {
+    static AnomalyStatus s; // uiTask only
+    s = getAnomalyStatus();
+    out.printf("Anomaly detector: %s, capture %s, %lu s tested, %lu triggers\n",
+               s.warm ? "running" : "warming up", pulseRecorderArmed() ? "armed" : "off", (unsigned long)s.seconds,
+               (unsigned long)s.triggers);
+    out.printf("  background %.3f cps, CUSUM %.2f of %.1f (tuned to %.1fx), trace %u s before, %u s after\n",
+               s.backgroundCps, s.statistic, s.threshold, s.shift, (unsigned)ANOMALY_PRE_S, (unsigned)ANOMALY_POST_S);
+    for (uint8_t i = 0; i < s.eventCount; i++) {
+        const AnomalyEvent& e = s.events[i];
+        if (e.startUtc) out.printf("  %lu UTC", (unsigned long)e.startUtc);
+        else out.printf("  %lu s uptime", (unsigned long)e.startUptimeS);
+        out.printf(": %lu s%s, %lu counts, peak %.0f cps over %.2f, %s\n", (unsigned long)e.seconds,
+                   e.active ? " so far" : "", (unsigned long)e.counts, e.peakCps, e.backgroundCps,
+                   e.captured ? e.trace : "no trace");
+    }
+}
@@ -0,0 +1,84 @@
+#ifndef ANOMALY_CAPTURE_H
+#define ANOMALY_CAPTURE_H
+
+#include <Arduino.h>
+#include <WebServer.h>
+#include <ArduinoJson.h>
+#include "config.h"
+#include "anomaly_detector.h"
+
+// Event-triggered capture of rate anomalies ("anomaly", /api/anomaly).
+// pulseTask runs every closed second through a Poisson CUSUM against the
+// learned background (anomaly_detector.h). A trigger writes the pulse
+// recorder's pre-trigger ring to a new trace, ev-<UTC> or ev-up<uptime>, and
+// records every pulse until ANOMALY_POST_S after the event has ended
+// (pulse_recorder.h); the trace replays like any other (tools/pulse_replay).
+// So full detail is kept around events only, not for every second. Start and
+// end of an event are pushed as a "radiation_event" telemetry line and an
+// "anomaly" server-sent event. Injected pulses (pulse_injector.h) are left
+// out, and the last ANOMALY_EVENT_LOG events are kept for the report.
+//   GET  /api/anomaly                        detector state and recent events
+//   POST /api/anomaly?action=arm|disarm|reset
+
+static const uint8_t ANOMALY_EVENT_LOG = 8;
+
+struct AnomalyEvent {
+    uint32_t startUtc;          ///< 0 if UTC was not known
+    uint32_t startUptimeS;
+    uint32_t seconds;           ///< Trigger to end (so far, while active)
+    uint32_t counts;            ///< Counted in those seconds
+    float backgroundCps;        ///< At the trigger
+    float peakCps;              ///< Highest 1-second count
+    float peakStatistic;        ///< Highest CUSUM value
+    bool active;
+    bool captured;              ///< A trace was written
+    char trace[24];             ///< Name of its trace (if captured)
+};
+
+struct AnomalyStatus {
+    bool armed;                 ///< Event capture armed (the detector always runs)
+    bool warm;                  ///< Past the warm-up
+    float backgroundCps;
+    float statistic;            ///< CUSUM S
+    float threshold;
+    float shift;
+    uint32_t seconds;           ///< Seconds tested since the last reset
+    uint32_t triggers;
+    uint8_t eventCount;         ///< Valid entries of events[], newest first
+    AnomalyEvent events[ANOMALY_EVENT_LOG];
+};
+
+// Applies the configured parameters and arms event capture if
+// ANOMALY_CAPTURE_ENABLED. Call in setup() after initPulseRecorder().
+void initAnomalyCapture();
+
+// pulseTask only: one closed second. @p injected: the pulse injector is running.
+void anomalyCaptureSecond(uint32_t counts, bool injected, uint32_t nowMs);
+
+// Any task: posts COMMAND_RESET_ANOMALY. @return false if the queue is full
+bool anomalyRequestReset();
+
+// pulseTask only: an event is in progress.
+bool anomalyActive();
+
+// pulseTask only (COMMAND_RESET_ANOMALY): learns the background anew.
+void anomalyReset();
+
+// Arms or disarms event capture. Any task.
+void anomalyArm(bool armed);
+
+// Consistent copy of the last published status. Any task, lock-free.
+AnomalyStatus getAnomalyStatus();
+
+// Changes when an event starts or ends (0: none since boot).
+uint32_t anomalyEventVersion();
+
+void buildAnomalyJson(JsonDocument& doc);
+String getAnomalyJson();
+
+// Registers /api/anomaly. Call while the other routes are set up.
+void anomalyAttach(WebServer& server);
+
+void printAnomaly(Print& out);
+
+#endif // ANOMALY_CAPTURE_H
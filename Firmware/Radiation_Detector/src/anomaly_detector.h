@@ -0,0 +1,112 @@
+#ifndef ANOMALY_DETECTOR_H
+#define ANOMALY_DETECTOR_H
+
+#include <math.h>
+#include <stdint.h>
+
+// Sequential test of the 1-second counts against the learned background.
+// A one-sided Poisson CUSUM for a step from the background rate b to k b:
+//     S = max(0, S + x ln(k) - (k - 1) b)
+// is Page's cumulative log-likelihood ratio, i.e. a repeated SPRT that
+// restarts at zero whenever the evidence favours the background. It triggers
+// when S crosses the threshold h: the false-alarm interval grows roughly as
+// exp(h), the delay to a real step as h / (k ln k - k + 1) / b seconds, and
+// a large step (a source brought close) crosses within a second or two. The
+// event ends once S has fallen back to zero; S is capped at twice h so a
+// long event does not take as long again to end.
+// The background is a bias-corrected exponential average of the counts
+// (like rate_ewma.h), fed only while S is below h / 2, so an event does not
+// teach itself as the new background. No decision is made during the first
+// warm-up seconds. Only increases are detected: a drop in rate is a tube or
+// HV problem and is left to tube_health.h.
+// No Arduino dependencies (host-compilable).
+
+struct CusumParams {
+    float shift;          ///< k: rate ratio the test is tuned to (> 1)
+    float threshold;      ///< h, in nats
+    float learnTauS;      ///< Time constant of the background average
+    uint32_t warmupS;     ///< Seconds of background before the first decision
+    float minCps;         ///< Floor of the background (a quiet tube early on)
+};
+
+enum CusumResult {
+    CUSUM_QUIET = 0,
+    CUSUM_TRIGGERED,      ///< S crossed h in this second
+    CUSUM_ACTIVE,         ///< Still above zero after a trigger
+    CUSUM_ENDED           ///< S returned to zero in this second
+};
+
+class PoissonCusum {
+public:
+    PoissonCusum() { configure({2.0f, 12.0f, 3600.0f, 300, 0.05f}); }
+
+    void configure(const CusumParams& p) {
+        params_ = p;
+        if (params_.shift < 1.05f) params_.shift = 1.05f;
+        logShift_ = log((double)params_.shift);
+        alpha_ = 1.0 - exp(-1.0 / (params_.learnTauS > 1.0f ? params_.learnTauS : 1.0f));
+        reset();
+    }
+
+    void reset() {
+        value_ = 0.0;
+        decay_ = 1.0;
+        statistic_ = 0.0;
+        peak_ = 0.0;
+        seconds_ = 0;
+        active_ = false;
+    }
+
+    /// One closed second.
+    CusumResult addSecond(uint32_t counts) {
+        seconds_++;
+        bool warm = seconds_ > params_.warmupS;
+        if (warm) {
+            double b = backgroundCps();
+            statistic_ += counts * logShift_ - (params_.shift - 1.0) * b;
+            if (statistic_ < 0.0) statistic_ = 0.0;
+            if (statistic_ > 2.0 * params_.threshold) statistic_ = 2.0 * params_.threshold;
+            if (statistic_ > peak_) peak_ = statistic_;
+        }
+        if (!warm || statistic_ < 0.5 * params_.threshold) {
+            value_ += alpha_ * (counts - value_);
+            decay_ *= 1.0 - alpha_;
+        }
+        if (!active_) {
+            if (statistic_ < params_.threshold) return CUSUM_QUIET;
+            active_ = true;
+            return CUSUM_TRIGGERED;
+        }
+        if (statistic_ > 0.0) return CUSUM_ACTIVE;
+        active_ = false;
+        peak_ = 0.0;
+        return CUSUM_ENDED;
+    }
+
+    /// Learned background in counts per second (the floor until warmed up).
+    float backgroundCps() const {
+        double weight = 1.0 - decay_;
+        double b = weight > 0.0 ? value_ / weight : 0.0;
+        return (float)(b > params_.minCps ? b : params_.minCps);
+    }
+
+    float statistic() const { return (float)statistic_; }
+    float peak() const { return (float)peak_; }     ///< Highest S of the current event
+    bool active() const { return active_; }
+    bool warm() const { return seconds_ > params_.warmupS; }
+    uint32_t seconds() const { return seconds_; }
+    const CusumParams& params() const { return params_; }
+
+private:
+    CusumParams params_;
+    double logShift_;
+    double alpha_;
+    double value_;
+    double decay_;        ///< (1 - a)^n: weight not yet given to data
+    double statistic_;
+    double peak_;
+    uint32_t seconds_;
+    bool active_;
+};
+
+#endif // ANOMALY_DETECTOR_H
@@ -0,0 +1,242 @@
+/**
+ * @file asset_pack.cpp
+ * @brief LVGL image decoder for the memory-mapped asset partition.
+ *
+ * esp_partition_mmap() maps the partition into the data address space through
+ * the flash cache, so raw entries are handed to LVGL as a pointer into the
+ * mapping, exactly like a C array in .rodata. The decoder is created before the
+ * image cache statistics one (img_cache_stats.h), which delegates to it.
+ */
+
+#include "config.h"
+
+#if !HEADLESS
+
+#include "asset_pack.h"
+#include "debug.h"
+#include <lvgl.h>
+#include "esp_partition.h"
+#include "esp_heap_caps.h"
+#include "esp_rom_crc.h"
+
+static const char* PARTITION_LABEL = "assets";
+static const uint32_t PACK_MAGIC = 0x5041564c; // "LVAP"
+static const uint16_t PACK_VERSION = 1;
+static const uint8_t ENCODING_RAW = 0;
+static const uint8_t ENCODING_RLE = 1;
+
+struct PackHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;
+    uint32_t size; ///< Header, entries and data
+    uint32_t crc;  ///< CRC-32 of everything after the header
+};
+
+struct PackEntry {
+    char name[32];     ///< The placeholder's lv_img_dsc_t symbol, NUL-terminated
+    uint16_t w;
+    uint16_t h;
+    uint8_t cf;        ///< lv_img_cf_t of the pixels
+    uint8_t encoding;  ///< ENCODING_RAW or ENCODING_RLE
+    uint16_t reserved;
+    uint32_t offset;   ///< From the start of the pack
+    uint32_t size;     ///< Bytes stored
+    uint32_t rawSize;  ///< Bytes of the decoded pixels
+};
+
+static_assert(sizeof(PackHeader) == 16 && sizeof(PackEntry) == 52, "asset pack layout (tools/pack_assets.py)");
+
+static const uint8_t* pack = nullptr;
+static const PackEntry* entries = nullptr;
+static AssetPackStats stats;
+
+/**
+ * @return the pack entry a placeholder image names, or nullptr
+ */
+static const PackEntry* findEntry(const void* src) {
+    if (!pack || lv_img_src_get_type(src) != LV_IMG_SRC_VARIABLE) return nullptr;
+    const lv_img_dsc_t* img = (const lv_img_dsc_t*)src;
+    if (img->header.cf != LV_IMG_CF_USER_ENCODED_0 || !img->data) return nullptr;
+    for (uint16_t i = 0; i < stats.images; i++) {
+        if (strncmp(entries[i].name, (const char*)img->data, sizeof(entries[i].name)) == 0) return &entries[i];
+    }
+    return nullptr;
+}
+
+static uint8_t pixelBytes(uint8_t cf) {
+    return cf == LV_IMG_CF_TRUE_COLOR_ALPHA ? LV_IMG_PX_SIZE_ALPHA_BYTE : LV_COLOR_SIZE / 8;
+}
+
+/**
+ * @brief Expands RLE packets of @p unit-byte pixels.
+ * @return false if the packets do not decode to exactly @p outSize bytes
+ */
+static bool expandRle(const uint8_t* in, uint32_t inSize, uint8_t* out, uint32_t outSize, uint8_t unit) {
+    const uint8_t* inEnd = in + inSize;
+    uint8_t* outEnd = out + outSize;
+    while (in < inEnd) {
+        uint8_t control = *in++;
+        uint32_t n = (control & 0x7f) + 1;
+        uint32_t bytes = n * unit;
+        if ((uint32_t)(outEnd - out) < bytes) return false;
+        if (control & 0x80) {
+            if ((uint32_t)(inEnd - in) < unit) return false;
+            for (uint32_t i = 0; i < n; i++, out += unit) memcpy(out, in, unit);
+            in += unit;
+        } else {
+            if ((uint32_t)(inEnd - in) < bytes) return false;
+            memcpy(out, in, bytes);
+            in += bytes;
+            out += bytes;
+        }
+    }
+    return out == outEnd;
+}
+
+static lv_res_t packInfo(lv_img_decoder_t* decoder, const void* src, lv_img_header_t* header) {
+    const PackEntry* entry = findEntry(src);
+    if (!entry) return LV_RES_INV;
+    header->always_zero = 0;
+    header->w = entry->w;
+    header->h = entry->h;
+    header->cf = entry->cf;
+    return LV_RES_OK;
+}
+
+static lv_res_t packOpen(lv_img_decoder_t* decoder, lv_img_decoder_dsc_t* dsc) {
+    const PackEntry* entry = findEntry(dsc->src);
+    if (!entry) {
+        stats.failures++;
+        return LV_RES_INV;
+    }
+    stats.opens++;
+    const uint8_t* data = pack + entry->offset;
+    if (entry->encoding == ENCODING_RAW) {
+        dsc->img_data = data;
+        return LV_RES_OK;
+    }
+
+    // PSRAM: a decoded entry can be the size of the whole splash image
+    uint8_t* pixels = (uint8_t*)heap_caps_malloc(entry->rawSize, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!pixels) pixels = (uint8_t*)heap_caps_malloc(entry->rawSize, MALLOC_CAP_8BIT);
+    if (!pixels || !expandRle(data, entry->size, pixels, entry->rawSize, pixelBytes(entry->cf))) {
+        heap_caps_free(pixels);
+        stats.failures++;
+        return LV_RES_INV;
+    }
+    stats.expansions++;
+    stats.expandedBytes += entry->rawSize;
+    dsc->img_data = pixels;
+    dsc->user_data = pixels;
+    return LV_RES_OK;
+}
+
+static void packClose(lv_img_decoder_t* decoder, lv_img_decoder_dsc_t* dsc) {
+    if (!dsc->user_data) return;
+    const PackEntry* entry = findEntry(dsc->src);
+    if (entry) stats.expandedBytes -= entry->rawSize;
+    heap_caps_free(dsc->user_data);
+    dsc->user_data = nullptr;
+}
+
+/**
+ * @return true if the entries of the mapped pack of @p size bytes lie inside
+ *         it and its CRC matches
+ */
+static bool verifyPack(const uint8_t* base, uint32_t size) {
+    const PackHeader* header = (const PackHeader*)base;
+    uint32_t tableEnd = sizeof(PackHeader) + (uint32_t)header->count * sizeof(PackEntry);
+    if (tableEnd > size) {
+        DEBUG_PRINTLN("Asset pack: entry table out of range");
+        return false;
+    }
+    const PackEntry* table = (const PackEntry*)(base + sizeof(PackHeader));
+    for (uint16_t i = 0; i < header->count; i++) {
+        const PackEntry& e = table[i];
+        if (e.offset < tableEnd || e.offset > size || e.size > size - e.offset ||
+            e.name[sizeof(e.name) - 1] != '\0' ||
+            (e.encoding == ENCODING_RAW ? e.size != e.rawSize || e.offset % 4 != 0 : e.encoding != ENCODING_RLE)) {
+            DEBUG_PRINTF("Asset pack: entry %u is corrupt\n", (unsigned)i);
+            return false;
+        }
+    }
+    uint32_t crc = esp_rom_crc32_le(0, base + sizeof(PackHeader), size - sizeof(PackHeader));
+    if (crc != header->crc) {
+        DEBUG_PRINTF("Asset pack: CRC %08lx, expected %08lx\n", (unsigned long)crc, (unsigned long)header->crc);
+        return false;
+    }
+    return true;
+}
+
+bool assetPackBegin() {
+    if (stats.mapped) return true;
+    const esp_partition_t* partition =
+        esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, PARTITION_LABEL);
+    if (!partition) {
+        DEBUG_PRINTLN("Asset pack: no \"assets\" partition, images will not be drawn");
+        return false;
+    }
+    stats.partitionBytes = partition->size;
+
+    // Only the pack is mapped, not the whole partition (MMU pages of 64 KB)
+    PackHeader header;
+    if (esp_partition_read(partition, 0, &header, sizeof(header)) != ESP_OK || header.magic != PACK_MAGIC ||
+        header.version != PACK_VERSION) {
+        DEBUG_PRINTLN("Asset pack: no pack in the partition (flash assets/assets.bin)");
+        return false;
+    }
+    if (header.size < sizeof(PackHeader) || header.size > partition->size) {
+        DEBUG_PRINTLN("Asset pack: size out of range");
+        return false;
+    }
+    const void* mapped = nullptr;
+    spi_flash_mmap_handle_t handle;
+    if (esp_partition_mmap(partition, 0, header.size, SPI_FLASH_MMAP_DATA, &mapped, &handle) != ESP_OK) {
+        DEBUG_PRINTLN("Asset pack: mapping the partition failed");
+        return false;
+    }
+    uint32_t startUs = micros();
+    if (!verifyPack((const uint8_t*)mapped, header.size)) {
+        spi_flash_munmap(handle);
+        return false;
+    }
+    // The mapping stays for the lifetime of the firmware
+    pack = (const uint8_t*)mapped;
+    entries = (const PackEntry*)(pack + sizeof(PackHeader));
+    stats.images = header.count;
+    stats.packBytes = header.size;
+    stats.mapped = true;
+
+    lv_img_decoder_t* decoder = lv_img_decoder_create();
+    if (decoder) {
+        lv_img_decoder_set_info_cb(decoder, packInfo);
+        lv_img_decoder_set_open_cb(decoder, packOpen);
+        lv_img_decoder_set_close_cb(decoder, packClose);
+    }
+    DEBUG_PRINTF("Asset pack: %u images, %lu bytes, verified in %lu us\n", (unsigned)stats.images,
+                 (unsigned long)stats.packBytes, (unsigned long)(micros() - startUs));
+    return decoder != nullptr;
+}
+
+AssetPackStats getAssetPackStats() {
+    return stats;
+}
+
+void printAssetPack(Print& out) {
+    if (!stats.mapped) {
+        out.println("Asset pack: not mapped");
+        return;
+    }
+    out.printf("Asset pack: %u images, %lu of %lu partition bytes\n", (unsigned)stats.images,
+               (unsigned long)stats.packBytes, (unsigned long)stats.partitionBytes);
+    for (uint16_t i = 0; i < stats.images; i++) {
+        const PackEntry& e = entries[i];
+        out.printf("  %-28s %3ux%-3u %6lu bytes %s\n", e.name, (unsigned)e.w, (unsigned)e.h,
+                   (unsigned long)e.size, e.encoding == ENCODING_RLE ? "rle" : "raw (mapped)");
+    }
+    out.printf("  opens %lu (rle %lu), expanded %lu bytes, failures %lu\n", (unsigned long)stats.opens,
+               (unsigned long)stats.expansions, (unsigned long)stats.expandedBytes, (unsigned long)stats.failures);
+}
+
+#endif // !HEADLESS
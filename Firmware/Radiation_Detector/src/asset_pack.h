@@ -0,0 +1,43 @@
+#ifndef ASSET_PACK_H
+#define ASSET_PACK_H
+
+#include <Arduino.h>
+
+// Images in the "assets" flash partition (partitions.csv), built by
+// tools/pack_assets.py from the SquareLine exports in assets/images.
+// The partition is memory-mapped once. The lv_img_dsc_t symbols the screens
+// use are placeholders (src/ui_img_assets.c: cf LV_IMG_CF_USER_ENCODED_0, data
+// = entry name) that an LVGL image decoder resolves to the mapped pixels, which
+// LVGL then reads in place. Run-length encoded entries (the large, mostly flat
+// images) are expanded into PSRAM when opened and stay in LVGL's image cache.
+// The pack carries its own CRC and can be flashed without rebuilding the app as
+// long as the entry names and sizes still match the placeholders.
+//
+// Layout (little-endian): a 16-byte header {"LVAP", u16 version, u16 count,
+// u32 total size, u32 CRC-32 of everything after the header}, count 52-byte
+// entries {char name[32], u16 w, u16 h, u8 lv_img_cf_t, u8 encoding,
+// u16 reserved, u32 offset, u32 stored size, u32 pixel size}, then the data,
+// 4-byte aligned. RLE packets are a control byte and pixels: 0x80 | (n - 1)
+// before one pixel repeated n times, n - 1 before n literal pixels.
+
+struct AssetPackStats {
+    bool mapped;            ///< Partition found, mapped and verified
+    uint16_t images;
+    uint32_t packBytes;
+    uint32_t partitionBytes;
+    uint32_t opens;         ///< Decoder opens (LVGL image cache misses)
+    uint32_t expansions;    ///< Opens of RLE entries
+    uint32_t expandedBytes; ///< PSRAM held by open RLE entries
+    uint32_t failures;      ///< Unknown names, corrupt entries, out of memory
+};
+
+// Maps and verifies the partition and registers the decoder. Call after
+// lv_init() and before any screen is built (lv_img_set_src() asks for sizes).
+// @return false if the partition is missing or the pack is invalid
+bool assetPackBegin();
+
+AssetPackStats getAssetPackStats();
+
+void printAssetPack(Print& out);
+
+#endif // ASSET_PACK_H
@@ -0,0 +1,70 @@
+/**
+ * @file background_store.cpp
+ * @brief The last session's background rate in NVS, saved by a background job.
+ *
+ * The record is one blob; NVS checks its integrity and a blob of the wrong
+ * size (another firmware's layout) is ignored.
+ */
+
+#include "background_store.h"
+#include "debug.h"
+#include "job_wheel.h"
+#include <Preferences.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+static const char* BACKGROUND_NAMESPACE = "background";
+static const char* RECORD_KEY = "record";
+
+static BackgroundCollect collectRecord = nullptr;
+static SemaphoreHandle_t saveMutex = nullptr;
+static BackgroundStoreStats stats;
+
+bool backgroundStoreLoad(BackgroundRecord& out) {
+    Preferences prefs;
+    if (!prefs.begin(BACKGROUND_NAMESPACE, true)) return false;
+    bool found = prefs.getBytesLength(RECORD_KEY) == sizeof(out) &&
+                 prefs.getBytes(RECORD_KEY, &out, sizeof(out)) == sizeof(out);
+    prefs.end();
+    stats.loaded = found && out.cps > 0.0f;
+    return stats.loaded;
+}
+
+bool backgroundStoreSave() {
+    if (!collectRecord) return false;
+    BackgroundRecord record;
+    memset(&record, 0, sizeof(record));
+    if (!collectRecord(record) || record.seconds < BACKGROUND_MIN_SESSION_S || !(record.cps > 0.0f)) {
+        stats.skipped++;
+        return false;
+    }
+    xSemaphoreTake(saveMutex, portMAX_DELAY);
+    Preferences prefs;
+    bool saved = prefs.begin(BACKGROUND_NAMESPACE, false) &&
+                 prefs.putBytes(RECORD_KEY, &record, sizeof(record)) == sizeof(record);
+    prefs.end();
+    if (saved) {
+        stats.writes++;
+        stats.lastWriteMs = millis();
+    }
+    xSemaphoreGive(saveMutex);
+    if (!saved) DEBUG_PRINTLN("Background store: NVS write failed");
+    return saved;
+}
+
+static void backgroundSaveJob(void* arg) {
+    backgroundStoreSave();
+}
+
+bool initBackgroundStore(BackgroundCollect collect) {
+    if (saveMutex) return true;
+    saveMutex = xSemaphoreCreateMutex();
+    if (!saveMutex) return false;
+    collectRecord = collect;
+    return jobWheelAdd("background", BACKGROUND_SAVE_INTERVAL_S * 1000UL, BACKGROUND_SAVE_INTERVAL_S * 1000UL,
+                       backgroundSaveJob, nullptr);
+}
+
+BackgroundStoreStats getBackgroundStoreStats() {
+    return stats;
+}
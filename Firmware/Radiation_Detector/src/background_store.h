@@ -0,0 +1,44 @@
+#ifndef BACKGROUND_STORE_H
+#define BACKGROUND_STORE_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// The background rate of the last session, kept in NVS (namespace
+// "background") to seed the rate prior at the next boot (rate_prior.h).
+// A background job (job_wheel.h) saves the session's 1-hour average rate
+// every BACKGROUND_SAVE_INTERVAL_S once the session has counted for
+// BACKGROUND_MIN_SESSION_S; shorter sessions leave the saved record alone,
+// so switching the unit on and off keeps the prior of the last real session.
+// Nothing is saved while the caller reports the rate as not background (an
+// alarm, injected pulses).
+
+struct BackgroundRecord {
+    float cps;              ///< Raw counts per second
+    float sigmaCps;         ///< Count-statistics 1-sigma of cps
+    uint32_t seconds;       ///< Session time behind it
+    int64_t utcMs;          ///< When it was saved, 0 if unknown
+};
+
+// Fills @p record with the rate to save; false if it is not background now.
+typedef bool (*BackgroundCollect)(BackgroundRecord& record);
+
+struct BackgroundStoreStats {
+    bool loaded;            ///< A record was found at boot
+    uint32_t writes;
+    uint32_t skipped;       ///< Saves skipped: too short a session, or not background
+    uint32_t lastWriteMs;
+};
+
+// Reads the saved record. Call once in setup(); false if none is stored.
+bool backgroundStoreLoad(BackgroundRecord& out);
+
+// Adds the periodic save; after initJobWheel().
+bool initBackgroundStore(BackgroundCollect collect);
+
+// Collects and saves now (before logger sleep). @return false if skipped
+bool backgroundStoreSave();
+
+BackgroundStoreStats getBackgroundStoreStats();
+
+#endif // BACKGROUND_STORE_H
@@ -0,0 +1,99 @@
+#ifndef BATTERY_MODEL_H
+#define BATTERY_MODEL_H
+
+#include <math.h>
+#include <stdint.h>
+#include "ring_history.h"
+
+// Single-cell Li-Po state of charge and runtime estimation.
+// The state of charge comes from a piecewise-linear open-circuit discharge
+// curve; the device draws a few tens of mA, so the voltage under load stays
+// close to it. The runtime is the state of charge over the discharge rate,
+// which is the least-squares slope of the per-minute state of charge: it follows
+// the real load (display on or off, WiFi) instead of an assumed current.
+// No Arduino dependencies (host-compilable).
+
+struct BatteryCurvePoint {
+    float volts;
+    float percent;
+};
+
+// Typical 1C-rated Li-Po cell at low discharge rates, highest voltage first
+static const BatteryCurvePoint BATTERY_CURVE[] = {
+    {4.20f, 100.0f}, {4.10f, 90.0f}, {4.00f, 79.0f}, {3.92f, 68.0f}, {3.86f, 58.0f},
+    {3.81f, 48.0f},  {3.78f, 38.0f}, {3.75f, 28.0f}, {3.71f, 18.0f}, {3.66f, 10.0f},
+    {3.58f, 5.0f},   {3.45f, 2.0f},  {3.30f, 0.0f}
+};
+static const uint8_t BATTERY_CURVE_POINTS = sizeof(BATTERY_CURVE) / sizeof(BATTERY_CURVE[0]);
+
+/**
+ * @brief State of charge in percent for a cell voltage, clamped to 0-100.
+ */
+inline float batteryPercentFromVoltage(float volts) {
+    if (volts >= BATTERY_CURVE[0].volts) return 100.0f;
+    for (uint8_t i = 1; i < BATTERY_CURVE_POINTS; i++) {
+        const BatteryCurvePoint& low = BATTERY_CURVE[i];
+        if (volts >= low.volts) {
+            const BatteryCurvePoint& high = BATTERY_CURVE[i - 1];
+            return low.percent + (volts - low.volts) * (high.percent - low.percent) / (high.volts - low.volts);
+        }
+    }
+    return 0.0f;
+}
+
+class BatteryRuntimeEstimator {
+public:
+    static const size_t TREND_MINUTES = 120;      ///< Longest slope window
+    static const size_t MIN_TREND_MINUTES = 10;   ///< Slope needs at least this many samples
+    static constexpr float JUMP_PERCENT = 3.0f;   ///< A step this large restarts the trend (plugged in / out)
+    static constexpr float IDLE_PCT_PER_HOUR = 0.05f; ///< Slopes within this band count as flat
+
+    BatteryRuntimeEstimator() { clear(); }
+
+    void clear() { history_.clear(); }
+
+    /// Adds the state of charge sampled once per minute.
+    void addMinute(float percent) {
+        if (!history_.empty() && fabsf(percent - history_.newest()) >= JUMP_PERCENT) history_.clear();
+        history_.push(percent);
+    }
+
+    size_t minutes() const { return history_.size(); }
+
+    /**
+     * @brief Least-squares slope of the state of charge in %/h; 0 without enough samples.
+     */
+    float slopePctPerHour() const {
+        size_t n = history_.size();
+        if (n < MIN_TREND_MINUTES) return 0.0f;
+        // x = 0..n-1 minutes: mean and spread of x have closed forms
+        float meanX = (n - 1) * 0.5f;
+        float meanY = 0.0f;
+        for (size_t i = 0; i < n; i++) meanY += history_[i];
+        meanY /= n;
+        float sxy = 0.0f;
+        float sxx = 0.0f;
+        for (size_t i = 0; i < n; i++) {
+            float dx = i - meanX;
+            sxy += dx * (history_[i] - meanY);
+            sxx += dx * dx;
+        }
+        return sxx > 0.0f ? sxy / sxx * 60.0f : 0.0f;
+    }
+
+    bool trendKnown() const { return history_.size() >= MIN_TREND_MINUTES; }
+
+    /**
+     * @brief Hours until empty at the current discharge rate; < 0 if not discharging.
+     */
+    float runtimeHours(float percent) const {
+        float slope = slopePctPerHour();
+        if (!trendKnown() || slope > -IDLE_PCT_PER_HOUR) return -1.0f;
+        return percent / -slope;
+    }
+
+private:
+    RingHistory<float, TREND_MINUTES> history_;
+};
+
+#endif // BATTERY_MODEL_H
@@ -0,0 +1,189 @@
+/**
+ * @file battery_monitor.cpp
+ * @brief Oversampled, calibrated battery divider reader and runtime estimator.
+ *
+ * The sampling job (job_wheel.h) is the only writer of the filter and the
+ * estimator; it publishes a BatteryStatus after every sample. Oversampling averages the ADC's
+ * white noise, the exponential filter (time constant BATTERY_FILTER_SECONDS)
+ * the load steps when the display or the radio switch on and off.
+ */
+
+#include "battery_monitor.h"
+#include "battery_model.h"
+#include "seqlock.h"
+#include "debug.h"
+#include "job_wheel.h"
+#include "driver/adc.h"
+#include "esp_adc_cal.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+static const uint32_t ADC_DEFAULT_VREF_MV = 1100;  ///< Only used without eFuse calibration
+static const float ABSENT_VOLTS = 2.5f;            ///< Below this no cell is connected
+static const uint8_t ADC2_READ_RETRIES = 3;
+
+static SeqLock<BatteryStatus> statusLock;
+static esp_adc_cal_characteristics_t adcChars;
+static bool useAdc2 = false;
+static int adcChannel = -1;
+static bool started = false;
+
+/**
+ * @brief Maps an ESP32-S3 GPIO to its ADC unit and channel; false if it has none.
+ */
+static bool gpioToAdc(int pin, bool* adc2, int* channel) {
+    if (pin >= 1 && pin <= 10) {
+        *adc2 = false;
+        *channel = pin - 1;
+        return true;
+    }
+    if (pin >= 11 && pin <= 20) {
+        *adc2 = true;
+        *channel = pin - 11;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief One raw conversion; false if ADC2 stayed busy with the radio.
+ */
+static bool readRaw(int* raw) {
+    if (!useAdc2) {
+        *raw = adc1_get_raw((adc1_channel_t)adcChannel);
+        return *raw >= 0;
+    }
+    for (uint8_t attempt = 0; attempt < ADC2_READ_RETRIES; attempt++) {
+        if (adc2_get_raw((adc2_channel_t)adcChannel, ADC_WIDTH_BIT_12, raw) == ESP_OK) return true;
+        vTaskDelay(1);
+    }
+    return false;
+}
+
+// Sampling job only
+static BatteryRuntimeEstimator estimator;
+static BatteryStatus sampled;
+static bool filterPrimed = false;
+static float alpha = 1.0f;
+static uint32_t samplesPerMinute = 1;
+
+/**
+ * @brief Sampling job: oversample, calibrate, filter, estimate, publish.
+ */
+static void batterySampleJob(void* parameter) {
+    BatteryStatus& status = sampled;
+
+    uint32_t sum = 0;
+    uint16_t good = 0;
+    for (uint16_t i = 0; i < BATTERY_OVERSAMPLE; i++) {
+        int raw;
+        if (readRaw(&raw)) {
+            sum += (uint32_t)raw;
+            good++;
+        } else {
+            status.adcErrors++;
+        }
+    }
+
+    if (good > 0) {
+        uint32_t millivolts = esp_adc_cal_raw_to_voltage((sum + good / 2) / good, &adcChars);
+        float volts = millivolts / 1000.0f * BATTERY_DIVIDER_RATIO;
+        status.volts = filterPrimed ? status.volts + alpha * (volts - status.volts) : volts;
+        filterPrimed = true;
+        status.samples++;
+
+        if (status.volts < ABSENT_VOLTS) {
+            status.state = BATTERY_STATE_ABSENT;
+            status.level = BATTERY_LEVEL_OK;
+            status.percent = 0.0f;
+            status.pctPerHour = 0.0f;
+            status.runtimeHours = -1.0f;
+            estimator.clear();
+        } else {
+            status.percent = batteryPercentFromVoltage(status.volts);
+            if (status.samples % samplesPerMinute == 0) estimator.addMinute(status.percent);
+            status.pctPerHour = estimator.slopePctPerHour();
+            status.runtimeHours = estimator.runtimeHours(status.percent);
+            if (!estimator.trendKnown()) {
+                status.state = BATTERY_STATE_UNKNOWN;
+            } else if (status.runtimeHours >= 0.0f) {
+                status.state = BATTERY_STATE_DISCHARGING;
+            } else if (status.pctPerHour > BatteryRuntimeEstimator::IDLE_PCT_PER_HOUR) {
+                status.state = BATTERY_STATE_CHARGING;
+            } else {
+                status.state = BATTERY_STATE_IDLE;
+            }
+            status.level = status.percent <= BATTERY_CRITICAL_PERCENT ? BATTERY_LEVEL_CRITICAL
+                         : status.percent <= BATTERY_LOW_PERCENT      ? BATTERY_LEVEL_LOW
+                                                                      : BATTERY_LEVEL_OK;
+        }
+        statusLock.publish(status);
+    } else {
+        statusLock.publish(status); // Keep the error count visible
+    }
+}
+
+bool initBatteryMonitor() {
+    if (started) return true;
+    BatteryStatus status;
+    memset(&status, 0, sizeof(status));
+    status.state = BATTERY_STATE_NOT_CONFIGURED;
+    status.runtimeHours = -1.0f;
+    statusLock.publish(status);
+
+    if (BATTERY_ADC_PIN < 0) return false;
+    if (!gpioToAdc(BATTERY_ADC_PIN, &useAdc2, &adcChannel)) {
+        DEBUG_PRINTF("Battery: GPIO %d has no ADC channel\n", BATTERY_ADC_PIN);
+        return false;
+    }
+    if (!useAdc2 && SPECTRUM_ENABLED) {
+        DEBUG_PRINTLN("Battery: ADC1 is in continuous mode for the spectrum, use an ADC2 pin");
+        return false;
+    }
+
+    adc_unit_t unit = useAdc2 ? ADC_UNIT_2 : ADC_UNIT_1;
+    if (useAdc2) {
+        adc2_config_channel_atten((adc2_channel_t)adcChannel, ADC_ATTEN_DB_11);
+    } else {
+        adc1_config_width(ADC_WIDTH_BIT_12);
+        adc1_config_channel_atten((adc1_channel_t)adcChannel, ADC_ATTEN_DB_11);
+    }
+    esp_adc_cal_value_t source = esp_adc_cal_characterize(unit, ADC_ATTEN_DB_11, ADC_WIDTH_BIT_12,
+                                                          ADC_DEFAULT_VREF_MV, &adcChars);
+    DEBUG_PRINTF("Battery: ADC%d channel %d, calibration %s\n", useAdc2 ? 2 : 1, adcChannel,
+                 source == ESP_ADC_CAL_VAL_EFUSE_TP ? "eFuse two-point" : "default");
+
+    sampled = status;
+    alpha = (float)BATTERY_SAMPLE_INTERVAL_MS / (BATTERY_FILTER_SECONDS * 1000.0f);
+    if (alpha > 1.0f) alpha = 1.0f;
+    samplesPerMinute = 60000UL / BATTERY_SAMPLE_INTERVAL_MS;
+    if (samplesPerMinute == 0) samplesPerMinute = 1;
+    started = jobWheelAdd("battery", BATTERY_SAMPLE_INTERVAL_MS, 0, batterySampleJob, NULL);
+    return started;
+}
+
+BatteryStatus getBatteryStatus() {
+    BatteryStatus status;
+    memset(&status, 0, sizeof(status));
+    status.runtimeHours = -1.0f;
+    statusLock.read(status);
+    return status;
+}
+
+const char* batteryStateName(uint8_t state) {
+    static const char* NAMES[] = {"not configured", "absent", "unknown", "discharging", "charging", "idle"};
+    return state <= BATTERY_STATE_IDLE ? NAMES[state] : "?";
+}
+
+void printBatteryStatus(Print& out) {
+    BatteryStatus status = getBatteryStatus();
+    out.printf("Battery: %s", batteryStateName(status.state));
+    if (status.state >= BATTERY_STATE_UNKNOWN) {
+        out.printf(", %.3f V, %.0f%%, %+.2f %%/h", status.volts, status.percent, status.pctPerHour);
+        if (status.runtimeHours >= 0.0f) out.printf(", %.1f h left", status.runtimeHours);
+        if (status.level == BATTERY_LEVEL_CRITICAL) out.print(" (CRITICAL)");
+        else if (status.level == BATTERY_LEVEL_LOW) out.print(" (LOW)");
+    }
+    out.printf("\n  %lu samples, %lu ADC reads refused\n", (unsigned long)status.samples,
+               (unsigned long)status.adcErrors);
+}
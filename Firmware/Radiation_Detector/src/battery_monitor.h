@@ -0,0 +1,55 @@
+#ifndef BATTERY_MONITOR_H
+#define BATTERY_MONITOR_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Battery voltage, state of charge and remaining runtime.
+// A background job (job_wheel.h) samples the divider on BATTERY_ADC_PIN every
+// BATTERY_SAMPLE_INTERVAL_MS: BATTERY_OVERSAMPLE raw reads are averaged,
+// converted with the eFuse calibration (esp_adc_cal) and smoothed by an
+// exponential filter. The state of charge and the runtime come from
+// battery_model.h. The status is published through a SeqLock for any task.
+//
+// ADC1 runs in continuous mode for the spectrum probe, so with the spectrum
+// enabled the divider must be on an ADC2 pin (GPIO 11-20). ADC2 reads can be
+// refused while the WiFi radio holds the ADC; those reads are retried.
+
+enum BatteryState {
+    BATTERY_STATE_NOT_CONFIGURED = 0, ///< No BATTERY_ADC_PIN or the ADC could not be set up
+    BATTERY_STATE_ABSENT,             ///< Divider reads near 0 V (USB power only)
+    BATTERY_STATE_UNKNOWN,            ///< Not enough trend yet
+    BATTERY_STATE_DISCHARGING,
+    BATTERY_STATE_CHARGING,
+    BATTERY_STATE_IDLE                ///< Flat trend (charged and on USB)
+};
+
+enum BatteryLevel {
+    BATTERY_LEVEL_OK = 0,
+    BATTERY_LEVEL_LOW,
+    BATTERY_LEVEL_CRITICAL
+};
+
+struct BatteryStatus {
+    uint8_t state;           ///< BatteryState
+    uint8_t level;           ///< BatteryLevel
+    float volts;             ///< Filtered cell voltage
+    float percent;           ///< State of charge 0-100
+    float pctPerHour;        ///< Trend of the state of charge (negative while discharging)
+    float runtimeHours;      ///< Remaining runtime, < 0 if unknown or not discharging
+    uint32_t samples;        ///< Filter updates since boot
+    uint32_t adcErrors;      ///< Raw reads refused by the ADC (ADC2/WiFi arbitration)
+};
+
+// Configures the ADC and adds the sampling job; after initJobWheel(). False
+// (and state NOT_CONFIGURED) if no pin is set or the pin cannot be used.
+bool initBatteryMonitor();
+
+// Latest status (any task).
+BatteryStatus getBatteryStatus();
+
+const char* batteryStateName(uint8_t state);
+
+void printBatteryStatus(Print& out);
+
+#endif // BATTERY_MONITOR_H
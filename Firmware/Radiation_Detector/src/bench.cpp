@@ -0,0 +1,118 @@
+/**
+ * @file bench.cpp
+ * @brief Cycle-counter benchmark harness and report formatting.
+ *
+ * Runs are timed one by one with ESP.getCycleCount() (wraps after ~17 s at
+ * 240 MHz, far longer than any case), so min/max show preemption by other tasks
+ * on the same core while the mean stays comparable between builds. The report
+ * is published through a SeqLock: the UI task writes it, the web task reads it.
+ */
+
+#include "bench.h"
+#include "seqlock.h"
+#include "time_base.h"
+#include "json_arena.h"
+#include <ArduinoJson.h>
+
+static BenchReport building;          ///< Report being filled by benchRun()
+static SeqLock<BenchReport> reportLock;
+
+/**
+ * @brief Converts cycles to microseconds at the clock the report was taken at.
+ */
+static float cyclesToUs(uint32_t cycles, uint32_t cpuMhz) {
+    return cpuMhz ? (float)cycles / (float)cpuMhz : 0.0f;
+}
+
+/**
+ * @brief Throughput of a case from its mean run time; 0 for non-throughput cases.
+ */
+static float throughputMBps(const BenchResult& result, uint32_t cpuMhz) {
+    float us = cyclesToUs(result.meanCycles, cpuMhz);
+    return (result.bytes && us > 0.0f) ? (float)result.bytes / us : 0.0f; // bytes/µs == MB/s
+}
+
+void benchBegin() {
+    memset(&building, 0, sizeof(building));
+    building.cpuMhz = getCpuFrequencyMhz();
+}
+
+bool benchRun(const char* name, BenchFunction fn, void* arg, uint16_t runs, uint32_t bytesPerRun) {
+    if (building.count >= BENCH_MAX_CASES || runs == 0) return false;
+    BenchResult& result = building.results[building.count++];
+    strlcpy(result.name, name, sizeof(result.name));
+    result.runs = runs;
+    result.bytes = bytesPerRun;
+    result.minCycles = UINT32_MAX;
+
+    uint64_t total = 0;
+    for (uint16_t i = 0; i < runs; i++) {
+        uint32_t start = ESP.getCycleCount();
+        fn(arg);
+        uint32_t cycles = ESP.getCycleCount() - start;
+        total += cycles;
+        if (cycles < result.minCycles) result.minCycles = cycles;
+        if (cycles > result.maxCycles) result.maxCycles = cycles;
+        // Keep the task watchdog and the other core's work going between runs
+        vTaskDelay(1);
+    }
+    result.meanCycles = (uint32_t)(total / runs);
+    return true;
+}
+
+void benchEnd() {
+    building.uptimeSeconds = timeBaseSeconds();
+    reportLock.publish(building);
+}
+
+bool getBenchReport(BenchReport& out) {
+    if (reportLock.version() == 0) return false;
+    return reportLock.read(out);
+}
+
+void printBenchReport(const BenchReport& report, Print& out) {
+    out.printf("=== Benchmark (%lu MHz, uptime %lu s) ===\n", (unsigned long)report.cpuMhz,
+               (unsigned long)report.uptimeSeconds);
+    out.printf("%-20s %5s %10s %10s %10s %8s\n", "case", "runs", "min us", "mean us", "max us", "MB/s");
+    for (uint8_t i = 0; i < report.count; i++) {
+        const BenchResult& r = report.results[i];
+        out.printf("%-20s %5u %10.1f %10.1f %10.1f", r.name, r.runs, cyclesToUs(r.minCycles, report.cpuMhz),
+                   cyclesToUs(r.meanCycles, report.cpuMhz), cyclesToUs(r.maxCycles, report.cpuMhz));
+        if (r.bytes) {
+            out.printf(" %8.2f\n", throughputMBps(r, report.cpuMhz));
+        } else {
+            out.printf(" %8s\n", "-");
+        }
+    }
+}
+
+void buildBenchReportJson(const BenchReport& report, JsonDocument& doc) {
+    doc["cpu_mhz"] = report.cpuMhz;
+    doc["uptime_s"] = report.uptimeSeconds;
+    doc["sdk"] = ESP.getSdkVersion();
+    doc["sketch_md5"] = ESP.getSketchMD5(); // Identifies the build being measured
+    JsonArray cases = doc["cases"].to<JsonArray>();
+    for (uint8_t i = 0; i < report.count; i++) {
+        const BenchResult& r = report.results[i];
+        JsonObject c = cases.add<JsonObject>();
+        c["name"] = r.name;
+        c["runs"] = r.runs;
+        c["min_cycles"] = r.minCycles;
+        c["mean_cycles"] = r.meanCycles;
+        c["max_cycles"] = r.maxCycles;
+        c["mean_us"] = cyclesToUs(r.meanCycles, report.cpuMhz);
+        if (r.bytes) {
+            c["bytes"] = r.bytes;
+            c["mb_per_s"] = throughputMBps(r, report.cpuMhz);
+        }
+    }
+}
+
+String getBenchReportJson(const BenchReport& report) {
+    JsonArenaLease lease;
+    JsonDocument doc(lease.allocator());
+    buildBenchReportJson(report, doc);
+    String json;
+    serializeJson(doc, json);
+    return json;
+}
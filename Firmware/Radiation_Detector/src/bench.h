@@ -0,0 +1,51 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+// On-target timing of the firmware's hot paths (serial "bench").
+// Each case runs a fixed number of times under the CPU cycle counter. The last
+// report is kept, so "bench json" and /api/bench can hand it to a host script
+// that compares firmware builds.
+
+static const uint8_t BENCH_MAX_CASES = 24;
+
+struct BenchResult {
+    char name[20];
+    uint16_t runs;
+    uint32_t minCycles;
+    uint32_t meanCycles;
+    uint32_t maxCycles;
+    uint32_t bytes;        ///< Bytes moved per run, 0 if the case is not a throughput test
+};
+
+struct BenchReport {
+    uint8_t count;
+    uint32_t cpuMhz;
+    uint32_t uptimeSeconds; ///< When the report was taken
+    BenchResult results[BENCH_MAX_CASES];
+};
+
+typedef void (*BenchFunction)(void* arg);
+
+// Starts a new report. Cases are then added with benchRun() and the report is
+// published with benchEnd(); all three must be called from the same task.
+void benchBegin();
+
+// Times @p runs calls of fn(arg). Returns false if the report is full.
+bool benchRun(const char* name, BenchFunction fn, void* arg, uint16_t runs, uint32_t bytesPerRun = 0);
+
+void benchEnd();
+
+// Copies the last published report; false if "bench" has not run since boot.
+bool getBenchReport(BenchReport& out);
+
+// Prints @p report as a table (µs and MB/s).
+void printBenchReport(const BenchReport& report, Print& out);
+
+// Fills @p doc with @p report (/api/bench); getBenchReportJson() serialises it.
+void buildBenchReportJson(const BenchReport& report, JsonDocument& doc);
+String getBenchReportJson(const BenchReport& report);
+
+#endif // BENCH_H
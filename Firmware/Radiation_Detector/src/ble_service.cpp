@@ -0,0 +1,382 @@
+/**
+ * @file ble_service.cpp
+ * @brief GATT readout service: batched rate and per-second counts, alarm, history transfer.
+ *
+ * The Bluedroid callbacks run on the BT task and only record the connection
+ * and the history request. The notifications are sent from a task of our own.
+ * It ticks every BLE_IDLE_TICK_MS and reads the snapshots once a second. While
+ * a history transfer runs, it ticks every BLE_TRANSFER_TICK_MS and sends a few
+ * frames per tick, so the controller's buffers never overflow.
+ */
+
+#include "ble_service.h"
+#include "history_api.h"
+#include "mdns_service.h"
+#include "sysinfo.h"
+#include "debug.h"
+#include <Preferences.h>
+
+#if BLE_ENABLED
+#include <BLEDevice.h>
+#include <BLEServer.h>
+#include <BLE2902.h>
+#include <atomic>
+#include "sdkconfig.h"
+#include "esp_gap_ble_api.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+static_assert(sizeof(BleRateRecord) == 28 && sizeof(BleCpsHeader) == 8 && sizeof(BleAlarmRecord) == 12,
+              "BLE record layout is part of the protocol");
+static_assert(sizeof(BleHistoryRequest) == 8 && sizeof(BleHistoryFrameHeader) == 4,
+              "BLE history layout is part of the protocol");
+static_assert(BLE_MTU >= 23 && BLE_MTU <= 517, "ATT MTU range");
+
+static const uint32_t BLE_TASK_STACK       = 6144;
+static const uint32_t BLE_IDLE_TICK_MS     = 250;
+static const uint32_t BLE_TRANSFER_TICK_MS = 20;
+static const uint8_t FRAMES_PER_TICK       = 4;
+static const uint16_t ATT_HEADER = 3;          ///< Opcode and handle in front of a notification
+static const uint16_t DEFAULT_MTU = 23;
+
+// Connection parameters, in the units of the request (1.25 ms, 10 ms for the timeout)
+static const uint16_t IDLE_INTERVAL_MIN = 400;     ///< 500 ms
+static const uint16_t IDLE_INTERVAL_MAX = 800;     ///< 1 s
+static const uint16_t IDLE_LATENCY = 2;
+static const uint16_t FAST_INTERVAL_MIN = 12;      ///< 15 ms
+static const uint16_t FAST_INTERVAL_MAX = 24;      ///< 30 ms
+static const uint16_t SUPERVISION_TIMEOUT = 600;   ///< 6 s, above (1 + latency) * 2 * max interval
+
+static const HistoryStore* bleHistory = nullptr;
+static BleSource readingsSource = nullptr;
+static bool enabled = false;
+static bool started = false;
+
+static BLEServer* server = nullptr;
+static BLECharacteristic* rateChar = nullptr;
+static BLECharacteristic* cpsChar = nullptr;
+static BLECharacteristic* alarmChar = nullptr;
+static BLECharacteristic* historyChar = nullptr;
+
+// Set on the BT task, taken by the BLE task
+static std::atomic<bool> connected(false);
+static std::atomic<bool> paramsPending(false);
+static std::atomic<bool> requestPending(false);
+static portMUX_TYPE requestMux = portMUX_INITIALIZER_UNLOCKED;
+static BleHistoryRequest pendingRequest;
+static uint16_t connId = 0;
+static esp_bd_addr_t peerAddress;
+
+static BleStats stats;
+
+// History transfer, BLE task only
+static bool transferring = false;
+static BleHistoryRequest transfer;
+static size_t transferOffset = 0;
+static uint32_t transferLeft = 0;
+static uint16_t transferSequence = 0;
+
+static uint32_t lastCpsSecond = 0;
+static bool cpsStarted = false;
+static uint32_t lastSnapshotMs = 0;
+static uint32_t lastNotifyMs = 0;
+static BleAlarmRecord lastAlarm;
+
+class ServerCallbacks : public BLEServerCallbacks {
+    void onConnect(BLEServer* s, esp_ble_gatts_cb_param_t* param) override {
+        connId = param->connect.conn_id;
+        memcpy(peerAddress, param->connect.remote_bda, sizeof(peerAddress));
+        connected.store(true);
+        paramsPending.store(true);
+        stats.connections++;
+    }
+
+    void onDisconnect(BLEServer* s) override {
+        connected.store(false);
+        if (enabled) BLEDevice::startAdvertising(); // Bluedroid stops advertising on a connection
+    }
+};
+
+class HistoryCallbacks : public BLECharacteristicCallbacks {
+    void onWrite(BLECharacteristic* characteristic) override {
+        std::string value = characteristic->getValue();
+        if (value.size() < sizeof(BleHistoryRequest)) return;
+        portENTER_CRITICAL(&requestMux);
+        memcpy(&pendingRequest, value.data(), sizeof(pendingRequest));
+        portEXIT_CRITICAL(&requestMux);
+        requestPending.store(true);
+    }
+};
+
+static const uint16_t MAX_PAYLOAD = BLE_MTU - ATT_HEADER;  ///< Frame buffers are sized for the MTU asked for
+
+static uint16_t payloadSize() {
+    uint16_t mtu = stats.mtu > DEFAULT_MTU ? stats.mtu : DEFAULT_MTU;
+    return mtu - ATT_HEADER < MAX_PAYLOAD ? mtu - ATT_HEADER : MAX_PAYLOAD;
+}
+
+static void notify(BLECharacteristic* characteristic, const void* data, size_t length) {
+    characteristic->setValue((uint8_t*)data, length);
+    characteristic->notify();
+    stats.notifications++;
+}
+
+static void requestInterval(bool fast) {
+    server->updateConnParams(peerAddress, fast ? FAST_INTERVAL_MIN : IDLE_INTERVAL_MIN,
+                             fast ? FAST_INTERVAL_MAX : IDLE_INTERVAL_MAX, fast ? 0 : IDLE_LATENCY,
+                             SUPERVISION_TIMEOUT);
+}
+
+/**
+ * @brief Per-second counts closed since the last notification, in as few frames as the MTU allows.
+ */
+static void notifyCps() {
+    uint8_t frame[MAX_PAYLOAD];
+    uint16_t room = (payloadSize() - sizeof(BleCpsHeader)) / sizeof(uint16_t);
+
+    size_t available = bleHistory->count(HISTORY_LEVEL_SECOND);
+    size_t offset = cpsStarted ? bleHistory->findOffset(HISTORY_LEVEL_SECOND, lastCpsSecond + 1)
+                               : (available > BLE_NOTIFY_INTERVAL_S ? available - BLE_NOTIFY_INTERVAL_S : 0);
+    size_t limit = (size_t)room * FRAMES_PER_TICK;
+    if (available > offset + limit) offset = available - limit; // After a long gap only the newest
+
+    HistoryBucket buckets[32];
+    BleCpsHeader* header = (BleCpsHeader*)frame;
+    uint16_t* counts = (uint16_t*)(frame + sizeof(BleCpsHeader));
+    while (offset < available) {
+        header->count = 0;
+        header->reserved = 0;
+        while (header->count < room && offset < available) {
+            size_t want = room - header->count < 32 ? room - header->count : 32;
+            size_t n = bleHistory->read(HISTORY_LEVEL_SECOND, offset, buckets, want);
+            if (n == 0) {
+                offset = available;
+                break;
+            }
+            if (header->count == 0) header->firstSecond = buckets[0].startTime;
+            for (size_t i = 0; i < n; i++) {
+                counts[header->count++] = buckets[i].counts < 0xFFFF ? (uint16_t)buckets[i].counts : 0xFFFF;
+                lastCpsSecond = buckets[i].startTime;
+            }
+            offset += n;
+        }
+        if (header->count == 0) return;
+        cpsStarted = true;
+        notify(cpsChar, frame, sizeof(BleCpsHeader) + header->count * sizeof(uint16_t));
+    }
+}
+
+static void startTransfer(const BleHistoryRequest& request) {
+    transfer = request;
+    if (transfer.level > HISTORY_LEVEL_HOUR) transfer.level = HISTORY_LEVEL_HOUR;
+    HistoryLevel level = (HistoryLevel)transfer.level;
+    transferOffset = transfer.from ? bleHistory->findOffset(level, transfer.from) : 0;
+    size_t available = bleHistory->count(level);
+    transferLeft = transferOffset < available ? available - transferOffset : 0;
+    if (transfer.maxCount && transferLeft > transfer.maxCount) transferLeft = transfer.maxCount;
+    transferSequence = 0;
+    transferring = true;
+    requestInterval(true);
+}
+
+/**
+ * @brief Sends up to FRAMES_PER_TICK frames of the running transfer.
+ */
+static void continueTransfer() {
+    uint8_t frame[MAX_PAYLOAD];
+    uint16_t perFrame = (payloadSize() - sizeof(BleHistoryFrameHeader)) / sizeof(HistoryPackRecord);
+    HistoryBucket buckets[16];
+
+    for (uint8_t f = 0; f < FRAMES_PER_TICK; f++) {
+        BleHistoryFrameHeader* header = (BleHistoryFrameHeader*)frame;
+        HistoryPackRecord* records = (HistoryPackRecord*)(frame + sizeof(BleHistoryFrameHeader));
+        header->sequence = transferSequence++;
+        header->level = transfer.level;
+        header->count = 0;
+        while (header->count < perFrame && transferLeft > 0) {
+            size_t want = perFrame - header->count;
+            if (want > 16) want = 16;
+            if (want > transferLeft) want = transferLeft;
+            size_t n = bleHistory->read((HistoryLevel)transfer.level, transferOffset, buckets, want);
+            if (n == 0) {
+                transferLeft = 0; // The level wrapped under the transfer; end it here
+                break;
+            }
+            for (size_t i = 0; i < n; i++) {
+                HistoryPackRecord& r = records[header->count++];
+                r.startTime = buckets[i].startTime;
+                r.counts = buckets[i].counts;
+                r.minCps = buckets[i].minCps;
+                r.maxCps = buckets[i].maxCps;
+                r.seconds = buckets[i].seconds;
+                r.flags = buckets[i].flags;
+            }
+            transferOffset += n;
+            transferLeft -= n;
+            stats.historyRecords += n;
+        }
+        notify(historyChar, frame, sizeof(BleHistoryFrameHeader) + header->count * sizeof(HistoryPackRecord));
+        if (header->count == 0) { // The end marker went out
+            transferring = false;
+            requestInterval(false);
+            return;
+        }
+    }
+}
+
+static void bleTask(void* parameter) {
+    for (;;) {
+        vTaskDelay(pdMS_TO_TICKS(transferring ? BLE_TRANSFER_TICK_MS : BLE_IDLE_TICK_MS));
+        stats.connected = connected.load();
+        if (!stats.connected) {
+            transferring = false;
+            cpsStarted = false;
+            stats.mtu = DEFAULT_MTU;
+            continue;
+        }
+        stats.mtu = server->getPeerMTU(connId);
+        if (paramsPending.exchange(false)) requestInterval(false);
+
+        if (requestPending.exchange(false)) {
+            BleHistoryRequest request;
+            portENTER_CRITICAL(&requestMux);
+            request = pendingRequest;
+            portEXIT_CRITICAL(&requestMux);
+            startTransfer(request);
+        }
+        if (transferring) {
+            continueTransfer();
+            continue; // The readings wait; the transfer has the link
+        }
+
+        uint32_t nowMs = millis();
+        if (nowMs - lastSnapshotMs < 1000) continue;
+        lastSnapshotMs = nowMs;
+        BleReadings readings;
+        readingsSource(readings);
+        rateChar->setValue((uint8_t*)&readings.rate, sizeof(readings.rate));
+        alarmChar->setValue((uint8_t*)&readings.alarm, sizeof(readings.alarm));
+
+        // Alarm changes at once, everything else batched into one connection event
+        if (readings.alarm.level != lastAlarm.level || readings.alarm.causes != lastAlarm.causes) {
+            lastAlarm = readings.alarm;
+            notify(alarmChar, &readings.alarm, sizeof(readings.alarm));
+        }
+        if (nowMs - lastNotifyMs >= BLE_NOTIFY_INTERVAL_S * 1000UL) {
+            lastNotifyMs = nowMs;
+            notify(rateChar, &readings.rate, sizeof(readings.rate));
+            notifyCps();
+        }
+    }
+}
+
+static BLECharacteristic* addCharacteristic(BLEService* service, const char* uuid, uint32_t properties) {
+    BLECharacteristic* characteristic = service->createCharacteristic(uuid, properties);
+    if (properties & BLECharacteristic::PROPERTY_NOTIFY) characteristic->addDescriptor(new BLE2902());
+    return characteristic;
+}
+
+static bool startStack() {
+    if (started) return true;
+    BLEDevice::init(mdnsHostname());
+    BLEDevice::setMTU(BLE_MTU);
+#if CONFIG_BT_BLE_50_FEATURES_SUPPORTED
+    // Prefer 2M in both directions; the phone may still keep 1M
+    esp_ble_gap_set_prefered_default_phy(ESP_BLE_GAP_PHY_1M_PREF_MASK | ESP_BLE_GAP_PHY_2M_PREF_MASK,
+                                         ESP_BLE_GAP_PHY_1M_PREF_MASK | ESP_BLE_GAP_PHY_2M_PREF_MASK);
+#endif
+    server = BLEDevice::createServer();
+    server->setCallbacks(new ServerCallbacks());
+
+    BLEService* service = server->createService(BLEUUID(BLE_SERVICE_UUID), 16);
+    rateChar = addCharacteristic(service, BLE_RATE_CHAR_UUID,
+                                 BLECharacteristic::PROPERTY_READ | BLECharacteristic::PROPERTY_NOTIFY);
+    cpsChar = addCharacteristic(service, BLE_CPS_CHAR_UUID, BLECharacteristic::PROPERTY_NOTIFY);
+    alarmChar = addCharacteristic(service, BLE_ALARM_CHAR_UUID,
+                                  BLECharacteristic::PROPERTY_READ | BLECharacteristic::PROPERTY_NOTIFY);
+    historyChar = addCharacteristic(service, BLE_HISTORY_CHAR_UUID,
+                                    BLECharacteristic::PROPERTY_WRITE | BLECharacteristic::PROPERTY_NOTIFY);
+    historyChar->setCallbacks(new HistoryCallbacks());
+    service->start();
+
+    BLEAdvertising* advertising = BLEDevice::getAdvertising();
+    advertising->addServiceUUID(BLE_SERVICE_UUID);
+    advertising->setScanResponse(true);
+
+    TaskHandle_t task = nullptr;
+    if (xTaskCreatePinnedToCore(bleTask, "BleTask", BLE_TASK_STACK, NULL, NETWORK_TASK_PRIORITY, &task,
+                                TASK_CORE_NETWORK) != pdPASS) {
+        DEBUG_PRINTLN("Error: BLE task not created");
+        return false;
+    }
+    sysInfoWatchTask(task, BLE_TASK_STACK);
+    started = true;
+    stats.mtu = DEFAULT_MTU;
+    return true;
+}
+
+void initBleService(const HistoryStore& store, BleSource source) {
+    bleHistory = &store;
+    readingsSource = source;
+    Preferences prefs;
+    prefs.begin("ble", true);
+    bool saved = prefs.getBool("enabled", false);
+    prefs.end();
+    if (saved) bleServiceSetEnabled(true);
+}
+
+bool bleServiceSetEnabled(bool on) {
+    if (!bleHistory) return false;
+    Preferences prefs;
+    prefs.begin("ble", false);
+    prefs.putBool("enabled", on);
+    prefs.end();
+
+    if (on) {
+        if (!startStack()) return false;
+        enabled = true;
+        BLEDevice::startAdvertising();
+        DEBUG_PRINTF("BLE: advertising as %s\n", mdnsHostname());
+    } else if (started) {
+        // Bluedroid cannot be brought up again after a deinit, so the stack stays loaded until reboot
+        enabled = false;
+        BLEDevice::getAdvertising()->stop();
+        if (connected.load()) server->disconnect(connId);
+    }
+    stats.running = enabled;
+    return true;
+}
+
+BleStats getBleStats() {
+    return stats;
+}
+
+void printBleService(Print& out) {
+    out.printf("BLE: %s%s", enabled ? "ON" : "OFF", started && !enabled ? " (stack loaded until reboot)" : "");
+    if (enabled) {
+        out.printf(", %s, MTU %u", stats.connected ? "connected" : "advertising", (unsigned)stats.mtu);
+    }
+    out.println();
+    out.printf("  %lu connections, %lu notifications, %lu history records sent\n", (unsigned long)stats.connections,
+               (unsigned long)stats.notifications, (unsigned long)stats.historyRecords);
+}
+
+#else // BLE_ENABLED
+
+void initBleService(const HistoryStore& store, BleSource source) {}
+
+bool bleServiceSetEnabled(bool on) {
+    return false;
+}
+
+BleStats getBleStats() {
+    BleStats stats;
+    memset(&stats, 0, sizeof(stats));
+    return stats;
+}
+
+void printBleService(Print& out) {
+    out.println("BLE: not built (BLE_ENABLED 0)");
+}
+
+#endif // BLE_ENABLED
@@ -0,0 +1,107 @@
+#ifndef BLE_SERVICE_H
+#define BLE_SERVICE_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "history_store.h"
+
+// BLE GATT peripheral for a phone readout nearby, without WiFi.
+// One primary service (BLE_SERVICE_UUID) with four characteristics, all
+// fields little-endian and naturally aligned (sizes checked in ble_service.cpp):
+//
+//   rate     read, notify  BleRateRecord
+//   cps      notify        BleCpsHeader, then `count` uint16_t counts, one per
+//                          second, oldest first (saturated at 65535)
+//   alarm    read, notify  BleAlarmRecord, notified when it changes
+//   history  write, notify write BleHistoryRequest; the buckets come back as
+//                          notifications of BleHistoryFrameHeader and up to
+//                          `count` HistoryPackRecord entries (history_api.h),
+//                          oldest first. A frame with count 0 ends the transfer.
+//
+// The readings come from the same snapshots /api/data is built from
+// (BleSource), so BLE and the dashboard always agree.
+//
+// Low duty cycle: rate and cps are sent together every BLE_NOTIFY_INTERVAL_S
+// in one radio event, and only alarm changes are sent at once. After a
+// connection the peripheral asks for a slow connection interval with
+// slave latency. During a history transfer it asks for a fast one and
+// sends as many MTU-sized notifications per tick as the link takes. It asks
+// for the larger MTU (BLE_MTU) and, where the controller has BLE 5, the 2M
+// PHY; a phone that declines either still gets the same data, only slower.
+//
+// "ble on|off" starts it or stops advertising; the choice is kept in
+// Preferences ("ble" namespace) and applied at boot.
+
+#define BLE_SERVICE_UUID        "7a3f1000-52d4-4a2c-9b1e-0d5241445300"
+#define BLE_RATE_CHAR_UUID      "7a3f1001-52d4-4a2c-9b1e-0d5241445300"
+#define BLE_CPS_CHAR_UUID       "7a3f1002-52d4-4a2c-9b1e-0d5241445300"
+#define BLE_ALARM_CHAR_UUID     "7a3f1003-52d4-4a2c-9b1e-0d5241445300"
+#define BLE_HISTORY_CHAR_UUID   "7a3f1004-52d4-4a2c-9b1e-0d5241445300"
+
+struct BleRateRecord {
+    uint32_t timestamp;     ///< UTC seconds, 0 before the time base has it
+    float currentUsvH;
+    float currentSigma;     ///< Count statistics, 1-sigma
+    float averageUsvH;
+    float cumulativeMsv;
+    float cpm;              ///< Dead-time corrected
+    uint32_t totalCounts;   ///< Since boot
+};
+
+struct BleCpsHeader {
+    uint32_t firstSecond;   ///< Start time of the first count (history store time base)
+    uint16_t count;
+    uint16_t reserved;
+};
+
+struct BleAlarmRecord {
+    uint8_t level;          ///< AlarmLevel
+    uint8_t causes;         ///< AlarmCause bits
+    uint16_t reserved;
+    float rateUpperUsvH;    ///< Upper confidence bound of the alarm rate
+    float secondsToDoseAlarm; ///< < 0 if not approaching
+};
+
+struct BleHistoryRequest {
+    uint32_t from;          ///< Oldest start time wanted (0: all retained)
+    uint16_t maxCount;      ///< 0: no limit
+    uint8_t level;          ///< HistoryLevel
+    uint8_t reserved;
+};
+
+struct BleHistoryFrameHeader {
+    uint16_t sequence;      ///< From 0 for each transfer
+    uint8_t count;          ///< Records in this frame; 0 ends the transfer
+    uint8_t level;
+};
+
+// Snapshot the main loop copies the readings from (any task).
+struct BleReadings {
+    BleRateRecord rate;
+    BleAlarmRecord alarm;
+};
+
+typedef void (*BleSource)(BleReadings& out);
+
+struct BleStats {
+    bool running;           ///< Stack up and advertising or connected
+    bool connected;
+    uint16_t mtu;           ///< Negotiated; 23 until the phone asks for more
+    uint32_t connections;   ///< Since boot
+    uint32_t notifications; ///< Since boot
+    uint32_t historyRecords; ///< Sent in history transfers since boot
+};
+
+// Stores the source and starts the service if Preferences say so. Call in
+// setup() once the history store is allocated.
+void initBleService(const HistoryStore& store, BleSource source);
+
+// Starts the stack (on) or stops advertising and drops the connection (off).
+// Saved to Preferences. UI task.
+bool bleServiceSetEnabled(bool enabled);
+
+BleStats getBleStats();
+
+void printBleService(Print& out);
+
+#endif // BLE_SERVICE_H
@@ -0,0 +1,508 @@
+/**
+ * @file blend_rgb565.cpp
+ * @brief Word-wide RGB565 fill blending for LVGL's software renderer.
+ *
+ * fill_normal() in lv_draw_sw_blend.c mixes a semi-transparent fill one
+ * 16-bit pixel at a time and re-mixes whenever the destination pixel differs
+ * from the previous one. Here the destination is read and written as 32-bit
+ * words (two pixels), and the mixed result of the last word is reused while
+ * the words repeat, which is the common case for panels over flat
+ * backgrounds. Mask bytes are read four at a time so that fully transparent
+ * and fully covering runs skip the per-pixel mask handling.
+ *
+ * The per-pixel mixes are the same calls with the same rounding as LVGL's
+ * (lv_color_mix_premult() with the opacity rounded to the 16-bit mixer's
+ * 5-bit steps, lv_color_mix() under a mask), including the black seed colour
+ * of fill_normal()'s cache, so both paths give identical pixels.
+ *
+ * The PIE version of the unmasked fill computes lv_color_mix_premult() on
+ * eight pixels per pass: the channels are split with masks and shifts
+ * (EE.VMUL.U16 by one, shifted right by SAR), multiplied by the inverse
+ * opacity, added to the premultiplied colour and divided by 255 as
+ * (t + 1 + (t >> 8)) >> 8, which equals LV_UDIV255() for every sum of a 6-bit
+ * channel. No intermediate exceeds 16 bits. Each asm block loads every q
+ * register it uses, as pulse_kernel.cpp does, and the vector path only runs
+ * on TASK_CORE_UI: the render split worker on the other core shares that core
+ * with the PIE pulse kernel, so it keeps to the word path.
+ */
+
+#include "config.h"
+
+#if !HEADLESS
+
+#include "blend_rgb565.h"
+#include "config.h"
+#include <src/draw/sw/lv_draw_sw.h> // lv_draw_sw_ctx_t and the scalar blend, not exported by lvgl.h
+#include <stdlib.h>
+
+#if LV_COLOR_DEPTH != 16 || LV_COLOR_16_SWAP != 0 || LV_COLOR_MIX_ROUND_OFS != 0
+#error "blend_rgb565 expects native RGB565 (LV_COLOR_DEPTH 16, LV_COLOR_16_SWAP 0, LV_COLOR_MIX_ROUND_OFS 0)"
+#endif
+
+static bool enabled = true;
+static bool pieEnabled = true; ///< Cleared by the self-test to time the word path
+
+/**
+ * @brief Unmasked opacity mix with fill_normal()'s single-pixel cache.
+ */
+struct OpaMixer {
+    uint16_t premult[3];
+    lv_opa_t opaInv;
+    uint16_t lastDest;
+    uint16_t lastRes;
+    bool seeded; ///< lastRes is still the black seed computed with lv_color_mix()
+
+    OpaMixer(lv_color_t color, lv_opa_t opa) {
+        lastDest = lv_color_black().full;
+        lastRes = lv_color_mix(color, lv_color_black(), opa).full;
+        seeded = true;
+        opa = (lv_opa_t)((((uint32_t)opa + 4) >> 3) << 3); // The 16-bit lv_color_mix() rounding
+        lv_color_premult(color, opa, premult);
+        opaInv = 255 - opa;
+    }
+
+    uint16_t mix(uint16_t dest) {
+        if (dest != lastDest) {
+            lv_color_t c;
+            c.full = dest;
+            lastDest = dest;
+            lastRes = lv_color_mix_premult(premult, c, opaInv).full;
+            seeded = false;
+        }
+        return lastRes;
+    }
+};
+
+#if RGB565_BLEND_PIE
+
+enum PieLane {
+    PIE_BLUE_MASK = 0,
+    PIE_OPA_INV,
+    PIE_PREMULT_BLUE,
+    PIE_ONE,
+    PIE_GREEN_MASK,
+    PIE_PREMULT_GREEN,
+    PIE_PREMULT_RED,
+    PIE_GREEN_SHIFT,
+    PIE_RED_SHIFT,
+    PIE_LANE_COUNT
+};
+
+/**
+ * @brief Mixes @p vectors runs of eight pixels at @p p (16-byte aligned) with
+ *        the constants in @p lanes, eight copies each in PieLane order.
+ */
+static void mixVectorsPie(uint16_t* p, int32_t vectors, const uint16_t* lanes) {
+    for (int32_t v = 0; v < vectors; v++) {
+        const uint16_t* c = lanes;
+        __asm__ __volatile__(
+            "ee.vld.128.ip q0, %[p], 0\n"
+            "ee.vld.128.ip q1, %[c], 16\n"     // Blue mask
+            "ee.andq q2, q0, q1\n"
+            "ee.vld.128.ip q3, %[c], 16\n"     // Inverse opacity
+            "ssai 0\n"
+            "ee.vmul.u16 q2, q2, q3\n"
+            "ee.vld.128.ip q1, %[c], 16\n"     // Premultiplied blue
+            "ee.vadds.s16 q2, q2, q1\n"
+            "ee.vld.128.ip q4, %[c], 16\n"     // Ones
+            "ssai 5\n"
+            "ee.vmul.u16 q5, q0, q4\n"
+            "ee.vld.128.ip q1, %[c], 16\n"     // Green mask
+            "ee.andq q5, q5, q1\n"
+            "ssai 0\n"
+            "ee.vmul.u16 q5, q5, q3\n"
+            "ee.vld.128.ip q1, %[c], 16\n"     // Premultiplied green
+            "ee.vadds.s16 q5, q5, q1\n"
+            "ssai 11\n"
+            "ee.vmul.u16 q6, q0, q4\n"
+            "ssai 0\n"
+            "ee.vmul.u16 q6, q6, q3\n"
+            "ee.vld.128.ip q1, %[c], 16\n"     // Premultiplied red
+            "ee.vadds.s16 q6, q6, q1\n"
+            "ssai 8\n"                         // LV_UDIV255() of the three sums
+            "ee.vmul.u16 q1, q2, q4\n"
+            "ee.vadds.s16 q2, q2, q1\n"
+            "ee.vadds.s16 q2, q2, q4\n"
+            "ee.vmul.u16 q2, q2, q4\n"
+            "ee.vmul.u16 q1, q5, q4\n"
+            "ee.vadds.s16 q5, q5, q1\n"
+            "ee.vadds.s16 q5, q5, q4\n"
+            "ee.vmul.u16 q5, q5, q4\n"
+            "ee.vmul.u16 q1, q6, q4\n"
+            "ee.vadds.s16 q6, q6, q1\n"
+            "ee.vadds.s16 q6, q6, q4\n"
+            "ee.vmul.u16 q6, q6, q4\n"
+            "ssai 0\n"
+            "ee.vld.128.ip q1, %[c], 16\n"     // Green to its place
+            "ee.vmul.u16 q5, q5, q1\n"
+            "ee.vld.128.ip q1, %[c], 16\n"     // Red to its place
+            "ee.vmul.u16 q6, q6, q1\n"
+            "ee.orq q2, q2, q5\n"
+            "ee.orq q2, q2, q6\n"
+            "ee.vst.128.ip q2, %[p], 16\n"
+            : [p] "+r"(p), [c] "+r"(c)
+            :
+            : "memory");
+    }
+}
+
+/**
+ * @brief fillOpa() with the aligned runs on the vector unit.
+ */
+static void fillOpaPie(lv_color_t* destBuf, lv_coord_t stride, int32_t w, int32_t h, lv_color_t color,
+                       lv_opa_t opa) {
+    OpaMixer mixer(color, opa);
+    uint16_t lanes[PIE_LANE_COUNT * 8] __attribute__((aligned(16)));
+    const uint16_t values[PIE_LANE_COUNT] = {0x001F, mixer.opaInv, mixer.premult[2], 1, 0x003F,
+                                             mixer.premult[1], mixer.premult[0], 1 << 5, 1 << 11};
+    for (uint8_t l = 0; l < PIE_LANE_COUNT; l++) {
+        for (uint8_t i = 0; i < 8; i++) lanes[l * 8 + i] = values[l];
+    }
+    uint32_t seedWord = (uint32_t)mixer.lastRes * 0x10001u;
+
+    for (int32_t y = 0; y < h; y++) {
+        uint16_t* p = (uint16_t*)(destBuf + (int32_t)stride * y);
+        int32_t x = 0;
+        // Until the first pixel that is not black, fill_normal() gives black
+        // its seed colour: the vector mix only takes over after that
+        while (x < w && mixer.seeded) {
+            uint32_t* v = (uint32_t*)(p + x);
+            if (!((uintptr_t)v & 0xF) && x + 8 <= w && (v[0] | v[1] | v[2] | v[3]) == 0) {
+                v[0] = v[1] = v[2] = v[3] = seedWord;
+                x += 8;
+                continue;
+            }
+            p[x] = mixer.mix(p[x]);
+            x++;
+        }
+        for (; x < w && ((uintptr_t)(p + x) & 0xF); x++) p[x] = mixer.mix(p[x]);
+        int32_t vectors = (w - x) / 8;
+        mixVectorsPie(p + x, vectors, lanes);
+        x += vectors * 8;
+        for (; x < w; x++) p[x] = mixer.mix(p[x]);
+    }
+}
+
+#endif
+
+static void fillOpa(lv_color_t* destBuf, lv_coord_t stride, int32_t w, int32_t h, lv_color_t color,
+                    lv_opa_t opa) {
+#if RGB565_BLEND_PIE
+    if (pieEnabled && xPortGetCoreID() == TASK_CORE_UI) {
+        fillOpaPie(destBuf, stride, w, h, color, opa);
+        return;
+    }
+#endif
+    OpaMixer mixer(color, opa);
+    uint32_t lastWord = 0;
+    uint32_t lastWordRes = 0;
+    bool wordValid = false;
+
+    for (int32_t y = 0; y < h; y++) {
+        uint16_t* p = (uint16_t*)(destBuf + (int32_t)stride * y);
+        int32_t x = 0;
+        if (((uintptr_t)p & 0x2) && w > 0) {
+            p[0] = mixer.mix(p[0]);
+            x = 1;
+        }
+        for (; x + 1 < w; x += 2) {
+            uint32_t* word = (uint32_t*)(p + x);
+            uint32_t v = *word;
+            if (!wordValid || v != lastWord) {
+                // A word mixed while the seed was live is not reusable: LVGL
+                // re-mixes a black pixel once it has seen any other colour
+                bool seeded = mixer.seeded;
+                uint32_t lo = mixer.mix((uint16_t)v);
+                uint32_t hi = mixer.mix((uint16_t)(v >> 16));
+                lastWord = v;
+                lastWordRes = lo | (hi << 16);
+                wordValid = !seeded;
+            }
+            *word = lastWordRes;
+        }
+        if (x < w) p[x] = mixer.mix(p[x]);
+    }
+}
+
+/**
+ * @brief Masked opacity mix; a pure function of (mask, destination) like the
+ *        masked branch of fill_normal(), cached on both.
+ */
+struct MaskMixer {
+    lv_color_t color;
+    lv_opa_t opa;
+    lv_opa_t lastMask;
+    lv_opa_t opaMask;
+    uint16_t lastDest;
+    uint16_t lastRes;
+    bool valid;
+
+    MaskMixer(lv_color_t c, lv_opa_t o) : color(c), opa(o), lastMask(LV_OPA_TRANSP), opaMask(0), lastDest(0),
+                                          lastRes(0), valid(false) {}
+
+    uint16_t mix(uint16_t dest, lv_opa_t mask) {
+        if (valid && mask == lastMask && dest == lastDest) return lastRes;
+        if (!valid || mask != lastMask) {
+            opaMask = mask == LV_OPA_COVER ? opa : (lv_opa_t)(((uint32_t)mask * opa) >> 8);
+        }
+        lv_color_t c;
+        c.full = dest;
+        lastRes = opaMask == LV_OPA_COVER ? color.full : lv_color_mix(color, c, opaMask).full;
+        lastMask = mask;
+        lastDest = dest;
+        valid = true;
+        return lastRes;
+    }
+};
+
+static void fillOpaMasked(lv_color_t* destBuf, lv_coord_t stride, int32_t w, int32_t h, lv_color_t color,
+                          lv_opa_t opa, const lv_opa_t* maskBuf, lv_coord_t maskStride) {
+    MaskMixer mixer(color, opa);
+    for (int32_t y = 0; y < h; y++) {
+        uint16_t* p = (uint16_t*)(destBuf + (int32_t)stride * y);
+        const lv_opa_t* mask = maskBuf + (int32_t)maskStride * y;
+        int32_t x = 0;
+        for (; x < w && ((uintptr_t)(mask + x) & 0x3); x++) {
+            if (mask[x]) p[x] = mixer.mix(p[x], mask[x]);
+        }
+        for (; x + 3 < w; x += 4) {
+            uint32_t m32 = *(const uint32_t*)(mask + x);
+            if (m32 == 0) continue;
+            if (m32 == 0xFFFFFFFF) {
+                p[x] = mixer.mix(p[x], LV_OPA_COVER);
+                p[x + 1] = mixer.mix(p[x + 1], LV_OPA_COVER);
+                p[x + 2] = mixer.mix(p[x + 2], LV_OPA_COVER);
+                p[x + 3] = mixer.mix(p[x + 3], LV_OPA_COVER);
+                continue;
+            }
+            for (int32_t i = x; i < x + 4; i++) {
+                if (mask[i]) p[i] = mixer.mix(p[i], mask[i]);
+            }
+        }
+        for (; x < w; x++) {
+            if (mask[x]) p[x] = mixer.mix(p[x], mask[x]);
+        }
+    }
+}
+
+/**
+ * @brief The semi-transparent normal fills of a plain RGB565 buffer are
+ *        handled here, everything else by LVGL.
+ */
+static void blendFast(lv_draw_ctx_t* ctx, const lv_draw_sw_blend_dsc_t* dsc) {
+    lv_disp_t* disp = _lv_refr_get_disp_refreshing();
+    if (dsc->src_buf || dsc->blend_mode != LV_BLEND_MODE_NORMAL || dsc->opa >= LV_OPA_MAX || !disp ||
+        disp->driver->set_px_cb || disp->driver->screen_transp) {
+        lv_draw_sw_blend_basic(ctx, dsc);
+        return;
+    }
+
+    // Same mask interpretation as lv_draw_sw_blend_basic()
+    const lv_opa_t* mask;
+    if (dsc->mask_buf && dsc->mask_res == LV_DRAW_MASK_RES_TRANSP) return;
+    else if (dsc->mask_res == LV_DRAW_MASK_RES_FULL_COVER) mask = NULL;
+    else mask = dsc->mask_buf;
+    if (mask && !disp->driver->antialiasing) {
+        lv_draw_sw_blend_basic(ctx, dsc); // Rounds the mask first
+        return;
+    }
+
+    lv_area_t area;
+    if (!_lv_area_intersect(&area, dsc->blend_area, ctx->clip_area)) return;
+    lv_coord_t stride = lv_area_get_width(ctx->buf_area);
+    lv_color_t* dest = (lv_color_t*)ctx->buf + stride * (area.y1 - ctx->buf_area->y1) + (area.x1 - ctx->buf_area->x1);
+    int32_t w = lv_area_get_width(&area);
+    int32_t h = lv_area_get_height(&area);
+
+    if (!mask) {
+        fillOpa(dest, stride, w, h, dsc->color, dsc->opa);
+    } else {
+        lv_coord_t maskStride = lv_area_get_width(dsc->mask_area);
+        mask += maskStride * (area.y1 - dsc->mask_area->y1) + (area.x1 - dsc->mask_area->x1);
+        fillOpaMasked(dest, stride, w, h, dsc->color, dsc->opa, mask, maskStride);
+    }
+}
+
+/**
+ * @brief lv_draw_sw_ctx_t::blend
+ */
+static void blend(lv_draw_ctx_t* ctx, const lv_draw_sw_blend_dsc_t* dsc) {
+    if (enabled) blendFast(ctx, dsc);
+    else lv_draw_sw_blend_basic(ctx, dsc);
+}
+
+static void initCtx(lv_disp_drv_t* drv, lv_draw_ctx_t* ctx) {
+    lv_draw_sw_init_ctx(drv, ctx);
+    ((lv_draw_sw_ctx_t*)ctx)->blend = blend;
+}
+
+void blend565Install(lv_disp_drv_t* drv) {
+    drv->draw_ctx_init = initCtx;
+    drv->draw_ctx_size = sizeof(lv_draw_sw_ctx_t);
+}
+
+void blend565SetEnabled(bool on) {
+    enabled = on;
+}
+
+bool blend565Enabled() {
+    return enabled;
+}
+
+bool blend565Vectorized() {
+    return RGB565_BLEND_PIE && pieEnabled;
+}
+
+/*******************************************************************************
+ * Self-test
+ ******************************************************************************/
+
+static uint32_t testSeed = 1;
+
+static uint32_t testRandom() {
+    testSeed = testSeed * 1664525u + 1013904223u;
+    return testSeed >> 8;
+}
+
+/**
+ * @brief Destination content: runs of one colour (the cached case) mixed with noise.
+ */
+static void fillTestPixels(uint16_t* buf, uint32_t count, bool flat) {
+    uint16_t run = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (flat) {
+            buf[i] = 0x2124;
+            continue;
+        }
+        if (i % 13 == 0) run = (uint16_t)testRandom();
+        buf[i] = (testRandom() & 3) ? run : (uint16_t)testRandom();
+        if ((testRandom() & 31) == 0) buf[i] = 0x0000; // Black: the seeded case
+    }
+}
+
+typedef void (*BlendFunction)(lv_draw_ctx_t*, const lv_draw_sw_blend_dsc_t*);
+
+/**
+ * @brief Mean time of @p runs blends of @p dsc, each on freshly filled pixels.
+ */
+static uint32_t timeBlend(BlendFunction fn, lv_draw_ctx_t* ctx, const lv_draw_sw_blend_dsc_t* dsc,
+                          uint32_t pixels, bool flat, uint8_t runs) {
+    uint32_t total = 0;
+    testSeed = 7;
+    for (uint8_t r = 0; r < runs; r++) {
+        fillTestPixels((uint16_t*)ctx->buf, pixels, flat);
+        uint32_t start = micros();
+        fn(ctx, dsc);
+        total += micros() - start;
+    }
+    return total / runs;
+}
+
+uint32_t blend565SelfTest(Print& out) {
+    const lv_coord_t W = 240;
+    const lv_coord_t H = 32;
+    const uint32_t pixels = (uint32_t)W * H;
+    uint16_t* scalarBuf = (uint16_t*)malloc(pixels * 2);
+    uint16_t* fastBuf = (uint16_t*)malloc(pixels * 2);
+    lv_opa_t* maskBuf = (lv_opa_t*)malloc(pixels);
+    if (!scalarBuf || !fastBuf || !maskBuf) {
+        free(scalarBuf);
+        free(fastBuf);
+        free(maskBuf);
+        out.println("Blend self-test: out of memory");
+        return 0;
+    }
+
+    // lv_draw_sw_blend_basic() reads the driver flags of the refreshing display
+    lv_disp_t* previous = _lv_refr_get_disp_refreshing();
+    _lv_refr_set_disp_refreshing(lv_disp_get_default());
+
+    lv_area_t bufArea;
+    lv_area_set(&bufArea, 0, 0, W - 1, H - 1);
+    lv_draw_ctx_t ctxScalar;
+    lv_draw_ctx_t ctxFast;
+    memset(&ctxScalar, 0, sizeof(ctxScalar));
+    ctxScalar.buf_area = &bufArea;
+    ctxScalar.clip_area = &bufArea;
+    ctxFast = ctxScalar;
+    ctxScalar.buf = scalarBuf;
+    ctxFast.buf = fastBuf;
+
+    // Every case through each path: the vector one (if built) and the word one
+    const uint16_t cases = 300;
+    const uint8_t paths = RGB565_BLEND_PIE ? 2 : 1;
+    uint32_t differing = 0;
+    for (uint8_t path = 0; path < paths; path++) {
+        pieEnabled = path + 1 < paths;
+        testSeed = 1;
+        for (uint16_t c = 0; c < cases; c++) {
+            fillTestPixels(scalarBuf, pixels, false);
+            memcpy(fastBuf, scalarBuf, pixels * 2);
+
+            // Any alignment and size, opacity from 1 to LV_OPA_MAX - 1
+            lv_area_t area;
+            area.x1 = testRandom() % W;
+            area.y1 = testRandom() % H;
+            area.x2 = area.x1 + testRandom() % (W - area.x1);
+            area.y2 = area.y1 + testRandom() % (H - area.y1);
+            lv_draw_sw_blend_dsc_t dsc;
+            memset(&dsc, 0, sizeof(dsc));
+            dsc.blend_area = &area;
+            dsc.color.full = (uint16_t)testRandom();
+            dsc.opa = 1 + testRandom() % (LV_OPA_MAX - 1);
+            dsc.blend_mode = LV_BLEND_MODE_NORMAL;
+            dsc.mask_res = LV_DRAW_MASK_RES_FULL_COVER;
+            if (c & 1) {
+                // Mask runs of transparent, covering and partial values
+                uint32_t maskPixels = (uint32_t)lv_area_get_size(&area);
+                for (uint32_t i = 0; i < maskPixels;) {
+                    uint32_t run = 1 + testRandom() % 12;
+                    uint8_t kind = testRandom() % 3;
+                    for (; run && i < maskPixels; run--, i++) {
+                        maskBuf[i] = kind == 0 ? LV_OPA_TRANSP : (kind == 1 ? LV_OPA_COVER : (lv_opa_t)testRandom());
+                    }
+                }
+                dsc.mask_buf = maskBuf;
+                dsc.mask_area = &area;
+                dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+            }
+            lv_draw_sw_blend_basic(&ctxScalar, &dsc);
+            blendFast(&ctxFast, &dsc);
+            for (uint32_t i = 0; i < pixels; i++) {
+                if (scalarBuf[i] != fastBuf[i]) differing++;
+            }
+        }
+    }
+
+    // Kernel time for a 50% fill of the whole buffer, flat and textured background
+    lv_draw_sw_blend_dsc_t fill;
+    memset(&fill, 0, sizeof(fill));
+    fill.blend_area = &bufArea;
+    fill.color = lv_color_hex(0x89DE10);
+    fill.opa = LV_OPA_50;
+    fill.blend_mode = LV_BLEND_MODE_NORMAL;
+    fill.mask_res = LV_DRAW_MASK_RES_FULL_COVER;
+    out.printf("Blend self-test: %u cases on %u path%s, %lu pixels differ\n", (unsigned)cases, (unsigned)paths,
+               paths > 1 ? "s" : "", (unsigned long)differing);
+    for (uint8_t flat = 0; flat < 2; flat++) {
+        uint32_t scalarUs = timeBlend(lv_draw_sw_blend_basic, &ctxScalar, &fill, pixels, flat, 20);
+        pieEnabled = false;
+        uint32_t fastUs = timeBlend(blendFast, &ctxFast, &fill, pixels, flat, 20);
+        out.printf("  50%% fill %dx%d, %s background: LVGL %lu us, word path %lu us", W, H,
+                   flat ? "flat" : "textured", (unsigned long)scalarUs, (unsigned long)fastUs);
+        if (RGB565_BLEND_PIE) {
+            pieEnabled = true;
+            out.printf(", PIE %lu us", (unsigned long)timeBlend(blendFast, &ctxFast, &fill, pixels, flat, 20));
+        }
+        out.println();
+    }
+    pieEnabled = true;
+
+    _lv_refr_set_disp_refreshing(previous);
+    free(scalarBuf);
+    free(fastBuf);
+    free(maskBuf);
+    return differing;
+}
+
+#endif // !HEADLESS
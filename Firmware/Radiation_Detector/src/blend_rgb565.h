@@ -0,0 +1,43 @@
+#ifndef BLEND_RGB565_H
+#define BLEND_RGB565_H
+
+#include <Arduino.h>
+#include <lvgl.h>
+
+// RGB565 blend backend for LVGL's software renderer (lv_draw_sw_ctx_t::blend).
+// Semi-transparent color fills (panel backgrounds with bg_opa, shadows, the
+// opacity-masked edges of rounded rectangles) are handled here, two pixels per
+// 32-bit access with the mixed result of the last destination word cached, and
+// mask words that are fully transparent or fully covering taken four pixels at
+// a time. Everything else goes to lv_draw_sw_blend_basic(). The results are
+// bit-identical to LVGL's scalar path, which blend565SelfTest() verifies.
+//
+// On the ESP32-S3 unmasked fills run on the PIE 128-bit vector unit, eight
+// pixels per pass over aligned runs, with the word path for row ends and
+// unaligned pixels; RGB565_BLEND_PIE=0 keeps the word path everywhere.
+
+#ifndef RGB565_BLEND_PIE
+#if defined(CONFIG_IDF_TARGET_ESP32S3)
+#define RGB565_BLEND_PIE 1
+#else
+#define RGB565_BLEND_PIE 0
+#endif
+#endif
+
+// Installs the backend on @p drv; call before lv_disp_drv_register().
+void blend565Install(lv_disp_drv_t* drv);
+
+// Falls back to LVGL's scalar blend while disabled (for comparisons).
+void blend565SetEnabled(bool enabled);
+
+bool blend565Enabled();
+
+// True when unmasked fills use the vector unit.
+bool blend565Vectorized();
+
+// Blends random fills (opacity, masks, alignments) through both paths into two
+// buffers, compares them and times both. LVGL task only.
+// @return number of differing pixels (0 = identical)
+uint32_t blend565SelfTest(Print& out);
+
+#endif // BLEND_RGB565_H
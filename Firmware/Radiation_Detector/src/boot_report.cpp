@@ -0,0 +1,134 @@
+/**
+ * @file boot_report.cpp
+ * @brief Phase timings of setup() and the failed-boot counter in RTC memory.
+ *
+ * Everything but bootReportCountingStarted() (pulseTask) and bootReportLoop()
+ * (uiTask) runs in setup(); the report fields are single aligned words, so
+ * the readers take them without a lock.
+ */
+
+#include "boot_report.h"
+#include "supervisor.h"
+#include "debug.h"
+#include "esp_timer.h"
+#include "esp_system.h"
+#include "esp_attr.h"
+#include "esp_rom_crc.h"
+
+static const uint32_t BOOT_RTC_MAGIC = 0x42545452;     ///< "RTTB"
+
+/// Kept in RTC memory; survives soft resets, not power cycles
+struct BootRtc {
+    uint32_t magic;
+    uint32_t attempts;  ///< Boots started since the last one that became stable
+    int32_t phase;      ///< Phase the latest boot was in
+    uint32_t crc;
+};
+
+RTC_NOINIT_ATTR static BootRtc rtcBoot;
+
+static BootReport report;
+static int8_t currentPhase = -1;
+static uint32_t phaseStartUs = 0;
+static bool stable = false;
+
+static uint32_t rtcCrc(const BootRtc& copy) {
+    return esp_rom_crc32_le(0, (const uint8_t*)&copy, offsetof(BootRtc, crc));
+}
+
+static void rtcStore() {
+    rtcBoot.magic = BOOT_RTC_MAGIC;
+    rtcBoot.crc = rtcCrc(rtcBoot);
+}
+
+void bootReportBegin() {
+    memset(&report, 0, sizeof(report));
+    report.bootUs = (uint32_t)esp_timer_get_time();
+    report.failedPhase = -1;
+
+    // A power cycle (or brownout, the plant going down) starts the count over;
+    // after power-on RTC memory holds noise anyway
+    esp_reset_reason_t reason = esp_reset_reason();
+    report.resetReason = (uint8_t)reason;
+    bool softReset = reason != ESP_RST_POWERON && reason != ESP_RST_BROWNOUT && reason != ESP_RST_UNKNOWN;
+    uint32_t attempts = 0;
+    if (softReset && rtcBoot.magic == BOOT_RTC_MAGIC && rtcBoot.crc == rtcCrc(rtcBoot)) {
+        attempts = rtcBoot.attempts;
+        if (attempts) report.failedPhase = (int8_t)rtcBoot.phase;
+    }
+    report.failedBoots = attempts > 255 ? 255 : (uint8_t)attempts;
+    report.safeMode = attempts >= BOOT_SAFE_MODE_AFTER;
+
+    rtcBoot.attempts = attempts + 1;
+    rtcBoot.phase = -1;
+    rtcStore();
+}
+
+void bootPhase(uint8_t phase) {
+    uint32_t now = (uint32_t)esp_timer_get_time();
+    if (currentPhase >= 0) report.phaseUs[currentPhase] = now - phaseStartUs;
+    if (phase >= BOOT_PHASE_COUNT) return;
+    currentPhase = (int8_t)phase;
+    phaseStartUs = now;
+    rtcBoot.phase = phase;
+    rtcStore();
+}
+
+void bootReportComplete() {
+    bootPhase(BOOT_PHASE_COUNT);
+    currentPhase = -1;
+    report.setupUs = (uint32_t)esp_timer_get_time();
+}
+
+void bootReportCountingStarted() {
+    report.countingUs = (uint32_t)esp_timer_get_time();
+}
+
+void bootReportLoop(uint32_t nowMs) {
+    if (stable || nowMs < BOOT_STABLE_AFTER_MS) return;
+    stable = true;
+    rtcBoot.attempts = 0;
+    rtcStore();
+    if (report.failedBoots) {
+        DEBUG_PRINTF("Boot: stable after %u failed boot(s), counter cleared\n", report.failedBoots);
+    }
+}
+
+bool bootSafeMode() {
+    return report.safeMode;
+}
+
+BootReport getBootReport() {
+    return report;
+}
+
+const char* bootPhaseName(uint8_t phase) {
+    switch (phase) {
+        case BOOT_PHASE_EARLY:    return "early";
+        case BOOT_PHASE_COUNTING: return "counting";
+        case BOOT_PHASE_NETWORK:  return "network";
+        case BOOT_PHASE_DISPLAY:  return "display";
+        case BOOT_PHASE_STORAGE:  return "storage";
+        case BOOT_PHASE_SERVICES: return "services";
+        default:                  return "?";
+    }
+}
+
+void printBootReport(Print& out) {
+    BootReport r = getBootReport();
+    out.printf("Boot: %s reset, core start %lu ms, counting at %lu ms, setup done at ",
+               resetReasonName(r.resetReason), (unsigned long)(r.bootUs / 1000), (unsigned long)(r.countingUs / 1000));
+    if (r.setupUs) {
+        out.printf("%lu ms\n", (unsigned long)(r.setupUs / 1000));
+    } else {
+        out.println("(running)");
+    }
+    for (uint8_t i = 0; i < BOOT_PHASE_COUNT; i++) {
+        out.printf("  %-9s %6lu us\n", bootPhaseName(i), (unsigned long)r.phaseUs[i]);
+    }
+    if (r.failedBoots) {
+        out.printf("  %u failed boot(s) before this one, last in phase %s\n", r.failedBoots,
+                   r.failedPhase >= 0 ? bootPhaseName((uint8_t)r.failedPhase) : "-");
+    }
+    if (r.safeMode) out.println("  SAFE MODE: SD log, spectrum, telemetry and fleet OTA skipped");
+}
@@ -0,0 +1,68 @@
+#ifndef BOOT_REPORT_H
+#define BOOT_REPORT_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Boot sequence timing and crash-loop protection.
+// setup() starts pulse counting before anything slow (display, SD card,
+// network), so counts arriving right after power-on are not lost; the rest
+// comes up while pulseTask already counts. Each phase of setup() is timed
+// against esp_timer (which starts with the bootloader) and printed as the
+// boot report ("boot" serial command).
+//
+// The phase in progress is kept in RTC memory. A boot that does not reach
+// BOOT_STABLE_AFTER_MS of uptime counts as failed; after
+// BOOT_SAFE_MODE_AFTER failed boots in a row the next one starts in safe
+// mode, which counts, displays and serves the web UI (for an OTA fix) but
+// skips the SD log, the spectrum and the uploads. The counter only survives
+// soft resets (panic, watchdog, brownout-free restarts); a power cycle
+// starts over, as does a boot that stays up.
+
+enum BootPhase {
+    BOOT_PHASE_EARLY = 0,   ///< Serial, clock, settings, HV
+    BOOT_PHASE_COUNTING,    ///< Stores, dose restore, pulseTask
+    BOOT_PHASE_NETWORK,     ///< WiFi and SNTP started (connects in the background)
+    BOOT_PHASE_DISPLAY,     ///< SPI bus, TFT, LVGL
+    BOOT_PHASE_STORAGE,     ///< SD log, spectrum, telemetry queue
+    BOOT_PHASE_SERVICES,    ///< Power, checkpoints, uiTask, serial link
+    BOOT_PHASE_COUNT
+};
+
+struct BootReport {
+    uint32_t bootUs;                       ///< esp_timer at setup() entry (bootloader and core start)
+    uint32_t phaseUs[BOOT_PHASE_COUNT];    ///< Duration of each phase, 0 if not reached
+    uint32_t countingUs;                   ///< esp_timer when the pulse counter was live
+    uint32_t setupUs;                      ///< esp_timer when setup() returned, 0 while running
+    uint8_t resetReason;                   ///< esp_reset_reason_t
+    uint8_t failedBoots;                   ///< Incomplete boots before this one
+    int8_t failedPhase;                    ///< Phase the last incomplete boot stopped in, -1 if none
+    bool safeMode;
+};
+
+// Reads the RTC record of the previous boots. Call first in setup().
+void bootReportBegin();
+
+// Ends the running phase and starts @p phase.
+void bootPhase(uint8_t phase);
+
+// Ends the last phase. Call at the end of setup().
+void bootReportComplete();
+
+// The pulse counter is running (pulseSampleTask, once PCNT is configured).
+void bootReportCountingStarted();
+
+// Clears the failed-boot counter once the uptime is stable (UI task).
+void bootReportLoop(uint32_t nowMs);
+
+// This boot skips the optional subsystems after repeated failed boots.
+bool bootSafeMode();
+
+BootReport getBootReport();
+
+const char* bootPhaseName(uint8_t phase);
+
+// Prints the phase timings and the failed-boot state ("boot" serial command).
+void printBootReport(Print& out);
+
+#endif // BOOT_REPORT_H
@@ -0,0 +1,292 @@
+/**
+ * @file calibration.cpp
+ * @brief Calibration runs on uiTask, the stored calibration, its web endpoint and serial report.
+ *
+ * The run only reads the pulse total, so calibrating never disturbs the dose
+ * pipeline; the display keeps showing the rate with the old factor until the
+ * new one is applied. A stopped source run never applies its factor: it has
+ * not reached the precision the operator asked for. A stopped background run
+ * keeps its rate once it counted for CALIBRATION_MIN_MS, since its error is
+ * carried into every later calibration anyway.
+ */
+
+#include "calibration.h"
+#include "device_config.h"
+#include "settings_store.h"
+#include "plateau_scan.h"
+#include "time_base.h"
+#include "seqlock.h"
+#include "debug.h"
+#include "json_body.h"
+#include "json_arena.h"
+#include "web_arena.h"
+#include <ArduinoJson.h>
+#include <atomic>
+
+static const uint32_t PUBLISH_INTERVAL_MS = 1000;
+static const char* CONTROL_FILTER = "{\"action\":true,\"reference\":true}";
+
+static CalibrationParams calibrationParams() {
+    CalibrationParams p;
+    p.targetRel = CALIBRATION_TARGET_REL;
+    p.backgroundRel = CALIBRATION_BACKGROUND_REL;
+    p.minMs = CALIBRATION_MIN_MS;
+    p.maxMs = CALIBRATION_MAX_MS;
+    p.backgroundMaxMs = CALIBRATION_BACKGROUND_MAX_MS;
+    p.z = CALIBRATION_CONFIDENCE_Z;
+    p.referenceRel = CALIBRATION_REFERENCE_REL;
+    return p;
+}
+
+static CalibrationRun run(calibrationParams()); ///< uiTask only
+static SeqLock<CalibrationStatus> statusLock;
+static std::atomic<uint32_t> publishedVersion(0);
+static std::atomic<bool> backgroundRequested(false);
+static std::atomic<bool> startRequested(false);
+static std::atomic<bool> stopRequested(false);
+static std::atomic<float> requestedReference(0.0f);
+static std::atomic<bool> running(false);
+static bool applied = false;
+static const char* refusal = nullptr;  ///< Start refused before the run began
+static uint32_t lastPublishMs = 0;
+static WebServer* calibrationServer = nullptr;
+
+static void publish(uint32_t nowMs) {
+    CalibrationStatus status;
+    memset(&status, 0, sizeof(status));
+    status.state = refusal ? (uint8_t)CALIBRATION_ABORTED : run.state();
+    status.source = run.sourceRun();
+    status.counts = run.counts();
+    status.elapsedMs = run.elapsedMs();
+    status.remainingMs = run.remainingMs();
+    status.referenceUsvH = run.referenceUsvH();
+    status.backgroundCps = run.backgroundCps();
+    status.backgroundSeconds = run.backgroundSeconds();
+    status.estimate = run.estimate();
+    status.targetRel = run.sourceRun() ? CALIBRATION_TARGET_REL : CALIBRATION_BACKGROUND_REL;
+    status.applied = applied;
+    strlcpy(status.reason, refusal ? refusal : run.reason(), sizeof(status.reason));
+    status.factor = getDeviceConfig().cpmPerUsvH;
+    status.factorRel = settingGetFloat(SETTING_CAL_REL);
+    status.calibratedUtc = (uint32_t)settingGetInt(SETTING_CAL_TIME);
+    status.storedBackgroundCps = settingGetFloat(SETTING_CAL_BACKGROUND);
+    status.storedBackgroundSeconds = settingGetFloat(SETTING_CAL_BACKGROUND_S);
+    status.version = publishedVersion.load() + 1;
+    statusLock.publish(status);
+    publishedVersion = status.version;
+    running = run.running();
+    lastPublishMs = nowMs;
+}
+
+/**
+ * @brief Stores what a finished run measured: the background, or the factor
+ *        with its uncertainty.
+ */
+static void finishRun() {
+    if (run.state() != CALIBRATION_DONE) {
+        DEBUG_PRINTF("Calibration: %s run ended without a result (%s)\n", run.sourceRun() ? "source" : "background",
+                     run.reason());
+        return;
+    }
+    if (!run.sourceRun()) {
+        settingSetFloat(SETTING_CAL_BACKGROUND, run.backgroundCps());
+        settingSetFloat(SETTING_CAL_BACKGROUND_S, run.backgroundSeconds());
+        DEBUG_PRINTF("Calibration: background %.3f cps over %.0f s stored\n", run.backgroundCps(),
+                     run.backgroundSeconds());
+        return;
+    }
+    const CalibrationEstimate& e = run.estimate();
+    DeviceConfig config = getDeviceConfig();
+    config.cpmPerUsvH = e.factor;
+    setDeviceConfig(config);
+    settingSetFloat(SETTING_CAL_REL, e.factorRel);
+    settingSetFloat(SETTING_CAL_REFERENCE, run.referenceUsvH());
+    settingSetInt(SETTING_CAL_TIME, (int32_t)timeBaseUtcSeconds());
+    applied = true;
+    DEBUG_PRINTF("Calibration: %.1f CPM per uSv/h (%.1f ... %.1f) stored\n", e.factor, e.factorLow, e.factorHigh);
+}
+
+bool initCalibration() {
+    publish(millis());
+    return true;
+}
+
+void calibrationRequestBackground() {
+    backgroundRequested = true;
+}
+
+void calibrationRequestStart(float referenceUsvH) {
+    requestedReference = referenceUsvH;
+    startRequested = true;
+}
+
+void calibrationRequestStop() {
+    stopRequested = true;
+}
+
+void calibrationLoop(uint32_t nowMs, uint32_t totalCounts) {
+    bool changed = false;
+    bool background = backgroundRequested.exchange(false);
+    bool start = startRequested.exchange(false);
+    if ((background || start) && !run.running()) {
+        float reference = requestedReference.load();
+        applied = false;
+        refusal = nullptr;
+        if (plateauScanRunning()) {
+            refusal = "plateau scan running";
+        } else if (background) {
+            run.startBackground(nowMs, totalCounts);
+            DEBUG_PRINTLN("Calibration: counting background");
+        } else if (!(reference > 0.0f)) {
+            refusal = "no reference dose rate";
+        } else {
+            float backgroundS = settingGetFloat(SETTING_CAL_BACKGROUND_S);
+            float backgroundCps = backgroundS > 0.0f ? settingGetFloat(SETTING_CAL_BACKGROUND) : 0.0f;
+            run.startSource(nowMs, totalCounts, reference, backgroundCps, backgroundS);
+            DEBUG_PRINTF("Calibration: counting against %.3f uSv/h, background %.3f cps\n", reference, backgroundCps);
+        }
+        changed = true;
+    }
+    if (stopRequested.exchange(false) && run.running()) {
+        run.stop();
+        finishRun();
+        changed = true;
+    }
+
+    if (run.running() && run.update(nowMs, totalCounts, getDeviceConfig().deadTimeSec)) {
+        finishRun();
+        changed = true;
+    }
+
+    if (changed || (run.running() && nowMs - lastPublishMs >= PUBLISH_INTERVAL_MS)) publish(nowMs);
+}
+
+bool calibrationRunning() {
+    return running.load();
+}
+
+CalibrationStatus getCalibrationStatus() {
+    CalibrationStatus status;
+    memset(&status, 0, sizeof(status));
+    statusLock.read(status);
+    return status;
+}
+
+uint32_t calibrationVersion() {
+    return publishedVersion.load();
+}
+
+const char* calibrationStateName(uint8_t state) {
+    static const char* NAMES[] = {"idle", "background", "source", "done", "aborted"};
+    return state <= CALIBRATION_ABORTED ? NAMES[state] : "?";
+}
+
+void buildCalibrationJson(JsonDocument& doc) {
+    CalibrationStatus s = getCalibrationStatus();
+    doc["state"] = calibrationStateName(s.state);
+    doc["run"] = s.source ? "source" : "background";
+    doc["counts"] = s.counts;
+    doc["elapsed_s"] = s.elapsedMs / 1000.0f;
+    doc["remaining_s"] = s.remainingMs / 1000.0f;
+    doc["target_rel"] = s.targetRel;
+    doc["reason"] = s.reason;
+    if (s.source) {
+        doc["reference_usvh"] = s.referenceUsvH;
+        doc["background_cps"] = s.backgroundCps;
+        JsonObject estimate = doc["estimate"].to<JsonObject>();
+        estimate["gross_cps"] = s.estimate.grossCps;
+        estimate["net_cps"] = s.estimate.netCps;
+        estimate["net_rel"] = s.estimate.netRel;
+        if (s.estimate.valid) {
+            estimate["factor"] = s.estimate.factor;
+            estimate["factor_low"] = s.estimate.factorLow;
+            estimate["factor_high"] = s.estimate.factorHigh;
+        }
+        estimate["applied"] = s.applied;
+    } else {
+        doc["background_cps"] = s.backgroundCps;
+        doc["background_rel"] = s.counts ? 1.0f / sqrtf((float)s.counts) : 1.0f;
+    }
+    JsonObject stored = doc["stored"].to<JsonObject>();
+    stored["cpm_per_usvh"] = s.factor;
+    stored["rel"] = s.factorRel;
+    stored["utc"] = s.calibratedUtc;
+    stored["background_cps"] = s.storedBackgroundCps;
+    stored["background_s"] = s.storedBackgroundSeconds;
+}
+
+/**
+ * @brief POST /api/calibration with {"action":"background|start|stop","reference":<µSv/h>}
+ *        or the same as arguments: queues the request for uiTask.
+ */
+static void handleCalibrationControl(WebServer& server, JsonVariantConst body) {
+    String action = body["action"] | server.arg("action");
+    if (action == "background") {
+        calibrationRequestBackground();
+    } else if (action == "start") {
+        float reference = body["reference"] | server.arg("reference").toFloat();
+        if (!(reference > 0.0f)) {
+            server.send(400, "text/plain", "reference must be a dose rate in uSv/h");
+            return;
+        }
+        calibrationRequestStart(reference);
+    } else if (action == "stop") {
+        calibrationRequestStop();
+    } else {
+        server.send(400, "text/plain", "action must be background, start or stop");
+        return;
+    }
+    server.send(202, "text/plain", "Queued");
+}
+
+void calibrationAttach(WebServer& server) {
+    calibrationServer = &server;
+    server.on("/api/calibration", HTTP_GET, []() {
+        calibrationServer->sendHeader("Cache-Control", "no-store");
+        calibrationServer->sendHeader("Access-Control-Allow-Origin", "*");
+        JsonArenaLease lease;
+        JsonDocument doc(lease.allocator());
+        buildCalibrationJson(doc);
+        webSendJson(*calibrationServer, 200, doc);
+    });
+    jsonBodyOn(server, "/api/calibration", CONTROL_FILTER, handleCalibrationControl);
+}
+
+void printCalibration(Print& out) {
+    CalibrationStatus s = getCalibrationStatus();
+    out.printf("Calibration: %s", calibrationStateName(s.state));
+    if (s.state != CALIBRATION_IDLE) {
+        out.printf(", %s run, %lu counts in %.0f s", s.source ? "source" : "background", (unsigned long)s.counts,
+                   s.elapsedMs / 1000.0f);
+        if (s.remainingMs) out.printf(", about %.0f s to go", s.remainingMs / 1000.0f);
+    }
+    if (s.reason[0]) out.printf(" (%s)", s.reason);
+    out.println();
+    if (s.state != CALIBRATION_IDLE && s.source) {
+        out.printf("  reference %.3f uSv/h, gross %.2f cps, background %.3f cps, net %.2f cps +-%.1f %% (target %.1f %%)\n",
+                   s.referenceUsvH, s.estimate.grossCps, s.backgroundCps, s.estimate.netCps,
+                   s.estimate.netRel * 100.0f, s.targetRel * 100.0f);
+        if (s.estimate.valid) {
+            out.printf("  factor %.1f CPM per uSv/h, %.1f ... %.1f at %.2f sigma%s\n", s.estimate.factor,
+                       s.estimate.factorLow, s.estimate.factorHigh, CALIBRATION_CONFIDENCE_Z,
+                       s.applied ? " (stored)" : "");
+        }
+    } else if (s.state != CALIBRATION_IDLE) {
+        out.printf("  background %.3f cps +-%.1f %% (target %.1f %%)\n", s.backgroundCps,
+                   s.counts ? 100.0f / sqrtf((float)s.counts) : 100.0f, s.targetRel * 100.0f);
+    }
+    out.printf("  stored: %.2f CPM per uSv/h", s.factor);
+    if (s.factorRel > 0.0f) out.printf(" +-%.1f %%", s.factorRel * 100.0f);
+    else out.print(" (not calibrated)");
+    if (s.calibratedUtc) {
+        time_t t = s.calibratedUtc;
+        struct tm tm;
+        gmtime_r(&t, &tm);
+        out.printf(" on %04d-%02d-%02d", tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday);
+    }
+    if (s.storedBackgroundSeconds > 0.0f) {
+        out.printf(", background %.3f cps over %.0f s\n", s.storedBackgroundCps, s.storedBackgroundSeconds);
+    } else {
+        out.println(", no background");
+    }
+}
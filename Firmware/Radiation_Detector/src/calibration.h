@@ -0,0 +1,77 @@
+#ifndef CALIBRATION_H
+#define CALIBRATION_H
+
+#include <Arduino.h>
+#include <WebServer.h>
+#include <ArduinoJson.h>
+#include "config.h"
+#include "calibration_fit.h"
+
+// Dose-rate calibration against a reference source (calibration_fit.h), from
+// the CAL panel on the settings screen, the serial console or the web API.
+//  1. Background: with the source removed, count until the background is known
+//     to CALIBRATION_BACKGROUND_REL. The result is stored and reused by every
+//     later calibration until the next background run.
+//  2. Start with the reference dose rate at the tube: count until the net rate
+//     is known to CALIBRATION_TARGET_REL. The factor (CPM per µSv/h) becomes
+//     the configured conversion factor and is stored together with its
+//     uncertainty, the reference and the time.
+// The run lives on uiTask: calibrationLoop() feeds it the pulse total every
+// pass. Requests are accepted from any task and take effect on the next pass.
+//   GET  /api/calibration        state, progress, estimate, stored calibration
+//   POST /api/calibration?action=background|start|stop[&reference=<µSv/h>]
+
+struct CalibrationStatus {
+    uint8_t state;             ///< CalibrationState
+    bool source;               ///< The current or last run is a source run
+    uint32_t counts;           ///< Of the current or last run
+    uint32_t elapsedMs;
+    uint32_t remainingMs;      ///< Estimate at the present rate, 0 if unknown
+    float referenceUsvH;
+    float backgroundCps;       ///< Background run: measured so far; source run: subtracted
+    float backgroundSeconds;
+    CalibrationEstimate estimate;
+    float targetRel;           ///< Precision the run stops at
+    bool applied;              ///< The factor was stored as the conversion factor
+    char reason[28];           ///< Why the run ended early, or ""
+
+    // Stored calibration
+    float factor;              ///< Configured CPM per µSv/h
+    float factorRel;           ///< Its relative 1-sigma (0: never calibrated)
+    uint32_t calibratedUtc;    ///< 0 if unknown
+    float storedBackgroundCps;
+    float storedBackgroundSeconds; ///< 0: no background stored
+
+    uint32_t version;          ///< Changes with every published update
+};
+
+// Loads the stored background and publishes the first status. Call in setup()
+// after initDeviceConfig().
+bool initCalibration();
+
+// Any task. A start without a positive reference is refused on the next pass.
+void calibrationRequestBackground();
+void calibrationRequestStart(float referenceUsvH);
+void calibrationRequestStop();
+
+// Advances the run. Call from uiTask once per pass.
+void calibrationLoop(uint32_t nowMs, uint32_t totalCounts);
+
+bool calibrationRunning();
+
+// Consistent copy of the last published state. Any task, lock-free.
+CalibrationStatus getCalibrationStatus();
+
+// Cheap change check for pollers (the CAL panel).
+uint32_t calibrationVersion();
+
+const char* calibrationStateName(uint8_t state);
+
+void buildCalibrationJson(JsonDocument& doc);
+
+// Registers /api/calibration. Call while the other routes are set up.
+void calibrationAttach(WebServer& server);
+
+void printCalibration(Print& out);
+
+#endif // CALIBRATION_H
@@ -0,0 +1,208 @@
+#ifndef CALIBRATION_FIT_H
+#define CALIBRATION_FIT_H
+
+#include <math.h>
+#include <stdint.h>
+#include "count_statistics.h"
+
+// Dose-rate calibration against a reference source with precision-based
+// stopping. A run integrates counts until the relative 1-sigma error of the
+// rate it measures reaches the target, instead of counting for a fixed time:
+// a strong source is done in seconds, a weak one takes as long as it needs.
+//  - Background run (source removed): the rate's error is 1/sqrt(N). It stops
+//    at backgroundRel, or at maxMs with whatever precision it reached. Either
+//    way the rate and its live time are kept, and the error travels with it.
+//  - Source run: the gross rate is dead-time corrected (rateUncertainty() of
+//    count_statistics.h), then the stored background is subtracted. The errors of both add in quadrature:
+//        var(net) = var(gross) + background / backgroundSeconds
+//    The run stops once var(net) / net^2 <= targetRel^2 after at least minMs.
+//    It aborts at maxMs, or as soon as the background's own error alone
+//    exceeds the target: no amount of counting can reach it then.
+// The factor is net CPM per µSv/h of the reference. Its confidence interval
+// is +-z sigma of the counting error and the reference's certificate error
+// (referenceRel) combined. The caller feeds the running pulse total once per
+// UI pass. No Arduino dependencies (host-compilable).
+
+enum CalibrationState {
+    CALIBRATION_IDLE = 0,
+    CALIBRATION_BACKGROUND,
+    CALIBRATION_SOURCE,
+    CALIBRATION_DONE,
+    CALIBRATION_ABORTED
+};
+
+struct CalibrationParams {
+    float targetRel;        ///< Relative 1-sigma error of the net rate that ends a source run
+    float backgroundRel;    ///< ... of the background rate that ends a background run
+    uint32_t minMs;         ///< Shortest run
+    uint32_t maxMs;         ///< Longest source run
+    uint32_t backgroundMaxMs;
+    float z;                ///< Confidence interval half-width in sigmas (1.96: 95 %)
+    float referenceRel;     ///< Relative 1-sigma error of the reference dose rate
+};
+
+struct CalibrationEstimate {
+    bool valid;             ///< Net rate above zero by at least three sigmas
+    float grossCps;         ///< Dead-time corrected
+    float netCps;
+    float netRel;           ///< Relative 1-sigma of the net rate (counting only)
+    float factor;           ///< CPM per µSv/h
+    float factorRel;        ///< Relative 1-sigma of the factor, reference included
+    float factorLow;        ///< Confidence interval
+    float factorHigh;
+};
+
+/**
+ * @brief Net rate and factor of @p counts in @p seconds against the reference.
+ * @param backgroundSeconds live time behind @p backgroundCps (0: no background)
+ */
+inline CalibrationEstimate estimateCalibration(uint32_t counts, float seconds, float deadTimeSec, float backgroundCps,
+                                               float backgroundSeconds, float referenceUsvH,
+                                               const CalibrationParams& p) {
+    CalibrationEstimate e = {};
+    if (seconds <= 0.0f) return e;
+    RateUncertainty gross = rateUncertainty(counts, seconds, p.z, deadTimeSec, 1.0f);
+    e.grossCps = gross.rate;
+    float grossVar = gross.sigma * gross.sigma;
+    float backgroundVar = backgroundSeconds > 0.0f ? backgroundCps / backgroundSeconds : 0.0f;
+    e.netCps = e.grossCps - backgroundCps;
+    float sigma = sqrtf(grossVar + backgroundVar);
+    if (e.netCps <= 0.0f) return e;
+    e.netRel = sigma / e.netCps;
+    e.valid = e.netCps > 3.0f * sigma && referenceUsvH > 0.0f;
+    if (!e.valid) return e;
+    e.factor = e.netCps * 60.0f / referenceUsvH;
+    e.factorRel = sqrtf(e.netRel * e.netRel + p.referenceRel * p.referenceRel);
+    e.factorLow = e.factor * (1.0f - p.z * e.factorRel);
+    e.factorHigh = e.factor * (1.0f + p.z * e.factorRel);
+    return e;
+}
+
+/**
+ * @brief One background or source run.
+ */
+class CalibrationRun {
+public:
+    explicit CalibrationRun(const CalibrationParams& params) : p_(params) {}
+
+    void startBackground(uint32_t nowMs, uint32_t totalCounts) {
+        begin(CALIBRATION_BACKGROUND, nowMs, totalCounts);
+    }
+
+    /**
+     * @param backgroundCps     Stored background, dead-time corrected
+     * @param backgroundSeconds Its live time (0: none stored, nothing subtracted)
+     */
+    void startSource(uint32_t nowMs, uint32_t totalCounts, float referenceUsvH, float backgroundCps,
+                     float backgroundSeconds) {
+        referenceUsvH_ = referenceUsvH;
+        backgroundCps_ = backgroundCps;
+        backgroundSeconds_ = backgroundSeconds;
+        begin(CALIBRATION_SOURCE, nowMs, totalCounts);
+    }
+
+    /**
+     * @brief Takes the pulse total and checks the stopping rule.
+     * @return true if the run ended with this call
+     */
+    bool update(uint32_t nowMs, uint32_t totalCounts, float deadTimeSec) {
+        if (!running()) return false;
+        counts_ = totalCounts - startCounts_;
+        elapsedMs_ = nowMs - startMs_;
+        float seconds = elapsedMs_ / 1000.0f;
+        remainingMs_ = 0;
+
+        if (state_ == CALIBRATION_BACKGROUND) {
+            backgroundCps_ = rateUncertainty(counts_, seconds, p_.z, deadTimeSec, 1.0f).rate;
+            backgroundSeconds_ = seconds;
+            float rel = counts_ ? 1.0f / sqrtf((float)counts_) : 1.0f;
+            if (counts_ && rel <= p_.backgroundRel && elapsedMs_ >= p_.minMs) return finish(CALIBRATION_DONE, "");
+            if (elapsedMs_ >= p_.backgroundMaxMs) return finish(CALIBRATION_DONE, "time limit");
+            // Counts still needed at the present rate
+            if (counts_ && seconds > 0.0f) {
+                float needed = 1.0f / (p_.backgroundRel * p_.backgroundRel) - counts_;
+                if (needed > 0.0f) remainingMs_ = (uint32_t)(needed / (counts_ / seconds) * 1000.0f);
+            }
+            return false;
+        }
+
+        estimate_ = estimateCalibration(counts_, seconds, deadTimeSec, backgroundCps_, backgroundSeconds_,
+                                        referenceUsvH_, p_);
+        // var(net) = gross / t + backgroundVar; solve for the t that meets the target
+        bool reachable = true;
+        if (estimate_.netCps > 0.0f) {
+            float backgroundVar = backgroundSeconds_ > 0.0f ? backgroundCps_ / backgroundSeconds_ : 0.0f;
+            float allowed = p_.targetRel * p_.targetRel * estimate_.netCps * estimate_.netCps - backgroundVar;
+            reachable = allowed > 0.0f;
+            float needMs = reachable ? estimate_.grossCps / allowed * 1000.0f : 0.0f;
+            if (needMs > elapsedMs_) remainingMs_ = (uint32_t)(needMs - elapsedMs_);
+        }
+        if (elapsedMs_ < p_.minMs) return false;
+        if (estimate_.valid && estimate_.netRel <= p_.targetRel) return finish(CALIBRATION_DONE, "");
+        if (elapsedMs_ >= p_.maxMs) return finish(CALIBRATION_ABORTED, "precision not reached");
+        if (!reachable) return finish(CALIBRATION_ABORTED, "background too uncertain");
+        return false;
+    }
+
+    /**
+     * @brief Operator stop: a background run that counted for minMs keeps its
+     *        rate, anything else is aborted.
+     */
+    void stop() {
+        if (!running()) return;
+        if (state_ == CALIBRATION_BACKGROUND && counts_ && elapsedMs_ >= p_.minMs) finish(CALIBRATION_DONE, "stopped");
+        else finish(CALIBRATION_ABORTED, "stopped");
+    }
+
+    void abort(const char* reason) {
+        if (running()) finish(CALIBRATION_ABORTED, reason);
+    }
+
+    bool running() const { return state_ == CALIBRATION_BACKGROUND || state_ == CALIBRATION_SOURCE; }
+    uint8_t state() const { return state_; }
+    bool sourceRun() const { return source_; }
+    uint32_t counts() const { return counts_; }
+    uint32_t elapsedMs() const { return elapsedMs_; }
+    uint32_t remainingMs() const { return remainingMs_; }     ///< Estimate at the present rate, 0 if unknown
+    float referenceUsvH() const { return referenceUsvH_; }
+    float backgroundCps() const { return backgroundCps_; }    ///< Measured (background run) or subtracted
+    float backgroundSeconds() const { return backgroundSeconds_; }
+    const CalibrationEstimate& estimate() const { return estimate_; }
+    const char* reason() const { return reason_; }
+
+private:
+    void begin(uint8_t state, uint32_t nowMs, uint32_t totalCounts) {
+        state_ = state;
+        source_ = state == CALIBRATION_SOURCE;
+        startMs_ = nowMs;
+        startCounts_ = totalCounts;
+        counts_ = 0;
+        elapsedMs_ = 0;
+        remainingMs_ = 0;
+        estimate_ = CalibrationEstimate();
+        reason_ = "";
+    }
+
+    bool finish(uint8_t state, const char* reason) {
+        state_ = state;
+        reason_ = reason;
+        remainingMs_ = 0;
+        return true;
+    }
+
+    CalibrationParams p_;
+    uint8_t state_ = CALIBRATION_IDLE;
+    bool source_ = false;
+    uint32_t startMs_ = 0;
+    uint32_t startCounts_ = 0;
+    uint32_t counts_ = 0;
+    uint32_t elapsedMs_ = 0;
+    uint32_t remainingMs_ = 0;
+    float referenceUsvH_ = 0.0f;
+    float backgroundCps_ = 0.0f;
+    float backgroundSeconds_ = 0.0f;
+    CalibrationEstimate estimate_ = {};
+    const char* reason_ = "";
+};
+
+#endif // CALIBRATION_FIT_H
@@ -0,0 +1,227 @@
+/**
+ * @file calibration_view.cpp
+ * @brief Calibration panel on the settings screen.
+ *
+ * Plain LVGL widgets: the panel changes once a second at most, so nothing
+ * here needs the direct drawing of the plots. The reference spinbox counts in
+ * nSv/h (three decimals of µSv/h); a tap on a digit selects the one the
+ * +/- buttons step.
+ */
+
+#include "config.h"
+
+#if !HEADLESS
+
+#include "calibration_view.h"
+#include "calibration.h"
+#include "settings_store.h"
+#include <math.h>
+#include <stdio.h>
+
+static const uint32_t UPDATE_INTERVAL_MS = 1000;
+static const lv_coord_t ROW = 36;
+static const lv_coord_t GAP = 10;
+static const int32_t REFERENCE_MAX = 999999; ///< 999.999 µSv/h
+
+static lv_obj_t* view = nullptr;
+static lv_obj_t* reference = nullptr;
+static lv_obj_t* backgroundBtn = nullptr;
+static lv_obj_t* startLabel = nullptr;
+static lv_obj_t* progress = nullptr;
+static lv_obj_t* text = nullptr;
+static uint32_t shownVersion = UINT32_MAX;
+static uint32_t lastUpdateMs = 0;
+static bool refreshNow = false;      ///< A request was made; show its result on the next pass
+
+static const lv_color_t COLOR_STATE[] = {LV_COLOR_MAKE(0xFF, 0xFF, 0xFF), LV_COLOR_MAKE(0xFF, 0xC8, 0x00),
+                                         LV_COLOR_MAKE(0xFF, 0xC8, 0x00), LV_COLOR_MAKE(0x89, 0xDE, 0x10),
+                                         LV_COLOR_MAKE(0xFF, 0x30, 0x30)};
+
+/**
+ * @brief Rebuilds the text, the bar and the buttons from the last published status.
+ */
+static void refresh() {
+    CalibrationStatus s = getCalibrationStatus();
+    shownVersion = s.version;
+    bool running = s.state == CALIBRATION_BACKGROUND || s.state == CALIBRATION_SOURCE;
+
+    // The relative error falls with the square root of the counts, so
+    // (target / reached)^2 is the fraction of the run's time that has passed
+    float reached = s.source ? s.estimate.netRel : (s.counts ? 1.0f / sqrtf((float)s.counts) : 0.0f);
+    int32_t percent = 0;
+    if (s.state == CALIBRATION_DONE) percent = 100;
+    else if (reached > 0.0f) percent = (int32_t)fminf(100.0f, 100.0f * (s.targetRel / reached) * (s.targetRel / reached));
+    lv_bar_set_value(progress, percent, LV_ANIM_OFF);
+
+    char buf[384];
+    size_t n = 0;
+    const char* run = s.source ? "Source" : "Background";
+    if (s.state == CALIBRATION_IDLE) {
+        n += snprintf(buf + n, sizeof(buf) - n, "Remove the source and press BKG, then place the tube at the reference and press START");
+    } else {
+        n += snprintf(buf + n, sizeof(buf) - n, "%s %s: %lu counts in %.0f s", run, calibrationStateName(s.state),
+                      (unsigned long)s.counts, s.elapsedMs / 1000.0f);
+        if (s.remainingMs) n += snprintf(buf + n, sizeof(buf) - n, ", about %.0f s to go", s.remainingMs / 1000.0f);
+        if (s.reason[0]) n += snprintf(buf + n, sizeof(buf) - n, " (%s)", s.reason);
+    }
+    if (s.state != CALIBRATION_IDLE && s.source) {
+        n += snprintf(buf + n, sizeof(buf) - n, "\nNet %.2f cps +-%.1f %% (target %.1f %%), background %.3f cps",
+                      s.estimate.netCps, s.estimate.netRel * 100.0f, s.targetRel * 100.0f, s.backgroundCps);
+        if (s.estimate.valid) {
+            n += snprintf(buf + n, sizeof(buf) - n, "\nFactor %.1f CPM per uSv/h (%.1f ... %.1f)%s", s.estimate.factor,
+                          s.estimate.factorLow, s.estimate.factorHigh, s.applied ? ", stored" : "");
+        }
+    } else if (s.state != CALIBRATION_IDLE) {
+        n += snprintf(buf + n, sizeof(buf) - n, "\nBackground %.3f cps +-%.1f %% (target %.1f %%)", s.backgroundCps,
+                      reached * 100.0f, s.targetRel * 100.0f);
+    }
+    n += snprintf(buf + n, sizeof(buf) - n, "\nStored: %.1f CPM per uSv/h", s.factor);
+    if (s.factorRel > 0.0f) n += snprintf(buf + n, sizeof(buf) - n, " +-%.1f %%", s.factorRel * 100.0f);
+    else n += snprintf(buf + n, sizeof(buf) - n, " (not calibrated)");
+    if (s.storedBackgroundSeconds > 0.0f) {
+        snprintf(buf + n, sizeof(buf) - n, ", background %.3f cps", s.storedBackgroundCps);
+    } else {
+        snprintf(buf + n, sizeof(buf) - n, ", no background");
+    }
+    lv_label_set_text(text, buf);
+    uint8_t state = s.state <= CALIBRATION_ABORTED ? s.state : (uint8_t)CALIBRATION_ABORTED;
+    lv_obj_set_style_text_color(text, COLOR_STATE[state], LV_PART_MAIN);
+
+    lv_label_set_text_static(startLabel, running && s.source ? "STOP" : "START");
+    if (running) lv_obj_add_state(backgroundBtn, LV_STATE_DISABLED);
+    else lv_obj_clear_state(backgroundBtn, LV_STATE_DISABLED);
+}
+
+static void referenceStepCb(lv_event_t* e) {
+    lv_event_code_t code = lv_event_get_code(e);
+    if (code != LV_EVENT_CLICKED && code != LV_EVENT_LONG_PRESSED_REPEAT) return;
+    if (lv_event_get_user_data(e)) lv_spinbox_increment(reference);
+    else lv_spinbox_decrement(reference);
+}
+
+static void backgroundCb(lv_event_t* e) {
+    if (lv_event_get_code(e) != LV_EVENT_CLICKED) return;
+    calibrationRequestBackground();
+    refreshNow = true;
+}
+
+static void startCb(lv_event_t* e) {
+    if (lv_event_get_code(e) != LV_EVENT_CLICKED) return;
+    if (calibrationRunning()) {
+        calibrationRequestStop();
+    } else {
+        float usvH = lv_spinbox_get_value(reference) / 1000.0f;
+        settingSetFloat(SETTING_CAL_REFERENCE, usvH); // Offered again next time
+        calibrationRequestStart(usvH);
+    }
+    refreshNow = true;
+}
+
+static void closeCb(lv_event_t* e) {
+    if (lv_event_get_code(e) != LV_EVENT_CLICKED) return;
+    calibrationViewShow(false);
+}
+
+static void openCb(lv_event_t* e) {
+    calibrationViewShow(true);
+}
+
+static void viewDeletedCb(lv_event_t* e) {
+    view = reference = backgroundBtn = startLabel = progress = text = nullptr;
+}
+
+static lv_obj_t* addButton(lv_obj_t* parent, const char* label, lv_coord_t x, lv_coord_t y, lv_coord_t w,
+                           lv_event_cb_t cb, void* userData, lv_obj_t** labelOut = nullptr) {
+    lv_obj_t* btn = lv_btn_create(parent);
+    lv_obj_set_size(btn, w, ROW);
+    lv_obj_set_pos(btn, x, y);
+    lv_obj_add_event_cb(btn, cb, LV_EVENT_ALL, userData);
+    lv_obj_t* l = lv_label_create(btn);
+    lv_label_set_text_static(l, label);
+    lv_obj_center(l);
+    if (labelOut) *labelOut = l;
+    return btn;
+}
+
+void calibrationViewAttach(lv_obj_t* screen, lv_coord_t top) {
+    lv_obj_t* open = lv_btn_create(screen);
+    lv_obj_set_size(open, 80, ROW);
+    lv_obj_align(open, LV_ALIGN_BOTTOM_RIGHT, -20, -50); // Above the alarm checkbox
+    lv_obj_t* openLabel = lv_label_create(open);
+    lv_label_set_text_static(openLabel, "CAL");
+    lv_obj_center(openLabel);
+    lv_obj_add_event_cb(open, openCb, LV_EVENT_CLICKED, NULL);
+
+    view = lv_obj_create(screen);
+    lv_obj_set_size(view, lv_obj_get_width(screen), lv_obj_get_height(screen) - top);
+    lv_obj_align(view, LV_ALIGN_TOP_LEFT, 0, top);
+    lv_obj_set_style_bg_color(view, lv_color_black(), LV_PART_MAIN);
+    lv_obj_set_style_radius(view, 0, LV_PART_MAIN);
+    lv_obj_set_style_border_width(view, 0, LV_PART_MAIN);
+    lv_obj_set_style_pad_all(view, 6, LV_PART_MAIN);
+    lv_obj_clear_flag(view, LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_GESTURE_BUBBLE);
+    lv_obj_add_flag(view, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_add_event_cb(view, viewDeletedCb, LV_EVENT_DELETE, NULL);
+
+    lv_obj_t* caption = lv_label_create(view);
+    lv_label_set_text_static(caption, "Reference");
+    lv_obj_set_style_text_color(caption, lv_color_white(), LV_PART_MAIN);
+    lv_obj_set_pos(caption, 0, 10);
+
+    addButton(view, "-", 100, 0, 40, referenceStepCb, NULL);
+    reference = lv_spinbox_create(view);
+    lv_spinbox_set_digit_format(reference, 6, 3);
+    lv_spinbox_set_range(reference, 1, REFERENCE_MAX);
+    lv_spinbox_set_step(reference, 1000);
+    int32_t stored = (int32_t)lroundf(settingGetFloat(SETTING_CAL_REFERENCE) * 1000.0f);
+    lv_spinbox_set_value(reference, stored < 1 ? 1 : stored > REFERENCE_MAX ? REFERENCE_MAX : stored);
+    lv_obj_set_size(reference, 110, ROW + 6);
+    lv_obj_set_pos(reference, 100 + 40 + GAP, -3);
+    addButton(view, "+", 100 + 40 + GAP + 110 + GAP, 0, 40, referenceStepCb, (void*)1);
+    lv_obj_t* unit = lv_label_create(view);
+    lv_label_set_text_static(unit, "uSv/h");
+    lv_obj_set_style_text_color(unit, lv_color_white(), LV_PART_MAIN);
+    lv_obj_set_pos(unit, 100 + 40 + GAP + 110 + GAP + 40 + GAP, 10);
+
+    lv_coord_t y = ROW + GAP + 4;
+    backgroundBtn = addButton(view, "BKG", 0, y, 100, backgroundCb, NULL);
+    addButton(view, "START", 100 + GAP, y, 100, startCb, NULL, &startLabel);
+    lv_obj_t* close = addButton(view, "CLOSE", 0, y, 100, closeCb, NULL);
+    lv_obj_align(close, LV_ALIGN_TOP_RIGHT, 0, y);
+
+    y += ROW + GAP;
+    progress = lv_bar_create(view);
+    lv_bar_set_range(progress, 0, 100);
+    lv_obj_set_size(progress, lv_pct(100), 12);
+    lv_obj_set_pos(progress, 0, y);
+
+    y += 12 + GAP;
+    text = lv_label_create(view);
+    lv_label_set_long_mode(text, LV_LABEL_LONG_WRAP);
+    lv_obj_set_width(text, lv_pct(100));
+    lv_obj_set_pos(text, 0, y);
+    shownVersion = UINT32_MAX;
+}
+
+void calibrationViewShow(bool show) {
+    if (!view) return;
+    if (show) {
+        lv_obj_clear_flag(view, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_move_foreground(view);
+        refresh();
+    } else {
+        lv_obj_add_flag(view, LV_OBJ_FLAG_HIDDEN);
+    }
+}
+
+void calibrationViewUpdate(uint32_t nowMs) {
+    if (!view || lv_obj_has_flag(view, LV_OBJ_FLAG_HIDDEN)) return;
+    if (!refreshNow && nowMs - lastUpdateMs < UPDATE_INTERVAL_MS) return;
+    lastUpdateMs = nowMs;
+    if (calibrationVersion() != shownVersion) {
+        refreshNow = false;
+        refresh();
+    }
+}
+
+#endif // !HEADLESS
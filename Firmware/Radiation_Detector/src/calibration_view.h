@@ -0,0 +1,22 @@
+#ifndef CALIBRATION_VIEW_H
+#define CALIBRATION_VIEW_H
+
+#include <lvgl.h>
+
+// Calibration panel over the settings screen (calibration.h). A CAL button
+// at the bottom right opens it below the navigation bar: the reference dose
+// rate with +/- buttons, BKG (count the background), START/STOP (count
+// against the reference), a progress bar towards the target precision and
+// the live estimate with its confidence interval. The text is rebuilt only
+// when a new status was published. LVGL task only.
+
+// Creates the CAL button and the (hidden) panel on @p screen, from @p top down
+// to the bottom of the screen. Both are removed with their screen.
+void calibrationViewAttach(lv_obj_t* screen, lv_coord_t top);
+
+void calibrationViewShow(bool show);
+
+// Picks up a new status at most once a second while shown.
+void calibrationViewUpdate(uint32_t nowMs);
+
+#endif // CALIBRATION_VIEW_H
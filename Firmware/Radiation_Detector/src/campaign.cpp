@@ -0,0 +1,327 @@
+/**
+ * @file campaign.cpp
+ * @brief Acquisition windows and upload slots: radio, display and deep sleep
+ *        held to the schedule.
+ *
+ * Everything runs on uiTask, which owns the WiFi state machine and the
+ * display. Times are seconds of the UTC day; a window or slot is found by the
+ * offset of now from its start, modulo a day, so one that runs past midnight
+ * needs no special case.
+ */
+
+#include "campaign.h"
+#include "logger_mode.h"
+#include "wifi_manager.h"
+#include "ethernet_link.h"
+#include "telemetry.h"
+#include "time_base.h"
+#include "debug.h"
+#if !HEADLESS
+#include "display_power.h"
+#endif
+#include <Preferences.h>
+
+static const uint32_t DAY_S = 86400;
+static const uint32_t LOOP_MS = 1000;
+
+static CampaignSchedule active;             ///< uiTask
+static CampaignStats stats;
+static uint32_t lastRunMs = 0;
+static uint32_t slotStartUtc = 0;           ///< Slot being held; 0: none
+static uint32_t doneSlotUtc = 0;            ///< Last slot ended early or over
+static uint32_t slotOnlineMs = 0;           ///< First pass of the slot with the network up; 0: not yet
+static const char* sleepRefused = nullptr;  ///< loggerModeEnter()'s reason, kept
+
+/**
+ * @brief Reads "HH:MM" at @p p and moves past it. 24:00 only with @p end.
+ */
+static bool parseTime(const char*& p, bool end, uint16_t& minute) {
+    if (!isdigit((unsigned char)p[0]) || !isdigit((unsigned char)p[1]) || p[2] != ':' ||
+        !isdigit((unsigned char)p[3]) || !isdigit((unsigned char)p[4])) {
+        return false;
+    }
+    unsigned h = (p[0] - '0') * 10 + (p[1] - '0');
+    unsigned m = (p[3] - '0') * 10 + (p[4] - '0');
+    if (m > 59 || h > 24 || (h == 24 && (m != 0 || !end))) return false;
+    minute = h * 60 + m;
+    p += 5;
+    return true;
+}
+
+static void skipSpaces(const char*& p) {
+    while (*p == ' ') p++;
+}
+
+const char* campaignParseWindows(const char* text, CampaignSchedule& schedule) {
+    CampaignWindow windows[CAMPAIGN_MAX_WINDOWS];
+    uint8_t count = 0;
+    const char* p = text;
+    skipSpaces(p);
+    while (*p) {
+        uint16_t start, end;
+        if (!parseTime(p, false, start) || *p++ != '-' || !parseTime(p, true, end)) return "windows are HH:MM-HH:MM";
+        if (start == end) return "a window needs a length";
+        if (count == CAMPAIGN_MAX_WINDOWS) return "too many windows";
+        windows[count].startMin = start;
+        windows[count].lengthMin = end > start ? end - start : end + 1440 - start;
+        count++;
+        skipSpaces(p);
+        if (*p == ',') {
+            p++;
+            skipSpaces(p);
+            if (!*p) return "windows are HH:MM-HH:MM";
+        } else if (*p) {
+            return "windows are separated by commas";
+        }
+    }
+    memcpy(schedule.windows, windows, sizeof(windows));
+    schedule.windowCount = count;
+    return nullptr;
+}
+
+const char* campaignParseUploads(const char* text, CampaignSchedule& schedule) {
+    uint16_t uploads[CAMPAIGN_MAX_UPLOADS];
+    uint8_t count = 0;
+    const char* p = text;
+    skipSpaces(p);
+    while (*p) {
+        uint16_t start;
+        if (!parseTime(p, false, start)) return "upload slots are HH:MM";
+        if (count == CAMPAIGN_MAX_UPLOADS) return "too many upload slots";
+        uploads[count++] = start;
+        skipSpaces(p);
+        if (*p == ',') {
+            p++;
+            skipSpaces(p);
+            if (!*p) return "upload slots are HH:MM";
+        } else if (*p) {
+            return "upload slots are separated by commas";
+        }
+    }
+    memcpy(schedule.uploads, uploads, sizeof(uploads));
+    schedule.uploadCount = count;
+    return nullptr;
+}
+
+void campaignFormatWindows(const CampaignSchedule& schedule, char* out, size_t size) {
+    size_t used = 0;
+    out[0] = '\0';
+    for (uint8_t i = 0; i < schedule.windowCount && used < size; i++) {
+        const CampaignWindow& w = schedule.windows[i];
+        unsigned end = w.startMin + w.lengthMin;
+        if (end > 1440) end -= 1440; // A window ending at midnight reads 24:00
+        used += snprintf(out + used, size - used, "%s%02u:%02u-%02u:%02u", i ? "," : "", w.startMin / 60,
+                         w.startMin % 60, end / 60, end % 60);
+    }
+}
+
+void campaignFormatUploads(const CampaignSchedule& schedule, char* out, size_t size) {
+    size_t used = 0;
+    out[0] = '\0';
+    for (uint8_t i = 0; i < schedule.uploadCount && used < size; i++) {
+        used += snprintf(out + used, size - used, "%s%02u:%02u", i ? "," : "", schedule.uploads[i] / 60,
+                         schedule.uploads[i] % 60);
+    }
+}
+
+void initCampaign() {
+    Preferences prefs;
+    memset(&active, 0, sizeof(active));
+    if (!prefs.begin("campaign", true)) return;
+    active.enabled = prefs.getBool("on", false);
+    // Saved as text: a changed struct layout still reads back
+    if (campaignParseWindows(prefs.getString("win", "").c_str(), active) ||
+        campaignParseUploads(prefs.getString("up", "").c_str(), active)) {
+        memset(&active, 0, sizeof(active));
+    }
+    prefs.end();
+    if (active.enabled) {
+        DEBUG_PRINTF("Campaign: %u window(s), %u upload slot(s)\n", active.windowCount, active.uploadCount);
+    }
+}
+
+CampaignSchedule campaignSchedule() {
+    return active;
+}
+
+bool campaignSetSchedule(const CampaignSchedule& schedule) {
+    char windows[CAMPAIGN_MAX_WINDOWS * 12];
+    char uploads[CAMPAIGN_MAX_UPLOADS * 6];
+    campaignFormatWindows(schedule, windows, sizeof(windows));
+    campaignFormatUploads(schedule, uploads, sizeof(uploads));
+    active = schedule;
+    sleepRefused = nullptr; // Try again under the new schedule
+    Preferences prefs;
+    if (!prefs.begin("campaign", false)) return false;
+    bool ok = prefs.putBool("on", schedule.enabled) == 1;
+    ok = prefs.putString("win", windows) == strlen(windows) && ok;
+    ok = prefs.putString("up", uploads) == strlen(uploads) && ok;
+    prefs.end();
+    return ok;
+}
+
+/**
+ * @brief Seconds from @p daySecond to @p minute of the day; 0 when it is now.
+ */
+static uint32_t untilMinute(uint32_t daySecond, uint16_t minute) {
+    return (minute * 60 + DAY_S - daySecond) % DAY_S;
+}
+
+static bool inWindow(uint32_t daySecond) {
+    for (uint8_t i = 0; i < active.windowCount; i++) {
+        uint32_t since = (daySecond + DAY_S - active.windows[i].startMin * 60) % DAY_S;
+        if (since < active.windows[i].lengthMin * 60UL) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief UTC start of the upload slot @p utc falls in; 0 outside slots.
+ */
+static uint32_t currentSlot(uint32_t utc) {
+    uint32_t daySecond = utc % DAY_S;
+    for (uint8_t i = 0; i < active.uploadCount; i++) {
+        uint32_t since = (daySecond + DAY_S - active.uploads[i] * 60) % DAY_S;
+        if (since < CAMPAIGN_UPLOAD_SLOT_S) return utc - since;
+    }
+    return 0;
+}
+
+/**
+ * @brief Seconds to the next window start or upload slot after now; 0 without any.
+ */
+static uint32_t nextEvent(uint32_t daySecond) {
+    uint32_t next = 0;
+    for (uint8_t i = 0; i < active.windowCount + active.uploadCount; i++) {
+        uint16_t minute = i < active.windowCount ? active.windows[i].startMin : active.uploads[i - active.windowCount];
+        uint32_t in = untilMinute(daySecond, minute);
+        if (in == 0) in = DAY_S; // Started this second; the next one is a day away
+        if (!next || in < next) next = in;
+    }
+    return next;
+}
+
+/**
+ * @brief Gives the radio back and ends a logger sleep the schedule started.
+ */
+static void release() {
+    wifiManagerSuspend(WIFI_SUSPEND_CAMPAIGN, false);
+    slotStartUtc = 0;
+    if (loggerModeActive() && loggerModeWake() == LOGGER_WAKE_SCHEDULED) loggerModeExit();
+}
+
+/**
+ * @brief Why the device cannot sleep now; nullptr if it can.
+ */
+static const char* sleepBlocker(uint32_t nowMs, bool holdAwake, uint32_t nextInS) {
+    if (stats.state != CAMPAIGN_IDLE) return "in a window or upload slot";
+    if (!LOGGER_ULP_AVAILABLE) return "logger mode not built in (LOGGER_ULP_AVAILABLE)";
+    if (sleepRefused) return sleepRefused;
+    if (holdAwake) return "alarm active";
+    if (nowMs < CAMPAIGN_MIN_AWAKE_S * 1000UL) return "just booted";
+    if (nextInS && nextInS < CAMPAIGN_MIN_SLEEP_S) return "next event too close";
+#if !HEADLESS
+    if (displayPowerState() != DISPLAY_POWER_OFF) return "display in use";
+#endif
+    return nullptr;
+}
+
+void campaignLoop(uint32_t nowMs, bool holdAwake) {
+    if (nowMs - lastRunMs < LOOP_MS) return;
+    lastRunMs = nowMs;
+    if (!active.enabled || !timeBaseUtcValid()) {
+        // Without UTC there is no schedule to keep, and the radio is what brings it
+        if (stats.state > CAMPAIGN_NO_TIME) release();
+        stats.state = active.enabled ? CAMPAIGN_NO_TIME : CAMPAIGN_OFF;
+        stats.windowOpen = false;
+        stats.nextEventInS = 0;
+        stats.sleepBlocked = nullptr;
+        return;
+    }
+    uint32_t utc = timeBaseUtcSeconds();
+    uint32_t daySecond = utc % DAY_S;
+
+    bool window = inWindow(daySecond);
+    if (window && !stats.windowOpen) {
+        stats.windows++;
+        DEBUG_PRINTLN("Campaign: window open");
+        if (loggerModeActive()) loggerModeExit(); // Live counting at full resolution from here
+    }
+    if (!window && (stats.windowOpen || stats.state < CAMPAIGN_IDLE)) {
+        DEBUG_PRINTLN("Campaign: outside windows");
+#if !HEADLESS
+        if (displayPowerState() != DISPLAY_POWER_OFF) displayPowerOff();
+#endif
+    }
+    stats.windowOpen = window;
+
+    uint32_t slot = currentSlot(utc);
+    if (slot && slot != doneSlotUtc) {
+        if (slot != slotStartUtc) {
+            slotStartUtc = slot;
+            slotOnlineMs = 0;
+            stats.slots++;
+            DEBUG_PRINTLN("Campaign: upload slot");
+        }
+        if (networkOnline() && !slotOnlineMs) {
+            slotOnlineMs = nowMs ? nowMs : 1;
+            telemetryFlush();
+        }
+        if (slotOnlineMs && nowMs - slotOnlineMs >= CAMPAIGN_UPLOAD_LINGER_S * 1000UL &&
+            getTelemetryStats().queued == 0) {
+            stats.slotsEmptied++;
+            doneSlotUtc = slot;
+            slotStartUtc = 0;
+            DEBUG_PRINTLN("Campaign: upload slot done");
+        }
+    } else if (slotStartUtc) {
+        doneSlotUtc = slotStartUtc; // Over with records left; the next slot takes them
+        slotStartUtc = 0;
+    }
+    wifiManagerSuspend(WIFI_SUSPEND_CAMPAIGN, slotStartUtc == 0);
+
+    stats.state = slotStartUtc ? CAMPAIGN_UPLOAD : window ? CAMPAIGN_ACQUIRE : CAMPAIGN_IDLE;
+    stats.nextEventInS = nextEvent(daySecond);
+    stats.sleepBlocked = sleepBlocker(nowMs, holdAwake, stats.nextEventInS);
+    if (stats.sleepBlocked) return;
+
+    // Returns only if logger mode refused; the ULP counts until the next event
+    loggerModeSetWakeAt(stats.nextEventInS ? utc + stats.nextEventInS - CAMPAIGN_WAKE_LEAD_S : 0);
+    DEBUG_PRINTF("Campaign: sleeping %lu s\n", (unsigned long)stats.nextEventInS);
+    sleepRefused = loggerModeEnter(CAMPAIGN_SLEEP_INTERVAL_S);
+    loggerModeSetWakeAt(0);
+    DEBUG_PRINTF("Campaign: not sleeping: %s\n", sleepRefused);
+}
+
+CampaignStats getCampaignStats() {
+    return stats;
+}
+
+const char* campaignStateName(uint8_t state) {
+    switch (state) {
+        case CAMPAIGN_OFF: return "off";
+        case CAMPAIGN_NO_TIME: return "waiting for UTC";
+        case CAMPAIGN_IDLE: return "between windows";
+        case CAMPAIGN_ACQUIRE: return "acquiring";
+        case CAMPAIGN_UPLOAD: return "upload slot";
+        default: return "?";
+    }
+}
+
+void printCampaign(Print& out) {
+    CampaignStats s = getCampaignStats();
+    char windows[CAMPAIGN_MAX_WINDOWS * 12];
+    char uploads[CAMPAIGN_MAX_UPLOADS * 6];
+    campaignFormatWindows(active, windows, sizeof(windows));
+    campaignFormatUploads(active, uploads, sizeof(uploads));
+    out.printf("Campaign: %s%s\n", campaignStateName(s.state),
+               s.state == CAMPAIGN_UPLOAD && s.windowOpen ? ", window open" : "");
+    out.printf("  Windows (UTC): %s\n", windows[0] ? windows : "none");
+    out.printf("  Upload slots (UTC): %s, %u s each\n", uploads[0] ? uploads : "none",
+               (unsigned)CAMPAIGN_UPLOAD_SLOT_S);
+    if (s.state < CAMPAIGN_IDLE) return;
+    out.printf("  Next event in %lu s; %lu windows, %lu slots (%lu emptied) since boot\n",
+               (unsigned long)s.nextEventInS, (unsigned long)s.windows, (unsigned long)s.slots,
+               (unsigned long)s.slotsEmptied);
+    if (s.state == CAMPAIGN_IDLE) out.printf("  Stays up: %s\n", s.sleepBlocked ? s.sleepBlocked : "no, sleeping");
+}
@@ -0,0 +1,93 @@
+#ifndef CAMPAIGN_H
+#define CAMPAIGN_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Scheduled acquisition campaigns for environmental monitoring.
+// A schedule holds acquisition windows ("06:00-08:00") and upload slots
+// ("08:05") in UTC time of day; a window may run past midnight. While it is
+// enabled and the time base has UTC, campaignLoop() holds the device to it:
+//  - in a window, measurement runs live at full resolution. The display is
+//    left to its usual timeout;
+//  - outside windows the display is turned off (a touch or an alarm still
+//    wakes it), and logger mode (logger_mode.h) takes over between events
+//    more than CAMPAIGN_MIN_SLEEP_S apart: the ULP counts in
+//    CAMPAIGN_SLEEP_INTERVAL_S intervals and the device wakes
+//    CAMPAIGN_WAKE_LEAD_S before the next window or slot. Without the ULP
+//    program, or while an alarm is active, the device stays up and keeps
+//    counting live;
+//  - the radio is off (wifiManagerSuspend()) except in upload slots, whether
+//    or not a window is open. A slot turns it on, flushes the telemetry ring
+//    and turns it off again when the queue is empty or the slot is over.
+// Records made in between queue where they always do: the history log, the
+// telemetry ring on flash and the logger backlog, which the next full boot
+// replays into both. The dashboard and /api/config are reachable only in
+// upload slots; the serial console always.
+//
+// The schedule is saved in Preferences ("campaign" namespace) and set
+// through /api/config (campaign_enabled, campaign_windows, campaign_uploads)
+// or "config set".
+
+struct CampaignWindow {
+    uint16_t startMin;        ///< Minute of the UTC day
+    uint16_t lengthMin;       ///< 1-1440
+};
+
+struct CampaignSchedule {
+    bool enabled;
+    uint8_t windowCount;
+    uint8_t uploadCount;
+    CampaignWindow windows[CAMPAIGN_MAX_WINDOWS];
+    uint16_t uploads[CAMPAIGN_MAX_UPLOADS];   ///< Minute of the UTC day a slot starts
+};
+
+enum CampaignState {
+    CAMPAIGN_OFF = 0,         ///< Not enabled
+    CAMPAIGN_NO_TIME,         ///< Enabled, waiting for UTC
+    CAMPAIGN_IDLE,            ///< Between windows
+    CAMPAIGN_ACQUIRE,         ///< In a window
+    CAMPAIGN_UPLOAD           ///< In an upload slot (a window may be open too)
+};
+
+struct CampaignStats {
+    uint8_t state;            ///< CampaignState
+    bool windowOpen;
+    uint32_t nextEventInS;    ///< To the next window start or slot; 0 without one
+    uint32_t windows;         ///< Windows entered since boot
+    uint32_t slots;           ///< Upload slots held since boot
+    uint32_t slotsEmptied;    ///< ... that ended with the telemetry queue empty
+    const char* sleepBlocked; ///< Why the device stays up outside windows; nullptr if it may sleep
+};
+
+// Parses "HH:MM-HH:MM,..." ("" for none) into @p schedule's windows.
+// @return nullptr, or why the text is refused
+const char* campaignParseWindows(const char* text, CampaignSchedule& schedule);
+
+// Parses "HH:MM,..." ("" for none) into @p schedule's upload slots.
+const char* campaignParseUploads(const char* text, CampaignSchedule& schedule);
+
+// The text forms the parsers accept.
+void campaignFormatWindows(const CampaignSchedule& schedule, char* out, size_t size);
+void campaignFormatUploads(const CampaignSchedule& schedule, char* out, size_t size);
+
+// Loads the saved schedule. Call once in setup().
+void initCampaign();
+
+CampaignSchedule campaignSchedule();
+
+// Saves @p schedule and follows it from the next loop pass. UI task.
+// @return false if it could not be stored
+bool campaignSetSchedule(const CampaignSchedule& schedule);
+
+// Holds the device to the schedule, once a second. @p holdAwake (an active
+// alarm) keeps it from sleeping. UI task loop.
+void campaignLoop(uint32_t nowMs, bool holdAwake);
+
+CampaignStats getCampaignStats();
+const char* campaignStateName(uint8_t state);
+
+// Schedule and state ("campaign").
+void printCampaign(Print& out);
+
+#endif // CAMPAIGN_H
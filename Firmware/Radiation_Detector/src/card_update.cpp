@@ -0,0 +1,288 @@
+/**
+ * @file card_update.cpp
+ * @brief Signed firmware image from the microSD card, streamed into the OTA partition.
+ *
+ * The reader (the caller) and the writer task pass two buffers back and forth
+ * through a pair of queues: the reader fills one from the card while the
+ * writer hands the other to esp_ota_write(). esp_ota_begin() with the image
+ * size erases the whole range first, so the writes only program flash and
+ * the erase time is not spent piece by piece between reads. A half-written
+ * partition never boots: it only becomes the boot partition after both
+ * digests matched.
+ */
+
+#include "card_update.h"
+#include "log_storage.h"
+#include "ota_guard.h"
+#include "dose_checkpoint.h"
+#include "settings_store.h"
+#include "debug.h"
+#include <FS.h>
+#include "esp_ota_ops.h"
+#include "esp_heap_caps.h"
+#include "mbedtls/pk.h"
+#include "mbedtls/sha256.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+
+static const uint32_t CARD_UPDATE_MAGIC = 0x31554452; ///< "RDU1"
+static const size_t   SIGNATURE_MAX = 72;
+static const char PUBLIC_KEY[] = CARD_UPDATE_PUBLIC_KEY;
+
+struct CardUpdateHeader {
+    uint32_t magic;
+    uint32_t imageSize;
+    uint8_t signatureLength;
+    uint8_t reserved[3];
+    uint8_t sha256[32];
+    uint8_t signature[SIGNATURE_MAX];
+    uint8_t reserved2[12];
+};
+
+static_assert(sizeof(CardUpdateHeader) == 128, "card update header is 128 bytes");
+
+struct Chunk {
+    uint8_t* data;      ///< nullptr: the writer has finished
+    size_t length;      ///< 0: no more data
+};
+
+static CardUpdateStatus status;
+static QueueHandle_t filledQueue = nullptr;
+static QueueHandle_t emptyQueue = nullptr;
+static volatile esp_err_t writeError = ESP_OK;
+
+static void fail(const char* error) {
+    status.state = CARD_UPDATE_FAILED;
+    strlcpy(status.error, error, sizeof(status.error));
+    DEBUG_PRINTF("Card update: %s\n", error);
+}
+
+/**
+ * @brief Checks the header's signature over the image digest against CARD_UPDATE_PUBLIC_KEY.
+ */
+static bool signatureValid(const CardUpdateHeader& header) {
+    if (header.signatureLength == 0 || header.signatureLength > SIGNATURE_MAX) return false;
+    mbedtls_pk_context key;
+    mbedtls_pk_init(&key);
+    // A PEM key is parsed with its terminator
+    int ret = mbedtls_pk_parse_public_key(&key, (const uint8_t*)PUBLIC_KEY, sizeof(PUBLIC_KEY));
+    if (!ret) {
+        ret = mbedtls_pk_verify(&key, MBEDTLS_MD_SHA256, header.sha256, sizeof(header.sha256), header.signature,
+                                header.signatureLength);
+    }
+    mbedtls_pk_free(&key);
+    return ret == 0;
+}
+
+/**
+ * @brief Writer task: programs the filled buffers in order and hands them back.
+ */
+static void writerTask(void* parameter) {
+    esp_ota_handle_t handle = *(esp_ota_handle_t*)parameter;
+    Chunk chunk;
+    for (;;) {
+        xQueueReceive(filledQueue, &chunk, portMAX_DELAY);
+        if (chunk.length == 0) break;
+        if (writeError == ESP_OK) writeError = esp_ota_write(handle, chunk.data, chunk.length);
+        xQueueSend(emptyQueue, &chunk, portMAX_DELAY);
+    }
+    Chunk done = {nullptr, 0};
+    xQueueSend(emptyQueue, &done, portMAX_DELAY);
+    vTaskDelete(NULL);
+}
+
+/**
+ * @brief Streams the image after the header from @p file into the OTA handle.
+ * @param digest SHA-256 of what was read
+ */
+static bool streamImage(File& file, esp_ota_handle_t handle, uint8_t* buffers[2], uint8_t* digest) {
+    filledQueue = xQueueCreate(2, sizeof(Chunk));
+    emptyQueue = xQueueCreate(3, sizeof(Chunk)); // Both buffers and the writer's end marker
+    if (!filledQueue || !emptyQueue) {
+        fail("no queues");
+        return false;
+    }
+    for (int i = 0; i < 2; i++) {
+        Chunk chunk = {buffers[i], 0};
+        xQueueSend(emptyQueue, &chunk, 0);
+    }
+    writeError = ESP_OK;
+    // On the other core from the caller (setup() or the serial task)
+    if (xTaskCreatePinnedToCore(writerTask, "CardUpdate", 4096, &handle, configMAX_PRIORITIES - 3, NULL,
+                                xPortGetCoreID() ? 0 : 1) != pdPASS) {
+        fail("no writer task");
+        return false;
+    }
+
+    mbedtls_sha256_context ctx;
+    mbedtls_sha256_init(&ctx);
+    mbedtls_sha256_starts_ret(&ctx, 0);
+    bool readOk = true;
+    Chunk chunk;
+    while (status.written < status.size && writeError == ESP_OK) {
+        xQueueReceive(emptyQueue, &chunk, portMAX_DELAY);
+        size_t want = status.size - status.written < CARD_UPDATE_CHUNK ? status.size - status.written
+                                                                        : CARD_UPDATE_CHUNK;
+        sdCardBegin();
+        chunk.length = file.read(chunk.data, want);
+        sdCardEnd();
+        if (chunk.length != want) {
+            readOk = false;
+            xQueueSend(emptyQueue, &chunk, 0); // Unused; the writer gets the end marker below
+            break;
+        }
+        mbedtls_sha256_update_ret(&ctx, chunk.data, chunk.length);
+        xQueueSend(filledQueue, &chunk, portMAX_DELAY);
+        status.written += chunk.length;
+    }
+    mbedtls_sha256_finish_ret(&ctx, digest);
+    mbedtls_sha256_free(&ctx);
+
+    // The end marker, then wait for the writer to finish the last buffer
+    Chunk end = {nullptr, 0};
+    xQueueSend(filledQueue, &end, portMAX_DELAY);
+    do {
+        xQueueReceive(emptyQueue, &chunk, portMAX_DELAY);
+    } while (chunk.data);
+    vQueueDelete(filledQueue);
+    vQueueDelete(emptyQueue);
+    filledQueue = emptyQueue = nullptr;
+
+    if (!readOk) fail("card read failed");
+    else if (writeError != ESP_OK) fail("flash write failed");
+    return readOk && writeError == ESP_OK;
+}
+
+/**
+ * @brief Writes, verifies and activates the image; the partition is claimed.
+ */
+static bool installImage(File& file, const CardUpdateHeader& header, const esp_partition_t* partition) {
+    uint8_t* buffers[2] = {nullptr, nullptr};
+    for (int i = 0; i < 2; i++) {
+        buffers[i] = (uint8_t*)heap_caps_malloc(CARD_UPDATE_CHUNK, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        if (!buffers[i]) buffers[i] = (uint8_t*)heap_caps_malloc(CARD_UPDATE_CHUNK, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    }
+    esp_ota_handle_t handle = 0;
+    bool ok = buffers[0] && buffers[1];
+    if (!ok) fail("no buffers");
+    if (ok && esp_ota_begin(partition, header.imageSize, &handle) != ESP_OK) {
+        fail("cannot start the OTA write");
+        ok = false;
+        handle = 0;
+    }
+
+    uint8_t digest[32];
+    if (ok) ok = streamImage(file, handle, buffers, digest);
+    if (ok && memcmp(digest, header.sha256, sizeof(digest)) != 0) {
+        fail("SHA-256 of the file mismatch");
+        ok = false;
+    }
+    if (handle) {
+        // esp_ota_end() checks the image format and its own checksum
+        if (ok && esp_ota_end(handle) != ESP_OK) {
+            fail("image not valid");
+            ok = false;
+        } else if (!ok) {
+            esp_ota_abort(handle);
+        }
+    }
+    if (ok && (!otaPartitionSha256(partition, header.imageSize, digest) ||
+               memcmp(digest, header.sha256, sizeof(digest)) != 0)) {
+        fail("read-back mismatch");
+        ok = false;
+    }
+    if (ok && esp_ota_set_boot_partition(partition) != ESP_OK) {
+        fail("cannot set the boot partition");
+        ok = false;
+    }
+    for (int i = 0; i < 2; i++) heap_caps_free(buffers[i]);
+    return ok;
+}
+
+/**
+ * @brief Renames the image so the next boot does not take it again.
+ */
+static void retireImage() {
+    sdCardBegin();
+    fs::FS& fs = sdCardFs();
+    if (fs.exists(CARD_UPDATE_PATH ".done")) fs.remove(CARD_UPDATE_PATH ".done");
+    fs.rename(CARD_UPDATE_PATH, CARD_UPDATE_PATH ".done");
+    sdCardEnd();
+}
+
+bool cardUpdateCheck() {
+    if (sizeof(PUBLIC_KEY) <= 1 || !sdCardMount()) return false;
+    if (status.state == CARD_UPDATE_WRITING || status.state == CARD_UPDATE_READY) return false;
+
+    sdCardBegin();
+    File file = sdCardFs().exists(CARD_UPDATE_PATH) ? sdCardFs().open(CARD_UPDATE_PATH, "r") : File();
+    size_t fileSize = file ? file.size() : 0;
+    CardUpdateHeader header;
+    bool headerRead = file && file.read((uint8_t*)&header, sizeof(header)) == sizeof(header);
+    sdCardEnd();
+    if (!file) return false;
+
+    memset(&status, 0, sizeof(status));
+    const esp_partition_t* partition = esp_ota_get_next_update_partition(NULL);
+    uint32_t startMs = millis();
+    bool ok = false;
+    if (!headerRead || header.magic != CARD_UPDATE_MAGIC || fileSize != sizeof(header) + header.imageSize) {
+        fail("not an update image");
+    } else if (!partition || header.imageSize > partition->size) {
+        fail("image larger than the partition");
+    } else if (!signatureValid(header)) {
+        fail("signature not valid");
+    } else {
+        status.size = header.imageSize;
+        uint8_t running[32];
+        if (otaPartitionSha256(esp_ota_get_running_partition(), header.imageSize, running) &&
+            memcmp(running, header.sha256, sizeof(running)) == 0) {
+            // Installed before and not renamed (or rolled back to): nothing to do
+            status.state = CARD_UPDATE_CURRENT;
+            retireImage();
+        } else if (!otaPartitionClaim(OTA_OWNER_CARD)) {
+            fail("OTA partition busy");
+        } else {
+            status.state = CARD_UPDATE_WRITING;
+            DEBUG_PRINTF("Card update: installing %lu bytes into %s\n", (unsigned long)header.imageSize,
+                         partition->label);
+            ok = installImage(file, header, partition);
+            if (!ok) otaPartitionRelease(OTA_OWNER_CARD);
+        }
+    }
+    sdCardBegin();
+    file.close();
+    sdCardEnd();
+    status.elapsedMs = millis() - startMs;
+    if (!ok) return false;
+
+    status.state = CARD_UPDATE_READY;
+    retireImage();
+    DEBUG_PRINTF("Card update: %lu bytes verified in %lu ms, restarting\n", (unsigned long)status.size,
+                 (unsigned long)status.elapsedMs);
+    settingsFlush();
+    doseCheckpointSave();
+    debugLogFlush(200);
+    ESP.restart();
+    return true;
+}
+
+CardUpdateStatus getCardUpdateStatus() {
+    return status;
+}
+
+void printCardUpdate(Print& out) {
+    static const char* const NAMES[] = {"no image", "image is the running firmware", "writing", "ready",
+                                        "failed"};
+    CardUpdateStatus s = getCardUpdateStatus();
+    out.printf("Card update: %s (%s)\n", s.state <= CARD_UPDATE_FAILED ? NAMES[s.state] : "?",
+               sizeof(PUBLIC_KEY) > 1 ? CARD_UPDATE_PATH : "no CARD_UPDATE_PUBLIC_KEY");
+    if (s.size) {
+        out.printf("  %lu of %lu bytes in %lu ms", (unsigned long)s.written, (unsigned long)s.size,
+                   (unsigned long)s.elapsedMs);
+        if (s.written && s.elapsedMs) out.printf(", %.2f MB/s", s.written / 1048.576 / s.elapsedMs);
+        out.println();
+    }
+    if (s.error[0]) out.printf("  error: %s\n", s.error);
+}
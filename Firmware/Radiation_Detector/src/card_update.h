@@ -0,0 +1,50 @@
+#ifndef CARD_UPDATE_H
+#define CARD_UPDATE_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Firmware update from a file on the microSD card, for the field without a
+// network. At boot, once the card can be mounted and before the web stack
+// starts, CARD_UPDATE_PATH is checked:
+//   - the file is a 128-byte header {"RDU1", u32 image size, u8 signature
+//     length, 3 reserved, SHA-256 of the image, DER ECDSA P-256 signature of
+//     that digest padded to 72 bytes, 12 reserved} and the image, built by
+//     tools/make_card_update.py;
+//   - the signature is checked against CARD_UPDATE_PUBLIC_KEY before anything
+//     is written, and an image equal to the running one is skipped;
+//   - the image is read in CARD_UPDATE_CHUNK pieces into two buffers in turn,
+//     while a writer task on the other core programs the previous piece into
+//     the passive app partition (erased in one go beforehand), so the card
+//     and the flash work at the same time;
+//   - the digest of what was read and of the partition read back must both
+//     match the signed one; then the file is renamed to CARD_UPDATE_PATH
+//     ".done", the dose is checkpointed and the unit restarts into the image,
+//     which is confirmed or rolled back like any update (ota_guard.h).
+
+enum CardUpdateState {
+    CARD_UPDATE_NONE = 0,     ///< No image on the card (or the check is off)
+    CARD_UPDATE_CURRENT,      ///< The image is the running firmware
+    CARD_UPDATE_WRITING,
+    CARD_UPDATE_READY,        ///< Verified, restarting
+    CARD_UPDATE_FAILED
+};
+
+struct CardUpdateStatus {
+    uint8_t state;            ///< CardUpdateState
+    uint32_t size;            ///< Image bytes
+    uint32_t written;
+    uint32_t elapsedMs;       ///< Signature check to verified read-back
+    char error[40];
+};
+
+// Installs a signed image from the card and restarts; returns if there is
+// none or it was refused. setup(), after initTFT() (the card shares its bus)
+// and the dose restore; or "cardupdate run".
+bool cardUpdateCheck();
+
+CardUpdateStatus getCardUpdateStatus();
+
+void printCardUpdate(Print& out);
+
+#endif // CARD_UPDATE_H
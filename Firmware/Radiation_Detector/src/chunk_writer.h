@@ -0,0 +1,60 @@
+#ifndef CHUNK_WRITER_H
+#define CHUNK_WRITER_H
+
+#include <Arduino.h>
+#include <WebServer.h>
+#include <stdarg.h>
+#include "supervisor.h"
+
+// Print adapter for streamed HTTP bodies: output is collected in a 1 KB
+// buffer on the caller's stack and sent as one chunk (or one sendContent()
+// of a body with a known length) whenever it fills. A whole export never
+// exists in RAM at once. The caller sends the headers first, flushes at the
+// end and, for chunked transfer encoding, the terminating empty chunk.
+
+#define CHUNK_WRITER_SIZE 1024
+
+class ChunkWriter : public Print {
+public:
+    explicit ChunkWriter(WebServer& server) : server_(server), length_(0) {}
+
+    void printf(const char* format, ...) __attribute__((format(printf, 2, 3))) {
+        if (CHUNK_WRITER_SIZE - length_ < 96) flush();
+        va_list args;
+        va_start(args, format);
+        size_t room = CHUNK_WRITER_SIZE - length_;
+        int n = vsnprintf(buffer_ + length_, room, format, args);
+        va_end(args);
+        // Lines are far shorter than the 96 bytes kept free, so nothing is cut
+        if (n > 0 && (size_t)n < room) length_ += n;
+    }
+
+    size_t write(uint8_t byte) override {
+        return write(&byte, 1);
+    }
+
+    size_t write(const uint8_t* data, size_t size) override {
+        for (size_t done = 0; done < size;) {
+            if (length_ == CHUNK_WRITER_SIZE) flush();
+            size_t n = size - done < CHUNK_WRITER_SIZE - length_ ? size - done : CHUNK_WRITER_SIZE - length_;
+            memcpy(buffer_ + length_, data + done, n);
+            length_ += n;
+            done += n;
+        }
+        return size;
+    }
+
+    void flush() override {
+        if (length_ == 0) return;
+        server_.sendContent(buffer_, length_);
+        length_ = 0;
+        supervisorHeartbeat(); // A long export is progress, not a stalled web task
+    }
+
+private:
+    WebServer& server_;
+    char buffer_[CHUNK_WRITER_SIZE];
+    size_t length_;
+};
+
+#endif // CHUNK_WRITER_H
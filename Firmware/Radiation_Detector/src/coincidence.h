@@ -0,0 +1,71 @@
+#ifndef COINCIDENCE_H
+#define COINCIDENCE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Coincidence tagging of scintillation pulses against Geiger pulses.
+// Both streams carry 32-bit esp_timer microsecond stamps (wrapping every ~71
+// minutes; all comparisons use signed differences). No Arduino dependencies
+// (host-compilable).
+
+enum CoincidenceMode {
+    COINCIDENCE_OFF = 0,     ///< Tag only; every scintillation pulse is binned
+    COINCIDENCE_VETO = 1,    ///< Anti-coincidence: drop pulses seen by both detectors (muons)
+    COINCIDENCE_REQUIRE = 2  ///< Bin only pulses seen by both detectors
+};
+
+/**
+ * @brief Sliding window of recent Geiger timestamps for classifying scintillation pulses.
+ *
+ * The Geiger stream reaches the pulse task within microseconds of the edge, the
+ * scintillation stream a DMA frame or more later. A pulse at time t can only be
+ * classified once every Geiger pulse up to t + window is known, so the caller
+ * advances a watermark after each Geiger drain and holds back pulses that
+ * classify() reports as undecided; latency is bounded by one poll interval.
+ */
+class CoincidenceGate {
+public:
+    static const size_t HISTORY = 32; ///< Geiger stamps kept; ample below ~10 kcps
+
+    explicit CoincidenceGate(uint32_t windowUs = 100)
+        : windowUs_(windowUs), head_(0), count_(0), watermarkUs_(0) {}
+
+    void setWindow(uint32_t windowUs) { windowUs_ = windowUs; }
+    uint32_t window() const { return windowUs_; }
+
+    /// Adds a Geiger timestamp (non-decreasing order).
+    void addReference(uint32_t timestampUs) {
+        refs_[head_] = timestampUs;
+        head_ = (head_ + 1) % HISTORY;
+        if (count_ < HISTORY) count_++;
+    }
+
+    /// Declares that every Geiger pulse stamped before @p timestampUs has been added.
+    void setWatermark(uint32_t timestampUs) { watermarkUs_ = timestampUs; }
+
+    /**
+     * @brief Classifies a scintillation pulse at @p timestampUs.
+     * @return 1 if a Geiger pulse lies within +-window, 0 if none does, -1 if not decidable yet
+     */
+    int classify(uint32_t timestampUs) const {
+        if ((int32_t)(watermarkUs_ - (timestampUs + windowUs_)) < 0) return -1;
+        // Newest first: once a stamp is older than t - window, all further ones are too
+        for (size_t i = 0; i < count_; i++) {
+            uint32_t ref = refs_[(head_ + HISTORY - 1 - i) % HISTORY];
+            int32_t delta = (int32_t)(timestampUs - ref);
+            if (delta <= (int32_t)windowUs_ && delta >= -(int32_t)windowUs_) return 1;
+            if (delta > (int32_t)windowUs_) break;
+        }
+        return 0;
+    }
+
+private:
+    uint32_t windowUs_;
+    uint32_t refs_[HISTORY];
+    size_t head_;
+    size_t count_;
+    uint32_t watermarkUs_;
+};
+
+#endif // COINCIDENCE_H
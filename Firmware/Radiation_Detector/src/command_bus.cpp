@@ -0,0 +1,52 @@
+/**
+ * @file command_bus.cpp
+ * @brief One FreeRTOS queue of Command values per owner task.
+ *
+ * Commands are copied into the queue, so the poster's buffer can go out of
+ * scope right away. The statistics are plain counters; two tasks posting in
+ * the same instant may lose an increment, which only skews the report.
+ */
+
+#include "command_bus.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+
+static QueueHandle_t queues[COMMAND_TARGET_COUNT] = {};
+static CommandBusStats stats;
+
+bool initCommandBus() {
+    for (uint8_t t = 0; t < COMMAND_TARGET_COUNT; t++) {
+        if (queues[t]) continue;
+        queues[t] = xQueueCreate(COMMAND_QUEUE_LENGTH, sizeof(Command));
+        if (!queues[t]) return false;
+    }
+    return true;
+}
+
+bool commandPost(CommandTarget target, const Command& command) {
+    if (target >= COMMAND_TARGET_COUNT || !queues[target]) return false;
+    if (xQueueSend(queues[target], &command, 0) != pdTRUE) {
+        stats.dropped[target]++;
+        return false;
+    }
+    stats.posted[target]++;
+    return true;
+}
+
+bool commandReceive(CommandTarget target, Command& command) {
+    if (target >= COMMAND_TARGET_COUNT || !queues[target]) return false;
+    return xQueueReceive(queues[target], &command, 0) == pdTRUE;
+}
+
+CommandBusStats getCommandBusStats() {
+    return stats;
+}
+
+void printCommandBus(Print& out) {
+    static const char* names[COMMAND_TARGET_COUNT] = {"pulse"};
+    CommandBusStats s = getCommandBusStats();
+    for (uint8_t t = 0; t < COMMAND_TARGET_COUNT; t++) {
+        out.printf("Commands to %s: %lu posted, %lu dropped, %u waiting\n", names[t], (unsigned long)s.posted[t],
+                   (unsigned long)s.dropped[t], queues[t] ? (unsigned)uxQueueMessagesWaiting(queues[t]) : 0u);
+    }
+}
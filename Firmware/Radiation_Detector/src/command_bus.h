@@ -0,0 +1,61 @@
+#ifndef COMMAND_BUS_H
+#define COMMAND_BUS_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Typed commands to the task that owns a piece of state.
+// Serial commands run on uiTask, HTTP handlers on the web task; neither
+// writes state another task works on. They post a command to the owner's
+// queue instead, and the owner applies it at the top of its next pass, in
+// order. What the owner computes goes the other way as a SeqLock snapshot
+// (pulse snapshot, alarm status, dose values), so every piece of shared state
+// has exactly one writer.
+//
+// Posting never blocks; a full queue drops the command and counts it.
+
+enum CommandTarget {
+    COMMAND_TARGET_PULSE = 0,   ///< pulseTask: coincidence gate, pulse latency and width statistics, injection, tube health, anomaly detector
+    COMMAND_TARGET_COUNT
+};
+
+enum CommandType {
+    COMMAND_SET_COINCIDENCE = 1,  ///< arg.coincidence
+    COMMAND_RESET_LATENCY,        ///< No argument
+    COMMAND_RESET_PULSE_WIDTH,    ///< No argument
+    COMMAND_SET_INJECTING,        ///< arg.injecting
+    COMMAND_RESET_TUBE_HEALTH,    ///< No argument
+    COMMAND_RESET_ANOMALY,        ///< No argument
+};
+
+struct Command {
+    uint8_t type;   ///< CommandType
+    union {
+        struct {
+            uint8_t mode;        ///< CoincidenceMode
+            uint32_t windowUs;   ///< 0: keep the current window
+        } coincidence;
+        bool injecting;          ///< The counts come from the pulse injector
+    } arg;
+};
+
+struct CommandBusStats {
+    uint32_t posted[COMMAND_TARGET_COUNT];
+    uint32_t dropped[COMMAND_TARGET_COUNT];   ///< Queue full
+};
+
+// Creates the queues. Call in setup() before the owners and posters run.
+bool initCommandBus();
+
+// Any task. @return false if the queue is full (or not created)
+bool commandPost(CommandTarget target, const Command& command);
+
+// Owner task only; never blocks. @return false if nothing is queued
+bool commandReceive(CommandTarget target, Command& command);
+
+CommandBusStats getCommandBusStats();
+
+// One line per queue: posted, dropped and waiting commands ("perf").
+void printCommandBus(Print& out);
+
+#endif // COMMAND_BUS_H
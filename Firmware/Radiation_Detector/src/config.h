@@ -0,0 +1,2181 @@
+#ifndef CONFIG_H
+#define CONFIG_H
+
+// Build-time configuration for the Radiation Detector firmware.
+// Every option can be overridden from the build environment with -D<NAME>=<value>.
+
+// Task topology. The WiFi and lwIP tasks of the prebuilt SDK run on core 0 at
+// high priority, so the measurement and the UI go to core 1 and everything
+// network-bound (web server, SD log, telemetry, fleet OTA) stays on core 0 at
+// low priority. On the measurement core a minimal sampling task reads PCNT
+// (every PULSE_POLL_MS, or as pulses arrive) above everything else; pulseTask
+// processes the readings below the HV regulation and above the UI. TASK_CORE_NETWORK should name the
+// core the SDK's WiFi task is pinned to. "latency" shows the sampling jitter.
+#ifndef TASK_CORE_MEASUREMENT
+#define TASK_CORE_MEASUREMENT 1
+#endif
+
+#ifndef TASK_CORE_UI
+#define TASK_CORE_UI 1
+#endif
+
+#ifndef TASK_CORE_NETWORK
+#define TASK_CORE_NETWORK 0
+#endif
+
+#ifndef PULSE_POLL_MS
+#define PULSE_POLL_MS 50
+#endif
+
+// Event-driven sampling: instead of reading PCNT every PULSE_POLL_MS, the
+// sampling task sleeps until PULSE_EVENT_COUNTS pulses have arrived (the PCNT
+// limit event) or the 1-second bucket is due, whichever comes first, and reads
+// no more often than every PULSE_POLL_MS. At background rates it wakes about
+// once a second; at high rates as often as with polling. 0 polls at the fixed
+// period. The alarms then follow at most one second behind a low rate, and
+// within PULSE_EVENT_COUNTS pulses of a high one.
+#ifndef PULSE_EVENT_WAKE
+#define PULSE_EVENT_WAKE 1
+#endif
+
+#ifndef PULSE_EVENT_COUNTS
+#define PULSE_EVENT_COUNTS 64
+#endif
+
+#ifndef PULSE_SAMPLE_PRIORITY
+#define PULSE_SAMPLE_PRIORITY 10
+#endif
+
+#ifndef HV_CONTROL_PRIORITY
+#define HV_CONTROL_PRIORITY 4
+#endif
+
+#ifndef PULSE_PROCESS_PRIORITY
+#define PULSE_PROCESS_PRIORITY 3
+#endif
+
+#ifndef UI_TASK_PRIORITY
+#define UI_TASK_PRIORITY 1
+#endif
+
+#ifndef NETWORK_TASK_PRIORITY
+#define NETWORK_TASK_PRIORITY 1
+#endif
+
+// Per-pulse timestamp capture: a GPIO interrupt on the Geiger input pushes a
+// microsecond timestamp for each pulse into a lock-free ring drained by pulseTask.
+// The PCNT counter stays the authoritative count; capture adds inter-arrival data.
+#ifndef PULSE_CAPTURE_ENABLED
+#define PULSE_CAPTURE_ENABLED 1
+#endif
+
+// Capacity of the timestamp ring (power of two). At 50 ms drain intervals
+// 1024 entries absorb bursts of ~20 kcps before timestamps are dropped.
+#ifndef PULSE_CAPTURE_RING_SIZE
+#define PULSE_CAPTURE_RING_SIZE 1024
+#endif
+
+// Times every window in which flash operations turn the cache off
+// (flash_stall.h) and counts the pulses captured meanwhile ("latency").
+#ifndef FLASH_STALL_MONITOR
+#define FLASH_STALL_MONITOR 1
+#endif
+
+// Default GM tube dead time (tau) in microseconds for the non-paralyzable
+// correction, from the tube profile (TUBE_MODEL, tube_profile.h); tune per tube
+// via the "deadtime" serial command, which stores the value in Preferences
+// ("settings/deadTimeUs").
+#ifndef DEAD_TIME_DEFAULT_US
+#define DEAD_TIME_DEFAULT_US (ActiveTube::DEAD_TIME_US)
+#endif
+
+// Persistent history log on the microSD card (display SPI bus or SDMMC), or
+// on internal flash on a unit without one (HISTORY_LOG_STORAGE).
+// One 16-byte record per second is appended in 512-byte blocks, ~1.4 MB per day.
+#ifndef HISTORY_LOG_ENABLED
+#define HISTORY_LOG_ENABLED 1
+#endif
+
+#ifndef SD_CS_PIN
+#define SD_CS_PIN 5
+#endif
+
+#ifndef SD_SPI_FREQUENCY
+#define SD_SPI_FREQUENCY 20000000
+#endif
+
+#ifndef HISTORY_LOG_PATH
+#define HISTORY_LOG_PATH "/rdlog.bin"
+#endif
+
+// Medium of the history log (log_storage.h): 0 = the first that starts of the
+// microSD card, the raw flash partition HISTORY_LOG_PARTITION (not in the
+// default partitions.csv) and LittleFS; 1 = the card only, 2 = the partition
+// only, 3 = LittleFS only. On LittleFS the log leaves HISTORY_LOG_FLASH_RESERVE
+// bytes to the telemetry queue, spectrum sessions and pulse traces.
+#ifndef HISTORY_LOG_STORAGE
+#define HISTORY_LOG_STORAGE 0
+#endif
+
+#ifndef HISTORY_LOG_PARTITION
+#define HISTORY_LOG_PARTITION "rdlog"
+#endif
+
+#ifndef HISTORY_LOG_FLASH_RESERVE
+#define HISTORY_LOG_FLASH_RESERVE (1024 * 1024)
+#endif
+
+// Records buffered between pulseTask and the logger task (one per second).
+// 64 entries ride out ~1 minute of a stalled card before records are dropped.
+#ifndef HISTORY_LOG_QUEUE_DEPTH
+#define HISTORY_LOG_QUEUE_DEPTH 64
+#endif
+
+// Card interface of the history log: 0 = SPI, on the display's bus (every
+// access arbitrated by spi_bus.h); 1 = the SDMMC peripheral, for boards that
+// wire the card to it. SDMMC_D1..D3 at -1 select the 1-bit bus, otherwise 4-bit.
+#ifndef HISTORY_LOG_SDMMC
+#define HISTORY_LOG_SDMMC 0
+#endif
+
+#ifndef SDMMC_CLK_PIN
+#define SDMMC_CLK_PIN 39
+#endif
+
+#ifndef SDMMC_CMD_PIN
+#define SDMMC_CMD_PIN 38
+#endif
+
+#ifndef SDMMC_D0_PIN
+#define SDMMC_D0_PIN 40
+#endif
+
+#ifndef SDMMC_D1_PIN
+#define SDMMC_D1_PIN -1
+#endif
+
+#ifndef SDMMC_D2_PIN
+#define SDMMC_D2_PIN -1
+#endif
+
+#ifndef SDMMC_D3_PIN
+#define SDMMC_D3_PIN -1
+#endif
+
+#ifndef SDMMC_FREQ_KHZ
+#define SDMMC_FREQ_KHZ 40000
+#endif
+
+// Write-behind buffer of the history log (PSRAM, a multiple of 512 bytes).
+// Sealed blocks collect there and go to the card as one sector-aligned write
+// of HISTORY_LOG_WRITE_CHUNK bytes, followed by one sync; blocks older than
+// HISTORY_LOG_SYNC_S are written early, which bounds what a power cut can
+// lose. On SPI a write holds the bus for at most HISTORY_LOG_SPI_SLICE bytes
+// at a time, so a display flush waits for one slice, not the whole chunk.
+#ifndef HISTORY_LOG_WRITE_BUFFER
+#define HISTORY_LOG_WRITE_BUFFER 32768
+#endif
+
+#ifndef HISTORY_LOG_WRITE_CHUNK
+#define HISTORY_LOG_WRITE_CHUNK 16384
+#endif
+
+#ifndef HISTORY_LOG_SYNC_S
+#define HISTORY_LOG_SYNC_S 300
+#endif
+
+#ifndef HISTORY_LOG_SPI_SLICE
+#define HISTORY_LOG_SPI_SLICE 4096
+#endif
+
+// Retention of the history log, per resolution (log_compaction.h). A job folds
+// the 1 s log into 1-minute and then 1-hour summaries (counts, live seconds,
+// min/max per-second count) in files of their own. Each resolution is a ring
+// of HISTORY_LOG_*_DAYS that reuses its oldest sectors in order once full; 0
+// keeps a resolution without limit. The 1 s ring is sized for a busy log
+// (~300 records per block) and must hold more than a day, from which the
+// open summaries are rebuilt after a reset. A changed 1 s retention applies
+// to a log that has not wrapped yet or to a new one.
+#ifndef HISTORY_LOG_RAW_DAYS
+#define HISTORY_LOG_RAW_DAYS 30
+#endif
+
+#ifndef HISTORY_LOG_MINUTE_DAYS
+#define HISTORY_LOG_MINUTE_DAYS 400
+#endif
+
+#ifndef HISTORY_LOG_HOUR_DAYS
+#define HISTORY_LOG_HOUR_DAYS 0
+#endif
+
+// Compaction runs one step per HISTORY_COMPACT_STEP_MS on the job wheel: one
+// 1 s block is read and the summary sectors it fills are written, so a step
+// holds the card for a few sector transfers. Summaries not filling a sector
+// are written in place every HISTORY_COMPACT_SYNC_S.
+#ifndef HISTORY_COMPACT_STEP_MS
+#define HISTORY_COMPACT_STEP_MS 250
+#endif
+
+#ifndef HISTORY_COMPACT_SYNC_S
+#define HISTORY_COMPACT_SYNC_S 3600
+#endif
+
+// Read-only USB drive with the history log (usb_drive.h). Needs TinyUSB on the
+// native port (ARDUINO_USB_MODE=0, "USB-OTG"), so it is off by default. With
+// USB_DRIVE_SHOWN the drive is present from boot; otherwise "usbdrive on".
+#ifndef USB_DRIVE_ENABLED
+#define USB_DRIVE_ENABLED 0
+#endif
+
+#ifndef USB_DRIVE_SHOWN
+#define USB_DRIVE_SHOWN 0
+#endif
+
+// Server-Sent Events stream at /events. Each client keeps one socket open, so
+// the count is bounded well below the lwIP socket limit (10 by default).
+#ifndef LIVE_EVENTS_MAX_CLIENTS
+#define LIVE_EVENTS_MAX_CLIENTS 4
+#endif
+
+// Minimum spacing of "rate" events; a value is pushed only if it changed.
+#ifndef LIVE_EVENTS_RATE_INTERVAL_MS
+#define LIVE_EVENTS_RATE_INTERVAL_MS 1000
+#endif
+
+// HTTPS front end (https_service.h): TLS 1.2 with an ECDSA P-256 certificate
+// on HTTPS_PORT, passed through to the HTTP server. Every TLS connection
+// holds about 20 KB of record buffers, so HTTPS_MAX_LINKS stays small. Idle
+// keep-alive connections are closed after HTTPS_IDLE_TIMEOUT_MS, or earlier
+// when a new client needs the slot. A session ticket, or an entry of the
+// HTTPS_SESSION_CACHE, lets a client resume within HTTPS_SESSION_LIFETIME_S
+// without the ECDHE and ECDSA operations. HTTPS_ONLY redirects plain HTTP
+// requests from the network to HTTPS.
+#ifndef HTTPS_ENABLED
+#define HTTPS_ENABLED 0
+#endif
+
+#ifndef HTTPS_ONLY
+#define HTTPS_ONLY 0
+#endif
+
+#ifndef HTTPS_PORT
+#define HTTPS_PORT 443
+#endif
+
+#ifndef HTTPS_MAX_LINKS
+#define HTTPS_MAX_LINKS 3
+#endif
+
+#ifndef HTTPS_IDLE_TIMEOUT_MS
+#define HTTPS_IDLE_TIMEOUT_MS 30000
+#endif
+
+#ifndef HTTPS_SESSION_CACHE
+#define HTTPS_SESSION_CACHE 8
+#endif
+
+#ifndef HTTPS_SESSION_LIFETIME_S
+#define HTTPS_SESSION_LIFETIME_S 86400
+#endif
+
+// Web API rate limits per client address (web_rate_limit.h). API requests
+// refill at WEB_RATE_API_PER_MIN with WEB_RATE_API_BURST in reserve. That
+// covers a dashboard page load plus 5 s polling, but holds a 10 Hz scraper to
+// 2 requests a second. Bulk exports get WEB_RATE_BULK_PER_MIN and
+// WEB_RATE_BULK_BURST. They are also refused for WEB_RATE_OTA_RETRY_S while a
+// firmware upload runs. The dashboard page and OTA are never limited.
+// WEB_RATE_CLIENTS addresses are tracked at a time.
+#ifndef WEB_RATE_LIMIT_ENABLED
+#define WEB_RATE_LIMIT_ENABLED 1
+#endif
+
+#ifndef WEB_RATE_CLIENTS
+#define WEB_RATE_CLIENTS 16
+#endif
+
+#ifndef WEB_RATE_API_PER_MIN
+#define WEB_RATE_API_PER_MIN 120
+#endif
+
+#ifndef WEB_RATE_API_BURST
+#define WEB_RATE_API_BURST 20
+#endif
+
+#ifndef WEB_RATE_BULK_PER_MIN
+#define WEB_RATE_BULK_PER_MIN 6
+#endif
+
+#ifndef WEB_RATE_BULK_BURST
+#define WEB_RATE_BULK_BURST 3
+#endif
+
+#ifndef WEB_RATE_OTA_RETRY_S
+#define WEB_RATE_OTA_RETRY_S 30
+#endif
+
+// Telemetry upload in InfluxDB line protocol (URL/token set with the "telemetry"
+// serial command). One record per 3-minute chart interval is kept in a ring file
+// on the internal flash: 4096 records (64 KB) cover ~8 days offline.
+#ifndef TELEMETRY_ENABLED
+#define TELEMETRY_ENABLED 1
+#endif
+
+#ifndef TELEMETRY_QUEUE_PATH
+#define TELEMETRY_QUEUE_PATH "/telemetry.q"
+#endif
+
+#ifndef TELEMETRY_QUEUE_CAPACITY
+#define TELEMETRY_QUEUE_CAPACITY 4096
+#endif
+
+// Records per upload (20 = one hour of intervals) and the longest a record waits
+// for its batch to fill; in between the radio stays idle.
+#ifndef TELEMETRY_BATCH_RECORDS
+#define TELEMETRY_BATCH_RECORDS 20
+#endif
+
+#ifndef TELEMETRY_FLUSH_INTERVAL_S
+#define TELEMETRY_FLUSH_INTERVAL_S 3600
+#endif
+
+// Records held in RAM until NTP provides wall-clock time (~1.5 h of intervals).
+#ifndef TELEMETRY_RAM_QUEUE_DEPTH
+#define TELEMETRY_RAM_QUEUE_DEPTH 32
+#endif
+
+// Performance block (telemetryPerf) queued every TELEMETRY_PERF_INTERVAL_S
+// (0: none) and sent as a "radiation_perf" line tagged with the firmware
+// version, so a regression shows on the fleet dashboard within the hour of a
+// rollout. One 24-byte ring slot each: 96 a day.
+#ifndef TELEMETRY_PERF_INTERVAL_S
+#define TELEMETRY_PERF_INTERVAL_S 900
+#endif
+
+// Survey GPS (gps_survey.h): NMEA receiver on UART GPS_UART_NUM; GPS_RX_PIN -1
+// means none. Any update rate up to 10 Hz; GPS_FIX_HISTORY keeps 1.6 s of fixes
+// at 10 Hz to match seconds against. Without GST sentences the horizontal
+// accuracy is HDOP times GPS_UERE_M.
+#ifndef GPS_RX_PIN
+#define GPS_RX_PIN -1
+#endif
+
+#ifndef GPS_TX_PIN
+#define GPS_TX_PIN -1
+#endif
+
+#ifndef GPS_UART_NUM
+#define GPS_UART_NUM 1
+#endif
+
+#ifndef GPS_BAUD
+#define GPS_BAUD 9600
+#endif
+
+#ifndef GPS_FIX_HISTORY
+#define GPS_FIX_HISTORY 16
+#endif
+
+#ifndef GPS_FIX_MAX_AGE_MS
+#define GPS_FIX_MAX_AGE_MS 1500
+#endif
+
+#ifndef GPS_UERE_M
+#define GPS_UERE_M 5.0f
+#endif
+
+// Survey records: one CSV line per geo-tagged second in SURVEY_LOG_PATH on the
+// SD card, written every SURVEY_LOG_FLUSH_S; one telemetry point per
+// SURVEY_TELEMETRY_S seconds (0: none). GPS_SURVEY_ON_BOOT 0 waits for
+// "survey on".
+#ifndef GPS_SURVEY_ON_BOOT
+#define GPS_SURVEY_ON_BOOT 1
+#endif
+
+#ifndef SURVEY_LOG_PATH
+#define SURVEY_LOG_PATH "/survey.csv"
+#endif
+
+#ifndef SURVEY_LOG_FLUSH_S
+#define SURVEY_LOG_FLUSH_S 30
+#endif
+
+#ifndef SURVEY_TELEMETRY_S
+#define SURVEY_TELEMETRY_S 10
+#endif
+
+// Breadcrumb track (survey_track_view.h): the last SURVEY_TRACK_POINTS
+// positions (12 bytes each, PSRAM; 4096 is over an hour at 1 s). SHOWN 1 opens
+// the 24 h chart screen on the track.
+#ifndef SURVEY_TRACK_POINTS
+#define SURVEY_TRACK_POINTS 4096
+#endif
+
+#ifndef SURVEY_TRACK_SHOWN
+#define SURVEY_TRACK_SHOWN 0
+#endif
+
+// Gamma spectroscopy on the optional CsI(Tl) + SiPM probe. The shaped pulse is
+// sampled by ADC1 in continuous (DMA) mode; pulse heights are binned into a
+// SPECTRUM_CHANNELS histogram in PSRAM.
+#ifndef SPECTRUM_ENABLED
+#define SPECTRUM_ENABLED 1
+#endif
+
+// Must be an ADC1 pin (GPIO 1-10 on the ESP32-S3).
+#ifndef SPECTRUM_ADC_PIN
+#define SPECTRUM_ADC_PIN 4
+#endif
+
+// ADC1 continuous mode tops out at ~83 kS/s on the S3.
+#ifndef SPECTRUM_SAMPLE_RATE
+#define SPECTRUM_SAMPLE_RATE 80000
+#endif
+
+// Histogram channels (power of two); 1024 channels = 4 ADC codes each.
+#ifndef SPECTRUM_CHANNELS
+#define SPECTRUM_CHANNELS 1024
+#endif
+
+// DMA frame size: 1024 bytes = 256 samples = 3.2 ms at 80 kS/s.
+#ifndef SPECTRUM_ADC_FRAME_BYTES
+#define SPECTRUM_ADC_FRAME_BYTES 1024
+#endif
+
+// Sample source of the spectrum channel (spectrum_source.h): 0 the ADC1
+// settings above, 1 an external parallel ADC clocked through the LCD_CAM
+// peripheral in camera mode, its words streamed by DMA into a PSRAM ring.
+// The shaping, pile-up and live-time settings apply to either; their times
+// are converted at the source's sample rate.
+#ifndef SPECTRUM_SOURCE
+#define SPECTRUM_SOURCE 0
+#endif
+
+// External ADC: conversion clock (160 MHz / an integer >= 2, output on CLK_PIN)
+// and resolution (at most 12 bits, on data lines D0 upwards).
+#ifndef SPECTRUM_CAM_SAMPLE_RATE
+#define SPECTRUM_CAM_SAMPLE_RATE 5000000
+#endif
+
+#ifndef SPECTRUM_CAM_BITS
+#define SPECTRUM_CAM_BITS 12
+#endif
+
+// External ADC pins. PCLK_PIN -1 samples the data on the clock the ESP
+// drives out of CLK_PIN (looped back inside the GPIO matrix); otherwise it is
+// the converter's data-ready output. DATA_PINS lists D0 upwards, SPECTRUM_CAM_BITS
+// entries. PCLK_INVERT 1 latches on the falling edge instead of the rising one.
+#ifndef SPECTRUM_CAM_CLK_PIN
+#define SPECTRUM_CAM_CLK_PIN -1
+#endif
+
+#ifndef SPECTRUM_CAM_PCLK_PIN
+#define SPECTRUM_CAM_PCLK_PIN -1
+#endif
+
+#ifndef SPECTRUM_CAM_PCLK_INVERT
+#define SPECTRUM_CAM_PCLK_INVERT 0
+#endif
+
+#ifndef SPECTRUM_CAM_DATA_PINS
+#define SPECTRUM_CAM_DATA_PINS {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}
+#endif
+
+// PSRAM ring of the external ADC: NODES DMA buffers of 2016 samples each
+// (64 x 4032 B = 252 KB, 26 ms at 5 MS/s). The acquisition task must keep up
+// on average; the ring absorbs its scheduling delays.
+#ifndef SPECTRUM_CAM_RING_NODES
+#define SPECTRUM_CAM_RING_NODES 64
+#endif
+
+// Discriminator threshold in ADC codes above baseline (runtime: "spectrum threshold").
+#ifndef SPECTRUM_THRESHOLD_DEFAULT
+#define SPECTRUM_THRESHOLD_DEFAULT 40
+#endif
+
+// Pile-up handling of the pulse-height detector (runtime: "spectrum pileup"):
+// 0 off, 1 flag (binned, counted), 2 reject. A pulse is piled up if it rises
+// again on its tail, takes longer than MAX_RISE_US to its maximum or stays
+// above the threshold longer than MAX_WIDTH_US; set the two from the shaping
+// amplifier's pulse (0 disables that criterion).
+#ifndef SPECTRUM_PILEUP_MODE
+#define SPECTRUM_PILEUP_MODE 2
+#endif
+
+#ifndef SPECTRUM_PILEUP_MAX_WIDTH_US
+#define SPECTRUM_PILEUP_MAX_WIDTH_US 300
+#endif
+
+#ifndef SPECTRUM_PILEUP_MAX_RISE_US
+#define SPECTRUM_PILEUP_MAX_RISE_US 100
+#endif
+
+// Trapezoidal shaping ahead of the pulse-height detector (trapezoid_shaper.h;
+// runtime: "spectrum shaping"). Off, the detector holds the highest raw sample.
+// On, it measures the top of a trapezoid that averages each pulse over RISE_US,
+// which cuts the noise and the sampling-phase error of the height. DECAY_US is
+// the fall time constant of the shaping amplifier's pulse (pole-zero
+// correction); the pile-up limits above are widened by the trapezoid's own
+// rise and flat top. Heights come out on a different scale: recalibrate
+// ("spectrum cal") after switching.
+#ifndef SPECTRUM_SHAPING
+#define SPECTRUM_SHAPING 0
+#endif
+
+#ifndef SPECTRUM_TRAP_RISE_US
+#define SPECTRUM_TRAP_RISE_US 100
+#endif
+
+#ifndef SPECTRUM_TRAP_FLAT_US
+#define SPECTRUM_TRAP_FLAT_US 15
+#endif
+
+#ifndef SPECTRUM_TRAP_DECAY_US
+#define SPECTRUM_TRAP_DECAY_US 40
+#endif
+
+// Pulses queued from the acquisition task to pulseTask (50 ms poll): 1024 covers 20 kcps.
+#ifndef SPECTRUM_EVENT_RING_SIZE
+#define SPECTRUM_EVENT_RING_SIZE 1024
+#endif
+
+// Geiger/scintillator coincidence gating (runtime: "coincidence"). Mode 0 tags
+// only, 1 vetoes coincident pulses (cosmic muons), 2 keeps only coincident ones.
+#ifndef COINCIDENCE_MODE_DEFAULT
+#define COINCIDENCE_MODE_DEFAULT 0
+#endif
+
+// Covers the GM avalanche jitter plus the 12.5 us ADC sample period.
+#ifndef COINCIDENCE_WINDOW_US
+#define COINCIDENCE_WINDOW_US 100
+#endif
+
+// Spectrum screen: display columns (2 px each on the 392 px chart) and redraw period.
+#ifndef SPECTRUM_VIEW_COLUMNS
+#define SPECTRUM_VIEW_COLUMNS 196
+#endif
+
+#ifndef SPECTRUM_VIEW_INTERVAL_MS
+#define SPECTRUM_VIEW_INTERVAL_MS 300
+#endif
+
+// Spectrum waterfall (spectrum_waterfall.h): a PSRAM ring of SLICES spectra
+// of CHANNELS bins, one per SLICE_MS (240 x 256 x 2 B = 120 KB; 8 minutes at
+// 2 s). SHOWN 1 opens the spectrum screen on the waterfall instead of the plot.
+#ifndef SPECTRUM_WATERFALL_CHANNELS
+#define SPECTRUM_WATERFALL_CHANNELS 256
+#endif
+
+#ifndef SPECTRUM_WATERFALL_SLICES
+#define SPECTRUM_WATERFALL_SLICES 240
+#endif
+
+#ifndef SPECTRUM_WATERFALL_SLICE_MS
+#define SPECTRUM_WATERFALL_SLICE_MS 2000
+#endif
+
+#ifndef SPECTRUM_WATERFALL_SHOWN
+#define SPECTRUM_WATERFALL_SHOWN 0
+#endif
+
+// Refresh period of the zoomable history plot on the 1 h chart screen.
+#ifndef TIMESERIES_VIEW_INTERVAL_MS
+#define TIMESERIES_VIEW_INTERVAL_MS 1000
+#endif
+
+// Default energy calibration E = c0 + c1*ch + c2*ch^2 (keV) until one is saved
+// with "spectrum cal"; 3 keV/channel puts K-40 (1461 keV) near channel 490.
+#ifndef SPECTRUM_CAL_C0
+#define SPECTRUM_CAL_C0 0.0f
+#endif
+
+#ifndef SPECTRUM_CAL_C1
+#define SPECTRUM_CAL_C1 3.0f
+#endif
+
+#ifndef SPECTRUM_CAL_C2
+#define SPECTRUM_CAL_C2 0.0f
+#endif
+
+// Detector resolution (FWHM) at 662 keV, used to size the fit windows; ~7.5% for CsI(Tl).
+#ifndef SPECTRUM_RESOLUTION_662
+#define SPECTRUM_RESOLUTION_662 0.075f
+#endif
+
+// Peak analysis period (background task) and minimum spectrum counts before fitting.
+#ifndef SPECTRUM_ANALYSIS_INTERVAL_MS
+#define SPECTRUM_ANALYSIS_INTERVAL_MS 5000
+#endif
+
+// SiPM gain compensation (sipm_gain.h, runtime: "gain"): 0 off, 1 from the
+// temperature, 2 holding the SIPM_STABILIZE_KEV peak (calibrated channel),
+// 3 both. TEMP_SOURCE 1 is the ESP32-S3 die sensor plus TEMP_OFFSET_C; it
+// only tracks the probe if they share an enclosure. TEMPCO is the SiPM's
+// gain change at constant bias, in % per degree.
+#ifndef SIPM_GAIN_MODE
+#define SIPM_GAIN_MODE 0
+#endif
+
+#ifndef SIPM_TEMP_SOURCE
+#define SIPM_TEMP_SOURCE 1
+#endif
+
+#ifndef SIPM_TEMP_OFFSET_C
+#define SIPM_TEMP_OFFSET_C 0.0f
+#endif
+
+#ifndef SIPM_GAIN_TEMPCO_PCT
+#define SIPM_GAIN_TEMPCO_PCT -2.0f
+#endif
+
+#ifndef SIPM_GAIN_REF_C
+#define SIPM_GAIN_REF_C 25.0f
+#endif
+
+#ifndef SIPM_GAIN_INTERVAL_MS
+#define SIPM_GAIN_INTERVAL_MS 10000
+#endif
+
+// Gain change that rebuilds the channel table (0.05%, well inside a channel)
+#ifndef SIPM_GAIN_REBUILD_STEP
+#define SIPM_GAIN_REBUILD_STEP 0.0005f
+#endif
+
+// Peak hold: line energy, window counts per step and the fraction of the
+// window imbalance corrected per step (about half the shift, for stability
+// against the counting noise)
+#ifndef SIPM_STABILIZE_KEV
+#define SIPM_STABILIZE_KEV 1460.8f
+#endif
+
+#ifndef SIPM_STABILIZE_MIN_COUNTS
+#define SIPM_STABILIZE_MIN_COUNTS 400
+#endif
+
+#ifndef SIPM_STABILIZE_STEP
+#define SIPM_STABILIZE_STEP 0.02f
+#endif
+
+#ifndef SPECTRUM_ANALYSIS_MIN_COUNTS
+#define SPECTRUM_ANALYSIS_MIN_COUNTS 2000
+#endif
+
+// Isotope identification (isotope_id.h, serial "isotope"): pass interval and
+// the window the line sums cover, the live time the background is learned
+// over (and needed before anything is identified), the template significance
+// that identifies an isotope and the one that clears it, the largest line-ratio
+// chi-square per degree of freedom accepted, and the share of core 0 a pass may use.
+#ifndef ISOTOPE_ID_INTERVAL_MS
+#define ISOTOPE_ID_INTERVAL_MS 1000
+#endif
+
+#ifndef ISOTOPE_ID_WINDOW_S
+#define ISOTOPE_ID_WINDOW_S 30
+#endif
+
+#ifndef ISOTOPE_ID_BACKGROUND_S
+#define ISOTOPE_ID_BACKGROUND_S 600.0f
+#endif
+
+#ifndef ISOTOPE_ID_LEARN_S
+#define ISOTOPE_ID_LEARN_S 120.0f
+#endif
+
+#ifndef ISOTOPE_ID_ALARM_SIGMA
+#define ISOTOPE_ID_ALARM_SIGMA 5.0f
+#endif
+
+#ifndef ISOTOPE_ID_CLEAR_SIGMA
+#define ISOTOPE_ID_CLEAR_SIGMA 3.0f
+#endif
+
+#ifndef ISOTOPE_ID_MAX_CHI2
+#define ISOTOPE_ID_MAX_CHI2 4.0f
+#endif
+
+#ifndef ISOTOPE_ID_CPU_PCT
+#define ISOTOPE_ID_CPU_PCT 10
+#endif
+
+// Saved spectra (*.rds) live in this directory on the SD card, or on LittleFS
+// without a card. A running session is checkpointed every SPECTRUM_CHECKPOINT_S.
+#ifndef SPECTRUM_SESSION_DIR
+#define SPECTRUM_SESSION_DIR "/spectra"
+#endif
+
+#ifndef SPECTRUM_CHECKPOINT_S
+#define SPECTRUM_CHECKPOINT_S 300
+#endif
+
+// Periodic background jobs (job_wheel.h): tick of their timer wheel. Jobs
+// are due on whole ticks and the task sleeps until the next deadline, so a
+// finer tick costs nothing while idle.
+#ifndef JOB_WHEEL_TICK_MS
+#define JOB_WHEEL_TICK_MS 10
+#endif
+
+// Task and heap profiling (/api/sysinfo, serial "perf"). A background job
+// samples CPU load, stack high-water marks and heap state into a RAM ring:
+// 180 samples every 10 s keep the last 30 minutes for charting.
+#ifndef SYSINFO_SAMPLE_INTERVAL_MS
+#define SYSINFO_SAMPLE_INTERVAL_MS 10000
+#endif
+
+#ifndef SYSINFO_HISTORY_SIZE
+#define SYSINFO_HISTORY_SIZE 180
+#endif
+
+// In-RAM binary event trace (serial "trace", /api/trace). Recording costs a few
+// dozen cycles, so it stays on in normal builds; 0 compiles every TRACE_EVENT()
+// out. The ring holds 16-byte events (power of two): 2048 cover ~20 s.
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED 1
+#endif
+
+#ifndef TRACE_RING_SIZE
+#define TRACE_RING_SIZE 2048
+#endif
+
+// Quiet period before changed settings are written to NVS. Each further change
+// restarts it, so a burst of spinbox steps ends in a single flash write.
+#ifndef SETTINGS_COMMIT_DELAY_MS
+#define SETTINGS_COMMIT_DELAY_MS 2000
+#endif
+
+// Defaults of the device configuration (device_config.h) until the user changes
+// them: tube sensitivity in CPM per µSv/h (from the tube profile) and the idle
+// time before the display dims.
+#ifndef CONVERSION_FACTOR_DEFAULT
+#define CONVERSION_FACTOR_DEFAULT (ActiveTube::CPM_PER_USVH)
+#endif
+
+#ifndef DISPLAY_TIMEOUT_DEFAULT_MS
+#define DISPLAY_TIMEOUT_DEFAULT_MS 300000
+#endif
+
+// Display power states (display_power.h). The backlight is PWM-dimmed on
+// DISPLAY_BACKLIGHT_PIN; -1 when the backlight is wired to the supply, in which
+// case only the screen-off state (panel sleep, rendering paused) saves power.
+#ifndef DISPLAY_BACKLIGHT_PIN
+#define DISPLAY_BACKLIGHT_PIN -1
+#endif
+
+#ifndef DISPLAY_BRIGHTNESS_NORMAL
+#define DISPLAY_BRIGHTNESS_NORMAL 128
+#endif
+
+#ifndef DISPLAY_BRIGHTNESS_DIMMED
+#define DISPLAY_BRIGHTNESS_DIMMED 20
+#endif
+
+// Time spent dimmed before the screen turns off, and the fixed CPU clock while
+// it is off (0 keeps the full clock; DFS idles at POWER_MIN_CPU_MHZ anyway). 80 MHz is the lowest clock that keeps the
+// APB, and with it the PCNT glitch filter and the WiFi stack, at full speed.
+#ifndef DISPLAY_OFF_DELAY_MS
+#define DISPLAY_OFF_DELAY_MS 60000
+#endif
+
+#ifndef DISPLAY_OFF_CPU_MHZ
+#define DISPLAY_OFF_CPU_MHZ 80
+#endif
+
+// CPU clock range of the power profile (power_profile.h). With CONFIG_PM_ENABLE
+// the clock scales between the two; the minimum must stay >= 80 MHz so the
+// APB clock of the pulse counter never changes.
+#ifndef POWER_MAX_CPU_MHZ
+#define POWER_MAX_CPU_MHZ 240
+#endif
+
+#ifndef POWER_MIN_CPU_MHZ
+#define POWER_MIN_CPU_MHZ 80
+#endif
+
+// Optional supply-current sense input for "power bench" (e.g. a shunt amplifier
+// on an ADC pin): -1 for none, otherwise the amplifier's output in mV per mA.
+#ifndef POWER_BENCH_CURRENT_PIN
+#define POWER_BENCH_CURRENT_PIN -1
+#endif
+
+#ifndef POWER_BENCH_MV_PER_MA
+#define POWER_BENCH_MV_PER_MA 10.0f
+#endif
+
+// Energy accounting (energy_meter.h, "energy"): state sampling period, and
+// every ENERGY_LOG_INTERVAL_S an entry of the RAM history (96 x 15 min: the
+// last day) and a debug log line.
+#ifndef ENERGY_SAMPLE_MS
+#define ENERGY_SAMPLE_MS 1000
+#endif
+
+#ifndef ENERGY_LOG_INTERVAL_S
+#define ENERGY_LOG_INTERVAL_S 900
+#endif
+
+#ifndef ENERGY_HISTORY_SIZE
+#define ENERGY_HISTORY_SIZE 96
+#endif
+
+// Default per-state currents for the energy estimate, in mA (the click in
+// uA s). Typical ESP32-S3 figures; measure each board once and save its own
+// with "energy coef <name> <value>". CPU: idle = base + per MHz, busy adds
+// per MHz on top. WiFi modem-sleep figures are averages over the DTIM or
+// listen-interval cycle. Backlight at full duty. Buzzer: average over an
+// alarm pattern. Base: HV supply, regulators and the input stage.
+#ifndef ENERGY_COEF_CPU_IDLE_BASE_MA
+#define ENERGY_COEF_CPU_IDLE_BASE_MA 12.0f
+#endif
+
+#ifndef ENERGY_COEF_CPU_IDLE_MA_PER_MHZ
+#define ENERGY_COEF_CPU_IDLE_MA_PER_MHZ 0.12f
+#endif
+
+#ifndef ENERGY_COEF_CPU_BUSY_MA_PER_MHZ
+#define ENERGY_COEF_CPU_BUSY_MA_PER_MHZ 0.12f
+#endif
+
+#ifndef ENERGY_COEF_WIFI_AWAKE_MA
+#define ENERGY_COEF_WIFI_AWAKE_MA 95.0f
+#endif
+
+#ifndef ENERGY_COEF_WIFI_MODEM_MA
+#define ENERGY_COEF_WIFI_MODEM_MA 22.0f
+#endif
+
+#ifndef ENERGY_COEF_WIFI_LISTEN_MA
+#define ENERGY_COEF_WIFI_LISTEN_MA 6.0f
+#endif
+
+#ifndef ENERGY_COEF_BLE_MA
+#define ENERGY_COEF_BLE_MA 12.0f
+#endif
+
+#ifndef ENERGY_COEF_PANEL_MA
+#define ENERGY_COEF_PANEL_MA 8.0f
+#endif
+
+#ifndef ENERGY_COEF_BACKLIGHT_MA
+#define ENERGY_COEF_BACKLIGHT_MA 60.0f
+#endif
+
+#ifndef ENERGY_COEF_BUZZER_MA
+#define ENERGY_COEF_BUZZER_MA 25.0f
+#endif
+
+#ifndef ENERGY_COEF_CLICK_UAS
+#define ENERGY_COEF_CLICK_UAS 20.0f
+#endif
+
+#ifndef ENERGY_COEF_FLASH_WRITE_MA
+#define ENERGY_COEF_FLASH_WRITE_MA 20.0f
+#endif
+
+#ifndef ENERGY_COEF_BASE_MA
+#define ENERGY_COEF_BASE_MA 6.0f
+#endif
+
+// Deep-sleep logger mode (logger_mode.h). LOGGER_ULP_AVAILABLE is 1 only in
+// builds that embed ulp/logger_ulp.c (ESP-IDF ulp_embed_binary). The ULP
+// closes an interval every LOGGER_INTERVAL_S seconds and wakes the main cores
+// once LOGGER_BATCH_INTERVALS of them are waiting (at most LOGGER_ULP_RING).
+// Every LOGGER_UPLOAD_BATCHES-th wake (0: never) boots fully for WiFi and
+// telemetry, for at most LOGGER_UPLOAD_WINDOW_MS, then sleeps again.
+#ifndef LOGGER_ULP_AVAILABLE
+#define LOGGER_ULP_AVAILABLE 0
+#endif
+
+#ifndef LOGGER_INTERVAL_S
+#define LOGGER_INTERVAL_S 60
+#endif
+
+#ifndef LOGGER_BATCH_INTERVALS
+#define LOGGER_BATCH_INTERVALS 60
+#endif
+
+#ifndef LOGGER_ULP_RING
+#define LOGGER_ULP_RING 128
+#endif
+
+#ifndef LOGGER_UPLOAD_BATCHES
+#define LOGGER_UPLOAD_BATCHES 24
+#endif
+
+#ifndef LOGGER_UPLOAD_WINDOW_MS
+#define LOGGER_UPLOAD_WINDOW_MS 120000
+#endif
+
+// Intervals stored by logger-mode wakes, replayed on the next full boot (LittleFS).
+#ifndef LOGGER_BACKLOG_PATH
+#define LOGGER_BACKLOG_PATH "/logger.bin"
+#endif
+
+// Scheduled acquisition campaigns (campaign.h). Up to CAMPAIGN_MAX_WINDOWS
+// acquisition windows and CAMPAIGN_MAX_UPLOADS upload slots per UTC day. An
+// upload slot keeps the radio on for at most CAMPAIGN_UPLOAD_SLOT_S, and
+// ends early once the network has been up for CAMPAIGN_UPLOAD_LINGER_S with
+// the telemetry queue empty. Between events more than CAMPAIGN_MIN_SLEEP_S
+// apart the device sleeps in logger mode with CAMPAIGN_SLEEP_INTERVAL_S
+// intervals, waking CAMPAIGN_WAKE_LEAD_S early, but not before it has been
+// up for CAMPAIGN_MIN_AWAKE_S after a boot.
+#ifndef CAMPAIGN_MAX_WINDOWS
+#define CAMPAIGN_MAX_WINDOWS 4
+#endif
+
+#ifndef CAMPAIGN_MAX_UPLOADS
+#define CAMPAIGN_MAX_UPLOADS 4
+#endif
+
+#ifndef CAMPAIGN_UPLOAD_SLOT_S
+#define CAMPAIGN_UPLOAD_SLOT_S 300
+#endif
+
+#ifndef CAMPAIGN_UPLOAD_LINGER_S
+#define CAMPAIGN_UPLOAD_LINGER_S 30
+#endif
+
+#ifndef CAMPAIGN_SLEEP_INTERVAL_S
+#define CAMPAIGN_SLEEP_INTERVAL_S 300
+#endif
+
+#ifndef CAMPAIGN_MIN_SLEEP_S
+#define CAMPAIGN_MIN_SLEEP_S 600
+#endif
+
+#ifndef CAMPAIGN_WAKE_LEAD_S
+#define CAMPAIGN_WAKE_LEAD_S 30
+#endif
+
+#ifndef CAMPAIGN_MIN_AWAKE_S
+#define CAMPAIGN_MIN_AWAKE_S 60
+#endif
+
+// Battery divider (battery_monitor.h). -1 disables the monitor; with the
+// spectrum enabled the pin must be on ADC2 (GPIO 11-20). The ratio is the
+// divider's (top + bottom) / bottom.
+#ifndef BATTERY_ADC_PIN
+#define BATTERY_ADC_PIN -1
+#endif
+
+#ifndef BATTERY_DIVIDER_RATIO
+#define BATTERY_DIVIDER_RATIO 2.0f
+#endif
+
+// Sampling period, raw reads averaged per sample and the time constant of the
+// voltage filter.
+#ifndef BATTERY_SAMPLE_INTERVAL_MS
+#define BATTERY_SAMPLE_INTERVAL_MS 2000
+#endif
+
+#ifndef BATTERY_OVERSAMPLE
+#define BATTERY_OVERSAMPLE 64
+#endif
+
+#ifndef BATTERY_FILTER_SECONDS
+#define BATTERY_FILTER_SECONDS 30.0f
+#endif
+
+// State of charge below which the battery is reported low and critical. On
+// reaching critical the dose is checkpointed before the cell browns out.
+#ifndef BATTERY_LOW_PERCENT
+#define BATTERY_LOW_PERCENT 20.0f
+#endif
+
+#ifndef BATTERY_CRITICAL_PERCENT
+#define BATTERY_CRITICAL_PERCENT 5.0f
+#endif
+
+// Checkpoint of the cumulative dose, maximum, total counts and chart histories,
+// written every DOSE_CHECKPOINT_INTERVAL_S and before an OTA update, restored at
+// boot. Records rotate over DOSE_CHECKPOINT_SLOTS NVS keys, so a write torn by a
+// power cut only loses that record and the previous one is used.
+#ifndef DOSE_CHECKPOINT_INTERVAL_S
+#define DOSE_CHECKPOINT_INTERVAL_S 300
+#endif
+
+#ifndef DOSE_CHECKPOINT_SLOTS
+#define DOSE_CHECKPOINT_SLOTS 4
+#endif
+
+// Power-fail flush (power_fail.h) for mains-powered units. POWER_FAIL_PIN is a
+// supply-sense input: a comparator or voltage supervisor on the adapter side
+// of the regulator, asserted while the hold-up capacitance still carries the
+// board for some tens of ms. On that edge the dose and the history log records
+// not yet stored are written into the pre-erased raw partition
+// POWER_FAIL_PARTITION (not in the default partitions.csv) and restored on the
+// next boot. The chip's own brownout detector trips too late for this: it
+// watches the 3.3 V rail the flash needs and resets from its interrupt. -1: off.
+#ifndef POWER_FAIL_PIN
+#define POWER_FAIL_PIN -1
+#endif
+
+#ifndef POWER_FAIL_ACTIVE_LOW
+#define POWER_FAIL_ACTIVE_LOW 1
+#endif
+
+#ifndef POWER_FAIL_PARTITION
+#define POWER_FAIL_PARTITION "rdpfail"
+#endif
+
+// Log records kept in PSRAM until stored, for the flush (16 bytes each); a 1 s
+// log holds up to a block plus HISTORY_LOG_SYNC_S records unsynced
+#ifndef POWER_FAIL_LOG_RECORDS
+#define POWER_FAIL_LOG_RECORDS 1024
+#endif
+
+// Supply back for this long after a flush: the area is erased again and re-armed
+#ifndef POWER_FAIL_REARM_MS
+#define POWER_FAIL_REARM_MS 5000
+#endif
+
+// Alarm levels around the user's thresholds (alarm_rules.h): warn at this
+// fraction of the dose-rate and dose thresholds, danger at this multiple.
+#ifndef ALARM_WARN_FRACTION
+#define ALARM_WARN_FRACTION 0.5f
+#endif
+
+#ifndef ALARM_DANGER_FACTOR
+#define ALARM_DANGER_FACTOR 10.0f
+#endif
+
+// Rarely visited SquareLine screens (Settings with its keyboard, Voltage) are
+// deleted when they are left and rebuilt on the next visit (ui_screens.h), which
+// keeps their widgets out of the LVGL heap. 0 keeps every built screen.
+#ifndef UI_DELETE_RARE_SCREENS
+#define UI_DELETE_RARE_SCREENS 1
+#endif
+
+// Internal-RAM block pools of the LVGL allocator (lvgl_heap.h), split evenly
+// over the 16 / 32 / 64 / 128-byte classes. Larger LVGL data lives in PSRAM.
+#ifndef LVGL_HEAP_POOL_BYTES
+#define LVGL_HEAP_POOL_BYTES 16384
+#endif
+
+// Word-wide blending of semi-transparent RGB565 fills (blend_rgb565.h); 0 leaves
+// every blend to LVGL's scalar software renderer.
+#ifndef RGB565_FAST_BLEND
+#define RGB565_FAST_BLEND 1
+#endif
+
+// Experimental: blends of at least RENDER_SPLIT_MIN_PIXELS are cut into two
+// row bands, the lower one blended by a worker on the core that is not
+// TASK_CORE_UI (render_split.h). Off by default; "render split on" starts it
+// at run time and "render split" checks and times it.
+#ifndef RENDER_SPLIT_CORES
+#define RENDER_SPLIT_CORES 0
+#endif
+
+#ifndef RENDER_SPLIT_MIN_PIXELS
+#define RENDER_SPLIT_MIN_PIXELS 4096
+#endif
+
+// Pre-rendered glyph masks for the large ui_CurrentRad readout (digit_sprites.h);
+// 0 draws it through LVGL's per-glyph path.
+#ifndef DIGIT_SPRITES
+#define DIGIT_SPRITES 1
+#endif
+
+// Longest uiTask wait between passes (ui_wake.h) when no touch, data or LVGL
+// timer wakes it earlier; bounds the serial command and WiFi latency.
+#ifndef UI_TASK_MAX_SLEEP_MS
+#define UI_TASK_MAX_SLEEP_MS 100
+#endif
+
+// XPT2046 pen interrupt (T_IRQ, active low while touched); -1 when not wired, in
+// which case touches are only seen by LVGL's periodic touch read.
+#ifndef TOUCH_IRQ_PIN
+#define TOUCH_IRQ_PIN -1
+#endif
+
+// High-voltage boost regulation (hv_control.h). HV_PWM_PIN drives the boost
+// switch, HV_FEEDBACK_PIN reads the output through a divider of HV_DIVIDER_RATIO
+// (output volts per volt at the pin); -1 on boards with a fixed HV supply.
+#ifndef HV_PWM_PIN
+#define HV_PWM_PIN -1
+#endif
+
+#ifndef HV_FEEDBACK_PIN
+#define HV_FEEDBACK_PIN -1
+#endif
+
+#ifndef HV_DIVIDER_RATIO
+#define HV_DIVIDER_RATIO 1001.0f
+#endif
+
+#ifndef HV_PWM_FREQUENCY
+#define HV_PWM_FREQUENCY 25000
+#endif
+
+// Operating voltage range the target is clamped to, and the trip level above it.
+// The default target is the tube profile's operating voltage.
+#ifndef HV_TARGET_DEFAULT_V
+#define HV_TARGET_DEFAULT_V (ActiveTube::OPERATING_V)
+#endif
+
+#ifndef HV_MIN_V
+#define HV_MIN_V 250.0f
+#endif
+
+#ifndef HV_MAX_V
+#define HV_MAX_V 600.0f
+#endif
+
+#ifndef HV_OVERVOLTAGE_MARGIN_V
+#define HV_OVERVOLTAGE_MARGIN_V 30.0f
+#endif
+
+// Control loop: rate, PI gains (duty per volt, duty per volt-second), the boost
+// duty limit and the soft-start / target change slew
+#ifndef HV_CONTROL_RATE_HZ
+#define HV_CONTROL_RATE_HZ 200
+#endif
+
+#ifndef HV_KP
+#define HV_KP 0.0005f
+#endif
+
+#ifndef HV_KI
+#define HV_KI 0.02f
+#endif
+
+#ifndef HV_MAX_DUTY
+#define HV_MAX_DUTY 0.6f
+#endif
+
+#ifndef HV_SLEW_V_PER_S
+#define HV_SLEW_V_PER_S 100.0f
+#endif
+
+// Plateau scan (AUTO on the voltage screen): voltage range and step, settling
+// per step, and the counts for a statistically sufficient step (1000 counts:
+// about 3 % relative error). Below the threshold or at background a step ends
+// after PLATEAU_MAX_STEP_MS; with a check source the scan takes minutes.
+#ifndef PLATEAU_START_V
+#define PLATEAU_START_V 300.0f
+#endif
+
+#ifndef PLATEAU_END_V
+#define PLATEAU_END_V 560.0f
+#endif
+
+#ifndef PLATEAU_STEP_V
+#define PLATEAU_STEP_V 10.0f
+#endif
+
+#ifndef PLATEAU_SETTLE_MS
+#define PLATEAU_SETTLE_MS 3000
+#endif
+
+#ifndef PLATEAU_TARGET_COUNTS
+#define PLATEAU_TARGET_COUNTS 1000
+#endif
+
+#ifndef PLATEAU_MIN_STEP_MS
+#define PLATEAU_MIN_STEP_MS 10000
+#endif
+
+#ifndef PLATEAU_MAX_STEP_MS
+#define PLATEAU_MAX_STEP_MS 120000
+#endif
+
+// Widest run of steps whose slope is at most this (percent per 100 V)
+#ifndef PLATEAU_MAX_SLOPE_PCT
+#define PLATEAU_MAX_SLOPE_PCT 10.0f
+#endif
+
+// Calibration against a reference source (calibration.h): a source run ends
+// when the net rate's relative 1-sigma error reaches CALIBRATION_TARGET_REL
+// (2 %: about 2500 net counts without background), a background run at
+// CALIBRATION_BACKGROUND_REL. Neither ends before CALIBRATION_MIN_MS. The
+// factor's confidence interval is +-CALIBRATION_CONFIDENCE_Z sigmas, and it
+// includes the reference's own 1-sigma error from its certificate.
+#ifndef CALIBRATION_TARGET_REL
+#define CALIBRATION_TARGET_REL 0.02f
+#endif
+
+#ifndef CALIBRATION_BACKGROUND_REL
+#define CALIBRATION_BACKGROUND_REL 0.05f
+#endif
+
+#ifndef CALIBRATION_MIN_MS
+#define CALIBRATION_MIN_MS 30000
+#endif
+
+#ifndef CALIBRATION_MAX_MS
+#define CALIBRATION_MAX_MS 3600000
+#endif
+
+#ifndef CALIBRATION_BACKGROUND_MAX_MS
+#define CALIBRATION_BACKGROUND_MAX_MS 1800000
+#endif
+
+#ifndef CALIBRATION_CONFIDENCE_Z
+#define CALIBRATION_CONFIDENCE_Z 1.96f
+#endif
+
+#ifndef CALIBRATION_REFERENCE_REL
+#define CALIBRATION_REFERENCE_REL 0.03f
+#endif
+
+// Reference dose rate offered by the calibration panel until one was used (µSv/h)
+#ifndef CALIBRATION_REFERENCE_DEFAULT
+#define CALIBRATION_REFERENCE_DEFAULT 10.0f
+#endif
+
+// Firmware update (ota_guard.h): bytes between yields of the web task while an
+// upload is written, the delay before the reboot into a verified image, and the
+// confirmation window of a new image (rolled back if not confirmed in time)
+#ifndef OTA_YIELD_BYTES
+#define OTA_YIELD_BYTES 4096
+#endif
+
+#ifndef OTA_REBOOT_DELAY_MS
+#define OTA_REBOOT_DELAY_MS 2000
+#endif
+
+#ifndef OTA_CONFIRM_AFTER_MS
+#define OTA_CONFIRM_AFTER_MS 60000
+#endif
+
+#ifndef OTA_CONFIRM_TIMEOUT_MS
+#define OTA_CONFIRM_TIMEOUT_MS 180000
+#endif
+
+// Fleet pull updates (fleet_ota.h; manifest URL set with the "fleet" serial
+// command): manifest poll interval, the UTC hours in which a downloaded image
+// is installed, and the pause between downloaded 4 KB sectors, which keeps the
+// background download from crowding out telemetry and the dashboard.
+#ifndef FLEET_OTA_ENABLED
+#define FLEET_OTA_ENABLED 1
+#endif
+
+#ifndef FLEET_POLL_INTERVAL_S
+#define FLEET_POLL_INTERVAL_S 21600
+#endif
+
+#ifndef FLEET_QUIET_START_H
+#define FLEET_QUIET_START_H 2
+#endif
+
+#ifndef FLEET_QUIET_END_H
+#define FLEET_QUIET_END_H 5
+#endif
+
+#ifndef FLEET_SECTOR_GAP_MS
+#define FLEET_SECTOR_GAP_MS 20
+#endif
+
+// Firmware update from the microSD card (card_update.h): an image signed with
+// tools/make_card_update.py at CARD_UPDATE_PATH is installed at boot, before
+// the network starts. CARD_UPDATE_PUBLIC_KEY is the PEM of the P-256 key the
+// images are signed with; empty turns the check off, as an unsigned image is
+// never taken. The card is read CARD_UPDATE_CHUNK bytes at a time into one
+// buffer while the other is written to flash.
+#ifndef CARD_UPDATE_PATH
+#define CARD_UPDATE_PATH "/firmware.rdu"
+#endif
+
+#ifndef CARD_UPDATE_PUBLIC_KEY
+#define CARD_UPDATE_PUBLIC_KEY ""
+#endif
+
+#ifndef CARD_UPDATE_CHUNK
+#define CARD_UPDATE_CHUNK 32768
+#endif
+
+// Binary serial protocol (serial_link.h): the interval between spectrum
+// snapshots while that stream is on, and the per-pulse timestamp queue between
+// pulseTask and the link task (a power of two; overflow is counted, not fatal).
+#ifndef SERIAL_LINK_ENABLED
+#define SERIAL_LINK_ENABLED 1
+#endif
+
+#ifndef SERIAL_LINK_SPECTRUM_MS
+#define SERIAL_LINK_SPECTRUM_MS 1000
+#endif
+
+#ifndef SERIAL_LINK_PULSE_QUEUE
+#define SERIAL_LINK_PULSE_QUEUE 1024
+#endif
+
+// Time base (time_base.h): SNTP servers and the interval between SNTP results,
+// each of which disciplines the UTC mapping of the record timestamps
+#ifndef TIME_SNTP_SERVER_1
+#define TIME_SNTP_SERVER_1 "pool.ntp.org"
+#endif
+
+#ifndef TIME_SNTP_SERVER_2
+#define TIME_SNTP_SERVER_2 "time.nist.gov"
+#endif
+
+#ifndef TIME_SNTP_INTERVAL_S
+#define TIME_SNTP_INTERVAL_S 3600
+#endif
+
+// Boot report and crash-loop protection (boot_report.h). A boot counts as
+// failed unless it stays up BOOT_STABLE_AFTER_MS; after BOOT_SAFE_MODE_AFTER
+// failed boots in a row the next one skips the SD log, spectrum and uploads.
+#ifndef BOOT_STABLE_AFTER_MS
+#define BOOT_STABLE_AFTER_MS 60000
+#endif
+
+#ifndef BOOT_SAFE_MODE_AFTER
+#define BOOT_SAFE_MODE_AFTER 3
+#endif
+
+// Task supervision (supervisor.h). A supervised task without a heartbeat for
+// its stall limit is restarted (web, UI) or the device is rebooted (pulse,
+// or after SUPERVISOR_MAX_RESTARTS restarts of one task). The TWDT timeout is
+// the last resort and must stay above every stall limit.
+#ifndef SUPERVISOR_WDT_TIMEOUT_S
+#define SUPERVISOR_WDT_TIMEOUT_S 30
+#endif
+
+#ifndef SUPERVISOR_INTERVAL_MS
+#define SUPERVISOR_INTERVAL_MS 1000
+#endif
+
+#ifndef SUPERVISOR_MAX_RESTARTS
+#define SUPERVISOR_MAX_RESTARTS 3
+#endif
+
+#ifndef SUPERVISOR_PULSE_STALL_MS
+#define SUPERVISOR_PULSE_STALL_MS 3000
+#endif
+
+#ifndef SUPERVISOR_UI_STALL_MS
+#define SUPERVISOR_UI_STALL_MS 10000
+#endif
+
+// Long exports and uploads send heartbeats per chunk, so this only has to
+// cover one stuck socket write
+#ifndef SUPERVISOR_WEB_STALL_MS
+#define SUPERVISOR_WEB_STALL_MS 20000
+#endif
+
+// Alarm and event journal (event_journal.h). Events go to a ring of
+// EVENT_JOURNAL_RTC_SLOTS in RTC memory and are spilled to NVS pages of 16
+// once EVENT_JOURNAL_SPILL_BATCH are pending or the oldest pending one is
+// EVENT_JOURNAL_SPILL_MS old. NVS keeps the last 16 * EVENT_JOURNAL_PAGES.
+#ifndef EVENT_JOURNAL_RTC_SLOTS
+#define EVENT_JOURNAL_RTC_SLOTS 32
+#endif
+
+#ifndef EVENT_JOURNAL_PAGES
+#define EVENT_JOURNAL_PAGES 8
+#endif
+
+#ifndef EVENT_JOURNAL_SPILL_BATCH
+#define EVENT_JOURNAL_SPILL_BATCH 8
+#endif
+
+#ifndef EVENT_JOURNAL_SPILL_MS
+#define EVENT_JOURNAL_SPILL_MS 60000
+#endif
+
+// Commands queued per owner task (command_bus.h). They are applied every
+// pass of the owner (50 ms for pulseTask); a burst beyond this is dropped.
+#ifndef COMMAND_QUEUE_LENGTH
+#define COMMAND_QUEUE_LENGTH 8
+#endif
+
+// Off-screen frames for the main screen dose readouts (readout_sprite.h): a new
+// value is pushed to the panel as the changed columns only, without an LVGL
+// redraw. The large readout uses the digit sprites if it cannot get a frame.
+#ifndef READOUT_SPRITES
+#define READOUT_SPRITES 1
+#endif
+
+// JSON request bodies (json_body.h): largest body accepted (413 above), the
+// arena holding a body's filtered document, and the number of such routes.
+#ifndef JSON_BODY_MAX_BYTES
+#define JSON_BODY_MAX_BYTES 16384
+#endif
+
+#ifndef JSON_BODY_DOC_BYTES
+#define JSON_BODY_DOC_BYTES 4096
+#endif
+
+#ifndef JSON_BODY_MAX_ROUTES
+#define JSON_BODY_MAX_ROUTES 8
+#endif
+
+// Shared arena every JsonDocument is built on (json_arena.h), reset for each
+// document. Sized for /api/sysinfo, the largest; a document that does not fit
+// loses its tail fields and counts as refused in "perf".
+#ifndef JSON_ARENA_BYTES
+#define JSON_ARENA_BYTES 8192
+#endif
+
+// Response bodies of one web request (web_arena.h), reset after each one.
+// Sized for /api/sysinfo with a full history (~15 KB); a larger body is
+// moved to the heap and counted as spilled in "perf".
+#ifndef WEB_ARENA_BYTES
+#define WEB_ARENA_BYTES 24576
+#endif
+
+// GM tube fitted to this build (tube_profile.h). It sets the defaults of the
+// conversion factor, dead time and operating voltage. Files that use those
+// defaults include tube_profile.h.
+#define TUBE_SBM20 1
+#define TUBE_M4011 2
+#define TUBE_J305  3
+
+#ifndef TUBE_MODEL
+#define TUBE_MODEL TUBE_SBM20
+#endif
+
+// Energy-compensated dose from the spectrum (spectrum_dose.h). The scale is
+// the scintillator's count rate per uSv/h of Cs-137; "spectrum dose cal" fits
+// it against the GM rate in a Cs-137 field. B1 and B2 shape G(E) away from
+// 662 keV: B1 = 1 weighs each count by its energy, a first-order default until
+// the crystal's response is fitted. Channels below MIN_KEV weigh nothing.
+// BUILD_CHUNK channels of a new table are computed per pulseTask poll.
+#ifndef SPECTRUM_DOSE_CPS_PER_USVH_662
+#define SPECTRUM_DOSE_CPS_PER_USVH_662 300.0f
+#endif
+
+#ifndef SPECTRUM_DOSE_B1
+#define SPECTRUM_DOSE_B1 1.0f
+#endif
+
+#ifndef SPECTRUM_DOSE_B2
+#define SPECTRUM_DOSE_B2 0.0f
+#endif
+
+#ifndef SPECTRUM_DOSE_MIN_KEV
+#define SPECTRUM_DOSE_MIN_KEV 30.0f
+#endif
+
+#ifndef SPECTRUM_DOSE_BUILD_CHUNK
+#define SPECTRUM_DOSE_BUILD_CHUNK 64
+#endif
+
+// Fast WiFi reconnect (wifi_manager.h). The fast path associates to the
+// cached BSSID and channel and gives up after WIFI_FAST_CONNECT_TIMEOUT_MS,
+// falling back to a full scan. A cached address is reused statically only
+// while its lease is younger than WIFI_FAST_LEASE_REUSE_S; keep that well
+// below the DHCP server's lease time.
+#ifndef WIFI_FAST_CONNECT_TIMEOUT_MS
+#define WIFI_FAST_CONNECT_TIMEOUT_MS 3000
+#endif
+
+#ifndef WIFI_FAST_LEASE_REUSE_S
+#define WIFI_FAST_LEASE_REUSE_S 3600
+#endif
+
+// Network list on the settings screen (wifi_scan_view.h): while it is open,
+// the cached scan is refreshed in the background once it is older than
+// WIFI_SCAN_REFRESH_S. A scan takes the radio off channel for about two
+// seconds, which a connected session rides out.
+#ifndef WIFI_SCAN_REFRESH_S
+#define WIFI_SCAN_REFRESH_S 30
+#endif
+
+// First-time setup portal (provisioning_portal.h): with no network saved, the
+// unit opens an access point named after its host name (PORTAL_PASSWORD, WPA2
+// with at least 8 characters, or "" for an open one) with a captive page to
+// pick a network. It closes once credentials are saved, or after
+// PORTAL_TIMEOUT_S without them (0: stays open).
+#ifndef PORTAL_ENABLED
+#define PORTAL_ENABLED 1
+#endif
+
+#ifndef PORTAL_PASSWORD
+#define PORTAL_PASSWORD ""
+#endif
+
+#ifndef PORTAL_TIMEOUT_S
+#define PORTAL_TIMEOUT_S 900
+#endif
+
+// WiFi modem-sleep policy (wifi_power.h): 0 awake, 1 modem sleep at every
+// DTIM, 2 scheduled (modem sleep at WIFI_LISTEN_INTERVAL beacons between wake
+// windows). At the usual 102.4 ms beacon interval, 10 beacons let a request
+// wait up to about a second before a session's wake window opens. A session
+// stays awake WIFI_SESSION_HOLD_MS after its last request.
+#ifndef WIFI_POWER_POLICY
+#define WIFI_POWER_POLICY 2
+#endif
+
+#ifndef WIFI_LISTEN_INTERVAL
+#define WIFI_LISTEN_INTERVAL 10
+#endif
+
+#ifndef WIFI_SESSION_HOLD_MS
+#define WIFI_SESSION_HOLD_MS 30000
+#endif
+
+// BLE GATT readout (ble_service.h). BLE_ENABLED 0 leaves the Bluetooth stack
+// out of the build; with 1 it is still only started by "ble on". Rate and
+// per-second counts are notified together every BLE_NOTIFY_INTERVAL_S.
+// BLE_MTU is the ATT MTU asked for: 247 fills one 251-byte link-layer packet
+// with data length extension, 12 history records per notification.
+#ifndef BLE_ENABLED
+#define BLE_ENABLED 1
+#endif
+
+#ifndef BLE_NOTIFY_INTERVAL_S
+#define BLE_NOTIFY_INTERVAL_S 10
+#endif
+
+#ifndef BLE_MTU
+#define BLE_MTU 247
+#endif
+
+// ESP-NOW ring relay (espnow_link.h). Frames are flooded ESPNOW_TTL relays
+// deep with up to ESPNOW_RELAY_JITTER_MS of random delay per relay; an alarm
+// frame is sent ESPNOW_ALARM_REPEATS times ESPNOW_REPEAT_MS apart. The hub
+// tracks ESPNOW_MAX_NODES origins and forgets one after ESPNOW_NODE_TIMEOUT_S.
+#ifndef ESPNOW_CHANNEL
+#define ESPNOW_CHANNEL 1
+#endif
+
+#ifndef ESPNOW_INTERVAL_S
+#define ESPNOW_INTERVAL_S 10
+#endif
+
+#ifndef ESPNOW_TTL
+#define ESPNOW_TTL 3
+#endif
+
+#ifndef ESPNOW_RELAY_JITTER_MS
+#define ESPNOW_RELAY_JITTER_MS 20
+#endif
+
+#ifndef ESPNOW_ALARM_REPEATS
+#define ESPNOW_ALARM_REPEATS 3
+#endif
+
+#ifndef ESPNOW_REPEAT_MS
+#define ESPNOW_REPEAT_MS 30
+#endif
+
+#ifndef ESPNOW_MAX_NODES
+#define ESPNOW_MAX_NODES 16
+#endif
+
+#ifndef ESPNOW_NODE_TIMEOUT_S
+#define ESPNOW_NODE_TIMEOUT_S 60
+#endif
+
+// The hub's own access point for its dashboard (WPA2, at least 8 characters;
+// set a site-specific password in the build).
+#ifndef ESPNOW_HUB_AP
+#define ESPNOW_HUB_AP 1
+#endif
+
+#ifndef ESPNOW_HUB_AP_PASSWORD
+#define ESPNOW_HUB_AP_PASSWORD "radscan-ring"
+#endif
+
+// Mesh time over ESP-NOW (time_sync.h). Every TIME_SYNC_INTERVAL_S a unit
+// runs TIME_SYNC_BURST two-way exchanges with its time server and keeps the
+// one with the shortest round trip; the last TIME_SYNC_SAMPLES of those give
+// the offset and drift. Units synced within TIME_SYNC_HOLDOVER_S serve time
+// to others, up to TIME_SYNC_MAX_STRATUM hops from the hub. An offset off
+// the prediction by more than TIME_SYNC_STEP_US restarts the fit.
+#ifndef TIME_SYNC_INTERVAL_S
+#define TIME_SYNC_INTERVAL_S 16
+#endif
+
+#ifndef TIME_SYNC_BURST
+#define TIME_SYNC_BURST 8
+#endif
+
+#ifndef TIME_SYNC_SAMPLES
+#define TIME_SYNC_SAMPLES 8
+#endif
+
+#ifndef TIME_SYNC_HOLDOVER_S
+#define TIME_SYNC_HOLDOVER_S 300
+#endif
+
+#ifndef TIME_SYNC_MAX_STRATUM
+#define TIME_SYNC_MAX_STRATUM 3
+#endif
+
+#ifndef TIME_SYNC_STEP_US
+#define TIME_SYNC_STEP_US 10000
+#endif
+
+// Source localisation on the hub (source_locator.h). Detector positions are
+// set with "locate pos"; counts of each detector are averaged over about
+// SOURCE_LOCATOR_TAU_S. The source is assumed SOURCE_LOCATOR_HEIGHT_M off the
+// plane of the detectors, which also keeps the inverse square finite at a
+// detector. At least SOURCE_LOCATOR_MIN_DETECTORS placed, live detectors are
+// needed (four unknowns). Each new interval runs at most
+// SOURCE_LOCATOR_ITERATIONS fit steps and stops early past
+// SOURCE_LOCATOR_BUDGET_US; the next interval goes on from there.
+#ifndef SOURCE_LOCATOR_TAU_S
+#define SOURCE_LOCATOR_TAU_S 60
+#endif
+
+#ifndef SOURCE_LOCATOR_HEIGHT_M
+#define SOURCE_LOCATOR_HEIGHT_M 0.5f
+#endif
+
+#ifndef SOURCE_LOCATOR_MIN_DETECTORS
+#define SOURCE_LOCATOR_MIN_DETECTORS 4
+#endif
+
+#ifndef SOURCE_LOCATOR_ITERATIONS
+#define SOURCE_LOCATOR_ITERATIONS 8
+#endif
+
+#ifndef SOURCE_LOCATOR_BUDGET_US
+#define SOURCE_LOCATOR_BUDGET_US 3000
+#endif
+
+// UDP multicast stream of per-second records (udp_stream.h). Off unless
+// enabled here or with "udp on". The group must be an IPv4 multicast address.
+#ifndef UDP_STREAM_ENABLED
+#define UDP_STREAM_ENABLED 0
+#endif
+
+#ifndef UDP_STREAM_GROUP
+#define UDP_STREAM_GROUP "239.255.82.68"
+#endif
+
+#ifndef UDP_STREAM_PORT
+#define UDP_STREAM_PORT 47268
+#endif
+
+// Modbus TCP server for SCADA polling (modbus_server.h): read-only input and
+// holding registers with the measurement snapshot, for up to
+// MODBUS_MAX_CLIENTS masters at once. A master silent for
+// MODBUS_IDLE_TIMEOUT_MS is disconnected; a new one takes the slot of the
+// longest-idle master when all are in use.
+#ifndef MODBUS_ENABLED
+#define MODBUS_ENABLED 0
+#endif
+
+#ifndef MODBUS_PORT
+#define MODBUS_PORT 502
+#endif
+
+#ifndef MODBUS_MAX_CLIENTS
+#define MODBUS_MAX_CLIENTS 4
+#endif
+
+#ifndef MODBUS_IDLE_TIMEOUT_MS
+#define MODBUS_IDLE_TIMEOUT_MS 60000
+#endif
+
+// Wired Ethernet for fixed installations (ethernet_link.h): a WIZnet W5500 on
+// its own SPI host with DMA, ETH_SPI_HOST, which must not be the display's
+// SPI2. While the cable has a link and an address, the web service, HTTP
+// telemetry, Modbus and the other network services run over it and WiFi is
+// switched off; WiFi comes back when the link drops. Pins of -1 are unset; the
+// chip select, interrupt and SPI pins are required, the reset pin is optional.
+#ifndef ETH_ENABLED
+#define ETH_ENABLED 0
+#endif
+
+#ifndef ETH_SPI_HOST
+#define ETH_SPI_HOST SPI3_HOST
+#endif
+
+#ifndef ETH_SPI_CLOCK_MHZ
+#define ETH_SPI_CLOCK_MHZ 20
+#endif
+
+#ifndef ETH_PIN_SCLK
+#define ETH_PIN_SCLK -1
+#endif
+
+#ifndef ETH_PIN_MOSI
+#define ETH_PIN_MOSI -1
+#endif
+
+#ifndef ETH_PIN_MISO
+#define ETH_PIN_MISO -1
+#endif
+
+#ifndef ETH_PIN_CS
+#define ETH_PIN_CS -1
+#endif
+
+#ifndef ETH_PIN_INT
+#define ETH_PIN_INT -1
+#endif
+
+#ifndef ETH_PIN_RST
+#define ETH_PIN_RST -1
+#endif
+
+// Debug output (debug.h, debug_log.h): 1 queues DEBUG_PRINT* messages in a
+// lock-free ring of DEBUG_LOG_SLOTS (a power of two) that a low-priority task
+// writes out, so a log call never waits for the UART; a full ring drops the
+// message and counts it ("debug stats"). 0 prints from the calling task as
+// before. Lines longer than DEBUG_LOG_LINE_CHARS are cut.
+#ifndef DEBUG_LOG_ASYNC
+#define DEBUG_LOG_ASYNC 1
+#endif
+
+#ifndef DEBUG_LOG_SLOTS
+#define DEBUG_LOG_SLOTS 32
+#endif
+
+#ifndef DEBUG_LOG_LINE_CHARS
+#define DEBUG_LOG_LINE_CHARS 160
+#endif
+
+// Remote syslog of the async debug output (syslog_sink.h), for installs
+// nobody watches the serial port of: lines are collected into one RFC 5424
+// datagram (facility user, severity debug) of up to DEBUG_SYSLOG_BATCH_BYTES,
+// sent when full or DEBUG_SYSLOG_BATCH_MS after its first line, and at most
+// DEBUG_SYSLOG_MAX_PER_MIN datagrams a minute. Silent while WiFi is not
+// connected. "" sends none.
+#ifndef DEBUG_SYSLOG_HOST
+#define DEBUG_SYSLOG_HOST ""
+#endif
+
+#ifndef DEBUG_SYSLOG_PORT
+#define DEBUG_SYSLOG_PORT 514
+#endif
+
+#ifndef DEBUG_SYSLOG_TAG
+#define DEBUG_SYSLOG_TAG "radiation-detector"
+#endif
+
+#ifndef DEBUG_SYSLOG_BATCH_BYTES
+#define DEBUG_SYSLOG_BATCH_BYTES 1024
+#endif
+
+#ifndef DEBUG_SYSLOG_BATCH_MS
+#define DEBUG_SYSLOG_BATCH_MS 2000
+#endif
+
+#ifndef DEBUG_SYSLOG_MAX_PER_MIN
+#define DEBUG_SYSLOG_MAX_PER_MIN 20
+#endif
+
+// Remote screen mirror (screen_mirror.h): tile edge in pixels (must divide
+// the panel size), least time between two passes and concurrent viewers.
+#ifndef SCREEN_MIRROR_TILE
+#define SCREEN_MIRROR_TILE 16
+#endif
+
+#ifndef SCREEN_MIRROR_INTERVAL_MS
+#define SCREEN_MIRROR_INTERVAL_MS 100
+#endif
+
+#ifndef SCREEN_MIRROR_MAX_VIEWERS
+#define SCREEN_MIRROR_MAX_VIEWERS 2
+#endif
+
+// Pulse-width discrimination (pulse_width.h): an RMT channel measures every
+// Geiger pulse and counts those outside PULSE_WIDTH_MIN_US .. PULSE_WIDTH_MAX_US.
+// PULSE_WIDTH_MIN_US also sets the PCNT glitch filter (at most ~12.8 us), so
+// shorter spikes are never counted. PULSE_WIDTH_MAX_US must stay below ~2.6 ms.
+// The histogram has PULSE_WIDTH_BINS bins of PULSE_WIDTH_BIN_US.
+#ifndef PULSE_WIDTH_ENABLED
+#define PULSE_WIDTH_ENABLED 1
+#endif
+
+#ifndef PULSE_WIDTH_MIN_US
+#define PULSE_WIDTH_MIN_US 2
+#endif
+
+#ifndef PULSE_WIDTH_MAX_US
+#define PULSE_WIDTH_MAX_US 500
+#endif
+
+#ifndef PULSE_WIDTH_BIN_US
+#define PULSE_WIDTH_BIN_US 16
+#endif
+
+#ifndef PULSE_WIDTH_BINS
+#define PULSE_WIDTH_BINS 32
+#endif
+
+// Additional GM tubes (counter_channel.h, counter_range.h). 1 counts the main
+// tube only. 2 adds a high-range tube on COUNTER2_PIN (PCNT unit 1): while the
+// main tube is busy for COUNTER_RANGE_UP of each second, the rate and dose
+// follow the high-range tube, until the main tube is below COUNTER_RANGE_DOWN
+// again. COUNTER2_TUBE gives the second tube's name, conversion factor and dead
+// time; "counters" shows both channels.
+#ifndef COUNTER_CHANNELS
+#define COUNTER_CHANNELS 1
+#endif
+
+#ifndef COUNTER2_PIN
+#define COUNTER2_PIN 14
+#endif
+
+#ifndef COUNTER2_TUBE
+#define COUNTER2_TUBE TUBE_J305
+#endif
+
+#ifndef COUNTER_RANGE_UP
+#define COUNTER_RANGE_UP 0.25f
+#endif
+
+#ifndef COUNTER_RANGE_DOWN
+#define COUNTER_RANGE_DOWN 0.10f
+#endif
+
+// Raw pulse traces (pulse_recorder.h): directory on the SD card (or LittleFS),
+// chunk size and count of the PSRAM pool between pulseTask and the writer, and
+// the longest a chunk stays open before it is written.
+#ifndef PULSE_TRACE_DIR
+#define PULSE_TRACE_DIR "/traces"
+#endif
+
+#ifndef PULSE_TRACE_CHUNK_BYTES
+#define PULSE_TRACE_CHUNK_BYTES 4096
+#endif
+
+#ifndef PULSE_TRACE_CHUNKS
+#define PULSE_TRACE_CHUNKS 8
+#endif
+
+#ifndef PULSE_TRACE_FLUSH_MS
+#define PULSE_TRACE_FLUSH_MS 5000
+#endif
+
+// Pulse injector (pulse_injector.h): RMT output wired back to the Geiger input
+// for the counting acceptance test ("inject bench"); -1 leaves it out. Width of
+// the injected pulses, length of each step, the wait for the last second to
+// close, and the allowed error of the dead-time corrected Poisson counts.
+#ifndef PULSE_INJECT_PIN
+#define PULSE_INJECT_PIN -1
+#endif
+
+#ifndef PULSE_INJECT_WIDTH_US
+#define PULSE_INJECT_WIDTH_US 10
+#endif
+
+#ifndef PULSE_INJECT_STEP_S
+#define PULSE_INJECT_STEP_S 10
+#endif
+
+#ifndef PULSE_INJECT_SETTLE_MS
+#define PULSE_INJECT_SETTLE_MS 2500
+#endif
+
+#ifndef PULSE_INJECT_RATE_TOLERANCE
+#define PULSE_INJECT_RATE_TOLERANCE 0.02f
+#endif
+
+#ifndef PULSE_INJECT_MAX_STEPS
+#define PULSE_INJECT_MAX_STEPS 16
+#endif
+
+// End-to-end latency (latency_probe.h): an injected train's trace is given up
+// after LATENCY_TRACE_TIMEOUT_MS. "latency e2e bench" runs up to
+// LATENCY_BENCH_MAX_TRIALS trials at LATENCY_BENCH_RATE_FACTOR times the
+// current alarm threshold, LATENCY_BENCH_SETTLE_MS after the alarm went quiet,
+// and passes if each raised the alarm within LATENCY_ALARM_LIMIT_MS and set the
+// dose-rate label within LATENCY_DISPLAY_LIMIT_MS.
+#ifndef LATENCY_TRACE_TIMEOUT_MS
+#define LATENCY_TRACE_TIMEOUT_MS 60000
+#endif
+
+#ifndef LATENCY_BENCH_MAX_TRIALS
+#define LATENCY_BENCH_MAX_TRIALS 20
+#endif
+
+#ifndef LATENCY_BENCH_RATE_FACTOR
+#define LATENCY_BENCH_RATE_FACTOR 3
+#endif
+
+#ifndef LATENCY_BENCH_SETTLE_MS
+#define LATENCY_BENCH_SETTLE_MS 10000
+#endif
+
+#ifndef LATENCY_ALARM_LIMIT_MS
+#define LATENCY_ALARM_LIMIT_MS 5000
+#endif
+
+#ifndef LATENCY_DISPLAY_LIMIT_MS
+#define LATENCY_DISPLAY_LIMIT_MS 2000
+#endif
+
+// Rate estimator comparison (rate_estimator.h, "estimators", tools/rate_bench.cpp):
+// bits of the candidates pulseTask runs next to the production pipeline on the
+// same buckets: 1 window 10 s, 2 window 60 s, 4 window 300 s, 8 adaptive,
+// 16 EWMA and 32 Bayes (both with time constant RATE_ESTIMATOR_TAU_S; Bayes
+// takes the rate prior), 64 Kalman (drift RATE_ESTIMATOR_KALMAN_DRIFT of the
+// rate per second). 0 runs none; the shown dose rate is not affected.
+#ifndef RATE_ESTIMATOR_SET
+#define RATE_ESTIMATOR_SET 0x7F
+#endif
+
+#ifndef RATE_ESTIMATOR_TAU_S
+#define RATE_ESTIMATOR_TAU_S 60
+#endif
+
+#ifndef RATE_ESTIMATOR_KALMAN_DRIFT
+#define RATE_ESTIMATOR_KALMAN_DRIFT 0.02f
+#endif
+
+// Rate prior after boot (rate_prior.h, background_store.h): the last session's
+// background, with its count statistics and a spread of RATE_PRIOR_SPREAD of
+// its value for a different place, weighs at most RATE_PRIOR_MAX_SECONDS of
+// data (0 turns the prior off) and is dropped when the counts are more than
+// RATE_PRIOR_CONFLICT_Z sigmas off it. The background is saved every
+// BACKGROUND_SAVE_INTERVAL_S once a session has counted for
+// BACKGROUND_MIN_SESSION_S.
+#ifndef RATE_PRIOR_MAX_SECONDS
+#define RATE_PRIOR_MAX_SECONDS 30
+#endif
+
+#ifndef RATE_PRIOR_SPREAD
+#define RATE_PRIOR_SPREAD 0.25f
+#endif
+
+#ifndef RATE_PRIOR_CONFLICT_Z
+#define RATE_PRIOR_CONFLICT_Z 3.0f
+#endif
+
+#ifndef BACKGROUND_SAVE_INTERVAL_S
+#define BACKGROUND_SAVE_INTERVAL_S 900
+#endif
+
+#ifndef BACKGROUND_MIN_SESSION_S
+#define BACKGROUND_MIN_SESSION_S 600
+#endif
+
+// Hardware-gated scaler (scaler.h): SCALER_GATE_PIN is a spare GPIO that
+// carries the gate (nothing needs to be wired to it); -1 leaves the scaler out.
+// It takes PCNT unit SCALER_PCNT_UNIT (2 or 3; the counter channels have 0 and
+// 1) and RMT transmit channel SCALER_RMT_CHANNEL (0 is the injector's, 1 the
+// status LED's). Runs are limited to SCALER_MAX_TIME_S, whose gate takes
+// 4 bytes of PSRAM per 65 ms; the last SCALER_HISTORY_SIZE results are kept.
+#ifndef SCALER_GATE_PIN
+#define SCALER_GATE_PIN -1
+#endif
+
+#ifndef SCALER_PCNT_UNIT
+#define SCALER_PCNT_UNIT 3
+#endif
+
+#ifndef SCALER_RMT_CHANNEL
+#define SCALER_RMT_CHANNEL 2
+#endif
+
+#ifndef SCALER_MAX_TIME_S
+#define SCALER_MAX_TIME_S 3600
+#endif
+
+#ifndef SCALER_HISTORY_SIZE
+#define SCALER_HISTORY_SIZE 8
+#endif
+
+// Hot-spot search (search_mode.h): the buzzer pitch follows the rate of the
+// last SEARCH_WINDOW_MS, recomputed SEARCH_UPDATE_HZ times a second (20 or
+// more keeps the tone within a few tens of ms of the pulses). The pitch runs
+// from SEARCH_PITCH_MIN_HZ at the background to SEARCH_PITCH_MAX_HZ, rising
+// SEARCH_PITCH_OCTAVES_PER_DECADE per tenfold rate. The ISR keeps the last
+// SEARCH_RING_SIZE pulse times (a power of two); above SEARCH_RING_SIZE pulses
+// per window the rate comes from the span of the ring instead.
+#ifndef SEARCH_WINDOW_MS
+#define SEARCH_WINDOW_MS 200
+#endif
+
+#ifndef SEARCH_UPDATE_HZ
+#define SEARCH_UPDATE_HZ 25
+#endif
+
+#ifndef SEARCH_PITCH_MIN_HZ
+#define SEARCH_PITCH_MIN_HZ 400
+#endif
+
+#ifndef SEARCH_PITCH_MAX_HZ
+#define SEARCH_PITCH_MAX_HZ 4000
+#endif
+
+#ifndef SEARCH_PITCH_OCTAVES_PER_DECADE
+#define SEARCH_PITCH_OCTAVES_PER_DECADE 1.5f
+#endif
+
+#ifndef SEARCH_RING_SIZE
+#define SEARCH_RING_SIZE 128
+#endif
+
+// Tube diagnostics (tube_health.h): half-life of the inter-arrival histogram,
+// evaluation window, short intervals needed for a dead-time estimate, and the
+// thresholds of the afterpulsing, double-trigger, rate-shift and HV checks.
+#ifndef TUBE_HEALTH_HALF_LIFE_S
+#define TUBE_HEALTH_HALF_LIFE_S 3600
+#endif
+
+#ifndef TUBE_HEALTH_WINDOW_S
+#define TUBE_HEALTH_WINDOW_S 10
+#endif
+
+#ifndef TUBE_HEALTH_MIN_BELOW
+#define TUBE_HEALTH_MIN_BELOW 100
+#endif
+
+#ifndef TUBE_AFTERPULSE_RATIO
+#define TUBE_AFTERPULSE_RATIO 1.5f
+#endif
+
+#ifndef TUBE_DOUBLE_TRIGGER_FRACTION
+#define TUBE_DOUBLE_TRIGGER_FRACTION 0.001f
+#endif
+
+#ifndef TUBE_RATE_SHIFT_FRACTION
+#define TUBE_RATE_SHIFT_FRACTION 0.25f
+#endif
+
+#ifndef TUBE_HV_DRIFT_V
+#define TUBE_HV_DRIFT_V 15.0f
+#endif
+
+// Rate anomaly detection and event capture (anomaly_capture.h): a Poisson
+// CUSUM tuned to a rate ANOMALY_SHIFT times the learned background triggers
+// at ANOMALY_THRESHOLD nats: at background about one false trigger in three
+// weeks, a doubled rate found after about 90 s, a hot source at once. The
+// pulse trace around it is kept from ANOMALY_PRE_S before the trigger
+// (in ANOMALY_PRE_CHUNKS chunks of the trace pool) to ANOMALY_POST_S after
+// the last one. 0 leaves event capture disarmed at boot ("anomaly arm").
+#ifndef ANOMALY_CAPTURE_ENABLED
+#define ANOMALY_CAPTURE_ENABLED 1
+#endif
+
+#ifndef ANOMALY_SHIFT
+#define ANOMALY_SHIFT 2.0f
+#endif
+
+#ifndef ANOMALY_THRESHOLD
+#define ANOMALY_THRESHOLD 12.0f
+#endif
+
+#ifndef ANOMALY_LEARN_TAU_S
+#define ANOMALY_LEARN_TAU_S 3600
+#endif
+
+#ifndef ANOMALY_WARMUP_S
+#define ANOMALY_WARMUP_S 300
+#endif
+
+#ifndef ANOMALY_PRE_S
+#define ANOMALY_PRE_S 120
+#endif
+
+#ifndef ANOMALY_POST_S
+#define ANOMALY_POST_S 300
+#endif
+
+#ifndef ANOMALY_PRE_CHUNKS
+#define ANOMALY_PRE_CHUNKS 4
+#endif
+
+// Status LED (status_led.h) on STATUS_LED_PIN, -1 if none. STATUS_LED_TYPE 0:
+// STATUS_LED_COUNT WS2812-type pixels in STATUS_LED_ORDER (Adafruit_NeoPixel
+// NEO_* order) on RMT transmit channel STATUS_LED_RMT_CHANNEL (0 is the pulse
+// injector's); 1: a single-colour LED on LEDC. Frame period and default
+// brightness (0-255).
+#ifndef STATUS_LED_PIN
+#define STATUS_LED_PIN -1
+#endif
+
+#ifndef STATUS_LED_TYPE
+#define STATUS_LED_TYPE 0
+#endif
+
+#ifndef STATUS_LED_COUNT
+#define STATUS_LED_COUNT 1
+#endif
+
+#ifndef STATUS_LED_ORDER
+#define STATUS_LED_ORDER NEO_GRB
+#endif
+
+#ifndef STATUS_LED_RMT_CHANNEL
+#define STATUS_LED_RMT_CHANNEL 1
+#endif
+
+#ifndef STATUS_LED_FRAME_MS
+#define STATUS_LED_FRAME_MS 40
+#endif
+
+#ifndef STATUS_LED_BRIGHTNESS
+#define STATUS_LED_BRIGHTNESS 48
+#endif
+
+// Local styles of the generated screens are replaced by shared, deduplicated
+// styles after each build (ui_style_share.h); 0 keeps LVGL's per-object
+// local styles. UI_STYLE_SHARE_MAX distinct property sets are shared (12 bytes
+// of internal RAM each), the rest stay local.
+#ifndef UI_STYLE_SHARING
+#define UI_STYLE_SHARING 1
+#endif
+
+#ifndef UI_STYLE_SHARE_MAX
+#define UI_STYLE_SHARE_MAX 256
+#endif
+
+// Layout-only containers of the main and chart screens are dissolved after
+// each build (ui_flatten.h), leaving fewer objects to clip and lay out; 0
+// keeps the generated tree.
+#ifndef UI_FLATTEN_SCREENS
+#define UI_FLATTEN_SCREENS 1
+#endif
+
+// The static layer of the main and chart screens (dividers, captions, icons)
+// is rendered once after each build into a full-screen RGB565 image in PSRAM
+// (ui_backdrop.h, 300 KB per screen) and redrawn areas copy it instead of
+// drawing those objects again. Needs PSRAM; screens stay as they are without.
+#ifndef UI_SCREEN_BACKDROPS
+#define UI_SCREEN_BACKDROPS 1
+#endif
+
+// LVGL renders into a full-screen framebuffer in PSRAM (direct mode) and only
+// the redrawn areas are sent to the panel, instead of rendering every area in
+// 1/10-screen stripes. Costs 300 KB of PSRAM and no internal RAM; whether it
+// is faster depends on the board's PSRAM and SPI clocks ("display bench").
+#ifndef DISPLAY_DIRECT_MODE
+#define DISPLAY_DIRECT_MODE 0
+#endif
+
+// Requests other tasks may queue for uiTask (ui_async.h): widget updates
+// still pending at the start of a pass, and the longest label text one
+// carries (longer text is cut).
+#ifndef UI_ASYNC_SLOTS
+#define UI_ASYNC_SLOTS 32
+#endif
+
+#ifndef UI_ASYNC_TEXT_MAX
+#define UI_ASYNC_TEXT_MAX 48
+#endif
+
+// Demo build: 1 runs LVGL's benchmark, 2 its stress test on the panel
+// instead of the firmware (lvgl_demo.h); results go to serial as JSON lines.
+// Set it with -DLVGL_DEMO=1 so lv_conf.h sees it too; 0 is the firmware.
+#ifndef LVGL_DEMO
+#define LVGL_DEMO 0
+#endif
+
+// Interval of the stress test's reports
+#ifndef LVGL_DEMO_REPORT_MS
+#define LVGL_DEMO_REPORT_MS 10000
+#endif
+
+// Headless logger build for fixed, enclosed installations: measurement,
+// storage and network without the panel. LVGL, TFT_eSPI, the SquareLine
+// screens and every view module are compiled out; uiTask keeps only its
+// control step (rates, dose, charts, alarms, WiFi) and the dashboard, serial,
+// BLE and telemetry are the readouts. Set it with -DHEADLESS=1 in an
+// environment that also leaves out the lvgl and TFT_eSPI libraries and the
+// SquareLine export (README); 0 is the handheld.
+#ifndef HEADLESS
+#define HEADLESS 0
+#endif
+
+// SPI pins of the microSD card in the headless build. With the panel,
+// TFT_eSPI starts the shared bus with the pins of its User_Setup.h.
+#ifndef SD_SCLK_PIN
+#define SD_SCLK_PIN 12
+#endif
+
+#ifndef SD_MISO_PIN
+#define SD_MISO_PIN 13
+#endif
+
+#ifndef SD_MOSI_PIN
+#define SD_MOSI_PIN 11
+#endif
+
+#endif // CONFIG_H
@@ -0,0 +1,363 @@
+/**
+ * @file config_api.cpp
+ * @brief Typed configuration document, validation, and the batch hand-off to uiTask.
+ *
+ * The PUT handler validates on the web task and leaves the patch in a single
+ * slot. It then waits up to APPLY_WAIT_MS for uiTask to apply it, so the
+ * client gets back the configuration as stored, not only a receipt. A second
+ * PUT arriving while one is queued gets 503. Serial batches run on uiTask
+ * and apply directly.
+ */
+
+#include "config_api.h"
+#include "settings_store.h"
+#include "wifi_manager.h"
+#include "json_body.h"
+#include "json_arena.h"
+#include "web_arena.h"
+#include "debug.h"
+#include <math.h>
+#include <atomic>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+static const uint32_t APPLY_WAIT_MS = 2000;
+static const uint32_t RECONNECT_DELAY_MS = 1500;  ///< Lets the answer leave before the link drops
+
+enum FieldKind : uint8_t { KIND_BOOL, KIND_NUMBER, KIND_STRING };
+
+struct FieldDef {
+    const char* key;
+    uint16_t field;
+    uint8_t kind;
+    float min;   ///< Numbers: lowest value; strings: shortest length
+    float max;   ///< Numbers: highest value; strings: longest length
+};
+
+static const FieldDef FIELDS[] = {
+    {"alarm_enabled", CONFIG_FIELD_ALARM_ENABLED, KIND_BOOL, 0.0f, 0.0f},
+    {"rate_alarm_usv_h", CONFIG_FIELD_RATE_ALARM, KIND_NUMBER, 0.0f, ALARM_THRESHOLD_MAX_X10 / 10.0f},
+    {"dose_alarm_msv", CONFIG_FIELD_DOSE_ALARM, KIND_NUMBER, 0.0f, ALARM_THRESHOLD_MAX_X10 / 10.0f},
+    {"cpm_per_usv_h", CONFIG_FIELD_CONVERSION, KIND_NUMBER, CONVERSION_FACTOR_MIN, CONVERSION_FACTOR_MAX},
+    {"dead_time_us", CONFIG_FIELD_DEAD_TIME, KIND_NUMBER, 0.0f, DEAD_TIME_MAX_US - 0.1f},
+    {"hv_target_v", CONFIG_FIELD_HV_TARGET, KIND_NUMBER, HV_MIN_V, HV_MAX_V},
+    {"display_timeout_s", CONFIG_FIELD_DISPLAY_TIMEOUT, KIND_NUMBER, DISPLAY_TIMEOUT_MIN_MS / 1000.0f,
+     DISPLAY_TIMEOUT_MAX_MS / 1000.0f},
+    {"clicks", CONFIG_FIELD_CLICKS, KIND_BOOL, 0.0f, 0.0f},
+    {"wifi_auto_connect", CONFIG_FIELD_WIFI_AUTO, KIND_BOOL, 0.0f, 0.0f},
+    {"wifi_ssid", CONFIG_FIELD_WIFI_SSID, KIND_STRING, 1.0f, 32.0f},
+    {"wifi_password", CONFIG_FIELD_WIFI_PASSWORD, KIND_STRING, 0.0f, 63.0f},
+    {"campaign_enabled", CONFIG_FIELD_CAMPAIGN_ENABLED, KIND_BOOL, 0.0f, 0.0f},
+    {"campaign_windows", CONFIG_FIELD_CAMPAIGN_WINDOWS, KIND_STRING, 0.0f, 63.0f},
+    {"campaign_uploads", CONFIG_FIELD_CAMPAIGN_UPLOADS, KIND_STRING, 0.0f, 63.0f},
+};
+static const uint8_t FIELD_COUNT = sizeof(FIELDS) / sizeof(FIELDS[0]);
+
+// Reported by GET, accepted and ignored by PUT
+static const char* const READ_ONLY[] = {"version", "revision", "wifi_password_set"};
+
+static ConfigPatch staged;                      ///< Serial batch (uiTask)
+static ConfigPatch queued;                      ///< PUT batch, web task -> uiTask
+static std::atomic<bool> queuedReady(false);
+static std::atomic<uint32_t> queuedSeq(0);
+static std::atomic<uint32_t> appliedSeq(0);
+static std::atomic<bool> lastApplyOk(true);
+static bool reconnectDue = false;               ///< uiTask
+static uint32_t reconnectAtMs = 0;
+static ConfigApiStats stats;
+static WebServer* configServer = nullptr;
+
+static const FieldDef* findField(const char* key) {
+    for (uint8_t i = 0; i < FIELD_COUNT; i++) {
+        if (strcmp(FIELDS[i].key, key) == 0) return &FIELDS[i];
+    }
+    return nullptr;
+}
+
+static bool readOnlyKey(const char* key) {
+    for (const char* k : READ_ONLY) {
+        if (strcmp(k, key) == 0) return true;
+    }
+    return false;
+}
+
+const char* configPatchSet(ConfigPatch& patch, const char* key, JsonVariantConst value) {
+    const FieldDef* def = findField(key);
+    if (!def) return readOnlyKey(key) ? nullptr : "unknown field";
+
+    DeviceConfig& c = patch.values;
+    if (def->kind == KIND_BOOL) {
+        if (!value.is<bool>()) return "must be true or false";
+        bool b = value.as<bool>();
+        switch (def->field) {
+            case CONFIG_FIELD_ALARM_ENABLED: c.alarmEnabled = b; break;
+            case CONFIG_FIELD_CLICKS:        c.clicksEnabled = b; break;
+            case CONFIG_FIELD_WIFI_AUTO:     c.wifiAutoConnect = b; break;
+            case CONFIG_FIELD_CAMPAIGN_ENABLED: patch.campaign.enabled = b; break;
+        }
+    } else if (def->kind == KIND_NUMBER) {
+        if (!value.is<float>()) return "must be a number";
+        float f = value.as<float>();
+        if (!isfinite(f) || f < def->min || f > def->max) return "out of range";
+        switch (def->field) {
+            case CONFIG_FIELD_RATE_ALARM:      c.currentAlarmX10 = (int32_t)lroundf(f * 10.0f); break;
+            case CONFIG_FIELD_DOSE_ALARM:      c.cumulativeAlarmX10 = (int32_t)lroundf(f * 10.0f); break;
+            case CONFIG_FIELD_CONVERSION:      c.cpmPerUsvH = f; break;
+            case CONFIG_FIELD_DEAD_TIME:       c.deadTimeUs = f; break;
+            case CONFIG_FIELD_HV_TARGET:       c.hvTargetV = f; break;
+            case CONFIG_FIELD_DISPLAY_TIMEOUT: c.displayTimeoutMs = (uint32_t)lroundf(f) * 1000; break;
+        }
+    } else {
+        if (!value.is<const char*>()) return "must be a string";
+        const char* s = value.as<const char*>();
+        size_t n = strlen(s);
+        if (n < def->min || n > def->max) return "wrong length";
+        if (def->field == CONFIG_FIELD_WIFI_PASSWORD && n > 0 && n < 8) return "WPA2 needs 8 to 63 characters";
+        if (def->field == CONFIG_FIELD_CAMPAIGN_WINDOWS) {
+            const char* error = campaignParseWindows(s, patch.campaign);
+            if (error) return error;
+        } else if (def->field == CONFIG_FIELD_CAMPAIGN_UPLOADS) {
+            const char* error = campaignParseUploads(s, patch.campaign);
+            if (error) return error;
+        } else {
+            strlcpy(def->field == CONFIG_FIELD_WIFI_SSID ? patch.ssid : patch.password, s,
+                    def->field == CONFIG_FIELD_WIFI_SSID ? sizeof(patch.ssid) : sizeof(patch.password));
+        }
+    }
+    patch.fields |= def->field;
+    return nullptr;
+}
+
+/**
+ * @brief Checks the rules that span fields. @return nullptr or the reason
+ */
+static const char* checkPatch(const ConfigPatch& patch) {
+    // An SSID alone would silently keep the old network's password
+    bool ssid = patch.fields & CONFIG_FIELD_WIFI_SSID;
+    bool password = patch.fields & CONFIG_FIELD_WIFI_PASSWORD;
+    if (ssid != password) return "wifi_ssid and wifi_password go together (\"\" for an open network)";
+    return nullptr;
+}
+
+bool configPatchFromJson(JsonVariantConst body, ConfigPatch& patch, JsonObject errors) {
+    memset(&patch, 0, sizeof(patch));
+    if (!body.is<JsonObjectConst>()) {
+        errors["body"] = "must be a JSON object";
+        return false;
+    }
+    bool ok = true;
+    for (JsonPairConst field : body.as<JsonObjectConst>()) {
+        const char* error = configPatchSet(patch, field.key().c_str(), field.value());
+        if (error) {
+            errors[field.key()] = error;
+            ok = false;
+        }
+    }
+    const char* error = checkPatch(patch);
+    if (error) {
+        errors["wifi"] = error;
+        ok = false;
+    }
+    return ok;
+}
+
+bool configApply(const ConfigPatch& patch) {
+    if (patch.fields & CONFIG_FIELD_DEVICE) {
+        DeviceConfig c = getDeviceConfig();
+        const DeviceConfig& v = patch.values;
+        if (patch.fields & CONFIG_FIELD_ALARM_ENABLED) c.alarmEnabled = v.alarmEnabled;
+        if (patch.fields & CONFIG_FIELD_RATE_ALARM) c.currentAlarmX10 = v.currentAlarmX10;
+        if (patch.fields & CONFIG_FIELD_DOSE_ALARM) c.cumulativeAlarmX10 = v.cumulativeAlarmX10;
+        if (patch.fields & CONFIG_FIELD_CONVERSION) c.cpmPerUsvH = v.cpmPerUsvH;
+        if (patch.fields & CONFIG_FIELD_DEAD_TIME) c.deadTimeUs = v.deadTimeUs;
+        if (patch.fields & CONFIG_FIELD_HV_TARGET) c.hvTargetV = v.hvTargetV;
+        if (patch.fields & CONFIG_FIELD_DISPLAY_TIMEOUT) c.displayTimeoutMs = v.displayTimeoutMs;
+        if (patch.fields & CONFIG_FIELD_CLICKS) c.clicksEnabled = v.clicksEnabled;
+        if (patch.fields & CONFIG_FIELD_WIFI_AUTO) c.wifiAutoConnect = v.wifiAutoConnect;
+        setDeviceConfig(c); // One publish: readers see the whole batch or none of it
+    }
+
+    bool ok = true;
+    if (patch.fields & CONFIG_FIELD_WIFI_SSID) {
+        bool hadPassword;
+        String oldSsid = wifiManagerSavedSsid(&hadPassword);
+        ok = wifiManagerSaveCredentials(patch.ssid, patch.password);
+        // Rejoin if the station is in use or is meant to connect at boot
+        if (ok && (wifiManagerState() != WIFI_STATE_IDLE || getDeviceConfig().wifiAutoConnect)) {
+            reconnectDue = true;
+            reconnectAtMs = millis() + RECONNECT_DELAY_MS;
+        }
+        DEBUG_PRINTF("Config: WiFi credentials %s (was %s)\n", patch.ssid, oldSsid.c_str());
+    }
+    if (patch.fields & CONFIG_FIELD_CAMPAIGN) {
+        CampaignSchedule c = campaignSchedule();
+        const CampaignSchedule& v = patch.campaign;
+        if (patch.fields & CONFIG_FIELD_CAMPAIGN_ENABLED) c.enabled = v.enabled;
+        if (patch.fields & CONFIG_FIELD_CAMPAIGN_WINDOWS) {
+            c.windowCount = v.windowCount;
+            memcpy(c.windows, v.windows, sizeof(c.windows));
+        }
+        if (patch.fields & CONFIG_FIELD_CAMPAIGN_UPLOADS) {
+            c.uploadCount = v.uploadCount;
+            memcpy(c.uploads, v.uploads, sizeof(c.uploads));
+        }
+        ok = campaignSetSchedule(c) && ok;
+    }
+
+    settingsFlush(); // The batch in one NVS commit, before anyone is told it is stored
+    if (getSettingsStoreStats().pending) ok = false;
+
+    stats.applied++;
+    if (!ok) stats.storeFailures++;
+    DEBUG_PRINTF("Config: batch of %u field(s) applied%s\n", (unsigned)__builtin_popcount(patch.fields),
+                 ok ? "" : ", NOT fully stored");
+    return ok;
+}
+
+void configApiLoop(uint32_t nowMs) {
+    if (queuedReady.load()) {
+        ConfigPatch patch = queued;
+        uint32_t seq = queuedSeq.load();
+        lastApplyOk = configApply(patch);
+        queuedReady = false;
+        appliedSeq = seq;
+    }
+    if (reconnectDue && (int32_t)(nowMs - reconnectAtMs) >= 0) {
+        reconnectDue = false;
+        wifiManagerConnectSaved();
+    }
+}
+
+void buildConfigJson(JsonDocument& doc) {
+    DeviceConfig c = getDeviceConfig();
+    bool hasPassword;
+    String ssid = wifiManagerSavedSsid(&hasPassword);
+    doc["version"] = c.version;
+    doc["revision"] = deviceConfigRevision();
+    doc["alarm_enabled"] = c.alarmEnabled;
+    doc["rate_alarm_usv_h"] = c.currentAlarmUsvH();
+    doc["dose_alarm_msv"] = c.cumulativeAlarmMsv();
+    doc["cpm_per_usv_h"] = c.cpmPerUsvH;
+    doc["dead_time_us"] = c.deadTimeUs;
+    doc["hv_target_v"] = c.hvTargetV;
+    doc["display_timeout_s"] = c.displayTimeoutMs / 1000;
+    doc["clicks"] = c.clicksEnabled;
+    doc["wifi_auto_connect"] = c.wifiAutoConnect;
+    doc["wifi_ssid"] = ssid;
+    doc["wifi_password_set"] = hasPassword;
+    CampaignSchedule campaign = campaignSchedule();
+    char text[64];
+    doc["campaign_enabled"] = campaign.enabled;
+    campaignFormatWindows(campaign, text, sizeof(text));
+    doc["campaign_windows"] = text; // Copied: text is reused below
+    campaignFormatUploads(campaign, text, sizeof(text));
+    doc["campaign_uploads"] = text;
+}
+
+String getConfigJson() {
+    JsonArenaLease lease;
+    JsonDocument doc(lease.allocator());
+    buildConfigJson(doc);
+    String json;
+    serializeJson(doc, json);
+    return json;
+}
+
+/**
+ * @brief Answers with the configuration as it is now.
+ */
+static void sendConfig(WebServer& server, int code) {
+    JsonArenaLease lease;
+    JsonDocument doc(lease.allocator());
+    buildConfigJson(doc);
+    webSendJson(server, code, doc);
+}
+
+const char* configStage(const char* key, const char* value) {
+    const FieldDef* def = findField(key);
+    if (!def) return "unknown field";
+    JsonDocument doc;
+    if (def->kind == KIND_STRING) {
+        doc.set(value); // Taken as typed, no quotes
+    } else if (deserializeJson(doc, value)) {
+        return def->kind == KIND_BOOL ? "must be true or false" : "must be a number";
+    }
+    ConfigPatch next = staged;
+    const char* error = configPatchSet(next, key, doc.as<JsonVariantConst>());
+    if (!error) staged = next;
+    return error;
+}
+
+const char* configCommitStaged() {
+    if (!staged.fields) return "nothing staged";
+    const char* error = checkPatch(staged);
+    if (error) {
+        stats.rejected++;
+        return error; // Still staged, so the missing field can be added
+    }
+    bool ok = configApply(staged);
+    configDiscardStaged();
+    return ok ? nullptr : "applied, but not all of it could be stored";
+}
+
+void configDiscardStaged() {
+    memset(&staged, 0, sizeof(staged));
+}
+
+uint16_t configStagedFields() {
+    return staged.fields;
+}
+
+ConfigApiStats getConfigApiStats() {
+    return stats;
+}
+
+/**
+ * @brief PUT /api/config: validates the batch, hands it to uiTask and answers
+ *        with the stored configuration.
+ */
+static void handleConfigPut(WebServer& server, JsonVariantConst body) {
+    server.sendHeader("Cache-Control", "no-store");
+    {
+        JsonArenaLease lease;
+        JsonDocument reply(lease.allocator());
+        JsonObject errors = reply["fields"].to<JsonObject>();
+        ConfigPatch patch;
+        if (!configPatchFromJson(body, patch, errors)) {
+            stats.rejected++;
+            reply["error"] = "invalid configuration, nothing changed";
+            webSendJson(server, 400, reply);
+            return;
+        }
+        if (queuedReady.load()) {
+            stats.busy++;
+            server.sendHeader("Retry-After", "1");
+            server.send(503, "text/plain", "Another configuration is being applied");
+            return;
+        }
+        queued = patch;
+        queuedSeq = queuedSeq.load() + 1;
+        queuedReady = true;
+    }
+
+    uint32_t seq = queuedSeq.load();
+    uint32_t startMs = millis();
+    while ((int32_t)(appliedSeq.load() - seq) < 0 && millis() - startMs < APPLY_WAIT_MS) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    if ((int32_t)(appliedSeq.load() - seq) < 0) {
+        server.send(202, "text/plain", "Queued"); // uiTask is busy; it applies the batch on its next pass
+    } else {
+        sendConfig(server, lastApplyOk.load() ? 200 : 500); // 500: live, but not all of it reached flash
+    }
+}
+
+void configApiAttach(WebServer& server) {
+    configServer = &server;
+    server.on("/api/config", HTTP_GET, []() {
+        configServer->sendHeader("Cache-Control", "no-store");
+        configServer->sendHeader("Access-Control-Allow-Origin", "*");
+        sendConfig(*configServer, 200);
+    });
+    jsonBodyOn(server, "/api/config", nullptr, handleConfigPut, HTTP_PUT);
+}
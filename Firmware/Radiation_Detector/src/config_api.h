@@ -0,0 +1,99 @@
+#ifndef CONFIG_API_H
+#define CONFIG_API_H
+
+#include <Arduino.h>
+#include <WebServer.h>
+#include <ArduinoJson.h>
+#include "device_config.h"
+#include "campaign.h"
+
+// Bulk configuration for provisioning: GET and PUT /api/config and the serial
+// "config set ... / config commit" pair for factory lines.
+//
+// The typed configuration is one flat JSON object. It holds the
+// DeviceConfig fields in user units, plus the WiFi credentials, which are
+// saved by wifi_manager.h. The password is write-only: GET reports only
+// whether one is stored. The acquisition campaign (campaign.h) is there too:
+// campaign_enabled, and campaign_windows and campaign_uploads in the text
+// form "HH:MM-HH:MM,..." and "HH:MM,...". A PUT may carry any subset of the fields. Every
+// field is checked for type and range before anything changes. One bad
+// field, an unknown key, or an SSID without its password rejects the whole
+// request with 400 and a reason per field. The fields GET reports but PUT
+// cannot set ("version", "revision", "wifi_password_set") are ignored, so a
+// GET result can be PUT back.
+//
+// A valid batch is applied on uiTask, which owns the read-modify-write of
+// the configuration. It is published with one setDeviceConfig(), so readers
+// see all of the batch or none of it. Every subsystem reads the published
+// snapshot (alarms, dose maths, HV target, display timeout, the settings
+// widgets), so the batch takes effect without a reboot. The settings store
+// then writes the changed keys in one NVS session with a single commit
+// before the answer goes out. Changed WiFi credentials are saved in the
+// same pass; once the answer has left, the station reconnects with them.
+
+enum ConfigField : uint16_t {
+    CONFIG_FIELD_ALARM_ENABLED = 1 << 0,
+    CONFIG_FIELD_RATE_ALARM = 1 << 1,
+    CONFIG_FIELD_DOSE_ALARM = 1 << 2,
+    CONFIG_FIELD_CONVERSION = 1 << 3,
+    CONFIG_FIELD_DEAD_TIME = 1 << 4,
+    CONFIG_FIELD_HV_TARGET = 1 << 5,
+    CONFIG_FIELD_DISPLAY_TIMEOUT = 1 << 6,
+    CONFIG_FIELD_CLICKS = 1 << 7,
+    CONFIG_FIELD_WIFI_AUTO = 1 << 8,
+    CONFIG_FIELD_WIFI_SSID = 1 << 9,
+    CONFIG_FIELD_WIFI_PASSWORD = 1 << 10,
+    CONFIG_FIELD_CAMPAIGN_ENABLED = 1 << 11,
+    CONFIG_FIELD_CAMPAIGN_WINDOWS = 1 << 12,
+    CONFIG_FIELD_CAMPAIGN_UPLOADS = 1 << 13,
+    CONFIG_FIELD_DEVICE = (1 << 9) - 1,  ///< Fields of DeviceConfig
+    CONFIG_FIELD_CAMPAIGN = 7 << 11      ///< Fields of CampaignSchedule
+};
+
+// A validated set of changes; only the fields in the mask are applied.
+struct ConfigPatch {
+    uint16_t fields;
+    DeviceConfig values;
+    char ssid[33];
+    char password[64];
+    CampaignSchedule campaign;
+};
+
+struct ConfigApiStats {
+    uint32_t applied;       ///< Batches applied (web and serial)
+    uint32_t rejected;      ///< Failed validation
+    uint32_t busy;          ///< Refused while another batch was queued
+    uint32_t storeFailures; ///< Applied, but NVS or the credentials could not be written
+};
+
+// Sets one field from JSON. @return nullptr, or why the value is refused
+const char* configPatchSet(ConfigPatch& patch, const char* key, JsonVariantConst value);
+
+// Validates a whole object into @p patch. Reasons go to @p errors, keyed by field.
+// @return true if every field was accepted
+bool configPatchFromJson(JsonVariantConst body, ConfigPatch& patch, JsonObject errors);
+
+// uiTask: applies @p patch now. @return false if something could not be stored
+bool configApply(const ConfigPatch& patch);
+
+// uiTask loop: applies a batch queued by PUT and reconnects WiFi when due.
+void configApiLoop(uint32_t nowMs);
+
+// The configuration as GET /api/config returns it.
+void buildConfigJson(JsonDocument& doc);
+String getConfigJson();
+
+// Serial "config set <key> <value>": stages a field, checked right away.
+// Stays staged until "config commit" applies the batch or "config discard"
+// drops it. uiTask only. Both return nullptr, or why nothing (or not all) was done.
+const char* configStage(const char* key, const char* value);
+const char* configCommitStaged();
+void configDiscardStaged();
+uint16_t configStagedFields();
+
+ConfigApiStats getConfigApiStats();
+
+// Registers GET and PUT /api/config.
+void configApiAttach(WebServer& server);
+
+#endif // CONFIG_API_H
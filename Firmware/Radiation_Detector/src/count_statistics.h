@@ -0,0 +1,162 @@
+#ifndef COUNT_STATISTICS_H
+#define COUNT_STATISTICS_H
+
+#include <math.h>
+#include <stdint.h>
+#include "dead_time.h"
+
+// Count-statistics uncertainty of a rate measured as N counts in T seconds.
+// The interval comes from the square-root transform. sqrt(N) is close to
+// normal with sigma 1/2, so the bounds are (sqrt(N) - z/2)^2 and
+// (sqrt(N + 1) + z/2)^2. Unlike N +- z*sqrt(N), the interval stays positive
+// and usable down to a handful of counts. The inputs are the window sums the
+// estimators already keep, so an evaluation is O(1). The dead-time correction
+// is monotonic and maps the bounds as they are; the Poisson sigma is carried
+// through its derivative. No Arduino dependencies (host-compilable).
+
+static const float CONFIDENCE_Z_95 = 1.96f; ///< Two-sided 95 % interval
+
+/**
+ * @brief Confidence bounds of a Poisson mean for @p counts observed.
+ * @param z Sigmas on each side
+ */
+inline void poissonBounds(uint32_t counts, float z, float* lower, float* upper) {
+    float lowRoot = sqrtf((float)counts) - z * 0.5f;
+    *lower = lowRoot > 0.0f ? lowRoot * lowRoot : 0.0f;
+    float highRoot = sqrtf((float)counts + 1.0f) + z * 0.5f;
+    *upper = highRoot * highRoot;
+}
+
+/**
+ * @brief A rate with its count-statistics uncertainty, in the caller's units.
+ */
+struct RateUncertainty {
+    float rate;   ///< Dead-time corrected rate
+    float sigma;  ///< Poisson 1-sigma of rate
+    float lower;  ///< Confidence bounds
+    float upper;
+
+    /// Half-width of the interval.
+    float halfWidth() const { return (upper - lower) * 0.5f; }
+
+    /// Half-width relative to the rate; 1 while nothing was counted.
+    float relative() const { return rate > 0.0f ? halfWidth() / rate : 1.0f; }
+};
+
+/**
+ * @param counts       Counts in the window
+ * @param seconds      Window length
+ * @param z            Sigmas on each side of the interval
+ * @param deadTimeSec  Tube dead time; <= 0 leaves the rate uncorrected
+ * @param scale        Output units per count per second (e.g. µSv/h per cps)
+ */
+inline RateUncertainty rateUncertainty(uint32_t counts, float seconds, float z, float deadTimeSec, float scale) {
+    RateUncertainty r = {0.0f, 0.0f, 0.0f, 0.0f};
+    if (seconds <= 0.0f) return r;
+    float perSecond = 1.0f / seconds;
+    float measured = counts * perSecond;
+    r.rate = correctDeadTimeCps(measured, deadTimeSec) * scale;
+
+    // dn/dm = 1 / (1 - m*tau)^2 for the non-paralyzable model
+    float fraction = deadTimeSec > 0.0f ? measured * deadTimeSec : 0.0f;
+    if (fraction > DEAD_TIME_MAX_FRACTION) fraction = DEAD_TIME_MAX_FRACTION;
+    float gain = 1.0f / ((1.0f - fraction) * (1.0f - fraction));
+    r.sigma = sqrtf((float)counts) * perSecond * gain * scale;
+
+    float low, high;
+    poissonBounds(counts, z, &low, &high);
+    r.lower = correctDeadTimeCps(low * perSecond, deadTimeSec) * scale;
+    r.upper = correctDeadTimeCps(high * perSecond, deadTimeSec) * scale;
+    return r;
+}
+
+/**
+ * @brief A rate measurement that runs until its interval is narrow enough.
+ *
+ * Counts and seconds are differences of the pipeline's monotonic totals, so an
+ * update is O(1) however long the run. The run ends when the half-width of
+ * the 95 % interval falls to the target fraction of the rate, or at the time
+ * limit. The interval narrows only with the counts (about 1.96 / sqrt(N)), so
+ * a lucky stretch cannot end a run early.
+ */
+class PrecisionMeasurement {
+public:
+    enum State {
+        IDLE = 0,
+        RUNNING,
+        REACHED,  ///< Stopped at the target precision
+        TIMED_OUT,
+        STOPPED   ///< Stopped by the operator
+    };
+
+    PrecisionMeasurement()
+        : state_(IDLE), target_(0.0f), maxSeconds_(0), startCounts_(0), startSeconds_(0), counts_(0),
+          seconds_(0) {}
+
+    /**
+     * @param targetRelative Half-width of the 95 % interval as a fraction of the rate
+     * @param maxSeconds     Time limit; 0 for none
+     */
+    void start(uint32_t totalCounts, uint32_t secondsClosed, float targetRelative, uint32_t maxSeconds) {
+        state_ = RUNNING;
+        target_ = targetRelative;
+        maxSeconds_ = maxSeconds;
+        startCounts_ = totalCounts;
+        startSeconds_ = secondsClosed;
+        counts_ = 0;
+        seconds_ = 0;
+    }
+
+    void stop() {
+        if (state_ == RUNNING) state_ = STOPPED;
+    }
+
+    /**
+     * @brief Follows the totals while running.
+     * @return true on the update that ended the run
+     */
+    bool update(uint32_t totalCounts, uint32_t secondsClosed) {
+        if (state_ != RUNNING) return false;
+        counts_ = totalCounts - startCounts_;
+        seconds_ = secondsClosed - startSeconds_;
+        if (seconds_ == 0) return false;
+        if (interval(0.0f, 1.0f).relative() <= target_) {
+            state_ = REACHED;
+            return true;
+        }
+        if (maxSeconds_ && seconds_ >= maxSeconds_) {
+            state_ = TIMED_OUT;
+            return true;
+        }
+        return false;
+    }
+
+    /// The run's rate and 95 % interval (see rateUncertainty()).
+    RateUncertainty interval(float deadTimeSec, float scale) const {
+        return rateUncertainty(counts_, (float)seconds_, CONFIDENCE_Z_95, deadTimeSec, scale);
+    }
+
+    State state() const { return state_; }
+    float target() const { return target_; }
+    uint32_t maxSeconds() const { return maxSeconds_; }
+    uint32_t counts() const { return counts_; }
+    uint32_t seconds() const { return seconds_; }
+
+    /// Counts the target needs, from relative ~= z / sqrt(N).
+    uint32_t countsNeeded() const {
+        if (target_ <= 0.0f) return 0;
+        float n = CONFIDENCE_Z_95 / target_;
+        return (uint32_t)(n * n);
+    }
+
+private:
+    State state_;
+    float target_;
+    uint32_t maxSeconds_;
+    uint32_t startCounts_;
+    uint32_t startSeconds_;
+    uint32_t counts_;
+    uint32_t seconds_;
+};
+
+#endif // COUNT_STATISTICS_H
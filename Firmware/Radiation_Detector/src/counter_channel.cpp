@@ -0,0 +1,85 @@
+/**
+ * @file counter_channel.cpp
+ * @brief PCNT unit setup and the 32-bit extension of its 16-bit count.
+ */
+
+#include "counter_channel.h"
+#include "debug.h"
+#include "driver/pcnt.h"
+
+void IRAM_ATTR CounterChannel::limitIsr(void* arg) {
+    CounterChannel* channel = (CounterChannel*)arg;
+    channel->epoch_ = channel->epoch_ + 1;
+    CounterLimitHook hook = channel->hook_;
+    if (hook) hook();
+}
+
+bool CounterChannel::begin(uint8_t unit, uint8_t pin, int16_t highLimit, uint16_t filterCycles,
+                           CounterLimitHook hook) {
+    unit_ = unit;
+    pin_ = pin;
+    highLimit_ = highLimit;
+    hook_ = hook;
+    pcnt_unit_t pcntUnit = (pcnt_unit_t)unit;
+
+    pcnt_config_t config = {};
+    config.pulse_gpio_num = pin;
+    config.ctrl_gpio_num  = PCNT_PIN_NOT_USED;
+    config.channel        = PCNT_CHANNEL_0;
+    config.unit           = pcntUnit;
+    config.pos_mode       = PCNT_COUNT_INC;
+    config.neg_mode       = PCNT_COUNT_DIS;
+    config.lctrl_mode     = PCNT_MODE_KEEP;
+    config.hctrl_mode     = PCNT_MODE_KEEP;
+    config.counter_h_lim  = highLimit;
+    config.counter_l_lim  = 0;
+    if (pcnt_unit_config(&config) != ESP_OK) {
+        DEBUG_PRINTF("PCNT unit %d config failed\n", unit);
+        return false;
+    }
+
+    pcnt_set_filter_value(pcntUnit, filterCycles);
+    pcnt_filter_enable(pcntUnit);
+
+    pcnt_counter_pause(pcntUnit);
+    pcnt_counter_clear(pcntUnit);
+
+    // Count every high-limit wrap so read32() is monotonic
+    epoch_ = 0;
+    lastReturned_ = 0;
+    pcnt_event_enable(pcntUnit, PCNT_EVT_H_LIM);
+    esp_err_t err = pcnt_isr_service_install(ESP_INTR_FLAG_IRAM);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+        DEBUG_PRINTF("PCNT ISR service install failed (%d)\n", err);
+    }
+    pcnt_isr_handler_add(pcntUnit, limitIsr, this);
+
+    pcnt_counter_resume(pcntUnit);
+    active_ = true;
+    DEBUG_PRINTF("PCNT unit %d counting on GPIO %d\n", unit, pin);
+    return true;
+}
+
+/**
+ * Combines the 16-bit hardware counter with the epoch. The epoch is read before
+ * and after the counter so a wrap during the read is detected. A wrap whose ISR
+ * has not run yet (counter already back near 0, epoch not yet incremented) is
+ * caught by the monotonic guard.
+ */
+uint32_t CounterChannel::read32() {
+    uint32_t epoch;
+    int16_t count16 = 0;
+
+    do {
+        epoch = epoch_;
+        pcnt_get_counter_value((pcnt_unit_t)unit_, &count16);
+    } while (epoch != epoch_);
+
+    uint32_t total = epoch * (uint32_t)highLimit_ + (uint32_t)count16;
+    if ((int32_t)(total - lastReturned_) < 0) {
+        // Hardware wrapped but the limit ISR is still pending
+        total += highLimit_;
+    }
+    lastReturned_ = total;
+    return total;
+}
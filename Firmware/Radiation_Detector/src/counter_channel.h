@@ -0,0 +1,49 @@
+#ifndef COUNTER_CHANNEL_H
+#define COUNTER_CHANNEL_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// One GM tube on one PCNT unit.
+// The hardware counter is 16 bits and wraps to 0 at its high limit; the limit
+// event ISR counts the wraps (the epoch), and read32() combines both into a
+// monotonic 32-bit count. The ESP32-S3 has four units, so up to four tubes can
+// be counted side by side (COUNTER_CHANNELS); how their counts are combined is
+// counter_range.h's business. A channel may hand its limit event to a hook,
+// which the primary channel uses to wake the sampling task (PULSE_EVENT_WAKE).
+
+// Called from the limit ISR after the epoch is updated. Must be IRAM_ATTR.
+typedef void (*CounterLimitHook)();
+
+class CounterChannel {
+public:
+    CounterChannel() : unit_(0), pin_(0), highLimit_(0), active_(false), epoch_(0), lastReturned_(0),
+                       hook_(nullptr) {}
+
+    /**
+     * @brief Configures PCNT unit @p unit to count rising edges on @p pin and
+     *        installs the limit ISR on the calling task's core.
+     * @param filterCycles Glitch filter in APB cycles (0..1023)
+     */
+    bool begin(uint8_t unit, uint8_t pin, int16_t highLimit, uint16_t filterCycles, CounterLimitHook hook);
+
+    /// Pulses since begin(). Any one task; a wrap whose ISR is pending is caught.
+    uint32_t read32();
+
+    bool active() const { return active_; }
+    uint8_t unit() const { return unit_; }
+    uint8_t pin() const { return pin_; }
+
+private:
+    static void limitIsr(void* arg);
+
+    uint8_t unit_;
+    uint8_t pin_;
+    int16_t highLimit_;
+    bool active_;
+    volatile uint32_t epoch_;   ///< High-limit wraps since begin()
+    uint32_t lastReturned_;
+    CounterLimitHook hook_;
+};
+
+#endif // COUNTER_CHANNEL_H
@@ -0,0 +1,131 @@
+#ifndef COUNTER_RANGE_H
+#define COUNTER_RANGE_H
+
+#include <stdint.h>
+#include "dead_time.h"
+
+// Automatic range switching between a sensitive primary tube and a small
+// high-range tube.
+// The rate pipeline (measurement.h) takes one monotonic count and corrects it
+// with the primary tube's dead time and conversion factor. While the primary
+// tube is near saturation, CounterRange feeds it the high-range tube's counts
+// expressed as the counts the primary tube would have registered in the same
+// field: the high-range count is dead-time corrected with its own tau, scaled
+// by the ratio of the conversion factors, and put through the primary tube's
+// dead-time model the other way (n = m / (1 + m * tau)). The pipeline's own
+// correction then undoes that last step, so the dose rate, dose and alarms
+// follow the field across a switch without a jump and without knowing there
+// are two tubes. The output count has no seams either: it keeps counting from
+// where the other source left off.
+//
+// The scale is taken from the previous second's rates, so each count is
+// converted linearly; a non-linear conversion of a few counts per poll would
+// be biased. The pipeline clamps its correction at DEAD_TIME_MAX_FRACTION,
+// which bounds the range this extends to about 1 / (tau * (1 - 0.95)).
+//
+// Switch up when the primary tube was busy for COUNTER_RANGE_UP of the last
+// second (m * tau), down when it was below COUNTER_RANGE_DOWN and the
+// high-range tube agrees: a GM tube in a very strong field can fold back to a
+// low count. No Arduino dependencies (host-compilable).
+
+class CounterRange {
+public:
+    CounterRange(float upFraction, float downFraction)
+        : up_(upFraction), down_(downFraction), primaryTau_(0.0f), highTau_(0.0f), highPerPrimary_(1.0f),
+          scale_(0.0f), residual_(0.0f), high_(false), switches_(0), last_{0, 0}, out_(0), second_{0, 0},
+          lastSecond_{0, 0} {}
+
+    /**
+     * @brief Tube parameters; may change at any time (run-time overrides).
+     * @param highPerPrimary High-range tube's uSv/h per CPM over the primary's
+     */
+    void configure(float primaryDeadTimeSec, float highDeadTimeSec, float highPerPrimary) {
+        primaryTau_ = primaryDeadTimeSec;
+        highTau_ = highDeadTimeSec;
+        highPerPrimary_ = highPerPrimary;
+    }
+
+    /// Takes the current counts as the reference; the output starts at @p primary.
+    void begin(uint32_t primary, uint32_t high) {
+        last_[0] = primary;
+        last_[1] = high;
+        out_ = primary;
+    }
+
+    /**
+     * @brief One reading of both tubes.
+     * @return The merged count, monotonic, in primary-tube counts
+     */
+    uint32_t merge(uint32_t primary, uint32_t high) {
+        uint32_t d0 = primary - last_[0]; // Unsigned: correct across wraps
+        uint32_t d1 = high - last_[1];
+        last_[0] = primary;
+        last_[1] = high;
+        second_[0] += d0;
+        second_[1] += d1;
+        if (!high_) {
+            out_ += d0;
+        } else {
+            residual_ += d1 * scale_;
+            uint32_t whole = (uint32_t)residual_;
+            residual_ -= whole;
+            out_ += whole;
+        }
+        return out_;
+    }
+
+    /**
+     * @brief Closes the second the pipeline just closed: updates the scale and
+     *        decides the range for the next one.
+     * @return true if the range changed
+     */
+    bool closeSecond() {
+        lastSecond_[0] = second_[0];
+        lastSecond_[1] = second_[1];
+        second_[0] = 0;
+        second_[1] = 0;
+
+        // Primary-tube equivalent of the high-range tube's rate
+        float highTrue = correctDeadTimeCps((float)lastSecond_[1], highTau_);
+        float equivalent = highTrue * highPerPrimary_;
+        float primaryBusy = lastSecond_[0] * primaryTau_;
+        float equivalentBusy = equivalent * primaryTau_;
+
+        // Primary counts per high-range count at this rate
+        scale_ = lastSecond_[1] ? (equivalent / (1.0f + equivalentBusy)) / lastSecond_[1] : highPerPrimary_;
+
+        bool wasHigh = high_;
+        if (!high_ && primaryBusy >= up_) {
+            high_ = true;
+        } else if (high_ && primaryBusy < down_ && equivalentBusy < down_ / (1.0f - down_)) {
+            high_ = false;
+        }
+        if (high_ != wasHigh) {
+            switches_++;
+            residual_ = 0.0f;
+        }
+        return high_ != wasHigh;
+    }
+
+    bool highRange() const { return high_; }
+    uint32_t switches() const { return switches_; }
+    /// Raw counts of tube @p channel (0: primary) in the last closed second.
+    uint32_t lastSecondCounts(uint8_t channel) const { return lastSecond_[channel ? 1 : 0]; }
+
+private:
+    float up_;
+    float down_;
+    float primaryTau_;
+    float highTau_;
+    float highPerPrimary_;
+    float scale_;
+    float residual_;
+    bool high_;
+    uint32_t switches_;
+    uint32_t last_[2];
+    uint32_t out_;
+    uint32_t second_[2];
+    uint32_t lastSecond_[2];
+};
+
+#endif // COUNTER_RANGE_H
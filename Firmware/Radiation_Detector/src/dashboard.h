@@ -2,16 +2,30 @@
 #define DASHBOARD_H
 
 #include <Arduino.h>
+#include <WebServer.h>
 #include "radiation_data.h" // Include our new header for radiation data exports
 
-// Returns the complete HTML page for the dashboard.
-String getDashboardPage();
+// Sends the gzip-compressed dashboard page (304 if the client's ETag matches).
+void sendDashboardPage(WebServer& server);
 
-// Chart size constants
-#define CHART1_SIZE 20
-#define CHART3_SIZE 24
+// Sends the gzip-compressed chart script (web/charts.js) with immutable caching.
+void sendDashboardCharts(WebServer& server);
 
-// These are declared in Radiation-Detector.cpp
-// Not using extern here to avoid conflicts with static declarations
+// Sends the service worker (web/sw.js) that keeps the page available offline.
+// Served from "/sw.js" so its scope is the whole site.
+void sendDashboardWorker(WebServer& server);
+
+// Sends the web app manifest (web/manifest.webmanifest).
+void sendDashboardManifest(WebServer& server);
+
+// URL of the chart script; it changes with the script's content.
+const char* dashboardChartsPath();
+
+// Reads the compressed page from flash once, as send_P() streams it, and returns
+// its length (benchmark of the page path; the page is not built per request).
+size_t readDashboardPage();
+
+// Registers the request headers the web handlers read. Call before server.begin().
+void collectRequestHeaders(WebServer& server);
 
 #endif
@@ -0,0 +1,528 @@
+#ifndef DASHBOARD_PAGE_H
+#define DASHBOARD_PAGE_H
+
+// Generated by tools/embed_dashboard.py from src/web/dashboard.html,
+// src/web/charts.js, src/web/sw.js and src/web/manifest.webmanifest - do not edit.
+// 18307 bytes of HTML, 5802 bytes gzip-compressed; chart script 3366 -> 1306 bytes;
+// service worker 1148 -> 493 bytes.
+
+#include <Arduino.h>
+
+#define DASHBOARD_PAGE_ETAG "\"601d5d30\""
+static const size_t DASHBOARD_PAGE_GZ_LEN = 5802;
+static const uint8_t DASHBOARD_PAGE_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xc5, 0x3c, 0xed, 0x72, 0xdb, 0x38,
+    0x92, 0xff, 0xf3, 0x14, 0x48, 0x76, 0x37, 0xa4, 0x26, 0x12, 0x2d, 0xc9, 0x76, 0x26, 0x23, 0x59,
+    0x9e, 0x4a, 0x62, 0x67, 0x26, 0xb7, 0xf9, 0x70, 0xc5, 0xce, 0xce, 0x4e, 0xe5, 0x52, 0x59, 0x88,
+    0x84, 0x24, 0x8e, 0x29, 0x42, 0x4b, 0x52, 0x96, 0x7d, 0x5e, 0x3f, 0xc3, 0xfe, 0xdd, 0xbf, 0x77,
+    0x6f, 0x70, 0x3f, 0xae, 0xea, 0x7e, 0xdf, 0xbe, 0xc9, 0xbd, 0xc0, 0xbd, 0xc2, 0x75, 0x37, 0x00,
+    0x12, 0x20, 0x29, 0xc7, 0x9e, 0xda, 0xba, 0xcb, 0xd4, 0xd8, 0x22, 0xd1, 0x68, 0x74, 0x37, 0xfa,
+    0x1b, 0x90, 0x0f, 0x1e, 0x1e, 0xbd, 0x7f, 0x79, 0xf6, 0xf3, 0xc9, 0x31, 0x5b, 0x14, 0xcb, 0xe4,
+    0xf0, 0x00, 0x7f, 0xb2, 0x84, 0xa7, 0xf3, 0x89, 0x27, 0x52, 0x0f, 0x9e, 0x05, 0x8f, 0x0e, 0x1f,
+    0x1c, 0x2c, 0x45, 0xc1, 0x59, 0xb8, 0xe0, 0x59, 0x2e, 0x8a, 0x89, 0xf7, 0xf1, 0xec, 0x55, 0xef,
+    0x99, 0x67, 0x5e, 0xa7, 0x7c, 0x29, 0x26, 0xde, 0x45, 0x2c, 0x36, 0x2b, 0x99, 0x15, 0x1e, 0x0b,
+    0x65, 0x5a, 0x88, 0x14, 0xc0, 0x36, 0x71, 0x54, 0x2c, 0x26, 0x91, 0xb8, 0x88, 0x43, 0xd1, 0xa3,
+    0x87, 0x2e, 0x8b, 0xd3, 0xb8, 0x88, 0x79, 0xd2, 0xcb, 0x43, 0x9e, 0x88, 0xc9, 0x20, 0xe8, 0x23,
+    0x9a, 0x22, 0x2e, 0x12, 0x71, 0xf8, 0x81, 0x47, 0x31, 0x2f, 0x62, 0x99, 0xb2, 0x23, 0x51, 0x88,
+    0xb0, 0x90, 0x19, 0x3b, 0xe2, 0xf9, 0x62, 0x2a, 0x79, 0x16, 0xb1, 0xff, 0xfe, 0xdb, 0xbf, 0xfd,
+    0xcf, 0x7f, 0xfe, 0xf5, 0x60, 0x47, 0x81, 0x3a, 0x2b, 0x17, 0x0b, 0xb1, 0x14, 0xbd, 0x50, 0x26,
+    0x32, 0xb3, 0x16, 0xff, 0xcd, 0xf0, 0xe9, 0x90, 0xef, 0x3e, 0x45, 0xf4, 0x49, 0x9c, 0x9e, 0xb3,
+    0x4c, 0x24, 0x13, 0x6f, 0xc9, 0xd3, 0x78, 0x26, 0x72, 0x20, 0x72, 0x91, 0x89, 0xd9, 0xc4, 0xdb,
+    0x31, 0x2f, 0x82, 0x8d, 0x98, 0x96, 0x83, 0x30, 0x25, 0x0f, 0xb3, 0x78, 0x55, 0xb0, 0x3c, 0x0b,
+    0x01, 0x08, 0xf9, 0x2e, 0xf2, 0x60, 0x57, 0x84, 0xb3, 0x6f, 0x77, 0x67, 0x61, 0xf0, 0x4b, 0x0e,
+    0x82, 0xd9, 0x51, 0x20, 0x08, 0x5b, 0x5c, 0x21, 0x49, 0x53, 0x19, 0x5d, 0xb1, 0x6b, 0x36, 0x03,
+    0x02, 0x7a, 0x33, 0xbe, 0x8c, 0x93, 0xab, 0x11, 0xf3, 0x4e, 0xc5, 0x5c, 0x0a, 0xf6, 0xf1, 0xb5,
+    0xd7, 0x65, 0x67, 0x7c, 0x21, 0x97, 0xbc, 0xcb, 0x7e, 0x10, 0xa9, 0xb8, 0x80, 0xdf, 0x7f, 0x10,
+    0x59, 0xc4, 0x53, 0xf8, 0x90, 0xf3, 0x34, 0xef, 0xe5, 0x22, 0x8b, 0x67, 0x63, 0x36, 0xe5, 0xe1,
+    0xf9, 0x3c, 0x93, 0xeb, 0x34, 0x52, 0x0c, 0x8d, 0xd8, 0x6f, 0xfa, 0xb3, 0xc1, 0xee, 0xe0, 0xdb,
+    0x31, 0x5b, 0xf2, 0x6c, 0x1e, 0xa7, 0x23, 0xd6, 0x1f, 0xb3, 0x15, 0x8f, 0xa2, 0x38, 0x9d, 0xd3,
+    0x67, 0x03, 0x36, 0x9b, 0xc1, 0xf4, 0x9b, 0x07, 0xb8, 0x5f, 0x22, 0x03, 0x3a, 0x5a, 0x30, 0x29,
+    0x89, 0x54, 0x53, 0x8e, 0x9e, 0xbd, 0x1c, 0x0c, 0x5f, 0x5a, 0xe8, 0x86, 0xfd, 0xd5, 0x25, 0x1b,
+    0xc0, 0x8f, 0x31, 0x2b, 0xc4, 0x65, 0xd1, 0xe3, 0x49, 0x3c, 0x87, 0x15, 0x43, 0x10, 0xa8, 0xc8,
+    0x0c, 0x05, 0xbd, 0xa9, 0x2c, 0x0a, 0xb9, 0x54, 0xd0, 0xb4, 0xe4, 0x00, 0x96, 0xb3, 0xa8, 0x23,
+    0x09, 0xe4, 0xf1, 0xbf, 0x08, 0x00, 0x11, 0x4b, 0x84, 0x08, 0x70, 0x57, 0x78, 0x9c, 0x12, 0x61,
+    0x51, 0x9c, 0xaf, 0x12, 0x0e, 0xc2, 0x99, 0x25, 0x02, 0xe6, 0xe3, 0xcf, 0x5e, 0x14, 0x67, 0xb0,
+    0xe1, 0xb0, 0xf5, 0x23, 0x24, 0x6e, 0xbd, 0x4c, 0xc7, 0x8c, 0xd6, 0xee, 0xc5, 0x85, 0x58, 0xe6,
+    0x15, 0x05, 0x0e, 0xa5, 0x0a, 0x33, 0x28, 0x47, 0x6e, 0x63, 0x9d, 0x67, 0x71, 0x34, 0xa6, 0x9f,
+    0x3d, 0x98, 0x0b, 0xef, 0x0a, 0xd2, 0x0d, 0xc0, 0x09, 0x78, 0x32, 0xb1, 0x12, 0xbc, 0xf0, 0xf9,
+    0xba, 0x90, 0xbd, 0x59, 0x5c, 0x74, 0xd9, 0x32, 0x4e, 0x97, 0xfc, 0xd2, 0x1f, 0xf6, 0x01, 0x5f,
+    0x97, 0x0d, 0x66, 0x59, 0xa7, 0x03, 0x93, 0xf9, 0x6a, 0xc4, 0x76, 0x69, 0x05, 0xd2, 0xda, 0x11,
+    0xc8, 0xa4, 0xff, 0x3b, 0xe4, 0xff, 0xb2, 0x57, 0xbd, 0xa0, 0x71, 0xc3, 0x36, 0x49, 0xae, 0xcf,
+    0xf6, 0xe8, 0x57, 0x49, 0xd8, 0xed, 0xdb, 0x30, 0x95, 0x19, 0x6c, 0x55, 0x2f, 0x03, 0xb5, 0x5f,
+    0xe7, 0x23, 0x2d, 0xf7, 0xa9, 0xbc, 0xec, 0xe5, 0x0b, 0x1e, 0xc9, 0xcd, 0x08, 0xf1, 0x01, 0xba,
+    0x67, 0xf0, 0x7f, 0x36, 0x9f, 0x72, 0xbf, 0xdf, 0xa5, 0xff, 0x82, 0xdd, 0x4e, 0x43, 0x10, 0x6d,
+    0xbb, 0x55, 0x64, 0xa0, 0x57, 0xb1, 0x12, 0x2a, 0x7d, 0x9e, 0xc9, 0x6c, 0xc9, 0x60, 0x7a, 0x5e,
+    0xd2, 0x37, 0x5a, 0xc8, 0x0b, 0xda, 0x93, 0x72, 0x5c, 0x83, 0xa2, 0xd4, 0x7e, 0xf6, 0x7b, 0xfb,
+    0xab, 0xcb, 0x4e, 0xc5, 0xcc, 0x62, 0x68, 0xef, 0x33, 0xfc, 0x37, 0xd0, 0xdc, 0x5a, 0x1b, 0x3e,
+    0x08, 0xf6, 0x71, 0xcb, 0x6b, 0x4a, 0xa9, 0xe6, 0xaf, 0x6e, 0x57, 0x93, 0xba, 0x56, 0xe2, 0x34,
+    0x34, 0xbc, 0x9e, 0xad, 0x3c, 0xf7, 0xdb, 0x8f, 0xf1, 0xff, 0x91, 0xf8, 0x4b, 0x52, 0x33, 0xb9,
+    0xd9, 0xa2, 0xe1, 0x9b, 0x0c, 0x95, 0x0a, 0x7f, 0xde, 0x4b, 0xbf, 0x2a, 0x21, 0x28, 0x75, 0x42,
+    0x5c, 0x30, 0x3a, 0x46, 0xc5, 0x35, 0xb0, 0xbb, 0x0a, 0xf4, 0xff, 0x81, 0xd5, 0x27, 0xcc, 0xe1,
+    0x5b, 0xfb, 0x87, 0x42, 0x02, 0x7b, 0x7b, 0x06, 0x7a, 0xba, 0x06, 0x6f, 0x91, 0xe6, 0xb5, 0xe1,
+    0xdd, 0x72, 0xb8, 0x48, 0x6d, 0x89, 0xc5, 0x29, 0x38, 0x6b, 0xd1, 0x9b, 0x26, 0x32, 0x3c, 0xb7,
+    0xd6, 0x1e, 0x80, 0x26, 0xb2, 0xe1, 0x3e, 0xce, 0xb1, 0x95, 0xcd, 0x56, 0x1b, 0xe3, 0x26, 0x5b,
+    0xc4, 0x60, 0x34, 0x8a, 0xac, 0x24, 0x12, 0xa1, 0xcc, 0xb8, 0x32, 0x8b, 0x54, 0xa6, 0xa2, 0x21,
+    0x1d, 0x5a, 0xc5, 0x36, 0x9e, 0x3a, 0x46, 0x6d, 0x43, 0x95, 0x25, 0x0c, 0x2c, 0x66, 0x4a, 0x93,
+    0x6a, 0xa1, 0xe3, 0xdb, 0xe1, 0xb7, 0x7b, 0x42, 0x34, 0xad, 0x63, 0xce, 0xd7, 0x73, 0xe1, 0xa8,
+    0xf9, 0x4a, 0x9a, 0xc5, 0x21, 0x6c, 0x01, 0xb1, 0x17, 0xa2, 0x54, 0x95, 0xa1, 0xab, 0xe8, 0x7d,
+    0x86, 0xce, 0x0c, 0xd1, 0xcc, 0xa4, 0x2c, 0x68, 0x72, 0x73, 0x1b, 0x2c, 0x99, 0xf5, 0x83, 0xef,
+    0xb6, 0x18, 0x5b, 0x66, 0xc2, 0x6f, 0x2f, 0x11, 0x17, 0x22, 0x41, 0xaf, 0xb0, 0x3d, 0x06, 0x10,
+    0xf2, 0x41, 0x85, 0x7c, 0x23, 0xe2, 0xf9, 0xa2, 0x00, 0x59, 0xc9, 0x24, 0xaa, 0x61, 0xcb, 0xf9,
+    0x4c, 0x00, 0xb2, 0xba, 0x10, 0x1c, 0x98, 0xa5, 0x84, 0x1d, 0x00, 0x9f, 0x63, 0xc1, 0xb5, 0x52,
+    0xb6, 0x80, 0x55, 0x2c, 0x98, 0x57, 0xaf, 0xf6, 0xbf, 0x1d, 0x0e, 0x6b, 0x30, 0x40, 0x74, 0x06,
+    0x09, 0x81, 0x0d, 0xb6, 0xb7, 0xb7, 0x8b, 0x66, 0x00, 0x60, 0x79, 0xc1, 0x8b, 0x75, 0xde, 0x8b,
+    0xd3, 0x28, 0x0e, 0x39, 0x66, 0x18, 0xb6, 0xac, 0x67, 0xf1, 0xa5, 0x00, 0xea, 0x2d, 0xde, 0x32,
+    0xc5, 0x95, 0x7a, 0x28, 0xb5, 0x71, 0xbf, 0x8c, 0x92, 0x75, 0xc3, 0x6a, 0x68, 0xe8, 0x50, 0x6b,
+    0x86, 0x5e, 0x57, 0x92, 0x7a, 0xdf, 0x4d, 0x3b, 0x8c, 0x42, 0x57, 0xb3, 0xd7, 0xab, 0x08, 0x58,
+    0x4c, 0xe7, 0xed, 0xf3, 0x8d, 0xc0, 0xb6, 0xcf, 0x97, 0xb3, 0xd9, 0xf6, 0xe5, 0x8d, 0x90, 0xf4,
+    0xf3, 0x66, 0x01, 0xa1, 0x97, 0x26, 0x27, 0x3c, 0x2f, 0xd4, 0xd2, 0x22, 0xba, 0x9f, 0x52, 0xd8,
+    0x32, 0x68, 0x6e, 0x2b, 0x64, 0x50, 0x2a, 0x71, 0x3a, 0xd8, 0xa1, 0x24, 0xf3, 0x00, 0x13, 0x28,
+    0x78, 0x52, 0x19, 0x0c, 0x64, 0x9e, 0x83, 0xbb, 0x65, 0x84, 0x00, 0xa7, 0x30, 0xc0, 0xa4, 0x07,
+    0x07, 0x51, 0x7c, 0xc1, 0xe2, 0x68, 0xe2, 0xd5, 0x37, 0x1a, 0x32, 0x43, 0x60, 0x24, 0x6f, 0x0e,
+    0x30, 0x67, 0x6b, 0xbc, 0xc3, 0xf7, 0xf4, 0xfb, 0x60, 0x07, 0x10, 0x69, 0x74, 0x7a, 0x62, 0x69,
+    0x9f, 0x9e, 0xb5, 0x8c, 0x2d, 0x9c, 0x72, 0x09, 0xe7, 0xe5, 0xe1, 0x1b, 0x78, 0x62, 0xfa, 0x69,
+    0xc4, 0xde, 0x81, 0x6d, 0x65, 0x6d, 0xd8, 0x31, 0x8f, 0xf1, 0x9a, 0xef, 0xf0, 0xd5, 0x62, 0x78,
+    0xf8, 0x72, 0x9d, 0x65, 0x20, 0x6c, 0x60, 0x74, 0x08, 0x2f, 0x56, 0xb4, 0x76, 0xa8, 0xde, 0xf5,
+    0x4a, 0xd5, 0xf7, 0x0e, 0x7b, 0x3d, 0xb6, 0x3e, 0xbd, 0xd8, 0x59, 0x1c, 0xec, 0xac, 0x50, 0xae,
+    0xad, 0xab, 0x68, 0x8c, 0xcf, 0x81, 0x0e, 0x3e, 0x17, 0x0e, 0x46, 0xae, 0xde, 0xfd, 0x4a, 0x8c,
+    0x6f, 0xf9, 0x65, 0xbc, 0x5c, 0x2f, 0x1d, 0x8c, 0x4b, 0xf5, 0xee, 0x57, 0x62, 0x7c, 0xb9, 0x5e,
+    0xae, 0x95, 0xfb, 0x63, 0x47, 0x32, 0x17, 0x35, 0xee, 0xcd, 0x58, 0x2f, 0x82, 0x31, 0xc2, 0xbb,
+    0x3c, 0xbd, 0x70, 0xb0, 0xb6, 0x20, 0x37, 0xe1, 0xca, 0x6b, 0x7b, 0x6f, 0x2d, 0x5d, 0xa9, 0xde,
+    0x1b, 0xf4, 0x86, 0x7a, 0x69, 0x6b, 0x46, 0xcd, 0x69, 0x43, 0x45, 0x10, 0xf2, 0xf4, 0x82, 0xe7,
+    0x44, 0x9c, 0x1e, 0x44, 0xa4, 0x58, 0x2a, 0xa8, 0x91, 0x43, 0x9b, 0x1e, 0x84, 0xaa, 0x79, 0xdc,
+    0x52, 0x7f, 0xea, 0x9e, 0xd8, 0xf5, 0xa5, 0xde, 0xe1, 0x29, 0x7a, 0x54, 0x4d, 0xd6, 0xed, 0x8c,
+    0x5a, 0x0c, 0xfd, 0x28, 0xd7, 0x59, 0x72, 0xc5, 0x2a, 0xbe, 0xfc, 0xdd, 0x1e, 0x24, 0x11, 0x10,
+    0x71, 0xc1, 0x84, 0x2f, 0x78, 0x92, 0x77, 0x34, 0x8f, 0x16, 0x1b, 0x0b, 0x9a, 0xd3, 0xe0, 0xe3,
+    0x1f, 0x21, 0xdf, 0x23, 0x1e, 0xbb, 0xd4, 0x0c, 0x7a, 0xb8, 0xda, 0xad, 0xe4, 0x44, 0x38, 0xe7,
+    0x4e, 0xd4, 0x90, 0x67, 0x81, 0x09, 0x3a, 0xad, 0xa0, 0x38, 0xef, 0x29, 0xb5, 0x21, 0x42, 0xc0,
+    0x18, 0x39, 0x10, 0x72, 0xfd, 0x48, 0xdb, 0xd0, 0xa3, 0x51, 0xbf, 0xfb, 0x48, 0x71, 0xfb, 0x68,
+    0xf4, 0xe9, 0x73, 0xf7, 0x11, 0x2d, 0x85, 0x1f, 0x6f, 0xda, 0xb8, 0xd4, 0x39, 0x0d, 0xb2, 0xc2,
+    0xcb, 0x77, 0x45, 0x6a, 0xaa, 0xca, 0x5f, 0x38, 0xd0, 0x45, 0xd5, 0xe1, 0xe8, 0x42, 0xc6, 0x91,
+    0xdf, 0xef, 0x78, 0x4c, 0xa6, 0x61, 0x12, 0x87, 0xe7, 0xb0, 0xb9, 0x62, 0x96, 0x89, 0x7c, 0x71,
+    0x04, 0x14, 0xf8, 0x1d, 0xef, 0xf0, 0x83, 0x7a, 0x64, 0xf8, 0x7c, 0xb0, 0xc3, 0xb7, 0x60, 0xdc,
+    0xd9, 0xf0, 0x2c, 0x05, 0xcf, 0x0f, 0xee, 0xe9, 0xec, 0x39, 0xfb, 0x48, 0xce, 0x44, 0x41, 0x6b,
+    0xe2, 0x54, 0xf0, 0x3f, 0x7c, 0x1c, 0xca, 0xd5, 0xd5, 0x18, 0x72, 0x84, 0xe1, 0x3e, 0x3b, 0xe1,
+    0x90, 0x45, 0xb1, 0xb7, 0x32, 0xfb, 0xfb, 0xbf, 0xa6, 0xec, 0x44, 0xfc, 0xfd, 0xdf, 0x79, 0xc0,
+    0x9e, 0x27, 0x89, 0x8a, 0x69, 0x39, 0x24, 0x16, 0x50, 0x72, 0x5e, 0x88, 0x28, 0x38, 0xd8, 0xd1,
+    0x93, 0x4b, 0x64, 0xa6, 0xb2, 0x4d, 0x44, 0xc1, 0x94, 0x50, 0x5e, 0xa2, 0xd4, 0xba, 0x8c, 0xa4,
+    0xa2, 0x3f, 0x93, 0x8a, 0xd3, 0xe7, 0xf1, 0x83, 0xd9, 0x3a, 0xa5, 0xea, 0x8d, 0xaa, 0x7b, 0x7a,
+    0x97, 0xfb, 0x1d, 0x76, 0xfd, 0x80, 0x61, 0x39, 0x0e, 0xde, 0x8f, 0x84, 0x8e, 0x1c, 0x1e, 0x27,
+    0x10, 0x99, 0xd3, 0x82, 0x4d, 0x58, 0x24, 0xc1, 0x80, 0xe1, 0x63, 0x30, 0x17, 0x85, 0x7e, 0xfb,
+    0xe2, 0xea, 0x75, 0xe4, 0xdb, 0x1b, 0xd4, 0x19, 0x37, 0x31, 0xc0, 0xd4, 0x7f, 0x3a, 0x7d, 0xff,
+    0x2e, 0x58, 0x61, 0x2b, 0xc2, 0xaf, 0x23, 0x0e, 0x30, 0x3a, 0xbd, 0x54, 0x2d, 0x00, 0x6b, 0xb6,
+    0x62, 0xe2, 0x0d, 0x9f, 0x8a, 0x24, 0x07, 0x04, 0x9f, 0x3e, 0xe3, 0x10, 0x94, 0x3b, 0xcc, 0x47,
+    0x16, 0x63, 0x78, 0x05, 0xa5, 0x42, 0xcc, 0x0e, 0x40, 0x70, 0xf0, 0xfb, 0xc9, 0x13, 0x45, 0xbb,
+    0x99, 0x0d, 0x56, 0x82, 0xb3, 0xfc, 0x98, 0x7d, 0xc3, 0x76, 0x3b, 0xec, 0x77, 0xec, 0x69, 0x7f,
+    0x6c, 0x0d, 0x23, 0x72, 0x1c, 0x7f, 0xcb, 0x8b, 0x45, 0x30, 0x4b, 0xa4, 0xcc, 0x7c, 0x03, 0xba,
+    0x03, 0xa0, 0x1d, 0x05, 0x6b, 0x93, 0x10, 0xac, 0xd6, 0xf9, 0xc2, 0xff, 0xd3, 0x6f, 0xaf, 0x69,
+    0xea, 0xcd, 0x62, 0xf4, 0xdb, 0x6b, 0x5c, 0x23, 0x28, 0xe4, 0x69, 0x91, 0xc1, 0x2e, 0xfb, 0x1d,
+    0x60, 0x2f, 0x3a, 0x2d, 0x80, 0x37, 0x7f, 0xd8, 0x65, 0x5e, 0xdf, 0xeb, 0xdc, 0x2c, 0xff, 0x44,
+    0x88, 0x6e, 0x4a, 0x9e, 0x68, 0x2f, 0xee, 0xc2, 0xd2, 0x9e, 0xc3, 0x92, 0x35, 0xad, 0x24, 0x23,
+    0xbe, 0x59, 0x54, 0xd8, 0xad, 0x0d, 0x47, 0xa6, 0x60, 0x47, 0xe9, 0x73, 0x80, 0x51, 0xd1, 0xdf,
+    0xba, 0x6b, 0x8e, 0xa7, 0xe8, 0x74, 0xf5, 0x62, 0x09, 0xad, 0x33, 0x72, 0x98, 0xef, 0xb2, 0x35,
+    0x28, 0xc9, 0x88, 0x79, 0xff, 0xf5, 0x1f, 0x18, 0x05, 0xbc, 0xae, 0x49, 0x0d, 0x3c, 0x9d, 0x01,
+    0xc1, 0x9b, 0x59, 0x9c, 0x24, 0xf0, 0x82, 0x6a, 0x91, 0xc1, 0x60, 0x0f, 0x0a, 0xf3, 0xc1, 0xd3,
+    0x2e, 0x1b, 0xee, 0x3e, 0xeb, 0x42, 0xfe, 0x3a, 0xe8, 0x78, 0x48, 0x2a, 0x11, 0x6c, 0x11, 0x1b,
+    0xe4, 0xa2, 0xa8, 0xf4, 0x21, 0x50, 0x23, 0x04, 0x54, 0x69, 0xed, 0x3d, 0x18, 0xb2, 0x7d, 0x4d,
+    0x83, 0x1f, 0x4b, 0x88, 0xb7, 0xb0, 0xa3, 0x52, 0x9d, 0x1a, 0x3b, 0x43, 0xe4, 0x64, 0xf0, 0xdd,
+    0x6e, 0x97, 0xed, 0xed, 0xd5, 0xb9, 0xa9, 0x08, 0xad, 0x31, 0x43, 0x03, 0x04, 0x52, 0x59, 0x9d,
+    0xc3, 0x0b, 0xbd, 0xde, 0xce, 0x8c, 0x1d, 0x8e, 0x3a, 0x35, 0x3c, 0xb5, 0xa5, 0xb4, 0x43, 0x04,
+    0x1a, 0xfb, 0x60, 0xe3, 0xa2, 0x28, 0x3d, 0xf4, 0x4b, 0x64, 0xab, 0x09, 0xa8, 0xd0, 0xa9, 0xf4,
+    0xa6, 0x84, 0xa5, 0xd8, 0x74, 0x06, 0xa6, 0xd8, 0x02, 0x3f, 0x7e, 0x70, 0x53, 0xf9, 0x8b, 0xe6,
+    0x02, 0xe0, 0xfa, 0xd7, 0x42, 0x29, 0x6b, 0x3c, 0x63, 0xea, 0x11, 0xb4, 0xb8, 0x1f, 0xec, 0x77,
+    0xc0, 0x65, 0x15, 0xeb, 0x2c, 0xad, 0x14, 0x65, 0x5c, 0x03, 0x1a, 0x3a, 0x40, 0x5a, 0xfc, 0x75,
+    0x20, 0x1b, 0x44, 0xd5, 0x0f, 0x04, 0x52, 0xbd, 0xa3, 0x3c, 0xd8, 0x73, 0xc8, 0xdc, 0xca, 0x9e,
+    0x45, 0xad, 0xb2, 0x4a, 0x0a, 0xd8, 0x77, 0xf0, 0x72, 0xf5, 0xd0, 0x4f, 0x52, 0xb4, 0x27, 0x07,
+    0x14, 0x04, 0xde, 0x71, 0x28, 0x64, 0x26, 0xac, 0x01, 0x3e, 0x6e, 0x13, 0x8f, 0xd6, 0x51, 0x1b,
+    0x89, 0xe5, 0x0e, 0x11, 0x4d, 0x95, 0x38, 0x78, 0xe3, 0x26, 0x30, 0xad, 0xf8, 0x26, 0xce, 0x8b,
+    0x00, 0x0a, 0x1d, 0x9b, 0x44, 0xca, 0x3a, 0x94, 0x83, 0x60, 0xa0, 0xf2, 0xa2, 0x29, 0xf4, 0xaf,
+    0x2f, 0xfd, 0xd6, 0x54, 0x78, 0xf7, 0x5f, 0xde, 0x14, 0x87, 0x5b, 0x49, 0xb8, 0x13, 0x01, 0x3f,
+    0x62, 0xe9, 0x78, 0xff, 0xc5, 0xb1, 0xe2, 0x74, 0x16, 0xfe, 0xfa, 0x4a, 0xc7, 0xba, 0x00, 0xbd,
+    0xff, 0x62, 0xba, 0x74, 0xd5, 0xeb, 0xd9, 0x1a, 0xc8, 0x57, 0xab, 0xe4, 0xea, 0x03, 0x08, 0xc1,
+    0xc7, 0xc8, 0xa8, 0xf8, 0xdd, 0xd9, 0x61, 0xdf, 0xed, 0x43, 0x38, 0x5a, 0xf0, 0x64, 0x66, 0x7a,
+    0x41, 0x26, 0xa1, 0xf9, 0x22, 0xb2, 0xec, 0x11, 0x84, 0x63, 0x56, 0x2c, 0x04, 0x23, 0xb9, 0x03,
+    0x01, 0x68, 0xd6, 0xb3, 0x4c, 0x2e, 0x2b, 0xa8, 0x30, 0xfe, 0x6e, 0x9f, 0xc0, 0x76, 0xf8, 0x2a,
+    0xde, 0x41, 0xd4, 0x55, 0xc4, 0xc5, 0x18, 0x12, 0x59, 0x96, 0x4b, 0xc0, 0x55, 0x4c, 0x85, 0x05,
+    0xea, 0x00, 0xf8, 0xea, 0xe1, 0x64, 0x02, 0x1e, 0x31, 0x12, 0x33, 0xf0, 0xae, 0x11, 0xfb, 0xbe,
+    0x09, 0x30, 0x42, 0xcc, 0xdf, 0x33, 0x3f, 0x8c, 0x3f, 0x0d, 0x3e, 0xb3, 0x1e, 0x3c, 0x7d, 0xea,
+    0x7f, 0xc6, 0x50, 0x39, 0x84, 0xa1, 0x74, 0x9d, 0x24, 0xe4, 0x09, 0xb7, 0x66, 0x07, 0x8d, 0x9a,
+    0xa7, 0xe3, 0x8a, 0x5f, 0x07, 0xb9, 0x6a, 0x51, 0x88, 0xaa, 0xaf, 0xb0, 0xae, 0xf7, 0x87, 0x1d,
+    0xf6, 0x84, 0xf9, 0x86, 0x46, 0x5c, 0x09, 0xc8, 0xf0, 0xd8, 0x3f, 0xaf, 0xfb, 0xfd, 0xe9, 0x00,
+    0x3e, 0x3c, 0x41, 0x96, 0x6c, 0x68, 0x70, 0xd9, 0x1e, 0xce, 0xf1, 0x54, 0xbd, 0xe2, 0xdd, 0x4a,
+    0x58, 0xb3, 0x74, 0xaa, 0x11, 0xa6, 0x88, 0xd2, 0x60, 0x2e, 0x51, 0x77, 0x5a, 0xa0, 0x59, 0x49,
+    0xb5, 0x2e, 0xa0, 0xc1, 0x7e, 0xc5, 0x02, 0xf5, 0x82, 0xaa, 0x15, 0x7d, 0x05, 0x54, 0x5f, 0x01,
+    0x6a, 0x2f, 0xaf, 0x25, 0xb2, 0x44, 0x77, 0x08, 0x2a, 0xd1, 0xdd, 0xe3, 0x49, 0x54, 0x0f, 0x25,
+    0x60, 0x04, 0x2a, 0x1c, 0x92, 0x33, 0xc8, 0x31, 0x51, 0x4c, 0xe7, 0x02, 0xd3, 0x6d, 0xc1, 0x56,
+    0xa2, 0xaa, 0x27, 0xa0, 0xdc, 0xc1, 0x44, 0x0e, 0xf4, 0x6c, 0xc0, 0x16, 0x9d, 0x11, 0x53, 0xa7,
+    0x59, 0x90, 0x29, 0x61, 0x26, 0x1c, 0x65, 0x7c, 0x93, 0xc2, 0x9c, 0xe4, 0x0a, 0xf1, 0x6d, 0x16,
+    0x02, 0x32, 0x59, 0x48, 0x91, 0xe7, 0x22, 0x15, 0xaa, 0x55, 0xc8, 0x96, 0xf2, 0x42, 0x40, 0xac,
+    0xe7, 0x69, 0x04, 0x33, 0x57, 0x12, 0x74, 0x67, 0x26, 0x8a, 0x70, 0x01, 0x0b, 0xe2, 0x2c, 0xb2,
+    0x32, 0x9e, 0x65, 0x1c, 0x3f, 0xf1, 0x42, 0x13, 0x11, 0x3d, 0xb0, 0x72, 0xd7, 0x1f, 0x00, 0xe7,
+    0x84, 0x5d, 0xeb, 0x8c, 0x45, 0x69, 0xba, 0x4e, 0xa8, 0xd5, 0x03, 0xbb, 0x19, 0xdb, 0xf0, 0xaf,
+    0x10, 0x3d, 0xf6, 0x7a, 0xbe, 0x3a, 0xc9, 0xf5, 0x11, 0x24, 0x0c, 0x1f, 0x0f, 0xc6, 0xba, 0x0a,
+    0x11, 0x0a, 0x3c, 0xed, 0x6a, 0xf1, 0x54, 0x81, 0x15, 0x64, 0xb1, 0x2e, 0xc4, 0x69, 0x21, 0x33,
+    0x11, 0xf0, 0x10, 0x37, 0xd4, 0xc4, 0xc5, 0x31, 0x3a, 0x96, 0x23, 0x92, 0x08, 0x39, 0x0b, 0xe4,
+    0x2d, 0x47, 0xb8, 0x88, 0xa9, 0x49, 0x50, 0x8c, 0x01, 0x99, 0x82, 0x47, 0x1a, 0x15, 0xe0, 0xaf,
+    0x99, 0xfd, 0xe3, 0xc7, 0xea, 0xed, 0x04, 0xde, 0x1a, 0xee, 0x3f, 0x21, 0x4d, 0x9f, 0xd9, 0x5f,
+    0xfe, 0xc2, 0xfc, 0x87, 0x7a, 0xaf, 0x00, 0xcc, 0x81, 0x32, 0x3c, 0x2b, 0xd0, 0x4e, 0xa7, 0xa4,
+    0xc8, 0x8e, 0x76, 0x79, 0x99, 0x9c, 0x97, 0x3a, 0xa6, 0xdf, 0x8f, 0xab, 0xd7, 0xd5, 0x7a, 0x93,
+    0x72, 0x09, 0xdb, 0x2b, 0x91, 0xec, 0x46, 0x38, 0xa4, 0x26, 0x55, 0xeb, 0x50, 0x82, 0xdd, 0x24,
+    0x46, 0xe1, 0xa1, 0x1c, 0x1b, 0xdf, 0xfb, 0x5e, 0xe9, 0x30, 0x77, 0xd0, 0x73, 0x28, 0x79, 0x5f,
+    0xb3, 0x90, 0x83, 0x4e, 0x80, 0xdf, 0x48, 0x65, 0x8f, 0x3e, 0x7a, 0x90, 0xd9, 0xd1, 0x02, 0x01,
+    0x48, 0x31, 0xf5, 0xa1, 0xe6, 0x5a, 0xc1, 0x16, 0x43, 0x48, 0x3f, 0xd4, 0x4c, 0x28, 0xc6, 0x1e,
+    0x9a, 0x81, 0x40, 0x9e, 0x77, 0x40, 0xe0, 0xd8, 0x4e, 0x4f, 0xc5, 0x86, 0x1d, 0x67, 0x19, 0x98,
+    0x87, 0xa7, 0x14, 0x3c, 0x13, 0x7f, 0x06, 0x2e, 0x0b, 0x36, 0x83, 0xed, 0xc7, 0x4e, 0x12, 0xae,
+    0x5b, 0xce, 0x53, 0x4d, 0x2c, 0x2d, 0x82, 0x32, 0x9b, 0x29, 0x87, 0x7f, 0xc9, 0x65, 0xea, 0xeb,
+    0x51, 0x87, 0x22, 0xa5, 0xb4, 0x16, 0x39, 0x95, 0x54, 0x69, 0xa8, 0xc4, 0xd8, 0x26, 0x56, 0x17,
+    0x5f, 0xc8, 0x51, 0x30, 0x02, 0x49, 0x46, 0x84, 0xa8, 0xcb, 0x32, 0x11, 0x81, 0x50, 0x3c, 0x10,
+    0x2b, 0x4c, 0x17, 0xbf, 0xa8, 0xd7, 0x46, 0x6c, 0xe4, 0x3c, 0x08, 0xfb, 0x08, 0x52, 0x65, 0x82,
+    0xee, 0x68, 0x8c, 0xb0, 0x5b, 0x3c, 0x49, 0xae, 0x7c, 0xa8, 0x25, 0x91, 0xc2, 0x2d, 0xfb, 0x42,
+    0x31, 0x83, 0x32, 0xe8, 0x9b, 0x36, 0x5b, 0xc8, 0xad, 0x88, 0x69, 0x59, 0x88, 0xae, 0x58, 0x60,
+    0xc9, 0x5a, 0x85, 0x5b, 0xd6, 0x0e, 0x5f, 0xc8, 0x6e, 0xa2, 0x5a, 0x31, 0x61, 0xa3, 0x20, 0x43,
+    0xf4, 0xdc, 0xb2, 0x38, 0x2a, 0xf3, 0x75, 0x6b, 0xbe, 0xc9, 0xdf, 0xc9, 0x5d, 0x9d, 0x81, 0x3d,
+    0xa9, 0x13, 0xe5, 0xca, 0xbe, 0xd4, 0x19, 0xb9, 0x97, 0x6b, 0x0b, 0x03, 0x39, 0x85, 0x32, 0x8b,
+    0xc0, 0xe1, 0x9c, 0x8b, 0x55, 0x81, 0xf1, 0xf9, 0x35, 0x28, 0x2f, 0x38, 0xdb, 0xa3, 0x17, 0x50,
+    0xc3, 0xb3, 0xfc, 0x2a, 0x0d, 0x19, 0xcf, 0xcf, 0x73, 0x44, 0x47, 0x8a, 0xb8, 0x88, 0xd1, 0x42,
+    0xaf, 0x94, 0x33, 0xc2, 0x2a, 0x10, 0x91, 0x1a, 0x6b, 0xe5, 0x33, 0x3c, 0x17, 0xc0, 0x37, 0xd8,
+    0x98, 0x04, 0x18, 0x63, 0xcf, 0x5d, 0x96, 0x4b, 0x60, 0x7f, 0x83, 0x2d, 0x49, 0x44, 0x95, 0x48,
+    0xd8, 0x17, 0x84, 0x5b, 0x41, 0x88, 0xc2, 0xbe, 0xe8, 0x15, 0xb8, 0xb7, 0x15, 0x72, 0x01, 0x18,
+    0x01, 0x8e, 0x49, 0xc0, 0x84, 0xae, 0x51, 0x79, 0x4d, 0x1c, 0x42, 0x24, 0x15, 0x03, 0x2c, 0x17,
+    0x69, 0x04, 0x0b, 0x22, 0x32, 0xc5, 0x02, 0xf9, 0x60, 0x45, 0x48, 0x40, 0x9c, 0x6b, 0xc0, 0x50,
+    0xae, 0x53, 0x10, 0x40, 0x0e, 0x40, 0x38, 0x23, 0x8f, 0xd1, 0x5f, 0xa3, 0xcf, 0x9d, 0x4a, 0x09,
+    0xd5, 0x14, 0xa2, 0x9c, 0xc5, 0x19, 0x50, 0x8b, 0xbc, 0x22, 0x3a, 0x39, 0x03, 0xc7, 0x8b, 0x83,
+    0xd4, 0xa5, 0xcf, 0x95, 0x9f, 0xc5, 0x67, 0x10, 0x9a, 0x9c, 0xcd, 0x40, 0x61, 0x59, 0x21, 0xe1,
+    0x2d, 0x50, 0x16, 0xe2, 0xe1, 0x11, 0xf3, 0xff, 0xd8, 0xfb, 0x51, 0x49, 0xa5, 0xf7, 0x02, 0xa7,
+    0x81, 0xeb, 0x46, 0x3c, 0xd5, 0xdb, 0x77, 0x72, 0xd3, 0x21, 0x09, 0xd8, 0xb2, 0x82, 0x65, 0x04,
+    0xcf, 0x92, 0x18, 0xa8, 0x46, 0xe4, 0x39, 0x6c, 0x80, 0x58, 0x21, 0x44, 0x9c, 0xb1, 0x55, 0xc2,
+    0x43, 0xe0, 0xe2, 0xa7, 0xb8, 0x00, 0x7d, 0x28, 0x10, 0x59, 0xb9, 0x2b, 0x84, 0x43, 0x6f, 0x6a,
+    0x28, 0x41, 0xa9, 0x69, 0x67, 0x4b, 0x1f, 0x01, 0x9b, 0xc5, 0xa6, 0x62, 0x86, 0xbe, 0x56, 0xfb,
+    0xf8, 0x1f, 0x5f, 0x9f, 0x9e, 0xbd, 0xff, 0xf0, 0xf3, 0x97, 0xd3, 0x9f, 0xdf, 0xbd, 0xfc, 0xf2,
+    0xf6, 0x14, 0xd4, 0xf8, 0x69, 0x1f, 0xfe, 0x75, 0xcb, 0x81, 0xdf, 0x1f, 0x1f, 0x9f, 0x7c, 0xc1,
+    0xf7, 0xbb, 0x7d, 0xf6, 0x0d, 0x7b, 0xf6, 0x74, 0xcf, 0x1e, 0x3c, 0x79, 0xfe, 0xc3, 0x31, 0x0c,
+    0xe1, 0x21, 0xa1, 0x09, 0x1a, 0x96, 0x3f, 0xa7, 0x90, 0x11, 0x4d, 0x4d, 0xb8, 0x50, 0xde, 0x7d,
+    0x04, 0x7e, 0x03, 0xd2, 0xd7, 0x2e, 0x9b, 0xae, 0xf3, 0xab, 0xf2, 0xa1, 0x88, 0x97, 0x22, 0x33,
+    0x80, 0x33, 0x8e, 0x1d, 0xf6, 0x96, 0xc0, 0x52, 0x5c, 0x1e, 0x81, 0xd2, 0xf8, 0xc5, 0xa5, 0xb2,
+    0x22, 0xed, 0x5c, 0xd0, 0x41, 0x9d, 0x00, 0x9b, 0x71, 0x2e, 0x7c, 0x03, 0x8a, 0x1e, 0x4e, 0x26,
+    0x17, 0x80, 0x39, 0x13, 0xbf, 0x88, 0xb0, 0x30, 0xbe, 0xba, 0xb8, 0x0c, 0x20, 0x22, 0xcb, 0xe5,
+    0x2a, 0x11, 0x05, 0xd2, 0x57, 0xc2, 0x03, 0x00, 0xd3, 0x73, 0x7c, 0x3c, 0x6a, 0x1e, 0x57, 0xe0,
+    0xda, 0x93, 0xa8, 0x07, 0x3e, 0x95, 0x54, 0xf2, 0xd6, 0x26, 0xe2, 0x1a, 0x40, 0x97, 0x72, 0x32,
+    0x66, 0x7e, 0xcd, 0x15, 0xa0, 0x9a, 0xea, 0x3d, 0xf7, 0x7f, 0x35, 0x03, 0xe4, 0xa5, 0x37, 0x71,
+    0x1a, 0xc9, 0x4d, 0x10, 0x9b, 0x5d, 0xef, 0x94, 0x5e, 0x53, 0x53, 0x62, 0xf9, 0xec, 0x4a, 0x35,
+    0x52, 0x54, 0xbe, 0x0b, 0xf0, 0x00, 0x7c, 0x9a, 0x08, 0x5d, 0x7e, 0xbb, 0x31, 0x47, 0x45, 0x1d,
+    0x93, 0x58, 0x1b, 0x3f, 0x3f, 0x61, 0xe5, 0x42, 0x01, 0xf2, 0x40, 0x85, 0x42, 0x1e, 0x72, 0xac,
+    0x49, 0x88, 0x1b, 0xf0, 0x3c, 0x83, 0x8e, 0x89, 0x5f, 0x34, 0x07, 0x04, 0xb5, 0x5e, 0xcd, 0x01,
+    0x0c, 0x0c, 0x53, 0x44, 0x10, 0xe9, 0x5c, 0x81, 0x95, 0x0b, 0x2b, 0x60, 0x60, 0x75, 0x9d, 0x40,
+    0x35, 0x92, 0x09, 0xc8, 0xb5, 0xde, 0x4f, 0x91, 0x03, 0xd2, 0x1f, 0xc8, 0x35, 0x95, 0x35, 0x78,
+    0x18, 0xd2, 0xce, 0xc5, 0xd5, 0x09, 0xc7, 0xd2, 0xc2, 0x2b, 0x3c, 0xdd, 0xa7, 0xb8, 0x23, 0x12,
+    0x61, 0x5a, 0x78, 0xcc, 0xec, 0x6b, 0x45, 0x66, 0xbe, 0x0e, 0x43, 0x91, 0xe7, 0xdb, 0x54, 0xc1,
+    0xc5, 0x5e, 0x29, 0x46, 0x85, 0xc0, 0x68, 0x47, 0x9b, 0x42, 0x18, 0xa8, 0xdb, 0xb4, 0x02, 0xe8,
+    0x8d, 0xde, 0x02, 0x85, 0x3e, 0xf0, 0x67, 0x17, 0xf0, 0xc5, 0x25, 0x20, 0xb5, 0x93, 0xa3, 0x68,
+    0x1a, 0xd0, 0x61, 0x30, 0x57, 0xcb, 0x58, 0x6c, 0xd5, 0xb7, 0x0b, 0x15, 0xb5, 0x29, 0x00, 0xcc,
+    0xb3, 0x69, 0x11, 0xab, 0xcb, 0x50, 0x19, 0x94, 0x8a, 0xc2, 0x35, 0x26, 0x74, 0xec, 0xb6, 0x45,
+    0xd0, 0x08, 0x70, 0xe0, 0xf0, 0xb4, 0x52, 0xbf, 0x22, 0xb3, 0xf5, 0x95, 0xf5, 0x56, 0x09, 0xde,
+    0x43, 0xfd, 0x86, 0x1d, 0xb2, 0x7e, 0x07, 0xd3, 0x2e, 0xfd, 0x88, 0xa9, 0x90, 0xcd, 0x9f, 0x7e,
+    0x0d, 0x00, 0x0f, 0x5d, 0xb6, 0xed, 0xec, 0xab, 0x65, 0xc2, 0x44, 0x23, 0x1c, 0xdf, 0x53, 0x74,
+    0x5d, 0xe6, 0xa1, 0xec, 0x37, 0x59, 0x6c, 0x2a, 0xfa, 0x2d, 0x72, 0x5b, 0xad, 0x0b, 0xcd, 0x02,
+    0x4c, 0x51, 0x1f, 0x0c, 0xbc, 0x2b, 0x3d, 0xcc, 0xde, 0xb5, 0x2c, 0x3a, 0x3a, 0x0b, 0x29, 0x05,
+    0xaa, 0x54, 0x80, 0xce, 0x82, 0x9d, 0x74, 0x44, 0xc3, 0x1b, 0x9f, 0x57, 0x66, 0x1e, 0x46, 0xce,
+    0xe0, 0xdc, 0x89, 0x9a, 0x9c, 0xc2, 0x25, 0xc5, 0x43, 0x08, 0x0d, 0x7a, 0xd6, 0x09, 0x0f, 0xcf,
+    0x3f, 0xa8, 0x08, 0x3d, 0xd6, 0x42, 0xca, 0x55, 0x04, 0x58, 0x67, 0x39, 0x88, 0x06, 0x20, 0xf1,
+    0x29, 0x85, 0x82, 0x45, 0x4f, 0xcd, 0xc8, 0xa9, 0x5a, 0xbb, 0x87, 0xb8, 0x4f, 0x60, 0xc8, 0xc7,
+    0xf8, 0x06, 0x4e, 0x59, 0x46, 0x57, 0x90, 0x89, 0xf0, 0xfc, 0x1d, 0xcc, 0xb1, 0xd5, 0x11, 0x6f,
+    0xd5, 0x61, 0x8e, 0x03, 0x3f, 0xb1, 0x8b, 0xf6, 0x07, 0x78, 0xf4, 0x11, 0xb8, 0x63, 0x72, 0x62,
+    0x7c, 0x08, 0xa6, 0x57, 0x85, 0x78, 0x23, 0xd2, 0x79, 0xb1, 0x60, 0x07, 0x6c, 0xf0, 0x14, 0x37,
+    0x13, 0x27, 0xa2, 0xea, 0x7d, 0x84, 0x02, 0x68, 0x77, 0xe8, 0x43, 0xf0, 0x28, 0x32, 0x6c, 0x55,
+    0x61, 0xa2, 0xde, 0xbf, 0xdc, 0x1b, 0xee, 0x3d, 0xdb, 0xdb, 0xdb, 0x1f, 0xb6, 0x24, 0x9b, 0xef,
+    0xd0, 0x5d, 0x31, 0x93, 0x50, 0xac, 0x80, 0x55, 0x5b, 0xdb, 0xf1, 0x48, 0x17, 0xe8, 0xb1, 0xb1,
+    0x0f, 0x9e, 0xfa, 0x4f, 0x35, 0xf6, 0xae, 0x8a, 0xeb, 0x35, 0x00, 0x58, 0x7e, 0x30, 0xd4, 0x10,
+    0x77, 0xd7, 0x96, 0x4f, 0x96, 0x17, 0x52, 0x2a, 0xf1, 0xb9, 0xa9, 0x3a, 0x76, 0xec, 0xcb, 0xdb,
+    0x4c, 0x50, 0xa3, 0xe8, 0x6c, 0xeb, 0x8e, 0x13, 0xbd, 0x2d, 0x3d, 0x7f, 0x8e, 0x4c, 0x80, 0x24,
+    0x9f, 0x30, 0x6c, 0xe5, 0x23, 0xd7, 0x76, 0xcb, 0x3f, 0x2f, 0x54, 0x03, 0xb6, 0xc6, 0x25, 0x2f,
+    0x2c, 0x2e, 0x8d, 0xd1, 0xe4, 0xa4, 0xc8, 0xd7, 0x0c, 0xb2, 0x1a, 0x35, 0xed, 0x09, 0xe5, 0x34,
+    0x81, 0x4a, 0x5a, 0x40, 0x62, 0xa3, 0x26, 0x1a, 0x80, 0xd9, 0x2b, 0x45, 0x9a, 0x8f, 0xea, 0xe2,
+    0x26, 0x80, 0x41, 0x29, 0x74, 0xed, 0x91, 0xed, 0x7f, 0xcb, 0x76, 0xa4, 0xe5, 0x36, 0x94, 0x8e,
+    0x9c, 0x48, 0xd1, 0x6a, 0x3b, 0x29, 0x09, 0x1c, 0x98, 0x4a, 0xc8, 0xb0, 0x10, 0x09, 0x0c, 0xdc,
+    0xfe, 0xeb, 0xa3, 0x17, 0xbf, 0x17, 0x57, 0x1f, 0xb0, 0xb8, 0x0d, 0xd6, 0x2b, 0x48, 0xed, 0x5e,
+    0xe0, 0x15, 0x02, 0x1f, 0x34, 0x53, 0x04, 0xa9, 0xdc, 0xf8, 0xd8, 0xc6, 0xc1, 0xa4, 0x84, 0xf5,
+    0x6a, 0x79, 0x4c, 0xe7, 0x6b, 0x86, 0xae, 0xcc, 0xc0, 0xc3, 0x5f, 0xde, 0x7d, 0x3d, 0xa5, 0x36,
+    0x9b, 0x86, 0x8b, 0xa4, 0x4a, 0xcd, 0x44, 0x7e, 0xc4, 0xec, 0x44, 0x7f, 0xbb, 0x8e, 0xd3, 0xda,
+    0xfe, 0x3d, 0xd8, 0xfb, 0x64, 0xb0, 0x7c, 0x8c, 0x17, 0xe1, 0x78, 0x31, 0x99, 0xc6, 0xe9, 0xe3,
+    0x24, 0x5e, 0xc6, 0xc5, 0x04, 0x6b, 0x15, 0x27, 0xf7, 0x82, 0x9a, 0xe5, 0xb1, 0x92, 0x1a, 0x8d,
+    0x59, 0x52, 0x6c, 0xec, 0x86, 0x53, 0x14, 0x92, 0xdd, 0xd7, 0x8a, 0x42, 0x3b, 0xf5, 0xa0, 0x6a,
+    0xad, 0x73, 0x9f, 0xda, 0xd0, 0x38, 0xb2, 0xfb, 0x54, 0x87, 0x4a, 0x89, 0x29, 0x99, 0x9e, 0x54,
+    0x40, 0xea, 0x0a, 0x45, 0x4e, 0xf1, 0xca, 0x73, 0x93, 0x67, 0xaf, 0x36, 0x15, 0xf6, 0x1a, 0x66,
+    0xbe, 0x5b, 0x2f, 0xa7, 0x22, 0xf3, 0xbf, 0x86, 0x00, 0xf2, 0x6c, 0x2b, 0xeb, 0x21, 0x96, 0x68,
+    0x69, 0x8c, 0x38, 0x3e, 0x62, 0xc2, 0x00, 0x55, 0x36, 0xe5, 0x29, 0x31, 0xa5, 0x16, 0x04, 0x38,
+    0x22, 0x2a, 0x14, 0x55, 0x21, 0x01, 0xc9, 0xcc, 0x95, 0x28, 0x2c, 0x24, 0x84, 0x03, 0xbd, 0x19,
+    0x09, 0x1f, 0x9f, 0x2a, 0xb9, 0x51, 0x6f, 0xf4, 0x39, 0xb2, 0x86, 0x0a, 0x8d, 0xcd, 0x1e, 0x94,
+    0x18, 0x26, 0xbb, 0x6c, 0xca, 0x31, 0xef, 0xc5, 0x3e, 0x0e, 0xd5, 0x0a, 0xe4, 0x9e, 0x37, 0x90,
+    0x9e, 0x43, 0x39, 0x05, 0x4b, 0xa0, 0x8b, 0xd8, 0x40, 0x7e, 0x4f, 0xfe, 0x5b, 0x26, 0x91, 0xf6,
+    0xe8, 0x25, 0x5a, 0x13, 0xf2, 0x8d, 0x03, 0xb0, 0xcd, 0x87, 0x3c, 0xeb, 0xb8, 0x04, 0x2d, 0xc9,
+    0x02, 0x30, 0xfc, 0x55, 0x1b, 0xd1, 0x35, 0x8b, 0x3e, 0x36, 0xcc, 0xda, 0xed, 0xa8, 0x03, 0x86,
+    0x04, 0xcf, 0xb5, 0xa9, 0xa5, 0xb9, 0x5a, 0xab, 0xa1, 0x44, 0x34, 0x59, 0xa5, 0x28, 0xd1, 0xd2,
+    0x0d, 0xc4, 0x8d, 0xb3, 0x7f, 0xda, 0x62, 0xda, 0x76, 0x1f, 0x86, 0x9c, 0xcd, 0x03, 0x30, 0x6f,
+    0x6b, 0x5b, 0x81, 0x5a, 0x04, 0x2f, 0xd6, 0xb3, 0x19, 0xa8, 0x41, 0xdd, 0x40, 0x29, 0x4a, 0x55,
+    0x46, 0x7a, 0x7b, 0xc4, 0x1b, 0x97, 0x0e, 0xa9, 0xdd, 0x34, 0x96, 0x30, 0xd9, 0x42, 0x86, 0x8f,
+    0xec, 0xfb, 0x36, 0x03, 0x1f, 0xb5, 0xb7, 0x03, 0xc0, 0x94, 0xb1, 0x79, 0x9e, 0xfb, 0x65, 0x61,
+    0x8d, 0x05, 0x5a, 0x97, 0xe9, 0x4b, 0xe9, 0x30, 0x9c, 0x3b, 0xe7, 0xd5, 0xaa, 0x3a, 0x55, 0x71,
+    0xf7, 0x39, 0x32, 0xe9, 0x13, 0x48, 0x80, 0x27, 0x79, 0x7e, 0x1f, 0x9d, 0xb2, 0x2e, 0x5c, 0xb7,
+    0x82, 0x28, 0x1f, 0x46, 0x8b, 0x05, 0xa0, 0x55, 0xc7, 0xdc, 0xce, 0x4a, 0x32, 0x37, 0xd8, 0xc4,
+    0xb5, 0xd3, 0xe3, 0x2c, 0x28, 0x60, 0xe3, 0x91, 0x42, 0x54, 0x04, 0xa2, 0x51, 0x4b, 0x07, 0xb7,
+    0x39, 0x66, 0x87, 0xb0, 0xf5, 0xd8, 0x3c, 0xc3, 0x00, 0x56, 0x91, 0xae, 0xf0, 0x21, 0xe1, 0x9f,
+    0xe2, 0xcf, 0xec, 0x09, 0xec, 0x6d, 0x10, 0x9a, 0x8d, 0xd3, 0xe4, 0x96, 0x03, 0x79, 0x55, 0x76,
+    0x28, 0xc1, 0x53, 0xbe, 0x43, 0xe5, 0x2b, 0x04, 0x8a, 0xaa, 0xfa, 0x06, 0xec, 0xca, 0x1e, 0xb0,
+    0x8a, 0x1d, 0x83, 0x1d, 0xcd, 0xf9, 0x4a, 0x5f, 0xa2, 0x56, 0x19, 0x0f, 0x02, 0xa8, 0xca, 0x16,
+    0xaa, 0xf7, 0x2a, 0x6b, 0x51, 0xfd, 0x3d, 0x73, 0x2c, 0x8d, 0x31, 0x97, 0x5a, 0x0f, 0x93, 0xb2,
+    0xc1, 0xdf, 0x16, 0x8b, 0x91, 0x15, 0x27, 0x14, 0x23, 0xb7, 0x15, 0xe5, 0x1d, 0x83, 0xa3, 0x62,
+    0x72, 0xc7, 0x66, 0xec, 0x1b, 0x28, 0xa1, 0xe1, 0x47, 0x33, 0x55, 0xad, 0x44, 0x47, 0x08, 0x4c,
+    0xf7, 0xbf, 0xa3, 0xc9, 0x54, 0xc7, 0xe0, 0x38, 0x54, 0x9e, 0x81, 0x6b, 0x35, 0x53, 0xe3, 0x8e,
+    0x22, 0x59, 0xb9, 0xa6, 0x6f, 0xe5, 0xda, 0x6e, 0x1e, 0xd3, 0x48, 0xa6, 0x4d, 0x6e, 0xae, 0xf1,
+    0xea, 0xa2, 0x33, 0xa8, 0x0a, 0xdf, 0x07, 0xae, 0x67, 0x6d, 0x38, 0x82, 0xfb, 0x24, 0xd9, 0x76,
+    0xca, 0xf3, 0xd5, 0x12, 0xc5, 0x00, 0xa3, 0xd3, 0x7e, 0x0e, 0x8a, 0x6b, 0x47, 0xf8, 0x44, 0x6e,
+    0x4c, 0x84, 0x47, 0xb2, 0x7a, 0xaa, 0x0b, 0xd1, 0xb9, 0x6b, 0x78, 0x76, 0x4a, 0x5a, 0x32, 0x04,
+    0xf2, 0x37, 0x4e, 0x55, 0xf3, 0xc0, 0x8a, 0x72, 0xca, 0x56, 0x12, 0x4a, 0x63, 0x3b, 0x4e, 0x75,
+    0xdc, 0xec, 0x55, 0x23, 0x2b, 0xa5, 0x77, 0xab, 0x5f, 0x02, 0x68, 0x1a, 0xbb, 0x22, 0x7f, 0xf7,
+    0x29, 0xf6, 0x50, 0x06, 0xcf, 0xe0, 0xc7, 0xb0, 0x6f, 0x22, 0x52, 0xed, 0xcc, 0x7d, 0xdb, 0x5c,
+    0xdd, 0x80, 0x51, 0x28, 0x86, 0x7b, 0x6a, 0x76, 0xbd, 0x24, 0x03, 0x0f, 0x74, 0x27, 0xdd, 0xb0,
+    0xdf, 0x60, 0x3b, 0x66, 0x5b, 0xa5, 0x85, 0x63, 0x16, 0xa7, 0x61, 0x22, 0x78, 0x76, 0x06, 0x41,
+    0x4c, 0x42, 0xc2, 0x64, 0xc3, 0x51, 0x17, 0x47, 0x6f, 0x8b, 0xae, 0x6a, 0x75, 0x26, 0xd5, 0xe6,
+    0x4b, 0x75, 0x26, 0xe4, 0xe4, 0x41, 0xb6, 0x13, 0x45, 0x0a, 0xaf, 0x75, 0x1f, 0x4e, 0x35, 0x86,
+    0x54, 0xac, 0x1a, 0x31, 0x60, 0x5d, 0xc5, 0x1e, 0xbc, 0x76, 0x7c, 0x43, 0x4e, 0xdb, 0x5a, 0xc0,
+    0x2e, 0xc3, 0xec, 0x8e, 0xf0, 0x57, 0x6b, 0x31, 0xd5, 0x1a, 0xc6, 0xa5, 0x31, 0xdc, 0xeb, 0x5c,
+    0xcc, 0x2d, 0xc9, 0xdc, 0x7e, 0x70, 0x4b, 0x4f, 0xa3, 0x45, 0x6c, 0x2a, 0x93, 0xb0, 0xd3, 0x8e,
+    0xf2, 0xe8, 0x6b, 0x11, 0x47, 0x91, 0x48, 0x3b, 0xac, 0x21, 0x44, 0x0c, 0xe9, 0xa2, 0x30, 0x32,
+    0xb6, 0x36, 0xb4, 0x5b, 0xef, 0xd8, 0x95, 0xe1, 0xca, 0x55, 0x01, 0xf4, 0xa1, 0xae, 0x0e, 0x38,
+    0xed, 0xa7, 0xb6, 0xfd, 0xc0, 0x4a, 0xbb, 0x8d, 0x0d, 0xd0, 0x95, 0x09, 0x8b, 0xa6, 0x8d, 0xd8,
+    0x6b, 0x76, 0xd8, 0x2e, 0x89, 0xb7, 0xc5, 0x4d, 0xbb, 0x29, 0x50, 0xc7, 0x5f, 0xab, 0xe3, 0x71,
+    0xdb, 0x8d, 0x77, 0xb6, 0xd6, 0x73, 0x1c, 0x1e, 0xe5, 0x65, 0x3f, 0x61, 0xe7, 0x15, 0x53, 0x26,
+    0x7d, 0x28, 0x44, 0x4e, 0x15, 0xa5, 0xd7, 0x35, 0x91, 0xc0, 0x6a, 0x08, 0x83, 0x63, 0x02, 0x27,
+    0x92, 0x37, 0x49, 0xb4, 0x64, 0x7b, 0x3f, 0x6d, 0x31, 0x09, 0x2f, 0xad, 0xce, 0xd6, 0x69, 0xd9,
+    0x5a, 0x6b, 0x2d, 0xe2, 0xdf, 0xa0, 0xb3, 0xd0, 0xe1, 0x88, 0x03, 0x3c, 0xfa, 0x7a, 0xa0, 0x99,
+    0xee, 0xe8, 0xef, 0xd0, 0x91, 0x38, 0x84, 0x1c, 0x3c, 0xcf, 0x43, 0xd5, 0xab, 0xfa, 0xb5, 0xb1,
+    0x75, 0xae, 0x07, 0x7a, 0x94, 0xe0, 0x7d, 0x69, 0x75, 0x34, 0x08, 0xd9, 0xb5, 0x3e, 0x11, 0x83,
+    0x9d, 0x58, 0x22, 0x60, 0x24, 0x37, 0x29, 0xf3, 0x31, 0x59, 0x84, 0x98, 0xb9, 0xdc, 0xc0, 0x2a,
+    0x50, 0x64, 0x49, 0xc9, 0x96, 0x3c, 0xbd, 0x02, 0x9b, 0x8d, 0x71, 0x8d, 0x2e, 0xb9, 0xc0, 0x34,
+    0xc5, 0x2f, 0x39, 0xa5, 0xf3, 0x4e, 0x80, 0xb8, 0xde, 0x63, 0x1f, 0x1e, 0x2a, 0x83, 0x68, 0x9d,
+    0x00, 0x31, 0x80, 0x24, 0xc7, 0x33, 0x7a, 0xac, 0xb9, 0x25, 0x5e, 0x17, 0x02, 0x21, 0x2f, 0xa5,
+    0x6e, 0xd7, 0x1b, 0x07, 0x0e, 0xc1, 0x76, 0x96, 0xe0, 0xf5, 0x3d, 0xd5, 0x74, 0x37, 0x67, 0x9b,
+    0x88, 0x2d, 0x92, 0x6b, 0x90, 0x81, 0x69, 0xf6, 0x0b, 0x48, 0x37, 0xa8, 0x14, 0x58, 0xa3, 0x8c,
+    0x56, 0xd8, 0x1a, 0xe7, 0x7a, 0xf3, 0xcd, 0x21, 0xa6, 0xb2, 0x01, 0x56, 0xf0, 0x29, 0xa4, 0x30,
+    0x10, 0xe2, 0x61, 0x16, 0x2e, 0x4c, 0x67, 0x0a, 0x29, 0xf5, 0xfb, 0x13, 0x6c, 0xe5, 0xa7, 0xea,
+    0xe2, 0x80, 0xe1, 0x17, 0xb5, 0xd9, 0xf4, 0xb0, 0x4f, 0xde, 0xbf, 0x79, 0xa3, 0x7a, 0xd7, 0xfb,
+    0xd4, 0xba, 0x56, 0xcf, 0xcf, 0xff, 0x68, 0xf5, 0xb3, 0x4d, 0x77, 0x1a, 0x31, 0x93, 0x75, 0x5d,
+    0xbb, 0x2d, 0xe7, 0x38, 0x7d, 0x95, 0xa8, 0x2b, 0xf6, 0xba, 0x21, 0x0d, 0x85, 0x26, 0x7e, 0x0d,
+    0x44, 0xa3, 0x86, 0x0d, 0x2d, 0xf8, 0xdc, 0x00, 0x6f, 0x78, 0x4a, 0x57, 0xa8, 0x09, 0xd4, 0x69,
+    0x50, 0x1b, 0x31, 0x9e, 0xc0, 0x32, 0xfe, 0xd2, 0xa4, 0x72, 0xb6, 0xbb, 0x54, 0x04, 0x58, 0x9e,
+    0xd2, 0x7e, 0x61, 0xe5, 0x25, 0xe8, 0x27, 0xf4, 0x90, 0x5a, 0x0e, 0xf3, 0xac, 0xa6, 0xe3, 0xa8,
+    0xcd, 0xb6, 0x7c, 0x86, 0x75, 0xbd, 0xb3, 0xcb, 0x96, 0x79, 0x8b, 0x7b, 0x38, 0x51, 0xda, 0xa6,
+    0xdd, 0x83, 0xbb, 0x58, 0xe5, 0xec, 0xc9, 0x61, 0x39, 0xcb, 0x20, 0x21, 0xfa, 0x85, 0x11, 0x5b,
+    0xc7, 0xe5, 0x5c, 0x8f, 0x92, 0x0c, 0xeb, 0x0b, 0xcb, 0xd5, 0xed, 0xeb, 0x96, 0xde, 0xd2, 0xc1,
+    0xd8, 0x27, 0x34, 0x98, 0xa7, 0xe5, 0x10, 0x64, 0x43, 0x51, 0x4a, 0xaa, 0xc4, 0xac, 0xb5, 0xfa,
+    0x98, 0x4c, 0xc9, 0x0e, 0x7b, 0xba, 0x59, 0x4e, 0x03, 0xa7, 0x6a, 0x32, 0x78, 0x18, 0x85, 0xc6,
+    0x0e, 0x78, 0x15, 0x62, 0x2c, 0x6a, 0x2b, 0x68, 0x28, 0xcd, 0x95, 0x7d, 0x2a, 0x0f, 0xa7, 0xc0,
+    0x02, 0x99, 0xa2, 0x06, 0xb6, 0xf5, 0xb5, 0x1d, 0x16, 0x95, 0x13, 0x53, 0xb7, 0x08, 0x4e, 0xa9,
+    0xf8, 0xf5, 0x3d, 0x7d, 0xc1, 0x5f, 0x45, 0x6e, 0x07, 0x65, 0x5b, 0x2f, 0xf9, 0x81, 0xae, 0x22,
+    0x6d, 0xfa, 0x81, 0xe8, 0x2c, 0x06, 0x1b, 0x9b, 0x5e, 0xe1, 0x51, 0x95, 0x48, 0x66, 0xca, 0x75,
+    0x98, 0x6b, 0x36, 0x4b, 0x01, 0xc2, 0x84, 0xad, 0x6a, 0x5b, 0x5b, 0x7d, 0xf3, 0xc2, 0x38, 0x6b,
+    0x57, 0x0f, 0xea, 0x04, 0xf1, 0x28, 0xa2, 0x55, 0xf1, 0x86, 0x10, 0xde, 0x40, 0xc0, 0xc6, 0x7f,
+    0x41, 0xd7, 0x22, 0x4b, 0xdf, 0x68, 0x08, 0xac, 0xae, 0x05, 0x59, 0x97, 0x62, 0x21, 0x74, 0xe0,
+    0x89, 0xe7, 0x57, 0x85, 0x60, 0xc6, 0xf0, 0x0b, 0x0a, 0xea, 0x4a, 0x71, 0xe4, 0x97, 0x79, 0xcd,
+    0x2d, 0xd4, 0xa8, 0x73, 0xae, 0xed, 0xf4, 0xe8, 0x63, 0xd7, 0x2d, 0x14, 0xd5, 0x22, 0x66, 0x14,
+    0xe7, 0xdb, 0x54, 0xc8, 0xe8, 0x8a, 0xde, 0x5f, 0x45, 0x4e, 0x98, 0xc8, 0x5c, 0x98, 0x0d, 0xae,
+    0x29, 0x65, 0xed, 0xce, 0x94, 0x73, 0xd3, 0xda, 0xdc, 0x98, 0x7a, 0xce, 0xe8, 0x1e, 0x36, 0xb6,
+    0x64, 0xb9, 0xf2, 0x45, 0xda, 0xa9, 0xf3, 0xd2, 0xcb, 0x66, 0x6b, 0x70, 0xc5, 0xbf, 0xc8, 0x38,
+    0xd5, 0xa7, 0x8c, 0xfa, 0xbd, 0xeb, 0x1d, 0x2a, 0x13, 0xac, 0x54, 0xb9, 0x36, 0xb4, 0x2d, 0x75,
+    0xbb, 0xab, 0x2f, 0x72, 0x77, 0xce, 0x7c, 0xf9, 0xc7, 0x33, 0xf5, 0x9a, 0xb9, 0x63, 0x00, 0x04,
+    0x40, 0x0c, 0x88, 0x11, 0x36, 0x57, 0xc5, 0xda, 0xeb, 0x59, 0xef, 0x1d, 0x68, 0x75, 0xef, 0x2d,
+    0x46, 0xd4, 0x31, 0xfa, 0x70, 0x10, 0x89, 0xba, 0x92, 0x42, 0x75, 0x37, 0x1d, 0x51, 0xe6, 0xf4,
+    0x25, 0x20, 0x3c, 0x99, 0xe4, 0x6c, 0xb7, 0xbf, 0xd7, 0x72, 0xb3, 0xe1, 0x7b, 0xb5, 0xd1, 0x93,
+    0x3e, 0x9d, 0x03, 0x2d, 0x45, 0xb1, 0x90, 0xd8, 0x58, 0xfa, 0xe1, 0xf8, 0x0c, 0x6f, 0xb9, 0xfe,
+    0x23, 0x6e, 0x3a, 0x54, 0xfd, 0x9a, 0x66, 0x1b, 0x5a, 0x14, 0x1b, 0x99, 0x9d, 0x97, 0xbd, 0x06,
+    0xca, 0x38, 0xf0, 0x28, 0x4d, 0x9e, 0xdf, 0xde, 0xdc, 0x72, 0x3b, 0x1d, 0x18, 0x3f, 0xb6, 0x36,
+    0xb9, 0x8e, 0xcf, 0xf8, 0xdc, 0x73, 0x3a, 0x53, 0x04, 0x0e, 0x8e, 0x56, 0x4d, 0x83, 0x42, 0x51,
+    0x6f, 0x0d, 0x3e, 0x97, 0xe5, 0x9b, 0x9d, 0x25, 0x59, 0xe3, 0xb0, 0x0c, 0xfe, 0xba, 0xf7, 0x15,
+    0x0c, 0x4a, 0x38, 0x2c, 0x31, 0xd9, 0x5e, 0x1c, 0x70, 0xea, 0x50, 0x68, 0xd0, 0xde, 0x66, 0xce,
+    0x5b, 0x0d, 0xda, 0xb0, 0x57, 0xdd, 0x84, 0x50, 0xff, 0x6a, 0xb7, 0x0a, 0xad, 0x3e, 0x53, 0xfd,
+    0x74, 0x89, 0xae, 0x31, 0xac, 0xf3, 0x8b, 0xc5, 0x97, 0x95, 0xc8, 0xbe, 0x84, 0xab, 0xa5, 0x05,
+    0xdc, 0xb8, 0x6b, 0xe1, 0x6e, 0xc5, 0x96, 0xfb, 0x21, 0xd7, 0xd6, 0x3e, 0xdd, 0x76, 0x4f, 0x04,
+    0x31, 0x5a, 0xa9, 0x5d, 0xbb, 0x18, 0x5c, 0xf7, 0xda, 0x90, 0x21, 0x35, 0x57, 0x20, 0xfd, 0x71,
+    0x22, 0x24, 0xfb, 0x86, 0x0d, 0x9d, 0xa4, 0xa5, 0xb6, 0x39, 0xb5, 0xdb, 0x27, 0x2e, 0x66, 0xcb,
+    0xc6, 0x9d, 0x3a, 0xe3, 0xb6, 0x78, 0x5c, 0xd5, 0x0b, 0x65, 0x3e, 0xd1, 0x74, 0xae, 0x17, 0x71,
+    0x1e, 0x4f, 0xe3, 0x24, 0x2e, 0xae, 0x94, 0xc5, 0xda, 0x6e, 0xb6, 0x72, 0x8d, 0x8d, 0x84, 0xa4,
+    0x8c, 0x57, 0xaf, 0x32, 0x21, 0x72, 0xf7, 0x4e, 0x09, 0x85, 0xd1, 0x9e, 0x4e, 0xe0, 0xf2, 0x44,
+    0xdd, 0x85, 0xa0, 0x78, 0xa9, 0x00, 0xc9, 0xef, 0xa8, 0x62, 0xb8, 0xe1, 0x8c, 0xb5, 0x9f, 0xad,
+    0xe7, 0x04, 0xb4, 0x71, 0x5f, 0x2f, 0x47, 0xeb, 0x17, 0xab, 0xb6, 0xab, 0xb6, 0xe3, 0xab, 0x75,
+    0xe7, 0xa2, 0x4e, 0x87, 0x53, 0x5f, 0x83, 0x18, 0x3b, 0xe3, 0xfa, 0x0d, 0x6d, 0xad, 0x0f, 0xda,
+    0x23, 0x58, 0x0d, 0xbd, 0xea, 0xdb, 0x7e, 0xb7, 0xdc, 0xc9, 0x6e, 0x7c, 0x65, 0x50, 0x1d, 0xb2,
+    0x99, 0x47, 0xf7, 0x46, 0x76, 0x03, 0xd8, 0x24, 0x6d, 0x6a, 0x80, 0x9c, 0x47, 0x69, 0x9e, 0xa6,
+    0x9f, 0xe5, 0xa2, 0xaa, 0x6e, 0x00, 0xbb, 0x5f, 0x41, 0x34, 0xbd, 0xbe, 0x12, 0xba, 0x76, 0xbf,
+    0x58, 0x7d, 0x43, 0xd1, 0xab, 0x5d, 0x86, 0xb6, 0xd7, 0xad, 0x62, 0xc5, 0x1d, 0x57, 0x76, 0x83,
+    0xcb, 0x2d, 0x6b, 0x7f, 0xd4, 0x80, 0x41, 0x10, 0xdc, 0x46, 0x40, 0x69, 0x90, 0x77, 0xe5, 0xdc,
+    0x35, 0xe0, 0xed, 0xac, 0xeb, 0x6f, 0xb0, 0xf6, 0xd8, 0x07, 0xab, 0x9e, 0x2a, 0x89, 0x69, 0xde,
+    0xd9, 0x77, 0x5c, 0xa1, 0xa5, 0x10, 0xaa, 0xcf, 0xa6, 0x8f, 0x55, 0x9d, 0x0e, 0x1c, 0x6a, 0xef,
+    0x69, 0x41, 0x71, 0x18, 0xd2, 0xd7, 0x42, 0xbe, 0x91, 0xf8, 0x97, 0x4a, 0xce, 0xd4, 0xdb, 0x32,
+    0x5f, 0xdb, 0xaa, 0x44, 0xce, 0x77, 0x3f, 0xeb, 0x57, 0x68, 0x3d, 0xf7, 0xbb, 0xa0, 0x18, 0xc6,
+    0xf4, 0x72, 0x5f, 0xf1, 0x0a, 0x47, 0xef, 0xdf, 0x6a, 0x2c, 0x6f, 0x24, 0x04, 0xb0, 0xa8, 0xe9,
+    0x15, 0x6e, 0x4b, 0x16, 0xec, 0x6f, 0x65, 0x91, 0x21, 0xb9, 0xe9, 0x27, 0xba, 0x8d, 0x8f, 0x90,
+    0xb9, 0x26, 0xe4, 0x0d, 0x1a, 0xe5, 0x5e, 0x7e, 0x57, 0xf3, 0x74, 0x7a, 0x1f, 0x3a, 0x49, 0x31,
+    0x1b, 0xa6, 0x0e, 0x4c, 0xf0, 0x56, 0x0a, 0xe6, 0x1b, 0xb9, 0x08, 0xb1, 0x30, 0xa5, 0xbf, 0xd5,
+    0x72, 0x59, 0x30, 0xff, 0xc7, 0xb3, 0xb3, 0x93, 0x53, 0x6c, 0xaa, 0x0b, 0xf6, 0xa8, 0x48, 0xf2,
+    0x47, 0xf8, 0x67, 0x07, 0x12, 0x0e, 0x69, 0x35, 0x0e, 0xc0, 0xdc, 0x18, 0x92, 0x6c, 0xb4, 0xfe,
+    0x5c, 0xdb, 0x98, 0x87, 0x5f, 0x5d, 0x03, 0xe7, 0xf6, 0x13, 0x64, 0x08, 0x22, 0xf3, 0x30, 0x01,
+    0x4f, 0xf9, 0x45, 0x3c, 0xe7, 0x56, 0xb3, 0xa3, 0x7c, 0x11, 0x38, 0xc0, 0x41, 0x26, 0xe6, 0x28,
+    0x56, 0x10, 0xea, 0x4e, 0xbe, 0xc1, 0x3f, 0xe5, 0xb2, 0xf5, 0xce, 0x40, 0x7b, 0x80, 0x3a, 0x55,
+    0xd8, 0xd8, 0x86, 0xd0, 0x51, 0x4a, 0x62, 0x50, 0xc2, 0x9e, 0xd6, 0x02, 0xd5, 0x8d, 0xb9, 0xc9,
+    0x0f, 0xbf, 0xad, 0xbf, 0x18, 0xb3, 0x43, 0x5f, 0x75, 0x3e, 0xd8, 0xa1, 0x3f, 0xb9, 0xf3, 0xe0,
+    0x7f, 0x01, 0xbb, 0x48, 0xb2, 0xa0, 0x83, 0x47, 0x00, 0x00,
+};
+
+#define DASHBOARD_CHARTS_PATH "/charts.3ecf73fc.js"
+static const size_t DASHBOARD_CHARTS_GZ_LEN = 1306;
+static const uint8_t DASHBOARD_CHARTS_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xa5, 0x57, 0x6d, 0x6f, 0xdb, 0x36,
+    0x10, 0xfe, 0x9e, 0x5f, 0xc1, 0xa1, 0x58, 0x45, 0xc5, 0xb2, 0x22, 0x39, 0x76, 0xdb, 0xc5, 0xcb,
+    0x86, 0xa2, 0x18, 0x86, 0x02, 0x0d, 0x16, 0x64, 0x01, 0xfa, 0x21, 0xc8, 0x07, 0x45, 0xa2, 0x64,
+    0x62, 0x32, 0x29, 0x50, 0xf4, 0xdb, 0x5a, 0xff, 0xf7, 0xdd, 0xf1, 0x45, 0x96, 0x94, 0x6c, 0xeb,
+    0x30, 0x20, 0x89, 0x44, 0xf2, 0x5e, 0x9e, 0x3b, 0x3e, 0x77, 0xa7, 0xd0, 0x72, 0x23, 0x72, 0xcd,
+    0xa5, 0x20, 0x74, 0x17, 0x92, 0x2f, 0x67, 0xc1, 0xa6, 0x65, 0xa4, 0xd5, 0x8a, 0xe7, 0x3a, 0x58,
+    0x9e, 0x75, 0x87, 0x25, 0xd7, 0x34, 0xcf, 0xc4, 0x36, 0x6b, 0x23, 0x92, 0xb5, 0x0d, 0xcb, 0x35,
+    0x0a, 0xe7, 0x52, 0xb4, 0x9a, 0xa8, 0x0c, 0x44, 0xc8, 0x35, 0xd9, 0xc5, 0x05, 0xdb, 0xf2, 0x9c,
+    0xdd, 0xf2, 0x3d, 0xab, 0xef, 0xcc, 0xe6, 0xd7, 0xaf, 0x24, 0x5d, 0x9e, 0x59, 0xc5, 0xb8, 0xd5,
+    0x87, 0x9a, 0xc5, 0x3b, 0x5e, 0xe8, 0x15, 0x48, 0x07, 0x69, 0x92, 0x7c, 0x0f, 0x2e, 0xac, 0x0d,
+    0xbf, 0xeb, 0x44, 0xf3, 0x9a, 0x33, 0xa1, 0x3f, 0x9b, 0x4d, 0xb0, 0x71, 0x99, 0x24, 0x5e, 0x70,
+    0xc5, 0x78, 0xb5, 0xd2, 0x20, 0x79, 0x93, 0xe9, 0x55, 0xac, 0xe4, 0x46, 0x14, 0xd4, 0x2a, 0x9f,
+    0x7b, 0x60, 0x23, 0x87, 0x9d, 0x86, 0x7b, 0x99, 0x90, 0xa0, 0xd9, 0x07, 0x9d, 0x90, 0xf7, 0xec,
+    0x8d, 0x98, 0x68, 0xba, 0xd3, 0xb1, 0xf2, 0xe9, 0xdc, 0xa0, 0xa9, 0x4e, 0x90, 0x2b, 0xa6, 0x3f,
+    0x48, 0xa1, 0xd9, 0x5e, 0xd3, 0x60, 0x56, 0x04, 0x80, 0xa2, 0x8a, 0x5b, 0xa6, 0xef, 0x55, 0x26,
+    0xda, 0x52, 0xaa, 0x35, 0x35, 0x8a, 0x11, 0x49, 0xcc, 0x4f, 0x6f, 0x01, 0x92, 0x8a, 0xe9, 0x8d,
+    0x12, 0xe4, 0x0b, 0xa9, 0xae, 0x48, 0x15, 0x59, 0x28, 0x57, 0xf6, 0x11, 0x39, 0xcf, 0x57, 0x1e,
+    0xc1, 0x71, 0x79, 0x76, 0x3c, 0xdd, 0x8b, 0x80, 0x7c, 0xdf, 0x64, 0x7b, 0xba, 0xc5, 0xeb, 0xe0,
+    0x25, 0xa1, 0xdf, 0xd1, 0x2d, 0xf9, 0x09, 0x8c, 0x86, 0xc4, 0x19, 0x4d, 0x3d, 0xd6, 0xc6, 0x27,
+    0xad, 0x91, 0x3b, 0x9a, 0x82, 0x67, 0xb3, 0x28, 0x6b, 0x29, 0x15, 0x35, 0xaf, 0xb5, 0xac, 0xd2,
+    0x04, 0x2c, 0x85, 0xa1, 0x57, 0x59, 0x83, 0xca, 0x96, 0x5c, 0x90, 0xa6, 0x83, 0x48, 0xd7, 0xe4,
+    0xc7, 0x6b, 0x92, 0x92, 0x9f, 0xe1, 0xf7, 0x8a, 0x98, 0xc5, 0x0c, 0x16, 0x33, 0xbf, 0x58, 0xc0,
+    0x62, 0x01, 0x8b, 0x34, 0x09, 0x21, 0x57, 0xcd, 0x00, 0xab, 0x62, 0x85, 0xca, 0x76, 0xbf, 0x89,
+    0x3b, 0xd6, 0xf2, 0x3f, 0x19, 0xcd, 0x57, 0x99, 0x32, 0x2c, 0xaa, 0x19, 0x80, 0x63, 0xa2, 0xe0,
+    0x02, 0xd3, 0x09, 0x37, 0xbd, 0x8b, 0xb3, 0xa2, 0xf8, 0x65, 0x0b, 0x0c, 0xf8, 0xc4, 0x5b, 0xcd,
+    0x04, 0x53, 0x34, 0x50, 0x46, 0x29, 0x88, 0xc8, 0x89, 0xaf, 0x86, 0x81, 0x35, 0xcb, 0xd4, 0x3d,
+    0x5f, 0x33, 0xb9, 0xd1, 0xd4, 0x19, 0x01, 0xf8, 0x27, 0x73, 0x78, 0x05, 0xee, 0x78, 0xa0, 0x49,
+    0x8c, 0xfb, 0x18, 0x11, 0xd1, 0x70, 0x49, 0x8e, 0x11, 0x40, 0xc6, 0xab, 0x38, 0x86, 0x03, 0xcc,
+    0x9f, 0xb8, 0x60, 0x1d, 0xf1, 0x65, 0x83, 0x7b, 0x2d, 0xfa, 0xd5, 0x2b, 0x0e, 0x2c, 0x35, 0xfb,
+    0x1d, 0x05, 0x96, 0x76, 0x17, 0x4b, 0xc1, 0x49, 0xba, 0x9d, 0x22, 0xd3, 0x19, 0x6c, 0x3e, 0x3c,
+    0x62, 0x1a, 0x07, 0x39, 0xc0, 0xe3, 0xd0, 0x4b, 0x59, 0x28, 0xe0, 0x1d, 0x9d, 0xc6, 0x8d, 0x92,
+    0x5a, 0xea, 0x43, 0xc3, 0x90, 0x45, 0xa0, 0x7d, 0x42, 0x8f, 0xe6, 0x3a, 0x0c, 0xce, 0xb6, 0x79,
+    0x40, 0xa5, 0xa0, 0x8f, 0xa1, 0xb5, 0xe5, 0xd8, 0x1c, 0x9e, 0x0c, 0xec, 0x9d, 0x2a, 0xb9, 0xc4,
+    0x7d, 0xa8, 0xf4, 0x5e, 0x74, 0x40, 0xd0, 0x78, 0x11, 0x46, 0x86, 0xe9, 0x65, 0x0c, 0xe4, 0xc4,
+    0xf0, 0x6c, 0x9c, 0x11, 0x29, 0xfc, 0x3b, 0xba, 0xf7, 0xa4, 0x11, 0x9e, 0x67, 0x6b, 0xe0, 0xa5,
+    0x8c, 0xeb, 0xec, 0x89, 0xd5, 0x6d, 0x5c, 0x33, 0x51, 0x21, 0x9b, 0x67, 0x1d, 0xb9, 0x6a, 0x56,
+    0x62, 0x5c, 0xf3, 0x39, 0x54, 0x83, 0x2b, 0x32, 0x64, 0xa5, 0x96, 0x48, 0xd4, 0xd9, 0x2c, 0x22,
+    0x4f, 0x52, 0x6b, 0xb9, 0x36, 0x8b, 0x8e, 0xc3, 0x06, 0xb9, 0xab, 0xd9, 0xa9, 0x35, 0x31, 0xb5,
+    0xea, 0x11, 0x69, 0x56, 0xe6, 0xd0, 0xd5, 0xc9, 0xd4, 0x58, 0x9a, 0x3a, 0x2b, 0x1d, 0xa3, 0xb3,
+    0x3d, 0x08, 0xf9, 0xaa, 0xf1, 0x30, 0xe3, 0xac, 0x69, 0xea, 0x03, 0x15, 0x9b, 0xba, 0x86, 0xa0,
+    0x62, 0x10, 0xcd, 0x33, 0x4d, 0x1f, 0x92, 0xc7, 0x5e, 0x2d, 0xec, 0x07, 0x39, 0xe3, 0x48, 0x21,
+    0x57, 0x13, 0x06, 0xc5, 0x04, 0xb1, 0x9d, 0x13, 0x0e, 0xd5, 0x42, 0x05, 0xb8, 0x4d, 0x91, 0x54,
+    0x5e, 0xf7, 0x30, 0xd0, 0xdd, 0xf6, 0x74, 0x11, 0xe3, 0x04, 0x91, 0x4f, 0xf1, 0xcf, 0xb9, 0x4b,
+    0x1c, 0x17, 0x74, 0x1b, 0x21, 0xd6, 0x10, 0xcc, 0xc1, 0xc3, 0x98, 0xaa, 0x62, 0x43, 0xf6, 0x3b,
+    0x68, 0x71, 0xd4, 0x36, 0x11, 0x97, 0x88, 0xa8, 0x0b, 0xda, 0x34, 0x9d, 0x12, 0xba, 0x90, 0xe9,
+    0xaf, 0x69, 0xb3, 0x27, 0x2d, 0x74, 0x9f, 0x69, 0xcb, 0x14, 0x2f, 0x03, 0x3c, 0xab, 0x81, 0x0a,
+    0x9f, 0x5d, 0xc3, 0x4b, 0x4d, 0x87, 0xd2, 0x4a, 0xfe, 0xc1, 0x7e, 0xc7, 0x46, 0x89, 0x3a, 0xaa,
+    0x7a, 0xca, 0xe8, 0x6c, 0xb1, 0x80, 0x7b, 0xea, 0xfe, 0x24, 0x71, 0x1a, 0x1a, 0xe5, 0x92, 0xd7,
+    0x75, 0x27, 0xf9, 0xaa, 0x2c, 0xad, 0x49, 0xec, 0x78, 0xef, 0x6b, 0x5e, 0x09, 0xa3, 0x8f, 0x28,
+    0x70, 0x6e, 0x48, 0x45, 0x28, 0xd6, 0x35, 0x37, 0x15, 0x0d, 0x0f, 0xe8, 0x0d, 0x73, 0x78, 0x4e,
+    0x26, 0x27, 0xb6, 0x1d, 0x0e, 0xc3, 0x36, 0x7e, 0xa0, 0x78, 0x3b, 0x36, 0x87, 0x73, 0x68, 0x60,
+    0x13, 0xa4, 0x1e, 0xba, 0x78, 0x62, 0x15, 0x17, 0xb7, 0x20, 0x48, 0x4d, 0x80, 0x6b, 0xb9, 0x65,
+    0xf7, 0x92, 0x62, 0xda, 0x23, 0x30, 0x12, 0xfa, 0xc0, 0xdc, 0x9e, 0xb9, 0x8a, 0xee, 0xc0, 0x06,
+    0x68, 0x15, 0x31, 0x80, 0x7b, 0x6c, 0xd0, 0x93, 0x81, 0xa7, 0x58, 0xcb, 0x5b, 0xc5, 0x72, 0xde,
+    0xc2, 0xed, 0xd0, 0x4b, 0xe0, 0xba, 0xa3, 0xd5, 0x1b, 0x34, 0x02, 0xd6, 0xe6, 0xa6, 0x28, 0x47,
+    0x91, 0xe6, 0xd0, 0x9d, 0x98, 0xea, 0xe6, 0x17, 0xdb, 0x32, 0xd5, 0x85, 0x93, 0x33, 0x5e, 0x8f,
+    0x99, 0x0f, 0x9e, 0xde, 0x85, 0x2f, 0x26, 0x86, 0x8c, 0x24, 0x71, 0x73, 0x72, 0x6d, 0x2d, 0x86,
+    0xa4, 0x87, 0xda, 0xcb, 0x3d, 0xf0, 0xc7, 0x88, 0xec, 0x81, 0x82, 0x51, 0x9f, 0xed, 0x6f, 0xc2,
+    0x67, 0xb7, 0x81, 0x71, 0x04, 0x83, 0xc0, 0x65, 0xbc, 0x11, 0x5c, 0x63, 0xa3, 0x08, 0x02, 0x1b,
+    0x27, 0xf4, 0x3d, 0x2c, 0x49, 0x33, 0x3a, 0x0a, 0x87, 0xc0, 0xcf, 0x8e, 0xbf, 0xcf, 0xfd, 0x9e,
+    0x26, 0xe0, 0xfd, 0x40, 0x0b, 0x53, 0x23, 0xa3, 0xb0, 0x52, 0x1b, 0x56, 0x71, 0x8a, 0x07, 0x6f,
+    0xbd, 0xbb, 0x23, 0x8b, 0x1c, 0x75, 0xb9, 0xd1, 0x1d, 0x93, 0x50, 0x42, 0xfd, 0xd5, 0x52, 0x8d,
+    0xe9, 0x3a, 0x1b, 0xdf, 0x66, 0x67, 0xce, 0x3b, 0x32, 0x55, 0x17, 0x75, 0x25, 0x35, 0x14, 0x4a,
+    0xc6, 0x27, 0x79, 0x2d, 0x5b, 0x76, 0x0a, 0xac, 0x4f, 0x6e, 0x69, 0x56, 0x7e, 0xd7, 0x75, 0xd1,
+    0xae, 0x7e, 0x7f, 0xcd, 0x36, 0x95, 0x9f, 0x09, 0xff, 0x32, 0x0a, 0xb6, 0x59, 0xbd, 0x61, 0x76,
+    0xa6, 0x99, 0xb5, 0xed, 0x3e, 0xa9, 0x5f, 0x9a, 0x38, 0x4d, 0x31, 0xbd, 0x9d, 0xbd, 0x9d, 0x33,
+    0x16, 0x7c, 0xe3, 0x7c, 0x30, 0x08, 0xfe, 0x61, 0x40, 0x18, 0xb7, 0xa6, 0x7f, 0x44, 0xc4, 0xf8,
+    0xf0, 0x1f, 0x07, 0x0e, 0xcf, 0xb5, 0xeb, 0xda, 0x76, 0xf9, 0xfa, 0xb5, 0xed, 0x8a, 0x7e, 0x17,
+    0x17, 0xb0, 0xe7, 0xc0, 0xf9, 0x5d, 0x67, 0xc7, 0x13, 0x63, 0x10, 0x9e, 0x79, 0x0e, 0x42, 0xc4,
+    0x9e, 0x35, 0x8c, 0xd1, 0xdd, 0xe9, 0x78, 0x36, 0x8d, 0x43, 0xf9, 0x5f, 0xc3, 0xc9, 0x17, 0xa3,
+    0xea, 0x26, 0x10, 0x34, 0x52, 0x3f, 0x2d, 0x2e, 0xc8, 0xac, 0xd7, 0x28, 0x81, 0x2b, 0x30, 0x77,
+    0xf2, 0x7d, 0x6f, 0x9c, 0x18, 0x81, 0xfc, 0x30, 0x9c, 0x21, 0xdd, 0xe4, 0x69, 0xe1, 0x73, 0x81,
+    0xf5, 0x27, 0x9b, 0xff, 0x80, 0x42, 0x1f, 0xbd, 0x6c, 0x5c, 0x74, 0x49, 0x84, 0xca, 0x0a, 0xc3,
+    0x6f, 0x6f, 0xdb, 0x7d, 0xae, 0x2b, 0xe8, 0x4d, 0x49, 0x7c, 0xf9, 0x42, 0xfd, 0x65, 0x2a, 0xa7,
+    0x39, 0x5e, 0xeb, 0x21, 0x72, 0x52, 0xef, 0x16, 0x0e, 0xc8, 0xed, 0x47, 0x68, 0xd8, 0x7e, 0x84,
+    0xdc, 0x7e, 0x7c, 0xa1, 0xb2, 0x82, 0x57, 0x49, 0x91, 0xfe, 0x90, 0xce, 0x82, 0x61, 0x29, 0x21,
+    0x33, 0x6c, 0x78, 0xf8, 0xe1, 0x08, 0xf9, 0xfe, 0xaf, 0x5e, 0xdd, 0x0b, 0x1c, 0xd0, 0x14, 0x0a,
+    0xcc, 0xd8, 0x7a, 0xa9, 0xb2, 0x4f, 0x84, 0x18, 0x02, 0x38, 0x22, 0x13, 0x76, 0xf1, 0x0d, 0x17,
+    0xfc, 0x03, 0x7e, 0x95, 0x81, 0x28, 0x7c, 0x15, 0x42, 0x3e, 0xae, 0x7a, 0x44, 0x78, 0xfe, 0x11,
+    0xe6, 0x67, 0xa8, 0x60, 0xbb, 0x97, 0xbf, 0xd3, 0xf0, 0xb3, 0xee, 0xac, 0x42, 0x86, 0x3d, 0x37,
+    0x34, 0xd2, 0x1f, 0x14, 0x35, 0xe8, 0x21, 0xa2, 0x63, 0x08, 0xff, 0x59, 0x88, 0x42, 0xee, 0xc2,
+    0xe5, 0x5f, 0xbc, 0xab, 0x22, 0xad, 0x26, 0x0d, 0x00, 0x00,
+};
+
+static const size_t DASHBOARD_WORKER_GZ_LEN = 493;
+static const uint8_t DASHBOARD_WORKER_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x9d, 0x53, 0x4d, 0x6f, 0xd4, 0x30,
+    0x10, 0xbd, 0xe7, 0x57, 0x98, 0x4b, 0xe3, 0x48, 0xc5, 0x5d, 0xb4, 0x02, 0x0e, 0xcb, 0x1e, 0xaa,
+    0x6a, 0x45, 0x0f, 0x2b, 0x81, 0x80, 0xaa, 0x07, 0xc4, 0xc1, 0x38, 0x93, 0xc6, 0xac, 0x63, 0x07,
+    0x7b, 0xd2, 0x05, 0xd1, 0xfe, 0x77, 0x26, 0x76, 0x92, 0x66, 0x59, 0x2a, 0x3e, 0x2e, 0x89, 0x27,
+    0x33, 0x6f, 0xde, 0x9b, 0xe7, 0x49, 0xde, 0x05, 0x60, 0x01, 0xbd, 0x56, 0x98, 0xaf, 0x32, 0xe5,
+    0x6c, 0x40, 0x76, 0x71, 0x7e, 0x71, 0xb9, 0x61, 0x6b, 0x96, 0x7b, 0x59, 0x06, 0x25, 0xed, 0xd3,
+    0x17, 0x8b, 0x67, 0xe5, 0xf3, 0x72, 0xb9, 0x98, 0x2a, 0xde, 0x5f, 0x6e, 0xb6, 0x5b, 0xaa, 0xf8,
+    0x98, 0x9f, 0xe5, 0xa7, 0x2c, 0x3f, 0x53, 0xb5, 0xf4, 0x18, 0xc4, 0x12, 0x54, 0xf5, 0x72, 0x59,
+    0x29, 0xf1, 0x25, 0xc4, 0xcf, 0x8d, 0xb4, 0xba, 0x82, 0x80, 0x62, 0x0f, 0x9f, 0xc7, 0x73, 0xfe,
+    0x69, 0x95, 0x05, 0x30, 0x95, 0x90, 0x65, 0xb9, 0xb9, 0x05, 0x8b, 0x5b, 0x1d, 0x10, 0x2c, 0x78,
+    0x9e, 0x6b, 0x6a, 0x2d, 0x8d, 0x21, 0x68, 0xd5, 0x59, 0x85, 0xda, 0x59, 0xc6, 0xa1, 0x2f, 0x29,
+    0xd8, 0x8f, 0x2c, 0x1e, 0xc4, 0x5e, 0x6a, 0xbc, 0xb2, 0xa8, 0x0d, 0x57, 0x52, 0xd5, 0x10, 0x84,
+    0x6b, 0xc1, 0xf2, 0x28, 0xb8, 0x10, 0x58, 0xd3, 0xf9, 0x01, 0x1a, 0x2b, 0x7a, 0xa8, 0x07, 0xec,
+    0xbc, 0x65, 0x31, 0xee, 0x69, 0xcf, 0x8d, 0xe1, 0x71, 0x82, 0x62, 0x95, 0xdd, 0x1f, 0xc1, 0x66,
+    0x88, 0xa8, 0x33, 0xec, 0x74, 0x7b, 0x4d, 0xb4, 0xda, 0xde, 0xf0, 0x08, 0x88, 0x8f, 0x47, 0x87,
+    0x90, 0xd4, 0xe6, 0x56, 0x22, 0xfc, 0xd3, 0x14, 0x3b, 0xf8, 0x1e, 0xf8, 0x91, 0x12, 0x2b, 0x1b,
+    0x08, 0x33, 0x39, 0x6f, 0xbd, 0x6b, 0x74, 0xa0, 0x11, 0x48, 0x7f, 0xcc, 0x89, 0x4a, 0x1b, 0x24,
+    0xd2, 0x43, 0xc8, 0x0c, 0xd1, 0x87, 0x42, 0xdb, 0x12, 0xbe, 0xbd, 0xa9, 0xf8, 0x74, 0x9d, 0x79,
+    0xc1, 0xd6, 0xeb, 0x35, 0x5b, 0xb0, 0x93, 0x93, 0x58, 0xc1, 0x9e, 0x50, 0x14, 0x3d, 0x8c, 0x7e,
+    0x34, 0xb2, 0x7d, 0xbc, 0xe3, 0x20, 0xb8, 0x04, 0x03, 0x08, 0x29, 0x39, 0x79, 0xf2, 0x27, 0x27,
+    0x95, 0xd1, 0x34, 0x7d, 0xa0, 0xb7, 0xd4, 0xcd, 0xdf, 0x78, 0x59, 0x01, 0xaa, 0xfa, 0xf7, 0x46,
+    0xa6, 0x3d, 0xf4, 0xf0, 0xb5, 0xa3, 0x9d, 0xa2, 0x4d, 0x4c, 0xc6, 0x0e, 0xf1, 0x2a, 0xd3, 0x15,
+    0xe3, 0x43, 0x20, 0x1a, 0xc0, 0xda, 0x95, 0x71, 0xc8, 0xfc, 0xf5, 0xe6, 0x03, 0x4d, 0x9f, 0x44,
+    0x8d, 0xcb, 0xdc, 0x79, 0x43, 0x0d, 0x2c, 0xec, 0xd9, 0xd5, 0xbb, 0xed, 0x84, 0xa2, 0xaf, 0x45,
+    0xea, 0x43, 0x27, 0xe1, 0xbc, 0xbe, 0xd1, 0x36, 0xf6, 0x88, 0x5a, 0x8d, 0x53, 0xb2, 0x57, 0x34,
+    0x26, 0xee, 0xee, 0xd2, 0x3f, 0x31, 0x99, 0xdd, 0x83, 0x5a, 0x89, 0x75, 0xb2, 0xef, 0x15, 0x5b,
+    0x3c, 0xb0, 0x8e, 0x52, 0x43, 0xeb, 0x6c, 0x79, 0xad, 0xb1, 0xfe, 0xef, 0x5d, 0x6e, 0x24, 0xf9,
+    0x73, 0x48, 0xf5, 0x2b, 0xb0, 0xd6, 0x38, 0x83, 0x51, 0xd4, 0x4b, 0x8d, 0xbe, 0x8e, 0x93, 0x1e,
+    0x41, 0x92, 0xb2, 0x10, 0xe9, 0x92, 0x8f, 0x29, 0x16, 0x6e, 0x57, 0x0c, 0xc4, 0x6d, 0x87, 0x07,
+    0xb4, 0xa7, 0x6c, 0x2a, 0x52, 0xc6, 0x59, 0xe0, 0xfd, 0xc5, 0x0e, 0x9c, 0x63, 0x26, 0xdd, 0xf4,
+    0xfd, 0xec, 0xda, 0x7f, 0x02, 0x7e, 0xa4, 0xec, 0x74, 0x7c, 0x04, 0x00, 0x00,
+};
+
+static const size_t DASHBOARD_MANIFEST_GZ_LEN = 356;
+static const uint8_t DASHBOARD_MANIFEST_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x55, 0x91, 0xcf, 0x6e, 0xc2, 0x30,
+    0x0c, 0xc6, 0xef, 0x3c, 0x45, 0xd4, 0xa9, 0xca, 0x61, 0x40, 0xff, 0x69, 0xc0, 0x90, 0x7a, 0xd8,
+    0x80, 0x17, 0xd8, 0x8e, 0xd3, 0x34, 0x99, 0x24, 0xb4, 0xd1, 0xd2, 0x04, 0xa5, 0x81, 0xd2, 0x21,
+    0xde, 0x7d, 0x4e, 0x83, 0xb4, 0xee, 0xd0, 0xd4, 0xf6, 0xf7, 0xb3, 0x63, 0x7d, 0xb9, 0x4e, 0x08,
+    0x89, 0x34, 0x34, 0x22, 0x5a, 0x93, 0xe8, 0x0d, 0xb8, 0x04, 0x27, 0x8d, 0x26, 0x5b, 0xe1, 0x04,
+    0x73, 0xc6, 0x92, 0x2d, 0xb4, 0xf5, 0xde, 0x80, 0xe5, 0xd1, 0xd4, 0x93, 0x6d, 0x6d, 0xac, 0xfb,
+    0x1a, 0xf1, 0xef, 0x0c, 0xf4, 0x5d, 0x72, 0x80, 0xd2, 0xc9, 0x2a, 0xaf, 0x24, 0xf7, 0x1a, 0x33,
+    0x47, 0x31, 0xca, 0xb9, 0x6c, 0x8f, 0x0a, 0x7a, 0x5f, 0x41, 0x5c, 0x73, 0x50, 0x46, 0x8b, 0x20,
+    0xed, 0x81, 0x7d, 0x57, 0xd6, 0x9c, 0x34, 0xff, 0x62, 0x46, 0x19, 0xeb, 0x99, 0x87, 0xf4, 0x90,
+    0x15, 0xd9, 0x32, 0x00, 0xae, 0x16, 0x8d, 0x18, 0x69, 0xf9, 0x22, 0x87, 0x62, 0x11, 0x34, 0xc9,
+    0x8c, 0x6e, 0xb1, 0xfa, 0x81, 0x09, 0x21, 0xd7, 0xe1, 0xf4, 0xd7, 0x5b, 0xe6, 0x51, 0x0e, 0x0e,
+    0xd6, 0xb2, 0x81, 0x4a, 0x24, 0xed, 0xb9, 0x7a, 0xbc, 0x34, 0x6a, 0x1a, 0x17, 0x1b, 0x0c, 0x09,
+    0x86, 0xba, 0x2d, 0x69, 0xed, 0xdc, 0x71, 0x9d, 0x24, 0x5d, 0xd7, 0xcd, 0xbb, 0x62, 0x6e, 0x6c,
+    0x95, 0xe4, 0x69, 0x9a, 0x7a, 0x98, 0x92, 0xb3, 0x14, 0xdd, 0xab, 0xb9, 0x94, 0x34, 0x25, 0x29,
+    0xc9, 0xd2, 0xe1, 0xa3, 0x71, 0xb1, 0xc3, 0x09, 0x16, 0x2d, 0x22, 0x9d, 0xe4, 0xae, 0x2e, 0xa9,
+    0xaf, 0x92, 0x5a, 0xc8, 0xaa, 0x76, 0xf7, 0xc4, 0x62, 0x4f, 0xb6, 0xa2, 0xe4, 0x20, 0x95, 0x2a,
+    0x69, 0x9c, 0x17, 0x61, 0x61, 0x9a, 0x84, 0x66, 0x27, 0x2e, 0x8e, 0x20, 0xf2, 0x84, 0x68, 0x5f,
+    0xd2, 0x25, 0xfe, 0x0e, 0x46, 0xbb, 0x59, 0x2b, 0x7f, 0x44, 0x49, 0x17, 0x98, 0x7a, 0x62, 0x06,
+    0x9a, 0xa1, 0xe5, 0x25, 0x6d, 0x24, 0xe7, 0x4a, 0x8c, 0xa6, 0x6d, 0x57, 0x9b, 0x2c, 0xdf, 0x0c,
+    0x9b, 0xec, 0xf2, 0xf8, 0x79, 0x15, 0xbf, 0xe4, 0x38, 0x35, 0xf1, 0x4d, 0xe1, 0x02, 0xbf, 0x3e,
+    0x46, 0x83, 0x41, 0xc1, 0x0d, 0x9c, 0xec, 0x4d, 0x8a, 0x40, 0xf7, 0x7f, 0x55, 0xd7, 0x87, 0x17,
+    0xfa, 0xe7, 0x4f, 0x34, 0xa8, 0x37, 0x3c, 0x3f, 0x27, 0xb7, 0xc9, 0x2f, 0xcc, 0x48, 0x52, 0xe4,
+    0x24, 0x02, 0x00, 0x00,
+};
+
+#endif // DASHBOARD_PAGE_H
@@ -0,0 +1,38 @@
+#ifndef DEAD_TIME_H
+#define DEAD_TIME_H
+
+// Non-paralyzable dead-time model for GM tubes.
+// After each registered pulse the tube is blind for tau seconds. With a measured
+// rate m the true rate is n = m / (1 - m * tau). This header has no Arduino
+// dependencies so the rate math can be compiled and checked on the host.
+
+// Upper bound on the dead-time fraction m * tau. Close to 1 the correction
+// diverges, so the result is clamped to the rate reached at this fraction.
+static const float DEAD_TIME_MAX_FRACTION = 0.95f;
+
+/**
+ * @brief Applies the non-paralyzable correction to a measured count rate.
+ *
+ * @param measuredCps  Measured rate in counts per second
+ * @param deadTimeSec  Tube dead time (tau) in seconds; <= 0 disables correction
+ * @return float       Estimated true rate in counts per second
+ */
+inline float correctDeadTimeCps(float measuredCps, float deadTimeSec) {
+    if (deadTimeSec <= 0.0f || measuredCps <= 0.0f) {
+        return measuredCps;
+    }
+    float fraction = measuredCps * deadTimeSec;
+    if (fraction > DEAD_TIME_MAX_FRACTION) {
+        fraction = DEAD_TIME_MAX_FRACTION;
+    }
+    return measuredCps / (1.0f - fraction);
+}
+
+/**
+ * @brief Convenience wrapper working in counts per minute.
+ */
+inline float correctDeadTimeCpm(float measuredCpm, float deadTimeSec) {
+    return correctDeadTimeCps(measuredCpm * (1.0f / 60.0f), deadTimeSec) * 60.0f;
+}
+
+#endif // DEAD_TIME_H
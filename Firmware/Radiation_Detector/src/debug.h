@@ -0,0 +1,51 @@
+#ifndef DEBUG_H
+#define DEBUG_H
+
+#include <Arduino.h>
+#include <atomic>
+#include "config.h"
+#include "debug_log.h"
+
+// Debug configuration
+// Uncomment the line below to enable debug output at compile time
+#define DEBUG
+
+// Runtime debug flag - can be toggled via serial command (defined in Radiation-Detector.cpp).
+// Atomic: uiTask sets it while every other task tests it.
+extern std::atomic<bool> debugEnabled;
+
+#if defined(DEBUG) && DEBUG_LOG_ASYNC
+    // Queued with the time of the call and written out by the debug log task
+    // (debug_log.h); the call returns without waiting for the UART.
+    #define DEBUG_PRINT(x) do { if (debugEnabled) { DebugLogLine line_; line_.print(x); line_.commit(false); } } while(0)
+    #define DEBUG_PRINTLN(x) do { if (debugEnabled) { DebugLogLine line_; line_.print(x); line_.commit(true); } } while(0)
+    #define DEBUG_PRINTF(...) do { if (debugEnabled) { debugLogPrintf(__VA_ARGS__); } } while(0)
+#elif defined(DEBUG)
+    #define DEBUG_TIMESTAMP() do { \
+        if (debugEnabled) { \
+            unsigned long ms = millis(); \
+            unsigned int seconds = ms / 1000; \
+            unsigned int minutes = seconds / 60; \
+            unsigned int hours = minutes / 60; \
+            unsigned int days = hours / 24; \
+            seconds %= 60; \
+            minutes %= 60; \
+            hours %= 24; \
+            char timestamp[20]; \
+            snprintf(timestamp, sizeof(timestamp), "[%d:%02d:%02d.%03d] ", \
+                    (int)days * 24 + (int)hours, (int)minutes, (int)seconds, (int)(ms % 1000)); \
+            Serial.print(timestamp); \
+        } \
+    } while(0)
+    
+    #define DEBUG_PRINT(x) do { if (debugEnabled) { DEBUG_TIMESTAMP(); Serial.print(x); } } while(0)
+    #define DEBUG_PRINTLN(x) do { if (debugEnabled) { DEBUG_TIMESTAMP(); Serial.println(x); } } while(0)
+    #define DEBUG_PRINTF(...) do { if (debugEnabled) { DEBUG_TIMESTAMP(); Serial.printf(__VA_ARGS__); } } while(0)
+#else
+    #define DEBUG_TIMESTAMP()
+    #define DEBUG_PRINT(x)
+    #define DEBUG_PRINTLN(x)
+    #define DEBUG_PRINTF(...)
+#endif
+
+#endif // DEBUG_H
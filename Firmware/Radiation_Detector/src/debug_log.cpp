@@ -0,0 +1,217 @@
+/**
+ * @file debug_log.cpp
+ * @brief Lock-free ring of debug messages, written out by a low-priority task.
+ *
+ * The ring is a bounded multi-producer queue after D. Vyukov: each slot
+ * carries a sequence number that says whose turn it is. A producer claims
+ * position p with a compare-and-swap on the enqueue position once slot p's
+ * sequence is p, fills it and publishes it by setting the sequence to p + 1;
+ * the drain task takes it when it sees p + 1 and hands it back for the next
+ * lap with p + DEBUG_LOG_SLOTS. A producer that finds its slot a lap behind
+ * drops the message. A producer preempted between claim and publish only
+ * holds up the drain, never another producer.
+ */
+
+#include "debug_log.h"
+#include <atomic>
+#include <stdarg.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+static_assert((DEBUG_LOG_SLOTS & (DEBUG_LOG_SLOTS - 1)) == 0, "DEBUG_LOG_SLOTS must be a power of two");
+
+static const uint32_t SLOT_MASK = DEBUG_LOG_SLOTS - 1;
+static const uint32_t TASK_STACK = 4096;
+static const uint32_t IDLE_POLL_MS = 10;
+
+struct Slot {
+    // The sequence minus the slot's index, so the zero-initialised ring is
+    // already empty before any constructor or init call has run
+    std::atomic<uint32_t> turn;
+    uint32_t position;
+    uint32_t ms;
+    uint16_t length;
+    bool newline;
+    char text[DEBUG_LOG_LINE_CHARS];
+};
+
+static Slot ring[DEBUG_LOG_SLOTS];
+static std::atomic<uint32_t> enqueuePos(0);
+static std::atomic<uint32_t> dequeuePos(0);
+static std::atomic<bool> draining(false); ///< One consumer at a time
+static TaskHandle_t taskHandle = nullptr;
+
+static std::atomic<uint32_t> messages(0);
+static std::atomic<uint32_t> dropped(0);
+static std::atomic<uint32_t> truncated(0);
+static std::atomic<uint16_t> highWater(0);
+
+// Consumer only
+static uint32_t reportedDropped = 0;
+static DebugLogSink sinkWrite = nullptr;
+static DebugLogSinkIdle sinkIdle = nullptr;
+
+/**
+ * @brief Claims the next free slot. @return nullptr if the ring is full
+ */
+static Slot* claim() {
+    uint32_t pos = enqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = ring[pos & SLOT_MASK];
+        int32_t diff = (int32_t)(slot.turn.load(std::memory_order_acquire) + (pos & SLOT_MASK) - pos);
+        if (diff == 0) {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                slot.position = pos;
+                slot.ms = millis();
+                uint16_t used = (uint16_t)(pos + 1 - dequeuePos.load(std::memory_order_relaxed));
+                if (used > highWater.load(std::memory_order_relaxed)) highWater.store(used, std::memory_order_relaxed);
+                return &slot;
+            }
+        } else if (diff < 0) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        } else {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+static void publish(Slot* slot) {
+    messages.fetch_add(1, std::memory_order_relaxed);
+    slot->turn.store(slot->position + 1 - (slot->position & SLOT_MASK), std::memory_order_release);
+}
+
+bool debugLogPrintf(const char* format, ...) {
+    Slot* slot = claim();
+    if (!slot) return false;
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(slot->text, sizeof(slot->text), format, args);
+    va_end(args);
+    if (n < 0) n = 0;
+    if (n >= (int)sizeof(slot->text)) {
+        n = sizeof(slot->text) - 1;
+        truncated.fetch_add(1, std::memory_order_relaxed);
+    }
+    slot->length = (uint16_t)n;
+    slot->newline = false;
+    publish(slot);
+    return true;
+}
+
+DebugLogLine::DebugLogLine() : slot(claim()), length(0), cut(false) {}
+
+size_t DebugLogLine::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t DebugLogLine::write(const uint8_t* buffer, size_t size) {
+    Slot* s = (Slot*)slot;
+    if (!s) return size;
+    size_t room = sizeof(s->text) - 1 - length;
+    if (size > room) {
+        cut = true;
+        size = room;
+    }
+    memcpy(s->text + length, buffer, size);
+    length += size;
+    return size;
+}
+
+void DebugLogLine::commit(bool newline) {
+    Slot* s = (Slot*)slot;
+    if (!s) return;
+    if (cut) truncated.fetch_add(1, std::memory_order_relaxed);
+    s->text[length] = '\0';
+    s->length = length;
+    s->newline = newline;
+    publish(s);
+    slot = nullptr;
+}
+
+static void writeOut(const Slot& slot) {
+    uint32_t ms = slot.ms;
+    uint32_t seconds = ms / 1000;
+    char timestamp[20];
+    snprintf(timestamp, sizeof(timestamp), "[%lu:%02u:%02u.%03u] ", (unsigned long)(seconds / 3600),
+             (unsigned)(seconds / 60 % 60), (unsigned)(seconds % 60), (unsigned)(ms % 1000));
+    Serial.print(timestamp);
+    Serial.write((const uint8_t*)slot.text, slot.length);
+    if (slot.newline) Serial.println();
+    if (sinkWrite) sinkWrite(slot.ms, slot.text, slot.length);
+}
+
+/**
+ * @brief Writes out the next published message. @return false if there is none yet
+ */
+static bool drainOne() {
+    uint32_t pos = dequeuePos.load(std::memory_order_relaxed);
+    Slot& slot = ring[pos & SLOT_MASK];
+    if (slot.turn.load(std::memory_order_acquire) + (pos & SLOT_MASK) != pos + 1) return false;
+    writeOut(slot);
+    slot.turn.store(pos + DEBUG_LOG_SLOTS - (pos & SLOT_MASK), std::memory_order_release);
+    dequeuePos.store(pos + 1, std::memory_order_release);
+
+    uint32_t lost = dropped.load(std::memory_order_relaxed);
+    if (lost != reportedDropped) {
+        Serial.printf("[log] %lu messages dropped (ring full)\n", (unsigned long)(lost - reportedDropped));
+        reportedDropped = lost;
+    }
+    return true;
+}
+
+static void drainAll() {
+    bool expected = false;
+    if (!draining.compare_exchange_strong(expected, true, std::memory_order_acquire)) return;
+    while (drainOne()) {
+    }
+    draining.store(false, std::memory_order_release);
+}
+
+static void debugLogTask(void* parameter) {
+    for (;;) {
+        drainAll();
+        if (sinkIdle) sinkIdle(millis());
+        vTaskDelay(pdMS_TO_TICKS(IDLE_POLL_MS));
+    }
+}
+
+void initDebugLog() {
+    if (taskHandle) return;
+    xTaskCreatePinnedToCore(debugLogTask, "debugLog", TASK_STACK, nullptr, tskIDLE_PRIORITY + 1, &taskHandle,
+                            TASK_CORE_NETWORK);
+}
+
+void debugLogSetSink(DebugLogSink write, DebugLogSinkIdle idle) {
+    sinkWrite = write;
+    sinkIdle = idle;
+}
+
+bool debugLogFlush(uint32_t timeoutMs) {
+    uint32_t start = millis();
+    for (;;) {
+        if (!taskHandle) drainAll();
+        if (dequeuePos.load(std::memory_order_acquire) == enqueuePos.load(std::memory_order_relaxed)) break;
+        if (millis() - start >= timeoutMs) break;
+        vTaskDelay(pdMS_TO_TICKS(IDLE_POLL_MS));
+    }
+    Serial.flush();
+    return dequeuePos.load(std::memory_order_acquire) == enqueuePos.load(std::memory_order_relaxed);
+}
+
+DebugLogStats getDebugLogStats() {
+    DebugLogStats s;
+    s.running = taskHandle != nullptr;
+    s.messages = messages.load(std::memory_order_relaxed);
+    s.dropped = dropped.load(std::memory_order_relaxed);
+    s.truncated = truncated.load(std::memory_order_relaxed);
+    s.highWater = highWater.load(std::memory_order_relaxed);
+    return s;
+}
+
+void printDebugLog(Print& out) {
+    DebugLogStats s = getDebugLogStats();
+    out.printf("Debug log: %s, %lu messages, %lu dropped, %lu cut, ring high-water %u/%u slots\n",
+               s.running ? "async" : "not started", (unsigned long)s.messages, (unsigned long)s.dropped,
+               (unsigned long)s.truncated, (unsigned)s.highWater, (unsigned)DEBUG_LOG_SLOTS);
+}
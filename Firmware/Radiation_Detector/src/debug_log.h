@@ -0,0 +1,65 @@
+#ifndef DEBUG_LOG_H
+#define DEBUG_LOG_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Asynchronous backend of the DEBUG_PRINT* macros (debug.h). A log call
+// claims a slot of a fixed ring with one compare-and-swap, formats straight
+// into it and returns; it never takes a lock and never waits for the UART.
+// When the ring is full the message is dropped and counted. A task at idle+1
+// on TASK_CORE_NETWORK drains the ring in order to Serial, prefixing the
+// timestamp taken at the call, and hands each message to an optional sink
+// (syslog_sink.h). Messages longer than DEBUG_LOG_LINE_CHARS are
+// cut. Messages logged before initDebugLog() wait in the ring. Task context
+// only (not from ISRs); anything still in the ring is lost on a crash, so
+// reboot paths call debugLogFlush() first.
+
+struct DebugLogStats {
+    bool running;              ///< Drain task started
+    uint32_t messages;         ///< Queued since boot
+    uint32_t dropped;          ///< Ring full
+    uint32_t truncated;        ///< Cut to DEBUG_LOG_LINE_CHARS
+    uint16_t highWater;        ///< Most slots in use at once
+};
+
+// Second destination of every message, called on the debug log task after
+// Serial: @p ms is the time of the call, @p text is not terminated by a
+// newline for DEBUG_PRINTLN. The idle hook runs on the same task every
+// pass (about every 10 ms), for sinks that batch.
+typedef void (*DebugLogSink)(uint32_t ms, const char* text, size_t length);
+typedef void (*DebugLogSinkIdle)(uint32_t nowMs);
+
+// Starts the drain task. Call once Serial is up.
+void initDebugLog();
+
+// Queues one message (timestamped at the call). @return false if dropped
+bool debugLogPrintf(const char* format, ...) __attribute__((format(printf, 1, 2)));
+
+// One message built with Print calls: DEBUG_PRINT / DEBUG_PRINTLN. Claims a
+// slot on construction; the text goes out once commit() publishes it.
+class DebugLogLine : public Print {
+public:
+    DebugLogLine();
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    void commit(bool newline);
+
+private:
+    void* slot;
+    uint16_t length;
+    bool cut;
+};
+
+// Installs the sink; nullptr removes it.
+void debugLogSetSink(DebugLogSink write, DebugLogSinkIdle idle);
+
+// Waits up to @p timeoutMs until the ring is written out, then flushes
+// Serial. Without the drain task, drains from the calling task.
+// @return true if nothing is left
+bool debugLogFlush(uint32_t timeoutMs);
+
+DebugLogStats getDebugLogStats();
+void printDebugLog(Print& out);
+
+#endif // DEBUG_LOG_H
@@ -0,0 +1,150 @@
+/**
+ * @file device_config.cpp
+ * @brief Device configuration snapshot on top of the settings store.
+ *
+ * The configuration is read from the settings cache once, migrated and
+ * validated, and published through a SeqLock. Writers take a mutex, so the
+ * SeqLock only ever sees one publisher at a time and the settings cache receives
+ * the fields in the order they were published.
+ */
+
+#include "device_config.h"
+#include "tube_profile.h"
+#include "settings_store.h"
+#include "seqlock.h"
+#include "debug.h"
+#include <math.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+static SeqLock<DeviceConfig> configLock;
+static SemaphoreHandle_t writeMutex = nullptr;
+
+static int32_t clampInt(int32_t value, int32_t low, int32_t high) {
+    return value < low ? low : (value > high ? high : value);
+}
+
+/**
+ * @brief Brings @p config into the valid ranges and derives the reciprocals.
+ *        Non-finite floats fall back to the defaults (the tube profile's).
+ */
+static void sanitize(DeviceConfig& config) {
+    config.currentAlarmX10 = clampInt(config.currentAlarmX10, 0, ALARM_THRESHOLD_MAX_X10);
+    config.cumulativeAlarmX10 = clampInt(config.cumulativeAlarmX10, 0, ALARM_THRESHOLD_MAX_X10);
+
+    if (!isfinite(config.cpmPerUsvH) || config.cpmPerUsvH <= 0.0f) config.cpmPerUsvH = CONVERSION_FACTOR_DEFAULT;
+    if (config.cpmPerUsvH < CONVERSION_FACTOR_MIN) config.cpmPerUsvH = CONVERSION_FACTOR_MIN;
+    if (config.cpmPerUsvH > CONVERSION_FACTOR_MAX) config.cpmPerUsvH = CONVERSION_FACTOR_MAX;
+
+    if (!isfinite(config.deadTimeUs) || config.deadTimeUs < 0.0f) config.deadTimeUs = DEAD_TIME_DEFAULT_US;
+    if (config.deadTimeUs >= DEAD_TIME_MAX_US) config.deadTimeUs = DEAD_TIME_DEFAULT_US;
+
+    if (config.displayTimeoutMs < DISPLAY_TIMEOUT_MIN_MS) config.displayTimeoutMs = DISPLAY_TIMEOUT_MIN_MS;
+    if (config.displayTimeoutMs > DISPLAY_TIMEOUT_MAX_MS) config.displayTimeoutMs = DISPLAY_TIMEOUT_MAX_MS;
+
+    if (!isfinite(config.hvTargetV)) config.hvTargetV = HV_TARGET_DEFAULT_V;
+    if (config.hvTargetV < HV_MIN_V) config.hvTargetV = HV_MIN_V;
+    if (config.hvTargetV > HV_MAX_V) config.hvTargetV = HV_MAX_V;
+
+    config.usvHPerCpm = 1.0f / config.cpmPerUsvH;
+    config.deadTimeSec = config.deadTimeUs * 1e-6f;
+}
+
+/**
+ * @brief Upgrades values written by an older layout, one version at a time.
+ * @return true if anything was migrated (the new version must be stored)
+ */
+static bool migrate(DeviceConfig& config) {
+    if (config.version >= DEVICE_CONFIG_VERSION) return false;
+    DEBUG_PRINTF("Config: migrating from version %ld\n", (long)config.version);
+    switch (config.version) {
+        case 0:
+            // Earlier firmware kept the same units but no version key and did not
+            // range-check the dead time; the conversion factor and the display
+            // timeout did not exist and were read as their defaults. sanitize()
+            // after the migration repairs any out-of-range value.
+            // fall through
+        default:
+            break;
+    }
+    config.version = DEVICE_CONFIG_VERSION;
+    return true;
+}
+
+/**
+ * @brief Writes the fields of @p config that differ from the cache (a no-op for equal ones).
+ */
+static void store(const DeviceConfig& config) {
+    settingSetInt(SETTING_CURRENT_ALARM, config.currentAlarmX10);
+    settingSetInt(SETTING_CUMULATIVE_ALARM, config.cumulativeAlarmX10);
+    settingSetBool(SETTING_ALARM_ENABLED, config.alarmEnabled);
+    settingSetBool(SETTING_ON_STARTUP, config.wifiAutoConnect);
+    settingSetBool(SETTING_CLICKS, config.clicksEnabled);
+    settingSetFloat(SETTING_CONVERSION_FACTOR, config.cpmPerUsvH);
+    settingSetFloat(SETTING_DEAD_TIME_US, config.deadTimeUs);
+    settingSetInt(SETTING_DISPLAY_TIMEOUT, (int32_t)config.displayTimeoutMs);
+    settingSetFloat(SETTING_HV_TARGET, config.hvTargetV);
+    settingSetInt(SETTING_CONFIG_VERSION, config.version);
+}
+
+bool initDeviceConfig() {
+    if (writeMutex) return true;
+
+    DeviceConfig config;
+    config.version = settingGetInt(SETTING_CONFIG_VERSION);
+    config.currentAlarmX10 = settingGetInt(SETTING_CURRENT_ALARM);
+    config.cumulativeAlarmX10 = settingGetInt(SETTING_CUMULATIVE_ALARM);
+    config.alarmEnabled = settingGetBool(SETTING_ALARM_ENABLED);
+    config.wifiAutoConnect = settingGetBool(SETTING_ON_STARTUP);
+    config.clicksEnabled = settingGetBool(SETTING_CLICKS);
+    config.cpmPerUsvH = settingGetFloat(SETTING_CONVERSION_FACTOR);
+    config.deadTimeUs = settingGetFloat(SETTING_DEAD_TIME_US);
+    config.displayTimeoutMs = (uint32_t)settingGetInt(SETTING_DISPLAY_TIMEOUT);
+    config.hvTargetV = settingGetFloat(SETTING_HV_TARGET);
+
+    bool migrated = migrate(config);
+    sanitize(config);
+    if (migrated) store(config);
+    configLock.publish(config);
+
+    writeMutex = xSemaphoreCreateMutex();
+    return writeMutex != nullptr;
+}
+
+DeviceConfig getDeviceConfig() {
+    DeviceConfig config;
+    // A publish is a short struct copy; retry rather than hand out a zeroed config
+    while (!configLock.read(config)) {
+    }
+    return config;
+}
+
+void setDeviceConfig(const DeviceConfig& config) {
+    DeviceConfig next = config;
+    next.version = DEVICE_CONFIG_VERSION;
+    sanitize(next);
+
+    if (writeMutex) xSemaphoreTake(writeMutex, portMAX_DELAY);
+    configLock.publish(next);
+    store(next);
+    if (writeMutex) xSemaphoreGive(writeMutex);
+}
+
+uint32_t deviceConfigRevision() {
+    return configLock.version();
+}
+
+void printDeviceConfig(Print& out) {
+    DeviceConfig config = getDeviceConfig();
+    out.printf("Config version: %ld (revision %lu)\n", (long)config.version, (unsigned long)deviceConfigRevision());
+    out.printf("Alarms: %s, %.1f uSv/h, %.1f mSv\n", config.alarmEnabled ? "ENABLED" : "DISABLED",
+               config.currentAlarmUsvH(), config.cumulativeAlarmMsv());
+    out.printf("Tube: %s (defaults %.1f CPM per uSv/h, %.0f us, %.0f V)\n", ActiveTube::NAME,
+               (float)CONVERSION_FACTOR_DEFAULT, (float)DEAD_TIME_DEFAULT_US, (float)HV_TARGET_DEFAULT_V);
+    out.printf("Conversion: %.2f CPM per uSv/h\n", config.cpmPerUsvH);
+    out.printf("Dead time: %.1f us\n", config.deadTimeUs);
+    out.printf("WiFi auto-connect: %s\n", config.wifiAutoConnect ? "ON" : "OFF");
+    out.printf("Clicks: %s\n", config.clicksEnabled ? "ON" : "OFF");
+    out.printf("Display timeout: %lu s\n", (unsigned long)(config.displayTimeoutMs / 1000));
+    out.printf("HV target: %.1f V\n", config.hvTargetV);
+}
@@ -0,0 +1,64 @@
+#ifndef DEVICE_CONFIG_H
+#define DEVICE_CONFIG_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Typed device configuration, loaded from the settings store once at boot.
+// The whole struct is published through a SeqLock, so any task reads a
+// consistent copy without locks or NVS access; the alarm check, the labels and
+// the dose maths read it instead of the LVGL widgets. The widgets only reflect
+// the configuration: their handlers write it back with setDeviceConfig().
+//
+// DEVICE_CONFIG_VERSION is stored with the values. Values written by an older
+// layout are migrated step by step by initDeviceConfig() before publishing.
+
+static const int32_t DEVICE_CONFIG_VERSION = 1;
+
+static const int32_t ALARM_THRESHOLD_MAX_X10 = 9999; ///< Spinbox range "xxx.x"
+static const float DEAD_TIME_MAX_US = 10000.0f;      ///< Exclusive
+static const float CONVERSION_FACTOR_MIN = 0.01f;
+static const float CONVERSION_FACTOR_MAX = 100000.0f;
+static const uint32_t DISPLAY_TIMEOUT_MIN_MS = 10000;
+static const uint32_t DISPLAY_TIMEOUT_MAX_MS = 86400000;
+
+struct DeviceConfig {
+    int32_t version;
+    int32_t currentAlarmX10;    ///< Dose-rate alarm threshold, µSv/h x10 (spinbox units)
+    int32_t cumulativeAlarmX10; ///< Cumulative dose alarm threshold, mSv x10
+    bool alarmEnabled;
+    bool wifiAutoConnect;       ///< Connect with the stored credentials at boot
+    bool clicksEnabled;         ///< Audible Geiger clicks on the buzzer
+    float cpmPerUsvH;           ///< Tube sensitivity: CPM per µSv/h
+    float deadTimeUs;           ///< Tube dead time (tau) for the rate correction
+    uint32_t displayTimeoutMs;  ///< Idle time before the display dims
+    float hvTargetV;            ///< Tube operating voltage (hv_control.h)
+
+    // Derived whenever the configuration is published, not stored: the
+    // per-sample dose maths multiplies by these instead of dividing
+    float usvHPerCpm;           ///< 1 / cpmPerUsvH
+    float deadTimeSec;          ///< deadTimeUs in seconds
+
+    float currentAlarmUsvH() const { return currentAlarmX10 / 10.0f; }
+    float cumulativeAlarmMsv() const { return cumulativeAlarmX10 / 10.0f; }
+};
+
+// Reads the settings store (initSettingsStore() first), migrates and publishes.
+bool initDeviceConfig();
+
+// Consistent copy of the current configuration. Any task, lock-free.
+DeviceConfig getDeviceConfig();
+
+// Clamps @p config to valid ranges, publishes it and queues the changed fields
+// for NVS. Callers copy getDeviceConfig(), edit fields and write it back; the
+// LVGL handlers and serial commands that do so all run on uiTask, so those
+// read-modify-write sequences never interleave. Readers never wait.
+void setDeviceConfig(const DeviceConfig& config);
+
+// Incremented by every setDeviceConfig(): lets the UI refresh its widgets only
+// when the configuration changed.
+uint32_t deviceConfigRevision();
+
+void printDeviceConfig(Print& out);
+
+#endif // DEVICE_CONFIG_H
@@ -0,0 +1,218 @@
+/**
+ * @file digit_sprites.cpp
+ * @brief Pre-rendered glyph masks for a few-character label.
+ *
+ * lv_draw_letter() resolves the glyph (character map, glyph cache), fetches
+ * its bitmap (decompressing it for compressed fonts), unpacks the 1 to 8-bit
+ * pixels through an opacity table into a mask buffer and then blends the
+ * mask, for every glyph on every draw. The unpacked masks only depend on the
+ * font, so they are built once here and blended directly.
+ *
+ * The draw hook runs as a preprocess DRAW_MAIN handler: it draws the label's
+ * base (background, border) through the class chain exactly as the label
+ * would, places the glyphs with lv_draw_label()'s arithmetic and stops the
+ * event, so the label's own text drawing is skipped. When the sprites cannot
+ * reproduce the text exactly it returns early and the label draws normally.
+ */
+
+#include "config.h"
+
+#if !HEADLESS
+
+#include "digit_sprites.h"
+#include <src/draw/sw/lv_draw_sw.h> // lv_draw_sw_blend(), not exported by lvgl.h
+#include "esp_heap_caps.h"
+#include <string.h>
+
+extern "C" const uint8_t _lv_bpp1_opa_table[2];
+extern "C" const uint8_t _lv_bpp2_opa_table[4];
+extern "C" const uint8_t _lv_bpp4_opa_table[16];
+extern "C" const uint8_t _lv_bpp8_opa_table[256];
+
+static bool enabled = true;
+
+struct Sprite {
+    uint32_t offset;  ///< First mask byte in DigitSprites::masks
+    int16_t advance;  ///< Pen advance in pixels
+    int16_t x, y;     ///< Box position relative to the pen on the top of the line
+    uint16_t w, h;    ///< Box size; 0 for blank glyphs (space)
+};
+
+struct DigitSprites {
+    const lv_font_t* font;
+    int8_t slot[128]; ///< Sprite index per ASCII character, -1 if not cached
+    Sprite sprites[DIGIT_SPRITES_MAX_GLYPHS];
+    lv_opa_t* masks;  ///< Row-major coverage masks of all sprites
+};
+
+static const uint8_t* opaTable(uint8_t bpp) {
+    switch (bpp) {
+    case 1: return _lv_bpp1_opa_table;
+    case 2: return _lv_bpp2_opa_table;
+    case 4: return _lv_bpp4_opa_table;
+    case 8: return _lv_bpp8_opa_table;
+    default: return nullptr;
+    }
+}
+
+/**
+ * @brief Expands a glyph bitmap (rows of box_w pixels, not byte aligned) to
+ *        one coverage byte per pixel, as draw_letter_normal() does per draw.
+ */
+static void expandGlyph(const uint8_t* bitmap, uint8_t bpp, uint32_t pixels, lv_opa_t* out) {
+    const uint8_t* table = opaTable(bpp);
+    uint8_t mask = (1 << bpp) - 1;
+    for (uint32_t i = 0; i < pixels; i++) {
+        uint32_t bit = i * bpp;
+        out[i] = table[(bitmap[bit >> 3] >> (8 - (bit & 7) - bpp)) & mask];
+    }
+}
+
+/**
+ * @return the line width of @p text in pixels, or -1 if a character has no sprite
+ */
+static int32_t lineWidth(const DigitSprites* s, const char* text, lv_coord_t letterSpace) {
+    int32_t width = 0;
+    for (const char* p = text; *p; p++) {
+        uint8_t c = (uint8_t)*p;
+        if (c >= 128 || s->slot[c] < 0) return -1;
+        int16_t advance = s->sprites[s->slot[c]].advance;
+        if (advance > 0) width += advance + letterSpace;
+    }
+    if (width > 0) width -= letterSpace; // As lv_txt_get_width(): no space after the last letter
+    return width;
+}
+
+static void drawCb(lv_event_t* e) {
+    if (!enabled) return;
+    const DigitSprites* s = (const DigitSprites*)lv_event_get_user_data(e);
+    lv_obj_t* obj = lv_event_get_target(e);
+    lv_label_t* label = (lv_label_t*)obj;
+    lv_draw_ctx_t* drawCtx = lv_event_get_draw_ctx(e);
+
+    if (label->recolor || label->long_mode == LV_LABEL_LONG_SCROLL ||
+        label->long_mode == LV_LABEL_LONG_SCROLL_CIRCULAR ||
+        lv_label_get_text_selection_start(obj) != LV_DRAW_LABEL_NO_TXT_SEL) {
+        return;
+    }
+    lv_draw_label_dsc_t dsc;
+    lv_draw_label_dsc_init(&dsc);
+    lv_obj_init_draw_label_dsc(obj, LV_PART_MAIN, &dsc);
+    if (dsc.opa < LV_OPA_MAX || dsc.font != s->font || dsc.decor != LV_TEXT_DECOR_NONE) return;
+
+    lv_area_t coords;
+    lv_obj_get_content_coords(obj, &coords);
+    const char* text = lv_label_get_text(obj);
+    int32_t width = lineWidth(s, text, dsc.letter_space);
+    if (width < 0 || width > lv_area_get_width(&coords)) return; // Wrapping or other characters
+    if (lv_draw_mask_is_any(&obj->coords)) return;
+
+    // From here on the label's draw is replaced: base first, as lv_label_event() does
+    if (lv_obj_event_base(&lv_label_class, e) != LV_RES_OK) return;
+    lv_event_stop_processing(e);
+
+    lv_area_t clip;
+    if (!_lv_area_intersect(&clip, &coords, drawCtx->clip_area)) return;
+
+    lv_point_t pen = {(lv_coord_t)(coords.x1 + label->offset.x), (lv_coord_t)(coords.y1 + label->offset.y)};
+    lv_text_align_t align = lv_obj_calculate_style_text_align(obj, LV_PART_MAIN, text);
+    if (align == LV_TEXT_ALIGN_CENTER) {
+        pen.x += (lv_area_get_width(&coords) - width) / 2;
+    } else if (align == LV_TEXT_ALIGN_RIGHT) {
+        pen.x += lv_area_get_width(&coords) - width;
+    }
+
+    lv_draw_sw_blend_dsc_t blend;
+    lv_memset_00(&blend, sizeof(blend));
+    blend.color = dsc.color;
+    blend.opa = dsc.opa;
+    blend.blend_mode = dsc.blend_mode;
+    blend.mask_res = LV_DRAW_MASK_RES_CHANGED;
+    for (const char* p = text; *p; p++) {
+        const Sprite& sprite = s->sprites[s->slot[(uint8_t)*p]];
+        if (sprite.w) {
+            lv_area_t box;
+            box.x1 = pen.x + sprite.x;
+            box.y1 = pen.y + sprite.y;
+            box.x2 = box.x1 + sprite.w - 1;
+            box.y2 = box.y1 + sprite.h - 1;
+            blend.blend_area = &box;
+            blend.mask_area = &box;
+            blend.mask_buf = s->masks + sprite.offset;
+            lv_draw_sw_blend(drawCtx, &blend);
+        }
+        if (sprite.advance > 0) pen.x += sprite.advance + dsc.letter_space;
+    }
+}
+
+static void deleteCb(lv_event_t* e) {
+    heap_caps_free(lv_event_get_user_data(e));
+}
+
+bool digitSpritesAttach(lv_obj_t* label, const char* glyphs) {
+    const lv_font_t* font = lv_obj_get_style_text_font(label, LV_PART_MAIN);
+    size_t count = strlen(glyphs);
+    if (!font || font->subpx != LV_FONT_SUBPX_NONE || count > DIGIT_SPRITES_MAX_GLYPHS) return false;
+
+    // Sizes first, so that the sprites and their masks fit one allocation
+    lv_font_glyph_dsc_t g[DIGIT_SPRITES_MAX_GLYPHS];
+    uint32_t maskBytes = 0;
+    for (size_t i = 0; i < count; i++) {
+        if ((uint8_t)glyphs[i] >= 128) return false;
+        if (!lv_font_get_glyph_dsc(font, &g[i], (uint8_t)glyphs[i], 0) || g[i].resolved_font != font) return false;
+        if (g[i].box_w && !opaTable(g[i].bpp)) return false;
+        // Every pair has to advance by the plain width, i.e. no kerning between cached glyphs
+        for (size_t j = 0; j < count; j++) {
+            if (lv_font_get_glyph_width(font, (uint8_t)glyphs[i], (uint8_t)glyphs[j]) != g[i].adv_w) return false;
+        }
+        maskBytes += (uint32_t)g[i].box_w * g[i].box_h;
+    }
+
+    // Internal RAM: the masks are read for every pixel of every glyph drawn
+    size_t bytes = sizeof(DigitSprites) + maskBytes;
+    DigitSprites* s = (DigitSprites*)heap_caps_malloc(bytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (!s) s = (DigitSprites*)heap_caps_malloc(bytes, MALLOC_CAP_8BIT);
+    if (!s) return false;
+    s->font = font;
+    s->masks = (lv_opa_t*)(s + 1);
+    memset(s->slot, -1, sizeof(s->slot));
+
+    lv_coord_t top = font->line_height - font->base_line;
+    uint32_t offset = 0;
+    for (size_t i = 0; i < count; i++) {
+        Sprite& sprite = s->sprites[i];
+        sprite.offset = offset;
+        sprite.advance = g[i].adv_w;
+        sprite.w = g[i].box_h ? g[i].box_w : 0;
+        sprite.h = g[i].box_w ? g[i].box_h : 0;
+        sprite.x = g[i].ofs_x;
+        sprite.y = top - g[i].box_h - g[i].ofs_y;
+        if (sprite.w) {
+            // Compressed fonts decompress into a shared buffer: expand it right away
+            const uint8_t* bitmap = lv_font_get_glyph_bitmap(font, (uint8_t)glyphs[i]);
+            if (!bitmap) {
+                heap_caps_free(s);
+                return false;
+            }
+            expandGlyph(bitmap, g[i].bpp, (uint32_t)sprite.w * sprite.h, s->masks + offset);
+            offset += (uint32_t)sprite.w * sprite.h;
+        }
+        s->slot[(uint8_t)glyphs[i]] = (int8_t)i;
+    }
+
+    lv_obj_add_event_cb(label, drawCb, (lv_event_code_t)(LV_EVENT_DRAW_MAIN | LV_EVENT_PREPROCESS), s);
+    lv_obj_add_event_cb(label, deleteCb, LV_EVENT_DELETE, s);
+    lv_obj_invalidate(label);
+    return true;
+}
+
+void digitSpritesSetEnabled(bool on) {
+    enabled = on;
+    lv_obj_invalidate(lv_scr_act());
+}
+
+bool digitSpritesEnabled() {
+    return enabled;
+}
+
+#endif // !HEADLESS
@@ -0,0 +1,26 @@
+#ifndef DIGIT_SPRITES_H
+#define DIGIT_SPRITES_H
+
+#include <lvgl.h>
+
+// Pre-rendered glyphs for a label that only ever shows a few characters (the
+// large dose-rate readout). The glyphs of the label's font are expanded once
+// into 8-bit coverage masks; the label's draw then blends those masks at the
+// pen positions instead of looking up, decompressing and unpacking every
+// glyph bitmap per frame. Anything the sprites cannot reproduce exactly (other
+// characters, a changed font, masks, partial opacity, selections, scrolling)
+// falls back to the label's own drawing. LVGL task only.
+
+#define DIGIT_SPRITES_MAX_GLYPHS 16
+
+// Renders @p glyphs (ASCII, at most DIGIT_SPRITES_MAX_GLYPHS) in the label's
+// current font. The sprites are freed with the label.
+// @return false if the font cannot be cached (kerning, unsupported bpp, no memory)
+bool digitSpritesAttach(lv_obj_t* label, const char* glyphs);
+
+// Draws every attached label through LVGL's glyph path while disabled (for comparisons).
+void digitSpritesSetEnabled(bool enabled);
+
+bool digitSpritesEnabled();
+
+#endif // DIGIT_SPRITES_H
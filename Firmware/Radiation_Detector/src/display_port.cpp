@@ -0,0 +1,595 @@
+/**
+ * @file display_port.cpp
+ * @brief LVGL display and touch driver on one shared TFT_eSPI instance.
+ *
+ * LVGL renders into two DMA-capable stripes of 1/10 screen each. The flush
+ * queues a stripe, address window included, behind the one in flight
+ * (pushImageDMAQueued) and only then waits for that previous stripe, whose
+ * buffer LVGL draws into next; the bus goes from one stripe to the next
+ * without waiting for the CPU.
+ * The panel write transaction stays open between the stripes of one refresh
+ * and is closed after its last stripe. While it is open the UI task holds the
+ * bus, so a task that takes the bus for the SD card never finds it open: the
+ * transaction holds the HAL's SPI lock, which only its owner may give back.
+ *
+ * Touch reads from LVGL do not close it: each read queues the next set of
+ * XPT2046 conversions on the DMA bus (TFT_eSPI::startTouchAsync()), where it
+ * runs after the stripe in flight, and uses the set queued by the previous read.
+ *
+ * In direct mode LVGL renders into a full-screen framebuffer in PSRAM, each
+ * invalidated area once, at its place on the screen. LVGL 8 passes the whole
+ * screen to every flush of a direct-mode frame, so nothing is sent until the
+ * last one; then the frame's invalidated areas are copied, byte-swapped, into
+ * the two stripe buffers in turn (the SPI DMA cannot read PSRAM) and queued
+ * like stripes. The stripe buffers serve as these bounce buffers, so direct
+ * mode needs no internal RAM of its own.
+ */
+
+#include "config.h"
+
+#if !HEADLESS
+
+#include "display_port.h"
+#include "spi_bus.h"
+#include "debug.h"
+#include "config.h"
+#include "blend_rgb565.h"
+#include "render_split.h"
+#include "ui_wake.h"
+#include "latency_probe.h"
+#include "esp_heap_caps.h"
+#include "driver/gpio.h"
+
+static const uint32_t DRAW_BUF_PIXELS = DISPLAY_WIDTH * DISPLAY_HEIGHT / 10;
+static const uint16_t TOUCH_PRESSURE_THRESHOLD = 600;
+static const uint16_t TOUCH_HOLD_THRESHOLD = 20;   ///< While pressed, as TFT_eSPI::getTouch()
+static const uint8_t TOUCH_SAMPLES = TOUCH_ASYNC_SAMPLES; ///< Raw positions per read, median taken
+static const uint16_t TOUCH_MAX_SPREAD = 40;       ///< Raw interquartile range of a steady touch
+static const uint8_t TOUCH_RELEASE_READS = 2;      ///< Reads without pressure before a release
+
+static TFT_eSPI tft(DISPLAY_WIDTH, DISPLAY_HEIGHT);
+static lv_disp_draw_buf_t drawBuf;
+static lv_disp_drv_t dispDrv;
+static lv_indev_drv_t indevDrv;
+static lv_color_t* drawBuf1 = nullptr;
+static lv_color_t* drawBuf2 = nullptr;
+static lv_color_t* frameBuf = nullptr;  ///< Direct mode: the whole screen, in PSRAM
+static bool directMode = false;
+static bool dmaEnabled = false;  ///< DMA initialised on the panel
+static bool touchAsync = false;  ///< Touch conversions queued behind the display DMA
+static bool touchQueued = false; ///< A conversion set is queued or running (touchAsync)
+static bool writeOpen = false;   ///< Panel holds an open write transaction, and uiTask a level of the bus
+static bool panelAsleep = false; ///< Controller in sleep mode (displayPortSleep())
+static volatile bool touchSuppressed = false; ///< Report released until the finger lifts
+static volatile bool touchSampling = false;   ///< Conversions toggle T_IRQ: ignore it meanwhile
+static bool touchHeld = false;                ///< Debounced state reported to LVGL
+static uint8_t touchMissedReads = 0;
+static lv_point_t touchPoint;
+static volatile DisplayFlushHook flushHook = nullptr;
+
+enum TouchSample {
+    TOUCH_NONE,      ///< No pressure
+    TOUCH_UNSTABLE,  ///< Pressure, but the positions scatter (finger landing or lifting)
+    TOUCH_VALID
+};
+
+// ST7796 commands for the panel's sleep mode (GRAM is retained)
+static const uint8_t ST7796_SLPIN  = 0x10;
+static const uint8_t ST7796_SLPOUT = 0x11;
+static const uint8_t ST7796_DISPOFF = 0x28;
+static const uint8_t ST7796_DISPON = 0x29;
+static const uint32_t ST7796_SLPOUT_DELAY_MS = 120;
+
+/**
+ * @brief Opens the panel write transaction, taking a level of the bus that
+ *        closePanelWrite() gives back. uiTask only.
+ */
+static void openPanelWrite() {
+    if (writeOpen) return;
+    spiBusAcquire(SPI_BUS_DISPLAY);
+    tft.startWrite();
+    writeOpen = true;
+}
+
+/**
+ * @brief Closes the panel transaction on the task that opened it.
+ */
+static void closePanelWrite() {
+    if (!writeOpen) return;
+    tft.endWrite(); // Waits for DMA completion before deasserting CS
+    writeOpen = false;
+    spiBusRelease();
+}
+
+/**
+ * @brief SPI bus release hook: waits for a queued touch conversion set and
+ *        closes the panel transaction so touch or SD can use the bus.
+ *
+ * Another task only gets here once uiTask has let go of the bus, so with the
+ * transaction closed; an open one is only closed for uiTask's own touch reads.
+ */
+static void releaseDisplayBus() {
+    tft.waitTouchAsync(); // A queued touch conversion set uses the bus too
+    closePanelWrite();
+}
+
+/**
+ * @brief Sends one stripe of LVGL pixels (or a test frame) to the panel.
+ */
+static void pushStripe(const lv_area_t* area, lv_color_t* color_p, bool last) {
+    uint32_t w = (area->x2 - area->x1 + 1);
+    uint32_t h = (area->y2 - area->y1 + 1);
+    DisplayFlushHook hook = flushHook;
+    if (hook) hook(area->x1, area->y1, w, h, (const uint16_t*)&color_p->full, false);
+
+    openPanelWrite();
+    if (dmaEnabled) {
+        // Queued behind the previous stripe; LVGL renders into that one's buffer next
+        tft.pushImageDMAQueued(area->x1, area->y1, w, h, (uint16_t*)&color_p->full);
+        latencyProbeFlush(area);
+        tft.dmaWaitQueued(drawBuf2 ? 1 : 0); // Single buffer: wait for this stripe as well
+    } else {
+        tft.setAddrWindow(area->x1, area->y1, w, h);
+        tft.pushColors((uint16_t*)&color_p->full, w * h, true);
+        latencyProbeFlush(area);
+    }
+    if (last) closePanelWrite(); // The bus is free for the SD card until the next refresh
+}
+
+/**
+ * @brief Direct mode: sends the areas LVGL redrew in the framebuffer, through
+ *        the stripe buffers in turn.
+ */
+static void pushDirtyAreas(lv_disp_t* disp) {
+    const uint16_t* frame = (const uint16_t*)frameBuf;
+    uint8_t next = 0;
+    for (uint16_t i = 0; i < disp->inv_p; i++) {
+        if (disp->inv_area_joined[i]) continue;
+        const lv_area_t& area = disp->inv_areas[i];
+        uint32_t w = area.x2 - area.x1 + 1;
+        uint32_t rowsPerChunk = DRAW_BUF_PIXELS / w;
+        for (int32_t y = area.y1; y <= area.y2; y += rowsPerChunk) {
+            uint32_t rows = area.y2 - y + 1 < (int32_t)rowsPerChunk ? area.y2 - y + 1 : rowsPerChunk;
+            uint16_t* bounce = (uint16_t*)(next && drawBuf2 ? drawBuf2 : drawBuf1);
+            next ^= 1;
+            uint16_t* out = bounce;
+            for (uint32_t r = 0; r < rows; r++) {
+                const uint16_t* in = frame + (y + r) * DISPLAY_WIDTH + area.x1;
+                for (uint32_t x = 0; x < w; x++) *out++ = (uint16_t)(in[x] << 8 | in[x] >> 8);
+            }
+            DisplayFlushHook hook = flushHook;
+            if (hook) hook(area.x1, y, w, rows, bounce, true);
+
+            openPanelWrite();
+            // Queued behind the previous chunk, whose buffer is filled next
+            tft.pushImageDMAQueued(area.x1, y, w, rows, (const uint16_t*)bounce);
+            lv_area_t chunk = {area.x1, (lv_coord_t)y, area.x2, (lv_coord_t)(y + rows - 1)};
+            latencyProbeFlush(&chunk);
+            tft.dmaWaitQueued(drawBuf2 ? 1 : 0);
+        }
+    }
+    closePanelWrite();
+}
+
+static void flushCb(lv_disp_drv_t* drv, const lv_area_t* area, lv_color_t* color_p) {
+    if (!directMode) {
+        pushStripe(area, color_p, lv_disp_flush_is_last(drv));
+    } else if (lv_disp_flush_is_last(drv)) {
+        pushDirtyAreas(_lv_refr_get_disp_refreshing()); // The area is always the whole screen here
+    }
+    // With two buffers LVGL renders the next stripe into the other one while DMA runs
+    lv_disp_flush_ready(drv);
+}
+
+/**
+ * @brief T_IRQ falling edge: a finger came down, wake the UI task.
+ *
+ * Registered with the GPIO ISR service directly rather than attachInterrupt():
+ * the service is allocated in IRAM for pulse capture, so it also runs while
+ * a flash write has the cache off, and Arduino's dispatcher in between lives
+ * in flash.
+ */
+static void IRAM_ATTR touchIrqIsr(void* arg) {
+    if (!touchSampling) uiWakeNotifyFromIsr(UI_WAKE_TOUCH);
+}
+
+static uint16_t median(uint16_t* v, uint8_t n, uint16_t* spread) {
+    for (uint8_t i = 1; i < n; i++) {
+        uint16_t key = v[i];
+        int8_t j = i - 1;
+        for (; j >= 0 && v[j] > key; j--) v[j + 1] = v[j];
+        v[j + 1] = key;
+    }
+    *spread = v[n * 3 / 4] - v[n / 4];
+    return v[n / 2];
+}
+
+/**
+ * @brief Converts the per-axis median of TOUCH_SAMPLES raw positions, rejecting
+ *        a set whose positions scatter.
+ */
+static TouchSample filterTouch(uint16_t* rawX, uint16_t* rawY, uint16_t* x, uint16_t* y) {
+    uint16_t spreadX, spreadY;
+    uint16_t a = median(rawX, TOUCH_SAMPLES, &spreadX);
+    uint16_t b = median(rawY, TOUCH_SAMPLES, &spreadY);
+    if (spreadX > TOUCH_MAX_SPREAD || spreadY > TOUCH_MAX_SPREAD) return TOUCH_UNSTABLE;
+    tft.convertRawXY(&a, &b);
+    if (a >= tft.width() || b >= tft.height()) return TOUCH_UNSTABLE;
+    // The touch axes are swapped relative to the panel in rotation 1
+    *x = b;
+    *y = a;
+    return TOUCH_VALID;
+}
+
+/**
+ * @brief Takes TOUCH_SAMPLES raw positions between two pressure checks and
+ *        converts their per-axis median. Replaces TFT_eSPI::getTouch(), which
+ *        keeps only its last valid sample and waits 5 ms or more per sample.
+ *        Blocking: waits for the display DMA first.
+ */
+static TouchSample sampleTouch(uint16_t* x, uint16_t* y, uint16_t threshold) {
+    uint16_t rawX[TOUCH_SAMPLES], rawY[TOUCH_SAMPLES];
+    spiBusAcquire(SPI_BUS_TOUCH);
+    touchSampling = true;
+    bool pressed = tft.getTouchRawZ() > threshold;
+    if (pressed) {
+        for (uint8_t i = 0; i < TOUCH_SAMPLES; i++) tft.getTouchRaw(&rawX[i], &rawY[i]);
+        pressed = tft.getTouchRawZ() > threshold; // Still down: the samples are not from a lifting finger
+    }
+    touchSampling = false;
+    spiBusRelease();
+    if (!pressed) return TOUCH_NONE;
+    return filterTouch(rawX, rawY, x, y);
+}
+
+/**
+ * @brief Non-blocking read: evaluates the conversion set that completed since
+ *        the last call.
+ * @return false if none did (still behind a DMA stripe, or none queued)
+ */
+static bool sampleTouchAsync(TouchSample* sample, uint16_t* x, uint16_t* y, uint16_t threshold) {
+    TFT_eSPI::TouchRawSet set;
+    spiBusAcquire(SPI_BUS_DISPLAY);
+    bool fresh = tft.getTouchAsync(&set);
+    spiBusRelease();
+    if (!fresh) return false;
+    touchQueued = false;
+
+    // Still down after the positions: they are not from a lifting finger
+    if (set.z1 <= threshold || set.z2 <= threshold) {
+        *sample = TOUCH_NONE;
+    } else {
+        *sample = filterTouch(set.x, set.y, x, y);
+    }
+    return true;
+}
+
+/**
+ * @brief Queues the next conversion set; returns at once.
+ */
+static void queueTouchAsync() {
+    // As the display: the SPI driver runs the set after the stripe in flight
+    spiBusAcquire(SPI_BUS_DISPLAY);
+    touchQueued = tft.startTouchAsync();
+    spiBusRelease();
+    touchSampling = touchQueued; // T_IRQ follows the conversions until the set is collected
+}
+
+static void touchReadCb(lv_indev_drv_t* drv, lv_indev_data_t* data) {
+    uint16_t x, y;
+    uint16_t threshold = touchHeld ? TOUCH_HOLD_THRESHOLD : TOUCH_PRESSURE_THRESHOLD;
+    TouchSample sample = TOUCH_UNSTABLE;
+    bool fresh = false;
+    if (touchAsync) {
+        fresh = sampleTouchAsync(&sample, &x, &y, threshold);
+    } else {
+        sample = sampleTouch(&x, &y, threshold);
+    }
+    if (sample == TOUCH_VALID) {
+        touchHeld = true;
+        touchMissedReads = 0;
+        touchPoint.x = x;
+        touchPoint.y = y;
+    } else if (sample == TOUCH_NONE && touchHeld && ++touchMissedReads >= TOUCH_RELEASE_READS) {
+        touchHeld = false;
+    }
+    // An unstable sample keeps the previous state and point
+
+    bool touched = touchHeld;
+    if (touched && touchSuppressed) touched = false; // The waking touch is not a click
+    else if (!touched) touchSuppressed = false;
+
+    data->point = touchPoint;
+    data->state = touched ? LV_INDEV_STATE_PR : LV_INDEV_STATE_REL;
+
+    // The next set for the next read: while held, without T_IRQ, and after a
+    // wake until a set has answered. A set that found no touch ends the reads.
+    if (touchAsync && !touchQueued && (touchHeld || TOUCH_IRQ_PIN < 0 || !fresh)) queueTouchAsync();
+
+    // Released: no more reads until T_IRQ reports the next touch
+    if (!touchHeld && !touchQueued && TOUCH_IRQ_PIN >= 0) {
+        lv_timer_pause(drv->read_timer);
+        if (digitalRead(TOUCH_IRQ_PIN) == LOW) lv_timer_resume(drv->read_timer); // Touched meanwhile
+    }
+}
+
+void displayPortBegin() {
+    spiBusAcquire(SPI_BUS_DISPLAY);
+    tft.begin();
+    tft.setRotation(1);
+    uint16_t calData[5] = {267, 3646, 198, 3669, 6};
+    tft.setTouch(calData);
+    tft.setSwapBytes(true); // LVGL renders native RGB565, the panel expects big-endian
+    dmaEnabled = tft.initDMA();
+    touchAsync = dmaEnabled && tft.initTouchAsync();
+    spiBusRelease();
+
+    spiBusSetDisplayReleaseHook(releaseDisplayBus);
+    if (TOUCH_IRQ_PIN >= 0) {
+        pinMode(TOUCH_IRQ_PIN, INPUT_PULLUP); // Open drain on the XPT2046
+        gpio_set_intr_type((gpio_num_t)TOUCH_IRQ_PIN, GPIO_INTR_NEGEDGE);
+        esp_err_t err = gpio_install_isr_service(ESP_INTR_FLAG_IRAM); // Pulse capture may have installed it
+        if (err == ESP_OK || err == ESP_ERR_INVALID_STATE) {
+            gpio_isr_handler_add((gpio_num_t)TOUCH_IRQ_PIN, touchIrqIsr, nullptr);
+            gpio_intr_enable((gpio_num_t)TOUCH_IRQ_PIN);
+        }
+    }
+    DEBUG_PRINTF("TFT initialized (DMA %s, touch %s).\n", dmaEnabled ? "on" : "off",
+                 touchAsync ? "queued" : "blocking");
+}
+
+bool displayPortRegister() {
+    // Internal DMA-capable RAM; the SPI DMA cannot read the draw buffers from PSRAM
+    size_t bufBytes = DRAW_BUF_PIXELS * sizeof(lv_color_t);
+    drawBuf1 = (lv_color_t*)heap_caps_malloc(bufBytes, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    drawBuf2 = (lv_color_t*)heap_caps_malloc(bufBytes, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    if (!drawBuf1) {
+        DEBUG_PRINTLN("ERROR: Draw buffer allocation failed");
+        return false;
+    }
+    if (!drawBuf2) {
+        DEBUG_PRINTLN("WARNING: Second draw buffer unavailable, flushing single-buffered");
+    }
+    lv_disp_draw_buf_init(&drawBuf, drawBuf1, drawBuf2, DRAW_BUF_PIXELS);
+
+    lv_disp_drv_init(&dispDrv);
+    dispDrv.hor_res = DISPLAY_WIDTH;
+    dispDrv.ver_res = DISPLAY_HEIGHT;
+    dispDrv.flush_cb = flushCb;
+    dispDrv.draw_buf = &drawBuf;
+#if RGB565_FAST_BLEND
+    blend565Install(&dispDrv);
+#endif
+    renderSplitInstall(&dispDrv); // Wraps whichever blend is installed
+    lv_disp_drv_register(&dispDrv);
+
+    lv_indev_drv_init(&indevDrv);
+    indevDrv.type = LV_INDEV_TYPE_POINTER;
+    indevDrv.read_cb = touchReadCb;
+    lv_indev_drv_register(&indevDrv);
+
+    if (DISPLAY_DIRECT_MODE && !displayPortSetDirect(true)) {
+        DEBUG_PRINTLN("WARNING: No PSRAM framebuffer or DMA, rendering in stripes");
+    }
+    return true;
+}
+
+bool displayPortSetDirect(bool direct) {
+    if (direct == directMode) return true;
+    if (direct) {
+        if (!dmaEnabled || !drawBuf1) return false;
+        if (!frameBuf) {
+            frameBuf = (lv_color_t*)heap_caps_malloc(DISPLAY_WIDTH * DISPLAY_HEIGHT * sizeof(lv_color_t),
+                                                     MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+            if (!frameBuf) return false;
+        }
+    }
+    displayPortFlushWait(); // The stripe buffers may still be the source of a transfer
+    if (direct) lv_disp_draw_buf_init(&drawBuf, frameBuf, nullptr, DISPLAY_WIDTH * DISPLAY_HEIGHT);
+    else lv_disp_draw_buf_init(&drawBuf, drawBuf1, drawBuf2, DRAW_BUF_PIXELS);
+    dispDrv.direct_mode = direct;
+    directMode = direct;
+
+    // The framebuffer holds nothing yet, and the stripes nothing of the last frame
+    lv_disp_t* disp = lv_disp_get_default();
+    if (disp) lv_obj_invalidate(lv_disp_get_scr_act(disp));
+    return true;
+}
+
+bool displayPortDirect() {
+    return directMode;
+}
+
+/**
+ * @brief Average and best time of @p frames redraws of @p area, flush included.
+ */
+static void benchRedraws(lv_obj_t* screen, const lv_area_t* area, uint8_t frames, uint32_t* average, uint32_t* best) {
+    uint32_t total = 0;
+    *best = UINT32_MAX;
+    for (uint8_t i = 0; i < frames; i++) {
+        lv_obj_invalidate_area(screen, area);
+        uint32_t start = micros();
+        lv_refr_now(NULL);
+        displayPortFlushWait();
+        uint32_t us = micros() - start;
+        total += us;
+        if (us < *best) *best = us;
+    }
+    *average = total / frames;
+}
+
+void displayPortBenchModes(Print& out, uint8_t frames) {
+    lv_disp_t* disp = lv_disp_get_default();
+    if (!disp || frames == 0) return;
+    lv_obj_t* screen = lv_disp_get_scr_act(disp);
+    lv_area_t full = {0, 0, DISPLAY_WIDTH - 1, DISPLAY_HEIGHT - 1};
+    // A readout-sized area in the middle, as a value update redraws it
+    lv_area_t part = {DISPLAY_WIDTH / 2 - 80, DISPLAY_HEIGHT / 2 - 24, DISPLAY_WIDTH / 2 + 79, DISPLAY_HEIGHT / 2 + 23};
+
+    bool wasDirect = directMode;
+    for (uint8_t m = 0; m < 2; m++) {
+        bool direct = m == 1;
+        if (!displayPortSetDirect(direct)) {
+            out.println("Direct mode: unavailable (no PSRAM framebuffer or no DMA)");
+            continue;
+        }
+        lv_refr_now(NULL); // The full redraw after a switch is not timed
+        uint32_t fullAvg, fullBest, partAvg, partBest;
+        benchRedraws(screen, &full, frames, &fullAvg, &fullBest);
+        benchRedraws(screen, &part, frames, &partAvg, &partBest);
+        out.printf("%-8s full screen %lu us (best %lu), 160x48 area %lu us (best %lu)\n", direct ? "Direct:" : "Stripes:",
+                   (unsigned long)fullAvg, (unsigned long)fullBest, (unsigned long)partAvg, (unsigned long)partBest);
+    }
+    displayPortSetDirect(wasDirect);
+    out.printf("Buffers: 2 x %u B stripes in internal RAM", (unsigned)(DRAW_BUF_PIXELS * sizeof(lv_color_t)));
+    if (frameBuf) out.printf(", %u B framebuffer in PSRAM", (unsigned)(DISPLAY_WIDTH * DISPLAY_HEIGHT * sizeof(lv_color_t)));
+    out.println();
+    out.printf("Rendering in %s\n", directMode ? "direct mode" : "stripes");
+}
+
+void displayPortFlushWait() {
+    spiBusAcquire(SPI_BUS_DISPLAY);
+    releaseDisplayBus();
+    spiBusRelease();
+}
+
+bool displayPortPushRect(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint16_t* pixels) {
+    if (!dmaEnabled || panelAsleep) return false;
+    DisplayFlushHook hook = flushHook;
+    if (hook) hook(x, y, w, h, pixels, true);
+    openPanelWrite();
+    bool queued = tft.pushImageDMAQueued(x, y, w, h, pixels);
+    if (queued) tft.dmaWaitQueued(1);
+    return queued;
+}
+
+void displayPortPushFrame() {
+    if (!drawBuf1) return;
+    displayPortFlushWait(); // drawBuf1 may still be the source of a running transfer
+    lv_color_t black = lv_color_black();
+    for (uint32_t i = 0; i < DRAW_BUF_PIXELS; i++) drawBuf1[i] = black;
+
+    const uint16_t stripeRows = DRAW_BUF_PIXELS / DISPLAY_WIDTH;
+    for (uint16_t y = 0; y < DISPLAY_HEIGHT; y += stripeRows) {
+        lv_area_t area;
+        area.x1 = 0;
+        area.x2 = DISPLAY_WIDTH - 1;
+        area.y1 = y;
+        uint16_t end = y + stripeRows < DISPLAY_HEIGHT ? y + stripeRows : DISPLAY_HEIGHT;
+        area.y2 = end - 1;
+        pushStripe(&area, drawBuf1, false);
+    }
+    displayPortFlushWait();
+}
+
+/**
+ * @brief 16-bit test pattern: alternating bit stripes (worst case for the
+ *        clock edges) mixed with a pseudo-random sequence.
+ */
+static uint16_t testPixel(uint32_t i) {
+    if ((i & 0x0F) == 0) return (i & 0x10) ? 0xAAAA : 0x5555;
+    uint32_t x = i * 2654435761u;
+    return (uint16_t)(x >> 16);
+}
+
+uint32_t displayPortCheck(Print& out) {
+    out.printf("Display bus: SPI%d, write %.1f MHz (DMA %s), read %.1f MHz, touch %.2f MHz\n",
+#ifdef USE_HSPI_PORT
+               3,
+#else
+               2,
+#endif
+               SPI_FREQUENCY / 1e6f, dmaEnabled ? "on" : "off", SPI_READ_FREQUENCY / 1e6f,
+               SPI_TOUCH_FREQUENCY / 1e6f);
+    if (!drawBuf1) return 0;
+
+    // One stripe there and back: the readback runs at the lower read clock, so
+    // a mismatch points at the write path
+    const uint16_t rows = DRAW_BUF_PIXELS / DISPLAY_WIDTH;
+    const uint32_t pixels = (uint32_t)rows * DISPLAY_WIDTH;
+    displayPortFlushWait();
+    for (uint32_t i = 0; i < pixels; i++) drawBuf1[i].full = testPixel(i);
+    lv_area_t area;
+    area.x1 = 0;
+    area.x2 = DISPLAY_WIDTH - 1;
+    area.y1 = 0;
+    area.y2 = rows - 1;
+    pushStripe(&area, drawBuf1, false);
+    displayPortFlushWait();
+
+    uint16_t* readBuf = drawBuf2 ? (uint16_t*)drawBuf2 : (uint16_t*)heap_caps_malloc(pixels * 2, MALLOC_CAP_8BIT);
+    uint32_t errors = pixels;
+    if (readBuf) {
+        spiBusAcquire(SPI_BUS_DISPLAY);
+        tft.readRect(0, 0, DISPLAY_WIDTH, rows, readBuf);
+        spiBusRelease();
+        errors = 0;
+        for (uint32_t i = 0; i < pixels; i++) {
+            // readRect() returns the bytes swapped for pushRect()
+            uint16_t expected = testPixel(i);
+            uint16_t swapped = (uint16_t)(expected << 8 | expected >> 8);
+            if (readBuf[i] != expected && readBuf[i] != swapped) errors++;
+        }
+        if (!drawBuf2) heap_caps_free(readBuf);
+    }
+    out.printf("  pattern readback: %lu of %lu pixels wrong%s\n", (unsigned long)errors, (unsigned long)pixels,
+               readBuf ? "" : " (no read buffer)");
+
+    // Full frames through the flush path; 16 bits per pixel on the wire
+    const uint8_t frames = 10;
+    uint32_t start = micros();
+    for (uint8_t i = 0; i < frames; i++) displayPortPushFrame();
+    uint32_t frameUs = (micros() - start) / frames;
+    float mbits = frameUs ? (float)DISPLAY_WIDTH * DISPLAY_HEIGHT * 16 / frameUs : 0.0f;
+    out.printf("  full frame: %lu us (%.1f fps), %.1f Mbit/s effective (%u%% of the write clock)\n",
+               (unsigned long)frameUs, frameUs ? 1e6f / frameUs : 0.0f, mbits,
+               (unsigned)(mbits * 1e6f * 100 / SPI_FREQUENCY));
+    return errors;
+}
+
+void displayPortSetFlushHook(DisplayFlushHook hook) {
+    flushHook = hook;
+}
+
+bool displayPortTouched() {
+    if (TOUCH_IRQ_PIN >= 0) return digitalRead(TOUCH_IRQ_PIN) == LOW; // No bus access
+    uint16_t x, y;
+    return sampleTouch(&x, &y, TOUCH_PRESSURE_THRESHOLD) != TOUCH_NONE;
+}
+
+void displayPortReadTouchNow() {
+    if (!indevDrv.read_timer) return;
+    lv_timer_resume(indevDrv.read_timer);
+    lv_timer_ready(indevDrv.read_timer);
+}
+
+void displayPortSuppressTouch() {
+    touchSuppressed = true;
+}
+
+void displayPortSleep(bool sleep) {
+    spiBusAcquire(SPI_BUS_DISPLAY);
+    releaseDisplayBus(); // writecommand() opens its own transaction
+    panelAsleep = sleep;
+    if (sleep) {
+        tft.writecommand(ST7796_DISPOFF);
+        tft.writecommand(ST7796_SLPIN);
+    } else {
+        tft.writecommand(ST7796_SLPOUT);
+    }
+    spiBusRelease();
+
+    if (!sleep) {
+        // The controller ignores commands until its oscillator has restarted
+        vTaskDelay(pdMS_TO_TICKS(ST7796_SLPOUT_DELAY_MS));
+        spiBusAcquire(SPI_BUS_DISPLAY);
+        tft.writecommand(ST7796_DISPON);
+        spiBusRelease();
+    }
+}
+
+TFT_eSPI& displayPortTft() {
+    return tft;
+}
+
+#endif // !HEADLESS
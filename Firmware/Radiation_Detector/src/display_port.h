@@ -0,0 +1,96 @@
+#ifndef DISPLAY_PORT_H
+#define DISPLAY_PORT_H
+
+#include <lvgl.h>
+#include <TFT_eSPI.h>
+
+// LVGL port for the ST7796 panel and its XPT2046 touch controller.
+// A single TFT_eSPI instance drives both; flushes use double-buffered DMA and
+// every bus access goes through spi_bus so touch reads and SD writes never
+// collide with a running display transfer.
+// A touch read takes the median of five raw positions and reports a release
+// only after two reads without pressure. The conversions of a read are one
+// SPI transaction queued behind the display DMA (TFT_eSPI::startTouchAsync());
+// LVGL's read evaluates the set the previous read queued, one read period
+// (LV_INDEV_DEF_READ_PERIOD) old, and never waits for a stripe. With the pen interrupt wired
+// (TOUCH_IRQ_PIN) LVGL's touch read timer is paused while nothing touches the
+// panel, so the touch controller is not polled over the shared bus; the
+// interrupt wakes the LVGL task and the reads resume.
+
+static const uint16_t DISPLAY_WIDTH  = 480;
+static const uint16_t DISPLAY_HEIGHT = 320;
+
+// Initialises the panel, touch calibration and DMA. Call once before displayPortRegister().
+void displayPortBegin();
+
+// Allocates the draw buffers and registers the LVGL display and input drivers.
+// Call after lv_init().
+bool displayPortRegister();
+
+// Switches between rendering in stripes (1/10 screen, internal RAM) and direct
+// mode (a full-screen framebuffer in PSRAM; only the areas LVGL redrew are
+// sent). The first switch to direct mode allocates the framebuffer, which is
+// kept afterwards. The screen is redrawn in full. LVGL task only; registered
+// with DISPLAY_DIRECT_MODE.
+// @return false if direct mode is unavailable (no PSRAM or no DMA)
+bool displayPortSetDirect(bool direct);
+bool displayPortDirect();
+
+// Times full-screen and partial redraws (render and flush) in both modes and
+// prints them, then restores the mode. Blocks the LVGL task meanwhile.
+void displayPortBenchModes(Print& out, uint8_t frames);
+
+// Waits until the last flushed stripe has left the DMA engine and closes the
+// panel transaction.
+void displayPortFlushWait();
+
+// Sends one full frame through the flush callback, stripe by stripe, from a
+// black draw buffer, and waits for the last stripe (flush throughput benchmark).
+// Invalidate the screen afterwards so LVGL redraws it. Call from the LVGL task.
+void displayPortPushFrame();
+
+// Bus check for a board revision: prints the SPI clocks of the board profile
+// (User_Setup.h), writes a test pattern over the display path and reads it back
+// from the panel, then times full-frame pushes (frame time, effective clock).
+// Invalidate the screen afterwards so LVGL redraws it. Call from the LVGL task.
+// @return number of pixels that read back wrong
+uint32_t displayPortCheck(Print& out);
+
+// Queues @p pixels (panel byte order, w * h below 32768) for the panel area at
+// x, y through the display DMA, behind the stripes in flight, and returns once
+// the push before it has been sent, so the caller may alternate two buffers.
+// The panel transaction, and with it the bus, stays with the caller's task
+// until displayPortFlushWait() after the last push.
+// Bypasses LVGL: the caller makes sure nothing else is shown there.
+// @return false (nothing sent) while the panel sleeps or runs without DMA
+bool displayPortPushRect(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint16_t* pixels);
+
+// Called with every area sent to the panel (LVGL flushes and
+// displayPortPushRect()), before the transfer, on the task that sends it.
+// @p swapped: the pixels are in panel byte order rather than LVGL's.
+typedef void (*DisplayFlushHook)(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint16_t* pixels, bool swapped);
+
+// Installs @p hook, or removes it with nullptr (screen_mirror.h).
+void displayPortSetFlushHook(DisplayFlushHook hook);
+
+// Touch check outside LVGL, for waking the display while rendering is paused
+// (the T_IRQ level if wired, without bus access).
+bool displayPortTouched();
+
+// Resumes the touch reads and makes the next lv_timer_handler() read at once
+// (called when the touch interrupt woke the LVGL task).
+void displayPortReadTouchNow();
+
+// The current touch is reported to LVGL as released until the finger lifts, so
+// the touch that wakes the display does not also press a button.
+void displayPortSuppressTouch();
+
+// Puts the panel controller into sleep (display off, GRAM retained) or wakes
+// it; waking blocks for the controller's 120 ms start-up. LVGL task only.
+void displayPortSleep(bool sleep);
+
+// The shared panel instance, for code outside LVGL (e.g. backlight control).
+// Hold the SPI bus (SPI_BUS_DISPLAY) while drawing with it directly.
+TFT_eSPI& displayPortTft();
+
+#endif // DISPLAY_PORT_H
@@ -0,0 +1,132 @@
+/**
+ * @file display_power.cpp
+ * @brief Backlight PWM, panel sleep and render suspension for idle periods.
+ *
+ * Everything here runs on uiTask, between lv_timer_handler() calls, so no
+ * stripe is in flight when the panel is put to sleep and LVGL never renders
+ * into a sleeping panel.
+ */
+
+#include "config.h"
+
+#if !HEADLESS
+
+#include "display_power.h"
+#include "display_port.h"
+#include "power_profile.h"
+#include "debug.h"
+#include <lvgl.h>
+
+static const uint32_t BACKLIGHT_PWM_FREQUENCY = 5000;
+static const uint8_t BACKLIGHT_PWM_BITS = 8;
+
+static int8_t backlightPin = -1;
+static uint8_t backlightChannel = 0;
+static DisplayPowerState state = DISPLAY_POWER_ACTIVE;
+static uint32_t offSinceMs = 0;
+static DisplayPowerStats stats;
+
+static void setBacklight(uint8_t level) {
+    if (backlightPin >= 0) ledcWrite(backlightChannel, level);
+}
+
+static void enterState(DisplayPowerState next) {
+    if (next == state) return;
+
+    if (state == DISPLAY_POWER_OFF) {
+        powerProfileSetScreenOff(false);
+        displayPortSleep(false);
+        // Widgets kept changing while paused; repaint the whole screen once
+        lv_obj_invalidate(lv_scr_act());
+        stats.offMs += millis() - offSinceMs;
+        stats.wakeCount++;
+    }
+
+    switch (next) {
+        case DISPLAY_POWER_ACTIVE:
+            setBacklight(DISPLAY_BRIGHTNESS_NORMAL);
+            break;
+        case DISPLAY_POWER_DIMMED:
+            setBacklight(DISPLAY_BRIGHTNESS_DIMMED);
+            break;
+        case DISPLAY_POWER_OFF:
+            setBacklight(0);
+            displayPortSleep(true);
+            powerProfileSetScreenOff(true);
+            offSinceMs = millis();
+            stats.offCount++;
+            break;
+    }
+    DEBUG_PRINTF("Display: %s -> %s\n", displayPowerStateName(state), displayPowerStateName(next));
+    state = next;
+}
+
+bool initDisplayPower(int8_t pin, uint8_t ledcChannel) {
+    backlightPin = pin;
+    backlightChannel = ledcChannel;
+    if (backlightPin >= 0) {
+        if (ledcSetup(backlightChannel, BACKLIGHT_PWM_FREQUENCY, BACKLIGHT_PWM_BITS) == 0) {
+            backlightPin = -1;
+            return false;
+        }
+        ledcAttachPin(backlightPin, backlightChannel);
+    }
+    setBacklight(DISPLAY_BRIGHTNESS_NORMAL);
+    stats.backlightPwm = backlightPin >= 0;
+    return true;
+}
+
+bool displayPowerUpdate(uint32_t inactiveMs, uint32_t dimTimeoutMs, bool wakeRequest) {
+    if (state == DISPLAY_POWER_OFF) {
+        if (wakeRequest) {
+            enterState(DISPLAY_POWER_ACTIVE);
+        } else if (displayPortTouched()) {
+            displayPortSuppressTouch();
+            enterState(DISPLAY_POWER_ACTIVE);
+        } else {
+            return false;
+        }
+        lv_disp_trig_activity(NULL); // Restart the idle timeout from the wake
+        return true;
+    }
+
+    if (wakeRequest) {
+        lv_disp_trig_activity(NULL);
+        enterState(DISPLAY_POWER_ACTIVE);
+    } else if (inactiveMs >= dimTimeoutMs + DISPLAY_OFF_DELAY_MS) {
+        enterState(DISPLAY_POWER_OFF);
+        return false;
+    } else if (inactiveMs >= dimTimeoutMs) {
+        enterState(DISPLAY_POWER_DIMMED);
+    } else {
+        enterState(DISPLAY_POWER_ACTIVE);
+    }
+    return true;
+}
+
+void displayPowerWake() {
+    enterState(DISPLAY_POWER_ACTIVE);
+    lv_disp_trig_activity(NULL);
+}
+
+void displayPowerOff() {
+    enterState(DISPLAY_POWER_OFF);
+}
+
+DisplayPowerState displayPowerState() {
+    return state;
+}
+
+const char* displayPowerStateName(uint8_t value) {
+    static const char* NAMES[] = {"active", "dimmed", "off"};
+    return value <= DISPLAY_POWER_OFF ? NAMES[value] : "?";
+}
+
+DisplayPowerStats getDisplayPowerStats() {
+    DisplayPowerStats out = stats;
+    out.state = state;
+    if (state == DISPLAY_POWER_OFF) out.offMs += millis() - offSinceMs;
+    return out;
+}
+
+#endif // !HEADLESS
@@ -0,0 +1,50 @@
+#ifndef DISPLAY_POWER_H
+#define DISPLAY_POWER_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Display power states, driven from uiTask once per pass:
+//  - ACTIVE: normal backlight.
+//  - DIMMED: the display timeout passed without input; the backlight drops to
+//    DISPLAY_BRIGHTNESS_DIMMED. A touch is handled normally and restores ACTIVE.
+//  - OFF: DISPLAY_OFF_DELAY_MS later the backlight goes off, the panel enters
+//    sleep and uiTask stops calling lv_timer_handler(). Only a cheap raw touch
+//    poll runs; the power profile lowers the CPU clock (power_profile.h).
+// Idle time is LVGL's input inactivity (every touch on any widget counts). Any
+// touch, or an active alarm, wakes the display; the waking touch is swallowed.
+//
+// Measurement continues at full rate in every state: pulseTask, the alarms and
+// the dose bookkeeping never depend on rendering.
+
+enum DisplayPowerState {
+    DISPLAY_POWER_ACTIVE = 0,
+    DISPLAY_POWER_DIMMED,
+    DISPLAY_POWER_OFF
+};
+
+struct DisplayPowerStats {
+    uint8_t state;          ///< DisplayPowerState
+    bool backlightPwm;      ///< A backlight pin is configured
+    uint32_t offCount;      ///< Screen-off transitions since boot
+    uint32_t wakeCount;     ///< Wakes from OFF (touch or alarm)
+    uint32_t offMs;         ///< Total time spent off, including the current period
+};
+
+// Configures the backlight PWM on @p backlightPin (-1: none) and turns it on.
+bool initDisplayPower(int8_t backlightPin, uint8_t ledcChannel);
+
+// Advances the state machine. @p inactiveMs is LVGL's input inactivity,
+// @p wakeRequest holds the display on (alarm). Returns false while the screen is
+// off, i.e. when the caller must skip lv_timer_handler(). uiTask only.
+bool displayPowerUpdate(uint32_t inactiveMs, uint32_t dimTimeoutMs, bool wakeRequest);
+
+// Immediate transitions (serial command). uiTask only.
+void displayPowerWake();
+void displayPowerOff();
+
+DisplayPowerState displayPowerState();
+const char* displayPowerStateName(uint8_t state);
+DisplayPowerStats getDisplayPowerStats();
+
+#endif // DISPLAY_POWER_H
@@ -0,0 +1,166 @@
+/**
+ * @file dose_checkpoint.cpp
+ * @brief Rotating, CRC-checked NVS records of the accumulated dose.
+ *
+ * NVS already spreads its writes over the partition's pages; rotating over
+ * several keys adds redundancy on top: a record is written to a key that does
+ * not hold the newest one, so a reset in the middle of a write can only damage
+ * a record that is about to be superseded. On load every slot is read and the
+ * valid record with the highest sequence number is taken.
+ */
+
+#include "dose_checkpoint.h"
+#include "debug.h"
+#include "job_wheel.h"
+#include "power_fail.h"
+#include <Preferences.h>
+#include "esp_rom_crc.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+static const char* DOSE_NAMESPACE = "dose";
+static const uint32_t DOSE_CHECKPOINT_MAGIC = 0x43445452; ///< "RTDC"
+static const uint16_t DOSE_CHECKPOINT_FORMAT = 1;
+
+static DoseCheckpointCollect collectCheckpoint = nullptr;
+static SemaphoreHandle_t saveMutex = nullptr;
+static uint8_t nextSlot = 0;
+static uint32_t nextSequence = 1;
+static DoseCheckpointStats stats;
+static bool rescuedUnsaved = false;      ///< Restored from a power-fail image, not yet in NVS
+
+static uint32_t checkpointCrc(const DoseCheckpoint& checkpoint) {
+    return esp_rom_crc32_le(0, (const uint8_t*)&checkpoint, offsetof(DoseCheckpoint, crc));
+}
+
+static void slotKey(uint8_t slot, char* key, size_t size) {
+    snprintf(key, size, "ckpt%u", (unsigned)slot);
+}
+
+static bool checkpointValid(const DoseCheckpoint& checkpoint) {
+    return checkpoint.magic == DOSE_CHECKPOINT_MAGIC &&
+           checkpoint.format == DOSE_CHECKPOINT_FORMAT &&
+           checkpoint.hourlyCount <= DOSE_CHECKPOINT_HOURLY &&
+           checkpoint.dailyCount <= DOSE_CHECKPOINT_DAILY &&
+           checkpoint.crc == checkpointCrc(checkpoint);
+}
+
+bool doseCheckpointLoad(DoseCheckpoint* out) {
+    Preferences prefs;
+    bool opened = prefs.begin(DOSE_NAMESPACE, true); // False if never written
+
+    bool found = false;
+    uint8_t newestSlot = 0;
+    for (uint8_t slot = 0; opened && slot < DOSE_CHECKPOINT_SLOTS; slot++) {
+        char key[8];
+        slotKey(slot, key, sizeof(key));
+        if (prefs.getBytesLength(key) != sizeof(DoseCheckpoint)) continue;
+
+        DoseCheckpoint record;
+        prefs.getBytes(key, &record, sizeof(record));
+        if (!checkpointValid(record)) {
+            DEBUG_PRINTF("Dose checkpoint: slot %u is damaged, skipped\n", (unsigned)slot);
+            continue;
+        }
+        // Wrap-safe comparison of the sequence numbers
+        if (!found || (int32_t)(record.sequence - out->sequence) > 0) {
+            *out = record;
+            newestSlot = slot;
+            found = true;
+        }
+    }
+    if (opened) prefs.end();
+    if (found) nextSlot = (newestSlot + 1) % DOSE_CHECKPOINT_SLOTS;
+
+    // A checkpoint saved as the power failed (power_fail.h) outranks the NVS
+    // records it was saved after; initDoseCheckpoint() stores it
+    DoseCheckpoint rescued;
+    if (powerFailRescuedDose(&rescued) && checkpointValid(rescued) &&
+        (!found || (int32_t)(rescued.sequence - out->sequence) > 0)) {
+        *out = rescued;
+        found = true;
+        rescuedUnsaved = true;
+    }
+
+    if (found) {
+        nextSequence = out->sequence + 1;
+        stats.restored = true;
+        stats.sequence = out->sequence;
+    }
+    return found;
+}
+
+bool doseCheckpointSave() {
+    if (!saveMutex || !collectCheckpoint) return false;
+    xSemaphoreTake(saveMutex, portMAX_DELAY);
+
+    DoseCheckpoint checkpoint;
+    memset(&checkpoint, 0, sizeof(checkpoint));
+    collectCheckpoint(checkpoint);
+    checkpoint.magic = DOSE_CHECKPOINT_MAGIC;
+    checkpoint.format = DOSE_CHECKPOINT_FORMAT;
+    checkpoint.sequence = nextSequence;
+    checkpoint.crc = checkpointCrc(checkpoint);
+
+    char key[8];
+    slotKey(nextSlot, key, sizeof(key));
+    bool ok = false;
+    Preferences prefs;
+    if (prefs.begin(DOSE_NAMESPACE, false)) {
+        ok = prefs.putBytes(key, &checkpoint, sizeof(checkpoint)) == sizeof(checkpoint);
+        prefs.end();
+    }
+
+    if (ok) {
+        nextSlot = (nextSlot + 1) % DOSE_CHECKPOINT_SLOTS;
+        nextSequence++;
+        stats.writes++;
+        stats.sequence = checkpoint.sequence;
+        stats.lastWriteMs = millis();
+    } else {
+        stats.failures++; // Same slot and sequence again next time
+        DEBUG_PRINTLN("Dose checkpoint: NVS write failed");
+    }
+
+    xSemaphoreGive(saveMutex);
+    return ok;
+}
+
+bool doseCheckpointRescue(DoseCheckpoint* out) {
+    if (!collectCheckpoint) return false;
+    memset(out, 0, sizeof(*out));
+    collectCheckpoint(*out);
+    out->magic = DOSE_CHECKPOINT_MAGIC;
+    out->format = DOSE_CHECKPOINT_FORMAT;
+    // Above a record a save in progress may be writing, and below the saves
+    // that follow if the supply comes back
+    out->sequence = nextSequence + 1;
+    nextSequence += 2;
+    out->crc = checkpointCrc(*out);
+    return true;
+}
+
+/**
+ * @brief Checkpoint job: writes a record every DOSE_CHECKPOINT_INTERVAL_S.
+ */
+static void doseCheckpointJob(void* parameter) {
+    doseCheckpointSave();
+}
+
+bool initDoseCheckpoint(DoseCheckpointCollect collect) {
+    if (saveMutex) return true;
+    collectCheckpoint = collect;
+    saveMutex = xSemaphoreCreateMutex();
+    if (!saveMutex) return false;
+    if (rescuedUnsaved) {
+        // The live state was restored from it, so this stores the same values
+        rescuedUnsaved = !doseCheckpointSave();
+    }
+    return jobWheelAdd("dose save", DOSE_CHECKPOINT_INTERVAL_S * 1000UL, DOSE_CHECKPOINT_INTERVAL_S * 1000UL,
+                       doseCheckpointJob, NULL);
+}
+
+DoseCheckpointStats getDoseCheckpointStats() {
+    return stats;
+}
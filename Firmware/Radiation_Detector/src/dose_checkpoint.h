@@ -0,0 +1,66 @@
+#ifndef DOSE_CHECKPOINT_H
+#define DOSE_CHECKPOINT_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Persistence of the accumulated dose across reboots and OTA updates.
+// A DoseCheckpoint is written to NVS (namespace "dose") every
+// DOSE_CHECKPOINT_INTERVAL_S by a background job (job_wheel.h), and on demand
+// before an update or restart. Each write goes to the next of
+// DOSE_CHECKPOINT_SLOTS keys with a higher sequence number and a CRC-32; the
+// newest valid record wins at boot. Interval averages still being accumulated
+// are not saved, so up to one interval of chart history (not of dose) is lost
+// per reboot. A unit with a supply-sense line also saves a record as the power
+// fails (power_fail.h), which is restored like one from NVS.
+
+static const size_t DOSE_CHECKPOINT_HOURLY = 20; ///< Chart1: 3-minute averages
+static const size_t DOSE_CHECKPOINT_DAILY = 24;  ///< Chart3: 1-hour averages
+
+struct DoseCheckpoint {
+    uint32_t magic;
+    uint16_t format;
+    uint8_t hourlyCount;      ///< Valid entries of hourly[], oldest first
+    uint8_t dailyCount;       ///< Valid entries of daily[], oldest first
+    uint32_t sequence;        ///< Incremented by every write
+    uint32_t totalCounts;     ///< Counts since the first boot of the measurement
+    uint32_t elapsedMs;       ///< Measurement time behind totalCounts (for the average)
+    float cumulativemSv;
+    float maxuSvHr;
+    float hourly[DOSE_CHECKPOINT_HOURLY];
+    float daily[DOSE_CHECKPOINT_DAILY];
+    uint32_t crc;             ///< CRC-32 of everything above
+};
+
+struct DoseCheckpointStats {
+    bool restored;            ///< A record was restored at boot
+    uint32_t sequence;        ///< Sequence of the newest record written or restored
+    uint32_t writes;          ///< Records written since boot
+    uint32_t failures;
+    uint32_t lastWriteMs;     ///< millis() of the last write, 0 if none
+};
+
+// Fills a checkpoint from the live state; called from the checkpoint task or
+// the caller of doseCheckpointSave().
+typedef void (*DoseCheckpointCollect)(DoseCheckpoint& checkpoint);
+
+// Reads the newest valid record, from NVS or a power-fail image, into @p out.
+// Call once in setup() after powerFailLoad() and before initDoseCheckpoint();
+// false if none is stored.
+bool doseCheckpointLoad(DoseCheckpoint* out);
+
+// Starts the periodic checkpoint task.
+bool initDoseCheckpoint(DoseCheckpointCollect collect);
+
+// Collects and writes a record now (before an OTA update or a restart).
+// Blocks for the NVS write; serialised with the periodic task.
+bool doseCheckpointSave();
+
+// Fills @p out as doseCheckpointSave() would, without NVS or the save lock,
+// for the power-fail flush (power_fail.h). Its sequence outranks the records
+// written so far.
+bool doseCheckpointRescue(DoseCheckpoint* out);
+
+DoseCheckpointStats getDoseCheckpointStats();
+
+#endif // DOSE_CHECKPOINT_H
@@ -0,0 +1,359 @@
+/**
+ * @file energy_meter.cpp
+ * @brief Charge per subsystem from sampled states and per-board current coefficients.
+ *
+ * The sampling job reads every subsystem's state first and only then takes
+ * the meter's mutex, so it never waits for sysinfo while holding it (the
+ * /api/sysinfo writer takes them the other way round).
+ */
+
+#include "energy_meter.h"
+#include "alarm_sequencer.h"
+#include "ble_service.h"
+#include "debug.h"
+#include "display_power.h"
+#include "flash_stall.h"
+#include "job_wheel.h"
+#include "power_profile.h"
+#include "sysinfo.h"
+#include "wifi_power.h"
+#include <Preferences.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+static const uint8_t WIFI_SLOTS = 4;
+static const uint8_t WIFI_SLOT_OFF = 3;
+static const char* const RAIL_NAMES[ENERGY_RAIL_COUNT] = {"cpu", "radio", "display", "buzzer", "storage", "base"};
+static const char* const WIFI_SLOT_NAMES[WIFI_SLOTS] = {"awake", "modem", "listen", "off"};
+static const char* const DISPLAY_STATE_NAMES[3] = {"active", "dimmed", "off"};
+
+struct CoefficientField {
+    const char* name;           ///< Also the Preferences key
+    size_t offset;
+    float fallback;
+};
+
+static const CoefficientField COEFFICIENTS[] = {
+    {"cpuIdleBase", offsetof(EnergyCoefficients, cpuIdleBaseMa), ENERGY_COEF_CPU_IDLE_BASE_MA},
+    {"cpuIdlePerMhz", offsetof(EnergyCoefficients, cpuIdleMaPerMhz), ENERGY_COEF_CPU_IDLE_MA_PER_MHZ},
+    {"cpuBusyPerMhz", offsetof(EnergyCoefficients, cpuBusyMaPerMhz), ENERGY_COEF_CPU_BUSY_MA_PER_MHZ},
+    {"wifiAwake", offsetof(EnergyCoefficients, wifiAwakeMa), ENERGY_COEF_WIFI_AWAKE_MA},
+    {"wifiModem", offsetof(EnergyCoefficients, wifiModemMa), ENERGY_COEF_WIFI_MODEM_MA},
+    {"wifiListen", offsetof(EnergyCoefficients, wifiListenMa), ENERGY_COEF_WIFI_LISTEN_MA},
+    {"ble", offsetof(EnergyCoefficients, bleMa), ENERGY_COEF_BLE_MA},
+    {"panel", offsetof(EnergyCoefficients, panelMa), ENERGY_COEF_PANEL_MA},
+    {"backlight", offsetof(EnergyCoefficients, backlightMa), ENERGY_COEF_BACKLIGHT_MA},
+    {"buzzer", offsetof(EnergyCoefficients, buzzerMa), ENERGY_COEF_BUZZER_MA},
+    {"click", offsetof(EnergyCoefficients, clickUas), ENERGY_COEF_CLICK_UAS},
+    {"flashWrite", offsetof(EnergyCoefficients, flashWriteMa), ENERGY_COEF_FLASH_WRITE_MA},
+    {"base", offsetof(EnergyCoefficients, baseMa), ENERGY_COEF_BASE_MA},
+};
+static const uint8_t COEFFICIENT_COUNT = sizeof(COEFFICIENTS) / sizeof(COEFFICIENTS[0]);
+
+struct CpuClock {
+    uint16_t mhz;
+    double busyMs;
+    double idleMs;
+};
+
+/// What the job saw last, to charge the time until the next look
+struct Reading {
+    uint32_t ms;
+    uint64_t toneUs;
+    uint32_t clicks;
+    uint64_t flashUs;
+};
+
+static SemaphoreHandle_t mutex = nullptr;
+static EnergyCoefficients coef;
+static double totalMas[ENERGY_RAIL_COUNT];
+static double intervalMas[ENERGY_RAIL_COUNT];
+static uint32_t intervalStartMs = 0;
+static double accountedMs = 0;
+static CpuClock clocks[ENERGY_CPU_CLOCKS];
+static double wifiMs[WIFI_SLOTS];
+static double bleMs = 0;
+static double displayMs[3];
+static double backlightDutyMs = 0;          ///< Duty-weighted time
+static Reading last;
+static EnergyInterval history[ENERGY_HISTORY_SIZE];
+static size_t historyHead = 0;
+static size_t historyCount = 0;
+
+static float& field(EnergyCoefficients& c, uint8_t index) {
+    return *(float*)((uint8_t*)&c + COEFFICIENTS[index].offset);
+}
+
+/**
+ * @brief Clock table entry for @p mhz; the last one takes any further clocks.
+ */
+static CpuClock& clockEntry(uint16_t mhz) {
+    for (uint8_t i = 0; i < ENERGY_CPU_CLOCKS; i++) {
+        if (clocks[i].mhz == mhz) return clocks[i];
+        if (clocks[i].mhz == 0) {
+            clocks[i].mhz = mhz;
+            return clocks[i];
+        }
+    }
+    return clocks[ENERGY_CPU_CLOCKS - 1];
+}
+
+static void charge(uint8_t rail, double mas) {
+    totalMas[rail] += mas;
+    intervalMas[rail] += mas;
+}
+
+/**
+ * @brief Closes the interval: history entry and debug log line. Mutex held.
+ */
+static void closeInterval(uint32_t nowMs) {
+    EnergyInterval& entry = history[historyHead];
+    entry.uptimeSeconds = nowMs / 1000;
+    char line[160];
+    int length = snprintf(line, sizeof(line), "Energy: last %lu s", (unsigned long)((nowMs - intervalStartMs) / 1000));
+    for (uint8_t r = 0; r < ENERGY_RAIL_COUNT; r++) {
+        entry.mah[r] = (float)(intervalMas[r] / 3600.0);
+        intervalMas[r] = 0;
+        if (length > 0 && length < (int)sizeof(line)) {
+            length += snprintf(line + length, sizeof(line) - length, " %s %.2f", RAIL_NAMES[r], entry.mah[r]);
+        }
+    }
+    historyHead = (historyHead + 1) % ENERGY_HISTORY_SIZE;
+    if (historyCount < ENERGY_HISTORY_SIZE) historyCount++;
+    intervalStartMs = nowMs;
+    DEBUG_PRINTF("%s mAh\n", line);
+}
+
+static void energySampleJob(void* arg) {
+    // Every state first, then the mutex (see the file comment)
+    Reading now;
+    now.ms = millis();
+    now.toneUs = alarmSoundingUs();
+    now.clicks = getAlarmClickStats().played;
+    now.flashUs = getFlashStallStats().totalUs;
+    SysInfoSample sample = getSysInfoSample();
+    int8_t wifi = wifiPowerAppliedMode();
+    bool ble = getBleStats().running;
+#if HEADLESS
+    DisplayPowerStats display = {DISPLAY_POWER_OFF, true, 0, 0, 0}; // No panel fitted
+#else
+    DisplayPowerStats display = getDisplayPowerStats();
+#endif
+    bool dfs = powerProfileMode() == POWER_MODE_DFS;
+    uint16_t mhz = (uint16_t)getCpuFrequencyMhz();
+
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    double dtMs = now.ms - last.ms;
+    accountedMs += dtMs;
+
+    // Unknown load (no run-time stats) is charged as busy
+    double busy = sample.cpuLoad[0] < 0 ? 1.0 : (sample.cpuLoad[0] + sample.cpuLoad[1]) / 200.0;
+    uint16_t busyMhz = dfs ? POWER_MAX_CPU_MHZ : mhz;
+    uint16_t idleMhz = dfs ? POWER_MIN_CPU_MHZ : mhz;
+    double busyMs = dtMs * busy;
+    double idleMs = dtMs - busyMs;
+    clockEntry(busyMhz).busyMs += busyMs;
+    clockEntry(idleMhz).idleMs += idleMs;
+    double busyMa = coef.cpuIdleBaseMa + coef.cpuIdleMaPerMhz * busyMhz + coef.cpuBusyMaPerMhz * busyMhz;
+    double idleMa = coef.cpuIdleBaseMa + coef.cpuIdleMaPerMhz * idleMhz;
+    charge(ENERGY_RAIL_CPU, (busyMs * busyMa + idleMs * idleMa) / 1000.0);
+
+    uint8_t slot = wifi >= 0 && wifi < WIFI_SLOT_OFF ? (uint8_t)wifi : WIFI_SLOT_OFF;
+    const float wifiMa[WIFI_SLOTS] = {coef.wifiAwakeMa, coef.wifiModemMa, coef.wifiListenMa, 0.0f};
+    wifiMs[slot] += dtMs;
+    if (ble) bleMs += dtMs;
+    charge(ENERGY_RAIL_RADIO, dtMs * (wifiMa[slot] + (ble ? coef.bleMa : 0.0f)) / 1000.0);
+
+    // Without a PWM pin the backlight is wired to the supply and always on
+    uint8_t state = display.state < 3 ? display.state : DISPLAY_POWER_ACTIVE;
+    float duty = !display.backlightPwm              ? 1.0f
+                 : state == DISPLAY_POWER_ACTIVE ? DISPLAY_BRIGHTNESS_NORMAL / 255.0f
+                 : state == DISPLAY_POWER_DIMMED ? DISPLAY_BRIGHTNESS_DIMMED / 255.0f
+                                                 : 0.0f;
+    displayMs[state] += dtMs;
+    backlightDutyMs += dtMs * duty;
+    double panelMa = state == DISPLAY_POWER_OFF ? 0.0 : coef.panelMa;
+    charge(ENERGY_RAIL_DISPLAY, dtMs * (panelMa + coef.backlightMa * duty) / 1000.0);
+
+    charge(ENERGY_RAIL_BUZZER, (now.toneUs - last.toneUs) / 1e6 * coef.buzzerMa +
+                                   (uint32_t)(now.clicks - last.clicks) * coef.clickUas / 1000.0);
+    charge(ENERGY_RAIL_STORAGE, (now.flashUs - last.flashUs) / 1e6 * coef.flashWriteMa);
+    charge(ENERGY_RAIL_BASE, dtMs * coef.baseMa / 1000.0);
+    last = now;
+
+    if (now.ms - intervalStartMs >= ENERGY_LOG_INTERVAL_S * 1000UL) closeInterval(now.ms);
+    xSemaphoreGive(mutex);
+}
+
+bool initEnergyMeter() {
+    if (mutex) return true;
+    mutex = xSemaphoreCreateMutex();
+    if (!mutex) return false;
+
+    Preferences prefs;
+    prefs.begin("energy", true);
+    for (uint8_t i = 0; i < COEFFICIENT_COUNT; i++) {
+        field(coef, i) = prefs.getFloat(COEFFICIENTS[i].name, COEFFICIENTS[i].fallback);
+    }
+    prefs.end();
+
+    last.ms = millis();
+    last.toneUs = alarmSoundingUs();
+    last.clicks = getAlarmClickStats().played;
+    last.flashUs = getFlashStallStats().totalUs;
+    intervalStartMs = last.ms;
+    return jobWheelAdd("energy", ENERGY_SAMPLE_MS, ENERGY_SAMPLE_MS, energySampleJob, nullptr);
+}
+
+const char* energyRailName(uint8_t rail) {
+    return rail < ENERGY_RAIL_COUNT ? RAIL_NAMES[rail] : "?";
+}
+
+EnergyCoefficients getEnergyCoefficients() {
+    if (!mutex) return coef;
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    EnergyCoefficients copy = coef;
+    xSemaphoreGive(mutex);
+    return copy;
+}
+
+bool energySetCoefficient(const char* name, float value) {
+    if (!mutex || !(value >= 0.0f)) return false;
+    for (uint8_t i = 0; i < COEFFICIENT_COUNT; i++) {
+        if (strcmp(name, COEFFICIENTS[i].name) != 0) continue;
+        Preferences prefs;
+        prefs.begin("energy", false);
+        prefs.putFloat(COEFFICIENTS[i].name, value);
+        prefs.end();
+        xSemaphoreTake(mutex, portMAX_DELAY);
+        field(coef, i) = value;
+        xSemaphoreGive(mutex);
+        return true;
+    }
+    return false;
+}
+
+void energyResetCoefficients() {
+    if (!mutex) return;
+    Preferences prefs;
+    prefs.begin("energy", false);
+    prefs.clear();
+    prefs.end();
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    for (uint8_t i = 0; i < COEFFICIENT_COUNT; i++) field(coef, i) = COEFFICIENTS[i].fallback;
+    xSemaphoreGive(mutex);
+}
+
+EnergyStats getEnergyStats() {
+    EnergyStats s;
+    memset(&s, 0, sizeof(s));
+    if (!mutex) return s;
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    s.running = true;
+    s.seconds = (uint32_t)(accountedMs / 1000.0);
+    double totalMah = 0;
+    for (uint8_t r = 0; r < ENERGY_RAIL_COUNT; r++) {
+        s.mah[r] = (float)(totalMas[r] / 3600.0);
+        totalMah += totalMas[r] / 3600.0;
+    }
+    s.averageMa = accountedMs > 0 ? (float)(totalMah * 3600000.0 / accountedMs) : 0.0f;
+    for (uint8_t i = 0; i < ENERGY_CPU_CLOCKS; i++) {
+        s.cpu[i].mhz = clocks[i].mhz;
+        s.cpu[i].busyMs = (uint64_t)clocks[i].busyMs;
+        s.cpu[i].idleMs = (uint64_t)clocks[i].idleMs;
+    }
+    for (uint8_t w = 0; w < WIFI_SLOTS; w++) s.wifiMs[w] = (uint64_t)wifiMs[w];
+    s.bleMs = (uint64_t)bleMs;
+    for (uint8_t d = 0; d < 3; d++) s.displayMs[d] = (uint64_t)displayMs[d];
+    s.backlightDuty = accountedMs > 0 ? (float)(backlightDutyMs / accountedMs) : 0.0f;
+    s.toneMs = last.toneUs / 1000;
+    s.clicks = last.clicks;
+    s.flashWriteMs = last.flashUs / 1000;
+    xSemaphoreGive(mutex);
+    return s;
+}
+
+void writeEnergyJson(Print& out) {
+    EnergyStats s = getEnergyStats();
+    EnergyCoefficients c = getEnergyCoefficients();
+    out.printf("{\"seconds\":%lu,\"average_ma\":%.2f,\"mah\":{", (unsigned long)s.seconds, s.averageMa);
+    for (uint8_t r = 0; r < ENERGY_RAIL_COUNT; r++) out.printf("%s\"%s\":%.3f", r ? "," : "", RAIL_NAMES[r], s.mah[r]);
+    out.print("},\"cpu_clocks\":[");
+    for (uint8_t i = 0; i < ENERGY_CPU_CLOCKS && s.cpu[i].mhz; i++) {
+        out.printf("%s{\"mhz\":%u,\"busy_s\":%.1f,\"idle_s\":%.1f}", i ? "," : "", (unsigned)s.cpu[i].mhz,
+                   s.cpu[i].busyMs / 1000.0, s.cpu[i].idleMs / 1000.0);
+    }
+    out.print("],\"wifi_s\":{");
+    for (uint8_t w = 0; w < WIFI_SLOTS; w++) {
+        out.printf("%s\"%s\":%.1f", w ? "," : "", WIFI_SLOT_NAMES[w], s.wifiMs[w] / 1000.0);
+    }
+    out.printf("},\"ble_s\":%.1f,\"display_s\":{", s.bleMs / 1000.0);
+    for (uint8_t d = 0; d < 3; d++) {
+        out.printf("%s\"%s\":%.1f", d ? "," : "", DISPLAY_STATE_NAMES[d], s.displayMs[d] / 1000.0);
+    }
+    out.printf("},\"backlight_duty\":%.3f,\"tone_s\":%.1f,\"clicks\":%lu,\"flash_write_ms\":%lu,\"coefficients\":{",
+               s.backlightDuty, s.toneMs / 1000.0, (unsigned long)s.clicks, (unsigned long)s.flashWriteMs);
+    for (uint8_t i = 0; i < COEFFICIENT_COUNT; i++) {
+        out.printf("%s\"%s\":%.3f", i ? "," : "", COEFFICIENTS[i].name, field(c, i));
+    }
+
+    // History as one array per series, as the sysinfo history
+    out.printf("},\"interval_s\":%u,\"history\":{\"uptime_s\":[", (unsigned)ENERGY_LOG_INTERVAL_S);
+    if (!mutex) {
+        out.print("]}}");
+        return;
+    }
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    size_t start = (historyHead + ENERGY_HISTORY_SIZE - historyCount) % ENERGY_HISTORY_SIZE;
+    for (size_t i = 0; i < historyCount; i++) {
+        out.printf("%s%lu", i ? "," : "", (unsigned long)history[(start + i) % ENERGY_HISTORY_SIZE].uptimeSeconds);
+    }
+    out.print(']');
+    for (uint8_t r = 0; r < ENERGY_RAIL_COUNT; r++) {
+        out.printf(",\"%s\":[", RAIL_NAMES[r]);
+        for (size_t i = 0; i < historyCount; i++) {
+            out.printf("%s%.3f", i ? "," : "", history[(start + i) % ENERGY_HISTORY_SIZE].mah[r]);
+        }
+        out.print(']');
+    }
+    xSemaphoreGive(mutex);
+    out.print("}}");
+}
+
+void printEnergyMeter(Print& out, bool coefficients) {
+    EnergyStats s = getEnergyStats();
+    if (!s.running) {
+        out.println("Energy accounting not running");
+        return;
+    }
+    out.printf("=== Energy (estimate over %lu s, average %.1f mA) ===\n", (unsigned long)s.seconds, s.averageMa);
+    float total = 0.0f;
+    for (uint8_t r = 0; r < ENERGY_RAIL_COUNT; r++) total += s.mah[r];
+    for (uint8_t r = 0; r < ENERGY_RAIL_COUNT; r++) {
+        out.printf("%-8s %9.2f mAh  %3.0f %%\n", RAIL_NAMES[r], s.mah[r], total > 0.0f ? 100.0f * s.mah[r] / total : 0.0f);
+    }
+    out.print("CPU:");
+    for (uint8_t i = 0; i < ENERGY_CPU_CLOCKS && s.cpu[i].mhz; i++) {
+        out.printf(" %u MHz busy %lu s idle %lu s;", (unsigned)s.cpu[i].mhz, (unsigned long)(s.cpu[i].busyMs / 1000),
+                   (unsigned long)(s.cpu[i].idleMs / 1000));
+    }
+    out.println();
+    out.print("WiFi:");
+    for (uint8_t w = 0; w < WIFI_SLOTS; w++) {
+        out.printf(" %s %lu s", WIFI_SLOT_NAMES[w], (unsigned long)(s.wifiMs[w] / 1000));
+    }
+    out.printf("; BLE %lu s\n", (unsigned long)(s.bleMs / 1000));
+    out.printf("Display: active %lu s, dimmed %lu s, off %lu s, backlight duty %.0f %%\n",
+               (unsigned long)(s.displayMs[0] / 1000), (unsigned long)(s.displayMs[1] / 1000),
+               (unsigned long)(s.displayMs[2] / 1000), s.backlightDuty * 100.0f);
+    out.printf("Buzzer: alarm %lu s, %lu clicks; flash writes %lu ms\n", (unsigned long)(s.toneMs / 1000),
+               (unsigned long)s.clicks, (unsigned long)s.flashWriteMs);
+    if (!coefficients) return;
+    EnergyCoefficients c = getEnergyCoefficients();
+    out.println("Coefficients (mA, click uA s; \"energy coef <name> <value>\" saves one, \"energy coef reset\"):");
+    for (uint8_t i = 0; i < COEFFICIENT_COUNT; i++) {
+        float value = field(c, i);
+        out.printf("  %-14s %8.3f%s\n", COEFFICIENTS[i].name, value,
+                   value == COEFFICIENTS[i].fallback ? "" : " (measured)");
+    }
+}
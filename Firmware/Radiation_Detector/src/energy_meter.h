@@ -0,0 +1,110 @@
+#ifndef ENERGY_METER_H
+#define ENERGY_METER_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Charge accounting per subsystem ("energy", /api/sysinfo "energy").
+// A background job (job_wheel.h) looks at the state of each subsystem every
+// ENERGY_SAMPLE_MS and charges the time since the last look at that state's
+// current:
+//  - cpu:     busy and idle time per clock (the sysinfo CPU load; with DFS
+//             busy time runs at POWER_MAX_CPU_MHZ and idle time at
+//             POWER_MIN_CPU_MHZ). Automatic light sleep stays off while the
+//             pulse counter holds its APB lock (power_profile.h).
+//  - radio:   WiFi time per applied power-save mode, BLE time while it runs.
+//  - display: panel awake time and backlight duty per display power state.
+//  - buzzer:  time an alarm pattern sounds and the clicks played; both are
+//             counted where they happen, so short chirps are not missed.
+//  - storage: time the flash cache was off for writes (flash_stall.h), the
+//             only storage this board has.
+//  - base:    everything always on (HV supply, regulators, the tube input).
+// The currents are coefficients measured once per board with a supply meter
+// (e.g. during "power bench") and saved to Preferences ("energy" namespace)
+// with "energy coef <name> <value>"; config.h holds the defaults. The result
+// is an estimate: it is only as good as the coefficients.
+//
+// Every ENERGY_LOG_INTERVAL_S the charge per subsystem over the interval goes
+// into a RAM ring of ENERGY_HISTORY_SIZE entries and into the debug log (and
+// so to syslog on headless installs). Totals count from boot.
+
+enum EnergyRail : uint8_t {
+    ENERGY_RAIL_CPU = 0,
+    ENERGY_RAIL_RADIO,
+    ENERGY_RAIL_DISPLAY,
+    ENERGY_RAIL_BUZZER,
+    ENERGY_RAIL_STORAGE,
+    ENERGY_RAIL_BASE,
+    ENERGY_RAIL_COUNT
+};
+
+static const uint8_t ENERGY_CPU_CLOCKS = 4;   ///< Distinct clocks timed
+
+// Coefficients in mA (clickUas in uA s per click), see ENERGY_COEF_* in config.h.
+struct EnergyCoefficients {
+    float cpuIdleBaseMa;
+    float cpuIdleMaPerMhz;
+    float cpuBusyMaPerMhz;       ///< On top of idle
+    float wifiAwakeMa;           ///< WIFI_PS_NONE
+    float wifiModemMa;           ///< WIFI_PS_MIN_MODEM, average
+    float wifiListenMa;          ///< WIFI_PS_MAX_MODEM, average
+    float bleMa;
+    float panelMa;               ///< Panel and controller awake
+    float backlightMa;           ///< At full duty
+    float buzzerMa;              ///< Average while an alarm pattern sounds
+    float clickUas;
+    float flashWriteMa;
+    float baseMa;
+};
+
+struct EnergyCpuClock {
+    uint16_t mhz;
+    uint64_t busyMs;
+    uint64_t idleMs;
+};
+
+struct EnergyStats {
+    bool running;
+    uint32_t seconds;                        ///< Accounted since boot
+    float mah[ENERGY_RAIL_COUNT];            ///< Since boot
+    float averageMa;                         ///< All rails, since boot
+    EnergyCpuClock cpu[ENERGY_CPU_CLOCKS];
+    uint64_t wifiMs[4];                      ///< Awake, modem (DTIM), modem (listen), off
+    uint64_t bleMs;
+    uint64_t displayMs[3];                   ///< Per DisplayPowerState
+    float backlightDuty;                     ///< Average since boot, 0-1
+    uint64_t toneMs;
+    uint32_t clicks;
+    uint64_t flashWriteMs;
+};
+
+struct EnergyInterval {
+    uint32_t uptimeSeconds;                  ///< End of the interval
+    float mah[ENERGY_RAIL_COUNT];
+};
+
+// Loads the coefficients and adds the job; after initJobWheel().
+bool initEnergyMeter();
+
+const char* energyRailName(uint8_t rail);
+
+EnergyCoefficients getEnergyCoefficients();
+
+// Sets coefficient @p name (the EnergyCoefficients field) and saves it.
+// @return false for an unknown name or a negative value
+bool energySetCoefficient(const char* name, float value);
+
+// Back to the config.h defaults (and clears the saved ones).
+void energyResetCoefficients();
+
+EnergyStats getEnergyStats();
+
+// Totals, state times and the interval history as one JSON object, written
+// straight to @p out (the "energy" member of /api/sysinfo).
+void writeEnergyJson(Print& out);
+
+// Totals per subsystem and the state times ("energy"); with @p coefficients
+// the coefficients too ("energy coef").
+void printEnergyMeter(Print& out, bool coefficients);
+
+#endif // ENERGY_METER_H
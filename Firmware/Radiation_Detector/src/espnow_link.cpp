@@ -0,0 +1,492 @@
+/**
+ * @file espnow_link.cpp
+ * @brief ESP-NOW broadcast, flood relay with per-origin replay windows, hub table.
+ *
+ * The receive callback runs on the WiFi task and only queues the frame. The
+ * ESP-NOW task checks and relays the frames, updates the origin table and
+ * sends this unit's own frames. The table is also read by the web and UI
+ * tasks, under a mutex.
+ */
+
+#include "espnow_link.h"
+#include "wifi_manager.h"
+#include "wifi_power.h"
+#include "web_service.h"
+#include "mdns_service.h"
+#include "alarm_rules.h"
+#include "time_base.h"
+#include "json_arena.h"
+#include "web_arena.h"
+#include "time_sync.h"
+#include "debug.h"
+#include <WiFi.h>
+#include <Preferences.h>
+#include "esp_now.h"
+#include "esp_wifi.h"
+#include "esp_random.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+
+static_assert(sizeof(EspNowFrame) == 40, "ESP-NOW frame layout is on the air");
+
+static const uint32_t TASK_STACK = 4096;
+static const uint8_t RX_QUEUE_DEPTH = 16;
+static const uint32_t POLL_MS = 100;             ///< Alarm level check and RX wait
+static const uint32_t CHANNEL_CHECK_MS = 5000;   ///< Back to our channel after a WiFi scan moved the radio
+static const uint8_t WINDOW_BITS = 32;
+static const uint8_t BROADCAST[6] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+static const char* const ROLE_NAMES[ESPNOW_ROLE_COUNT] = {"off", "node", "hub"};
+
+struct RxItem {
+    uint8_t from[6];
+    EspNowFrame frame;
+};
+
+/// Replay window of one origin, and what the hub shows of it
+struct OriginEntry {
+    bool used;
+    uint16_t bootId;
+    uint32_t highSequence;
+    uint32_t window;        ///< Bit i: highSequence - i received
+    EspNowNode node;
+};
+
+static EspNowSource readingsSource = nullptr;
+static volatile uint8_t role = ESPNOW_ROLE_OFF;
+static uint8_t channel = ESPNOW_CHANNEL;
+static bool espNowUp = false;
+static bool hubAccessPoint = false;
+static QueueHandle_t rxQueue = nullptr;
+static TaskHandle_t taskHandle = nullptr;
+static SemaphoreHandle_t tableMutex = nullptr;
+static OriginEntry origins[ESPNOW_MAX_NODES];
+static EspNowStats stats;
+
+// Tags of the frames in flight, in send order: the send callback reports
+// frames in the order they were queued. WiFi task pops, ESP-NOW task pushes.
+static const uint8_t SENT_TAGS = 32;
+static uint8_t sentTags[SENT_TAGS];
+static volatile uint8_t sentHead = 0;
+static volatile uint8_t sentTail = 0;
+
+// ESP-NOW task only
+static uint8_t ownMac[6];
+static uint16_t bootId = 0;
+static uint32_t nextSequence = 1;
+static uint32_t lastTotalCounts = 0;
+static uint32_t lastIntervalMs = 0;
+static uint8_t lastAlarmLevel = 0;
+
+static void onReceive(const uint8_t* mac, const uint8_t* data, int length) {
+    int64_t rxUs = esp_timer_get_time(); // First, for time sync
+    uint16_t magic = 0;
+    if (length >= (int)sizeof(magic)) memcpy(&magic, data, sizeof(magic));
+    if (magic == TIME_SYNC_MAGIC) {
+        timeSyncReceive(mac, data, length, rxUs);
+        return;
+    }
+    if (length != sizeof(EspNowFrame) || !rxQueue) {
+        stats.dropped++;
+        return;
+    }
+    RxItem item;
+    memcpy(item.from, mac, sizeof(item.from));
+    memcpy(&item.frame, data, sizeof(item.frame));
+    if (xQueueSend(rxQueue, &item, 0) != pdTRUE) stats.dropped++;
+}
+
+static void onSent(const uint8_t* mac, esp_now_send_status_t status) {
+    int64_t txUs = esp_timer_get_time();
+    if (status != ESP_NOW_SEND_SUCCESS) stats.sendFailures++;
+    if (sentTail == sentHead) return;
+    uint8_t tag = sentTags[sentTail];
+    sentTail = (sentTail + 1) % SENT_TAGS;
+    if (tag != TIME_SYNC_TAG_NONE) timeSyncSent(tag, txUs, status == ESP_NOW_SEND_SUCCESS);
+}
+
+static bool transmit(const void* data, size_t length, uint8_t tag) {
+    uint8_t head = sentHead;
+    uint8_t next = (head + 1) % SENT_TAGS;
+    if (next == sentTail) { // Callbacks lost; a stale tag would stamp the wrong frame
+        sentTail = head;
+    }
+    sentTags[head] = tag;
+    sentHead = next;
+    if (esp_now_send(BROADCAST, (const uint8_t*)data, length) == ESP_OK) {
+        stats.sent++;
+        return true;
+    }
+    sentHead = head; // No callback follows a refused frame
+    stats.sendFailures++;
+    return false;
+}
+
+static void send(const EspNowFrame& frame) {
+    transmit(&frame, sizeof(frame), TIME_SYNC_TAG_NONE);
+}
+
+bool espNowSendTagged(const void* data, size_t length, uint8_t tag) {
+    return espNowUp && transmit(data, length, tag);
+}
+
+/**
+ * @brief Moves the radio to our channel unless an access point decides it.
+ */
+static void applyChannel() {
+    if (wifiManagerState() == WIFI_STATE_CONNECTED || wifiManagerState() == WIFI_STATE_CONNECTING) return;
+    uint8_t current;
+    wifi_second_chan_t second;
+    if (esp_wifi_get_channel(&current, &second) == ESP_OK && current == channel) return;
+    esp_wifi_set_promiscuous(true);
+    esp_wifi_set_channel(channel, WIFI_SECOND_CHAN_NONE);
+    esp_wifi_set_promiscuous(false);
+}
+
+static bool startEspNow() {
+    if (espNowUp) return true;
+    if (esp_now_init() != ESP_OK) return false;
+    esp_now_register_recv_cb(onReceive);
+    esp_now_register_send_cb(onSent);
+    esp_now_peer_info_t peer;
+    memset(&peer, 0, sizeof(peer));
+    memcpy(peer.peer_addr, BROADCAST, sizeof(BROADCAST));
+    peer.channel = 0; // The current channel
+    peer.ifidx = WIFI_IF_STA;
+    peer.encrypt = false;
+    if (esp_now_add_peer(&peer) != ESP_OK) {
+        esp_now_deinit();
+        return false;
+    }
+    espNowUp = true;
+    applyChannel();
+    wifiPowerHold(WIFI_WAKE_ESPNOW);
+    return true;
+}
+
+static void stopEspNow() {
+    if (!espNowUp) return;
+    esp_now_deinit();
+    espNowUp = false;
+    wifiPowerRelease(WIFI_WAKE_ESPNOW);
+}
+
+/**
+ * @brief Table entry of @p origin, reusing the longest silent one when full (tableMutex held).
+ */
+static OriginEntry* findOrigin(const uint8_t* origin) {
+    OriginEntry* oldest = &origins[0];
+    for (uint8_t i = 0; i < ESPNOW_MAX_NODES; i++) {
+        OriginEntry& e = origins[i];
+        if (e.used && memcmp(e.node.origin, origin, 6) == 0) return &e;
+        if (!e.used) {
+            oldest = &e;
+        } else if (oldest->used && (int32_t)(e.node.lastSeenMs - oldest->node.lastSeenMs) < 0) {
+            oldest = &e;
+        }
+    }
+    memset(oldest, 0, sizeof(*oldest));
+    oldest->used = true;
+    memcpy(oldest->node.origin, origin, 6);
+    return oldest;
+}
+
+/**
+ * @brief Replay check; marks the sequence received (tableMutex held).
+ * @return false for a frame already seen or too old to tell
+ */
+static bool acceptSequence(OriginEntry& e, const EspNowFrame& frame) {
+    if (e.node.frames == 0 || e.bootId != frame.bootId) {
+        e.bootId = frame.bootId; // First frame, or the origin restarted
+        e.highSequence = frame.sequence;
+        e.window = 1;
+        return true;
+    }
+    if (frame.sequence > e.highSequence) {
+        uint32_t shift = frame.sequence - e.highSequence;
+        e.node.missed += shift - 1;
+        e.window = shift >= WINDOW_BITS ? 1 : (e.window << shift) | 1;
+        e.highSequence = frame.sequence;
+        return true;
+    }
+    uint32_t age = e.highSequence - frame.sequence;
+    if (age >= WINDOW_BITS || (e.window & (1UL << age))) return false;
+    e.window |= 1UL << age; // Late, by another path
+    if (e.node.missed) e.node.missed--;
+    return true;
+}
+
+static void receive(const RxItem& item) {
+    const EspNowFrame& frame = item.frame;
+    if (frame.magic != ESPNOW_FRAME_MAGIC || frame.version != ESPNOW_FRAME_VERSION ||
+        memcmp(frame.origin, ownMac, 6) == 0) {
+        stats.dropped++; // Our own frame relayed back counts as a duplicate
+        return;
+    }
+    stats.received++;
+
+    xSemaphoreTake(tableMutex, portMAX_DELAY);
+    OriginEntry* e = findOrigin(frame.origin);
+    bool fresh = acceptSequence(*e, frame);
+    if (fresh) {
+        uint8_t previousLevel = e->node.frames ? e->node.last.alarmLevel : 0;
+        e->node.last = frame;
+        memcpy(e->node.via, item.from, 6);
+        e->node.lastSeenMs = millis();
+        e->node.frames++;
+        if (role == ESPNOW_ROLE_HUB && frame.alarmLevel > previousLevel) {
+            DEBUG_PRINTF("ESP-NOW: %02X:%02X:%02X:%02X:%02X:%02X alarm %s (%.2f uSv/h, %u hops)\n",
+                         frame.origin[0], frame.origin[1], frame.origin[2], frame.origin[3], frame.origin[4],
+                         frame.origin[5], alarmLevelName(frame.alarmLevel), frame.doseRateUsvH, frame.hops);
+        }
+    } else {
+        e->node.duplicates++;
+    }
+    xSemaphoreGive(tableMutex);
+    if (!fresh) {
+        stats.dropped++;
+        return;
+    }
+
+    if (frame.ttl > 0) {
+        // Neighbours that heard the same frame spread their relays apart
+        vTaskDelay(pdMS_TO_TICKS(esp_random() % (ESPNOW_RELAY_JITTER_MS + 1)));
+        EspNowFrame relay = frame;
+        relay.ttl--;
+        relay.hops++;
+        send(relay);
+        stats.relayed++;
+    }
+}
+
+static void sendOwn(uint8_t type, const EspNowReadings& readings, uint32_t nowMs) {
+    EspNowFrame frame;
+    memset(&frame, 0, sizeof(frame));
+    frame.magic = ESPNOW_FRAME_MAGIC;
+    frame.version = ESPNOW_FRAME_VERSION;
+    frame.type = type;
+    memcpy(frame.origin, ownMac, 6);
+    frame.ttl = ESPNOW_TTL;
+    frame.bootId = bootId;
+    frame.sequence = nextSequence++;
+    frame.uptime = timeBaseSeconds();
+    frame.doseRateUsvH = readings.doseRateUsvH;
+    frame.cpm = readings.cpm;
+    frame.counts = readings.totalCounts - lastTotalCounts;
+    frame.seconds = (uint16_t)((nowMs - lastIntervalMs + 500) / 1000);
+    frame.alarmLevel = readings.alarmLevel;
+    frame.batteryPct = readings.batteryPct;
+
+    // Broadcasts are not acknowledged; an alarm goes out more than once, the receivers drop the copies
+    uint8_t copies = type == ESPNOW_FRAME_ALARM ? ESPNOW_ALARM_REPEATS : 1;
+    for (uint8_t i = 0; i < copies; i++) {
+        if (i) vTaskDelay(pdMS_TO_TICKS(ESPNOW_REPEAT_MS));
+        send(frame);
+    }
+}
+
+static void espNowTask(void* parameter) {
+    uint32_t lastChannelCheckMs = 0;
+    bool primed = false;  ///< Interval started; the first one begins when the link does
+    for (;;) {
+        RxItem item;
+        bool got = xQueueReceive(rxQueue, &item, pdMS_TO_TICKS(POLL_MS)) == pdTRUE;
+        if (role == ESPNOW_ROLE_OFF || !espNowUp) {
+            primed = false;
+            continue;
+        }
+        if (got) receive(item);
+
+        uint32_t nowMs = millis();
+        timeSyncPoll(role, ownMac, nowMs);
+        if (nowMs - lastChannelCheckMs >= CHANNEL_CHECK_MS) {
+            lastChannelCheckMs = nowMs;
+            applyChannel();
+        }
+
+        EspNowReadings readings;
+        readingsSource(readings);
+        if (!primed) {
+            primed = true;
+            lastTotalCounts = readings.totalCounts;
+            lastIntervalMs = nowMs;
+            lastAlarmLevel = readings.alarmLevel;
+            continue;
+        }
+        bool alarmChanged = readings.alarmLevel != lastAlarmLevel;
+        if (alarmChanged || nowMs - lastIntervalMs >= ESPNOW_INTERVAL_S * 1000UL) {
+            sendOwn(alarmChanged ? ESPNOW_FRAME_ALARM : ESPNOW_FRAME_INTERVAL, readings, nowMs);
+            lastAlarmLevel = readings.alarmLevel;
+            lastTotalCounts = readings.totalCounts;
+            lastIntervalMs = nowMs;
+        }
+    }
+}
+
+void initEspNowLink(EspNowSource source) {
+    if (taskHandle) return;
+    readingsSource = source;
+    Preferences prefs;
+    prefs.begin("espnow", true);
+    uint8_t savedRole = prefs.getUChar("role", ESPNOW_ROLE_OFF);
+    uint8_t savedChannel = prefs.getUChar("channel", ESPNOW_CHANNEL);
+    prefs.end();
+
+    WiFi.macAddress(ownMac);
+    bootId = (uint16_t)esp_random();
+    tableMutex = xSemaphoreCreateMutex();
+    rxQueue = xQueueCreate(RX_QUEUE_DEPTH, sizeof(RxItem));
+    if (!tableMutex || !rxQueue) return;
+    if (xTaskCreatePinnedToCore(espNowTask, "EspNow", TASK_STACK, NULL, NETWORK_TASK_PRIORITY, &taskHandle,
+                                TASK_CORE_NETWORK) != pdPASS) {
+        DEBUG_PRINTLN("Error: ESP-NOW task not created");
+        return;
+    }
+    if (savedRole != ESPNOW_ROLE_OFF) espNowSetRole((EspNowRole)savedRole, savedChannel);
+}
+
+/**
+ * @brief The hub's own access point on the ring's channel, so its dashboard is reachable without one.
+ */
+static void setHubAccessPoint(bool on) {
+#if ESPNOW_HUB_AP
+    if (on && !hubAccessPoint) {
+        WiFi.mode(WIFI_AP_STA);
+        hubAccessPoint = WiFi.softAP(mdnsHostname(), ESPNOW_HUB_AP_PASSWORD, channel);
+        if (!hubAccessPoint) {
+            DEBUG_PRINTLN("ESP-NOW: hub access point not started");
+            return;
+        }
+        DEBUG_PRINTF("ESP-NOW: hub access point %s at %s\n", mdnsHostname(), WiFi.softAPIP().toString().c_str());
+        webServiceBegin();
+    } else if (!on && hubAccessPoint) {
+        WiFi.softAPdisconnect(true);
+        WiFi.mode(WIFI_STA);
+        hubAccessPoint = false;
+    }
+#endif
+}
+
+bool espNowSetRole(EspNowRole next, uint8_t nextChannel) {
+    if (!taskHandle || next >= ESPNOW_ROLE_COUNT || nextChannel > 13) return false;
+    if (nextChannel) channel = nextChannel;
+    if (next == ESPNOW_ROLE_OFF) {
+        role = next;
+        stopEspNow();
+    } else {
+        if (!startEspNow()) return false;
+        applyChannel();
+        role = next;
+    }
+    setHubAccessPoint(next == ESPNOW_ROLE_HUB);
+    stats.role = role;
+    stats.channel = channel;
+
+    Preferences prefs;
+    prefs.begin("espnow", false);
+    prefs.putUChar("role", (uint8_t)next);
+    prefs.putUChar("channel", channel);
+    prefs.end();
+    DEBUG_PRINTF("ESP-NOW: %s on channel %u\n", espNowRoleName(next), channel);
+    return true;
+}
+
+EspNowStats getEspNowStats() {
+    EspNowStats s = stats;
+    s.role = role;
+    s.channel = channel;
+    return s;
+}
+
+const char* espNowRoleName(uint8_t value) {
+    return value < ESPNOW_ROLE_COUNT ? ROLE_NAMES[value] : "?";
+}
+
+size_t getEspNowNodes(EspNowNode* out, size_t maxCount) {
+    if (!tableMutex || role != ESPNOW_ROLE_HUB) return 0;
+    size_t n = 0;
+    uint32_t nowMs = millis();
+    xSemaphoreTake(tableMutex, portMAX_DELAY);
+    for (uint8_t i = 0; i < ESPNOW_MAX_NODES && n < maxCount; i++) {
+        const OriginEntry& e = origins[i];
+        if (e.used && nowMs - e.node.lastSeenMs < ESPNOW_NODE_TIMEOUT_S * 1000UL) out[n++] = e.node;
+    }
+    xSemaphoreGive(tableMutex);
+    return n;
+}
+
+uint8_t espNowRemoteAlarmLevel() {
+    if (!tableMutex || role != ESPNOW_ROLE_HUB) return 0;
+    uint8_t level = 0;
+    uint32_t nowMs = millis();
+    xSemaphoreTake(tableMutex, portMAX_DELAY);
+    for (uint8_t i = 0; i < ESPNOW_MAX_NODES; i++) {
+        const OriginEntry& e = origins[i];
+        if (e.used && nowMs - e.node.lastSeenMs < ESPNOW_NODE_TIMEOUT_S * 1000UL && e.node.last.alarmLevel > level) {
+            level = e.node.last.alarmLevel;
+        }
+    }
+    xSemaphoreGive(tableMutex);
+    return level;
+}
+
+static void formatMac(char* out, size_t size, const uint8_t* mac) {
+    snprintf(out, size, "%02X:%02X:%02X:%02X:%02X:%02X", mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+}
+
+void espNowAttach(WebServer& server) {
+    server.on("/api/nodes", HTTP_GET, [&server]() {
+        static EspNowNode nodes[ESPNOW_MAX_NODES]; // Web task only; kept off its stack
+        size_t n = getEspNowNodes(nodes, ESPNOW_MAX_NODES);
+        uint32_t nowMs = millis();
+        JsonArenaLease lease;
+        JsonDocument doc(lease.allocator());
+        doc["role"] = espNowRoleName(role);
+        doc["channel"] = channel;
+        buildTimeSyncJson(doc["mesh_time"].to<JsonObject>());
+        JsonArray list = doc["nodes"].to<JsonArray>();
+        for (size_t i = 0; i < n; i++) {
+            const EspNowNode& node = nodes[i];
+            char mac[18];
+            JsonObject obj = list.add<JsonObject>();
+            formatMac(mac, sizeof(mac), node.origin);
+            obj["id"] = mac;
+            formatMac(mac, sizeof(mac), node.via);
+            obj["via"] = mac;
+            obj["age_s"] = (nowMs - node.lastSeenMs) / 1000;
+            obj["hops"] = node.last.hops;
+            obj["rate"] = node.last.doseRateUsvH;
+            obj["cpm"] = node.last.cpm;
+            obj["counts"] = node.last.counts;
+            obj["seconds"] = node.last.seconds;
+            obj["alarm"] = alarmLevelName(node.last.alarmLevel);
+            if (node.last.batteryPct != 255) obj["battery"] = node.last.batteryPct;
+            obj["frames"] = node.frames;
+            obj["missed"] = node.missed;
+        }
+        server.sendHeader("Cache-Control", "no-store");
+        server.sendHeader("Access-Control-Allow-Origin", "*");
+        webSendJson(server, 200, doc);
+    });
+}
+
+void printEspNowLink(Print& out) {
+    EspNowStats s = getEspNowStats();
+    out.printf("ESP-NOW: %s, channel %u, %lu sent (%lu failed), %lu received, %lu relayed, %lu dropped\n",
+               espNowRoleName(s.role), s.channel, (unsigned long)s.sent, (unsigned long)s.sendFailures,
+               (unsigned long)s.received, (unsigned long)s.relayed, (unsigned long)s.dropped);
+    EspNowNode nodes[ESPNOW_MAX_NODES];
+    size_t n = getEspNowNodes(nodes, ESPNOW_MAX_NODES);
+    uint32_t nowMs = millis();
+    for (size_t i = 0; i < n; i++) {
+        const EspNowNode& node = nodes[i];
+        char mac[18];
+        formatMac(mac, sizeof(mac), node.origin);
+        out.printf("  %s: %.3f uSv/h, %.0f CPM, alarm %s, %u hops, %lu s ago, %lu frames, %lu missed\n", mac,
+                   node.last.doseRateUsvH, node.last.cpm, alarmLevelName(node.last.alarmLevel), node.last.hops,
+                   (unsigned long)((nowMs - node.lastSeenMs) / 1000), (unsigned long)node.frames,
+                   (unsigned long)node.missed);
+    }
+    if (s.role != ESPNOW_ROLE_OFF) printTimeSync(out);
+}
@@ -0,0 +1,129 @@
+#ifndef ESPNOW_LINK_H
+#define ESPNOW_LINK_H
+
+#include <Arduino.h>
+#include <WebServer.h>
+#include "config.h"
+
+// ESP-NOW relay for rings of detectors without an access point.
+// Every unit in node or hub role broadcasts one EspNowFrame per
+// ESPNOW_INTERVAL_S with its rate and the counts of the interval. A change of
+// alarm level is broadcast at once. Frames are flooded through the ring:
+// a unit that hears a frame for the first time rebroadcasts it with the TTL
+// decreased, so units out of the hub's range still reach it. The hub keeps
+// the latest frame of each origin and serves them at /api/nodes and "espnow".
+//
+// Deduplication: each origin numbers its frames, and a random boot id
+// restarts the numbering after a reset. A receiver keeps, per origin, the
+// highest sequence and a 32-frame window below it. A frame already in the
+// window is a repeat or a relayed copy and is dropped, so floods end.
+// Broadcasts are not acknowledged, so alarm frames are sent
+// ESPNOW_ALARM_REPEATS times ESPNOW_REPEAT_MS apart with the same sequence.
+// Interval frames are sent once; the next interval supersedes them.
+//
+// ESP-NOW uses the radio's current channel. A unit that is not connected to
+// an access point is put on ESPNOW_CHANNEL (or the one given to "espnow").
+// With ESPNOW_HUB_AP the hub also opens an access point of its own on that
+// channel (SSID: its mDNS name) and starts the web service, so its dashboard
+// and /api/nodes are reachable where there is no infrastructure. A hub that
+// joins an existing network instead moves to that network's channel (the
+// radio has one), and the nodes must be set to it. While the link runs it
+// holds a WiFi wake window (wifi_power.h), because modem sleep would miss
+// broadcasts.
+//
+// The link also carries the mesh time exchanges (time_sync.h), told apart by
+// their magic.
+
+enum EspNowRole {
+    ESPNOW_ROLE_OFF = 0,
+    ESPNOW_ROLE_NODE,   ///< Broadcasts its own frames and relays others
+    ESPNOW_ROLE_HUB,    ///< ... and aggregates every origin it hears
+    ESPNOW_ROLE_COUNT
+};
+
+enum EspNowFrameType {
+    ESPNOW_FRAME_INTERVAL = 1,
+    ESPNOW_FRAME_ALARM = 2
+};
+
+#define ESPNOW_FRAME_MAGIC   0x5244 // "RD"
+#define ESPNOW_FRAME_VERSION 1
+
+// On-air record, little-endian.
+struct EspNowFrame {
+    uint16_t magic;
+    uint8_t version;
+    uint8_t type;           ///< EspNowFrameType
+    uint8_t origin[6];      ///< MAC of the detector that measured
+    uint8_t ttl;            ///< Relays left
+    uint8_t hops;           ///< Relays taken
+    uint16_t bootId;        ///< Random per boot of the origin
+    uint16_t reserved;
+    uint32_t sequence;      ///< Per origin and boot, from 1
+    uint32_t uptime;        ///< Origin's seconds since boot
+    float doseRateUsvH;
+    float cpm;              ///< Dead-time corrected
+    uint32_t counts;        ///< In the interval
+    uint16_t seconds;       ///< Interval length
+    uint8_t alarmLevel;     ///< AlarmLevel
+    uint8_t batteryPct;     ///< 255 if unknown
+};
+
+// Readings of this unit, copied by the source function (ESP-NOW task).
+struct EspNowReadings {
+    float doseRateUsvH;
+    float cpm;
+    uint32_t totalCounts;   ///< Since boot
+    uint8_t alarmLevel;
+    uint8_t batteryPct;     ///< 255 if unknown
+};
+
+typedef void (*EspNowSource)(EspNowReadings& out);
+
+// One origin as the hub last heard it.
+struct EspNowNode {
+    uint8_t origin[6];
+    uint8_t via[6];         ///< Last hop the newest frame came from
+    EspNowFrame last;
+    uint32_t lastSeenMs;
+    uint32_t frames;        ///< Distinct frames accepted
+    uint32_t duplicates;    ///< Repeats and relayed copies dropped
+    uint32_t missed;        ///< Sequence numbers never received
+};
+
+struct EspNowStats {
+    uint8_t role;
+    uint8_t channel;
+    uint32_t sent;
+    uint32_t sendFailures;
+    uint32_t received;
+    uint32_t relayed;
+    uint32_t dropped;       ///< Duplicates, malformed frames, full queue
+};
+
+// Loads the role and channel from Preferences ("espnow" namespace) and starts
+// the link unless it is off. Call in setup() after the WiFi manager.
+void initEspNowLink(EspNowSource source);
+
+// Switches role (and channel, 0 keeps it). Saved to Preferences. UI task.
+bool espNowSetRole(EspNowRole role, uint8_t channel);
+
+EspNowStats getEspNowStats();
+const char* espNowRoleName(uint8_t role);
+
+// Origins heard within ESPNOW_NODE_TIMEOUT_S (hub). @return the number copied
+size_t getEspNowNodes(EspNowNode* out, size_t maxCount);
+
+// Highest alarm level among the live origins; 0 when none or not a hub.
+uint8_t espNowRemoteAlarmLevel();
+
+// Broadcasts a frame of another protocol on the link (time_sync.h). A non-zero
+// @p tag is reported with the send time once the frame has left. ESP-NOW task.
+bool espNowSendTagged(const void* data, size_t length, uint8_t tag);
+
+// Registers GET /api/nodes.
+void espNowAttach(WebServer& server);
+
+void printEspNowLink(Print& out);
+
+#endif // ESPNOW_LINK_H
@@ -0,0 +1,227 @@
+/**
+ * @file ethernet_link.cpp
+ * @brief W5500 Ethernet over SPI through the IDF Ethernet driver.
+ *
+ * The Arduino ETH class of this core drives only RMII PHYs, so the SPI MAC
+ * and PHY of the W5500 are created here directly. The driver's receive task
+ * moves frames to lwIP on its own; this module only keeps the link state.
+ */
+
+#include "ethernet_link.h"
+#include "wifi_manager.h"
+#include "debug.h"
+#include <WiFi.h>
+#include "esp_eth.h"
+#include "esp_netif.h"
+#include "esp_event.h"
+#include "esp_mac.h"
+#include "driver/gpio.h"
+#include "driver/spi_master.h"
+
+static EthLinkHandler linkHandler = nullptr;
+static esp_netif_t* netif = nullptr;
+static volatile bool linkUpEvent = false;
+static volatile bool linkDownEvent = false;
+static volatile bool gotIpEvent = false;
+static volatile uint32_t ethIp = 0;        ///< Set with the address event, cleared on link down
+static EthLinkState state = ETH_LINK_OFF;
+static EthLinkStats stats;                 ///< UI task
+static uint32_t linkUpMs = 0;
+
+static void onEthEvent(void* arg, esp_event_base_t base, int32_t id, void* data) {
+    if (base == ETH_EVENT) {
+        if (id == ETHERNET_EVENT_CONNECTED) {
+            linkUpEvent = true;
+        } else if (id == ETHERNET_EVENT_DISCONNECTED) {
+            ethIp = 0;
+            linkDownEvent = true;
+        }
+    } else if (base == IP_EVENT && id == IP_EVENT_ETH_GOT_IP) {
+        ethIp = ((ip_event_got_ip_t*)data)->ip_info.ip.addr;
+        gotIpEvent = true;
+    }
+}
+
+static void setState(EthLinkState next, uint32_t nowMs) {
+    state = next;
+    stats.state = next;
+    stats.stateSinceMs = nowMs;
+    if (linkHandler) linkHandler(next);
+}
+
+#if CONFIG_ETH_SPI_ETHERNET_W5500
+/**
+ * @brief Undo a partial installDriver(): detach the W5500 and release the bus.
+ */
+static void releaseBus(spi_device_handle_t spi) {
+    spi_bus_remove_device(spi);
+    spi_bus_free(ETH_SPI_HOST);
+}
+
+/**
+ * @brief Bus, SPI device, MAC and PHY of the W5500; nullptr if any step fails.
+ */
+static esp_eth_handle_t installDriver() {
+    spi_bus_config_t bus;
+    memset(&bus, 0, sizeof(bus));
+    bus.sclk_io_num = ETH_PIN_SCLK;
+    bus.mosi_io_num = ETH_PIN_MOSI;
+    bus.miso_io_num = ETH_PIN_MISO;
+    bus.quadwp_io_num = -1;
+    bus.quadhd_io_num = -1;
+    if (spi_bus_initialize(ETH_SPI_HOST, &bus, SPI_DMA_CH_AUTO) != ESP_OK) return nullptr;
+
+    // The W5500 frame: 16-bit address phase, 8-bit control phase, then data
+    spi_device_interface_config_t device;
+    memset(&device, 0, sizeof(device));
+    device.command_bits = 16;
+    device.address_bits = 8;
+    device.mode = 0;
+    device.clock_speed_hz = ETH_SPI_CLOCK_MHZ * 1000 * 1000;
+    device.spics_io_num = ETH_PIN_CS;
+    device.queue_size = 20;
+    spi_device_handle_t spi = nullptr;
+    if (spi_bus_add_device(ETH_SPI_HOST, &device, &spi) != ESP_OK) {
+        spi_bus_free(ETH_SPI_HOST);
+        return nullptr;
+    }
+
+    // The driver waits on the chip's interrupt line through the GPIO ISR service
+    esp_err_t isr = gpio_install_isr_service(ESP_INTR_FLAG_IRAM);
+    if (isr != ESP_OK && isr != ESP_ERR_INVALID_STATE) {
+        releaseBus(spi);
+        return nullptr;
+    }
+
+    eth_w5500_config_t w5500 = ETH_W5500_DEFAULT_CONFIG(spi);
+    w5500.int_gpio_num = ETH_PIN_INT;
+    eth_mac_config_t macConfig = ETH_MAC_DEFAULT_CONFIG();
+    eth_phy_config_t phyConfig = ETH_PHY_DEFAULT_CONFIG();
+    phyConfig.reset_gpio_num = ETH_PIN_RST;
+    esp_eth_mac_t* mac = esp_eth_mac_new_w5500(&w5500, &macConfig);
+    esp_eth_phy_t* phy = esp_eth_phy_new_w5500(&phyConfig);
+    if (!mac || !phy) {
+        if (phy) phy->del(phy);
+        if (mac) mac->del(mac);
+        releaseBus(spi);
+        return nullptr;
+    }
+
+    esp_eth_config_t config = ETH_DEFAULT_CONFIG(mac, phy);
+    esp_eth_handle_t handle = nullptr;
+    if (esp_eth_driver_install(&config, &handle) != ESP_OK) {
+        phy->del(phy);
+        mac->del(mac);
+        releaseBus(spi);
+        return nullptr;
+    }
+    // The W5500 has no address of its own; it takes the one eFuse reserves for Ethernet
+    uint8_t address[6];
+    esp_read_mac(address, ESP_MAC_ETH);
+    esp_eth_ioctl(handle, ETH_CMD_S_MAC_ADDR, address);
+    return handle;
+}
+#endif
+
+bool initEthernetLink(EthLinkHandler handler) {
+    linkHandler = handler;
+    if (!ETH_ENABLED) return false;
+#if CONFIG_ETH_SPI_ETHERNET_W5500
+    if (ETH_PIN_SCLK < 0 || ETH_PIN_MOSI < 0 || ETH_PIN_MISO < 0 || ETH_PIN_CS < 0 || ETH_PIN_INT < 0) {
+        DEBUG_PRINTLN("Ethernet: ETH_PIN_* not set");
+        return false;
+    }
+    esp_eth_handle_t handle = installDriver();
+    if (!handle) {
+        DEBUG_PRINTLN("Ethernet: W5500 not found");
+        return false;
+    }
+    esp_netif_config_t netifConfig = ESP_NETIF_DEFAULT_ETH();
+    netif = esp_netif_new(&netifConfig);
+    esp_netif_attach(netif, esp_eth_new_netif_glue(handle));
+    esp_event_handler_register(ETH_EVENT, ESP_EVENT_ANY_ID, onEthEvent, nullptr);
+    esp_event_handler_register(IP_EVENT, IP_EVENT_ETH_GOT_IP, onEthEvent, nullptr);
+    if (esp_eth_start(handle) != ESP_OK) {
+        DEBUG_PRINTLN("Ethernet: driver not started");
+        return false;
+    }
+    state = ETH_LINK_DOWN;
+    stats.state = state;
+    stats.stateSinceMs = millis();
+    DEBUG_PRINTF("Ethernet: W5500 on SPI%d at %d MHz\n", (int)ETH_SPI_HOST + 1, (int)ETH_SPI_CLOCK_MHZ);
+    return true;
+#else
+    DEBUG_PRINTLN("Ethernet: the W5500 driver is not in this core's build");
+    return false;
+#endif
+}
+
+void ethernetLinkLoop(uint32_t nowMs) {
+    if (state == ETH_LINK_OFF) return;
+    if (linkDownEvent) {
+        linkDownEvent = false;
+        linkUpEvent = false; // A bounce in between ends down
+        gotIpEvent = false;
+        if (state != ETH_LINK_DOWN) {
+            stats.linkDowns++;
+            DEBUG_PRINTLN("Ethernet: link down");
+            setState(ETH_LINK_DOWN, nowMs);
+        }
+    }
+    if (linkUpEvent) {
+        linkUpEvent = false;
+        if (state == ETH_LINK_DOWN) {
+            stats.linkUps++;
+            linkUpMs = nowMs;
+            DEBUG_PRINTLN("Ethernet: link up");
+            setState(ETH_LINK_UP, nowMs);
+        }
+    }
+    if (gotIpEvent) {
+        gotIpEvent = false;
+        if (state != ETH_LINK_DOWN && ethIp) {
+            // A renewal with a new address is announced like a first one
+            if (state == ETH_LINK_UP) stats.dhcpMs = nowMs - linkUpMs;
+            DEBUG_PRINTF("Ethernet: online at %s\n", IPAddress((uint32_t)ethIp).toString().c_str());
+            setState(ETH_LINK_ONLINE, nowMs);
+        }
+    }
+}
+
+EthLinkState ethernetLinkState() {
+    return state;
+}
+
+bool ethernetLinkOnline() {
+    return state == ETH_LINK_ONLINE;
+}
+
+bool networkOnline() {
+    return state == ETH_LINK_ONLINE || wifiManagerState() == WIFI_STATE_CONNECTED;
+}
+
+IPAddress networkLocalIP() {
+    uint32_t ip = ethIp;
+    if (state == ETH_LINK_ONLINE && ip) return IPAddress(ip);
+    return WiFi.localIP();
+}
+
+EthLinkStats getEthLinkStats() {
+    return stats;
+}
+
+void printEthernetLink(Print& out) {
+    static const char* const NAMES[] = {"off", "down", "up, waiting for DHCP", "online"};
+    if (!ETH_ENABLED) {
+        out.println("Ethernet: off (ETH_ENABLED)");
+        return;
+    }
+    EthLinkStats s = getEthLinkStats();
+    out.printf("Ethernet: %s for %lu s", s.state <= ETH_LINK_ONLINE ? NAMES[s.state] : "?",
+               (unsigned long)((millis() - s.stateSinceMs) / 1000));
+    if (s.state == ETH_LINK_ONLINE) out.printf(", %s", networkLocalIP().toString().c_str());
+    out.println();
+    if (s.state == ETH_LINK_OFF) return;
+    out.printf("  %lu link ups, %lu link downs; last DHCP %lu ms; WiFi %s\n", (unsigned long)s.linkUps,
+               (unsigned long)s.linkDowns, (unsigned long)s.dhcpMs, wifiManagerSuspended() ? "off" : "on");
+}
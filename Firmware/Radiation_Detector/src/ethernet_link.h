@@ -0,0 +1,62 @@
+#ifndef ETHERNET_LINK_H
+#define ETHERNET_LINK_H
+
+#include <Arduino.h>
+#include <IPAddress.h>
+#include "config.h"
+
+// Wired Ethernet through a WIZnet W5500 on ETH_SPI_HOST (ETH_ENABLED), for
+// fixed installations. The IDF Ethernet driver runs the chip over SPI with
+// DMA and attaches it to lwIP as a second interface, so every service that
+// listens on INADDR_ANY or opens a client socket (web service, HTTPS, HTTP
+// telemetry, UDP stream, Modbus, syslog, SNTP, mDNS) works over it unchanged.
+// The driver's events only set flags; ethernetLinkLoop() advances the link
+// state on the UI task and calls the handler, as wifi_manager.h does, and the
+// handler brings the services up the same way a WiFi connection does.
+//
+// While the link is online WiFi is off entirely (wifiManagerSuspend()):
+// station, scans and ESP-NOW. It comes back, and rejoins the network it had,
+// when the cable is pulled or the switch goes down.
+//
+// networkOnline() and networkLocalIP() are the "is there a network" and "our
+// address" of modules that do not care which link carries it.
+
+enum EthLinkState {
+    ETH_LINK_OFF = 0,         ///< Disabled, or the chip did not answer
+    ETH_LINK_DOWN,            ///< No cable or no link partner
+    ETH_LINK_UP,              ///< Link, waiting for DHCP
+    ETH_LINK_ONLINE           ///< Link and an address
+};
+
+typedef void (*EthLinkHandler)(EthLinkState state);
+
+struct EthLinkStats {
+    uint8_t state;            ///< EthLinkState
+    uint32_t linkUps;
+    uint32_t linkDowns;
+    uint32_t stateSinceMs;
+    uint32_t dhcpMs;          ///< Link up to address, last time
+};
+
+// Starts the SPI bus, the W5500 driver and its network interface. Call once
+// in setup(), after wifiManagerBegin() (the TCP/IP stack and the event loop);
+// false when disabled, pins are unset or the chip does not answer.
+bool initEthernetLink(EthLinkHandler handler);
+
+// Applies link and address events and calls the handler on a change. UI task
+// loop, next to wifiManagerLoop().
+void ethernetLinkLoop(uint32_t nowMs);
+
+EthLinkState ethernetLinkState();
+bool ethernetLinkOnline();
+
+// Ethernet online, or WiFi connected.
+bool networkOnline();
+
+// The Ethernet address while it is online, otherwise the WiFi station's.
+IPAddress networkLocalIP();
+
+EthLinkStats getEthLinkStats();
+void printEthernetLink(Print& out);
+
+#endif // ETHERNET_LINK_H
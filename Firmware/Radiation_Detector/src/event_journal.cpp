@@ -0,0 +1,411 @@
+/**
+ * @file event_journal.cpp
+ * @brief RTC ring of events, its batched spill to NVS, the web endpoint and serial report.
+ *
+ * The ring slot of an event is fixed by its sequence number (sequence modulo
+ * the ring size), and so is its place in the NVS pages, so neither needs an
+ * index: a slot or page entry holds an event if it carries that sequence.
+ * Writers of the ring (any task) and of the page copy (loopTask) hold
+ * journalLock for one event at a time; the NVS write itself runs outside it.
+ * Only loopTask writes the page copy, so it reads it without the lock.
+ */
+
+#include "event_journal.h"
+#include "alarm_rules.h"
+#include "alarm_sequencer.h"
+#include "supervisor.h"
+#include "time_base.h"
+#include "json_arena.h"
+#include "web_arena.h"
+#include "debug.h"
+#include <ArduinoJson.h>
+#include <Preferences.h>
+#include "esp_system.h"
+#include "esp_attr.h"
+#include "esp_rom_crc.h"
+#include <time.h>
+
+static const uint32_t JOURNAL_RTC_MAGIC = 0x4C4E524A;   ///< "JRNL"
+static const uint32_t PAGE_EVENTS = 16;
+static const uint32_t CAPACITY = PAGE_EVENTS * EVENT_JOURNAL_PAGES;
+static const size_t API_DEFAULT_EVENTS = 32;
+static const size_t API_MAX_EVENTS = 64;
+static const char* NVS_NAMESPACE = "journal";
+
+static_assert(EVENT_JOURNAL_PAGES <= 32, "Dirty pages are tracked in a 32-bit mask");
+static_assert(EVENT_JOURNAL_RTC_SLOTS <= PAGE_EVENTS * EVENT_JOURNAL_PAGES, "NVS must hold a full ring");
+
+struct JournalSlot {
+    JournalEvent event;
+    uint32_t crc;                  ///< CRC-32 of event
+    uint32_t reserved;
+};
+
+/// Kept in RTC memory; each slot is checked on its own at boot
+struct JournalRtc {
+    uint32_t magic;
+    uint32_t size;                 ///< sizeof(JournalRtc): a changed layout starts empty
+    JournalSlot slots[EVENT_JOURNAL_RTC_SLOTS];
+};
+
+RTC_NOINIT_ATTR static JournalRtc rtcRing;
+
+static JournalEvent pages[EVENT_JOURNAL_PAGES][PAGE_EVENTS]; ///< As stored in NVS
+static portMUX_TYPE journalLock = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t nextSequence = 1;
+static uint32_t durableSequence = 0;   ///< Newest sequence in NVS
+static uint32_t pendingSinceMs = 0;    ///< Uptime of the oldest event not in NVS
+static JournalStats stats;
+static bool ready = false;
+static bool spillNow = false;          ///< loopTask only
+static bool failing = false;           ///< loopTask only: the last NVS write failed
+static uint32_t failedAtMs = 0;
+static WebServer* journalServer = nullptr;
+
+static uint32_t slotCrc(const JournalSlot& slot) {
+    return esp_rom_crc32_le(0, (const uint8_t*)&slot.event, sizeof(slot.event));
+}
+
+static JournalSlot& slotOf(uint32_t sequence) {
+    return rtcRing.slots[sequence % EVENT_JOURNAL_RTC_SLOTS];
+}
+
+static JournalEvent& pageEntryOf(uint32_t sequence) {
+    return pages[(sequence / PAGE_EVENTS) % EVENT_JOURNAL_PAGES][sequence % PAGE_EVENTS];
+}
+
+static void pageKey(uint8_t page, char* key, size_t size) {
+    snprintf(key, size, "p%u", (unsigned)page);
+}
+
+/**
+ * @brief Event @p sequence from the ring or the page copy. Under journalLock.
+ */
+static bool lookup(uint32_t sequence, JournalEvent& out) {
+    const JournalSlot& slot = slotOf(sequence);
+    if (slot.event.sequence == sequence) {
+        out = slot.event;
+        return true;
+    }
+    const JournalEvent& entry = pageEntryOf(sequence);
+    if (entry.sequence == sequence) {
+        out = entry;
+        return true;
+    }
+    return false;
+}
+
+bool initEventJournal() {
+    memset(pages, 0, sizeof(pages));
+    Preferences prefs;
+    if (prefs.begin(NVS_NAMESPACE, true)) {
+        char key[8];
+        for (uint8_t p = 0; p < EVENT_JOURNAL_PAGES; p++) {
+            pageKey(p, key, sizeof(key));
+            if (prefs.getBytesLength(key) == sizeof(pages[p])) prefs.getBytes(key, pages[p], sizeof(pages[p]));
+        }
+        prefs.end();
+    }
+    uint32_t durable = 0;
+    for (uint8_t p = 0; p < EVENT_JOURNAL_PAGES; p++) {
+        for (uint8_t i = 0; i < PAGE_EVENTS; i++) {
+            JournalEvent& entry = pages[p][i];
+            if (!entry.sequence) continue;
+            if (&pageEntryOf(entry.sequence) != &entry) {
+                memset(&entry, 0, sizeof(entry)); // Not where its sequence belongs
+            } else if (entry.sequence > durable) {
+                durable = entry.sequence;
+            }
+        }
+    }
+
+    // Whatever survived the reset, slot by slot
+    uint32_t newest = durable;
+    uint32_t recovered = 0;
+    if (rtcRing.magic != JOURNAL_RTC_MAGIC || rtcRing.size != sizeof(JournalRtc)) {
+        memset(&rtcRing, 0, sizeof(rtcRing));
+        rtcRing.magic = JOURNAL_RTC_MAGIC;
+        rtcRing.size = sizeof(JournalRtc);
+    }
+    for (uint32_t i = 0; i < EVENT_JOURNAL_RTC_SLOTS; i++) {
+        JournalSlot& slot = rtcRing.slots[i];
+        uint32_t sequence = slot.event.sequence;
+        if (!sequence) continue;
+        if (slot.crc != slotCrc(slot) || &slotOf(sequence) != &slot) {
+            memset(&slot, 0, sizeof(slot));
+            continue;
+        }
+        if (sequence > newest) newest = sequence;
+        if (sequence > durable) recovered++;
+    }
+
+    nextSequence = newest + 1;
+    durableSequence = durable;
+    pendingSinceMs = millis();
+    memset(&stats, 0, sizeof(stats));
+    stats.recovered = recovered;
+    ready = true;
+    spillNow = true; // Recovered events and this reset, on the first pass after setup()
+    if (recovered) DEBUG_PRINTF("Journal: %lu events recovered from RTC memory\n", (unsigned long)recovered);
+
+    esp_reset_reason_t reason = esp_reset_reason();
+    eventJournalRecord(reason == ESP_RST_BROWNOUT ? JOURNAL_BROWNOUT : JOURNAL_RESET, ALARM_LEVEL_NONE,
+                       (uint16_t)reason, 0.0f);
+    return true;
+}
+
+void eventJournalRecord(uint8_t type, uint8_t level, uint16_t detail, float value) {
+    if (!ready) return;
+    JournalEvent event;
+    event.uptimeMs = millis();
+    event.utcMs = timeBaseUtcValid() ? timeBaseUtcUs() / 1000 : 0;
+    event.value = value;
+    event.detail = detail;
+    event.type = type;
+    event.level = level;
+
+    portENTER_CRITICAL(&journalLock);
+    if (nextSequence - 1 == durableSequence) pendingSinceMs = event.uptimeMs;
+    event.sequence = nextSequence++;
+    JournalSlot& slot = slotOf(event.sequence);
+    slot.event = event;
+    slot.crc = slotCrc(slot);
+    stats.recorded++;
+    portEXIT_CRITICAL(&journalLock);
+}
+
+bool eventJournalAcknowledge(uint16_t source) {
+    uint8_t level = alarmSoundingLevel();
+    if (!alarmAcknowledge()) return false;
+    eventJournalRecord(JOURNAL_ALARM_ACK, level, source, 0.0f);
+    return true;
+}
+
+void eventJournalLoop(uint32_t nowMs) {
+    if (!ready) return;
+    portENTER_CRITICAL(&journalLock);
+    uint32_t newest = nextSequence - 1;
+    uint32_t durable = durableSequence;
+    uint32_t since = pendingSinceMs;
+    portEXIT_CRITICAL(&journalLock);
+
+    uint32_t pending = newest - durable;
+    if (!pending) {
+        spillNow = false;
+        return;
+    }
+    if (failing && nowMs - failedAtMs < EVENT_JOURNAL_SPILL_MS) return;
+    if (!spillNow && !failing && pending < EVENT_JOURNAL_SPILL_BATCH && nowMs - since < EVENT_JOURNAL_SPILL_MS) return;
+    spillNow = false;
+
+    // Copy the pending events into their pages, then write the pages that changed
+    uint32_t first = pending > EVENT_JOURNAL_RTC_SLOTS ? newest - EVENT_JOURNAL_RTC_SLOTS + 1 : durable + 1;
+    uint32_t lost = first - durable - 1;
+    uint32_t copied = 0;
+    uint32_t dirty = 0;
+    for (uint32_t sequence = first; sequence <= newest; sequence++) {
+        portENTER_CRITICAL(&journalLock);
+        const JournalSlot& slot = slotOf(sequence);
+        bool present = slot.event.sequence == sequence;
+        if (present) pageEntryOf(sequence) = slot.event;
+        portEXIT_CRITICAL(&journalLock);
+        if (present) {
+            dirty |= 1u << ((sequence / PAGE_EVENTS) % EVENT_JOURNAL_PAGES);
+            copied++;
+        } else {
+            lost++; // Overwritten while this batch was being copied
+        }
+    }
+
+    bool ok = true;
+    Preferences prefs;
+    if (dirty && prefs.begin(NVS_NAMESPACE, false)) {
+        char key[8];
+        for (uint8_t p = 0; p < EVENT_JOURNAL_PAGES; p++) {
+            if (!(dirty & (1u << p))) continue;
+            pageKey(p, key, sizeof(key));
+            if (prefs.putBytes(key, pages[p], sizeof(pages[p])) != sizeof(pages[p])) ok = false;
+        }
+        prefs.end();
+    } else if (dirty) {
+        ok = false;
+    }
+
+    portENTER_CRITICAL(&journalLock);
+    if (ok) {
+        durableSequence = newest;
+        stats.spills++;
+        stats.spilled += copied;
+        stats.lost += lost;
+        if (nextSequence - 1 != newest) pendingSinceMs = nowMs; // Recorded while writing
+    } else {
+        stats.failures++;
+    }
+    portEXIT_CRITICAL(&journalLock);
+    failing = !ok;
+    if (!ok) {
+        failedAtMs = nowMs;
+        DEBUG_PRINTLN("Journal: NVS write failed, retrying later");
+    }
+}
+
+size_t getEventJournal(JournalEvent* out, size_t maxEvents, uint32_t afterSequence) {
+    if (!maxEvents) return 0;
+    portENTER_CRITICAL(&journalLock);
+    uint32_t newest = nextSequence - 1;
+    portEXIT_CRITICAL(&journalLock);
+
+    // Newest first into the back of out[], then moved to the front
+    uint32_t window = CAPACITY + EVENT_JOURNAL_RTC_SLOTS;
+    uint32_t oldest = newest > window ? newest - window + 1 : 1;
+    if (afterSequence >= oldest) oldest = afterSequence + 1;
+    size_t n = 0;
+    for (uint32_t sequence = newest; sequence >= oldest && sequence && n < maxEvents; sequence--) {
+        portENTER_CRITICAL(&journalLock);
+        bool found = lookup(sequence, out[maxEvents - 1 - n]);
+        portEXIT_CRITICAL(&journalLock);
+        if (found) n++;
+    }
+    if (n < maxEvents) memmove(out, out + maxEvents - n, n * sizeof(JournalEvent));
+    return n;
+}
+
+JournalStats getEventJournalStats() {
+    portENTER_CRITICAL(&journalLock);
+    JournalStats s = stats;
+    s.newest = nextSequence - 1;
+    s.durable = durableSequence;
+    portEXIT_CRITICAL(&journalLock);
+    return s;
+}
+
+const char* journalEventName(uint8_t type) {
+    static const char* NAMES[JOURNAL_EVENT_TYPES] = {"reset", "brownout", "alarm raised", "alarm lowered",
+                                                     "alarm cleared", "alarm acknowledged", "scaler"};
+    return type < JOURNAL_EVENT_TYPES ? NAMES[type] : "?";
+}
+
+static const char* sourceName(uint16_t source) {
+    switch (source) {
+        case JOURNAL_SOURCE_SCREEN: return "screen";
+        case JOURNAL_SOURCE_WEB:    return "web";
+        case JOURNAL_SOURCE_SERIAL: return "serial";
+        default:                    return "?";
+    }
+}
+
+size_t formatJournalEvent(const JournalEvent& event, char* out, size_t size) {
+    int n;
+    if (event.utcMs) {
+        time_t t = (time_t)(event.utcMs / 1000);
+        struct tm tm;
+        gmtime_r(&t, &tm);
+        n = snprintf(out, size, "%04d-%02d-%02d %02d:%02d:%02d.%03d", tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday,
+                     tm.tm_hour, tm.tm_min, tm.tm_sec, (int)(event.utcMs % 1000));
+    } else {
+        n = snprintf(out, size, "uptime %lu.%03lu s", (unsigned long)(event.uptimeMs / 1000),
+                     (unsigned long)(event.uptimeMs % 1000));
+    }
+    if (n < 0 || (size_t)n >= size) return size ? size - 1 : 0;
+
+    int m;
+    switch (event.type) {
+        case JOURNAL_RESET:
+        case JOURNAL_BROWNOUT:
+            m = snprintf(out + n, size - n, " %s (%s)", journalEventName(event.type), resetReasonName(event.detail));
+            break;
+        case JOURNAL_ALARM_ACK:
+            m = snprintf(out + n, size - n, " %s: %s, from %s", journalEventName(event.type),
+                         alarmLevelName(event.level), sourceName(event.detail));
+            break;
+        case JOURNAL_SCALER:
+            m = snprintf(out + n, size - n, " %s: %.0f counts in %u s", journalEventName(event.type), event.value,
+                         (unsigned)event.detail);
+            break;
+        default:
+            m = snprintf(out + n, size - n, " %s: %s, %.2f uSv/h", journalEventName(event.type),
+                         alarmLevelName(event.level), event.value);
+            break;
+    }
+    if (m < 0) return n;
+    return (size_t)n + m < size ? (size_t)n + m : size - 1;
+}
+
+void buildEventJournalJson(JsonDocument& doc, uint32_t afterSequence, size_t limit) {
+    static JournalEvent events[API_MAX_EVENTS]; ///< Web task only
+    if (limit > API_MAX_EVENTS) limit = API_MAX_EVENTS;
+    size_t n = getEventJournal(events, limit, afterSequence);
+    JournalStats s = getEventJournalStats();
+    doc["newest"] = s.newest;
+    doc["durable"] = s.durable;
+    doc["lost"] = s.lost;
+    JsonArray list = doc["events"].to<JsonArray>();
+    for (size_t i = 0; i < n; i++) {
+        const JournalEvent& e = events[i];
+        JsonObject item = list.add<JsonObject>();
+        item["seq"] = e.sequence;
+        item["type"] = journalEventName(e.type);
+        item["level"] = alarmLevelName(e.level);
+        item["uptime_ms"] = e.uptimeMs;
+        if (e.utcMs) item["utc_ms"] = e.utcMs;
+        switch (e.type) {
+            case JOURNAL_RESET:
+            case JOURNAL_BROWNOUT:
+                item["reason"] = resetReasonName(e.detail);
+                break;
+            case JOURNAL_ALARM_ACK:
+                item["source"] = sourceName(e.detail);
+                break;
+            case JOURNAL_SCALER:
+                item["counts"] = e.value;
+                item["seconds"] = e.detail;
+                break;
+            default:
+                item["usvh"] = e.value;
+                item["causes"] = e.detail;
+                break;
+        }
+    }
+}
+
+void printEventJournal(Print& out, size_t count) {
+    JournalStats s = getEventJournalStats();
+    out.printf("Event journal: newest #%lu, %lu in NVS, %lu recorded since boot, %lu recovered at boot\n",
+               (unsigned long)s.newest, (unsigned long)s.durable, (unsigned long)s.recorded,
+               (unsigned long)s.recovered);
+    out.printf("  %lu spills (%lu events), %lu lost, %lu write failures\n", (unsigned long)s.spills,
+               (unsigned long)s.spilled, (unsigned long)s.lost, (unsigned long)s.failures);
+    JournalEvent events[16];
+    if (count > 16) count = 16;
+    size_t n = getEventJournal(events, count);
+    char line[96];
+    for (size_t i = 0; i < n; i++) {
+        formatJournalEvent(events[i], line, sizeof(line));
+        out.printf("  #%-5lu %s%s\n", (unsigned long)events[i].sequence, line,
+                   events[i].sequence > s.durable ? " *" : "");
+    }
+    if (n && s.newest > s.durable) out.println("  * not in NVS yet");
+}
+
+void eventJournalAttach(WebServer& server) {
+    journalServer = &server;
+    server.on("/api/events", HTTP_GET, []() {
+        uint32_t after = (uint32_t)journalServer->arg("after").toInt();
+        long limit = journalServer->hasArg("limit") ? journalServer->arg("limit").toInt() : API_DEFAULT_EVENTS;
+        if (limit < 1) limit = 1;
+        journalServer->sendHeader("Cache-Control", "no-store");
+        journalServer->sendHeader("Access-Control-Allow-Origin", "*");
+        JsonArenaLease lease;
+        JsonDocument doc(lease.allocator());
+        buildEventJournalJson(doc, after, (size_t)limit);
+        webSendJson(*journalServer, 200, doc);
+    });
+    server.on("/api/alarm/ack", HTTP_POST, []() {
+        journalServer->sendHeader("Access-Control-Allow-Origin", "*");
+        if (eventJournalAcknowledge(JOURNAL_SOURCE_WEB)) {
+            journalServer->send(200, "text/plain", "Acknowledged");
+        } else {
+            journalServer->send(409, "text/plain", "No alarm is sounding");
+        }
+    });
+}
@@ -0,0 +1,102 @@
+#ifndef EVENT_JOURNAL_H
+#define EVENT_JOURNAL_H
+
+#include <Arduino.h>
+#include <WebServer.h>
+#include <ArduinoJson.h>
+#include "config.h"
+
+// Journal of alarm activations, acknowledgements, resets, brownouts and
+// scaler runs.
+// An event is written to a ring of EVENT_JOURNAL_RTC_SLOTS in RTC slow memory
+// and nowhere else: recording one is a copy and a CRC under a spinlock, so
+// the alarm path on pulseTask never waits for flash. The ring survives soft
+// resets (panic, watchdog, OTA restart), and often a brownout too; every slot
+// carries its own CRC, so whatever survived is recovered at the next boot and
+// nothing else is trusted.
+//
+// loopTask spills the ring to NVS in batches: once EVENT_JOURNAL_SPILL_BATCH
+// events are pending, the oldest pending one is EVENT_JOURNAL_SPILL_MS old,
+// or on the first pass after boot. NVS holds pages of 16 events, keyed by
+// sequence number, so a batch rewrites one or two pages and the last
+// 16 * EVENT_JOURNAL_PAGES events are kept. A power cut loses the events not
+// yet spilled; more than EVENT_JOURNAL_RTC_SLOTS pending at once lose the
+// oldest of them ("lost").
+//
+// Events carry a sequence number that grows across boots, the uptime, and
+// UTC in milliseconds when the time base had it (time_base.h).
+
+enum JournalEventType : uint8_t {
+    JOURNAL_RESET = 0,      ///< Boot; detail: esp_reset_reason_t
+    JOURNAL_BROWNOUT,       ///< Boot after a brownout reset
+    JOURNAL_ALARM_RAISED,   ///< Level went up; value: µSv/h, detail: AlarmCause bits
+    JOURNAL_ALARM_LOWERED,  ///< Level went down but not to none
+    JOURNAL_ALARM_CLEARED,  ///< Level back to none; level: the one before
+    JOURNAL_ALARM_ACK,      ///< Buzzer silenced; level: the one sounding, detail: JournalSource
+    JOURNAL_SCALER,         ///< Scaler run finished (scaler.h); value: counts, detail: gate seconds
+    JOURNAL_EVENT_TYPES
+};
+
+enum JournalSource : uint16_t {
+    JOURNAL_SOURCE_SCREEN = 0,
+    JOURNAL_SOURCE_WEB,
+    JOURNAL_SOURCE_SERIAL
+};
+
+struct JournalEvent {
+    uint32_t sequence;   ///< From 1, across boots; 0: empty
+    uint32_t uptimeMs;   ///< Since the boot the event happened in
+    int64_t utcMs;       ///< Unix time in ms, 0 if unknown
+    float value;
+    uint16_t detail;
+    uint8_t type;        ///< JournalEventType
+    uint8_t level;       ///< AlarmLevel
+};
+
+struct JournalStats {
+    uint32_t newest;      ///< Sequence of the newest event, 0 if none
+    uint32_t durable;     ///< Newest sequence stored in NVS
+    uint32_t recorded;    ///< Since boot
+    uint32_t recovered;   ///< Found in RTC memory at boot, not yet in NVS
+    uint32_t spills;      ///< Batches written to NVS
+    uint32_t spilled;     ///< Events in them
+    uint32_t lost;        ///< Overwritten in RTC memory before they were spilled
+    uint32_t failures;    ///< NVS writes that failed (retried)
+};
+
+// Loads the NVS pages, recovers the RTC ring and journals this boot's reset.
+// Call in setup() after initSettingsStore() and initTimeBase().
+bool initEventJournal();
+
+// Journals an event. Any task (not ISRs); never touches flash.
+void eventJournalRecord(uint8_t type, uint8_t level, uint16_t detail, float value);
+
+// Silences the sounding alarm (alarm_sequencer.h) and journals the
+// acknowledgement. @return false if nothing was sounding
+bool eventJournalAcknowledge(uint16_t source);
+
+// Spills pending events to NVS when due. Call from loop().
+void eventJournalLoop(uint32_t nowMs);
+
+// Up to @p maxEvents of the newest events after @p afterSequence, oldest
+// first. @return events copied
+size_t getEventJournal(JournalEvent* out, size_t maxEvents, uint32_t afterSequence = 0);
+
+JournalStats getEventJournalStats();
+
+const char* journalEventName(uint8_t type);
+
+// One line: "YYYY-MM-DD HH:MM:SS.mmm" (uptime if UTC was unknown), the
+// event and its values. @return the length
+size_t formatJournalEvent(const JournalEvent& event, char* out, size_t size);
+
+// GET /api/events body: {"newest","durable","lost","events":[...]}.
+void buildEventJournalJson(JsonDocument& doc, uint32_t afterSequence, size_t limit);
+
+// Prints the counters and the last @p count events ("events").
+void printEventJournal(Print& out, size_t count);
+
+// Registers GET /api/events?after=&limit= and POST /api/alarm/ack.
+void eventJournalAttach(WebServer& server);
+
+#endif // EVENT_JOURNAL_H
@@ -0,0 +1,142 @@
+/**
+ * @file event_journal_view.cpp
+ * @brief Event list on the settings screen.
+ *
+ * One wrapped label holds the list; the journal changes rarely, so a rebuild
+ * of a few hundred bytes of text when the newest sequence moves is all the
+ * updating it needs. The ACK button is disabled while no alarm sounds.
+ */
+
+#include "config.h"
+
+#if !HEADLESS
+
+#include "event_journal_view.h"
+#include "event_journal.h"
+#include "alarm_rules.h"
+#include "alarm_sequencer.h"
+#include <stdio.h>
+
+static const uint32_t UPDATE_INTERVAL_MS = 1000;
+static const lv_coord_t ROW = 36;
+static const lv_coord_t GAP = 10;
+static const size_t SHOWN_EVENTS = 8;
+
+static lv_obj_t* view = nullptr;
+static lv_obj_t* ackBtn = nullptr;
+static lv_obj_t* text = nullptr;
+static uint32_t shownNewest = UINT32_MAX;
+static uint32_t lastUpdateMs = 0;
+
+/**
+ * @brief Rebuilds the list, newest first, from the journal.
+ */
+static void refresh() {
+    JournalEvent events[SHOWN_EVENTS];
+    size_t n = getEventJournal(events, SHOWN_EVENTS);
+    shownNewest = n ? events[n - 1].sequence : 0;
+
+    char buf[SHOWN_EVENTS * 72];
+    size_t used = 0;
+    for (size_t i = n; i-- > 0 && used + 1 < sizeof(buf);) {
+        if (used) buf[used++] = '\n';
+        used += formatJournalEvent(events[i], buf + used, sizeof(buf) - used);
+    }
+    buf[used] = '\0';
+    lv_label_set_text(text, n ? buf : "No events");
+}
+
+static void refreshAck() {
+    if (alarmSoundingLevel() != ALARM_LEVEL_NONE) lv_obj_clear_state(ackBtn, LV_STATE_DISABLED);
+    else lv_obj_add_state(ackBtn, LV_STATE_DISABLED);
+}
+
+static void ackCb(lv_event_t* e) {
+    if (lv_event_get_code(e) != LV_EVENT_CLICKED) return;
+    eventJournalAcknowledge(JOURNAL_SOURCE_SCREEN);
+    refresh();
+}
+
+static void closeCb(lv_event_t* e) {
+    if (lv_event_get_code(e) != LV_EVENT_CLICKED) return;
+    eventJournalViewShow(false);
+}
+
+static void openCb(lv_event_t* e) {
+    eventJournalViewShow(true);
+}
+
+static void viewDeletedCb(lv_event_t* e) {
+    view = ackBtn = text = nullptr;
+}
+
+static lv_obj_t* addButton(lv_obj_t* parent, const char* label, lv_coord_t x, lv_coord_t y, lv_coord_t w,
+                           lv_event_cb_t cb) {
+    lv_obj_t* btn = lv_btn_create(parent);
+    lv_obj_set_size(btn, w, ROW);
+    lv_obj_set_pos(btn, x, y);
+    lv_obj_add_event_cb(btn, cb, LV_EVENT_ALL, NULL);
+    lv_obj_t* l = lv_label_create(btn);
+    lv_label_set_text_static(l, label);
+    lv_obj_center(l);
+    return btn;
+}
+
+void eventJournalViewAttach(lv_obj_t* screen, lv_coord_t top) {
+    lv_obj_t* open = lv_btn_create(screen);
+    lv_obj_set_size(open, 80, ROW);
+    lv_obj_align(open, LV_ALIGN_BOTTOM_RIGHT, -20 - 80 - GAP, -50); // Left of CAL
+    lv_obj_t* openLabel = lv_label_create(open);
+    lv_label_set_text_static(openLabel, "LOG");
+    lv_obj_center(openLabel);
+    lv_obj_add_event_cb(open, openCb, LV_EVENT_CLICKED, NULL);
+
+    view = lv_obj_create(screen);
+    lv_obj_set_size(view, lv_obj_get_width(screen), lv_obj_get_height(screen) - top);
+    lv_obj_align(view, LV_ALIGN_TOP_LEFT, 0, top);
+    lv_obj_set_style_bg_color(view, lv_color_black(), LV_PART_MAIN);
+    lv_obj_set_style_radius(view, 0, LV_PART_MAIN);
+    lv_obj_set_style_border_width(view, 0, LV_PART_MAIN);
+    lv_obj_set_style_pad_all(view, 6, LV_PART_MAIN);
+    lv_obj_clear_flag(view, LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_GESTURE_BUBBLE);
+    lv_obj_add_flag(view, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_add_event_cb(view, viewDeletedCb, LV_EVENT_DELETE, NULL);
+
+    lv_obj_t* caption = lv_label_create(view);
+    lv_label_set_text_static(caption, "Events");
+    lv_obj_set_style_text_color(caption, lv_color_white(), LV_PART_MAIN);
+    lv_obj_set_pos(caption, 0, 10);
+
+    ackBtn = addButton(view, "ACK", 100, 0, 100, ackCb);
+    lv_obj_t* close = addButton(view, "CLOSE", 0, 0, 100, closeCb);
+    lv_obj_align(close, LV_ALIGN_TOP_RIGHT, 0, 0);
+
+    text = lv_label_create(view);
+    lv_label_set_long_mode(text, LV_LABEL_LONG_WRAP);
+    lv_obj_set_width(text, lv_pct(100));
+    lv_obj_set_style_text_color(text, lv_color_white(), LV_PART_MAIN);
+    lv_obj_set_pos(text, 0, ROW + GAP);
+    shownNewest = UINT32_MAX;
+}
+
+void eventJournalViewShow(bool show) {
+    if (!view) return;
+    if (show) {
+        lv_obj_clear_flag(view, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_move_foreground(view);
+        refresh();
+        refreshAck();
+    } else {
+        lv_obj_add_flag(view, LV_OBJ_FLAG_HIDDEN);
+    }
+}
+
+void eventJournalViewUpdate(uint32_t nowMs) {
+    if (!view || lv_obj_has_flag(view, LV_OBJ_FLAG_HIDDEN)) return;
+    if (nowMs - lastUpdateMs < UPDATE_INTERVAL_MS) return;
+    lastUpdateMs = nowMs;
+    refreshAck();
+    if (getEventJournalStats().newest != shownNewest) refresh();
+}
+
+#endif // !HEADLESS
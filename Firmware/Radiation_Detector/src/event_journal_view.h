@@ -0,0 +1,20 @@
+#ifndef EVENT_JOURNAL_VIEW_H
+#define EVENT_JOURNAL_VIEW_H
+
+#include <lvgl.h>
+
+// Event list over the settings screen (event_journal.h). A LOG button next
+// to CAL opens it below the navigation bar: the newest events first, one per
+// line, with ACK to silence a sounding alarm. The list is rebuilt only when
+// a new event was journaled. LVGL task only.
+
+// Creates the LOG button and the (hidden) panel on @p screen, from @p top down
+// to the bottom of the screen. Both are removed with their screen.
+void eventJournalViewAttach(lv_obj_t* screen, lv_coord_t top);
+
+void eventJournalViewShow(bool show);
+
+// Picks up new events at most once a second while shown.
+void eventJournalViewUpdate(uint32_t nowMs);
+
+#endif // EVENT_JOURNAL_VIEW_H
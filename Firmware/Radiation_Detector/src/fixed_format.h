@@ -0,0 +1,104 @@
+#ifndef FIXED_FORMAT_H
+#define FIXED_FORMAT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <math.h>
+#include <stdio.h>
+
+// Float-to-text for the readouts, the JSON chart arrays and the exporters,
+// without newlib's printf float path (slow on the Xtensa core).
+// The value is rounded once to an integer count of the last decimal, with one
+// double multiply, which is exact for a float and up to 6 decimals. That
+// integer is then printed with integer division by 10, which the compiler
+// turns into a multiply for each specialisation. The text matches "%.Nf"
+// except in two ways. An exact tie rounds away from zero, where printf rounds
+// to even. A negative value that rounds to zero prints without a sign.
+// Two cases go through snprintf() instead:
+//   - NaN and infinity
+//   - values of 2e9 units of the last decimal or more
+
+#define FIXED_FORMAT_MAX_DECIMALS 6
+
+namespace fixed_format_detail {
+constexpr double pow10(uint8_t decimals) { return decimals ? 10.0 * pow10(decimals - 1) : 1.0; }
+
+inline size_t formatFloat(char* out, size_t size, float value, uint8_t decimals) {
+    int n = snprintf(out, size, "%.*f", (int)decimals, value);
+    return n < 0 || (size_t)n >= size ? 0 : (size_t)n;
+}
+} // namespace fixed_format_detail
+
+/**
+ * @brief Writes @p scaled / 10^D with D decimals (a value already rounded to the
+ *        displayed precision, as LabelBinding keeps it).
+ * @return Length without the terminator, or 0 if @p size is too small
+ */
+template <uint8_t D>
+size_t formatScaled(char* out, size_t size, long scaled) {
+    static_assert(D <= FIXED_FORMAT_MAX_DECIMALS, "too many decimals");
+    char digits[12]; // Least significant first; 10 for a 32-bit long, plus the leading zero
+    unsigned long magnitude = scaled < 0 ? 0UL - (unsigned long)scaled : (unsigned long)scaled;
+    size_t count = 0;
+    for (uint8_t i = 0; i < D; i++) {
+        digits[count++] = '0' + magnitude % 10;
+        magnitude /= 10;
+    }
+    do {
+        digits[count++] = '0' + magnitude % 10;
+        magnitude /= 10;
+    } while (magnitude);
+
+    size_t length = count + (D ? 1 : 0) + (scaled < 0 ? 1 : 0);
+    if (length >= size) return 0;
+    char* p = out;
+    if (scaled < 0) *p++ = '-';
+    for (size_t i = count; i-- > D;) *p++ = digits[i];
+    if (D) {
+        *p++ = '.';
+        for (size_t i = D; i-- > 0;) *p++ = digits[i];
+    }
+    *p = '\0';
+    return length;
+}
+
+/**
+ * @brief Writes @p value rounded to D decimals, like "%.Nf".
+ * @return Length without the terminator, or 0 if @p size is too small
+ */
+template <uint8_t D>
+size_t formatFixed(char* out, size_t size, float value) {
+    double scaled = value * fixed_format_detail::pow10(D);
+    if (!(fabs(scaled) < 2.0e9)) return fixed_format_detail::formatFloat(out, size, value, D);
+    return formatScaled<D>(out, size, lround(scaled));
+}
+
+/// formatScaled() with the decimals known only at run time (0..FIXED_FORMAT_MAX_DECIMALS).
+inline size_t formatScaled(char* out, size_t size, long scaled, uint8_t decimals) {
+    switch (decimals) {
+        case 0: return formatScaled<0>(out, size, scaled);
+        case 1: return formatScaled<1>(out, size, scaled);
+        case 2: return formatScaled<2>(out, size, scaled);
+        case 3: return formatScaled<3>(out, size, scaled);
+        case 4: return formatScaled<4>(out, size, scaled);
+        case 5: return formatScaled<5>(out, size, scaled);
+        case 6: return formatScaled<6>(out, size, scaled);
+        default: return fixed_format_detail::formatFloat(out, size, scaled / fixed_format_detail::pow10(decimals), decimals);
+    }
+}
+
+/// formatFixed() with the decimals known only at run time (0..FIXED_FORMAT_MAX_DECIMALS).
+inline size_t formatFixed(char* out, size_t size, float value, uint8_t decimals) {
+    switch (decimals) {
+        case 0: return formatFixed<0>(out, size, value);
+        case 1: return formatFixed<1>(out, size, value);
+        case 2: return formatFixed<2>(out, size, value);
+        case 3: return formatFixed<3>(out, size, value);
+        case 4: return formatFixed<4>(out, size, value);
+        case 5: return formatFixed<5>(out, size, value);
+        case 6: return formatFixed<6>(out, size, value);
+        default: return fixed_format_detail::formatFloat(out, size, value, decimals);
+    }
+}
+
+#endif // FIXED_FORMAT_H
@@ -0,0 +1,86 @@
+/**
+ * @file flash_stall.cpp
+ * @brief Cache-off windows of the default flash chip, timed from its os callbacks.
+ *
+ * esp_flash calls os_func->start() before it drives the chip (that disables
+ * the cache and parks the other core) and os_func->end() afterwards. The
+ * wrappers run in between, with the cache off, so they are IRAM code and
+ * everything they touch is in DRAM, the copied callback table included: the
+ * driver reads end() from it while the cache is still off.
+ */
+
+#include "flash_stall.h"
+#include "debug.h"
+#include "esp_flash.h"
+#include "esp_timer.h"
+
+static DRAM_ATTR esp_flash_os_functions_t wrapped;
+static const esp_flash_os_functions_t* original = nullptr;
+static volatile bool active = false;
+static volatile int64_t startUs = 0;
+static volatile uint32_t windows = 0;
+static volatile uint64_t totalUs = 0;
+static volatile uint32_t maxUs = 0;
+static volatile uint32_t lastUs = 0;
+
+static esp_err_t IRAM_ATTR stallStart(void* arg) {
+    esp_err_t err = original->start(arg);
+    startUs = esp_timer_get_time();
+    active = true;
+    return err;
+}
+
+static esp_err_t IRAM_ATTR stallEnd(void* arg) {
+    if (active) {
+        uint32_t us = (uint32_t)(esp_timer_get_time() - startUs);
+        active = false;
+        lastUs = us;
+        totalUs = totalUs + us;
+        if (us > maxUs) maxUs = us;
+        windows = windows + 1;
+    }
+    return original->end(arg);
+}
+
+bool initFlashStallMonitor() {
+#if FLASH_STALL_MONITOR
+    if (original) return true;
+    if (!esp_flash_default_chip || !esp_flash_default_chip->os_func) {
+        DEBUG_PRINTLN("Flash stall monitor: no default flash chip");
+        return false;
+    }
+    original = esp_flash_default_chip->os_func;
+    wrapped = *original;
+    wrapped.start = stallStart;
+    wrapped.end = stallEnd;
+    esp_flash_default_chip->os_func = &wrapped; // One pointer store; no operation is running in setup()
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool IRAM_ATTR flashStallActive() {
+    return active;
+}
+
+FlashStallStats getFlashStallStats() {
+    FlashStallStats stats;
+    stats.installed = original != nullptr;
+    stats.windows = windows;
+    stats.totalUs = totalUs;
+    stats.maxUs = maxUs;
+    stats.lastUs = lastUs;
+    return stats;
+}
+
+void printFlashStalls(Print& out) {
+    FlashStallStats stats = getFlashStallStats();
+    if (!stats.installed) {
+        out.println("  flash cache-off windows: not monitored");
+        return;
+    }
+    out.printf("  flash cache-off windows: %lu, %.1f ms in total, longest %lu us, last %lu us\n",
+               (unsigned long)stats.windows, stats.totalUs / 1000.0, (unsigned long)stats.maxUs,
+               (unsigned long)stats.lastUs);
+}
@@ -0,0 +1,38 @@
+#ifndef FLASH_STALL_H
+#define FLASH_STALL_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Time the flash cache is off. Every esp_flash operation (NVS commits, OTA
+// and partition writes, LittleFS) disables the cache while the SPI1 bus
+// talks to the chip. Meanwhile the other core is parked, and only interrupts
+// allocated with ESP_INTR_FLAG_IRAM run: the PCNT limit and pulse-capture
+// ISRs with their hooks (alarm clicks), the touch interrupt. Code or data in
+// flash reached from them crashes the chip ("Cache disabled but cached memory
+// region accessed"), and anything else waits until the cache is back.
+// This wraps the default flash chip's start / end callbacks
+// (esp_flash_os_functions_t) and records each such window. The pulse-capture
+// ISR uses flashStallActive() to count the pulses it took during one, which
+// shows the pulse path kept running ("latency").
+
+struct FlashStallStats {
+    bool installed;
+    uint32_t windows;          ///< Cache-off windows since boot
+    uint64_t totalUs;
+    uint32_t maxUs;
+    uint32_t lastUs;
+};
+
+// Wraps the callbacks. Call early in setup(), before anything writes flash.
+bool initFlashStallMonitor();
+
+// True while the flash cache is off. IRAM, for ISRs.
+bool IRAM_ATTR flashStallActive();
+
+FlashStallStats getFlashStallStats();
+
+// One line: windows, total, longest.
+void printFlashStalls(Print& out);
+
+#endif // FLASH_STALL_H
@@ -0,0 +1,414 @@
+/**
+ * @file fleet_ota.cpp
+ * @brief Manifest polling, resumable background download and scheduled install.
+ *
+ * The download bypasses Updater: Updater would erase as it goes but cannot
+ * resume. Sectors are erased and written with esp_partition_*() and the
+ * partition is only made bootable by esp_ota_set_boot_partition(), which
+ * validates the whole image, after the SHA-256 over the partition matched.
+ * A half-written partition therefore never boots. Between sectors the
+ * partition is released, so a pushed update (ota_guard.h) can take it over;
+ * the digest check then fails and the download starts again from zero.
+ */
+
+#include "fleet_ota.h"
+#include "ota_guard.h"
+#include "ethernet_link.h"
+#include "settings_store.h"
+#include "dose_checkpoint.h"
+#include "seqlock.h"
+#include "debug.h"
+#include <WiFi.h>
+#include <HTTPClient.h>
+#include <Preferences.h>
+#include "json_arena.h"
+#include <ArduinoJson.h>
+#include <atomic>
+#include <time.h>
+#include "time_base.h"
+#include "esp_ota_ops.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+static const uint32_t SECTOR_SIZE = 4096;
+static const uint32_t SAVE_EVERY_BYTES = 65536;      ///< Resume point written to NVS
+static const uint32_t STALL_TIMEOUT_MS = 15000;
+static const uint16_t HTTP_TIMEOUT_MS = 10000;
+static const uint32_t RETRY_MIN_MS = 60000;
+static const uint32_t RETRY_MAX_MS = 3600000;
+
+struct Offer {
+    bool valid;
+    String version;
+    String url;
+    uint32_t size;
+    uint8_t sha256[32];
+    String shaHex;
+    uint8_t rollout;
+};
+
+static SeqLock<FleetStatus> statusLock;
+static FleetStatus status;               ///< Fleet task only; published to statusLock
+static SemaphoreHandle_t settingsMutex = nullptr;
+static String manifestUrl;
+static std::atomic<bool> checkRequested(false);
+static uint8_t sector[SECTOR_SIZE];
+static uint8_t mac[6];
+static String rejectedVersion;           ///< Failed its digest twice; not retried until reboot
+
+static void publish() {
+    statusLock.publish(status);
+}
+
+static void setError(const char* error) {
+    status.state = FLEET_FAILED;
+    strlcpy(status.error, error, sizeof(status.error));
+    publish();
+    DEBUG_PRINTF("Fleet OTA: %s\n", error);
+}
+
+static uint32_t fnv1a(const uint8_t* data, size_t length, uint32_t hash = 2166136261u) {
+    for (size_t i = 0; i < length; i++) hash = (hash ^ data[i]) * 16777619u;
+    return hash;
+}
+
+/**
+ * @return the rollout bucket (0 ... 99) of this device for @p version
+ */
+static uint8_t rolloutBucket(const String& version) {
+    uint32_t hash = fnv1a(mac, sizeof(mac));
+    hash = fnv1a((const uint8_t*)version.c_str(), version.length(), hash);
+    return hash % 100;
+}
+
+static bool parseHex(const String& hex, uint8_t* out) {
+    if (hex.length() != 64) return false;
+    for (uint8_t i = 0; i < 32; i++) {
+        char pair[3] = {hex[2 * i], hex[2 * i + 1], '\0'};
+        char* end = nullptr;
+        out[i] = (uint8_t)strtoul(pair, &end, 16);
+        if (end != pair + 2) return false;
+    }
+    return true;
+}
+
+static void saveProgress(const Offer& offer) {
+    Preferences prefs;
+    prefs.begin("fleet", false);
+    prefs.putString("sha", offer.shaHex);
+    prefs.putUInt("done", status.downloaded);
+    prefs.end();
+}
+
+static void clearProgress() {
+    status.downloaded = 0;
+    Preferences prefs;
+    prefs.begin("fleet", false);
+    prefs.remove("sha");
+    prefs.remove("done");
+    prefs.end();
+}
+
+/**
+ * @brief Fetches and parses the manifest.
+ * @return false if it could not be read; @p offer.valid tells whether it offers an update
+ */
+static bool fetchManifest(const String& url, Offer& offer) {
+    offer.valid = false;
+    HTTPClient http;
+    http.setTimeout(HTTP_TIMEOUT_MS);
+    if (!http.begin(url)) {
+        status.lastStatus = -1;
+        return false;
+    }
+    int code = http.GET();
+    status.lastStatus = code;
+    if (code != 200) {
+        http.end();
+        return false;
+    }
+    JsonArenaLease lease;
+    JsonDocument doc(lease.allocator());
+    DeserializationError error = deserializeJson(doc, http.getString());
+    http.end();
+    if (error) return false;
+
+    offer.version = doc["version"] | "";
+    offer.url = doc["url"] | "";
+    offer.size = doc["size"] | 0;
+    offer.shaHex = doc["sha256"] | "";
+    offer.shaHex.toLowerCase();
+    int rollout = doc["rollout"] | 100;
+    offer.rollout = rollout < 0 ? 0 : (rollout > 100 ? 100 : rollout);
+    if (!offer.version.length() || !offer.url.length() || !offer.size || !parseHex(offer.shaHex, offer.sha256)) {
+        return false;
+    }
+    strlcpy(status.offered, offer.version.c_str(), sizeof(status.offered));
+    status.rollout = offer.rollout;
+    status.bucket = rolloutBucket(offer.version);
+    status.size = offer.size;
+    offer.valid = offer.version != status.running && offer.version != rejectedVersion &&
+                  status.bucket < offer.rollout;
+    return true;
+}
+
+/**
+ * @brief Erases and writes one sector at the resume point.
+ */
+static bool writeSector(const esp_partition_t* partition, uint32_t length) {
+    if (!otaPartitionClaim(OTA_OWNER_FLEET)) return false; // A pushed update owns it now
+    bool ok = esp_partition_erase_range(partition, status.downloaded, SECTOR_SIZE) == ESP_OK &&
+              esp_partition_write(partition, status.downloaded, sector, length) == ESP_OK;
+    otaPartitionRelease(OTA_OWNER_FLEET);
+    return ok;
+}
+
+/**
+ * @brief Downloads from the resume point until the image is complete, the
+ *        connection drops or the link stalls.
+ * @return true when the whole image is in the partition
+ */
+static bool downloadSession(const Offer& offer, const esp_partition_t* partition) {
+    HTTPClient http;
+    http.setTimeout(HTTP_TIMEOUT_MS);
+    if (!http.begin(offer.url)) {
+        status.lastStatus = -1;
+        return false;
+    }
+    if (status.downloaded) http.addHeader("Range", "bytes=" + String(status.downloaded) + "-");
+    int code = http.GET();
+    status.lastStatus = code;
+    if (code == 200 && status.downloaded) {
+        DEBUG_PRINTLN("Fleet OTA: server ignored the range, starting over");
+        status.downloaded = 0;
+    } else if (code != 200 && code != 206) {
+        http.end();
+        return false;
+    }
+
+    WiFiClient* stream = http.getStreamPtr();
+    uint32_t fill = 0;
+    uint32_t lastDataMs = millis();
+    uint32_t savedAt = status.downloaded;
+    while (status.downloaded < offer.size && networkOnline()) {
+        uint32_t want = offer.size - status.downloaded < SECTOR_SIZE ? offer.size - status.downloaded : SECTOR_SIZE;
+        int available = stream->available();
+        if (available <= 0) {
+            if (!http.connected() || millis() - lastDataMs >= STALL_TIMEOUT_MS) break;
+            vTaskDelay(pdMS_TO_TICKS(10));
+            continue;
+        }
+        int n = stream->read(sector + fill, want - fill < (uint32_t)available ? want - fill : available);
+        if (n <= 0) continue;
+        fill += n;
+        lastDataMs = millis();
+        if (fill < want) continue;
+
+        if (!writeSector(partition, fill)) {
+            fill = 0;
+            break;
+        }
+        status.downloaded += fill;
+        fill = 0;
+        if (status.downloaded - savedAt >= SAVE_EVERY_BYTES) {
+            saveProgress(offer);
+            savedAt = status.downloaded;
+            publish();
+        }
+        vTaskDelay(pdMS_TO_TICKS(FLEET_SECTOR_GAP_MS));
+    }
+    http.end();
+    // A partial sector is dropped; the resume point stays sector-aligned
+    saveProgress(offer);
+    publish();
+    return status.downloaded == offer.size;
+}
+
+static bool inQuietWindow() {
+    if (!timeBaseUtcValid()) return false; // No clock, no schedule
+    time_t now = (time_t)timeBaseUtcSeconds();
+    struct tm utc;
+    gmtime_r(&now, &utc);
+    int h = utc.tm_hour;
+    return FLEET_QUIET_START_H <= FLEET_QUIET_END_H ? h >= FLEET_QUIET_START_H && h < FLEET_QUIET_END_H
+                                                    : h >= FLEET_QUIET_START_H || h < FLEET_QUIET_END_H;
+}
+
+static void install(const Offer& offer, const esp_partition_t* partition) {
+    if (otaGuardActive() || !otaPartitionClaim(OTA_OWNER_FLEET)) return;
+    esp_err_t err = esp_ota_set_boot_partition(partition); // Validates the image
+    if (err != ESP_OK) {
+        otaPartitionRelease(OTA_OWNER_FLEET);
+        clearProgress();
+        rejectedVersion = offer.version;
+        setError("image rejected by the bootloader check");
+        return;
+    }
+    DEBUG_PRINTF("Fleet OTA: installing %s\n", offer.version.c_str());
+    clearProgress();
+    settingsFlush();
+    doseCheckpointSave();
+    debugLogFlush(200); // The reboot message above
+    ESP.restart();
+}
+
+/**
+ * @brief Fleet task: polls the manifest, downloads in sessions, verifies and installs.
+ */
+static void fleetTask(void* parameter) {
+    Offer offer;
+    offer.valid = false;
+    bool verified = false;
+    bool freshDownload = false;  ///< Current image was downloaded from zero
+    uint32_t retryMs = RETRY_MIN_MS;
+    // First poll a few minutes after boot, spread over the fleet by the MAC
+    uint32_t nextCheckMs = millis() + 60000 + fnv1a(mac, sizeof(mac)) % 600000;
+    uint32_t nextAttemptMs = 0;
+    const esp_partition_t* partition = esp_ota_get_next_update_partition(NULL);
+
+    for (;;) {
+        vTaskDelay(pdMS_TO_TICKS(1000));
+        xSemaphoreTake(settingsMutex, portMAX_DELAY);
+        String url = manifestUrl;
+        xSemaphoreGive(settingsMutex);
+        if (status.configured != (url.length() > 0)) {
+            status.configured = url.length() > 0;
+            publish();
+        }
+        if (!status.configured || !partition || !networkOnline()) continue;
+
+        uint32_t nowMs = millis();
+        if (checkRequested.exchange(false) || (int32_t)(nowMs - nextCheckMs) >= 0) {
+            nextCheckMs = nowMs + FLEET_POLL_INTERVAL_S * 1000UL;
+            status.state = FLEET_CHECKING;
+            status.checks++;
+            publish();
+            Offer fresh;
+            if (!fetchManifest(url, fresh)) {
+                setError("manifest unavailable");
+                continue;
+            }
+            if (!fresh.valid || fresh.size > partition->size) {
+                offer.valid = false;
+                status.state = FLEET_IDLE;
+                status.error[0] = '\0';
+                publish();
+                continue;
+            }
+            if (!offer.valid || fresh.shaHex != offer.shaHex) verified = false;
+            offer = fresh;
+            // Resume only a download of the same image
+            Preferences prefs;
+            prefs.begin("fleet", true);
+            bool same = prefs.getString("sha", "") == offer.shaHex;
+            uint32_t done = prefs.getUInt("done", 0);
+            prefs.end();
+            status.downloaded = same && done <= offer.size ? done : 0;
+            freshDownload = status.downloaded == 0;
+            nextAttemptMs = nowMs;
+            DEBUG_PRINTF("Fleet OTA: %s offered (bucket %u < %u %%), resuming at %lu\n", offer.version.c_str(),
+                         (unsigned)status.bucket, (unsigned)offer.rollout, (unsigned long)status.downloaded);
+        }
+        if (!offer.valid) continue;
+
+        if (!verified && (int32_t)(nowMs - nextAttemptMs) >= 0) {
+            if (otaGuardActive()) continue; // A pushed update first
+            status.state = FLEET_DOWNLOADING;
+            publish();
+            if (!downloadSession(offer, partition)) {
+                nextAttemptMs = millis() + retryMs;
+                retryMs = retryMs * 2 > RETRY_MAX_MS ? RETRY_MAX_MS : retryMs * 2;
+                continue;
+            }
+            retryMs = RETRY_MIN_MS;
+            uint8_t digest[32];
+            if (!otaPartitionSha256(partition, offer.size, digest) || memcmp(digest, offer.sha256, 32) != 0) {
+                clearProgress();
+                if (freshDownload) {
+                    rejectedVersion = offer.version;
+                    offer.valid = false;
+                    setError("SHA-256 mismatch");
+                } else {
+                    // Resumed over something else (a pushed upload): once more from zero
+                    freshDownload = true;
+                    nextAttemptMs = millis();
+                }
+                continue;
+            }
+            verified = true;
+            status.state = FLEET_WAITING;
+            status.error[0] = '\0';
+            publish();
+            DEBUG_PRINTF("Fleet OTA: %s downloaded and verified\n", offer.version.c_str());
+        }
+        if (verified && inQuietWindow()) install(offer, partition);
+    }
+}
+
+bool initFleetOta() {
+#if FLEET_OTA_ENABLED
+    if (settingsMutex) return true;
+    settingsMutex = xSemaphoreCreateMutex();
+    if (!settingsMutex) return false;
+    Preferences prefs;
+    prefs.begin("fleet", true);
+    manifestUrl = prefs.getString("url", "");
+    status.downloaded = prefs.getUInt("done", 0);
+    prefs.end();
+    status.configured = manifestUrl.length() > 0;
+    strlcpy(status.running, esp_ota_get_app_description()->version, sizeof(status.running));
+    WiFi.macAddress(mac);
+    publish();
+
+    // Below telemetry: the download only uses what the rest leaves
+    if (xTaskCreatePinnedToCore(fleetTask, "FleetOta", 6144, NULL, NETWORK_TASK_PRIORITY, NULL,
+                                TASK_CORE_NETWORK) != pdPASS) {
+        return false;
+    }
+    DEBUG_PRINTF("Fleet OTA: running %s, manifest %s\n", status.running,
+                 status.configured ? manifestUrl.c_str() : "not configured");
+    return true;
+#else
+    return false;
+#endif
+}
+
+void fleetOtaConfigure(const String& url) {
+    Preferences prefs;
+    prefs.begin("fleet", false);
+    prefs.putString("url", url);
+    prefs.end();
+    if (settingsMutex) xSemaphoreTake(settingsMutex, portMAX_DELAY);
+    manifestUrl = url;
+    if (settingsMutex) xSemaphoreGive(settingsMutex);
+    if (url.length()) checkRequested = true;
+}
+
+void fleetOtaCheckNow() {
+    checkRequested = true;
+}
+
+FleetStatus getFleetStatus() {
+    FleetStatus s;
+    memset(&s, 0, sizeof(s));
+    statusLock.read(s);
+    return s;
+}
+
+const char* fleetStateName(uint8_t state) {
+    static const char* NAMES[] = {"idle", "checking", "downloading", "waiting for quiet time", "failed"};
+    return state <= FLEET_FAILED ? NAMES[state] : "?";
+}
+
+void printFleetStatus(Print& out) {
+    FleetStatus s = getFleetStatus();
+    out.printf("Fleet OTA: %s, %s, running %s\n", s.configured ? "CONFIGURED" : "OFF", fleetStateName(s.state),
+               s.running);
+    if (s.offered[0]) {
+        out.printf("  offered %s, bucket %u, rollout %u %%, %lu of %lu bytes\n", s.offered, (unsigned)s.bucket,
+                   (unsigned)s.rollout, (unsigned long)s.downloaded, (unsigned long)s.size);
+    }
+    out.printf("  %lu checks, last status %d, quiet time %02d:00-%02d:00 UTC\n", (unsigned long)s.checks,
+               s.lastStatus, FLEET_QUIET_START_H, FLEET_QUIET_END_H);
+    if (s.error[0]) out.printf("  error: %s\n", s.error);
+}
@@ -0,0 +1,62 @@
+#ifndef FLEET_OTA_H
+#define FLEET_OTA_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Pull-based firmware updates for fleets.
+// A low-priority task polls a manifest URL every FLEET_POLL_INTERVAL_S (offset
+// per device, so a fleet does not poll in step):
+//   {"version": "1.5.0", "url": "http://host/firmware.bin", "size": 1234567,
+//    "sha256": "<64 hex>", "rollout": 25}
+// A version different from the running one (esp_app_desc_t) is taken when the
+// device's rollout bucket, a hash of its MAC and the version in 0 ... 99, is
+// below "rollout" (percent, default 100): raising the percentage in the
+// manifest widens the stage without changing which devices went first.
+//
+// The image is downloaded into the passive app partition one 4 KB sector at a
+// time, paced by FLEET_SECTOR_GAP_MS. The sector-aligned progress is kept in
+// NVS, so a dropped connection or a reboot resumes with an HTTP Range request.
+// A complete image is checked against the manifest's SHA-256, then installed
+// in the next UTC window FLEET_QUIET_START_H ... FLEET_QUIET_END_H: boot
+// partition switched, settings and dose checkpointed, restart. The new image
+// is confirmed or rolled back like a pushed one (ota_guard.h).
+
+enum FleetState {
+    FLEET_IDLE = 0,
+    FLEET_CHECKING,
+    FLEET_DOWNLOADING,
+    FLEET_WAITING,     ///< Verified, waiting for the quiet window
+    FLEET_FAILED
+};
+
+struct FleetStatus {
+    bool configured;       ///< Manifest URL set
+    uint8_t state;         ///< FleetState
+    char running[32];      ///< Running firmware version
+    char offered[32];      ///< Version in the last manifest, "" if none
+    uint8_t bucket;        ///< This device's rollout bucket for the offered version
+    uint8_t rollout;       ///< Percentage from the manifest
+    uint32_t size;
+    uint32_t downloaded;   ///< Bytes in the partition (resume point)
+    int lastStatus;        ///< HTTP status (or negative HTTPClient error) of the last request
+    uint32_t checks;
+    char error[40];
+};
+
+// Loads the manifest URL and the resume point and starts the task.
+bool initFleetOta();
+
+// Sets the manifest URL (Preferences, "fleet" namespace); empty disables polling.
+void fleetOtaConfigure(const String& manifestUrl);
+
+// Polls the manifest now instead of at the next interval.
+void fleetOtaCheckNow();
+
+FleetStatus getFleetStatus();
+
+const char* fleetStateName(uint8_t state);
+
+void printFleetStatus(Print& out);
+
+#endif // FLEET_OTA_H
@@ -0,0 +1,258 @@
+#ifndef GPS_NMEA_H
+#define GPS_NMEA_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Incremental NMEA 0183 parser for the survey GPS (gps_survey.h).
+// Bytes are fed one at a time as the UART hands them over, in whatever chunks
+// it has, so no sentence is ever buffered whole. Each field is decoded when
+// its delimiter arrives, into a pending copy of the fix. The pending copy
+// becomes the fix only once the sentence's checksum matches, so a corrupted
+// sentence changes nothing.
+// Sentences used, from any talker (GP, GN, GL, ...):
+//   RMC  time, date, status, position, speed
+//   GGA  time, position, fix quality, satellites, HDOP, altitude
+//   GST  position error (1-sigma latitude/longitude), when the receiver has it
+// Coordinates go to 1e-7 degrees with integer arithmetic; there is no float
+// on the parsing path. No Arduino dependencies (host-compilable).
+
+struct NmeaFix {
+    bool valid;            ///< Position fix: RMC status A, GGA quality above 0
+    int32_t latE7;         ///< Degrees * 1e7, north positive
+    int32_t lonE7;         ///< Degrees * 1e7, east positive
+    int32_t altCm;         ///< Above mean sea level (GGA)
+    uint16_t hdopCenti;    ///< HDOP * 100, 0 if unknown
+    uint16_t sigmaDm;      ///< Horizontal 1-sigma from GST in decimetres, 0 if unknown
+    uint16_t speedCms;     ///< Speed over ground (RMC)
+    uint8_t quality;       ///< GGA fix quality (1 GPS, 2 DGPS, 4/5 RTK, ...)
+    uint8_t satellites;
+    uint32_t timeMs;       ///< UTC time of day of the last position
+    uint16_t year;         ///< RMC date; 0 until one was seen
+    uint8_t month;
+    uint8_t day;
+};
+
+class NmeaParser {
+public:
+    NmeaParser() { memset(&fix_, 0, sizeof(fix_)); }
+
+    /**
+     * @brief Takes the next byte of the stream.
+     * @return true if it completed a valid RMC or GGA sentence (a new position)
+     */
+    bool feed(char c) {
+        if (c == '$') {
+            // A start always resynchronises, even inside a broken sentence
+            state_ = STATE_BODY;
+            pending_ = fix_;
+            type_ = TYPE_OTHER;
+            sum_ = 0;
+            fieldIndex_ = 0;
+            fieldLength_ = 0;
+            return false;
+        }
+        switch (state_) {
+            case STATE_BODY:
+                if (c == '*') {
+                    endField();
+                    state_ = STATE_CHECKSUM_HIGH;
+                } else if (c == '\r' || c == '\n') {
+                    state_ = STATE_IDLE; // No checksum: not trusted
+                    errors_++;
+                } else {
+                    sum_ ^= (uint8_t)c;
+                    if (c == ',') endField();
+                    else if (fieldLength_ < sizeof(field_) - 1) field_[fieldLength_++] = c;
+                }
+                return false;
+            case STATE_CHECKSUM_HIGH:
+                expected_ = hexValue(c) << 4;
+                state_ = STATE_CHECKSUM_LOW;
+                return false;
+            case STATE_CHECKSUM_LOW:
+                expected_ |= hexValue(c);
+                state_ = STATE_IDLE;
+                if (expected_ != sum_) {
+                    errors_++;
+                    return false;
+                }
+                sentences_++;
+                if (type_ == TYPE_OTHER) return false;
+                fix_ = pending_;
+                return type_ == TYPE_RMC || type_ == TYPE_GGA;
+            default:
+                return false;
+        }
+    }
+
+    const NmeaFix& fix() const { return fix_; }
+    uint32_t sentences() const { return sentences_; }  ///< With a valid checksum, any type
+    uint32_t errors() const { return errors_; }        ///< Bad or missing checksum
+
+    /// Unix time of the last position, 0 before the first RMC date.
+    static uint32_t epochSeconds(const NmeaFix& fix) {
+        if (!fix.year) return 0;
+        // Days from civil (proleptic Gregorian), with March as the first month
+        int32_t y = fix.year - (fix.month <= 2);
+        int32_t era = y / 400;
+        uint32_t yoe = (uint32_t)(y - era * 400);
+        uint32_t doy = (153 * (fix.month + (fix.month > 2 ? -3 : 9)) + 2) / 5 + fix.day - 1;
+        uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        int32_t days = era * 146097 + (int32_t)doe - 719468;
+        return (uint32_t)days * 86400UL + fix.timeMs / 1000;
+    }
+
+private:
+    enum State : uint8_t { STATE_IDLE, STATE_BODY, STATE_CHECKSUM_HIGH, STATE_CHECKSUM_LOW };
+    enum Type : uint8_t { TYPE_OTHER, TYPE_RMC, TYPE_GGA, TYPE_GST };
+
+    static uint8_t hexValue(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        return 0xFF; // Never matches a checksum nibble
+    }
+
+    /**
+     * @brief Decimal field to an integer in units of 10^-decimals; extra digits are dropped.
+     * @return false for an empty or malformed field
+     */
+    static bool parseScaled(const char* text, uint8_t decimals, int64_t* out) {
+        bool negative = *text == '-';
+        if (negative) text++;
+        int64_t value = 0;
+        bool digits = false;
+        int8_t fraction = -1; // Decimals taken so far, -1 before the point
+        for (; *text; text++) {
+            if (*text == '.' && fraction < 0) {
+                fraction = 0;
+            } else if (*text >= '0' && *text <= '9') {
+                digits = true;
+                if (fraction >= decimals) continue;
+                value = value * 10 + (*text - '0');
+                if (fraction >= 0) fraction++;
+            } else {
+                return false;
+            }
+        }
+        if (!digits) return false;
+        for (int8_t f = fraction < 0 ? 0 : fraction; f < decimals; f++) value *= 10;
+        *out = negative ? -value : value;
+        return true;
+    }
+
+    /// "ddmm.mmmm" or "dddmm.mmmm" to degrees * 1e7 (unsigned; the hemisphere follows).
+    static bool parseCoordinate(const char* text, int32_t* out) {
+        int64_t minutesE7;
+        if (!parseScaled(text, 7, &minutesE7) || minutesE7 < 0) return false;
+        int64_t degrees = minutesE7 / 1000000000LL; // Whole degrees: the digits above mm
+        minutesE7 -= degrees * 1000000000LL;
+        *out = (int32_t)(degrees * 10000000LL + (minutesE7 + 30) / 60);
+        return true;
+    }
+
+    static uint32_t isqrt(uint64_t value) {
+        uint64_t root = 0;
+        for (uint64_t bit = 1ULL << 62; bit; bit >>= 2) {
+            if (value >= root + bit) {
+                value -= root + bit;
+                root = (root >> 1) + bit;
+            } else {
+                root >>= 1;
+            }
+        }
+        return (uint32_t)root;
+    }
+
+    /// "hhmmss.sss" to milliseconds of the day.
+    static bool parseTime(const char* text, uint32_t* out) {
+        int64_t t;
+        if (!parseScaled(text, 3, &t) || t < 0) return false;
+        uint32_t hhmmss = (uint32_t)(t / 1000);
+        *out = (hhmmss / 10000 * 3600 + hhmmss / 100 % 100 * 60 + hhmmss % 100) * 1000 + (uint32_t)(t % 1000);
+        return true;
+    }
+
+    void endField() {
+        field_[fieldLength_] = '\0';
+        applyField(fieldIndex_++, field_);
+        fieldLength_ = 0;
+    }
+
+    void applyField(uint8_t index, const char* text) {
+        int64_t value;
+        if (index == 0) {
+            size_t length = strlen(text);
+            const char* kind = length >= 3 ? text + length - 3 : text;
+            if (!strcmp(kind, "RMC")) type_ = TYPE_RMC;
+            else if (!strcmp(kind, "GGA")) type_ = TYPE_GGA;
+            else if (!strcmp(kind, "GST")) type_ = TYPE_GST;
+            return;
+        }
+        if (type_ == TYPE_RMC || type_ == TYPE_GGA) {
+            // Time and position are in the same fields of both
+            uint8_t latField = type_ == TYPE_RMC ? 3 : 2;
+            if (index == 1) {
+                parseTime(text, &pending_.timeMs);
+            } else if (index == latField) {
+                if (!parseCoordinate(text, &pending_.latE7)) pending_.valid = false;
+            } else if (index == latField + 1) {
+                if (*text == 'S' && pending_.latE7 > 0) pending_.latE7 = -pending_.latE7;
+            } else if (index == latField + 2) {
+                if (!parseCoordinate(text, &pending_.lonE7)) pending_.valid = false;
+            } else if (index == latField + 3) {
+                if (*text == 'W' && pending_.lonE7 > 0) pending_.lonE7 = -pending_.lonE7;
+            }
+        }
+        if (type_ == TYPE_RMC) {
+            if (index == 2) {
+                pending_.valid = *text == 'A';
+            } else if (index == 7 && parseScaled(text, 2, &value)) {
+                pending_.speedCms = (uint16_t)(value * 1852 / 3600); // Knots * 100 to cm/s
+            } else if (index == 9 && strlen(text) == 6) {
+                pending_.day = (text[0] - '0') * 10 + (text[1] - '0');
+                pending_.month = (text[2] - '0') * 10 + (text[3] - '0');
+                pending_.year = 2000 + (text[4] - '0') * 10 + (text[5] - '0');
+            }
+        } else if (type_ == TYPE_GGA) {
+            if (index == 6) {
+                pending_.quality = parseScaled(text, 0, &value) ? (uint8_t)value : 0;
+                pending_.valid = pending_.quality > 0;
+            } else if (index == 7 && parseScaled(text, 0, &value)) {
+                pending_.satellites = (uint8_t)value;
+            } else if (index == 8) {
+                pending_.hdopCenti = parseScaled(text, 2, &value) && value < 0xFFFF ? (uint16_t)value : 0;
+            } else if (index == 9 && parseScaled(text, 2, &value)) {
+                pending_.altCm = (int32_t)value;
+            }
+        } else if (type_ == TYPE_GST) {
+            // Latitude and longitude sigma (metres) combine into one horizontal figure
+            if (index == 6) {
+                gstLatDm_ = parseScaled(text, 1, &value) ? value : -1;
+            } else if (index == 7) {
+                int64_t lonDm;
+                if (gstLatDm_ >= 0 && parseScaled(text, 1, &lonDm)) {
+                    uint32_t root = isqrt((uint64_t)(gstLatDm_ * gstLatDm_ + lonDm * lonDm));
+                    pending_.sigmaDm = root > 0xFFFF ? 0xFFFF : root ? (uint16_t)root : 1;
+                }
+            }
+        }
+    }
+
+    NmeaFix fix_;
+    NmeaFix pending_;
+    char field_[24];
+    uint8_t fieldLength_ = 0;
+    uint8_t fieldIndex_ = 0;
+    State state_ = STATE_IDLE;
+    Type type_ = TYPE_OTHER;
+    uint8_t sum_ = 0;
+    uint8_t expected_ = 0;
+    int64_t gstLatDm_ = -1;
+    uint32_t sentences_ = 0;
+    uint32_t errors_ = 0;
+};
+
+#endif // GPS_NMEA_H
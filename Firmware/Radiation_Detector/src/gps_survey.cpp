@@ -0,0 +1,339 @@
+/**
+ * @file gps_survey.cpp
+ * @brief GPS UART task: NMEA parsing, fix history and fused survey records.
+ *
+ * The UART driver is installed from the task itself, so its interrupt is
+ * allocated on core 0 with the task and never competes with pulseTask on
+ * core 1. The task sleeps on the driver's event queue. A data event means
+ * the receive FIFO reached its threshold or went idle, so a 10 Hz receiver
+ * wakes it a few times per burst of sentences, not once per byte.
+ * Closed seconds from pulseTask wait in their own queue and are fused when
+ * the task wakes, at the latest every EVENT_WAIT_MS.
+ *
+ * The CSV lines collect in a RAM buffer that goes to the card every
+ * SURVEY_LOG_FLUSH_S, or sooner when it fills, as one append under the card
+ * lock; on SPI that is a single write of at most LOG_BUFFER_BYTES.
+ */
+
+#include "gps_survey.h"
+#include "gps_nmea.h"
+#include "history_log.h"
+#include "telemetry.h"
+#include "time_base.h"
+#include "dead_time.h"
+#include "fixed_format.h"
+#include "spsc_ring.h"
+#include "debug.h"
+#include <math.h>
+#include "driver/uart.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+
+static const uart_port_t PORT = (uart_port_t)GPS_UART_NUM;
+static const size_t UART_RING_BYTES = 2048;      ///< ~200 ms of a 10 Hz NMEA stream at 115200 Bd
+static const size_t READ_CHUNK = 128;
+static const uint32_t EVENT_WAIT_MS = 200;
+static const uint8_t SECOND_QUEUE_DEPTH = 8;
+static const size_t LOG_BUFFER_BYTES = 4096;
+static const size_t LOG_LINE_BYTES = 160;
+static const uint8_t FIX_HISTORY = GPS_FIX_HISTORY;
+
+struct SurveySecond {
+    uint32_t timestamp;      ///< timeBaseSeconds() at the close, as in the history log
+    uint32_t endMs;          ///< millis() of the closing sample
+    uint32_t counts;
+    float deadTimeSec;
+    float usvHPerCpm;
+};
+
+struct FixSample {
+    uint32_t ms;             ///< Arrival of the sentence that completed it
+    NmeaFix fix;
+};
+
+static QueueHandle_t uartEvents = nullptr;
+static QueueHandle_t secondQueue = nullptr;
+static NmeaParser parser;
+static FixSample fixes[FIX_HISTORY];
+static uint8_t fixHead = 0;                      ///< Next slot written
+static uint8_t fixCount = 0;
+static SpscRing<SurveyPoint, 64> trackPoints;    ///< GPS task to the UI task
+static volatile bool surveying = GPS_SURVEY_ON_BOOT;
+
+static char logBuffer[LOG_BUFFER_BYTES];
+static size_t logLength = 0;
+static uint32_t logFlushedMs = 0;
+static bool logHeaderChecked = false;
+
+// Telemetry point being aggregated
+static uint32_t aggregateSeconds = 0;
+static float aggregateCps = 0.0f;
+static float aggregateDose = 0.0f;
+
+static uint32_t parseUs = 0;
+static uint32_t parseWindowMs = 0;
+static GpsSurveyStats stats;
+
+/**
+ * @brief Keeps a completed position. RMC and GGA of the same epoch complete
+ *        it twice; the second one replaces the first.
+ */
+static void addFix(uint32_t nowMs) {
+    const NmeaFix& fix = parser.fix();
+    uint8_t last = (fixHead + FIX_HISTORY - 1) % FIX_HISTORY;
+    if (fixCount && fixes[last].fix.timeMs == fix.timeMs) {
+        fixes[last].fix = fix;
+        return;
+    }
+    fixes[fixHead].ms = nowMs;
+    fixes[fixHead].fix = fix;
+    fixHead = (fixHead + 1) % FIX_HISTORY;
+    if (fixCount < FIX_HISTORY) fixCount++;
+}
+
+/**
+ * @brief Valid fix that arrived nearest to @p ms, within GPS_FIX_MAX_AGE_MS.
+ */
+static const FixSample* fixNear(uint32_t ms) {
+    const FixSample* best = nullptr;
+    uint32_t bestDistance = GPS_FIX_MAX_AGE_MS + 1;
+    for (uint8_t i = 0; i < fixCount; i++) {
+        const FixSample& sample = fixes[i];
+        if (!sample.fix.valid) continue;
+        uint32_t distance = (int32_t)(sample.ms - ms) < 0 ? ms - sample.ms : sample.ms - ms;
+        if (distance < bestDistance) {
+            bestDistance = distance;
+            best = &sample;
+        }
+    }
+    return best;
+}
+
+static float accuracyOf(const NmeaFix& fix) {
+    if (fix.sigmaDm) return fix.sigmaDm * 0.1f;
+    return fix.hdopCenti ? fix.hdopCenti * 0.01f * GPS_UERE_M : NAN;
+}
+
+static void flushLog() {
+    if (!logLength) return;
+    if (!sdCardMounted()) {
+        stats.logErrors++; // No card; the batch is dropped
+        logLength = 0;
+        return;
+    }
+    sdCardBegin();
+    fs::FS& fs = sdCardFs();
+    if (!logHeaderChecked) {
+        // A new file starts with the column names
+        if (!fs.exists(SURVEY_LOG_PATH)) {
+            File header = fs.open(SURVEY_LOG_PATH, FILE_WRITE);
+            if (header) {
+                header.print("timestamp,utc,lat,lon,alt_m,accuracy_m,satellites,speed_mps,"
+                             "counts,cps,cps_sigma,dose_usvh\n");
+                header.close();
+            }
+        }
+        logHeaderChecked = true;
+    }
+    File file = fs.open(SURVEY_LOG_PATH, FILE_APPEND);
+    bool written = file && file.write((const uint8_t*)logBuffer, logLength) == logLength;
+    if (file) file.close();
+    sdCardEnd();
+    if (!written) stats.logErrors++;
+    logLength = 0;
+}
+
+/**
+ * @brief Appends one CSV line to the log buffer.
+ */
+static void logRecord(uint32_t timestamp, bool utc, const NmeaFix& fix, float accuracy, uint32_t counts, float cps,
+                      float sigma, float dose) {
+    char lat[16], lon[16], alt[16], acc[16], speed[16], rate[16], rateSigma[16], doseText[16];
+    formatScaled<6>(lat, sizeof(lat), (fix.latE7 + (fix.latE7 < 0 ? -5 : 5)) / 10);
+    formatScaled<6>(lon, sizeof(lon), (fix.lonE7 + (fix.lonE7 < 0 ? -5 : 5)) / 10);
+    formatScaled<1>(alt, sizeof(alt), (fix.altCm + (fix.altCm < 0 ? -5 : 5)) / 10);
+    if (isnan(accuracy)) acc[0] = '\0';
+    else formatFixed<1>(acc, sizeof(acc), accuracy);
+    formatScaled<2>(speed, sizeof(speed), fix.speedCms);
+    formatFixed<2>(rate, sizeof(rate), cps);
+    formatFixed<2>(rateSigma, sizeof(rateSigma), sigma);
+    formatFixed<4>(doseText, sizeof(doseText), dose);
+
+    if (logLength + LOG_LINE_BYTES > sizeof(logBuffer)) flushLog();
+    int n = snprintf(logBuffer + logLength, sizeof(logBuffer) - logLength, "%lu,%u,%s,%s,%s,%s,%u,%s,%lu,%s,%s,%s\n",
+                     (unsigned long)timestamp, utc ? 1 : 0, lat, lon, alt, acc, (unsigned)fix.satellites, speed,
+                     (unsigned long)counts, rate, rateSigma, doseText);
+    if (n > 0 && (size_t)n < sizeof(logBuffer) - logLength) {
+        logLength += n;
+        stats.logLines++;
+    } else {
+        stats.logErrors++;
+    }
+}
+
+static void fuseSecond(const SurveySecond& second) {
+    // The position at the middle of the counting interval
+    const FixSample* sample = fixNear(second.endMs - 500);
+    if (!sample) {
+        stats.untagged++;
+        return;
+    }
+    const NmeaFix& fix = sample->fix;
+    float cps = correctDeadTimeCps((float)second.counts, second.deadTimeSec);
+    float sigma = second.counts ? cps / sqrtf((float)second.counts) : 1.0f;
+    float dose = cps * 60.0f * second.usvHPerCpm;
+    stats.tagged++;
+
+    SurveyPoint point = {fix.latE7, fix.lonE7, dose};
+    trackPoints.push(point);
+    if (!surveying) return;
+
+    // Wall-clock stamp from the time base, else from the receiver itself
+    bool utc = timeBaseUtcValid();
+    uint32_t timestamp = utc ? timeBaseUtcAt(second.timestamp) : NmeaParser::epochSeconds(fix);
+    if (timestamp) utc = true;
+    else timestamp = second.timestamp;
+    logRecord(timestamp, utc, fix, accuracyOf(fix), second.counts, cps, sigma, dose);
+
+    if (SURVEY_TELEMETRY_S > 0) {
+        aggregateSeconds++;
+        aggregateCps += cps;
+        aggregateDose += dose;
+        if (aggregateSeconds >= SURVEY_TELEMETRY_S) {
+            if (telemetrySurvey(timestamp, utc, fix.latE7, fix.lonE7, aggregateDose / aggregateSeconds,
+                                aggregateCps / aggregateSeconds, aggregateSeconds)) {
+                stats.telemetryPoints++;
+            }
+            aggregateSeconds = 0;
+            aggregateCps = aggregateDose = 0.0f;
+        }
+    }
+}
+
+static void readUart(size_t available) {
+    uint8_t chunk[READ_CHUNK];
+    while (available) {
+        int n = uart_read_bytes(PORT, chunk, available < sizeof(chunk) ? available : sizeof(chunk), 0);
+        if (n <= 0) break;
+        available -= n;
+        stats.bytes += n;
+        uint32_t start = micros();
+        uint32_t nowMs = millis();
+        for (int i = 0; i < n; i++) {
+            if (parser.feed((char)chunk[i])) addFix(nowMs);
+        }
+        parseUs += micros() - start;
+    }
+}
+
+static void updateStats(uint32_t nowMs) {
+    const FixSample* last = fixCount ? &fixes[(fixHead + FIX_HISTORY - 1) % FIX_HISTORY] : nullptr;
+    stats.sentences = parser.sentences();
+    stats.checksumErrors = parser.errors();
+    stats.surveying = surveying;
+    if (last) {
+        stats.fixAgeMs = nowMs - last->ms;
+        stats.fix = last->fix.valid && stats.fixAgeMs <= GPS_FIX_MAX_AGE_MS;
+        stats.quality = last->fix.quality;
+        stats.satellites = last->fix.satellites;
+        stats.hdop = last->fix.hdopCenti * 0.01f;
+        stats.accuracyM = accuracyOf(last->fix);
+        stats.latE7 = last->fix.latE7;
+        stats.lonE7 = last->fix.lonE7;
+    }
+    if (nowMs - parseWindowMs >= 1000) {
+        stats.parseUsPerS = parseUs;
+        parseUs = 0;
+        parseWindowMs = nowMs;
+    }
+}
+
+static void gpsTask(void* parameter) {
+    uart_config_t config = {};
+    config.baud_rate = GPS_BAUD;
+    config.data_bits = UART_DATA_8_BITS;
+    config.parity = UART_PARITY_DISABLE;
+    config.stop_bits = UART_STOP_BITS_1;
+    config.flow_ctrl = UART_HW_FLOWCTRL_DISABLE;
+    config.source_clk = UART_SCLK_APB;
+    if (uart_driver_install(PORT, UART_RING_BYTES, 0, 16, &uartEvents, 0) != ESP_OK ||
+        uart_param_config(PORT, &config) != ESP_OK ||
+        uart_set_pin(PORT, GPS_TX_PIN, GPS_RX_PIN, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE) != ESP_OK) {
+        DEBUG_PRINTLN("GPS: UART setup failed");
+        vTaskDelete(NULL);
+        return;
+    }
+    stats.enabled = true;
+    DEBUG_PRINTF("GPS: UART%d on RX %d at %d Bd\n", (int)PORT, GPS_RX_PIN, GPS_BAUD);
+
+    for (;;) {
+        uart_event_t event;
+        if (xQueueReceive(uartEvents, &event, pdMS_TO_TICKS(EVENT_WAIT_MS)) == pdTRUE) {
+            if (event.type == UART_DATA) {
+                size_t available = 0;
+                uart_get_buffered_data_len(PORT, &available);
+                readUart(available);
+            } else if (event.type == UART_FIFO_OVF || event.type == UART_BUFFER_FULL) {
+                // Bytes were lost; the parser resynchronises on the next '$'
+                uart_flush_input(PORT);
+                xQueueReset(uartEvents);
+                stats.overruns++;
+            }
+        }
+
+        uint32_t nowMs = millis();
+        SurveySecond second;
+        while (xQueueReceive(secondQueue, &second, 0) == pdTRUE) fuseSecond(second);
+        if (logLength && nowMs - logFlushedMs >= SURVEY_LOG_FLUSH_S * 1000UL) {
+            flushLog();
+            logFlushedMs = nowMs;
+        }
+        updateStats(nowMs);
+    }
+}
+
+bool initGpsSurvey() {
+    if (GPS_RX_PIN < 0) return false;
+    secondQueue = xQueueCreate(SECOND_QUEUE_DEPTH, sizeof(SurveySecond));
+    if (!secondQueue) return false;
+    return xTaskCreatePinnedToCore(gpsTask, "GpsSurvey", 4096, NULL, tskIDLE_PRIORITY + 1, NULL, 0) == pdPASS;
+}
+
+void gpsSurveySecond(uint32_t timestamp, uint32_t endMs, uint32_t counts, float deadTimeSec, float usvHPerCpm) {
+    if (!secondQueue) return;
+    SurveySecond second = {timestamp, endMs, counts, deadTimeSec, usvHPerCpm};
+    xQueueSend(secondQueue, &second, 0); // A full queue means the task is stuck; the second is dropped
+}
+
+bool gpsSurveyPopPoint(SurveyPoint& point) {
+    return trackPoints.pop(point);
+}
+
+void gpsSurveySetActive(bool active) {
+    surveying = active;
+}
+
+GpsSurveyStats getGpsSurveyStats() {
+    return stats;
+}
+
+void printGpsSurvey(Print& out) {
+    GpsSurveyStats s = getGpsSurveyStats();
+    if (!s.enabled) {
+        out.println(GPS_RX_PIN < 0 ? "GPS: not configured (GPS_RX_PIN)" : "GPS: UART not running");
+        return;
+    }
+    out.printf("GPS: %s, survey %s, %lu bytes, %lu sentences, %lu checksum errors, %lu overruns, parser %lu us/s\n",
+               s.fix ? "FIX" : "no fix", s.surveying ? "RECORDING" : "paused", (unsigned long)s.bytes,
+               (unsigned long)s.sentences, (unsigned long)s.checksumErrors, (unsigned long)s.overruns,
+               (unsigned long)s.parseUsPerS);
+    if (s.fix) {
+        out.printf("  %.6f %.6f, quality %u, %u satellites, HDOP %.2f, accuracy %.1f m, %lu ms old\n",
+                   s.latE7 * 1e-7, s.lonE7 * 1e-7, (unsigned)s.quality, (unsigned)s.satellites, s.hdop, s.accuracyM,
+                   (unsigned long)s.fixAgeMs);
+    }
+    out.printf("  %lu seconds tagged, %lu without a fix, %lu log lines (%lu errors), %lu telemetry points\n",
+               (unsigned long)s.tagged, (unsigned long)s.untagged, (unsigned long)s.logLines,
+               (unsigned long)s.logErrors, (unsigned long)s.telemetryPoints);
+}
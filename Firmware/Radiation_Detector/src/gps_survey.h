@@ -0,0 +1,76 @@
+#ifndef GPS_SURVEY_H
+#define GPS_SURVEY_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Geo-tagged survey mode for walk and drive surveys with an optional GPS on
+// a UART (GPS_RX_PIN).
+// The UART driver moves received bytes into its ring buffer from the
+// interrupt. A low-priority task on core 0 takes them in whatever chunks have
+// arrived and feeds them to the incremental NMEA parser (gps_nmea.h). It
+// keeps the last GPS_FIX_HISTORY fixes with their arrival time. pulseTask
+// only queues each closed second (one non-blocking queue send), so a 10 Hz
+// receiver costs the pulse path nothing.
+//
+// Each second is matched to the fix nearest its midpoint, no further than
+// GPS_FIX_MAX_AGE_MS away, and becomes a fused record:
+//   position, horizontal accuracy (GST sigma, or HDOP * GPS_UERE_M),
+//   counts, dead-time corrected cps with its Poisson 1-sigma, dose rate.
+// While surveying, records are
+//   - appended to SURVEY_LOG_PATH on the SD card (CSV, one line per second,
+//     written in batches), next to the history log;
+//   - aggregated into one telemetry point per SURVEY_TELEMETRY_S
+//     ("radiation_survey", telemetry.h);
+//   - handed to the breadcrumb track on the display (survey_track_view.h).
+// Seconds without a recent fix are counted but not recorded. Injected test
+// pulses are never recorded.
+
+struct GpsSurveyStats {
+    bool enabled;            ///< UART running
+    bool surveying;          ///< Records are written ("survey on|off")
+    bool fix;                ///< A valid fix within GPS_FIX_MAX_AGE_MS
+    uint8_t quality;         ///< GGA fix quality
+    uint8_t satellites;
+    float hdop;
+    float accuracyM;         ///< Horizontal 1-sigma
+    int32_t latE7;           ///< Last fix, degrees * 1e7
+    int32_t lonE7;
+    uint32_t fixAgeMs;
+    uint32_t bytes;          ///< Received from the UART
+    uint32_t sentences;      ///< With a valid checksum
+    uint32_t checksumErrors;
+    uint32_t overruns;       ///< UART FIFO or ring overflows (bytes lost)
+    uint32_t tagged;         ///< Seconds recorded with a position
+    uint32_t untagged;       ///< Seconds without a recent fix
+    uint32_t logLines;       ///< Written to SURVEY_LOG_PATH
+    uint32_t logErrors;
+    uint32_t telemetryPoints;
+    uint32_t parseUsPerS;    ///< Parser time over the last second
+};
+
+// A point of the breadcrumb track.
+struct SurveyPoint {
+    int32_t latE7;
+    int32_t lonE7;
+    float doseRate;          ///< µSv/h of the second
+};
+
+// Starts the GPS task if GPS_RX_PIN is set. Call in setup() after
+// initHistoryLog() and initTelemetry().
+bool initGpsSurvey();
+
+// pulseTask, for every closed second of real (not injected) counts. Never blocks.
+void gpsSurveySecond(uint32_t timestamp, uint32_t endMs, uint32_t counts, float deadTimeSec, float usvHPerCpm);
+
+// UI task: next new point of the track, if any.
+bool gpsSurveyPopPoint(SurveyPoint& point);
+
+// Starts or pauses recording (on at boot when GPS_SURVEY_ON_BOOT).
+void gpsSurveySetActive(bool active);
+
+GpsSurveyStats getGpsSurveyStats();
+
+void printGpsSurvey(Print& out);
+
+#endif // GPS_SURVEY_H
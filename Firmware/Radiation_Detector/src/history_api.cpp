@@ -0,0 +1,275 @@
+/**
+ * @file history_api.cpp
+ * @brief Ranged, paginated history endpoint (packed binary, JSON or CSV).
+ *
+ * Every response is produced by walking the store with a HistoryRange, which
+ * copies buckets out in small batches; the full range is never held in RAM.
+ * A first pass only counts the points of the page and finds the cursor of the
+ * next one, so the binary format can announce its length and every format can
+ * send X-History-Next before the body. At 20 bytes per bucket a week of minute
+ * data is ~200 KB, against ~900 KB as JSON text.
+ */
+
+#include "history_api.h"
+#include "history_range.h"
+#include "history_log.h"
+#include "log_compaction.h"
+#include "chunk_writer.h"
+#include "supervisor.h"
+#include "esp_random.h"
+
+static const size_t HISTORY_API_BATCH = 32;        ///< Records per socket write (640 bytes on the stack)
+
+static_assert(sizeof(HistoryPackHeader) == 16, "pack header layout is part of the API");
+static_assert(sizeof(HistoryPackRecord) == 20, "pack record layout is part of the API");
+
+static WebServer* historyServer = nullptr;
+static HistoryStore* historySource = nullptr;
+static uint32_t historyBoot = 0;                   ///< Random per boot: the time base restarts with it
+
+enum HistoryFormat {
+    HISTORY_FORMAT_BIN,
+    HISTORY_FORMAT_JSON,
+    HISTORY_FORMAT_CSV
+};
+
+/**
+ * @brief Maps the res parameter (1s, 1m, 1h) to a store level.
+ */
+static bool parseResolution(const String& res, HistoryLevel* level) {
+    if (res == "1m") *level = HISTORY_LEVEL_MINUTE;
+    else if (res == "1s") *level = HISTORY_LEVEL_SECOND;
+    else if (res == "1h") *level = HISTORY_LEVEL_HOUR;
+    else return false;
+    return true;
+}
+
+static uint32_t argU32(WebServer& server, const char* name, uint32_t fallback) {
+    return server.hasArg(name) ? strtoul(server.arg(name).c_str(), NULL, 10) : fallback;
+}
+
+static void streamBinary(WebServer& server, HistoryRange& range, uint32_t step, size_t count) {
+    HistoryPackHeader header;
+    header.magic = HISTORY_PACK_MAGIC;
+    header.version = HISTORY_PACK_VERSION;
+    header.recordSize = sizeof(HistoryPackRecord);
+    header.bucketSeconds = step;
+    header.count = count;
+
+    server.setContentLength(sizeof(header) + count * sizeof(HistoryPackRecord));
+    server.send(200, "application/octet-stream", "");
+    server.sendContent((const char*)&header, sizeof(header));
+
+    HistoryPackRecord records[HISTORY_API_BATCH];
+    HistoryBucket b;
+    size_t sent = 0;
+    while (sent < count) {
+        size_t want = count - sent < HISTORY_API_BATCH ? count - sent : HISTORY_API_BATCH;
+        for (size_t i = 0; i < want; i++) {
+            // Pad if the range ran short (ring evicted meanwhile), so the body matches the length
+            if (range.next(&b)) {
+                records[i].startTime = b.startTime;
+                records[i].counts = b.counts;
+                records[i].minCps = b.minCps;
+                records[i].maxCps = b.maxCps;
+                records[i].seconds = b.seconds;
+                records[i].flags = b.flags;
+            } else {
+                memset(&records[i], 0, sizeof(records[i]));
+            }
+        }
+        server.sendContent((const char*)records, want * sizeof(HistoryPackRecord));
+        supervisorHeartbeat();
+        if (!server.client().connected()) break;
+        sent += want;
+    }
+}
+
+static void streamText(WebServer& server, HistoryRange& range, HistoryFormat format,
+                       uint32_t step, size_t count, bool hasNext, uint32_t next) {
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN); // Chunked transfer encoding
+    server.send(200, format == HISTORY_FORMAT_JSON ? "application/json" : "text/csv", "");
+
+    ChunkWriter out(server);
+    if (format == HISTORY_FORMAT_JSON) {
+        out.printf("{\"step\":%u,\"points\":[", step);
+    } else {
+        out.printf("start,counts,min_cps,max_cps,seconds,flags\n");
+    }
+
+    HistoryBucket b;
+    for (size_t i = 0; i < count && range.next(&b); i++) {
+        if (format == HISTORY_FORMAT_JSON) {
+            out.printf("%s[%u,%u,%u,%u,%u,%u]", i ? "," : "", b.startTime, b.counts,
+                       b.minCps, b.maxCps, b.seconds, b.flags);
+        } else {
+            out.printf("%u,%u,%u,%u,%u,%u\n", b.startTime, b.counts,
+                       b.minCps, b.maxCps, b.seconds, b.flags);
+        }
+        if ((i & 63) == 63 && !server.client().connected()) return;
+    }
+
+    if (format == HISTORY_FORMAT_JSON) {
+        if (hasNext) out.printf("],\"next\":\"%u\"}", next);
+        else out.printf("],\"next\":null}");
+    }
+    out.flush();
+    server.sendContent(""); // Terminating zero-length chunk
+}
+
+/**
+ * @brief Serves the SD card log (src=log): its encoded blocks, CSV decoded block
+ *        by block, or the compacted 1-minute or 1-hour summaries (res) as CSV.
+ */
+static void streamLog(WebServer& server) {
+    if (!getHistoryLogStats().mounted) {
+        server.send(503, "text/plain", "History log not mounted");
+        return;
+    }
+    String formatArg = server.arg("format");
+    bool csv = formatArg == "csv";
+    if (!csv && formatArg.length() && formatArg != "col") {
+        server.send(400, "text/plain", "format must be col or csv for src=log");
+        return;
+    }
+    uint32_t summarySeconds = 0;
+    if (server.hasArg("res")) {
+        String res = server.arg("res");
+        if (res == "1m") summarySeconds = 60;
+        else if (res == "1h") summarySeconds = 3600;
+        else if (res != "1s") {
+            server.send(400, "text/plain", "res must be 1s, 1m or 1h");
+            return;
+        }
+        if (summarySeconds && formatArg.length() && !csv) {
+            server.send(400, "text/plain", "summaries of src=log are served as format=csv");
+            return;
+        }
+    }
+    csv = csv || summarySeconds;
+    uint32_t from = argU32(server, "from", 0);
+    uint32_t to = argU32(server, "to", UINT32_MAX);
+
+    server.sendHeader("Cache-Control", "no-store");
+    server.sendHeader("Access-Control-Allow-Origin", "*");
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN); // Chunked transfer encoding
+    server.send(200, csv ? "text/csv" : "application/octet-stream", "");
+    ChunkWriter out(server);
+    if (summarySeconds) exportLogSummaryCsv(out, summarySeconds, from, to);
+    else if (csv) exportHistoryLogCsv(out, from, to);
+    else exportHistoryLogBlocks(out, from, to);
+    out.flush();
+    server.sendContent(""); // Terminating zero-length chunk
+}
+
+/**
+ * @brief Handles GET /api/history.
+ */
+static void handleHistoryRequest() {
+    WebServer& server = *historyServer;
+    if (server.arg("src") == "log") {
+        streamLog(server);
+        return;
+    }
+    if (!historySource->ready()) {
+        server.send(503, "text/plain", "History store not allocated");
+        return;
+    }
+
+    uint32_t step = argU32(server, "step", 0);
+    HistoryLevel level = HISTORY_LEVEL_MINUTE;
+    if (server.hasArg("res")) {
+        if (!parseResolution(server.arg("res"), &level)) {
+            server.send(400, "text/plain", "res must be 1s, 1m or 1h");
+            return;
+        }
+    } else if (step) {
+        // Coarsest level whose buckets tile the step exactly
+        for (int l = HISTORY_LEVEL_COUNT - 1; l >= 0; l--) {
+            if (step % HistoryStore::bucketSeconds((HistoryLevel)l) == 0) {
+                level = (HistoryLevel)l;
+                break;
+            }
+        }
+    }
+    uint32_t bucketSeconds = HistoryStore::bucketSeconds(level);
+    if (step == 0) step = bucketSeconds;
+    if (step % bucketSeconds != 0) {
+        server.send(400, "text/plain", "step must be a multiple of res");
+        return;
+    }
+
+    HistoryFormat format = HISTORY_FORMAT_BIN;
+    String formatArg = server.arg("format");
+    if (formatArg == "json") format = HISTORY_FORMAT_JSON;
+    else if (formatArg == "csv") format = HISTORY_FORMAT_CSV;
+    else if (formatArg.length() && formatArg != "bin") {
+        server.send(400, "text/plain", "format must be bin, json or csv");
+        return;
+    }
+
+    // The cursor is the start time of the first point not yet delivered
+    uint32_t from = argU32(server, "cursor", argU32(server, "from", 0));
+    uint32_t to = argU32(server, "to", UINT32_MAX);
+    size_t limit = argU32(server, "limit", HISTORY_API_DEFAULT_LIMIT);
+
+    // maxPoints: the step (and, without res, the level) that fit the range in that many points
+    size_t maxPoints = argU32(server, "maxPoints", 0);
+    if (maxPoints) {
+        HistoryPlan plan;
+        if (planHistoryPoints(*historySource, from, to, maxPoints, &plan)) {
+            if (!server.hasArg("res")) level = plan.level;
+            bucketSeconds = HistoryStore::bucketSeconds(level);
+            if (plan.step > step) step = plan.step;
+            step = (step + bucketSeconds - 1) / bucketSeconds * bucketSeconds;
+        }
+        if (maxPoints < limit) limit = maxPoints;
+    }
+    if (limit == 0 || limit > HistoryStore::capacity(level)) limit = HistoryStore::capacity(level);
+
+    // Pass 1: size the page and find where the next one starts
+    size_t count = 0;
+    bool hasNext = false;
+    uint32_t next = 0;
+    {
+        HistoryRange counter(*historySource, level, from, to, step);
+        HistoryBucket b;
+        while (counter.next(&b)) {
+            if (count == limit) {
+                hasNext = true;
+                next = b.startTime;
+                break;
+            }
+            count++;
+        }
+    }
+
+    server.sendHeader("Cache-Control", "no-store");
+    server.sendHeader("Access-Control-Allow-Origin", "*");
+    server.sendHeader("Access-Control-Expose-Headers", "X-History-Next, X-History-Boot, X-History-Now");
+    if (hasNext) server.sendHeader("X-History-Next", String(next));
+    // Lets a client map the store's time base to its own clock and notice a restart
+    char boot[9];
+    snprintf(boot, sizeof(boot), "%08lx", (unsigned long)historyBoot);
+    server.sendHeader("X-History-Boot", boot);
+    HistoryBucket newest;
+    size_t seconds = historySource->count(HISTORY_LEVEL_SECOND);
+    if (seconds && historySource->read(HISTORY_LEVEL_SECOND, seconds - 1, &newest, 1) == 1) {
+        server.sendHeader("X-History-Now", String(newest.startTime + 1));
+    }
+
+    // Pass 2: stream the page
+    HistoryRange range(*historySource, level, from, to, step);
+    if (format == HISTORY_FORMAT_BIN) {
+        streamBinary(server, range, step, count);
+    } else {
+        streamText(server, range, format, step, count, hasNext, next);
+    }
+}
+
+void historyApiAttach(WebServer& server, HistoryStore& store) {
+    historyServer = &server;
+    historySource = &store;
+    if (!historyBoot) historyBoot = esp_random() | 1;
+    server.on("/api/history", HTTP_GET, handleHistoryRequest);
+}
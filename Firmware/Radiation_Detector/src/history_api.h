@@ -0,0 +1,65 @@
+#ifndef HISTORY_API_H
+#define HISTORY_API_H
+
+#include <Arduino.h>
+#include <WebServer.h>
+#include "history_store.h"
+
+// Ranged, paginated history download.
+//
+// GET /api/history?res=1s|1m|1h&step=<s>&from=<t>&to=<t>&limit=<n>&format=bin|json|csv
+//   res     source resolution; defaults to the coarsest level that divides step (else 1m)
+//   step    seconds per returned point, a multiple of res (buckets are merged)
+//   from/to inclusive start-time range, in the time base the store was fed with
+//   limit   points per page (default HISTORY_API_DEFAULT_LIMIT)
+//   cursor  resume token from a previous page; replaces from
+//   maxPoints  at most this many points for the whole range: the step is
+//           raised (and, without res, the level chosen) so the range fits,
+//           and limit is capped to it. Points are min/max decimated like
+//           the on-device chart (history_range.h), so short peaks survive.
+// When more points remain, the response carries the token in X-History-Next
+// (and "next" in JSON); pass it back as cursor= to fetch the following page.
+// Times are seconds since boot. X-History-Boot changes with every boot (a
+// cursor from another boot means nothing), and X-History-Now is the end of
+// the newest second, so a client can place the buckets on its own clock.
+// Minute and hour buckets are only stored once complete, so a client that
+// keeps them syncs incrementally with cursor = the last start time + 1.
+//
+// format=bin (default) is application/octet-stream, all fields little-endian:
+//   HistoryPackHeader, then `count` HistoryPackRecord entries, oldest first.
+// json and csv are streamed with chunked transfer encoding.
+//
+// GET /api/history?src=log&res=1s|1m|1h&from=<t>&to=<t>&format=col|csv
+//   serves the log on the SD card instead (history_log.h), streamed with
+//   chunked transfer encoding and not paginated. For 1s (default), col
+//   (default) sends the blocks that overlap the range still encoded, ~1.1
+//   bytes per record, for tools/decode_history_log.py; csv decodes them on the
+//   device block by block. 1m and 1h send the compacted summaries
+//   (log_compaction.h), which reach back further than the 1 s ring, as CSV.
+
+struct HistoryPackHeader {
+    uint32_t magic;          ///< HISTORY_PACK_MAGIC ("RDHB")
+    uint16_t version;        ///< HISTORY_PACK_VERSION
+    uint16_t recordSize;     ///< sizeof(HistoryPackRecord)
+    uint32_t bucketSeconds;  ///< Resolution of the records (the requested step)
+    uint32_t count;          ///< Records that follow
+};
+
+struct HistoryPackRecord {
+    uint32_t startTime;
+    uint32_t counts;
+    uint32_t minCps;
+    uint32_t maxCps;
+    uint16_t seconds;
+    uint16_t flags;
+};
+
+#define HISTORY_PACK_MAGIC   0x42484452 // "RDHB"
+#define HISTORY_PACK_VERSION 1
+
+#define HISTORY_API_DEFAULT_LIMIT 1000
+
+// Registers /api/history on @p server, serving from @p store.
+void historyApiAttach(WebServer& server, HistoryStore& store);
+
+#endif // HISTORY_API_H
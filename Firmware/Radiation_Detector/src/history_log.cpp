@@ -0,0 +1,714 @@
+/**
+ * @file history_log.cpp
+ * @brief Power-loss-safe persistent history log on the microSD card or internal flash.
+ *
+ * Layout on the medium (log_storage.h), all little-endian:
+ *   offset 0      index header, one 512-byte sector (magic, format, geometry)
+ *   offset 512*k  data block k-1: 44-byte block header + columnar payload
+ *
+ * Block slots live at fixed offsets, so a reader can seek to any block
+ * directly. Every block carries its own CRC-32, the sequence number and
+ * timestamp of its first record, and the min/max of its timestamps and
+ * counts, so range queries skip blocks without decoding them. The payload
+ * holds the records column by column (log_codec.h): ~450 records of a steady
+ * 1 s log per block, about 1.1 bytes per record against 16 in format 1.
+ * The writer only ever writes whole blocks, in slot order; once the log holds
+ * HISTORY_LOG_RAW_DAYS, or fills what the medium allows, it wraps and reuses
+ * the oldest slots (log_ring.h), after the compaction job (log_compaction.h) has folded
+ * them into summaries. On mount the newest block is located from the block
+ * sequence numbers and a torn or corrupt block at the write position
+ * (brownout during a write) is discarded and overwritten.
+ *
+ * Sealed blocks are not written one by one: they collect in a write-behind
+ * buffer in PSRAM and go to the medium as one sector-aligned write of
+ * HISTORY_LOG_WRITE_CHUNK bytes with a single sync, or earlier once the
+ * oldest has waited HISTORY_LOG_SYNC_S. Without PSRAM the buffer holds one
+ * block and every block is written and synced on its own, as before.
+ *
+ * Every access goes through the medium's backend, which holds the display's
+ * SPI bus for a card on it, slicing long transfers, and erases flash ahead of
+ * the writer on the raw partition.
+ */
+
+#include "history_log.h"
+#include "log_codec.h"
+#include "log_ring.h"
+#include "power_fail.h"
+#include "debug.h"
+#include "esp_rom_crc.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+
+static const uint32_t LOG_FILE_MAGIC    = 0x474C4452; ///< "RDLG"
+static const uint32_t LOG_BLOCK_MAGIC   = 0x424C4452; ///< "RDLB"
+static const uint16_t LOG_FORMAT        = 2;             ///< 1: 31 raw records per block
+static const size_t   LOG_BLOCK_SIZE    = 512;
+static const size_t   LOG_BLOCK_PAYLOAD = LOG_BLOCK_SIZE - HISTORY_LOG_BLOCK_HEADER;
+static const uint32_t LOG_TAIL_SCAN_BLOCKS  = 8; ///< Blocks checked backwards on mount
+static const uint32_t LOG_ERASE_BLOCKS  = 8;     ///< Blocks per 4 KB flash erase sector
+static const uint32_t LOG_RING_RECORDS  = 300;   ///< Records per block of a busy 1 s log, for the ring size
+static const uint32_t LOG_RING_BLOCKS   = HISTORY_LOG_RAW_DAYS
+                                              ? (HISTORY_LOG_RAW_DAYS * 86400UL + LOG_RING_RECORDS - 1) / LOG_RING_RECORDS
+                                              : UINT32_MAX;
+
+struct LogFileHeader {
+    uint32_t magic;
+    uint16_t format;
+    uint16_t blockSize;
+    uint16_t recordSize;    ///< Decoded record size
+    uint16_t recordsPerBlock; ///< 0: variable (columnar blocks)
+    uint32_t crc;           ///< CRC-32 of the fields above
+    uint8_t  reserved[LOG_BLOCK_SIZE - 16];
+};
+
+struct LogBlock {
+    uint32_t magic;
+    uint16_t recordCount;
+    uint16_t payloadLength;
+    uint32_t firstSequence;
+    uint32_t firstTimestamp;
+    uint32_t minTimestamp;  ///< Timestamps restart at every boot, so the first is not the minimum
+    uint32_t maxTimestamp;
+    uint32_t minCounts;
+    uint32_t maxCounts;
+    uint16_t columnLength[LOG_COLUMN_COUNT];
+    uint32_t crc;           ///< CRC-32 of the header after the magic and of the payload
+    uint8_t  payload[LOG_BLOCK_PAYLOAD];
+};
+
+static_assert(sizeof(LogRecord) == 16, "LogRecord must stay 16 bytes");
+static_assert(offsetof(LogBlock, payload) == HISTORY_LOG_BLOCK_HEADER, "block header layout is part of the API");
+static_assert(sizeof(LogFileHeader) == LOG_BLOCK_SIZE, "file header must fill one sector");
+static_assert(sizeof(LogBlock) == LOG_BLOCK_SIZE, "log block must fill one sector");
+static_assert(HISTORY_LOG_WRITE_BUFFER % LOG_BLOCK_SIZE == 0, "write buffer must hold whole sectors");
+static_assert(HISTORY_LOG_WRITE_CHUNK <= HISTORY_LOG_WRITE_BUFFER, "write chunk must fit the buffer");
+static_assert(HISTORY_LOG_RAW_DAYS == 0 || HISTORY_LOG_RAW_DAYS >= 2, "the summaries are rebuilt from up to a day of the log");
+
+static LogStorage* storage = nullptr;
+static QueueHandle_t logQueue = nullptr;
+static TaskHandle_t logTaskHandle = nullptr;
+static volatile bool flushRequested = false;
+
+static LogBlockEncoder<LOG_BLOCK_PAYLOAD> pendingBlock; ///< Block being filled by the logger task
+static uint32_t nextSequence = 0;
+
+// Block slots on the medium; written by the logger task, read by the exports
+struct LogRing {
+    uint32_t capacity; ///< Slots before the writer wraps (UINT32_MAX: never)
+    uint32_t head;     ///< Slot of the first block in the write buffer
+    uint32_t stored;   ///< Slots written; all of them once wrapped
+    uint32_t synced;   ///< Sequence after the newest block stored
+};
+static LogRing ring = {LOG_RING_BLOCKS, 0, 0, 0};
+static portMUX_TYPE ringMux = portMUX_INITIALIZER_UNLOCKED;
+
+static LogBlock* writeBuffer = nullptr;  ///< Sealed blocks not yet stored
+static LogBlock fallbackBlock;           ///< One-block buffer when PSRAM is missing
+static uint32_t bufferCapacity = 0;      ///< In blocks
+static uint32_t bufferedBlocks = 0;
+static uint32_t oldestBufferedMs = 0;    ///< When the first buffered block was sealed
+static bool olderFormat = false;         ///< The existing log uses an earlier LOG_FORMAT
+
+// Every record until it is stored, for the power-fail flush (power_fail.h):
+// slot sequence % POWER_FAIL_LOG_RECORDS, the sequence written last
+static LogRecord* rescueJournal = nullptr;
+static LogBlockEncoder<LOG_BLOCK_PAYLOAD> rescueEncoder; ///< Power-fail task only
+
+static HistoryLogStats logStats = {false, false, nullptr, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+
+static uint32_t blockCrc(const LogBlock& block) {
+    // Covers everything after the magic except the crc field itself
+    uint32_t crc = esp_rom_crc32_le(0, (const uint8_t*)&block.recordCount,
+                                    offsetof(LogBlock, crc) - offsetof(LogBlock, recordCount));
+    return esp_rom_crc32_le(crc, block.payload, block.payloadLength);
+}
+
+static uint32_t headerCrc(const LogFileHeader& header) {
+    return esp_rom_crc32_le(0, (const uint8_t*)&header, offsetof(LogFileHeader, crc));
+}
+
+static bool blockValid(const LogBlock& block) {
+    if (block.magic != LOG_BLOCK_MAGIC || block.recordCount == 0 || block.payloadLength > LOG_BLOCK_PAYLOAD) {
+        return false;
+    }
+    uint32_t columns = 0;
+    for (int c = 0; c < LOG_COLUMN_COUNT; c++) columns += block.columnLength[c];
+    return columns == block.payloadLength && block.crc == blockCrc(block);
+}
+
+/**
+ * @brief Reads the block in @p slot; false if it is not a valid block.
+ */
+static bool readBlock(uint32_t slot, LogBlock& block) {
+    return storage->read(slot + 1, &block, 1) && blockValid(block);
+}
+
+static LogRing ringSnapshot() {
+    portENTER_CRITICAL(&ringMux);
+    LogRing copy = ring;
+    portEXIT_CRITICAL(&ringMux);
+    return copy;
+}
+
+/**
+ * @brief Slot of the @p index-th stored block, oldest first.
+ */
+static uint32_t ringSlot(const LogRing& r, uint32_t index) {
+    uint32_t oldest = r.stored < r.capacity ? 0 : r.head;
+    return (uint32_t)(((uint64_t)oldest + index) % r.capacity);
+}
+
+/**
+ * @brief Writes the buffered blocks at their slots, wrapping at the end of the
+ *        ring, and syncs them.
+ */
+static bool writeBufferedBlocks() {
+    if (bufferedBlocks == 0) return true;
+
+    const uint8_t* data = (const uint8_t*)writeBuffer;
+    uint32_t head = ring.head; // Only this task moves it
+    uint32_t first = bufferedBlocks < ring.capacity - head ? bufferedBlocks : ring.capacity - head;
+    uint32_t records = 0;
+    uint32_t payloadBytes = 0;
+    for (uint32_t b = 0; b < bufferedBlocks; b++) {
+        records += writeBuffer[b].recordCount;
+        payloadBytes += writeBuffer[b].payloadLength;
+    }
+
+    int64_t startUs = esp_timer_get_time();
+    bool written = storage->write(head + 1, data, first) &&
+                   (first == bufferedBlocks ||
+                    storage->write(1, data + first * LOG_BLOCK_SIZE, bufferedBlocks - first)) &&
+                   storage->sync();
+
+    if (!written) {
+        // Drop the batch rather than grow it; the slots are retried with the next blocks
+        logStats.writeErrors++;
+        bufferedBlocks = 0;
+        logStats.buffered = 0;
+        return false;
+    }
+
+    portENTER_CRITICAL(&ringMux);
+    ring.head = (uint32_t)(((uint64_t)head + bufferedBlocks) % ring.capacity);
+    ring.stored = ring.capacity - ring.stored > bufferedBlocks ? ring.stored + bufferedBlocks : ring.capacity;
+    ring.synced = writeBuffer[bufferedBlocks - 1].firstSequence + writeBuffer[bufferedBlocks - 1].recordCount;
+    portEXIT_CRITICAL(&ringMux);
+    logStats.blocks = ring.stored;
+    logStats.records += records;
+    logStats.payloadBytes += payloadBytes;
+    logStats.writtenBytes += bufferedBlocks * LOG_BLOCK_SIZE;
+    logStats.writeUs += esp_timer_get_time() - startUs;
+    logStats.syncs++;
+    bufferedBlocks = 0;
+    logStats.buffered = 0;
+    return true;
+}
+
+/**
+ * @brief Encodes the records of @p encoder into @p block and clears the encoder.
+ */
+static void sealBlock(LogBlockEncoder<LOG_BLOCK_PAYLOAD>& encoder, LogBlock& block) {
+    memset(&block, 0, sizeof(block));
+    block.magic = LOG_BLOCK_MAGIC;
+    block.recordCount = encoder.count();
+    block.firstSequence = encoder.first().sequence;
+    block.firstTimestamp = encoder.first().timestamp;
+    block.minTimestamp = encoder.minTimestamp();
+    block.maxTimestamp = encoder.maxTimestamp();
+    block.minCounts = encoder.minCounts();
+    block.maxCounts = encoder.maxCounts();
+    block.payloadLength = (uint16_t)encoder.finish(block.payload, block.columnLength);
+    block.crc = blockCrc(block);
+    encoder.clear();
+}
+
+/**
+ * @brief Encodes pendingBlock into the write buffer; writes the buffer once a chunk is due.
+ */
+static void sealPendingBlock() {
+    if (pendingBlock.count() == 0) return;
+
+    sealBlock(pendingBlock, writeBuffer[bufferedBlocks]);
+
+    if (bufferedBlocks == 0) oldestBufferedMs = millis();
+    bufferedBlocks++;
+    logStats.buffered = bufferedBlocks;
+
+    if (bufferedBlocks * LOG_BLOCK_SIZE >= HISTORY_LOG_WRITE_CHUNK || bufferedBlocks >= bufferCapacity) {
+        writeBufferedBlocks();
+    }
+}
+
+/**
+ * @brief Creates the index header of a new, empty log file.
+ */
+static bool writeFileHeader() {
+    LogFileHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = LOG_FILE_MAGIC;
+    header.format = LOG_FORMAT;
+    header.blockSize = LOG_BLOCK_SIZE;
+    header.recordSize = sizeof(LogRecord);
+    header.recordsPerBlock = 0;
+    header.crc = headerCrc(header);
+
+    return storage->write(0, &header, 1) && storage->sync();
+}
+
+/**
+ * @brief Validates an existing log and finds the write position.
+ *
+ * The newest block is located from the block sequence numbers (log_ring.h).
+ * A torn block at the write position is a write that was cut short and will
+ * be overwritten by the next block. A log that has wrapped keeps its size as
+ * the ring; one that has not grows to the ring size, or wraps at its current
+ * size if it is already larger.
+ */
+static bool recoverLog(uint32_t ringBlocks) {
+    LogFileHeader header;
+    if (!storage->read(0, &header, 1) || header.magic != LOG_FILE_MAGIC || header.crc != headerCrc(header)) {
+        return false;
+    }
+    if (header.format != LOG_FORMAT) {
+        olderFormat = true;
+        return false;
+    }
+
+    uint32_t extent = storage->extent();
+    uint32_t slots = extent > 1 ? extent - 1 : 0;
+
+    LogBlock block;
+    LogRingScan scan = logRingScan(slots, LOG_TAIL_SCAN_BLOCKS, [&block](uint32_t slot, uint32_t* sequence) {
+        if (!readBlock(slot, block)) return false;
+        *sequence = block.firstSequence;
+        return true;
+    });
+    logStats.recovered += scan.discarded;
+    uint32_t newest = scan.head ? scan.head - 1 : slots - 1;
+    if (scan.stored && readBlock(newest, block)) {
+        nextSequence = block.firstSequence + block.recordCount;
+    }
+
+    ring.capacity = scan.wrapped ? slots : slots > ringBlocks ? slots : ringBlocks;
+    ring.head = scan.head % ring.capacity;
+    ring.stored = scan.stored;
+    ring.synced = nextSequence;
+    logStats.blocks = ring.stored;
+    // Records since the log was created; exact enough for statistics
+    logStats.records = nextSequence;
+    return true;
+}
+
+/**
+ * @brief Keeps @p record for the power-fail flush until it is stored.
+ */
+static void journalRecord(const LogRecord& record) {
+    if (!rescueJournal) return;
+    LogRecord& entry = rescueJournal[record.sequence % POWER_FAIL_LOG_RECORDS];
+    __atomic_store_n(&entry.sequence, UINT32_MAX, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    entry.timestamp = record.timestamp;
+    entry.counts = record.counts;
+    entry.seconds = record.seconds;
+    entry.flags = record.flags;
+    __atomic_store_n(&entry.sequence, record.sequence, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Copies the journal's record @p sequence; false if it was overwritten or is being written.
+ */
+static bool journalRead(uint32_t sequence, LogRecord* out) {
+    const LogRecord& entry = rescueJournal[sequence % POWER_FAIL_LOG_RECORDS];
+    if (__atomic_load_n(&entry.sequence, __ATOMIC_ACQUIRE) != sequence) return false;
+    out->timestamp = entry.timestamp;
+    out->counts = entry.counts;
+    out->seconds = entry.seconds;
+    out->flags = entry.flags;
+    out->sequence = sequence;
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(&entry.sequence, __ATOMIC_RELAXED) == sequence;
+}
+
+/**
+ * @brief Continues the log with the records a power-fail flush saved that it
+ *        had not stored, and writes them. Before the logger task starts.
+ */
+static void restoreRescuedRecords() {
+    const uint8_t* data = nullptr;
+    uint32_t blocks = powerFailRescuedLog(&data);
+    uint32_t restored = 0;
+    LogBlock block;
+    for (uint32_t b = 0; b < blocks; b++) {
+        memcpy(&block, data + b * LOG_BLOCK_SIZE, LOG_BLOCK_SIZE);
+        if (!blockValid(block)) continue;
+        LogBlockDecoder decoder(block.payload, block.columnLength, block.recordCount,
+                                block.firstTimestamp, block.firstSequence);
+        LogRecord record;
+        while (decoder.next(&record)) {
+            if ((int32_t)(record.sequence - nextSequence) < 0) continue; // Stored before the supply failed
+            if (record.sequence != nextSequence) {
+                // Records the flush missed: the block ends at the gap
+                sealPendingBlock();
+                nextSequence = record.sequence;
+            }
+            nextSequence++;
+            if (!pendingBlock.add(record)) {
+                sealPendingBlock();
+                pendingBlock.add(record);
+            }
+            restored++;
+        }
+    }
+    if (restored == 0) return;
+    sealPendingBlock();
+    writeBufferedBlocks();
+    DEBUG_PRINTF("History log: %u record(s) restored from the power-fail flush\n", (unsigned)restored);
+}
+
+/**
+ * @brief Logger task: batches queued records into blocks and blocks into chunk writes;
+ *        everything, including a partial block, is written on request.
+ */
+static void historyLogTask(void* parameter) {
+    LogRecord record;
+    for (;;) {
+        if (xQueueReceive(logQueue, &record, pdMS_TO_TICKS(1000)) == pdTRUE) {
+            record.sequence = nextSequence++;
+            journalRecord(record);
+            if (!pendingBlock.add(record)) {
+                sealPendingBlock();
+                pendingBlock.add(record);
+            }
+        }
+        if (flushRequested) {
+            flushRequested = false;
+            sealPendingBlock();
+            writeBufferedBlocks();
+        } else if (bufferedBlocks > 0 && millis() - oldestBufferedMs >= HISTORY_LOG_SYNC_S * 1000UL) {
+            writeBufferedBlocks();
+        }
+    }
+}
+
+/**
+ * @brief Starts the medium and recovers or creates the log on it.
+ */
+static bool openLog() {
+    storage = initLogStorage();
+    if (!storage) {
+        DEBUG_PRINTLN("History log: no storage (SD card, flash partition or LittleFS)");
+        return false;
+    }
+    // The ring stops short of what the medium holds, and ends with a flash
+    // erase sector, so on the partition a wrapped ring is all that was written
+    uint32_t ringBlocks = storage->capacity() > 1 ? storage->capacity() - 1 : 0;
+    if (ringBlocks > LOG_RING_BLOCKS) ringBlocks = LOG_RING_BLOCKS;
+    if (ringBlocks != UINT32_MAX) ringBlocks -= (ringBlocks + 1) % LOG_ERASE_BLOCKS;
+    if (ringBlocks < LOG_TAIL_SCAN_BLOCKS) {
+        DEBUG_PRINTF("History log: no room on %s\n", storage->name());
+        return false;
+    }
+
+    bool exists = storage->extent() > 0;
+    if (!exists || !recoverLog(ringBlocks)) {
+        // Older format (decodable with tools/decode_history_log.py) or an unknown or
+        // damaged header: keep the file where the medium can, start a fresh log
+        const char* keptSuffix = !exists ? nullptr : olderFormat ? ".v1" : ".bad";
+        ring = {ringBlocks, 0, 0, 0};
+        nextSequence = 0;
+        if (!storage->reset(keptSuffix) || !writeFileHeader()) {
+            DEBUG_PRINTLN("History log: cannot create the log");
+            return false;
+        }
+    }
+    return true;
+}
+
+bool initHistoryLog() {
+#if HISTORY_LOG_ENABLED
+    if (logStats.mounted) return true;
+
+    if (!openLog()) return false;
+
+    pendingBlock.clear();
+    writeBuffer = (LogBlock*)heap_caps_malloc(HISTORY_LOG_WRITE_BUFFER, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    bufferCapacity = HISTORY_LOG_WRITE_BUFFER / LOG_BLOCK_SIZE;
+    if (!writeBuffer) {
+        writeBuffer = &fallbackBlock;
+        bufferCapacity = 1;
+    }
+    logQueue = xQueueCreate(HISTORY_LOG_QUEUE_DEPTH, sizeof(LogRecord));
+    if (!logQueue) return false;
+
+    restoreRescuedRecords();
+    if (POWER_FAIL_PIN >= 0) {
+        rescueJournal = (LogRecord*)heap_caps_calloc(POWER_FAIL_LOG_RECORDS, sizeof(LogRecord),
+                                                     MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        if (rescueJournal) {
+            // Slot 0 would otherwise pass for record 0
+            for (uint32_t i = 0; i < POWER_FAIL_LOG_RECORDS; i++) rescueJournal[i].sequence = UINT32_MAX;
+        }
+    }
+
+    xTaskCreatePinnedToCore(historyLogTask, "HistoryLog", 4096, NULL,
+                            NETWORK_TASK_PRIORITY, &logTaskHandle, TASK_CORE_NETWORK);
+
+    logStats.mounted = true;
+    logStats.sdmmc = storage->kind() == LOG_STORAGE_SD && HISTORY_LOG_SDMMC;
+    logStats.storage = storage->name();
+    logStats.ringBlocks = ring.capacity == UINT32_MAX ? 0 : ring.capacity;
+    DEBUG_PRINTF("History log: on %s, %u blocks (ring of %u), next seq %u, %u torn block(s) discarded, %u KB write-behind\n",
+                 logStats.storage, logStats.blocks, logStats.ringBlocks, nextSequence, logStats.recovered,
+                 (unsigned)(bufferCapacity * LOG_BLOCK_SIZE / 1024));
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool logHistoryRecord(uint32_t timestamp, uint32_t counts, uint16_t seconds, uint16_t flags) {
+    if (!logQueue) return false;
+
+    LogRecord record;
+    record.timestamp = timestamp;
+    record.counts = counts;
+    record.seconds = seconds;
+    record.flags = flags;
+    record.sequence = 0; // Assigned by the logger task
+
+    if (xQueueSend(logQueue, &record, 0) != pdTRUE) {
+        logStats.dropped++;
+        return false;
+    }
+    return true;
+}
+
+void flushHistoryLog() {
+    flushRequested = true;
+}
+
+HistoryLogStats getHistoryLogStats() {
+    return logStats;
+}
+
+size_t exportHistoryLogCsv(Print& out, uint32_t fromTs, uint32_t toTs) {
+    if (!logStats.mounted) return 0;
+    out.println("timestamp,counts,seconds,flags");
+
+    LogBlock block;
+    LogRecord r;
+    size_t exported = 0;
+    LogRing blocks = ringSnapshot();
+    for (uint32_t b = 0; b < blocks.stored; b++) {
+        // The block index skips blocks outside the range without decoding them
+        if (!readBlock(ringSlot(blocks, b), block) || block.maxTimestamp < fromTs ||
+            block.minTimestamp > toTs) {
+            continue;
+        }
+        // Timestamps restart at every boot, so records are filtered individually
+        LogBlockDecoder decoder(block.payload, block.columnLength, block.recordCount,
+                                block.firstTimestamp, block.firstSequence);
+        while (decoder.next(&r)) {
+            if (r.timestamp < fromTs || r.timestamp > toTs) continue;
+            out.printf("%u,%u,%u,%u\n", r.timestamp, r.counts, r.seconds, r.flags);
+            exported++;
+        }
+    }
+    return exported;
+}
+
+size_t exportHistoryLogBlocks(Print& out, uint32_t fromTs, uint32_t toTs) {
+    if (!logStats.mounted) return 0;
+    LogBlock block;
+    size_t exported = 0;
+    LogRing blocks = ringSnapshot();
+    for (uint32_t b = 0; b < blocks.stored; b++) {
+        if (!readBlock(ringSlot(blocks, b), block) || block.maxTimestamp < fromTs ||
+            block.minTimestamp > toTs) {
+            continue;
+        }
+        // Header and the used part of the payload; the rest of the sector is padding
+        if (out.write((const uint8_t*)&block, HISTORY_LOG_BLOCK_HEADER + block.payloadLength) !=
+            HISTORY_LOG_BLOCK_HEADER + block.payloadLength) {
+            break;
+        }
+        exported++;
+    }
+    return exported;
+}
+
+static LogBlock compactBlock;
+static uint32_t compactSlot = UINT32_MAX;    ///< Slot it read last
+static uint32_t compactEnd = 0;              ///< Sequence after that block
+
+size_t historyLogReadFrom(uint32_t sequence, HistoryLogVisitor visit, void* context, uint32_t* next) {
+    *next = sequence;
+    if (!logStats.mounted) return 0;
+    LogRing blocks = ringSnapshot();
+    if (blocks.stored == 0 || sequence >= blocks.synced) return 0; // Nothing newer stored yet
+
+    // Usually the block after the one read last
+    LogBlock& block = compactBlock;
+    uint32_t slot = compactSlot == UINT32_MAX ? 0 : (compactSlot + 1) % blocks.capacity;
+    bool found = compactSlot != UINT32_MAX && compactEnd == sequence &&
+                 readBlock(slot, block) && block.firstSequence == sequence;
+    if (!found) {
+        // Otherwise bisect for the first block starting after the sequence;
+        // the one before it holds the sequence, unless it was reused already
+        uint32_t lo = 0, hi = blocks.stored;
+        while (lo < hi) {
+            uint32_t mid = lo + (hi - lo) / 2;
+            if (!readBlock(ringSlot(blocks, mid), block) || block.firstSequence <= sequence) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        for (uint32_t index = lo ? lo - 1 : 0;; index++) {
+            if (index >= blocks.stored) return 0;
+            slot = ringSlot(blocks, index);
+            if (readBlock(slot, block) && block.firstSequence + block.recordCount > sequence) {
+                break;
+            }
+        }
+    }
+
+    LogBlockDecoder decoder(block.payload, block.columnLength, block.recordCount,
+                            block.firstTimestamp, block.firstSequence);
+    LogRecord r;
+    size_t passed = 0;
+    while (decoder.next(&r)) {
+        if (r.sequence < sequence) continue;
+        visit(r, context);
+        passed++;
+    }
+    compactSlot = slot;
+    compactEnd = block.firstSequence + block.recordCount;
+    *next = compactEnd;
+    return passed;
+}
+
+bool historyLogRescueBlock(uint32_t* cursor, void* block) {
+    if (!rescueJournal) return false;
+    uint32_t end = __atomic_load_n(&nextSequence, __ATOMIC_RELAXED);
+    if (*cursor == UINT32_MAX) {
+        uint32_t synced = ringSnapshot().synced;
+        *cursor = end - synced > POWER_FAIL_LOG_RECORDS ? end - POWER_FAIL_LOG_RECORDS : synced;
+    }
+    rescueEncoder.clear();
+    LogRecord record;
+    while ((int32_t)(end - *cursor) > 0) {
+        if (!journalRead(*cursor, &record)) {
+            // Sequences within a block are consecutive; a missing one ends it
+            if (rescueEncoder.count() > 0) break;
+            (*cursor)++;
+            continue;
+        }
+        if (!rescueEncoder.add(record)) break;
+        (*cursor)++;
+    }
+    if (rescueEncoder.count() == 0) return false;
+    sealBlock(rescueEncoder, *(LogBlock*)block);
+    return true;
+}
+
+static bool rawOpen = false;
+
+uint32_t historyLogRawOpen() {
+    if (!logStats.mounted) return 0;
+    rawOpen = true;
+    // Only the blocks already synced; the one being written may be torn. A
+    // wrapped log is every slot, the blocks in slot order
+    return (ringSnapshot().stored + 1) * LOG_BLOCK_SIZE;
+}
+
+size_t historyLogRawRead(uint32_t offset, uint8_t* out, size_t length) {
+    if (!rawOpen) return 0;
+    size_t done = 0;
+    while (done < length) {
+        // Whole sectors straight into the caller's buffer, a partial one through a copy
+        uint32_t position = offset + done;
+        uint32_t within = position % LOG_BLOCK_SIZE;
+        size_t remaining = length - done;
+        if (within == 0 && remaining >= LOG_BLOCK_SIZE) {
+            uint32_t count = remaining / LOG_BLOCK_SIZE;
+            if (!storage->read(position / LOG_BLOCK_SIZE, out + done, count)) break;
+            done += count * LOG_BLOCK_SIZE;
+        } else {
+            uint8_t sector[LOG_BLOCK_SIZE];
+            if (!storage->read(position / LOG_BLOCK_SIZE, sector, 1)) break;
+            size_t n = LOG_BLOCK_SIZE - within < remaining ? LOG_BLOCK_SIZE - within : remaining;
+            memcpy(out + done, sector + within, n);
+            done += n;
+        }
+    }
+    return done;
+}
+
+void historyLogRawClose() {
+    rawOpen = false;
+}
+
+bool historyLogBenchmark(Print& out) {
+    if (!sdCardMounted()) {
+        out.println("Log benchmark: no card");
+        return false;
+    }
+    static const size_t SIZES[] = {512, 4096, 16384, 32768};
+    static const size_t TOTAL_BYTES = 512 * 1024; ///< Per write size
+    static const char* BENCH_PATH = HISTORY_LOG_PATH ".bench";
+
+    uint8_t* data = (uint8_t*)heap_caps_malloc(32768, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!data) data = (uint8_t*)heap_caps_malloc(32768, MALLOC_CAP_8BIT);
+    if (!data) {
+        out.println("Log benchmark: no buffer");
+        return false;
+    }
+    for (size_t i = 0; i < 32768; i++) data[i] = (uint8_t)i;
+
+    out.printf("Log benchmark: %s, %u KB per write size, sync every 32 KB\n",
+               HISTORY_LOG_SDMMC ? "SDMMC" : "SPI (sliced bus holds)", (unsigned)(TOTAL_BYTES / 1024));
+    bool ok = true;
+    for (size_t s = 0; s < sizeof(SIZES) / sizeof(SIZES[0]) && ok; s++) {
+        size_t size = SIZES[s];
+        sdCardBegin();
+        File file = sdCardFs().open(BENCH_PATH, "w");
+        sdCardEnd();
+        if (!file) {
+            ok = false;
+            break;
+        }
+
+        int64_t start = esp_timer_get_time();
+        int64_t longestHold = 0;
+        for (size_t done = 0; done < TOTAL_BYTES && ok; done += size) {
+            // The same slicing as the logger, so the bus hold matches production
+            size_t step = HISTORY_LOG_SDMMC ? size : HISTORY_LOG_SPI_SLICE;
+            for (size_t offset = 0; offset < size && ok; offset += step) {
+                size_t slice = size - offset < step ? size - offset : step;
+                int64_t held = esp_timer_get_time();
+                sdCardBegin();
+                ok = file.write(data + offset, slice) == slice;
+                if ((done + offset + slice) % 32768 == 0) file.flush();
+                sdCardEnd();
+                held = esp_timer_get_time() - held;
+                if (held > longestHold) longestHold = held;
+            }
+        }
+        int64_t elapsed = esp_timer_get_time() - start;
+
+        sdCardBegin();
+        file.close();
+        sdCardFs().remove(BENCH_PATH);
+        sdCardEnd();
+        if (!ok) break;
+        out.printf("  %5u B writes: %7.1f KB/s, longest card hold %lld us\n", (unsigned)size,
+                   TOTAL_BYTES / 1024.0 / (elapsed / 1e6), (long long)longestHold);
+    }
+    heap_caps_free(data);
+    if (!ok) out.println("Log benchmark: write failed");
+    return ok;
+}
@@ -0,0 +1,102 @@
+#ifndef HISTORY_LOG_H
+#define HISTORY_LOG_H
+
+#include <Arduino.h>
+#include <FS.h>
+#include "config.h"
+#include "log_codec.h" // LogRecord and the columnar block encoding
+#include "log_storage.h" // The media it can live on, and the SD card for other users
+
+// Binary history log on the microSD card (SPI or SDMMC, config.h), or on
+// internal flash without one (log_storage.h).
+// Fixed 16-byte records are queued by pulseTask without blocking and packed
+// column by column into 512-byte CRC-protected blocks (one SD sector, ~450
+// records of a 1 s log) by a low-priority logger task, which writes them in
+// sector-aligned chunks from a PSRAM write-behind buffer. The file is a ring
+// of HISTORY_LOG_RAW_DAYS (log_ring.h): blocks are written in slot order and
+// only the oldest ones are ever rewritten, once the log is full, after the
+// compaction job (log_compaction.h) has summarised them. A brownout can at
+// worst lose the block being filled, the buffered blocks and a torn write,
+// which is detected by its CRC and overwritten on the next boot.
+
+// Stream of /api/history?src=log&format=col and exportHistoryLogBlocks(): each
+// block as its HISTORY_LOG_BLOCK_HEADER-byte header (little-endian: u32 magic
+// "RDLB", u16 recordCount, u16 payloadLength, u32 firstSequence, u32
+// firstTimestamp, u32 min/max timestamp, u32 min/max counts, u16 column
+// lengths[4], u32 crc) followed by payloadLength bytes of columns
+// (log_codec.h). tools/decode_history_log.py turns it, or the log file
+// itself, into CSV.
+#define HISTORY_LOG_BLOCK_HEADER 44
+
+struct HistoryLogStats {
+    bool mounted;          ///< Log open on a medium
+    bool sdmmc;            ///< Card on the SDMMC peripheral rather than the display's SPI bus
+    const char* storage;   ///< Name of that medium (log_storage.h), nullptr if none
+    uint32_t records;      ///< Records logged since the file was created
+    uint32_t blocks;       ///< Data blocks in the file
+    uint32_t ringBlocks;   ///< Blocks before the oldest are reused (0: never)
+    uint32_t buffered;     ///< Sealed blocks waiting in the write-behind buffer
+    uint32_t syncs;        ///< Chunk writes (each followed by one sync)
+    uint32_t payloadBytes; ///< Encoded column bytes written since boot
+    uint32_t writtenBytes; ///< Block bytes written since boot
+    uint64_t writeUs;      ///< Time spent in those writes and their syncs
+    uint32_t dropped;      ///< Records lost because the queue was full
+    uint32_t writeErrors;  ///< Failed block writes
+    uint32_t recovered;    ///< Torn tail blocks discarded at mount
+};
+
+// Starts the log's medium (initLogStorage()), validates or creates the log and
+// starts the logger task. Call after the TFT is initialised (on SPI the card
+// shares its bus).
+bool initHistoryLog();
+
+// Queues a record for the logger task. Never blocks; false if the record was dropped.
+bool logHistoryRecord(uint32_t timestamp, uint32_t counts, uint16_t seconds, uint16_t flags);
+
+// Asks the logger task to write out the buffered and the partially filled block now (e.g. before OTA).
+void flushHistoryLog();
+
+// Power-fail flush (power_fail.h): encodes the next records not yet stored
+// into one 512-byte block at @p block, from *@p cursor on (UINT32_MAX on the
+// first call: the oldest kept). False once none are left. Lock-free, for the
+// flush task only; a record the logger task is taking in may be missed.
+// initHistoryLog() continues the log with the records such a flush saved.
+bool historyLogRescueBlock(uint32_t* cursor, void* block);
+
+// Snapshot of the logger statistics.
+HistoryLogStats getHistoryLogStats();
+
+// Streams records within [fromTs, toTs] as CSV ("timestamp,counts,seconds,flags").
+// Returns the number of records written.
+size_t exportHistoryLogCsv(Print& out, uint32_t fromTs = 0, uint32_t toTs = UINT32_MAX);
+
+// Streams the still-encoded blocks whose timestamps overlap [fromTs, toTs] (see
+// above). Returns the number of blocks written.
+size_t exportHistoryLogBlocks(Print& out, uint32_t fromTs = 0, uint32_t toTs = UINT32_MAX);
+
+// Reader of the compaction job (log_compaction.h): decodes the synced block
+// holding record @p sequence, or the oldest block after it if that one was
+// reused already, and passes its records from @p sequence on to @p visit.
+// Sets @p next to the sequence after that block. Returns the records passed;
+// 0 if nothing from @p sequence on is stored yet. One caller at a time.
+typedef void (*HistoryLogVisitor)(const LogRecord& record, void* context);
+size_t historyLogReadFrom(uint32_t sequence, HistoryLogVisitor visit, void* context, uint32_t* next);
+
+// Raw read-only view of the log as it is stored, for the USB drive
+// (usb_drive.h): the file header and the blocks in slot order, the same
+// layout on every medium. historyLogRawOpen() returns the length of the
+// header and the blocks synced so far (0 if not mounted). Until the ring
+// wraps those never change, so a snapshot of that length stays consistent
+// while the logger appends behind it; once it has wrapped, the reader sorts
+// the blocks by sequence. On the SPI card reads hold the bus for at most
+// HISTORY_LOG_SPI_SLICE bytes at a time. historyLogRawRead() returns bytes read.
+uint32_t historyLogRawOpen();
+size_t historyLogRawRead(uint32_t offset, uint8_t* out, size_t length);
+void historyLogRawClose();
+
+// Writes 512 KB at each of 512 B, 4 KB, 16 KB and 32 KB per write to a scratch
+// file on the card and prints the throughput and the longest single card hold
+// ("logbench"). logStorageBenchmark() compares the media.
+bool historyLogBenchmark(Print& out);
+
+#endif // HISTORY_LOG_H
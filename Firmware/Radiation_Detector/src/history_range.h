@@ -0,0 +1,189 @@
+#ifndef HISTORY_RANGE_H
+#define HISTORY_RANGE_H
+
+#include "history_store.h"
+
+/**
+ * @brief Forward iterator over a time range of a HistoryStore level.
+ *
+ * Buckets are copied out of the store in small batches, so a range of any size
+ * is walked in constant memory. With @p step larger than the level's bucket
+ * length, consecutive buckets falling into the same step-aligned interval are
+ * merged into one point (counts summed, min/max combined). Each batch is located
+ * again by start time, so buckets evicted or appended between batches never
+ * shift the walk. No Arduino dependencies (host-compilable).
+ *
+ * This is the one decimation kernel of the firmware: /api/history (maxPoints=)
+ * and the on-device time-series view (timeseries_view.h) both reduce a range
+ * to points with it. Besides the merged bucket, each point carries the lowest
+ * and highest mean rate of the buckets merged into it (lowRate(), highRate()),
+ * which is the spread the view draws.
+ */
+class HistoryRange {
+public:
+    HistoryRange(const HistoryStore& store, HistoryLevel level,
+                 uint32_t from, uint32_t to, uint32_t step)
+        : store_(store), level_(level), nextFrom_(from), to_(to),
+          step_(step ? step : 1), got_(0), pos_(0), exhausted_(false),
+          havePending_(false), pendingGroup_(0) {}
+
+    /// Produces the next point; false once the range is exhausted.
+    bool next(HistoryBucket* out) {
+        while (!exhausted_) {
+            if (pos_ >= got_ && !refill()) break;
+
+            const HistoryBucket& b = batch_[pos_];
+            if (b.startTime > to_) {
+                exhausted_ = true;
+                break;
+            }
+            uint32_t group = b.startTime - b.startTime % step_;
+            if (havePending_ && group != pendingGroup_) {
+                // b opens the next point: hand out the finished one first
+                *out = pending_;
+                lowRate_ = pendingLow_;
+                highRate_ = pendingHigh_;
+                startPoint(b, group);
+                pos_++;
+                return true;
+            }
+            if (havePending_) {
+                merge(b);
+            } else {
+                startPoint(b, group);
+            }
+            pos_++;
+        }
+        if (havePending_) {
+            *out = pending_;
+            lowRate_ = pendingLow_;
+            highRate_ = pendingHigh_;
+            havePending_ = false;
+            return true;
+        }
+        return false;
+    }
+
+    /// Lowest and highest mean rate (cps) among the buckets with data in the
+    /// point last produced; both 0 if none had any.
+    float lowRate() const { return lowRate_; }
+    float highRate() const { return highRate_; }
+
+private:
+    static const size_t BATCH = 32;
+
+    bool refill() {
+        size_t offset = store_.findOffset(level_, nextFrom_);
+        got_ = store_.read(level_, offset, batch_, BATCH);
+        pos_ = 0;
+        if (got_ == 0) {
+            exhausted_ = true;
+            return false;
+        }
+        nextFrom_ = batch_[got_ - 1].startTime + 1;
+        return true;
+    }
+
+    void startPoint(const HistoryBucket& b, uint32_t group) {
+        pending_ = b;
+        pending_.startTime = group;
+        pendingGroup_ = group;
+        havePending_ = true;
+        pendingLow_ = pendingHigh_ = b.meanCps();
+        pendingRated_ = b.seconds != 0;
+    }
+
+    void merge(const HistoryBucket& b) {
+        pending_.counts += b.counts;
+        // seconds is 16-bit: a point longer than ~18 h saturates rather than wraps
+        uint32_t seconds = (uint32_t)pending_.seconds + b.seconds;
+        pending_.seconds = seconds > 0xFFFF ? 0xFFFF : (uint16_t)seconds;
+        if (b.minCps < pending_.minCps) pending_.minCps = b.minCps;
+        if (b.maxCps > pending_.maxCps) pending_.maxCps = b.maxCps;
+        pending_.flags |= b.flags;
+        if (b.seconds == 0) return;
+        float rate = b.meanCps();
+        if (!pendingRated_ || rate < pendingLow_) pendingLow_ = rate;
+        if (!pendingRated_ || rate > pendingHigh_) pendingHigh_ = rate;
+        pendingRated_ = true;
+    }
+
+    const HistoryStore& store_;
+    HistoryLevel level_;
+    uint32_t nextFrom_;
+    uint32_t to_;
+    uint32_t step_;
+    HistoryBucket batch_[BATCH];
+    size_t got_;
+    size_t pos_;
+    bool exhausted_;
+    bool havePending_;
+    uint32_t pendingGroup_;
+    HistoryBucket pending_;
+    bool pendingRated_ = false;
+    float pendingLow_ = 0.0f;
+    float pendingHigh_ = 0.0f;
+    float lowRate_ = 0.0f;
+    float highRate_ = 0.0f;
+};
+
+struct HistoryPlan {
+    HistoryLevel level;
+    uint32_t step;          ///< Seconds per point, a multiple of the level's buckets
+};
+
+/**
+ * @brief Picks the level and step that reduce [from, to] to at most
+ *        @p maxPoints points.
+ *
+ * The level is the coarsest one that retains the whole range and whose
+ * buckets are no longer than the step; the step is rounded up to whole buckets. Points
+ * are aligned to multiples of the step, which can cut one extra point at the
+ * start, so the span is divided by maxPoints - 1. The range is clipped to the
+ * retained data first, so an open range ("from=0") is planned over what exists.
+ * @return false if the store holds nothing in the range
+ */
+inline bool planHistoryPoints(const HistoryStore& store, uint32_t from, uint32_t to,
+                              size_t maxPoints, HistoryPlan* plan) {
+    // The finest level that still holds the start, else the one reaching furthest back
+    HistoryBucket oldest[HISTORY_LEVEL_COUNT], newest[HISTORY_LEVEL_COUNT];
+    bool has[HISTORY_LEVEL_COUNT];
+    int finest = -1;
+    for (int l = 0; l < HISTORY_LEVEL_COUNT; l++) {
+        HistoryLevel level = (HistoryLevel)l;
+        size_t count = store.count(level);
+        has[l] = count && store.read(level, 0, &oldest[l], 1) && store.read(level, count - 1, &newest[l], 1);
+        if (!has[l]) continue;
+        if (finest < 0 || oldest[l].startTime < oldest[finest].startTime) finest = l;
+        if (oldest[l].startTime <= from) {
+            finest = l;
+            break;
+        }
+    }
+    if (finest < 0) return false;
+    uint32_t start = from > oldest[finest].startTime ? from : oldest[finest].startTime;
+    uint32_t end = newest[finest].startTime + HistoryStore::bucketSeconds((HistoryLevel)finest);
+    if (to < end) end = to + 1;
+    if (end <= start) return false;
+
+    uint32_t span = end - start;
+    uint32_t divisor = maxPoints > 1 ? (uint32_t)maxPoints - 1 : 1;
+    uint32_t step = (span + divisor - 1) / divisor;
+
+    plan->level = (HistoryLevel)finest;
+    for (int l = HISTORY_LEVEL_COUNT - 1; l > finest; l--) {
+        HistoryLevel level = (HistoryLevel)l;
+        // A coarser level is cheaper to walk if it still covers the whole range
+        // (its newest bucket lags until the current one is complete)
+        uint32_t bucket = HistoryStore::bucketSeconds(level);
+        if (bucket > step || !has[l] || oldest[l].startTime > start) continue;
+        if (newest[l].startTime + bucket < end) continue;
+        plan->level = level;
+        break;
+    }
+    uint32_t bucket = HistoryStore::bucketSeconds(plan->level);
+    plan->step = (step + bucket - 1) / bucket * bucket;
+    return true;
+}
+
+#endif // HISTORY_RANGE_H
@@ -0,0 +1,188 @@
+/**
+ * @file history_store.cpp
+ * @brief Cascading multi-resolution pulse history kept in PSRAM.
+ *
+ * pulseTask feeds one bucket per second. When 60 one-second buckets have been
+ * merged, a minute bucket is closed; 60 minute buckets close an hour bucket.
+ * Readers (chart drawing, web API) copy buckets out under a short mutex, so the
+ * producer is only ever blocked for the duration of a memcpy.
+ */
+
+#include "history_store.h"
+#include <string.h>
+#include <stdlib.h>
+
+#ifdef ARDUINO
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#endif
+
+static const uint32_t LEVEL_BUCKET_SECONDS[HISTORY_LEVEL_COUNT] = {1, 60, 3600};
+static const uint32_t LEVEL_CAPACITY[HISTORY_LEVEL_COUNT]       = {3600, 10080, 8760};
+
+HistoryStore::HistoryStore() : mutex_(nullptr), ready_(false) {
+    memset(levels_, 0, sizeof(levels_));
+}
+
+bool HistoryStore::begin() {
+    if (ready_) return true;
+
+    for (int l = 0; l < HISTORY_LEVEL_COUNT; l++) {
+        size_t bytes = LEVEL_CAPACITY[l] * sizeof(HistoryBucket);
+#ifdef ARDUINO
+        // Prefer PSRAM; the store is large and only touched once per second
+        void* mem = heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+#else
+        void* mem = malloc(bytes);
+#endif
+        if (!mem) {
+            // All or nothing: a later begin() starts from empty levels
+            for (int k = 0; k < l; k++) {
+#ifdef ARDUINO
+                heap_caps_free(levels_[k].ring);
+#else
+                free(levels_[k].ring);
+#endif
+                levels_[k].ring = nullptr;
+            }
+            return false;
+        }
+        memset(mem, 0, bytes);
+        levels_[l].ring = (HistoryBucket*)mem;
+    }
+
+#ifdef ARDUINO
+    mutex_ = xSemaphoreCreateMutex();
+#endif
+    ready_ = true;
+    return true;
+}
+
+uint32_t HistoryStore::bucketSeconds(HistoryLevel level) {
+    return LEVEL_BUCKET_SECONDS[level];
+}
+
+uint32_t HistoryStore::capacity(HistoryLevel level) {
+    return LEVEL_CAPACITY[level];
+}
+
+void HistoryStore::lock() const {
+#ifdef ARDUINO
+    if (mutex_) xSemaphoreTake((SemaphoreHandle_t)mutex_, portMAX_DELAY);
+#endif
+}
+
+void HistoryStore::unlock() const {
+#ifdef ARDUINO
+    if (mutex_) xSemaphoreGive((SemaphoreHandle_t)mutex_);
+#endif
+}
+
+void HistoryStore::mergeInto(HistoryBucket& dst, const HistoryBucket& src, bool first) {
+    if (first) {
+        dst = src;
+        return;
+    }
+    dst.counts += src.counts;
+    dst.seconds += src.seconds;
+    if (src.minCps < dst.minCps) dst.minCps = src.minCps;
+    if (src.maxCps > dst.maxCps) dst.maxCps = src.maxCps;
+    dst.flags |= src.flags;
+}
+
+void HistoryStore::pushBucket(HistoryLevel level, const HistoryBucket& bucket) {
+    Level& lv = levels_[level];
+    lv.ring[lv.head] = bucket;
+    lv.head = (lv.head + 1) % LEVEL_CAPACITY[level];
+    if (lv.size < LEVEL_CAPACITY[level]) lv.size++;
+
+    // Cascade into the next coarser level
+    int next = level + 1;
+    if (next >= HISTORY_LEVEL_COUNT) return;
+
+    Level& up = levels_[next];
+    mergeInto(up.pending, bucket, up.pendingParts == 0);
+    up.pendingParts++;
+    if (up.pendingParts >= LEVEL_BUCKET_SECONDS[next] / LEVEL_BUCKET_SECONDS[level]) {
+        HistoryBucket closed = up.pending;
+        up.pendingParts = 0;
+        pushBucket((HistoryLevel)next, closed);
+    }
+}
+
+void HistoryStore::addSecond(uint32_t timestamp, uint32_t counts) {
+    if (!ready_) return;
+
+    HistoryBucket b;
+    b.startTime = timestamp;
+    b.counts = counts;
+    b.minCps = counts;
+    b.maxCps = counts;
+    b.seconds = 1;
+    b.flags = 0;
+
+    lock();
+    pushBucket(HISTORY_LEVEL_SECOND, b);
+    unlock();
+}
+
+size_t HistoryStore::count(HistoryLevel level) const {
+    return levels_[level].size;
+}
+
+size_t HistoryStore::read(HistoryLevel level, size_t offset, HistoryBucket* out, size_t maxCount) const {
+    if (!ready_) return 0;
+
+    lock();
+    const Level& lv = levels_[level];
+    size_t copied = 0;
+    if (offset < lv.size) {
+        uint32_t cap = LEVEL_CAPACITY[level];
+        uint32_t oldest = (lv.head + cap - lv.size) % cap;
+        while (copied < maxCount && offset + copied < lv.size) {
+            out[copied] = lv.ring[(oldest + offset + copied) % cap];
+            copied++;
+        }
+    }
+    unlock();
+    return copied;
+}
+
+size_t HistoryStore::findOffset(HistoryLevel level, uint32_t timestamp) const {
+    if (!ready_) return 0;
+
+    lock();
+    const Level& lv = levels_[level];
+    uint32_t cap = LEVEL_CAPACITY[level];
+    uint32_t oldest = (lv.head + cap - lv.size) % cap;
+    // Start times grow with the offset, so a lower-bound binary search applies
+    size_t lo = 0, hi = lv.size;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (lv.ring[(oldest + mid) % cap].startTime < timestamp) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    unlock();
+    return lo;
+}
+
+bool HistoryStore::summarizeRecent(HistoryLevel level, size_t buckets, HistoryBucket* out) const {
+    if (!ready_ || !out) return false;
+
+    lock();
+    const Level& lv = levels_[level];
+    size_t n = buckets < lv.size ? buckets : lv.size;
+    uint32_t cap = LEVEL_CAPACITY[level];
+    for (size_t i = 0; i < n; i++) {
+        // Walk backwards from the newest bucket; keep the oldest start time
+        const HistoryBucket& b = lv.ring[(lv.head + cap - 1 - i) % cap];
+        mergeInto(*out, b, i == 0);
+        out->startTime = b.startTime;
+    }
+    unlock();
+    return n > 0;
+}
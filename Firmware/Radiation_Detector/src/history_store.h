@@ -0,0 +1,92 @@
+#ifndef HISTORY_STORE_H
+#define HISTORY_STORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Multi-resolution time-series store for pulse counts.
+// Per-second counts cascade into coarser levels: 1 s buckets for 1 hour,
+// 1 min buckets for 1 week and 1 h buckets for 1 year. Each bucket keeps the
+// total counts, the covered seconds and the min/max per-second count, so the
+// mean rate and the spread are available at every resolution.
+// Bucket rings are allocated in PSRAM on the target (~450 KB in total).
+
+enum HistoryLevel {
+    HISTORY_LEVEL_SECOND = 0, ///< 1 s buckets, 3600 retained (1 hour)
+    HISTORY_LEVEL_MINUTE = 1, ///< 1 min buckets, 10080 retained (1 week)
+    HISTORY_LEVEL_HOUR   = 2, ///< 1 h buckets, 8760 retained (1 year)
+    HISTORY_LEVEL_COUNT
+};
+
+struct HistoryBucket {
+    uint32_t startTime; ///< Start of the bucket in seconds (time base of the caller)
+    uint32_t counts;    ///< Total counts in the bucket
+    uint32_t minCps;    ///< Lowest 1-second count inside the bucket
+    uint32_t maxCps;    ///< Highest 1-second count inside the bucket
+    uint16_t seconds;   ///< Seconds of live data covered
+    uint16_t flags;     ///< Reserved for data-quality flags
+
+    /// Mean count rate in counts per second.
+    float meanCps() const { return seconds ? (float)counts / (float)seconds : 0.0f; }
+};
+
+class HistoryStore {
+public:
+    HistoryStore();
+
+    /// Allocates the bucket rings (PSRAM preferred). Returns false if allocation failed.
+    bool begin();
+
+    /// True once begin() succeeded.
+    bool ready() const { return ready_; }
+
+    /// Adds one completed second and cascades finished buckets to the coarser levels.
+    void addSecond(uint32_t timestamp, uint32_t counts);
+
+    /// Number of buckets retained at a level.
+    size_t count(HistoryLevel level) const;
+
+    /// Bucket duration at a level in seconds.
+    static uint32_t bucketSeconds(HistoryLevel level);
+
+    /// Retention capacity of a level in buckets.
+    static uint32_t capacity(HistoryLevel level);
+
+    /**
+     * @brief Copies buckets in age order (offset 0 = oldest retained).
+     * @return Number of buckets copied
+     */
+    size_t read(HistoryLevel level, size_t offset, HistoryBucket* out, size_t maxCount) const;
+
+    /**
+     * @brief Offset of the oldest bucket starting at or after @p timestamp.
+     * @return count(level) if every retained bucket is older
+     */
+    size_t findOffset(HistoryLevel level, uint32_t timestamp) const;
+
+    /**
+     * @brief Merges the newest @p buckets buckets of a level into one summary.
+     * @return false if the level holds no data
+     */
+    bool summarizeRecent(HistoryLevel level, size_t buckets, HistoryBucket* out) const;
+
+private:
+    struct Level {
+        HistoryBucket* ring;     ///< Bucket storage (capacity entries)
+        uint32_t head;           ///< Next write position
+        uint32_t size;           ///< Buckets retained
+        HistoryBucket pending;   ///< Bucket being built from the finer level
+        uint32_t pendingParts;   ///< Finer buckets merged into pending
+    };
+
+    void pushBucket(HistoryLevel level, const HistoryBucket& bucket);
+    static void mergeInto(HistoryBucket& dst, const HistoryBucket& src, bool first);
+    void lock() const;
+    void unlock() const;
+
+    Level levels_[HISTORY_LEVEL_COUNT];
+    void* mutex_;
+    bool ready_;
+};
+
+#endif // HISTORY_STORE_H
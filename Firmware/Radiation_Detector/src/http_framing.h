@@ -0,0 +1,155 @@
+#ifndef HTTP_FRAMING_H
+#define HTTP_FRAMING_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+// HTTP/1.x message framing for the HTTPS front end (https_service.h).
+// The front end passes requests through to the plain HTTP server on the loopback
+// interface. That server closes its connection after every response. The
+// front end therefore only needs two things:
+//  - where a request ends: the header block, then Content-Length bytes of body;
+//  - whether the client can still tell where a response ends once "Connection:
+//    close" is gone from it. That holds for a Content-Length, a chunked body,
+//    or a status or method without a body.
+// If it can, the response header is rewritten to "Connection: keep-alive" and
+// the TLS connection stays open for the next request. Otherwise (e.g. an event
+// stream) the response runs until the server closes. No Arduino dependencies
+// (host-compilable).
+
+struct HttpRequestHead {
+    uint16_t length;        ///< Header block including the blank line
+    uint32_t contentLength; ///< Body bytes that follow
+    bool keepAlive;         ///< The client will send another request on this connection
+    bool head;              ///< HEAD request: the response has no body
+    bool chunked;           ///< Chunked request body (not supported by the server)
+};
+
+/**
+ * @brief Case-insensitive match of the header line at @p line against "name:".
+ * @return the value with leading blanks skipped, or nullptr
+ */
+inline const char* httpHeaderValue(const char* line, const char* lineEnd, const char* name) {
+    size_t n = strlen(name);
+    if ((size_t)(lineEnd - line) <= n || strncasecmp(line, name, n) != 0 || line[n] != ':') return nullptr;
+    const char* v = line + n + 1;
+    while (v < lineEnd && (*v == ' ' || *v == '\t')) v++;
+    return v;
+}
+
+/// True if the value from @p value to @p end contains @p token (case-insensitive).
+inline bool httpValueHas(const char* value, const char* end, const char* token) {
+    size_t n = strlen(token);
+    for (const char* p = value; p + n <= end; p++) {
+        if (strncasecmp(p, token, n) == 0) return true;
+    }
+    return false;
+}
+
+/// Offset just past the blank line ending the header block, or 0 if it is not complete.
+inline size_t httpHeadEnd(const char* buf, size_t len) {
+    for (size_t i = 3; i < len; i++) {
+        if (buf[i] == '\n' && buf[i - 1] == '\r' && buf[i - 2] == '\n' && buf[i - 3] == '\r') return i + 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Parses the request header block at the start of @p buf.
+ * @return 1 when complete, 0 if more bytes are needed, -1 if malformed
+ */
+inline int parseHttpRequestHead(const char* buf, size_t len, HttpRequestHead* out) {
+    size_t end = httpHeadEnd(buf, len);
+    if (!end) return 0;
+    memset(out, 0, sizeof(*out));
+    out->length = (uint16_t)end;
+
+    const char* line = buf;
+    const char* lineEnd = (const char*)memchr(line, '\n', end);
+    const char* version = nullptr;
+    for (const char* p = line; p + 5 <= lineEnd; p++) {
+        if (memcmp(p, "HTTP/", 5) == 0) version = p;
+    }
+    if (!version || lineEnd - version < 8) return -1;
+    out->keepAlive = version[7] == '1';  // HTTP/1.1 keeps the connection by default
+    out->head = len >= 5 && memcmp(buf, "HEAD ", 5) == 0;
+
+    for (line = lineEnd + 1; line < buf + end - 2; line = lineEnd + 1) {
+        lineEnd = (const char*)memchr(line, '\n', buf + end - line);
+        const char* v;
+        if ((v = httpHeaderValue(line, lineEnd, "Content-Length"))) {
+            char* stop;
+            unsigned long n = strtoul(v, &stop, 10);
+            if (stop == v) return -1;
+            out->contentLength = (uint32_t)n;
+        } else if ((v = httpHeaderValue(line, lineEnd, "Connection"))) {
+            if (httpValueHas(v, lineEnd, "close")) out->keepAlive = false;
+            else if (httpValueHas(v, lineEnd, "keep-alive")) out->keepAlive = true;
+            if (httpValueHas(v, lineEnd, "upgrade")) out->keepAlive = false;
+        } else if ((v = httpHeaderValue(line, lineEnd, "Transfer-Encoding"))) {
+            out->chunked = httpValueHas(v, lineEnd, "chunked");
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Copies the response header block @p in to @p out, with the
+ *        connection kept open if the client can find the end of the body.
+ *
+ * @param keepAlive   The client asked to keep the connection
+ * @param headRequest The request was HEAD (no body whatever the header says)
+ * @param persistent  Set if the rewritten response keeps the connection
+ * @return bytes written to @p out, or 0 if it does not fit (send @p in unchanged)
+ */
+inline size_t rewriteHttpResponseHead(const char* in, size_t len, bool keepAlive, bool headRequest, char* out,
+                                      size_t outSize, bool* persistent) {
+    *persistent = false;
+    const char* statusEnd = (const char*)memchr(in, '\n', len);
+    if (!statusEnd || len < 12 || memcmp(in, "HTTP/1.", 7) != 0) return 0;
+    int status = atoi(in + 9);
+    bool delimited = headRequest || status / 100 == 1 || status == 204 || status == 304;
+
+    for (const char* line = statusEnd + 1; line < in + len - 2;) {
+        const char* lineEnd = (const char*)memchr(line, '\n', in + len - line);
+        if (!lineEnd) break;
+        const char* v;
+        if (httpHeaderValue(line, lineEnd, "Content-Length")) delimited = true;
+        else if ((v = httpHeaderValue(line, lineEnd, "Transfer-Encoding")) && httpValueHas(v, lineEnd, "chunked"))
+            delimited = true;
+        line = lineEnd + 1;
+    }
+    *persistent = keepAlive && delimited;
+
+    static const char KEEP[] = "Connection: keep-alive\r\n";
+    static const char CLOSE[] = "Connection: close\r\n";
+    const char* connection = *persistent ? KEEP : CLOSE;
+    size_t connectionLen = *persistent ? sizeof(KEEP) - 1 : sizeof(CLOSE) - 1;
+
+    // Status line, every header but Connection, our Connection, blank line
+    size_t n = 0;
+    size_t statusLen = statusEnd + 1 - in;
+    if (statusLen + connectionLen + 2 > outSize) return 0;
+    memcpy(out, in, statusLen);
+    n = statusLen;
+    for (const char* line = statusEnd + 1; line < in + len - 2;) {
+        const char* lineEnd = (const char*)memchr(line, '\n', in + len - line);
+        if (!lineEnd) break;
+        size_t lineLen = lineEnd + 1 - line;
+        if (!httpHeaderValue(line, lineEnd, "Connection")) {
+            if (n + lineLen + connectionLen + 2 > outSize) return 0;
+            memcpy(out + n, line, lineLen);
+            n += lineLen;
+        }
+        line = lineEnd + 1;
+    }
+    memcpy(out + n, connection, connectionLen);
+    n += connectionLen;
+    memcpy(out + n, "\r\n", 2);
+    return n + 2;
+}
+
+#endif // HTTP_FRAMING_H
@@ -0,0 +1,941 @@
+/**
+ * @file https_service.cpp
+ * @brief TLS termination task, identity store, crypto benchmarks and the /api/tls report.
+ *
+ * One task serves every link with non-blocking sockets and select(). A
+ * handshake advances whenever its client has sent something, so a slow client
+ * never holds up the others; only the public-key maths of a full handshake
+ * runs in one piece. Each request goes to the HTTP server on a fresh loopback
+ * connection. The server closes that connection after its response, which
+ * marks where the response ends. The task copies it back to the client with
+ * the header rewritten for keep-alive where the client can frame the body
+ * itself (http_framing.h).
+ */
+
+#include "https_service.h"
+#include "http_framing.h"
+#include "mdns_service.h"
+#include "web_rate_limit.h"
+#include "web_service.h"
+#include "sysinfo.h"
+#include "bench.h"
+#include "seqlock.h"
+#include "json_arena.h"
+#include "web_arena.h"
+#include "debug.h"
+#include <ArduinoJson.h>
+#include <Preferences.h>
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "sdkconfig.h"
+#include "lwip/sockets.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include "mbedtls/ssl.h"
+#include "mbedtls/net_sockets.h"
+#include "mbedtls/entropy.h"
+#include "mbedtls/ctr_drbg.h"
+#include "mbedtls/ssl_cache.h"
+#include "mbedtls/ssl_ticket.h"
+#include "mbedtls/x509_crt.h"
+#include "mbedtls/pk.h"
+#include "mbedtls/ecdh.h"
+#include "mbedtls/gcm.h"
+#include "mbedtls/sha256.h"
+#include "mbedtls/oid.h"
+#include <atomic>
+
+static const uint32_t HTTPS_TASK_STACK = 10240;  ///< A full handshake's ECDSA signature is the deepest path
+static const uint32_t HANDSHAKE_TIMEOUT_MS = 10000;
+static const uint32_t IO_TIMEOUT_MS = 5000;
+static const uint32_t SELECT_TIMEOUT_MS = 200;
+static const uint16_t BACKEND_PORT = 80;
+static const size_t HEAD_MAX = 1536;             ///< Request and response header blocks
+static const size_t IO_CHUNK = 1400;
+static const size_t IDENTITY_DER_MAX = 1024;
+static const char* PREFS_NAMESPACE = "tls";
+
+// AES-GCM only: both run on the AES accelerator, and every current client offers them
+static const int CIPHERSUITES[] = {MBEDTLS_TLS_ECDHE_ECDSA_WITH_AES_128_GCM_SHA256,
+                                   MBEDTLS_TLS_ECDHE_ECDSA_WITH_AES_256_GCM_SHA384, 0};
+static const mbedtls_ecp_group_id CURVES[] = {MBEDTLS_ECP_DP_SECP256R1, MBEDTLS_ECP_DP_NONE};
+
+#ifdef CONFIG_MBEDTLS_HARDWARE_AES
+static const bool HW_AES = true;
+#else
+static const bool HW_AES = false;
+#endif
+#ifdef CONFIG_MBEDTLS_HARDWARE_SHA
+static const bool HW_SHA = true;
+#else
+static const bool HW_SHA = false;
+#endif
+#ifdef CONFIG_MBEDTLS_HARDWARE_MPI
+static const bool HW_MPI = true;
+#else
+static const bool HW_MPI = false;
+#endif
+#ifdef CONFIG_MBEDTLS_HARDWARE_GCM
+static const bool HW_GCM = true;
+#else
+static const bool HW_GCM = false;
+#endif
+
+enum LinkState : uint8_t {
+    LINK_FREE = 0,
+    LINK_HANDSHAKE,
+    LINK_IDLE,      ///< Waiting for the next request
+    LINK_FORWARD    ///< A request is with the HTTP server
+};
+
+enum LinkResume : uint8_t { RESUME_NONE = 0, RESUME_TICKET, RESUME_CACHE };
+
+struct Link {
+    uint8_t state;
+    uint8_t resume;          ///< How the handshake in progress resumes
+    bool used;               ///< Served a request already
+    bool keepAlive;          ///< The client keeps the connection after this request
+    bool headRequest;
+    bool responseStarted;    ///< Response header sent on
+    bool persistent;         ///< The response keeps the connection
+    int backend;             ///< Loopback socket to the HTTP server, -1 if none
+    uint32_t ip;             ///< Client address (network order) for the rate limit
+    mbedtls_net_context net;
+    mbedtls_ssl_context ssl;
+    uint32_t openedMs;
+    uint32_t lastMs;
+    uint32_t handshakeUs;    ///< CPU time in mbedtls_ssl_handshake()
+    uint32_t bodyLeft;       ///< Request body still to pass on
+    uint16_t inLen;          ///< Buffered request bytes (the header, or the next request)
+    uint16_t respLen;        ///< Buffered response header bytes
+    char in[HEAD_MAX];
+    char resp[HEAD_MAX];
+};
+
+static mbedtls_entropy_context entropy;
+static mbedtls_ctr_drbg_context drbg;
+static mbedtls_ssl_config conf;
+static mbedtls_x509_crt cert;
+static mbedtls_pk_context key;
+static mbedtls_ssl_cache_context cache;
+static mbedtls_ssl_ticket_context tickets;
+
+static Link* links = nullptr;               ///< HTTPS_MAX_LINKS, PSRAM if there is any
+static Link* handshaking = nullptr;         ///< Link whose handshake step runs (resume callbacks)
+static int listener = -1;
+static uint8_t io[IO_CHUNK];
+static char rewritten[HEAD_MAX + 32];
+
+static HttpsStats stats;                    ///< HTTPS task only
+static bool statsDirty = true;
+static uint64_t fullUsTotal = 0;
+static uint64_t resumeUsTotal = 0;
+static SeqLock<HttpsStats> statsLock;
+static std::atomic<bool> started(false);
+static std::atomic<bool> running(false);
+static char fingerprint[96] = "";           ///< Written once before running is set
+static WebServer* tlsServer = nullptr;
+
+/*******************************************************************************
+ * Identity
+ ******************************************************************************/
+
+static bool seedRng() {
+    static const char PERSONAL[] = "radscan-tls";
+    mbedtls_entropy_init(&entropy);
+    mbedtls_ctr_drbg_init(&drbg);
+    int ret = mbedtls_ctr_drbg_seed(&drbg, mbedtls_entropy_func, &entropy, (const unsigned char*)PERSONAL,
+                                    sizeof(PERSONAL) - 1);
+    if (ret) stats.lastError = ret;
+    return ret == 0;
+}
+
+/**
+ * @brief subjectAltName with one dNSName; browsers ignore the CN.
+ */
+static size_t encodeSubjectAltName(const char* dns, uint8_t* out, size_t size) {
+    size_t n = strlen(dns);
+    if (n > 120 || n + 4 > size) return 0;
+    out[0] = 0x30;                   // SEQUENCE
+    out[1] = (uint8_t)(n + 2);
+    out[2] = 0x82;                   // [2] dNSName
+    out[3] = (uint8_t)n;
+    memcpy(out + 4, dns, n);
+    return n + 4;
+}
+
+/**
+ * @brief Creates a P-256 key and a self-signed certificate for <host>.local
+ *        and stores both (DER).
+ */
+static bool createIdentity(Preferences& prefs) {
+    mbedtls_pk_context k;
+    mbedtls_x509write_cert crt;
+    mbedtls_mpi serial;
+    mbedtls_pk_init(&k);
+    mbedtls_x509write_crt_init(&crt);
+    mbedtls_mpi_init(&serial);
+    uint8_t* der = (uint8_t*)malloc(IDENTITY_DER_MAX);
+
+    char dns[32];
+    char subject[64];
+    uint8_t san[40];
+    snprintf(dns, sizeof(dns), "%s.local", mdnsHostname());
+    snprintf(subject, sizeof(subject), "CN=%s,O=RadScan", dns);
+    size_t sanLen = encodeSubjectAltName(dns, san, sizeof(san));
+
+    int ret = der ? 0 : MBEDTLS_ERR_PK_ALLOC_FAILED;
+    if (!ret) ret = mbedtls_pk_setup(&k, mbedtls_pk_info_from_type(MBEDTLS_PK_ECKEY));
+    if (!ret) ret = mbedtls_ecp_gen_key(MBEDTLS_ECP_DP_SECP256R1, mbedtls_pk_ec(k), mbedtls_ctr_drbg_random, &drbg);
+    if (!ret) ret = mbedtls_mpi_fill_random(&serial, 16, mbedtls_ctr_drbg_random, &drbg);
+    if (!ret) {
+        mbedtls_x509write_crt_set_version(&crt, MBEDTLS_X509_CRT_VERSION_3);
+        mbedtls_x509write_crt_set_md_alg(&crt, MBEDTLS_MD_SHA256);
+        mbedtls_x509write_crt_set_subject_key(&crt, &k);
+        mbedtls_x509write_crt_set_issuer_key(&crt, &k);
+        ret = mbedtls_x509write_crt_set_serial(&crt, &serial);
+    }
+    if (!ret) ret = mbedtls_x509write_crt_set_subject_name(&crt, subject);
+    if (!ret) ret = mbedtls_x509write_crt_set_issuer_name(&crt, subject);
+    // The clock may not be set yet; a fixed span keeps the certificate valid regardless
+    if (!ret) ret = mbedtls_x509write_crt_set_validity(&crt, "20240101000000", "20491231235959");
+    if (!ret) ret = mbedtls_x509write_crt_set_basic_constraints(&crt, 0, -1);
+    if (!ret) ret = mbedtls_x509write_crt_set_key_usage(&crt, MBEDTLS_X509_KU_DIGITAL_SIGNATURE);
+    if (!ret && sanLen) {
+        ret = mbedtls_x509write_crt_set_extension(&crt, MBEDTLS_OID_SUBJECT_ALT_NAME,
+                                                  MBEDTLS_OID_SIZE(MBEDTLS_OID_SUBJECT_ALT_NAME), 0, san, sanLen);
+    }
+    if (!ret) {
+        // Both writers fill the buffer from its end
+        int len = mbedtls_pk_write_key_der(&k, der, IDENTITY_DER_MAX);
+        if (len < 0) ret = len;
+        else if (prefs.putBytes("key", der + IDENTITY_DER_MAX - len, len) != (size_t)len) ret = -1;
+    }
+    if (!ret) {
+        int len = mbedtls_x509write_crt_der(&crt, der, IDENTITY_DER_MAX, mbedtls_ctr_drbg_random, &drbg);
+        if (len < 0) ret = len;
+        else if (prefs.putBytes("crt", der + IDENTITY_DER_MAX - len, len) != (size_t)len) ret = -1;
+    }
+
+    free(der);
+    mbedtls_mpi_free(&serial);
+    mbedtls_x509write_crt_free(&crt);
+    mbedtls_pk_free(&k);
+    if (ret) {
+        stats.lastError = ret;
+        prefs.remove("key");
+        prefs.remove("crt");
+    }
+    return ret == 0;
+}
+
+/**
+ * @brief Loads the stored key and certificate, creating them on first start.
+ */
+static bool loadIdentity() {
+    Preferences prefs;
+    if (!prefs.begin(PREFS_NAMESPACE, false)) return false;
+    if (!prefs.isKey("key") || !prefs.isKey("crt")) {
+        DEBUG_PRINTLN("HTTPS: creating a P-256 key and a self-signed certificate");
+        uint32_t startMs = millis();
+        if (!createIdentity(prefs)) {
+            prefs.end();
+            return false;
+        }
+        DEBUG_PRINTF("HTTPS: identity created in %lu ms\n", (unsigned long)(millis() - startMs));
+    }
+
+    uint8_t* der = (uint8_t*)malloc(IDENTITY_DER_MAX);
+    int ret = der ? 0 : MBEDTLS_ERR_PK_ALLOC_FAILED;
+    mbedtls_pk_init(&key);
+    mbedtls_x509_crt_init(&cert);
+    if (!ret) {
+        size_t len = prefs.getBytes("key", der, IDENTITY_DER_MAX);
+        ret = mbedtls_pk_parse_key(&key, der, len, NULL, 0);
+    }
+    if (!ret) {
+        size_t len = prefs.getBytes("crt", der, IDENTITY_DER_MAX);
+        ret = mbedtls_x509_crt_parse_der(&cert, der, len);
+    }
+    if (!ret) ret = mbedtls_pk_check_pair(&cert.pk, &key);
+    prefs.end();
+    free(der);
+    if (ret) {
+        stats.lastError = ret;
+        return false;
+    }
+
+    uint8_t digest[32];
+    mbedtls_sha256_ret(cert.raw.p, cert.raw.len, digest, 0);
+    for (size_t i = 0; i < sizeof(digest); i++) {
+        snprintf(fingerprint + i * 3, sizeof(fingerprint) - i * 3, i + 1 < sizeof(digest) ? "%02X:" : "%02X",
+                 digest[i]);
+    }
+    return true;
+}
+
+/*******************************************************************************
+ * TLS configuration
+ ******************************************************************************/
+
+static int cacheGet(void* data, mbedtls_ssl_session* session) {
+    int ret = mbedtls_ssl_cache_get(data, session);
+    if (ret == 0 && handshaking) handshaking->resume = RESUME_CACHE;
+    return ret;
+}
+
+static int ticketParse(void* data, mbedtls_ssl_session* session, unsigned char* buf, size_t len) {
+    int ret = mbedtls_ssl_ticket_parse(data, session, buf, len);
+    if (ret == 0 && handshaking) handshaking->resume = RESUME_TICKET;
+    return ret;
+}
+
+static bool setupTls() {
+    mbedtls_ssl_config_init(&conf);
+    int ret = mbedtls_ssl_config_defaults(&conf, MBEDTLS_SSL_IS_SERVER, MBEDTLS_SSL_TRANSPORT_STREAM,
+                                          MBEDTLS_SSL_PRESET_DEFAULT);
+    if (!ret) {
+        mbedtls_ssl_conf_rng(&conf, mbedtls_ctr_drbg_random, &drbg);
+        mbedtls_ssl_conf_min_version(&conf, MBEDTLS_SSL_MAJOR_VERSION_3, MBEDTLS_SSL_MINOR_VERSION_3);
+        mbedtls_ssl_conf_ciphersuites(&conf, CIPHERSUITES);
+        mbedtls_ssl_conf_curves(&conf, CURVES);
+        ret = mbedtls_ssl_conf_own_cert(&conf, &cert, &key);
+    }
+    if (!ret) {
+        // Clients without tickets resume by session ID
+        mbedtls_ssl_cache_init(&cache);
+        mbedtls_ssl_cache_set_max_entries(&cache, HTTPS_SESSION_CACHE);
+        mbedtls_ssl_cache_set_timeout(&cache, HTTPS_SESSION_LIFETIME_S);
+        mbedtls_ssl_conf_session_cache(&conf, &cache, cacheGet, mbedtls_ssl_cache_set);
+
+        // Ticket keys live in RAM only: a reboot costs every client one full handshake
+        mbedtls_ssl_ticket_init(&tickets);
+        ret = mbedtls_ssl_ticket_setup(&tickets, mbedtls_ctr_drbg_random, &drbg, MBEDTLS_CIPHER_AES_256_GCM,
+                                       HTTPS_SESSION_LIFETIME_S);
+    }
+    if (!ret) mbedtls_ssl_conf_session_tickets_cb(&conf, mbedtls_ssl_ticket_write, ticketParse, &tickets);
+    if (ret) stats.lastError = ret;
+    return ret == 0;
+}
+
+static bool openListener() {
+    listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (listener < 0) return false;
+    int one = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(HTTPS_PORT);
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind(listener, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(listener, HTTPS_MAX_LINKS) != 0) {
+        close(listener);
+        listener = -1;
+        return false;
+    }
+    fcntl(listener, F_SETFL, fcntl(listener, F_GETFL, 0) | O_NONBLOCK);
+    return true;
+}
+
+/*******************************************************************************
+ * Links
+ ******************************************************************************/
+
+static void closeLink(Link& l, bool notify) {
+    if (l.state == LINK_FREE) return;
+    if (notify && l.state != LINK_HANDSHAKE) mbedtls_ssl_close_notify(&l.ssl); // Best effort, never waits
+    mbedtls_ssl_free(&l.ssl);
+    mbedtls_net_free(&l.net);
+    if (l.backend >= 0) close(l.backend);
+    l.backend = -1;
+    l.state = LINK_FREE;
+    stats.links--;
+    statsDirty = true;
+}
+
+static bool waitWritable(int fd) {
+    fd_set wr;
+    FD_ZERO(&wr);
+    FD_SET(fd, &wr);
+    struct timeval tv = {(time_t)(IO_TIMEOUT_MS / 1000), (suseconds_t)(IO_TIMEOUT_MS % 1000 * 1000)};
+    return select(fd + 1, NULL, &wr, NULL, &tv) > 0;
+}
+
+/**
+ * @brief Encrypts and sends @p len bytes; waits up to IO_TIMEOUT_MS for a slow client.
+ */
+static bool sslWriteAll(Link& l, const void* data, size_t len) {
+    const uint8_t* p = (const uint8_t*)data;
+    while (len) {
+        int ret = mbedtls_ssl_write(&l.ssl, p, len);
+        if (ret > 0) {
+            p += ret;
+            len -= ret;
+            stats.bytesOut += ret;
+        } else if (ret == MBEDTLS_ERR_SSL_WANT_WRITE || ret == MBEDTLS_ERR_SSL_WANT_READ) {
+            if (!waitWritable(l.net.fd)) return false;
+        } else {
+            stats.lastError = ret;
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool backendSendAll(Link& l, const void* data, size_t len) {
+    const uint8_t* p = (const uint8_t*)data;
+    while (len) {
+        int n = send(l.backend, p, len, 0);
+        if (n <= 0) return false;
+        p += n;
+        len -= n;
+    }
+    return true;
+}
+
+/**
+ * @brief Answers with a bodiless status and closes the link.
+ */
+static void failRequest(Link& l, const char* status) {
+    char response[128];
+    int n = snprintf(response, sizeof(response), "HTTP/1.1 %s\r\nContent-Length: 0\r\nConnection: close\r\n\r\n",
+                     status);
+    sslWriteAll(l, response, n);
+    closeLink(l, true);
+}
+
+static int connectBackend() {
+    int fd = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (fd < 0) return -1;
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(BACKEND_PORT);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    struct timeval tv = {(time_t)(IO_TIMEOUT_MS / 1000), 0};
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+    if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static void acceptClient(uint32_t nowMs) {
+    struct sockaddr_in peer;
+    socklen_t peerLen = sizeof(peer);
+    int fd = accept(listener, (struct sockaddr*)&peer, &peerLen);
+    if (fd < 0) return;
+    stats.accepted++;
+    statsDirty = true;
+
+    Link* slot = nullptr;
+    Link* oldestIdle = nullptr;
+    for (uint8_t i = 0; i < HTTPS_MAX_LINKS; i++) {
+        Link& l = links[i];
+        if (l.state == LINK_FREE) {
+            slot = &l;
+            break;
+        }
+        if (l.state == LINK_IDLE && l.inLen == 0 && (!oldestIdle || (int32_t)(l.lastMs - oldestIdle->lastMs) < 0)) {
+            oldestIdle = &l;
+        }
+    }
+    if (!slot && oldestIdle) {
+        closeLink(*oldestIdle, true);
+        stats.evicted++;
+        slot = oldestIdle;
+    }
+    if (!slot) {
+        close(fd);
+        stats.refused++;
+        return;
+    }
+
+    Link& l = *slot;
+    memset(&l, 0, offsetof(Link, in)); // The buffers need no clearing
+    l.backend = -1;
+    l.ip = peer.sin_addr.s_addr;
+    mbedtls_net_init(&l.net);
+    l.net.fd = fd;
+    mbedtls_net_set_nonblock(&l.net);
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    mbedtls_ssl_init(&l.ssl);
+    int ret = mbedtls_ssl_setup(&l.ssl, &conf); // Allocates the record buffers
+    if (ret) {
+        stats.lastError = ret;
+        mbedtls_ssl_free(&l.ssl);
+        mbedtls_net_free(&l.net);
+        stats.refused++;
+        return;
+    }
+    mbedtls_ssl_set_bio(&l.ssl, &l.net, mbedtls_net_send, mbedtls_net_recv, NULL);
+    l.state = LINK_HANDSHAKE;
+    l.openedMs = l.lastMs = nowMs;
+    stats.links++;
+}
+
+static void stepHandshake(Link& l, uint32_t nowMs) {
+    handshaking = &l;
+    int64_t startUs = esp_timer_get_time();
+    int ret = mbedtls_ssl_handshake(&l.ssl);
+    l.handshakeUs += (uint32_t)(esp_timer_get_time() - startUs);
+    handshaking = nullptr;
+    if (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE) return;
+    statsDirty = true;
+    if (ret) {
+        stats.failedHandshakes++;
+        stats.lastError = ret;
+        closeLink(l, false);
+        return;
+    }
+    if (l.resume == RESUME_NONE) {
+        stats.fullHandshakes++;
+        fullUsTotal += l.handshakeUs;
+        stats.fullHandshakeUs = fullUsTotal / stats.fullHandshakes;
+    } else {
+        if (l.resume == RESUME_TICKET) stats.ticketResumes++;
+        else stats.cacheResumes++;
+        resumeUsTotal += l.handshakeUs;
+        stats.resumeHandshakeUs = resumeUsTotal / (stats.ticketResumes + stats.cacheResumes);
+    }
+    l.state = LINK_IDLE;
+    l.lastMs = nowMs;
+}
+
+static void startRequest(Link& l);
+
+/**
+ * @brief Answers 429 for a request over its client's budget (web_rate_limit.h).
+ *        A request without a body keeps the connection; it is cheaper than
+ *        the client's reconnect.
+ */
+static void limitRequest(Link& l, const HttpRequestHead& head, uint32_t retryAfterS) {
+    if (head.contentLength || !head.keepAlive) {
+        char status[48];
+        snprintf(status, sizeof(status), "429 Too Many Requests\r\nRetry-After: %lu", (unsigned long)retryAfterS);
+        return failRequest(l, status);
+    }
+    char response[128];
+    int n = snprintf(response, sizeof(response),
+                     "HTTP/1.1 429 Too Many Requests\r\nRetry-After: %lu\r\nContent-Length: 0\r\n"
+                     "Connection: keep-alive\r\n\r\n",
+                     (unsigned long)retryAfterS);
+    memmove(l.in, l.in + head.length, l.inLen - head.length);
+    l.inLen -= head.length;
+    if (!sslWriteAll(l, response, n)) return closeLink(l, false);
+    if (l.inLen) startRequest(l);
+}
+
+/**
+ * @brief Passes the buffered request to the HTTP server once its header is complete.
+ */
+static void startRequest(Link& l) {
+    HttpRequestHead head;
+    int parsed = parseHttpRequestHead(l.in, l.inLen, &head);
+    if (parsed == 0) {
+        if (l.inLen >= HEAD_MAX) failRequest(l, "431 Request Header Fields Too Large");
+        return;
+    }
+    if (parsed < 0) return failRequest(l, "400 Bad Request");
+    if (head.chunked) return failRequest(l, "411 Length Required"); // WebServer reads Content-Length only
+
+    // The server sees every HTTPS request from loopback, so the client's own budget is charged here
+    char target[48];
+    const char* space = (const char*)memchr(l.in, ' ', head.length);
+    size_t n = 0;
+    if (space) {
+        for (const char* p = space + 1; p < l.in + head.length && *p != ' ' && n + 1 < sizeof(target); p++) {
+            target[n++] = *p;
+        }
+    }
+    target[n] = '\0';
+    uint32_t retryAfterS = webRateAdmit(l.ip, target);
+    if (retryAfterS) return limitRequest(l, head, retryAfterS);
+
+    l.backend = connectBackend();
+    if (l.backend < 0) return failRequest(l, "502 Bad Gateway");
+    uint32_t buffered = l.inLen - head.length;
+    uint32_t body = buffered < head.contentLength ? buffered : head.contentLength;
+    if (!backendSendAll(l, l.in, head.length + body)) return failRequest(l, "502 Bad Gateway");
+
+    // Whatever follows belongs to the next request
+    uint16_t consumed = head.length + body;
+    memmove(l.in, l.in + consumed, l.inLen - consumed);
+    l.inLen -= consumed;
+    stats.bytesIn += consumed;
+    l.bodyLeft = head.contentLength - body;
+    l.keepAlive = head.keepAlive;
+    l.headRequest = head.head;
+    l.responseStarted = false;
+    l.persistent = false;
+    l.respLen = 0;
+    stats.requests++;
+    if (l.used) stats.reusedRequests++;
+    l.used = true;
+    l.state = LINK_FORWARD;
+    statsDirty = true;
+}
+
+/**
+ * @brief Reads from the client: a request header while idle, the request body
+ *        while forwarding, or a pipelined request (buffered until the response is done).
+ */
+static void readClient(Link& l) {
+    int ret;
+    if (l.state == LINK_FORWARD && l.bodyLeft) {
+        ret = mbedtls_ssl_read(&l.ssl, io, l.bodyLeft < sizeof(io) ? l.bodyLeft : sizeof(io));
+        if (ret > 0) {
+            l.bodyLeft -= ret;
+            stats.bytesIn += ret;
+            if (!backendSendAll(l, io, ret)) closeLink(l, true);
+            return;
+        }
+    } else {
+        if (l.inLen >= HEAD_MAX) return;
+        ret = mbedtls_ssl_read(&l.ssl, (unsigned char*)l.in + l.inLen, HEAD_MAX - l.inLen);
+        if (ret > 0) {
+            l.inLen += ret;
+            if (l.state == LINK_IDLE) startRequest(l);
+            return;
+        }
+    }
+    if (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE) return;
+    if (ret != 0 && ret != MBEDTLS_ERR_SSL_PEER_CLOSE_NOTIFY) stats.lastError = ret;
+    closeLink(l, false); // Closed by the client (this also ends an event stream)
+}
+
+/**
+ * @brief Sends the buffered response header on, rewritten for keep-alive if
+ *        the client can find the end of the body.
+ */
+static bool sendResponseHead(Link& l, size_t headLen) {
+    size_t n = rewriteHttpResponseHead(l.resp, headLen, l.keepAlive && l.bodyLeft == 0, l.headRequest, rewritten,
+                                       sizeof(rewritten), &l.persistent);
+    l.responseStarted = true;
+    if (!n) return sslWriteAll(l, l.resp, l.respLen); // Too large to rewrite: pass on, then close
+    return sslWriteAll(l, rewritten, n) && sslWriteAll(l, l.resp + headLen, l.respLen - headLen);
+}
+
+/**
+ * @brief Copies what the HTTP server sent back to the client. The server
+ *        closing its side ends the response.
+ */
+static void pumpResponse(Link& l, uint32_t nowMs) {
+    int n;
+    if (!l.responseStarted) {
+        n = recv(l.backend, l.resp + l.respLen, HEAD_MAX - l.respLen, MSG_DONTWAIT);
+        if (n > 0) {
+            l.respLen += n;
+            size_t headLen = httpHeadEnd(l.resp, l.respLen);
+            bool ok = true;
+            if (headLen) {
+                ok = sendResponseHead(l, headLen);
+            } else if (l.respLen >= HEAD_MAX) {
+                l.responseStarted = true;
+                ok = sslWriteAll(l, l.resp, l.respLen);
+            }
+            if (!ok) closeLink(l, false);
+            return;
+        }
+    } else {
+        n = recv(l.backend, io, sizeof(io), MSG_DONTWAIT);
+        if (n > 0) {
+            if (!sslWriteAll(l, io, n)) closeLink(l, false);
+            return;
+        }
+    }
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return;
+
+    // The server is done with this request
+    close(l.backend);
+    l.backend = -1;
+    if (!l.responseStarted) {
+        if (!l.respLen || n < 0) return failRequest(l, "502 Bad Gateway");
+        if (!sslWriteAll(l, l.resp, l.respLen)) return closeLink(l, false);
+    }
+    if (!l.persistent || l.bodyLeft || n < 0) return closeLink(l, true);
+    l.state = LINK_IDLE;
+    l.lastMs = nowMs;
+    if (l.inLen) startRequest(l);
+}
+
+/*******************************************************************************
+ * Task
+ ******************************************************************************/
+
+static void publishStats() {
+    stats.running = running.load();
+    statsLock.publish(stats);
+    statsDirty = false;
+}
+
+static void httpsTask(void* parameter) {
+    links = (Link*)heap_caps_calloc(HTTPS_MAX_LINKS, sizeof(Link), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!links) links = (Link*)calloc(HTTPS_MAX_LINKS, sizeof(Link));
+    if (!links || !seedRng() || !loadIdentity() || !setupTls() || !openListener()) {
+        DEBUG_PRINTF("HTTPS: not started (error -0x%04X)\n", (unsigned)-stats.lastError);
+        publishStats(); // Not retried before the next boot
+        vTaskDelete(NULL);
+        return;
+    }
+    for (uint8_t i = 0; i < HTTPS_MAX_LINKS; i++) links[i].backend = -1;
+    running = true;
+    publishStats();
+    DEBUG_PRINTF("HTTPS: listening on port %u, certificate %s\n", (unsigned)HTTPS_PORT, fingerprint);
+
+    while (true) {
+        fd_set rd;
+        FD_ZERO(&rd);
+        FD_SET(listener, &rd);
+        int maxFd = listener;
+        bool buffered = false;  // Decrypted bytes waiting in mbedTLS: no wait in select()
+        for (uint8_t i = 0; i < HTTPS_MAX_LINKS; i++) {
+            Link& l = links[i];
+            if (l.state == LINK_FREE) continue;
+            if (l.state != LINK_FORWARD || l.bodyLeft || l.inLen < HEAD_MAX) {
+                FD_SET(l.net.fd, &rd);
+                if (l.net.fd > maxFd) maxFd = l.net.fd;
+                if (l.state != LINK_HANDSHAKE && mbedtls_ssl_get_bytes_avail(&l.ssl)) buffered = true;
+            }
+            if (l.backend >= 0) {
+                FD_SET(l.backend, &rd);
+                if (l.backend > maxFd) maxFd = l.backend;
+            }
+        }
+        uint32_t waitMs = buffered ? 0 : SELECT_TIMEOUT_MS;
+        struct timeval tv = {(time_t)(waitMs / 1000), (suseconds_t)(waitMs % 1000 * 1000)};
+        int ready = select(maxFd + 1, &rd, NULL, NULL, &tv);
+        if (ready < 0) FD_ZERO(&rd);
+        uint32_t nowMs = millis();
+
+        for (uint8_t i = 0; i < HTTPS_MAX_LINKS; i++) {
+            Link& l = links[i];
+            if (l.state == LINK_FREE) continue;
+            bool clientReady = FD_ISSET(l.net.fd, &rd) ||
+                               (l.state != LINK_HANDSHAKE && mbedtls_ssl_get_bytes_avail(&l.ssl) > 0);
+            bool backendReady = l.backend >= 0 && FD_ISSET(l.backend, &rd);
+            switch (l.state) {
+                case LINK_HANDSHAKE:
+                    if (clientReady) {
+                        stepHandshake(l, nowMs);
+                    } else if (nowMs - l.openedMs > HANDSHAKE_TIMEOUT_MS) {
+                        stats.failedHandshakes++;
+                        closeLink(l, false);
+                    }
+                    break;
+                case LINK_IDLE:
+                    if (clientReady) readClient(l);
+                    else if (nowMs - l.lastMs > HTTPS_IDLE_TIMEOUT_MS) closeLink(l, true);
+                    break;
+                case LINK_FORWARD:
+                    if (clientReady) readClient(l);
+                    if (l.state == LINK_FORWARD && backendReady) pumpResponse(l, nowMs);
+                    break;
+            }
+        }
+        // Accepted last: the new socket was not part of this select()
+        if (ready > 0 && FD_ISSET(listener, &rd)) acceptClient(nowMs);
+        if (statsDirty) publishStats();
+    }
+}
+
+bool httpsServiceBegin() {
+    if (started.exchange(true)) return running.load();
+    TaskHandle_t handle = NULL;
+    if (xTaskCreatePinnedToCore(httpsTask, "HttpsTask", HTTPS_TASK_STACK, NULL, NETWORK_TASK_PRIORITY, &handle,
+                                TASK_CORE_NETWORK) != pdPASS) {
+        DEBUG_PRINTLN("Error: HTTPS task not created");
+        started = false;
+        return false;
+    }
+    sysInfoWatchTask(handle, HTTPS_TASK_STACK);
+    return true;
+}
+
+bool httpsServiceRunning() {
+    return running.load();
+}
+
+HttpsStats getHttpsStats() {
+    HttpsStats s;
+    memset(&s, 0, sizeof(s));
+    statsLock.read(s);
+    return s;
+}
+
+const char* httpsFingerprint() {
+    return running.load() ? fingerprint : "";
+}
+
+void httpsServiceForgetIdentity() {
+    Preferences prefs;
+    if (!prefs.begin(PREFS_NAMESPACE, false)) return;
+    prefs.remove("key");
+    prefs.remove("crt");
+    prefs.end();
+}
+
+/*******************************************************************************
+ * Benchmarks
+ ******************************************************************************/
+
+// The symmetric work of every request, and the public-key work only a full
+// handshake does. The times show whether the build runs them on the accelerators.
+struct CryptoBench {
+    mbedtls_entropy_context entropy;
+    mbedtls_ctr_drbg_context drbg;
+    mbedtls_gcm_context gcm;
+    mbedtls_ecp_group group;
+    mbedtls_mpi secret;
+    mbedtls_mpi shared;
+    mbedtls_ecp_point point;
+    mbedtls_ecp_point peer;
+    mbedtls_pk_context signer;
+    uint8_t iv[12];
+    uint8_t tag[16];
+    uint8_t digest[32];
+    uint8_t signature[MBEDTLS_ECDSA_MAX_LEN];
+    uint8_t plain[1024];
+    uint8_t sealed[1024];
+};
+
+static void benchGcm(void* arg) {
+    CryptoBench* b = (CryptoBench*)arg;
+    mbedtls_gcm_crypt_and_tag(&b->gcm, MBEDTLS_GCM_ENCRYPT, sizeof(b->plain), b->iv, sizeof(b->iv), NULL, 0,
+                              b->plain, b->sealed, sizeof(b->tag), b->tag);
+}
+
+static void benchSha256(void* arg) {
+    CryptoBench* b = (CryptoBench*)arg;
+    mbedtls_sha256_ret(b->plain, sizeof(b->plain), b->digest, 0);
+}
+
+static void benchEcdhe(void* arg) {
+    // The server's share of a key exchange: a fresh key pair, then the shared secret
+    CryptoBench* b = (CryptoBench*)arg;
+    mbedtls_ecdh_gen_public(&b->group, &b->secret, &b->point, mbedtls_ctr_drbg_random, &b->drbg);
+    mbedtls_ecdh_compute_shared(&b->group, &b->shared, &b->peer, &b->secret, mbedtls_ctr_drbg_random, &b->drbg);
+}
+
+static void benchEcdsaSign(void* arg) {
+    CryptoBench* b = (CryptoBench*)arg;
+    size_t len = 0;
+    mbedtls_pk_sign(&b->signer, MBEDTLS_MD_SHA256, b->digest, sizeof(b->digest), b->signature, &len,
+                    mbedtls_ctr_drbg_random, &b->drbg);
+}
+
+void httpsServiceBench() {
+    CryptoBench* b = (CryptoBench*)calloc(1, sizeof(CryptoBench));
+    if (!b) return;
+    mbedtls_entropy_init(&b->entropy);
+    mbedtls_ctr_drbg_init(&b->drbg);
+    mbedtls_gcm_init(&b->gcm);
+    mbedtls_ecp_group_init(&b->group);
+    mbedtls_mpi_init(&b->secret);
+    mbedtls_mpi_init(&b->shared);
+    mbedtls_ecp_point_init(&b->point);
+    mbedtls_ecp_point_init(&b->peer);
+    mbedtls_pk_init(&b->signer);
+
+    static const uint8_t GCM_KEY[16] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+    mbedtls_mpi peerSecret;
+    mbedtls_mpi_init(&peerSecret);
+    int ret = mbedtls_ctr_drbg_seed(&b->drbg, mbedtls_entropy_func, &b->entropy, NULL, 0);
+    if (!ret) ret = mbedtls_gcm_setkey(&b->gcm, MBEDTLS_CIPHER_ID_AES, GCM_KEY, 128);
+    if (!ret) ret = mbedtls_ecp_group_load(&b->group, MBEDTLS_ECP_DP_SECP256R1);
+    if (!ret) ret = mbedtls_ecdh_gen_public(&b->group, &peerSecret, &b->peer, mbedtls_ctr_drbg_random, &b->drbg);
+    if (!ret) ret = mbedtls_pk_setup(&b->signer, mbedtls_pk_info_from_type(MBEDTLS_PK_ECKEY));
+    if (!ret) {
+        ret = mbedtls_ecp_gen_key(MBEDTLS_ECP_DP_SECP256R1, mbedtls_pk_ec(b->signer), mbedtls_ctr_drbg_random,
+                                  &b->drbg);
+    }
+    if (!ret) {
+        benchRun("aes128_gcm_1k", benchGcm, b, 50, sizeof(b->plain));
+        benchRun("sha256_1k", benchSha256, b, 50, sizeof(b->plain));
+        benchRun("ecdhe_p256", benchEcdhe, b, 5);
+        benchRun("ecdsa_p256_sign", benchEcdsaSign, b, 5);
+    }
+
+    mbedtls_mpi_free(&peerSecret);
+    mbedtls_pk_free(&b->signer);
+    mbedtls_ecp_point_free(&b->peer);
+    mbedtls_ecp_point_free(&b->point);
+    mbedtls_mpi_free(&b->shared);
+    mbedtls_mpi_free(&b->secret);
+    mbedtls_ecp_group_free(&b->group);
+    mbedtls_gcm_free(&b->gcm);
+    mbedtls_ctr_drbg_free(&b->drbg);
+    mbedtls_entropy_free(&b->entropy);
+    free(b);
+}
+
+/*******************************************************************************
+ * Reports
+ ******************************************************************************/
+
+void buildHttpsJson(JsonDocument& doc) {
+    HttpsStats s = getHttpsStats();
+    doc["enabled"] = (bool)HTTPS_ENABLED;
+    doc["running"] = s.running;
+    doc["port"] = HTTPS_PORT;
+    doc["https_only"] = (bool)HTTPS_ONLY;
+    doc["fingerprint_sha256"] = httpsFingerprint();
+    doc["links"] = s.links;
+    doc["accepted"] = s.accepted;
+    doc["refused"] = s.refused;
+    doc["evicted"] = s.evicted;
+    JsonObject handshakes = doc["handshakes"].to<JsonObject>();
+    handshakes["full"] = s.fullHandshakes;
+    handshakes["ticket"] = s.ticketResumes;
+    handshakes["cache"] = s.cacheResumes;
+    handshakes["failed"] = s.failedHandshakes;
+    handshakes["full_ms"] = s.fullHandshakeUs / 1000.0f;
+    handshakes["resumed_ms"] = s.resumeHandshakeUs / 1000.0f;
+    doc["requests"] = s.requests;
+    doc["reused_requests"] = s.reusedRequests;
+    doc["bytes_in"] = s.bytesIn;
+    doc["bytes_out"] = s.bytesOut;
+    doc["last_error"] = s.lastError;
+    JsonObject hw = doc["accelerators"].to<JsonObject>();
+    hw["aes"] = HW_AES;
+    hw["gcm"] = HW_GCM;
+    hw["sha"] = HW_SHA;
+    hw["mpi"] = HW_MPI;
+}
+
+void httpsServiceAttach(WebServer& server) {
+    tlsServer = &server;
+    server.on("/api/tls", HTTP_GET, []() {
+        webSendHeaders(*tlsServer, WEB_HEADERS_NO_STORE);
+        JsonArenaLease lease;
+        JsonDocument doc(lease.allocator());
+        buildHttpsJson(doc);
+        webSendJson(*tlsServer, 200, doc);
+    });
+}
+
+void printHttpsService(Print& out) {
+    HttpsStats s = getHttpsStats();
+    if (!HTTPS_ENABLED) {
+        out.println("HTTPS: disabled (HTTPS_ENABLED 0)");
+    } else {
+        out.printf("HTTPS: %s on port %u%s, %u of %u links open\n", s.running ? "RUNNING" : "not running",
+                   (unsigned)HTTPS_PORT, HTTPS_ONLY ? ", HTTP redirected" : "", (unsigned)s.links,
+                   (unsigned)HTTPS_MAX_LINKS);
+        out.printf("  certificate SHA-256 %s\n", s.running ? fingerprint : "-");
+        out.printf("  handshakes: %lu full (%.1f ms), %lu ticket + %lu cache resumed (%.1f ms), %lu failed\n",
+                   (unsigned long)s.fullHandshakes, s.fullHandshakeUs / 1000.0f, (unsigned long)s.ticketResumes,
+                   (unsigned long)s.cacheResumes, s.resumeHandshakeUs / 1000.0f, (unsigned long)s.failedHandshakes);
+        out.printf("  %lu connections (%lu refused, %lu idle evicted), %lu requests (%lu on a kept connection)\n",
+                   (unsigned long)s.accepted, (unsigned long)s.refused, (unsigned long)s.evicted,
+                   (unsigned long)s.requests, (unsigned long)s.reusedRequests);
+        out.printf("  %lu bytes in, %lu out", (unsigned long)s.bytesIn, (unsigned long)s.bytesOut);
+        if (s.lastError) out.printf(", last error -0x%04X", (unsigned)-s.lastError);
+        out.println();
+    }
+    out.printf("  mbedTLS accelerators: AES %s, GCM %s, SHA %s, MPI %s (\"bench\" times them)\n",
+               HW_AES ? "hw" : "sw", HW_GCM ? "hw" : "sw", HW_SHA ? "hw" : "sw", HW_MPI ? "hw" : "sw");
+}
@@ -0,0 +1,74 @@
+#ifndef HTTPS_SERVICE_H
+#define HTTPS_SERVICE_H
+
+#include <Arduino.h>
+#include <WebServer.h>
+#include <ArduinoJson.h>
+#include "config.h"
+
+// HTTPS front end for the dashboard and the API (HTTPS_ENABLED).
+// A task on the network core terminates TLS on HTTPS_PORT and passes each
+// request through to the plain HTTP server over the loopback interface. Every
+// route, the event stream and the uploads are therefore served over HTTPS
+// with no change to their handlers (framing: http_framing.h).
+//
+// Handshake cost is what limits a TLS server on this chip. A full ECDHE-ECDSA
+// handshake with P-256 needs one key generation, one ECDH and one signature,
+// and takes tens to hundreds of milliseconds. Polling clients avoid it:
+//  - Connections are kept alive between requests, up to HTTPS_MAX_LINKS. The
+//    oldest idle one gives way to a new client.
+//  - A reconnecting client resumes its session from a ticket (RFC 5077) or the
+//    session cache. Only the key schedule runs then, no public-key operation.
+// Either way a steady poll costs only AES-GCM and SHA-256, which mbedTLS runs
+// on the chip's AES and SHA accelerators. The "tls" report shows which
+// accelerators the build uses, and "bench" times the primitives.
+//
+// The key and a self-signed certificate for <host>.local are generated on
+// first start and kept in NVS (namespace "tls": "key" and "crt", DER). A
+// CA-issued pair can be written to the same keys instead.
+
+struct HttpsStats {
+    bool running;
+    uint8_t links;             ///< Open TLS connections
+    uint32_t accepted;
+    uint32_t refused;          ///< No free link and none idle
+    uint32_t evicted;          ///< Idle links closed for a new client
+    uint32_t fullHandshakes;
+    uint32_t ticketResumes;
+    uint32_t cacheResumes;
+    uint32_t failedHandshakes;
+    uint32_t requests;         ///< Passed to the HTTP server
+    uint32_t reusedRequests;   ///< Of those, on an already used connection
+    uint32_t bytesIn;          ///< Plaintext, from clients
+    uint32_t bytesOut;         ///< Plaintext, to clients
+    uint32_t fullHandshakeUs;  ///< Mean CPU time of our side of a full handshake
+    uint32_t resumeHandshakeUs;///< ... of a resumed one
+    int32_t lastError;         ///< Last mbedTLS error, 0 if none
+};
+
+// Starts the HTTPS task (loads or creates the identity, then listens). Call
+// once the network is up, after webServiceBegin(). Later calls do nothing.
+bool httpsServiceBegin();
+
+bool httpsServiceRunning();
+
+HttpsStats getHttpsStats();
+
+// SHA-256 fingerprint of the certificate as colon-separated hex, "" before the
+// identity is loaded. For pinning in API clients.
+const char* httpsFingerprint();
+
+// Deletes the stored identity; a new one is created on the next start.
+void httpsServiceForgetIdentity();
+
+// Adds AES-GCM, SHA-256, ECDHE and ECDSA cases to the running "bench" report.
+void httpsServiceBench();
+
+void buildHttpsJson(JsonDocument& doc);
+
+// Registers /api/tls. Call while the other routes are set up.
+void httpsServiceAttach(WebServer& server);
+
+void printHttpsService(Print& out);
+
+#endif // HTTPS_SERVICE_H
@@ -0,0 +1,248 @@
+/**
+ * @file hv_control.cpp
+ * @brief Timer-paced PI regulation of the HV boost converter.
+ *
+ * The esp_timer callback only notifies the control task, so a step never runs
+ * in the timer task and never waits for it. The task runs on the measurement
+ * core between the pulse sampling and processing tasks, above uiTask: a step
+ * is a few one-shot conversions and a PWM write, short enough to preempt LVGL
+ * and pulseTask without a visible cost, while the network core keeps the
+ * radio. The esp_timer clock does not change with frequency scaling
+ * (power_profile.h), unlike the APB-clocked general-purpose timers.
+ *
+ * The single ADC DMA controller is taken by the spectrum acquisition
+ * (spectrum_adc.h), so the divider is read with oversampled one-shot
+ * conversions: on ADC1 when the spectrum is disabled, otherwise on ADC2, where
+ * a conversion fails while the radio holds the unit. A failed step keeps the
+ * previous duty; HV_FEEDBACK_TIMEOUT_MS without a reading stops the output.
+ */
+
+#include "hv_control.h"
+#include "tube_profile.h"
+#include "device_config.h"
+#include "seqlock.h"
+#include "debug.h"
+#include <atomic>
+#include <math.h>
+#include "driver/adc.h"
+#include "esp_adc_cal.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+static const uint8_t FEEDBACK_OVERSAMPLE = 4;
+static const uint32_t HV_FEEDBACK_TIMEOUT_MS = 100;
+static const uint8_t PWM_BITS = 10;
+static const uint32_t ADC_DEFAULT_VREF_MV = 1100; ///< Only used without eFuse calibration
+static const uint32_t CONTROL_PERIOD_US = 1000000UL / HV_CONTROL_RATE_HZ;
+
+static SeqLock<HvStatus> statusLock;
+static TaskHandle_t controlTask = nullptr;
+static esp_timer_handle_t controlTimer = nullptr;
+static esp_adc_cal_characteristics_t adcChars;
+static bool useAdc2 = false;
+static int adcChannel = -1;
+static uint8_t pwmChannel = 0;
+
+static std::atomic<bool> enabled(true);
+static std::atomic<bool> overrideActive(false);
+static std::atomic<float> overrideVolts(HV_TARGET_DEFAULT_V);
+static std::atomic<bool> resetRequested(false);
+
+static float clampTarget(float volts) {
+    if (!isfinite(volts)) return HV_TARGET_DEFAULT_V;
+    return volts < HV_MIN_V ? HV_MIN_V : (volts > HV_MAX_V ? HV_MAX_V : volts);
+}
+
+/**
+ * @brief Averages FEEDBACK_OVERSAMPLE conversions into output volts.
+ * @return false if no conversion succeeded (ADC2 busy)
+ */
+static bool readFeedback(float* volts) {
+    uint32_t sum = 0;
+    uint8_t good = 0;
+    for (uint8_t i = 0; i < FEEDBACK_OVERSAMPLE; i++) {
+        int raw = -1;
+        if (useAdc2) {
+            if (adc2_get_raw((adc2_channel_t)adcChannel, ADC_WIDTH_BIT_12, &raw) != ESP_OK) raw = -1;
+        } else {
+            raw = adc1_get_raw((adc1_channel_t)adcChannel);
+        }
+        if (raw < 0) continue;
+        sum += raw;
+        good++;
+    }
+    if (!good) return false;
+    uint32_t millivolts = esp_adc_cal_raw_to_voltage((sum + good / 2) / good, &adcChars);
+    *volts = millivolts * 0.001f * HV_DIVIDER_RATIO;
+    return true;
+}
+
+static void writeDuty(float duty) {
+    ledcWrite(pwmChannel, (uint32_t)lroundf(duty * ((1 << PWM_BITS) - 1)));
+}
+
+static void controlTimerCallback(void* arg) {
+    xTaskNotifyGive(controlTask);
+}
+
+static void hvControlTask(void* parameter) {
+    HvRegulatorParams params;
+    params.kp = HV_KP;
+    params.ki = HV_KI;
+    params.dtSec = 1.0f / HV_CONTROL_RATE_HZ;
+    params.maxDuty = HV_MAX_DUTY;
+    params.slewVPerSec = HV_SLEW_V_PER_S;
+    params.maxVolts = HV_MAX_V + HV_OVERVOLTAGE_MARGIN_V;
+    params.noRegulationSec = 2.0f;
+    HvRegulator regulator(params);
+
+    HvStatus status;
+    memset(&status, 0, sizeof(status));
+    status.running = true;
+    const uint32_t timeoutTicks = HV_FEEDBACK_TIMEOUT_MS * HV_CONTROL_RATE_HZ / 1000;
+    uint32_t missedReadings = 0;
+    int64_t lastWakeUs = 0;
+
+    for (;;) {
+        // More than one pending notification: periods passed without a step
+        uint32_t periods = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        int64_t nowUs = esp_timer_get_time();
+        if (periods > 1) status.missedTicks += periods - 1;
+        if (lastWakeUs) {
+            int64_t deviation = (nowUs - lastWakeUs) - (int64_t)CONTROL_PERIOD_US * periods;
+            status.lastJitterUs = (uint32_t)(deviation < 0 ? -deviation : deviation);
+            if (status.lastJitterUs > status.maxJitterUs) status.maxJitterUs = status.lastJitterUs;
+        }
+        lastWakeUs = nowUs;
+
+        if (resetRequested.exchange(false)) {
+            regulator.reset();
+            status.maxJitterUs = 0;
+        }
+        status.overridden = overrideActive.load();
+        status.targetV = status.overridden ? overrideVolts.load() : getDeviceConfig().hvTargetV;
+        status.enabled = enabled.load();
+
+        float volts;
+        if (readFeedback(&volts)) {
+            missedReadings = 0;
+            status.measuredV = volts;
+            if (regulator.fault() == HV_FAULT_FEEDBACK) regulator.reset(); // Readings are back: soft start
+            writeDuty(regulator.update(volts, status.enabled ? status.targetV : 0.0f));
+        } else {
+            status.adcFailures++;
+            if (++missedReadings >= timeoutTicks && regulator.state() != HV_STATE_FAULT) {
+                regulator.trip(HV_FAULT_FEEDBACK);
+                writeDuty(0.0f);
+            }
+        }
+
+        status.state = regulator.state();
+        status.fault = regulator.fault();
+        status.setpointV = regulator.setpoint();
+        status.duty = regulator.duty();
+        status.ticks++;
+        statusLock.publish(status);
+    }
+}
+
+bool initHvControl(int8_t pwmPin, int8_t feedbackPin, uint8_t ledcChannel) {
+    if (controlTask) return true;
+    if (pwmPin < 0 || feedbackPin < 0) {
+        DEBUG_PRINTLN("HV: no boost converter configured (HV_PWM_PIN / HV_FEEDBACK_PIN)");
+        return false;
+    }
+    int8_t channel = digitalPinToAnalogChannel(feedbackPin);
+    if (channel < 0) {
+        DEBUG_PRINTF("HV: GPIO %d has no ADC channel\n", feedbackPin);
+        return false;
+    }
+    useAdc2 = channel >= SOC_ADC_MAX_CHANNEL_NUM;
+    adcChannel = useAdc2 ? channel - SOC_ADC_MAX_CHANNEL_NUM : channel;
+    if (!useAdc2 && SPECTRUM_ENABLED) {
+        DEBUG_PRINTLN("HV: ADC1 is in continuous mode for the spectrum, use an ADC2 pin");
+        return false;
+    }
+    adc_unit_t unit = useAdc2 ? ADC_UNIT_2 : ADC_UNIT_1;
+    if (useAdc2) {
+        adc2_config_channel_atten((adc2_channel_t)adcChannel, ADC_ATTEN_DB_11);
+    } else {
+        adc1_config_width(ADC_WIDTH_BIT_12);
+        adc1_config_channel_atten((adc1_channel_t)adcChannel, ADC_ATTEN_DB_11);
+    }
+    esp_adc_cal_characterize(unit, ADC_ATTEN_DB_11, ADC_WIDTH_BIT_12, ADC_DEFAULT_VREF_MV, &adcChars);
+
+    // Switch off before anything else can run
+    pwmChannel = ledcChannel;
+    ledcSetup(pwmChannel, HV_PWM_FREQUENCY, PWM_BITS);
+    ledcAttachPin(pwmPin, pwmChannel);
+    writeDuty(0.0f);
+
+    // Between the pulse sampling and processing tasks on the measurement core
+    if (xTaskCreatePinnedToCore(hvControlTask, "HvControl", 3072, NULL, HV_CONTROL_PRIORITY, &controlTask,
+                                TASK_CORE_MEASUREMENT) != pdPASS) {
+        controlTask = nullptr;
+        return false;
+    }
+    esp_timer_create_args_t args = {};
+    args.callback = controlTimerCallback;
+    args.name = "hv";
+    if (esp_timer_create(&args, &controlTimer) != ESP_OK ||
+        esp_timer_start_periodic(controlTimer, CONTROL_PERIOD_US) != ESP_OK) {
+        DEBUG_PRINTLN("HV: control timer could not be started");
+        return false;
+    }
+    DEBUG_PRINTF("HV: PWM GPIO %d, feedback ADC%d channel %d, %u Hz loop\n", pwmPin, useAdc2 ? 2 : 1, adcChannel,
+                 (unsigned)HV_CONTROL_RATE_HZ);
+    return true;
+}
+
+void hvSetEnabled(bool on) {
+    enabled = on;
+}
+
+void hvSetTargetOverride(float volts) {
+    overrideVolts = clampTarget(volts);
+    overrideActive = true;
+}
+
+void hvClearTargetOverride() {
+    overrideActive = false;
+}
+
+void hvReset() {
+    resetRequested = true;
+}
+
+HvStatus getHvStatus() {
+    HvStatus status;
+    memset(&status, 0, sizeof(status));
+    statusLock.read(status);
+    return status;
+}
+
+const char* hvStateName(uint8_t state) {
+    static const char* NAMES[] = {"off", "ramping", "regulating", "fault"};
+    return state <= HV_STATE_FAULT ? NAMES[state] : "?";
+}
+
+const char* hvFaultName(uint8_t fault) {
+    static const char* NAMES[] = {"none", "overvoltage", "no regulation", "feedback lost"};
+    return fault <= HV_FAULT_FEEDBACK ? NAMES[fault] : "?";
+}
+
+void printHvStatus(Print& out) {
+    HvStatus s = getHvStatus();
+    if (!s.running) {
+        out.println("HV: not running (no boost converter configured)");
+        return;
+    }
+    out.printf("HV: %s%s, %.1f V measured, setpoint %.1f V, target %.1f V%s\n", hvStateName(s.state),
+               s.enabled ? "" : " (disabled)", s.measuredV, s.setpointV, s.targetV,
+               s.overridden ? " (override)" : "");
+    out.printf("  duty %.1f%%, fault: %s\n", s.duty * 100.0f, hvFaultName(s.fault));
+    out.printf("  %lu steps at %u Hz, %lu missed, jitter %lu us (max %lu us), %lu ADC failures\n",
+               (unsigned long)s.ticks, (unsigned)HV_CONTROL_RATE_HZ, (unsigned long)s.missedTicks,
+               (unsigned long)s.lastJitterUs, (unsigned long)s.maxJitterUs, (unsigned long)s.adcFailures);
+}
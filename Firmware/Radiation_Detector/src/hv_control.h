@@ -0,0 +1,61 @@
+#ifndef HV_CONTROL_H
+#define HV_CONTROL_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "hv_regulator.h"
+
+// Closed-loop regulation of the tube high voltage.
+// An esp_timer fires at HV_CONTROL_RATE_HZ and wakes a control task above
+// uiTask's priority: it oversamples the divider on HV_FEEDBACK_PIN, steps the
+// PI regulator (hv_regulator.h) and writes the boost duty to an LEDC channel
+// on HV_PWM_PIN. Nothing in the loop depends on the UI or the network, so the
+// control rate holds under any UI load; the period jitter is measured.
+//
+// The target follows the device configuration (DeviceConfig::hvTargetV) unless
+// an override is set (plateau scans). When the divider cannot be read for
+// HV_FEEDBACK_TIMEOUT_MS (ADC2 held by the radio) the converter stops and
+// soft-starts again once readings return. Overvoltage and no-regulation faults
+// latch until hvReset().
+
+struct HvStatus {
+    bool running;          ///< Pins configured, loop started
+    bool enabled;          ///< Output requested (hvSetEnabled())
+    uint8_t state;         ///< HvState
+    uint8_t fault;         ///< HvFault
+    bool overridden;       ///< Target set by hvSetTargetOverride()
+    float targetV;         ///< Where the loop is heading
+    float setpointV;       ///< Soft-start ramp
+    float measuredV;
+    float duty;            ///< 0 ... HV_MAX_DUTY
+    uint32_t ticks;        ///< Control steps since start
+    uint32_t missedTicks;  ///< Timer periods the task did not get to
+    uint32_t lastJitterUs; ///< Deviation of the last period from nominal
+    uint32_t maxJitterUs;  ///< Worst deviation since start / hvReset()
+    uint32_t adcFailures;  ///< Steps without a divider reading
+};
+
+// Sets up the feedback ADC, the PWM channel and the control timer, and starts
+// the output. @return false when the pins are not configured or unusable.
+bool initHvControl(int8_t pwmPin, int8_t feedbackPin, uint8_t ledcChannel);
+
+// Turns the converter output on (soft start) or off. Any task.
+void hvSetEnabled(bool enabled);
+
+// Target for the loop instead of the configured one (volts, clamped to
+// HV_MIN_V ... HV_MAX_V); hvClearTargetOverride() returns to the configuration.
+void hvSetTargetOverride(float volts);
+void hvClearTargetOverride();
+
+// Clears a latched fault and the jitter statistics; the output soft-starts.
+void hvReset();
+
+// Consistent copy of the last control step. Any task, lock-free.
+HvStatus getHvStatus();
+
+const char* hvStateName(uint8_t state);
+const char* hvFaultName(uint8_t fault);
+
+void printHvStatus(Print& out);
+
+#endif // HV_CONTROL_H
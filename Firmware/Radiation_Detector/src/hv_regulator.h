@@ -0,0 +1,140 @@
+#ifndef HV_REGULATOR_H
+#define HV_REGULATOR_H
+
+#include <math.h>
+#include <stdint.h>
+
+// PI regulator for the tube's high-voltage boost converter, stepped at a fixed
+// rate with the divider reading; the output is the PWM duty of the boost switch.
+// Soft start: the setpoint the PI loop follows ramps towards the target at
+// slewVPerSec, starting from the measured voltage, so neither the first start
+// nor a large target change pulls a current spike through the inductor. The
+// integrator only runs while the duty is not saturated in the direction of the
+// error (anti-windup). Faults latch the output to zero until reset():
+//  - overvoltage above maxVolts,
+//  - no regulation: the duty sits at its limit for noRegulationSec while the
+//    voltage stays below half the setpoint (broken divider or converter).
+// No Arduino dependencies (host-compilable).
+
+enum HvState {
+    HV_STATE_OFF = 0,
+    HV_STATE_RAMPING,    ///< Setpoint still slewing towards the target
+    HV_STATE_REGULATING,
+    HV_STATE_FAULT
+};
+
+enum HvFault {
+    HV_FAULT_NONE = 0,
+    HV_FAULT_OVERVOLTAGE,
+    HV_FAULT_NO_REGULATION,
+    HV_FAULT_FEEDBACK      ///< No divider reading for too long (set by the caller)
+};
+
+struct HvRegulatorParams {
+    float kp;              ///< Duty per volt of error
+    float ki;              ///< Duty per volt-second of error
+    float dtSec;           ///< Control period
+    float maxDuty;         ///< Boost switch duty limit (never 100 %)
+    float slewVPerSec;     ///< Soft-start / target change ramp
+    float maxVolts;        ///< Overvoltage trip
+    float noRegulationSec; ///< Saturated without reaching half the setpoint
+};
+
+class HvRegulator {
+public:
+    explicit HvRegulator(const HvRegulatorParams& params) : p_(params) { reset(); }
+
+    /// Output off, fault cleared; the next enable soft-starts from the measured voltage.
+    void reset() {
+        state_ = HV_STATE_OFF;
+        fault_ = HV_FAULT_NONE;
+        integral_ = 0.0f;
+        setpoint_ = 0.0f;
+        duty_ = 0.0f;
+        saturatedSec_ = 0.0f;
+    }
+
+    /// Latches a fault detected outside the loop (e.g. feedback lost); output zero.
+    void trip(HvFault fault) {
+        state_ = HV_STATE_FAULT;
+        fault_ = fault;
+        integral_ = 0.0f;
+        duty_ = 0.0f;
+    }
+
+    /**
+     * @brief One control step.
+     * @param measuredVolts Divider reading of this period
+     * @param targetVolts   Operating voltage; <= 0 turns the converter off
+     * @return the duty (0 ... maxDuty) to apply until the next step
+     */
+    float update(float measuredVolts, float targetVolts) {
+        if (state_ == HV_STATE_FAULT) return 0.0f;
+        if (measuredVolts > p_.maxVolts) {
+            trip(HV_FAULT_OVERVOLTAGE);
+            return 0.0f;
+        }
+        if (targetVolts <= 0.0f) {
+            state_ = HV_STATE_OFF;
+            integral_ = 0.0f;
+            duty_ = 0.0f;
+            return 0.0f;
+        }
+        if (targetVolts > p_.maxVolts) targetVolts = p_.maxVolts;
+        if (state_ == HV_STATE_OFF) {
+            setpoint_ = measuredVolts; // Soft start from where the output is now
+            saturatedSec_ = 0.0f;
+        }
+
+        // Ramp the setpoint
+        float step = p_.slewVPerSec * p_.dtSec;
+        float delta = targetVolts - setpoint_;
+        if (fabsf(delta) <= step) {
+            setpoint_ = targetVolts;
+            state_ = HV_STATE_REGULATING;
+        } else {
+            setpoint_ += delta > 0.0f ? step : -step;
+            state_ = HV_STATE_RAMPING;
+        }
+
+        float error = setpoint_ - measuredVolts;
+        float candidate = integral_ + p_.ki * error * p_.dtSec;
+        float out = p_.kp * error + candidate;
+        bool high = out > p_.maxDuty;
+        bool low = out < 0.0f;
+        // Conditional integration: only while it does not push further into the limit
+        if (!(high && error > 0.0f) && !(low && error < 0.0f)) integral_ = candidate;
+        out = p_.kp * error + integral_;
+        if (out > p_.maxDuty) out = p_.maxDuty;
+        if (out < 0.0f) out = 0.0f;
+        duty_ = out;
+
+        if (duty_ >= p_.maxDuty && measuredVolts < 0.5f * setpoint_) {
+            saturatedSec_ += p_.dtSec;
+            if (saturatedSec_ >= p_.noRegulationSec) {
+                trip(HV_FAULT_NO_REGULATION);
+                return 0.0f;
+            }
+        } else {
+            saturatedSec_ = 0.0f;
+        }
+        return duty_;
+    }
+
+    HvState state() const { return state_; }
+    HvFault fault() const { return fault_; }
+    float setpoint() const { return setpoint_; }
+    float duty() const { return duty_; }
+    float integral() const { return integral_; }
+
+private:
+    HvRegulatorParams p_;
+    HvState state_;
+    HvFault fault_;
+    float integral_;
+    float setpoint_;
+    float duty_;
+    float saturatedSec_;
+};
+
+#endif // HV_REGULATOR_H
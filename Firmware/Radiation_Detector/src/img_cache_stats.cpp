@@ -0,0 +1,117 @@
+/**
+ * @file img_cache_stats.cpp
+ * @brief Pass-through LVGL image decoder that counts image lookups and opens.
+ *
+ * lv_img_decoder_create() puts the decoder at the head of LVGL's list, so it
+ * is asked first for every image. It claims variable images by delegating to
+ * the next decoder that accepts them (the asset pack decoder for the screens'
+ * images, the built-in one for plain C arrays), which makes its open callback
+ * the single point every cache miss goes through. The open hands the entry to
+ * that decoder, so LVGL reads and closes it without coming back here. A header
+ * query that is not part of an open is a draw that may have hit the cache.
+ */
+
+#include "config.h"
+
+#if !HEADLESS
+
+#include "img_cache_stats.h"
+#include <lvgl.h>
+#include <src/misc/lv_gc.h> // LVGL's decoder list, not exported by lvgl.h
+
+static lv_img_decoder_t* countingDecoder = nullptr;
+static uint16_t cacheEntries = LV_IMG_CACHE_DEF_SIZE;
+static ImageCacheStats stats;
+static lv_obj_t* currentScreen = nullptr;
+
+/**
+ * @brief Rolls the per-screen counter over when the active screen changed.
+ */
+static void trackScreen() {
+    lv_obj_t* screen = lv_scr_act();
+    if (screen == currentScreen) return;
+    currentScreen = screen;
+    stats.opensLastScreen = stats.opensThisScreen;
+    stats.opensThisScreen = 0;
+    stats.screenLoads++;
+}
+
+/**
+ * @return the first decoder after the counting one whose info accepts @p src
+ */
+static lv_img_decoder_t* nextDecoder(const void* src, lv_img_header_t* header) {
+    lv_img_decoder_t* d = (lv_img_decoder_t*)_lv_ll_get_next(&LV_GC_ROOT(_lv_img_decoder_ll), countingDecoder);
+    for (; d; d = (lv_img_decoder_t*)_lv_ll_get_next(&LV_GC_ROOT(_lv_img_decoder_ll), d)) {
+        if (d->info_cb && d->open_cb && d->info_cb(d, src, header) == LV_RES_OK) return d;
+    }
+    return nullptr;
+}
+
+static lv_res_t countingInfo(lv_img_decoder_t* decoder, const void* src, lv_img_header_t* header) {
+    if (lv_img_src_get_type(src) != LV_IMG_SRC_VARIABLE) return LV_RES_INV; // Files and symbols: built-in
+    if (!nextDecoder(src, header)) return LV_RES_INV;
+    trackScreen();
+    stats.lookups++;
+    return LV_RES_OK;
+}
+
+static lv_res_t countingOpen(lv_img_decoder_t* decoder, lv_img_decoder_dsc_t* dsc) {
+    trackScreen();
+    stats.opens++;
+    stats.opensThisScreen++;
+    // lv_img_decoder_open() asked for the header first: that was not a draw
+    if (stats.lookups > 0) stats.lookups--;
+    lv_img_decoder_t* next = nextDecoder(dsc->src, &dsc->header);
+    if (!next) return LV_RES_INV;
+    dsc->decoder = next;
+    return next->open_cb(next, dsc);
+}
+
+void imageCacheStatsEnable(bool enabled) {
+    if (enabled == (countingDecoder != nullptr)) return;
+    // Cached entries hold a pointer to the decoder that opened them
+    lv_img_cache_invalidate_src(NULL);
+    if (enabled) {
+        countingDecoder = lv_img_decoder_create();
+        if (!countingDecoder) return;
+        lv_img_decoder_set_info_cb(countingDecoder, countingInfo);
+        lv_img_decoder_set_open_cb(countingDecoder, countingOpen);
+        imageCacheStatsReset();
+    } else {
+        lv_img_decoder_delete(countingDecoder);
+        countingDecoder = nullptr;
+    }
+    lv_obj_invalidate(lv_scr_act());
+}
+
+void imageCacheSetEntries(uint16_t entries) {
+    if (entries == 0) entries = 1; // With no entry LVGL cannot draw images at all
+    lv_img_cache_set_size(entries);
+    cacheEntries = entries;
+    lv_obj_invalidate(lv_scr_act());
+}
+
+void imageCacheStatsReset() {
+    memset(&stats, 0, sizeof(stats));
+    currentScreen = lv_scr_act();
+}
+
+ImageCacheStats getImageCacheStats() {
+    ImageCacheStats out = stats;
+    out.enabled = countingDecoder != nullptr;
+    out.cacheEntries = cacheEntries;
+    return out;
+}
+
+void printImageCacheStats(Print& out) {
+    ImageCacheStats s = getImageCacheStats();
+    out.printf("Image cache: %u entries, measurement %s\n", (unsigned)s.cacheEntries, s.enabled ? "ON" : "OFF");
+    if (!s.enabled) return;
+    float hitRate = s.lookups ? 100.0f * (float)(s.lookups > s.opens ? s.lookups - s.opens : 0) / s.lookups : 0.0f;
+    out.printf("  %lu lookups, %lu opens (misses), hit rate %.1f%%\n", (unsigned long)s.lookups,
+               (unsigned long)s.opens, hitRate);
+    out.printf("  %lu screen loads, opens this screen %lu, previous screen %lu\n", (unsigned long)s.screenLoads,
+               (unsigned long)s.opensThisScreen, (unsigned long)s.opensLastScreen);
+}
+
+#endif // !HEADLESS
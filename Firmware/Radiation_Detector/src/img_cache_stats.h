@@ -0,0 +1,37 @@
+#ifndef IMG_CACHE_STATS_H
+#define IMG_CACHE_STATS_H
+
+#include <Arduino.h>
+
+// Measurement mode for LVGL's image cache ("imgcache").
+// While enabled, a pass-through decoder sits in front of the others and
+// counts how often an image is looked up and how often it really has to be
+// opened (a cache miss). Opens are also counted per screen load, so a screen
+// switch that reuses cached assets shows 0. Cache hits skip the decoder, so
+// lookups are counted where LVGL asks for the image header: every background
+// image draw, which is how every SquareLine asset except the splash is drawn.
+// LVGL task only.
+
+struct ImageCacheStats {
+    bool enabled;
+    uint16_t cacheEntries;      ///< Current LVGL image cache size
+    uint32_t lookups;           ///< Background image draws since enabled / reset
+    uint32_t opens;             ///< Decoder opens (cache misses)
+    uint32_t screenLoads;       ///< Screen changes seen
+    uint32_t opensThisScreen;   ///< Opens since the current screen was loaded
+    uint32_t opensLastScreen;   ///< Opens during the previous screen's visit
+};
+
+// Registers the counting decoder and starts from an empty cache.
+void imageCacheStatsEnable(bool enabled);
+
+// Resizes the LVGL image cache (tuning, at least 1); opened entries are closed.
+void imageCacheSetEntries(uint16_t entries);
+
+void imageCacheStatsReset();
+
+ImageCacheStats getImageCacheStats();
+
+void printImageCacheStats(Print& out);
+
+#endif // IMG_CACHE_STATS_H
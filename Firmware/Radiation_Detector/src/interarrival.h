@@ -0,0 +1,241 @@
+#ifndef INTERARRIVAL_H
+#define INTERARRIVAL_H
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+// Inter-arrival statistics of the Geiger pulses and the tube checks built on
+// them (tube_health.h).
+// InterArrivalHistogram bins the time between consecutive pulse timestamps in
+// quarter octaves from 1 us to 2^24 us (16.8 s; longer gaps go in the last
+// bin). The bin is found from the position of the leading bit and the two
+// bits after it, so adding an interval is a few instructions. Counts are
+// floats so that age() can halve them: the histogram then follows a slowly
+// changing tube instead of averaging its whole life. It also ages itself at
+// 2^23 intervals, where adding 1 to a float total starts to lose counts.
+//
+// A GM tube with a non-paralyzable dead time tau gives exponential intervals
+// shifted by tau: F(t) = 1 - exp(-lambda (t - tau)) for t >= tau, with mean
+// tau + 1 / lambda. From the fraction F below a bin edge t and the mean,
+//     tau = (t - g * mean) / (1 - g),   g = -ln(1 - F),
+// which needs no fit. Afterpulses show up as more intervals just above tau
+// than the exponential allows; intervals far below the rated dead time are
+// double triggers of the input (ringing, noise). A tube in continuous
+// discharge fires almost periodically, far more regular than a counting tube
+// at the same rate, whose coefficient of variation is 1 - m * tau.
+// No Arduino dependencies (host-compilable).
+
+#define INTERARRIVAL_OCTAVES 24
+#define INTERARRIVAL_BINS (INTERARRIVAL_OCTAVES * 4)
+
+class InterArrivalHistogram {
+public:
+    InterArrivalHistogram() { reset(); }
+
+    void reset() {
+        memset(counts_, 0, sizeof(counts_));
+        total_ = 0.0f;
+        sumUs_ = 0.0;
+    }
+
+    static uint8_t binOf(uint32_t us) {
+        if (us == 0) return 0;
+        uint8_t octave = 31 - __builtin_clz(us);
+        if (octave >= INTERARRIVAL_OCTAVES) return INTERARRIVAL_BINS - 1;
+        uint8_t quarter = octave >= 2 ? (us >> (octave - 2)) & 3 : (octave == 1 ? (us & 1) << 1 : 0);
+        return octave * 4 + quarter;
+    }
+
+    /// Lower edge of @p bin in microseconds.
+    static float binLowerUs(uint8_t bin) {
+        return ldexpf(1.0f + (bin & 3) * 0.25f, bin >> 2);
+    }
+
+    void add(uint32_t us) {
+        if (total_ >= 8388608.0f) age();
+        counts_[binOf(us)] += 1.0f;
+        total_ += 1.0f;
+        sumUs_ += us;
+    }
+
+    /// Halves every count: one half-life of the histogram has passed.
+    void age() {
+        for (uint8_t i = 0; i < INTERARRIVAL_BINS; i++) counts_[i] *= 0.5f;
+        total_ *= 0.5f;
+        sumUs_ *= 0.5;
+    }
+
+    /// Intervals below the lower edge of @p bin.
+    float countBelowBin(uint8_t bin) const {
+        float sum = 0.0f;
+        for (uint8_t i = 0; i < bin && i < INTERARRIVAL_BINS; i++) sum += counts_[i];
+        return sum;
+    }
+
+    /// First bin whose lower edge is at or above @p us.
+    static uint8_t binAtOrAbove(float us) {
+        uint8_t bin = binOf(us < 1.0f ? 1 : (uint32_t)us);
+        while (bin < INTERARRIVAL_BINS - 1 && binLowerUs(bin) < us) bin++;
+        return bin;
+    }
+
+    float count(uint8_t bin) const { return counts_[bin]; }
+    float total() const { return total_; }
+    float meanUs() const { return total_ > 0.0f ? (float)(sumUs_ / total_) : 0.0f; }
+    const float* counts() const { return counts_; }
+
+private:
+    float counts_[INTERARRIVAL_BINS];
+    float total_;
+    double sumUs_;
+};
+
+/**
+ * @brief Mean and spread of the intervals over a short window.
+ */
+class IntervalMoments {
+public:
+    IntervalMoments() { reset(); }
+
+    void reset() {
+        n_ = 0;
+        sum_ = 0.0;
+        sumSquares_ = 0.0;
+    }
+
+    void add(uint32_t us) {
+        n_++;
+        sum_ += us;
+        sumSquares_ += (double)us * us;
+    }
+
+    uint32_t count() const { return n_; }
+    float meanUs() const { return n_ ? (float)(sum_ / n_) : 0.0f; }
+
+    /// Coefficient of variation (1 for a Poisson process without dead time).
+    float cv() const {
+        if (n_ < 2 || sum_ <= 0.0) return 0.0f;
+        double mean = sum_ / n_;
+        double variance = sumSquares_ / n_ - mean * mean;
+        return variance > 0.0 ? (float)(sqrt(variance) / mean) : 0.0f;
+    }
+
+private:
+    uint32_t n_;
+    double sum_;
+    double sumSquares_;
+};
+
+struct DeadTimeEstimate {
+    bool valid;          ///< Enough intervals below the edge
+    float us;
+    float sigmaUs;
+    float edgeUs;        ///< Bin edge t the fraction was taken at
+    float below;         ///< Intervals below it
+};
+
+/**
+ * @brief Dead time from the fraction of intervals below a bin edge (see the
+ *        header comment). The edge is the one nearest 4 x @p ratedUs, or
+ *        closer to it at high rates, where most intervals are that short.
+ * @param minBelow Intervals below the edge needed for an estimate
+ */
+inline DeadTimeEstimate estimateDeadTime(const InterArrivalHistogram& h, float ratedUs, float minBelow) {
+    DeadTimeEstimate e = {};
+    float n = h.total();
+    if (n <= 0.0f) return e;
+    uint8_t lowest = InterArrivalHistogram::binAtOrAbove(1.5f * ratedUs);
+    uint8_t edge = InterArrivalHistogram::binAtOrAbove(4.0f * ratedUs);
+    e.below = h.countBelowBin(edge);
+    while (edge > lowest && e.below > 0.4f * n) e.below = h.countBelowBin(--edge);
+    e.edgeUs = InterArrivalHistogram::binLowerUs(edge);
+    if (e.below < minBelow || e.below >= n) return e;
+
+    float f = e.below / n;
+    float g = -logf(1.0f - f);
+    float mean = h.meanUs();
+    if (g >= 1.0f) return e;
+    e.us = (e.edgeUs - g * mean) / (1.0f - g);
+    // Binomial error of the count below the edge, through g
+    float sigmaG = sqrtf(e.below * (1.0f - f)) / (n * (1.0f - f));
+    e.sigmaUs = fabsf(mean - e.us) * sigmaG / (1.0f - g);
+    // Afterpulses pull the estimate down, to nonsense when they are frequent
+    e.valid = e.us > 0.0f;
+    return e;
+}
+
+/**
+ * @brief Intervals from @p ratedUs to 4 x @p ratedUs against the shifted
+ *        exponential with the rated dead time and the observed mean.
+ * @param expected Receives the expected count
+ * @return Observed count
+ */
+inline float shortIntervalExcess(const InterArrivalHistogram& h, float ratedUs, float* expected) {
+    uint8_t from = InterArrivalHistogram::binAtOrAbove(ratedUs);
+    uint8_t to = InterArrivalHistogram::binAtOrAbove(4.0f * ratedUs);
+    float observed = h.countBelowBin(to) - h.countBelowBin(from);
+    float lambda = h.meanUs() > ratedUs ? 1.0f / (h.meanUs() - ratedUs) : 0.0f;
+    float t0 = InterArrivalHistogram::binLowerUs(from);
+    float t1 = InterArrivalHistogram::binLowerUs(to);
+    if (t0 < ratedUs) t0 = ratedUs;
+    *expected = h.total() * (expf(-lambda * (t0 - ratedUs)) - expf(-lambda * (t1 - ratedUs)));
+    return observed;
+}
+
+/**
+ * @brief Hourly count rate against its slowly following baseline.
+ */
+class RateBaseline {
+public:
+    RateBaseline() { reset(); }
+
+    void reset() {
+        baselineCps_ = 0.0f;
+        hours_ = 0;
+        counts_ = 0;
+        seconds_ = 0;
+        lastZ_ = 0.0f;
+        lastRatio_ = 1.0f;
+        shiftedHours_ = 0;
+    }
+
+    /// One closed second. @return true when it closed an hour
+    bool addSecond(uint32_t counts, float shiftFraction, float baselineHours) {
+        counts_ += counts;
+        if (++seconds_ < 3600) return false;
+        float hourCps = counts_ / 3600.0f;
+        if (hours_ == 0) {
+            baselineCps_ = hourCps;
+        } else {
+            float expected = baselineCps_ * 3600.0f;
+            lastZ_ = expected > 0.0f ? (counts_ - expected) / sqrtf(expected) : 0.0f;
+            lastRatio_ = baselineCps_ > 0.0f ? hourCps / baselineCps_ : 1.0f;
+            bool shifted = fabsf(lastZ_) > 5.0f && fabsf(lastRatio_ - 1.0f) > shiftFraction;
+            shiftedHours_ = shifted ? (shiftedHours_ < UINT8_MAX ? shiftedHours_ + 1 : UINT8_MAX) : 0;
+            baselineCps_ += (hourCps - baselineCps_) / baselineHours;
+        }
+        if (hours_ < UINT16_MAX) hours_++;
+        counts_ = 0;
+        seconds_ = 0;
+        return true;
+    }
+
+    /// Two hours in a row off the baseline, after six hours to form it.
+    bool shifted() const { return hours_ >= 6 && shiftedHours_ >= 2; }
+    float baselineCps() const { return baselineCps_; }
+    float lastZ() const { return lastZ_; }
+    float lastRatio() const { return lastRatio_; }
+    uint16_t hours() const { return hours_; }
+
+private:
+    float baselineCps_;
+    uint16_t hours_;
+    uint32_t counts_;
+    uint16_t seconds_;
+    float lastZ_;
+    float lastRatio_;
+    uint8_t shiftedHours_;
+};
+
+#endif // INTERARRIVAL_H
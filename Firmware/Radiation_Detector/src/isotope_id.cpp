@@ -0,0 +1,433 @@
+/**
+ * @file isotope_id.cpp
+ * @brief Template matching of isotope line sets on windowed ROI sums.
+ *
+ * Region edges are sorted into one boundary list and every channel maps to
+ * the segment between two boundaries (a byte table in internal RAM, read per
+ * pulse). A region's sum is then a difference of two prefix sums over the
+ * segments. pulseTask only increments running per-segment counters. The task
+ * turns them into per-pass deltas by differencing, so it never stops the
+ * writer. Like Spectrum::read(), a pass sees each counter whole but may be a
+ * few pulses behind on some.
+ *
+ * A new energy calibration rebuilds the regions into the spare table, swaps
+ * it in and restarts the window and the background: the segments of the old
+ * table mean different channels. The background holds ROI and sideband counts
+ * per line with exponential forgetting. The expected net counts and their
+ * variance scale with the window's live time.
+ */
+
+#include "isotope_id.h"
+#include "alarm_rules.h"
+#include "spectrum_analysis.h"
+#include "seqlock.h"
+#include "debug.h"
+#include "esp_heap_caps.h"
+#include <atomic>
+#include <math.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+static const uint8_t MAX_LINES = 4;                                   ///< Per isotope
+static const uint8_t LINE_CAPACITY = ISOTOPE_COUNT * MAX_LINES;
+static const uint16_t MAX_BOUNDARIES = LINE_CAPACITY * 4 + 2;         ///< Four edges per line, 0 and the overflow channel
+static const uint8_t SLOTS = ISOTOPE_ID_WINDOW_S * 1000 / ISOTOPE_ID_INTERVAL_MS;
+static const float ROI_HALF_FWHM = 0.6f;                              ///< Best signal to noise for a Gaussian on a flat continuum
+static const float SIDE_FWHM = 0.5f;                                  ///< Width of each sideband
+
+static_assert(MAX_BOUNDARIES <= 256, "segment indices are bytes");
+static_assert(SLOTS >= 2, "the window needs at least two passes");
+
+struct IsotopeLine {
+    float keV;
+    float weight;          ///< Expected peak area relative to the strongest line, for this detector
+};
+
+struct IsotopeTemplate {
+    const char* name;
+    IsotopeClass isotopeClass;
+    IsotopeLine lines[MAX_LINES];
+};
+
+// Weights fold the emission probabilities with the falling photopeak
+// efficiency of a small CsI(Tl) crystal; they only need to be roughly right
+// for the ratio test. Unused lines have keV 0.
+static const IsotopeTemplate LIBRARY[ISOTOPE_COUNT] = {
+    {"K-40", ISOTOPE_NATURAL, {{1460.8f, 1.0f}}},
+    {"Ra-226", ISOTOPE_NATURAL, {{351.9f, 0.8f}, {609.3f, 1.0f}, {1764.5f, 0.2f}}},
+    {"Th-232", ISOTOPE_NATURAL, {{238.6f, 1.0f}, {583.2f, 0.6f}, {911.2f, 0.4f}, {2614.5f, 0.3f}}},
+    {"Tc-99m", ISOTOPE_MEDICAL, {{140.5f, 1.0f}}},
+    {"I-131", ISOTOPE_MEDICAL, {{364.5f, 1.0f}}},
+    {"F-18", ISOTOPE_MEDICAL, {{511.0f, 1.0f}}},
+    {"Am-241", ISOTOPE_INDUSTRIAL, {{59.5f, 1.0f}}},
+    {"Ba-133", ISOTOPE_INDUSTRIAL, {{81.0f, 0.6f}, {356.0f, 1.0f}}},
+    {"Cs-137", ISOTOPE_INDUSTRIAL, {{661.7f, 1.0f}}},
+    {"Co-60", ISOTOPE_INDUSTRIAL, {{1173.2f, 1.0f}, {1332.5f, 0.9f}}},
+    {"Ir-192", ISOTOPE_INDUSTRIAL, {{316.5f, 1.0f}, {468.1f, 0.45f}}},
+    {"U-235", ISOTOPE_NUCLEAR, {{185.7f, 1.0f}}},
+};
+
+struct LineRegions {
+    uint8_t isotope;
+    float weight;
+    uint8_t edge[4];       ///< Boundary indices: left sideband, ROI start, ROI end, right sideband end
+    float sideScale;       ///< ROI channels per sideband channel
+};
+
+// Shared with pulseTask
+static const Spectrum* idSpectrum = nullptr;
+static uint8_t* tables[2] = {nullptr, nullptr};    ///< Segment of each channel
+static const uint8_t* volatile activeTable = nullptr;
+static volatile uint32_t segmentCounts[MAX_BOUNDARIES];
+static volatile uint32_t liveMsTotal = 0;
+static std::atomic<uint8_t> alarmLevel(ALARM_LEVEL_NONE);
+static std::atomic<bool> relearnRequested(false);
+
+// Evaluation task only
+static EnergyCalibration tableCal;
+static LineRegions lines[LINE_CAPACITY];
+static uint8_t lineCount = 0;
+static uint16_t segmentCount = 0;
+static uint32_t lastCounts[MAX_BOUNDARIES];
+static uint32_t lastLiveMs = 0;
+static bool primed = false;
+static uint32_t* ring = nullptr;                   ///< SLOTS x MAX_BOUNDARIES deltas, PSRAM
+static uint32_t ringLiveMs[SLOTS];
+static uint32_t windowCounts[MAX_BOUNDARIES];
+static uint32_t windowLiveMs = 0;
+static uint8_t head = 0;
+static uint32_t windowPrefix[MAX_BOUNDARIES + 1];
+static uint32_t deltaPrefix[MAX_BOUNDARIES + 1];
+static float backgroundRoi[LINE_CAPACITY];
+static float backgroundSide[LINE_CAPACITY];
+static float backgroundLiveS = 0.0f;
+static float lineExcess[LINE_CAPACITY];
+static float lineVariance[LINE_CAPACITY];
+static IsotopeIdStatus status;
+static SeqLock<IsotopeIdStatus> statusLock;
+
+static bool sameCalibration(const EnergyCalibration& a, const EnergyCalibration& b) {
+    return a.c0 == b.c0 && a.c1 == b.c1 && a.c2 == b.c2;
+}
+
+static uint8_t boundaryIndex(const uint16_t* bounds, uint16_t count, uint16_t channel) {
+    uint16_t lo = 0, hi = count - 1;
+    while (lo < hi) {
+        uint16_t mid = (lo + hi) / 2;
+        if (bounds[mid] < channel) lo = mid + 1;
+        else hi = mid;
+    }
+    return (uint8_t)lo;
+}
+
+static void resetWindow() {
+    primed = false;
+    memset(ring, 0, (size_t)SLOTS * MAX_BOUNDARIES * sizeof(uint32_t));
+    memset(ringLiveMs, 0, sizeof(ringLiveMs));
+    memset(windowCounts, 0, sizeof(windowCounts));
+    windowLiveMs = 0;
+    head = 0;
+}
+
+static void resetBackground() {
+    memset(backgroundRoi, 0, sizeof(backgroundRoi));
+    memset(backgroundSide, 0, sizeof(backgroundSide));
+    backgroundLiveS = 0.0f;
+    alarmLevel.store(ALARM_LEVEL_NONE, std::memory_order_relaxed); // Nothing is identified until learned again
+    status.alarmLevel = ALARM_LEVEL_NONE;
+}
+
+/**
+ * @brief Lays out the regions of every line inside the calibrated range and
+ *        fills the spare segment table, then swaps it in.
+ */
+static void buildRegions(const EnergyCalibration& cal) {
+    uint16_t channels = idSpectrum->channels();
+    uint16_t last = channels - 1; // The overflow channel stays outside every region
+    uint16_t edges[LINE_CAPACITY][4];
+    uint16_t bounds[MAX_BOUNDARIES];
+    uint16_t boundCount = 0;
+    bounds[boundCount++] = 0;
+    bounds[boundCount++] = last;
+
+    lineCount = 0;
+    memset(status.isotopes, 0, sizeof(status.isotopes));
+    for (uint8_t i = 0; i < ISOTOPE_COUNT; i++) {
+        status.isotopes[i].name = LIBRARY[i].name;
+        status.isotopes[i].isotopeClass = LIBRARY[i].isotopeClass;
+        for (uint8_t j = 0; j < MAX_LINES && LIBRARY[i].lines[j].keV > 0.0f && cal.valid(); j++) {
+            float keV = LIBRARY[i].lines[j].keV;
+            float fwhm = SPECTRUM_RESOLUTION_662 * sqrtf(661.7f * keV);
+            float outer = (ROI_HALF_FWHM + SIDE_FWHM) * fwhm;
+            float sideLo = cal.channel(keV - outer);
+            float sideHi = cal.channel(keV + outer);
+            if (sideLo < 1.0f || sideHi < 0.0f || sideHi + 0.5f > last) continue; // Outside the calibrated range
+            uint16_t* e = edges[lineCount];
+            e[0] = (uint16_t)(sideLo + 0.5f);
+            e[1] = (uint16_t)(cal.channel(keV - ROI_HALF_FWHM * fwhm) + 0.5f);
+            e[2] = (uint16_t)(cal.channel(keV + ROI_HALF_FWHM * fwhm) + 0.5f);
+            e[3] = (uint16_t)(sideHi + 0.5f);
+            // At least one channel per region, however coarse the calibration
+            if (e[1] <= e[0]) e[1] = e[0] + 1;
+            if (e[2] <= e[1]) e[2] = e[1] + 1;
+            if (e[3] <= e[2]) e[3] = e[2] + 1;
+            if (e[3] > last) continue;
+            lines[lineCount].isotope = i;
+            lines[lineCount].weight = LIBRARY[i].lines[j].weight;
+            lines[lineCount].sideScale = (float)(e[2] - e[1]) / (float)((e[1] - e[0]) + (e[3] - e[2]));
+            for (uint8_t k = 0; k < 4; k++) bounds[boundCount++] = e[k];
+            status.isotopes[i].lines++;
+            lineCount++;
+        }
+    }
+
+    // Sorted unique boundaries; segment s is [bounds[s], bounds[s + 1])
+    for (uint16_t i = 1; i < boundCount; i++) {
+        uint16_t v = bounds[i];
+        uint16_t j = i;
+        for (; j > 0 && bounds[j - 1] > v; j--) bounds[j] = bounds[j - 1];
+        bounds[j] = v;
+    }
+    uint16_t unique = 0;
+    for (uint16_t i = 0; i < boundCount; i++) {
+        if (unique == 0 || bounds[i] != bounds[unique - 1]) bounds[unique++] = bounds[i];
+    }
+    for (uint8_t l = 0; l < lineCount; l++) {
+        for (uint8_t k = 0; k < 4; k++) lines[l].edge[k] = boundaryIndex(bounds, unique, edges[l][k]);
+    }
+
+    uint8_t* table = activeTable == tables[0] ? tables[1] : tables[0];
+    uint16_t segment = 0;
+    for (uint16_t ch = 0; ch < channels; ch++) {
+        while (segment + 1 < unique && ch >= bounds[segment + 1]) segment++;
+        table[ch] = (uint8_t)segment;
+    }
+    segmentCount = unique; // The overflow channel's own segment is never summed
+    activeTable = table;
+    tableCal = cal;
+    status.tableBuilds++;
+    status.segments = segmentCount;
+    resetWindow();
+    resetBackground();
+}
+
+/**
+ * @brief Moves the counts since the last pass into the window ring.
+ * @return Live milliseconds of the pass, 0 on the pass that only primes
+ */
+static uint32_t advanceWindow() {
+    uint32_t liveMs = liveMsTotal;
+    if (!primed) {
+        for (uint16_t s = 0; s < segmentCount; s++) lastCounts[s] = segmentCounts[s];
+        lastLiveMs = liveMs;
+        primed = true;
+        return 0;
+    }
+    uint32_t* slot = ring + (size_t)head * MAX_BOUNDARIES;
+    deltaPrefix[0] = 0;
+    windowPrefix[0] = 0;
+    for (uint16_t s = 0; s < segmentCount; s++) {
+        uint32_t count = segmentCounts[s];
+        uint32_t delta = count - lastCounts[s];
+        lastCounts[s] = count;
+        windowCounts[s] += delta - slot[s];
+        slot[s] = delta;
+        deltaPrefix[s + 1] = deltaPrefix[s] + delta;
+        windowPrefix[s + 1] = windowPrefix[s] + windowCounts[s];
+    }
+    uint32_t liveDelta = liveMs - lastLiveMs;
+    lastLiveMs = liveMs;
+    windowLiveMs += liveDelta - ringLiveMs[head];
+    ringLiveMs[head] = liveDelta;
+    head = (head + 1) % SLOTS;
+    return liveDelta;
+}
+
+static uint32_t regionSum(const uint32_t* prefix, uint8_t from, uint8_t to) {
+    return prefix[to] - prefix[from];
+}
+
+static uint8_t classLevel(uint8_t isotopeClass) {
+    switch (isotopeClass) {
+        case ISOTOPE_MEDICAL: return ALARM_LEVEL_WARN;
+        case ISOTOPE_INDUSTRIAL:
+        case ISOTOPE_NUCLEAR: return ALARM_LEVEL_ALARM;
+        default: return ALARM_LEVEL_NONE;
+    }
+}
+
+static void evaluate() {
+    EnergyCalibration cal = getEnergyCalibration();
+    if (!sameCalibration(cal, tableCal)) buildRegions(cal);
+    if (relearnRequested.exchange(false)) resetBackground();
+
+    uint32_t passLiveMs = advanceWindow();
+    float liveS = windowLiveMs / 1000.0f;
+    status.windowLiveS = liveS;
+    if (passLiveMs == 0 || liveS < 1.0f) return; // Primed only, or the probe is idle
+
+    // Net peak counts of each line in the window, against the learned background
+    for (uint8_t l = 0; l < lineCount; l++) {
+        const LineRegions& line = lines[l];
+        float k = line.sideScale;
+        float roi = regionSum(windowPrefix, line.edge[1], line.edge[2]);
+        float side = regionSum(windowPrefix, line.edge[0], line.edge[1]) +
+                     regionSum(windowPrefix, line.edge[2], line.edge[3]);
+        float excess = roi - k * side;
+        float variance = roi + k * k * side;
+        if (backgroundLiveS > 0.0f) {
+            float scale = liveS / backgroundLiveS;
+            excess -= (backgroundRoi[l] - k * backgroundSide[l]) * scale;
+            variance += (backgroundRoi[l] + k * k * backgroundSide[l]) * scale * scale;
+        }
+        lineExcess[l] = excess;
+        lineVariance[l] = variance > 1.0f ? variance : 1.0f;
+    }
+
+    // Weighted least-squares amplitude of each template
+    bool learned = backgroundLiveS >= ISOTOPE_ID_LEARN_S;
+    bool quiet = true;
+    uint8_t level = ALARM_LEVEL_NONE;
+    for (uint8_t i = 0; i < ISOTOPE_COUNT; i++) {
+        IsotopeResult& result = status.isotopes[i];
+        float swe = 0.0f, sww = 0.0f;
+        for (uint8_t l = 0; l < lineCount; l++) {
+            if (lines[l].isotope != i) continue;
+            swe += lines[l].weight * lineExcess[l] / lineVariance[l];
+            sww += lines[l].weight * lines[l].weight / lineVariance[l];
+        }
+        if (result.lines == 0 || sww <= 0.0f) continue;
+        result.amplitude = swe / sww;
+        result.z = swe / sqrtf(sww);
+        float chi2 = 0.0f;
+        for (uint8_t l = 0; l < lineCount; l++) {
+            if (lines[l].isotope != i) continue;
+            float residual = lineExcess[l] - result.amplitude * lines[l].weight;
+            chi2 += residual * residual / lineVariance[l];
+        }
+        result.chi2 = result.lines > 1 ? chi2 / (result.lines - 1) : 0.0f;
+
+        if (!learned) {
+            result.identified = false;
+        } else if (result.identified) {
+            result.identified = result.z >= ISOTOPE_ID_CLEAR_SIGMA;
+        } else {
+            result.identified = result.z >= ISOTOPE_ID_ALARM_SIGMA && result.chi2 <= ISOTOPE_ID_MAX_CHI2;
+        }
+        if (result.identified || result.z >= ISOTOPE_ID_CLEAR_SIGMA) quiet = false;
+        if (result.identified && classLevel(result.isotopeClass) > level) level = classLevel(result.isotopeClass);
+    }
+    alarmLevel.store(level, std::memory_order_relaxed);
+    status.alarmLevel = level;
+
+    // The background learns from quiet passes (and from every pass until learned)
+    if (!learned || quiet) {
+        float passS = passLiveMs / 1000.0f;
+        float decay = expf(-passS / ISOTOPE_ID_BACKGROUND_S);
+        for (uint8_t l = 0; l < lineCount; l++) {
+            const LineRegions& line = lines[l];
+            backgroundRoi[l] = backgroundRoi[l] * decay + regionSum(deltaPrefix, line.edge[1], line.edge[2]);
+            backgroundSide[l] = backgroundSide[l] * decay + regionSum(deltaPrefix, line.edge[0], line.edge[1]) +
+                                regionSum(deltaPrefix, line.edge[2], line.edge[3]);
+        }
+        backgroundLiveS = backgroundLiveS * decay + passS;
+    }
+    status.backgroundLiveS = backgroundLiveS;
+    status.ready = learned && lineCount > 0;
+    status.passes++;
+}
+
+/**
+ * @brief Evaluation task (core 0): one pass per interval, stretched to stay in budget.
+ */
+static void isotopeIdTask(void* parameter) {
+    TickType_t wake = xTaskGetTickCount();
+    uint32_t intervalMs = ISOTOPE_ID_INTERVAL_MS;
+    for (;;) {
+        vTaskDelayUntil(&wake, pdMS_TO_TICKS(intervalMs));
+        uint32_t start = micros();
+        evaluate();
+        uint32_t passUs = micros() - start;
+
+        // A pass may take ISOTOPE_ID_CPU_PCT of its interval: us * 100 / pct / 1000 ms
+        uint32_t budgetMs = passUs / (10 * ISOTOPE_ID_CPU_PCT) + 1;
+        intervalMs = budgetMs > ISOTOPE_ID_INTERVAL_MS ? budgetMs : ISOTOPE_ID_INTERVAL_MS;
+        status.passUs = passUs;
+        status.intervalMs = intervalMs;
+        status.cpuPct = passUs / (intervalMs * 10.0f);
+        statusLock.publish(status);
+    }
+}
+
+bool initIsotopeId(const Spectrum& spectrum) {
+    if (idSpectrum) return true;
+    if (!spectrum.ready()) return false;
+    for (uint8_t i = 0; i < 2; i++) {
+        tables[i] = (uint8_t*)heap_caps_malloc(spectrum.channels(), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT); // Read per pulse
+        if (!tables[i]) return false;
+    }
+    ring = (uint32_t*)heap_caps_malloc((size_t)SLOTS * MAX_BOUNDARIES * sizeof(uint32_t),
+                                       MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!ring) return false;
+
+    idSpectrum = &spectrum;
+    status.intervalMs = ISOTOPE_ID_INTERVAL_MS;
+    buildRegions(getEnergyCalibration());
+    statusLock.publish(status);
+    if (xTaskCreatePinnedToCore(isotopeIdTask, "IsotopeId", 4096, NULL, tskIDLE_PRIORITY + 1, NULL, 0) != pdPASS) {
+        activeTable = nullptr;
+        return false;
+    }
+    DEBUG_PRINTF("Isotope ID: %u lines in %u segments\n", (unsigned)lineCount, (unsigned)segmentCount);
+    return true;
+}
+
+void isotopeIdAdd(uint16_t channel) {
+    const uint8_t* table = activeTable;
+    if (table) segmentCounts[table[channel]]++;
+}
+
+void isotopeIdAddLiveMs(uint32_t liveMs) {
+    liveMsTotal += liveMs;
+}
+
+uint8_t isotopeIdAlarmLevel() {
+    return alarmLevel.load(std::memory_order_relaxed);
+}
+
+IsotopeIdStatus getIsotopeIdStatus() {
+    IsotopeIdStatus copy;
+    memset(&copy, 0, sizeof(copy));
+    statusLock.read(copy);
+    return copy;
+}
+
+void isotopeIdRelearn() {
+    relearnRequested.store(true);
+}
+
+void printIsotopeId(Print& out) {
+    static const char* classNames[] = {"natural", "medical", "industrial", "nuclear"};
+    if (!idSpectrum) {
+        out.println("Isotope ID: not running (no spectrum)");
+        return;
+    }
+    IsotopeIdStatus s = getIsotopeIdStatus();
+    out.printf("Isotope ID: %s, alarm level %s; window %.0f s live, background %.0f s live%s\n",
+               s.ready ? "ready" : "learning", alarmLevelName(s.alarmLevel), s.windowLiveS, s.backgroundLiveS,
+               s.backgroundLiveS < ISOTOPE_ID_LEARN_S ? " (learning)" : "");
+    out.printf("  %u segments, %lu builds, %lu passes, last %lu us every %lu ms (%.2f%% CPU)\n",
+               (unsigned)s.segments, (unsigned long)s.tableBuilds, (unsigned long)s.passes,
+               (unsigned long)s.passUs, (unsigned long)s.intervalMs, s.cpuPct);
+    for (uint8_t i = 0; i < ISOTOPE_COUNT; i++) {
+        const IsotopeResult& r = s.isotopes[i];
+        if (!r.name) continue;
+        if (r.lines == 0) {
+            out.printf("  %-7s %-10s outside the calibrated range\n", r.name, classNames[r.isotopeClass]);
+            continue;
+        }
+        out.printf("  %-7s %-10s z %+6.1f, %8.0f counts, chi2 %5.2f%s\n", r.name, classNames[r.isotopeClass], r.z,
+                   r.amplitude, r.chi2, r.identified ? "  IDENTIFIED" : "");
+    }
+}
@@ -0,0 +1,91 @@
+#ifndef ISOTOPE_ID_H
+#define ISOTOPE_ID_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "spectrum.h"
+
+// Isotope identification alarm on the live scintillation spectrum.
+// Every isotope of a small library is a template of up to four gamma lines
+// with their expected relative peak areas. Each line gets a region of
+// interest (ROI, +-0.6 FWHM) and a sideband on either side for the
+// continuum under it. All region edges cut the channel axis into segments.
+// pulseTask adds each pulse to its segment's running count, one table
+// lookup and one increment, so the sums follow every new count without a
+// pass over the histogram.
+//
+// A task on core 0 evaluates every ISOTOPE_ID_INTERVAL_MS. The segment counts
+// since the previous pass go into a ring covering ISOTOPE_ID_WINDOW_S. For
+// each line it takes the window's net peak counts (ROI minus the scaled
+// sidebands), less what the learned background predicts for the same live
+// time. A weighted least-squares fit of the template to those excesses gives
+// each isotope a significance z and a chi-square for the line ratios. A
+// Cs-137 source therefore does not read as Ra-226, whose 609 keV line it
+// overlaps, because Ra-226's other lines stay flat.
+//
+// An isotope is identified when z reaches ISOTOPE_ID_ALARM_SIGMA with
+// consistent ratios. It clears below ISOTOPE_ID_CLEAR_SIGMA. Its class decides
+// the alarm level (alarm_rules.h, ALARM_CAUSE_ISOTOPE):
+//  - natural (NORM): reported only;
+//  - medical: a nuisance, warns;
+//  - industrial or nuclear material: alarms.
+// The background is learned while nothing is identified, over
+// ISOTOPE_ID_BACKGROUND_S of live time; nothing alarms before
+// ISOTOPE_ID_LEARN_S of it. If a pass takes more than ISOTOPE_ID_CPU_PCT of
+// its interval, the interval is stretched.
+
+enum IsotopeClass {
+    ISOTOPE_NATURAL = 0,
+    ISOTOPE_MEDICAL,
+    ISOTOPE_INDUSTRIAL,
+    ISOTOPE_NUCLEAR,
+};
+
+static const uint8_t ISOTOPE_COUNT = 12;
+
+struct IsotopeResult {
+    const char* name;       ///< e.g. "Cs-137"
+    uint8_t isotopeClass;   ///< IsotopeClass
+    uint8_t lines;          ///< Lines inside the calibrated range (0: not evaluated)
+    bool identified;
+    float z;                ///< Significance of the template amplitude
+    float amplitude;        ///< Excess counts in the window, in units of the strongest line
+    float chi2;             ///< Line-ratio mismatch per degree of freedom (0 for one line)
+};
+
+struct IsotopeIdStatus {
+    bool ready;             ///< Regions built and background learned
+    uint8_t alarmLevel;     ///< AlarmLevel of the identified isotopes
+    float windowLiveS;      ///< Live time behind the window sums
+    float backgroundLiveS;  ///< Effective live time of the learned background
+    uint16_t segments;
+    uint32_t passes;
+    uint32_t tableBuilds;
+    uint32_t passUs;        ///< Duration of the last pass
+    uint32_t intervalMs;    ///< Current pass interval (stretched beyond the budget)
+    float cpuPct;           ///< Last pass against its interval
+    IsotopeResult isotopes[ISOTOPE_COUNT];
+};
+
+// Starts the evaluation task on @p spectrum's channels. Call in setup() after
+// initSpectrumAnalysis() (energy calibration).
+bool initIsotopeId(const Spectrum& spectrum);
+
+// pulseTask, for each kept pulse and its channel (Spectrum::channelOf()),
+// whether or not the histogram accumulates.
+void isotopeIdAdd(uint16_t channel);
+
+// pulseTask, once per batch: live time sampled since the last one.
+void isotopeIdAddLiveMs(uint32_t liveMs);
+
+// Alarm level of the identified isotopes (any task, wait-free).
+uint8_t isotopeIdAlarmLevel();
+
+IsotopeIdStatus getIsotopeIdStatus();
+
+// Forgets the background; it is learned again from now on.
+void isotopeIdRelearn();
+
+void printIsotopeId(Print& out);
+
+#endif // ISOTOPE_ID_H
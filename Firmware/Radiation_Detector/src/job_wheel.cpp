@@ -0,0 +1,239 @@
+/**
+ * @file job_wheel.cpp
+ * @brief Hierarchical timer wheel running periodic background jobs on one task.
+ *
+ * Level n holds the jobs due within 64^(n+1) ticks, in the slot of bits
+ * 6n..6n+5 of their deadline; each slot is a list threaded through the job
+ * table. When the tick crosses a level-1 (level-2) slot boundary, that slot's
+ * jobs are filed again against the new tick and land one level finer, so
+ * level 0 always holds exactly the jobs due in the next 64 ticks, one tick
+ * per slot. Adding or rescheduling a job is O(1); advancing skips empty
+ * slots with one bit test. The task's sleep time is the earliest deadline,
+ * taken from the (short) job table rather than from the wheel.
+ */
+
+#include "job_wheel.h"
+#include "debug.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+static const uint8_t LEVELS = 3;
+static const uint8_t SLOT_BITS = 6;
+static const uint32_t SLOT_MASK = (1UL << SLOT_BITS) - 1;
+static const uint32_t SPAN_TICKS = 1UL << (SLOT_BITS * LEVELS); ///< Farthest deadline the wheel holds
+static const int8_t NO_JOB = -1;
+static const uint32_t TASK_STACK = 4096;
+
+struct Entry {
+    JobWheelJob record;
+    JobWheelFn fn;
+    void* arg;
+    uint32_t periodTicks;
+    uint32_t due;           ///< Tick of the next deadline
+    int8_t next;            ///< Next job in the same slot
+};
+
+static Entry jobs[JOB_WHEEL_MAX_JOBS];
+static uint8_t jobCount = 0;
+static int8_t slots[LEVELS][1 << SLOT_BITS];
+static uint64_t occupied[LEVELS];
+static uint32_t currentTick = 0;    ///< Last tick processed
+static SemaphoreHandle_t lock = nullptr;
+static TaskHandle_t taskHandle = nullptr;
+static JobWheelStats stats;
+
+static uint32_t nowTick() {
+    return (uint32_t)(esp_timer_get_time() / (JOB_WHEEL_TICK_MS * 1000LL));
+}
+
+/**
+ * @brief Puts job @p index into the slot of its deadline, relative to currentTick.
+ */
+static void fileJob(int8_t index) {
+    Entry& job = jobs[index];
+    uint32_t at = job.due;
+    uint32_t delta = at - currentTick;
+    if ((int32_t)delta < 0) {
+        at = currentTick;
+        delta = 0;
+    }
+    if (delta >= SPAN_TICKS) {
+        at = currentTick + SPAN_TICKS - 1; // Filed again from level 2 as it comes closer
+        delta = SPAN_TICKS - 1;
+    }
+    uint8_t level = 0;
+    while (level < LEVELS - 1 && delta >= (1UL << (SLOT_BITS * (level + 1)))) level++;
+    uint8_t slot = (at >> (SLOT_BITS * level)) & SLOT_MASK;
+    job.next = slots[level][slot];
+    slots[level][slot] = index;
+    occupied[level] |= 1ULL << slot;
+}
+
+/**
+ * @brief Detaches the list of a slot. @return its first job
+ */
+static int8_t takeSlot(uint8_t level, uint8_t slot) {
+    int8_t head = slots[level][slot];
+    slots[level][slot] = NO_JOB;
+    occupied[level] &= ~(1ULL << slot);
+    return head;
+}
+
+static void cascade(uint8_t level, uint8_t slot) {
+    if (!(occupied[level] & (1ULL << slot))) return;
+    for (int8_t index = takeSlot(level, slot); index != NO_JOB;) {
+        int8_t next = jobs[index].next;
+        fileJob(index);
+        stats.cascades++;
+        index = next;
+    }
+}
+
+/**
+ * @brief Runs one job (lock released meanwhile) and sets its next deadline.
+ */
+static void runJob(int8_t index) {
+    Entry& job = jobs[index];
+    int64_t startUs = esp_timer_get_time();
+    int32_t lateMs = (int32_t)(startUs / 1000 - (int64_t)job.due * JOB_WHEEL_TICK_MS);
+
+    xSemaphoreGive(lock);
+    job.fn(job.arg);
+    uint32_t runUs = (uint32_t)(esp_timer_get_time() - startUs);
+    xSemaphoreTake(lock, portMAX_DELAY);
+
+    JobWheelJob& r = job.record;
+    r.runs++;
+    if (lateMs > 0 && (uint32_t)lateMs > r.maxLateMs) r.maxLateMs = (uint32_t)lateMs;
+    r.lastRunUs = runUs;
+    if (runUs > r.maxRunUs) r.maxRunUs = runUs;
+    r.totalRunUs += runUs;
+
+    // Fixed rate; deadlines already passed are skipped, not caught up
+    job.due += job.periodTicks;
+    uint32_t now = nowTick();
+    if ((int32_t)(job.due - now) <= 0) {
+        uint32_t skipped = (now - job.due) / job.periodTicks + 1;
+        job.due += skipped * job.periodTicks;
+        r.overruns += skipped;
+    }
+    fileJob(index);
+}
+
+/**
+ * @brief Processes every tick up to @p target. Lock held.
+ */
+static void advance(uint32_t target) {
+    while ((int32_t)(target - currentTick) > 0) {
+        uint32_t tick = ++currentTick;
+        if ((tick & ((1UL << (SLOT_BITS * 2)) - 1)) == 0) cascade(2, (tick >> (SLOT_BITS * 2)) & SLOT_MASK);
+        if ((tick & SLOT_MASK) == 0) cascade(1, (tick >> SLOT_BITS) & SLOT_MASK);
+        uint8_t slot = tick & SLOT_MASK;
+        if (!(occupied[0] & (1ULL << slot))) continue;
+        for (int8_t index = takeSlot(0, slot); index != NO_JOB;) {
+            int8_t next = jobs[index].next;
+            if ((int32_t)(jobs[index].due - tick) <= 0) runJob(index);
+            else fileJob(index);
+            index = next;
+        }
+    }
+}
+
+/**
+ * @brief Ticks until the earliest deadline; UINT32_MAX without jobs. Lock held.
+ */
+static uint32_t ticksToNext() {
+    uint32_t wait = UINT32_MAX;
+    uint32_t now = nowTick();
+    for (uint8_t i = 0; i < jobCount; i++) {
+        int32_t delta = (int32_t)(jobs[i].due - now);
+        uint32_t ticks = delta > 0 ? (uint32_t)delta : 0;
+        if (ticks < wait) wait = ticks;
+    }
+    return wait;
+}
+
+static void jobWheelTask(void* parameter) {
+    for (;;) {
+        xSemaphoreTake(lock, portMAX_DELAY);
+        advance(nowTick());
+        uint32_t wait = ticksToNext();
+        xSemaphoreGive(lock);
+        stats.wakeups++;
+        if (wait == 0) continue;
+        TickType_t ticks = wait == UINT32_MAX
+                               ? portMAX_DELAY
+                               : (TickType_t)((wait * JOB_WHEEL_TICK_MS + portTICK_PERIOD_MS - 1) / portTICK_PERIOD_MS);
+        ulTaskNotifyTake(pdTRUE, ticks); // Woken early by jobWheelAdd()
+    }
+}
+
+bool initJobWheel() {
+    if (lock) return taskHandle != nullptr;
+    lock = xSemaphoreCreateMutex();
+    if (!lock) return false;
+    memset(slots, NO_JOB, sizeof(slots));
+    currentTick = nowTick();
+    if (xTaskCreatePinnedToCore(jobWheelTask, "Jobs", TASK_STACK, NULL, tskIDLE_PRIORITY + 1, &taskHandle,
+                                TASK_CORE_NETWORK) != pdPASS) {
+        taskHandle = nullptr;
+        return false;
+    }
+    return true;
+}
+
+bool jobWheelAdd(const char* name, uint32_t periodMs, uint32_t firstDelayMs, JobWheelFn fn, void* arg) {
+    if (!lock || !fn) return false;
+    xSemaphoreTake(lock, portMAX_DELAY);
+    if (jobCount >= JOB_WHEEL_MAX_JOBS) {
+        xSemaphoreGive(lock);
+        DEBUG_PRINTF("Jobs: no room for %s\n", name);
+        return false;
+    }
+    int8_t index = jobCount++;
+    Entry& job = jobs[index];
+    memset(&job, 0, sizeof(job));
+    job.record.name = name;
+    job.record.periodMs = periodMs;
+    job.fn = fn;
+    job.arg = arg;
+    job.periodTicks = (periodMs + JOB_WHEEL_TICK_MS / 2) / JOB_WHEEL_TICK_MS;
+    if (job.periodTicks == 0) job.periodTicks = 1;
+    job.due = nowTick() + firstDelayMs / JOB_WHEEL_TICK_MS;
+    if ((int32_t)(job.due - currentTick) <= 0) job.due = currentTick + 1; // That tick is done
+    fileJob(index);
+    stats.jobs = jobCount;
+    xSemaphoreGive(lock);
+    if (taskHandle) xTaskNotifyGive(taskHandle);
+    return true;
+}
+
+bool getJobWheelJob(uint8_t index, JobWheelJob& out) {
+    if (!lock) return false;
+    xSemaphoreTake(lock, portMAX_DELAY);
+    bool found = index < jobCount;
+    if (found) out = jobs[index].record;
+    xSemaphoreGive(lock);
+    return found;
+}
+
+JobWheelStats getJobWheelStats() {
+    JobWheelStats s = stats;
+    s.running = taskHandle != nullptr;
+    return s;
+}
+
+void printJobWheel(Print& out) {
+    JobWheelStats s = getJobWheelStats();
+    out.printf("Jobs: %s, %u jobs, %lu wakeups, %lu cascades, tick %u ms\n", s.running ? "running" : "not running",
+               (unsigned)s.jobs, (unsigned long)s.wakeups, (unsigned long)s.cascades, (unsigned)JOB_WHEEL_TICK_MS);
+    out.println("Job          Period ms     Runs  Overruns  Late max ms  Run avg us  Run max us");
+    JobWheelJob job;
+    for (uint8_t i = 0; getJobWheelJob(i, job); i++) {
+        out.printf("%-12s %9lu %8lu %9lu %12lu %11lu %11lu\n", job.name, (unsigned long)job.periodMs,
+                   (unsigned long)job.runs, (unsigned long)job.overruns, (unsigned long)job.maxLateMs,
+                   (unsigned long)(job.runs ? job.totalRunUs / job.runs : 0), (unsigned long)job.maxRunUs);
+    }
+}
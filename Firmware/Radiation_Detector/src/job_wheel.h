@@ -0,0 +1,60 @@
+#ifndef JOB_WHEEL_H
+#define JOB_WHEEL_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Periodic background jobs on one task ("jobs"). Slow, low-priority work that
+// used to own a task each (battery sampling, dose checkpoints, the sysinfo
+// sampler) registers here instead: one stack instead of several, one wakeup
+// per deadline instead of one per task, and one table that shows what runs
+// how often, how late and for how long.
+//
+// Deadlines live in a hierarchical timer wheel of JOB_WHEEL_TICK_MS ticks:
+// three levels of 64 slots span 64 ticks, 4096 ticks and 262144 ticks (43
+// minutes at 10 ms); a job further out waits in the last level and is filed
+// again as it comes closer. Jobs are fixed-rate: the next deadline is the
+// last one plus the period, so they do not drift. A job that runs past one or
+// more of its next deadlines skips them and counts an overrun. The task sleeps
+// until the earliest deadline. Jobs run one after another at idle+1 on
+// TASK_CORE_NETWORK and may block briefly (NVS, ADC), which delays the others;
+// the table shows by how much. Not for LVGL work, which stays on uiTask.
+
+static const uint8_t JOB_WHEEL_MAX_JOBS = 16;
+
+typedef void (*JobWheelFn)(void* arg);
+
+struct JobWheelJob {
+    const char* name;
+    uint32_t periodMs;
+    uint32_t runs;
+    uint32_t overruns;         ///< Deadlines skipped because the job was still busy or late
+    uint32_t maxLateMs;        ///< Start after the deadline, worst case
+    uint32_t lastRunUs;
+    uint32_t maxRunUs;
+    uint64_t totalRunUs;
+};
+
+struct JobWheelStats {
+    bool running;
+    uint8_t jobs;
+    uint32_t wakeups;
+    uint32_t cascades;         ///< Jobs filed down to a finer level
+};
+
+// Starts the task. Call once in setup(), before the modules that add jobs.
+bool initJobWheel();
+
+// Runs @p fn every @p periodMs (rounded to ticks), the first time after
+// @p firstDelayMs. @p name must stay valid. @return false if the table is full
+bool jobWheelAdd(const char* name, uint32_t periodMs, uint32_t firstDelayMs, JobWheelFn fn, void* arg);
+
+// Copy of job @p index's record. @return false past the last job
+bool getJobWheelJob(uint8_t index, JobWheelJob& out);
+
+JobWheelStats getJobWheelStats();
+
+// Table of the jobs ("jobs" serial command).
+void printJobWheel(Print& out);
+
+#endif // JOB_WHEEL_H
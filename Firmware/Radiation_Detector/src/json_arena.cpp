@@ -0,0 +1,51 @@
+/**
+ * @file json_arena.cpp
+ * @brief The shared JsonDocument arena and its leases.
+ *
+ * Documents are built for the web task's responses and live events, the
+ * fleet manifest and serial bench reports; only the web task builds them
+ * continuously. One arena sized for the largest of them (/api/sysinfo) keeps
+ * that polling off the heap. The rare overlap with another task falls back
+ * to the heap rather than waiting for the arena.
+ */
+
+#include "json_arena.h"
+#include "config.h"
+#include <atomic>
+
+static JsonArena<JSON_ARENA_BYTES> arena;
+static std::atomic<bool> arenaTaken(false);
+static std::atomic<uint32_t> leases(0);
+static std::atomic<uint32_t> fallbacks(0);
+
+JsonArenaLease::JsonArenaLease() {
+    leases++;
+    shared_ = !arenaTaken.exchange(true);
+    if (shared_) {
+        arena.reset();
+        allocator_ = &arena;
+    } else {
+        fallbacks++;
+        allocator_ = ArduinoJson::detail::DefaultAllocator::instance();
+    }
+}
+
+JsonArenaLease::~JsonArenaLease() {
+    if (shared_) arenaTaken.store(false);
+}
+
+JsonArenaStats getJsonArenaStats() {
+    JsonArenaStats s;
+    s.leases = leases.load();
+    s.fallbacks = fallbacks.load();
+    s.failures = arena.failures();
+    s.peakBytes = arena.peak();
+    return s;
+}
+
+void printJsonArena(Print& out) {
+    JsonArenaStats s = getJsonArenaStats();
+    out.printf("JSON arena: %lu documents, %lu on the heap, %lu refused allocations, peak %lu of %u bytes\n",
+               (unsigned long)s.leases, (unsigned long)s.fallbacks, (unsigned long)s.failures,
+               (unsigned long)s.peakBytes, (unsigned)JSON_ARENA_BYTES);
+}
@@ -0,0 +1,159 @@
+#ifndef JSON_ARENA_H
+#define JSON_ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <ArduinoJson.h>
+
+class Print;
+
+/**
+ * @brief ArduinoJson allocator backed by a fixed, statically allocated arena.
+ *
+ * Allocation bumps a pointer, so a JsonDocument built on it never touches the
+ * heap. Only the most recent block can be freed or grown in place (which is
+ * what ArduinoJson does when it shrinks its last pool); anything else is freed
+ * all at once by reset() before the next document is built. When the arena is
+ * exhausted allocate() returns nullptr and the document reports overflowed().
+ * Each block carries its size in a header word, so an older block is shrunk
+ * in place and moved with only its own bytes: ArduinoJson relies on a shrink
+ * never failing (it saves a key whose pool slot was allocated after it that
+ * way), which a full arena must not break.
+ *
+ * Not thread-safe: one arena per task that builds documents. No Arduino
+ * dependencies (host-compilable).
+ *
+ * @tparam N Arena size in bytes
+ */
+template <size_t N>
+class JsonArena : public ArduinoJson::Allocator {
+public:
+    JsonArena() : used_(0), peak_(0), failures_(0), last_(nullptr) {}
+
+    /// Releases every block. Call before building a new document.
+    void reset() {
+        used_ = 0;
+        last_ = nullptr;
+    }
+
+    /// Bytes currently handed out.
+    size_t used() const { return used_; }
+
+    /// Highest usage seen since boot, for sizing N.
+    size_t peak() const { return peak_; }
+
+    /// Allocations refused because the arena was full, since boot.
+    uint32_t failures() const { return failures_; }
+
+    void* allocate(size_t size) override {
+        size = align(size);
+        if (size > N - used_ || HEADER > N - used_ - size) {
+            failures_++;
+            return nullptr;
+        }
+        uint8_t* block = buffer_ + used_ + HEADER;
+        setBlockSize(block, size);
+        used_ += HEADER + size;
+        if (used_ > peak_) peak_ = used_;
+        last_ = block;
+        return block;
+    }
+
+    void deallocate(void* ptr) override {
+        // Only the newest block can be returned; the rest goes on reset()
+        if (ptr && ptr == last_) {
+            used_ = (uint8_t*)ptr - HEADER - buffer_;
+            last_ = nullptr;
+        }
+    }
+
+    void* reallocate(void* ptr, size_t newSize) override {
+        if (!ptr) return allocate(newSize);
+
+        size_t size = align(newSize);
+        if (ptr == last_) {
+            size_t offset = (uint8_t*)ptr - buffer_;
+            if (size > N - offset) {
+                failures_++;
+                return nullptr;
+            }
+            setBlockSize(ptr, size);
+            used_ = offset + size;
+            if (used_ > peak_) peak_ = used_;
+            return ptr;
+        }
+
+        // Older block: shrinks keep their place, growth moves the block to the top
+        size_t oldSize = blockSize(ptr);
+        if (size <= oldSize) return ptr;
+        void* moved = allocate(newSize);
+        if (moved) memcpy(moved, ptr, oldSize);
+        return moved;
+    }
+
+private:
+    static const size_t HEADER = 8; ///< Block size, keeping blocks 8-byte aligned
+
+    static size_t align(size_t size) { return (size + 7) & ~(size_t)7; }
+
+    static size_t blockSize(const void* block) {
+        uint32_t size;
+        memcpy(&size, (const uint8_t*)block - HEADER, sizeof(size));
+        return size;
+    }
+
+    static void setBlockSize(void* block, size_t size) {
+        uint32_t value = (uint32_t)size;
+        memcpy((uint8_t*)block - HEADER, &value, sizeof(value));
+    }
+
+    alignas(8) uint8_t buffer_[N];
+    size_t used_;
+    size_t peak_;
+    uint32_t failures_;
+    void* last_;
+};
+
+/**
+ * @brief Lends the shared document arena (JSON_ARENA_BYTES) for one document.
+ *
+ * Every JsonDocument the firmware builds for output or from a response is
+ * constructed on a lease, declared before the document so the document goes
+ * first:
+ *
+ *   JsonArenaLease lease;
+ *   JsonDocument doc(lease.allocator());
+ *
+ * The lease resets the arena. While it is held, another lease (a second task,
+ * or a nested document) gets the heap allocator instead and is counted as a
+ * fallback, so a live document is never reset under its owner.
+ */
+class JsonArenaLease {
+public:
+    JsonArenaLease();
+    ~JsonArenaLease();
+
+    JsonArenaLease(const JsonArenaLease&) = delete;
+    JsonArenaLease& operator=(const JsonArenaLease&) = delete;
+
+    ArduinoJson::Allocator* allocator() const { return allocator_; }
+
+private:
+    ArduinoJson::Allocator* allocator_;
+    bool shared_;
+};
+
+struct JsonArenaStats {
+    uint32_t leases;
+    uint32_t fallbacks;   ///< Arena busy, document built on the heap
+    uint32_t failures;    ///< Allocations refused (document overflowed)
+    uint32_t peakBytes;
+};
+
+JsonArenaStats getJsonArenaStats();
+
+// One line: leases, heap fallbacks, refused allocations and the peak ("perf").
+void printJsonArena(Print& out);
+
+#endif // JSON_ARENA_H
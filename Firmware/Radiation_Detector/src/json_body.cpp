@@ -0,0 +1,118 @@
+/**
+ * @file json_body.cpp
+ * @brief Raw-chunk JSON body reception into a fixed buffer and a filtered arena document.
+ *
+ * WebServer reads a non-form POST body whole into a String sized by
+ * Content-Length (a heap block as large as whatever the client claims),
+ * unless the route's handler accepts raw bodies (RequestHandler::canRaw()):
+ * then it hands the body over in HTTP_RAW_BUFLEN chunks (HTTPRaw) as it reads
+ * them. The chunks are copied into the receive buffer, which is allocated
+ * once, in PSRAM if present.
+ *
+ * ArduinoJson 7 dropped the zero-copy (char* input) mode, so the strings
+ * that pass the filter are copied into the document. The document lives in
+ * a JsonArena and holds only the filtered fields.
+ */
+
+#include "json_body.h"
+#include "json_arena.h"
+#include "esp_heap_caps.h"
+
+static JsonBodyReceiver receiver;   ///< JSON_BODY_MAX_BYTES, shared by the routes
+static JsonArena<JSON_BODY_DOC_BYTES> arena;
+static JsonBodyStats stats;
+static uint8_t routeCount = 0;
+
+static void reject(WebServer& server, int code, const char* message) {
+    stats.rejected++;
+    server.send(code, "text/plain", message);
+}
+
+/**
+ * @brief POST or PUT route that takes raw bodies only; multipart uploads are not accepted
+ *        (canUpload() stays false), so WebServer never reads those into the route.
+ */
+class JsonBodyRoute : public RequestHandler {
+public:
+    JsonBodyRoute(const char* uri, HTTPMethod method, JsonDocument* filter, JsonBodyHandler handler)
+        : uri_(uri), method_(method), filter_(filter), handler_(handler) {}
+
+    bool canHandle(HTTPMethod method, String uri) override { return method == method_ && uri == uri_; }
+
+    bool canRaw(String uri) override { return uri == uri_; }
+
+    void raw(WebServer& server, String uri, HTTPRaw& raw) override {
+        if (raw.status == RAW_START) {
+            receiver.start();
+        } else if (raw.status == RAW_WRITE) {
+            receiver.write(raw.buf, raw.currentSize); // WebServer keeps draining the socket past the limit
+        } else if (raw.status == RAW_ABORTED) {
+            receiver.abort();
+        }
+    }
+
+    bool handle(WebServer& server, HTTPMethod method, String uri) override {
+        if (!canHandle(method, uri)) return false;
+        stats.requests++;
+        server.sendHeader("Access-Control-Allow-Origin", "*");
+        const char* body;
+        size_t bodyLength;
+        if (!receiver.take(&body, &bodyLength)) {
+            reject(server, 413, "Body too large");
+            return true;
+        }
+        if (bodyLength > stats.peakBodyBytes) stats.peakBodyBytes = bodyLength;
+
+        arena.reset();
+        JsonDocument doc(&arena);
+        JsonBodyResult result = jsonBodyParse(doc, body, bodyLength, filter_);
+        if (result.status != 200) {
+            reject(server, result.status, result.message);
+            return true;
+        }
+        if (arena.used() > stats.peakDocBytes) stats.peakDocBytes = arena.used();
+        handler_(server, doc.as<JsonVariantConst>());
+        return true;
+    }
+
+private:
+    String uri_;
+    HTTPMethod method_;
+    JsonDocument* filter_;   ///< nullptr: keep everything
+    JsonBodyHandler handler_;
+};
+
+bool jsonBodyOn(WebServer& server, const char* uri, const char* filterJson, JsonBodyHandler handler,
+                HTTPMethod method) {
+    if (routeCount >= JSON_BODY_MAX_ROUTES || !handler) return false;
+    if (!receiver.attached()) {
+        char* buffer = (char*)heap_caps_malloc(JSON_BODY_MAX_BYTES, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        if (!buffer) buffer = (char*)heap_caps_malloc(JSON_BODY_MAX_BYTES, MALLOC_CAP_8BIT);
+        if (!buffer) return false;
+        receiver.attach(buffer, JSON_BODY_MAX_BYTES);
+    }
+
+    // Filter and route are built once at registration, the only heap use of a route
+    JsonDocument* filter = nullptr;
+    if (filterJson) {
+        filter = new JsonDocument();
+        if (deserializeJson(*filter, filterJson)) {
+            delete filter;
+            return false;
+        }
+    }
+    server.addHandler(new JsonBodyRoute(uri, method, filter, handler));
+    routeCount++;
+    return true;
+}
+
+JsonBodyStats getJsonBodyStats() {
+    return stats;
+}
+
+void printJsonBody(Print& out) {
+    JsonBodyStats s = getJsonBodyStats();
+    out.printf("JSON bodies: %lu requests, %lu rejected, largest %lu of %u bytes, document %lu of %u bytes\n",
+               (unsigned long)s.requests, (unsigned long)s.rejected, (unsigned long)s.peakBodyBytes,
+               (unsigned)JSON_BODY_MAX_BYTES, (unsigned long)s.peakDocBytes, (unsigned)JSON_BODY_DOC_BYTES);
+}
@@ -0,0 +1,41 @@
+#ifndef JSON_BODY_H
+#define JSON_BODY_H
+
+#include <Arduino.h>
+#include <WebServer.h>
+#include <ArduinoJson.h>
+#include "config.h"
+#include "json_body_parse.h"
+
+// JSON request bodies (config, calibration, alarm rules pushed by the
+// provisioning tool) without the String copy WebServer makes of "plain"
+// bodies. A route registered here takes the body as raw chunks from the
+// client socket into one fixed receive buffer, then parses it with a filter
+// into a JsonDocument on a static arena, so a request makes no heap
+// allocation whatever its size. Only the fields named in the filter are kept.
+// A body over JSON_BODY_MAX_BYTES is refused with 413 before it is parsed.
+// Web task only: the buffer and the arena are shared by all routes.
+
+// Called with the filtered body; null for a request without one (query
+// arguments only). The variant is valid until the handler returns.
+typedef void (*JsonBodyHandler)(WebServer& server, JsonVariantConst body);
+
+struct JsonBodyStats {
+    uint32_t requests;
+    uint32_t rejected;      ///< Too large, not JSON, or over the document arena
+    uint32_t peakBodyBytes;
+    uint32_t peakDocBytes;  ///< Arena used by the largest parsed document
+};
+
+// Registers @p method (POST or PUT) @p uri. @p filterJson lists the fields to
+// keep as ArduinoJson filter JSON (e.g. {"action":true}); nullptr keeps everything.
+// @return false if the filter does not parse or the buffer cannot be allocated
+bool jsonBodyOn(WebServer& server, const char* uri, const char* filterJson, JsonBodyHandler handler,
+                HTTPMethod method = HTTP_POST);
+
+JsonBodyStats getJsonBodyStats();
+
+// One line: requests, rejects and the peak sizes against the limits ("perf").
+void printJsonBody(Print& out);
+
+#endif // JSON_BODY_H
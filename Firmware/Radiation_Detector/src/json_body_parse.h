@@ -0,0 +1,95 @@
+#ifndef JSON_BODY_PARSE_H
+#define JSON_BODY_PARSE_H
+
+#include <stddef.h>
+#include <string.h>
+#include <ArduinoJson.h>
+
+// The request-dependent half of json_body.h: collecting the raw chunks of a
+// body into the fixed receive buffer and parsing it into a filtered document,
+// with every failure mapped to the status the route answers with. Kept apart
+// from the WebServer glue so tools/http_fuzz.cpp runs this code on the host.
+// No Arduino dependencies (host-compilable).
+
+// Filter of the command routes (/api/anomaly, /api/plateau, /api/tube)
+#define JSON_BODY_ACTION_FILTER "{\"action\":true}"
+
+struct JsonBodyResult {
+    int status;           ///< 200: parsed, or no body; otherwise answer with status and message
+    const char* message;
+};
+
+/**
+ * @brief Collects a body arriving in chunks into one fixed buffer.
+ *
+ * A body larger than the buffer is not stored any further and is refused by
+ * take(), however much the client keeps sending.
+ */
+class JsonBodyReceiver {
+public:
+    JsonBodyReceiver() : buffer_(nullptr), capacity_(0), length_(0), overflow_(false) {}
+
+    void attach(char* buffer, size_t capacity) {
+        buffer_ = buffer;
+        capacity_ = capacity;
+        start();
+    }
+
+    bool attached() const { return buffer_ != nullptr; }
+
+    void start() {
+        length_ = 0;
+        overflow_ = false;
+    }
+
+    void write(const void* data, size_t size) {
+        if (overflow_ || size > capacity_ - length_) {
+            overflow_ = true;
+            return;
+        }
+        memcpy(buffer_ + length_, data, size);
+        length_ += size;
+    }
+
+    /// The client went away mid-body.
+    void abort() { overflow_ = true; }
+
+    /// Hands out the body and starts empty for the next request, which may
+    /// have no body at all. @return false if the body did not fit
+    bool take(const char** body, size_t* length) {
+        bool complete = !overflow_;
+        *body = buffer_;
+        *length = complete ? length_ : 0;
+        start();
+        return complete;
+    }
+
+private:
+    char* buffer_;
+    size_t capacity_;
+    size_t length_;
+    bool overflow_;
+};
+
+/**
+ * @brief Parses @p body into @p doc, keeping only what @p filter names
+ *        (nullptr keeps everything). An empty body leaves @p doc null.
+ */
+static inline JsonBodyResult jsonBodyParse(JsonDocument& doc, const char* body, size_t length,
+                                           const JsonDocument* filter) {
+    JsonBodyResult result = {200, nullptr};
+    if (length == 0) return result;
+    DeserializationError error = filter
+        ? deserializeJson(doc, body, length, DeserializationOption::Filter(*filter))
+        : deserializeJson(doc, body, length);
+    if (error == DeserializationError::NoMemory || doc.overflowed()) {
+        result.status = 413;
+        result.message = "Too many fields";
+    } else if (error) {
+        result.status = 400;
+        result.message = error.c_str();
+    }
+    return result;
+}
+
+#endif // JSON_BODY_PARSE_H
@@ -0,0 +1,84 @@
+#ifndef LABEL_BINDING_H
+#define LABEL_BINDING_H
+
+#include <lvgl.h>
+#include <math.h>
+#include <string.h>
+#include "fixed_format.h"
+
+// Change-detecting binding between a numeric value and an LVGL label.
+// The value is rounded to the displayed precision first; the label is only
+// reformatted and invalidated when that rounded value differs from what is on
+// screen, and at most once per minIntervalMs. A change that arrives inside the
+// interval is kept and applied by the first update() after it expires.
+// An optional prefix and unit frame the number (e.g. "+/- ", " V"). The text
+// is formatted into the binding's own buffer and handed to
+// lv_label_set_text_static() unless attach() names another setter, so the
+// label points at that buffer instead of copying it into a fresh LVGL
+// allocation on every change; the setter's invalidate is the only redraw.
+// Bindings live as long as the labels they are attached to (statics).
+
+class LabelBinding {
+public:
+    // Receives the binding's buffer, which stays valid until the next update()
+    typedef void (*SetText)(lv_obj_t* label, const char* text);
+
+    static const size_t TEXT_SIZE = 32;
+
+    LabelBinding(uint8_t decimals, uint32_t minIntervalMs, const char* unit = "", const char* prefix = "")
+        : label_(nullptr), setText_(lv_label_set_text_static), decimals_(decimals), minIntervalMs_(minIntervalMs),
+          unit_(unit), prefix_(prefix), shown_(0), hasShown_(false), lastUpdateMs_(0) {
+        scale_ = 1.0f;
+        for (uint8_t i = 0; i < decimals; i++) scale_ *= 10.0f;
+        text_[0] = '\0';
+    }
+
+    void attach(lv_obj_t* label, SetText setText = lv_label_set_text_static) {
+        label_ = label;
+        setText_ = setText;
+        hasShown_ = false;
+    }
+
+    /// Forces the next update() to redraw (e.g. after the label was recreated).
+    void invalidate() { hasShown_ = false; }
+
+    /**
+     * @brief Shows @p value if its rounded form changed and the rate limit allows.
+     * @return true if the label text was set
+     */
+    bool update(float value, uint32_t nowMs) {
+        if (!label_) return false;
+
+        long rounded = lroundf(value * scale_);
+        if (hasShown_) {
+            if (rounded == shown_) return false;
+            if (nowMs - lastUpdateMs_ < minIntervalMs_) return false;
+        }
+
+        // The rounded value is printed as is; no float formatting per update
+        size_t length = strlcpy(text_, prefix_, sizeof(text_));
+        if (length >= sizeof(text_)) length = sizeof(text_) - 1;
+        length += formatScaled(text_ + length, sizeof(text_) - length, rounded, decimals_);
+        if (length < sizeof(text_)) strlcpy(text_ + length, unit_, sizeof(text_) - length);
+        setText_(label_, text_);
+        shown_ = rounded;
+        hasShown_ = true;
+        lastUpdateMs_ = nowMs;
+        return true;
+    }
+
+private:
+    lv_obj_t* label_;
+    SetText setText_;
+    uint8_t decimals_;
+    uint32_t minIntervalMs_;
+    const char* unit_;
+    const char* prefix_;
+    char text_[TEXT_SIZE];  ///< Shown by the label (static text)
+    float scale_;
+    long shown_;
+    bool hasShown_;
+    uint32_t lastUpdateMs_;
+};
+
+#endif // LABEL_BINDING_H
@@ -0,0 +1,63 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <stdint.h>
+
+// Log2 histogram of microsecond latencies: bucket b holds values below
+// 2^(b+1) us (bucket 0 also 0 and 1), the last bucket everything above.
+// LatencyHistogram (20 buckets, up to ~1 s) is the pulse path's; longer
+// chains such as pulse-to-alarm (latency_probe.h) take more buckets.
+// One writer; readers on other tasks may see a count mid-update, which only
+// shifts a percentile by one sample. No Arduino dependencies (host-compilable).
+
+template <uint8_t N>
+class LatencyHistogramN {
+public:
+    static const uint8_t BUCKETS = N;    ///< Up to 2^N us resolved
+
+    LatencyHistogramN() { reset(); }
+
+    void reset() {
+        for (uint8_t b = 0; b < BUCKETS; b++) buckets_[b] = 0;
+        count_ = 0;
+        max_ = 0;
+        totalUs_ = 0;
+    }
+
+    void add(uint32_t us) {
+        uint8_t bucket = 31 - __builtin_clz(us | 1);
+        if (bucket >= BUCKETS) bucket = BUCKETS - 1;
+        buckets_[bucket]++;
+        count_++;
+        totalUs_ += us;
+        if (us > max_) max_ = us;
+    }
+
+    /// Upper bound of the bucket holding the @p permille-th value (500: median).
+    uint32_t percentileUs(uint16_t permille) const {
+        if (!count_) return 0;
+        uint64_t rank = (uint64_t)count_ * permille / 1000;
+        uint64_t seen = 0;
+        for (uint8_t b = 0; b < BUCKETS; b++) {
+            seen += buckets_[b];
+            if (seen > rank) return b == BUCKETS - 1 ? max_ : (2u << b);
+        }
+        return max_;
+    }
+
+    uint32_t bucket(uint8_t b) const { return buckets_[b]; }
+    uint32_t count() const { return count_; }
+    uint32_t maxUs() const { return max_; }
+    uint32_t meanUs() const { return count_ ? (uint32_t)(totalUs_ / count_) : 0; }
+    uint64_t totalUs() const { return totalUs_; }
+
+private:
+    uint32_t buckets_[BUCKETS];
+    uint32_t count_;
+    uint32_t max_;
+    uint64_t totalUs_;
+};
+
+typedef LatencyHistogramN<20> LatencyHistogram;
+
+#endif // LATENCY_HISTOGRAM_H
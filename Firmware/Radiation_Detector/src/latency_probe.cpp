@@ -0,0 +1,373 @@
+/**
+ * @file latency_probe.cpp
+ * @brief Traces injected pulse trains to the dose-rate label, its flush and the alarm tone.
+ *
+ * The open trace is shared by the injector task (start), uiTask (label,
+ * flush) and pulseTask (alarm) under one spinlock; the probes read the open
+ * flag first and take the lock only while a trace is open. Each histogram is
+ * added to under the lock as well, so a reset cannot tear one.
+ */
+
+#include "latency_probe.h"
+#include "alarm_rules.h"
+#include "alarm_sequencer.h"
+#include "debug.h"
+#include "device_config.h"
+#include "pulse_injector.h"
+#include "seqlock.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+static const uint8_t PROBE_BIT_LABEL = 1 << LATENCY_PROBE_LABEL;
+static const uint8_t PROBE_BIT_FLUSH = 1 << LATENCY_PROBE_FLUSH;
+static const uint8_t PROBE_BIT_ALARM = 1 << LATENCY_PROBE_ALARM;
+/// Probes every trace waits for besides the alarm
+static const uint8_t PROBE_BITS_DISPLAY = HEADLESS ? 0 : PROBE_BIT_LABEL | PROBE_BIT_FLUSH;
+static const uint32_t POLL_MS = 50;
+static const char* const PROBE_NAMES[LATENCY_PROBE_COUNT] = {"label", "flush", "alarm"};
+
+struct Trace {
+    uint32_t startUs;
+    uint32_t counts;           ///< Total counts when the train started
+    uint8_t pending;           ///< Probes still to close
+#if !HEADLESS
+    lv_obj_t* label;           ///< Set by the label probe, for the flush probe
+#endif
+    LatencyProbeTrial trial;
+};
+
+static portMUX_TYPE traceLock = portMUX_INITIALIZER_UNLOCKED;
+static volatile bool traceOpen = false;
+static Trace trace;
+static LatencyProbeStats stats;
+static LatencyProbeHistogram histograms[LATENCY_PROBE_COUNT];
+static LatencyProbeCounts readCounts = nullptr;
+
+static volatile bool benchRunning = false;
+static volatile bool benchStop = false;
+static SeqLock<LatencyProbeReport> reportLock;
+static LatencyProbeReport report;          ///< Bench task while it runs
+
+static uint32_t nowUs() {
+    return (uint32_t)esp_timer_get_time();
+}
+
+/**
+ * @brief Closes @p probe of the open trace at @p us. traceLock held.
+ */
+static void closeProbe(LatencyProbeId probe, uint32_t us) {
+    uint32_t latency = us - trace.startUs;
+    trace.trial.us[probe] = latency;
+    trace.trial.seen |= 1 << probe;
+    trace.pending &= ~(1 << probe);
+    histograms[probe].add(latency);
+    if (trace.pending == 0) {
+        traceOpen = false;
+        stats.complete++;
+    }
+}
+
+/**
+ * @brief Ends the open trace if it is older than LATENCY_TRACE_TIMEOUT_MS. traceLock held.
+ */
+static void expireTrace(uint32_t us) {
+    if (traceOpen && us - trace.startUs >= LATENCY_TRACE_TIMEOUT_MS * 1000UL) {
+        traceOpen = false;
+        stats.expired++;
+    }
+}
+
+/**
+ * @brief Injector task, as a train starts.
+ */
+static void traceStart(uint32_t firstPulseUs) {
+    uint32_t counts = 0;
+    uint32_t seconds = 0;
+    if (readCounts) readCounts(&counts, &seconds);
+    bool alarm = getDeviceConfig().alarmEnabled && alarmSoundingLevel() == ALARM_LEVEL_NONE;
+
+    portENTER_CRITICAL(&traceLock);
+    expireTrace(nowUs());
+    if (traceOpen) {
+        stats.skipped++;
+    } else {
+        memset(&trace, 0, sizeof(trace));
+        trace.startUs = firstPulseUs;
+        trace.counts = counts;
+        trace.pending = PROBE_BITS_DISPLAY | (alarm ? PROBE_BIT_ALARM : 0);
+        trace.trial.traced = trace.pending;
+        stats.traces++;
+        traceOpen = true;
+    }
+    portEXIT_CRITICAL(&traceLock);
+}
+
+void initLatencyProbe(LatencyProbeCounts counts) {
+    readCounts = counts;
+    pulseInjectSetStartHook(traceStart);
+}
+
+#if !HEADLESS
+void latencyProbeLabel(lv_obj_t* label, uint32_t totalCounts) {
+    if (!traceOpen) return;
+    uint32_t us = nowUs();
+    portENTER_CRITICAL(&traceLock);
+    if (traceOpen && (trace.pending & PROBE_BIT_LABEL) && totalCounts > trace.counts) {
+        trace.label = label;
+        closeProbe(LATENCY_PROBE_LABEL, us);
+    }
+    portEXIT_CRITICAL(&traceLock);
+}
+
+void latencyProbeFlush(const lv_area_t* area) {
+    if (!traceOpen) return;
+    uint32_t us = nowUs();
+    lv_obj_t* label = nullptr;
+    portENTER_CRITICAL(&traceLock);
+    if (traceOpen && (trace.pending & (PROBE_BIT_LABEL | PROBE_BIT_FLUSH)) == PROBE_BIT_FLUSH) label = trace.label;
+    portEXIT_CRITICAL(&traceLock);
+    if (!label) return;
+
+    // uiTask, as the label probe: the object is still there
+    lv_area_t coords;
+    lv_obj_get_coords(label, &coords);
+    if (!_lv_area_is_on(area, &coords)) return;
+    portENTER_CRITICAL(&traceLock);
+    if (traceOpen && (trace.pending & PROBE_BIT_FLUSH)) closeProbe(LATENCY_PROBE_FLUSH, us);
+    portEXIT_CRITICAL(&traceLock);
+}
+#endif
+
+void latencyProbeAlarm() {
+    if (!traceOpen) return;
+    uint32_t us = nowUs();
+    portENTER_CRITICAL(&traceLock);
+    if (traceOpen && (trace.pending & PROBE_BIT_ALARM)) closeProbe(LATENCY_PROBE_ALARM, us);
+    portEXIT_CRITICAL(&traceLock);
+}
+
+/**
+ * @brief Waits @p ms in steps, @return false if the bench was stopped meanwhile.
+ */
+static bool benchWait(uint32_t ms) {
+    for (uint32_t waited = 0; waited < ms; waited += POLL_MS) {
+        if (benchStop) return false;
+        vTaskDelay(pdMS_TO_TICKS(POLL_MS));
+    }
+    return !benchStop;
+}
+
+/**
+ * @brief One trial: waits for quiet, injects until the trace closes or expires.
+ */
+static bool runTrial(LatencyProbeTrial& result) {
+    uint32_t quietSince = millis();
+    while (millis() - quietSince < LATENCY_BENCH_SETTLE_MS) {
+        if (alarmSoundingLevel() != ALARM_LEVEL_NONE || pulseInjectRunning() || traceOpen) quietSince = millis();
+        if (!benchWait(POLL_MS)) return false;
+    }
+
+    uint32_t tracesBefore = getLatencyProbeStats().traces;
+    PulsePatternParams params;
+    memset(&params, 0, sizeof(params));
+    params.type = PULSE_PATTERN_FIXED;
+    params.rate = report.rateHz;
+    if (!pulseInjectStart(params, LATENCY_TRACE_TIMEOUT_MS / 1000 + 1)) return false;
+
+    // The injector counts the background first, then the train opens the trace
+    uint32_t startMs = millis();
+    bool started = false;
+    bool done = false;
+    while (!done) {
+        if (!benchWait(POLL_MS)) break;
+        LatencyProbeStats s = getLatencyProbeStats();
+        started = s.traces != tracesBefore;
+        done = (started && !s.open) || (!started && !pulseInjectRunning()) ||
+               millis() - startMs >= LATENCY_TRACE_TIMEOUT_MS + 10000UL;
+    }
+    pulseInjectStop();
+
+    portENTER_CRITICAL(&traceLock);
+    if (traceOpen) {
+        traceOpen = false;
+        stats.expired++;
+    }
+    if (started) result = trace.trial;
+    portEXIT_CRITICAL(&traceLock);
+    if (!started) result.traced = PROBE_BITS_DISPLAY | PROBE_BIT_ALARM; // All missed
+    return !benchStop;
+}
+
+static void latencyBenchTask(void* parameter) {
+    DEBUG_PRINTF("Latency bench: %u trials at %.1f Hz\n", report.trials, report.rateHz);
+    while (report.count < report.trials) {
+        LatencyProbeTrial result;
+        memset(&result, 0, sizeof(result));
+        if (!runTrial(result)) break;
+        report.results[report.count++] = result;
+        reportLock.publish(report);
+    }
+    while (pulseInjectRunning()) vTaskDelay(pdMS_TO_TICKS(POLL_MS));
+    report.running = false;
+    reportLock.publish(report);
+    benchRunning = false;
+    DEBUG_PRINTLN("Latency bench: done (\"latency e2e\" prints the report)");
+    vTaskDelete(NULL);
+}
+
+bool latencyProbeStartBench(uint8_t trials) {
+    DeviceConfig config = getDeviceConfig();
+    float thresholdCpm = config.currentAlarmUsvH() * config.cpmPerUsvH;
+    if (benchRunning || pulseInjectRunning() || !config.alarmEnabled || thresholdCpm <= 0.0f) return false;
+    if (trials == 0) trials = 1;
+    if (trials > LATENCY_BENCH_MAX_TRIALS) trials = LATENCY_BENCH_MAX_TRIALS;
+
+    benchRunning = true;
+    benchStop = false;
+    memset(&report, 0, sizeof(report));
+    report.running = true;
+    report.trials = trials;
+    report.thresholdUsvH = config.currentAlarmUsvH();
+    report.rateHz = LATENCY_BENCH_RATE_FACTOR * thresholdCpm / 60.0f;
+    reportLock.publish(report);
+
+    if (xTaskCreatePinnedToCore(latencyBenchTask, "LatencyBench", 3072, NULL, tskIDLE_PRIORITY + 1, NULL,
+                                TASK_CORE_NETWORK) != pdPASS) {
+        report.running = false;
+        reportLock.publish(report);
+        benchRunning = false;
+        return false;
+    }
+    return true;
+}
+
+void latencyProbeStopBench() {
+    if (benchRunning) benchStop = true;
+}
+
+bool latencyProbeReset() {
+    if (benchRunning) return false;
+    portENTER_CRITICAL(&traceLock);
+    bool idle = !traceOpen;
+    if (idle) {
+        for (uint8_t p = 0; p < LATENCY_PROBE_COUNT; p++) histograms[p].reset();
+        memset(&stats, 0, sizeof(stats));
+    }
+    portEXIT_CRITICAL(&traceLock);
+    return idle;
+}
+
+LatencyProbeStats getLatencyProbeStats() {
+    portENTER_CRITICAL(&traceLock);
+    LatencyProbeStats s = stats;
+    s.open = traceOpen;
+    portEXIT_CRITICAL(&traceLock);
+    return s;
+}
+
+const LatencyProbeHistogram& latencyProbeHistogram(LatencyProbeId probe) {
+    return histograms[probe];
+}
+
+LatencyProbeReport getLatencyProbeReport() {
+    LatencyProbeReport copy;
+    reportLock.read(copy);
+    return copy;
+}
+
+/**
+ * @brief Worst latency of @p probe over the bench trials; UINT32_MAX if a trial missed it.
+ */
+static uint32_t worstTrial(const LatencyProbeReport& r, LatencyProbeId probe) {
+    uint32_t worst = 0;
+    for (uint8_t i = 0; i < r.count; i++) {
+        if (!(r.results[i].seen & (1 << probe))) return UINT32_MAX;
+        if (r.results[i].us[probe] > worst) worst = r.results[i].us[probe];
+    }
+    return worst;
+}
+
+static bool benchPassed(const LatencyProbeReport& r) {
+    return r.count == r.trials && r.count > 0 &&
+           worstTrial(r, LATENCY_PROBE_ALARM) <= LATENCY_ALARM_LIMIT_MS * 1000UL &&
+           (HEADLESS || worstTrial(r, LATENCY_PROBE_LABEL) <= LATENCY_DISPLAY_LIMIT_MS * 1000UL);
+}
+
+static void printMs(Print& out, uint32_t us) {
+    out.printf(" %9.1f", us / 1000.0f);
+}
+
+void printLatencyProbe(Print& out) {
+    LatencyProbeStats s = getLatencyProbeStats();
+    out.printf("End-to-end latency: %lu traces, %lu complete, %lu expired, %lu skipped%s\n",
+               (unsigned long)s.traces, (unsigned long)s.complete, (unsigned long)s.expired,
+               (unsigned long)s.skipped, s.open ? ", one open" : "");
+    out.println("Probe      Count    p50 ms    p99 ms    max ms   mean ms");
+    for (uint8_t p = 0; p < LATENCY_PROBE_COUNT; p++) {
+        const LatencyProbeHistogram& h = histograms[p];
+        out.printf("%-8s %7lu", PROBE_NAMES[p], (unsigned long)h.count());
+        printMs(out, h.percentileUs(500));
+        printMs(out, h.percentileUs(990));
+        printMs(out, h.maxUs());
+        printMs(out, h.meanUs());
+        out.println();
+    }
+
+    LatencyProbeReport r = getLatencyProbeReport();
+    if (r.trials == 0) return;
+    out.printf("Bench: %u/%u trials at %.1f Hz (%.1fx the %.2f uSv/h alarm)%s\n", r.count, r.trials, r.rateHz,
+               (float)LATENCY_BENCH_RATE_FACTOR, r.thresholdUsvH, r.running ? ", running" : "");
+    out.println("Trial   label ms  flush ms  alarm ms");
+    for (uint8_t i = 0; i < r.count; i++) {
+        const LatencyProbeTrial& t = r.results[i];
+        out.printf("%5u", (unsigned)(i + 1));
+        for (uint8_t p = 0; p < LATENCY_PROBE_COUNT; p++) {
+            if (t.seen & (1 << p)) printMs(out, t.us[p]);
+            else out.print(t.traced & (1 << p) ? "    missed" : "         -");
+        }
+        out.println();
+    }
+    if (!r.running) {
+        out.printf("Verdict: %s (alarm within %lu ms, label within %lu ms)\n", benchPassed(r) ? "PASS" : "FAIL",
+                   (unsigned long)LATENCY_ALARM_LIMIT_MS, (unsigned long)LATENCY_DISPLAY_LIMIT_MS);
+    }
+}
+
+void buildLatencyProbeJson(JsonDocument& doc) {
+    LatencyProbeStats s = getLatencyProbeStats();
+    doc["traces"] = s.traces;
+    doc["complete"] = s.complete;
+    doc["expired"] = s.expired;
+    doc["skipped"] = s.skipped;
+    doc["open"] = s.open;
+    JsonObject probes = doc["probes"].to<JsonObject>();
+    for (uint8_t p = 0; p < LATENCY_PROBE_COUNT; p++) {
+        const LatencyProbeHistogram& h = histograms[p];
+        JsonObject o = probes[PROBE_NAMES[p]].to<JsonObject>();
+        o["count"] = h.count();
+        o["p50_us"] = h.percentileUs(500);
+        o["p99_us"] = h.percentileUs(990);
+        o["max_us"] = h.maxUs();
+        o["mean_us"] = h.meanUs();
+    }
+
+    LatencyProbeReport r = getLatencyProbeReport();
+    if (r.trials == 0) return;
+    JsonObject bench = doc["bench"].to<JsonObject>();
+    bench["running"] = r.running;
+    bench["trials"] = r.trials;
+    bench["rate_hz"] = r.rateHz;
+    bench["threshold_usvh"] = r.thresholdUsvH;
+    bench["alarm_limit_ms"] = LATENCY_ALARM_LIMIT_MS;
+    bench["display_limit_ms"] = LATENCY_DISPLAY_LIMIT_MS;
+    if (!r.running) bench["passed"] = benchPassed(r);
+    JsonArray results = bench["results"].to<JsonArray>();
+    for (uint8_t i = 0; i < r.count; i++) {
+        JsonObject t = results.add<JsonObject>();
+        for (uint8_t p = 0; p < LATENCY_PROBE_COUNT; p++) {
+            if (r.results[i].seen & (1 << p)) t[PROBE_NAMES[p]] = r.results[i].us[p];
+            else if (r.results[i].traced & (1 << p)) t[PROBE_NAMES[p]] = nullptr;
+        }
+    }
+}
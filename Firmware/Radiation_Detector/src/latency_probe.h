@@ -0,0 +1,98 @@
+#ifndef LATENCY_PROBE_H
+#define LATENCY_PROBE_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "config.h"
+#if !HEADLESS
+#include <lvgl.h>
+#endif
+#include "latency_histogram.h"
+
+// End-to-end latency of the alarm response ("latency e2e", /api/latency).
+// Every pulse train the injector (pulse_injector.h) starts opens a trace at
+// the time its first pulse is due. The trace then closes three probes:
+//  - label: the first time the dose-rate label is set, once the pulse
+//    snapshot holds counts from the train (uiTask);
+//  - flush: the first stripe after that covering the label's area, at the
+//    time it is queued to the panel's DMA (display_port.cpp, uiTask);
+//  - alarm: the first alarm tone, NONE to a level (alarm_sequencer.cpp,
+//    pulseTask). Only traced if the alarm is enabled and quiet at the start.
+// Each latency goes into a log2 histogram of its own, with one writer each.
+// A trace that has not closed all of its probes after
+// LATENCY_TRACE_TIMEOUT_MS counts as expired; the label and flush probes
+// only close while the main screen is shown. Trains started while a trace is
+// open are not traced. The headless build (HEADLESS) has no label to trace
+// and waits for the alarm only.
+//
+// "latency e2e bench [n]" is the certification run: n trials of a fixed rate
+// of LATENCY_BENCH_RATE_FACTOR times the current alarm threshold, each once
+// the alarm has gone quiet again plus LATENCY_BENCH_SETTLE_MS. It passes if
+// every trial raised the alarm within LATENCY_ALARM_LIMIT_MS and updated the
+// label within LATENCY_DISPLAY_LIMIT_MS. The tube must be disconnected or its
+// HV off, as for "inject".
+
+typedef LatencyHistogramN<27> LatencyProbeHistogram;   ///< Up to ~134 s
+
+// Counts since boot and closed seconds (the injector's callback).
+typedef void (*LatencyProbeCounts)(uint32_t* counts, uint32_t* seconds);
+
+enum LatencyProbeId : uint8_t {
+    LATENCY_PROBE_LABEL = 0,
+    LATENCY_PROBE_FLUSH,
+    LATENCY_PROBE_ALARM,
+    LATENCY_PROBE_COUNT
+};
+
+struct LatencyProbeTrial {
+    uint32_t us[LATENCY_PROBE_COUNT];   ///< From the first pulse
+    uint8_t seen;                       ///< Bit per probe that closed
+    uint8_t traced;                     ///< Bit per probe the trace waited for
+};
+
+struct LatencyProbeStats {
+    uint32_t traces;
+    uint32_t complete;
+    uint32_t expired;
+    uint32_t skipped;                   ///< Trains started while a trace was open
+    bool open;
+};
+
+struct LatencyProbeReport {
+    bool running;
+    uint8_t trials;                     ///< Planned
+    uint8_t count;                      ///< Finished
+    float rateHz;
+    float thresholdUsvH;
+    LatencyProbeTrial results[LATENCY_BENCH_MAX_TRIALS];
+};
+
+// Attaches to the injector. Call once in setup(), after initPulseInjector().
+void initLatencyProbe(LatencyProbeCounts counts);
+
+// The probes. Cheap while no trace is open.
+#if !HEADLESS
+void latencyProbeLabel(lv_obj_t* label, uint32_t totalCounts);
+void latencyProbeFlush(const lv_area_t* area);
+#endif
+void latencyProbeAlarm();
+
+// Starts the certification run on a task of its own.
+// @return false if one is running, the injector is busy or the alarm is off
+bool latencyProbeStartBench(uint8_t trials);
+void latencyProbeStopBench();
+
+// Clears the histograms; false while a trace is open or the bench runs.
+bool latencyProbeReset();
+
+LatencyProbeStats getLatencyProbeStats();
+const LatencyProbeHistogram& latencyProbeHistogram(LatencyProbeId probe);
+LatencyProbeReport getLatencyProbeReport();
+
+// Histograms, the last bench run and its verdict ("latency e2e").
+void printLatencyProbe(Print& out);
+
+// Fills @p doc for /api/latency.
+void buildLatencyProbeJson(JsonDocument& doc);
+
+#endif // LATENCY_PROBE_H
@@ -0,0 +1,87 @@
+#ifndef LED_PATTERN_H
+#define LED_PATTERN_H
+
+#include <math.h>
+#include <stdint.h>
+#include "alarm_rules.h"
+
+// Status LED patterns: the colour of one frame from the alarm level, the
+// dose rate relative to the rate warning and the time. Alarm levels follow the
+// buzzer's rhythm (alarm_sequencer.h) so LED and tone agree:
+//   none    breathing, green at background turning yellow towards the
+//           warning threshold (log scale from 1 % of it)
+//   warn    amber, 1 s on / 1 s off
+//   alarm   red, 4 Hz
+//   danger  red / white alternating at 5 Hz
+// Without an alarm, a rate anomaly (anomaly_capture.h) adds a magenta double
+// blink every 2 s and each Geiger pulse a short white tick. A single-colour
+// LED takes the brightness of the frame. No Arduino dependencies
+// (host-compilable).
+
+struct LedColor {
+    uint8_t r, g, b;
+
+    bool operator==(const LedColor& o) const { return r == o.r && g == o.g && b == o.b; }
+    bool operator!=(const LedColor& o) const { return !(*this == o); }
+    uint8_t level() const { return r > g ? (r > b ? r : b) : (g > b ? g : b); }
+};
+
+struct LedPatternInput {
+    uint8_t alarmLevel;      ///< AlarmLevel
+    float rateFraction;      ///< Dose rate over the warning threshold of the rate rule
+    bool anomaly;            ///< A rate anomaly is active
+    uint32_t pulseAgeMs;     ///< Since the last Geiger pulse (UINT32_MAX: none)
+};
+
+static const uint16_t LED_PULSE_TICK_MS = 30;
+
+static inline LedColor ledScale(LedColor c, float f) {
+    if (f < 0.0f) f = 0.0f;
+    if (f > 1.0f) f = 1.0f;
+    return {(uint8_t)(c.r * f + 0.5f), (uint8_t)(c.g * f + 0.5f), (uint8_t)(c.b * f + 0.5f)};
+}
+
+static inline LedColor ledMix(LedColor a, LedColor b, float f) {
+    if (f < 0.0f) f = 0.0f;
+    if (f > 1.0f) f = 1.0f;
+    return {(uint8_t)(a.r + (b.r - a.r) * f + 0.5f), (uint8_t)(a.g + (b.g - a.g) * f + 0.5f),
+            (uint8_t)(a.b + (b.b - a.b) * f + 0.5f)};
+}
+
+/**
+ * @brief Colour of the frame at @p ms (any monotonic millisecond clock).
+ */
+static inline LedColor ledPatternFrame(const LedPatternInput& in, uint32_t ms) {
+    static const LedColor GREEN = {0, 255, 0};
+    static const LedColor YELLOW = {255, 200, 0};
+    static const LedColor AMBER = {255, 110, 0};
+    static const LedColor RED = {255, 0, 0};
+    static const LedColor WHITE = {255, 255, 255};
+    static const LedColor MAGENTA = {255, 0, 200};
+    static const LedColor OFF = {0, 0, 0};
+
+    switch (in.alarmLevel) {
+        case ALARM_LEVEL_WARN:
+            return (ms % 2000) < 1000 ? AMBER : OFF;
+        case ALARM_LEVEL_ALARM:
+            return (ms % 250) < 125 ? RED : OFF;
+        case ALARM_LEVEL_DANGER:
+            return (ms % 200) < 100 ? RED : WHITE;
+        default:
+            break;
+    }
+
+    if (in.anomaly) {
+        uint32_t phase = ms % 2000;
+        if (phase < 100 || (phase >= 200 && phase < 300)) return MAGENTA;
+    }
+    if (in.pulseAgeMs < LED_PULSE_TICK_MS) return WHITE;
+
+    // Two decades below the threshold map onto green ... yellow
+    float x = in.rateFraction > 0.01f ? (log10f(in.rateFraction) + 2.0f) / 2.0f : 0.0f;
+    LedColor base = ledMix(GREEN, YELLOW, x);
+    float breath = 0.5f - 0.5f * cosf((ms % 4000) * (2.0f * (float)M_PI / 4000.0f));
+    return ledScale(base, 0.25f + 0.75f * breath);
+}
+
+#endif // LED_PATTERN_H
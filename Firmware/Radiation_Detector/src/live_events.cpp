@@ -0,0 +1,228 @@
+/**
+ * @file live_events.cpp
+ * @brief Server-Sent Events push channel for the web dashboard.
+ *
+ * The synchronous WebServer handles one request at a time, so the /events
+ * handler only writes the SSE response header and keeps a copy of the client
+ * socket. Once WebServer lets go of the request the copy stays open and is
+ * served from liveEventsLoop() on the web task:
+ *
+ *   event: rate    current/average/maximum/cumulative/cpm, at most once per
+ *                  LIVE_EVENTS_RATE_INTERVAL_MS and only if a value changed
+ *   event: charts  hourly/daily arrays, when a chart interval has closed and
+ *                  once to every newly connected client
+ *   event: plateau same payload as /api/plateau, while a plateau scan publishes
+ *                  progress and once to a new client after a scan has run
+ *   event: anomaly same payload as /api/anomaly, when a rate anomaly starts or
+ *                  ends and once to a new client after the first one
+ *
+ * A write that does not complete within the socket timeout drops the client;
+ * EventSource reconnects by itself after the advertised retry delay.
+ */
+
+#include "live_events.h"
+#include "radiation_data.h"
+#include "plateau_scan.h"
+#include "anomaly_capture.h"
+#include "debug.h"
+
+static const uint32_t HEARTBEAT_INTERVAL_MS = 15000; ///< Keeps proxies and NATs from idling out
+static const uint32_t CLIENT_SEND_TIMEOUT_S = 1;     ///< WiFiClient timeout is in seconds
+
+struct EventClient {
+    WiFiClient client;
+    bool active;
+    bool chartsPending; ///< Client has not received the current chart arrays yet
+    bool ratePending;   ///< Client has not received the current rate payload yet
+    bool plateauPending; ///< Client has not received the current plateau scan state yet
+    bool anomalyPending; ///< Client has not received the current anomaly events yet
+};
+
+static EventClient eventClients[LIVE_EVENTS_MAX_CLIENTS];
+static WebServer* eventServer = nullptr;
+
+static const size_t RATE_PAYLOAD_SIZE = 192;
+static const size_t FRAME_BUFFER_SIZE = 256;       ///< Frames up to this size go out in one write
+
+static char lastRatePayload[RATE_PAYLOAD_SIZE] = "";
+static uint32_t lastRateCheckMs = 0;
+static uint32_t lastHeartbeatMs = 0;
+static uint32_t sentChartVersion = 0;
+static uint32_t sentPlateauVersion = 0;
+static uint32_t sentAnomalyVersion = 0;
+
+/**
+ * @brief Writes @p length bytes or drops the client.
+ */
+static bool sendBytes(EventClient& slot, const char* data, size_t length) {
+    if (slot.client.write((const uint8_t*)data, length) == length) return true;
+    DEBUG_PRINTLN("Live events: client dropped");
+    slot.client.stop();
+    slot.active = false;
+    return false;
+}
+
+/**
+ * @brief Writes one SSE frame; drops the client if the socket is gone or stalls.
+ *
+ * A frame that fits FRAME_BUFFER_SIZE (the rate and anomaly events) is put
+ * together on the stack and written at once; a larger payload (the chart
+ * arrays) is written between its header and trailer as it is, never copied.
+ */
+static bool sendEvent(EventClient& slot, const char* event, const char* data, size_t length) {
+    if (!slot.client.connected()) {
+        slot.client.stop();
+        slot.active = false;
+        return false;
+    }
+
+    char frame[FRAME_BUFFER_SIZE];
+    int header = event ? snprintf(frame, sizeof(frame), "event: %s\ndata: ", event)
+                       : snprintf(frame, sizeof(frame), "data: ");
+    if (header < 0 || (size_t)header >= sizeof(frame)) return false;
+    if (header + length + 2 <= sizeof(frame)) {
+        memcpy(frame + header, data, length);
+        memcpy(frame + header + length, "\n\n", 2);
+        return sendBytes(slot, frame, header + length + 2);
+    }
+    return sendBytes(slot, frame, header) && sendBytes(slot, data, length) && sendBytes(slot, "\n\n", 2);
+}
+
+static bool sendEvent(EventClient& slot, const char* event, const String& data) {
+    return sendEvent(slot, event, data.c_str(), data.length());
+}
+
+/**
+ * @brief Handles GET /events: answers with the SSE header and adopts the socket.
+ */
+static void handleEventsRequest() {
+    int freeSlot = -1;
+    for (int i = 0; i < LIVE_EVENTS_MAX_CLIENTS; i++) {
+        if (eventClients[i].active && !eventClients[i].client.connected()) {
+            eventClients[i].client.stop();
+            eventClients[i].active = false;
+        }
+        if (!eventClients[i].active && freeSlot < 0) freeSlot = i;
+    }
+    if (freeSlot < 0) {
+        // The page falls back to polling /api/data when the stream is refused
+        eventServer->send(503, "text/plain", "Too many event clients");
+        return;
+    }
+
+    EventClient& slot = eventClients[freeSlot];
+    slot.client = eventServer->client();
+    slot.client.setTimeout(CLIENT_SEND_TIMEOUT_S);
+    slot.client.print("HTTP/1.1 200 OK\r\n"
+                      "Content-Type: text/event-stream\r\n"
+                      "Cache-Control: no-cache\r\n"
+                      "Connection: keep-alive\r\n"
+                      "Access-Control-Allow-Origin: *\r\n"
+                      "\r\n"
+                      "retry: 3000\n\n");
+    slot.active = true;
+    slot.chartsPending = true;
+    slot.ratePending = true;
+    slot.plateauPending = true;
+    slot.anomalyPending = true;
+    DEBUG_PRINTF("Live events: client %d connected\n", freeSlot);
+}
+
+void liveEventsAttach(WebServer& server) {
+    eventServer = &server;
+    server.on("/events", HTTP_GET, handleEventsRequest);
+}
+
+uint8_t liveEventsClientCount() {
+    uint8_t count = 0;
+    for (int i = 0; i < LIVE_EVENTS_MAX_CLIENTS; i++) {
+        if (eventClients[i].active) count++;
+    }
+    return count;
+}
+
+void liveEventsLoop(uint32_t nowMs) {
+    if (liveEventsClientCount() == 0) return;
+
+    // Chart arrays are only serialised when an interval closed or a client is new
+    uint32_t chartVersion = getChartDataVersion();
+    bool chartsChanged = chartVersion != sentChartVersion;
+    bool chartsWanted = chartsChanged;
+    for (int i = 0; i < LIVE_EVENTS_MAX_CLIENTS; i++) {
+        if (eventClients[i].active && eventClients[i].chartsPending) chartsWanted = true;
+    }
+    if (chartsWanted) {
+        String charts = getChartDataJsonExport();
+        for (int i = 0; i < LIVE_EVENTS_MAX_CLIENTS; i++) {
+            EventClient& slot = eventClients[i];
+            if (!slot.active || !(chartsChanged || slot.chartsPending)) continue;
+            if (sendEvent(slot, "charts", charts)) slot.chartsPending = false;
+        }
+        sentChartVersion = chartVersion;
+    }
+
+    // Version 0: no scan since boot, nothing to show
+    uint32_t plateauVersion = plateauScanVersion();
+    bool plateauChanged = plateauVersion != sentPlateauVersion;
+    bool plateauWanted = plateauChanged;
+    for (int i = 0; i < LIVE_EVENTS_MAX_CLIENTS; i++) {
+        if (eventClients[i].active && eventClients[i].plateauPending) plateauWanted = true;
+    }
+    if (plateauVersion && plateauWanted) {
+        String plateau = getPlateauScanJson();
+        for (int i = 0; i < LIVE_EVENTS_MAX_CLIENTS; i++) {
+            EventClient& slot = eventClients[i];
+            if (!slot.active || !(plateauChanged || slot.plateauPending)) continue;
+            if (sendEvent(slot, "plateau", plateau)) slot.plateauPending = false;
+        }
+        sentPlateauVersion = plateauVersion;
+    }
+
+    // Version 0: no anomaly since boot
+    uint32_t anomalyVersion = anomalyEventVersion();
+    bool anomalyChanged = anomalyVersion != sentAnomalyVersion;
+    bool anomalyWanted = anomalyChanged;
+    for (int i = 0; i < LIVE_EVENTS_MAX_CLIENTS; i++) {
+        if (eventClients[i].active && eventClients[i].anomalyPending) anomalyWanted = true;
+    }
+    if (anomalyVersion && anomalyWanted) {
+        String anomaly = getAnomalyJson();
+        for (int i = 0; i < LIVE_EVENTS_MAX_CLIENTS; i++) {
+            EventClient& slot = eventClients[i];
+            if (!slot.active || !(anomalyChanged || slot.anomalyPending)) continue;
+            if (sendEvent(slot, "anomaly", anomaly)) slot.anomalyPending = false;
+        }
+        sentAnomalyVersion = anomalyVersion;
+    }
+
+    if (nowMs - lastRateCheckMs >= LIVE_EVENTS_RATE_INTERVAL_MS) {
+        lastRateCheckMs = nowMs;
+        // Built and compared in fixed buffers: the per-second path allocates nothing
+        char rate[RATE_PAYLOAD_SIZE];
+        size_t length = writeLiveRate(rate, sizeof(rate));
+        bool rateChanged = length && strcmp(rate, lastRatePayload) != 0;
+        if (rateChanged) memcpy(lastRatePayload, rate, length + 1);
+        size_t lastLength = strlen(lastRatePayload);
+        for (int i = 0; i < LIVE_EVENTS_MAX_CLIENTS; i++) {
+            EventClient& slot = eventClients[i];
+            if (!slot.active || !lastLength || !(rateChanged || slot.ratePending)) continue;
+            if (sendEvent(slot, "rate", lastRatePayload, lastLength)) {
+                slot.ratePending = false;
+                lastHeartbeatMs = nowMs;
+            }
+        }
+    }
+
+    if (nowMs - lastHeartbeatMs >= HEARTBEAT_INTERVAL_MS) {
+        lastHeartbeatMs = nowMs;
+        for (int i = 0; i < LIVE_EVENTS_MAX_CLIENTS; i++) {
+            EventClient& slot = eventClients[i];
+            if (!slot.active) continue;
+            // SSE comment line: ignored by EventSource, detects dead sockets
+            if (!slot.client.connected() || slot.client.print(":\n\n") != 3) {
+                slot.client.stop();
+                slot.active = false;
+            }
+        }
+    }
+}
@@ -0,0 +1,24 @@
+#ifndef LIVE_EVENTS_H
+#define LIVE_EVENTS_H
+
+#include <Arduino.h>
+#include <WebServer.h>
+#include "config.h"
+
+// Server-Sent Events stream of live readings at /events.
+// The handler takes over the client socket from WebServer and keeps it open;
+// liveEventsLoop() then pushes a small "rate" event when the displayed values
+// change, a "charts" event only when a chart interval closes, "plateau"
+// events while a plateau scan runs (plateau_scan.h) and an "anomaly" event
+// when a rate anomaly starts or ends (anomaly_capture.h).
+
+// Registers the /events route. Call while the other routes are set up.
+void liveEventsAttach(WebServer& server);
+
+// Sends pending events and drops dead clients. Call from the web task after handleClient().
+void liveEventsLoop(uint32_t nowMs);
+
+// Number of connected event-stream clients.
+uint8_t liveEventsClientCount();
+
+#endif // LIVE_EVENTS_H
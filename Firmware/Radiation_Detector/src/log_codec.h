@@ -0,0 +1,301 @@
+#ifndef LOG_CODEC_H
+#define LOG_CODEC_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Columnar encoding of history log records (history_log.h).
+// A block's records are stored column by column, each column a sequence of
+// LEB128 varints:
+//   timestamps  run-length pairs (run, zigzag delta-of-delta); the first
+//               timestamp is kept by the caller, its delta counts as 0
+//   counts      zigzag delta to the previous record (the first to 0)
+//   seconds     run-length pairs (run, value)
+//   flags       run-length pairs (run, value)
+// A steady 1 s log is one timestamp run, one seconds run and one flags run per
+// block plus about a byte of counts per record, against 16 bytes raw.
+// No Arduino dependencies (host-compilable); tools/decode_history_log.py
+// implements the same decoding.
+
+enum LogRecordFlags {
+    LOG_FLAG_BOOT       = 0x0001, ///< First record after power-on/reset
+    LOG_FLAG_ALARM      = 0x0002, ///< An alarm was active during the interval
+    LOG_FLAG_TIME_VALID = 0x0004, ///< Timestamp is wall-clock (UTC) rather than uptime
+    LOG_FLAG_INJECTED   = 0x0008  ///< Counts came from the pulse injector, not the tube
+};
+
+struct LogRecord {
+    uint32_t timestamp; ///< Interval start in seconds
+    uint32_t counts;    ///< Counts registered in the interval
+    uint16_t seconds;   ///< Interval length in seconds
+    uint16_t flags;     ///< LogRecordFlags
+    uint32_t sequence;  ///< Monotonic record number since the log was created
+};
+
+enum LogColumn {
+    LOG_COLUMN_TIMESTAMP = 0,
+    LOG_COLUMN_COUNTS,
+    LOG_COLUMN_SECONDS,
+    LOG_COLUMN_FLAGS,
+    LOG_COLUMN_COUNT
+};
+
+inline size_t logVarintLength(uint64_t value) {
+    size_t length = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        length++;
+    }
+    return length;
+}
+
+inline size_t logVarintPut(uint8_t* out, uint64_t value) {
+    size_t n = 0;
+    while (value >= 0x80) {
+        out[n++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    out[n++] = (uint8_t)value;
+    return n;
+}
+
+inline uint64_t logZigzag(int64_t value) {
+    return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+inline int64_t logUnzigzag(uint64_t value) {
+    return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+/**
+ * @brief One column being filled; run-length columns keep their open run
+ *        unwritten so a repeated value only grows its count.
+ */
+template <size_t CAPACITY>
+class LogColumnWriter {
+public:
+    void clear(bool runLength) {
+        runLength_ = runLength;
+        length_ = 0;
+        run_ = 0;
+        value_ = 0;
+    }
+
+    /// Encoded size once @p value is added (the open run included).
+    size_t sizeWith(uint64_t value) const {
+        if (!runLength_) return length_ + logVarintLength(value);
+        if (run_ && value == value_) return length_ + logVarintLength(run_ + 1) + logVarintLength(value);
+        return openRunSize(length_) + 1 + logVarintLength(value);
+    }
+
+    /// Encoded size with the open run closed.
+    size_t size() const { return openRunSize(length_); }
+
+    void add(uint64_t value) {
+        if (!runLength_) {
+            length_ += logVarintPut(bytes_ + length_, value);
+        } else if (run_ && value == value_) {
+            run_++;
+        } else {
+            closeRun();
+            run_ = 1;
+            value_ = value;
+        }
+    }
+
+    /// Closes the open run and copies the column to @p out. @return its length
+    size_t finish(uint8_t* out) {
+        closeRun();
+        memcpy(out, bytes_, length_);
+        return length_;
+    }
+
+private:
+    size_t openRunSize(size_t length) const {
+        return run_ ? length + logVarintLength(run_) + logVarintLength(value_) : length;
+    }
+
+    void closeRun() {
+        if (!run_) return;
+        length_ += logVarintPut(bytes_ + length_, run_);
+        length_ += logVarintPut(bytes_ + length_, value_);
+        run_ = 0;
+    }
+
+    bool runLength_;
+    size_t length_;
+    uint64_t run_;
+    uint64_t value_;
+    uint8_t bytes_[CAPACITY];
+};
+
+/**
+ * @brief Packs records into at most PAYLOAD bytes of columns.
+ */
+template <size_t PAYLOAD>
+class LogBlockEncoder {
+public:
+    LogBlockEncoder() { clear(); }
+
+    void clear() {
+        count_ = 0;
+        columns_[LOG_COLUMN_TIMESTAMP].clear(true);
+        columns_[LOG_COLUMN_COUNTS].clear(false);
+        columns_[LOG_COLUMN_SECONDS].clear(true);
+        columns_[LOG_COLUMN_FLAGS].clear(true);
+    }
+
+    /**
+     * @brief Appends @p record if the encoded block still fits.
+     * @return false when the block is full (the record was not added)
+     */
+    bool add(const LogRecord& record) {
+        uint64_t values[LOG_COLUMN_COUNT];
+        int64_t delta = count_ ? (int64_t)record.timestamp - lastTimestamp_ : 0;
+        values[LOG_COLUMN_TIMESTAMP] = logZigzag(delta - lastDelta_);
+        values[LOG_COLUMN_COUNTS] = logZigzag((int64_t)record.counts - (count_ ? lastCounts_ : 0));
+        values[LOG_COLUMN_SECONDS] = record.seconds;
+        values[LOG_COLUMN_FLAGS] = record.flags;
+
+        size_t total = 0;
+        for (int c = 0; c < LOG_COLUMN_COUNT; c++) total += columns_[c].sizeWith(values[c]);
+        if (total > PAYLOAD || count_ == UINT16_MAX) return false;
+
+        for (int c = 0; c < LOG_COLUMN_COUNT; c++) columns_[c].add(values[c]);
+        if (count_ == 0) {
+            first_ = record;
+            minTimestamp_ = maxTimestamp_ = record.timestamp;
+            minCounts_ = maxCounts_ = record.counts;
+        }
+        if (record.timestamp < minTimestamp_) minTimestamp_ = record.timestamp;
+        if (record.timestamp > maxTimestamp_) maxTimestamp_ = record.timestamp;
+        if (record.counts < minCounts_) minCounts_ = record.counts;
+        if (record.counts > maxCounts_) maxCounts_ = record.counts;
+        lastDelta_ = delta;
+        lastTimestamp_ = record.timestamp;
+        lastCounts_ = record.counts;
+        count_++;
+        return true;
+    }
+
+    /**
+     * @brief Writes the columns back to back to @p out (PAYLOAD bytes) and
+     *        their lengths to @p lengths. @return the payload length
+     */
+    size_t finish(uint8_t* out, uint16_t lengths[LOG_COLUMN_COUNT]) {
+        size_t length = 0;
+        for (int c = 0; c < LOG_COLUMN_COUNT; c++) {
+            lengths[c] = (uint16_t)columns_[c].finish(out + length);
+            length += lengths[c];
+        }
+        return length;
+    }
+
+    uint16_t count() const { return count_; }
+    const LogRecord& first() const { return first_; }
+    uint32_t minTimestamp() const { return minTimestamp_; }
+    uint32_t maxTimestamp() const { return maxTimestamp_; }
+    uint32_t minCounts() const { return minCounts_; }
+    uint32_t maxCounts() const { return maxCounts_; }
+
+private:
+    LogColumnWriter<PAYLOAD> columns_[LOG_COLUMN_COUNT];
+    uint16_t count_;
+    LogRecord first_;
+    int64_t lastTimestamp_;
+    int64_t lastDelta_;
+    uint32_t lastCounts_;
+    uint32_t minTimestamp_;
+    uint32_t maxTimestamp_;
+    uint32_t minCounts_;
+    uint32_t maxCounts_;
+};
+
+/**
+ * @brief Streams the records of one encoded block back out, one at a time.
+ */
+class LogBlockDecoder {
+public:
+    /**
+     * @param payload   Columns as written by LogBlockEncoder::finish()
+     * @param lengths   Their lengths
+     * @param count     Records in the block
+     * @param firstTimestamp, firstSequence  Of the block's first record
+     */
+    LogBlockDecoder(const uint8_t* payload, const uint16_t lengths[LOG_COLUMN_COUNT], uint16_t count,
+                    uint32_t firstTimestamp, uint32_t firstSequence)
+        : remaining_(count), timestamp_(firstTimestamp), delta_(0), counts_(0),
+          sequence_(firstSequence), first_(true) {
+        const uint8_t* p = payload;
+        for (int c = 0; c < LOG_COLUMN_COUNT; c++) {
+            cursor_[c] = p;
+            end_[c] = p + lengths[c];
+            run_[c] = 0;
+            value_[c] = 0;
+            p += lengths[c];
+        }
+    }
+
+    /// @return false after the last record or on a malformed column
+    bool next(LogRecord* record) {
+        if (remaining_ == 0) return false;
+        uint64_t dod, countDelta, seconds, flags;
+        if (!nextRun(LOG_COLUMN_TIMESTAMP, &dod) || !nextVarint(LOG_COLUMN_COUNTS, &countDelta) ||
+            !nextRun(LOG_COLUMN_SECONDS, &seconds) || !nextRun(LOG_COLUMN_FLAGS, &flags)) {
+            remaining_ = 0;
+            return false;
+        }
+        if (!first_) {
+            delta_ += logUnzigzag(dod);
+            timestamp_ += delta_;
+        }
+        first_ = false;
+        counts_ += logUnzigzag(countDelta);
+        record->timestamp = (uint32_t)timestamp_;
+        record->counts = (uint32_t)counts_;
+        record->seconds = (uint16_t)seconds;
+        record->flags = (uint16_t)flags;
+        record->sequence = sequence_++;
+        remaining_--;
+        return true;
+    }
+
+private:
+    bool nextVarint(int column, uint64_t* value) {
+        uint64_t result = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (cursor_[column] >= end_[column]) return false;
+            uint8_t byte = *cursor_[column]++;
+            result |= (uint64_t)(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                *value = result;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool nextRun(int column, uint64_t* value) {
+        if (run_[column] == 0 &&
+            (!nextVarint(column, &run_[column]) || run_[column] == 0 || !nextVarint(column, &value_[column]))) {
+            return false;
+        }
+        run_[column]--;
+        *value = value_[column];
+        return true;
+    }
+
+    uint32_t remaining_;
+    int64_t timestamp_;
+    int64_t delta_;
+    int64_t counts_;
+    uint32_t sequence_;
+    bool first_;
+    const uint8_t* cursor_[LOG_COLUMN_COUNT];
+    const uint8_t* end_[LOG_COLUMN_COUNT];
+    uint64_t run_[LOG_COLUMN_COUNT];
+    uint64_t value_[LOG_COLUMN_COUNT];
+};
+
+#endif // LOG_CODEC_H
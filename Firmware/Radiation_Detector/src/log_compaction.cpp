@@ -0,0 +1,421 @@
+/**
+ * @file log_compaction.cpp
+ * @brief Background compaction of the history log into 1-minute and 1-hour summaries.
+ *
+ * Summary file layout (all little-endian):
+ *   offset 0      file header, one 512-byte sector (magic, format, resolution)
+ *   offset 512*k  sector slot k-1: 20-byte sector header + 24 HistoryBucket
+ *
+ * The slots form a ring (log_ring.h). The sector being filled always sits at
+ * the slot after the newest full one and is rewritten there in place; a torn
+ * rewrite is discarded on mount like a torn log block, and its summaries are
+ * rebuilt from the 1 s log starting at the source sequence of the last intact
+ * sector. A header that does not match (another resolution, an unknown
+ * format) starts the file over; it is rebuilt as far as the 1 s log reaches.
+ */
+
+#include "log_compaction.h"
+#include "history_log.h"
+#include "log_ring.h"
+#include "log_summary.h"
+#include "job_wheel.h"
+#include "debug.h"
+#include <FS.h>
+#include "esp_rom_crc.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+static const uint32_t SUMMARY_FILE_MAGIC   = 0x534C4452; ///< "RDLS"
+static const uint32_t SUMMARY_SECTOR_MAGIC = 0x4D4C4452; ///< "RDLM"
+static const uint16_t SUMMARY_FORMAT       = 1;
+static const size_t   SUMMARY_SECTOR_SIZE  = 512;
+static const uint16_t SUMMARIES_PER_SECTOR = 24;
+static const uint32_t SUMMARY_TAIL_SCAN    = 4; ///< Sectors checked backwards on mount
+
+struct SummaryFileHeader {
+    uint32_t magic;
+    uint16_t format;
+    uint16_t sectorSize;
+    uint32_t seconds;       ///< Resolution of the summaries
+    uint8_t reserved[SUMMARY_SECTOR_SIZE - 16];
+    uint32_t crc;           ///< CRC-32 of the fields above
+};
+
+struct SummarySector {
+    uint32_t magic;
+    uint16_t count;         ///< Summaries in use
+    uint16_t reserved;
+    uint32_t firstSequence; ///< Number of the first summary in the file's history
+    uint32_t sourceEnd;     ///< 1 s log sequence after the newest summary
+    uint32_t crc;           ///< CRC-32 of the header after the magic and of the summaries
+    HistoryBucket summaries[SUMMARIES_PER_SECTOR];
+    uint8_t padding[12];
+};
+
+static_assert(sizeof(HistoryBucket) == 20, "HistoryBucket is part of the summary file format");
+static_assert(sizeof(SummaryFileHeader) == SUMMARY_SECTOR_SIZE, "file header must fill one sector");
+static_assert(sizeof(SummarySector) == SUMMARY_SECTOR_SIZE, "summary sector must fill one sector");
+
+enum { RES_MINUTE, RES_HOUR, RES_COUNT };
+
+struct SummaryResolution {
+    const char* path;
+    uint32_t seconds;
+    uint32_t days;          ///< Retention, 0: without limit
+};
+
+static const SummaryResolution RESOLUTIONS[RES_COUNT] = {
+    {HISTORY_LOG_PATH ".1m", 60, HISTORY_LOG_MINUTE_DAYS},
+    {HISTORY_LOG_PATH ".1h", 3600, HISTORY_LOG_HOUR_DAYS},
+};
+
+// One resolution: its file, ring position and the sector being filled
+struct SummaryFile {
+    const SummaryResolution* res;
+    uint32_t capacity;      ///< Slots, the open sector's included (UINT32_MAX: never wraps)
+    File file;
+    uint32_t head;          ///< Slot of the open sector
+    uint32_t full;          ///< Full sectors before it
+    SummarySector open;
+    bool dirty;             ///< open has summaries not stored yet
+    uint32_t syncedMs;
+    uint32_t cursor;        ///< 1 s sequence after the newest summary stored
+};
+
+static SummaryFile files[RES_COUNT];
+static LogSummaryLevel levels[RES_COUNT] = {LogSummaryLevel(60), LogSummaryLevel(3600)};
+
+static SemaphoreHandle_t compactMutex = nullptr;
+static bool opened = false;
+static bool failed = false;              ///< A summary file could not be opened; the job idles
+static uint32_t position = 0;            ///< Next 1 s sequence to read
+static LogCompactionStats stats;
+
+static uint32_t sectorCrc(const SummarySector& sector) {
+    uint32_t crc = esp_rom_crc32_le(0, (const uint8_t*)&sector.count,
+                                    offsetof(SummarySector, crc) - offsetof(SummarySector, count));
+    return esp_rom_crc32_le(crc, (const uint8_t*)sector.summaries, sizeof(sector.summaries));
+}
+
+static uint32_t fileHeaderCrc(const SummaryFileHeader& header) {
+    return esp_rom_crc32_le(0, (const uint8_t*)&header, offsetof(SummaryFileHeader, crc));
+}
+
+static bool sectorValid(const SummarySector& sector) {
+    return sector.magic == SUMMARY_SECTOR_MAGIC && sector.count > 0 && sector.count <= SUMMARIES_PER_SECTOR &&
+           sector.crc == sectorCrc(sector);
+}
+
+static uint32_t nextSlot(const SummaryFile& f, uint32_t slot) {
+    return (uint32_t)(((uint64_t)slot + 1) % f.capacity);
+}
+
+/**
+ * @brief Slot of the @p index-th full sector, oldest first.
+ */
+static uint32_t fullSlot(uint32_t capacity, uint32_t head, uint32_t full, uint32_t index) {
+    return (uint32_t)(((uint64_t)head + capacity - full + index) % capacity);
+}
+
+/**
+ * @brief Holds the medium of the summary files (the log's, log_storage.h) for an access.
+ */
+static void summaryFilesBegin() {
+    logStorage()->filesBegin();
+}
+
+static void summaryFilesEnd() {
+    logStorage()->filesEnd();
+}
+
+/**
+ * @brief Reads the sector in @p slot through @p file. Medium held by the caller.
+ */
+static bool readSector(File& file, uint32_t slot, SummarySector& sector) {
+    return file.seek((uint64_t)(slot + 1) * SUMMARY_SECTOR_SIZE) &&
+           file.read((uint8_t*)&sector, sizeof(sector)) == sizeof(sector) && sectorValid(sector);
+}
+
+/**
+ * @brief Writes the open sector at its slot and syncs it; the medium is held only for the write.
+ */
+static bool writeOpenSector(SummaryFile& f) {
+    f.open.crc = sectorCrc(f.open);
+    summaryFilesBegin();
+    bool written = f.file.seek((uint64_t)(f.head + 1) * SUMMARY_SECTOR_SIZE) &&
+                   f.file.write((const uint8_t*)&f.open, sizeof(f.open)) == sizeof(f.open);
+    if (written) f.file.flush();
+    summaryFilesEnd();
+    stats.sectorWrites++;
+    if (!written) stats.writeErrors++;
+    return written;
+}
+
+static void clearOpenSector(SummaryFile& f, uint32_t firstSequence) {
+    memset(&f.open, 0, sizeof(f.open));
+    f.open.magic = SUMMARY_SECTOR_MAGIC;
+    f.open.firstSequence = firstSequence;
+    f.dirty = false;
+}
+
+/**
+ * @brief Finds the open sector of an existing summary file (log_ring.h). Medium held.
+ */
+static bool recoverSummaryFile(SummaryFile& f) {
+    SummaryFileHeader header;
+    f.file.seek(0);
+    if (f.file.read((uint8_t*)&header, sizeof(header)) != sizeof(header) || header.magic != SUMMARY_FILE_MAGIC ||
+        header.crc != fileHeaderCrc(header) || header.format != SUMMARY_FORMAT || header.seconds != f.res->seconds) {
+        return false;
+    }
+
+    size_t size = f.file.size();
+    uint32_t slots = size > SUMMARY_SECTOR_SIZE ? (size - SUMMARY_SECTOR_SIZE) / SUMMARY_SECTOR_SIZE : 0;
+    SummarySector& sector = f.open;
+    LogRingScan scan = logRingScan(slots, SUMMARY_TAIL_SCAN, [&f, &sector](uint32_t slot, uint32_t* sequence) {
+        if (!readSector(f.file, slot, sector)) return false;
+        *sequence = sector.firstSequence;
+        return true;
+    });
+    if (scan.wrapped || slots > f.capacity) f.capacity = slots;
+
+    uint32_t newest = scan.head ? scan.head - 1 : slots - 1;
+    if (scan.stored == 0 || !readSector(f.file, newest, sector)) {
+        clearOpenSector(f, 0);
+        f.head = scan.head % f.capacity;
+        f.full = 0;
+        f.cursor = 0;
+        return true;
+    }
+    f.cursor = sector.sourceEnd;
+    if (sector.count < SUMMARIES_PER_SECTOR) {
+        // Partly filled: it stays the open sector
+        f.head = newest;
+        f.full = scan.stored - 1;
+        f.dirty = false;
+    } else {
+        f.head = scan.head % f.capacity;
+        f.full = scan.stored;
+        clearOpenSector(f, sector.firstSequence + sector.count);
+    }
+    if (f.full > f.capacity - 1) f.full = f.capacity - 1;
+    return true;
+}
+
+/**
+ * @brief Opens, recovers or creates the file of one resolution. Medium held.
+ */
+static bool openSummaryFile(SummaryFile& f) {
+    const SummaryResolution& res = *f.res;
+    f.capacity = res.days ? (res.days * 86400UL / res.seconds + SUMMARIES_PER_SECTOR - 1) / SUMMARIES_PER_SECTOR + 1
+                          : UINT32_MAX;
+    fs::FS* files = logStorage()->files();
+    if (!files) return false;
+    fs::FS& fs = *files;
+    bool exists = fs.exists(res.path);
+    f.file = fs.open(res.path, exists ? "r+" : "w+");
+    if (!f.file) return false;
+    if (exists && recoverSummaryFile(f)) return true;
+
+    if (exists) {
+        // Another layout or a damaged header: start over and rebuild from the 1 s log
+        f.file.close();
+        f.file = fs.open(res.path, "w+");
+        if (!f.file) return false;
+    }
+    SummaryFileHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = SUMMARY_FILE_MAGIC;
+    header.format = SUMMARY_FORMAT;
+    header.sectorSize = SUMMARY_SECTOR_SIZE;
+    header.seconds = res.seconds;
+    header.crc = fileHeaderCrc(header);
+    if (f.file.write((const uint8_t*)&header, sizeof(header)) != sizeof(header)) return false;
+    f.file.flush();
+    f.head = 0;
+    f.full = 0;
+    f.cursor = 0;
+    clearOpenSector(f, 0);
+    return true;
+}
+
+/**
+ * @brief Adds a closed summary to the open sector; a full sector is written
+ *        and the next one opened.
+ */
+static void appendSummary(SummaryFile& f, const LogSummary& summary) {
+    f.open.summaries[f.open.count++] = summary.bucket;
+    f.open.sourceEnd = summary.endSource;
+    f.cursor = summary.endSource;
+    f.dirty = true;
+    if (f.open.count < SUMMARIES_PER_SECTOR) return;
+
+    // Even if the write failed the ring moves on, so the slot is not rewritten forever
+    writeOpenSector(f);
+    f.syncedMs = millis();
+    uint32_t nextSequence = f.open.firstSequence + f.open.count;
+    f.head = nextSlot(f, f.head);
+    if (f.full < f.capacity - 1) f.full++;
+    clearOpenSector(f, nextSequence);
+}
+
+/**
+ * @brief Folds one 1 s record into both resolutions. Summaries that were
+ *        stored before a reset are rebuilt and recognised by their source.
+ */
+static void compactRecord(const LogRecord& record, void* context) {
+    uint32_t* expected = (uint32_t*)context;
+    if (record.sequence > *expected) stats.skipped += record.sequence - *expected;
+    *expected = record.sequence + 1;
+    stats.compacted++;
+
+    LogSummary minute, hour;
+    if (!levels[RES_MINUTE].add(record, &minute)) return;
+    if (minute.firstSource >= files[RES_MINUTE].cursor) appendSummary(files[RES_MINUTE], minute);
+    if (minute.firstSource >= files[RES_HOUR].cursor && levels[RES_HOUR].add(minute, &hour)) {
+        if (hour.firstSource >= files[RES_HOUR].cursor) appendSummary(files[RES_HOUR], hour);
+    }
+}
+
+/**
+ * @brief Opens the summary files and picks up where their summaries end.
+ */
+static bool openCompaction() {
+    summaryFilesBegin();
+    bool ok = true;
+    for (int r = 0; r < RES_COUNT && ok; r++) {
+        files[r].res = &RESOLUTIONS[r];
+        ok = openSummaryFile(files[r]);
+    }
+    summaryFilesEnd();
+    if (!ok) {
+        DEBUG_PRINTLN("Log compaction: cannot open the summary files");
+        return false;
+    }
+    // The open buckets were lost with the reset: rebuild them from the older cursor on
+    position = files[RES_MINUTE].cursor < files[RES_HOUR].cursor ? files[RES_MINUTE].cursor : files[RES_HOUR].cursor;
+    for (int r = 0; r < RES_COUNT; r++) {
+        levels[r].reset();
+        files[r].syncedMs = millis();
+    }
+    DEBUG_PRINTF("Log compaction: resuming at seq %u (%u and %u sectors)\n", position,
+                 files[RES_MINUTE].full, files[RES_HOUR].full);
+    return true;
+}
+
+/**
+ * @brief One step: one 1 s block, the sectors it fills, and the due in-place syncs.
+ */
+static void compactionJob(void* arg) {
+    if (failed || !getHistoryLogStats().mounted) return;
+    xSemaphoreTake(compactMutex, portMAX_DELAY);
+    if (!opened) {
+        opened = openCompaction();
+        failed = !opened;
+    }
+    if (opened) {
+        uint32_t expected = position;
+        historyLogReadFrom(position, compactRecord, &expected, &position);
+        for (int r = 0; r < RES_COUNT; r++) {
+            SummaryFile& f = files[r];
+            if (f.dirty && millis() - f.syncedMs >= HISTORY_COMPACT_SYNC_S * 1000UL) {
+                f.dirty = !writeOpenSector(f);
+                f.syncedMs = millis();
+            }
+        }
+        stats.running = true;
+        stats.position = position;
+    }
+    xSemaphoreGive(compactMutex);
+}
+
+bool initLogCompaction() {
+    if (compactMutex) return true;
+    compactMutex = xSemaphoreCreateMutex();
+    if (!compactMutex) return false;
+    return jobWheelAdd("log compact", HISTORY_COMPACT_STEP_MS, HISTORY_COMPACT_STEP_MS, compactionJob, nullptr);
+}
+
+static void printSummaries(Print& out, const HistoryBucket* summaries, uint16_t count, uint32_t fromTs,
+                           uint32_t toTs, size_t* exported) {
+    for (uint16_t i = 0; i < count; i++) {
+        const HistoryBucket& b = summaries[i];
+        if (b.startTime < fromTs || b.startTime > toTs) continue;
+        out.printf("%u,%u,%u,%u,%u,%u\n", b.startTime, b.counts, b.minCps, b.maxCps, b.seconds, b.flags);
+        (*exported)++;
+    }
+}
+
+size_t exportLogSummaryCsv(Print& out, uint32_t seconds, uint32_t fromTs, uint32_t toTs) {
+    int r = seconds == 60 ? RES_MINUTE : seconds == 3600 ? RES_HOUR : RES_COUNT;
+    if (r == RES_COUNT || !compactMutex) return 0;
+
+    // Snapshot of the ring and a copy of the open sector; the full sectors are
+    // read without holding up the job
+    SummarySector openCopy;
+    xSemaphoreTake(compactMutex, portMAX_DELAY);
+    bool ready = opened;
+    const SummaryFile& f = files[r];
+    uint32_t capacity = f.capacity, head = f.head, full = f.full;
+    openCopy = f.open;
+    xSemaphoreGive(compactMutex);
+
+    size_t exported = 0;
+    if (ready) {
+        out.println("start,counts,min_cps,max_cps,seconds,flags");
+        summaryFilesBegin();
+        File reader = logStorage()->files()->open(RESOLUTIONS[r].path, "r");
+        summaryFilesEnd();
+        SummarySector sector;
+        for (uint32_t i = 0; reader && i < full; i++) {
+            summaryFilesBegin();
+            bool read = readSector(reader, fullSlot(capacity, head, full, i), sector);
+            summaryFilesEnd();
+            if (read) printSummaries(out, sector.summaries, sector.count, fromTs, toTs, &exported);
+        }
+        if (reader) {
+            summaryFilesBegin();
+            reader.close();
+            summaryFilesEnd();
+        }
+        printSummaries(out, openCopy.summaries, openCopy.count, fromTs, toTs, &exported);
+    }
+    return exported;
+}
+
+LogCompactionStats getLogCompactionStats() {
+    LogCompactionStats copy = stats;
+    if (compactMutex) {
+        xSemaphoreTake(compactMutex, portMAX_DELAY);
+        for (int r = 0; r < RES_COUNT; r++) {
+            copy.summaries[r] = opened ? files[r].full * SUMMARIES_PER_SECTOR + files[r].open.count : 0;
+        }
+        xSemaphoreGive(compactMutex);
+    }
+    return copy;
+}
+
+void printLogCompaction(Print& out) {
+    LogCompactionStats s = getLogCompactionStats();
+    HistoryLogStats log = getHistoryLogStats();
+    out.printf("Log compaction: %s\n", s.running ? "RUNNING" : failed ? "FAILED" : "IDLE");
+    out.printf("  at seq %lu, %lu records compacted since boot, %lu reused before compaction\n",
+               (unsigned long)s.position, (unsigned long)s.compacted, (unsigned long)s.skipped);
+    if (log.ringBlocks) {
+        out.printf("  1 s   : ring of %lu blocks (%u days)\n", (unsigned long)log.ringBlocks,
+                   (unsigned)HISTORY_LOG_RAW_DAYS);
+    } else {
+        out.println("  1 s   : kept without limit");
+    }
+    static const char* const NAMES[RES_COUNT] = {"1 min", "1 h  "};
+    for (int r = 0; r < RES_COUNT; r++) {
+        if (RESOLUTIONS[r].days) {
+            out.printf("  %s : %lu summaries, %u days\n", NAMES[r], (unsigned long)s.summaries[r],
+                       (unsigned)RESOLUTIONS[r].days);
+        } else {
+            out.printf("  %s : %lu summaries, kept without limit\n", NAMES[r], (unsigned long)s.summaries[r]);
+        }
+    }
+    out.printf("  %lu sector writes, %lu write errors\n", (unsigned long)s.sectorWrites,
+               (unsigned long)s.writeErrors);
+}
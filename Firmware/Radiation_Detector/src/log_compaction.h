@@ -0,0 +1,53 @@
+#ifndef LOG_COMPACTION_H
+#define LOG_COMPACTION_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Compaction of the history log (history_log.h) into lower
+// resolutions. A background job (job_wheel.h, "log compact") reads the synced
+// 1 s blocks in order and folds them into 1-minute and then 1-hour summaries
+// (log_summary.h): total counts, live seconds, min/max per-second count and
+// the or-ed flags, 20 bytes each (the HistoryBucket of the RAM store). They go
+// to HISTORY_LOG_PATH ".1m" and ".1h", 24 per 512-byte CRC-protected sector,
+// on the card or on LittleFS when the log is in flash (log_storage.h).
+//
+// Each step, every HISTORY_COMPACT_STEP_MS, reads one 1 s block and writes
+// the summary sectors it fills (normally none), so a backlog (a log written
+// before compaction existed, a long logger-mode batch) is worked off at a few
+// blocks per second and a step holds the medium only for those transfers. The
+// job runs at idle+1 on the network core; counting, the UI and the logger
+// task never wait for it.
+//
+// Retention is per resolution (HISTORY_LOG_RAW_DAYS, _MINUTE_DAYS,
+// _HOUR_DAYS): every file is a ring (log_ring.h) that reuses its oldest
+// sectors in order once full, so space is reclaimed by sequential whole-sector
+// overwrites and nothing is deleted or moved. A sector not yet full is
+// rewritten in place every HISTORY_COMPACT_SYNC_S. Each sector records the 1 s
+// sequence its summaries reach; after a reset compaction resumes there and
+// rebuilds the open buckets from the 1 s log.
+
+struct LogCompactionStats {
+    bool running;              ///< Summary files open, the job stepping
+    uint32_t compacted;        ///< 1 s records folded in since boot
+    uint32_t position;         ///< Sequence of the next 1 s record to read
+    uint32_t skipped;          ///< 1 s records reused before they were compacted
+    uint32_t summaries[2];     ///< Stored 1-minute, 1-hour summaries
+    uint32_t sectorWrites;
+    uint32_t writeErrors;
+};
+
+// Adds the compaction job; after initHistoryLog() opened the log.
+bool initLogCompaction();
+
+// Streams the stored summaries of @p seconds (60 or 3600) whose start lies in
+// [fromTs, toTs] as CSV ("start,counts,min_cps,max_cps,seconds,flags"),
+// oldest first. Returns the number of summaries written.
+size_t exportLogSummaryCsv(Print& out, uint32_t seconds, uint32_t fromTs = 0, uint32_t toTs = UINT32_MAX);
+
+LogCompactionStats getLogCompactionStats();
+
+// Status and retention ("logcompact" serial command).
+void printLogCompaction(Print& out);
+
+#endif // LOG_COMPACTION_H
@@ -0,0 +1,74 @@
+#ifndef LOG_RING_H
+#define LOG_RING_H
+
+#include <stdint.h>
+
+// Position of the writer in a file of fixed sector slots used as a ring: the
+// history log (history_log.h) and its summaries (log_compaction.h). Sectors
+// are appended until the ring holds its capacity, then the oldest ones are
+// reused in order, so the card sees one sequential stream of whole-sector
+// writes and nothing is ever deleted or moved. Every sector carries the
+// sequence number of its first entry and its own CRC, which is all a reader
+// needs to find the newest lap after a reset:
+//   - slot 0 newer than the last slot: the ring has wrapped; the slots run
+//     newest lap, then previous lap, and the boundary is found by bisection;
+//   - slot 0 invalid (a torn write right after wrapping): the newest sector
+//     is the last slot;
+//   - otherwise the file has not wrapped and ends in at most a few torn
+//     sectors, which are walked back over.
+// Writes run front to back, so a power cut leaves torn sectors only at the
+// boundary. No Arduino dependencies (host-compilable).
+
+struct LogRingScan {
+    uint32_t head;      ///< Slot the next sector goes to (may equal the slot count)
+    uint32_t stored;    ///< Sectors in use: every slot once wrapped (readers skip invalid ones), else head
+    bool wrapped;       ///< The slots from head on hold the previous lap
+    uint32_t discarded; ///< Torn or invalid sectors at the boundary
+};
+
+/**
+ * @brief Finds the writer's position in a ring of @p slots sectors.
+ * @param tailScan  Torn sectors walked back over at the end of an unwrapped file
+ * @param sequenceOf bool(uint32_t slot, uint32_t* sequence): reads a slot;
+ *                   false if it is not a valid sector
+ */
+template <typename SequenceOf>
+LogRingScan logRingScan(uint32_t slots, uint32_t tailScan, SequenceOf sequenceOf) {
+    LogRingScan scan = {0, 0, false, 0};
+    if (slots == 0) return scan;
+
+    uint32_t first = 0, last = 0;
+    bool firstValid = sequenceOf(0, &first);
+    bool lastValid = slots > 1 ? sequenceOf(slots - 1, &last) : false;
+    if (firstValid && lastValid && last < first) {
+        // Smallest slot that is invalid or older than slot 0
+        uint32_t lo = 1, hi = slots - 1;
+        while (lo < hi) {
+            uint32_t mid = lo + (hi - lo) / 2;
+            uint32_t sequence;
+            if (!sequenceOf(mid, &sequence) || sequence < first) hi = mid;
+            else lo = mid + 1;
+        }
+        uint32_t sequence;
+        if (!sequenceOf(lo, &sequence)) scan.discarded++;
+        scan.head = lo;
+        scan.stored = slots;
+        scan.wrapped = true;
+    } else if (!firstValid && lastValid) {
+        scan.head = 0;
+        scan.stored = slots;
+        scan.wrapped = true;
+        scan.discarded = 1;
+    } else {
+        scan.head = slots;
+        uint32_t sequence;
+        while (scan.head > 0 && scan.discarded < tailScan && !sequenceOf(scan.head - 1, &sequence)) {
+            scan.head--;
+            scan.discarded++;
+        }
+        scan.stored = scan.head;
+    }
+    return scan;
+}
+
+#endif // LOG_RING_H
@@ -0,0 +1,139 @@
+/**
+ * @file log_storage.cpp
+ * @brief Selection of the history log's medium and the storage benchmark.
+ */
+
+#include "log_storage.h"
+#include "debug.h"
+#include "esp_heap_caps.h"
+#include "esp_random.h"
+#include "esp_timer.h"
+
+static LogStorage* selected = nullptr;
+
+LogStorage* initLogStorage() {
+    if (selected) return selected;
+    LogStorage* const candidates[] = {&sdLogStorage(), &partitionLogStorage(), &littleFsLogStorage()};
+    for (LogStorage* candidate : candidates) {
+        if (HISTORY_LOG_STORAGE != LOG_STORAGE_AUTO && candidate->kind() != HISTORY_LOG_STORAGE) continue;
+        if (candidate->begin()) {
+            selected = candidate;
+            break;
+        }
+    }
+    DEBUG_PRINTF("Log storage: %s\n", selected ? selected->name() : "none");
+    return selected;
+}
+
+LogStorage* logStorage() {
+    return selected;
+}
+
+/**
+ * @brief Writes @p sectors from sector 0 on in chunks of the logger's write size, then syncs.
+ * @return Elapsed microseconds, or -1 on a failed write
+ */
+static int64_t benchLap(LogStorage& storage, const uint8_t* data, uint32_t sectors, uint32_t chunkSectors) {
+    int64_t start = esp_timer_get_time();
+    for (uint32_t sector = 0; sector < sectors; sector += chunkSectors) {
+        if (!storage.write(sector, data, chunkSectors)) return -1;
+    }
+    if (!storage.sync()) return -1;
+    return esp_timer_get_time() - start;
+}
+
+/**
+ * @brief Measures one backend on its scratch target and prints the results.
+ */
+static void benchStorage(Print& out, LogStorage& storage, uint8_t* data) {
+    static const uint32_t LAP_SECTORS = 512;   ///< 256 KB
+    static const uint32_t CHUNK_SECTORS = HISTORY_LOG_WRITE_CHUNK / LOG_STORAGE_SECTOR;
+    static const uint32_t READS = 200;
+
+    if (storage.capacity() < LAP_SECTORS) {
+        out.printf("  %-16s too small for the benchmark\n", storage.name());
+        return;
+    }
+    LogStorageCounters before = storage.counters();
+    int64_t firstLap = benchLap(storage, data, LAP_SECTORS, CHUNK_SECTORS);
+    LogStorageCounters between = storage.counters();
+    int64_t secondLap = firstLap < 0 ? -1 : benchLap(storage, data, LAP_SECTORS, CHUNK_SECTORS);
+    LogStorageCounters after = storage.counters();
+    if (secondLap < 0) {
+        out.printf("  %-16s write failed\n", storage.name());
+        return;
+    }
+
+    int64_t readTotal = 0, readLongest = 0;
+    for (uint32_t i = 0; i < READS; i++) {
+        int64_t start = esp_timer_get_time();
+        if (!storage.read(esp_random() % LAP_SECTORS, data, 1)) {
+            out.printf("  %-16s read failed\n", storage.name());
+            return;
+        }
+        int64_t elapsed = esp_timer_get_time() - start;
+        readTotal += elapsed;
+        if (elapsed > readLongest) readLongest = elapsed;
+    }
+
+    double lapMb = LAP_SECTORS * LOG_STORAGE_SECTOR / 1048576.0;
+    out.printf("  %-16s append %6.2f MB/s, second lap %6.2f MB/s, random read %5lu us mean, %6lu us max\n",
+               storage.name(), lapMb / (firstLap / 1e6), lapMb / (secondLap / 1e6),
+               (unsigned long)(readTotal / READS), (unsigned long)readLongest);
+    if (after.physical) {
+        // The second lap is what a wrapped ring costs on every block
+        uint64_t logical = after.logicalBytes - between.logicalBytes;
+        out.printf("  %-16s write amplification %.2f first lap, %.2f second lap, %lu KB erased\n", "",
+                   (double)(between.programmedBytes - before.programmedBytes) /
+                       (double)(between.logicalBytes - before.logicalBytes),
+                   (double)(after.programmedBytes - between.programmedBytes) / (double)logical,
+                   (unsigned long)((after.erasedBytes - before.erasedBytes) / 1024));
+    } else {
+        out.printf("  %-16s write amplification not visible (%s)\n", "",
+                   storage.kind() == LOG_STORAGE_SD ? "inside the card"
+                                                    : "needs CONFIG_SPI_FLASH_ENABLE_COUNTERS");
+    }
+}
+
+bool logStorageBenchmark(Print& out) {
+    static const char* BENCH_PATH = HISTORY_LOG_PATH ".bench";
+    uint8_t* data = (uint8_t*)heap_caps_malloc(HISTORY_LOG_WRITE_CHUNK, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!data) data = (uint8_t*)heap_caps_malloc(HISTORY_LOG_WRITE_CHUNK, MALLOC_CAP_8BIT);
+    if (!data) {
+        out.println("Storage benchmark: no buffer");
+        return false;
+    }
+    for (size_t i = 0; i < HISTORY_LOG_WRITE_CHUNK; i++) data[i] = (uint8_t)i;
+
+    out.printf("Storage benchmark: 256 KB laps in %u KB writes, 200 random 512 B reads; log on %s\n",
+               (unsigned)(HISTORY_LOG_WRITE_CHUNK / 1024), selected ? selected->name() : "none");
+    const LogStorageKind kinds[] = {LOG_STORAGE_SD, LOG_STORAGE_PARTITION, LOG_STORAGE_LITTLEFS};
+    for (LogStorageKind kind : kinds) {
+        if (kind == LOG_STORAGE_PARTITION) {
+            LogStorage& partition = partitionLogStorage();
+            if (selected == &partition) {
+                out.printf("  %-16s holds the log, not measured\n", partition.name());
+            } else if (!partition.begin()) {
+                out.printf("  %-16s no " HISTORY_LOG_PARTITION " partition\n", partition.name());
+            } else {
+                // The scratch area is the partition itself; what it held is overwritten
+                benchStorage(out, partition, data);
+            }
+            continue;
+        }
+        LogStorage* scratch = newFileLogStorage(kind, BENCH_PATH);
+        if (!scratch) continue;
+        if (scratch->begin()) {
+            benchStorage(out, *scratch, data);
+            scratch->end();
+            scratch->filesBegin();
+            scratch->files()->remove(BENCH_PATH);
+            scratch->filesEnd();
+        } else {
+            out.printf("  %-16s not available\n", scratch->name());
+        }
+        delete scratch;
+    }
+    heap_caps_free(data);
+    return true;
+}
@@ -0,0 +1,121 @@
+#ifndef LOG_STORAGE_H
+#define LOG_STORAGE_H
+
+#include <Arduino.h>
+#include <FS.h>
+#include "config.h"
+
+// Media the history log (history_log.h) can live on. The log only sees this
+// interface: 512-byte sectors, sector 0 its file header and sector k+1 block
+// slot k, written in whole sectors by the logger task and read by any task.
+// The backends:
+//  - SD (log_storage_file.cpp): HISTORY_LOG_PATH on the microSD card, on the
+//    display's SPI bus (every access holds it via spi_bus.h, writes in
+//    HISTORY_LOG_SPI_SLICE pieces) or on SDMMC;
+//  - flash partition (log_storage_partition.cpp): the raw data partition
+//    HISTORY_LOG_PARTITION, without a file system. Its 4 KB erase sectors are
+//    erased as the ring reaches them, so a lap costs one erase per 8 sectors;
+//    a rewrite in the middle of an erase sector (a torn block, the slots next
+//    to the file header) reads, erases and rewrites the erase sector;
+//  - LittleFS (log_storage_file.cpp): HISTORY_LOG_PATH on the internal
+//    LittleFS partition, sharing it with the telemetry queue, spectrum
+//    sessions and pulse traces, of which HISTORY_LOG_FLASH_RESERVE stays free.
+// HISTORY_LOG_STORAGE picks one, or the first that starts in that order. On
+// internal flash every write stalls the flash cache, so the pulse path's
+// latency ("latency") and the flash's wear ("storagebench") decide whether a
+// unit without a card should log at all.
+//
+// A backend also names the file system for the log's companion files (the
+// summaries of log_compaction.h): the card, or LittleFS for both flash
+// backends.
+
+enum LogStorageKind {
+    LOG_STORAGE_AUTO = 0,
+    LOG_STORAGE_SD = 1,
+    LOG_STORAGE_PARTITION = 2,
+    LOG_STORAGE_LITTLEFS = 3
+};
+
+static const size_t LOG_STORAGE_SECTOR = 512;
+
+// Bytes handed to write() against bytes the medium was programmed and erased
+// with, where the backend can see them: exact for the partition, for LittleFS
+// only with CONFIG_SPI_FLASH_ENABLE_COUNTERS, never inside an SD card.
+struct LogStorageCounters {
+    uint64_t logicalBytes;
+    uint64_t programmedBytes;
+    uint64_t erasedBytes;
+    bool physical;          ///< The programmed and erased bytes are measured
+};
+
+class LogStorage {
+public:
+    virtual ~LogStorage() {}
+    virtual LogStorageKind kind() const = 0;
+    virtual const char* name() const = 0;
+
+    /// Mounts the medium and opens the log on it; false if the unit lacks it.
+    virtual bool begin() = 0;
+
+    /// Closes the log (a benchmark's scratch target); the medium stays mounted.
+    virtual void end() = 0;
+
+    /// Sectors the log may use, header included (UINT32_MAX: no limit but HISTORY_LOG_RAW_DAYS).
+    virtual uint32_t capacity() = 0;
+
+    /// Sectors that may hold data: the file length, or the written part of a partition.
+    virtual uint32_t extent() = 0;
+
+    /// Starts an empty log. A file is kept as its path + @p keptSuffix
+    /// (nullptr: removed); the partition is erased.
+    virtual bool reset(const char* keptSuffix) = 0;
+
+    virtual bool read(uint32_t sector, void* data, uint32_t count) = 0;
+    virtual bool write(uint32_t sector, const void* data, uint32_t count) = 0;
+
+    /// Makes the writes so far durable.
+    virtual bool sync() = 0;
+
+    /// File system for companion files (nullptr: none), used between filesBegin() and filesEnd().
+    virtual fs::FS* files() = 0;
+    virtual void filesBegin() {}
+    virtual void filesEnd() {}
+
+    LogStorageCounters counters() const { return counters_; }
+
+protected:
+    LogStorageCounters counters_ = {0, 0, 0, false};
+};
+
+// The backends, one instance each on the log's own path or partition.
+LogStorage& sdLogStorage();
+LogStorage& partitionLogStorage();
+LogStorage& littleFsLogStorage();
+
+// Another file on the card or on LittleFS (a benchmark's scratch target); delete it after end().
+LogStorage* newFileLogStorage(LogStorageKind kind, const char* path);
+
+// Starts the backend HISTORY_LOG_STORAGE selects, or the first available one
+// (SD, partition, LittleFS). nullptr if none started.
+LogStorage* initLogStorage();
+
+// The backend initLogStorage() started; nullptr before or without one.
+LogStorage* logStorage();
+
+// Sequential append, a second lap over the same sectors (the steady state of
+// the ring), random single-sector reads and write amplification, on a scratch
+// file of each backend the unit has ("storagebench"). The partition is only
+// measured while the log is elsewhere, as the scratch area is the partition.
+bool logStorageBenchmark(Print& out);
+
+// The microSD card for other users (spectrum sessions, survey log, pulse
+// traces, firmware updates), whichever medium the log is on. sdCardMount()
+// mounts it once, if the log did not. Accesses run between sdCardBegin() and
+// sdCardEnd(), which hold the SPI bus when the card is on it.
+bool sdCardMount();
+bool sdCardMounted();
+fs::FS& sdCardFs();
+void sdCardBegin();
+void sdCardEnd();
+
+#endif // LOG_STORAGE_H
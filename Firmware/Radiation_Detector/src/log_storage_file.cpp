@@ -0,0 +1,281 @@
+/**
+ * @file log_storage_file.cpp
+ * @brief History log backends on a file: the microSD card and LittleFS.
+ *
+ * One handle serves the writer and every reader: each access seeks first and
+ * holds the backend's mutex, so an export never disturbs the writer's
+ * position. A separate read handle would not do on FAT, where a handle sees
+ * the file length as it was when it was opened.
+ *
+ * On the SPI card every access also holds the bus (spi_bus.h), which waits
+ * out any display DMA in flight, and moves HISTORY_LOG_SPI_SLICE bytes at a
+ * time with the bus released in between, so a display flush waits for one
+ * slice and not a whole chunk.
+ */
+
+#include "log_storage.h"
+#include "debug.h"
+#include "spi_bus.h"
+#include <SD.h>
+#include <SD_MMC.h>
+#include <LittleFS.h>
+#if !HEADLESS
+#include <TFT_eSPI.h>
+#endif
+#if CONFIG_SPI_FLASH_ENABLE_COUNTERS
+#include "esp_spi_flash.h"
+#endif
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+static bool cardMounted = false;
+
+// Once: SPI on the display's bus, SPI alone in the headless build, or SDMMC
+bool sdCardMount() {
+    if (cardMounted) return true;
+    sdCardBegin();
+#if HISTORY_LOG_SDMMC
+    bool oneBit = SDMMC_D1_PIN < 0 || SDMMC_D2_PIN < 0 || SDMMC_D3_PIN < 0;
+    cardMounted = SD_MMC.setPins(SDMMC_CLK_PIN, SDMMC_CMD_PIN, SDMMC_D0_PIN,
+                                 SDMMC_D1_PIN, SDMMC_D2_PIN, SDMMC_D3_PIN) &&
+                  SD_MMC.begin("/sdcard", oneBit, false, SDMMC_FREQ_KHZ);
+#elif HEADLESS
+    // No panel: the card has the bus to itself, started here
+    SPI.begin(SD_SCLK_PIN, SD_MISO_PIN, SD_MOSI_PIN);
+    cardMounted = SD.begin(SD_CS_PIN, SPI, SD_SPI_FREQUENCY);
+#else
+    cardMounted = SD.begin(SD_CS_PIN, TFT_eSPI::getSPIinstance(), SD_SPI_FREQUENCY);
+#endif
+    sdCardEnd();
+    if (!cardMounted) DEBUG_PRINTLN("Log storage: SD card not found");
+    return cardMounted;
+}
+
+#if CONFIG_SPI_FLASH_ENABLE_COUNTERS
+/**
+ * @brief Adds the flash bytes programmed and erased since @p before to the counters.
+ */
+static void addFlashCounters(LogStorageCounters& counters, const spi_flash_counters_t& before) {
+    const spi_flash_counters_t* now = spi_flash_get_counters();
+    counters.programmedBytes += now->write.bytes - before.write.bytes;
+    counters.erasedBytes += now->erase.bytes - before.erase.bytes;
+}
+#endif
+
+class FileLogStorage : public LogStorage {
+public:
+    FileLogStorage(LogStorageKind kind, const char* path)
+        : kind_(kind), path_(path), mutex_(nullptr), capacity_(UINT32_MAX) {}
+
+    ~FileLogStorage() override {
+        if (mutex_) vSemaphoreDelete(mutex_);
+    }
+
+    LogStorageKind kind() const override { return kind_; }
+
+    const char* name() const override {
+        if (kind_ == LOG_STORAGE_LITTLEFS) return "LittleFS";
+        return HISTORY_LOG_SDMMC ? "SD card (SDMMC)" : "SD card (SPI)";
+    }
+
+    bool begin() override {
+        if (!mutex_) mutex_ = xSemaphoreCreateMutex();
+        if (!mutex_) return false;
+        if (kind_ == LOG_STORAGE_SD ? !sdCardMount() : !LittleFS.begin(true)) return false;
+
+        filesBegin();
+        bool exists = fs().exists(path_);
+        file_ = fs().open(path_, exists ? "r+" : "w+");
+        size_t size = file_ ? file_.size() : 0;
+        filesEnd();
+        if (!file_) {
+            DEBUG_PRINTF("Log storage: cannot open %s on %s\n", path_, name());
+            return false;
+        }
+        if (kind_ == LOG_STORAGE_LITTLEFS) {
+            // What is free now plus what the log already holds, less the other users' share
+            size_t free = LittleFS.totalBytes() - LittleFS.usedBytes() + size;
+            capacity_ = free > HISTORY_LOG_FLASH_RESERVE ? (free - HISTORY_LOG_FLASH_RESERVE) / LOG_STORAGE_SECTOR : 0;
+        }
+#if CONFIG_SPI_FLASH_ENABLE_COUNTERS
+        counters_.physical = kind_ == LOG_STORAGE_LITTLEFS;
+#endif
+        return true;
+    }
+
+    void end() override {
+        if (!mutex_) return;
+        xSemaphoreTake(mutex_, portMAX_DELAY);
+        filesBegin();
+        if (file_) file_.close();
+        filesEnd();
+        xSemaphoreGive(mutex_);
+    }
+
+    uint32_t capacity() override { return capacity_; }
+
+    uint32_t extent() override {
+        xSemaphoreTake(mutex_, portMAX_DELAY);
+        filesBegin();
+        size_t size = file_ ? file_.size() : 0;
+        filesEnd();
+        xSemaphoreGive(mutex_);
+        // A partial last sector counts; reading it fails like a torn block
+        return (size + LOG_STORAGE_SECTOR - 1) / LOG_STORAGE_SECTOR;
+    }
+
+    bool reset(const char* keptSuffix) override {
+        xSemaphoreTake(mutex_, portMAX_DELAY);
+        filesBegin();
+        size_t size = file_ ? file_.size() : 0;
+        if (file_) file_.close();
+        fs::FS& files = fs();
+        if (size > 0 && keptSuffix) {
+            String kept = String(path_) + keptSuffix;
+            if (files.exists(kept)) files.remove(kept);
+            files.rename(path_, kept);
+        } else if (files.exists(path_)) {
+            files.remove(path_);
+        }
+        file_ = files.open(path_, "w+");
+        bool opened = (bool)file_;
+        filesEnd();
+        xSemaphoreGive(mutex_);
+        return opened;
+    }
+
+    bool read(uint32_t sector, void* data, uint32_t count) override {
+        xSemaphoreTake(mutex_, portMAX_DELAY);
+        filesBegin();
+        size_t length = count * LOG_STORAGE_SECTOR;
+        size_t done = 0;
+        if (file_ && file_.seek((uint64_t)sector * LOG_STORAGE_SECTOR)) {
+            while (done < length) {
+                size_t n = file_.read((uint8_t*)data + done, slice(length - done));
+                done += n;
+                if (n == 0) break;
+                if (done < length) yieldBus();
+            }
+        }
+        filesEnd();
+        xSemaphoreGive(mutex_);
+        return done == length;
+    }
+
+    bool write(uint32_t sector, const void* data, uint32_t count) override {
+        xSemaphoreTake(mutex_, portMAX_DELAY);
+#if CONFIG_SPI_FLASH_ENABLE_COUNTERS
+        spi_flash_counters_t before = *spi_flash_get_counters();
+#endif
+        filesBegin();
+        size_t length = count * LOG_STORAGE_SECTOR;
+        size_t written = 0;
+        if (file_ && file_.seek((uint64_t)sector * LOG_STORAGE_SECTOR)) {
+            while (written < length) {
+                size_t step = slice(length - written);
+                size_t n = file_.write((const uint8_t*)data + written, step);
+                written += n;
+                if (n != step) break;
+                if (written < length) yieldBus();
+            }
+        }
+        filesEnd();
+#if CONFIG_SPI_FLASH_ENABLE_COUNTERS
+        if (counters_.physical) addFlashCounters(counters_, before);
+#endif
+        counters_.logicalBytes += written;
+        xSemaphoreGive(mutex_);
+        return written == length;
+    }
+
+    bool sync() override {
+        xSemaphoreTake(mutex_, portMAX_DELAY);
+#if CONFIG_SPI_FLASH_ENABLE_COUNTERS
+        spi_flash_counters_t before = *spi_flash_get_counters();
+#endif
+        filesBegin();
+        bool open = (bool)file_;
+        if (open) file_.flush();
+        filesEnd();
+#if CONFIG_SPI_FLASH_ENABLE_COUNTERS
+        if (counters_.physical) addFlashCounters(counters_, before);
+#endif
+        xSemaphoreGive(mutex_);
+        return open;
+    }
+
+    fs::FS* files() override { return &fs(); }
+
+    void filesBegin() override {
+        if (kind_ == LOG_STORAGE_SD) sdCardBegin();
+    }
+
+    void filesEnd() override {
+        if (kind_ == LOG_STORAGE_SD) sdCardEnd();
+    }
+
+private:
+    fs::FS& fs() {
+        if (kind_ == LOG_STORAGE_LITTLEFS) return LittleFS;
+        return sdCardFs();
+    }
+
+    /// Bytes moved per bus hold: a slice on the SPI card, everything elsewhere.
+    size_t slice(size_t remaining) const {
+        bool sliced = kind_ == LOG_STORAGE_SD && !HISTORY_LOG_SDMMC;
+        return sliced && remaining > HISTORY_LOG_SPI_SLICE ? HISTORY_LOG_SPI_SLICE : remaining;
+    }
+
+    /// Lets a display flush in between slices.
+    void yieldBus() {
+        if (kind_ != LOG_STORAGE_SD || HISTORY_LOG_SDMMC) return;
+        filesEnd();
+        taskYIELD();
+        filesBegin();
+    }
+
+    LogStorageKind kind_;
+    const char* path_;
+    SemaphoreHandle_t mutex_;
+    uint32_t capacity_;
+    File file_;
+};
+
+LogStorage& sdLogStorage() {
+    static FileLogStorage storage(LOG_STORAGE_SD, HISTORY_LOG_PATH);
+    return storage;
+}
+
+LogStorage& littleFsLogStorage() {
+    static FileLogStorage storage(LOG_STORAGE_LITTLEFS, HISTORY_LOG_PATH);
+    return storage;
+}
+
+LogStorage* newFileLogStorage(LogStorageKind kind, const char* path) {
+    return new FileLogStorage(kind, path);
+}
+
+bool sdCardMounted() {
+    return cardMounted;
+}
+
+fs::FS& sdCardFs() {
+#if HISTORY_LOG_SDMMC
+    return SD_MMC;
+#else
+    return SD;
+#endif
+}
+
+// The SPI card waits for the display; the SDMMC card has its own bus
+void sdCardBegin() {
+#if !HISTORY_LOG_SDMMC
+    spiBusAcquire(SPI_BUS_SD);
+#endif
+}
+
+void sdCardEnd() {
+#if !HISTORY_LOG_SDMMC
+    spiBusRelease();
+#endif
+}
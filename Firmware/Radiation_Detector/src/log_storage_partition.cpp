@@ -0,0 +1,160 @@
+/**
+ * @file log_storage_partition.cpp
+ * @brief History log backend on a raw flash data partition.
+ *
+ * The partition holds the log's sectors at their offsets, without a file
+ * system. NOR flash only clears bits, so a sector must be erased before it is
+ * written again, 4 KB at a time:
+ *   - a write that starts an erase sector erases it first; the ring writes
+ *     front to back, so the rest of that erase sector is still to come;
+ *   - a write into an erase sector that is still erased there is programmed
+ *     directly;
+ *   - anything else (a torn block rewritten after a reset, the slots that
+ *     share erase sector 0 with the file header) reads the erase sector,
+ *     erases it and writes it back with the new sectors in place.
+ * Nothing records how far the log reaches: the written part ends at the first
+ * erase sector whose first sector is still erased, and since every erase
+ * sector the writer has reached starts with a written sector, that is found
+ * by bisection. The ring then finds its head as on a file (log_ring.h).
+ */
+
+#include "log_storage.h"
+#include "debug.h"
+#include <LittleFS.h>
+#include "esp_partition.h"
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+static const uint32_t ERASE_SIZE = 4096; ///< SPI flash sector
+static const uint32_t SECTORS_PER_ERASE = ERASE_SIZE / LOG_STORAGE_SECTOR;
+
+class PartitionLogStorage : public LogStorage {
+public:
+    PartitionLogStorage() : partition_(nullptr), mutex_(nullptr), scratch_(nullptr) {}
+
+    LogStorageKind kind() const override { return LOG_STORAGE_PARTITION; }
+    const char* name() const override { return "flash partition"; }
+
+    bool begin() override {
+        if (partition_) return true;
+        const esp_partition_t* partition =
+            esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, HISTORY_LOG_PARTITION);
+        if (!partition) return false; // Not in this unit's partition table
+        if (partition->size < 2 * ERASE_SIZE || partition->address % ERASE_SIZE) {
+            DEBUG_PRINTLN("Log storage: partition " HISTORY_LOG_PARTITION " is too small or unaligned");
+            return false;
+        }
+        mutex_ = xSemaphoreCreateMutex();
+        scratch_ = (uint8_t*)heap_caps_malloc(ERASE_SIZE, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        if (!mutex_ || !scratch_) return false;
+        partition_ = partition;
+        counters_.physical = true;
+        return true;
+    }
+
+    void end() override {}
+
+    uint32_t capacity() override { return partition_ ? partition_->size / LOG_STORAGE_SECTOR : 0; }
+
+    uint32_t extent() override {
+        if (!partition_ || sectorErased(0)) return 0;
+        uint32_t lo = 1, hi = partition_->size / ERASE_SIZE;
+        while (lo < hi) {
+            uint32_t mid = lo + (hi - lo) / 2;
+            if (sectorErased(mid * SECTORS_PER_ERASE)) hi = mid;
+            else lo = mid + 1;
+        }
+        return lo * SECTORS_PER_ERASE;
+    }
+
+    bool reset(const char* keptSuffix) override {
+        // Old blocks left anywhere would be taken for the newest lap: erase it all
+        xSemaphoreTake(mutex_, portMAX_DELAY);
+        bool erased = esp_partition_erase_range(partition_, 0, partition_->size) == ESP_OK;
+        if (erased) counters_.erasedBytes += partition_->size;
+        xSemaphoreGive(mutex_);
+        return erased;
+    }
+
+    bool read(uint32_t sector, void* data, uint32_t count) override {
+        if (!partition_ || (uint64_t)(sector + count) * LOG_STORAGE_SECTOR > partition_->size) return false;
+        xSemaphoreTake(mutex_, portMAX_DELAY);
+        bool read = esp_partition_read(partition_, sector * LOG_STORAGE_SECTOR, data,
+                                       count * LOG_STORAGE_SECTOR) == ESP_OK;
+        xSemaphoreGive(mutex_);
+        return read;
+    }
+
+    bool write(uint32_t sector, const void* data, uint32_t count) override {
+        if (!partition_ || (uint64_t)(sector + count) * LOG_STORAGE_SECTOR > partition_->size) return false;
+        xSemaphoreTake(mutex_, portMAX_DELAY);
+        const uint8_t* bytes = (const uint8_t*)data;
+        bool ok = true;
+        while (count > 0 && ok) {
+            // The part of the write inside one erase sector
+            uint32_t offset = sector % SECTORS_PER_ERASE;
+            uint32_t n = SECTORS_PER_ERASE - offset < count ? SECTORS_PER_ERASE - offset : count;
+            ok = writeInEraseSector(sector, bytes, n);
+            sector += n;
+            bytes += n * LOG_STORAGE_SECTOR;
+            count -= n;
+        }
+        xSemaphoreGive(mutex_);
+        return ok;
+    }
+
+    bool sync() override { return partition_ != nullptr; } // Programmed flash is durable
+
+    fs::FS* files() override { return LittleFS.begin(true) ? &LittleFS : nullptr; }
+
+private:
+    bool sectorErased(uint32_t sector) {
+        uint32_t word = 0;
+        return esp_partition_read(partition_, sector * LOG_STORAGE_SECTOR, &word, sizeof(word)) == ESP_OK &&
+               word == UINT32_MAX;
+    }
+
+    /**
+     * @brief Writes @p n sectors that lie in one erase sector. Mutex held.
+     */
+    bool writeInEraseSector(uint32_t sector, const uint8_t* data, uint32_t n) {
+        uint32_t address = sector * LOG_STORAGE_SECTOR;
+        uint32_t length = n * LOG_STORAGE_SECTOR;
+        uint32_t eraseStart = address - address % ERASE_SIZE;
+        counters_.logicalBytes += length;
+
+        if (address == eraseStart) {
+            if (esp_partition_erase_range(partition_, eraseStart, ERASE_SIZE) != ESP_OK) return false;
+            counters_.erasedBytes += ERASE_SIZE;
+            return program(address, data, length);
+        }
+        if (esp_partition_read(partition_, eraseStart, scratch_, ERASE_SIZE) != ESP_OK) return false;
+        bool erased = true;
+        for (uint32_t i = address - eraseStart; i < address - eraseStart + length && erased; i++) {
+            erased = scratch_[i] == 0xFF;
+        }
+        if (erased) return program(address, data, length);
+
+        // Read-modify-write: the other sectors of the erase sector go back as they were
+        memcpy(scratch_ + (address - eraseStart), data, length);
+        if (esp_partition_erase_range(partition_, eraseStart, ERASE_SIZE) != ESP_OK) return false;
+        counters_.erasedBytes += ERASE_SIZE;
+        return program(eraseStart, scratch_, ERASE_SIZE);
+    }
+
+    bool program(uint32_t address, const void* data, uint32_t length) {
+        if (esp_partition_write(partition_, address, data, length) != ESP_OK) return false;
+        counters_.programmedBytes += length;
+        return true;
+    }
+
+    const esp_partition_t* partition_;
+    SemaphoreHandle_t mutex_;
+    uint8_t* scratch_; ///< One erase sector, internal RAM (flash writes run with the cache off)
+};
+
+LogStorage& partitionLogStorage() {
+    static PartitionLogStorage storage;
+    return storage;
+}
@@ -0,0 +1,82 @@
+#ifndef LOG_SUMMARY_H
+#define LOG_SUMMARY_H
+
+#include <stdint.h>
+#include "history_store.h" // HistoryBucket
+#include "log_codec.h"     // LogRecord, LogRecordFlags
+
+// One resolution of the compacted history log (log_compaction.h). Parts (1 s
+// records, or the closed summaries of the finer resolution) are folded into
+// the bucket of `seconds` they start in; a part in another bucket closes the
+// open one. Timestamps restart at every boot, so a part that goes back in
+// time, carries LOG_FLAG_BOOT or changes between uptime and UTC
+// (LOG_FLAG_TIME_VALID) closes it as well and never merges into the last
+// bucket of another time base. The other flags are or-ed.
+//
+// Every summary also records the range of log sequence numbers it was built
+// from: its end is where compaction resumes after a reset, and rebuilding
+// from an earlier sequence gives the same buckets, so the ones already stored
+// are recognised by their source and skipped.
+// No Arduino dependencies (host-compilable).
+
+struct LogSummary {
+    HistoryBucket bucket;
+    uint32_t firstSource; ///< Sequence of the first 1 s record folded in
+    uint32_t endSource;   ///< Sequence after the last one
+};
+
+class LogSummaryLevel {
+public:
+    explicit LogSummaryLevel(uint32_t seconds) : seconds_(seconds), open_(false) {}
+
+    uint32_t seconds() const { return seconds_; }
+
+    /// Forgets the open bucket (compaction restarts from a stored position).
+    void reset() { open_ = false; }
+
+    /// Folds a 1 s log record in. @return true if that closed a bucket into @p closed
+    bool add(const LogRecord& record, LogSummary* closed) {
+        HistoryBucket part;
+        part.startTime = record.timestamp;
+        part.counts = record.counts;
+        part.seconds = record.seconds;
+        part.minCps = part.maxCps = record.seconds > 1 ? record.counts / record.seconds : record.counts;
+        part.flags = record.flags;
+        return add(part, record.sequence, record.sequence + 1, closed);
+    }
+
+    /// Folds a finer summary in. @return true if that closed a bucket into @p closed
+    bool add(const LogSummary& summary, LogSummary* closed) {
+        return add(summary.bucket, summary.firstSource, summary.endSource, closed);
+    }
+
+private:
+    bool add(const HistoryBucket& part, uint32_t firstSource, uint32_t endSource, LogSummary* closed) {
+        uint32_t start = part.startTime - part.startTime % seconds_;
+        bool closing = open_ && (start != summary_.bucket.startTime ||
+                                 (part.flags & LOG_FLAG_BOOT) ||
+                                 ((part.flags ^ summary_.bucket.flags) & LOG_FLAG_TIME_VALID));
+        if (closing) *closed = summary_;
+        if (!open_ || closing) {
+            summary_.bucket = part;
+            summary_.bucket.startTime = start;
+            summary_.firstSource = firstSource;
+            open_ = true;
+        } else {
+            HistoryBucket& b = summary_.bucket;
+            b.counts += part.counts;
+            b.seconds += part.seconds;
+            if (part.minCps < b.minCps) b.minCps = part.minCps;
+            if (part.maxCps > b.maxCps) b.maxCps = part.maxCps;
+            b.flags |= part.flags;
+        }
+        summary_.endSource = endSource;
+        return closing;
+    }
+
+    uint32_t seconds_;
+    bool open_;
+    LogSummary summary_;
+};
+
+#endif // LOG_SUMMARY_H
@@ -0,0 +1,409 @@
+/**
+ * @file logger_mode.cpp
+ * @brief Deep-sleep logger: the ULP program's host side, the batch wake path,
+ *        the backlog file and its replay.
+ *
+ * The state that must outlive deep sleep is in RTC memory (loggerRtc); the ULP
+ * ring and counters are the ulp_* globals of ulp/logger_ulp.c. Everything here
+ * runs on loopTask, or in setup() before any task exists.
+ */
+
+#include "logger_mode.h"
+#include "device_config.h"
+#include "history_log.h"
+#include "telemetry.h"
+#include "time_base.h"
+#include "debug.h"
+#include "log_codec.h"
+#include <LittleFS.h>
+#include <math.h>
+#include "esp_attr.h"
+#include "esp_sleep.h"
+#include "esp_system.h"
+#if LOGGER_ULP_AVAILABLE
+#include "esp_rtc_time.h"
+#include "driver/rtc_io.h"
+#include "ulp_riscv.h"
+#include "ulp_logger.h"   // ulp_* globals, generated by ulp_embed_binary
+#endif
+
+static const uint32_t LOGGER_RTC_MAGIC = 0x52474F4C;   ///< "LOGR"
+static const uint32_t ULP_NOMINAL_HZ = 17500000;       ///< RC_FAST; corrected at every batch wake
+static const float MAX_CORRECTION = 0.1f;              ///< Per calibration step
+static const size_t REPLAY_CHUNK = 24;                 ///< Per loop() pass: inside the log and telemetry queues
+
+#if LOGGER_ULP_AVAILABLE
+extern const uint8_t ulpLoggerStart[] asm("_binary_ulp_logger_bin_start");
+extern const uint8_t ulpLoggerEnd[] asm("_binary_ulp_logger_bin_end");
+static_assert(LOGGER_ULP_RING == 128, "RING_SIZE in ulp/logger_ulp.c");
+#endif
+static_assert(LOGGER_BATCH_INTERVALS < LOGGER_ULP_RING, "The ring must hold a batch and the intervals closed while it is stored");
+
+/// Kept in RTC memory; survives deep sleep and soft resets
+struct LoggerRtc {
+    uint32_t magic;
+    uint32_t size;                 ///< sizeof(LoggerRtc): a changed layout starts over
+    bool active;
+    bool utcValid;                 ///< At entry
+    uint32_t intervalS;
+    uint32_t alarmCounts;
+    uint32_t cyclesPerInterval;
+    float intervalUs;              ///< Measured length of an interval
+    int64_t utcUsAtEntry;
+    uint64_t rtcUsAtEntry;
+    uint64_t boundaryRtcUs;        ///< RTC time of the last known interval boundary
+    uint32_t boundaryHead;         ///< ULP head then
+    uint32_t intervals;            ///< Stored since entry (also the next record's sequence)
+    uint32_t wakes;
+    uint32_t batches;
+    float intervalError;
+    uint32_t replayedBytes;        ///< Of the backlog file
+    uint64_t wakeRtcUs;            ///< RTC time of the scheduled wake; 0: none
+};
+
+RTC_NOINIT_ATTR static LoggerRtc loggerRtc;
+
+static LoggerSleepHook sleepHook = nullptr;
+static uint8_t wake = LOGGER_WAKE_NONE;
+static uint32_t bootMs = 0;
+static uint32_t replayed = 0;
+static bool replayDone = false;   ///< Backlog empty; set again by a drain
+static double replay1h = -1.0;     ///< µSv/h averages of the replayed intervals, < 0 before the first
+static double replay24h = -1.0;
+
+#if LOGGER_ULP_AVAILABLE
+
+static uint32_t& ulpRing(uint32_t index) {
+    return (&ulp_ring)[index % LOGGER_ULP_RING];
+}
+
+/**
+ * @brief Timestamp of interval @p k of a drain ending at @p nowUs with @p head closed.
+ */
+static LogRecord intervalRecord(uint32_t k, uint32_t head, uint64_t nowUs, uint32_t counts) {
+    LogRecord record;
+    double startUs = (double)nowUs - (double)(head - k) * loggerRtc.intervalUs;
+    double sinceEntryUs = startUs - (double)loggerRtc.rtcUsAtEntry;
+    if (sinceEntryUs < 0.0) sinceEntryUs = 0.0;
+    record.timestamp = loggerRtc.utcValid ? (uint32_t)((loggerRtc.utcUsAtEntry + (int64_t)sinceEntryUs) / 1000000)
+                                          : (uint32_t)(sinceEntryUs / 1e6);
+    record.counts = counts;
+    record.seconds = (uint16_t)loggerRtc.intervalS;
+    record.flags = (loggerRtc.utcValid ? LOG_FLAG_TIME_VALID : 0) |
+                   (loggerRtc.alarmCounts && counts >= loggerRtc.alarmCounts ? LOG_FLAG_ALARM : 0);
+    record.sequence = loggerRtc.intervals;
+    return record;
+}
+
+/**
+ * @brief Moves the closed intervals from the ULP ring to the backlog file.
+ * @param boundary The wake came right after an interval closed (a batch wake):
+ *        the time since the previous boundary calibrates the ULP clock
+ */
+static void drainUlp(bool boundary) {
+    uint64_t nowUs = esp_rtc_get_time_us();
+    uint32_t head = ulp_head;
+    uint32_t tail = ulp_tail;
+    if (head - tail > LOGGER_ULP_RING) tail = head - LOGGER_ULP_RING; // Not written by our ULP
+
+    if (boundary && head - loggerRtc.boundaryHead >= LOGGER_BATCH_INTERVALS) {
+        float measured = (float)(nowUs - loggerRtc.boundaryRtcUs) / (float)(head - loggerRtc.boundaryHead);
+        float nominal = loggerRtc.intervalS * 1e6f;
+        float ratio = nominal / measured;
+        ratio = fminf(fmaxf(ratio, 1.0f - MAX_CORRECTION), 1.0f + MAX_CORRECTION);
+        loggerRtc.intervalUs = measured;
+        loggerRtc.intervalError = measured / nominal - 1.0f;
+        loggerRtc.cyclesPerInterval = (uint32_t)(loggerRtc.cyclesPerInterval * ratio);
+        ulp_cycles_per_interval = loggerRtc.cyclesPerInterval;
+    }
+    if (boundary) {
+        loggerRtc.boundaryRtcUs = nowUs;
+        loggerRtc.boundaryHead = head;
+    }
+    if (head == tail) return;
+
+    if (LittleFS.begin(true)) {
+        File file = LittleFS.open(LOGGER_BACKLOG_PATH, FILE_APPEND);
+        for (uint32_t k = tail; k != head; k++) {
+            LogRecord record = intervalRecord(k, head, nowUs, ulpRing(k));
+            if (file) file.write((const uint8_t*)&record, sizeof(record));
+            loggerRtc.intervals++;
+        }
+        if (file) file.close();
+        replayDone = false;
+    } else {
+        loggerRtc.intervals += head - tail; // Lost, but keep the sequence
+    }
+    ulp_tail = head;
+}
+
+static void stopUlp() {
+    ulp_riscv_halt();
+    loggerRtc.active = false;
+    loggerRtc.wakeRtcUs = 0;
+}
+
+[[noreturn]] static void sleepNow() {
+    if (sleepHook) sleepHook();
+    esp_sleep_pd_config(ESP_PD_DOMAIN_RTC_PERIPH, ESP_PD_OPTION_ON); // RTC GPIO input
+    esp_sleep_enable_ulp_wakeup();
+    // Backstop: a stalled ULP would otherwise never wake the device
+    uint64_t timerUs = (uint64_t)LOGGER_BATCH_INTERVALS * loggerRtc.intervalS * 2000000ULL;
+    if (loggerRtc.wakeRtcUs) {
+        uint64_t nowUs = esp_rtc_get_time_us();
+        uint64_t untilUs = loggerRtc.wakeRtcUs > nowUs ? loggerRtc.wakeRtcUs - nowUs : 1000;
+        if (untilUs < timerUs) timerUs = untilUs;
+    }
+    esp_sleep_enable_timer_wakeup(timerUs);
+    esp_deep_sleep_start();
+}
+
+#endif // LOGGER_ULP_AVAILABLE
+
+void loggerModeResume() {
+    if (loggerRtc.magic != LOGGER_RTC_MAGIC || loggerRtc.size != sizeof(LoggerRtc)) {
+        memset(&loggerRtc, 0, sizeof(loggerRtc));
+        loggerRtc.magic = LOGGER_RTC_MAGIC;
+        loggerRtc.size = sizeof(LoggerRtc);
+    }
+    bootMs = millis();
+    if (!loggerRtc.active) return;
+#if LOGGER_ULP_AVAILABLE
+    esp_reset_reason_t reason = esp_reset_reason();
+    esp_sleep_wakeup_cause_t cause = esp_sleep_get_wakeup_cause();
+    if (reason != ESP_RST_DEEPSLEEP || (cause != ESP_SLEEP_WAKEUP_ULP && cause != ESP_SLEEP_WAKEUP_TIMER)) {
+        // RTC memory is only intact after a soft reset
+        if (reason != ESP_RST_POWERON && reason != ESP_RST_BROWNOUT) drainUlp(false);
+        stopUlp();
+        wake = LOGGER_WAKE_RESET;
+        return;
+    }
+    loggerRtc.wakes++;
+    bool stalled = ulp_head == ulp_tail; // Nothing closed since the last drain
+    bool alarm = ulp_alarm != 0;
+    drainUlp(cause == ESP_SLEEP_WAKEUP_ULP && !alarm);
+    if (alarm) {
+        ulp_alarm = 0;
+        stopUlp();
+        wake = LOGGER_WAKE_ALARM;
+        return;
+    }
+    // Checked before the stall: the scheduled time may come before any interval closes
+    if (loggerRtc.wakeRtcUs && esp_rtc_get_time_us() + 1000000ULL >= loggerRtc.wakeRtcUs) {
+        loggerRtc.wakeRtcUs = 0;
+        wake = LOGGER_WAKE_SCHEDULED;
+        return;
+    }
+    if (cause == ESP_SLEEP_WAKEUP_TIMER && stalled) {
+        stopUlp();
+        wake = LOGGER_WAKE_STALLED;
+        return;
+    }
+    loggerRtc.batches++;
+    if (LOGGER_UPLOAD_BATCHES && !loggerRtc.wakeRtcUs && loggerRtc.batches % LOGGER_UPLOAD_BATCHES == 0) {
+        wake = LOGGER_WAKE_UPLOAD;
+        return;
+    }
+    sleepNow();
+#else
+    loggerRtc.active = false;
+#endif
+}
+
+void initLoggerMode(LoggerSleepHook hook) {
+    sleepHook = hook;
+    if (wake != LOGGER_WAKE_NONE) {
+        DEBUG_PRINTF("Logger: woken (%s) after %lu intervals\n", loggerWakeName(wake),
+                     (unsigned long)loggerRtc.intervals);
+    }
+}
+
+void loggerModeSetWakeAt(uint32_t utc) {
+#if LOGGER_ULP_AVAILABLE
+    uint32_t now = timeBaseUtcSeconds();
+    if (utc == 0 || !timeBaseUtcValid() || utc <= now) {
+        loggerRtc.wakeRtcUs = 0;
+        return;
+    }
+    loggerRtc.wakeRtcUs = esp_rtc_get_time_us() + (uint64_t)(utc - now) * 1000000ULL;
+#else
+    (void)utc;
+#endif
+}
+
+bool loggerModeActive() {
+    return loggerRtc.active;
+}
+
+uint8_t loggerModeWake() {
+    return wake;
+}
+
+const char* loggerModeEnter(uint32_t intervalS) {
+#if LOGGER_ULP_AVAILABLE
+    if (intervalS < 10 || intervalS > 3600) return "interval must be 10-3600 s";
+    if (!rtc_gpio_is_valid_gpio((gpio_num_t)GEIGER_PULSE_PIN)) return "the pulse input is not an RTC GPIO";
+    if (HV_PWM_PIN >= 0) return "the HV regulator stops in deep sleep";
+    if (loggerRtc.active) sleepNow(); // Upload wake: the ULP is still counting
+
+    DeviceConfig config = getDeviceConfig();
+    float alarmCounts = config.alarmEnabled ? config.currentAlarmUsvH() * config.cpmPerUsvH * intervalS / 60.0f : 0.0f;
+    loggerRtc.intervalS = intervalS;
+    loggerRtc.alarmCounts = alarmCounts > 0.0f ? (uint32_t)ceilf(alarmCounts) : 0;
+    loggerRtc.cyclesPerInterval = ULP_NOMINAL_HZ * intervalS;
+    loggerRtc.intervalUs = intervalS * 1e6f;
+    loggerRtc.intervalError = 0.0f;
+    loggerRtc.utcValid = timeBaseUtcValid();
+    loggerRtc.utcUsAtEntry = loggerRtc.utcValid ? timeBaseUtcUs() : 0;
+    loggerRtc.rtcUsAtEntry = esp_rtc_get_time_us();
+    loggerRtc.boundaryRtcUs = loggerRtc.rtcUsAtEntry; // The first interval opens as the ULP starts
+    loggerRtc.boundaryHead = 0;
+    loggerRtc.intervals = 0;
+    loggerRtc.wakes = 0;
+    loggerRtc.batches = 0;
+
+    // Loading clears the ULP's variables; they are set after it
+    if (ulp_riscv_load_binary(ulpLoggerStart, ulpLoggerEnd - ulpLoggerStart) != ESP_OK) return "ULP load failed";
+    ulp_pulse_gpio = GEIGER_PULSE_PIN;
+    ulp_cycles_per_interval = loggerRtc.cyclesPerInterval;
+    ulp_wake_intervals = LOGGER_BATCH_INTERVALS;
+    ulp_alarm_counts = loggerRtc.alarmCounts;
+    rtc_gpio_init((gpio_num_t)GEIGER_PULSE_PIN);
+    rtc_gpio_set_direction((gpio_num_t)GEIGER_PULSE_PIN, RTC_GPIO_MODE_INPUT_ONLY);
+    if (ulp_riscv_run() != ESP_OK) return "ULP start failed";
+    loggerRtc.active = true;
+    DEBUG_PRINTF("Logger: %lu s intervals, alarm at %lu counts; sleeping\n", (unsigned long)intervalS,
+                 (unsigned long)loggerRtc.alarmCounts);
+    sleepNow();
+#else
+    (void)intervalS;
+    return "the ULP program is not built in (LOGGER_ULP_AVAILABLE)";
+#endif
+}
+
+void loggerModeExit() {
+#if LOGGER_ULP_AVAILABLE
+    if (!loggerRtc.active) return;
+    drainUlp(false);
+    stopUlp();
+    wake = LOGGER_WAKE_NONE;
+#endif
+}
+
+/**
+ * @brief Hands up to REPLAY_CHUNK backlog records to the history log and telemetry.
+ * @return false when the backlog is empty or could not be read
+ */
+static bool replayChunk() {
+    if (!LittleFS.begin(true) || !LittleFS.exists(LOGGER_BACKLOG_PATH)) return false;
+    File file = LittleFS.open(LOGGER_BACKLOG_PATH, "r");
+    if (!file) return false;
+    size_t size = file.size();
+    if (loggerRtc.replayedBytes >= size) {
+        file.close();
+        LittleFS.remove(LOGGER_BACKLOG_PATH);
+        loggerRtc.replayedBytes = 0;
+        return false;
+    }
+    file.seek(loggerRtc.replayedBytes);
+    bool logMounted = getHistoryLogStats().mounted;
+    DeviceConfig config = getDeviceConfig();
+    LogRecord record;
+    for (size_t i = 0; i < REPLAY_CHUNK && file.read((uint8_t*)&record, sizeof(record)) == sizeof(record); i++) {
+        if (logMounted && !logHistoryRecord(record.timestamp, record.counts, record.seconds, record.flags)) break;
+        if ((record.flags & LOG_FLAG_TIME_VALID) && record.seconds) {
+            float cpm = record.counts * 60.0f / record.seconds;
+            double rate = cpm * config.usvHPerCpm;
+            // Same time constants as the live averages, one step per interval
+            double a1h = 1.0 - exp(-(double)record.seconds / 3600.0);
+            double a24h = 1.0 - exp(-(double)record.seconds / 86400.0);
+            replay1h = replay1h < 0.0 ? rate : replay1h + a1h * (rate - replay1h);
+            replay24h = replay24h < 0.0 ? rate : replay24h + a24h * (rate - replay24h);
+            telemetryRecord(record.timestamp, true, (float)rate, cpm, record.seconds, (float)replay1h,
+                            (float)replay24h);
+        }
+        loggerRtc.replayedBytes += sizeof(record);
+        replayed++;
+    }
+    file.close();
+    return true;
+}
+
+void loggerModeLoop(uint32_t nowMs) {
+    bool pending = !replayDone && replayChunk();
+    if (!pending) replayDone = true;
+
+#if LOGGER_ULP_AVAILABLE
+    if (wake != LOGGER_WAKE_UPLOAD || !loggerRtc.active) return;
+    TelemetryStats telemetry = getTelemetryStats();
+    bool uploaded = !pending && (!telemetry.configured || telemetry.queued == 0);
+    if (uploaded || nowMs - bootMs >= LOGGER_UPLOAD_WINDOW_MS) {
+        DEBUG_PRINTF("Logger: upload wake over (%s); sleeping\n", uploaded ? "done" : "window");
+        drainUlp(false);
+        sleepNow();
+    }
+#else
+    (void)pending;
+#endif
+}
+
+LoggerStatus getLoggerStatus() {
+    LoggerStatus s;
+    s.available = LOGGER_ULP_AVAILABLE;
+    s.active = loggerRtc.active;
+    s.wake = wake;
+    s.intervalS = loggerRtc.intervalS;
+    s.alarmCounts = loggerRtc.alarmCounts;
+    s.intervals = loggerRtc.intervals;
+    s.wakes = loggerRtc.wakes;
+#if LOGGER_ULP_AVAILABLE
+    s.overflows = loggerRtc.active ? ulp_overflows : 0;
+#else
+    s.overflows = 0;
+#endif
+    s.intervalError = loggerRtc.intervalError;
+    s.backlog = 0;
+    if (LittleFS.begin(true) && LittleFS.exists(LOGGER_BACKLOG_PATH)) {
+        File file = LittleFS.open(LOGGER_BACKLOG_PATH, "r");
+        if (file) {
+            size_t size = file.size();
+            if (size > loggerRtc.replayedBytes) s.backlog = (size - loggerRtc.replayedBytes) / sizeof(LogRecord);
+            file.close();
+        }
+    }
+    s.replayed = replayed;
+    s.wakeInS = 0;
+#if LOGGER_ULP_AVAILABLE
+    uint64_t nowUs = esp_rtc_get_time_us();
+    if (loggerRtc.wakeRtcUs > nowUs) s.wakeInS = (uint32_t)((loggerRtc.wakeRtcUs - nowUs) / 1000000ULL);
+#endif
+    return s;
+}
+
+const char* loggerWakeName(uint8_t wake) {
+    switch (wake) {
+        case LOGGER_WAKE_NONE: return "none";
+        case LOGGER_WAKE_UPLOAD: return "upload";
+        case LOGGER_WAKE_ALARM: return "alarm";
+        case LOGGER_WAKE_STALLED: return "stalled";
+        case LOGGER_WAKE_RESET: return "reset";
+        case LOGGER_WAKE_SCHEDULED: return "scheduled";
+        default: return "?";
+    }
+}
+
+void printLoggerMode(Print& out) {
+    LoggerStatus s = getLoggerStatus();
+    if (!s.available) {
+        out.println("Logger: not available (ULP program not built in)");
+    } else {
+        out.printf("Logger: %s, this boot: %s\n", s.active ? "active" : "off", loggerWakeName(s.wake));
+        out.printf("  %lu s intervals, alarm at %lu counts, ULP clock %+.2f%%\n", (unsigned long)s.intervalS,
+                   (unsigned long)s.alarmCounts, s.intervalError * 100.0f);
+        out.printf("  %lu intervals in %lu wakes, %lu dropped\n", (unsigned long)s.intervals,
+                   (unsigned long)s.wakes, (unsigned long)s.overflows);
+        if (s.wakeInS) out.printf("  Scheduled wake in %lu s\n", (unsigned long)s.wakeInS);
+    }
+    out.printf("  Backlog: %lu records, %lu replayed this boot\n", (unsigned long)s.backlog,
+               (unsigned long)s.replayed);
+}
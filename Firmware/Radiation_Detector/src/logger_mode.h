@@ -0,0 +1,102 @@
+#ifndef LOGGER_MODE_H
+#define LOGGER_MODE_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Deep-sleep logger mode for unattended months-long monitoring.
+// The main cores sleep in deep sleep while the ULP RISC-V coprocessor polls
+// the pulse input (an RTC GPIO), counts rising edges and closes one interval
+// every LOGGER_INTERVAL_S into a ring in RTC memory (ulp/logger_ulp.c). It
+// wakes the main cores when:
+//  - LOGGER_BATCH_INTERVALS intervals are waiting. loggerModeResume(), the
+//    first thing in setup(), appends them to LOGGER_BACKLOG_PATH on LittleFS
+//    and sleeps again within a few tens of milliseconds, before anything else
+//    starts.
+//  - the open interval reaches the dose-rate alarm in counts (raw, from the
+//    configuration when the mode was entered). Logger mode ends and the
+//    device boots normally, so the alarm sounds from live counting.
+//  - every LOGGER_UPLOAD_BATCHES-th batch. The device boots fully, so WiFi
+//    and telemetry run, and loggerModeLoop() puts it back to sleep once the
+//    backlog is uploaded or LOGGER_UPLOAD_WINDOW_MS has passed.
+//  - the time set with loggerModeSetWakeAt() is reached (campaign.h). The
+//    device boots fully with the ULP still counting, as for an upload, and
+//    the caller either sleeps again or ends logger mode. While such a time is
+//    set, the LOGGER_UPLOAD_BATCHES wakes are skipped.
+// Any other reset ends logger mode. On every full boot, loggerModeLoop()
+// replays the backlog into the history log and, for records with UTC, into
+// telemetry.
+//
+// The ULP clock (RC_FAST, about 17.5 MHz) is only accurate to a few percent.
+// A batch wake comes right after an interval closes, so the RTC time between
+// two batch wakes gives the true interval length, and the ULP's cycle count
+// per interval is corrected from it. Intervals get their timestamps back
+// from the latest wake: UTC when the time base had it at entry, otherwise
+// seconds since entry.
+//
+// Requirements: the ULP program built in (LOGGER_ULP_AVAILABLE), the pulse on
+// an RTC GPIO (0-21), and a tube supply that runs without the MCU. The HV
+// regulator (HV_PWM_PIN) stops in deep sleep, so the mode is refused with it.
+
+enum LoggerWake {
+    LOGGER_WAKE_NONE = 0,   ///< Not woken from logger mode
+    LOGGER_WAKE_UPLOAD,     ///< Full boot to upload; sleeps again
+    LOGGER_WAKE_ALARM,      ///< Alarm threshold crossed; logger mode ended
+    LOGGER_WAKE_STALLED,    ///< Backstop timer, no new intervals; logger mode ended
+    LOGGER_WAKE_RESET,      ///< Another reset ended logger mode
+    LOGGER_WAKE_SCHEDULED   ///< loggerModeSetWakeAt() time; the ULP still counts
+};
+
+struct LoggerStatus {
+    bool available;         ///< ULP program built in
+    bool active;            ///< ULP counting, sleeping between batches
+    uint8_t wake;           ///< LoggerWake of this boot
+    uint32_t intervalS;
+    uint32_t alarmCounts;   ///< Per interval; 0 without the alarm
+    uint32_t intervals;     ///< Closed since entry and stored
+    uint32_t wakes;         ///< Since entry
+    uint32_t overflows;     ///< Intervals the ULP dropped with its ring full
+    float intervalError;    ///< Measured / nominal interval - 1 at the last calibration
+    uint32_t backlog;       ///< Stored records not yet replayed
+    uint32_t replayed;      ///< Since boot
+    uint32_t wakeInS;       ///< To the scheduled wake; 0 without one
+};
+
+// Called before the device goes to deep sleep (flush logs, save the dose).
+typedef void (*LoggerSleepHook)();
+
+// Call first in setup(). Stores the intervals of a batch wake and goes back
+// to deep sleep without returning; otherwise returns and the boot continues.
+void loggerModeResume();
+
+// Registers @p hook. Call in setup() once the logs and storage are up.
+void initLoggerMode(LoggerSleepHook hook);
+
+// Wakes the device fully at UTC @p utc during the next logger sleep (0: no
+// scheduled wake). Needs the time base's UTC; set before loggerModeEnter().
+void loggerModeSetWakeAt(uint32_t utc);
+
+// The ULP is counting: logger mode was entered and has not ended. Cheap.
+bool loggerModeActive();
+
+// LoggerWake of this boot.
+uint8_t loggerModeWake();
+
+// Starts the ULP and sleeps; does not return on success.
+// @return why logger mode cannot start
+const char* loggerModeEnter(uint32_t intervalS);
+
+// Ends logger mode during an upload wake; the device keeps running.
+void loggerModeExit();
+
+// loopTask: replays the backlog and ends an upload wake when it is done.
+void loggerModeLoop(uint32_t nowMs);
+
+LoggerStatus getLoggerStatus();
+
+const char* loggerWakeName(uint8_t wake);
+
+// Status ("logger").
+void printLoggerMode(Print& out);
+
+#endif // LOGGER_MODE_H
@@ -0,0 +1,170 @@
+/**
+ * @file lvgl_demo.cpp
+ * @brief LVGL benchmark and stress demo builds with JSON reports.
+ *
+ * The benchmark keeps its results to itself and only logs them, so the
+ * runner registers the LVGL log callback and turns the "Result of ..." and
+ * "Weighted FPS" lines into JSON; other log lines pass through unchanged.
+ * Render times come from the display driver's monitor callback, chained in
+ * front of the one the benchmark installs. Its finished callback marks the
+ * end of each scene, so every scene line carries the times of that scene.
+ */
+
+#include "lvgl_demo.h"
+
+#if LVGL_DEMO
+
+#include <lvgl.h>
+#include <demos/lv_demos.h>
+#include <stdlib.h>
+#include <string.h>
+#include "asset_pack.h"
+#include "display_port.h"
+#include "lvgl_heap.h"
+#include "esp_heap_caps.h"
+
+struct RenderStats {
+    uint32_t frames;
+    uint32_t timeSum;
+    uint32_t timeMax;
+    uint32_t pixels;
+};
+
+static RenderStats current = {0, 0, 0, 0}; ///< Since the last scene or report
+static RenderStats scene = {0, 0, 0, 0};   ///< The scene that just finished
+static RenderStats total = {0, 0, 0, 0};
+static void (*demoMonitor)(lv_disp_drv_t*, uint32_t, uint32_t) = NULL;
+static uint32_t lvglBaseline = 0;          ///< LVGL heap in use at the first report
+
+static void monitor(lv_disp_drv_t* drv, uint32_t time, uint32_t px) {
+    RenderStats* stats[] = {&current, &total};
+    for (RenderStats* s : stats) {
+        s->frames++;
+        s->timeSum += time;
+        if (time > s->timeMax) s->timeMax = time;
+        s->pixels += px;
+    }
+    if (demoMonitor) demoMonitor(drv, time, px);
+}
+
+static void printRender(const RenderStats& s) {
+    Serial.printf("\"render\":{\"frames\":%lu,\"avg_ms\":%.2f,\"max_ms\":%lu,\"px\":%lu}", (unsigned long)s.frames,
+                  s.frames ? (float)s.timeSum / s.frames : 0.0f, (unsigned long)s.timeMax, (unsigned long)s.pixels);
+}
+
+static uint32_t lvglHeapInUse(const LvglHeapStats& h) {
+    uint32_t bytes = h.internalBytes + h.psramBytes;
+    for (uint8_t c = 0; c < LVGL_HEAP_CLASSES; c++) bytes += h.classes[c].used * h.classes[c].blockSize;
+    return bytes;
+}
+
+static void printMemory() {
+    LvglHeapStats h = getLvglHeapStats();
+    uint32_t used = lvglHeapInUse(h);
+    if (!lvglBaseline) lvglBaseline = used;
+    Serial.printf("\"mem\":{\"lvgl_used\":%lu,\"lvgl_growth\":%ld,\"lvgl_internal_peak\":%lu,\"lvgl_psram_peak\":%lu,"
+                  "\"lvgl_failures\":%lu,\"pool_peak\":[",
+                  (unsigned long)used, (long)(used - lvglBaseline), (unsigned long)h.internalPeak,
+                  (unsigned long)h.psramPeak, (unsigned long)h.failures);
+    for (uint8_t c = 0; c < LVGL_HEAP_CLASSES; c++) {
+        Serial.printf("%s[%u,%u,%u]", c ? "," : "", (unsigned)h.classes[c].blockSize, (unsigned)h.classes[c].peak,
+                      (unsigned)h.classes[c].blocks);
+    }
+    Serial.printf("],\"internal_free\":%u,\"internal_min\":%u,\"psram_free\":%u,\"psram_min\":%u,\"stack_min\":%u}",
+                  (unsigned)heap_caps_get_free_size(MALLOC_CAP_INTERNAL),
+                  (unsigned)heap_caps_get_minimum_free_size(MALLOC_CAP_INTERNAL),
+                  (unsigned)heap_caps_get_free_size(MALLOC_CAP_SPIRAM),
+                  (unsigned)heap_caps_get_minimum_free_size(MALLOC_CAP_SPIRAM),
+                  (unsigned)uxTaskGetStackHighWaterMark(NULL));
+}
+
+#if LV_USE_DEMO_BENCHMARK
+
+static uint32_t weightedFps = 0;
+
+static void sceneFinished() {
+    scene = current;
+    current = {0, 0, 0, 0};
+}
+
+/**
+ * @brief Parses the benchmark's log lines; anything else is printed as is.
+ */
+static void benchmarkLog(const char* line) {
+    const char* name = strstr(line, "Result of \"");
+    if (name) {
+        name += strlen("Result of \"");
+        const char* end = strchr(name, '"');
+        const char* fps = end ? strstr(end, ": ") : NULL;
+        if (end && fps) {
+            const char* opa = strstr(name, " + opa\"");
+            bool withOpa = opa && opa < end + 1;
+            int length = (int)((withOpa ? opa : end) - name);
+            Serial.printf("{\"demo\":\"benchmark\",\"scene\":\"%.*s\",\"opa\":%s,\"fps\":%ld,", length, name,
+                          withOpa ? "true" : "false", strtol(fps + 2, NULL, 10));
+            printRender(scene);
+            Serial.println("}");
+            return;
+        }
+    }
+    const char* weighted = strstr(line, "Weighted FPS: ");
+    if (weighted) {
+        weightedFps = strtoul(weighted + strlen("Weighted FPS: "), NULL, 10);
+        return;
+    }
+    const char* opaSpeed = strstr(line, "Opa. speed: ");
+    if (opaSpeed) {
+        Serial.printf("{\"demo\":\"benchmark\",\"weighted_fps\":%lu,\"opa_speed_pct\":%lu,",
+                      (unsigned long)weightedFps, strtoul(opaSpeed + strlen("Opa. speed: "), NULL, 10));
+        printRender(total);
+        Serial.print(",");
+        printMemory();
+        Serial.println("}");
+        return;
+    }
+    Serial.print(line);
+}
+
+#endif
+
+#if LV_USE_DEMO_STRESS
+
+static void stressReport(lv_timer_t* timer) {
+    (void)timer;
+    Serial.printf("{\"demo\":\"stress\",\"uptime_s\":%lu,\"fps\":%.1f,", (unsigned long)(millis() / 1000),
+                  current.frames * 1000.0f / LVGL_DEMO_REPORT_MS);
+    printRender(current);
+    Serial.print(",");
+    printMemory();
+    Serial.println("}");
+    current = {0, 0, 0, 0};
+}
+
+#endif
+
+void lvglDemoRun() {
+    lv_init();
+    assetPackBegin();
+    displayPortRegister();
+    lv_disp_t* disp = lv_disp_get_default();
+
+#if LV_USE_DEMO_BENCHMARK
+    lv_log_register_print_cb(benchmarkLog);
+    lv_demo_benchmark_set_finished_cb(sceneFinished);
+    lv_demo_benchmark();
+#elif LV_USE_DEMO_STRESS
+    lv_demo_stress();
+    lv_timer_create(stressReport, LVGL_DEMO_REPORT_MS, NULL);
+#else
+#error "LVGL_DEMO needs lv_conf.h to enable the demo (LV_USE_DEMO_BENCHMARK or LV_USE_DEMO_STRESS)"
+#endif
+    demoMonitor = disp->driver->monitor_cb; // The benchmark's own, set by lv_demo_benchmark()
+    disp->driver->monitor_cb = monitor;
+
+    for (;;) {
+        lv_timer_handler();
+        delay(1);
+    }
+}
+
+#endif // LVGL_DEMO
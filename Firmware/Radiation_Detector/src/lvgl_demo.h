@@ -0,0 +1,27 @@
+#ifndef LVGL_DEMO_H
+#define LVGL_DEMO_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// On-device runs of LVGL's own demos (build with -DLVGL_DEMO=1 for
+// lv_demo_benchmark, 2 for lv_demo_stress). They draw through the firmware's
+// display port (display_port.h): the same DMA flush, draw buffers, SPI bus and
+// LVGL heap, so the numbers compare board revisions and lv_conf.h changes.
+// Each result is one JSON line on serial:
+//   {"demo":"benchmark","scene":"Rectangle","opa":false,"fps":...}
+//   {"demo":"benchmark","weighted_fps":...,"opa_speed_pct":...,"render":...,"mem":...}
+//   {"demo":"stress","uptime_s":...,"fps":...,"render":...,"mem":...}
+// "render" sums LVGL's monitor callback: frames, average and worst render
+// plus flush time per frame, pixels. "mem" holds the LVGL heap (pool and
+// heap peaks, failures), free and minimum free internal RAM and PSRAM, and
+// the free stack of the LVGL task at its lowest. The stress test runs until
+// reset and reports every LVGL_DEMO_REPORT_MS; a leak shows as "lvgl_growth".
+
+#if LVGL_DEMO
+// Sets up LVGL and the panel, starts the demo and runs LVGL forever. Call
+// after displayPortBegin() in place of the UI; never returns.
+void lvglDemoRun();
+#endif
+
+#endif // LVGL_DEMO_H
@@ -0,0 +1,217 @@
+/**
+ * @file lvgl_heap.cpp
+ * @brief Pooled internal-RAM / PSRAM allocator for LVGL.
+ *
+ * Each size class owns a contiguous slice of one static internal-RAM array,
+ * so the class of a pointer follows from its address (at most four compares)
+ * and pooled blocks need no header. Free blocks form an intrusive singly
+ * linked list per class.
+ * Heap blocks carry an 8-byte header with the requested size and the region,
+ * which keeps the byte counters exact and lets realloc stay in its region.
+ */
+
+#include "config.h"
+
+#if !HEADLESS
+
+#include "lvgl_heap.h"
+#include "config.h"
+#include <lvgl.h>
+#include "esp_heap_caps.h"
+
+static const uint16_t CLASS_SIZES[LVGL_HEAP_CLASSES] = {16, 32, 64, LVGL_HEAP_BLOCK_MAX};
+static const uint32_t HEAP_INTERNAL = 0;
+static const uint32_t HEAP_PSRAM = 1;
+
+// Eighths of the pool per class: object and widget structs fall in the 64 and
+// 128-byte classes, style and event arrays and short strings in the smaller ones
+static const uint8_t CLASS_EIGHTHS[LVGL_HEAP_CLASSES] = {1, 2, 3, 2};
+static const size_t POOL_UNIT = LVGL_HEAP_POOL_BYTES / 8 / LVGL_HEAP_BLOCK_MAX * LVGL_HEAP_BLOCK_MAX;
+
+struct FreeBlock {
+    FreeBlock* next;
+};
+
+struct HeapHeader {
+    uint32_t size;   ///< Requested bytes
+    uint32_t region; ///< HEAP_INTERNAL or HEAP_PSRAM
+};
+
+static uint8_t poolMemory[POOL_UNIT * 8] __attribute__((aligned(8)));
+static uint8_t* classEnd[LVGL_HEAP_CLASSES]; ///< Classes are laid out in order from poolMemory
+static FreeBlock* freeLists[LVGL_HEAP_CLASSES];
+static bool poolReady = false;
+static LvglHeapStats stats;
+
+static void initPool() {
+    uint8_t* base = poolMemory;
+    for (uint8_t c = 0; c < LVGL_HEAP_CLASSES; c++) {
+        uint16_t blocks = CLASS_EIGHTHS[c] * POOL_UNIT / CLASS_SIZES[c];
+        classEnd[c] = base + blocks * CLASS_SIZES[c];
+        freeLists[c] = nullptr;
+        for (int32_t i = blocks - 1; i >= 0; i--) {
+            FreeBlock* block = (FreeBlock*)(base + i * CLASS_SIZES[c]);
+            block->next = freeLists[c];
+            freeLists[c] = block;
+        }
+        stats.classes[c].blockSize = CLASS_SIZES[c];
+        stats.classes[c].blocks = blocks;
+        base = classEnd[c];
+    }
+    stats.poolBytes = sizeof(poolMemory);
+    poolReady = true;
+}
+
+/**
+ * @return the class owning @p ptr, or -1 if it is not a pool block
+ */
+static int8_t classOf(const void* ptr) {
+    const uint8_t* p = (const uint8_t*)ptr;
+    if (p < poolMemory) return -1;
+    for (uint8_t c = 0; c < LVGL_HEAP_CLASSES; c++) {
+        if (p < classEnd[c]) return c;
+    }
+    return -1;
+}
+
+static void* poolAlloc(size_t size) {
+    for (uint8_t c = 0; c < LVGL_HEAP_CLASSES; c++) {
+        if (size > CLASS_SIZES[c] || !freeLists[c]) continue;
+        if (c > 0 && size <= CLASS_SIZES[c - 1]) stats.spills++;
+        FreeBlock* block = freeLists[c];
+        freeLists[c] = block->next;
+        LvglHeapClassStats& cs = stats.classes[c];
+        if (++cs.used > cs.peak) cs.peak = cs.used;
+        return block;
+    }
+    return nullptr;
+}
+
+static void countHeap(uint32_t region, int32_t delta) {
+    if (region == HEAP_PSRAM) {
+        stats.psramBytes += delta;
+        if (stats.psramBytes > stats.psramPeak) stats.psramPeak = stats.psramBytes;
+    } else {
+        stats.internalBytes += delta;
+        if (stats.internalBytes > stats.internalPeak) stats.internalPeak = stats.internalBytes;
+    }
+}
+
+static uint32_t regionCaps(uint32_t region) {
+    return region == HEAP_PSRAM ? (MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT) : (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+}
+
+/**
+ * @brief True while LVGL draws a frame: allocations then are scratch buffers
+ *        that are read and written per pixel.
+ */
+static bool rendering() {
+    lv_disp_t* disp = _lv_refr_get_disp_refreshing();
+    return disp && disp->rendering_in_progress;
+}
+
+static void* heapAlloc(size_t size) {
+    uint32_t first = rendering() ? HEAP_INTERNAL : HEAP_PSRAM;
+    uint32_t region = first;
+    HeapHeader* header = (HeapHeader*)heap_caps_malloc(sizeof(HeapHeader) + size, regionCaps(region));
+    if (!header) {
+        region = first == HEAP_PSRAM ? HEAP_INTERNAL : HEAP_PSRAM;
+        header = (HeapHeader*)heap_caps_malloc(sizeof(HeapHeader) + size, regionCaps(region));
+    }
+    if (!header) return nullptr;
+    header->size = size;
+    header->region = region;
+    countHeap(region, (int32_t)size);
+    return header + 1;
+}
+
+extern "C" void* lvglHeapAlloc(size_t size) {
+    if (!poolReady) initPool();
+    void* ptr = nullptr;
+    if (size <= LVGL_HEAP_BLOCK_MAX) ptr = poolAlloc(size);
+    if (!ptr) {
+        if (size <= LVGL_HEAP_BLOCK_MAX) stats.spills++;
+        ptr = heapAlloc(size);
+    }
+    if (ptr) {
+        stats.allocs++;
+    } else {
+        stats.failures++;
+    }
+    return ptr;
+}
+
+extern "C" void lvglHeapFree(void* ptr) {
+    if (!ptr) return;
+    stats.frees++;
+    int8_t c = classOf(ptr);
+    if (c >= 0) {
+        FreeBlock* block = (FreeBlock*)ptr;
+        block->next = freeLists[c];
+        freeLists[c] = block;
+        stats.classes[c].used--;
+        return;
+    }
+    HeapHeader* header = (HeapHeader*)ptr - 1;
+    countHeap(header->region, -(int32_t)header->size);
+    heap_caps_free(header);
+}
+
+extern "C" void* lvglHeapRealloc(void* ptr, size_t size) {
+    if (!ptr) return lvglHeapAlloc(size);
+    stats.reallocs++;
+
+    int8_t c = classOf(ptr);
+    if (c >= 0) {
+        if (size <= CLASS_SIZES[c]) return ptr;
+        void* grown = lvglHeapAlloc(size);
+        if (!grown) return nullptr;
+        memcpy(grown, ptr, CLASS_SIZES[c]);
+        lvglHeapFree(ptr);
+        return grown;
+    }
+
+    // Heap blocks stay in their region; the other one is the fallback
+    HeapHeader* header = (HeapHeader*)ptr - 1;
+    uint32_t region = header->region;
+    uint32_t oldSize = header->size;
+    HeapHeader* moved = (HeapHeader*)heap_caps_realloc(header, sizeof(HeapHeader) + size, regionCaps(region));
+    if (moved) {
+        moved->size = size;
+        countHeap(region, (int32_t)size - (int32_t)oldSize);
+        return moved + 1;
+    }
+    void* copy = heapAlloc(size);
+    if (!copy) {
+        stats.failures++;
+        return nullptr;
+    }
+    memcpy(copy, ptr, oldSize < size ? oldSize : size);
+    countHeap(region, -(int32_t)oldSize);
+    heap_caps_free(header);
+    return copy;
+}
+
+LvglHeapStats getLvglHeapStats() {
+    if (!poolReady) initPool();
+    return stats;
+}
+
+void printLvglHeapStats(Print& out) {
+    LvglHeapStats s = getLvglHeapStats();
+    uint32_t pooledBytes = 0;
+    for (uint8_t c = 0; c < LVGL_HEAP_CLASSES; c++) pooledBytes += s.classes[c].used * s.classes[c].blockSize;
+    out.printf("LVGL heap: pool %lu of %lu bytes, internal %lu (peak %lu), PSRAM %lu (peak %lu)\n",
+               (unsigned long)pooledBytes, (unsigned long)s.poolBytes, (unsigned long)s.internalBytes,
+               (unsigned long)s.internalPeak, (unsigned long)s.psramBytes, (unsigned long)s.psramPeak);
+    for (uint8_t c = 0; c < LVGL_HEAP_CLASSES; c++) {
+        const LvglHeapClassStats& cs = s.classes[c];
+        out.printf("  %3u B blocks: %u of %u used, peak %u\n", (unsigned)cs.blockSize, (unsigned)cs.used,
+                   (unsigned)cs.blocks, (unsigned)cs.peak);
+    }
+    out.printf("  allocs %lu, frees %lu, reallocs %lu, spills %lu, failures %lu\n", (unsigned long)s.allocs,
+               (unsigned long)s.frees, (unsigned long)s.reallocs, (unsigned long)s.spills,
+               (unsigned long)s.failures);
+}
+
+#endif // !HEADLESS
@@ -0,0 +1,57 @@
+#ifndef LVGL_HEAP_H
+#define LVGL_HEAP_H
+
+#include <Arduino.h>
+
+// Allocator behind lv_mem_alloc() (LV_MEM_CUSTOM in lv_conf.h).
+// Requests up to LVGL_HEAP_BLOCK_MAX bytes (object headers, styles, event
+// lists, short label texts: the bulk of widget churn) come from fixed-size
+// block pools in internal RAM, O(1) and free of fragmentation. Larger requests
+// made while a frame is rendering (masks, layers and intermediate buffers) go
+// to the internal heap; every other large request (chart point arrays,
+// keyboard maps, long-lived widget data) goes to PSRAM. A full class spills to
+// the next larger one, then to the heap; without PSRAM the internal heap is used.
+// Called from the LVGL task only; the statistics can be read from any task.
+
+static const uint8_t LVGL_HEAP_CLASSES = 4;
+static const size_t LVGL_HEAP_BLOCK_MAX = 128; ///< Largest pooled request
+
+struct LvglHeapClassStats {
+    uint16_t blockSize;
+    uint16_t blocks;
+    uint16_t used;
+    uint16_t peak;
+};
+
+struct LvglHeapStats {
+    LvglHeapClassStats classes[LVGL_HEAP_CLASSES];
+    uint32_t poolBytes;      ///< Size of all block pools
+    uint32_t internalBytes;  ///< Requested bytes live on the internal heap
+    uint32_t internalPeak;
+    uint32_t psramBytes;     ///< Requested bytes live in PSRAM
+    uint32_t psramPeak;
+    uint32_t allocs;
+    uint32_t frees;
+    uint32_t reallocs;
+    uint32_t spills;         ///< Pooled-size requests served by a larger class or the heap
+    uint32_t failures;       ///< Requests no region could serve
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The LV_MEM_CUSTOM_* hooks (also declared in lv_conf.h).
+void* lvglHeapAlloc(size_t size);
+void lvglHeapFree(void* ptr);
+void* lvglHeapRealloc(void* ptr, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+LvglHeapStats getLvglHeapStats();
+
+void printLvglHeapStats(Print& out);
+
+#endif // LVGL_HEAP_H
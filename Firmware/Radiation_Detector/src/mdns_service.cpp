@@ -0,0 +1,60 @@
+/**
+ * @file mdns_service.cpp
+ * @brief Per-device mDNS host name, _http._tcp service and its TXT records.
+ */
+
+#include "mdns_service.h"
+#include "config.h"
+#include "debug.h"
+#include <WiFi.h>
+#include <ESPmDNS.h>
+#include "mdns.h"
+#include "esp_ota_ops.h"
+
+static char hostname[16] = "";
+static bool started = false;
+
+const char* mdnsHostname() {
+    if (!hostname[0]) {
+        uint8_t mac[6];
+        WiFi.macAddress(mac);
+        snprintf(hostname, sizeof(hostname), "radscan-%02x%02x%02x", mac[3], mac[4], mac[5]);
+    }
+    return hostname;
+}
+
+void mdnsServiceAnnounce() {
+    if (started) {
+        // Setting the (same) host name restarts probing and announcing on all
+        // interfaces, so caches that expired while the link was down refill
+        mdns_hostname_set(mdnsHostname());
+        DEBUG_PRINTF("mDNS: re-announced %s.local\n", hostname);
+        return;
+    }
+    if (!MDNS.begin(mdnsHostname())) {
+        DEBUG_PRINTLN("Error setting up mDNS responder!");
+        return;
+    }
+    started = true;
+
+    uint8_t mac[6];
+    char id[13];
+    WiFi.macAddress(mac);
+    snprintf(id, sizeof(id), "%02x%02x%02x%02x%02x%02x", mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+
+    MDNS.setInstanceName(String("RadScan ") + (hostname + 8));
+    MDNS.addService("http", "tcp", 80);
+    MDNS.addServiceTxt("http", "tcp", "id", id);
+    MDNS.addServiceTxt("http", "tcp", "fw", esp_ota_get_app_description()->version);
+    MDNS.addServiceTxt("http", "tcp", "data", "/api/data");
+    MDNS.addServiceTxt("http", "tcp", "events", "/events");
+    MDNS.addServiceTxt("http", "tcp", "history", "/api/history");
+    MDNS.addServiceTxt("http", "tcp", "ota", "/update");
+#if HTTPS_ENABLED
+    // Same paths; clients that pin the certificate fetch its fingerprint from /api/tls
+    MDNS.addService("https", "tcp", HTTPS_PORT);
+    MDNS.addServiceTxt("https", "tcp", "id", id);
+    MDNS.addServiceTxt("https", "tcp", "tls", "/api/tls");
+#endif
+    DEBUG_PRINTF("mDNS responder started - Device accessible at http://%s.local\n", hostname);
+}
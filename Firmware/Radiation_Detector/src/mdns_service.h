@@ -0,0 +1,25 @@
+#ifndef MDNS_SERVICE_H
+#define MDNS_SERVICE_H
+
+#include <Arduino.h>
+
+// mDNS advertisement for discovery by collectors.
+// Every unit answers to its own name, radscan-XXXXXX.local (last three MAC
+// bytes, the same tag telemetry uses), and advertises an _http._tcp service
+// whose TXT records tell a collector what it found without a request:
+//   id      full MAC, lower-case hex without separators
+//   fw      running firmware version (esp_app_desc_t)
+//   data    /api/data       events  /events
+//   history /api/history    ota     /update
+// Should two units still share a name, the responder's probe renames the
+// later one. A collector browses _http._tcp and keeps the instances whose
+// TXT has "id".
+
+// Starts the responder on the first call and re-announces the host and the
+// service on later ones. Call on every WiFi connection (UI task).
+void mdnsServiceAnnounce();
+
+// @return the host name without ".local"
+const char* mdnsHostname();
+
+#endif // MDNS_SERVICE_H
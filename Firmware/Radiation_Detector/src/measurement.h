@@ -0,0 +1,301 @@
+#ifndef MEASUREMENT_H
+#define MEASUREMENT_H
+
+#include <math.h>
+#include <stdint.h>
+#include "rate_window.h"
+#include "adaptive_rate.h"
+#include "count_statistics.h"
+#include "dead_time.h"
+
+// Hardware-independent core of the dose-rate pipeline.
+// pulseTask polls a MeasurementHal into a PulseAccumulator (1-second buckets
+// feeding the rate windows), sums the buckets into a DoseAccumulator and into
+// clock-aligned chart intervals; uiTask turns the resulting CPM into DoseStats.
+// The firmware implements the HAL on PCNT and millis();
+// tools/measurement_sim.cpp implements it with a synthetic pulse source and runs
+// the same code at accelerated time. No Arduino dependencies (host-compilable).
+
+/**
+ * @brief Time and pulse-count source for the pipeline.
+ */
+class MeasurementHal {
+public:
+    virtual ~MeasurementHal() {}
+    virtual uint32_t nowMs() = 0;      ///< Monotonic milliseconds (may wrap)
+    virtual uint32_t pulseCount() = 0; ///< Monotonic pulse count (may wrap)
+};
+
+/**
+ * @brief Turns count polls into 1-second buckets for the rate estimators (pulseTask side).
+ *
+ * A bucket closes on the first poll at least 1000 ms after the previous one, so
+ * with a 50 ms poll a "second" is 1000-1050 ms long, as it always was here.
+ */
+class PulseAccumulator {
+public:
+    PulseAccumulator(RateWindows& windows, AdaptiveRateEstimator& adaptive)
+        : windows_(windows), adaptive_(adaptive), lastCount_(0), secondStartMs_(0),
+          secondCounts_(0), lastSecondCounts_(0), totalCounts_(0) {}
+
+    /// Takes the current count as the reference for the first poll.
+    void begin(MeasurementHal& hal) { lastCount_ = hal.pulseCount(); }
+
+    /**
+     * @brief Reads the HAL once.
+     * @param secondClosed Set to true if this poll closed a 1-second bucket
+     * @return Counts since the previous poll
+     */
+    uint32_t poll(MeasurementHal& hal, bool* secondClosed) {
+        uint32_t count = hal.pulseCount();
+        uint32_t diff = count - lastCount_; // Unsigned: correct across wraps
+        lastCount_ = count;
+        secondCounts_ += diff;
+
+        uint32_t now = hal.nowMs();
+        *secondClosed = now - secondStartMs_ >= 1000;
+        if (*secondClosed) {
+            windows_.push(secondCounts_);
+            adaptive_.push(secondCounts_);
+            totalCounts_ += secondCounts_;
+            lastSecondCounts_ = secondCounts_;
+            secondCounts_ = 0;
+            secondStartMs_ = now;
+        }
+        return diff;
+    }
+
+    uint32_t lastSecondCounts() const { return lastSecondCounts_; }
+    uint32_t totalCounts() const { return totalCounts_; }
+    /// The open bucket: when it started and its counts so far.
+    uint32_t secondStartMs() const { return secondStartMs_; }
+    uint32_t secondCounts() const { return secondCounts_; }
+
+    /// begin() in the middle of a bucket another accumulator left open (replay).
+    void resume(MeasurementHal& hal, uint32_t secondStartMs, uint32_t secondCounts) {
+        begin(hal);
+        secondStartMs_ = secondStartMs;
+        secondCounts_ = secondCounts;
+    }
+
+    /// Continues the total of an earlier run (restored checkpoint) before the first poll.
+    void restoreTotalCounts(uint32_t totalCounts) { totalCounts_ = totalCounts; }
+
+private:
+    RateWindows& windows_;
+    AdaptiveRateEstimator& adaptive_;
+    uint32_t lastCount_;
+    uint32_t secondStartMs_;
+    uint32_t secondCounts_;
+    uint32_t lastSecondCounts_;
+    uint32_t totalCounts_;
+};
+
+/**
+ * @brief Cumulative dose as an integer sum of dead-time corrected counts (pulseTask side).
+ *
+ * Each closed second adds its counts, corrected for dead time, to a 64-bit
+ * integer in 1/COUNT_SCALE units. Integer addition stays exact however long the
+ * run. A float running total stops growing once the increment falls below its
+ * resolution. Converting to mSv takes one multiply, done when read. When the
+ * conversion factor changes, the counts so far are settled at the old factor.
+ * The class is trivially copyable, so the whole state is published through a
+ * SeqLock.
+ */
+class DoseAccumulator {
+public:
+    static const uint32_t COUNT_SCALE = 1024; ///< Fixed-point fraction of a corrected count
+
+    DoseAccumulator() : settledMsv_(0.0), scaledCounts_(0), usvHPerCpm_(0.0f) {}
+
+    /// Continues the dose of an earlier run (restored checkpoint).
+    void restore(double msv) {
+        settledMsv_ = msv;
+        scaledCounts_ = 0;
+    }
+
+    /**
+     * @param counts       Counts of the closed 1-second bucket
+     * @param deadTimeSec  Tube dead time for the correction
+     * @param usvHPerCpm   µSv/h per CPM (DeviceConfig::usvHPerCpm)
+     */
+    void addSecond(uint32_t counts, float deadTimeSec, float usvHPerCpm) {
+        if (usvHPerCpm != usvHPerCpm_) {
+            settledMsv_ = msv();
+            scaledCounts_ = 0;
+            usvHPerCpm_ = usvHPerCpm;
+        }
+        if (counts) scaledCounts_ += (uint64_t)(correctDeadTimeCps((float)counts, deadTimeSec) * COUNT_SCALE + 0.5f);
+    }
+
+    /// Dose in mSv: (counts / 60) min at usvHPerCpm µSv/h per CPM.
+    double msv() const {
+        return settledMsv_ + (double)scaledCounts_ * ((double)usvHPerCpm_ / (60.0 * 1000.0 * COUNT_SCALE));
+    }
+
+    /// Dead-time corrected counts since the last factor change or restore.
+    double correctedCounts() const { return (double)scaledCounts_ / COUNT_SCALE; }
+
+private:
+    double settledMsv_;      ///< Dose before the current factor took effect
+    uint64_t scaledCounts_;  ///< Corrected counts since then, x COUNT_SCALE
+    float usvHPerCpm_;
+};
+
+/**
+ * @brief Current / average / maximum dose rate (uiTask side). The cumulative
+ *        dose is counted by DoseAccumulator.
+ */
+struct DoseStats {
+    float current;     ///< µSv/h
+    float average;     ///< µSv/h since start
+    float maximum;     ///< µSv/h
+    RateUncertainty currentError;  ///< 95 % interval of current, µSv/h
+    RateUncertainty averageError;  ///< 95 % interval of average, µSv/h
+
+    DoseStats() { reset(); }
+
+    void reset() {
+        current = 0.0f;
+        average = 0.0f;
+        maximum = 0.0f;
+        currentError = rateUncertainty(0, 0.0f, CONFIDENCE_Z_95, 0.0f, 0.0f);
+        averageError = currentError;
+    }
+
+    /**
+     * @param cpm          Dead-time corrected CPM
+     * @param totalCounts  Counts since start
+     * @param elapsedMs    Time since start
+     * @param usvHPerCpm   µSv/h per CPM (DeviceConfig::usvHPerCpm)
+     */
+    void update(float cpm, uint32_t totalCounts, uint32_t elapsedMs, float usvHPerCpm) {
+        // Division by a constant is folded into a reciprocal; the compiler
+        // keeps a float division as is (no -ffast-math)
+        static constexpr float MIN_PER_MS = 1.0f / 60000.0f;
+
+        // No extra smoothing here: the adaptive estimator already sets the window
+        current = cpm * usvHPerCpm;
+
+        float totalTimeMin = (float)elapsedMs * MIN_PER_MS;
+        if (totalTimeMin > 0.0f) {
+            average = ((float)totalCounts / totalTimeMin) * usvHPerCpm;
+        }
+
+        if (current > maximum && current < 100.0f) { // Sanity check upper limit
+            maximum = current;
+        }
+    }
+
+    /**
+     * @brief Count-statistics intervals of current and average, from the same
+     *        sums they were computed from. O(1).
+     * @param windowCounts   Counts in the adaptive window behind current
+     * @param windowSeconds  Its length
+     * @param totalCounts    Counts since start (average is not dead-time corrected)
+     * @param elapsedMs      Time since start
+     */
+    void updateUncertainty(uint32_t windowCounts, float windowSeconds, uint32_t totalCounts, uint32_t elapsedMs,
+                           float deadTimeSec, float usvHPerCpm) {
+        float scale = 60.0f * usvHPerCpm; // cps -> µSv/h
+        currentError = rateUncertainty(windowCounts, windowSeconds, CONFIDENCE_Z_95, deadTimeSec, scale);
+        averageError = rateUncertainty(totalCounts, elapsedMs * 0.001f, CONFIDENCE_Z_95, 0.0f, scale);
+    }
+};
+
+/**
+ * @brief One closed chart interval: exact counts over the seconds that were counted.
+ */
+struct AlignedInterval {
+    uint32_t start;           ///< Interval start, a multiple of length on the clock it was aligned to
+    uint32_t counts;          ///< Counts in the live seconds
+    uint16_t liveSeconds;     ///< Counted seconds; below length after boot, a clock change or injection
+    uint16_t length;
+    bool utc;                 ///< start is Unix time, else seconds since boot
+
+    float cps() const { return liveSeconds ? (float)counts / liveSeconds : 0.0f; }
+};
+
+/**
+ * @brief Sums closed 1-second buckets into intervals on clock-aligned
+ *        boundaries (pulseTask side).
+ *
+ * With UTC, an interval of length L covers [k L, (k + 1) L) Unix time, so
+ * the bars of every device start at the same instants and a backend merges
+ * them by start time. Before UTC is known the monotonic clock is used; the
+ * interval open when the clock changes is closed early. The counts are the
+ * integer bucket counts, and the rate is taken over the live seconds only,
+ * so a partial interval is a correct mean, not an underestimate.
+ */
+class AlignedIntervalCounter {
+public:
+    explicit AlignedIntervalCounter(uint16_t length) : length_(length ? length : 1) { reset(); }
+
+    void reset() {
+        open_ = false;
+        current_.counts = 0;
+        current_.liveSeconds = 0;
+    }
+
+    /**
+     * @brief One closed second ending at @p monotonicEnd, and at @p utcEnd
+     *        when UTC is known (else 0).
+     * @param live false: the second moves the boundaries but is not counted
+     * @return true with @p closed filled when an interval with live seconds closed
+     */
+    bool addSecond(uint32_t monotonicEnd, uint32_t utcEnd, uint32_t counts, bool live, AlignedInterval* closed) {
+        bool utc = utcEnd != 0;
+        uint32_t end = utc ? utcEnd : monotonicEnd;
+        uint32_t index = (end - 1) / length_;
+        bool emitted = false;
+        if (open_ && (index != index_ || utc != current_.utc)) emitted = close(closed);
+        if (!open_) {
+            open_ = true;
+            index_ = index;
+            current_.start = index * length_;
+            current_.length = length_;
+            current_.utc = utc;
+            current_.counts = 0;
+            current_.liveSeconds = 0;
+        }
+        if (live) {
+            current_.counts += counts;
+            current_.liveSeconds++;
+        }
+        // Complete: close now rather than with the first second of the next one
+        if (end >= current_.start + length_ && !emitted) emitted = close(closed);
+        return emitted;
+    }
+
+    /// The interval being filled (counts and live seconds so far).
+    const AlignedInterval& current() const { return current_; }
+
+private:
+    bool close(AlignedInterval* closed) {
+        open_ = false;
+        if (current_.liveSeconds == 0) return false;
+        *closed = current_;
+        return true;
+    }
+
+    uint16_t length_;
+    bool open_;
+    uint32_t index_;
+    AlignedInterval current_;
+};
+
+/// Y-axis top for a chart whose largest value is @p maxValue: 20% headroom, whole units, at least 1.
+inline float chartScaleMax(float maxValue) {
+    if (maxValue < 1.0f) maxValue = 1.0f;
+    return ceilf(maxValue * 1.2f);
+}
+
+/// Y-axis top with hysteresis: @p current is kept while @p maxValue fits under
+/// it and still needs more than half of it, so a closing interval rarely rescales.
+inline float chartAxisTop(float current, float maxValue) {
+    float fitted = chartScaleMax(maxValue);
+    if (maxValue > current || fitted * 2.0f <= current) return fitted;
+    return current;
+}
+
+#endif // MEASUREMENT_H
@@ -0,0 +1,142 @@
+#ifndef MESH_CLOCK_H
+#define MESH_CLOCK_H
+
+#include <math.h>
+#include <stdint.h>
+
+// Maps the local monotonic microsecond clock onto the mesh time (the time
+// server's clock, see time_sync.h) from two-way exchange results.
+// Each sample is the offset (mesh - local) measured at a local instant. The
+// caller passes only the best (shortest round trip) exchange of each burst,
+// since queueing delays only ever lengthen a trip and bias its offset. The
+// offset over the last N samples is fitted with a straight line: its slope
+// is the frequency difference of the two oscillators, so the mapping keeps
+// following between bursts instead of drifting by up to ~40 ppm. The fit is
+// redone for each sample and moves the mapping by the change of its
+// estimate, a few microseconds at a time.
+// A sample further than a step limit from the prediction (the server
+// restarted, another server took over) restarts the fit from it.
+// No Arduino dependencies (host-compilable).
+
+template <uint8_t N>
+class MeshClockN {
+public:
+    static const int32_t MAX_DRIFT_PPB = 500000;       ///< Frequency difference limit (500 ppm)
+    static const int64_t MIN_DRIFT_SPAN_US = 30000000; ///< Shorter spans keep the previous slope
+
+    MeshClockN() { clear(); }
+
+    void clear() {
+        count_ = 0;
+        next_ = 0;
+        driftPpb_ = 0;
+        anchorLocalUs_ = 0;
+        anchorOffsetUs_ = 0;
+        residualUs_ = 0;
+        lastErrorUs_ = 0;
+        steps_ = 0;
+    }
+
+    /**
+     * @brief Adds the best exchange of a burst.
+     * @param localUs   Local time the offset refers to (middle of the round trip)
+     * @param offsetUs  Mesh minus local time
+     * @param stepUs    Errors beyond this restart the fit
+     * @return true if the fit (re)started with this sample
+     */
+    bool add(int64_t localUs, int64_t offsetUs, int64_t stepUs) {
+        bool restart = count_ == 0;
+        if (!restart) {
+            lastErrorUs_ = offsetUs - offsetAt(localUs);
+            if (lastErrorUs_ > stepUs || lastErrorUs_ < -stepUs) restart = true;
+        } else {
+            lastErrorUs_ = 0;
+        }
+        if (restart) {
+            count_ = 0;
+            next_ = 0;
+            driftPpb_ = 0;
+            steps_++;
+        }
+        Sample& s = samples_[next_];
+        s.localUs = localUs;
+        s.offsetUs = offsetUs;
+        next_ = (next_ + 1) % N;
+        if (count_ < N) count_++;
+        fit(localUs, offsetUs);
+        return restart;
+    }
+
+    bool valid() const { return count_ > 0; }
+
+    /// Mesh minus local time at local @p localUs.
+    int64_t offsetAt(int64_t localUs) const {
+        int64_t dt = localUs - anchorLocalUs_;
+        return anchorOffsetUs_ + dt * driftPpb_ / 1000000000LL;
+    }
+
+    /// Mesh time at local @p localUs (only meaningful while valid()).
+    int64_t meshAt(int64_t localUs) const { return localUs + offsetAt(localUs); }
+
+    int32_t driftPpb() const { return driftPpb_; }
+    uint32_t residualUs() const { return residualUs_; }       ///< RMS distance of the samples from the fit
+    int64_t lastErrorUs() const { return lastErrorUs_; }      ///< Last sample against the prediction
+    int64_t lastSampleUs() const { return anchorLocalUs_; }
+    uint8_t count() const { return count_; }
+    uint32_t steps() const { return steps_; }
+
+private:
+    struct Sample {
+        int64_t localUs;
+        int64_t offsetUs;
+    };
+
+    /// Least squares line through the samples, anchored at the newest one.
+    void fit(int64_t newestLocalUs, int64_t newestOffsetUs) {
+        double sx = 0.0, sy = 0.0, sxx = 0.0, sxy = 0.0;
+        int64_t oldestUs = newestLocalUs;
+        for (uint8_t i = 0; i < count_; i++) {
+            double x = (samples_[i].localUs - newestLocalUs) * 1e-6;    // Seconds
+            double y = (double)(samples_[i].offsetUs - newestOffsetUs); // Microseconds
+            sx += x;
+            sy += y;
+            sxx += x * x;
+            sxy += x * y;
+            if (samples_[i].localUs < oldestUs) oldestUs = samples_[i].localUs;
+        }
+        double n = count_;
+        double slope = driftPpb_ * 1e-3; // us/s = ppm
+        double det = n * sxx - sx * sx;
+        if (count_ >= 2 && newestLocalUs - oldestUs >= MIN_DRIFT_SPAN_US && det > 0.0) {
+            slope = (n * sxy - sx * sy) / det;
+            double ppb = slope * 1e3;
+            if (ppb > MAX_DRIFT_PPB) ppb = MAX_DRIFT_PPB;
+            if (ppb < -MAX_DRIFT_PPB) ppb = -MAX_DRIFT_PPB;
+            driftPpb_ = (int32_t)lround(ppb);
+            slope = driftPpb_ * 1e-3;
+        }
+        double intercept = (sy - slope * sx) / n;
+
+        double squares = 0.0;
+        for (uint8_t i = 0; i < count_; i++) {
+            double x = (samples_[i].localUs - newestLocalUs) * 1e-6;
+            double r = (double)(samples_[i].offsetUs - newestOffsetUs) - (intercept + slope * x);
+            squares += r * r;
+        }
+        residualUs_ = (uint32_t)lround(sqrt(squares / n));
+        anchorLocalUs_ = newestLocalUs;
+        anchorOffsetUs_ = newestOffsetUs + (int64_t)llround(intercept);
+    }
+
+    Sample samples_[N];
+    uint8_t count_;
+    uint8_t next_;
+    int32_t driftPpb_;
+    int64_t anchorLocalUs_;
+    int64_t anchorOffsetUs_;
+    uint32_t residualUs_;
+    int64_t lastErrorUs_;
+    uint32_t steps_;
+};
+
+#endif // MESH_CLOCK_H
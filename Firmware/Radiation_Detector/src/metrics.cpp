@@ -0,0 +1,143 @@
+/**
+ * @file metrics.cpp
+ * @brief Prometheus /metrics rendered into a static buffer.
+ */
+
+#include "metrics.h"
+#include "sysinfo.h"
+#include "time_base.h"
+#include "fixed_format.h"
+#include <WiFi.h>
+#include <stdarg.h>
+
+static WebServer* metricsServer = nullptr;
+static MetricsSource metricsSource = nullptr;
+static char metricsBuffer[METRICS_BUFFER_SIZE]; ///< Web task only
+
+// Appends formatted text; once the buffer is full every later append is a no-op
+struct MetricsWriter {
+    char* out;
+    size_t size;
+    size_t length;
+    bool overflow;
+
+    void printf(const char* format, ...) __attribute__((format(printf, 2, 3))) {
+        if (overflow) return;
+        va_list args;
+        va_start(args, format);
+        int n = vsnprintf(out + length, size - length, format, args);
+        va_end(args);
+        if (n < 0 || (size_t)n >= size - length) {
+            overflow = true;
+            return;
+        }
+        length += n;
+    }
+
+    void header(const char* name, const char* type, const char* help) {
+        printf("# HELP radscan_%s %s\n# TYPE radscan_%s %s\n", name, help, name, type);
+    }
+
+    // Fixed @p decimals without the printf float path (fixed_format.h)
+    void sample(const char* name, float value, uint8_t decimals) {
+        char text[24];
+        if (!formatFixed(text, sizeof(text), value, decimals)) strlcpy(text, "NaN", sizeof(text));
+        printf("radscan_%s %s\n", name, text);
+    }
+
+    void gauge(const char* name, const char* help, float value, uint8_t decimals) {
+        header(name, "gauge", help);
+        sample(name, value, decimals);
+    }
+
+    void gaugeInt(const char* name, const char* help, long value) {
+        header(name, "gauge", help);
+        printf("radscan_%s %ld\n", name, value);
+    }
+
+    // Cumulative buckets at the log2 bounds of the histogram (latency_histogram.h)
+    void histogram(const char* name, const char* help, const LatencyHistogram& h) {
+        header(name, "histogram", help);
+        unsigned long cumulative = 0;
+        for (uint8_t b = 0; b + 1 < LatencyHistogram::BUCKETS; b++) {
+            cumulative += h.bucket(b);
+            printf("radscan_%s_bucket{le=\"%lu\"} %lu\n", name, 2UL << b, cumulative);
+        }
+        printf("radscan_%s_bucket{le=\"+Inf\"} %lu\n", name, (unsigned long)h.count());
+        printf("radscan_%s_sum %llu\nradscan_%s_count %lu\n", name, (unsigned long long)h.totalUs(), name,
+               (unsigned long)h.count());
+    }
+};
+
+size_t writeMetrics(char* out, size_t size, const MetricsReadings& r) {
+    MetricsWriter w = {out, size, 0, false};
+    w.gauge("dose_rate_usv_h", "Current dose rate in uSv/h.", r.doseRateUsvH, 4);
+    w.gauge("dose_rate_sigma_usv_h", "Count-statistics 1-sigma of the current dose rate in uSv/h.",
+            r.doseRateSigmaUsvH, 4);
+    w.gauge("dose_rate_average_usv_h", "Average dose rate since boot in uSv/h.", r.averageUsvH, 4);
+    w.gauge("dose_rate_average_sigma_usv_h", "Count-statistics 1-sigma of the average dose rate in uSv/h.",
+            r.averageSigmaUsvH, 4);
+    w.header("dose_rate_ewma_usv_h", "gauge", "Exponentially weighted average dose rate in uSv/h by time constant.");
+    for (uint8_t i = 0; i < RATE_EWMA_COUNT; i++) {
+        char text[24];
+        if (!formatFixed(text, sizeof(text), r.averagesUsvH[i], 4)) strlcpy(text, "NaN", sizeof(text));
+        w.printf("radscan_dose_rate_ewma_usv_h{tau=\"%s\"} %s\n", RateEwma::name((RateEwmaId)i), text);
+    }
+    w.gauge("dose_rate_max_usv_h", "Highest dose rate since boot in uSv/h.", r.maximumUsvH, 4);
+    w.gauge("cpm", "Dead-time corrected counts per minute.", r.cpm, 2);
+    w.gauge("cpm_raw", "Counts per minute before dead-time correction.", r.cpmRaw, 2);
+    w.header("counts_total", "counter", "Tube pulses counted since boot.");
+    w.printf("radscan_counts_total %lu\n", (unsigned long)r.totalCounts);
+    w.header("dose_msv_total", "counter", "Cumulative dose in mSv.");
+    w.sample("dose_msv_total", r.cumulativeMsv, 6);
+    w.gaugeInt("alarm_level", "Alarm level, 0 none.", r.alarmLevel);
+    w.histogram("pulse_sample_jitter_us", "Lateness of the PCNT readings past their deadline in us.", r.sampleJitter);
+    w.histogram("pulse_handoff_us", "PCNT reading to pulseTask processing it in us.", r.handoff);
+    w.header("pulse_readings_dropped_total", "counter", "PCNT readings lost with pulseTask behind.");
+    w.printf("radscan_pulse_readings_dropped_total %lu\n", (unsigned long)r.readingsDropped);
+
+    SysInfoSample s = getSysInfoSample();
+    w.gaugeInt("uptime_seconds", "Seconds since boot.", (long)timeBaseSeconds());
+    TimeBaseStatus timeStatus = getTimeBaseStatus();
+    w.gaugeInt("time_synced", "1 once the UTC mapping is valid.", timeStatus.utcValid ? 1 : 0);
+    w.gaugeInt("time_offset_us", "Error of the UTC mapping at the last SNTP result.", (long)timeStatus.lastErrorUs);
+    w.gaugeInt("time_freq_ppb", "Learned oscillator frequency correction.", (long)timeStatus.freqPpb);
+    w.gaugeInt("heap_free_bytes", "Free internal heap.", (long)s.heapFree);
+    w.gaugeInt("heap_largest_block_bytes", "Largest free internal heap block.", (long)s.heapLargest);
+    w.gaugeInt("heap_min_free_bytes", "Internal heap low-water mark since boot.", (long)s.heapMinFree);
+    w.gauge("heap_fragmentation_percent", "1 - largest block / free internal heap, in percent.",
+            s.heapFree ? 100.0f * (1.0f - (float)s.heapLargest / (float)s.heapFree) : 0.0f, 1);
+    w.gaugeInt("psram_free_bytes", "Free PSRAM.", (long)s.psramFree);
+
+    SysInfoTask tasks[SYSINFO_MAX_TASKS];
+    size_t taskCount = getSysInfoTasks(tasks, SYSINFO_MAX_TASKS);
+    w.header("task_stack_free_bytes", "gauge", "Stack never used by the task (high-water mark).");
+    for (size_t i = 0; i < taskCount; i++) {
+        w.printf("radscan_task_stack_free_bytes{task=\"%s\"} %u\n", tasks[i].name, (unsigned)tasks[i].stackFree);
+    }
+    w.header("cpu_load_percent", "gauge", "CPU load per core over the last sysinfo interval.");
+    for (uint8_t core = 0; core < 2; core++) {
+        if (s.cpuLoad[core] >= 0) w.printf("radscan_cpu_load_percent{core=\"%u\"} %d\n", core, s.cpuLoad[core]);
+    }
+
+    if (WiFi.isConnected()) w.gaugeInt("wifi_rssi_dbm", "Received signal strength of the access point.", WiFi.RSSI());
+    return w.overflow ? 0 : w.length;
+}
+
+static void handleMetrics() {
+    MetricsReadings readings = MetricsReadings(); // Zeroed, histograms empty
+    if (metricsSource) metricsSource(readings);
+    size_t length = writeMetrics(metricsBuffer, sizeof(metricsBuffer), readings);
+    if (!length) {
+        metricsServer->send(500, "text/plain", "Metrics buffer too small");
+        return;
+    }
+    metricsServer->sendHeader("Cache-Control", "no-store");
+    metricsServer->send_P(200, "text/plain; version=0.0.4", metricsBuffer, length);
+}
+
+void metricsAttach(WebServer& server, MetricsSource source) {
+    metricsServer = &server;
+    metricsSource = source;
+    server.on("/metrics", HTTP_GET, handleMetrics);
+}
@@ -0,0 +1,47 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <Arduino.h>
+#include <WebServer.h>
+#include "rate_ewma.h"
+#include "latency_histogram.h"
+
+// Prometheus text exposition at /metrics.
+// Each scrape formats the current readings, the sysinfo sample (heap,
+// fragmentation, task stack margins), the time base state and the WiFi RSSI
+// into one static buffer with snprintf(): no String, JsonDocument or heap
+// allocation, and nothing the pulse or UI task waits for. The values are the
+// ones the sysinfo and pulse snapshots hold, so scraping faster than once per
+// second only repeats them. The pulse sampling jitter and hand-over latency
+// ("latency") are Prometheus histograms, so a load test (tools/http_load.py)
+// can take their percentiles over its own window from two scrapes.
+
+#define METRICS_BUFFER_SIZE 8192 // ~6 KB with 30 tasks
+
+// Readings owned by the main loop, copied out by the source function.
+struct MetricsReadings {
+    float doseRateUsvH;
+    float doseRateSigmaUsvH;  ///< Count statistics, 1-sigma
+    float averageUsvH;
+    float averageSigmaUsvH;
+    float averagesUsvH[RATE_EWMA_COUNT]; ///< Exponentially weighted averages (rate_ewma.h)
+    float maximumUsvH;
+    float cumulativeMsv;
+    float cpm;             ///< Dead-time corrected
+    float cpmRaw;
+    uint32_t totalCounts;  ///< Since boot
+    uint8_t alarmLevel;
+    LatencyHistogram sampleJitter;  ///< PCNT reading past its deadline
+    LatencyHistogram handoff;       ///< PCNT reading to pulseTask processing it
+    uint32_t readingsDropped;       ///< Readings lost with pulseTask behind
+};
+
+typedef void (*MetricsSource)(MetricsReadings& out);
+
+// Registers /metrics; @p source is called on the web task for every scrape.
+void metricsAttach(WebServer& server, MetricsSource source);
+
+// Formats the exposition into @p out. @return the length, 0 if it did not fit
+size_t writeMetrics(char* out, size_t size, const MetricsReadings& readings);
+
+#endif // METRICS_H
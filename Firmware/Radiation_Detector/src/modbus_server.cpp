@@ -0,0 +1,308 @@
+/**
+ * @file modbus_server.cpp
+ * @brief Modbus TCP server task over a pre-encoded register block.
+ *
+ * The block is kept in wire order (big-endian registers), so a response is
+ * the MBAP header, two PDU bytes and a memcpy of the requested registers.
+ * Each master has a small frame buffer: a request split across segments is
+ * collected, and requests sent back to back without waiting for the answers
+ * are all answered in order.
+ */
+
+#include "modbus_server.h"
+#include "seqlock.h"
+#include "sysinfo.h"
+#include "debug.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "lwip/sockets.h"
+#include <fcntl.h>
+#include <errno.h>
+
+static const uint32_t TASK_STACK = 4096;
+static const uint32_t SELECT_TIMEOUT_MS = 1000;
+static const size_t   MBAP_LEN = 7;             ///< Transaction, protocol, length, unit
+static const size_t   ADU_MAX = 260;            ///< MBAP and the longest PDU
+static const uint16_t READ_MAX = 125;           ///< Registers per read request
+
+enum ModbusException {
+    MODBUS_ILLEGAL_FUNCTION = 1,
+    MODBUS_ILLEGAL_ADDRESS  = 2,
+    MODBUS_ILLEGAL_VALUE    = 3
+};
+
+struct RegisterBlock {
+    uint8_t bytes[MODBUS_REGISTERS * 2];
+};
+
+struct Client {
+    int fd;                  ///< -1: free
+    uint32_t lastMs;
+    size_t inLen;
+    uint8_t in[ADU_MAX];
+};
+
+static SeqLock<RegisterBlock> blockLock;
+static RegisterBlock encoding;              ///< Publishing task only
+static uint32_t publishes = 0;              ///< Publishing task only
+static Client clients[MODBUS_MAX_CLIENTS];  ///< Server task only
+static int listener = -1;
+static ModbusStats stats;                   ///< Server task writes; readers take a copy
+
+static void putU16(uint8_t* p, uint16_t v) {
+    p[0] = v >> 8;
+    p[1] = v & 0xFF;
+}
+
+static void putU32(uint8_t* p, uint32_t v) {
+    putU16(p, v >> 16);
+    putU16(p + 2, v & 0xFFFF);
+}
+
+static void putFloat(uint8_t* p, float v) {
+    uint32_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    putU32(p, bits);
+}
+
+static uint16_t getU16(const uint8_t* p) {
+    return (uint16_t)(p[0] << 8 | p[1]);
+}
+
+void modbusServerPublish(const ModbusReadings& r) {
+    if (!MODBUS_ENABLED) return;
+    uint8_t* b = encoding.bytes;
+    memset(b, 0, sizeof(encoding.bytes));
+    putFloat(b + 0 * 2, r.doseRateUsvH);
+    putFloat(b + 2 * 2, r.averageUsvH);
+    putFloat(b + 4 * 2, r.maximumUsvH);
+    putFloat(b + 6 * 2, r.cumulativeMsv);
+    putFloat(b + 8 * 2, r.cpm);
+    putFloat(b + 10 * 2, r.cpmRaw);
+    putFloat(b + 12 * 2, r.doseRateSigmaUsvH);
+    putU32(b + 14 * 2, r.totalCounts);
+    putU32(b + 16 * 2, r.lastSecondCounts);
+    putU32(b + 18 * 2, r.secondsClosed);
+    putU16(b + 20 * 2, r.alarmLevel);
+    putU16(b + 21 * 2, r.alarmBits);
+    putU16(b + 22 * 2, r.healthBits);
+    putU16(b + 23 * 2, r.batteryPct);
+    putU16(b + 24 * 2, r.hvVolts);
+    putU16(b + 25 * 2, (uint16_t)r.rssiDbm);
+    putU32(b + 26 * 2, r.uptimeS);
+    putU16(b + 28 * 2, r.freeHeapKb);
+    putU16(b + 29 * 2, MODBUS_MAP_VERSION);
+    blockLock.publish(encoding);
+    publishes++;
+}
+
+static void closeClient(Client& c) {
+    close(c.fd);
+    c.fd = -1;
+    stats.clients--;
+}
+
+/**
+ * @brief Sends a response without waiting: one that does not fit the socket
+ *        buffer means the master stopped reading, and it is disconnected.
+ */
+static bool sendAll(Client& c, const uint8_t* data, size_t len) {
+    while (len) {
+        int n = send(c.fd, data, len, 0);
+        if (n <= 0) return false;
+        data += n;
+        len -= n;
+    }
+    return true;
+}
+
+/**
+ * @brief Answers the complete request at the start of the client's buffer.
+ * @param pduLen PDU bytes after the unit identifier
+ */
+static bool answer(Client& c, size_t pduLen) {
+    const uint8_t* req = c.in;
+    const uint8_t* pdu = req + MBAP_LEN;
+    uint8_t resp[MBAP_LEN + 2 + READ_MAX * 2];
+    memcpy(resp, req, MBAP_LEN); // Transaction, protocol and unit echoed; length set below
+    uint8_t function = pdu[0];
+    uint8_t exception = 0;
+    size_t respPdu = 0;
+
+    stats.requests++;
+    if (function != 3 && function != 4) {
+        exception = MODBUS_ILLEGAL_FUNCTION;
+    } else if (pduLen != 5) {
+        exception = MODBUS_ILLEGAL_VALUE;
+    } else {
+        uint16_t start = getU16(pdu + 1);
+        uint16_t count = getU16(pdu + 3);
+        if (count == 0 || count > READ_MAX) {
+            exception = MODBUS_ILLEGAL_VALUE;
+        } else if ((uint32_t)start + count > MODBUS_REGISTERS) {
+            exception = MODBUS_ILLEGAL_ADDRESS;
+        } else {
+            RegisterBlock block;
+            if (!blockLock.read(block)) memset(&block, 0, sizeof(block)); // Only with a publisher gone wild
+            resp[MBAP_LEN] = function;
+            resp[MBAP_LEN + 1] = count * 2;
+            memcpy(resp + MBAP_LEN + 2, block.bytes + start * 2, count * 2);
+            respPdu = 2 + count * 2;
+        }
+    }
+    if (exception) {
+        stats.exceptions++;
+        resp[MBAP_LEN] = function | 0x80;
+        resp[MBAP_LEN + 1] = exception;
+        respPdu = 2;
+    }
+    putU16(resp + 4, 1 + respPdu); // Unit identifier and PDU
+    return sendAll(c, resp, MBAP_LEN + respPdu);
+}
+
+/**
+ * @brief Reads what the master sent and answers every complete request in it.
+ */
+static void serveClient(Client& c, uint32_t nowMs) {
+    int n = recv(c.fd, c.in + c.inLen, sizeof(c.in) - c.inLen, MSG_DONTWAIT);
+    if (n <= 0) {
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return;
+        closeClient(c); // Closed by the master
+        return;
+    }
+    c.inLen += n;
+    c.lastMs = nowMs;
+    while (c.inLen >= MBAP_LEN) {
+        uint16_t protocol = getU16(c.in + 2);
+        uint16_t length = getU16(c.in + 4);
+        if (protocol != 0 || length < 2 || MBAP_LEN - 1 + length > ADU_MAX) {
+            stats.dropped++;
+            closeClient(c); // Not Modbus; there is no resynchronising a TCP stream
+            return;
+        }
+        size_t frame = MBAP_LEN - 1 + length;
+        if (c.inLen < frame) return;
+        if (!answer(c, length - 1)) {
+            closeClient(c);
+            return;
+        }
+        memmove(c.in, c.in + frame, c.inLen - frame);
+        c.inLen -= frame;
+    }
+}
+
+static void acceptClient(uint32_t nowMs) {
+    int fd = accept(listener, NULL, NULL);
+    if (fd < 0) return;
+    Client* slot = nullptr;
+    for (uint8_t i = 0; i < MODBUS_MAX_CLIENTS; i++) {
+        Client& c = clients[i];
+        if (c.fd < 0) {
+            slot = &c;
+            break;
+        }
+        if (!slot || (int32_t)(c.lastMs - slot->lastMs) < 0) slot = &c;
+    }
+    if (slot->fd >= 0) {
+        closeClient(*slot); // All in use: the longest-idle master goes
+        stats.evicted++;
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    slot->fd = fd;
+    slot->lastMs = nowMs;
+    slot->inLen = 0;
+    stats.accepted++;
+    stats.clients++;
+}
+
+static bool openListener() {
+    listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (listener < 0) return false;
+    int one = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(MODBUS_PORT);
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind(listener, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(listener, MODBUS_MAX_CLIENTS) != 0) {
+        close(listener);
+        listener = -1;
+        return false;
+    }
+    fcntl(listener, F_SETFL, fcntl(listener, F_GETFL, 0) | O_NONBLOCK);
+    return true;
+}
+
+static void modbusTask(void* parameter) {
+    if (!openListener()) {
+        DEBUG_PRINTLN("Modbus: listener not opened");
+        vTaskDelete(NULL);
+        return;
+    }
+    for (uint8_t i = 0; i < MODBUS_MAX_CLIENTS; i++) clients[i].fd = -1;
+    stats.running = true;
+    DEBUG_PRINTF("Modbus: listening on port %u\n", (unsigned)MODBUS_PORT);
+
+    while (true) {
+        fd_set rd;
+        FD_ZERO(&rd);
+        FD_SET(listener, &rd);
+        int maxFd = listener;
+        for (uint8_t i = 0; i < MODBUS_MAX_CLIENTS; i++) {
+            if (clients[i].fd < 0) continue;
+            FD_SET(clients[i].fd, &rd);
+            if (clients[i].fd > maxFd) maxFd = clients[i].fd;
+        }
+        struct timeval tv = {(time_t)(SELECT_TIMEOUT_MS / 1000), (suseconds_t)(SELECT_TIMEOUT_MS % 1000 * 1000)};
+        int ready = select(maxFd + 1, &rd, NULL, NULL, &tv);
+        if (ready < 0) FD_ZERO(&rd);
+        uint32_t nowMs = millis();
+
+        for (uint8_t i = 0; i < MODBUS_MAX_CLIENTS; i++) {
+            Client& c = clients[i];
+            if (c.fd < 0) continue;
+            if (FD_ISSET(c.fd, &rd)) {
+                serveClient(c, nowMs);
+            } else if (nowMs - c.lastMs > MODBUS_IDLE_TIMEOUT_MS) {
+                stats.dropped++;
+                closeClient(c);
+            }
+        }
+        // Accepted last: the new socket was not part of this select()
+        if (ready > 0 && FD_ISSET(listener, &rd)) acceptClient(nowMs);
+    }
+}
+
+bool initModbusServer() {
+    if (!MODBUS_ENABLED) return false;
+    TaskHandle_t handle = NULL;
+    if (xTaskCreatePinnedToCore(modbusTask, "Modbus", TASK_STACK, NULL, NETWORK_TASK_PRIORITY, &handle,
+                                TASK_CORE_NETWORK) != pdPASS) {
+        DEBUG_PRINTLN("Error: Modbus task not created");
+        return false;
+    }
+    sysInfoWatchTask(handle, TASK_STACK);
+    return true;
+}
+
+ModbusStats getModbusStats() {
+    ModbusStats s = stats;
+    s.publishes = publishes;
+    return s;
+}
+
+void printModbusServer(Print& out) {
+    if (!MODBUS_ENABLED) {
+        out.println("Modbus TCP: off (MODBUS_ENABLED)");
+        return;
+    }
+    ModbusStats s = getModbusStats();
+    out.printf("Modbus TCP: %s on port %u, %u of %u masters connected\n", s.running ? "listening" : "not running",
+               (unsigned)MODBUS_PORT, (unsigned)s.clients, (unsigned)MODBUS_MAX_CLIENTS);
+    out.printf("  %lu accepted, %lu evicted, %lu dropped; %lu requests, %lu exceptions; %lu blocks published\n",
+               (unsigned long)s.accepted, (unsigned long)s.evicted, (unsigned long)s.dropped,
+               (unsigned long)s.requests, (unsigned long)s.exceptions, (unsigned long)s.publishes);
+}
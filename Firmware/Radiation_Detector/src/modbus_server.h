@@ -0,0 +1,102 @@
+#ifndef MODBUS_SERVER_H
+#define MODBUS_SERVER_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Modbus TCP server on MODBUS_PORT for SCADA masters (MODBUS_ENABLED).
+// The register block is encoded once per dose snapshot publication, on the
+// publishing task, and handed over through a sequence lock; a read request is
+// a copy of the block and of the requested range, with no reading, scaling or
+// locking of the measurement on the server side. One task on
+// TASK_CORE_NETWORK serves up to MODBUS_MAX_CLIENTS masters with
+// non-blocking sockets and select(), so a slow master does not hold up the
+// others, and nothing of it runs on the UI task.
+//
+// Function codes 3 (read holding registers) and 4 (read input registers)
+// read the same block; others answer exception 1, a range past the block
+// exception 2, a count of 0 or over 125 exception 3. The unit identifier is
+// echoed and not checked. 32-bit values take two registers, high word first;
+// floats are IEEE 754.
+//
+//   Reg  Words  Value
+//    0   2      Dose rate, uSv/h (float)
+//    2   2      Average dose rate since the start, uSv/h (float)
+//    4   2      Maximum dose rate, uSv/h (float)
+//    6   2      Cumulative dose, mSv (float)
+//    8   2      Count rate, dead-time corrected, CPM (float)
+//   10   2      Count rate as counted, CPM (float)
+//   12   2      Dose rate 1-sigma, uSv/h (float)
+//   14   2      Counts since boot
+//   16   2      Counts in the last second
+//   18   2      Seconds closed since boot; stops moving if the pipeline stalls
+//   20   1      Alarm level (0 none, 1 warning, 2 alarm, 3 danger)
+//   21   1      Alarm bits: 0-4 causes (rate, dose, rise, predicted, isotope),
+//               8 sounding, 9 alarms enabled
+//   22   1      Health bits: 0 HV regulated, 1 HV fault, 2 battery low,
+//               3 high-range tube, 4 UTC valid, 5 WiFi connected,
+//               6 Ethernet online
+//   23   1      Battery, percent (0xFFFF without a battery)
+//   24   1      High voltage measured, V
+//   25   1      WiFi RSSI, dBm (signed)
+//   26   2      Uptime, s
+//   28   1      Free heap, KB
+//   29   1      Register map version (MODBUS_MAP_VERSION)
+//   30   2      Reserved (0)
+
+#define MODBUS_REGISTERS   32
+#define MODBUS_MAP_VERSION 1
+
+// Values for one block, filled by the publishing task.
+struct ModbusReadings {
+    float doseRateUsvH;
+    float averageUsvH;
+    float maximumUsvH;
+    float cumulativeMsv;
+    float cpm;
+    float cpmRaw;
+    float doseRateSigmaUsvH;
+    uint32_t totalCounts;
+    uint32_t lastSecondCounts;
+    uint32_t secondsClosed;
+    uint8_t alarmLevel;
+    uint16_t alarmBits;
+    uint16_t healthBits;
+    uint16_t batteryPct;      ///< 0xFFFF without a battery
+    uint16_t hvVolts;
+    int16_t rssiDbm;
+    uint32_t uptimeS;
+    uint16_t freeHeapKb;
+};
+
+enum ModbusHealthBits {
+    MODBUS_HEALTH_HV_OK      = 1 << 0,
+    MODBUS_HEALTH_HV_FAULT   = 1 << 1,
+    MODBUS_HEALTH_BATTERY_LOW = 1 << 2,
+    MODBUS_HEALTH_HIGH_RANGE = 1 << 3,
+    MODBUS_HEALTH_UTC_VALID  = 1 << 4,
+    MODBUS_HEALTH_WIFI       = 1 << 5,
+    MODBUS_HEALTH_ETHERNET   = 1 << 6
+};
+
+struct ModbusStats {
+    bool running;
+    uint8_t clients;          ///< Connected masters
+    uint32_t accepted;
+    uint32_t evicted;         ///< Idle masters closed for a new one
+    uint32_t requests;
+    uint32_t exceptions;      ///< Requests answered with an exception
+    uint32_t dropped;         ///< Connections closed for a malformed frame or timeout
+    uint32_t publishes;       ///< Blocks encoded since boot
+};
+
+// Starts the server task. Call once in setup(); does nothing unless MODBUS_ENABLED.
+bool initModbusServer();
+
+// Encodes @p readings into the block the masters read. Wait-free; one task only.
+void modbusServerPublish(const ModbusReadings& readings);
+
+ModbusStats getModbusStats();
+void printModbusServer(Print& out);
+
+#endif // MODBUS_SERVER_H
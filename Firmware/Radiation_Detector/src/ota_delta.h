@@ -0,0 +1,134 @@
+#ifndef OTA_DELTA_H
+#define OTA_DELTA_H
+
+#include <stdint.h>
+#include <string.h>
+
+// Applies a binary delta against the running firmware image as a stream.
+// The delta (tools/make_ota_image.py) is a sequence of operations, all
+// integers little-endian:
+//   0x01 u32 offset u32 length   copy length bytes of the base image at offset
+//   0x02 u32 length, bytes       insert the bytes that follow
+// Input can be fed in pieces of any size; an operation split across pieces is
+// resumed. Copies go through a fixed buffer, so memory use does not depend on
+// the image size. The sink writes the output (the OTA partition), the source
+// reads the base (the running partition). No Arduino dependencies
+// (host-compilable).
+
+class OtaDeltaDecoder {
+public:
+    typedef bool (*Sink)(const uint8_t* data, uint32_t length, void* context);
+    typedef bool (*Source)(uint32_t offset, uint8_t* data, uint32_t length, void* context);
+
+    static const uint8_t OP_COPY = 0x01;
+    static const uint8_t OP_INSERT = 0x02;
+    static const uint32_t COPY_CHUNK = 1024;
+
+    OtaDeltaDecoder(Sink sink, Source source, void* context) : sink_(sink), source_(source), context_(context) {
+        reset(0, 0);
+    }
+
+    /// Starts a delta against a base of @p baseSize bytes producing @p outputSize bytes.
+    void reset(uint32_t baseSize, uint32_t outputSize) {
+        baseSize_ = baseSize;
+        outputSize_ = outputSize;
+        written_ = 0;
+        state_ = READ_OP;
+        argBytes_ = 0;
+        remaining_ = 0;
+        error_ = nullptr;
+    }
+
+    /**
+     * @brief Consumes @p length bytes of the operation stream.
+     * @return false on a malformed stream or a failed read / write (see error())
+     */
+    bool feed(const uint8_t* data, uint32_t length) {
+        while (length && !error_) {
+            if (state_ == READ_OP) {
+                op_ = *data++;
+                length--;
+                if (op_ != OP_COPY && op_ != OP_INSERT) return failWith("unknown delta operation");
+                argBytes_ = 0;
+                state_ = READ_ARGS;
+            } else if (state_ == READ_ARGS) {
+                uint8_t need = op_ == OP_COPY ? 8 : 4;
+                while (length && argBytes_ < need) {
+                    args_[argBytes_++] = *data++;
+                    length--;
+                }
+                if (argBytes_ < need) break;
+                uint32_t first = readU32(args_);
+                if (op_ == OP_COPY) {
+                    if (!copy(first, readU32(args_ + 4))) break;
+                    state_ = READ_OP;
+                } else {
+                    if (first > outputSize_ - written_) return failWith("delta output too long");
+                    remaining_ = first;
+                    state_ = remaining_ ? INSERT : READ_OP;
+                }
+            } else {
+                uint32_t n = length < remaining_ ? length : remaining_;
+                if (!write(data, n)) break;
+                data += n;
+                length -= n;
+                remaining_ -= n;
+                if (!remaining_) state_ = READ_OP;
+            }
+        }
+        return !error_;
+    }
+
+    /// @return true if the stream ended between operations with the whole output written
+    bool complete() const { return !error_ && state_ == READ_OP && written_ == outputSize_; }
+
+    uint32_t written() const { return written_; }
+    const char* error() const { return error_; }
+
+private:
+    enum State { READ_OP, READ_ARGS, INSERT };
+
+    static uint32_t readU32(const uint8_t* p) {
+        return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+    }
+
+    bool failWith(const char* error) {
+        error_ = error;
+        return false;
+    }
+
+    bool write(const uint8_t* data, uint32_t length) {
+        if (!sink_(data, length, context_)) return failWith("write failed");
+        written_ += length;
+        return true;
+    }
+
+    bool copy(uint32_t offset, uint32_t length) {
+        if (offset > baseSize_ || length > baseSize_ - offset) return failWith("delta copy outside the base");
+        if (length > outputSize_ - written_) return failWith("delta output too long");
+        while (length) {
+            uint32_t n = length < COPY_CHUNK ? length : COPY_CHUNK;
+            if (!source_(offset, buffer_, n, context_)) return failWith("base read failed");
+            if (!write(buffer_, n)) return false;
+            offset += n;
+            length -= n;
+        }
+        return true;
+    }
+
+    Sink sink_;
+    Source source_;
+    void* context_;
+    uint32_t baseSize_;
+    uint32_t outputSize_;
+    uint32_t written_;
+    State state_;
+    uint8_t op_;
+    uint8_t args_[8];
+    uint8_t argBytes_;
+    uint32_t remaining_;
+    const char* error_;
+    uint8_t buffer_[COPY_CHUNK];
+};
+
+#endif // OTA_DELTA_H
@@ -0,0 +1,293 @@
+/**
+ * @file ota_guard.cpp
+ * @brief ElegantOTA hooks: checkpoints, pacing, read-back digest and rollback.
+ *
+ * The hooks run inside ElegantOTA's handlers on the web task. Updater commits
+ * a 4 KB sector at a time (erase and write with the flash cache off), which
+ * stalls code running from flash on both cores for that sector; yielding
+ * between sectors keeps those stalls apart instead of back to back. Interrupt
+ * handlers in IRAM and the PCNT hardware keep counting through them.
+ *
+ * The digest is taken from flash after Updater finished, so it covers what the
+ * bootloader will load, not only what arrived over the network.
+ */
+
+#include "ota_guard.h"
+#include "seqlock.h"
+#include "settings_store.h"
+#include "dose_checkpoint.h"
+#include "supervisor.h"
+#include "debug.h"
+#include <ElegantOTA.h>
+#include "json_arena.h"
+#include "web_arena.h"
+#include <ArduinoJson.h>
+#include <atomic>
+#include "esp_ota_ops.h"
+#include "esp_partition.h"
+#include "mbedtls/sha256.h"
+
+static const uint32_t READBACK_CHUNK = 4096;
+static const uint32_t READBACK_YIELD_BYTES = 32768;
+static const uint32_t CLAIM_TIMEOUT_MS = 2000;
+
+static SeqLock<OtaStatus> statusLock;
+static OtaStatus status;                 ///< Web task only; published to statusLock
+static WebServer* otaServer = nullptr;
+static uint8_t expectedDigest[32];
+static uint32_t startMs = 0;
+static uint32_t lastYieldBytes = 0;
+static uint32_t readyMs = 0;
+static std::atomic<bool> pendingVerify(false);
+static std::atomic<uint8_t> partitionOwner(OTA_OWNER_NONE);
+static bool confirmChecked = false;      ///< uiTask only
+
+// Arduino marks the running image valid at boot unless this returns true
+extern "C" bool verifyRollbackLater() {
+    return true;
+}
+
+static void publish() {
+    status.elapsedMs = startMs ? millis() - startMs : 0;
+    statusLock.publish(status);
+}
+
+static void fail(const char* error) {
+    status.state = OTA_FAILED;
+    strlcpy(status.error, error, sizeof(status.error));
+    publish();
+    DEBUG_PRINTF("OTA: %s\n", error);
+}
+
+static bool parseDigest(const String& hex, uint8_t* out) {
+    if (hex.length() != 64) return false;
+    for (uint8_t i = 0; i < 32; i++) {
+        char pair[3] = {hex[2 * i], hex[2 * i + 1], '\0'};
+        char* end = nullptr;
+        out[i] = (uint8_t)strtoul(pair, &end, 16);
+        if (end != pair + 2) return false;
+    }
+    return true;
+}
+
+bool otaPartitionSha256(const esp_partition_t* partition, uint32_t length, uint8_t* digest) {
+    static uint8_t chunk[READBACK_CHUNK];
+    mbedtls_sha256_context ctx;
+    mbedtls_sha256_init(&ctx);
+    mbedtls_sha256_starts_ret(&ctx, 0);
+    bool ok = true;
+    for (uint32_t offset = 0; offset < length && ok; offset += READBACK_CHUNK) {
+        uint32_t n = length - offset < READBACK_CHUNK ? length - offset : READBACK_CHUNK;
+        ok = esp_partition_read(partition, offset, chunk, n) == ESP_OK;
+        if (ok) mbedtls_sha256_update_ret(&ctx, chunk, n);
+        if ((offset + n) % READBACK_YIELD_BYTES == 0) vTaskDelay(1);
+    }
+    mbedtls_sha256_finish_ret(&ctx, digest);
+    mbedtls_sha256_free(&ctx);
+    return ok;
+}
+
+bool otaGuardStart(bool firmware, uint32_t total, const uint8_t* digest) {
+    if (status.state == OTA_RECEIVING || status.state == OTA_VERIFYING) return false;
+    memset(&status, 0, sizeof(status));
+    status.state = OTA_RECEIVING;
+    status.firmware = firmware;
+    // A background download (fleet_ota.h) gives the partition up between sectors
+    uint32_t waitStartMs = millis();
+    while (firmware && !otaPartitionClaim(OTA_OWNER_PUSH)) {
+        if (millis() - waitStartMs >= CLAIM_TIMEOUT_MS) {
+            fail("OTA partition busy");
+            return false;
+        }
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    status.total = total;
+    status.digestExpected = digest != nullptr;
+    if (digest) memcpy(expectedDigest, digest, sizeof(expectedDigest));
+    startMs = millis();
+    lastYieldBytes = 0;
+    readyMs = 0;
+    publish();
+    // Settings still waiting for their quiet period, and the dose accumulated
+    // since the last checkpoint, must reach NVS before the flash gets busy
+    settingsFlush();
+    doseCheckpointSave();
+    DEBUG_PRINTF("OTA: %s update started%s\n", firmware ? "firmware" : "filesystem",
+                 digest ? ", SHA-256 given" : "");
+    return true;
+}
+
+void otaGuardProgress(uint32_t written) {
+    if (status.state != OTA_RECEIVING) return;
+    status.written = written;
+    supervisorHeartbeat(); // The upload runs inside one request on the web task
+    if (written - lastYieldBytes >= OTA_YIELD_BYTES) {
+        lastYieldBytes = written;
+        publish();
+        vTaskDelay(1); // Gap after each committed sector
+    }
+}
+
+static void finishUpload(bool success, const char* error) {
+    if (status.state != OTA_RECEIVING) {
+        // Refused at start: Updater has made the upload the boot image regardless
+        if (success && status.firmware) esp_ota_set_boot_partition(esp_ota_get_running_partition());
+        return;
+    }
+    if (!success) {
+        fail(error);
+        return;
+    }
+    status.state = OTA_VERIFYING;
+    publish();
+
+    // Updater already checked the image format and the image's own checksum
+    const esp_partition_t* partition =
+        status.firmware ? esp_ota_get_next_update_partition(NULL)
+                        : esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_SPIFFS, NULL);
+    uint8_t digest[32];
+    if (!partition || !otaPartitionSha256(partition, status.written, digest)) {
+        if (status.firmware) esp_ota_set_boot_partition(esp_ota_get_running_partition());
+        fail("read-back failed");
+        return;
+    }
+    for (uint8_t i = 0; i < 32; i++) snprintf(status.sha256 + 2 * i, 3, "%02x", digest[i]);
+    if (status.digestExpected && memcmp(digest, expectedDigest, sizeof(digest)) != 0) {
+        // Keep booting the running image; the new one is never started
+        if (status.firmware) esp_ota_set_boot_partition(esp_ota_get_running_partition());
+        fail("SHA-256 mismatch");
+        return;
+    }
+    status.state = OTA_READY;
+    readyMs = millis();
+    publish();
+    DEBUG_PRINTF("OTA: %lu bytes verified in %lu ms, SHA-256 %s\n", (unsigned long)status.written,
+                 (unsigned long)status.elapsedMs, status.sha256);
+}
+
+void otaGuardEnd(bool success, const char* error) {
+    finishUpload(success, error);
+    // A verified image keeps the partition until the reboot
+    if (status.state != OTA_READY) otaPartitionRelease(OTA_OWNER_PUSH);
+}
+
+bool otaPartitionClaim(uint8_t owner) {
+    uint8_t expected = OTA_OWNER_NONE;
+    return partitionOwner.compare_exchange_strong(expected, owner) || expected == owner;
+}
+
+void otaPartitionRelease(uint8_t owner) {
+    uint8_t expected = owner;
+    partitionOwner.compare_exchange_strong(expected, OTA_OWNER_NONE);
+}
+
+bool otaGuardActive() {
+    return status.state == OTA_RECEIVING || status.state == OTA_VERIFYING;
+}
+
+static void onOtaStart() {
+    bool firmware = otaServer->arg("mode") != "fs";
+    String hex = otaServer->arg("sha256");
+    uint8_t digest[32];
+    if (hex.length() && !parseDigest(hex, digest)) {
+        // The upload still runs; otaGuardEnd() discards it
+        otaGuardStart(firmware, 0, nullptr);
+        fail("sha256 must be 64 hex digits");
+        return;
+    }
+    otaGuardStart(firmware, otaServer->clientContentLength(), hex.length() ? digest : nullptr);
+}
+
+static void onOtaProgress(size_t current, size_t final) {
+    otaGuardProgress(current);
+}
+
+static void onOtaEnd(bool success) {
+    otaGuardEnd(success, Update.errorString());
+}
+
+void otaGuardBegin() {
+    esp_ota_img_states_t state;
+    if (esp_ota_get_state_partition(esp_ota_get_running_partition(), &state) == ESP_OK &&
+        state == ESP_OTA_IMG_PENDING_VERIFY) {
+        pendingVerify = true;
+        DEBUG_PRINTLN("OTA: first boot of a new image, confirming after the health check");
+    }
+}
+
+void otaGuardAttach(WebServer& server) {
+    otaServer = &server;
+    ElegantOTA.setAutoReboot(false);
+    ElegantOTA.onStart(onOtaStart);
+    ElegantOTA.onProgress(onOtaProgress);
+    ElegantOTA.onEnd(onOtaEnd);
+    server.on("/api/ota", HTTP_GET, []() {
+        OtaStatus s = getOtaStatus();
+        JsonArenaLease lease;
+        JsonDocument doc(lease.allocator());
+        doc["state"] = otaStateName(s.state);
+        doc["firmware"] = s.firmware;
+        doc["written"] = s.written;
+        doc["total"] = s.total;
+        doc["elapsed_ms"] = s.elapsedMs;
+        doc["sha256"] = s.sha256;
+        doc["sha256_checked"] = s.digestExpected;
+        doc["error"] = s.error;
+        doc["pending_verify"] = otaPendingVerify();
+        otaServer->sendHeader("Cache-Control", "no-store");
+        otaServer->sendHeader("Access-Control-Allow-Origin", "*");
+        webSendJson(*otaServer, 200, doc);
+    });
+}
+
+void otaGuardLoop(uint32_t nowMs) {
+    if (status.state != OTA_READY || nowMs - readyMs < OTA_REBOOT_DELAY_MS) return;
+    DEBUG_PRINTLN("OTA: rebooting into the new image");
+    doseCheckpointSave(); // Dose counted during the upload
+    debugLogFlush(200); // The reboot message above
+    ESP.restart();
+}
+
+void otaGuardConfirm(uint32_t nowMs, uint32_t secondsClosed) {
+    if (!pendingVerify || confirmChecked) return;
+    // The pulse pipeline has closed a bucket for (nearly) every second since boot
+    if (nowMs >= OTA_CONFIRM_AFTER_MS && secondsClosed + 5 >= OTA_CONFIRM_AFTER_MS / 1000) {
+        confirmChecked = true;
+        pendingVerify = false;
+        esp_ota_mark_app_valid_cancel_rollback();
+        DEBUG_PRINTLN("OTA: new image confirmed");
+    } else if (nowMs >= OTA_CONFIRM_TIMEOUT_MS) {
+        confirmChecked = true;
+        DEBUG_PRINTLN("OTA: new image not healthy, rolling back");
+        doseCheckpointSave();
+        esp_ota_mark_app_invalid_rollback_and_reboot(); // Returns only if there is nothing to roll back to
+    }
+}
+
+bool otaPendingVerify() {
+    return pendingVerify.load();
+}
+
+OtaStatus getOtaStatus() {
+    OtaStatus s;
+    memset(&s, 0, sizeof(s));
+    statusLock.read(s);
+    return s;
+}
+
+const char* otaStateName(uint8_t state) {
+    static const char* NAMES[] = {"idle", "receiving", "verifying", "ready", "failed"};
+    return state <= OTA_FAILED ? NAMES[state] : "?";
+}
+
+void printOtaStatus(Print& out) {
+    OtaStatus s = getOtaStatus();
+    const esp_partition_t* running = esp_ota_get_running_partition();
+    out.printf("OTA: %s, running from %s%s\n", otaStateName(s.state), running ? running->label : "?",
+               otaPendingVerify() ? " (not confirmed yet)" : "");
+    if (s.state == OTA_IDLE) return;
+    out.printf("  %s image, %lu of %lu bytes in %lu ms\n", s.firmware ? "firmware" : "filesystem",
+               (unsigned long)s.written, (unsigned long)s.total, (unsigned long)s.elapsedMs);
+    if (s.sha256[0]) out.printf("  SHA-256 %s%s\n", s.sha256, s.digestExpected && s.state == OTA_READY ? " (matches)" : "");
+    if (s.error[0]) out.printf("  error: %s\n", s.error);
+}
@@ -0,0 +1,90 @@
+#ifndef OTA_GUARD_H
+#define OTA_GUARD_H
+
+#include <Arduino.h>
+#include <WebServer.h>
+#include "config.h"
+#include "esp_partition.h"
+
+// Firmware updates through ElegantOTA without taking the detector offline.
+// Uploads are received on the web task (webTask), never on uiTask or
+// pulseTask, so the readings, charts and alarms keep running; after every
+// OTA_YIELD_BYTES the web task yields so each flash-sector commit is followed
+// by a gap for the other tasks. ElegantOTA's hooks:
+//  - start:    flush the settings, checkpoint the dose, note the expected
+//              digest (/ota/start?...&sha256=<64 hex>),
+//  - progress: bytes written, shown on the display and at /api/ota,
+//  - end:      read the written image back from flash and compare its SHA-256;
+//              on a mismatch the previous firmware stays the boot partition.
+// The reboot is done here (auto reboot off): one more dose checkpoint, then
+// restart OTA_REBOOT_DELAY_MS after a verified image.
+//
+// Rollback: the Arduino core would mark every booted image valid at once;
+// verifyRollbackLater() defers that. A new image is confirmed once the pulse
+// pipeline has run for OTA_CONFIRM_AFTER_MS; if it has not by
+// OTA_CONFIRM_TIMEOUT_MS (or the firmware crashes before), the bootloader
+// returns to the previous image. Needs a bootloader built with
+// CONFIG_BOOTLOADER_APP_ROLLBACK_ENABLE; without it confirming is a no-op.
+
+enum OtaState {
+    OTA_IDLE = 0,
+    OTA_RECEIVING,
+    OTA_VERIFYING,   ///< Reading the image back for the digest
+    OTA_READY,       ///< Verified, reboot pending
+    OTA_FAILED
+};
+
+struct OtaStatus {
+    uint8_t state;         ///< OtaState
+    bool firmware;         ///< App image (false: filesystem image)
+    bool digestExpected;   ///< sha256= was given at start
+    uint32_t written;
+    uint32_t total;        ///< Upload size as announced, 0 if unknown
+    uint32_t elapsedMs;
+    char error[40];
+    char sha256[65];       ///< Digest of the written image, hex
+};
+
+// Notes whether this boot is the first of a new image. Call early in setup().
+void otaGuardBegin();
+
+// Registers the ElegantOTA hooks and /api/ota. Call after ElegantOTA.begin().
+void otaGuardAttach(WebServer& server);
+
+// Upload paths of their own (ota_stream.h) report through these, so the
+// checkpoints, pacing, read-back and reboot are the same as for ElegantOTA.
+// Web task only. @return false from start while another update is running
+bool otaGuardStart(bool firmware, uint32_t total, const uint8_t* expectedSha256);
+void otaGuardProgress(uint32_t written);
+void otaGuardEnd(bool success, const char* error);
+bool otaGuardActive();
+
+// The passive app partition has one writer at a time: an upload here, the
+// background download (fleet_ota.h) or an image from the card (card_update.h).
+// Any task. @return false while another owner holds it
+enum OtaOwner { OTA_OWNER_NONE = 0, OTA_OWNER_PUSH, OTA_OWNER_FLEET, OTA_OWNER_CARD };
+bool otaPartitionClaim(uint8_t owner);
+void otaPartitionRelease(uint8_t owner);
+
+// SHA-256 of the first @p length bytes of a partition, read back in chunks
+// with yields in between. @return false if a read failed
+bool otaPartitionSha256(const esp_partition_t* partition, uint32_t length, uint8_t* digest);
+
+// Performs the pending reboot. Call from the web task.
+void otaGuardLoop(uint32_t nowMs);
+
+// Confirms a freshly updated image once the pulse pipeline has been running
+// for long enough, or rolls it back. Call from uiTask with the closed
+// 1-second buckets since boot.
+void otaGuardConfirm(uint32_t nowMs, uint32_t secondsClosed);
+
+// True while this boot still waits for confirmation.
+bool otaPendingVerify();
+
+OtaStatus getOtaStatus();
+
+const char* otaStateName(uint8_t state);
+
+void printOtaStatus(Print& out);
+
+#endif // OTA_GUARD_H
@@ -0,0 +1,251 @@
+/**
+ * @file ota_stream.cpp
+ * @brief Streaming inflate (and delta) into the OTA partition for POST /ota/stream.
+ *
+ * Everything happens in the WebServer upload callback on the web task: each
+ * received piece is inflated into the circular 32 KB dictionary tinfl needs,
+ * and whatever comes out is written before the next piece is read, so memory
+ * stays bounded at the window, the inflater state and one copy buffer.
+ */
+
+#include "ota_stream.h"
+#include "ota_guard.h"
+#include "ota_delta.h"
+#include "debug.h"
+#include <Update.h>
+#include <new>
+#include "esp_ota_ops.h"
+#include "esp_heap_caps.h"
+#if CONFIG_IDF_TARGET_ESP32S3
+#include "esp32s3/rom/miniz.h"
+#else
+#include "esp32/rom/miniz.h"
+#endif
+
+static const uint32_t STREAM_MAGIC = 0x315a4452; // "RDZ1"
+static const uint8_t KIND_FULL = 0;
+static const uint8_t KIND_DELTA = 1;
+
+struct StreamHeader {
+    uint32_t magic;
+    uint8_t kind;
+    uint8_t reserved[3];
+    uint32_t imageSize;
+    uint32_t baseSize;
+    uint8_t imageSha256[32];
+    uint8_t baseSha256[32];
+};
+
+static_assert(sizeof(StreamHeader) == 80, "OTA stream header (tools/make_ota_image.py)");
+
+struct StreamState {
+    StreamHeader header;
+    uint32_t headerBytes;
+    bool started;          ///< Update and otaGuard are running
+    const char* error;
+    tinfl_decompressor* inflater;
+    uint8_t* window;       ///< TINFL_LZ_DICT_SIZE, circular
+    uint32_t windowPos;
+    bool inflateDone;
+    uint32_t written;
+    const esp_partition_t* base;
+};
+
+static WebServer* streamServer = nullptr;
+static StreamState stream;
+
+static bool writeImage(const uint8_t* data, uint32_t length, void* context) {
+    if (Update.write((uint8_t*)data, length) != length) return false;
+    stream.written += length;
+    otaGuardProgress(stream.written);
+    return true;
+}
+
+static bool readBase(uint32_t offset, uint8_t* data, uint32_t length, void* context) {
+    return esp_partition_read(stream.base, offset, data, length) == ESP_OK;
+}
+
+static OtaDeltaDecoder* delta = nullptr; ///< Allocated with the window, delta uploads only
+
+static void releaseBuffers() {
+    heap_caps_free(stream.inflater);
+    heap_caps_free(stream.window);
+    delete delta;
+    stream.inflater = nullptr;
+    stream.window = nullptr;
+    delta = nullptr;
+}
+
+static void fail(const char* error) {
+    if (stream.error) return;
+    stream.error = error;
+    if (stream.started) {
+        Update.abort();
+        otaGuardEnd(false, error);
+    }
+    releaseBuffers();
+    DEBUG_PRINTF("OTA stream: %s\n", error);
+}
+
+/**
+ * @brief Checks the header, the base image of a delta, and starts the update.
+ */
+static void beginImage() {
+    const StreamHeader& h = stream.header;
+    if (h.magic != STREAM_MAGIC || (h.kind != KIND_FULL && h.kind != KIND_DELTA)) {
+        fail("not an RDZ1 image");
+        return;
+    }
+    if (h.kind == KIND_DELTA) {
+        stream.base = esp_ota_get_running_partition();
+        uint8_t digest[32];
+        if (!stream.base || h.baseSize > stream.base->size ||
+            !otaPartitionSha256(stream.base, h.baseSize, digest) ||
+            memcmp(digest, h.baseSha256, sizeof(digest)) != 0) {
+            fail("delta base is not the running image");
+            return;
+        }
+    }
+
+    // The window is only read back by tinfl itself: PSRAM is fast enough
+    stream.inflater = (tinfl_decompressor*)heap_caps_malloc(sizeof(tinfl_decompressor), MALLOC_CAP_8BIT);
+    stream.window = (uint8_t*)heap_caps_malloc(TINFL_LZ_DICT_SIZE, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!stream.window) stream.window = (uint8_t*)heap_caps_malloc(TINFL_LZ_DICT_SIZE, MALLOC_CAP_8BIT);
+    if (h.kind == KIND_DELTA) delta = new (std::nothrow) OtaDeltaDecoder(writeImage, readBase, nullptr);
+    if (!stream.inflater || !stream.window || (h.kind == KIND_DELTA && !delta)) {
+        fail("out of memory");
+        return;
+    }
+    tinfl_init(stream.inflater);
+    if (delta) delta->reset(h.baseSize, h.imageSize);
+
+    if (!otaGuardStart(true, h.imageSize, h.imageSha256)) {
+        fail("another update is running");
+        return;
+    }
+    stream.started = true;
+    if (!Update.begin(h.imageSize, U_FLASH)) {
+        fail(Update.errorString());
+        return;
+    }
+    DEBUG_PRINTF("OTA stream: %s image, %lu bytes\n", h.kind == KIND_DELTA ? "delta" : "compressed",
+                 (unsigned long)h.imageSize);
+}
+
+/**
+ * @brief Hands inflated bytes to the partition writer or the delta decoder.
+ */
+static bool consume(const uint8_t* data, uint32_t length) {
+    if (!length) return true;
+    if (delta) {
+        if (!delta->feed(data, length)) {
+            fail(delta->error());
+            return false;
+        }
+        return true;
+    }
+    if (stream.written + length > stream.header.imageSize) {
+        fail("image longer than announced");
+        return false;
+    }
+    if (!writeImage(data, length, nullptr)) {
+        fail("flash write failed");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Inflates @p length input bytes; @p more is false for the final call.
+ */
+static void inflate(const uint8_t* in, size_t length, bool more) {
+    uint32_t flags = TINFL_FLAG_PARSE_ZLIB_HEADER | (more ? TINFL_FLAG_HAS_MORE_INPUT : 0);
+    while (!stream.error && !stream.inflateDone) {
+        size_t inBytes = length;
+        size_t outBytes = TINFL_LZ_DICT_SIZE - stream.windowPos;
+        tinfl_status status = tinfl_decompress(stream.inflater, in, &inBytes, stream.window,
+                                               stream.window + stream.windowPos, &outBytes, flags);
+        in += inBytes;
+        length -= inBytes;
+        if (!consume(stream.window + stream.windowPos, outBytes)) return;
+        stream.windowPos = (stream.windowPos + outBytes) & (TINFL_LZ_DICT_SIZE - 1);
+        if (status < TINFL_STATUS_DONE) {
+            fail("corrupt compressed stream");
+            return;
+        }
+        if (status == TINFL_STATUS_DONE) {
+            stream.inflateDone = true;
+        } else if (status == TINFL_STATUS_NEEDS_MORE_INPUT && length == 0) {
+            if (!more) fail("compressed stream truncated");
+            return;
+        }
+    }
+}
+
+static void feed(const uint8_t* data, size_t length) {
+    if (stream.error) return;
+    if (stream.headerBytes < sizeof(StreamHeader)) {
+        size_t n = sizeof(StreamHeader) - stream.headerBytes;
+        if (n > length) n = length;
+        memcpy((uint8_t*)&stream.header + stream.headerBytes, data, n);
+        stream.headerBytes += n;
+        data += n;
+        length -= n;
+        if (stream.headerBytes < sizeof(StreamHeader)) return;
+        beginImage();
+    }
+    if (length) inflate(data, length, true);
+}
+
+static void finish() {
+    if (stream.error) return;
+    if (!stream.started) {
+        fail("upload shorter than the header");
+        return;
+    }
+    inflate(nullptr, 0, false);
+    if (stream.error) return;
+    bool complete = delta ? delta->complete() : stream.written == stream.header.imageSize;
+    if (!stream.inflateDone || !complete) {
+        fail("image shorter than announced");
+        return;
+    }
+    releaseBuffers();
+    if (!Update.end(true)) {
+        stream.error = Update.errorString();
+        otaGuardEnd(false, stream.error);
+        return;
+    }
+    otaGuardEnd(true, nullptr);
+    if (getOtaStatus().state != OTA_READY) stream.error = "verification failed (see /api/ota)";
+}
+
+static void handleUpload() {
+    HTTPUpload& upload = streamServer->upload();
+    if (upload.status == UPLOAD_FILE_START) {
+        releaseBuffers();
+        stream = StreamState();
+    } else if (upload.status == UPLOAD_FILE_WRITE) {
+        feed(upload.buf, upload.currentSize);
+    } else if (upload.status == UPLOAD_FILE_END) {
+        finish();
+    } else {
+        fail("upload aborted");
+    }
+}
+
+static void handleUploadDone() {
+    streamServer->sendHeader("Connection", "close");
+    streamServer->sendHeader("Access-Control-Allow-Origin", "*");
+    if (stream.error) {
+        String message = String(stream.error) + "\n";
+        streamServer->send(400, "text/plain", message);
+    } else {
+        streamServer->send(200, "text/plain", "OK");
+    }
+}
+
+void otaStreamAttach(WebServer& server) {
+    streamServer = &server;
+    server.on("/ota/stream", HTTP_POST, handleUploadDone, handleUpload);
+}
@@ -0,0 +1,24 @@
+#ifndef OTA_STREAM_H
+#define OTA_STREAM_H
+
+#include <Arduino.h>
+#include <WebServer.h>
+
+// Compressed and delta firmware uploads for weak links: POST /ota/stream with
+// a multipart file built by tools/make_ota_image.py. The zlib stream is
+// inflated by the ROM's tinfl as the upload arrives, with a fixed 32 KB window
+// in PSRAM, and written into the OTA partition (or, for a delta, turned into
+// copies from the running image and inserts, ota_delta.h). The upload goes
+// through the same checkpoints, pacing, SHA-256 read-back and reboot as the
+// ElegantOTA page (ota_guard.h).
+//
+// Container, little-endian: an 80-byte header {"RDZ1", u8 kind (0 full image,
+// 1 delta), 3 reserved, u32 image size, u32 base size, SHA-256 of the image,
+// SHA-256 of the first base-size bytes of the running partition (delta only)},
+// then the zlib stream. A delta is refused unless the running image matches
+// its base.
+
+// Registers /ota/stream. Call after otaGuardAttach().
+void otaStreamAttach(WebServer& server);
+
+#endif // OTA_STREAM_H
@@ -0,0 +1,254 @@
+#ifndef PLATEAU_FIT_H
+#define PLATEAU_FIT_H
+
+#include <math.h>
+#include <stdint.h>
+
+// Geiger plateau scan: steps the tube voltage, waits for the HV loop to settle
+// at each step, integrates counts until the step's relative error is small
+// enough, then fits the plateau and picks the operating point.
+//  - A step ends after targetCounts counts (relative error 1/sqrt(N)) and at
+//    least minStepMs, or after maxStepMs below the threshold / at background.
+//  - The scan stops early at the onset of continuous discharge: a step whose
+//    rate jumps by dischargeFactor over a flat pair of preceding steps.
+//  - The plateau is the widest run of at least three steps, starting where the
+//    rate has reached the run's level, whose weighted line has a slope of at
+//    most maxSlopePctPer100V and on which every step lies within its counting
+//    error of that line. The operating point is a third of the way from
+//    the knee (its first step) to its end, away from the discharge region.
+// The caller feeds the running pulse total and the HV status once per UI pass
+// and applies target() to the HV loop. No Arduino dependencies (host-compilable).
+
+static const uint8_t PLATEAU_MAX_POINTS = 64;
+static const float PLATEAU_RESIDUAL_SIGMAS = 4.0f; ///< Plus 2 % of the plateau rate
+
+struct PlateauPoint {
+    float volts;     ///< Mean of the divider readings while counting
+    uint32_t counts;
+    float seconds;
+
+    float rate() const { return seconds > 0.0f ? counts / seconds : 0.0f; }
+};
+
+struct PlateauFit {
+    bool valid;
+    uint8_t first;       ///< Index of the knee
+    uint8_t last;        ///< Last point of the plateau
+    float kneeV;
+    float endV;
+    float operatingV;
+    float rateCps;       ///< Mean rate on the plateau
+    float slopePctPer100V;
+};
+
+/**
+ * @brief Finds the plateau of @p n points in ascending voltage order.
+ * @return the fit; valid is false if no run of three points is flat enough
+ */
+inline PlateauFit fitPlateau(const PlateauPoint* points, uint8_t n, float maxSlopePctPer100V) {
+    PlateauFit best = {};
+    for (uint8_t a = 0; a + 2 < n; a++) {
+        for (uint8_t b = a + 2; b < n; b++) {
+            // Weighted least squares r = c + s * v, weights 1 / variance = t^2 / N
+            double sw = 0, sv = 0, sr = 0, svv = 0, svr = 0;
+            uint32_t counts = 0;
+            float seconds = 0.0f;
+            for (uint8_t i = a; i <= b; i++) {
+                const PlateauPoint& p = points[i];
+                double w = p.counts ? (double)p.seconds * p.seconds / p.counts : (double)p.seconds * p.seconds;
+                double r = p.rate();
+                sw += w;
+                sv += w * p.volts;
+                sr += w * r;
+                svv += w * p.volts * p.volts;
+                svr += w * p.volts * r;
+                counts += p.counts;
+                seconds += p.seconds;
+            }
+            double det = sw * svv - sv * sv;
+            if (det <= 0.0 || seconds <= 0.0f || counts == 0) continue;
+            double slope = (sw * svr - sv * sr) / det;
+            float mean = counts / seconds;
+            // Below the knee the rate has not reached the plateau level yet
+            if (points[a].rate() < 0.8f * mean) continue;
+            float slopePct = (float)(slope / mean * 100.0 * 100.0);
+            if (fabsf(slopePct) > maxSlopePctPer100V) continue;
+            // Every step on the line within its counting error: no hidden kink
+            double intercept = (sr - slope * sv) / sw;
+            bool onLine = true;
+            for (uint8_t i = a; i <= b && onLine; i++) {
+                const PlateauPoint& p = points[i];
+                float sigma = p.seconds > 0.0f ? sqrtf((float)(p.counts ? p.counts : 1)) / p.seconds : 0.0f;
+                float residual = fabsf((float)(p.rate() - (intercept + slope * p.volts)));
+                onLine = residual <= PLATEAU_RESIDUAL_SIGMAS * sigma + 0.02f * mean;
+            }
+            if (!onLine) continue;
+            float width = points[b].volts - points[a].volts;
+            float bestWidth = best.valid ? best.endV - best.kneeV : -1.0f;
+            if (width < bestWidth || (width == bestWidth && fabsf(slopePct) >= fabsf(best.slopePctPer100V))) continue;
+            best.valid = true;
+            best.first = a;
+            best.last = b;
+            best.kneeV = points[a].volts;
+            best.endV = points[b].volts;
+            best.rateCps = mean;
+            best.slopePctPer100V = slopePct;
+        }
+    }
+    if (best.valid) best.operatingV = best.kneeV + (best.endV - best.kneeV) / 3.0f;
+    return best;
+}
+
+enum PlateauScanState {
+    PLATEAU_IDLE = 0,
+    PLATEAU_SETTLING,  ///< Waiting for the HV loop at the step's voltage
+    PLATEAU_COUNTING,
+    PLATEAU_DONE,      ///< Finished; fit() holds the result
+    PLATEAU_ABORTED
+};
+
+struct PlateauScanParams {
+    float startV;
+    float endV;
+    float stepV;
+    uint32_t settleMs;        ///< Regulated within toleranceV for this long
+    uint32_t settleTimeoutMs; ///< Aborts if the loop does not get there
+    float toleranceV;
+    uint32_t targetCounts;
+    uint32_t minStepMs;
+    uint32_t maxStepMs;
+    float dischargeFactor;
+    float maxSlopePctPer100V;
+};
+
+class PlateauScanner {
+public:
+    explicit PlateauScanner(const PlateauScanParams& params) : p_(params) { clear(); }
+
+    void start(uint32_t nowMs) {
+        clear();
+        steps_ = (uint8_t)(floorf((p_.endV - p_.startV) / p_.stepV + 0.5f) + 1);
+        if (steps_ > PLATEAU_MAX_POINTS) steps_ = PLATEAU_MAX_POINTS;
+        target_ = p_.startV;
+        enter(PLATEAU_SETTLING, nowMs);
+    }
+
+    void abort(const char* reason) {
+        if (!running()) return;
+        reason_ = reason;
+        state_ = PLATEAU_ABORTED;
+    }
+
+    /**
+     * @brief Advances the scan.
+     * @param totalCounts Running pulse total (wraps)
+     * @param measuredV   Divider reading
+     * @param regulating  HV loop at its target without a fault
+     * @return true when a point was added or the state changed
+     */
+    bool update(uint32_t nowMs, uint32_t totalCounts, float measuredV, bool regulating) {
+        if (state_ == PLATEAU_SETTLING) {
+            bool settled = regulating && fabsf(measuredV - target_) <= p_.toleranceV;
+            if (!settled) settledSinceMs_ = nowMs;
+            if (nowMs - settledSinceMs_ >= p_.settleMs) {
+                enter(PLATEAU_COUNTING, nowMs);
+                countsStart_ = totalCounts;
+                voltSum_ = 0.0f;
+                voltSamples_ = 0;
+                return true;
+            }
+            if (nowMs - stateSinceMs_ >= p_.settleTimeoutMs) {
+                abort("HV did not settle");
+                return true;
+            }
+            return false;
+        }
+        if (state_ != PLATEAU_COUNTING) return false;
+        if (!regulating) {
+            abort("HV lost regulation");
+            return true;
+        }
+        voltSum_ += measuredV;
+        voltSamples_++;
+        stepCounts_ = totalCounts - countsStart_;
+        stepMs_ = nowMs - stateSinceMs_;
+        if (!(stepCounts_ >= p_.targetCounts && stepMs_ >= p_.minStepMs) && stepMs_ < p_.maxStepMs) return false;
+
+        PlateauPoint& point = points_[count_++];
+        point.volts = voltSum_ / voltSamples_;
+        point.counts = stepCounts_;
+        point.seconds = stepMs_ * 0.001f;
+        if (dischargeOnset()) {
+            finish(count_ - 1); // The discharge step stays visible but is not fitted
+        } else if (count_ >= steps_) {
+            finish(count_);
+        } else {
+            target_ += p_.stepV;
+            enter(PLATEAU_SETTLING, nowMs);
+        }
+        return true;
+    }
+
+    bool running() const { return state_ == PLATEAU_SETTLING || state_ == PLATEAU_COUNTING; }
+    PlateauScanState state() const { return state_; }
+    float target() const { return target_; }
+    uint8_t steps() const { return steps_; }
+    uint8_t count() const { return count_; }
+    const PlateauPoint* points() const { return points_; }
+    uint32_t stepCounts() const { return state_ == PLATEAU_COUNTING ? stepCounts_ : 0; }
+    uint32_t stepMs() const { return state_ == PLATEAU_COUNTING ? stepMs_ : 0; }
+    const PlateauFit& fit() const { return fit_; }
+    const char* reason() const { return reason_; } ///< Why the scan was aborted, or ""
+
+private:
+    void clear() {
+        state_ = PLATEAU_IDLE;
+        steps_ = 0;
+        count_ = 0;
+        target_ = 0.0f;
+        stepCounts_ = 0;
+        stepMs_ = 0;
+        fit_ = PlateauFit();
+        reason_ = "";
+    }
+
+    void enter(PlateauScanState state, uint32_t nowMs) {
+        state_ = state;
+        stateSinceMs_ = settledSinceMs_ = nowMs;
+        stepCounts_ = 0;
+        stepMs_ = 0;
+    }
+
+    bool dischargeOnset() const {
+        if (count_ < 3) return false;
+        float r0 = points_[count_ - 3].rate();
+        float r1 = points_[count_ - 2].rate();
+        float r2 = points_[count_ - 1].rate();
+        bool flat = r1 > 0.0f && fabsf(r1 - r0) <= 0.1f * r1;
+        return flat && r2 > p_.dischargeFactor * r1;
+    }
+
+    void finish(uint8_t fitted) {
+        fit_ = fitPlateau(points_, fitted, p_.maxSlopePctPer100V);
+        state_ = PLATEAU_DONE;
+        if (!fit_.valid) reason_ = "no plateau found";
+    }
+
+    PlateauScanParams p_;
+    PlateauScanState state_;
+    uint8_t steps_;
+    uint8_t count_;
+    float target_;
+    uint32_t stateSinceMs_;
+    uint32_t settledSinceMs_;
+    uint32_t countsStart_;
+    uint32_t stepCounts_;
+    uint32_t stepMs_;
+    float voltSum_;
+    uint32_t voltSamples_;
+    PlateauPoint points_[PLATEAU_MAX_POINTS];
+    PlateauFit fit_;
+    const char* reason_;
+};
+
+#endif // PLATEAU_FIT_H
@@ -0,0 +1,246 @@
+/**
+ * @file plateau_scan.cpp
+ * @brief Plateau scan state machine on uiTask, its web endpoint and serial report.
+ *
+ * The scanner only moves the HV loop through its target override, so the
+ * regulation itself (hv_control.h) keeps its timing and fault handling. The
+ * published status is about 1 KB and is copied at most once per second while
+ * a step counts, and at every state change.
+ */
+
+#include "plateau_scan.h"
+#include "hv_control.h"
+#include "device_config.h"
+#include "seqlock.h"
+#include "debug.h"
+#include "json_body.h"
+#include "json_arena.h"
+#include "web_arena.h"
+#include <ArduinoJson.h>
+#include <atomic>
+
+static const uint32_t PUBLISH_INTERVAL_MS = 1000;
+static const uint32_t SETTLE_TIMEOUT_MS = 20000;
+static const float SETTLE_TOLERANCE_V = 3.0f;
+static const float DISCHARGE_FACTOR = 1.5f;
+
+static PlateauScanParams scanParams() {
+    PlateauScanParams p;
+    p.startV = PLATEAU_START_V;
+    p.endV = PLATEAU_END_V;
+    p.stepV = PLATEAU_STEP_V;
+    p.settleMs = PLATEAU_SETTLE_MS;
+    p.settleTimeoutMs = SETTLE_TIMEOUT_MS;
+    p.toleranceV = SETTLE_TOLERANCE_V;
+    p.targetCounts = PLATEAU_TARGET_COUNTS;
+    p.minStepMs = PLATEAU_MIN_STEP_MS;
+    p.maxStepMs = PLATEAU_MAX_STEP_MS;
+    p.dischargeFactor = DISCHARGE_FACTOR;
+    p.maxSlopePctPer100V = PLATEAU_MAX_SLOPE_PCT;
+    return p;
+}
+
+static PlateauScanner scanner(scanParams()); ///< uiTask only
+static SeqLock<PlateauScanStatus> statusLock;
+static std::atomic<uint32_t> publishedVersion(0);
+static std::atomic<bool> startRequested(false);
+static std::atomic<bool> stopRequested(false);
+static std::atomic<bool> running(false);
+static bool applied = false;
+static const char* refusal = nullptr;  ///< Start refused before the scanner ran
+static uint32_t lastPublishMs = 0;
+static WebServer* plateauServer = nullptr;
+
+static void publish(uint32_t nowMs) {
+    static PlateauScanStatus status; // About 1 KB, kept off the stack
+    status.state = refusal ? PLATEAU_ABORTED : scanner.state();
+    status.steps = scanner.steps();
+    status.count = scanner.count();
+    status.targetV = scanner.target();
+    status.stepCounts = scanner.stepCounts();
+    status.stepMs = scanner.stepMs();
+    status.applied = applied;
+    strlcpy(status.reason, refusal ? refusal : scanner.reason(), sizeof(status.reason));
+    status.fit = scanner.fit();
+    memcpy(status.points, scanner.points(), sizeof(PlateauPoint) * scanner.count());
+    status.version = publishedVersion.load() + 1;
+    statusLock.publish(status);
+    publishedVersion = status.version;
+    running = scanner.running();
+    lastPublishMs = nowMs;
+}
+
+/**
+ * @brief Leaves the scan: back to the configured target, which becomes the
+ *        operating point when the fit succeeded.
+ */
+static void finishScan() {
+    hvClearTargetOverride();
+    const PlateauFit& fit = scanner.fit();
+    if (scanner.state() == PLATEAU_DONE && fit.valid) {
+        DeviceConfig config = getDeviceConfig();
+        config.hvTargetV = roundf(fit.operatingV);
+        setDeviceConfig(config);
+        applied = true;
+        DEBUG_PRINTF("Plateau: %.0f ... %.0f V, %.1f %%/100 V, operating point %.0f V\n", fit.kneeV, fit.endV,
+                     fit.slopePctPer100V, config.hvTargetV);
+    } else {
+        DEBUG_PRINTF("Plateau: scan ended without a result (%s)\n", scanner.reason());
+    }
+}
+
+void plateauScanRequestStart() {
+    startRequested = true;
+}
+
+void plateauScanRequestStop() {
+    stopRequested = true;
+}
+
+void plateauScanLoop(uint32_t nowMs, uint32_t totalCounts) {
+    bool changed = false;
+    if (startRequested.exchange(false) && !scanner.running()) {
+        HvStatus hv = getHvStatus();
+        applied = false;
+        refusal = nullptr;
+        if (!hv.running) {
+            refusal = "no HV control";
+        } else if (!hv.enabled || hv.state == HV_STATE_FAULT) {
+            refusal = "HV off or faulted";
+        } else {
+            scanner.start(nowMs);
+            hvSetTargetOverride(scanner.target());
+            DEBUG_PRINTF("Plateau: scanning %.0f ... %.0f V in %u steps\n", PLATEAU_START_V, PLATEAU_END_V,
+                         (unsigned)scanner.steps());
+        }
+        changed = true;
+    }
+    if (stopRequested.exchange(false) && scanner.running()) {
+        scanner.abort("stopped");
+        finishScan();
+        changed = true;
+    }
+
+    if (scanner.running()) {
+        HvStatus hv = getHvStatus();
+        bool regulating = hv.enabled && hv.state == HV_STATE_REGULATING;
+        if (scanner.update(nowMs, totalCounts, hv.measuredV, regulating)) {
+            changed = true;
+            if (scanner.running()) {
+                hvSetTargetOverride(scanner.target());
+            } else {
+                finishScan();
+            }
+        }
+    }
+
+    if (changed || (scanner.running() && nowMs - lastPublishMs >= PUBLISH_INTERVAL_MS)) publish(nowMs);
+}
+
+bool plateauScanRunning() {
+    return running.load();
+}
+
+PlateauScanStatus getPlateauScanStatus() {
+    PlateauScanStatus status;
+    memset(&status, 0, sizeof(status));
+    statusLock.read(status);
+    return status;
+}
+
+uint32_t plateauScanVersion() {
+    return publishedVersion.load();
+}
+
+const char* plateauScanStateName(uint8_t state) {
+    static const char* NAMES[] = {"idle", "settling", "counting", "done", "aborted"};
+    return state <= PLATEAU_ABORTED ? NAMES[state] : "?";
+}
+
+void buildPlateauScanJson(JsonDocument& doc) {
+    PlateauScanStatus s = getPlateauScanStatus();
+    doc["state"] = plateauScanStateName(s.state);
+    doc["steps"] = s.steps;
+    doc["done"] = s.count;
+    doc["target_v"] = s.targetV;
+    doc["step_counts"] = s.stepCounts;
+    doc["step_s"] = s.stepMs / 1000.0f;
+    doc["reason"] = s.reason;
+    JsonArray points = doc["points"].to<JsonArray>();
+    for (uint8_t i = 0; i < s.count; i++) {
+        JsonObject p = points.add<JsonObject>();
+        p["v"] = s.points[i].volts;
+        p["counts"] = s.points[i].counts;
+        p["s"] = s.points[i].seconds;
+        p["cps"] = s.points[i].rate();
+    }
+    if (s.fit.valid) {
+        JsonObject fit = doc["fit"].to<JsonObject>();
+        fit["knee_v"] = s.fit.kneeV;
+        fit["end_v"] = s.fit.endV;
+        fit["operating_v"] = s.fit.operatingV;
+        fit["cps"] = s.fit.rateCps;
+        fit["slope_pct_per_100v"] = s.fit.slopePctPer100V;
+        fit["applied"] = s.applied;
+    }
+}
+
+String getPlateauScanJson() {
+    JsonArenaLease lease;
+    JsonDocument doc(lease.allocator());
+    buildPlateauScanJson(doc);
+    String json;
+    serializeJson(doc, json);
+    return json;
+}
+
+/**
+ * @brief POST /api/plateau with {"action":"start|stop"} or ?action=start|stop:
+ *        queues the request for uiTask.
+ */
+static void handlePlateauControl(WebServer& server, JsonVariantConst body) {
+    String action = body["action"] | server.arg("action");
+    if (action == "start") {
+        plateauScanRequestStart();
+    } else if (action == "stop") {
+        plateauScanRequestStop();
+    } else {
+        server.send(400, "text/plain", "action must be start or stop");
+        return;
+    }
+    server.send(202, "text/plain", "Queued");
+}
+
+void plateauScanAttach(WebServer& server) {
+    plateauServer = &server;
+    server.on("/api/plateau", HTTP_GET, []() {
+        plateauServer->sendHeader("Cache-Control", "no-store");
+        plateauServer->sendHeader("Access-Control-Allow-Origin", "*");
+        JsonArenaLease lease;
+        JsonDocument doc(lease.allocator());
+        buildPlateauScanJson(doc);
+        webSendJson(*plateauServer, 200, doc);
+    });
+    jsonBodyOn(server, "/api/plateau", JSON_BODY_ACTION_FILTER, handlePlateauControl);
+}
+
+void printPlateauScan(Print& out) {
+    PlateauScanStatus s = getPlateauScanStatus();
+    out.printf("Plateau scan: %s, step %u of %u", plateauScanStateName(s.state), (unsigned)s.count, (unsigned)s.steps);
+    if (s.state == PLATEAU_SETTLING || s.state == PLATEAU_COUNTING) {
+        out.printf(", %.0f V, %lu counts in %.1f s", s.targetV, (unsigned long)s.stepCounts, s.stepMs / 1000.0f);
+    }
+    if (s.reason[0]) out.printf(" (%s)", s.reason);
+    out.println();
+    for (uint8_t i = 0; i < s.count; i++) {
+        const PlateauPoint& p = s.points[i];
+        bool onPlateau = s.fit.valid && i >= s.fit.first && i <= s.fit.last;
+        out.printf("  %6.1f V %7lu counts %6.1f s %8.2f cps%s\n", p.volts, (unsigned long)p.counts, p.seconds, p.rate(),
+                   onPlateau ? " *" : "");
+    }
+    if (s.fit.valid) {
+        out.printf("  plateau %.0f ... %.0f V, %.1f %%/100 V, %.2f cps; operating point %.0f V%s\n", s.fit.kneeV,
+                   s.fit.endV, s.fit.slopePctPer100V, s.fit.rateCps, s.fit.operatingV,
+                   s.applied ? " (stored)" : "");
+    }
+}
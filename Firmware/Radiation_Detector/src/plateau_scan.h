@@ -0,0 +1,61 @@
+#ifndef PLATEAU_SCAN_H
+#define PLATEAU_SCAN_H
+
+#include <Arduino.h>
+#include <WebServer.h>
+#include <ArduinoJson.h>
+#include "config.h"
+#include "plateau_fit.h"
+
+// Automatic plateau scan behind AUTO on the voltage screen (plateau_fit.h).
+// The scan runs on uiTask: plateauScanLoop() feeds it the pulse total and the
+// HV status every pass and moves the HV loop with hvSetTargetOverride(). When
+// it finishes with a plateau the operating point becomes the configured HV
+// target; an abort or a failed fit returns to the previous target.
+//
+// Start and stop requests are accepted from any task and take effect on the
+// next UI pass. Progress is published for the web task:
+//   GET  /api/plateau               state, steps, the current step, points, fit
+//   POST /api/plateau?action=start|stop
+// and as "plateau" events on /events (live_events.h).
+
+struct PlateauScanStatus {
+    uint8_t state;         ///< PlateauScanState
+    uint8_t steps;         ///< Planned steps
+    uint8_t count;         ///< Finished steps
+    float targetV;         ///< Voltage of the current step
+    uint32_t stepCounts;   ///< Counts of the current step so far
+    uint32_t stepMs;
+    bool applied;          ///< The operating point was stored as the HV target
+    char reason[24];       ///< Why the scan was aborted, or ""
+    uint32_t version;      ///< Changes with every published update
+    PlateauFit fit;
+    PlateauPoint points[PLATEAU_MAX_POINTS];
+};
+
+// Any task. A start without a running HV loop is refused on the next pass.
+void plateauScanRequestStart();
+void plateauScanRequestStop();
+
+// Advances the scan. Call from uiTask once per pass.
+void plateauScanLoop(uint32_t nowMs, uint32_t totalCounts);
+
+bool plateauScanRunning();
+
+// Consistent copy of the last published state. Any task, lock-free.
+PlateauScanStatus getPlateauScanStatus();
+
+// Cheap change check for pollers (the event stream).
+uint32_t plateauScanVersion();
+
+const char* plateauScanStateName(uint8_t state);
+
+void buildPlateauScanJson(JsonDocument& doc);
+String getPlateauScanJson();
+
+// Registers /api/plateau. Call while the other routes are set up.
+void plateauScanAttach(WebServer& server);
+
+void printPlateauScan(Print& out);
+
+#endif // PLATEAU_SCAN_H
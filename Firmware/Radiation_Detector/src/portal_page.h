@@ -0,0 +1,81 @@
+#ifndef PORTAL_PAGE_H
+#define PORTAL_PAGE_H
+
+// Generated by tools/embed_dashboard.py from src/web/portal.html - do not edit.
+// 2132 bytes of HTML, 1075 bytes gzip-compressed.
+
+#include <Arduino.h>
+
+static const size_t PORTAL_PAGE_GZ_LEN = 1075;
+static const uint8_t PORTAL_PAGE_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x7d, 0x56, 0x5d, 0x8e, 0xdb, 0x36,
+    0x10, 0x7e, 0xf7, 0x29, 0x26, 0x28, 0x0a, 0xda, 0xa8, 0x2d, 0xcb, 0xde, 0x74, 0x1b, 0xd8, 0xb2,
+    0x0b, 0xc4, 0xbb, 0x69, 0x03, 0xa4, 0x6d, 0xd0, 0x75, 0x5a, 0xf4, 0x91, 0x16, 0x47, 0x36, 0xb3,
+    0x14, 0xa9, 0x90, 0x94, 0xd7, 0x4e, 0xb0, 0x67, 0x28, 0x50, 0xf4, 0xa1, 0x6f, 0x05, 0x7a, 0x8a,
+    0x9e, 0xa7, 0x17, 0x68, 0x8f, 0xd0, 0xa1, 0x24, 0xdb, 0xca, 0xc6, 0xc9, 0xcb, 0x4a, 0xa4, 0x66,
+    0xbe, 0xf9, 0xe6, 0x9b, 0x1f, 0x6f, 0xf2, 0xe8, 0xea, 0x87, 0xc5, 0xf2, 0x97, 0x97, 0xd7, 0xb0,
+    0xf1, 0xb9, 0x9a, 0x27, 0xe1, 0x2f, 0x28, 0xae, 0xd7, 0x33, 0x86, 0x9a, 0xd1, 0x19, 0xb9, 0x98,
+    0x77, 0x92, 0x1c, 0x3d, 0x87, 0x74, 0xc3, 0xad, 0x43, 0x3f, 0x63, 0xaf, 0x96, 0xcf, 0x06, 0x4f,
+    0xd8, 0xe1, 0x5a, 0xf3, 0x1c, 0x67, 0x6c, 0x2b, 0xf1, 0xae, 0x30, 0xd6, 0x33, 0x48, 0x8d, 0xf6,
+    0xa8, 0xc9, 0xec, 0x4e, 0x0a, 0xbf, 0x99, 0x09, 0xdc, 0xca, 0x14, 0x07, 0xd5, 0xa1, 0x0f, 0x52,
+    0x4b, 0x2f, 0xb9, 0x1a, 0xb8, 0x94, 0x2b, 0x9c, 0x8d, 0xa2, 0x38, 0xc0, 0x78, 0xe9, 0x15, 0xce,
+    0x7f, 0xe4, 0x42, 0x72, 0x2f, 0x8d, 0x86, 0x2b, 0xf4, 0x98, 0x7a, 0x63, 0xe1, 0x67, 0xf9, 0x4c,
+    0xc2, 0x0d, 0xfa, 0xb2, 0x48, 0x86, 0xb5, 0x51, 0x27, 0x71, 0x7e, 0x1f, 0x9e, 0x2b, 0x23, 0xf6,
+    0xf0, 0x0e, 0x32, 0x0a, 0x36, 0xc8, 0x78, 0x2e, 0xd5, 0x7e, 0x02, 0xec, 0x06, 0xd7, 0x06, 0xe1,
+    0xd5, 0x73, 0xd6, 0x87, 0x25, 0xdf, 0x98, 0x9c, 0xf7, 0xe1, 0x1b, 0xd4, 0xb8, 0xa5, 0xe7, 0x4f,
+    0x68, 0x05, 0xd7, 0xf4, 0xe2, 0xb8, 0x76, 0x03, 0x87, 0x56, 0x66, 0x53, 0x58, 0xf1, 0xf4, 0x76,
+    0x6d, 0x4d, 0xa9, 0xc5, 0x20, 0x35, 0xca, 0xd8, 0x09, 0x7c, 0x16, 0x67, 0xa3, 0x8b, 0xd1, 0x57,
+    0x53, 0xc8, 0xb9, 0x5d, 0x4b, 0x3d, 0x81, 0x78, 0x0a, 0x87, 0x4f, 0x59, 0x46, 0x2e, 0xf7, 0x9d,
+    0x20, 0x09, 0x5a, 0x8a, 0x7d, 0xc6, 0x7b, 0x7c, 0x39, 0xe6, 0x17, 0x97, 0x27, 0x97, 0xab, 0x27,
+    0x8b, 0xd1, 0x78, 0x31, 0x85, 0x82, 0x0b, 0x21, 0xf5, 0x7a, 0x02, 0xa3, 0xcb, 0x62, 0x07, 0xa3,
+    0xb8, 0xd8, 0x4d, 0xc1, 0xe3, 0xce, 0x0f, 0xb8, 0x92, 0x6b, 0x8a, 0x92, 0x92, 0x60, 0x68, 0x2b,
+    0xf4, 0x11, 0x21, 0xb7, 0x82, 0x57, 0x09, 0x3a, 0xf9, 0x16, 0xc9, 0x37, 0x7a, 0x8c, 0x79, 0xb0,
+    0xc9, 0xb9, 0xd4, 0x95, 0xd5, 0xae, 0x96, 0x75, 0x02, 0x8f, 0xc7, 0x15, 0xe4, 0xd1, 0x0f, 0x78,
+    0xe9, 0xcd, 0x83, 0xb0, 0xc1, 0xb3, 0x54, 0xe4, 0xa7, 0xa4, 0x23, 0xc8, 0x20, 0xe3, 0x04, 0xb4,
+    0xd1, 0xd8, 0xb2, 0x8b, 0xdb, 0x18, 0x71, 0xcd, 0x36, 0x0e, 0x8e, 0x4a, 0x7e, 0x3a, 0xe1, 0x95,
+    0xb1, 0x24, 0xca, 0xc0, 0x52, 0x0d, 0x4b, 0x37, 0x81, 0x2f, 0x43, 0xb8, 0x53, 0xf4, 0xf1, 0x89,
+    0xdc, 0x60, 0x65, 0xbc, 0x37, 0xf9, 0x04, 0x2a, 0x46, 0x69, 0x69, 0x5d, 0xc0, 0x29, 0x8c, 0xac,
+    0x05, 0x10, 0xd2, 0x15, 0x8a, 0x53, 0x2d, 0x33, 0x85, 0xf4, 0xfd, 0x75, 0xe9, 0xbc, 0xcc, 0xf6,
+    0x83, 0xa6, 0xa7, 0x26, 0xe0, 0x0a, 0x4e, 0xcd, 0xb4, 0x42, 0x7f, 0x87, 0xa8, 0x1b, 0x62, 0x74,
+    0x17, 0xe4, 0x78, 0xa8, 0xf9, 0x7d, 0x47, 0xea, 0xa2, 0xf4, 0x7d, 0x58, 0x95, 0x14, 0x31, 0x58,
+    0xac, 0xcc, 0x2e, 0x48, 0x59, 0x71, 0x6a, 0x08, 0xd3, 0xd5, 0x14, 0x1a, 0x11, 0x47, 0x71, 0xfc,
+    0xf9, 0x07, 0xac, 0xdb, 0xfa, 0x07, 0xf5, 0xcf, 0x25, 0x5a, 0xdf, 0xb5, 0xd4, 0x3b, 0x26, 0x59,
+    0x57, 0xfa, 0xbe, 0x73, 0xa4, 0xf0, 0xb0, 0xcd, 0xce, 0x48, 0x7a, 0xe2, 0x5f, 0x9c, 0xc9, 0xea,
+    0x7c, 0xd7, 0x24, 0xc3, 0x66, 0x2c, 0x92, 0x61, 0x35, 0xb1, 0x49, 0x18, 0x0f, 0x3a, 0xd5, 0xbd,
+    0x4a, 0x63, 0x3c, 0x9a, 0x9f, 0x66, 0x09, 0xfe, 0xf9, 0xe3, 0xaf, 0x7f, 0xff, 0xfe, 0x95, 0x4c,
+    0x47, 0xf3, 0xda, 0x9e, 0x4c, 0x68, 0x98, 0xa9, 0xab, 0xe8, 0x41, 0x2d, 0x22, 0xc5, 0x8c, 0x69,
+    0x92, 0xd8, 0xd8, 0x5b, 0x47, 0x3b, 0x40, 0xc9, 0xf9, 0x4d, 0xca, 0xb5, 0x26, 0x55, 0xa2, 0x28,
+    0x4a, 0x86, 0x74, 0x4e, 0x86, 0xa5, 0x22, 0xdb, 0xcc, 0xd8, 0x1c, 0x68, 0x09, 0x6c, 0x0c, 0x79,
+    0x14, 0xc6, 0xd1, 0xf4, 0xf3, 0x34, 0x8c, 0xf0, 0x8c, 0x0d, 0x1d, 0xdf, 0x62, 0x18, 0xee, 0xaa,
+    0x08, 0x15, 0xa4, 0x73, 0x52, 0xb0, 0x66, 0x5d, 0xd4, 0xef, 0x54, 0xea, 0x14, 0x37, 0x46, 0x11,
+    0x81, 0x19, 0xfb, 0xbe, 0x8e, 0xc8, 0x42, 0x5f, 0x2b, 0xd4, 0x6b, 0xda, 0x1d, 0xec, 0x62, 0xcc,
+    0xc0, 0xe2, 0x9b, 0x52, 0x5a, 0x14, 0x47, 0xac, 0x1a, 0xa1, 0xe0, 0xce, 0x91, 0x3d, 0xa1, 0xf8,
+    0x7d, 0xf1, 0xde, 0xf9, 0x3d, 0xd4, 0x97, 0xc7, 0xeb, 0x16, 0xec, 0xe5, 0x45, 0x60, 0xd6, 0x14,
+    0xa5, 0x76, 0x77, 0xe5, 0x2a, 0x97, 0x9e, 0xcd, 0x6f, 0x88, 0x36, 0x70, 0x2d, 0xc2, 0x1a, 0xd3,
+    0xb4, 0x85, 0x92, 0x61, 0x6d, 0x16, 0xa4, 0x0d, 0xe9, 0xd2, 0xb3, 0xa8, 0x05, 0x32, 0x9e, 0xf2,
+    0x4b, 0x86, 0x45, 0xf8, 0xd2, 0x68, 0xe7, 0x52, 0x2b, 0x0b, 0x3f, 0xef, 0x0c, 0x87, 0xb0, 0xdc,
+    0x20, 0xd4, 0xab, 0x0f, 0x68, 0xd7, 0x69, 0x47, 0x9b, 0x0f, 0x3c, 0xdd, 0x9d, 0x0a, 0x3e, 0xad,
+    0xce, 0x61, 0x18, 0x41, 0x3a, 0x9a, 0x00, 0xa5, 0x50, 0x40, 0xa9, 0xbd, 0xa4, 0x02, 0x78, 0xd8,
+    0x70, 0x47, 0x99, 0xbb, 0x52, 0x79, 0xd7, 0xc9, 0x4a, 0x5d, 0xa9, 0x0a, 0xca, 0x70, 0xd1, 0xed,
+    0xc1, 0xbb, 0x0e, 0x40, 0x86, 0x3e, 0xdd, 0x74, 0x49, 0x66, 0x02, 0x67, 0xbd, 0x88, 0xa0, 0x74,
+    0xd7, 0xc2, 0x6c, 0x0e, 0x36, 0x7a, 0xed, 0x8c, 0xee, 0xf6, 0x9a, 0x3b, 0x11, 0xee, 0x82, 0x03,
+    0x84, 0x8c, 0x28, 0x16, 0xd5, 0x77, 0x06, 0xc2, 0xa4, 0x65, 0x4e, 0xdd, 0x13, 0xad, 0xd1, 0x5f,
+    0x2b, 0x0c, 0xaf, 0x4f, 0xf7, 0xcf, 0x45, 0xf7, 0x54, 0xf6, 0xde, 0xb4, 0xf2, 0x91, 0x19, 0x74,
+    0x1f, 0x89, 0xe8, 0x70, 0x1d, 0xd5, 0x0a, 0x12, 0x05, 0xa0, 0x5f, 0x82, 0xa5, 0xcc, 0xd1, 0x94,
+    0xbe, 0x1b, 0x68, 0xf5, 0x61, 0x1c, 0xc7, 0x71, 0x6f, 0x4a, 0xa4, 0x7d, 0x69, 0xab, 0xd1, 0x0c,
+    0xfe, 0xa5, 0x8a, 0x24, 0xe9, 0x68, 0xbf, 0x5d, 0x7e, 0xf7, 0x82, 0xe2, 0x32, 0x56, 0xc3, 0xb6,
+    0x10, 0x49, 0xd4, 0x6b, 0x4e, 0xa9, 0xe8, 0x13, 0xd1, 0x03, 0x55, 0x9a, 0xed, 0x16, 0xd5, 0xd4,
+    0x22, 0xf7, 0xd8, 0xb0, 0xed, 0x32, 0x25, 0x0f, 0x1c, 0x81, 0x0c, 0xa3, 0x30, 0x17, 0x8b, 0x7a,
+    0x4b, 0x90, 0x93, 0x8e, 0x42, 0x83, 0xc1, 0x17, 0xd0, 0xa5, 0x37, 0xa4, 0x2d, 0x83, 0xf0, 0x35,
+    0x30, 0xf8, 0xef, 0xcf, 0xdf, 0x7f, 0x63, 0x40, 0x3f, 0x14, 0x27, 0xd7, 0x3a, 0x92, 0xfb, 0x44,
+    0xa0, 0xb0, 0x5e, 0x4e, 0xf6, 0xee, 0x83, 0x48, 0x96, 0x42, 0x51, 0x24, 0x06, 0xe2, 0x69, 0xce,
+    0x5a, 0x8c, 0x78, 0x51, 0xa0, 0x16, 0x8b, 0x8d, 0x54, 0xa2, 0xeb, 0xda, 0x54, 0x8d, 0x4e, 0x95,
+    0x4c, 0x6f, 0xc9, 0x99, 0x6a, 0x19, 0x92, 0xfe, 0x78, 0x39, 0xaa, 0x31, 0xe9, 0x45, 0x5b, 0xae,
+    0x4a, 0x3c, 0xa6, 0x45, 0xda, 0x1e, 0xd0, 0x48, 0xde, 0x76, 0x18, 0x25, 0x9b, 0x38, 0xf7, 0xad,
+    0xf2, 0x89, 0xc8, 0x35, 0xd3, 0xdb, 0xfb, 0x58, 0xd1, 0x3a, 0xc1, 0x23, 0x4a, 0x79, 0x68, 0xa9,
+    0x9a, 0xd3, 0x79, 0x43, 0xb2, 0xa4, 0x8d, 0x5b, 0x35, 0xe1, 0x34, 0xec, 0x9c, 0xa6, 0xdd, 0x69,
+    0x46, 0xc2, 0xba, 0xa1, 0x5d, 0x12, 0xfe, 0x87, 0xe8, 0xfc, 0x0f, 0x37, 0x7c, 0xd1, 0xb2, 0x54,
+    0x08, 0x00, 0x00,
+};
+
+#endif // PORTAL_PAGE_H
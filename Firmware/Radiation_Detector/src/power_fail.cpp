@@ -0,0 +1,283 @@
+/**
+ * @file power_fail.cpp
+ * @brief Emergency flush of the dose and the unsynced log records into pre-erased flash.
+ *
+ * Area layout (raw partition POWER_FAIL_PARTITION, all little-endian):
+ *   offset 0      header sector: magic, format, block count, uptime, the
+ *                 DoseCheckpoint, CRC-32
+ *   offset 512*k  log block k-1, as in the history log (its own CRC-32)
+ *
+ * The blocks are programmed first and the header last, so an image cut short
+ * by the supply has no valid header and is ignored. Nothing is erased while
+ * the supply fails: the area is erased when it is armed, and only if it is not
+ * blank already, so a boot without a power failure costs no erase.
+ */
+
+#include "power_fail.h"
+#include "history_log.h"
+#include "debug.h"
+#include "driver/gpio.h"
+#include "esp_partition.h"
+#include "esp_heap_caps.h"
+#include "esp_rom_crc.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+static const uint32_t POWER_FAIL_MAGIC  = 0x46504452; ///< "RDPF"
+static const uint16_t POWER_FAIL_FORMAT = 1;
+static const size_t   AREA_SECTOR       = 512;
+static const uint32_t SUPPLY_POLL_MS    = 100;
+
+struct PowerFailHeader {
+    uint32_t magic;
+    uint16_t format;
+    uint16_t blockCount;
+    uint32_t uptimeMs;        ///< When the supply failed
+    DoseCheckpoint dose;      ///< magic 0: no checkpoint
+    uint32_t crc;             ///< CRC-32 of the fields above
+};
+
+static_assert(sizeof(PowerFailHeader) <= AREA_SECTOR, "power-fail header must fit one sector");
+
+static const esp_partition_t* area = nullptr;
+static uint32_t areaBlocks = 0;            ///< Log blocks after the header sector
+static TaskHandle_t flushTask = nullptr;
+static volatile bool armed = false;
+static volatile int64_t edgeUs = 0;
+
+// The flush task's buffers, in internal RAM
+static PowerFailHeader flushHeader;
+static uint8_t flushBlock[AREA_SECTOR];
+
+static PowerFailHeader rescuedHeader;
+static uint8_t* rescuedBlocks = nullptr;    ///< Image blocks read at boot (PSRAM)
+static bool rescued = false;
+
+static PowerFailStats stats;
+
+static uint32_t headerCrc(const PowerFailHeader& header) {
+    return esp_rom_crc32_le(0, (const uint8_t*)&header, offsetof(PowerFailHeader, crc));
+}
+
+static bool supplyFailing() {
+    return gpio_get_level((gpio_num_t)POWER_FAIL_PIN) == (POWER_FAIL_ACTIVE_LOW ? 0 : 1);
+}
+
+static bool findArea() {
+    if (area) return true;
+    const esp_partition_t* partition =
+        esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, POWER_FAIL_PARTITION);
+    if (!partition) return false; // Not in this unit's partition table
+    if (partition->size < 2 * AREA_SECTOR) {
+        DEBUG_PRINTLN("Power fail: partition " POWER_FAIL_PARTITION " is too small");
+        return false;
+    }
+    area = partition;
+    areaBlocks = partition->size / AREA_SECTOR - 1;
+    return true;
+}
+
+/**
+ * @brief Erases the area unless it is blank, then enables the flush. Flush task or setup().
+ */
+static bool arm() {
+    bool blank = true;
+    for (uint32_t offset = 0; offset < area->size && blank; offset += AREA_SECTOR) {
+        if (esp_partition_read(area, offset, flushBlock, AREA_SECTOR) != ESP_OK) return false;
+        for (size_t i = 0; i < AREA_SECTOR && blank; i++) blank = flushBlock[i] == 0xFF;
+    }
+    if (!blank && esp_partition_erase_range(area, 0, area->size) != ESP_OK) {
+        DEBUG_PRINTLN("Power fail: cannot erase the area");
+        return false;
+    }
+    armed = true;
+    stats.armed = true;
+    return true;
+}
+
+/**
+ * @brief Writes the image: the log blocks, then the header with the checkpoint.
+ */
+static bool flush() {
+    // The checkpoint first, while everything is still running
+    memset(&flushHeader, 0, sizeof(flushHeader));
+    doseCheckpointRescue(&flushHeader.dose);
+
+    uint32_t cursor = UINT32_MAX;
+    uint16_t blocks = 0;
+    bool written = true;
+    while (blocks < areaBlocks && historyLogRescueBlock(&cursor, flushBlock)) {
+        written = esp_partition_write(area, (blocks + 1) * AREA_SECTOR, flushBlock, AREA_SECTOR) == ESP_OK;
+        if (!written) break;
+        blocks++;
+    }
+
+    flushHeader.magic = POWER_FAIL_MAGIC;
+    flushHeader.format = POWER_FAIL_FORMAT;
+    flushHeader.blockCount = blocks;
+    flushHeader.uptimeMs = (uint32_t)(edgeUs / 1000);
+    flushHeader.crc = headerCrc(flushHeader);
+    written = esp_partition_write(area, 0, &flushHeader, sizeof(flushHeader)) == ESP_OK && written;
+    stats.lastFlushUs = (uint32_t)(esp_timer_get_time() - edgeUs);
+    stats.lastBlocks = blocks;
+    return written;
+}
+
+/**
+ * @brief Supply-sense edge. In IRAM, registered with the IRAM ISR service, so
+ *        it also runs while a flash write has the cache off.
+ */
+static void IRAM_ATTR powerFailIsr(void* arg) {
+    if (!armed) return; // The edge bounces while the supply collapses
+    armed = false;
+    edgeUs = esp_timer_get_time();
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(flushTask, &woken);
+    if (woken) portYIELD_FROM_ISR();
+}
+
+/**
+ * @brief Flush task: writes the image on a failure, and re-arms if the supply
+ *        comes back for POWER_FAIL_REARM_MS without a reset.
+ */
+static void powerFailTask(void* parameter) {
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        stats.armed = false;
+        bool written = flush();
+        stats.flushes++;
+        if (!written) stats.failures++;
+
+        uint32_t goodMs = 0;
+        while (goodMs < POWER_FAIL_REARM_MS) {
+            vTaskDelay(pdMS_TO_TICKS(SUPPLY_POLL_MS));
+            goodMs = supplyFailing() ? 0 : goodMs + SUPPLY_POLL_MS;
+        }
+        DEBUG_PRINTF("Power fail: supply back after a flush (%lu us, %u block(s)), re-arming\n",
+                     (unsigned long)stats.lastFlushUs, (unsigned)stats.lastBlocks);
+        arm();
+    }
+}
+
+bool powerFailLoad() {
+    if (POWER_FAIL_PIN < 0 || rescued || !findArea()) return false;
+    PowerFailHeader header;
+    if (esp_partition_read(area, 0, &header, sizeof(header)) != ESP_OK || header.magic != POWER_FAIL_MAGIC) {
+        return false; // Blank: no failure since the area was armed
+    }
+    if (header.format != POWER_FAIL_FORMAT || header.crc != headerCrc(header) || header.blockCount > areaBlocks) {
+        DEBUG_PRINTLN("Power fail: damaged image ignored");
+        return false;
+    }
+    if (header.blockCount > 0) {
+        size_t size = header.blockCount * AREA_SECTOR;
+        rescuedBlocks = (uint8_t*)heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        if (!rescuedBlocks) rescuedBlocks = (uint8_t*)heap_caps_malloc(size, MALLOC_CAP_8BIT);
+        if (!rescuedBlocks || esp_partition_read(area, AREA_SECTOR, rescuedBlocks, size) != ESP_OK) {
+            header.blockCount = 0; // The checkpoint alone
+        }
+    }
+    rescuedHeader = header;
+    rescued = true;
+    stats.rescuedDose = header.dose.magic != 0;
+    stats.rescuedBlocks = header.blockCount;
+    DEBUG_PRINTF("Power fail: image from %lu ms uptime, checkpoint %s, %u log block(s)\n",
+                 (unsigned long)header.uptimeMs, stats.rescuedDose ? "yes" : "no", (unsigned)header.blockCount);
+    return true;
+}
+
+bool powerFailRescuedDose(DoseCheckpoint* out) {
+    if (!rescued || !stats.rescuedDose) return false;
+    *out = rescuedHeader.dose;
+    return true;
+}
+
+uint32_t powerFailRescuedLog(const uint8_t** blocks) {
+    if (!rescued || !rescuedBlocks) return 0;
+    *blocks = rescuedBlocks;
+    return rescuedHeader.blockCount;
+}
+
+bool initPowerFail() {
+#if POWER_FAIL_PIN >= 0
+    if (flushTask) return true;
+    if (!findArea()) {
+        DEBUG_PRINTLN("Power fail: no " POWER_FAIL_PARTITION " partition, flush disabled");
+        return false;
+    }
+    // What was rescued is stored again by now; the area is reused
+    if (rescuedBlocks) {
+        heap_caps_free(rescuedBlocks);
+        rescuedBlocks = nullptr;
+    }
+    if (!arm()) return false;
+
+    // Above every other task, on the logger's core so the log stands still while it is read
+    if (xTaskCreatePinnedToCore(powerFailTask, "PowerFail", 4096, NULL, configMAX_PRIORITIES - 1, &flushTask,
+                                TASK_CORE_NETWORK) != pdPASS) {
+        return false;
+    }
+
+    pinMode(POWER_FAIL_PIN, POWER_FAIL_ACTIVE_LOW ? INPUT_PULLUP : INPUT); // Supervisors drive open drain
+    gpio_set_intr_type((gpio_num_t)POWER_FAIL_PIN, POWER_FAIL_ACTIVE_LOW ? GPIO_INTR_NEGEDGE : GPIO_INTR_POSEDGE);
+    esp_err_t err = gpio_install_isr_service(ESP_INTR_FLAG_IRAM); // Pulse capture may have installed it
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+        DEBUG_PRINTF("Power fail: ISR service install failed (%d)\n", err);
+        return false;
+    }
+    err = gpio_isr_handler_add((gpio_num_t)POWER_FAIL_PIN, powerFailIsr, nullptr);
+    if (err != ESP_OK) {
+        DEBUG_PRINTF("Power fail: handler add failed (%d)\n", err);
+        return false;
+    }
+    gpio_intr_enable((gpio_num_t)POWER_FAIL_PIN);
+    DEBUG_PRINTF("Power fail: armed on GPIO %d, %lu log blocks of room\n", POWER_FAIL_PIN,
+                 (unsigned long)areaBlocks);
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool powerFailTest(Print& out) {
+    if (!flushTask || !armed) {
+        out.println("Power fail: not armed");
+        return false;
+    }
+    uint32_t flushes = stats.flushes;
+    uint32_t failures = stats.failures;
+    armed = false;
+    edgeUs = esp_timer_get_time();
+    xTaskNotifyGive(flushTask);
+    for (int i = 0; i < 100 && stats.flushes == flushes; i++) vTaskDelay(pdMS_TO_TICKS(10));
+    if (stats.flushes == flushes) {
+        out.println("Power fail: flush did not finish within 1 s");
+        return false;
+    }
+    out.printf("Power fail: flush %s in %lu us, %u log block(s); re-armed in %u s\n",
+               stats.failures != failures ? "with errors" : "written", (unsigned long)stats.lastFlushUs,
+               (unsigned)stats.lastBlocks, (unsigned)(POWER_FAIL_REARM_MS / 1000));
+    return true;
+}
+
+PowerFailStats getPowerFailStats() {
+    return stats;
+}
+
+void printPowerFail(Print& out) {
+    if (POWER_FAIL_PIN < 0) {
+        out.println("Power fail: off (no POWER_FAIL_PIN)");
+        return;
+    }
+    out.printf("Power fail: %s on GPIO %d, partition %s (%lu log blocks)\n",
+               stats.armed ? "ARMED" : flushTask ? "FLUSHED" : "OFF", POWER_FAIL_PIN,
+               area ? POWER_FAIL_PARTITION : "missing", (unsigned long)areaBlocks);
+    out.printf("  image at boot: %s, %u log block(s)\n", stats.rescuedDose ? "checkpoint" : "no checkpoint",
+               (unsigned)stats.rescuedBlocks);
+    out.printf("  %lu flushes, %lu failed", (unsigned long)stats.flushes, (unsigned long)stats.failures);
+    if (stats.flushes) {
+        out.printf(", last %lu us for %u block(s)", (unsigned long)stats.lastFlushUs, (unsigned)stats.lastBlocks);
+    }
+    out.println();
+}
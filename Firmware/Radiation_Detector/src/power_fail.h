@@ -0,0 +1,60 @@
+#ifndef POWER_FAIL_H
+#define POWER_FAIL_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "dose_checkpoint.h"
+
+// Emergency flush on a failing supply. Between checkpoints the dose lives in
+// RAM (dose_checkpoint.h, every DOSE_CHECKPOINT_INTERVAL_S) and so do the
+// history log records not yet written (history_log.h, up to a block plus
+// HISTORY_LOG_SYNC_S); a mains unit that loses power loses both. With a
+// supply-sense line on POWER_FAIL_PIN they are saved within the hold-up time:
+//   - the area, the raw data partition POWER_FAIL_PARTITION, is erased while
+//     the supply is good, so the flush only programs flash (about 1 ms per
+//     512 bytes, against 45 ms per 4 KB erase);
+//   - the edge interrupt is IRAM-resident and registered with
+//     ESP_INTR_FLAG_IRAM, so it runs even while the flash cache is off; it
+//     wakes a task at the highest priority on the logger's core, which
+//     collects a checkpoint without taking the NVS path and encodes the
+//     unsynced records into log blocks, a steady 1 s log in two or three;
+//   - the blocks are written first and the header sector, with the
+//     checkpoint, last: an image cut short has no header and is ignored.
+// On the next boot the image is read (powerFailLoad(), before the dose and the
+// log start): the checkpoint competes with the NVS records by sequence and the
+// records continue the log. Once both are stored again, initPowerFail() erases
+// the area and arms the interrupt. A supply that recovers without a reset
+// re-arms after POWER_FAIL_REARM_MS.
+
+struct PowerFailStats {
+    bool armed;               ///< Area erased, interrupt enabled
+    bool rescuedDose;         ///< The image read at boot held a checkpoint
+    uint16_t rescuedBlocks;   ///< Log blocks of the image read at boot
+    uint32_t flushes;         ///< Flushes since boot (power failures and tests)
+    uint32_t failures;
+    uint32_t lastFlushUs;     ///< Edge to header written, of the last flush
+    uint16_t lastBlocks;      ///< Log blocks written by the last flush
+};
+
+// Reads the image of the last power failure, if any. Call in setup() before
+// doseCheckpointLoad() and initHistoryLog(), which take its parts.
+bool powerFailLoad();
+
+// The checkpoint of the loaded image; false if there is none.
+bool powerFailRescuedDose(DoseCheckpoint* out);
+
+// The log blocks of the loaded image (512 bytes each, history_log.h format),
+// oldest first; 0 if there are none.
+uint32_t powerFailRescuedLog(const uint8_t** blocks);
+
+// Erases the area and arms the interrupt; after the dose and the log have
+// stored what was rescued. False if POWER_FAIL_PIN or the partition is missing.
+bool initPowerFail();
+
+// Runs the flush as on a power failure and re-arms ("powerfail test").
+bool powerFailTest(Print& out);
+
+PowerFailStats getPowerFailStats();
+void printPowerFail(Print& out);
+
+#endif // POWER_FAIL_H
@@ -0,0 +1,233 @@
+/**
+ * @file power_profile.cpp
+ * @brief esp_pm frequency scaling, the PCNT clock lock and the power benchmark.
+ *
+ * Every clock change goes through applyClock() under one mutex: the serial
+ * commands and the screen-off hint run on uiTask, the benchmark on its own task.
+ * With power management compiled into the SDK, Arduino's setCpuFrequencyMhz()
+ * would be overridden by esp_pm, so a fixed clock is then an esp_pm profile
+ * with equal minimum and maximum.
+ */
+
+#include "power_profile.h"
+#include "sysinfo.h"
+#include "seqlock.h"
+#include "debug.h"
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#if CONFIG_PM_ENABLE
+#include "esp_pm.h"
+#endif
+
+static_assert(POWER_MIN_CPU_MHZ >= 80, "below 80 MHz the APB clock of the pulse counter drops");
+
+static const uint32_t BENCH_SETTLE_MS = 2000;      ///< After a mode switch, before measuring
+static const uint32_t BENCH_SAMPLE_MS = 100;       ///< Current sense sampling period
+
+static SemaphoreHandle_t clockMutex = nullptr;
+static PowerMode mode = POWER_MODE_FIXED_MAX;
+static bool screenOff = false;
+static volatile bool benchRunning = false;
+static uint32_t benchSecondsPerMode = 0;
+static PowerBenchCounts benchCounts = nullptr;
+static SeqLock<PowerBenchReport> reportLock;
+#if CONFIG_PM_ENABLE
+static esp_pm_lock_handle_t pcntLock = nullptr;
+#endif
+
+/**
+ * @brief Programs the clock for the current mode and screen state (clockMutex held).
+ */
+static bool applyClock() {
+    uint32_t maxMhz = POWER_MAX_CPU_MHZ;
+    uint32_t minMhz = POWER_MIN_CPU_MHZ;
+    if (mode == POWER_MODE_FIXED_MIN) {
+        maxMhz = POWER_MIN_CPU_MHZ;
+    } else if (mode == POWER_MODE_FIXED_MAX) {
+        // The screen-off clock is not applied while the benchmark owns the modes
+        bool lowered = screenOff && !benchRunning && DISPLAY_OFF_CPU_MHZ > 0;
+        maxMhz = lowered ? DISPLAY_OFF_CPU_MHZ : POWER_MAX_CPU_MHZ;
+        minMhz = maxMhz;
+    }
+
+#if CONFIG_PM_ENABLE
+    esp_pm_config_esp32s3_t pm;
+    pm.max_freq_mhz = maxMhz;
+    pm.min_freq_mhz = minMhz;
+    pm.light_sleep_enable = false; // The PCNT lock would block it anyway
+    esp_err_t err = esp_pm_configure(&pm);
+    if (err != ESP_OK) {
+        DEBUG_PRINTF("Power: esp_pm_configure(%lu-%lu MHz) failed (%d)\n", (unsigned long)minMhz,
+                     (unsigned long)maxMhz, err);
+        return false;
+    }
+    return true;
+#else
+    (void)minMhz; // A fixed clock has no separate minimum
+    return setCpuFrequencyMhz(maxMhz);
+#endif
+}
+
+bool initPowerProfile() {
+    if (clockMutex) return true;
+    clockMutex = xSemaphoreCreateMutex();
+    if (!clockMutex) return false;
+
+#if CONFIG_PM_ENABLE
+    // Held for the lifetime of the PCNT unit; see power_profile.h
+    if (esp_pm_lock_create(ESP_PM_APB_FREQ_MAX, 0, "pcnt", &pcntLock) == ESP_OK) {
+        esp_pm_lock_acquire(pcntLock);
+    } else {
+        DEBUG_PRINTLN("WARNING: PCNT power lock unavailable");
+    }
+#endif
+    return powerProfileSetMode(powerProfileDfsSupported() ? POWER_MODE_DFS : POWER_MODE_FIXED_MAX);
+}
+
+bool powerProfileSetMode(PowerMode next) {
+    if (!clockMutex || next >= POWER_MODE_COUNT) return false;
+    if (next == POWER_MODE_DFS && !powerProfileDfsSupported()) return false;
+    xSemaphoreTake(clockMutex, portMAX_DELAY);
+    PowerMode previous = mode;
+    mode = next;
+    bool ok = applyClock();
+    if (!ok) {
+        mode = previous;
+        applyClock();
+    }
+    xSemaphoreGive(clockMutex);
+    return ok;
+}
+
+PowerMode powerProfileMode() {
+    return mode;
+}
+
+bool powerProfileDfsSupported() {
+#if CONFIG_PM_ENABLE
+    return true;
+#else
+    return false;
+#endif
+}
+
+const char* powerModeName(uint8_t value) {
+    static const char* NAMES[POWER_MODE_COUNT] = {"max", "min", "dfs"};
+    return value < POWER_MODE_COUNT ? NAMES[value] : "?";
+}
+
+void powerProfileSetScreenOff(bool off) {
+    if (!clockMutex) return;
+    xSemaphoreTake(clockMutex, portMAX_DELAY);
+    if (screenOff != off) {
+        screenOff = off;
+        applyClock();
+    }
+    xSemaphoreGive(clockMutex);
+}
+
+/**
+ * @brief Measures one mode: settle, then count closed buckets and sample the sense input.
+ */
+static void benchMode(PowerMode benchedMode, PowerBenchResult& result) {
+    memset(&result, 0, sizeof(result));
+    result.mode = benchedMode;
+    result.currentMa = -1.0f;
+    if (!powerProfileSetMode(benchedMode)) {
+        result.skipped = true;
+        return;
+    }
+    vTaskDelay(pdMS_TO_TICKS(BENCH_SETTLE_MS));
+
+    uint32_t startCounts, startSeconds, counts, seconds;
+    benchCounts(&startCounts, &startSeconds);
+    double currentSum = 0.0;
+    uint32_t currentSamples = 0;
+    uint32_t startMs = millis();
+    while (millis() - startMs < benchSecondsPerMode * 1000UL) {
+        if (POWER_BENCH_CURRENT_PIN >= 0) {
+            currentSum += analogReadMilliVolts(POWER_BENCH_CURRENT_PIN) / POWER_BENCH_MV_PER_MA;
+            currentSamples++;
+        }
+        vTaskDelay(pdMS_TO_TICKS(BENCH_SAMPLE_MS));
+    }
+    benchCounts(&counts, &seconds);
+
+    result.seconds = seconds - startSeconds;
+    result.counts = counts - startCounts;
+    if (currentSamples) result.currentMa = (float)(currentSum / currentSamples);
+    SysInfoSample sample = getSysInfoSample();
+    result.cpuLoad[0] = sample.cpuLoad[0];
+    result.cpuLoad[1] = sample.cpuLoad[1];
+}
+
+/**
+ * @brief Benchmark task: every mode in turn, then the previous mode again.
+ */
+static void powerBenchTask(void* parameter) {
+    PowerMode previous = mode;
+    PowerBenchReport report;
+    memset(&report, 0, sizeof(report));
+    report.running = true;
+    reportLock.publish(report);
+
+    for (uint8_t m = 0; m < POWER_MODE_COUNT; m++) {
+        DEBUG_PRINTF("Power bench: mode %s for %lu s\n", powerModeName(m), (unsigned long)benchSecondsPerMode);
+        benchMode((PowerMode)m, report.results[m]);
+        report.count = m + 1;
+        reportLock.publish(report);
+    }
+
+    benchRunning = false;
+    powerProfileSetMode(previous);
+    report.running = false;
+    reportLock.publish(report);
+    DEBUG_PRINTLN("Power bench: done (\"power\" prints the results)");
+    vTaskDelete(NULL);
+}
+
+bool startPowerBench(uint32_t secondsPerMode, PowerBenchCounts counts) {
+    if (!clockMutex || !counts || benchRunning || secondsPerMode == 0) return false;
+    benchRunning = true;
+    benchSecondsPerMode = secondsPerMode;
+    benchCounts = counts;
+    if (xTaskCreatePinnedToCore(powerBenchTask, "PowerBench", 3072, NULL, tskIDLE_PRIORITY + 1, NULL, 0) != pdPASS) {
+        benchRunning = false;
+        return false;
+    }
+    return true;
+}
+
+PowerBenchReport getPowerBenchReport() {
+    PowerBenchReport report;
+    memset(&report, 0, sizeof(report));
+    reportLock.read(report);
+    return report;
+}
+
+void printPowerProfile(Print& out) {
+    out.printf("Power mode: %s (%s), CPU %lu MHz, screen %s\n", powerModeName(mode),
+               powerProfileDfsSupported() ? "esp_pm" : "fixed clock only", (unsigned long)getCpuFrequencyMhz(),
+               screenOff ? "off" : "on");
+    out.printf("  DFS range %d-%d MHz, light sleep off (PCNT needs the APB clock)\n", POWER_MIN_CPU_MHZ,
+               POWER_MAX_CPU_MHZ);
+
+    PowerBenchReport report = getPowerBenchReport();
+    if (report.count == 0 && !report.running) return;
+    out.printf("Power bench%s:\n", report.running ? " (running)" : "");
+    for (uint8_t i = 0; i < report.count; i++) {
+        const PowerBenchResult& r = report.results[i];
+        if (r.skipped) {
+            out.printf("  %-4s: not available\n", powerModeName(r.mode));
+            continue;
+        }
+        float cps = r.seconds ? (float)r.counts / r.seconds : 0.0f;
+        float sigma = r.seconds ? sqrtf((float)r.counts) / r.seconds : 0.0f;
+        out.printf("  %-4s: %.3f +/- %.3f cps over %lu s, load %d%% / %d%%", powerModeName(r.mode), cps, sigma,
+                   (unsigned long)r.seconds, r.cpuLoad[0], r.cpuLoad[1]);
+        if (r.currentMa >= 0.0f) out.printf(", %.1f mA", r.currentMa);
+        out.println();
+    }
+}
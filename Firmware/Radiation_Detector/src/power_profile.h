@@ -0,0 +1,74 @@
+#ifndef POWER_PROFILE_H
+#define POWER_PROFILE_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// CPU clock and power-management profile.
+// With CONFIG_PM_ENABLE in the SDK configuration the default mode is dynamic
+// frequency scaling (esp_pm): the CPU runs at POWER_MAX_CPU_MHZ while any task
+// or driver holds a CPU lock and drops to POWER_MIN_CPU_MHZ when idle. Without
+// it the clock is fixed, and only the screen-off state lowers it.
+//
+// The pulse counter stays exact in every mode:
+//  - POWER_MIN_CPU_MHZ is at least 80 MHz, so the APB clock (PCNT, its glitch
+//    filter, the capture timer) never changes frequency.
+//  - An ESP_PM_APB_FREQ_MAX lock is held for the PCNT unit from boot, as the
+//    IDF pulse-counter driver itself does when its glitch filter is enabled.
+//    That lock also keeps automatic light sleep from engaging: light sleep gates
+//    the APB clock and the PCNT unit stops, so pulses arriving in it would be
+//    lost. The pulse poll and all rate windows run off millis() and vTaskDelay(),
+//    which stay exact under tickless idle.
+//
+// "power bench" runs each mode in turn for a fixed time, reports the count rate
+// seen by the pipeline (it must agree between modes within Poisson error), the
+// CPU load per core and, when POWER_BENCH_CURRENT_PIN is wired to a current
+// sense amplifier, the mean supply current.
+
+enum PowerMode {
+    POWER_MODE_FIXED_MAX = 0,
+    POWER_MODE_FIXED_MIN,
+    POWER_MODE_DFS,
+    POWER_MODE_COUNT
+};
+
+// Counts since boot and the number of closed 1-second buckets behind them.
+typedef void (*PowerBenchCounts)(uint32_t* counts, uint32_t* seconds);
+
+struct PowerBenchResult {
+    uint8_t mode;          ///< PowerMode
+    bool skipped;          ///< Mode not available in this build
+    uint32_t seconds;      ///< Closed buckets measured
+    uint32_t counts;
+    int8_t cpuLoad[2];     ///< % per core at the end of the mode, -1 if unknown
+    float currentMa;       ///< Mean supply current, < 0 without a sense input
+};
+
+struct PowerBenchReport {
+    bool running;
+    uint8_t count;
+    PowerBenchResult results[POWER_MODE_COUNT];
+};
+
+// Takes the PCNT lock and applies the default mode. Call once in setup().
+bool initPowerProfile();
+
+// False if @p mode is not available (DFS without CONFIG_PM_ENABLE).
+bool powerProfileSetMode(PowerMode mode);
+PowerMode powerProfileMode();
+bool powerProfileDfsSupported();
+const char* powerModeName(uint8_t mode);
+
+// Screen-off hint from display_power: with a fixed clock the CPU drops to
+// DISPLAY_OFF_CPU_MHZ while the screen is off. DFS already idles at its minimum.
+void powerProfileSetScreenOff(bool off);
+
+// Starts the benchmark task (@p secondsPerMode each); false if one is running.
+bool startPowerBench(uint32_t secondsPerMode, PowerBenchCounts counts);
+
+PowerBenchReport getPowerBenchReport();
+
+// Mode, clock and the last benchmark ("power").
+void printPowerProfile(Print& out);
+
+#endif // POWER_PROFILE_H
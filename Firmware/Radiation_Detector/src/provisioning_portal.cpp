@@ -0,0 +1,241 @@
+/**
+ * @file provisioning_portal.cpp
+ * @brief Captive setup portal on a temporary access point.
+ *
+ * Everything the portal needs is created by its task and destroyed by it on
+ * the way out, so a unit that has been set up carries none of it: the page
+ * and its handlers stay in flash, and the only RAM left is the state below.
+ * The task polls the DNS and HTTP servers every few milliseconds; a setup
+ * page with one client does not need more, and the poll stops with the task.
+ */
+
+#include "provisioning_portal.h"
+#include "portal_page.h" // Generated from web/portal.html by tools/embed_dashboard.py
+#include "wifi_manager.h"
+#include "ethernet_link.h"
+#include "mdns_service.h"
+#include "device_config.h"
+#include "web_service.h"
+#include "https_service.h"
+#include "debug.h"
+#include <WiFi.h>
+#include <WebServer.h>
+#include <DNSServer.h>
+#include <ArduinoJson.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+static const uint32_t TASK_STACK = 6144;
+static const uint32_t POLL_MS = 5;
+static const uint32_t SAVE_LINGER_MS = 500; ///< Lets the answer to /save reach the client
+
+static TaskHandle_t taskHandle = nullptr;
+static WebServer* server = nullptr;         ///< Portal task only
+static volatile bool stopRequested = false;
+static volatile bool saved = false;
+static bool closePending = false;            ///< UI task: the close has not been handled
+static PortalStats stats;
+static uint32_t openedMs = 0;
+
+static void handlePage() {
+    stats.requests++;
+    server->sendHeader("Cache-Control", "no-store");
+    server->sendHeader("Content-Encoding", "gzip");
+    server->send_P(200, "text/html", (const char*)PORTAL_PAGE_GZ, PORTAL_PAGE_GZ_LEN);
+}
+
+/**
+ * @brief GET /scan: the scan cache, refreshed once it is older than WIFI_SCAN_REFRESH_S.
+ */
+static void handleScan() {
+    stats.requests++;
+    uint32_t now = millis();
+    if (!wifiManagerScanPending() && wifiManagerScanAgeMs(now) >= WIFI_SCAN_REFRESH_S * 1000UL) wifiManagerScan();
+
+    WifiNetwork networks[WIFI_SCAN_MAX_NETWORKS];
+    size_t n = wifiManagerNetworks(networks, WIFI_SCAN_MAX_NETWORKS, nullptr);
+    JsonDocument doc;
+    doc["scanning"] = wifiManagerScanPending();
+    JsonArray list = doc["networks"].to<JsonArray>();
+    for (size_t i = 0; i < n; i++) {
+        JsonObject o = list.add<JsonObject>();
+        o["ssid"] = (const char*)networks[i].ssid;
+        o["rssi"] = networks[i].rssi;
+        o["secure"] = networks[i].secure;
+    }
+    String json;
+    serializeJson(doc, json);
+    server->sendHeader("Cache-Control", "no-store");
+    server->send(200, "application/json", json);
+}
+
+/**
+ * @brief Text with the HTML metacharacters replaced by entities, for echoing
+ *        a client's input back into a page.
+ */
+static String htmlEscape(const String& text) {
+    String out;
+    out.reserve(text.length() + 16);
+    for (size_t i = 0; i < text.length(); i++) {
+        char c = text[i];
+        switch (c) {
+            case '&': out += "&amp;"; break;
+            case '<': out += "&lt;"; break;
+            case '>': out += "&gt;"; break;
+            case '"': out += "&quot;"; break;
+            case '\'': out += "&#39;"; break;
+            default: out += c; break;
+        }
+    }
+    return out;
+}
+
+/**
+ * @brief POST /save with the form fields ssid and password.
+ */
+static void handleSave() {
+    stats.requests++;
+    String ssid = server->arg("ssid");
+    String password = server->arg("password");
+    if (ssid.length() == 0 || ssid.length() > 32 || password.length() > 63 ||
+        (password.length() > 0 && password.length() < 8)) {
+        server->send(400, "text/plain", "Network name of 1-32 characters, password empty or 8-63 characters");
+        return;
+    }
+    if (!wifiManagerSaveCredentials(ssid.c_str(), password.c_str())) {
+        server->send(500, "text/plain", "Could not save the credentials");
+        return;
+    }
+    strlcpy(stats.savedSsid, ssid.c_str(), sizeof(stats.savedSsid));
+    String page = "<!DOCTYPE html><html><head><meta name='viewport' content='width=device-width'></head>"
+                  "<body style='font-family:sans-serif;background:#0f1317;color:#D8C12C;text-align:center'>"
+                  "<p>Saved. The detector now joins " + htmlEscape(ssid) + "; this setup network closes.</p></body></html>";
+    server->send(200, "text/html", page);
+    saved = true;
+    DEBUG_PRINTF("Portal: credentials for %s saved\n", ssid.c_str());
+}
+
+/**
+ * @brief Captive portal checks (generate_204, hotspot-detect.html, ...) and
+ *        everything else: a redirect to the page.
+ */
+static void handleOther() {
+    stats.requests++;
+    server->sendHeader("Location", "http://" + WiFi.softAPIP().toString() + "/");
+    server->send(302, "text/plain", "");
+}
+
+static void portalTask(void* parameter) {
+    WiFi.mode(WIFI_AP_STA);
+    const char* password = sizeof(PORTAL_PASSWORD) > 1 ? PORTAL_PASSWORD : nullptr;
+    if (!WiFi.softAP(mdnsHostname(), password)) {
+        DEBUG_PRINTLN("Portal: access point not started");
+        WiFi.mode(WIFI_STA);
+        stats.state = PORTAL_FAILED;
+        taskHandle = nullptr;
+        vTaskDelete(NULL);
+        return;
+    }
+    IPAddress ip = WiFi.softAPIP();
+    DNSServer* dns = new DNSServer();
+    dns->setErrorReplyCode(DNSReplyCode::NoError);
+    dns->start(53, "*", ip);
+    server = new WebServer(80);
+    server->on("/", HTTP_GET, handlePage);
+    server->on("/scan", HTTP_GET, handleScan);
+    server->on("/save", HTTP_POST, handleSave);
+    server->onNotFound(handleOther);
+    server->begin();
+    wifiManagerScan(); // The list is ready by the time a phone has joined
+    DEBUG_PRINTF("Portal: open as %s at %s\n", mdnsHostname(), ip.toString().c_str());
+
+    uint32_t savedAt = 0;
+    for (;;) {
+        dns->processNextRequest();
+        server->handleClient();
+        uint32_t now = millis();
+        if (saved && !savedAt) savedAt = now ? now : 1;
+        if (savedAt && now - savedAt >= SAVE_LINGER_MS) break;
+        if (stopRequested) break;
+        if (PORTAL_TIMEOUT_S && !saved && now - openedMs >= PORTAL_TIMEOUT_S * 1000UL) {
+            DEBUG_PRINTLN("Portal: timed out");
+            break;
+        }
+        vTaskDelay(pdMS_TO_TICKS(POLL_MS));
+    }
+
+    server->stop();
+    delete server;
+    server = nullptr;
+    dns->stop();
+    delete dns;
+    WiFi.softAPdisconnect(true);
+    WiFi.mode(wifiManagerSuspended() ? WIFI_OFF : WIFI_STA); // Ethernet came up meanwhile
+    stats.openMs = millis() - openedMs;
+    stats.state = saved ? PORTAL_SAVED : PORTAL_CLOSED;
+    DEBUG_PRINTF("Portal: closed after %lu s\n", (unsigned long)(stats.openMs / 1000));
+    taskHandle = nullptr;
+    vTaskDelete(NULL);
+}
+
+bool provisioningPortalStart() {
+    if (!PORTAL_ENABLED || taskHandle) return false;
+    stopRequested = false;
+    saved = false;
+    memset(&stats, 0, sizeof(stats));
+    stats.state = PORTAL_OPEN;
+    openedMs = millis();
+    if (xTaskCreatePinnedToCore(portalTask, "Portal", TASK_STACK, NULL, NETWORK_TASK_PRIORITY, &taskHandle,
+                                TASK_CORE_NETWORK) != pdPASS) {
+        DEBUG_PRINTLN("Error: portal task not created");
+        stats.state = PORTAL_FAILED;
+        taskHandle = nullptr;
+        return false;
+    }
+    closePending = true;
+    return true;
+}
+
+void provisioningPortalStop() {
+    stopRequested = true;
+}
+
+bool provisioningPortalOpen() {
+    return stats.state == PORTAL_OPEN;
+}
+
+void provisioningPortalLoop(uint32_t nowMs) {
+    if (!closePending || stats.state == PORTAL_OPEN) return;
+    closePending = false;
+    if (stats.state == PORTAL_SAVED) {
+        // Set up through the portal: connect now and on later boots
+        DeviceConfig config = getDeviceConfig();
+        if (!config.wifiAutoConnect) {
+            config.wifiAutoConnect = true;
+            setDeviceConfig(config);
+        }
+        wifiManagerConnectSaved();
+    } else if (networkOnline()) {
+        // Connected some other way while the portal held port 80
+        webServiceBegin();
+        if (HTTPS_ENABLED) httpsServiceBegin();
+    }
+}
+
+PortalStats getPortalStats() {
+    PortalStats s = stats;
+    if (s.state == PORTAL_OPEN) s.openMs = millis() - openedMs;
+    return s;
+}
+
+void printProvisioningPortal(Print& out) {
+    static const char* const NAMES[] = {"off", "open", "closed after a save", "closed", "failed"};
+    PortalStats s = getPortalStats();
+    out.printf("Setup portal: %s", s.state <= PORTAL_FAILED ? NAMES[s.state] : "?");
+    if (s.state != PORTAL_OFF && s.state != PORTAL_FAILED) {
+        out.printf(" (%s, %lu s, %lu requests)", mdnsHostname(), (unsigned long)(s.openMs / 1000),
+                   (unsigned long)s.requests);
+    }
+    out.println();
+    if (s.savedSsid[0]) out.printf("  saved: %s\n", s.savedSsid);
+}
@@ -0,0 +1,57 @@
+#ifndef PROVISIONING_PORTAL_H
+#define PROVISIONING_PORTAL_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// First-time WiFi setup through an access point. With no network saved
+// (wifi_manager.h), setup() opens the access point mdnsHostname() and a
+// portal of its own:
+//   - a DNS server answers every name with the access point's address, so
+//     phones and laptops show the page as a captive portal;
+//   - a WebServer of its own on port 80 serves one gzip page from flash
+//     (src/web/portal.html, embedded by tools/embed_dashboard.py), the scan
+//     cache as JSON at /scan and POST /save; anything else is redirected to
+//     the page. None of the dashboard's routes, web task or arena is started;
+//   - both run on one task, whose stack, the server, the DNS server and the
+//     access point are all released when the portal closes: the credentials
+//     were saved, PORTAL_TIMEOUT_S passed or "portal stop".
+// After a save, provisioningPortalLoop() turns on auto-connect and joins the
+// network through the connection state machine; the dashboard then starts on
+// the first connection as usual. A connection made another way (the settings
+// screen) closes the portal, and the dashboard starts once port 80 is free.
+// "portal open" reopens it by hand.
+
+enum PortalState {
+    PORTAL_OFF = 0,           ///< Never opened since boot
+    PORTAL_OPEN,
+    PORTAL_SAVED,             ///< Closed after credentials were saved
+    PORTAL_CLOSED,            ///< Closed without them (timeout or stop)
+    PORTAL_FAILED             ///< The access point did not start
+};
+
+struct PortalStats {
+    uint8_t state;            ///< PortalState
+    uint32_t requests;
+    uint32_t openMs;          ///< How long it was (or has been) open
+    char savedSsid[33];
+};
+
+// Opens the access point and the portal. False if it is disabled
+// (PORTAL_ENABLED), already open or its task could not start.
+bool provisioningPortalStart();
+
+// Asks the portal to close; it does so within a few milliseconds.
+void provisioningPortalStop();
+
+bool provisioningPortalOpen();
+
+// Once the portal has closed: joins the saved network after a save, or starts
+// the web service if the station connected meanwhile. Call from the UI task
+// loop next to wifiManagerLoop().
+void provisioningPortalLoop(uint32_t nowMs);
+
+PortalStats getPortalStats();
+void printProvisioningPortal(Print& out);
+
+#endif // PROVISIONING_PORTAL_H
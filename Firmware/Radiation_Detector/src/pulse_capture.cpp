@@ -0,0 +1,104 @@
+/**
+ * @file pulse_capture.cpp
+ * @brief Per-pulse timestamp capture for the Geiger input.
+ *
+ * A rising-edge GPIO interrupt on the Geiger pin records esp_timer_get_time() for
+ * every pulse into a lock-free SPSC ring. The ISR and the ring live in IRAM/DRAM so
+ * capture keeps working while the flash cache is disabled (NVS writes, OTA).
+ * pulseTask drains the ring alongside its regular PCNT read; the PCNT count remains
+ * the reference count and this path only adds inter-arrival information.
+ */
+
+#include "pulse_capture.h"
+#include "spsc_ring.h"
+#include "debug.h"
+#include "flash_stall.h"
+#include "driver/gpio.h"
+#include "esp_timer.h"
+
+static DRAM_ATTR SpscRing<uint32_t, PULSE_CAPTURE_RING_SIZE> pulseTimestampRing;
+
+static PulseCaptureStats captureStats = {0, 0, 0, 0, UINT32_MAX, 0};
+static bool captureActive = false;
+static volatile PulseIsrHook isrHook = nullptr;
+static volatile uint32_t flashPulses = 0; ///< ISR only
+
+/**
+ * @brief GPIO ISR: timestamps one pulse. Runs from IRAM, never blocks.
+ */
+static void IRAM_ATTR pulseCaptureIsr(void* arg) {
+    uint32_t timestampUs = (uint32_t)esp_timer_get_time();
+    pulseTimestampRing.push(timestampUs);
+    if (flashStallActive()) flashPulses = flashPulses + 1;
+    PulseIsrHook hook = isrHook;
+    if (hook) hook(timestampUs);
+}
+
+bool initPulseCapture(uint8_t pin) {
+#if PULSE_CAPTURE_ENABLED
+    if (captureActive) return true;
+
+    // The PCNT unit already routes this pin as an input; only the edge interrupt is added.
+    gpio_set_intr_type((gpio_num_t)pin, GPIO_INTR_POSEDGE);
+
+    // The ISR service may already be installed by the Arduino core (attachInterrupt)
+    esp_err_t err = gpio_install_isr_service(ESP_INTR_FLAG_IRAM);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+        DEBUG_PRINTF("Pulse capture: ISR service install failed (%d)\n", err);
+        return false;
+    }
+
+    err = gpio_isr_handler_add((gpio_num_t)pin, pulseCaptureIsr, nullptr);
+    if (err != ESP_OK) {
+        DEBUG_PRINTF("Pulse capture: handler add failed (%d)\n", err);
+        return false;
+    }
+    gpio_intr_enable((gpio_num_t)pin);
+
+    captureActive = true;
+    DEBUG_PRINTF("Pulse capture enabled on GPIO %d (ring %d entries)\n", pin, PULSE_CAPTURE_RING_SIZE);
+    return true;
+#else
+    return false;
+#endif
+}
+
+size_t drainPulseCapture(PulseTimestampHandler handler, void* context) {
+    size_t drained = 0;
+    uint32_t timestampUs;
+
+    while (pulseTimestampRing.pop(timestampUs)) {
+        if (captureStats.captured > 0) {
+            // Unsigned subtraction handles the 32-bit microsecond wrap (~71 minutes)
+            uint32_t interval = timestampUs - captureStats.lastTimestampUs;
+            captureStats.lastIntervalUs = interval;
+            if (interval < captureStats.minIntervalUs) {
+                captureStats.minIntervalUs = interval;
+            }
+        }
+        captureStats.lastTimestampUs = timestampUs;
+        captureStats.captured++;
+
+        if (handler) {
+            handler(timestampUs, context);
+        }
+        drained++;
+    }
+
+    captureStats.dropped = pulseTimestampRing.dropped();
+    return drained;
+}
+
+void pulseCaptureSetIsrHook(PulseIsrHook hook) {
+    isrHook = hook;
+}
+
+bool pulseCaptureActive() {
+    return captureActive;
+}
+
+PulseCaptureStats getPulseCaptureStats() {
+    PulseCaptureStats stats = captureStats;
+    stats.duringFlash = flashPulses;
+    return stats;
+}
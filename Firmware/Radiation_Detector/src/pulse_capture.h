@@ -0,0 +1,44 @@
+#ifndef PULSE_CAPTURE_H
+#define PULSE_CAPTURE_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Callback invoked by drainPulseCapture() for every captured pulse, oldest first.
+typedef void (*PulseTimestampHandler)(uint32_t timestampUs, void* context);
+
+// Running statistics maintained by the consumer side (pulseTask).
+struct PulseCaptureStats {
+    uint32_t captured;        ///< Timestamps drained since boot
+    uint32_t dropped;         ///< Timestamps lost because the ring was full
+    uint32_t lastTimestampUs; ///< Timestamp of the most recent pulse
+    uint32_t lastIntervalUs;  ///< Inter-arrival time of the most recent pulse pair
+    uint32_t minIntervalUs;   ///< Shortest inter-arrival time seen since boot
+    uint32_t duringFlash;     ///< Taken while a flash operation had the cache off
+};
+
+// Optional function called from the capture ISR with each pulse's timestamp.
+// It must be IRAM_ATTR and ISR-safe, and return within a few microseconds;
+// it also runs while the flash cache is off, so everything it reaches has to
+// be in IRAM / DRAM, including helpers the compiler might not inline.
+typedef void (*PulseIsrHook)(uint32_t timestampUs);
+
+// Installs the GPIO edge interrupt on the given pin. Call from the task that
+// should own the interrupt; the ISR is allocated on that task's core.
+bool initPulseCapture(uint8_t pin);
+
+// Pops every queued timestamp, updates the statistics and forwards each one to
+// the optional handler. Returns the number of timestamps drained.
+size_t drainPulseCapture(PulseTimestampHandler handler = nullptr, void* context = nullptr);
+
+// Sets or clears (nullptr) the ISR hook. Any task.
+void pulseCaptureSetIsrHook(PulseIsrHook hook);
+
+// Returns true once initPulseCapture() succeeded.
+bool pulseCaptureActive();
+
+// Copy of the consumer-side statistics. Call from the draining task; other
+// tasks read the copy pulseTask publishes with each second.
+PulseCaptureStats getPulseCaptureStats();
+
+#endif // PULSE_CAPTURE_H
@@ -0,0 +1,214 @@
+#ifndef PULSE_HEIGHT_H
+#define PULSE_HEIGHT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Streaming pulse-height detector for digitised, shaped scintillator pulses.
+ *
+ * Processes ADC samples in blocks. The baseline follows the signal with an
+ * exponential moving average (time constant 2^baselineShift samples) and is
+ * frozen while a pulse is in progress. A pulse starts when a sample exceeds the
+ * baseline by @p threshold, its maximum is held, and it ends when the signal
+ * falls back below half the threshold; the held maximum minus the baseline is
+ * reported as the pulse height. State carries across blocks, so a pulse split
+ * between two DMA frames is measured once. Samples are numbered by a free-running
+ * 32-bit position, so callers can timestamp each pulse by the sample that armed
+ * it. No Arduino dependencies (host-compilable).
+ *
+ * Pile-up: with setPileUp() a pulse is marked as piled up when the signal
+ * rises again by the threshold after falling from a maximum (a second pulse
+ * on the tail), when its rise from arming to the maximum takes longer than
+ * @p maxRise samples (a second pulse on the leading edge), or when it stays
+ * armed longer than @p maxWidth samples. Its height is then the sum of two
+ * pulses. Marked pulses are either dropped and counted (reject) or reported
+ * with PULSE_FLAG_PILEUP. Every sample spent inside a pulse counts as busy,
+ * since no other pulse can be measured then; busySamples() gives the dead
+ * time of the detector for live-time correction.
+ */
+enum PulseFlags : uint8_t {
+    PULSE_FLAG_PILEUP = 0x01,   ///< Two or more overlapping pulses
+};
+
+enum PileUpMode : uint8_t {
+    PILEUP_OFF = 0,     ///< No checks, every pulse reported unflagged
+    PILEUP_FLAG,        ///< Reported with PULSE_FLAG_PILEUP
+    PILEUP_REJECT,      ///< Not reported; counted in pileUps()
+};
+
+class PulseHeightDetector {
+public:
+    explicit PulseHeightDetector(uint16_t threshold = 40, uint8_t baselineShift = 8)
+        : threshold_(threshold), shift_(baselineShift), baselineAcc_(0),
+          primed_(false), inPulse_(false), peak_(0), pulseBaseline_(0), position_(0), pulseStart_(0),
+          pileUpMode_(PILEUP_OFF), maxWidth_(0), maxRise_(0), valley_(0), peakPosition_(0), piledUp_(false),
+          busySamples_(0), pileUps_(0) {}
+
+    void setThreshold(uint16_t threshold) { threshold_ = threshold; }
+    uint16_t threshold() const { return threshold_; }
+
+    /// @p maxWidth and @p maxRise in samples, 0 disables that criterion.
+    void setPileUp(PileUpMode mode, uint16_t maxWidth, uint16_t maxRise) {
+        pileUpMode_ = mode;
+        maxWidth_ = maxWidth;
+        maxRise_ = maxRise;
+    }
+    PileUpMode pileUpMode() const { return (PileUpMode)pileUpMode_; }
+
+    /// Samples spent inside pulses (wraps).
+    uint32_t busySamples() const { return busySamples_; }
+
+    /// Pulses found piled up (rejected or flagged) since construction.
+    uint32_t pileUps() const { return pileUps_; }
+
+    /// Current baseline estimate in ADC codes.
+    uint16_t baseline() const { return (uint16_t)(baselineAcc_ >> shift_); }
+
+    /// Samples consumed so far (wraps); the next sample has this position.
+    uint32_t position() const { return position_; }
+
+    /**
+     * @brief Runs the detector over @p count samples.
+     * @param heights    Receives pulse heights (ADC codes above baseline)
+     * @param maxHeights Capacity of @p heights; further pulses in the block are counted but not stored
+     * @param starts     Optional, receives the position of the sample that armed each stored pulse
+     * @param flags      Optional, receives the PulseFlags of each stored pulse
+     * @return Number of pulses that ended in this block, rejected pile-ups not included
+     */
+    size_t process(const uint16_t* samples, size_t count, uint16_t* heights, size_t maxHeights,
+                   uint32_t* starts = nullptr, uint8_t* flags = nullptr) {
+        size_t found = 0;
+        if (count == 0) return 0;
+        if (!primed_) {
+            baselineAcc_ = (uint32_t)samples[0] << shift_;
+            primed_ = true;
+        }
+
+        uint32_t armLevel = threshold_;
+        uint32_t releaseLevel = threshold_ / 2;
+        for (size_t i = 0; i < count; i++) {
+            uint16_t s = samples[i];
+            if (inPulse_) {
+                busySamples_++;
+                if (s > peak_) {
+                    // Rising again after the signal had fallen: a second pulse
+                    if (valley_ < peak_ && s > valley_ + armLevel) piledUp_ = true;
+                    peak_ = s;
+                    valley_ = s;
+                    peakPosition_ = position_ + (uint32_t)i;
+                } else if (s < valley_) {
+                    valley_ = s;
+                } else if (s > valley_ + armLevel) {
+                    piledUp_ = true;
+                }
+                if (s <= pulseBaseline_ + releaseLevel) {
+                    inPulse_ = false;
+                    uint8_t pulseFlags = 0;
+                    if (pileUpMode_ != PILEUP_OFF) {
+                        uint32_t end = position_ + (uint32_t)i;
+                        if (piledUp_ || (maxWidth_ && end - pulseStart_ > maxWidth_) ||
+                            (maxRise_ && peakPosition_ - pulseStart_ > maxRise_)) {
+                            pileUps_++;
+                            if (pileUpMode_ == PILEUP_REJECT) continue;
+                            pulseFlags = PULSE_FLAG_PILEUP;
+                        }
+                    }
+                    if (found < maxHeights) {
+                        heights[found] = (uint16_t)(peak_ - pulseBaseline_);
+                        if (starts) starts[found] = pulseStart_;
+                        if (flags) flags[found] = pulseFlags;
+                    }
+                    found++;
+                }
+                continue;
+            }
+
+            uint16_t base = (uint16_t)(baselineAcc_ >> shift_);
+            if (s > base + armLevel) {
+                inPulse_ = true;
+                peak_ = s;
+                valley_ = s;
+                piledUp_ = false;
+                pulseBaseline_ = base;
+                pulseStart_ = position_ + (uint32_t)i;
+                peakPosition_ = pulseStart_;
+                busySamples_++;
+                continue;
+            }
+            // Integer EMA: acc += s - acc / 2^shift
+            baselineAcc_ = baselineAcc_ - (baselineAcc_ >> shift_) + s;
+        }
+        position_ += (uint32_t)count;
+        return found;
+    }
+
+    /**
+     * @brief Same as process(), using per-chunk max/sum from pulseKernelSummarize().
+     *
+     * Chunks of @p chunkSize samples whose maximum stays below the trigger level
+     * while no pulse is open are consumed in one step: the baseline advances by
+     * the chunk sum (a chunk-wise EMA, accurate while 2^baselineShift is well
+     * above @p chunkSize). All other chunks, and a trailing partial chunk, go
+     * through the per-sample path, so detected pulses and heights are identical.
+     */
+    size_t processScreened(const uint16_t* samples, size_t count, size_t chunkSize,
+                           const int16_t* chunkMax, const int32_t* chunkSum,
+                           uint16_t* heights, size_t maxHeights, uint32_t* starts = nullptr,
+                           uint8_t* flags = nullptr) {
+        if (count == 0) return 0;
+        if (!primed_) {
+            baselineAcc_ = (uint32_t)samples[0] << shift_;
+            primed_ = true;
+        }
+
+        size_t found = 0;
+        size_t chunks = count / chunkSize;
+        bool fastPath = ((size_t)1 << shift_) >= chunkSize * 4;
+        for (size_t c = 0; c < chunks; c++) {
+            uint32_t base = baselineAcc_ >> shift_;
+            if (fastPath && !inPulse_ && chunkMax[c] >= 0 && (uint32_t)chunkMax[c] <= base + threshold_) {
+                baselineAcc_ = baselineAcc_ - chunkSize * (baselineAcc_ >> shift_) + (uint32_t)chunkSum[c];
+                position_ += (uint32_t)chunkSize;
+                continue;
+            }
+            size_t stored = found < maxHeights ? found : maxHeights;
+            found += process(samples + c * chunkSize, chunkSize, heights + stored, maxHeights - stored,
+                             starts ? starts + stored : nullptr, flags ? flags + stored : nullptr);
+        }
+        size_t tail = count - chunks * chunkSize;
+        if (tail) {
+            size_t stored = found < maxHeights ? found : maxHeights;
+            found += process(samples + chunks * chunkSize, tail, heights + stored, maxHeights - stored,
+                             starts ? starts + stored : nullptr, flags ? flags + stored : nullptr);
+        }
+        return found;
+    }
+
+    /// Forgets the baseline and any pulse in progress (e.g. after a gap in the sample stream).
+    void reset() {
+        primed_ = false;
+        inPulse_ = false;
+    }
+
+private:
+    uint16_t threshold_;
+    uint8_t shift_;
+    uint32_t baselineAcc_;   ///< Baseline << shift_
+    bool primed_;
+    bool inPulse_;
+    uint16_t peak_;
+    uint16_t pulseBaseline_; ///< Baseline frozen at the start of the current pulse
+    uint32_t position_;      ///< Position of the next sample
+    uint32_t pulseStart_;    ///< Position of the sample that armed the current pulse
+    uint8_t pileUpMode_;     ///< PileUpMode
+    uint16_t maxWidth_;
+    uint16_t maxRise_;
+    uint16_t valley_;        ///< Lowest sample since the last maximum of the current pulse
+    uint32_t peakPosition_;
+    bool piledUp_;           ///< Second rise seen in the current pulse
+    uint32_t busySamples_;
+    uint32_t pileUps_;
+};
+
+#endif // PULSE_HEIGHT_H
@@ -0,0 +1,380 @@
+/**
+ * @file pulse_injector.cpp
+ * @brief RMT pulse trains looped back to the Geiger input, and the count report.
+ *
+ * The RMT runs at 1 MHz (APB / 80), so one item half is up to 32767 us; a
+ * longer low gap takes extra all-low items. Items are generated into two
+ * blocks of BLOCK_ITEMS in internal RAM: the next block is filled while the
+ * driver sends the other one from its refill interrupt. Between two blocks the
+ * output idles low for the few microseconds rmt_write_items() takes to start,
+ * which lengthens one gap and changes no count.
+ */
+
+#include "pulse_injector.h"
+#include "command_bus.h"
+#include "device_config.h"
+#include "dead_time.h"
+#include "seqlock.h"
+#include "debug.h"
+#include "driver/rmt.h"
+#include "esp_heap_caps.h"
+#include "esp_random.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+static const rmt_channel_t INJECT_CHANNEL = RMT_CHANNEL_0; ///< Transmit channels are 0-3 on the ESP32-S3
+static const uint8_t INJECT_CLOCK_DIV = 80;                ///< 80 MHz APB / 80: 1 us per tick
+static const uint32_t MAX_HALF_US = 32767;
+static const uint32_t MIN_LOW_US = PULSE_INJECT_WIDTH_US;  ///< Gaps no shorter than pulses pass any input filter
+static const size_t BLOCK_ITEMS = 1024;
+static const uint32_t BACKGROUND_MS = 5000;                ///< Idle count window before a run
+
+static_assert(PULSE_INJECT_WIDTH_US >= 1 && PULSE_INJECT_WIDTH_US < MAX_HALF_US, "Injected pulse width out of range");
+
+// Release acceptance plan ("inject bench"); poisson steps take the configured dead time
+static const PulsePatternParams BENCH_PLAN[] = {
+    {PULSE_PATTERN_FIXED, 10.0f, 0.0f, 0, 0},
+    {PULSE_PATTERN_FIXED, 1000.0f, 0.0f, 0, 0},
+    {PULSE_PATTERN_FIXED, 10000.0f, 0.0f, 0, 0},
+    {PULSE_PATTERN_FIXED, 25000.0f, 0.0f, 0, 0},
+    {PULSE_PATTERN_POISSON, 60.0f, 0.0f, 0, 0},
+    {PULSE_PATTERN_POISSON, 600.0f, 0.0f, 0, 0},
+    {PULSE_PATTERN_POISSON, 6000.0f, 0.0f, 0, 0},
+    {PULSE_PATTERN_POISSON, 60000.0f, 0.0f, 0, 0},
+    {PULSE_PATTERN_POISSON, 300000.0f, 0.0f, 0, 0},
+    {PULSE_PATTERN_POISSON, 1200000.0f, 0.0f, 0, 0},
+    {PULSE_PATTERN_BURST, 100.0f, 0.0f, 20, 500},
+    {PULSE_PATTERN_BURST, 1000.0f, 0.0f, 2 * PULSE_INJECT_WIDTH_US, 2000},
+};
+static const uint8_t BENCH_STEPS = sizeof(BENCH_PLAN) / sizeof(BENCH_PLAN[0]);
+static_assert(sizeof(BENCH_PLAN) / sizeof(BENCH_PLAN[0]) <= PULSE_INJECT_MAX_STEPS, "Acceptance plan too long");
+
+static bool injectorReady = false;
+static uint8_t loopbackPin = 0;
+static PulseInjectCounts injectCounts = nullptr;
+static volatile bool injectRunning = false;
+static volatile bool stopRequested = false;
+static volatile PulseInjectStartHook startHook = nullptr;
+static SeqLock<PulseInjectReport> reportLock;
+static PulseInjectReport report;          ///< Injector task while it runs
+static rmt_item32_t* blocks[2] = {nullptr, nullptr};
+
+bool initPulseInjector(uint8_t geigerPin, PulseInjectCounts counts) {
+    if (PULSE_INJECT_PIN < 0 || PULSE_INJECT_PIN == geigerPin || !counts) return false;
+    loopbackPin = geigerPin;
+    injectCounts = counts;
+
+    rmt_config_t config = RMT_DEFAULT_CONFIG_TX((gpio_num_t)PULSE_INJECT_PIN, INJECT_CHANNEL);
+    config.clk_div = INJECT_CLOCK_DIV;
+    config.mem_block_num = 1;
+    config.tx_config.idle_output_en = true;
+    config.tx_config.idle_level = RMT_IDLE_LEVEL_LOW;
+    config.tx_config.carrier_en = false;
+    config.tx_config.loop_en = false;
+
+    esp_err_t err = rmt_config(&config);
+    if (err == ESP_OK) err = rmt_driver_install(INJECT_CHANNEL, 0, 0);
+    if (err != ESP_OK) {
+        DEBUG_PRINTF("Pulse injector: RMT setup failed (%d)\n", err);
+        return false;
+    }
+    memset(&report, 0, sizeof(report));
+    reportLock.publish(report);
+    injectorReady = true;
+    DEBUG_PRINTF("Pulse injector on GPIO %d (wire it to GPIO %d)\n", PULSE_INJECT_PIN, geigerPin);
+    return true;
+}
+
+/**
+ * @brief Tells pulseTask whether the counts are injected; retried until queued.
+ */
+static void postInjecting(bool on) {
+    Command cmd = {};
+    cmd.type = COMMAND_SET_INJECTING;
+    cmd.arg.injecting = on;
+    while (!commandPost(COMMAND_TARGET_PULSE, cmd)) vTaskDelay(pdMS_TO_TICKS(10));
+}
+
+/**
+ * @brief Fills blocks with RMT items and hands each to the driver.
+ */
+class ItemStream {
+public:
+    /// @p leadUs: low time before the first pulse, for the start hook
+    explicit ItemStream(uint32_t leadUs) : block_(0), length_(0), sent_(false), leadUs_(leadUs) {}
+
+    void pulse(uint32_t lowUs) {
+        if (length_ + 4 > BLOCK_ITEMS) flush();
+        uint32_t firstLow = lowUs > MAX_HALF_US ? MAX_HALF_US : lowUs;
+        put(1, PULSE_INJECT_WIDTH_US, 0, firstLow);
+        low(lowUs - firstLow);
+    }
+
+    /// Low output for @p us; every half of an item needs a duration of at least 1.
+    void low(uint32_t us) {
+        while (us > 0) {
+            if (length_ + 1 > BLOCK_ITEMS) flush();
+            uint32_t item = us > 2 * MAX_HALF_US ? 2 * MAX_HALF_US : us;
+            if (item == 1) {
+                put(0, 1, 0, 1); // One microsecond too long, at most once per gap
+            } else {
+                put(0, item / 2, 0, item - item / 2);
+            }
+            us -= item;
+        }
+    }
+
+    void flush() {
+        if (length_ == 0) return;
+        if (sent_) rmt_wait_tx_done(INJECT_CHANNEL, portMAX_DELAY);
+        uint32_t startUs = (uint32_t)esp_timer_get_time();
+        rmt_write_items(INJECT_CHANNEL, blocks[block_], length_, false);
+        PulseInjectStartHook hook = startHook;
+        if (!sent_ && hook) hook(startUs + leadUs_);
+        sent_ = true;
+        block_ ^= 1;
+        length_ = 0;
+    }
+
+    void finish() {
+        flush();
+        if (sent_) rmt_wait_tx_done(INJECT_CHANNEL, portMAX_DELAY);
+    }
+
+private:
+    void put(uint32_t level0, uint32_t duration0, uint32_t level1, uint32_t duration1) {
+        rmt_item32_t& item = blocks[block_][length_++];
+        item.level0 = level0;
+        item.duration0 = duration0;
+        item.level1 = level1;
+        item.duration1 = duration1;
+    }
+
+    uint8_t block_;
+    size_t length_;
+    bool sent_;
+    uint32_t leadUs_;
+};
+
+/**
+ * @brief Waits out the settle time and reads the counts.
+ */
+static uint32_t settledCounts() {
+    vTaskDelay(pdMS_TO_TICKS(PULSE_INJECT_SETTLE_MS));
+    uint32_t counts, seconds;
+    injectCounts(&counts, &seconds);
+    return counts;
+}
+
+/**
+ * @brief Injects one train and compares the registered counts with it.
+ */
+static void runStep(const PulsePatternParams& plan, uint32_t stepSeconds, PulseInjectStep& step) {
+    memset(&step, 0, sizeof(step));
+    step.params = plan;
+    if (plan.type == PULSE_PATTERN_POISSON) step.params.deadTimeUs = report.deadTimeUs;
+    step.seconds = stepSeconds;
+    step.seed = esp_random();
+
+    uint32_t startMs = millis();
+    uint32_t startCounts = settledCounts();
+
+    PulsePattern pattern;
+    pattern.begin(step.params, PULSE_INJECT_WIDTH_US + MIN_LOW_US, stepSeconds * 1000000ULL, step.seed);
+    uint32_t interval;
+    bool more = pattern.next(&interval);
+    ItemStream stream(more ? interval : 0);
+    if (more) stream.low(interval);
+    while (more && !stopRequested) {
+        more = pattern.next(&interval);
+        stream.pulse(more ? interval - PULSE_INJECT_WIDTH_US : MIN_LOW_US);
+    }
+    stream.finish();
+    step.aborted = stopRequested;
+    step.trueEvents = pattern.trueEvents();
+    step.injected = pattern.pulses();
+    if (step.aborted) {
+        // Whatever the driver had queued was sent; the counts of a cut-short train are not compared
+        return;
+    }
+
+    step.measured = settledCounts() - startCounts;
+    step.background = report.backgroundCps * (millis() - startMs) / 1000.0f;
+    float excess = (float)step.measured - step.injected - step.background;
+    step.countsOk = fabsf(excess) <= 3.0f * sqrtf(step.background) + 0.5f;
+
+    step.rateOk = true;
+    if (plan.type == PULSE_PATTERN_POISSON && step.trueEvents > 0) {
+        // The pipeline's own dead-time model, over the train
+        float measuredCps = ((float)step.measured - step.background) / stepSeconds;
+        step.corrected = correctDeadTimeCps(measuredCps, report.deadTimeUs * 1e-6f) * stepSeconds;
+        float tolerance = 3.0f / sqrtf((float)step.trueEvents);
+        if (tolerance < PULSE_INJECT_RATE_TOLERANCE) tolerance = PULSE_INJECT_RATE_TOLERANCE;
+        step.rateOk = fabsf(step.corrected / step.trueEvents - 1.0f) <= tolerance;
+    }
+}
+
+/**
+ * @brief Injector task: the background, then every planned step.
+ * @param parameter The single step to run, or nullptr for the acceptance plan
+ */
+static void pulseInjectTask(void* parameter) {
+    const PulsePatternParams* single = (const PulsePatternParams*)parameter;
+    size_t blockBytes = BLOCK_ITEMS * sizeof(rmt_item32_t);
+    for (uint8_t b = 0; b < 2; b++) {
+        blocks[b] = (rmt_item32_t*)heap_caps_malloc(blockBytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    }
+
+    if (blocks[0] && blocks[1]) {
+        postInjecting(true);
+        uint32_t startCounts = settledCounts();
+        vTaskDelay(pdMS_TO_TICKS(BACKGROUND_MS));
+        uint32_t counts, seconds;
+        injectCounts(&counts, &seconds);
+        report.backgroundCps = (counts - startCounts) * 1000.0f / BACKGROUND_MS;
+        reportLock.publish(report);
+
+        for (uint8_t i = 0; i < report.steps && !stopRequested; i++) {
+            runStep(single ? *single : BENCH_PLAN[i], single ? report.results[0].seconds : PULSE_INJECT_STEP_S,
+                    report.results[i]);
+            report.count = i + 1;
+            reportLock.publish(report);
+        }
+        postInjecting(false);
+    } else {
+        DEBUG_PRINTLN("Pulse injector: no memory for the RMT blocks");
+    }
+
+    for (uint8_t b = 0; b < 2; b++) {
+        heap_caps_free(blocks[b]);
+        blocks[b] = nullptr;
+    }
+    delete single;
+    report.running = false;
+    reportLock.publish(report);
+    injectRunning = false;
+    DEBUG_PRINTLN("Pulse injector: done (\"inject\" prints the report)");
+    vTaskDelete(NULL);
+}
+
+/**
+ * @brief Resets the report and starts the task; @p single is owned by the task.
+ */
+static bool startRun(PulsePatternParams* single, uint32_t seconds) {
+    if (!injectorReady || injectRunning) {
+        delete single;
+        return false;
+    }
+    injectRunning = true;
+    stopRequested = false;
+    memset(&report, 0, sizeof(report));
+    report.running = true;
+    report.bench = single == nullptr;
+    report.steps = single ? 1 : BENCH_STEPS;
+    report.deadTimeUs = getDeviceConfig().deadTimeUs;
+    report.results[0].seconds = seconds;
+    reportLock.publish(report);
+
+    // Core 0, below the network tasks: it only sleeps in the RMT driver and the settle waits
+    if (xTaskCreatePinnedToCore(pulseInjectTask, "PulseInject", 3072, single, tskIDLE_PRIORITY + 1, NULL, 0) !=
+        pdPASS) {
+        delete single;
+        report.running = false;
+        reportLock.publish(report);
+        injectRunning = false;
+        return false;
+    }
+    return true;
+}
+
+bool pulseInjectStart(const PulsePatternParams& params, uint32_t seconds) {
+    if (seconds == 0 || params.rate <= 0.0f) return false;
+    if (params.type == PULSE_PATTERN_BURST && (params.spacingUs < PULSE_INJECT_WIDTH_US + MIN_LOW_US ||
+                                               params.periodMs * 1000.0f < params.rate * params.spacingUs)) {
+        return false;
+    }
+    return startRun(new PulsePatternParams(params), seconds);
+}
+
+bool pulseInjectStartBench() {
+    return startRun(nullptr, PULSE_INJECT_STEP_S);
+}
+
+void pulseInjectSetStartHook(PulseInjectStartHook hook) {
+    startHook = hook;
+}
+
+void pulseInjectStop() {
+    if (injectRunning) stopRequested = true;
+}
+
+bool pulseInjectRunning() {
+    return injectRunning;
+}
+
+PulseInjectReport getPulseInjectReport() {
+    PulseInjectReport copy;
+    memset(&copy, 0, sizeof(copy));
+    reportLock.read(copy);
+    return copy;
+}
+
+static void printPattern(Print& out, const PulsePatternParams& params) {
+    char text[32];
+    switch (params.type) {
+        case PULSE_PATTERN_POISSON:
+            snprintf(text, sizeof(text), "poisson %.0f CPM", params.rate);
+            break;
+        case PULSE_PATTERN_BURST:
+            snprintf(text, sizeof(text), "burst %.0fx%luus/%lums", params.rate, (unsigned long)params.spacingUs,
+                     (unsigned long)params.periodMs);
+            break;
+        default:
+            snprintf(text, sizeof(text), "fixed %.0f Hz", params.rate);
+            break;
+    }
+    out.printf("  %-26s", text);
+}
+
+void printPulseInjector(Print& out) {
+    if (!injectorReady) {
+        out.println("Pulse injector: not available (PULSE_INJECT_PIN)");
+        return;
+    }
+    static PulseInjectReport snapshot; // Several hundred bytes, kept off the uiTask stack
+    snapshot = getPulseInjectReport();
+    out.printf("Pulse injector: GPIO %d -> GPIO %d, %d us pulses, %s\n", PULSE_INJECT_PIN, loopbackPin,
+               PULSE_INJECT_WIDTH_US, snapshot.running ? "running" : "idle");
+    if (snapshot.steps == 0) return;
+    out.printf("  %s, dead time %.1f us, background %.3f cps, %u of %u steps\n",
+               snapshot.bench ? "acceptance plan" : "single run", snapshot.deadTimeUs, snapshot.backgroundCps,
+               snapshot.count, snapshot.steps);
+    out.println("  pattern                       s       true   injected   measured  corrected  counts rate");
+
+    uint8_t passed = 0;
+    for (uint8_t i = 0; i < snapshot.count; i++) {
+        const PulseInjectStep& step = snapshot.results[i];
+        printPattern(out, step.params);
+        if (step.aborted) {
+            out.printf(" %4lu %10lu %10lu    aborted\n", (unsigned long)step.seconds, (unsigned long)step.trueEvents,
+                       (unsigned long)step.injected);
+            continue;
+        }
+        out.printf(" %4lu %10lu %10lu %10lu ", (unsigned long)step.seconds, (unsigned long)step.trueEvents,
+                   (unsigned long)step.injected, (unsigned long)step.measured);
+        if (step.params.type == PULSE_PATTERN_POISSON) {
+            out.printf("%10.0f ", step.corrected);
+        } else {
+            out.print("         - ");
+        }
+        out.printf(" %-6s %s\n", step.countsOk ? "ok" : "FAIL",
+                   step.params.type != PULSE_PATTERN_POISSON ? "-" : step.rateOk ? "ok" : "FAIL");
+        if (step.countsOk && step.rateOk) passed++;
+    }
+    if (!snapshot.running) {
+        out.printf("  Result: %s (%u of %u steps passed)\n",
+                   passed == snapshot.steps && snapshot.count == snapshot.steps ? "PASS" : "FAIL", passed,
+                   snapshot.steps);
+    }
+}
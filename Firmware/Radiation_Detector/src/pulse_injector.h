@@ -0,0 +1,82 @@
+#ifndef PULSE_INJECTOR_H
+#define PULSE_INJECTOR_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "pulse_pattern.h"
+
+// Hardware-in-the-loop pulse injector ("inject").
+// An RMT transmit channel drives PULSE_INJECT_PIN with pulse trains from
+// pulse_pattern.h, PULSE_INJECT_WIDTH_US wide at 1 us resolution. The pin is
+// wired to the Geiger input, so the injected pulses go through the whole
+// counting path: PCNT and its filter, the sampling task, pulseTask, the rate
+// pipeline. Disconnect the tube or switch its HV off first; a background
+// that remains is measured before the run and allowed for.
+//
+// Each step injects a known number of pulses, waits PULSE_INJECT_SETTLE_MS
+// for the last second to close, and compares the counts the pipeline
+// registered with the pulses sent: they must agree exactly (less the
+// background). Poisson steps emulate the tube dead time of the device
+// configuration, and the registered counts corrected with the pipeline's
+// dead-time model must come back to the true arrivals within
+// PULSE_INJECT_RATE_TOLERANCE, or three standard deviations if wider.
+// "inject bench" runs the release acceptance plan: fixed frequencies up to
+// 25 kHz, Poisson rates from 60 CPM to 1.2M CPM and a burst pattern.
+//
+// While a run is active pulseTask keeps the injected counts out of the
+// cumulative dose and flags the history log records (LOG_FLAG_INJECTED). The
+// rate display and the alarms do follow them, which is part of the test.
+
+// Counts since boot and the number of closed 1-second buckets behind them.
+typedef void (*PulseInjectCounts)(uint32_t* counts, uint32_t* seconds);
+
+struct PulseInjectStep {
+    PulsePatternParams params;
+    uint32_t seconds;        ///< Train length
+    uint32_t seed;
+    uint32_t trueEvents;     ///< Arrivals before the emulated dead time
+    uint32_t injected;       ///< Pulses sent
+    uint32_t measured;       ///< Counts registered in the step, background included
+    float background;        ///< Expected background counts in the step
+    float corrected;         ///< Dead-time corrected counts (poisson)
+    bool countsOk;
+    bool rateOk;             ///< Always true but for poisson steps
+    bool aborted;
+};
+
+struct PulseInjectReport {
+    bool running;
+    bool bench;              ///< The acceptance plan, not a single step
+    uint8_t steps;           ///< Planned
+    uint8_t count;           ///< Finished
+    float deadTimeUs;        ///< Emulated and corrected for
+    float backgroundCps;
+    PulseInjectStep results[PULSE_INJECT_MAX_STEPS];
+};
+
+// Sets up the RMT channel on PULSE_INJECT_PIN. Call once in setup().
+// @return false without a pin or if it is the Geiger input itself
+bool initPulseInjector(uint8_t geigerPin, PulseInjectCounts counts);
+
+// Runs one pattern for @p seconds on a task of its own. Any task.
+bool pulseInjectStart(const PulsePatternParams& params, uint32_t seconds);
+
+// Runs the acceptance plan. Any task.
+bool pulseInjectStartBench();
+
+// Called on the injector task as each train starts, with the esp_timer time
+// (low 32 bits) its first rising edge is due. One hook: latency_probe.h.
+typedef void (*PulseInjectStartHook)(uint32_t firstPulseUs);
+void pulseInjectSetStartHook(PulseInjectStartHook hook);
+
+// Ends the run after the current RMT block; the step is marked aborted.
+void pulseInjectStop();
+
+bool pulseInjectRunning();
+
+PulseInjectReport getPulseInjectReport();
+
+// Setup, the current run and the report with a PASS / FAIL verdict.
+void printPulseInjector(Print& out);
+
+#endif // PULSE_INJECTOR_H
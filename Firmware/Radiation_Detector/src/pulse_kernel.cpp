@@ -0,0 +1,79 @@
+/**
+ * @file pulse_kernel.cpp
+ * @brief Chunk max/sum kernel: ESP32-S3 PIE vector version and scalar fallback.
+ *
+ * Samples are 12-bit, so they are processed as signed 16-bit lanes without
+ * loss. The PIE version handles a 16-sample chunk with two 128-bit loads, one
+ * vector max and two multiply-accumulates against a vector of ones into the
+ * 40-bit ACCX accumulator. Each asm block sets up every q register it uses,
+ * so nothing relies on vector state surviving a context switch.
+ */
+
+#include "pulse_kernel.h"
+
+void pulseKernelSummarizeScalar(const uint16_t* samples, size_t chunks, int16_t* chunkMax, int32_t* chunkSum) {
+    for (size_t c = 0; c < chunks; c++) {
+        const uint16_t* s = samples + c * PULSE_KERNEL_CHUNK;
+        int16_t max = (int16_t)s[0];
+        int32_t sum = 0;
+        for (size_t i = 0; i < PULSE_KERNEL_CHUNK; i++) {
+            int16_t v = (int16_t)s[i];
+            if (v > max) max = v;
+            sum += v;
+        }
+        chunkMax[c] = max;
+        chunkSum[c] = sum;
+    }
+}
+
+#if PULSE_KERNEL_PIE
+
+static const int16_t kOnes[8] __attribute__((aligned(16))) = {1, 1, 1, 1, 1, 1, 1, 1};
+
+void pulseKernelSummarize(const uint16_t* samples, size_t chunks, int16_t* chunkMax, int32_t* chunkSum) {
+    int16_t lanes[8] __attribute__((aligned(16)));
+    const uint16_t* p = samples;
+    for (size_t c = 0; c < chunks; c++) {
+        int32_t sum;
+        const int16_t* ones = kOnes;
+        int16_t* laneOut = lanes;
+        __asm__ __volatile__(
+            "ee.zero.accx\n"
+            "ee.vld.128.ip q3, %[ones], 0\n"
+            "ee.vld.128.ip q0, %[p], 16\n"
+            "ee.vld.128.ip q1, %[p], 16\n"
+            "ee.vmax.s16 q2, q0, q1\n"
+            "ee.vmulas.s16.accx q0, q3\n"
+            "ee.vmulas.s16.accx q1, q3\n"
+            "ee.vst.128.ip q2, %[lanes], 0\n"
+            "movi.n %[sum], 0\n"
+            "ee.srs.accx %[sum], %[sum], 0\n"
+            : [p] "+r"(p), [sum] "=&r"(sum), [ones] "+r"(ones), [lanes] "+r"(laneOut)
+            :
+            : "memory");
+
+        // Horizontal max of the 8 lane maxima
+        int16_t max = lanes[0];
+        for (int i = 1; i < 8; i++) {
+            if (lanes[i] > max) max = lanes[i];
+        }
+        chunkMax[c] = max;
+        chunkSum[c] = sum;
+    }
+}
+
+bool pulseKernelVectorized() {
+    return true;
+}
+
+#else
+
+void pulseKernelSummarize(const uint16_t* samples, size_t chunks, int16_t* chunkMax, int32_t* chunkSum) {
+    pulseKernelSummarizeScalar(samples, chunks, chunkMax, chunkSum);
+}
+
+bool pulseKernelVectorized() {
+    return false;
+}
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef PULSE_KERNEL_H
+#define PULSE_KERNEL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef ARDUINO
+#include "sdkconfig.h"
+#endif
+
+// Block screening kernel for the pulse-height detector.
+// For every chunk of PULSE_KERNEL_CHUNK samples it computes the maximum and the
+// sum. The detector uses them to skip chunks that are pure baseline (max below
+// the trigger level) in one step, and only walks sample by sample through chunks
+// that contain a pulse.
+//
+// On the ESP32-S3 the kernel runs on the PIE 128-bit vector unit (8 x int16 per
+// instruction); elsewhere, or with PULSE_KERNEL_PIE=0, a scalar loop is used.
+
+#define PULSE_KERNEL_CHUNK 16
+
+#ifndef PULSE_KERNEL_PIE
+#if defined(CONFIG_IDF_TARGET_ESP32S3)
+#define PULSE_KERNEL_PIE 1
+#else
+#define PULSE_KERNEL_PIE 0
+#endif
+#endif
+
+// Summarises @p chunks chunks. @p samples must be 16-byte aligned (vector loads).
+void pulseKernelSummarize(const uint16_t* samples, size_t chunks, int16_t* chunkMax, int32_t* chunkSum);
+
+// Portable reference implementation (also used for the benchmark).
+void pulseKernelSummarizeScalar(const uint16_t* samples, size_t chunks, int16_t* chunkMax, int32_t* chunkSum);
+
+// True when pulseKernelSummarize() uses the vector unit.
+bool pulseKernelVectorized();
+
+#endif // PULSE_KERNEL_H
@@ -0,0 +1,142 @@
+#ifndef PULSE_PATTERN_H
+#define PULSE_PATTERN_H
+
+#include <math.h>
+#include <stdint.h>
+
+// Pulse trains for the pulse injector (pulse_injector.h), as the intervals
+// between the rising edges of consecutive pulses, in whole microseconds.
+//   fixed    a constant frequency
+//   poisson  random arrivals at a true rate, thinned by a non-paralyzable dead
+//            time as a GM tube would register them; trueEvents() counts the
+//            arrivals, so the dead-time correction can be checked against them
+//   burst    groups of pulses at a short spacing, repeated every period
+// No interval is shorter than the minimum given to begin(), which keeps the
+// pulses apart at the output (width plus a low gap); a poisson dead time
+// below it is raised to it. Positions are kept in fractional microseconds and
+// rounded once, so the rate has no rounding drift. A train ends at the given
+// duration; arrivals after it are not counted. The random source is a
+// seeded xorshift32: the same seed gives the same train on any target.
+// No Arduino dependencies (host-compilable).
+
+enum PulsePatternType {
+    PULSE_PATTERN_FIXED = 0,
+    PULSE_PATTERN_POISSON,
+    PULSE_PATTERN_BURST
+};
+
+struct PulsePatternParams {
+    uint8_t type;             ///< PulsePatternType
+    float rate;               ///< fixed: Hz; poisson: true CPM; burst: pulses per group
+    float deadTimeUs;         ///< poisson: emulated tube dead time
+    uint32_t spacingUs;       ///< burst: edge to edge within a group
+    uint32_t periodMs;        ///< burst: group start to group start
+};
+
+class PulsePattern {
+public:
+    PulsePattern()
+        : minIntervalUs_(1), endUs_(0.0), positionUs_(0.0), lastUs_(0), lastRegisteredUs_(-1e18), inGroup_(0),
+          state_(1), trueEvents_(0), pulses_(0) {
+        params_.type = PULSE_PATTERN_FIXED;
+        params_.rate = 1.0f;
+        params_.deadTimeUs = 0.0f;
+        params_.spacingUs = 0;
+        params_.periodMs = 0;
+    }
+
+    void begin(const PulsePatternParams& params, uint32_t minIntervalUs, uint64_t durationUs, uint32_t seed) {
+        params_ = params;
+        minIntervalUs_ = minIntervalUs ? minIntervalUs : 1;
+        endUs_ = (double)durationUs;
+        positionUs_ = 0.0;
+        lastUs_ = 0;
+        lastRegisteredUs_ = -1e18;
+        inGroup_ = 0;
+        state_ = seed ? seed : 1;
+        trueEvents_ = 0;
+        pulses_ = 0;
+    }
+
+    /**
+     * @brief Time of the next pulse after the previous one (the first: after
+     *        the start), >= the minimum interval except for the first.
+     * @return false at the end of the train
+     */
+    bool next(uint32_t* intervalUs) {
+        double at = positionUs_;
+        switch (params_.type) {
+            case PULSE_PATTERN_POISSON: {
+                double deadUs = params_.deadTimeUs > minIntervalUs_ ? params_.deadTimeUs : minIntervalUs_;
+                double meanUs = 60e6 / params_.rate;
+                do {
+                    at += -meanUs * log(uniform());
+                    if (at > endUs_) return false;
+                    trueEvents_++;
+                } while (at - lastRegisteredUs_ < deadUs);
+                lastRegisteredUs_ = at;
+                break;
+            }
+            case PULSE_PATTERN_BURST: {
+                uint32_t groupPulses = params_.rate >= 1.0f ? (uint32_t)params_.rate : 1;
+                if (pulses_ == 0) {
+                    at = 0.0;
+                } else if (inGroup_ < groupPulses) {
+                    at += params_.spacingUs;
+                } else {
+                    // Start of the next group, from the start of this one
+                    at += params_.periodMs * 1000.0 - (double)(groupPulses - 1) * params_.spacingUs;
+                    inGroup_ = 0;
+                }
+                if (at > endUs_) return false;
+                inGroup_++;
+                trueEvents_++;
+                break;
+            }
+            default:
+                at += 1e6 / params_.rate;
+                if (at > endUs_) return false;
+                trueEvents_++;
+                break;
+        }
+        positionUs_ = at;
+        uint64_t roundedUs = (uint64_t)(at + 0.5);
+        uint64_t interval = roundedUs - lastUs_;
+        if (pulses_ > 0 && interval < minIntervalUs_) {
+            interval = minIntervalUs_;
+            roundedUs = lastUs_ + interval;
+        }
+        lastUs_ = roundedUs;
+        pulses_++;
+        *intervalUs = interval > UINT32_MAX ? UINT32_MAX : (uint32_t)interval;
+        return true;
+    }
+
+    /// Arrivals before the dead time (poisson), else the same as pulses().
+    uint32_t trueEvents() const { return trueEvents_; }
+    uint32_t pulses() const { return pulses_; }
+    /// Rising edge of the last pulse from the start.
+    uint64_t lastUs() const { return lastUs_; }
+
+private:
+    /// Uniform in (0, 1]: never 0, so the log is finite.
+    double uniform() {
+        state_ ^= state_ << 13;
+        state_ ^= state_ >> 17;
+        state_ ^= state_ << 5;
+        return (state_ + 1.0) / 4294967296.0;
+    }
+
+    PulsePatternParams params_;
+    uint32_t minIntervalUs_;
+    double endUs_;
+    double positionUs_;
+    uint64_t lastUs_;
+    double lastRegisteredUs_;
+    uint32_t inGroup_;
+    uint32_t state_;
+    uint32_t trueEvents_;
+    uint32_t pulses_;
+};
+
+#endif // PULSE_PATTERN_H
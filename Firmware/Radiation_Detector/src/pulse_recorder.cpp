@@ -0,0 +1,552 @@
+/**
+ * @file pulse_recorder.cpp
+ * @brief Pulse trace recording from pulseTask and replay on a task of its own.
+ *
+ * pulseTask owns the open chunk and the encoder; the writer task owns the file
+ * while recording. They trade chunk indices through two queues: free chunks to
+ * pulseTask, filled ones (with their length) to the writer. The UI task only
+ * opens the file and flips the state; every transition of the recording itself
+ * happens on pulseTask in pulseRecorderPoll(), between passes.
+ *
+ * Armed, pulseTask keeps its filled chunks in a ring instead and returns the
+ * oldest to the pool. A trigger names the file, and the first message to the
+ * writer carries no chunk but the open flag: the writer creates the file and
+ * writes the header of the oldest ring chunk, so pulseTask never touches the
+ * card. The ring chunks follow oldest first, then the recording goes on as
+ * usual until ANOMALY_POST_S after the last trigger.
+ */
+
+#include "pulse_recorder.h"
+#include "pulse_replay.h"
+#include "history_log.h"
+#include "debug.h"
+#include <atomic>
+#include <FS.h>
+#include <LittleFS.h>
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+
+enum RecorderState {
+    RECORDER_IDLE = 0,
+    RECORDER_STARTING,   ///< File open, pulseTask writes the header next pass
+    RECORDER_RECORDING,
+    RECORDER_STOPPING,   ///< pulseTask hands over the last chunk next pass
+    RECORDER_CLOSING,    ///< The writer closes the file after the last chunk
+    RECORDER_ARMED       ///< pulseTask fills the pre-trigger ring, no file open
+};
+
+struct ChunkMessage {
+    int16_t index;       ///< -1: none (open or end only)
+    uint16_t length;
+    bool end;            ///< Close the file after this chunk
+    bool open;           ///< Create traceName and write eventHeader first
+};
+
+// The recording itself needs chunks while the ring is handed over
+static_assert(ANOMALY_PRE_CHUNKS >= 2 && ANOMALY_PRE_CHUNKS <= PULSE_TRACE_CHUNKS - 2,
+              "ANOMALY_PRE_CHUNKS must leave two chunks of the pool to the recording");
+
+static const size_t REPLAY_BUFFER_BYTES = 16384;
+
+static PulseTraceStateSource stateSource = nullptr;
+static fs::FS* traceFs = nullptr;
+static bool onSd = false;
+static uint8_t* chunkPool = nullptr;
+static QueueHandle_t freeChunks = nullptr;
+static QueueHandle_t fullChunks = nullptr;
+// IDLE -> STARTING (UI task) and IDLE -> ARMED (pulseTask) race: both compare-and-swap
+static std::atomic<uint8_t> recorderState(RECORDER_IDLE);
+static File traceFile;                   ///< Opened by the UI task or the writer, then the writer's
+static char traceName[24] = "";
+static volatile bool armRequested = false; ///< Set by the UI task, followed by pulseTask
+static PulseTraceHeader eventHeader;     ///< Written by pulseTask before the open message
+
+// pulseTask side
+static PulseTraceWriter writer;
+static int16_t openChunk = -1;
+static size_t openChunkHeader = 0;       ///< Header bytes ahead of the events (first chunk)
+static uint32_t openChunkMs = 0;
+static uint32_t pendingDropped = 0;      ///< Events skipped since the last sync
+static int16_t ringChunks[ANOMALY_PRE_CHUNKS]; ///< Filled pre-trigger chunks, oldest first
+static uint16_t ringLengths[ANOMALY_PRE_CHUNKS];
+static uint8_t ringCount = 0;
+static PulseTraceHeader chunkHeaders[PULSE_TRACE_CHUNKS]; ///< Pipeline state at the start of each armed chunk
+static bool eventRecording = false;      ///< The recording was triggered and stops by itself
+static uint32_t stopAtMs = 0;
+
+// Rotating at this age keeps at least ANOMALY_PRE_S in the ring's filled chunks
+static const uint32_t RING_ROTATE_MS = ANOMALY_PRE_S * 1000UL / (ANOMALY_PRE_CHUNKS - 1);
+
+// Statistics (read by the UI task)
+static uint32_t recordedEvents = 0;
+static uint32_t droppedEvents = 0;
+static uint32_t writtenBytes = 0;
+static uint32_t writtenChunks = 0;
+static uint32_t writeErrors = 0;
+static uint32_t eventCaptures = 0;
+
+struct ReplayResult {
+    char name[24];
+    float speed;
+    bool valid;           ///< The file had a trace header
+    uint32_t seconds;
+    uint32_t samples;
+    uint32_t pulses;
+    uint32_t dropped;
+    uint32_t checksum;
+    uint8_t maxAlarmLevel;
+    uint32_t elapsedUs;
+};
+static volatile bool replayRunning = false;
+static ReplayResult replayResult;        ///< Replay task while it runs, then the UI task's
+
+static void storageBegin() {
+    if (onSd) sdCardBegin();
+}
+
+static void storageEnd() {
+    if (onSd) sdCardEnd();
+}
+
+static String tracePath(const char* name) {
+    return String(PULSE_TRACE_DIR) + "/" + name + ".rpt";
+}
+
+static bool validName(const char* name) {
+    size_t length = strlen(name);
+    if (length == 0 || length > 20) return false;
+    for (size_t i = 0; i < length; i++) {
+        char c = name[i];
+        if (!isalnum((unsigned char)c) && c != '-' && c != '_') return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Appends the filled chunks to the file and closes it at the end.
+ */
+static void traceWriterTask(void* parameter) {
+    ChunkMessage message;
+    while (true) {
+        if (xQueueReceive(fullChunks, &message, portMAX_DELAY) != pdTRUE) continue;
+        if (message.open) {
+            storageBegin();
+            traceFile = traceFs->open(tracePath(traceName), FILE_WRITE);
+            size_t written = traceFile ? traceFile.write((const uint8_t*)&eventHeader, sizeof(eventHeader)) : 0;
+            storageEnd();
+            writtenBytes += written;
+            if (written != sizeof(eventHeader)) writeErrors++;
+            DEBUG_PRINTF("Pulse trace %s opened for an event\n", traceName);
+        }
+        if (message.index >= 0) {
+            storageBegin();
+            size_t written = traceFile.write(chunkPool + message.index * PULSE_TRACE_CHUNK_BYTES, message.length);
+            traceFile.flush();
+            storageEnd();
+            writtenBytes += written;
+            writtenChunks++;
+            if (written != message.length) writeErrors++;
+            xQueueSend(freeChunks, &message.index, 0);
+        }
+        if (message.end) {
+            storageBegin();
+            traceFile.close();
+            storageEnd();
+            DEBUG_PRINTF("Pulse trace %s closed, %lu bytes\n", traceName, (unsigned long)writtenBytes);
+            recorderState = RECORDER_IDLE;
+        }
+    }
+}
+
+bool initPulseRecorder(PulseTraceStateSource source) {
+    stateSource = source;
+    onSd = sdCardMounted();
+    if (onSd) {
+        traceFs = &sdCardFs();
+    } else if (LittleFS.begin(true)) {
+        traceFs = &LittleFS;
+    } else {
+        DEBUG_PRINTLN("Pulse trace: no storage");
+        return false;
+    }
+
+    size_t poolBytes = PULSE_TRACE_CHUNKS * PULSE_TRACE_CHUNK_BYTES;
+    chunkPool = (uint8_t*)heap_caps_malloc(poolBytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!chunkPool) chunkPool = (uint8_t*)heap_caps_malloc(poolBytes, MALLOC_CAP_8BIT);
+    freeChunks = xQueueCreate(PULSE_TRACE_CHUNKS, sizeof(int16_t));
+    fullChunks = xQueueCreate(PULSE_TRACE_CHUNKS + 2, sizeof(ChunkMessage)); // + the open and end messages
+    if (!chunkPool || !freeChunks || !fullChunks) return false;
+    for (int16_t i = 0; i < PULSE_TRACE_CHUNKS; i++) xQueueSend(freeChunks, &i, 0);
+
+    storageBegin();
+    if (!traceFs->exists(PULSE_TRACE_DIR)) traceFs->mkdir(PULSE_TRACE_DIR);
+    storageEnd();
+
+    return xTaskCreatePinnedToCore(traceWriterTask, "TraceWrite", 3072, NULL, NETWORK_TASK_PRIORITY, NULL,
+                                   TASK_CORE_NETWORK) == pdPASS;
+}
+
+bool pulseRecorderStart(const char* name) {
+    if (!traceFs || recorderState != RECORDER_IDLE || armRequested || !validName(name)) return false;
+    storageBegin();
+    traceFile = traceFs->open(tracePath(name), FILE_WRITE);
+    storageEnd();
+    if (!traceFile) return false;
+
+    strncpy(traceName, name, sizeof(traceName) - 1);
+    recordedEvents = droppedEvents = writtenBytes = writtenChunks = writeErrors = 0;
+    uint8_t expected = RECORDER_IDLE;
+    if (!recorderState.compare_exchange_strong(expected, RECORDER_STARTING)) {
+        // Armed by pulseTask in the meantime
+        storageBegin();
+        traceFile.close();
+        storageEnd();
+        return false;
+    }
+    return true;
+}
+
+void pulseRecorderStop() {
+    if (recorderState == RECORDER_RECORDING || recorderState == RECORDER_STARTING) {
+        recorderState = RECORDER_STOPPING;
+    }
+}
+
+/**
+ * @brief Takes a free chunk and starts it with @p headerBytes of @p header and a sync.
+ */
+static bool takeChunk(uint32_t nowMs, const PulseTraceHeader* header) {
+    int16_t index;
+    if (xQueueReceive(freeChunks, &index, 0) != pdTRUE) return false;
+    uint8_t* chunk = chunkPool + index * PULSE_TRACE_CHUNK_BYTES;
+    openChunkHeader = header ? sizeof(*header) : 0;
+    if (header) memcpy(chunk, header, sizeof(*header));
+    writer.begin(chunk + openChunkHeader, PULSE_TRACE_CHUNK_BYTES - openChunkHeader);
+    writer.sync(pendingDropped);
+    pendingDropped = 0;
+    openChunk = index;
+    openChunkMs = nowMs;
+    return true;
+}
+
+static void handOver(bool end) {
+    ChunkMessage message = {openChunk, (uint16_t)(openChunk >= 0 ? openChunkHeader + writer.length() : 0), end,
+                            false};
+    xQueueSend(fullChunks, &message, 0); // Sized for every chunk and the open and end messages
+    openChunk = -1;
+}
+
+/**
+ * @brief Armed: takes a chunk and notes the pipeline state its events start from.
+ */
+static bool takeRingChunk(uint32_t nowMs) {
+    if (!takeChunk(nowMs, nullptr)) return false;
+    PulseTraceHeader& header = chunkHeaders[openChunk];
+    memset(&header, 0, sizeof(header));
+    if (stateSource) stateSource(header);
+    header.magic = PULSE_TRACE_MAGIC;
+    header.version = PULSE_TRACE_VERSION;
+    header.headerBytes = sizeof(header);
+    return true;
+}
+
+/**
+ * @brief Armed: moves the open chunk into the ring, dropping the oldest one
+ *        the ring has no room for, and starts the next.
+ */
+static bool rotateRing(uint32_t nowMs) {
+    if (openChunk >= 0) {
+        if (ringCount == ANOMALY_PRE_CHUNKS - 1) {
+            xQueueSend(freeChunks, &ringChunks[0], 0);
+            memmove(ringChunks, ringChunks + 1, (ringCount - 1) * sizeof(ringChunks[0]));
+            memmove(ringLengths, ringLengths + 1, (ringCount - 1) * sizeof(ringLengths[0]));
+            ringCount--;
+        }
+        ringChunks[ringCount] = openChunk;
+        ringLengths[ringCount] = (uint16_t)writer.length();
+        ringCount++;
+        openChunk = -1;
+    }
+    return takeRingChunk(nowMs);
+}
+
+/**
+ * @brief Armed: returns the ring and the open chunk to the pool.
+ */
+static void releaseRing() {
+    for (uint8_t i = 0; i < ringCount; i++) xQueueSend(freeChunks, &ringChunks[i], 0);
+    ringCount = 0;
+    if (openChunk >= 0) xQueueSend(freeChunks, &openChunk, 0);
+    openChunk = -1;
+}
+
+/**
+ * @brief The open chunk, or a new one once it is full. false while none is free.
+ */
+static bool ensureRoom(uint32_t nowMs) {
+    if (openChunk >= 0 && writer.hasRoom()) return true;
+    if (recorderState == RECORDER_ARMED) return rotateRing(nowMs);
+    if (openChunk >= 0) handOver(false);
+    return takeChunk(nowMs, nullptr);
+}
+
+void pulseRecorderArm(bool armed) {
+    armRequested = armed && traceFs;
+}
+
+bool pulseRecorderArmed() {
+    return armRequested;
+}
+
+bool pulseRecorderTrigger(uint32_t nowMs, const char* name) {
+    if (recorderState != RECORDER_ARMED || !validName(name)) return false;
+
+    strncpy(traceName, name, sizeof(traceName) - 1);
+    traceName[sizeof(traceName) - 1] = '\0';
+    // The file starts where its oldest events do
+    int16_t first = ringCount ? ringChunks[0] : openChunk;
+    if (first >= 0) {
+        eventHeader = chunkHeaders[first];
+    } else {
+        memset(&eventHeader, 0, sizeof(eventHeader));
+        if (stateSource) stateSource(eventHeader);
+        eventHeader.magic = PULSE_TRACE_MAGIC;
+        eventHeader.version = PULSE_TRACE_VERSION;
+        eventHeader.headerBytes = sizeof(eventHeader);
+    }
+    recordedEvents = droppedEvents = writtenBytes = writtenChunks = writeErrors = 0;
+    ChunkMessage open = {-1, 0, false, true};
+    xQueueSend(fullChunks, &open, 0);
+    for (uint8_t i = 0; i < ringCount; i++) {
+        ChunkMessage message = {ringChunks[i], ringLengths[i], false, false};
+        xQueueSend(fullChunks, &message, 0);
+    }
+    ringCount = 0;
+    eventRecording = true;
+    stopAtMs = nowMs + ANOMALY_POST_S * 1000UL;
+    eventCaptures++;
+    // The open chunk carries on as the recording's first live chunk
+    recorderState = RECORDER_RECORDING;
+    return true;
+}
+
+void pulseRecorderExtend(uint32_t nowMs) {
+    if (recorderState == RECORDER_RECORDING && eventRecording) stopAtMs = nowMs + ANOMALY_POST_S * 1000UL;
+}
+
+void pulseRecorderPoll(uint32_t nowMs) {
+    switch (recorderState) {
+        case RECORDER_IDLE: {
+            uint8_t expected = RECORDER_IDLE;
+            if (armRequested && recorderState.compare_exchange_strong(expected, RECORDER_ARMED)) {
+                pendingDropped = 0;
+                takeRingChunk(nowMs);
+            }
+            break;
+        }
+        case RECORDER_ARMED:
+            if (!armRequested) {
+                releaseRing();
+                recorderState = RECORDER_IDLE;
+            } else if (openChunk < 0 || nowMs - openChunkMs >= RING_ROTATE_MS) {
+                rotateRing(nowMs);
+            }
+            break;
+        case RECORDER_STARTING: {
+            PulseTraceHeader header;
+            memset(&header, 0, sizeof(header));
+            if (stateSource) stateSource(header);
+            header.magic = PULSE_TRACE_MAGIC;
+            header.version = PULSE_TRACE_VERSION;
+            header.headerBytes = sizeof(header);
+            pendingDropped = 0;
+            if (takeChunk(nowMs, &header)) recorderState = RECORDER_RECORDING;
+            break;
+        }
+        case RECORDER_RECORDING:
+            // An aged chunk goes to the card even if it is far from full
+            if (openChunk >= 0 && nowMs - openChunkMs >= PULSE_TRACE_FLUSH_MS) handOver(false);
+            if (eventRecording && (int32_t)(nowMs - stopAtMs) >= 0) recorderState = RECORDER_STOPPING;
+            break;
+        case RECORDER_STOPPING:
+            eventRecording = false;
+            if (ensureRoom(nowMs)) writer.end();
+            handOver(true);
+            recorderState = RECORDER_CLOSING;
+            break;
+        default:
+            break;
+    }
+}
+
+void pulseRecorderSample(uint32_t ms, uint32_t count) {
+    uint8_t state = recorderState;
+    if (state != RECORDER_RECORDING && state != RECORDER_ARMED) return;
+    if (!ensureRoom(ms)) {
+        writer.skipSample(ms, count);
+        pendingDropped++;
+        droppedEvents++;
+        return;
+    }
+    writer.sample(ms, count);
+    recordedEvents++;
+}
+
+void pulseRecorderPulse(uint32_t us) {
+    uint8_t state = recorderState;
+    if (state != RECORDER_RECORDING && state != RECORDER_ARMED) return;
+    if (!ensureRoom(openChunkMs)) {
+        writer.skipPulse(us);
+        pendingDropped++;
+        droppedEvents++;
+        return;
+    }
+    writer.pulse(us);
+    recordedEvents++;
+}
+
+/**
+ * @brief Reads the trace in REPLAY_BUFFER_BYTES pieces and feeds it through a PulseReplay.
+ */
+static void pulseReplayTask(void* parameter) {
+    ReplayResult& result = replayResult;
+    uint8_t* buffer = (uint8_t*)heap_caps_malloc(REPLAY_BUFFER_BYTES, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    PulseReplay* replay = new PulseReplay();
+    PulseTraceHeader header;
+
+    storageBegin();
+    File file = traceFs->open(tracePath(result.name), FILE_READ);
+    bool ok = file && file.read((uint8_t*)&header, sizeof(header)) == sizeof(header);
+    storageEnd();
+    result.valid = ok && buffer && header.magic == PULSE_TRACE_MAGIC && header.version == PULSE_TRACE_VERSION &&
+                   header.headerBytes == sizeof(header);
+
+    if (result.valid) {
+        replay->begin(header);
+        PulseTraceReader reader;
+        PulseTraceEvent event;
+        PulseReplaySecond second;
+        size_t filled = 0;
+        bool ended = false;
+        bool haveFirst = false;
+        uint32_t firstMs = 0;
+        int64_t startUs = esp_timer_get_time();
+        int64_t lastYieldUs = startUs;
+        if (result.speed > 0.0f) Serial.println("replay,ms,counts,pulses,cpm60,rate_usvh,alarm");
+
+        while (!ended) {
+            storageBegin();
+            size_t got = file.read(buffer + filled, REPLAY_BUFFER_BYTES - filled);
+            storageEnd();
+            filled += got;
+            reader.setBuffer(buffer, filled);
+            while (!ended && reader.next(event)) {
+                if (event.type == PULSE_TRACE_END) {
+                    ended = true;
+                } else if (event.type == PULSE_TRACE_SAMPLE && !haveFirst) {
+                    firstMs = event.ms;
+                    haveFirst = true;
+                }
+                if (!replay->feed(event, &second)) continue;
+                if (second.alarmLevel > result.maxAlarmLevel) result.maxAlarmLevel = second.alarmLevel;
+                if (result.speed > 0.0f) {
+                    // Paced by the recorded sample clock
+                    int64_t dueUs = startUs + (int64_t)((second.ms - firstMs) * 1000.0 / result.speed);
+                    int64_t aheadUs = dueUs - esp_timer_get_time();
+                    if (aheadUs > 1000) vTaskDelay(pdMS_TO_TICKS(aheadUs / 1000));
+                    Serial.printf("replay,%lu,%lu,%lu,%.1f,%.4f,%u\n", (unsigned long)second.ms,
+                                  (unsigned long)second.counts, (unsigned long)second.pulses, second.cpm60,
+                                  second.rateUsvH, second.alarmLevel);
+                }
+            }
+            size_t used = reader.consumed();
+            memmove(buffer, buffer + used, filled - used);
+            filled -= used;
+            if (got == 0) break; // End of file (a torn last event stays unread)
+
+            // At full speed the idle task still needs a tick now and then
+            if (esp_timer_get_time() - lastYieldUs > 100000) {
+                vTaskDelay(1);
+                lastYieldUs = esp_timer_get_time();
+            }
+        }
+        result.elapsedUs = (uint32_t)(esp_timer_get_time() - startUs);
+        result.seconds = replay->seconds();
+        result.samples = replay->samples();
+        result.pulses = replay->pulses();
+        result.dropped = replay->droppedEvents();
+        result.checksum = replay->checksum();
+        Serial.printf("Replay of %s: %lu s, %lu samples, %lu pulses, checksum %08lx, max alarm %s, %.3f s "
+                      "(%.2f Mpulses/s)\n",
+                      result.name, (unsigned long)result.seconds, (unsigned long)result.samples,
+                      (unsigned long)result.pulses, (unsigned long)result.checksum,
+                      alarmLevelName(result.maxAlarmLevel), result.elapsedUs / 1e6f,
+                      result.elapsedUs ? (float)result.pulses / result.elapsedUs : 0.0f);
+    } else {
+        Serial.printf("Replay of %s: not a pulse trace\n", result.name);
+    }
+
+    storageBegin();
+    if (file) file.close();
+    storageEnd();
+    delete replay;
+    free(buffer);
+    replayRunning = false;
+    vTaskDelete(NULL);
+}
+
+bool pulseReplayStart(const char* name, float speed) {
+    if (!traceFs || replayRunning || !validName(name)) return false;
+    memset(&replayResult, 0, sizeof(replayResult));
+    strncpy(replayResult.name, name, sizeof(replayResult.name) - 1);
+    replayResult.speed = speed > 0.0f ? speed : 0.0f;
+    replayRunning = true;
+    if (xTaskCreatePinnedToCore(pulseReplayTask, "TraceReplay", 4096, NULL, NETWORK_TASK_PRIORITY, NULL,
+                                TASK_CORE_NETWORK) != pdPASS) {
+        replayRunning = false;
+        return false;
+    }
+    return true;
+}
+
+void printPulseRecorder(Print& out) {
+    if (!traceFs) {
+        out.println("Pulse trace: no storage");
+        return;
+    }
+    static const char* STATES[] = {"idle", "starting", "recording", "stopping", "closing", "armed"};
+    uint8_t state = recorderState;
+    bool named = state != RECORDER_IDLE && state != RECORDER_ARMED;
+    out.printf("Pulse trace: %s%s%s on %s, %lu events, %lu dropped, %lu bytes in %lu chunks, %lu write errors\n",
+               STATES[state], named ? " " : "", named ? traceName : "", onSd ? "SD" : "LittleFS",
+               (unsigned long)recordedEvents, (unsigned long)droppedEvents, (unsigned long)writtenBytes,
+               (unsigned long)writtenChunks, (unsigned long)writeErrors);
+    if (replayRunning) {
+        out.printf("  replaying %s\n", replayResult.name);
+    } else if (replayResult.name[0] && replayResult.valid) {
+        out.printf("  last replay %s: %lu s, %lu pulses, checksum %08lx, max alarm %s\n", replayResult.name,
+                   (unsigned long)replayResult.seconds, (unsigned long)replayResult.pulses,
+                   (unsigned long)replayResult.checksum, alarmLevelName(replayResult.maxAlarmLevel));
+    }
+    if (armRequested || eventCaptures) {
+        out.printf("  event capture %s: %u s before a trigger, %u s after, %lu captured\n",
+                   armRequested ? "armed" : "off", (unsigned)ANOMALY_PRE_S, (unsigned)ANOMALY_POST_S,
+                   (unsigned long)eventCaptures);
+    }
+
+    storageBegin();
+    File dir = traceFs->open(PULSE_TRACE_DIR);
+    File entry = dir ? dir.openNextFile() : File();
+    while (entry) {
+        String fileName = entry.name();
+        if (fileName.endsWith(".rpt")) {
+            out.printf("  %-24s %8lu bytes\n", fileName.c_str(), (unsigned long)entry.size());
+        }
+        entry.close();
+        entry = dir.openNextFile();
+    }
+    if (dir) dir.close();
+    storageEnd();
+}
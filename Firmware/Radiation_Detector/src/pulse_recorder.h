@@ -0,0 +1,70 @@
+#ifndef PULSE_RECORDER_H
+#define PULSE_RECORDER_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "pulse_trace.h"
+
+// Recording and replay of raw pulse traces ("pulsetrace").
+// While recording, pulseTask encodes every sample it consumes and every
+// capture timestamp (pulse_trace.h) into PULSE_TRACE_CHUNK_BYTES chunks from a
+// PSRAM pool, without blocking. A writer task on the network core appends the
+// chunks to PULSE_TRACE_DIR/<name>.rpt on the SD card, or LittleFS without a
+// card. A chunk is handed over when full or PULSE_TRACE_FLUSH_MS old. With no
+// free chunk the events are skipped until one returns, and the next chunk's
+// sync records the loss.
+//
+// Armed for event capture (anomaly_capture.h), pulseTask encodes the same way
+// into a ring of ANOMALY_PRE_CHUNKS chunks that reaches ANOMALY_PRE_S back,
+// and nothing goes to storage. A trigger writes the ring out as the start of
+// a new trace and records on until ANOMALY_POST_S after the last trigger;
+// then the recorder arms itself again. A manual recording is refused while
+// armed.
+//
+// A replay runs the file through its own PulseReplay (pulse_replay.h) on a
+// task of its own, never through the live state: the display, dose and alarms
+// carry on. At speed 0 it runs as fast as it can and prints a summary with the
+// checksum and the throughput; at another speed it is paced by the recorded
+// sample times and prints every second. tools/pulse_replay.cpp replays the
+// same files on the host.
+
+// Fills the header with the live pipeline parameters and state (pulseTask).
+typedef void (*PulseTraceStateSource)(PulseTraceHeader& header);
+
+// Allocates the chunk pool and starts the writer task. Call in setup() after
+// the history log (which mounts the card).
+bool initPulseRecorder(PulseTraceStateSource source);
+
+// Opens the file and asks pulseTask to start recording. UI task.
+// @return false if busy, no storage, a bad name (1-20 of [A-Za-z0-9_-]) or the file cannot be created
+bool pulseRecorderStart(const char* name);
+
+// Asks pulseTask to finish the recording; the writer closes the file. UI task.
+void pulseRecorderStop();
+
+// pulseTask, once per pass before the samples: starts and stops, and hands
+// over an aged chunk.
+void pulseRecorderPoll(uint32_t nowMs);
+
+// pulseTask: one consumed sample, one capture timestamp.
+void pulseRecorderSample(uint32_t ms, uint32_t count);
+void pulseRecorderPulse(uint32_t us);
+
+// Arms or disarms event capture; pulseTask follows on its next pass. Any task.
+void pulseRecorderArm(bool armed);
+bool pulseRecorderArmed();
+
+// pulseTask: writes the pre-trigger ring to <name> and records on until
+// ANOMALY_POST_S from now. @return false if not armed
+bool pulseRecorderTrigger(uint32_t nowMs, const char* name);
+
+// pulseTask: an event recording goes on until ANOMALY_POST_S from now.
+void pulseRecorderExtend(uint32_t nowMs);
+
+// Replays <name> at @p speed times real time (0: as fast as possible). UI task.
+bool pulseReplayStart(const char* name, float speed);
+
+// Recorder state, the traces on the storage and the last replay.
+void printPulseRecorder(Print& out);
+
+#endif // PULSE_RECORDER_H
@@ -0,0 +1,171 @@
+#ifndef PULSE_REPLAY_H
+#define PULSE_REPLAY_H
+
+#include <stdint.h>
+#include <string.h>
+#include "pulse_trace.h"
+#include "measurement.h"
+#include "alarm_rules.h"
+
+// Replays a pulse trace (pulse_trace.h) through the rate pipeline.
+// The samples go into a PulseAccumulator, and each closed second into the
+// DoseAccumulator and the AlarmEngine, with the same calls and parameters as
+// pulseTask. The replay runs on its own instances, never the live ones. Two
+// builds that replay the same trace agree bit for bit unless the pipeline
+// changed; checksum() folds every closed second into one value to compare.
+// The header carries the open bucket and the dose of the live pipeline, so
+// the replay closes its seconds where the live run did. A live run and its
+// recording agree once the 300 s windows and the alarm hysteresis have
+// caught up with the seconds before the recording, and as long as the
+// settings were not changed during it. One trace per instance. Pulse
+// timestamps are counted per second as a cross-check of the PCNT counts.
+// No Arduino dependencies (host-compilable).
+
+// Pipeline state after one closed second.
+struct PulseReplaySecond {
+    uint32_t ms;             ///< Sample time that closed it
+    uint32_t counts;         ///< Counts in the second
+    uint32_t totalCounts;
+    uint32_t pulses;         ///< Capture timestamps since the previous second
+    float cpm10;             ///< Raw CPM over 10 s
+    float cpm60;             ///< Raw CPM over 60 s
+    float adaptiveCpm;
+    uint16_t adaptiveSeconds;
+    uint8_t alarmLevel;      ///< AlarmLevel
+    uint8_t alarmCauses;
+    float rateUsvH;          ///< Alarm engine point estimate
+    double doseMsv;
+};
+
+class PulseReplay {
+public:
+    PulseReplay()
+        : accumulator_(windows_, adaptive_), deadTimeSec_(0.0f), cpmPerUsvH_(1.0f), usvHPerCpm_(1.0f),
+          bucketStartMs_(0), bucketCounts_(0), started_(false), checksum_(2166136261u), // FNV-1a offset basis
+          seconds_(0), samples_(0), pulses_(0), secondPulses_(0), dropped_(0) {
+        hal_.ms = 0;
+        hal_.count = 0;
+    }
+
+    /// Takes the parameters and the pipeline state of @p header. Before the first event.
+    void begin(const PulseTraceHeader& header) {
+        deadTimeSec_ = header.deadTimeUs * 1e-6f;
+        cpmPerUsvH_ = header.cpmPerUsvH;
+        usvHPerCpm_ = 1.0f / header.cpmPerUsvH;
+        thresholds_ = AlarmThresholds::fromAlarm(header.rateAlarmUsvH, header.doseAlarmMsv, header.warnFraction,
+                                                 header.dangerFactor);
+        bucketStartMs_ = header.bucketStartMs;
+        bucketCounts_ = header.bucketCounts;
+        dose_.restore(header.doseMsv);
+    }
+
+    /**
+     * @brief Feeds one event.
+     * @return true if it closed a second; @p second then holds the results
+     */
+    bool feed(const PulseTraceEvent& event, PulseReplaySecond* second) {
+        switch (event.type) {
+            case PULSE_TRACE_PULSE:
+                pulses_++;
+                secondPulses_++;
+                return false;
+            case PULSE_TRACE_SYNC:
+                dropped_ += event.dropped;
+                return false;
+            case PULSE_TRACE_SAMPLE:
+                break;
+            default:
+                return false;
+        }
+        samples_++;
+        hal_.ms = event.ms;
+        hal_.count = event.count;
+        // The first reading is the reference, as in pulseTask
+        if (!started_) {
+            accumulator_.resume(hal_, bucketStartMs_, bucketCounts_);
+            started_ = true;
+            return false;
+        }
+        bool closed = false;
+        accumulator_.poll(hal_, &closed);
+        if (!closed) return false;
+
+        uint32_t counts = accumulator_.lastSecondCounts();
+        dose_.addSecond(counts, deadTimeSec_, usvHPerCpm_);
+        const AlarmStatus& status =
+            alarms_.update(windows_, adaptive_, (float)dose_.msv(), deadTimeSec_, cpmPerUsvH_, thresholds_);
+
+        second->ms = event.ms;
+        second->counts = counts;
+        second->totalCounts = accumulator_.totalCounts();
+        second->pulses = secondPulses_;
+        second->cpm10 = windows_.cpm(RATE_WINDOW_10S);
+        second->cpm60 = windows_.cpm(RATE_WINDOW_60S);
+        second->adaptiveCpm = adaptive_.cpm();
+        second->adaptiveSeconds = adaptive_.windowSeconds();
+        second->alarmLevel = status.level;
+        second->alarmCauses = status.causes;
+        second->rateUsvH = status.rateUsvH;
+        second->doseMsv = dose_.msv();
+        secondPulses_ = 0;
+        seconds_++;
+        fold(*second);
+        return true;
+    }
+
+    uint32_t checksum() const { return checksum_; }
+    uint32_t seconds() const { return seconds_; }
+    uint32_t samples() const { return samples_; }
+    uint32_t pulses() const { return pulses_; }
+    uint32_t droppedEvents() const { return dropped_; }
+
+private:
+    struct ReplayHal : public MeasurementHal {
+        uint32_t ms;
+        uint32_t count;
+        uint32_t nowMs() override { return ms; }
+        uint32_t pulseCount() override { return count; }
+    };
+
+    /// FNV-1a over the fields (not the struct, whose padding is undefined).
+    void fold(const PulseReplaySecond& s) {
+        uint64_t doseBits;
+        memcpy(&doseBits, &s.doseMsv, sizeof(doseBits));
+        uint32_t words[] = {s.ms, s.counts, s.totalCounts, s.pulses, bits(s.cpm10), bits(s.cpm60),
+                            bits(s.adaptiveCpm), (uint32_t)s.adaptiveSeconds << 16 | s.alarmLevel << 8 | s.alarmCauses,
+                            bits(s.rateUsvH), (uint32_t)doseBits, (uint32_t)(doseBits >> 32)};
+        for (uint32_t word : words) {
+            for (int shift = 0; shift < 32; shift += 8) {
+                checksum_ = (checksum_ ^ ((word >> shift) & 0xFF)) * 16777619u;
+            }
+        }
+    }
+
+    static uint32_t bits(float value) {
+        uint32_t word;
+        memcpy(&word, &value, sizeof(word));
+        return word;
+    }
+
+    RateWindows windows_;
+    AdaptiveRateEstimator adaptive_;
+    PulseAccumulator accumulator_;
+    DoseAccumulator dose_;
+    AlarmEngine alarms_;
+    AlarmThresholds thresholds_;
+    ReplayHal hal_;
+    float deadTimeSec_;
+    float cpmPerUsvH_;
+    float usvHPerCpm_;
+    uint32_t bucketStartMs_;
+    uint32_t bucketCounts_;
+    bool started_;
+    uint32_t checksum_;
+    uint32_t seconds_;
+    uint32_t samples_;
+    uint32_t pulses_;
+    uint32_t secondPulses_;
+    uint32_t dropped_;
+};
+
+#endif // PULSE_REPLAY_H
@@ -0,0 +1,198 @@
+#ifndef PULSE_TRACE_H
+#define PULSE_TRACE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "log_codec.h" // LEB128 varints
+
+// Raw pulse trace: the input of the rate pipeline, recorded so that it can be
+// replayed (pulse_replay.h) on the device or on the host.
+// A trace is a PulseTraceHeader followed by a stream of events, each a LEB128
+// varint token (value << 2 | type) and, for some types, more varints:
+//   pulse   value: microseconds since the previous pulse (capture timestamp)
+//   sample  value: milliseconds since the previous sample, then the count
+//           delta: one PCNT reading as pulseTask consumed it
+//   sync    value: events dropped before it, then the absolute microseconds,
+//           milliseconds and count the deltas that follow refer to
+//   end     value 0: the recording was stopped (optional)
+// The recorder writes in chunks and starts each with a sync. Events that find
+// no free chunk are dropped, but the next sample's count delta still covers
+// every count; only timestamps and sample times are lost. A background trace
+// takes about 2 bytes per pulse and 3 per sample, ~70 bytes/s at 50 ms
+// samples. No Arduino dependencies (host-compilable).
+
+#define PULSE_TRACE_MAGIC   0x54504452 // "RDPT"
+#define PULSE_TRACE_VERSION 1
+#define PULSE_TRACE_MAX_EVENT 21       ///< Longest event: a sync token and three 5-byte varints
+
+enum PulseTraceEventType {
+    PULSE_TRACE_PULSE = 0,
+    PULSE_TRACE_SAMPLE = 1,
+    PULSE_TRACE_SYNC = 2,
+    PULSE_TRACE_END = 3
+};
+
+// Start of a trace file, little-endian. The pipeline parameters in effect when
+// the recording started; a replay uses them unless told otherwise.
+struct PulseTraceHeader {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t headerBytes;      ///< sizeof(PulseTraceHeader); events start here
+    uint16_t flags;           ///< Reserved
+    uint32_t startUtc;        ///< 0 if UTC was not known
+    float deadTimeUs;
+    float cpmPerUsvH;
+    float rateAlarmUsvH;      ///< AlarmThresholds::fromAlarm() inputs
+    float doseAlarmMsv;
+    float warnFraction;
+    float dangerFactor;
+    uint32_t bucketStartMs;   ///< Pipeline state: start of the open 1-second bucket
+    uint32_t bucketCounts;    ///< ... and its counts so far
+    uint32_t reserved;
+    double doseMsv;           ///< Cumulative dose so far
+};
+
+struct PulseTraceEvent {
+    uint8_t type;     ///< PulseTraceEventType
+    uint32_t us;      ///< Pulse timestamp (esp_timer, wraps)
+    uint32_t ms;      ///< Sample time (millis(), wraps)
+    uint32_t count;   ///< Sample count (monotonic, wraps)
+    uint32_t dropped; ///< Sync: events dropped before it
+};
+
+/**
+ * @brief Encodes events into one caller-owned chunk.
+ */
+class PulseTraceWriter {
+public:
+    PulseTraceWriter() : bytes_(nullptr), capacity_(0), length_(0), lastUs_(0), lastMs_(0), lastCount_(0) {}
+
+    /// Starts a chunk; the first event should be sync().
+    void begin(uint8_t* bytes, size_t capacity) {
+        bytes_ = bytes;
+        capacity_ = capacity;
+        length_ = 0;
+    }
+
+    /// Room for one more event of any type.
+    bool hasRoom() const { return bytes_ && length_ + PULSE_TRACE_MAX_EVENT <= capacity_; }
+
+    void sync(uint32_t dropped) {
+        token(PULSE_TRACE_SYNC, dropped);
+        put(lastUs_);
+        put(lastMs_);
+        put(lastCount_);
+    }
+
+    void pulse(uint32_t us) {
+        token(PULSE_TRACE_PULSE, (uint32_t)(us - lastUs_)); // Unsigned: correct across wraps
+        lastUs_ = us;
+    }
+
+    void sample(uint32_t ms, uint32_t count) {
+        token(PULSE_TRACE_SAMPLE, (uint32_t)(ms - lastMs_));
+        put((uint32_t)(count - lastCount_));
+        lastMs_ = ms;
+        lastCount_ = count;
+    }
+
+    void end() { token(PULSE_TRACE_END, 0); }
+
+    /// Keeps the delta references current while events cannot be stored.
+    void skipPulse(uint32_t us) { lastUs_ = us; }
+    void skipSample(uint32_t ms, uint32_t count) {
+        lastMs_ = ms;
+        lastCount_ = count;
+    }
+
+    size_t length() const { return length_; }
+
+private:
+    void token(uint8_t type, uint64_t value) { put(value << 2 | type); }
+    void put(uint64_t value) { length_ += logVarintPut(bytes_ + length_, value); }
+
+    uint8_t* bytes_;
+    size_t capacity_;
+    size_t length_;
+    uint32_t lastUs_;
+    uint32_t lastMs_;
+    uint32_t lastCount_;
+};
+
+/**
+ * @brief Decodes events from a byte window that may end mid-event: next()
+ *        then returns false without consuming it, and the caller moves the
+ *        rest to the front and appends more bytes.
+ */
+class PulseTraceReader {
+public:
+    PulseTraceReader() : bytes_(nullptr), length_(0), position_(0), us_(0), ms_(0), count_(0) {}
+
+    void setBuffer(const uint8_t* bytes, size_t length) {
+        bytes_ = bytes;
+        length_ = length;
+        position_ = 0;
+    }
+
+    /// Bytes of the buffer taken by complete events.
+    size_t consumed() const { return position_; }
+
+    bool next(PulseTraceEvent& event) {
+        size_t start = position_;
+        uint64_t token, a, b, c;
+        if (!get(&token)) return false;
+        event.type = (uint8_t)(token & 3);
+        uint64_t value = token >> 2;
+        switch (event.type) {
+            case PULSE_TRACE_PULSE:
+                us_ += (uint32_t)value;
+                event.us = us_;
+                return true;
+            case PULSE_TRACE_SAMPLE:
+                if (!get(&a)) break;
+                ms_ += (uint32_t)value;
+                count_ += (uint32_t)a;
+                event.ms = ms_;
+                event.count = count_;
+                return true;
+            case PULSE_TRACE_SYNC:
+                if (!get(&a) || !get(&b) || !get(&c)) break;
+                us_ = (uint32_t)a;
+                ms_ = (uint32_t)b;
+                count_ = (uint32_t)c;
+                event.dropped = (uint32_t)value;
+                event.us = us_;
+                event.ms = ms_;
+                event.count = count_;
+                return true;
+            default:
+                return true;
+        }
+        position_ = start;
+        return false;
+    }
+
+private:
+    bool get(uint64_t* value) {
+        uint64_t result = 0;
+        for (uint8_t shift = 0; shift < 64 && position_ < length_; shift += 7) {
+            uint8_t byte = bytes_[position_++];
+            result |= (uint64_t)(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                *value = result;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const uint8_t* bytes_;
+    size_t length_;
+    size_t position_;
+    uint32_t us_;
+    uint32_t ms_;
+    uint32_t count_;
+};
+
+#endif // PULSE_TRACE_H
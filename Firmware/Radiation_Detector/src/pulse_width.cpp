@@ -0,0 +1,156 @@
+/**
+ * @file pulse_width.cpp
+ * @brief RMT-based width measurement and window check of the Geiger pulses.
+ *
+ * The RMT receiver runs at 10 MHz (APB / 8), so a width is a 15-bit count of
+ * 0.1 us, up to ~3.2 ms. A frame ends after an idle gap of 1.25 x
+ * PULSE_WIDTH_MAX_US; a pulse still high at that point is recorded with a zero
+ * duration and counted as too long. The frame memory holds 192 items (four
+ * blocks), enough for a burst of as many pulses without an idle gap.
+ */
+
+#include "pulse_width.h"
+#include "debug.h"
+#include "driver/rmt.h"
+#include "freertos/ringbuf.h"
+
+static const rmt_channel_t WIDTH_CHANNEL = RMT_CHANNEL_4; ///< First receive channel of the ESP32-S3
+static const uint8_t WIDTH_CLOCK_DIV = 8;                 ///< 80 MHz APB / 8: 0.1 us per tick
+static const uint32_t TICKS_PER_US = 10;
+static const uint32_t MIN_TICKS = PULSE_WIDTH_MIN_US * TICKS_PER_US;
+static const uint32_t MAX_TICKS = PULSE_WIDTH_MAX_US * TICKS_PER_US;
+static const uint32_t IDLE_TICKS = MAX_TICKS + MAX_TICKS / 4;
+static const size_t WIDTH_RINGBUF_BYTES = 4096;
+
+static_assert(PULSE_WIDTH_MIN_US < PULSE_WIDTH_MAX_US, "Pulse width window is empty");
+static_assert(IDLE_TICKS <= 32767, "PULSE_WIDTH_MAX_US does not fit the RMT idle threshold");
+
+static RingbufHandle_t widthRing = nullptr;
+static PulseWidthStats widthStats;
+static bool widthActive = false;
+
+bool initPulseWidth(uint8_t pin) {
+#if PULSE_WIDTH_ENABLED
+    if (widthActive) return true;
+    resetPulseWidthStats();
+
+    // The pin stays routed to PCNT; the GPIO matrix feeds the RMT the same input
+    rmt_config_t config = RMT_DEFAULT_CONFIG_RX((gpio_num_t)pin, WIDTH_CHANNEL);
+    config.clk_div = WIDTH_CLOCK_DIV;
+    config.mem_block_num = 4;
+    config.rx_config.filter_en = true;
+    config.rx_config.filter_ticks_thresh = 8;   // APB cycles: drops only 100 ns glitches, the rest is measured
+    config.rx_config.idle_threshold = IDLE_TICKS;
+
+    esp_err_t err = rmt_config(&config);
+    if (err == ESP_OK) err = rmt_driver_install(WIDTH_CHANNEL, WIDTH_RINGBUF_BYTES, 0);
+    if (err == ESP_OK) err = rmt_get_ringbuf_handle(WIDTH_CHANNEL, &widthRing);
+    if (err == ESP_OK) err = rmt_rx_start(WIDTH_CHANNEL, true);
+    if (err != ESP_OK) {
+        DEBUG_PRINTF("Pulse width: RMT setup failed (%d)\n", err);
+        return false;
+    }
+
+    widthActive = true;
+    DEBUG_PRINTF("Pulse width discrimination on GPIO %d (%u .. %u us)\n", pin, (unsigned)PULSE_WIDTH_MIN_US,
+                 (unsigned)PULSE_WIDTH_MAX_US);
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Sorts one high time into the window counts and the histogram.
+ * @param ticks Width in 0.1 us; 0 if the input was still high when the frame ended
+ */
+static void addWidth(uint32_t ticks) {
+    if (ticks == 0) {
+        widthStats.tooLong++;
+        return;
+    }
+    if (ticks < widthStats.minTenthsUs) widthStats.minTenthsUs = ticks;
+    if (ticks > widthStats.maxTenthsUs) widthStats.maxTenthsUs = ticks;
+
+    uint32_t bin = ticks / (PULSE_WIDTH_BIN_US * TICKS_PER_US);
+    if (bin >= PULSE_WIDTH_BINS) bin = PULSE_WIDTH_BINS - 1;
+    widthStats.bins[bin]++;
+
+    if (ticks < MIN_TICKS) {
+        widthStats.tooShort++;
+    } else if (ticks > MAX_TICKS) {
+        widthStats.tooLong++;
+    } else {
+        widthStats.accepted++;
+        widthStats.acceptedTenthsUs += ticks;
+    }
+}
+
+size_t drainPulseWidths() {
+    if (!widthActive) return 0;
+    size_t measured = 0;
+    size_t bytes = 0;
+    rmt_item32_t* items;
+
+    while ((items = (rmt_item32_t*)xRingbufferReceive(widthRing, &bytes, 0)) != nullptr) {
+        widthStats.frames++;
+        size_t count = bytes / sizeof(rmt_item32_t);
+        for (size_t i = 0; i < count; i++) {
+            // Each item is two level/duration halves; the pulses are the high ones
+            if (items[i].level0) {
+                addWidth(items[i].duration0);
+                measured++;
+            }
+            if (items[i].level1) {
+                addWidth(items[i].duration1);
+                measured++;
+            }
+            if (items[i].duration0 == 0 || items[i].duration1 == 0) break; // End of frame
+        }
+        vRingbufferReturnItem(widthRing, items);
+    }
+    return measured;
+}
+
+void resetPulseWidthStats() {
+    memset(&widthStats, 0, sizeof(widthStats));
+    widthStats.minTenthsUs = UINT32_MAX;
+}
+
+bool pulseWidthActive() {
+    return widthActive;
+}
+
+PulseWidthStats getPulseWidthStats() {
+    return widthStats;
+}
+
+void printPulseWidth(Print& out) {
+    if (!widthActive) {
+        out.println("Pulse width discrimination disabled");
+        return;
+    }
+    PulseWidthStats stats = widthStats;
+    uint32_t measured = stats.accepted + stats.tooShort + stats.tooLong;
+    out.printf("Pulse width: window %u .. %u us, PCNT filter %.2f us, %lu pulses in %lu frames\n",
+               (unsigned)PULSE_WIDTH_MIN_US, (unsigned)PULSE_WIDTH_MAX_US, PULSE_WIDTH_PCNT_FILTER_CYCLES / 80.0f,
+               (unsigned long)measured, (unsigned long)stats.frames);
+    out.printf("  accepted %lu, too short %lu, too long %lu (%.2f%% rejected)\n", (unsigned long)stats.accepted,
+               (unsigned long)stats.tooShort, (unsigned long)stats.tooLong,
+               measured ? 100.0f * (stats.tooShort + stats.tooLong) / measured : 0.0f);
+    if (stats.maxTenthsUs) {
+        out.printf("  width min %.1f us, max %.1f us, accepted mean %.1f us\n", stats.minTenthsUs / 10.0f,
+                   stats.maxTenthsUs / 10.0f,
+                   stats.accepted ? (float)stats.acceptedTenthsUs / stats.accepted / 10.0f : 0.0f);
+    }
+    out.print("  ");
+    for (uint8_t b = 0; b < PULSE_WIDTH_BINS; b++) {
+        if (!stats.bins[b]) continue;
+        if (b == PULSE_WIDTH_BINS - 1) {
+            out.printf(">=%u:%lu ", (unsigned)(b * PULSE_WIDTH_BIN_US), (unsigned long)stats.bins[b]);
+        } else {
+            out.printf("<%u:%lu ", (unsigned)((b + 1) * PULSE_WIDTH_BIN_US), (unsigned long)stats.bins[b]);
+        }
+    }
+    out.println();
+}
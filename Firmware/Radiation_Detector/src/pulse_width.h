@@ -0,0 +1,53 @@
+#ifndef PULSE_WIDTH_H
+#define PULSE_WIDTH_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Pulse-width discrimination of the Geiger input.
+// An RMT receive channel listens on the Geiger pin next to PCNT and measures
+// the high time of every pulse in 0.1 us steps, in hardware. The driver
+// delivers whole frames (pulses up to an idle gap of 1.25 x PULSE_WIDTH_MAX_US),
+// so at high rates several pulses arrive per interrupt instead of one each.
+// pulseTask drains the frames, sorts each width into a histogram and counts
+// the pulses outside PULSE_WIDTH_MIN_US .. PULSE_WIDTH_MAX_US.
+//
+// Rejection in the counting path is done by the PCNT glitch filter, which is
+// set to PULSE_WIDTH_MIN_US (at most ~12.8 us): boost converter spikes never
+// reach the count. Too long pulses cannot be held back by PCNT; they are
+// counted here ("pulsewidth") as a sign of a failing tube or HV breakdown.
+
+// PCNT glitch filter for PULSE_WIDTH_MIN_US, in APB cycles (10 bits at 80 MHz)
+#define PULSE_WIDTH_PCNT_FILTER_CYCLES (PULSE_WIDTH_MIN_US * 80 > 1023 ? 1023 : PULSE_WIDTH_MIN_US * 80)
+
+struct PulseWidthStats {
+    uint32_t frames;          ///< RMT frames drained
+    uint32_t accepted;        ///< Inside the window
+    uint32_t tooShort;        ///< Below PULSE_WIDTH_MIN_US
+    uint32_t tooLong;         ///< Above PULSE_WIDTH_MAX_US, or high past the idle gap
+    uint32_t minTenthsUs;     ///< Shortest measured width, 0.1 us
+    uint32_t maxTenthsUs;     ///< Longest measured width, 0.1 us
+    uint64_t acceptedTenthsUs; ///< Sum of the accepted widths, for the mean
+    uint32_t bins[PULSE_WIDTH_BINS]; ///< PULSE_WIDTH_BIN_US wide; the last one takes the rest
+};
+
+// Starts the RMT channel on @p pin. Call after initPulseCounter() from the
+// task whose core should serve the interrupt.
+bool initPulseWidth(uint8_t pin);
+
+// Takes the completed frames off the driver and updates the statistics.
+// pulseTask only. @return the number of pulses measured
+size_t drainPulseWidths();
+
+// Clears the statistics. pulseTask only (COMMAND_RESET_PULSE_WIDTH).
+void resetPulseWidthStats();
+
+bool pulseWidthActive();
+
+// Copy of the statistics; other tasks may see a pass half applied.
+PulseWidthStats getPulseWidthStats();
+
+// Window, counts and the histogram ("pulsewidth").
+void printPulseWidth(Print& out);
+
+#endif // PULSE_WIDTH_H
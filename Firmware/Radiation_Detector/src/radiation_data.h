@@ -1,20 +1,52 @@
 #ifndef RADIATION_DATA_H
 #define RADIATION_DATA_H
 
+#include "count_statistics.h"
+#include "rate_ewma.h"
+
 // Export getRadiationDataJson function to be used by dashboard.cpp
 String getRadiationDataJsonExport();
 
-// Rename cumulativemSv to cumulativeDosemSv for dashboard.cpp
-// This is an extern declaration of the variable defined in Radiation-Detector.cpp
-extern float cumulativemSv;
-// This creates an alias for the dashboard.cpp to use
-#define cumulativeDosemSv cumulativemSv
-
-// Also export other radiation data variables needed by dashboard.cpp
-extern float currentuSvHr;
-extern float averageuSvHr;
-extern float maxuSvHr;
-extern float chart1Buffer[];
-extern float chart3Buffer[];
+// Wire formats of /api/data, selected by the Accept header
+enum ApiFormat {
+    API_FORMAT_JSON,
+    API_FORMAT_MSGPACK
+};
+
+// Serialises the same document into @p out without heap allocation (web task only),
+// without the chart arrays unless @p charts. Returns the length, or 0 if it did not fit.
+size_t writeRadiationData(char* out, size_t size, ApiFormat format = API_FORMAT_JSON, bool charts = true);
+
+// Compact live values for the /events "rate" event (no chart arrays), written
+// into @p out without heap allocation. Returns the length, or 0 if it did not fit.
+size_t writeLiveRate(char* out, size_t size);
+
+// Hourly and daily chart arrays for the /events "charts" event
+String getChartDataJsonExport();
+
+// Incremented whenever a chart interval closes or the charts are cleared
+uint32_t getChartDataVersion();
+
+// Seconds closed by the pulse pipeline; the /api/data values change with it
+uint32_t getApiDataGeneration();
+
+// Dose values as last integrated by uiTask. uiTask is their only writer; the
+// other tasks (web, metrics, checkpoints, alarms) read this copy.
+struct DoseSnapshot {
+    float currentUsvH;     ///< Instantaneous dose rate
+    float averageUsvH;     ///< Average over the measurement
+    float maximumUsvH;
+    float cumulativeMsv;   ///< From pulseTask's count accumulator, evaluated by getDoseSnapshot()
+    float rawCpm;          ///< Adaptive-window CPM as counted
+    float correctedCpm;    ///< ... after dead-time correction
+    RateUncertainty currentError;  ///< Count statistics of currentUsvH (95 %)
+    RateUncertainty averageError;  ///< ... of averageUsvH
+    PrecisionMeasurement measurement; ///< Run started with "measure"
+    float averagesUsvH[RATE_EWMA_COUNT];      ///< Exponentially weighted averages (rate_ewma.h), dead-time corrected
+    float averagesSigmaUsvH[RATE_EWMA_COUNT]; ///< Their count-statistics 1-sigma
+};
+
+// Consistent copy of the dose values. Any task, lock-free.
+DoseSnapshot getDoseSnapshot();
 
 #endif // RADIATION_DATA_H 
\ No newline at end of file
@@ -0,0 +1,242 @@
+#ifndef RATE_ESTIMATOR_H
+#define RATE_ESTIMATOR_H
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "rate_window.h"
+#include "adaptive_rate.h"
+
+// Common interface of the count-rate estimators over 1-second buckets, and a
+// bank that runs several of them side by side on the same buckets.
+// Every estimator takes one closed second in O(1) (a fixed number of
+// operations, independent of the rate and of its history) and reports a rate
+// with its count-statistics 1-sigma, both in counts per second:
+//  - SlidingWindowEstimator: the plain mean over a 10 s, 60 s or 300 s window
+//    (rate_window.h), extrapolated while it fills;
+//  - AdaptiveWindowEstimator: the adaptive window (adaptive_rate.h), the one
+//    the dose rate is shown from;
+//  - EwmaEstimator: one exponentially weighted average, as in rate_ewma.h;
+//  - BayesEstimator: a Gamma posterior whose evidence is discounted by
+//    exp(-1 / tau) per second, so it forgets like an EWMA of the same tau but
+//    starts from a prior instead of from nothing;
+//  - KalmanEstimator: a one-state random-walk Kalman filter, the drift per
+//    second a fraction of the rate and the measurement variance the Poisson
+//    variance of the current estimate.
+// The bank (RATE_ESTIMATOR_SET in config.h) runs on pulseTask next to the
+// production pipeline and counts the CPU cycles each estimator takes;
+// tools/rate_bench.cpp replays recorded traces through the same classes and
+// scores response time and noise. No Arduino dependencies (host-compilable).
+
+class RateEstimator {
+public:
+    virtual ~RateEstimator() {}
+    virtual const char* name() const = 0;
+    virtual void reset() = 0;
+    virtual void addSecond(uint32_t counts) = 0;
+    virtual float cps() const = 0;
+    virtual float sigmaCps() const = 0;
+};
+
+class SlidingWindowEstimator : public RateEstimator {
+public:
+    explicit SlidingWindowEstimator(RateWindowId window) : window_(window) {}
+    const char* name() const override {
+        static const char* const NAMES[RATE_WINDOW_COUNT] = {"window 10s", "window 60s", "window 300s"};
+        return NAMES[window_];
+    }
+    void reset() override { windows_.clear(); }
+    void addSecond(uint32_t counts) override { windows_.push(counts); }
+    float cps() const override { return windows_.cpm(window_) / 60.0f; }
+    float sigmaCps() const override {
+        uint16_t seconds = windows_.seconds(window_);
+        return seconds ? sqrtf((float)windows_.sum(window_)) / seconds : 0.0f;
+    }
+
+private:
+    RateWindowId window_;
+    RateWindows windows_;
+};
+
+class AdaptiveWindowEstimator : public RateEstimator {
+public:
+    const char* name() const override { return "adaptive"; }
+    void reset() override { adaptive_.clear(); }
+    void addSecond(uint32_t counts) override { adaptive_.push(counts); }
+    float cps() const override { return adaptive_.cpm() / 60.0f; }
+    float sigmaCps() const override {
+        uint16_t seconds = adaptive_.windowSeconds();
+        return seconds ? sqrtf((float)adaptive_.windowCounts()) / seconds : 0.0f;
+    }
+
+private:
+    AdaptiveRateEstimator adaptive_;
+};
+
+class EwmaEstimator : public RateEstimator {
+public:
+    explicit EwmaEstimator(float tauSeconds) : alpha_(1.0f - expf(-1.0f / tauSeconds)) {
+        snprintf(name_, sizeof(name_), "ewma %.0fs", tauSeconds);
+        reset();
+    }
+    const char* name() const override { return name_; }
+    void reset() override {
+        value_ = 0.0f;
+        decay_ = 1.0f;
+    }
+    void addSecond(uint32_t counts) override {
+        value_ += alpha_ * ((float)counts - value_);
+        decay_ *= 1.0f - alpha_;
+    }
+    float cps() const override { return decay_ < 1.0f ? value_ / (1.0f - decay_) : 0.0f; }
+    float sigmaCps() const override {
+        float weight = 1.0f - decay_;
+        if (weight <= 0.0f) return 0.0f;
+        float squares = alpha_ * (1.0f - decay_ * decay_) / (2.0f - alpha_);
+        return sqrtf(cps() * squares) / weight;
+    }
+
+private:
+    char name_[16];
+    float alpha_;
+    float value_;
+    float decay_;   ///< (1 - alpha)^n: weight not yet given to data
+};
+
+class BayesEstimator : public RateEstimator {
+public:
+    /// Prior mean @p priorCps worth @p priorSeconds of data (0: none).
+    BayesEstimator(float tauSeconds, float priorCps, float priorSeconds)
+        : keep_(expf(-1.0f / tauSeconds)) {
+        snprintf(name_, sizeof(name_), "bayes %.0fs", tauSeconds);
+        setPrior(priorCps, priorSeconds);
+    }
+    const char* name() const override { return name_; }
+
+    /// Replaces the prior and resets.
+    void setPrior(float priorCps, float priorSeconds) {
+        priorAlpha_ = priorCps * priorSeconds;
+        priorBeta_ = priorSeconds;
+        reset();
+    }
+    void reset() override {
+        alpha_ = priorAlpha_;
+        beta_ = priorBeta_;
+    }
+    void addSecond(uint32_t counts) override {
+        alpha_ = keep_ * alpha_ + (float)counts;
+        beta_ = keep_ * beta_ + 1.0f;
+    }
+    float cps() const override { return beta_ > 0.0f ? alpha_ / beta_ : 0.0f; }
+    float sigmaCps() const override { return beta_ > 0.0f ? sqrtf(alpha_) / beta_ : 0.0f; }
+
+private:
+    char name_[16];
+    float keep_;
+    float priorAlpha_;
+    float priorBeta_;
+    float alpha_;
+    float beta_;
+};
+
+class KalmanEstimator : public RateEstimator {
+public:
+    /// The rate drifts by @p driftPerSecond of itself (1-sigma) per second.
+    explicit KalmanEstimator(float driftPerSecond) : drift_(driftPerSecond) { reset(); }
+    const char* name() const override { return "kalman"; }
+    void reset() override {
+        rate_ = 0.0f;
+        variance_ = -1.0f;   // No measurement yet
+    }
+    void addSecond(uint32_t counts) override {
+        float z = (float)counts;
+        if (variance_ < 0.0f) {
+            rate_ = z;
+            variance_ = z > 1.0f ? z : 1.0f;
+            return;
+        }
+        float q = drift_ * rate_;
+        variance_ += q * q + MIN_PROCESS_VARIANCE;
+        float noise = rate_ > MIN_MEASUREMENT_VARIANCE ? rate_ : MIN_MEASUREMENT_VARIANCE;
+        float gain = variance_ / (variance_ + noise);
+        rate_ += gain * (z - rate_);
+        if (rate_ < 0.0f) rate_ = 0.0f;
+        variance_ *= 1.0f - gain;
+    }
+    float cps() const override { return rate_; }
+    float sigmaCps() const override { return variance_ > 0.0f ? sqrtf(variance_) : 0.0f; }
+
+private:
+    static constexpr float MIN_PROCESS_VARIANCE = 1e-6f;      ///< Keeps the gain above 0 at zero rate
+    static constexpr float MIN_MEASUREMENT_VARIANCE = 0.05f;  ///< Poisson variance floor near zero counts
+    float drift_;
+    float rate_;
+    float variance_;
+};
+
+/**
+ * @brief Runs up to MAX estimators on the same buckets and accounts the
+ *        cycles each one takes per second.
+ */
+class RateEstimatorBank {
+public:
+    static const uint8_t MAX = 8;
+    typedef uint32_t (*CycleClock)();
+
+    struct Cost {
+        uint32_t lastCycles;
+        uint32_t maxCycles;
+        uint64_t totalCycles;
+    };
+
+    RateEstimatorBank() : count_(0), seconds_(0) {}
+
+    bool add(RateEstimator* estimator) {
+        if (!estimator || count_ >= MAX) return false;
+        Cost& cost = costs_[count_];
+        cost.lastCycles = cost.maxCycles = 0;
+        cost.totalCycles = 0;
+        estimators_[count_++] = estimator;
+        return true;
+    }
+
+    /// One closed second into every estimator; timed with @p clock if given.
+    void addSecond(uint32_t counts, CycleClock clock = nullptr) {
+        for (uint8_t i = 0; i < count_; i++) {
+            if (!clock) {
+                estimators_[i]->addSecond(counts);
+                continue;
+            }
+            uint32_t start = clock();
+            estimators_[i]->addSecond(counts);
+            uint32_t cycles = clock() - start;
+            Cost& cost = costs_[i];
+            cost.lastCycles = cycles;
+            if (cycles > cost.maxCycles) cost.maxCycles = cycles;
+            cost.totalCycles += cycles;
+        }
+        seconds_++;
+    }
+
+    void reset() {
+        for (uint8_t i = 0; i < count_; i++) {
+            estimators_[i]->reset();
+            costs_[i].lastCycles = costs_[i].maxCycles = 0;
+            costs_[i].totalCycles = 0;
+        }
+        seconds_ = 0;
+    }
+
+    uint8_t count() const { return count_; }
+    const RateEstimator& at(uint8_t index) const { return *estimators_[index]; }
+    const Cost& cost(uint8_t index) const { return costs_[index]; }
+    uint32_t seconds() const { return seconds_; }
+
+private:
+    RateEstimator* estimators_[MAX];
+    Cost costs_[MAX];
+    uint8_t count_;
+    uint32_t seconds_;
+};
+
+#endif // RATE_ESTIMATOR_H
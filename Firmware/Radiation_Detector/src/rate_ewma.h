@@ -0,0 +1,95 @@
+#ifndef RATE_EWMA_H
+#define RATE_EWMA_H
+
+#include <math.h>
+#include <stdint.h>
+
+// Exponentially weighted rate averages over several time constants.
+// Every closed 1-second bucket updates each filter in O(1):
+//     s += a (counts - s),   a = 1 - exp(-1 / tau)
+// The filters start at zero, so each also tracks the total weight it has
+// given to real data, w = 1 - (1 - a)^n, and reports s / w. Until it has run
+// for a few time constants a filter is thus the plain mean since start, and
+// afterwards a moving average that forgets at its time constant, unlike the
+// since-boot average, which stops reacting after days of uptime. The 1-sigma
+// of Poisson counts follows from the same weights: the variance of the
+// weighted mean is rate * sum(w_i^2) / (sum w_i)^2. Rates are raw (not
+// dead-time corrected), like the sliding windows of rate_window.h.
+// No Arduino dependencies (host-compilable).
+
+enum RateEwmaId {
+    RATE_EWMA_10S = 0,
+    RATE_EWMA_1M,
+    RATE_EWMA_10M,
+    RATE_EWMA_1H,
+    RATE_EWMA_24H,
+    RATE_EWMA_COUNT
+};
+
+class RateEwma {
+public:
+    RateEwma() {
+        for (uint8_t i = 0; i < RATE_EWMA_COUNT; i++) {
+            double a = 1.0 - exp(-1.0 / tauSeconds((RateEwmaId)i));
+            alpha_[i] = a;
+            keep_[i] = 1.0 - a;
+        }
+        reset();
+    }
+
+    void reset() {
+        for (uint8_t i = 0; i < RATE_EWMA_COUNT; i++) {
+            value_[i] = 0.0;
+            decay_[i] = 1.0;
+        }
+        seconds_ = 0;
+    }
+
+    /// One closed second.
+    void addSecond(uint32_t counts) {
+        for (uint8_t i = 0; i < RATE_EWMA_COUNT; i++) {
+            value_[i] += alpha_[i] * (counts - value_[i]);
+            decay_[i] *= keep_[i];
+        }
+        seconds_++;
+    }
+
+    /// Counts per second; 0 before the first second.
+    float cps(RateEwmaId id) const {
+        double weight = 1.0 - decay_[id];
+        return weight > 0.0 ? (float)(value_[id] / weight) : 0.0f;
+    }
+
+    float cpm(RateEwmaId id) const { return 60.0f * cps(id); }
+
+    /// Count-statistics 1-sigma of cpm().
+    float sigmaCpm(RateEwmaId id) const {
+        double weight = 1.0 - decay_[id];
+        if (weight <= 0.0) return 0.0f;
+        double a = alpha_[id];
+        double squares = a * (1.0 - decay_[id] * decay_[id]) / (2.0 - a); // sum(w_i^2)
+        return (float)(60.0 * sqrt(cps(id) * squares) / weight);
+    }
+
+    uint32_t seconds() const { return seconds_; }
+
+    static uint32_t tauSeconds(RateEwmaId id) {
+        static const uint32_t TAU[RATE_EWMA_COUNT] = {10, 60, 600, 3600, 86400};
+        return TAU[id];
+    }
+
+    /// Short name of the time constant ("10s", "1m", "10m", "1h", "24h").
+    static const char* name(RateEwmaId id) {
+        static const char* const NAMES[RATE_EWMA_COUNT] = {"10s", "1m", "10m", "1h", "24h"};
+        return NAMES[id];
+    }
+
+private:
+    double alpha_[RATE_EWMA_COUNT];
+    double keep_[RATE_EWMA_COUNT];
+    double value_[RATE_EWMA_COUNT];
+    double decay_[RATE_EWMA_COUNT];  ///< (1 - a)^n: weight not yet given to data
+    uint32_t seconds_;
+};
+
+#endif // RATE_EWMA_H
@@ -0,0 +1,152 @@
+#ifndef RATE_LIMIT_H
+#define RATE_LIMIT_H
+
+#include <stdint.h>
+#include <string.h>
+
+// Per-client token buckets for the web API (web_rate_limit.h).
+// Every request falls into one of three traffic classes by its path:
+//  - PRIORITY: the dashboard page and its script, and the OTA pages and
+//    uploads. These are never limited.
+//  - API: polling endpoints such as /api/data, /events and /metrics.
+//  - BULK: large exports (history, spectrum, trace, screen stream). Each
+//    occupies the single-client web server for a long time.
+// Each client IPv4 address has one bucket per limited class. A bucket holds
+// up to `burst` tokens and refills at `perMinute` tokens a minute, so short
+// bursts such as a dashboard page load pass while a steady scraper is held
+// to the rate. The table keeps WEB_RATE_CLIENTS entries; a new address takes
+// the least recently seen one, which starts the old client over with full
+// buckets. Tokens are counted in thousandths so the refill needs no floats.
+// No Arduino dependencies (host-compilable).
+
+enum WebTrafficClass : uint8_t {
+    WEB_TRAFFIC_PRIORITY = 0,
+    WEB_TRAFFIC_API,
+    WEB_TRAFFIC_BULK,
+    WEB_TRAFFIC_CLASSES
+};
+
+inline bool uriStartsWith(const char* uri, const char* prefix) {
+    return strncmp(uri, prefix, strlen(prefix)) == 0;
+}
+
+/// Traffic class of a request path (the query string may be present).
+inline uint8_t webTrafficClass(const char* uri) {
+    if (strcmp(uri, "/") == 0 || uri[1] == '?' || uriStartsWith(uri, "/charts.") || uriStartsWith(uri, "/update") ||
+        uriStartsWith(uri, "/ota/") || uriStartsWith(uri, "/api/ota") || uriStartsWith(uri, "/warning") ||
+        uriStartsWith(uri, "/acknowledge-ota")) {
+        return WEB_TRAFFIC_PRIORITY;
+    }
+    if (uriStartsWith(uri, "/api/history") || uriStartsWith(uri, "/api/spectrum") ||
+        uriStartsWith(uri, "/api/trace") || uriStartsWith(uri, "/api/screen/stream")) {
+        return WEB_TRAFFIC_BULK;
+    }
+    return WEB_TRAFFIC_API;
+}
+
+struct TokenBucketLimit {
+    uint16_t perMinute;
+    uint16_t burst;
+};
+
+struct TokenBucket {
+    uint32_t milliTokens;
+    uint32_t lastMs;
+
+    void fill(const TokenBucketLimit& limit, uint32_t nowMs) {
+        milliTokens = (uint32_t)limit.burst * 1000;
+        lastMs = nowMs;
+    }
+
+    /**
+     * @brief Refills for the time since the last call, then takes one token.
+     * @return 0 if taken, else the seconds until a token is due (Retry-After)
+     */
+    uint32_t take(const TokenBucketLimit& limit, uint32_t nowMs) {
+        uint64_t refill = (uint64_t)(nowMs - lastMs) * limit.perMinute / 60; // Thousandths per ms = perMinute / 60000
+        uint32_t cap = (uint32_t)limit.burst * 1000;
+        milliTokens = refill >= cap - milliTokens ? cap : milliTokens + (uint32_t)refill;
+        lastMs = nowMs;
+        if (milliTokens >= 1000) {
+            milliTokens -= 1000;
+            return 0;
+        }
+        if (limit.perMinute == 0) return 3600;
+        uint32_t waitMs = (uint32_t)(((uint64_t)(1000 - milliTokens) * 60 + limit.perMinute - 1) / limit.perMinute);
+        return (waitMs + 999) / 1000;
+    }
+};
+
+template <uint8_t N>
+class ClientRateTable {
+public:
+    struct Entry {
+        uint32_t ip;        ///< 0: unused
+        uint32_t lastMs;
+        uint32_t limited;   ///< Requests refused since the entry was created
+        TokenBucket buckets[WEB_TRAFFIC_CLASSES - 1]; ///< API, BULK
+    };
+
+    ClientRateTable(TokenBucketLimit api, TokenBucketLimit bulk) {
+        limits_[0] = api;
+        limits_[1] = bulk;
+        clear();
+    }
+
+    void clear() {
+        memset(entries_, 0, sizeof(entries_));
+        evictions_ = 0;
+    }
+
+    /**
+     * @brief Charges one request of class @p cls to @p ip.
+     * @return 0 if admitted, else the seconds the client should wait
+     */
+    uint32_t admit(uint32_t ip, uint8_t cls, uint32_t nowMs) {
+        if (cls == WEB_TRAFFIC_PRIORITY || cls >= WEB_TRAFFIC_CLASSES) return 0;
+        Entry& e = lookup(ip, nowMs);
+        e.lastMs = nowMs;
+        uint32_t wait = e.buckets[cls - 1].take(limits_[cls - 1], nowMs);
+        if (wait) e.limited++;
+        return wait;
+    }
+
+    uint8_t clients() const {
+        uint8_t n = 0;
+        for (uint8_t i = 0; i < N; i++) n += entries_[i].ip != 0;
+        return n;
+    }
+
+    uint32_t evictions() const { return evictions_; }
+
+    /// Entry with the most refusals, or nullptr if none was refused.
+    const Entry* worst() const {
+        const Entry* w = nullptr;
+        for (uint8_t i = 0; i < N; i++) {
+            if (entries_[i].ip && entries_[i].limited && (!w || entries_[i].limited > w->limited)) w = &entries_[i];
+        }
+        return w;
+    }
+
+private:
+    Entry& lookup(uint32_t ip, uint32_t nowMs) {
+        Entry* victim = &entries_[0];
+        for (uint8_t i = 0; i < N; i++) {
+            Entry& e = entries_[i];
+            if (e.ip == ip) return e;
+            // Prefer an unused slot, else the least recently seen client
+            if (victim->ip && (!e.ip || (int32_t)(e.lastMs - victim->lastMs) < 0)) victim = &e;
+        }
+        if (victim->ip) evictions_++;
+        victim->ip = ip;
+        victim->limited = 0;
+        for (uint8_t c = 0; c < WEB_TRAFFIC_CLASSES - 1; c++) victim->buckets[c].fill(limits_[c], nowMs);
+        return *victim;
+    }
+
+    TokenBucketLimit limits_[WEB_TRAFFIC_CLASSES - 1];
+    Entry entries_[N];
+    uint32_t evictions_;
+};
+
+#endif // RATE_LIMIT_H
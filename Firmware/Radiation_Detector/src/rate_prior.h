@@ -0,0 +1,108 @@
+#ifndef RATE_PRIOR_H
+#define RATE_PRIOR_H
+
+#include <math.h>
+#include <stdint.h>
+
+// Gamma prior on the count rate for the first minutes after boot.
+// Right after power-on the adaptive window (adaptive_rate.h) holds a few
+// seconds, so its rate is mostly noise. With a prior Gamma(a, b) on the rate
+// in counts per second, taken from the background the last session saved
+// (mean m, 1-sigma s: b = m / s^2 seconds, a = m b), n counts in t seconds
+// give the posterior Gamma(a + n, b + t): mean (a + n) / (b + t), 1-sigma
+// sqrt(a + n) / (b + t). The reading is the prior mean before the first
+// second closes and the plain window mean once t >> b; b is capped so the
+// prior never weighs more than a set number of seconds of data.
+//
+// The prior only describes the seconds since boot, so it is released for good
+// once the adaptive window no longer covers all of them (it collapsed on a
+// change or reached its maximum), or when the counts contradict it: more than
+// a set number of sigmas of the prior predictive (negative binomial, mean
+// m t, variance m t + m t^2 / b) apart, as when the unit is switched on next
+// to a source. From then on the caller uses the adaptive rate again.
+// No Arduino dependencies (host-compilable).
+
+class RatePrior {
+public:
+    enum State : uint8_t {
+        NONE = 0,          ///< No prior was armed
+        ACTIVE,
+        RELEASED,          ///< The window outgrew it (or restarted)
+        CONFLICT           ///< The counts contradicted it
+    };
+
+    RatePrior() : state_(NONE), alpha_(0.0f), beta_(0.0f), counts_(0), seconds_(0), releasedAt_(0) {}
+
+    /**
+     * @brief Arms the prior.
+     * @param cps         Prior mean, counts per second
+     * @param sigmaCps    Its 1-sigma
+     * @param maxSeconds  Most data seconds the prior may weigh
+     */
+    void begin(float cps, float sigmaCps, float maxSeconds) {
+        if (!(cps > 0.0f) || !(sigmaCps > 0.0f) || !(maxSeconds > 0.0f)) return;
+        beta_ = cps / (sigmaCps * sigmaCps);
+        if (beta_ > maxSeconds) beta_ = maxSeconds;
+        alpha_ = cps * beta_;
+        counts_ = 0;
+        seconds_ = 0;
+        state_ = ACTIVE;
+    }
+
+    /**
+     * @brief Takes the adaptive window as it stands.
+     * @param windowCounts   Counts in the window
+     * @param windowSeconds  Its length
+     * @param secondsClosed  Seconds closed since boot
+     * @param conflictZ      Prior predictive sigmas that release the prior
+     * @return true while the prior applies
+     */
+    bool update(uint32_t windowCounts, uint32_t windowSeconds, uint32_t secondsClosed, float conflictZ) {
+        if (state_ != ACTIVE) return false;
+        if (windowSeconds < secondsClosed) return release(RELEASED, secondsClosed);
+        float mean = alpha_ / beta_;
+        float expected = mean * windowSeconds;
+        float variance = expected + expected * windowSeconds / beta_;
+        if (windowSeconds > 0 &&
+            fabsf((float)windowCounts - expected) > conflictZ * sqrtf(variance > 1.0f ? variance : 1.0f)) {
+            return release(CONFLICT, secondsClosed);
+        }
+        counts_ = windowCounts;
+        seconds_ = windowSeconds;
+        return true;
+    }
+
+    bool active() const { return state_ == ACTIVE; }
+    State state() const { return state_; }
+
+    /// Posterior mean, counts per second.
+    float cps() const { return beta_ + seconds_ > 0.0f ? (alpha_ + counts_) / (beta_ + seconds_) : 0.0f; }
+
+    /// Posterior 1-sigma, counts per second.
+    float sigmaCps() const { return beta_ + seconds_ > 0.0f ? sqrtf(alpha_ + counts_) / (beta_ + seconds_) : 0.0f; }
+
+    /// The posterior as the Poisson counts and seconds that would give it, for
+    /// count-statistics intervals (count_statistics.h).
+    float effectiveCounts() const { return alpha_ + counts_; }
+    float effectiveSeconds() const { return beta_ + seconds_; }
+
+    float priorCps() const { return beta_ > 0.0f ? alpha_ / beta_ : 0.0f; }
+    float priorSeconds() const { return beta_; }
+    uint32_t releasedAt() const { return releasedAt_; }   ///< Seconds since boot
+
+private:
+    bool release(State state, uint32_t secondsClosed) {
+        state_ = state;
+        releasedAt_ = secondsClosed;
+        return false;
+    }
+
+    State state_;
+    float alpha_;
+    float beta_;
+    uint32_t counts_;
+    uint32_t seconds_;
+    uint32_t releasedAt_;
+};
+
+#endif // RATE_PRIOR_H
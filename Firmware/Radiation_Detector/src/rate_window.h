@@ -0,0 +1,86 @@
+#ifndef RATE_WINDOW_H
+#define RATE_WINDOW_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Sliding-window pulse rates over 1-second buckets.
+// One ring of per-second counts serves several window lengths; each window keeps
+// a running sum that is updated incrementally when a bucket is pushed, so reading
+// any window is O(1). No Arduino dependencies (host-compilable).
+
+enum RateWindowId {
+    RATE_WINDOW_10S  = 0, ///< Fast-response window
+    RATE_WINDOW_60S  = 1, ///< Standard CPM window
+    RATE_WINDOW_300S = 2, ///< Low-noise window
+    RATE_WINDOW_COUNT
+};
+
+class RateWindows {
+public:
+    static const uint16_t CAPACITY = 300; ///< Seconds of history kept (longest window)
+
+    RateWindows() { clear(); }
+
+    /// Resets all buckets and sums.
+    void clear() {
+        for (size_t i = 0; i < CAPACITY; i++) buckets_[i] = 0;
+        for (size_t w = 0; w < RATE_WINDOW_COUNT; w++) sums_[w] = 0;
+        head_ = 0;
+        filled_ = 0;
+    }
+
+    /**
+     * @brief Appends the count of one completed second. O(windows).
+     *
+     * For every window that is already full, the bucket falling out of it is
+     * subtracted before the new one is added. For the longest window that is the
+     * slot about to be overwritten, so it is read before the write.
+     */
+    void push(uint32_t countsThisSecond) {
+        for (size_t w = 0; w < RATE_WINDOW_COUNT; w++) {
+            uint16_t len = length((RateWindowId)w);
+            if (filled_ >= len) {
+                sums_[w] -= buckets_[(head_ + CAPACITY - len) % CAPACITY];
+            }
+            sums_[w] += countsThisSecond;
+        }
+        buckets_[head_] = countsThisSecond;
+        head_ = (head_ + 1) % CAPACITY;
+        if (filled_ < CAPACITY) filled_++;
+    }
+
+    /// Sum of counts inside the window.
+    uint32_t sum(RateWindowId w) const { return sums_[w]; }
+
+    /// Seconds of data currently inside the window (<= window length).
+    uint16_t seconds(RateWindowId w) const {
+        return filled_ < length(w) ? filled_ : length(w);
+    }
+
+    /// Nominal window length in seconds.
+    static uint16_t length(RateWindowId w) {
+        static const uint16_t WINDOW_SECONDS[RATE_WINDOW_COUNT] = {10, 60, 300};
+        return WINDOW_SECONDS[w];
+    }
+
+    /// Counts per minute over the window, extrapolated while it is still filling.
+    float cpm(RateWindowId w) const {
+        uint16_t secs = seconds(w);
+        if (secs == 0) return 0.0f;
+        return (float)sums_[w] * 60.0f / (float)secs;
+    }
+
+    /// Count of the most recently completed second.
+    uint32_t lastBucket() const {
+        return filled_ ? buckets_[(head_ + CAPACITY - 1) % CAPACITY] : 0;
+    }
+
+private:
+    uint32_t buckets_[CAPACITY];
+    uint32_t sums_[RATE_WINDOW_COUNT];
+    uint16_t head_;
+    uint16_t filled_;
+};
+
+#endif // RATE_WINDOW_H
@@ -0,0 +1,451 @@
+/**
+ * @file readout_sprite.cpp
+ * @brief Off-screen frames for the readout labels, pushed to the panel by column range.
+ *
+ * A label in direct mode gets a fixed width (the frame's) and centred text,
+ * so LVGL lays it out exactly where the size-to-content label was, and its
+ * own text stops changing: nothing invalidates it on a new value. The glyphs
+ * are placed with lv_draw_label()'s arithmetic (pen advance with kerning,
+ * letter space, centring) and blended like LVGL's masked fill, so a frame
+ * copied by the label's draw and one pushed directly look the same.
+ *
+ * The dirty columns of an update are the cells (advance or ink box, the wider)
+ * of the glyphs that differ between the old and the new text at the same pen
+ * position. They are re-rendered in the frame, byte-swapped into one half of
+ * a small DMA-capable bounce buffer and queued on the display DMA; the halves
+ * alternate, and displayPortPushRect() returns once the previous push is out.
+ */
+
+#include "config.h"
+
+#if !HEADLESS
+
+#include "readout_sprite.h"
+#include "display_port.h"
+#include <src/draw/sw/lv_draw_sw.h> // lv_draw_sw_blend(), not exported by lvgl.h
+#include "esp_heap_caps.h"
+#include <string.h>
+
+extern "C" const uint8_t _lv_bpp1_opa_table[2];
+extern "C" const uint8_t _lv_bpp2_opa_table[4];
+extern "C" const uint8_t _lv_bpp4_opa_table[16];
+extern "C" const uint8_t _lv_bpp8_opa_table[256];
+
+static const uint32_t BOUNCE_PIXELS = 2048; ///< Per half; a 60 px line font pushes ~34 columns per chunk
+
+struct Readout {
+    lv_obj_t* label;
+    lv_color_t* frame;    ///< w x h, native RGB565, PSRAM if present
+    lv_coord_t w, h;
+    bool direct;          ///< Label drawn from the frame
+    // Style the frame was rendered with
+    const lv_font_t* font;
+    lv_color_t color;
+    lv_color_t bg;
+    lv_coord_t letterSpace;
+    // Text in the frame, one ASCII glyph per character
+    uint8_t count;
+    char text[READOUT_SPRITE_MAX_CHARS + 1];
+    int16_t pen[READOUT_SPRITE_MAX_CHARS];
+};
+
+static Readout* readouts[READOUT_SPRITE_MAX] = {};
+static uint16_t* bounce = nullptr;
+static uint8_t bounceHalf = 0;
+static bool enabled = true;
+static ReadoutSpriteStats stats;
+
+static const uint8_t* opaTable(uint8_t bpp) {
+    switch (bpp) {
+    case 1: return _lv_bpp1_opa_table;
+    case 2: return _lv_bpp2_opa_table;
+    case 4: return _lv_bpp4_opa_table;
+    case 8: return _lv_bpp8_opa_table;
+    default: return nullptr;
+    }
+}
+
+static Readout* findReadout(const lv_obj_t* label) {
+    for (uint8_t i = 0; i < READOUT_SPRITE_MAX; i++) {
+        if (readouts[i] && readouts[i]->label == label) return readouts[i];
+    }
+    return nullptr;
+}
+
+/**
+ * @brief The parent's background, if it is one opaque colour.
+ */
+static bool plainBackground(const lv_obj_t* label, lv_color_t* bg) {
+    const lv_obj_t* parent = lv_obj_get_parent(label);
+    if (!parent || lv_obj_get_style_bg_opa(parent, LV_PART_MAIN) < LV_OPA_COVER) return false;
+    if (lv_obj_get_style_bg_grad_dir(parent, LV_PART_MAIN) != LV_GRAD_DIR_NONE) return false;
+    if (lv_obj_get_style_bg_img_src(parent, LV_PART_MAIN)) return false;
+    *bg = lv_obj_get_style_bg_color(parent, LV_PART_MAIN);
+    return true;
+}
+
+/**
+ * @brief Pen positions of @p text from x = 0, as lv_draw_label() advances them.
+ * @return the line width as lv_txt_get_width() gives it, -1 if a glyph cannot be drawn
+ */
+static int32_t layoutText(const lv_font_t* font, lv_coord_t letterSpace, const char* text, int16_t* pen) {
+    int32_t x = 0;
+    int32_t width = 0;
+    for (uint8_t i = 0; text[i]; i++) {
+        uint8_t letter = (uint8_t)text[i];
+        if (letter >= 128 || i >= READOUT_SPRITE_MAX_CHARS) return -1;
+        lv_font_glyph_dsc_t g;
+        if (!lv_font_get_glyph_dsc(font, &g, letter, (uint8_t)text[i + 1])) return -1;
+        if (g.box_w && g.box_h && !opaTable(g.bpp)) return -1;
+        if (pen) pen[i] = (int16_t)x;
+        uint16_t advance = lv_font_get_glyph_width(font, letter, (uint8_t)text[i + 1]);
+        x += advance + letterSpace;
+        if (advance > 0) width += advance + letterSpace;
+    }
+    if (width > 0) width -= letterSpace;
+    return width;
+}
+
+/**
+ * @brief Columns [x1, x2) a glyph at @p pen touches: its advance and its ink box.
+ */
+static void glyphCells(const Readout* r, uint8_t i, int32_t* x1, int32_t* x2) {
+    lv_font_glyph_dsc_t g;
+    lv_font_get_glyph_dsc(r->font, &g, (uint8_t)r->text[i], (uint8_t)r->text[i + 1]);
+    int32_t from = r->pen[i] + (g.ofs_x < 0 ? g.ofs_x : 0);
+    int32_t to = r->pen[i] + (g.ofs_x + g.box_w > g.adv_w ? g.ofs_x + g.box_w : g.adv_w);
+    if (from < *x1) *x1 = from;
+    if (to > *x2) *x2 = to;
+}
+
+/**
+ * @brief Renders columns [x1, x2) of the frame from the background and r->text.
+ */
+static void renderColumns(Readout* r, int32_t x1, int32_t x2) {
+    if (x1 < 0) x1 = 0;
+    if (x2 > r->w) x2 = r->w;
+    if (x1 >= x2) return;
+    for (lv_coord_t y = 0; y < r->h; y++) {
+        lv_color_t* row = r->frame + (uint32_t)y * r->w;
+        for (int32_t x = x1; x < x2; x++) row[x] = r->bg;
+    }
+
+    lv_coord_t top = r->font->line_height - r->font->base_line;
+    for (uint8_t i = 0; i < r->count; i++) {
+        uint8_t letter = (uint8_t)r->text[i];
+        lv_font_glyph_dsc_t g;
+        if (!lv_font_get_glyph_dsc(r->font, &g, letter, (uint8_t)r->text[i + 1])) continue;
+        if (!g.box_w || !g.box_h) continue;
+        int32_t gx = r->pen[i] + g.ofs_x;
+        int32_t gy = top - g.box_h - g.ofs_y;
+        if (gx >= x2 || gx + g.box_w <= x1) continue;
+        // Compressed fonts decompress into a shared buffer: use it right away
+        const uint8_t* bitmap = lv_font_get_glyph_bitmap(g.resolved_font, letter);
+        const uint8_t* table = opaTable(g.bpp);
+        if (!bitmap || !table) continue;
+        uint8_t mask = (1 << g.bpp) - 1;
+        for (int32_t row = 0; row < g.box_h; row++) {
+            int32_t y = gy + row;
+            if (y < 0 || y >= r->h) continue;
+            lv_color_t* dst = r->frame + (uint32_t)y * r->w;
+            for (int32_t col = 0; col < g.box_w; col++) {
+                int32_t x = gx + col;
+                if (x < x1 || x >= x2) continue;
+                uint32_t bit = ((uint32_t)row * g.box_w + col) * g.bpp;
+                lv_opa_t a = table[(bitmap[bit >> 3] >> (8 - (bit & 7) - g.bpp)) & mask];
+                // As LVGL's masked fill at full opacity
+                if (a >= LV_OPA_MAX) dst[x] = r->color;
+                else if (a > LV_OPA_MIN) dst[x] = lv_color_mix(r->color, dst[x], a);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Takes the label's current text style. @return true if it differs from the frame's
+ */
+static bool refreshStyle(Readout* r, bool* usable) {
+    lv_draw_label_dsc_t dsc;
+    lv_draw_label_dsc_init(&dsc);
+    lv_obj_init_draw_label_dsc(r->label, LV_PART_MAIN, &dsc);
+    lv_color_t bg;
+    *usable = plainBackground(r->label, &bg) && dsc.opa >= LV_OPA_MAX && dsc.font &&
+              dsc.font->subpx == LV_FONT_SUBPX_NONE && dsc.decor == LV_TEXT_DECOR_NONE &&
+              dsc.font->line_height <= r->h;
+    if (!*usable) return false;
+    bool changed = dsc.font != r->font || dsc.color.full != r->color.full || bg.full != r->bg.full ||
+                   dsc.letter_space != r->letterSpace;
+    r->font = dsc.font;
+    r->color = dsc.color;
+    r->bg = bg;
+    r->letterSpace = dsc.letter_space;
+    return changed;
+}
+
+/**
+ * @brief Lays @p text out centred in the frame. @return false if it does not fit or cannot be drawn
+ */
+static bool setLayout(Readout* r, const char* text) {
+    int16_t pen[READOUT_SPRITE_MAX_CHARS];
+    int32_t width = layoutText(r->font, r->letterSpace, text, pen);
+    if (width < 0 || width > r->w) return false;
+    uint8_t count = (uint8_t)strlen(text);
+    int32_t offset = (r->w - width) / 2; // As lv_draw_label() for LV_TEXT_ALIGN_CENTER
+    for (uint8_t i = 0; i < count; i++) r->pen[i] = (int16_t)(pen[i] + offset);
+    memcpy(r->text, text, count + 1);
+    r->count = count;
+    return true;
+}
+
+static void enterDirect(Readout* r) {
+    r->direct = true;
+    lv_obj_set_style_text_align(r->label, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN);
+    lv_obj_set_width(r->label, r->w);
+    lv_label_set_text(r->label, r->text); // Fits the width; stays until the label leaves direct mode
+    renderColumns(r, 0, r->w);
+}
+
+static void leaveDirect(Readout* r, const char* text) {
+    r->direct = false;
+    lv_obj_set_width(r->label, LV_SIZE_CONTENT);
+    lv_label_set_text_static(r->label, text);
+}
+
+/**
+ * @brief Nothing but the label's parent draws over the frame's area on the panel right now.
+ */
+static bool panelShowsLabel(const Readout* r, const lv_area_t* area) {
+    lv_disp_t* disp = lv_obj_get_disp(r->label);
+    if (!disp || lv_obj_get_screen(r->label) != lv_disp_get_scr_act(disp)) return false;
+    if (disp->prev_scr || disp->scr_to_load) return false; // Screen animation
+    if (lv_obj_has_flag(r->label, LV_OBJ_FLAG_HIDDEN)) return false;
+    if (area->x1 < 0 || area->y1 < 0 || area->x2 >= lv_disp_get_hor_res(disp) ||
+        area->y2 >= lv_disp_get_ver_res(disp)) {
+        return false;
+    }
+    lv_obj_t* layers[2] = {lv_disp_get_layer_top(disp), lv_disp_get_layer_sys(disp)};
+    for (uint8_t l = 0; l < 2; l++) {
+        uint32_t children = lv_obj_get_child_cnt(layers[l]);
+        for (uint32_t c = 0; c < children; c++) {
+            lv_obj_t* child = lv_obj_get_child(layers[l], c);
+            lv_area_t overlap;
+            if (!lv_obj_has_flag(child, LV_OBJ_FLAG_HIDDEN) && _lv_area_intersect(&overlap, area, &child->coords)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Sends columns [x1, x2) of the frame at the label's position.
+ */
+static bool pushColumns(Readout* r, const lv_area_t* coords, int32_t x1, int32_t x2) {
+    uint16_t w = (uint16_t)(x2 - x1);
+    uint16_t rowsPerChunk = BOUNCE_PIXELS / w;
+    if (!rowsPerChunk) return false;
+    bool sent = true;
+    for (lv_coord_t y = 0; y < r->h && sent; y += rowsPerChunk) {
+        uint16_t rows = (y + rowsPerChunk <= r->h) ? rowsPerChunk : (uint16_t)(r->h - y);
+        uint16_t* out = bounce + bounceHalf * BOUNCE_PIXELS;
+        for (uint16_t row = 0; row < rows; row++) {
+            const lv_color_t* src = r->frame + (uint32_t)(y + row) * r->w + x1;
+            for (uint16_t x = 0; x < w; x++) {
+                uint16_t c = src[x].full;
+                *out++ = (uint16_t)(c << 8 | c >> 8); // Panel byte order, as the flush sends it
+            }
+        }
+        sent = displayPortPushRect(coords->x1 + x1, coords->y1 + y, w, rows, bounce + bounceHalf * BOUNCE_PIXELS);
+        if (sent) bounceHalf ^= 1;
+    }
+    displayPortFlushWait(); // Frees the bus for the SD card; no refresh may follow to do it
+    if (sent) stats.pushedPixels += (uint32_t)w * r->h;
+    return sent;
+}
+
+static void drawCb(lv_event_t* e) {
+    Readout* r = (Readout*)lv_event_get_user_data(e);
+    if (!r->direct) return;
+    bool usable;
+    if (refreshStyle(r, &usable)) renderColumns(r, 0, r->w);
+    if (!usable) return; // Drawn as it stands; the next update leaves direct mode
+
+    // The label's draw is replaced: base first, as lv_label_event() does
+    if (lv_obj_event_base(&lv_label_class, e) != LV_RES_OK) return;
+    lv_event_stop_processing(e);
+
+    lv_area_t area;
+    lv_obj_get_content_coords(r->label, &area);
+    area.x2 = area.x1 + r->w - 1;
+    area.y2 = area.y1 + r->h - 1;
+    lv_draw_sw_blend_dsc_t blend;
+    lv_memset_00(&blend, sizeof(blend));
+    blend.blend_area = &area;
+    blend.src_buf = r->frame;
+    blend.opa = LV_OPA_COVER;
+    blend.blend_mode = LV_BLEND_MODE_NORMAL;
+    blend.mask_res = LV_DRAW_MASK_RES_FULL_COVER;
+    lv_draw_sw_blend(lv_event_get_draw_ctx(e), &blend);
+}
+
+static void deleteCb(lv_event_t* e) {
+    Readout* r = (Readout*)lv_event_get_user_data(e);
+    for (uint8_t i = 0; i < READOUT_SPRITE_MAX; i++) {
+        if (readouts[i] == r) readouts[i] = nullptr;
+    }
+    heap_caps_free(r->frame);
+    heap_caps_free(r);
+}
+
+bool readoutSpriteAttach(lv_obj_t* label, const char* widest) {
+    if (findReadout(label)) return true;
+    int8_t slot = -1;
+    for (uint8_t i = 0; i < READOUT_SPRITE_MAX; i++) {
+        if (!readouts[i]) {
+            slot = (int8_t)i;
+            break;
+        }
+    }
+    if (slot < 0) return false;
+
+    Readout probe;
+    memset(&probe, 0, sizeof(probe));
+    probe.label = label;
+    probe.h = LV_COORD_MAX;
+    bool usable;
+    refreshStyle(&probe, &usable);
+    if (!usable) return false;
+    int32_t width = layoutText(probe.font, probe.letterSpace, widest, nullptr);
+    if (width <= 0) return false;
+    probe.w = (lv_coord_t)width;
+    probe.h = probe.font->line_height;
+
+    // The fixed-width box around the label's current centre must not cover anything else
+    lv_obj_update_layout(label);
+    lv_area_t box;
+    lv_obj_get_content_coords(label, &box);
+    box.x1 = (box.x1 + box.x2) / 2 - probe.w / 2;
+    box.x2 = box.x1 + probe.w - 1;
+    box.y2 = box.y1 + probe.h - 1;
+    lv_obj_t* parent = lv_obj_get_parent(label);
+    for (uint32_t c = 0; c < lv_obj_get_child_cnt(parent); c++) {
+        lv_obj_t* sibling = lv_obj_get_child(parent, c);
+        lv_area_t overlap;
+        if (sibling != label && !lv_obj_has_flag(sibling, LV_OBJ_FLAG_HIDDEN) &&
+            _lv_area_intersect(&overlap, &box, &sibling->coords)) {
+            return false;
+        }
+    }
+
+    if (!bounce) {
+        bounce = (uint16_t*)heap_caps_malloc(2 * BOUNCE_PIXELS * sizeof(uint16_t), MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+        if (!bounce) return false;
+    }
+    Readout* r = (Readout*)heap_caps_malloc(sizeof(Readout), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (!r) return false;
+    *r = probe;
+    size_t frameBytes = (size_t)r->w * r->h * sizeof(lv_color_t);
+    r->frame = (lv_color_t*)heap_caps_malloc(frameBytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!r->frame) r->frame = (lv_color_t*)heap_caps_malloc(frameBytes, MALLOC_CAP_8BIT);
+    if (!r->frame) {
+        heap_caps_free(r);
+        return false;
+    }
+    readouts[slot] = r;
+    lv_obj_add_event_cb(label, drawCb, (lv_event_code_t)(LV_EVENT_DRAW_MAIN | LV_EVENT_PREPROCESS), r);
+    lv_obj_add_event_cb(label, deleteCb, LV_EVENT_DELETE, r);
+    return true;
+}
+
+void readoutSpriteSetText(lv_obj_t* label, const char* text) {
+    Readout* r = findReadout(label);
+    if (!r) {
+        lv_label_set_text_static(label, text);
+        return;
+    }
+
+    bool usable;
+    bool restyled = refreshStyle(r, &usable);
+    if (!enabled || !usable) {
+        // The caller's buffer may be the one the label shows, rewritten in place
+        if (r->direct || lv_label_get_text(label) == text || strcmp(lv_label_get_text(label), text) != 0) {
+            leaveDirect(r, text);
+        }
+        stats.fallbackUpdates++;
+        return;
+    }
+    if (!r->direct || restyled) {
+        if (!setLayout(r, text)) {
+            if (r->direct) leaveDirect(r, text);
+            else lv_label_set_text_static(label, text);
+            stats.fallbackUpdates++;
+            return;
+        }
+        if (r->direct) {
+            renderColumns(r, 0, r->w);
+            lv_obj_invalidate(label);
+        } else {
+            enterDirect(r); // LVGL redraws the label from the frame
+        }
+        stats.fallbackUpdates++;
+        return;
+    }
+
+    // Dirty columns: glyphs of the old text that are gone, then the new ones that were not there
+    Readout old = *r;
+    if (!setLayout(r, text)) {
+        leaveDirect(r, text);
+        stats.fallbackUpdates++;
+        return;
+    }
+    int32_t x1 = r->w;
+    int32_t x2 = 0;
+    for (uint8_t i = 0; i < old.count; i++) {
+        bool kept = false;
+        for (uint8_t j = 0; j < r->count && !kept; j++) {
+            kept = old.pen[i] == r->pen[j] && old.text[i] == r->text[j] && old.text[i + 1] == r->text[j + 1];
+        }
+        if (!kept) glyphCells(&old, i, &x1, &x2);
+    }
+    for (uint8_t j = 0; j < r->count; j++) {
+        bool kept = false;
+        for (uint8_t i = 0; i < old.count && !kept; i++) {
+            kept = old.pen[i] == r->pen[j] && old.text[i] == r->text[j] && old.text[i + 1] == r->text[j + 1];
+        }
+        if (!kept) glyphCells(r, j, &x1, &x2);
+    }
+    if (x1 < 0) x1 = 0;
+    if (x2 > r->w) x2 = r->w;
+    if (x1 >= x2) return;
+    renderColumns(r, x1, x2);
+
+    lv_area_t coords;
+    lv_obj_get_content_coords(label, &coords);
+    lv_area_t dirty = {(lv_coord_t)(coords.x1 + x1), coords.y1, (lv_coord_t)(coords.x1 + x2 - 1),
+                       (lv_coord_t)(coords.y1 + r->h - 1)};
+    if (panelShowsLabel(r, &dirty) && pushColumns(r, &coords, x1, x2)) {
+        stats.directUpdates++;
+    } else {
+        lv_obj_invalidate_area(label, &dirty); // The label's draw copies the frame
+        stats.fallbackUpdates++;
+    }
+}
+
+void readoutSpriteSetEnabled(bool on) {
+    enabled = on;
+    if (on) return;
+    for (uint8_t i = 0; i < READOUT_SPRITE_MAX; i++) {
+        Readout* r = readouts[i];
+        if (r && r->direct) leaveDirect(r, r->text);
+    }
+}
+
+bool readoutSpriteEnabled() {
+    return enabled;
+}
+
+ReadoutSpriteStats getReadoutSpriteStats() {
+    return stats;
+}
+
+#endif // !HEADLESS
@@ -0,0 +1,50 @@
+#ifndef READOUT_SPRITE_H
+#define READOUT_SPRITE_H
+
+#include <Arduino.h>
+#include <lvgl.h>
+
+// Direct-to-panel path for fixed-position value labels (the main screen
+// readouts). Each attached label gets an off-screen RGB565 frame in PSRAM
+// covering the widest text it is expected to show. A new value is rendered
+// into that frame, and only the columns whose glyphs changed are sent to the
+// panel through the queued display DMA (displayPortPushRect()), without
+// invalidating the label. LVGL's layout and redraw are not involved.
+// When LVGL redraws the area for another reason (screen load, wake, an
+// overlay closing), the label's draw copies the frame. The update falls back
+// to a normal LVGL invalidate in these cases:
+//   - the screen is not the active one, or a screen animation is running
+//   - an object on the top or system layer overlaps the label
+//   - the panel sleeps or runs without DMA
+// The label goes back to plain LVGL text while the text does not fit the
+// frame. LVGL task only.
+
+#define READOUT_SPRITE_MAX 4          ///< Labels attached at once
+#define READOUT_SPRITE_MAX_CHARS 12   ///< Longest text drawn into a frame
+
+struct ReadoutSpriteStats {
+    uint32_t directUpdates;    ///< Values pushed straight to the panel
+    uint32_t fallbackUpdates;  ///< Values left to an LVGL redraw
+    uint32_t pushedPixels;     ///< Sum of the pushed dirty rectangles
+};
+
+// Gives @p label a frame as wide as @p widest in its current font. The label
+// has to sit on an opaque, plain parent background, with no other object
+// overlapping the frame. The frame is freed with the label.
+// @return false if the label does not qualify or there is no memory
+bool readoutSpriteAttach(lv_obj_t* label, const char* widest);
+
+// Text setter for attached labels (LabelBinding); plain
+// lv_label_set_text_static() for any other label. Whenever LVGL draws the
+// text it is @p text itself, so it has to outlive the next call (the
+// binding's buffer, or a literal).
+void readoutSpriteSetText(lv_obj_t* label, const char* text);
+
+// Updates go through LVGL while disabled (for comparisons).
+void readoutSpriteSetEnabled(bool enabled);
+
+bool readoutSpriteEnabled();
+
+ReadoutSpriteStats getReadoutSpriteStats();
+
+#endif // READOUT_SPRITE_H
@@ -0,0 +1,323 @@
+/**
+ * @file render_split.cpp
+ * @brief Large LVGL blends cut into two row bands, one per core.
+ *
+ * The lower band is posted as a job: a copy of the draw context with its own
+ * clip area, and the caller's descriptor, which stays valid because the
+ * caller does not return before the band is done. The job's state decides
+ * who blends it: the worker and the LVGL task both try to move it from
+ * POSTED to taken, and whoever succeeds does the band. If the worker won, the
+ * LVGL task waits on the done semaphore, which the worker gives once the
+ * band is in the buffer.
+ */
+
+#include "config.h"
+
+#if !HEADLESS
+
+#include "render_split.h"
+#include "debug.h"
+#include "ui_screens.h"
+#include <src/draw/sw/lv_draw_sw.h> // lv_draw_sw_ctx_t, not exported by lvgl.h
+#include "esp_heap_caps.h"
+#include <atomic>
+#include <stdlib.h>
+#include <string.h>
+
+typedef void (*BlendFunction)(lv_draw_ctx_t*, const lv_draw_sw_blend_dsc_t*);
+
+enum JobState : uint8_t { JOB_IDLE = 0, JOB_POSTED, JOB_WORKER, JOB_CALLER };
+
+struct Job {
+    lv_draw_sw_ctx_t ctx;                 ///< The caller's, clipped to the band
+    lv_area_t clip;
+    const lv_draw_sw_blend_dsc_t* dsc;
+};
+
+static BlendFunction nextBlend = lv_draw_sw_blend_basic;
+static void (*nextInit)(lv_disp_drv_t*, lv_draw_ctx_t*) = lv_draw_sw_init_ctx;
+static bool enabled = false;
+static uint32_t minPixels = RENDER_SPLIT_MIN_PIXELS; ///< 2 during the random blend check
+static TaskHandle_t worker = NULL;
+static SemaphoreHandle_t jobDone = NULL;
+static Job job;
+static std::atomic<uint8_t> jobState(JOB_IDLE);
+static RenderSplitStats stats;
+
+/**
+ * @brief Blends @p dsc into the rows y1..y2 of @p ctx's clip area only.
+ */
+static void blendRows(const lv_draw_sw_ctx_t* ctx, const lv_draw_sw_blend_dsc_t* dsc, const lv_area_t* clip) {
+    lv_draw_sw_ctx_t band = *ctx;
+    band.base_draw.clip_area = clip;
+    nextBlend(&band.base_draw, dsc);
+}
+
+static void workerTask(void* param) {
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        uint8_t expected = JOB_POSTED;
+        if (!jobState.compare_exchange_strong(expected, JOB_WORKER, std::memory_order_acquire)) continue;
+        uint32_t start = micros();
+        blendRows(&job.ctx, job.dsc, &job.clip);
+        stats.workerUs += micros() - start;
+        stats.workerPixels += (uint32_t)lv_area_get_size(&job.clip);
+        jobState.store(JOB_IDLE, std::memory_order_release);
+        xSemaphoreGive(jobDone);
+    }
+}
+
+/**
+ * @brief lv_draw_sw_ctx_t::blend
+ */
+static void splitBlend(lv_draw_ctx_t* ctx, const lv_draw_sw_blend_dsc_t* dsc) {
+    stats.blends++;
+    lv_area_t area;
+    if (!_lv_area_intersect(&area, dsc->blend_area, ctx->clip_area)) return;
+    lv_disp_t* disp = _lv_refr_get_disp_refreshing();
+    lv_coord_t rows = lv_area_get_height(&area);
+    if (!enabled || !worker || rows < 2 || (uint32_t)lv_area_get_size(&area) < minPixels || !disp ||
+        disp->driver->set_px_cb || disp->driver->screen_transp) {
+        nextBlend(ctx, dsc);
+        return;
+    }
+
+    lv_area_t upper = area;
+    upper.y2 = area.y1 + rows / 2 - 1;
+    job.ctx = *(lv_draw_sw_ctx_t*)ctx;
+    job.clip = area;
+    job.clip.y1 = upper.y2 + 1;
+    job.dsc = dsc;
+    jobState.store(JOB_POSTED, std::memory_order_release);
+    xTaskNotifyGive(worker);
+    stats.split++;
+
+    blendRows((lv_draw_sw_ctx_t*)ctx, dsc, &upper);
+
+    uint8_t expected = JOB_POSTED;
+    if (jobState.compare_exchange_strong(expected, JOB_CALLER, std::memory_order_acquire)) {
+        blendRows(&job.ctx, dsc, &job.clip);
+        jobState.store(JOB_IDLE, std::memory_order_relaxed);
+        stats.stolen++;
+    } else {
+        xSemaphoreTake(jobDone, portMAX_DELAY);
+    }
+}
+
+static void initCtx(lv_disp_drv_t* drv, lv_draw_ctx_t* ctx) {
+    nextInit(drv, ctx);
+    nextBlend = ((lv_draw_sw_ctx_t*)ctx)->blend;
+    ((lv_draw_sw_ctx_t*)ctx)->blend = splitBlend;
+}
+
+void renderSplitInstall(lv_disp_drv_t* drv) {
+    nextInit = drv->draw_ctx_init;
+    drv->draw_ctx_init = initCtx;
+    if (RENDER_SPLIT_CORES && !renderSplitSetEnabled(true)) {
+        DEBUG_PRINTLN("Render split: no worker, blending on one core");
+    }
+}
+
+bool renderSplitSetEnabled(bool on) {
+    if (on && !worker) {
+        jobDone = xSemaphoreCreateBinary();
+        if (!jobDone) return false;
+        // Same priority as the LVGL task: runs whenever its core has nothing more urgent
+        if (xTaskCreatePinnedToCore(workerTask, "RenderSplit", 3072, NULL, UI_TASK_PRIORITY, &worker,
+                                    1 - TASK_CORE_UI) != pdPASS) {
+            vSemaphoreDelete(jobDone);
+            jobDone = NULL;
+            worker = NULL;
+            return false;
+        }
+    }
+    enabled = on;
+    return true;
+}
+
+bool renderSplitEnabled() {
+    return enabled;
+}
+
+RenderSplitStats getRenderSplitStats() {
+    RenderSplitStats s = stats;
+    s.enabled = enabled;
+    s.running = worker != NULL;
+    return s;
+}
+
+/*******************************************************************************
+ * Checks
+ ******************************************************************************/
+
+static uint32_t testSeed = 1;
+
+static uint32_t testRandom() {
+    testSeed = testSeed * 1664525u + 1013904223u;
+    return testSeed >> 8;
+}
+
+static uint32_t countDiffering(const uint16_t* a, const uint16_t* b, uint32_t pixels) {
+    uint32_t differing = 0;
+    for (uint32_t i = 0; i < pixels; i++) {
+        if (a[i] != b[i]) differing++;
+    }
+    return differing;
+}
+
+/**
+ * @brief Random blends through the wrapped blend alone and through splitBlend().
+ */
+static uint32_t checkBlends(Print& out) {
+    const lv_coord_t W = 240;
+    const lv_coord_t H = 32;
+    const uint32_t pixels = (uint32_t)W * H;
+    uint16_t* wholeBuf = (uint16_t*)malloc(pixels * 2);
+    uint16_t* splitBuf = (uint16_t*)malloc(pixels * 2);
+    uint16_t* srcBuf = (uint16_t*)malloc(pixels * 2);
+    lv_opa_t* maskBuf = (lv_opa_t*)malloc(pixels);
+    uint32_t differing = 0;
+    if (!wholeBuf || !splitBuf || !srcBuf || !maskBuf) {
+        out.println("Render split check: out of memory");
+    } else {
+        lv_area_t bufArea;
+        lv_area_set(&bufArea, 0, 0, W - 1, H - 1);
+        lv_draw_sw_ctx_t ctxWhole;
+        memset(&ctxWhole, 0, sizeof(ctxWhole));
+        ctxWhole.base_draw.buf_area = &bufArea;
+        ctxWhole.base_draw.clip_area = &bufArea;
+        ctxWhole.blend = nextBlend;
+        lv_draw_sw_ctx_t ctxSplit = ctxWhole;
+        ctxWhole.base_draw.buf = wholeBuf;
+        ctxSplit.base_draw.buf = splitBuf;
+
+        testSeed = 3;
+        for (uint32_t i = 0; i < pixels; i++) srcBuf[i] = (uint16_t)testRandom();
+        for (uint16_t c = 0; c < 200; c++) {
+            for (uint32_t i = 0; i < pixels; i++) wholeBuf[i] = (uint16_t)testRandom();
+            memcpy(splitBuf, wholeBuf, pixels * 2);
+
+            lv_area_t area;
+            area.x1 = testRandom() % W;
+            area.y1 = testRandom() % H;
+            area.x2 = area.x1 + testRandom() % (W - area.x1);
+            area.y2 = area.y1 + testRandom() % (H - area.y1);
+            lv_draw_sw_blend_dsc_t dsc;
+            memset(&dsc, 0, sizeof(dsc));
+            dsc.blend_area = &area;
+            dsc.color.full = (uint16_t)testRandom();
+            dsc.opa = (c & 2) ? LV_OPA_COVER : (lv_opa_t)(1 + testRandom() % (LV_OPA_MAX - 1));
+            dsc.blend_mode = LV_BLEND_MODE_NORMAL;
+            dsc.mask_res = LV_DRAW_MASK_RES_FULL_COVER;
+            if (c & 1) {
+                for (uint32_t i = 0; i < (uint32_t)lv_area_get_size(&area); i++) maskBuf[i] = (lv_opa_t)testRandom();
+                dsc.mask_buf = maskBuf;
+                dsc.mask_area = &area;
+                dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+            }
+            if (c & 4) dsc.src_buf = (const lv_color_t*)srcBuf; // An image copy rather than a fill
+            nextBlend(&ctxWhole.base_draw, &dsc);
+            splitBlend(&ctxSplit.base_draw, &dsc);
+            differing += countDiffering(wholeBuf, splitBuf, pixels);
+        }
+        out.printf("Render split: 200 random blends, %lu pixels differ\n", (unsigned long)differing);
+    }
+    free(wholeBuf);
+    free(splitBuf);
+    free(srcBuf);
+    free(maskBuf);
+    return differing;
+}
+
+/**
+ * @brief The active screen rendered whole (lv_snapshot) with and without the split.
+ */
+static uint32_t checkFrame(Print& out) {
+    lv_obj_t* screen = lv_scr_act();
+    uint32_t size = lv_snapshot_buf_size_needed(screen, LV_IMG_CF_TRUE_COLOR);
+    uint16_t* whole = (uint16_t*)heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    uint16_t* split = (uint16_t*)heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    uint32_t differing = 0;
+    lv_img_dsc_t dsc;
+    if (!whole || !split) {
+        out.println("Render split frame check: no PSRAM for two frames");
+    } else {
+        bool was = enabled;
+        enabled = false;
+        lv_res_t a = lv_snapshot_take_to_buf(screen, LV_IMG_CF_TRUE_COLOR, &dsc, whole, size);
+        enabled = true;
+        uint32_t splitBefore = stats.split;
+        lv_res_t b = lv_snapshot_take_to_buf(screen, LV_IMG_CF_TRUE_COLOR, &dsc, split, size);
+        enabled = was;
+        if (a != LV_RES_OK || b != LV_RES_OK) {
+            out.println("Render split frame check: snapshot failed");
+        } else {
+            differing = countDiffering(whole, split, size / 2);
+            out.printf("Render split: %s frame, %lu blends split, %lu pixels differ\n",
+                       uiScreenName(uiScreenActive()), (unsigned long)(stats.split - splitBefore),
+                       (unsigned long)differing);
+        }
+    }
+    heap_caps_free(whole);
+    heap_caps_free(split);
+    return differing;
+}
+
+uint32_t renderSplitCheck(Print& out) {
+    if (!worker && !renderSplitSetEnabled(enabled)) {
+        out.println("Render split: worker could not be started");
+        return 0;
+    }
+    // lv_draw_sw_blend_basic() reads the driver flags of the refreshing display
+    lv_disp_t* previous = _lv_refr_get_disp_refreshing();
+    _lv_refr_set_disp_refreshing(lv_disp_get_default());
+    bool was = enabled;
+    enabled = true;
+    minPixels = 2; // Every blend of two rows or more
+    uint32_t differing = checkBlends(out);
+    minPixels = RENDER_SPLIT_MIN_PIXELS;
+    enabled = was;
+    _lv_refr_set_disp_refreshing(previous);
+    return differing + checkFrame(out);
+}
+
+/**
+ * @brief Mean and best time of @p frames full redraws of the active screen.
+ */
+static void timeRedraws(uint8_t frames, uint32_t* mean, uint32_t* best) {
+    lv_obj_t* screen = lv_scr_act();
+    uint32_t total = 0;
+    *best = UINT32_MAX;
+    for (uint8_t i = 0; i < frames; i++) {
+        lv_obj_invalidate(screen);
+        uint32_t start = micros();
+        lv_refr_now(NULL);
+        uint32_t us = micros() - start;
+        total += us;
+        if (us < *best) *best = us;
+    }
+    *mean = total / frames;
+}
+
+void renderSplitBench(Print& out, uint8_t frames) {
+    if (!lv_scr_act() || frames == 0) return;
+    if (!worker && !renderSplitSetEnabled(enabled)) {
+        out.println("Render split: worker could not be started");
+        return;
+    }
+    bool was = enabled;
+    uint32_t oneMean, oneBest, twoMean, twoBest;
+    enabled = false;
+    timeRedraws(frames, &oneMean, &oneBest);
+    uint32_t split = stats.split, stolen = stats.stolen;
+    enabled = true;
+    timeRedraws(frames, &twoMean, &twoBest);
+    enabled = was;
+    out.printf("Full redraw, one core: %lu us average, %lu us best of %u\n", (unsigned long)oneMean,
+               (unsigned long)oneBest, (unsigned)frames);
+    out.printf("Full redraw, split:    %lu us average, %lu us best; %lu blends split, %lu taken back\n",
+               (unsigned long)twoMean, (unsigned long)twoBest, (unsigned long)(stats.split - split),
+               (unsigned long)(stats.stolen - stolen));
+}
+
+#endif // !HEADLESS
@@ -0,0 +1,56 @@
+#ifndef RENDER_SPLIT_H
+#define RENDER_SPLIT_H
+
+#include <Arduino.h>
+#include <lvgl.h>
+#include "config.h"
+
+// Second core for the pixel work of full-screen redraws (experimental,
+// "render split"). LVGL 8's software renderer cannot draw two areas at once:
+// the draw mask stack, the image cache and the layer buffers are global, so
+// a stripe cannot be handed to the other core. What dominates a full redraw
+// is the blending, though: fills of backgrounds and image copies (a screen
+// backdrop, ui_backdrop.h, is one per stripe). Blending reads nothing but its
+// descriptor and writes only the rows it is given. So every blend of at least
+// RENDER_SPLIT_MIN_PIXELS is cut in two row bands: a worker on the core that
+// is not TASK_CORE_UI blends the lower band into the same draw buffer while
+// the LVGL task blends the upper one. If the worker has not picked the band
+// up by then (a busier task on its core), the LVGL task blends it itself, so
+// a redraw never waits for the other core to get scheduled.
+//
+// Each band goes through the blend that was installed before
+// (blend_rgb565.h or LVGL's), with the clip area narrowed to its rows, so the
+// pixels are the same as from one call. renderSplitCheck() verifies that on
+// random blends and on a whole frame of the active screen. Blends for
+// set_px_cb or transparent-screen drivers are never split. LVGL task only.
+
+struct RenderSplitStats {
+    bool enabled;
+    bool running;              ///< Worker task started
+    uint32_t blends;           ///< All blends since boot
+    uint32_t split;            ///< Cut in two
+    uint32_t stolen;           ///< Lower band blended by the LVGL task after all
+    uint32_t workerPixels;     ///< Blended by the worker
+    uint32_t workerUs;         ///< Its time doing so
+};
+
+// Wraps the blend of @p drv; call after blend565Install(), before
+// lv_disp_drv_register(). Starts the worker if RENDER_SPLIT_CORES.
+void renderSplitInstall(lv_disp_drv_t* drv);
+
+// Starts the worker on first use. @return false if it could not be started
+bool renderSplitSetEnabled(bool enabled);
+bool renderSplitEnabled();
+
+RenderSplitStats getRenderSplitStats();
+
+// Blends random fills and copies (opacity, masks, band sizes) whole and
+// split, then snapshots the active screen both ways, and compares them.
+// @return number of differing pixels (0 = identical)
+uint32_t renderSplitCheck(Print& out);
+
+// Times @p frames full redraws of the active screen with and without the
+// split and prints both (render and flush). Blocks the LVGL task meanwhile.
+void renderSplitBench(Print& out, uint8_t frames);
+
+#endif // RENDER_SPLIT_H
@@ -0,0 +1,82 @@
+#ifndef RING_HISTORY_H
+#define RING_HISTORY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Fixed-capacity time-ordered history with O(1) push and O(1) max.
+ *
+ * Values are stored in a ring; index 0 is always the oldest retained value and
+ * size() - 1 the newest, so charts and the web API read the same order.
+ * The maximum is tracked with a monotonic deque of sequence numbers: every push
+ * pops the dominated tail entries and expires the head once it leaves the ring,
+ * which is amortised O(1) and removes the per-interval rescans.
+ * No Arduino dependencies (host-compilable).
+ *
+ * @tparam T Value type (must support < and <=)
+ * @tparam N Capacity
+ */
+template <typename T, size_t N>
+class RingHistory {
+public:
+    RingHistory() { clear(); }
+
+    void clear() {
+        for (size_t i = 0; i < N; i++) values_[i] = T();
+        size_ = 0;
+        seq_ = 0;
+        dqHead_ = 0;
+        dqSize_ = 0;
+    }
+
+    /// Appends a value, evicting the oldest one once the ring is full.
+    void push(const T& value) {
+        uint32_t seq = seq_++;
+        values_[seq % N] = value;
+        if (size_ < N) size_++;
+
+        // Expire the deque head once its sequence number has left the ring
+        uint32_t oldestSeq = seq_ - (uint32_t)size_;
+        if (dqSize_ > 0 && dq_[dqHead_] < oldestSeq) {
+            dqHead_ = (dqHead_ + 1) % N;
+            dqSize_--;
+        }
+        // Drop candidates that can never be the max again
+        while (dqSize_ > 0 && valueAt(dq_[(dqHead_ + dqSize_ - 1) % N]) <= value) {
+            dqSize_--;
+        }
+        dq_[(dqHead_ + dqSize_) % N] = seq;
+        dqSize_++;
+    }
+
+    /// Number of values currently stored.
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    bool full() const { return size_ == N; }
+    static size_t capacity() { return N; }
+
+    /// Value by age order: 0 is the oldest retained value.
+    const T& operator[](size_t i) const { return valueAt(seq_ - (uint32_t)size_ + (uint32_t)i); }
+
+    /// Most recently pushed value (T() when empty).
+    T newest() const { return size_ ? valueAt(seq_ - 1) : T(); }
+
+    /// Largest retained value (T() when empty).
+    T max() const { return dqSize_ ? valueAt(dq_[dqHead_]) : T(); }
+
+    /// Total number of values ever pushed (monotonic, survives eviction).
+    uint32_t pushCount() const { return seq_; }
+
+private:
+    const T& valueAt(uint32_t seq) const { return values_[seq % N]; }
+
+    T values_[N];
+    size_t size_;
+    uint32_t seq_;
+    uint32_t dq_[N];
+    size_t dqHead_;
+    size_t dqSize_;
+};
+
+#endif // RING_HISTORY_H
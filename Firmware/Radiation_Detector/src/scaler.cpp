@@ -0,0 +1,451 @@
+/**
+ * @file scaler.cpp
+ * @brief Preset-time and preset-count runs on a PCNT unit gated by an RMT pulse.
+ *
+ * The gate is a single RMT transmission of all-high items, up to 2 x 32767 us
+ * each at 1 us per tick, generated into PSRAM for the run. The unit counts
+ * the Geiger input with its control input inhibiting it while low
+ * (lctrl_mode DISABLE); the control input reads the gate pin's own pad, which
+ * is set to input and output. Counts past the 16-bit limit are carried in an
+ * epoch like counter_channel.cpp's. A preset count of N is armed as the
+ * threshold N mod SCALER_HIGH_LIMIT in epoch N / SCALER_HIGH_LIMIT (or the
+ * high-limit event itself when the remainder is 0).
+ */
+
+#include "scaler.h"
+#include "event_journal.h"
+#include "time_base.h"
+#include "debug.h"
+#include "driver/gpio.h"
+#include "driver/pcnt.h"
+#include "driver/rmt.h"
+#include "esp_heap_caps.h"
+#include "esp_rom_gpio.h"
+#include "esp_timer.h"
+#include "hal/pcnt_ll.h"
+#include "soc/pcnt_struct.h"
+#include "soc/rmt_periph.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+static const pcnt_unit_t SCALER_UNIT = (pcnt_unit_t)SCALER_PCNT_UNIT;
+static const rmt_channel_t GATE_CHANNEL = (rmt_channel_t)SCALER_RMT_CHANNEL;
+static const uint8_t GATE_CLOCK_DIV = 80;       ///< 80 MHz APB / 80: 1 us per tick
+static const uint32_t MAX_HALF_US = 32767;
+static const int16_t SCALER_HIGH_LIMIT = 32767;
+static const uint32_t POLL_MS = 100;            ///< Live progress and stop requests
+
+static_assert(SCALER_PCNT_UNIT >= 2 && SCALER_PCNT_UNIT < 4, "PCNT units 0 and 1 are the counter channels'");
+static_assert(SCALER_RMT_CHANNEL >= 0 && SCALER_RMT_CHANNEL < 4, "Transmit channels are 0-3 on the ESP32-S3");
+
+static bool scalerReady = false;
+static volatile bool scalerRunning = false;
+static volatile bool stopRequested = false;
+static TaskHandle_t runTask = nullptr;
+static portMUX_TYPE resultLock = portMUX_INITIALIZER_UNLOCKED;
+static ScalerResult current;                    ///< resultLock
+static ScalerResult history[SCALER_HISTORY_SIZE];
+static uint8_t historyCount = 0;
+static uint8_t historyHead = 0;                 ///< Next slot to write
+static uint32_t runs = 0;
+
+// Shared with the ISR
+static volatile uint32_t epoch = 0;
+static volatile uint32_t wraps = 0;
+static volatile uint32_t targetEpoch = 0;
+static volatile int16_t targetRemainder = 0;
+static volatile bool armed = false;
+static volatile int64_t stopUs = 0;
+
+/**
+ * @brief PCNT events of the scaler unit: high-limit wraps and the preset count.
+ */
+static void IRAM_ATTR scalerIsr(void* arg) {
+    uint32_t status = 0;
+    pcnt_ll_get_event_status(&PCNT, SCALER_UNIT, &status);
+    bool reached = false;
+    if (status & PCNT_EVT_H_LIM) {
+        epoch = epoch + 1;
+        wraps = wraps + 1;
+        reached = targetRemainder == 0 && epoch == targetEpoch;
+    }
+    if ((status & PCNT_EVT_THRES_0) && targetRemainder != 0 && epoch == targetEpoch) reached = true;
+    if (!reached || !armed) return;
+
+    pcnt_ll_counter_pause(&PCNT, SCALER_UNIT);
+    stopUs = esp_timer_get_time();
+    armed = false;
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(runTask, &woken);
+    if (woken) portYIELD_FROM_ISR();
+}
+
+bool initScaler(uint8_t geigerPin, uint16_t filterCycles) {
+    if (SCALER_GATE_PIN < 0 || SCALER_GATE_PIN == geigerPin) return false;
+    gpio_num_t gatePin = (gpio_num_t)SCALER_GATE_PIN;
+
+    pcnt_config_t config = {};
+    config.pulse_gpio_num = geigerPin;
+    config.ctrl_gpio_num  = SCALER_GATE_PIN;
+    config.channel        = PCNT_CHANNEL_0;
+    config.unit           = SCALER_UNIT;
+    config.pos_mode       = PCNT_COUNT_INC;
+    config.neg_mode       = PCNT_COUNT_DIS;
+    config.lctrl_mode     = PCNT_MODE_DISABLE;   // Gate closed
+    config.hctrl_mode     = PCNT_MODE_KEEP;
+    config.counter_h_lim  = SCALER_HIGH_LIMIT;
+    config.counter_l_lim  = 0;
+    if (pcnt_unit_config(&config) != ESP_OK) {
+        DEBUG_PRINTF("Scaler: PCNT unit %d config failed\n", SCALER_PCNT_UNIT);
+        return false;
+    }
+    pcnt_set_filter_value(SCALER_UNIT, filterCycles);
+    pcnt_filter_enable(SCALER_UNIT);
+    pcnt_counter_pause(SCALER_UNIT);
+    pcnt_counter_clear(SCALER_UNIT);
+    pcnt_event_enable(SCALER_UNIT, PCNT_EVT_H_LIM);
+    esp_err_t err = pcnt_isr_service_install(ESP_INTR_FLAG_IRAM);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+        DEBUG_PRINTF("Scaler: PCNT ISR service install failed (%d)\n", err);
+        return false;
+    }
+    pcnt_isr_handler_add(SCALER_UNIT, scalerIsr, nullptr);
+
+    rmt_config_t gate = RMT_DEFAULT_CONFIG_TX(gatePin, GATE_CHANNEL);
+    gate.clk_div = GATE_CLOCK_DIV;
+    gate.mem_block_num = 1;
+    gate.tx_config.idle_output_en = true;
+    gate.tx_config.idle_level = RMT_IDLE_LEVEL_LOW;
+    gate.tx_config.carrier_en = false;
+    gate.tx_config.loop_en = false;
+    err = rmt_config(&gate);
+    if (err == ESP_OK) err = rmt_driver_install(GATE_CHANNEL, 0, 0);
+    if (err != ESP_OK) {
+        DEBUG_PRINTF("Scaler: RMT setup failed (%d)\n", err);
+        return false;
+    }
+
+    // rmt_config() made the pad output only: read it back into the PCNT control input
+    gpio_set_direction(gatePin, GPIO_MODE_INPUT_OUTPUT);
+    esp_rom_gpio_connect_out_signal(SCALER_GATE_PIN, rmt_periph_signals.groups[0].channels[GATE_CHANNEL].tx_sig,
+                                    false, false);
+
+    memset(&current, 0, sizeof(current));
+    scalerReady = true;
+    DEBUG_PRINTF("Scaler: PCNT unit %d gated by GPIO %d\n", SCALER_PCNT_UNIT, SCALER_GATE_PIN);
+    return true;
+}
+
+bool scalerAvailable() {
+    return scalerReady;
+}
+
+/**
+ * @brief Counts since the run was armed; the epoch is read on both sides of the counter.
+ */
+static uint32_t readCount() {
+    for (;;) {
+        uint32_t before = epoch;
+        int16_t value = 0;
+        pcnt_get_counter_value(SCALER_UNIT, &value);
+        if (epoch == before) return before * SCALER_HIGH_LIMIT + (uint16_t)value;
+    }
+}
+
+/**
+ * @brief All-high items for a gate of @p us. @return the item count, 0 without memory
+ */
+static size_t buildGate(uint64_t us, rmt_item32_t** items) {
+    size_t count = (size_t)((us + 2 * MAX_HALF_US - 1) / (2 * MAX_HALF_US));
+    size_t bytes = count * sizeof(rmt_item32_t);
+    rmt_item32_t* gate = (rmt_item32_t*)heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!gate) gate = (rmt_item32_t*)heap_caps_malloc(bytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (!gate) return 0;
+    for (size_t i = 0; i < count; i++) {
+        uint32_t first = us > MAX_HALF_US ? MAX_HALF_US : (uint32_t)us;
+        us -= first;
+        uint32_t second = us > MAX_HALF_US ? MAX_HALF_US : (uint32_t)us;
+        us -= second;
+        gate[i].level0 = 1;
+        gate[i].duration0 = first;
+        gate[i].level1 = second ? 1 : 0;
+        gate[i].duration1 = second;   // 0 ends the transmission after the first half
+    }
+    *items = gate;
+    return count;
+}
+
+/**
+ * @brief Closes a gate cut short. The driver keeps its transmit semaphore for an
+ *        unfinished transmission, so the channel is installed afresh.
+ */
+static void closeGate() {
+    rmt_tx_stop(GATE_CHANNEL);
+    rmt_driver_uninstall(GATE_CHANNEL);
+    if (rmt_driver_install(GATE_CHANNEL, 0, 0) != ESP_OK) {
+        DEBUG_PRINTLN("Scaler: RMT reinstall failed");
+        scalerReady = false;
+    }
+}
+
+static void publish(const ScalerResult& result) {
+    portENTER_CRITICAL(&resultLock);
+    current = result;
+    portEXIT_CRITICAL(&resultLock);
+}
+
+/**
+ * @brief Keeps a finished run: history, journal and log.
+ */
+static void finish(const ScalerResult& result) {
+    portENTER_CRITICAL(&resultLock);
+    current = result;
+    history[historyHead] = result;
+    historyHead = (historyHead + 1) % SCALER_HISTORY_SIZE;
+    if (historyCount < SCALER_HISTORY_SIZE) historyCount++;
+    portEXIT_CRITICAL(&resultLock);
+
+    uint64_t seconds = result.elapsedUs / 1000000;
+    eventJournalRecord(JOURNAL_SCALER, 0, seconds > UINT16_MAX ? UINT16_MAX : (uint16_t)seconds,
+                       (float)result.counts);
+    float sigma = 0.0f;
+    float cps = scalerCps(result, &sigma);
+    DEBUG_PRINTF("Scaler #%lu %s: %lu counts in %llu us (%.3f +- %.3f cps)\n", (unsigned long)result.sequence,
+                 scalerStateName(result.state), (unsigned long)result.counts, (unsigned long long)result.elapsedUs,
+                 cps, sigma);
+}
+
+/**
+ * @brief Run task: opens the gate, waits for the preset, the gate's end or a stop.
+ * @param parameter The gate items, freed by the task
+ */
+static void scalerRunTask(void* parameter) {
+    rmt_item32_t* items = (rmt_item32_t*)parameter;
+    runTask = xTaskGetCurrentTaskHandle(); // Before the ISR can want it
+    ScalerResult result;
+    portENTER_CRITICAL(&resultLock);
+    result = current;
+    portEXIT_CRITICAL(&resultLock);
+    size_t itemCount = (size_t)((result.presetUs + 2 * MAX_HALF_US - 1) / (2 * MAX_HALF_US));
+
+    pcnt_counter_pause(SCALER_UNIT);
+    epoch = 0;
+    targetEpoch = result.presetCounts / SCALER_HIGH_LIMIT;
+    targetRemainder = (int16_t)(result.presetCounts % SCALER_HIGH_LIMIT);
+    if (result.presetCounts > 0 && targetRemainder != 0) {
+        pcnt_set_event_value(SCALER_UNIT, PCNT_EVT_THRES_0, targetRemainder);
+        pcnt_event_enable(SCALER_UNIT, PCNT_EVT_THRES_0);
+    } else {
+        pcnt_event_disable(SCALER_UNIT, PCNT_EVT_THRES_0);
+    }
+    pcnt_counter_clear(SCALER_UNIT);
+    ulTaskNotifyTake(pdTRUE, 0);
+    armed = result.presetCounts > 0;
+    pcnt_counter_resume(SCALER_UNIT); // Still inhibited: the gate is low
+
+    // The gate opens at the end of rmt_write_items(); this task runs at high priority until it is stamped
+    esp_err_t err = rmt_write_items(GATE_CHANNEL, items, itemCount, false);
+    int64_t startUs = esp_timer_get_time();
+    vTaskPrioritySet(NULL, tskIDLE_PRIORITY + 1);
+
+    bool gateDone = false;
+    if (err != ESP_OK) {
+        result.state = SCALER_FAILED;
+        gateDone = true;
+    } else {
+        for (;;) {
+            if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(POLL_MS))) {
+                result.state = SCALER_DONE;
+                result.elapsedUs = stopUs - startUs;
+                break;
+            }
+            if (rmt_wait_tx_done(GATE_CHANNEL, 0) == ESP_OK) {
+                result.state = result.presetCounts ? SCALER_TIMED_OUT : SCALER_DONE;
+                result.elapsedUs = result.presetUs;
+                gateDone = true;
+                break;
+            }
+            if (stopRequested) {
+                pcnt_counter_pause(SCALER_UNIT);
+                result.state = SCALER_ABORTED;
+                result.elapsedUs = esp_timer_get_time() - startUs;
+                break;
+            }
+            result.counts = readCount();
+            result.elapsedUs = esp_timer_get_time() - startUs;
+            publish(result);
+        }
+    }
+
+    armed = false;
+    pcnt_counter_pause(SCALER_UNIT);
+    if (!gateDone) closeGate();
+    heap_caps_free(items);
+    vTaskDelay(1); // A wrap interrupt raised just before the pause lands first
+
+    result.counts = readCount();
+    if (result.presetCounts && result.state == SCALER_DONE) {
+        result.overshoot = result.counts - result.presetCounts;
+        result.counts = result.presetCounts;
+    }
+    finish(result);
+    runTask = nullptr;
+    scalerRunning = false;
+    vTaskDelete(NULL);
+}
+
+/**
+ * @brief Builds the gate and starts the run task.
+ */
+static bool startRun(uint64_t gateUs, uint32_t presetCounts) {
+    if (!scalerReady || scalerRunning) return false;
+    if (gateUs == 0 || gateUs > (uint64_t)SCALER_MAX_TIME_S * 1000000ULL) return false;
+    rmt_item32_t* items = nullptr;
+    if (buildGate(gateUs, &items) == 0) {
+        DEBUG_PRINTLN("Scaler: no memory for the gate");
+        return false;
+    }
+
+    scalerRunning = true;
+    stopRequested = false;
+    ScalerResult result;
+    memset(&result, 0, sizeof(result));
+    result.state = SCALER_RUNNING;
+    result.sequence = ++runs;
+    result.presetCounts = presetCounts;
+    result.presetUs = gateUs;
+    result.startUptimeMs = millis();
+    result.startUtcMs = timeBaseUtcValid() ? timeBaseUtcUs() / 1000 : 0;
+    publish(result);
+
+    // Core 0; starts above the network tasks so the gate's start is stamped promptly
+    if (xTaskCreatePinnedToCore(scalerRunTask, "Scaler", 3072, items, configMAX_PRIORITIES - 2, NULL, 0) !=
+        pdPASS) {
+        heap_caps_free(items);
+        result.state = SCALER_FAILED;
+        publish(result);
+        scalerRunning = false;
+        return false;
+    }
+    return true;
+}
+
+bool scalerStartTime(uint64_t us) {
+    return startRun(us, 0);
+}
+
+bool scalerStartCount(uint32_t counts, uint64_t limitUs) {
+    if (counts == 0) return false;
+    return startRun(limitUs ? limitUs : (uint64_t)SCALER_MAX_TIME_S * 1000000ULL, counts);
+}
+
+void scalerStop() {
+    if (scalerRunning) stopRequested = true;
+}
+
+ScalerResult getScalerResult() {
+    portENTER_CRITICAL(&resultLock);
+    ScalerResult copy = current;
+    portEXIT_CRITICAL(&resultLock);
+    return copy;
+}
+
+bool getScalerHistory(uint8_t index, ScalerResult& out) {
+    portENTER_CRITICAL(&resultLock);
+    bool found = index < historyCount;
+    if (found) out = history[(historyHead + SCALER_HISTORY_SIZE - 1 - index) % SCALER_HISTORY_SIZE];
+    portEXIT_CRITICAL(&resultLock);
+    return found;
+}
+
+ScalerStats getScalerStats() {
+    ScalerStats s;
+    s.available = scalerReady;
+    s.runs = runs;
+    s.wraps = wraps;
+    return s;
+}
+
+const char* scalerStateName(uint8_t state) {
+    static const char* NAMES[] = {"idle", "running", "done", "timed out", "aborted", "failed"};
+    return state < sizeof(NAMES) / sizeof(NAMES[0]) ? NAMES[state] : "?";
+}
+
+float scalerCps(const ScalerResult& result, float* sigma) {
+    float seconds = result.elapsedUs / 1e6f;
+    if (sigma) *sigma = seconds > 0.0f ? sqrtf((float)result.counts) / seconds : 0.0f;
+    return seconds > 0.0f ? result.counts / seconds : 0.0f;
+}
+
+void formatScalerLabel(char* text, size_t size) {
+    ScalerResult r = getScalerResult();
+    float seconds = r.elapsedUs / 1e6f;
+    switch (r.state) {
+        case SCALER_IDLE:
+            if (size) text[0] = '\0';
+            break;
+        case SCALER_RUNNING:
+            if (r.presetCounts) {
+                snprintf(text, size, "N %lu/%lu", (unsigned long)r.counts, (unsigned long)r.presetCounts);
+            } else {
+                snprintf(text, size, "T %.0f/%.0f s %lu", seconds, r.presetUs / 1e6f, (unsigned long)r.counts);
+            }
+            break;
+        default:
+            snprintf(text, size, "%lu in %.6f s%s", (unsigned long)r.counts, seconds,
+                     r.state == SCALER_DONE ? "" : " !");
+            break;
+    }
+}
+
+static void printResult(Print& out, const ScalerResult& r) {
+    float sigma = 0.0f;
+    float cps = scalerCps(r, &sigma);
+    out.printf("  #%-4lu %-9s ", (unsigned long)r.sequence, scalerStateName(r.state));
+    if (r.presetCounts) out.printf("preset %lu counts, ", (unsigned long)r.presetCounts);
+    else out.printf("preset %.6f s, ", r.presetUs / 1e6);
+    out.printf("%lu counts in %.6f s, %.3f +- %.3f cps", (unsigned long)r.counts, r.elapsedUs / 1e6, cps, sigma);
+    if (r.overshoot) out.printf(", overshoot %lu", (unsigned long)r.overshoot);
+    out.println();
+}
+
+void printScaler(Print& out) {
+    ScalerStats s = getScalerStats();
+    if (!s.available) {
+        out.println("Scaler: not available (SCALER_GATE_PIN)");
+        return;
+    }
+    out.printf("Scaler: PCNT unit %d gated on GPIO %d, %lu runs since boot\n", SCALER_PCNT_UNIT, SCALER_GATE_PIN,
+               (unsigned long)s.runs);
+    ScalerResult r = getScalerResult();
+    if (r.state == SCALER_RUNNING) printResult(out, r);
+    ScalerResult h;
+    for (uint8_t i = 0; getScalerHistory(i, h); i++) printResult(out, h);
+}
+
+static void addResult(JsonObject o, const ScalerResult& r) {
+    float sigma = 0.0f;
+    float cps = scalerCps(r, &sigma);
+    o["seq"] = r.sequence;
+    o["state"] = scalerStateName(r.state);
+    if (r.presetCounts) o["preset_counts"] = r.presetCounts;
+    o[r.presetCounts ? "limit_us" : "preset_us"] = r.presetUs;
+    o["counts"] = r.counts;
+    o["overshoot"] = r.overshoot;
+    o["elapsed_us"] = r.elapsedUs;
+    o["cps"] = cps;
+    o["cps_sigma"] = sigma;
+    o["start_uptime_ms"] = r.startUptimeMs;
+    if (r.startUtcMs) o["start_utc_ms"] = r.startUtcMs;
+}
+
+void buildScalerJson(JsonDocument& doc) {
+    ScalerStats s = getScalerStats();
+    doc["available"] = s.available;
+    doc["runs"] = s.runs;
+    ScalerResult r = getScalerResult();
+    if (r.state != SCALER_IDLE) addResult(doc["current"].to<JsonObject>(), r);
+    JsonArray list = doc["history"].to<JsonArray>();
+    ScalerResult h;
+    for (uint8_t i = 0; getScalerHistory(i, h); i++) addResult(list.add<JsonObject>(), h);
+}
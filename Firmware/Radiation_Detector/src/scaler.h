@@ -0,0 +1,95 @@
+#ifndef SCALER_H
+#define SCALER_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "config.h"
+
+// Hardware-gated scaler ("scaler", /api/scaler, main screen): a classic
+// preset-time or preset-count measurement on a PCNT unit of its own
+// (SCALER_PCNT_UNIT) that counts the Geiger input only while its control
+// input is high. SCALER_GATE_PIN carries the gate: an RMT transmit channel
+// (SCALER_RMT_CHANNEL, 1 us ticks from the APB clock) drives it and the pad
+// reads it back into the PCNT control input, so no software sits between the
+// gate edges and the counter. Nothing needs to be wired to the pin; a scope
+// on it shows the gate.
+//  - Preset time: the gate is one RMT transmission of exactly the preset
+//    length, so the count window is as exact as the crystal. Both gate edges
+//    pass the same PCNT glitch filter, which delays but does not shorten it.
+//  - Preset count: the PCNT threshold event fires on the count that reaches
+//    the preset; its ISR pauses the unit and timestamps the stop. The count
+//    is exact (pulses in the few microseconds before the pause are reported
+//    as overshoot); the elapsed time is good to the ISR latency, a few us.
+//    SCALER_MAX_TIME_S (or the given limit) closes the gate if the preset is
+//    not reached.
+// The primary counter and the rate pipeline carry on unaffected. Every
+// finished run is journalled (JOURNAL_SCALER) and logged; the last
+// SCALER_HISTORY_SIZE results are kept in RAM.
+
+enum ScalerState : uint8_t {
+    SCALER_IDLE = 0,
+    SCALER_RUNNING,
+    SCALER_DONE,        ///< Preset reached
+    SCALER_TIMED_OUT,   ///< Count preset not reached within the time limit
+    SCALER_ABORTED,     ///< "scaler stop"
+    SCALER_FAILED       ///< No memory for the gate or the RMT refused it
+};
+
+struct ScalerResult {
+    uint8_t state;
+    uint32_t sequence;       ///< Runs since boot
+    uint32_t presetCounts;   ///< 0 for a preset-time run
+    uint64_t presetUs;       ///< Gate length (the time limit for a preset-count run)
+    uint32_t counts;         ///< Registered in the gate; the preset itself once reached
+    uint32_t overshoot;      ///< Counts past the preset before the unit paused
+    uint64_t elapsedUs;      ///< Gate open time (so far, while running)
+    uint32_t startUptimeMs;
+    int64_t startUtcMs;      ///< 0 if the time base had no UTC
+};
+
+struct ScalerStats {
+    bool available;
+    uint32_t runs;
+    uint32_t wraps;          ///< PCNT high-limit events, all runs
+};
+
+// Sets up the PCNT unit and the gate channel. Call once in setup(), after
+// initPulseCounter() (whose ISR service the unit shares).
+// @return false without SCALER_GATE_PIN or if the peripherals refuse it
+bool initScaler(uint8_t geigerPin, uint16_t filterCycles);
+
+bool scalerAvailable();
+
+// Starts a preset-time run of @p us microseconds.
+// @return false if unavailable, running or out of range (1 us to SCALER_MAX_TIME_S)
+bool scalerStartTime(uint64_t us);
+
+// Starts a preset-count run of @p counts, given up after @p limitUs
+// (0: SCALER_MAX_TIME_S).
+bool scalerStartCount(uint32_t counts, uint64_t limitUs);
+
+void scalerStop();
+
+// The run in progress, or the last one (state SCALER_IDLE before the first).
+ScalerResult getScalerResult();
+
+// Result @p index back from the newest finished one. @return false past the end
+bool getScalerHistory(uint8_t index, ScalerResult& out);
+
+ScalerStats getScalerStats();
+
+const char* scalerStateName(uint8_t state);
+
+// Counts per second and its one-sigma counting error; 0 with no gate time.
+float scalerCps(const ScalerResult& result, float* sigma);
+
+// Short text for the main screen label ("" before the first run).
+void formatScalerLabel(char* text, size_t size);
+
+// The current run and the history ("scaler").
+void printScaler(Print& out);
+
+// Fills @p doc for /api/scaler.
+void buildScalerJson(JsonDocument& doc);
+
+#endif // SCALER_H
@@ -0,0 +1,267 @@
+/**
+ * @file screen_mirror.cpp
+ * @brief Shadow frame buffer fed by the flush hook, tile-diff stream to the browser.
+ *
+ * The flush hook runs on the LVGL task: it copies the area into the shadow
+ * buffer first and marks the tiles changed after, in one bit set per viewer.
+ * The web task clears a tile's bit before it reads the tile, so a flush that
+ * lands while a tile is being encoded marks it again and it goes out once
+ * more on the next pass; the two tasks share no lock.
+ */
+
+#include "config.h"
+
+#if !HEADLESS
+
+#include "screen_mirror.h"
+#include "display_port.h"
+#include "debug.h"
+#include <atomic>
+#include "esp_heap_caps.h"
+
+static const uint16_t TILE = SCREEN_MIRROR_TILE;
+static const uint16_t COLUMNS = DISPLAY_WIDTH / TILE;
+static const uint16_t ROWS = DISPLAY_HEIGHT / TILE;
+static const uint16_t TILES = COLUMNS * ROWS;
+static const uint16_t WORDS = (TILES + 31) / 32;
+static const uint32_t CLIENT_SEND_TIMEOUT_S = 1;
+static const size_t SEND_BUFFER = 1460;           ///< One TCP segment
+static const size_t PASS_BYTES = 24 * 1024;       ///< Per viewer and pass; the rest waits for the next one
+static const size_t RAW_BYTES = TILE * TILE * 2;
+
+static_assert(DISPLAY_WIDTH % SCREEN_MIRROR_TILE == 0 && DISPLAY_HEIGHT % SCREEN_MIRROR_TILE == 0,
+              "tiles must cover the panel exactly");
+static_assert(sizeof(ScreenMirrorHeader) == 12, "screen mirror header layout is on the wire");
+static_assert(sizeof(ScreenMirrorTile) == 6, "screen mirror tile layout is on the wire");
+static_assert(sizeof(ScreenMirrorTile) + RAW_BYTES <= SEND_BUFFER, "a raw tile must fit the send buffer");
+
+struct Viewer {
+    WiFiClient client;
+    bool active;
+    std::atomic<uint32_t> dirty[WORDS];
+};
+
+static WebServer* mirrorServer = nullptr;
+static uint16_t* shadow = nullptr;                ///< DISPLAY_WIDTH x DISPLAY_HEIGHT, LVGL byte order
+static Viewer viewers[SCREEN_MIRROR_MAX_VIEWERS];
+static std::atomic<uint8_t> viewerCount(0);
+static std::atomic<bool> redrawWanted(false);
+static uint32_t lastPassMs = 0;
+
+// Web task only
+static uint8_t sendBuffer[SEND_BUFFER];
+static size_t sendLength = 0;
+static uint16_t tilePixels[TILE * TILE];
+
+/**
+ * @brief Display flush hook (LVGL task): copies the area and marks its tiles.
+ */
+static void onFlush(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint16_t* pixels, bool swapped) {
+    if (x < 0 || y < 0 || x + w > DISPLAY_WIDTH || y + h > DISPLAY_HEIGHT) return;
+    for (uint16_t r = 0; r < h; r++) {
+        uint16_t* row = shadow + (uint32_t)(y + r) * DISPLAY_WIDTH + x;
+        const uint16_t* src = pixels + (uint32_t)r * w;
+        if (swapped) {
+            for (uint16_t i = 0; i < w; i++) row[i] = (uint16_t)(src[i] << 8 | src[i] >> 8);
+        } else {
+            memcpy(row, src, w * sizeof(uint16_t));
+        }
+    }
+    for (uint16_t row = y / TILE; row <= (y + h - 1) / TILE; row++) {
+        for (uint16_t column = x / TILE; column <= (x + w - 1) / TILE; column++) {
+            uint16_t tile = row * COLUMNS + column;
+            for (uint8_t v = 0; v < SCREEN_MIRROR_MAX_VIEWERS; v++) {
+                if (viewers[v].active) viewers[v].dirty[tile / 32].fetch_or(1UL << (tile % 32));
+            }
+        }
+    }
+}
+
+static void dropViewer(Viewer& viewer) {
+    viewer.client.stop();
+    viewer.active = false;
+    if (viewerCount.fetch_sub(1) == 1) displayPortSetFlushHook(nullptr);
+    DEBUG_PRINTLN("Screen mirror: viewer left");
+}
+
+static bool flushSend(Viewer& viewer) {
+    if (sendLength == 0) return true;
+    bool ok = viewer.client.write(sendBuffer, sendLength) == sendLength;
+    sendLength = 0;
+    return ok;
+}
+
+/**
+ * @brief Encodes one tile into the send buffer, RLE or raw, whichever is smaller.
+ * @return bytes added
+ */
+static size_t encodeTile(uint16_t tile) {
+    uint16_t column = tile % COLUMNS;
+    uint16_t row = tile / COLUMNS;
+    const uint16_t* src = shadow + (uint32_t)row * TILE * DISPLAY_WIDTH + column * TILE;
+    for (uint16_t r = 0; r < TILE; r++) memcpy(tilePixels + r * TILE, src + (uint32_t)r * DISPLAY_WIDTH, TILE * 2);
+
+    ScreenMirrorTile header = {SCREEN_MIRROR_RLE, (uint8_t)column, (uint8_t)row, 0, 0};
+    uint8_t* payload = sendBuffer + sendLength + sizeof(header);
+    size_t length = 0;
+    for (uint16_t i = 0; i < TILE * TILE && length + 3 <= RAW_BYTES;) {
+        uint16_t pixel = tilePixels[i];
+        uint16_t run = 1;
+        while (i + run < TILE * TILE && run < 256 && tilePixels[i + run] == pixel) run++;
+        payload[length++] = (uint8_t)(run - 1);
+        payload[length++] = (uint8_t)pixel;
+        payload[length++] = (uint8_t)(pixel >> 8);
+        i += run;
+        if (i == TILE * TILE) header.length = (uint16_t)length; // Finished smaller than raw
+    }
+    if (header.length == 0) {
+        header.encoding = SCREEN_MIRROR_RAW;
+        header.length = RAW_BYTES;
+        memcpy(payload, tilePixels, RAW_BYTES); // Little-endian on the ESP32
+    }
+    memcpy(sendBuffer + sendLength, &header, sizeof(header));
+    sendLength += sizeof(header) + header.length;
+    return sizeof(header) + header.length;
+}
+
+/**
+ * @brief Sends the viewer's changed tiles, up to PASS_BYTES.
+ * @return false if the viewer is gone
+ */
+static bool sendTiles(Viewer& viewer) {
+    size_t sent = 0;
+    for (uint16_t word = 0; word < WORDS && sent < PASS_BYTES; word++) {
+        uint32_t bits = viewer.dirty[word].exchange(0);
+        while (bits) {
+            uint16_t bit = __builtin_ctz(bits);
+            if (sent >= PASS_BYTES) {
+                viewer.dirty[word].fetch_or(bits); // Next pass
+                break;
+            }
+            bits &= bits - 1;
+            if (SEND_BUFFER - sendLength < sizeof(ScreenMirrorTile) + RAW_BYTES && !flushSend(viewer)) return false;
+            sent += encodeTile(word * 32 + bit);
+        }
+    }
+    return flushSend(viewer);
+}
+
+/**
+ * @brief Handles GET /api/screen/stream: adopts the socket and queues every tile.
+ */
+static void handleStreamRequest() {
+    if (!shadow) {
+        shadow = (uint16_t*)heap_caps_malloc(DISPLAY_WIDTH * DISPLAY_HEIGHT * 2, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        if (!shadow) {
+            mirrorServer->send(503, "text/plain", "No memory for the shadow frame buffer");
+            return;
+        }
+        memset(shadow, 0, DISPLAY_WIDTH * DISPLAY_HEIGHT * 2);
+    }
+    int freeSlot = -1;
+    for (int i = 0; i < SCREEN_MIRROR_MAX_VIEWERS; i++) {
+        if (viewers[i].active && !viewers[i].client.connected()) dropViewer(viewers[i]);
+        if (!viewers[i].active && freeSlot < 0) freeSlot = i;
+    }
+    if (freeSlot < 0) {
+        mirrorServer->send(503, "text/plain", "Too many screen viewers");
+        return;
+    }
+
+    Viewer& viewer = viewers[freeSlot];
+    viewer.client = mirrorServer->client();
+    viewer.client.setTimeout(CLIENT_SEND_TIMEOUT_S);
+    viewer.client.print("HTTP/1.1 200 OK\r\n"
+                        "Content-Type: application/octet-stream\r\n"
+                        "Cache-Control: no-store\r\n"
+                        "Access-Control-Allow-Origin: *\r\n"
+                        "Connection: close\r\n"
+                        "\r\n");
+    ScreenMirrorHeader header = {SCREEN_MIRROR_MAGIC, DISPLAY_WIDTH, DISPLAY_HEIGHT, (uint8_t)TILE,
+                                 SCREEN_MIRROR_VERSION, 0};
+    viewer.client.write((const uint8_t*)&header, sizeof(header));
+
+    // The last shadow contents at once, then the redraw replaces what is stale
+    for (uint16_t i = 0; i < WORDS; i++) {
+        uint16_t bits = TILES - i * 32 < 32 ? TILES - i * 32 : 32;
+        viewer.dirty[i].store(bits == 32 ? 0xFFFFFFFFUL : (1UL << bits) - 1);
+    }
+    viewer.active = true;
+    if (viewerCount.fetch_add(1) == 0) displayPortSetFlushHook(onFlush);
+    redrawWanted.store(true);
+    DEBUG_PRINTF("Screen mirror: viewer %d connected\n", freeSlot);
+}
+
+static const char SCREEN_PAGE[] PROGMEM = R"HTML(<!DOCTYPE html>
+<html><head><meta charset="utf-8"><meta name="viewport" content="width=device-width,initial-scale=1">
+<title>Screen</title>
+<style>body{margin:0;background:#111;color:#888;font:14px sans-serif;text-align:center}
+canvas{width:100%;max-width:960px;image-rendering:pixelated;margin-top:8px}</style></head>
+<body><canvas id="s" width="480" height="320"></canvas><div id="st">connecting</div>
+<script>
+const c=document.getElementById('s'),g=c.getContext('2d'),st=document.getElementById('st');
+function rgb(d,i,p){d[i]=(p>>8&248)|(p>>13);d[i+1]=(p>>3&252)|(p>>9&3);d[i+2]=(p<<3&248)|(p>>2&7);d[i+3]=255;}
+async function run(){
+  try{
+    const r=await fetch('/api/screen/stream');
+    if(!r.ok)throw r.status;
+    const rd=r.body.getReader();
+    let buf=new Uint8Array(0),img=null,T=16,tiles=0;
+    st.textContent='live';
+    for(;;){
+      const {value,done}=await rd.read();
+      if(done)break;
+      const n=new Uint8Array(buf.length+value.length);n.set(buf);n.set(value,buf.length);buf=n;
+      const v=new DataView(buf.buffer);
+      let o=0;
+      if(!img){
+        if(buf.length<12)continue;
+        if(v.getUint32(0,true)!=0x4D534452)throw 'bad stream';
+        c.width=v.getUint16(4,true);c.height=v.getUint16(6,true);T=buf[8];
+        img=g.createImageData(T,T);o=12;
+      }
+      while(buf.length-o>=6){
+        const len=v.getUint16(o+4,true);
+        if(buf.length-o-6<len)break;
+        const d=img.data;let p=o+6,i=0;
+        if(buf[o]==0){for(let k=0;k<T*T;k++,p+=2,i+=4)rgb(d,i,v.getUint16(p,true));}
+        else{while(p<o+6+len){const run=buf[p]+1,px=v.getUint16(p+1,true);p+=3;for(let k=0;k<run;k++,i+=4)rgb(d,i,px);}}
+        g.putImageData(img,buf[o+1]*T,buf[o+2]*T);
+        o+=6+len;tiles++;
+      }
+      buf=buf.slice(o);
+      st.textContent='live, '+tiles+' tiles';
+    }
+  }catch(e){st.textContent='reconnecting ('+e+')';}
+  setTimeout(run,2000);
+}
+run();
+</script></body></html>)HTML";
+
+void screenMirrorAttach(WebServer& server) {
+    mirrorServer = &server;
+    server.on("/screen", HTTP_GET, [&server]() {
+        server.send_P(200, "text/html", SCREEN_PAGE);
+    });
+    server.on("/api/screen/stream", HTTP_GET, handleStreamRequest);
+}
+
+void screenMirrorLoop(uint32_t nowMs) {
+    if (viewerCount.load() == 0 || nowMs - lastPassMs < SCREEN_MIRROR_INTERVAL_MS) return;
+    lastPassMs = nowMs;
+    for (int i = 0; i < SCREEN_MIRROR_MAX_VIEWERS; i++) {
+        Viewer& viewer = viewers[i];
+        if (!viewer.active) continue;
+        if (!viewer.client.connected() || !sendTiles(viewer)) dropViewer(viewer);
+    }
+}
+
+void screenMirrorUiLoop() {
+    if (redrawWanted.exchange(false)) lv_obj_invalidate(lv_scr_act());
+}
+
+uint8_t screenMirrorViewerCount() {
+    return viewerCount.load();
+}
+
+#endif // !HEADLESS
@@ -0,0 +1,61 @@
+#ifndef SCREEN_MIRROR_H
+#define SCREEN_MIRROR_H
+
+#include <Arduino.h>
+#include <WebServer.h>
+#include "config.h"
+
+// Remote view of the panel for support staff.
+// While a viewer is connected, every area sent to the panel (display_port.h
+// flush hook) is copied into a shadow frame buffer in PSRAM and the
+// SCREEN_MIRROR_TILE pixel tiles it touched are marked changed. Nothing is
+// rendered twice: the mirror sees exactly the pixels the panel gets.
+//
+//   GET /screen                 canvas page that shows the stream
+//   GET /api/screen/stream      binary stream, served like /events (the web
+//                               task adopts the socket and writes to it)
+//
+// The stream is a ScreenMirrorHeader, then one ScreenMirrorTile per changed
+// tile, at most every SCREEN_MIRROR_INTERVAL_MS. A tile is RLE coded (runs of
+// u8 length - 1, u16 pixel) or raw when that is not smaller; pixels are RGB565,
+// little-endian. A new viewer first receives every tile. WebServer has no
+// WebSocket support; the page reads the response body as a stream instead.
+
+#define SCREEN_MIRROR_MAGIC   0x4D534452 // "RDSM"
+#define SCREEN_MIRROR_VERSION 1
+
+enum ScreenMirrorEncoding {
+    SCREEN_MIRROR_RAW = 0,
+    SCREEN_MIRROR_RLE = 1
+};
+
+struct ScreenMirrorHeader {
+    uint32_t magic;
+    uint16_t width;
+    uint16_t height;
+    uint8_t tileSize;
+    uint8_t version;
+    uint16_t reserved;
+};
+
+// Precedes the payload of one tile.
+struct ScreenMirrorTile {
+    uint8_t encoding;       ///< ScreenMirrorEncoding
+    uint8_t column;         ///< Tile position, in tiles
+    uint8_t row;
+    uint8_t reserved;
+    uint16_t length;        ///< Payload bytes that follow
+};
+
+// Registers /screen and /api/screen/stream.
+void screenMirrorAttach(WebServer& server);
+
+// Sends the changed tiles and drops dead viewers. Web task, after handleClient().
+void screenMirrorLoop(uint32_t nowMs);
+
+// Redraws the whole screen once a new viewer needs every tile. LVGL task.
+void screenMirrorUiLoop();
+
+uint8_t screenMirrorViewerCount();
+
+#endif // SCREEN_MIRROR_H
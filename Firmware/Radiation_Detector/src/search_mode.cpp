@@ -0,0 +1,171 @@
+/**
+ * @file search_mode.cpp
+ * @brief Short-window rate to buzzer pitch, from an esp_timer.
+ *
+ * The ring is written by the capture ISR on the measurement core and read by
+ * the timer callback on the esp_timer task, without a lock: the ISR stores the
+ * time before it advances the head, and the reader never walks further back
+ * than SEARCH_RING_SIZE - RING_GUARD entries, so a slot the ISR may be
+ * overwriting meanwhile is never read. The callback only counts back from
+ * the newest entry until it leaves the window, so it costs at most a ring's
+ * worth of loads however long the search runs.
+ */
+
+#include "search_mode.h"
+#include "alarm_sequencer.h"
+#include "latency_histogram.h"
+#include "pulse_capture.h"
+#include "seqlock.h"
+#include "esp_timer.h"
+#include <math.h>
+
+static_assert((SEARCH_RING_SIZE & (SEARCH_RING_SIZE - 1)) == 0, "SEARCH_RING_SIZE must be a power of two");
+
+static const uint32_t RING_MASK = SEARCH_RING_SIZE - 1;
+static const uint32_t RING_GUARD = 4;           ///< Slots ahead of the reader the ISR may be writing
+static const uint32_t WINDOW_US = SEARCH_WINDOW_MS * 1000UL;
+static const float MIN_REFERENCE_CPS = 0.05f;   ///< Pitch floor with no background given (3 CPM)
+
+static DRAM_ATTR uint32_t ring[SEARCH_RING_SIZE];
+static volatile uint32_t ringHead = 0;          ///< Pulses stored since boot (ISR only writes)
+static volatile bool active = false;
+
+static esp_timer_handle_t updateTimer = nullptr;
+static float referenceCps = 0.0f;
+static uint32_t startHead = 0;                  ///< Ring head when the search started
+static uint32_t lastHead = 0;                   ///< Timer task only, with lastFrequency
+static uint32_t lastFrequency = 0;
+static SeqLock<SearchReading> readingLock;
+static SearchStats stats;
+static LatencyHistogram toneLatency;            ///< Newest pulse to the update that first counted it
+
+/**
+ * @brief Tone for @p cps: logarithmic in the rate above the reference.
+ * @param position  Set to the pitch between the minimum and maximum, 0...1
+ */
+static uint32_t searchPitch(float cps, float reference, float* position) {
+    float decades = log10f(cps / reference);
+    float octaves = decades > 0.0f ? decades * SEARCH_PITCH_OCTAVES_PER_DECADE : 0.0f;
+    float span = log2f((float)SEARCH_PITCH_MAX_HZ / SEARCH_PITCH_MIN_HZ);
+    if (octaves > span) octaves = span;
+    *position = span > 0.0f ? octaves / span : 0.0f;
+    return (uint32_t)lroundf(SEARCH_PITCH_MIN_HZ * exp2f(octaves));
+}
+
+static void updateCallback(void* arg) {
+    if (!active) return;
+    uint32_t startUs = (uint32_t)esp_timer_get_time();
+    uint32_t head = ringHead;
+    uint32_t available = head - startHead;      // Older entries are from before the start
+    if (available > SEARCH_RING_SIZE - RING_GUARD) available = SEARCH_RING_SIZE - RING_GUARD;
+
+    // Count back from the newest pulse to the first one outside the window
+    uint32_t pulses = 0;
+    uint32_t newestUs = 0;
+    uint32_t oldestUs = 0;
+    while (pulses < available) {
+        uint32_t t = ring[(head - 1 - pulses) & RING_MASK];
+        if (pulses == 0) newestUs = t;
+        if (startUs - t >= WINDOW_US) break;
+        oldestUs = t;
+        pulses++;
+    }
+
+    SearchReading r;
+    r.active = true;
+    r.referenceCps = referenceCps;
+    r.pulses = pulses;
+    if (pulses == available && available == SEARCH_RING_SIZE - RING_GUARD && newestUs != oldestUs) {
+        // More pulses in the window than the ring holds: the ring spans less than the window
+        r.cps = (pulses - 1) * 1e6f / (newestUs - oldestUs);
+        stats.saturated++;
+    } else {
+        r.cps = pulses * 1e6f / WINDOW_US;
+    }
+    r.position = 0.0f;
+    // One pulse in the window is the least there is to hear: it plays the lowest pitch
+    float floorCps = 1e6f / WINDOW_US;
+    r.frequency = pulses ? searchPitch(r.cps, referenceCps > floorCps ? referenceCps : floorCps, &r.position) : 0;
+    if (r.frequency != lastFrequency) stats.retunes++;
+    lastFrequency = r.frequency;
+    alarmSetSearchTone(r.frequency);
+    readingLock.publish(r);
+
+    if (head != lastHead) toneLatency.add(startUs - newestUs);
+    lastHead = head;
+    uint32_t tookUs = (uint32_t)esp_timer_get_time() - startUs;
+    if (tookUs > stats.maxUpdateUs) stats.maxUpdateUs = tookUs;
+    stats.updates++;
+}
+
+bool initSearchMode() {
+    if (updateTimer) return true;
+    esp_timer_create_args_t args = {};
+    args.callback = updateCallback;
+    args.name = "search";
+    return esp_timer_create(&args, &updateTimer) == ESP_OK;
+}
+
+void IRAM_ATTR searchModeFromIsr(uint32_t timestampUs) {
+    if (!active) return;
+    uint32_t head = ringHead;
+    ring[head & RING_MASK] = timestampUs;
+    __asm__ __volatile__("" ::: "memory"); // The time is stored before the head moves
+    ringHead = head + 1;
+}
+
+bool searchModeStart(float reference) {
+    if (!updateTimer || !pulseCaptureActive()) return false;
+    if (active) searchModeStop();
+    referenceCps = reference > MIN_REFERENCE_CPS ? reference : MIN_REFERENCE_CPS;
+    startHead = lastHead = ringHead;
+    lastFrequency = 0;
+    toneLatency.reset();
+    stats.sessions++;
+    active = true;
+    esp_timer_start_periodic(updateTimer, 1000000UL / SEARCH_UPDATE_HZ);
+    return true;
+}
+
+void searchModeStop() {
+    if (!active) return;
+    active = false;
+    esp_timer_stop(updateTimer);
+    alarmSetSearchTone(0);
+    SearchReading r = {};
+    r.referenceCps = referenceCps;
+    readingLock.publish(r);
+}
+
+bool searchModeActive() {
+    return active;
+}
+
+SearchReading getSearchReading() {
+    SearchReading r = {};
+    readingLock.read(r);
+    return r;
+}
+
+SearchStats getSearchStats() {
+    return stats;
+}
+
+void printSearchMode(Print& out) {
+    SearchReading r = getSearchReading();
+    out.printf("Search mode: %s, %u ms window, %u updates/s, %u-%u Hz, %.1f octaves per decade\n",
+               active ? "on" : "off", (unsigned)SEARCH_WINDOW_MS, (unsigned)SEARCH_UPDATE_HZ,
+               (unsigned)SEARCH_PITCH_MIN_HZ, (unsigned)SEARCH_PITCH_MAX_HZ, SEARCH_PITCH_OCTAVES_PER_DECADE);
+    if (active) {
+        out.printf("  %.1f CPS (%lu pulses), reference %.2f CPS, tone %lu Hz\n", r.cps, (unsigned long)r.pulses,
+                   r.referenceCps, (unsigned long)r.frequency);
+    }
+    out.printf("  %lu sessions, %lu updates, %lu retunes, %lu saturated, longest update %lu us\n",
+               (unsigned long)stats.sessions, (unsigned long)stats.updates, (unsigned long)stats.retunes,
+               (unsigned long)stats.saturated, (unsigned long)stats.maxUpdateUs);
+    if (toneLatency.count()) {
+        out.printf("  pulse to tone: mean %lu us, p99 <%lu us, max %lu us (%lu pulses)\n",
+                   (unsigned long)toneLatency.meanUs(), (unsigned long)toneLatency.percentileUs(990),
+                   (unsigned long)toneLatency.maxUs(), (unsigned long)toneLatency.count());
+    }
+}
@@ -0,0 +1,61 @@
+#ifndef SEARCH_MODE_H
+#define SEARCH_MODE_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Hot-spot search ("search", long press on the dose rate): the buzzer plays a
+// tone whose pitch follows the rate of the last SEARCH_WINDOW_MS, for walking
+// towards a lost source by ear. The pulse-capture ISR hook stores each pulse
+// time in a small ring of its own; a periodic esp_timer (SEARCH_UPDATE_HZ)
+// counts the pulses inside the window, maps the rate to a pitch and sets it
+// on the buzzer (alarm_sequencer.h). Neither the pulse pipeline nor the UI
+// loop sits between a pulse and the tone, so the pitch is at most one timer
+// period plus the window behind the source.
+//
+// The pitch is relative to the reference rate given at the start (the
+// background shown then): SEARCH_PITCH_MIN_HZ at or below it, rising
+// SEARCH_PITCH_OCTAVES_PER_DECADE per tenfold rate up to SEARCH_PITCH_MAX_HZ.
+// A window without pulses is silent, so at background the tone comes as short
+// blips per pulse. Alarms take precedence over the tone.
+
+struct SearchReading {
+    bool active;
+    float cps;              ///< Rate over the last window
+    float referenceCps;     ///< Rate the pitch is relative to
+    uint32_t pulses;        ///< Pulses in the window (or the ring span)
+    uint32_t frequency;     ///< Tone played, 0 for silence
+    float position;         ///< Pitch between the minimum and maximum, 0...1
+};
+
+struct SearchStats {
+    uint32_t sessions;
+    uint32_t updates;       ///< Timer runs while active
+    uint32_t retunes;       ///< Updates that changed the tone
+    uint32_t maxUpdateUs;   ///< Longest timer callback
+    uint32_t saturated;     ///< Updates with more pulses in the window than the ring holds
+};
+
+// Creates the timer. Install searchModeFromIsr() in the capture ISR hook.
+bool initSearchMode();
+
+// IRAM, ISR context; called for every captured pulse.
+void searchModeFromIsr(uint32_t timestampUs);
+
+// Starts the tone relative to @p referenceCps (any task).
+// @return false without pulse capture or a timer
+bool searchModeStart(float referenceCps);
+
+void searchModeStop();
+
+bool searchModeActive();
+
+// The latest update (any task).
+SearchReading getSearchReading();
+
+SearchStats getSearchStats();
+
+// Reading, settings and the pulse-to-tone latency ("search").
+void printSearchMode(Print& out);
+
+#endif // SEARCH_MODE_H
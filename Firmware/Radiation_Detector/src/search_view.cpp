@@ -0,0 +1,147 @@
+/**
+ * @file search_view.cpp
+ * @brief Minimal full-screen readout for the hot-spot search.
+ *
+ * Two labels and a bar. The labels are set only when their text changed and
+ * the bar only moves its width, so an update invalidates a few small areas.
+ */
+
+#include "config.h"
+
+#if !HEADLESS
+
+#include "search_view.h"
+#include "search_mode.h"
+#include "ui.h"
+#include <stdio.h>
+#include <string.h>
+
+static const uint32_t UPDATE_INTERVAL_MS = 100;
+static const lv_coord_t BAR_HEIGHT = 24;
+static const lv_coord_t MARGIN = 20;
+
+static lv_obj_t* view = nullptr;
+static lv_obj_t* rateLabel = nullptr;
+static lv_obj_t* ratioLabel = nullptr;
+static lv_obj_t* bar = nullptr;
+static SearchReferenceFn referenceFn = nullptr;
+static uint32_t lastUpdateMs = 0;
+static char rateText[16] = "";
+static char ratioText[32] = "";
+static lv_coord_t barWidth = -1;
+
+static const lv_color_t COLOR_BAR = LV_COLOR_MAKE(0xFF, 0x8C, 0x00);
+static const lv_color_t COLOR_DIM = LV_COLOR_MAKE(0xA0, 0xA0, 0xA0);
+
+static void setText(lv_obj_t* label, char* shown, size_t size, const char* text) {
+    if (strcmp(shown, text) == 0) return;
+    strlcpy(shown, text, size);
+    lv_label_set_text_static(label, shown);
+}
+
+/**
+ * @brief Copies the latest reading into the labels and the bar.
+ */
+static void refresh() {
+    SearchReading r = getSearchReading();
+    char text[32];
+    snprintf(text, sizeof(text), r.cps < 10.0f ? "%.1f" : "%.0f", r.cps);
+    setText(rateLabel, rateText, sizeof(rateText), text);
+    snprintf(text, sizeof(text), "CPS   x%.1f background", r.referenceCps > 0.0f ? r.cps / r.referenceCps : 0.0f);
+    setText(ratioLabel, ratioText, sizeof(ratioText), text);
+
+    lv_coord_t full = lv_obj_get_content_width(view) - 2 * MARGIN;
+    lv_coord_t width = r.frequency ? 4 + (lv_coord_t)(r.position * (full - 4)) : 0;
+    if (width != barWidth) {
+        barWidth = width;
+        lv_obj_set_width(bar, width);
+        if (width) lv_obj_clear_flag(bar, LV_OBJ_FLAG_HIDDEN);
+        else lv_obj_add_flag(bar, LV_OBJ_FLAG_HIDDEN);
+    }
+}
+
+static void show(bool visible) {
+    if (visible) {
+        lv_obj_clear_flag(view, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_move_foreground(view);
+        rateText[0] = ratioText[0] = '\0';
+        barWidth = -1;
+        refresh();
+    } else {
+        lv_obj_add_flag(view, LV_OBJ_FLAG_HIDDEN);
+    }
+}
+
+static void eventCb(lv_event_t* e) {
+    lv_event_code_t code = lv_event_get_code(e);
+    if (code == LV_EVENT_SHORT_CLICKED) {
+        searchModeStop();
+        show(false);
+    } else if (code == LV_EVENT_DELETE) {
+        view = rateLabel = ratioLabel = bar = nullptr;
+    }
+}
+
+static void overLongPressedCb(lv_event_t* e) {
+    if (searchModeStart(referenceFn ? referenceFn() : 0.0f)) show(true);
+}
+
+void searchViewAttach(lv_obj_t* screen, lv_obj_t* over, SearchReferenceFn reference) {
+    referenceFn = reference;
+    view = lv_obj_create(screen);
+    lv_obj_set_size(view, lv_obj_get_width(screen), lv_obj_get_height(screen));
+    lv_obj_align(view, LV_ALIGN_TOP_LEFT, 0, 0);
+    lv_obj_set_style_bg_color(view, lv_color_black(), LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(view, LV_OPA_COVER, LV_PART_MAIN);
+    lv_obj_set_style_radius(view, 0, LV_PART_MAIN);
+    lv_obj_set_style_border_width(view, 0, LV_PART_MAIN);
+    lv_obj_set_style_pad_all(view, 0, LV_PART_MAIN);
+    lv_obj_clear_flag(view, LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_GESTURE_BUBBLE);
+    lv_obj_add_flag(view, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_add_event_cb(view, eventCb, LV_EVENT_ALL, NULL);
+
+    lv_obj_t* caption = lv_label_create(view);
+    lv_label_set_text_static(caption, "SEARCH - tap to end");
+    lv_obj_set_style_text_color(caption, COLOR_DIM, LV_PART_MAIN);
+    lv_obj_align(caption, LV_ALIGN_TOP_MID, 0, MARGIN);
+
+    rateLabel = lv_label_create(view);
+    lv_obj_set_style_text_font(rateLabel, &ui_font_Pixel_60, LV_PART_MAIN);
+    lv_obj_set_style_text_color(rateLabel, lv_color_white(), LV_PART_MAIN);
+    lv_label_set_text_static(rateLabel, "");
+    lv_obj_align(rateLabel, LV_ALIGN_CENTER, 0, -30);
+
+    ratioLabel = lv_label_create(view);
+    lv_obj_set_style_text_color(ratioLabel, COLOR_DIM, LV_PART_MAIN);
+    lv_label_set_text_static(ratioLabel, "");
+    lv_obj_align(ratioLabel, LV_ALIGN_CENTER, 0, 30);
+
+    bar = lv_obj_create(view);
+    lv_obj_remove_style_all(bar);
+    lv_obj_set_style_bg_color(bar, COLOR_BAR, LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(bar, LV_OPA_COVER, LV_PART_MAIN);
+    lv_obj_set_height(bar, BAR_HEIGHT);
+    lv_obj_align(bar, LV_ALIGN_BOTTOM_LEFT, MARGIN, -MARGIN);
+    lv_obj_clear_flag(bar, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_add_flag(bar, LV_OBJ_FLAG_HIDDEN);
+
+    lv_obj_add_flag(over, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_add_event_cb(over, overLongPressedCb, LV_EVENT_LONG_PRESSED, NULL);
+    rateText[0] = ratioText[0] = '\0';
+    barWidth = -1;
+}
+
+bool searchViewShown() {
+    return view && !lv_obj_has_flag(view, LV_OBJ_FLAG_HIDDEN);
+}
+
+void searchViewUpdate(uint32_t nowMs) {
+    if (!view) return;
+    bool active = searchModeActive();
+    if (active != searchViewShown()) show(active);
+    if (!active || nowMs - lastUpdateMs < UPDATE_INTERVAL_MS) return;
+    lastUpdateMs = nowMs;
+    refresh();
+}
+
+#endif // !HEADLESS
@@ -0,0 +1,29 @@
+#ifndef SEARCH_VIEW_H
+#define SEARCH_VIEW_H
+
+#include <lvgl.h>
+
+// Full-screen readout of the hot-spot search (search_mode.h) over the main
+// screen: the short-window rate in the large font, its ratio to the
+// reference and a bar at the pitch played, nothing else. The view is opaque
+// and covers the whole screen, so LVGL redraws only the view's own changes;
+// the main screen values are not updated while it is shown. Long press on
+// the dose rate starts a search, a tap on the view ends it. The tone does not
+// depend on this view, it only follows the search at its own pace.
+// LVGL task only.
+
+// Rate the pitch is relative to when a search is started from the screen.
+typedef float (*SearchReferenceFn)();
+
+// Creates the (hidden) view on @p screen; a long press on @p over starts a
+// search relative to @p reference. The view removes itself when its screen is
+// deleted.
+void searchViewAttach(lv_obj_t* screen, lv_obj_t* over, SearchReferenceFn reference);
+
+bool searchViewShown();
+
+// Shows or hides the view as the search starts or ends, and copies the reading
+// while shown, ten times a second.
+void searchViewUpdate(uint32_t nowMs);
+
+#endif // SEARCH_VIEW_H
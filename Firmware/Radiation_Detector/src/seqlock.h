@@ -0,0 +1,61 @@
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+
+/**
+ * @brief Single-writer sequence lock for publishing a small struct across cores.
+ *
+ * The writer bumps the sequence to odd, copies the value and bumps it to even;
+ * it never waits for readers. A reader copies the value between two sequence
+ * loads and accepts it only if both were equal and even. Readers retry a bounded
+ * number of times, so neither side can be blocked by the other for longer than a
+ * struct copy. No Arduino dependencies (host-compilable).
+ *
+ * @tparam T Snapshot type (must be trivially copyable)
+ */
+template <typename T>
+class SeqLock {
+public:
+    SeqLock() : seq_(0) { memset(&value_, 0, sizeof(value_)); }
+
+    /// Writer side (one task only). Wait-free.
+    void publish(const T& value) {
+        uint32_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        memcpy(&value_, &value, sizeof(T));
+        std::atomic_thread_fence(std::memory_order_release);
+        seq_.store(seq + 2, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Reader side (any task). Copies a consistent snapshot into @p out.
+     * @return false if every attempt overlapped a publish; @p out is then unchanged
+     */
+    bool read(T& out, uint8_t maxAttempts = 8) const {
+        T copy;
+        for (uint8_t i = 0; i < maxAttempts; i++) {
+            uint32_t before = seq_.load(std::memory_order_acquire);
+            if (before & 1) continue;
+            memcpy(&copy, &value_, sizeof(T));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq_.load(std::memory_order_relaxed) == before) {
+                out = copy;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Number of completed publishes.
+    uint32_t version() const { return seq_.load(std::memory_order_acquire) / 2; }
+
+private:
+    std::atomic<uint32_t> seq_;
+    T value_;
+};
+
+#endif // SEQLOCK_H
@@ -0,0 +1,183 @@
+#ifndef SERIAL_FRAME_H
+#define SERIAL_FRAME_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Framing of the binary serial protocol (serial_link.h).
+// A frame is {u8 type, u8 sequence, payload, u16 CRC-16/CCITT-FALSE of the
+// preceding bytes, little-endian}, COBS-encoded so it contains no zero byte,
+// and sent as 0x00 <encoded> 0x00. The leading zero ends whatever partial text
+// line came before it; a receiver splits the stream at zeros and keeps the
+// pieces whose CRC matches. No Arduino dependencies (host-compilable).
+
+static const size_t SERIAL_FRAME_MAX_PAYLOAD = 256;
+static const size_t SERIAL_FRAME_MAX_RAW = SERIAL_FRAME_MAX_PAYLOAD + 4;          ///< type, seq, CRC
+static const size_t SERIAL_FRAME_MAX_ENCODED = SERIAL_FRAME_MAX_RAW + SERIAL_FRAME_MAX_RAW / 254 + 3;
+
+inline uint16_t serialFrameCrc(const uint8_t* data, size_t length, uint16_t crc = 0xFFFF) {
+    while (length--) {
+        crc ^= (uint16_t)(*data++) << 8;
+        for (uint8_t bit = 0; bit < 8; bit++) crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+    return crc;
+}
+
+/**
+ * @brief COBS-encodes @p length bytes into @p out (at most length + length / 254 + 1 bytes).
+ * @return the encoded length
+ */
+inline size_t cobsEncode(const uint8_t* in, size_t length, uint8_t* out) {
+    size_t codeIndex = 0;
+    size_t o = 1;
+    uint8_t code = 1;
+    for (size_t i = 0; i < length; i++) {
+        if (in[i] == 0) {
+            out[codeIndex] = code;
+            codeIndex = o++;
+            code = 1;
+            continue;
+        }
+        out[o++] = in[i];
+        if (++code == 0xFF) {
+            out[codeIndex] = code;
+            codeIndex = o++;
+            code = 1;
+        }
+    }
+    out[codeIndex] = code;
+    return o;
+}
+
+/**
+ * @brief Decodes a COBS block (without the zero delimiter) in place.
+ * @return the decoded length, 0 if the block is malformed
+ */
+inline size_t cobsDecode(uint8_t* data, size_t length) {
+    size_t in = 0;
+    size_t out = 0;
+    while (in < length) {
+        uint8_t code = data[in++];
+        if (code == 0 || in + code - 1 > length) return 0;
+        for (uint8_t i = 1; i < code; i++) data[out++] = data[in++];
+        if (code != 0xFF && in < length) data[out++] = 0;
+    }
+    return out;
+}
+
+/**
+ * @brief Builds 0x00 <COBS frame> 0x00 into @p out (SERIAL_FRAME_MAX_ENCODED + 1 bytes).
+ * @return the number of bytes to send, 0 if the payload is too long
+ */
+inline size_t encodeSerialFrame(uint8_t type, uint8_t sequence, const void* payload, size_t length, uint8_t* out) {
+    if (length > SERIAL_FRAME_MAX_PAYLOAD) return 0;
+    uint8_t raw[SERIAL_FRAME_MAX_RAW];
+    raw[0] = type;
+    raw[1] = sequence;
+    if (length) memcpy(raw + 2, payload, length);
+    uint16_t crc = serialFrameCrc(raw, length + 2);
+    raw[length + 2] = crc & 0xFF;
+    raw[length + 3] = crc >> 8;
+    out[0] = 0;
+    size_t n = cobsEncode(raw, length + 4, out + 1);
+    out[n + 1] = 0;
+    return n + 2;
+}
+
+/**
+ * @brief Splits a byte stream into text lines and frames.
+ *
+ * Bytes are text until a zero arrives; from there up to the next zero they
+ * are a frame. Text lines end at '\n' ('\r' is dropped). Over-long lines and
+ * frames are discarded up to their end.
+ */
+template <size_t LINE_MAX>
+class SerialFrameDecoder {
+public:
+    enum Result { NONE = 0, LINE, FRAME, BAD_FRAME };
+
+    SerialFrameDecoder() : inFrame_(false), lineLength_(0), frameLength_(0), overflow_(false) {}
+
+    /**
+     * @brief Consumes one byte.
+     * @return LINE when line() holds a complete line, FRAME when type(),
+     *         payload() and length() describe a frame with a valid CRC
+     */
+    Result feed(uint8_t byte) {
+        if (!inFrame_) {
+            if (byte == 0) {
+                // Start of a frame; a pending partial line is dropped
+                inFrame_ = true;
+                frameLength_ = 0;
+                lineLength_ = 0;
+                overflow_ = false;
+                return NONE;
+            }
+            if (byte == '\r') return NONE;
+            if (byte == '\n') {
+                bool complete = !overflow_;
+                line_[lineLength_] = '\0';
+                lineLength_ = 0;
+                overflow_ = false;
+                return complete ? LINE : NONE;
+            }
+            if (lineLength_ < LINE_MAX - 1) {
+                line_[lineLength_++] = (char)byte;
+            } else {
+                overflow_ = true;
+            }
+            return NONE;
+        }
+
+        if (byte != 0) {
+            if (frameLength_ < sizeof(frame_)) {
+                frame_[frameLength_++] = byte;
+            } else {
+                overflow_ = true;
+            }
+            return NONE;
+        }
+        // End of the frame (two zeros in a row are an empty frame: stay in frame mode)
+        if (frameLength_ == 0) return NONE;
+        inFrame_ = false;
+        size_t n = overflow_ ? 0 : cobsDecode(frame_, frameLength_);
+        overflow_ = false;
+        frameLength_ = 0;
+        if (n < 4 || serialFrameCrc(frame_, n - 2) != (uint16_t)(frame_[n - 2] | (frame_[n - 1] << 8))) {
+            return BAD_FRAME;
+        }
+        payloadLength_ = n - 4;
+        return FRAME;
+    }
+
+    /// True between a frame's opening zero and its end.
+    bool inFrame() const { return inFrame_; }
+
+    /// Drops a partial line or frame (the link calls this when a frame stalls).
+    void reset() {
+        inFrame_ = false;
+        lineLength_ = 0;
+        frameLength_ = 0;
+        overflow_ = false;
+    }
+
+    /// Last complete text line, without the line end.
+    const char* line() const { return line_; }
+
+    uint8_t type() const { return frame_[0]; }
+    uint8_t sequence() const { return frame_[1]; }
+    const uint8_t* payload() const { return frame_ + 2; }
+    size_t length() const { return payloadLength_; }
+
+private:
+    bool inFrame_;
+    char line_[LINE_MAX];
+    size_t lineLength_;
+    uint8_t frame_[SERIAL_FRAME_MAX_ENCODED];
+    size_t frameLength_;
+    size_t payloadLength_;
+    bool overflow_;
+};
+
+#endif // SERIAL_FRAME_H
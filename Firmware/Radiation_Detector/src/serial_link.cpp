@@ -0,0 +1,262 @@
+/**
+ * @file serial_link.cpp
+ * @brief Serial input demultiplexing, typed commands and the binary streams.
+ */
+
+#include "serial_link.h"
+#include "serial_frame.h"
+#include "spsc_ring.h"
+#include "spectrum.h"
+#include <atomic>
+#include "esp_ota_ops.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+
+static const uint8_t PROTOCOL_VERSION = 1;
+static const uint8_t LINE_QUEUE_DEPTH = 4;
+static const uint32_t FRAME_STALL_MS = 200;    ///< A frame with no new byte for this long is dropped
+static const uint32_t PULSE_FLUSH_MS = 50;     ///< Longest a pulse timestamp waits for a full frame
+static const size_t PULSES_PER_FRAME = 60;
+static const size_t CHANNELS_PER_FRAME = 56;
+static const TickType_t LINK_POLL = pdMS_TO_TICKS(5);
+
+struct SecondRecord {
+    uint32_t second;
+    uint32_t counts;
+    uint32_t total;
+};
+
+struct TextLine {
+    char text[SERIAL_LINE_MAX];
+};
+
+static SerialFrameDecoder<SERIAL_LINE_MAX> decoder;
+static QueueHandle_t lineQueue = nullptr;
+static TaskHandle_t linkTask = nullptr;
+static Spectrum* linkSpectrum = nullptr;
+static SerialStatusSource statusSource = nullptr;
+static std::atomic<uint8_t> streams(0);
+static SpscRing<SecondRecord, 16> secondRing;
+static SpscRing<uint32_t, SERIAL_LINK_PULSE_QUEUE> pulseRing;
+static uint8_t txSequence = 0;
+static uint8_t txBuffer[SERIAL_FRAME_MAX_ENCODED + 1];
+
+/**
+ * @brief Sends one frame if the transmit buffer has room for all of it.
+ * @return false if it was dropped
+ */
+static bool sendFrame(uint8_t type, const void* payload, size_t length) {
+    size_t n = encodeSerialFrame(type, txSequence, payload, length, txBuffer);
+    txSequence++; // Also for dropped frames: the gap tells the host
+    if (!n || Serial.availableForWrite() < (int)n) return false;
+    Serial.write(txBuffer, n);
+    return true;
+}
+
+static void sendAck(uint8_t command, bool ok) {
+    uint8_t payload[2] = {command, (uint8_t)(ok ? 1 : 0)};
+    sendFrame(SERIAL_MSG_ACK, payload, sizeof(payload));
+}
+
+static void sendHello() {
+    uint8_t payload[2 + 32];
+    const char* version = esp_ota_get_app_description()->version;
+    size_t length = strnlen(version, 32);
+    payload[0] = PROTOCOL_VERSION;
+    payload[1] = streams;
+    memcpy(payload + 2, version, length);
+    sendFrame(SERIAL_MSG_HELLO, payload, 2 + length);
+}
+
+static void queueLine(const char* text) {
+    TextLine line;
+    strlcpy(line.text, text, sizeof(line.text));
+    // A full queue drops the line: a host typing faster than the UI task executes
+    xQueueSend(lineQueue, &line, 0);
+}
+
+static void handleFrame() {
+    uint8_t type = decoder.type();
+    const uint8_t* payload = decoder.payload();
+    size_t length = decoder.length();
+    switch (type) {
+        case SERIAL_CMD_PING:
+            sendHello();
+            break;
+        case SERIAL_CMD_STREAM: {
+            if (length < 1) {
+                sendAck(type, false);
+                break;
+            }
+            uint8_t mask = payload[0] & (SERIAL_STREAM_SECONDS | SERIAL_STREAM_PULSES | SERIAL_STREAM_SPECTRUM);
+            uint8_t enabled = mask & ~streams.load();
+            // Start newly enabled streams from now, not from what queued before
+            SecondRecord second;
+            uint32_t timestamp;
+            if (enabled & SERIAL_STREAM_SECONDS) while (secondRing.pop(second)) {}
+            if (enabled & SERIAL_STREAM_PULSES) while (pulseRing.pop(timestamp)) {}
+            streams = mask;
+            sendAck(type, true);
+            break;
+        }
+        case SERIAL_CMD_STATUS: {
+            SerialStatusPayload status;
+            memset(&status, 0, sizeof(status));
+            if (statusSource) statusSource(status);
+            sendFrame(SERIAL_MSG_STATUS, &status, sizeof(status));
+            break;
+        }
+        case SERIAL_CMD_TEXT: {
+            char text[SERIAL_LINE_MAX];
+            size_t n = length < sizeof(text) - 1 ? length : sizeof(text) - 1;
+            memcpy(text, payload, n);
+            text[n] = '\0';
+            queueLine(text);
+            sendAck(type, true);
+            break;
+        }
+        default:
+            sendAck(type, false);
+            break;
+    }
+}
+
+/**
+ * @brief Reads everything the port has; lines are queued, frames handled.
+ * @return true if a text line completed (used by the fallback without the task)
+ */
+static bool pollInput(uint32_t nowMs) {
+    static uint32_t lastByteMs = 0;
+    bool line = false;
+    while (Serial.available() > 0) {
+        int byte = Serial.read();
+        if (byte < 0) break;
+        lastByteMs = nowMs;
+        switch (decoder.feed((uint8_t)byte)) {
+            case SerialFrameDecoder<SERIAL_LINE_MAX>::LINE:
+                if (lineQueue) queueLine(decoder.line());
+                line = true;
+                break;
+            case SerialFrameDecoder<SERIAL_LINE_MAX>::FRAME:
+                handleFrame();
+                break;
+            default:
+                break;
+        }
+        if (line && !lineQueue) return true; // Fallback: one line per call
+    }
+    if (decoder.inFrame() && nowMs - lastByteMs >= FRAME_STALL_MS) decoder.reset();
+    return line;
+}
+
+static void sendSeconds() {
+    SecondRecord record;
+    while (secondRing.peek(record)) {
+        uint32_t payload[4] = {record.second, record.counts, record.total, (uint32_t)pulseRing.dropped()};
+        if (!sendFrame(SERIAL_MSG_SECOND, payload, sizeof(payload))) return; // Retry next pass
+        secondRing.pop(record);
+    }
+}
+
+static void sendPulses(uint32_t nowMs) {
+    static uint32_t waitingSinceMs = 0;
+    for (;;) {
+        size_t queued = pulseRing.size();
+        if (!queued) {
+            waitingSinceMs = nowMs;
+            return;
+        }
+        if (queued < PULSES_PER_FRAME && nowMs - waitingSinceMs < PULSE_FLUSH_MS) return;
+        uint32_t timestamps[PULSES_PER_FRAME];
+        size_t n = 0;
+        while (n < PULSES_PER_FRAME && pulseRing.pop(timestamps[n])) n++;
+        sendFrame(SERIAL_MSG_PULSES, timestamps, n * sizeof(uint32_t));
+        waitingSinceMs = nowMs;
+    }
+}
+
+static void sendSpectrum(uint32_t nowMs) {
+    static uint32_t lastMs = 0;
+    if (!linkSpectrum || !linkSpectrum->ready() || nowMs - lastMs < SERIAL_LINK_SPECTRUM_MS) return;
+    lastMs = nowMs;
+    struct {                 // No padding: the wire layout as is
+        uint16_t first;
+        uint16_t channels;
+        uint32_t liveMs;
+        uint32_t total;
+        uint32_t counts[CHANNELS_PER_FRAME];
+    } chunk;
+    chunk.channels = linkSpectrum->channels();
+    chunk.liveMs = linkSpectrum->liveMs();
+    chunk.total = linkSpectrum->total();
+    for (uint32_t first = 0; first < chunk.channels; first += CHANNELS_PER_FRAME) {
+        chunk.first = first;
+        size_t n = linkSpectrum->read(first, chunk.counts, CHANNELS_PER_FRAME);
+        size_t length = sizeof(chunk) - sizeof(chunk.counts) + n * sizeof(uint32_t);
+        // Wait a little for room rather than leave a hole in the snapshot; a
+        // port nobody reads gives up the rest of the snapshot instead
+        uint8_t waits = 0;
+        while (Serial.availableForWrite() < (int)(length + length / 254 + 8) && waits++ < 20) vTaskDelay(LINK_POLL);
+        if (!sendFrame(SERIAL_MSG_SPECTRUM, &chunk, length)) return;
+    }
+}
+
+static void serialLinkTask(void* parameter) {
+    for (;;) {
+        uint32_t nowMs = millis();
+        pollInput(nowMs);
+        uint8_t active = streams;
+        if (active & SERIAL_STREAM_SECONDS) sendSeconds();
+        if (active & SERIAL_STREAM_PULSES) sendPulses(nowMs);
+        if (active & SERIAL_STREAM_SPECTRUM) sendSpectrum(nowMs);
+        vTaskDelay(LINK_POLL);
+    }
+}
+
+bool serialLinkBegin(Spectrum* spectrum, SerialStatusSource status) {
+#if SERIAL_LINK_ENABLED
+    if (linkTask) return true;
+    linkSpectrum = spectrum;
+    statusSource = status;
+    lineQueue = xQueueCreate(LINE_QUEUE_DEPTH, sizeof(TextLine));
+    if (!lineQueue) return false;
+    // Same core and priority as the UI task, which it only hands lines to
+    if (xTaskCreatePinnedToCore(serialLinkTask, "SerialLink", 4096, NULL, UI_TASK_PRIORITY, &linkTask,
+                                TASK_CORE_UI) != pdPASS) {
+        vQueueDelete(lineQueue);
+        lineQueue = nullptr;
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool serialLinkReadLine(char* out) {
+    if (!lineQueue) {
+        // No link task: read the port here, still without waiting for a line end
+        if (!pollInput(millis())) return false;
+        strlcpy(out, decoder.line(), SERIAL_LINE_MAX);
+        return true;
+    }
+    TextLine line;
+    if (xQueueReceive(lineQueue, &line, 0) != pdTRUE) return false;
+    strlcpy(out, line.text, SERIAL_LINE_MAX);
+    return true;
+}
+
+void serialLinkSecond(uint32_t second, uint32_t counts, uint32_t totalCounts) {
+    if (!(streams.load(std::memory_order_relaxed) & SERIAL_STREAM_SECONDS)) return;
+    SecondRecord record = {second, counts, totalCounts};
+    secondRing.push(record);
+}
+
+void serialLinkPulse(uint32_t timestampUs) {
+    if (!(streams.load(std::memory_order_relaxed) & SERIAL_STREAM_PULSES)) return;
+    pulseRing.push(timestampUs);
+}
+
+uint8_t serialLinkStreams() {
+    return streams;
+}
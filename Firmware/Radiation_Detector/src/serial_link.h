@@ -0,0 +1,83 @@
+#ifndef SERIAL_LINK_H
+#define SERIAL_LINK_H
+
+#include <Arduino.h>
+#include "config.h"
+
+class Spectrum;
+
+// Non-blocking serial input and the binary streaming protocol.
+// A low-priority task owns the serial input. Text lines go to a queue that
+// processSerialCommands() empties without waiting, so a partial line never
+// stalls the UI task. Frames (serial_frame.h: COBS, CRC-16, {type, sequence,
+// payload}) are handled on the task itself. Text output (command replies,
+// DEBUG_PRINTF) and frames share the port; a host splits the input at zero
+// bytes and keeps the pieces whose CRC matches. The sequence number of the
+// device's frames counts up by one per frame, a gap means dropped frames
+// (frames that do not fit the transmit buffer are dropped, not waited for).
+//
+// Payloads are little-endian and packed:
+//   host -> device
+//     PING      (empty)                     -> HELLO
+//     STREAM    u8 mask of SerialStream     -> ACK
+//     STATUS    (empty)                     -> STATUS
+//     TEXT      command line, as typed      -> text reply, then ACK
+//   device -> host
+//     HELLO     u8 protocol, u8 streams, firmware version (rest of frame)
+//     ACK       u8 command type, u8 1 ok / 0 rejected
+//     STATUS    SerialStatusPayload
+//     SECOND    u32 second number, u32 counts in the second, u32 total counts,
+//               u32 pulse timestamps dropped so far
+//     PULSES    u32 timestamps (µs, esp_timer, wrapping), up to 60 per frame
+//     SPECTRUM  u16 first channel, u16 channels, u32 live ms, u32 total, then
+//               up to 56 u32 counts; every SERIAL_LINK_SPECTRUM_MS, all channels
+
+enum SerialFrameType {
+    SERIAL_CMD_PING = 0x01,
+    SERIAL_CMD_STREAM = 0x02,
+    SERIAL_CMD_STATUS = 0x03,
+    SERIAL_CMD_TEXT = 0x04,
+    SERIAL_MSG_HELLO = 0x81,
+    SERIAL_MSG_ACK = 0x82,
+    SERIAL_MSG_STATUS = 0x83,
+    SERIAL_MSG_SECOND = 0x84,
+    SERIAL_MSG_PULSES = 0x85,
+    SERIAL_MSG_SPECTRUM = 0x86
+};
+
+enum SerialStream {
+    SERIAL_STREAM_SECONDS = 1 << 0,
+    SERIAL_STREAM_PULSES = 1 << 1,
+    SERIAL_STREAM_SPECTRUM = 1 << 2
+};
+
+struct __attribute__((packed)) SerialStatusPayload {
+    uint32_t uptimeSeconds;
+    uint32_t totalCounts;
+    float cpm;             ///< Dead-time corrected
+    float doseRateUsvH;
+    float cumulativeMsv;
+    uint8_t alarmLevel;
+};
+
+typedef void (*SerialStatusSource)(SerialStatusPayload& out);
+
+static const size_t SERIAL_LINE_MAX = 160;
+
+// Starts the link task. @p spectrum may be null (no SPECTRUM stream).
+bool serialLinkBegin(Spectrum* spectrum, SerialStatusSource status);
+
+// Copies the oldest queued text line into @p out (SERIAL_LINE_MAX bytes).
+// @return false if none is waiting
+bool serialLinkReadLine(char* out);
+
+// pulseTask: a second closed with @p counts.
+void serialLinkSecond(uint32_t second, uint32_t counts, uint32_t totalCounts);
+
+// pulseTask: one Geiger pulse timestamp.
+void serialLinkPulse(uint32_t timestampUs);
+
+// Enabled SerialStream bits.
+uint8_t serialLinkStreams();
+
+#endif // SERIAL_LINK_H
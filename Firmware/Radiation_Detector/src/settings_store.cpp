@@ -0,0 +1,238 @@
+/**
+ * @file settings_store.cpp
+ * @brief RAM cache of the settings with coalesced, deferred NVS commits.
+ *
+ * The cache is guarded by a spinlock held only for a few word copies, so the
+ * getters and setters are cheap enough for the LVGL handlers and the hot loops.
+ * A commit snapshots the dirty entries, clears their flags and writes them
+ * outside the lock; a setter racing with the write simply marks its entry dirty
+ * again and wakes the task for another round. A failed commit puts the flags
+ * back so nothing is lost.
+ *
+ * Preferences commits after every put, so a commit goes through the NVS handle
+ * directly. It sets every dirty entry, then makes one nvs_commit() for the
+ * batch. The encodings are the ones Preferences uses (i32, u8, a 4-byte blob
+ * for floats), so both read the same keys.
+ */
+
+#include "settings_store.h"
+#include "tube_profile.h"
+#include "debug.h"
+#include <Preferences.h>
+#include "nvs.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+enum SettingType {
+    SETTING_TYPE_INT,
+    SETTING_TYPE_FLOAT,
+    SETTING_TYPE_BOOL
+};
+
+union SettingValue {
+    int32_t i;
+    float f;
+    bool b;
+};
+
+struct SettingDef {
+    const char* key;      ///< NVS key in the "settings" namespace (unchanged from earlier firmware)
+    SettingType type;
+    int32_t defaultInt;   ///< Default of int and bool settings
+    float defaultFloat;   ///< Default of float settings
+};
+
+// Order matches SettingId
+static const SettingDef SETTINGS[SETTING_COUNT] = {
+    {"currentAlarm", SETTING_TYPE_INT, 50, 0.0f},     // 5.0 µSv/h
+    {"cumulativeAlarm", SETTING_TYPE_INT, 10, 0.0f},  // 1.0 mSv
+    {"alarmEnabled", SETTING_TYPE_BOOL, 0, 0.0f},
+    {"onstartup", SETTING_TYPE_BOOL, 0, 0.0f},
+    {"deadTimeUs", SETTING_TYPE_FLOAT, 0, DEAD_TIME_DEFAULT_US},
+    {"cpmPerUsvH", SETTING_TYPE_FLOAT, 0, CONVERSION_FACTOR_DEFAULT},
+    {"dispTimeout", SETTING_TYPE_INT, DISPLAY_TIMEOUT_DEFAULT_MS, 0.0f},
+    {"cfgVersion", SETTING_TYPE_INT, 0, 0.0f},
+    {"clicks", SETTING_TYPE_BOOL, 0, 0.0f},
+    {"hvTarget", SETTING_TYPE_FLOAT, 0, HV_TARGET_DEFAULT_V},
+    {"calRef", SETTING_TYPE_FLOAT, 0, CALIBRATION_REFERENCE_DEFAULT},
+    {"calRel", SETTING_TYPE_FLOAT, 0, 0.0f},
+    {"calTime", SETTING_TYPE_INT, 0, 0.0f},
+    {"calBgCps", SETTING_TYPE_FLOAT, 0, 0.0f},
+    {"calBgS", SETTING_TYPE_FLOAT, 0, 0.0f},
+};
+
+static const char* SETTINGS_NAMESPACE = "settings";
+
+static SettingValue values[SETTING_COUNT];
+static uint32_t dirtyMask = 0;
+static portMUX_TYPE settingsLock = portMUX_INITIALIZER_UNLOCKED;
+static SemaphoreHandle_t commitMutex = nullptr; ///< Serialises the task's commits with settingsFlush()
+static TaskHandle_t commitTaskHandle = nullptr;
+static SettingsStoreStats stats;
+
+/**
+ * @brief Value of @p id when its key is not in NVS yet.
+ */
+static SettingValue defaultValue(SettingId id) {
+    SettingValue value;
+    value.i = 0;
+    switch (SETTINGS[id].type) {
+        case SETTING_TYPE_INT:   value.i = SETTINGS[id].defaultInt; break;
+        case SETTING_TYPE_FLOAT: value.f = SETTINGS[id].defaultFloat; break;
+        case SETTING_TYPE_BOOL:  value.b = SETTINGS[id].defaultInt != 0; break;
+    }
+    return value;
+}
+
+/**
+ * @brief Writes every dirty entry in one NVS session.
+ */
+static void commitPending() {
+    xSemaphoreTake(commitMutex, portMAX_DELAY);
+
+    SettingValue snapshot[SETTING_COUNT];
+    portENTER_CRITICAL(&settingsLock);
+    uint32_t mask = dirtyMask;
+    dirtyMask = 0;
+    memcpy(snapshot, values, sizeof(snapshot));
+    portEXIT_CRITICAL(&settingsLock);
+
+    if (mask) {
+        nvs_handle_t handle;
+        esp_err_t err = nvs_open(SETTINGS_NAMESPACE, NVS_READWRITE, &handle);
+        if (err == ESP_OK) {
+            uint32_t written = 0;
+            uint32_t failed = 0;
+            for (int id = 0; id < SETTING_COUNT; id++) {
+                if (!(mask & (1u << id))) continue;
+                switch (SETTINGS[id].type) {
+                    case SETTING_TYPE_INT:   err = nvs_set_i32(handle, SETTINGS[id].key, snapshot[id].i); break;
+                    case SETTING_TYPE_FLOAT: err = nvs_set_blob(handle, SETTINGS[id].key, &snapshot[id].f, sizeof(float)); break;
+                    case SETTING_TYPE_BOOL:  err = nvs_set_u8(handle, SETTINGS[id].key, snapshot[id].b ? 1 : 0); break;
+                }
+                if (err == ESP_OK) written++;
+                else failed |= 1u << id;
+            }
+            if (nvs_commit(handle) != ESP_OK) failed = mask;
+            nvs_close(handle);
+            stats.commits++;
+            stats.writes += written;
+            if (failed) {
+                portENTER_CRITICAL(&settingsLock);
+                dirtyMask |= failed; // Retried with the next change or flush
+                portEXIT_CRITICAL(&settingsLock);
+                stats.failures++;
+            }
+            DEBUG_PRINTF("Settings: %lu value(s) committed\n", (unsigned long)written);
+        } else {
+            portENTER_CRITICAL(&settingsLock);
+            dirtyMask |= mask; // Retried with the next change or flush
+            portEXIT_CRITICAL(&settingsLock);
+            stats.failures++;
+        }
+    }
+
+    xSemaphoreGive(commitMutex);
+}
+
+/**
+ * @brief Waits for a change, then for SETTINGS_COMMIT_DELAY_MS without one, and commits.
+ */
+static void settingsCommitTask(void* parameter) {
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        // Every further change restarts the quiet period
+        while (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(SETTINGS_COMMIT_DELAY_MS)) > 0) {
+        }
+        commitPending();
+    }
+}
+
+bool initSettingsStore() {
+    if (commitMutex) return true;
+
+    Preferences prefs;
+    bool opened = prefs.begin(SETTINGS_NAMESPACE, true); // Fails only if the namespace was never written
+    for (int id = 0; id < SETTING_COUNT; id++) {
+        SettingValue value = defaultValue((SettingId)id);
+        if (opened) {
+            switch (SETTINGS[id].type) {
+                case SETTING_TYPE_INT:   value.i = prefs.getInt(SETTINGS[id].key, value.i); break;
+                case SETTING_TYPE_FLOAT: value.f = prefs.getFloat(SETTINGS[id].key, value.f); break;
+                case SETTING_TYPE_BOOL:  value.b = prefs.getBool(SETTINGS[id].key, value.b); break;
+            }
+        }
+        values[id] = value;
+    }
+    if (opened) prefs.end();
+
+    commitMutex = xSemaphoreCreateMutex();
+    if (!commitMutex) return false;
+    return xTaskCreatePinnedToCore(settingsCommitTask, "Settings", 3072, NULL,
+                                   tskIDLE_PRIORITY + 1, &commitTaskHandle, 0) == pdPASS;
+}
+
+static SettingValue getValue(SettingId id) {
+    portENTER_CRITICAL(&settingsLock);
+    SettingValue value = values[id];
+    portEXIT_CRITICAL(&settingsLock);
+    return value;
+}
+
+/**
+ * @brief Stores @p value and schedules a commit if it differs from the cached one.
+ */
+static void setValue(SettingId id, SettingValue value) {
+    bool changed;
+    portENTER_CRITICAL(&settingsLock);
+    switch (SETTINGS[id].type) {
+        case SETTING_TYPE_INT:   changed = values[id].i != value.i; break;
+        case SETTING_TYPE_FLOAT: changed = values[id].f != value.f; break;
+        default:                 changed = values[id].b != value.b; break;
+    }
+    if (changed) {
+        values[id] = value;
+        dirtyMask |= 1u << id;
+    }
+    portEXIT_CRITICAL(&settingsLock);
+
+    if (changed && commitTaskHandle) xTaskNotifyGive(commitTaskHandle);
+}
+
+int32_t settingGetInt(SettingId id) { return getValue(id).i; }
+float settingGetFloat(SettingId id) { return getValue(id).f; }
+bool settingGetBool(SettingId id) { return getValue(id).b; }
+
+void settingSetInt(SettingId id, int32_t value) {
+    SettingValue v;
+    v.i = value;
+    setValue(id, v);
+}
+
+void settingSetFloat(SettingId id, float value) {
+    SettingValue v;
+    v.f = value;
+    setValue(id, v);
+}
+
+void settingSetBool(SettingId id, bool value) {
+    SettingValue v;
+    v.i = 0; // Keep the unused bytes defined
+    v.b = value;
+    setValue(id, v);
+}
+
+void settingsFlush() {
+    if (commitMutex) commitPending();
+}
+
+SettingsStoreStats getSettingsStoreStats() {
+    SettingsStoreStats s = stats;
+    uint32_t mask;
+    portENTER_CRITICAL(&settingsLock);
+    mask = dirtyMask;
+    portEXIT_CRITICAL(&settingsLock);
+    s.pending = __builtin_popcount(mask);
+    return s;
+}
@@ -0,0 +1,59 @@
+#ifndef SETTINGS_STORE_H
+#define SETTINGS_STORE_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Cached, write-behind persistence of the user settings (Preferences "settings").
+// Every value is read from NVS once by initSettingsStore() and served from RAM
+// afterwards. Setters only update the cache and mark the entry dirty; a
+// background task commits all dirty entries in one NVS session, with one
+// nvs_commit(), once no change has arrived for SETTINGS_COMMIT_DELAY_MS. Holding a spinbox arrow therefore
+// costs one flash write, made outside the LVGL handler, instead of one per step.
+
+enum SettingId {
+    SETTING_CURRENT_ALARM = 0, ///< int: dose-rate alarm threshold, µSv/h x10
+    SETTING_CUMULATIVE_ALARM,  ///< int: cumulative dose alarm threshold, mSv x10
+    SETTING_ALARM_ENABLED,     ///< bool
+    SETTING_ON_STARTUP,        ///< bool: connect WiFi at boot
+    SETTING_DEAD_TIME_US,      ///< float: tube dead time
+    SETTING_CONVERSION_FACTOR, ///< float: CPM per µSv/h
+    SETTING_DISPLAY_TIMEOUT,   ///< int: ms without input before the display dims
+    SETTING_CONFIG_VERSION,    ///< int: DeviceConfig layout the values were written with (0: legacy)
+    SETTING_CLICKS,            ///< bool: audible click per pulse
+    SETTING_HV_TARGET,         ///< float: tube operating voltage
+    SETTING_CAL_REFERENCE,     ///< float: reference dose rate of the last calibration, µSv/h
+    SETTING_CAL_REL,           ///< float: relative 1-sigma of the calibrated factor (0: never calibrated)
+    SETTING_CAL_TIME,          ///< int: UTC seconds of the last calibration (0: clock not set)
+    SETTING_CAL_BACKGROUND,    ///< float: stored background, dead-time corrected cps
+    SETTING_CAL_BACKGROUND_S,  ///< float: its live time (0: none)
+    SETTING_COUNT
+};
+
+struct SettingsStoreStats {
+    uint32_t commits;    ///< NVS sessions opened by the store
+    uint32_t writes;     ///< Entries written
+    uint32_t failures;   ///< Commits that could not open NVS (retried)
+    uint8_t pending;     ///< Entries waiting for the next commit
+};
+
+// Loads every setting (defaults for missing keys) and starts the commit task.
+// Call early in setup(), before anything reads a setting.
+bool initSettingsStore();
+
+int32_t settingGetInt(SettingId id);
+float settingGetFloat(SettingId id);
+bool settingGetBool(SettingId id);
+
+// Update the cache; the entry is scheduled for writing only if the value changed.
+// Any task, never blocks on flash.
+void settingSetInt(SettingId id, int32_t value);
+void settingSetFloat(SettingId id, float value);
+void settingSetBool(SettingId id, bool value);
+
+// Writes pending changes now (before a reboot or OTA). Blocks for the NVS write.
+void settingsFlush();
+
+SettingsStoreStats getSettingsStoreStats();
+
+#endif // SETTINGS_STORE_H
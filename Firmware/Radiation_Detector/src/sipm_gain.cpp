@@ -0,0 +1,188 @@
+/**
+ * @file sipm_gain.cpp
+ * @brief Temperature and peak-position gain correction via a channel table.
+ *
+ * The table has one entry per ADC code (4096 x 2 B in internal RAM), written
+ * in place by the loop on the UI task while pulseTask reads it; see
+ * Spectrum::setChannelMap() for why that is safe. It is only rebuilt when
+ * the gain moved by more than SIPM_GAIN_REBUILD_STEP, a few times an hour
+ * outdoors. The peak window is counted by pulseTask into two atomics and
+ * taken by the loop once it holds SIPM_STABILIZE_MIN_COUNTS, so a step is
+ * always based on the pulses binned with the current table.
+ */
+
+#include "sipm_gain.h"
+#include "spectrum_analysis.h"
+#include "esp_heap_caps.h"
+#include <atomic>
+#include <math.h>
+
+static Spectrum* gainSpectrum = nullptr;
+static uint16_t* table = nullptr;
+static SipmGainStatus status;
+static float builtGain = 0.0f;     ///< Gain the table holds, 0 while not built
+static uint32_t lastLoopMs = 0;
+
+// Peak window [lo, mid) and [mid, hi), written by the loop, read by pulseTask
+static volatile uint16_t windowLo = 0;
+static volatile uint16_t windowMid = 0;
+static volatile uint16_t windowHi = 0;
+static std::atomic<uint32_t> lowerCount(0);
+static std::atomic<uint32_t> upperCount(0);
+
+static bool usesTemperature() {
+    return status.mode == SIPM_GAIN_TEMPERATURE || status.mode == SIPM_GAIN_BOTH;
+}
+
+static bool usesPeak() {
+    return status.mode == SIPM_GAIN_PEAK || status.mode == SIPM_GAIN_BOTH;
+}
+
+static void buildTable(float gain) {
+    uint32_t codes = gainSpectrum->codes();
+    uint16_t channels = gainSpectrum->channels();
+    float scale = gain * channels / codes;
+    for (uint32_t code = 0; code < codes; code++) {
+        uint32_t channel = (uint32_t)(code * scale);
+        table[code] = channel < channels ? channel : channels - 1;
+    }
+    builtGain = gain;
+    status.tableBuilds++;
+    gainSpectrum->setChannelMap(table);
+    // The window restarts with the pulses binned through the new table
+    lowerCount.store(0, std::memory_order_relaxed);
+    upperCount.store(0, std::memory_order_relaxed);
+}
+
+static void setWindow(float channel) {
+    status.peakChannel = channel;
+    if (channel <= 0.0f) {
+        windowLo = windowMid = windowHi = 0; // Nothing to hold
+        status.windowHalf = 0;
+        return;
+    }
+    float half = SPECTRUM_RESOLUTION_662 * channel; // One FWHM on each side
+    if (half < 2.0f) half = 2.0f;
+    uint16_t mid = (uint16_t)(channel + 0.5f);
+    status.windowHalf = (uint16_t)(half + 0.5f);
+    windowLo = mid > status.windowHalf ? mid - status.windowHalf : 0;
+    windowMid = mid;
+    windowHi = mid + status.windowHalf;
+    lowerCount.store(0, std::memory_order_relaxed);
+    upperCount.store(0, std::memory_order_relaxed);
+}
+
+static bool readTemperature(float* celsius) {
+#if SIPM_TEMP_SOURCE == 1
+    float t = temperatureRead() + SIPM_TEMP_OFFSET_C; // Die sensor of the S3
+    if (t < -40.0f || t > 125.0f) return false;
+    *celsius = t;
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool initSipmGain(Spectrum& spectrum) {
+    if (!spectrum.ready()) return false;
+    size_t bytes = spectrum.codes() * sizeof(uint16_t);
+    table = (uint16_t*)heap_caps_malloc(bytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT); // Read per pulse
+    if (!table) table = (uint16_t*)heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!table) return false;
+    gainSpectrum = &spectrum;
+    status.temperatureFactor = 1.0f;
+    status.peakFactor = 1.0f;
+    status.gain = 1.0f;
+    setSipmGainPeak(0.0f);
+    setSipmGainMode((SipmGainMode)SIPM_GAIN_MODE);
+    return true;
+}
+
+void sipmGainObserve(uint16_t channel) {
+    if (channel < windowLo || channel >= windowHi) return;
+    if (channel < windowMid) lowerCount.fetch_add(1, std::memory_order_relaxed);
+    else upperCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void sipmGainLoop(uint32_t nowMs) {
+    if (!table || status.mode == SIPM_GAIN_OFF || nowMs - lastLoopMs < SIPM_GAIN_INTERVAL_MS) return;
+    lastLoopMs = nowMs;
+
+    float celsius;
+    if (readTemperature(&celsius)) {
+        // Smoothed over a few readings; the probe follows far more slowly
+        status.temperatureC = status.temperatureValid ? status.temperatureC + 0.25f * (celsius - status.temperatureC)
+                                                      : celsius;
+        status.temperatureValid = true;
+    }
+    if (usesTemperature() && status.temperatureValid) {
+        float relativeGain = 1.0f + SIPM_GAIN_TEMPCO_PCT / 100.0f * (status.temperatureC - SIPM_GAIN_REF_C);
+        if (relativeGain > 0.5f) status.temperatureFactor = 1.0f / relativeGain;
+    }
+
+    uint32_t lower = lowerCount.load(std::memory_order_relaxed);
+    uint32_t upper = upperCount.load(std::memory_order_relaxed);
+    status.windowCounts = lower + upper;
+    if (usesPeak() && windowHi && status.windowCounts >= SIPM_STABILIZE_MIN_COUNTS) {
+        lowerCount.fetch_sub(lower, std::memory_order_relaxed);
+        upperCount.fetch_sub(upper, std::memory_order_relaxed);
+        // Positive when the peak sits above its channel: lower the gain
+        status.peakError = ((float)upper - (float)lower) / status.windowCounts;
+        float factor = status.peakFactor * (1.0f - SIPM_STABILIZE_STEP * status.peakError);
+        status.peakFactor = factor < 0.8f ? 0.8f : (factor > 1.25f ? 1.25f : factor);
+        status.steps++;
+        status.windowCounts = 0;
+    }
+
+    status.gain = status.temperatureFactor * status.peakFactor;
+    if (fabsf(status.gain - builtGain) > SIPM_GAIN_REBUILD_STEP) buildTable(status.gain);
+}
+
+void setSipmGainMode(SipmGainMode mode) {
+    if (!table) return;
+    status.mode = mode;
+    if (!usesTemperature()) status.temperatureFactor = 1.0f;
+    if (!usesPeak()) status.peakFactor = 1.0f;
+    if (mode == SIPM_GAIN_OFF) {
+        gainSpectrum->setChannelMap(nullptr);
+        status.gain = 1.0f;
+        builtGain = 0.0f;
+        return;
+    }
+    lastLoopMs = millis() - SIPM_GAIN_INTERVAL_MS; // Next loop pass updates
+}
+
+void setSipmGainPeak(float channel) {
+    if (channel <= 0.0f) {
+        EnergyCalibration cal = getEnergyCalibration();
+        channel = cal.valid() ? cal.channel(SIPM_STABILIZE_KEV) : -1.0f;
+    }
+    setWindow(channel);
+}
+
+SipmGainStatus getSipmGainStatus() {
+    return status;
+}
+
+void printSipmGain(Print& out) {
+    static const char* modeNames[] = {"OFF", "TEMPERATURE", "PEAK", "TEMPERATURE + PEAK"};
+    SipmGainStatus s = getSipmGainStatus();
+    if (!table) {
+        out.println("SiPM gain: not available (no spectrum)");
+        return;
+    }
+    out.printf("SiPM gain: %s, correction %.4f (temperature %.4f, peak %.4f), %lu table builds\n",
+               modeNames[s.mode], s.gain, s.temperatureFactor, s.peakFactor, (unsigned long)s.tableBuilds);
+    if (s.temperatureValid) {
+        out.printf("  Temperature %.1f C (reference %.1f C, %.2f %%/C)\n", s.temperatureC, (float)SIPM_GAIN_REF_C,
+                   (float)SIPM_GAIN_TEMPCO_PCT);
+    } else {
+        out.println("  Temperature: no reading");
+    }
+    if (s.windowHalf) {
+        out.printf("  Peak at ch %.1f +- %u: %lu counts pending, last error %+.3f, %lu steps\n", s.peakChannel,
+                   (unsigned)s.windowHalf, (unsigned long)s.windowCounts, s.peakError, (unsigned long)s.steps);
+    } else {
+        out.println("  Peak: no channel (calibrate, or \"gain peak <channel>\")");
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef SIPM_GAIN_H
+#define SIPM_GAIN_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "spectrum.h"
+
+// SiPM gain compensation of the spectrum's channel assignment.
+// The SiPM gain, and with it every peak position, moves by a few percent
+// per degree. Every SIPM_GAIN_INTERVAL_MS a slow loop works out a gain
+// correction and rebuilds a height -> channel table (Spectrum::setChannelMap),
+// so binning stays one lookup and pulses binned later land where they would
+// have at the reference temperature. Two sources, alone or combined:
+//  - temperature: feed-forward from the measured temperature with the
+//    SiPM's coefficient SIPM_GAIN_TEMPCO_PCT, relative to SIPM_GAIN_REF_C;
+//  - peak: a known line (SIPM_STABILIZE_KEV) is held at its channel by
+//    comparing the counts in the halves of a window around it, which only
+//    balance when the peak is centred (closed loop, needs a source or the
+//    natural K-40 line and a few hundred counts per step).
+// The board has no SiPM bias DAC, so the correction is applied to the
+// channel assignment rather than to the bias.
+
+enum SipmGainMode {
+    SIPM_GAIN_OFF = 0,
+    SIPM_GAIN_TEMPERATURE,
+    SIPM_GAIN_PEAK,
+    SIPM_GAIN_BOTH,        ///< Temperature feed-forward, peak trims what is left
+};
+
+struct SipmGainStatus {
+    uint8_t mode;            ///< SipmGainMode
+    bool temperatureValid;
+    float temperatureC;      ///< Smoothed
+    float temperatureFactor; ///< Correction from the temperature
+    float peakFactor;        ///< Correction from the peak window
+    float gain;              ///< Applied: temperatureFactor * peakFactor
+    float peakChannel;       ///< Window centre
+    uint16_t windowHalf;     ///< Channels on each side
+    float peakError;         ///< Last (upper - lower) / (upper + lower)
+    uint32_t windowCounts;   ///< Counts in the window since the last step
+    uint32_t steps;          ///< Peak corrections applied
+    uint32_t tableBuilds;
+};
+
+// Allocates the table and applies SIPM_GAIN_MODE to @p spectrum. Call in
+// setup() after the energy calibration is loaded (initSpectrumAnalysis).
+bool initSipmGain(Spectrum& spectrum);
+
+// Counts a binned pulse for the peak window. pulseTask, per binned pulse.
+void sipmGainObserve(uint16_t channel);
+
+// Reads the temperature and updates the correction every
+// SIPM_GAIN_INTERVAL_MS. UI task.
+void sipmGainLoop(uint32_t nowMs);
+
+void setSipmGainMode(SipmGainMode mode);
+
+// Holds the peak at @p channel (0: the calibrated SIPM_STABILIZE_KEV).
+void setSipmGainPeak(float channel);
+
+SipmGainStatus getSipmGainStatus();
+
+void printSipmGain(Print& out);
+
+#endif // SIPM_GAIN_H
@@ -0,0 +1,292 @@
+#ifndef SOURCE_FIT_H
+#define SOURCE_FIT_H
+
+#include <math.h>
+#include <stdint.h>
+
+// Position of a point source from the rates of detectors at known positions.
+// Model for detector i at (xi, yi) on a plane, the source at (x, y) a height
+// h off that plane:
+//   rate_i = b + A / ((x - xi)^2 + (y - yi)^2 + h^2)
+// with four unknowns: x, y, the strength A (cps at 1 m) and a common
+// background b. Weighted least squares with weights t^2 / N (the counting
+// error of each rate), solved by Levenberg-Marquardt steps on the 4x4 normal
+// equations. The fit is incremental: new rates replace the old ones and the
+// steps go on from the last estimate, so a slowly changing picture converges
+// in a step or two per update. The caller bounds the steps per update.
+// The estimate is kept within the detectors' bounding box widened by its own
+// size (at least 2 h), since outside it the rates barely constrain the
+// distance. The tubes are assumed alike and isotropic.
+// No Arduino dependencies (host-compilable).
+
+struct SourceFitDetector {
+    float x;        ///< m
+    float y;        ///< m
+    float counts;   ///< May be an average (not an integer)
+    float seconds;
+
+    float rate() const { return seconds > 0.0f ? counts / seconds : 0.0f; }
+};
+
+struct SourceFitResult {
+    bool valid;         ///< An estimate exists
+    bool converged;     ///< The last step moved it by less than the tolerances
+    float x;            ///< m
+    float y;
+    float sigmaX;       ///< Standard errors, scaled up by the fit quality when it is poor
+    float sigmaY;
+    float strength;     ///< cps at 1 m
+    float sigmaStrength;
+    float background;   ///< cps per detector
+    float chi2;
+    uint8_t dof;
+    uint32_t iterations;///< Steps since the estimate (re)started
+};
+
+template <uint8_t N>
+class SourceFitN {
+public:
+    static const uint8_t PARAMS = 4;
+    static constexpr float STEP_TOLERANCE_M = 0.005f;
+
+    explicit SourceFitN(float heightM) : h2_((double)heightM * heightM) { clear(); }
+
+    /// Forgets the estimate; the next step starts from the rates.
+    void clear() {
+        n_ = 0;
+        lambda_ = 1e-3;
+        result_ = SourceFitResult();
+    }
+
+    /// Replaces the detectors (at most N, zero-exposure ones are skipped).
+    void setDetectors(const SourceFitDetector* detectors, uint8_t n) {
+        n_ = 0;
+        for (uint8_t i = 0; i < n && n_ < N; i++) {
+            if (detectors[i].seconds > 0.0f) d_[n_++] = detectors[i];
+        }
+        bounds();
+    }
+
+    uint8_t detectors() const { return n_; }
+
+    /**
+     * @brief Runs at most @p maxSteps steps from the current estimate.
+     * @return true once converged
+     */
+    bool step(uint8_t maxSteps) {
+        if (n_ < PARAMS) {
+            result_.valid = false;
+            return false;
+        }
+        if (!result_.valid) start();
+        double chi2 = chiSquare(p_);
+        for (uint8_t s = 0; s < maxSteps; s++) {
+            double jtj[PARAMS][PARAMS], jtr[PARAMS];
+            normalEquations(p_, jtj, jtr);
+            double next[PARAMS];
+            bool improved = false;
+            // Raise the damping until a step lowers chi-square (a few tries at most)
+            for (uint8_t attempt = 0; attempt < 8 && !improved; attempt++) {
+                double a[PARAMS][PARAMS], delta[PARAMS];
+                for (uint8_t r = 0; r < PARAMS; r++) {
+                    for (uint8_t c = 0; c < PARAMS; c++) a[r][c] = jtj[r][c];
+                    a[r][r] += lambda_ * (jtj[r][r] > 0.0 ? jtj[r][r] : 1.0);
+                }
+                if (!solve(a, jtr, delta)) {
+                    lambda_ *= 10.0;
+                    continue;
+                }
+                for (uint8_t k = 0; k < PARAMS; k++) next[k] = p_[k] + delta[k];
+                constrain(next);
+                double nextChi2 = chiSquare(next);
+                if (nextChi2 <= chi2) {
+                    improved = true;
+                    chi2 = nextChi2;
+                } else {
+                    lambda_ *= 10.0;
+                }
+            }
+            result_.iterations++;
+            if (!improved) {
+                result_.converged = true; // No step lowers it: at the minimum
+                break;
+            }
+            double moved = hypot(next[0] - p_[0], next[1] - p_[1]);
+            for (uint8_t k = 0; k < PARAMS; k++) p_[k] = next[k];
+            if (lambda_ > 1e-9) lambda_ *= 0.1;
+            result_.converged = moved < STEP_TOLERANCE_M;
+            if (result_.converged) break;
+        }
+        finish(chi2);
+        return result_.converged;
+    }
+
+    const SourceFitResult& result() const { return result_; }
+
+    /// Model rate at a detector position for the current estimate.
+    float predicted(float x, float y) const {
+        double dx = p_[0] - x, dy = p_[1] - y;
+        return (float)(p_[3] + p_[2] / (dx * dx + dy * dy + h2_));
+    }
+
+private:
+    /// Weighted centroid of the detectors above the lowest rate; background from the lowest.
+    void start() {
+        double lowest = d_[0].rate(), highest = lowest;
+        uint8_t top = 0;
+        for (uint8_t i = 1; i < n_; i++) {
+            double r = d_[i].rate();
+            if (r < lowest) lowest = r;
+            if (r > highest) {
+                highest = r;
+                top = i;
+            }
+        }
+        double sw = 0.0, sx = 0.0, sy = 0.0;
+        for (uint8_t i = 0; i < n_; i++) {
+            double w = d_[i].rate() - lowest;
+            w *= w;
+            sw += w;
+            sx += w * d_[i].x;
+            sy += w * d_[i].y;
+        }
+        if (sw > 0.0) {
+            p_[0] = sx / sw;
+            p_[1] = sy / sw;
+        } else {
+            p_[0] = (minX_ + maxX_) * 0.5;
+            p_[1] = (minY_ + maxY_) * 0.5;
+        }
+        double dx = p_[0] - d_[top].x, dy = p_[1] - d_[top].y;
+        p_[3] = lowest;
+        p_[2] = (highest - lowest) * (dx * dx + dy * dy + h2_);
+        constrain(p_);
+        lambda_ = 1e-3;
+        result_.valid = true;
+        result_.converged = false;
+        result_.iterations = 0;
+    }
+
+    void bounds() {
+        if (!n_) return;
+        double x0 = d_[0].x, x1 = x0, y0 = d_[0].y, y1 = y0;
+        for (uint8_t i = 1; i < n_; i++) {
+            if (d_[i].x < x0) x0 = d_[i].x;
+            if (d_[i].x > x1) x1 = d_[i].x;
+            if (d_[i].y < y0) y0 = d_[i].y;
+            if (d_[i].y > y1) y1 = d_[i].y;
+        }
+        double size = x1 - x0 > y1 - y0 ? x1 - x0 : y1 - y0;
+        double margin = size > 2.0 * sqrt(h2_) ? size : 2.0 * sqrt(h2_);
+        minX_ = x0 - margin;
+        maxX_ = x1 + margin;
+        minY_ = y0 - margin;
+        maxY_ = y1 + margin;
+    }
+
+    void constrain(double* p) const {
+        if (p[0] < minX_) p[0] = minX_;
+        if (p[0] > maxX_) p[0] = maxX_;
+        if (p[1] < minY_) p[1] = minY_;
+        if (p[1] > maxY_) p[1] = maxY_;
+        if (p[2] < 0.0) p[2] = 0.0;
+        if (p[3] < 0.0) p[3] = 0.0;
+    }
+
+    /// Weight of a rate: 1 / its variance, t^2 / N, with N at least 1.
+    double weight(const SourceFitDetector& d) const {
+        double counts = d.counts > 1.0f ? d.counts : 1.0;
+        return (double)d.seconds * d.seconds / counts;
+    }
+
+    double chiSquare(const double* p) const {
+        double sum = 0.0;
+        for (uint8_t i = 0; i < n_; i++) {
+            double dx = p[0] - d_[i].x, dy = p[1] - d_[i].y;
+            double r = d_[i].rate() - (p[3] + p[2] / (dx * dx + dy * dy + h2_));
+            sum += weight(d_[i]) * r * r;
+        }
+        return sum;
+    }
+
+    void normalEquations(const double* p, double jtj[PARAMS][PARAMS], double* jtr) const {
+        for (uint8_t r = 0; r < PARAMS; r++) {
+            jtr[r] = 0.0;
+            for (uint8_t c = 0; c < PARAMS; c++) jtj[r][c] = 0.0;
+        }
+        for (uint8_t i = 0; i < n_; i++) {
+            double dx = p[0] - d_[i].x, dy = p[1] - d_[i].y;
+            double q = dx * dx + dy * dy + h2_;
+            double j[PARAMS] = {-2.0 * p[2] * dx / (q * q), -2.0 * p[2] * dy / (q * q), 1.0 / q, 1.0};
+            double w = weight(d_[i]);
+            double r = d_[i].rate() - (p[3] + p[2] / q);
+            for (uint8_t a = 0; a < PARAMS; a++) {
+                jtr[a] += w * j[a] * r;
+                for (uint8_t b = 0; b < PARAMS; b++) jtj[a][b] += w * j[a] * j[b];
+            }
+        }
+    }
+
+    /// Cholesky solve of the symmetric system; false if not positive definite.
+    static bool solve(double a[PARAMS][PARAMS], const double* b, double* x) {
+        double l[PARAMS][PARAMS] = {};
+        for (uint8_t r = 0; r < PARAMS; r++) {
+            for (uint8_t c = 0; c <= r; c++) {
+                double sum = a[r][c];
+                for (uint8_t k = 0; k < c; k++) sum -= l[r][k] * l[c][k];
+                if (r == c) {
+                    if (!(sum > 0.0)) return false;
+                    l[r][r] = sqrt(sum);
+                } else {
+                    l[r][c] = sum / l[c][c];
+                }
+            }
+        }
+        double y[PARAMS];
+        for (uint8_t r = 0; r < PARAMS; r++) {
+            double sum = b[r];
+            for (uint8_t k = 0; k < r; k++) sum -= l[r][k] * y[k];
+            y[r] = sum / l[r][r];
+        }
+        for (uint8_t r = PARAMS; r-- > 0;) {
+            double sum = y[r];
+            for (uint8_t k = r + 1; k < PARAMS; k++) sum -= l[k][r] * x[k];
+            x[r] = sum / l[r][r];
+        }
+        return true;
+    }
+
+    /// Copies the estimate and its standard errors (diagonal of the inverse normal matrix).
+    void finish(double chi2) {
+        result_.x = (float)p_[0];
+        result_.y = (float)p_[1];
+        result_.strength = (float)p_[2];
+        result_.background = (float)p_[3];
+        result_.chi2 = (float)chi2;
+        result_.dof = n_ - PARAMS;
+        double jtj[PARAMS][PARAMS], jtr[PARAMS];
+        normalEquations(p_, jtj, jtr);
+        double scale = result_.dof && chi2 > result_.dof ? chi2 / result_.dof : 1.0;
+        double variance[PARAMS];
+        for (uint8_t k = 0; k < PARAMS; k++) {
+            double a[PARAMS][PARAMS], e[PARAMS] = {}, column[PARAMS];
+            for (uint8_t r = 0; r < PARAMS; r++)
+                for (uint8_t c = 0; c < PARAMS; c++) a[r][c] = jtj[r][c];
+            e[k] = 1.0;
+            variance[k] = solve(a, e, column) ? column[k] * scale : INFINITY;
+        }
+        result_.sigmaX = (float)sqrt(variance[0]);
+        result_.sigmaY = (float)sqrt(variance[1]);
+        result_.sigmaStrength = (float)sqrt(variance[2]);
+    }
+
+    double h2_;
+    SourceFitDetector d_[N];
+    uint8_t n_;
+    double p_[PARAMS];   ///< x, y, A, b
+    double lambda_;
+    double minX_, maxX_, minY_, maxY_;
+    SourceFitResult result_;
+};
+
+#endif // SOURCE_FIT_H
@@ -0,0 +1,338 @@
+/**
+ * @file source_locator.cpp
+ * @brief Per-detector running counts on the hub and the incremental source fit.
+ *
+ * The node table is polled once a second. A node's newest frame is added once,
+ * recognised by its boot id and sequence; alarm frames carry a partial
+ * interval and are added the same way. Frames that arrive between two polls
+ * are missed whole, counts and seconds together, so the averages stay fair.
+ */
+
+#include "source_locator.h"
+#include "json_arena.h"
+#include "web_arena.h"
+#include "web_service.h"
+#include "seqlock.h"
+#include "debug.h"
+#include <WiFi.h>
+#include <Preferences.h>
+#include <math.h>
+
+static const char* LOCATE_NAMESPACE = "locate";
+static const char* POSITIONS_KEY = "positions";
+static const uint32_t POLL_MS = 1000;
+
+// Saved record of one position
+struct SavedPosition {
+    uint8_t mac[6];
+    uint8_t used;
+    uint8_t reserved;
+    float x;
+    float y;
+};
+
+struct Slot {
+    bool used;
+    bool live;
+    uint8_t mac[6];
+    float x;
+    float y;
+    uint16_t bootId;      ///< Of the last frame added
+    uint32_t sequence;
+    double counts;        ///< Decaying sums
+    double seconds;
+};
+
+// UI task only
+static EspNowSource selfSource = nullptr;
+static uint8_t selfMac[6];
+static Slot slots[SOURCE_LOCATOR_SLOTS];
+static SourceFitN<SOURCE_LOCATOR_SLOTS> fit(SOURCE_LOCATOR_HEIGHT_M);
+static uint32_t lastPollMs = 0;
+static bool selfPrimed = false;
+static uint32_t selfLastMs = 0;
+static uint32_t selfLastTotal = 0;
+static SourceEstimate estimate;
+
+static SeqLock<SourceEstimate> estimateLock;
+
+static void saveAll() {
+    SavedPosition saved[SOURCE_LOCATOR_SLOTS];
+    memset(saved, 0, sizeof(saved));
+    for (uint8_t i = 0; i < SOURCE_LOCATOR_SLOTS; i++) {
+        if (!slots[i].used) continue;
+        memcpy(saved[i].mac, slots[i].mac, 6);
+        saved[i].used = 1;
+        saved[i].x = slots[i].x;
+        saved[i].y = slots[i].y;
+    }
+    Preferences prefs;
+    if (prefs.begin(LOCATE_NAMESPACE, false)) {
+        prefs.putBytes(POSITIONS_KEY, saved, sizeof(saved));
+        prefs.end();
+    }
+}
+
+static Slot* findSlot(const uint8_t* mac) {
+    for (uint8_t i = 0; i < SOURCE_LOCATOR_SLOTS; i++) {
+        if (slots[i].used && memcmp(slots[i].mac, mac, 6) == 0) return &slots[i];
+    }
+    return nullptr;
+}
+
+void initSourceLocator(EspNowSource self) {
+    selfSource = self;
+    WiFi.macAddress(selfMac);
+    memset(slots, 0, sizeof(slots));
+    SavedPosition saved[SOURCE_LOCATOR_SLOTS];
+    Preferences prefs;
+    if (!prefs.begin(LOCATE_NAMESPACE, true)) return;
+    bool found = prefs.getBytesLength(POSITIONS_KEY) == sizeof(saved) &&
+                 prefs.getBytes(POSITIONS_KEY, saved, sizeof(saved)) == sizeof(saved);
+    prefs.end();
+    if (!found) return;
+    for (uint8_t i = 0; i < SOURCE_LOCATOR_SLOTS; i++) {
+        if (!saved[i].used || !isfinite(saved[i].x) || !isfinite(saved[i].y)) continue;
+        slots[i].used = true;
+        memcpy(slots[i].mac, saved[i].mac, 6);
+        slots[i].x = saved[i].x;
+        slots[i].y = saved[i].y;
+    }
+}
+
+const uint8_t* sourceLocatorSelf() {
+    return selfMac;
+}
+
+void sourceLocatorReset() {
+    for (Slot& s : slots) {
+        s.counts = s.seconds = 0.0;
+        s.bootId = 0;
+        s.sequence = 0;
+    }
+    selfPrimed = false;
+    fit.clear();
+    estimate.fit = fit.result();
+    estimate.used = 0;
+    estimateLock.publish(estimate);
+}
+
+bool sourceLocatorSetPosition(const uint8_t* mac, bool placed, float x, float y) {
+    Slot* slot = findSlot(mac);
+    if (!placed) {
+        if (!slot) return false;
+        memset(slot, 0, sizeof(*slot));
+    } else {
+        if (!isfinite(x) || !isfinite(y)) return false;
+        if (!slot) {
+            for (Slot& s : slots) {
+                if (!s.used) {
+                    slot = &s;
+                    break;
+                }
+            }
+            if (!slot) return false;
+            memset(slot, 0, sizeof(*slot));
+            slot->used = true;
+            memcpy(slot->mac, mac, 6);
+        }
+        slot->x = x;
+        slot->y = y;
+    }
+    saveAll();
+    fit.clear(); // The old estimate belongs to the old geometry
+    return true;
+}
+
+static void accumulate(Slot& slot, uint32_t counts, float seconds) {
+    double keep = exp(-seconds / (double)SOURCE_LOCATOR_TAU_S);
+    slot.counts = slot.counts * keep + counts;
+    slot.seconds = slot.seconds * keep + seconds;
+}
+
+/**
+ * @brief Adds the hub's own counts once per ESPNOW_INTERVAL_S, like a node's frame.
+ * @return true if counts were added
+ */
+static bool collectSelf(uint32_t nowMs) {
+    if (!selfSource) return false;
+    Slot* slot = findSlot(selfMac);
+    EspNowReadings readings;
+    selfSource(readings);
+    if (!selfPrimed) {
+        selfPrimed = true;
+        selfLastMs = nowMs;
+        selfLastTotal = readings.totalCounts;
+        return false;
+    }
+    if (nowMs - selfLastMs < ESPNOW_INTERVAL_S * 1000UL) return false;
+    float seconds = (nowMs - selfLastMs) / 1000.0f;
+    uint32_t counts = readings.totalCounts - selfLastTotal;
+    selfLastMs = nowMs;
+    selfLastTotal = readings.totalCounts;
+    if (!slot) return false;
+    slot->live = true;
+    accumulate(*slot, counts, seconds);
+    return true;
+}
+
+static bool collectNodes() {
+    static EspNowNode nodes[ESPNOW_MAX_NODES]; // UI task only; kept off its stack
+    size_t n = getEspNowNodes(nodes, ESPNOW_MAX_NODES);
+    for (Slot& s : slots) {
+        if (memcmp(s.mac, selfMac, 6) != 0) s.live = false;
+    }
+    bool added = false;
+    for (size_t i = 0; i < n; i++) {
+        const EspNowNode& node = nodes[i];
+        Slot* slot = findSlot(node.origin);
+        if (!slot) continue;
+        slot->live = true;
+        if (node.last.bootId == slot->bootId && node.last.sequence == slot->sequence) continue;
+        slot->bootId = node.last.bootId;
+        slot->sequence = node.last.sequence;
+        if (node.last.seconds == 0) continue;
+        accumulate(*slot, node.last.counts, node.last.seconds);
+        added = true;
+    }
+    return added;
+}
+
+/**
+ * @brief Refits from the current sums within the step and time budget, then publishes.
+ */
+static void refit(uint32_t nowMs) {
+    SourceFitDetector detectors[SOURCE_LOCATOR_SLOTS];
+    uint8_t used = 0, placed = 0;
+    for (const Slot& s : slots) {
+        if (!s.used) continue;
+        placed++;
+        if (!s.live || !(s.seconds > 0.0)) continue;
+        detectors[used++] = {s.x, s.y, (float)s.counts, (float)s.seconds};
+    }
+    uint32_t start = micros();
+    if (used >= SOURCE_LOCATOR_MIN_DETECTORS) {
+        fit.setDetectors(detectors, used);
+        uint8_t steps = 0;
+        while (steps < SOURCE_LOCATOR_ITERATIONS && micros() - start < SOURCE_LOCATOR_BUDGET_US) {
+            steps++;
+            if (fit.step(1)) break;
+        }
+    } else {
+        fit.clear();
+    }
+    uint32_t elapsed = micros() - start;
+
+    estimate.fit = fit.result();
+    estimate.placed = placed;
+    estimate.used = used;
+    uint8_t k = 0;
+    for (const Slot& s : slots) {
+        if (!s.used) continue;
+        SourceDetector& d = estimate.detectors[k++];
+        memcpy(d.mac, s.mac, 6);
+        d.self = memcmp(s.mac, selfMac, 6) == 0;
+        d.live = s.live;
+        d.x = s.x;
+        d.y = s.y;
+        d.seconds = (float)s.seconds;
+        d.cps = s.seconds > 0.0 ? (float)(s.counts / s.seconds) : 0.0f;
+        d.predictedCps = estimate.fit.valid ? fit.predicted(s.x, s.y) : 0.0f;
+    }
+    estimate.updates++;
+    estimate.updatedMs = nowMs;
+    estimate.lastFitUs = elapsed;
+    if (elapsed > estimate.maxFitUs) estimate.maxFitUs = elapsed;
+    estimateLock.publish(estimate);
+}
+
+void sourceLocatorUpdate(uint32_t nowMs) {
+    if (nowMs - lastPollMs < POLL_MS) return;
+    lastPollMs = nowMs;
+    if (getEspNowStats().role != ESPNOW_ROLE_HUB) {
+        selfPrimed = false;
+        return;
+    }
+    bool fresh = collectSelf(nowMs);
+    fresh |= collectNodes();
+    if (fresh) refit(nowMs);
+}
+
+SourceEstimate getSourceEstimate() {
+    SourceEstimate out = {};
+    estimateLock.read(out);
+    return out;
+}
+
+static void formatMac(char* out, size_t size, const uint8_t* mac) {
+    snprintf(out, size, "%02X:%02X:%02X:%02X:%02X:%02X", mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+}
+
+void sourceLocatorAttach(WebServer& server) {
+    server.on("/api/source", HTTP_GET, [&server]() {
+        static SourceEstimate e; // Web task only; kept off its stack
+        e = getSourceEstimate();
+        JsonArenaLease lease;
+        JsonDocument doc(lease.allocator());
+        doc["valid"] = e.fit.valid;
+        if (e.fit.valid) {
+            doc["x_m"] = e.fit.x;
+            doc["y_m"] = e.fit.y;
+            doc["sigma_x_m"] = e.fit.sigmaX;
+            doc["sigma_y_m"] = e.fit.sigmaY;
+            doc["strength_cps_1m"] = e.fit.strength;
+            doc["sigma_strength_cps_1m"] = e.fit.sigmaStrength;
+            doc["background_cps"] = e.fit.background;
+            doc["chi2"] = e.fit.chi2;
+            doc["dof"] = e.fit.dof;
+            doc["converged"] = e.fit.converged;
+            doc["iterations"] = e.fit.iterations;
+        }
+        doc["min_detectors"] = SOURCE_LOCATOR_MIN_DETECTORS;
+        doc["age_s"] = e.updates ? (millis() - e.updatedMs) / 1000 : 0;
+        doc["fit_us"] = e.lastFitUs;
+        JsonArray list = doc["detectors"].to<JsonArray>();
+        for (uint8_t i = 0; i < e.placed; i++) {
+            const SourceDetector& d = e.detectors[i];
+            char mac[18];
+            formatMac(mac, sizeof(mac), d.mac);
+            JsonObject obj = list.add<JsonObject>();
+            obj["id"] = mac;
+            if (d.self) obj["self"] = true;
+            obj["live"] = d.live;
+            obj["x_m"] = d.x;
+            obj["y_m"] = d.y;
+            obj["cps"] = d.cps;
+            obj["seconds"] = d.seconds;
+            if (e.fit.valid) obj["predicted_cps"] = d.predictedCps;
+        }
+        server.sendHeader("Cache-Control", "no-store");
+        server.sendHeader("Access-Control-Allow-Origin", "*");
+        webSendJson(server, 200, doc);
+    });
+}
+
+void printSourceLocator(Print& out) {
+    SourceEstimate e = getSourceEstimate();
+    const SourceFitResult& f = e.fit;
+    if (getEspNowStats().role != ESPNOW_ROLE_HUB) out.println("Source: runs on an ESP-NOW hub only");
+    if (f.valid) {
+        out.printf("Source: x %.2f +/- %.2f m, y %.2f +/- %.2f m, %.1f +/- %.1f cps at 1 m, background %.2f cps\n", f.x,
+                   f.sigmaX, f.y, f.sigmaY, f.strength, f.sigmaStrength, f.background);
+        out.printf("  chi2 %.1f for %u dof, %s after %lu steps\n", f.chi2, f.dof,
+                   f.converged ? "converged" : "still moving", (unsigned long)f.iterations);
+    } else {
+        out.printf("Source: no estimate, %u of %u detectors usable\n", e.used, SOURCE_LOCATOR_MIN_DETECTORS);
+    }
+    out.printf("  %lu fits, last %lu us, longest %lu us\n", (unsigned long)e.updates, (unsigned long)e.lastFitUs,
+               (unsigned long)e.maxFitUs);
+    for (uint8_t i = 0; i < e.placed; i++) {
+        const SourceDetector& d = e.detectors[i];
+        char mac[18];
+        formatMac(mac, sizeof(mac), d.mac);
+        out.printf("  %s%s at %.2f, %.2f m: %.2f cps over %.0f s", mac, d.self ? " (self)" : "", d.x, d.y, d.cps,
+                   d.seconds);
+        if (f.valid) out.printf(", fit %.2f", d.predictedCps);
+        out.println(d.live ? "" : ", not heard");
+    }
+}
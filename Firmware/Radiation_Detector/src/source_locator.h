@@ -0,0 +1,72 @@
+#ifndef SOURCE_LOCATOR_H
+#define SOURCE_LOCATOR_H
+
+#include <Arduino.h>
+#include <WebServer.h>
+#include "config.h"
+#include "espnow_link.h"
+#include "source_fit.h"
+
+// Source localisation on an ESP-NOW hub (espnow_link.h): the position of a
+// point source from the rates of detectors at known positions, fitted to the
+// inverse square law (source_fit.h). Positions are metres on a local plane
+// (east, north from any origin), set per detector MAC with "locate pos" and
+// kept in Preferences ("locate" namespace); the hub itself is "self".
+// Each interval frame a placed node sends adds its counts and seconds to that
+// node's running sums, which decay with SOURCE_LOCATOR_TAU_S; the hub adds its
+// own counts at the same pace. After new data the fit takes a bounded number
+// of steps from the previous estimate (SOURCE_LOCATOR_ITERATIONS, at most
+// SOURCE_LOCATOR_BUDGET_US), so its cost on the hub is a few milliseconds per
+// interval and the pulse pipeline, on its own task, is not affected.
+// Served at /api/source, drawn by the source map (source_map_view.h) and
+// printed by "locate". UI task, except where noted.
+
+static const uint8_t SOURCE_LOCATOR_SLOTS = ESPNOW_MAX_NODES + 1; // Nodes and the hub
+
+struct SourceDetector {
+    uint8_t mac[6];
+    bool self;
+    bool live;            ///< Heard within ESPNOW_NODE_TIMEOUT_S (always for self)
+    float x;              ///< m
+    float y;
+    float cps;            ///< Averaged rate
+    float predictedCps;   ///< By the estimate
+    float seconds;        ///< Effective exposure of the average
+};
+
+struct SourceEstimate {
+    SourceFitResult fit;  ///< fit.valid false below SOURCE_LOCATOR_MIN_DETECTORS
+    uint8_t placed;       ///< Detectors with a position
+    uint8_t used;         ///< Placed, live and with counts
+    SourceDetector detectors[SOURCE_LOCATOR_SLOTS];
+    uint32_t updates;     ///< Fits run
+    uint32_t updatedMs;
+    uint32_t lastFitUs;
+    uint32_t maxFitUs;
+};
+
+// Loads the positions. @p self reads the hub's own total counts.
+void initSourceLocator(EspNowSource self);
+
+// Takes new interval counts and refits. Call every uiTask pass; does nothing
+// unless the unit is a hub.
+void sourceLocatorUpdate(uint32_t nowMs);
+
+// Sets or removes (@p placed false) the position of a detector; saved.
+bool sourceLocatorSetPosition(const uint8_t* mac, bool placed, float x, float y);
+
+// Forgets the averages and the estimate.
+void sourceLocatorReset();
+
+// Latest estimate; any task.
+SourceEstimate getSourceEstimate();
+
+// Registers GET /api/source.
+void sourceLocatorAttach(WebServer& server);
+
+// MAC of the hub itself, for "locate pos self".
+const uint8_t* sourceLocatorSelf();
+
+void printSourceLocator(Print& out);
+
+#endif // SOURCE_LOCATOR_H
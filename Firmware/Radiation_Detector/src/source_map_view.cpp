@@ -0,0 +1,215 @@
+/**
+ * @file source_map_view.cpp
+ * @brief Source estimate and detector positions drawn into a PSRAM canvas.
+ *
+ * The frame is the bounding box of the placed detectors and the estimate with
+ * a margin of FRAME_MARGIN on every side, spanning at least MIN_SPAN_M. The
+ * map is tiny (a handful of markers), so every new estimate simply redraws
+ * it; the label is set only when its text changed.
+ */
+
+#include "config.h"
+
+#if !HEADLESS
+
+#include "source_map_view.h"
+#include "source_locator.h"
+#include "esp_heap_caps.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+static const float FRAME_MARGIN = 0.15f;
+static const float MIN_SPAN_M = 2.0f;
+static const uint8_t MARKER = 7;                ///< Detector square, pixels
+static const uint8_t CROSS = 6;                 ///< Half length of the source cross
+static const uint32_t POLL_MS = 500;
+
+static lv_obj_t* canvas = nullptr;
+static lv_obj_t* label = nullptr;
+static lv_color_t* canvasBuf = nullptr;         ///< PSRAM
+static uint16_t canvasW = 0;
+static uint16_t canvasH = 0;
+static bool shown = false;
+static bool fullRender = true;
+static uint32_t drawnUpdates = 0;
+static uint32_t lastPollMs = 0;
+static char text[80] = "";
+
+// Frame: centre and scale
+static float centreX = 0.0f;
+static float centreY = 0.0f;
+static float pixelsPerMetre = 1.0f;
+
+static void frame(const SourceEstimate& e) {
+    float x0 = INFINITY, x1 = -INFINITY, y0 = INFINITY, y1 = -INFINITY;
+    auto include = [&](float x, float y) {
+        if (x < x0) x0 = x;
+        if (x > x1) x1 = x;
+        if (y < y0) y0 = y;
+        if (y > y1) y1 = y;
+    };
+    for (uint8_t i = 0; i < e.placed; i++) include(e.detectors[i].x, e.detectors[i].y);
+    if (e.fit.valid) include(e.fit.x, e.fit.y);
+    if (x0 > x1) x0 = x1 = y0 = y1 = 0.0f;
+    centreX = (x0 + x1) * 0.5f;
+    centreY = (y0 + y1) * 0.5f;
+    float spanX = (x1 - x0) * (1.0f + 2.0f * FRAME_MARGIN);
+    float spanY = (y1 - y0) * (1.0f + 2.0f * FRAME_MARGIN);
+    if (spanX < MIN_SPAN_M) spanX = MIN_SPAN_M;
+    if (spanY < MIN_SPAN_M) spanY = MIN_SPAN_M;
+    float byWidth = canvasW / spanX;
+    float byHeight = canvasH / spanY;
+    pixelsPerMetre = byWidth < byHeight ? byWidth : byHeight;
+}
+
+static void project(float x, float y, int16_t* px, int16_t* py) {
+    *px = (int16_t)lroundf(canvasW * 0.5f + (x - centreX) * pixelsPerMetre);
+    *py = (int16_t)lroundf(canvasH * 0.5f - (y - centreY) * pixelsPerMetre);
+}
+
+static void plot(int16_t x, int16_t y, lv_color_t colour) {
+    if (x < 0 || y < 0 || x >= canvasW || y >= canvasH) return;
+    canvasBuf[(size_t)y * canvasW + x] = colour;
+}
+
+static void square(int16_t x, int16_t y, lv_color_t colour) {
+    for (int16_t row = y - MARKER / 2; row <= y + MARKER / 2; row++) {
+        for (int16_t col = x - MARKER / 2; col <= x + MARKER / 2; col++) plot(col, row, colour);
+    }
+}
+
+static void circle(int16_t x, int16_t y, float radius, lv_color_t colour) {
+    uint16_t steps = (uint16_t)(radius * 6.3f) + 8;
+    if (steps > 720) steps = 720;
+    for (uint16_t k = 0; k < steps; k++) {
+        float a = k * 6.2831853f / steps;
+        plot(x + (int16_t)lroundf(radius * cosf(a)), y + (int16_t)lroundf(radius * sinf(a)), colour);
+    }
+}
+
+static void setText(const char* next) {
+    if (strcmp(text, next) == 0) return;
+    strlcpy(text, next, sizeof(text));
+    lv_label_set_text_static(label, text);
+}
+
+static void drawAll(const SourceEstimate& e) {
+    lv_color_t background = lv_color_black();
+    for (size_t i = 0; i < (size_t)canvasW * canvasH; i++) canvasBuf[i] = background;
+    frame(e);
+
+    float highest = 0.0f;
+    for (uint8_t i = 0; i < e.placed; i++) {
+        if (e.detectors[i].live && e.detectors[i].cps > highest) highest = e.detectors[i].cps;
+    }
+    for (uint8_t i = 0; i < e.placed; i++) {
+        const SourceDetector& d = e.detectors[i];
+        int16_t x, y;
+        project(d.x, d.y, &x, &y);
+        lv_color_t colour = lv_color_make(0x60, 0x60, 0x60);
+        if (d.live && highest > 0.0f) {
+            uint8_t mix = (uint8_t)(255.0f * d.cps / highest);
+            colour = lv_color_mix(lv_color_make(0xFF, 0x28, 0x00), lv_color_make(0x00, 0xC8, 0x3C), mix);
+        }
+        square(x, y, colour);
+        if (d.self) circle(x, y, MARKER, lv_color_white());
+    }
+
+    char line[80];
+    if (e.fit.valid) {
+        int16_t x, y;
+        project(e.fit.x, e.fit.y, &x, &y);
+        lv_color_t red = lv_color_make(0xFF, 0x00, 0xC8);
+        for (int16_t k = -CROSS; k <= CROSS; k++) {
+            plot(x + k, y, red);
+            plot(x, y + k, red);
+        }
+        float sigma = e.fit.sigmaX > e.fit.sigmaY ? e.fit.sigmaX : e.fit.sigmaY;
+        if (isfinite(sigma) && sigma * pixelsPerMetre >= 2.0f) circle(x, y, sigma * pixelsPerMetre, red);
+        snprintf(line, sizeof(line), "Source %.1f, %.1f m  +/-%.1f m%s", e.fit.x, e.fit.y, sigma,
+                 e.fit.converged ? "" : " ...");
+    } else if (e.placed == 0) {
+        snprintf(line, sizeof(line), "No detector positions (\"locate pos\")");
+    } else {
+        snprintf(line, sizeof(line), "No estimate: %u of %u detectors", e.used, SOURCE_LOCATOR_MIN_DETECTORS);
+    }
+    setText(line);
+    lv_obj_invalidate(canvas);
+}
+
+static void longPressedCb(lv_event_t* e) {
+    lv_indev_t* indev = lv_indev_get_act();
+    if (indev) lv_indev_wait_release(indev); // The release must not also click the chart
+    sourceMapViewSetShown(!shown);
+}
+
+void sourceMapViewAttach(lv_obj_t* chart) {
+    if (!chart) {
+        // The chart's screen is being deleted; the canvas goes with it
+        canvas = label = nullptr;
+        heap_caps_free(canvasBuf);
+        canvasBuf = nullptr;
+        canvasW = canvasH = 0;
+        return;
+    }
+    lv_obj_update_layout(chart);
+    lv_area_t content;
+    lv_obj_get_content_coords(chart, &content);
+    uint16_t w = lv_area_get_width(&content);
+    uint16_t h = lv_area_get_height(&content);
+    canvasBuf = (lv_color_t*)heap_caps_malloc((size_t)w * h * sizeof(lv_color_t), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!canvasBuf) return;
+    canvasW = w;
+    canvasH = h;
+
+    canvas = lv_canvas_create(chart);
+    lv_canvas_set_buffer(canvas, canvasBuf, canvasW, canvasH, LV_IMG_CF_TRUE_COLOR);
+    lv_obj_set_pos(canvas, 0, 0);
+    // Clickable, so a tap on the map does not open the history plot
+    lv_obj_add_event_cb(canvas, longPressedCb, LV_EVENT_LONG_PRESSED, NULL);
+
+    label = lv_label_create(chart);
+    lv_obj_set_style_text_color(label, lv_color_white(), LV_PART_MAIN);
+    lv_obj_align(label, LV_ALIGN_TOP_LEFT, 4, 2);
+    text[0] = '\0';
+    lv_label_set_text_static(label, text);
+    lv_obj_clear_flag(label, LV_OBJ_FLAG_CLICKABLE);
+
+    lv_obj_add_event_cb(chart, longPressedCb, LV_EVENT_LONG_PRESSED, NULL);
+    sourceMapViewSetShown(shown);
+}
+
+void sourceMapViewSetShown(bool enabled) {
+    shown = enabled;
+    fullRender = true;
+    if (!canvas) return;
+    if (shown) {
+        lv_obj_clear_flag(canvas, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_clear_flag(label, LV_OBJ_FLAG_HIDDEN);
+    } else {
+        lv_obj_add_flag(canvas, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_add_flag(label, LV_OBJ_FLAG_HIDDEN);
+    }
+}
+
+bool sourceMapViewShown() {
+    return shown;
+}
+
+void sourceMapViewUpdate(uint32_t nowMs) {
+    if (!canvas || !shown || lv_obj_get_screen(canvas) != lv_scr_act()) {
+        fullRender = true;
+        return;
+    }
+    if (!fullRender && nowMs - lastPollMs < POLL_MS) return;
+    lastPollMs = nowMs;
+    static SourceEstimate e; // UI task only; kept off its stack
+    e = getSourceEstimate();
+    if (!fullRender && e.updates == drawnUpdates) return;
+    drawnUpdates = e.updates;
+    fullRender = false;
+    drawAll(e);
+}
+
+#endif // !HEADLESS
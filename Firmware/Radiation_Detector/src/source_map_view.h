@@ -0,0 +1,25 @@
+#ifndef SOURCE_MAP_VIEW_H
+#define SOURCE_MAP_VIEW_H
+
+#include <Arduino.h>
+#include <lvgl.h>
+
+// Map of the source estimate (source_locator.h) on the 1 h chart screen: the
+// placed detectors as squares coloured by their rate (grey if not heard),
+// the estimated source as a cross with a circle of its standard error, and a
+// line of text. North up, equal metres on both axes, framed to fit the
+// detectors and the estimate. The canvas is redrawn whole when a new estimate
+// is published (once per ESP-NOW interval at most) and only while shown.
+// A long press on the chart switches between the chart and the map. UI task.
+
+// Creates the (hidden) canvas over @p chart's plot area. Call with NULL
+// before the chart's screen is deleted.
+void sourceMapViewAttach(lv_obj_t* chart);
+
+// Redraws after a new estimate while the map is on the active screen.
+void sourceMapViewUpdate(uint32_t nowMs);
+
+void sourceMapViewSetShown(bool shown);
+bool sourceMapViewShown();
+
+#endif // SOURCE_MAP_VIEW_H
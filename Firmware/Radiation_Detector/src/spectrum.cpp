@@ -0,0 +1,80 @@
+/**
+ * @file spectrum.cpp
+ * @brief Pulse-height histogram storage.
+ */
+
+#include "spectrum.h"
+#include <string.h>
+#include <stdlib.h>
+
+#ifdef ARDUINO
+#include "esp_heap_caps.h"
+#endif
+
+Spectrum::Spectrum()
+    : counts_(nullptr), channels_(0), shift_(0), codes_(0), channelMap_(nullptr), total_(0), liveMs_(0),
+      realMs_(0), accumulating_(true), clearPending_(false), writerAttached_(false) {}
+
+bool Spectrum::begin(uint16_t channels, uint8_t adcBits) {
+    if (counts_) return true;
+    if (channels == 0 || (channels & (channels - 1)) != 0) return false; // Power of two only
+
+    size_t bytes = channels * sizeof(uint32_t);
+#ifdef ARDUINO
+    void* mem = heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+#else
+    void* mem = malloc(bytes);
+#endif
+    if (!mem) return false;
+    memset(mem, 0, bytes);
+
+    // Map the ADC code range onto the channels with a shift
+    uint8_t channelBits = 0;
+    while ((1u << channelBits) < channels) channelBits++;
+    shift_ = adcBits > channelBits ? adcBits - channelBits : 0;
+    codes_ = 1u << adcBits;
+    channels_ = channels;
+    counts_ = (volatile uint32_t*)mem;
+    return true;
+}
+
+size_t Spectrum::read(uint16_t first, uint32_t* out, size_t count) const {
+    if (!counts_ || first >= channels_) return 0;
+    size_t available = (size_t)(channels_ - first);
+    size_t n = available < count ? available : count;
+    for (size_t i = 0; i < n; i++) {
+        out[i] = counts_[first + i];
+    }
+    return n;
+}
+
+bool Spectrum::restore(const uint32_t* counts, size_t count, uint32_t liveMs) {
+    if (!counts_ || writerAttached_ || count != channels_) return false;
+    uint32_t total = 0;
+    for (uint16_t i = 0; i < channels_; i++) {
+        counts_[i] = counts[i];
+        total += counts[i];
+    }
+    total_ = total;
+    liveMs_ = liveMs;
+    realMs_ = liveMs;
+    return true;
+}
+
+void Spectrum::clear() {
+    if (writerAttached_) {
+        clearPending_ = true;
+        return;
+    }
+    zero();
+}
+
+void Spectrum::zero() {
+    if (!counts_) return;
+    for (uint16_t i = 0; i < channels_; i++) {
+        counts_[i] = 0;
+    }
+    total_ = 0;
+    liveMs_ = 0;
+    realMs_ = 0;
+}
@@ -0,0 +1,109 @@
+#ifndef SPECTRUM_H
+#define SPECTRUM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Pulse-height histogram for the scintillation channel.
+// Channel counts are 32-bit and live in PSRAM on the target. pulseTask, which
+// bins the acquisition task's events, is the only writer; readers copy ranges
+// out while it runs. Each count is
+// a single aligned word, so a reader never sees a torn value, only a histogram
+// that is a few pulses behind. Clears requested by other tasks are applied by
+// the writer between batches, so no increment can resurrect a cleared count.
+
+class Spectrum {
+public:
+    Spectrum();
+
+    /// Allocates @p channels counters (PSRAM preferred). @p adcBits is the sample width.
+    bool begin(uint16_t channels, uint8_t adcBits);
+
+    bool ready() const { return counts_ != nullptr; }
+    uint16_t channels() const { return channels_; }
+
+    /// Bins one pulse height given in ADC codes above baseline (writer only).
+    /// @return The channel it went into
+    uint16_t add(uint16_t height) {
+        uint16_t channel = channelOf(height);
+        counts_[channel]++;
+        total_++;
+        return channel;
+    }
+
+    /// Channel a pulse of @p height would be binned into, without binning it.
+    uint16_t channelOf(uint16_t height) const {
+        const uint16_t* map = channelMap_;
+        uint32_t channel = map && height < codes_ ? map[height] : (uint32_t)height >> shift_;
+        if (channel >= channels_) channel = channels_ - 1; // Overflow channel
+        return (uint16_t)channel;
+    }
+
+    /// Writer: call before each batch of add(). Applies a pending clear().
+    void beginBatch() {
+        if (clearPending_) {
+            zero();
+            clearPending_ = false;
+        }
+    }
+
+    /// Marks the writer (pulseTask) as running; from then on clear() is deferred to it.
+    void attachWriter() { writerAttached_ = true; }
+
+    /// Writer: adds live (sampled) time while accumulating.
+    void addLiveMs(uint32_t ms) { liveMs_ += ms; }
+
+    /// Milliseconds of sampled signal behind the current counts, without the
+    /// time the detector was busy with a pulse (rates per live time are
+    /// dead-time corrected).
+    uint32_t liveMs() const { return liveMs_; }
+
+    /// Writer: adds real (acquisition) time while accumulating.
+    void addRealMs(uint32_t ms) { realMs_ += ms; }
+
+    /// Milliseconds of acquisition behind the current counts; a restored
+    /// spectrum starts with its live time.
+    uint32_t realMs() const { return realMs_; }
+
+    /// Pauses or resumes binning; the writer drops pulses and live time while paused.
+    void setAccumulating(bool enabled) { accumulating_ = enabled; }
+    bool accumulating() const { return accumulating_; }
+
+    /// Loads saved counts and live time (before the writer is attached).
+    bool restore(const uint32_t* counts, size_t count, uint32_t liveMs);
+
+    /// Copies @p count channel counts starting at @p first. Returns channels copied.
+    size_t read(uint16_t first, uint32_t* out, size_t count) const;
+
+    /// ADC codes a pulse height can take (2^adcBits).
+    uint32_t codes() const { return codes_; }
+
+    /// Channel of each height 0..codes()-1 instead of height >> (adcBits -
+    /// log2 channels), e.g. with a gain correction; nullptr restores the
+    /// plain mapping. Any task: entries are aligned 16-bit words, so a table
+    /// rewritten in place gives each pulse the old or the new channel.
+    void setChannelMap(const uint16_t* map) { channelMap_ = map; }
+
+    /// Total pulses binned since the last clear().
+    uint32_t total() const { return total_; }
+
+    /// Zeroes all channels and the live time (deferred to the writer once attached).
+    void clear();
+
+private:
+    void zero();
+
+    volatile uint32_t* counts_;
+    uint16_t channels_;
+    uint8_t shift_;          ///< ADC codes per channel = 2^shift_
+    uint32_t codes_;
+    const uint16_t* volatile channelMap_;
+    volatile uint32_t total_;
+    volatile uint32_t liveMs_;
+    volatile uint32_t realMs_;
+    volatile bool accumulating_;
+    volatile bool clearPending_;
+    bool writerAttached_;
+};
+
+#endif // SPECTRUM_H
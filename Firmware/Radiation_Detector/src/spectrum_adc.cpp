@@ -0,0 +1,446 @@
+/**
+ * @file spectrum_adc.cpp
+ * @brief Spectrum acquisition: sample blocks to pulse heights to events.
+ *
+ * The acquisition task blocks on the SpectrumSource (spectrum_source.h) for
+ * the next block of samples, from ADC1 in continuous mode or from an external
+ * ADC through LCD_CAM, and runs the PulseHeightDetector over it. With ADC1 at
+ * ~80 kS/s this needs a shaping amplifier (or peak-hold) ahead of the ADC that
+ * stretches each scintillation pulse to tens of microseconds, so a pulse spans
+ * several samples. Every time constant (shaping, pile-up, live time) is
+ * converted at the source's sample rate, so the same pipeline runs at MS/s.
+ *
+ * With shaping on, the frame first goes through the TrapezoidShaper and the
+ * detector measures the trapezoids instead of the raw pulses. A change of the
+ * shaping is handed over through a flag and applied by the task between
+ * frames, so the shaper's delay line is only ever touched by this task.
+ *
+ * Each frame is first screened with pulseKernelSummarize() (PIE vector unit on
+ * the S3): chunks that hold only baseline are skipped in bulk and only chunks
+ * containing a pulse are walked sample by sample.
+ *
+ * Pulses leave as timestamped events through an SPSC ring; pulseTask merges them
+ * with the Geiger stream and bins them. Timestamps come from the sample clock:
+ * the end of each frame is predicted from the previous one plus the frame's
+ * sample count, and pulled back whenever the source reports it earlier
+ * than predicted. Scheduling delays only ever make the read late, so this
+ * minimum tracks the true frame end to a few microseconds instead of the task
+ * wake-up jitter; a small per-frame allowance lets it follow clock drift upward.
+ *
+ * Real time advances with those frame ends, so it includes frames lost to an
+ * overrun; live time only with the samples the detector saw outside a pulse.
+ */
+
+#include "spectrum_adc.h"
+#include "spectrum_source.h"
+#include "pulse_height.h"
+#include "pulse_kernel.h"
+#include "spsc_ring.h"
+#include "trapezoid_shaper.h"
+#include <atomic>
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include <math.h>
+#include "debug.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+static const size_t FRAME_SAMPLES = 2048;   ///< Largest block taken from the source per read
+static const size_t FRAME_CHUNKS = FRAME_SAMPLES / PULSE_KERNEL_CHUNK;
+static const size_t MAX_PULSES_PER_FRAME = 64;
+
+static PulseHeightDetector detector(SPECTRUM_THRESHOLD_DEFAULT);
+static SpectrumSource& source = SPECTRUM_SOURCE == 1 ? spectrumCamSource() : spectrumAdc1Source();
+static const uint32_t NOMINAL_RATE = SPECTRUM_SOURCE == 1 ? SPECTRUM_CAM_SAMPLE_RATE : SPECTRUM_SAMPLE_RATE;
+static uint32_t sampleRate = NOMINAL_RATE;      ///< The source's actual rate once started
+static SpectrumAcqStats acqStats = {false, 0, 0, 0, 0, NOMINAL_RATE, 0, 0, SPECTRUM_PILEUP_MODE, 0, 0, false};
+static const uint32_t FRAME_END_SLEW_US = 2; ///< Upward drift allowed per frame
+
+static SpscRing<SpectrumEvent, SPECTRUM_EVENT_RING_SIZE> eventRing;
+static std::atomic<uint32_t> pendingLiveMs(0);
+static std::atomic<uint32_t> pendingRealMs(0);
+
+static TrapezoidShaper shaper;                  ///< Acquisition task only
+static SpectrumShaping shaping = {SPECTRUM_SHAPING != 0, SPECTRUM_TRAP_RISE_US, SPECTRUM_TRAP_FLAT_US,
+                                  SPECTRUM_TRAP_DECAY_US};
+static portMUX_TYPE shapingMux = portMUX_INITIALIZER_UNLOCKED;
+static std::atomic<bool> shapingChanged(true);  ///< The task picks up `shaping` at its next frame
+
+/// Sample-clock span of @p samples in microseconds.
+static inline uint32_t samplesToUs(uint32_t samples) {
+    return (uint32_t)((uint64_t)samples * 1000000ULL / sampleRate);
+}
+
+/// Microseconds in whole samples, rounded.
+static inline uint32_t usToSamples(uint32_t us) {
+    return (uint32_t)(((uint64_t)us * sampleRate + 500000) / 1000000);
+}
+
+/// Decay time constant of @p c in samples, Q8.
+static inline uint32_t decaySamplesQ8(const SpectrumShaping& c) {
+    return (uint32_t)((uint64_t)c.decayUs * sampleRate * 256 / 1000000);
+}
+
+/// True if the trapezoid of @p c fits the shaper at the current sample rate.
+static bool shaperFits(const SpectrumShaping& c) {
+    uint32_t rise = usToSamples(c.riseUs), flat = usToSamples(c.flatUs);
+    return rise <= 0xFFFF && flat <= 0xFFFF && TrapezoidShaper::valid(rise, flat, decaySamplesQ8(c));
+}
+
+static bool configureShaper(TrapezoidShaper& target, const SpectrumShaping& c) {
+    return shaperFits(c) && target.configure(usToSamples(c.riseUs), usToSamples(c.flatUs), decaySamplesQ8(c));
+}
+
+/**
+ * @brief Acquisition task: one block of samples in, pulse events out.
+ */
+static void spectrumAcqTask(void* parameter) {
+    static uint16_t samples[FRAME_SAMPLES] __attribute__((aligned(16))); // Vector loads
+    static uint16_t shaped[FRAME_SAMPLES] __attribute__((aligned(16)));
+    static int16_t chunkMax[FRAME_CHUNKS];
+    static int32_t chunkSum[FRAME_CHUNKS];
+    uint16_t heights[MAX_PULSES_PER_FRAME];
+    uint32_t starts[MAX_PULSES_PER_FRAME];
+    uint8_t flags[MAX_PULSES_PER_FRAME];
+    uint32_t samplesPerMs = sampleRate / 1000;
+    uint64_t liveSamples = 0;
+    uint32_t liveRemainder = 0; // Samples not yet credited as a whole millisecond
+    uint32_t realRemainderUs = 0;
+    bool clockValid = false;
+    bool started = false;
+    uint32_t frameEndUs = 0;    // Estimated time of the last sample of the previous frame
+
+    for (;;) {
+        uint32_t readUs = 0;
+        bool lost = false;
+        size_t n = source.read(samples, FRAME_SAMPLES, &readUs, &lost);
+        if (lost) {
+            // The source overran: samples were lost, so the pulse in progress
+            // (if any), the baseline and the sample clock are meaningless
+            acqStats.overruns++;
+            detector.reset();
+            shaper.reset();
+            clockValid = false;
+        }
+        if (n == 0) continue;
+        if (shapingChanged.exchange(false, std::memory_order_acquire)) {
+            portENTER_CRITICAL(&shapingMux);
+            SpectrumShaping next = shaping;
+            portEXIT_CRITICAL(&shapingMux);
+            acqStats.shaping = next.enabled && configureShaper(shaper, next);
+            detector.reset(); // The shaped baseline sits at TRAPEZOID_OFFSET, not at the raw one
+        }
+
+        const uint16_t* input = samples;
+        if (acqStats.shaping) {
+            shaper.process(samples, shaped, n);
+            input = shaped;
+        }
+
+        size_t chunks = n / PULSE_KERNEL_CHUNK;
+        pulseKernelSummarize(input, chunks, chunkMax, chunkSum);
+        uint32_t busyBefore = detector.busySamples();
+        size_t pulses = detector.processScreened(input, n, PULSE_KERNEL_CHUNK, chunkMax, chunkSum,
+                                                 heights, MAX_PULSES_PER_FRAME, starts, flags);
+        uint32_t busy = detector.busySamples() - busyBefore;
+        size_t stored = pulses < MAX_PULSES_PER_FRAME ? pulses : MAX_PULSES_PER_FRAME;
+
+        // Frame end on the sample clock, clamped to the (never early) read time
+        uint32_t predictedUs = frameEndUs + samplesToUs(n) + FRAME_END_SLEW_US;
+        uint32_t previousEndUs = frameEndUs;
+        frameEndUs = clockValid && (int32_t)(readUs - predictedUs) > 0 ? predictedUs : readUs;
+        clockValid = true;
+        if (started) {
+            uint32_t spanUs = frameEndUs - previousEndUs;
+            acqStats.realUs += spanUs;
+            realRemainderUs += spanUs;
+            pendingRealMs.fetch_add(realRemainderUs / 1000, std::memory_order_relaxed);
+            realRemainderUs %= 1000;
+        }
+        started = true;
+        uint32_t endPosition = detector.position();
+        for (size_t i = 0; i < stored; i++) {
+            // A trapezoid arms the detector part way up its rise; date the pulse from its start
+            uint32_t start = starts[i];
+            if (acqStats.shaping) start -= shaper.armDelay(heights[i], detector.threshold());
+            SpectrumEvent event;
+            event.timestampUs = frameEndUs - samplesToUs(endPosition - start);
+            event.height = heights[i];
+            event.flags = flags[i];
+            event.reserved = 0;
+            if (!eventRing.push(event)) acqStats.eventDrops++;
+        }
+
+        // Live time counts delivered samples outside pulses only, so overrun
+        // frames, the dead time of each pulse and rejected pile-ups are excluded
+        uint32_t live = n - busy;
+        liveRemainder += live;
+        pendingLiveMs.fetch_add(liveRemainder / samplesPerMs, std::memory_order_relaxed);
+        liveRemainder %= samplesPerMs;
+        liveSamples += live;
+        acqStats.liveUs = liveSamples * 1000000ULL / sampleRate;
+        acqStats.samples += n;
+        acqStats.pulses += pulses;
+        acqStats.pileUps = detector.pileUps();
+        acqStats.baseline = detector.baseline();
+    }
+}
+
+bool initSpectrumAdc(Spectrum& spectrum) {
+#if SPECTRUM_ENABLED
+    if (acqStats.running) return true;
+    if (!spectrum.ready()) return false;
+    if (!source.begin()) return false;
+    sampleRate = source.sampleRate();
+    acqStats.sampleRate = sampleRate;
+    // Times to samples at the actual rate; a trapezoid that no longer fits
+    // leaves shaping off (acqStats.shaping) until it is set again
+    setSpectrumPileUp((PileUpMode)SPECTRUM_PILEUP_MODE);
+    shapingChanged.store(true, std::memory_order_release);
+
+    spectrum.attachWriter();
+    // Above pulseTask: a late frame costs samples, a late PCNT read costs nothing
+    xTaskCreatePinnedToCore(spectrumAcqTask, "SpectrumAcq", 4096, NULL, 3, NULL, 0);
+    acqStats.running = true;
+    DEBUG_PRINTF("Spectrum: %s at %lu S/s, %u channels\n", source.name(), (unsigned long)sampleRate,
+                 spectrum.channels());
+    return true;
+#else
+    return false;
+#endif
+}
+
+uint8_t spectrumSampleBits() {
+    return source.bits();
+}
+
+const char* spectrumSourceName() {
+    return source.name();
+}
+
+bool peekSpectrumEvent(SpectrumEvent& event) {
+    return eventRing.peek(event);
+}
+
+bool popSpectrumEvent(SpectrumEvent& event) {
+    return eventRing.pop(event);
+}
+
+uint32_t takeSpectrumLiveMs() {
+    return pendingLiveMs.exchange(0, std::memory_order_relaxed);
+}
+
+uint32_t takeSpectrumRealMs() {
+    return pendingRealMs.exchange(0, std::memory_order_relaxed);
+}
+
+void setSpectrumThreshold(uint16_t threshold) {
+    detector.setThreshold(threshold);
+}
+
+void setSpectrumPileUp(PileUpMode mode) {
+    uint32_t widthUs = SPECTRUM_PILEUP_MAX_WIDTH_US;
+    uint32_t riseUs = SPECTRUM_PILEUP_MAX_RISE_US;
+    if (shaping.enabled) {
+        // The trapezoid stretches every pulse by its rise and flat top
+        if (widthUs) widthUs += 2u * shaping.riseUs + shaping.flatUs;
+        if (riseUs) riseUs += shaping.riseUs + shaping.flatUs;
+    }
+    // Whole samples, rounded up, so a clean pulse of exactly the limit passes
+    auto samplesUp = [](uint32_t us) {
+        uint64_t samples = ((uint64_t)us * sampleRate + 999999) / 1000000;
+        return (uint16_t)(samples < 0xFFFF ? samples : 0xFFFF);
+    };
+    detector.setPileUp(mode, samplesUp(widthUs), samplesUp(riseUs));
+    acqStats.pileUpMode = mode;
+}
+
+bool setSpectrumShaping(const SpectrumShaping& next) {
+    if (next.enabled && !shaperFits(next)) return false;
+    portENTER_CRITICAL(&shapingMux);
+    shaping = next;
+    portEXIT_CRITICAL(&shapingMux);
+    shapingChanged.store(true, std::memory_order_release);
+    setSpectrumPileUp((PileUpMode)acqStats.pileUpMode);
+    return true;
+}
+
+SpectrumShaping getSpectrumShaping() {
+    portENTER_CRITICAL(&shapingMux);
+    SpectrumShaping current = shaping;
+    portEXIT_CRITICAL(&shapingMux);
+    return current;
+}
+
+/**
+ * @brief Fills @p buf with a baseline of ~500 codes and one shaped pulse every @p spacing samples.
+ */
+static void makeTestSignal(uint16_t* buf, size_t n, size_t spacing) {
+    for (size_t i = 0; i < n; i++) {
+        buf[i] = 500 + (i * 7) % 5; // A little deterministic noise
+    }
+    for (size_t start = spacing / 2; start + 12 < n; start += spacing) {
+        for (int k = 0; k < 12; k++) {
+            buf[start + k] += (uint16_t)(800.0f * expf(-(k - 4) * (k - 4) / 6.0f));
+        }
+    }
+}
+
+/**
+ * @brief Fills @p buf with a baseline of ~500 codes, ~6 codes rms of noise and a
+ * CR-RC pulse of @p amplitude every 128 samples, each at a random phase to the
+ * sample clock. The pulse rises with a 1-sample and falls with a
+ * @p decay-sample time constant. @p seed carries the noise across calls.
+ */
+static void makeLineSignal(uint16_t* buf, size_t n, float amplitude, float decay, uint32_t& seed) {
+    auto uniform = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return (seed >> 8) * (1.0f / 16777216.0f) - 0.5f;
+    };
+    for (size_t i = 0; i < n; i++) {
+        // Sum of four uniforms: sigma 0.577, near enough to Gaussian
+        float noise = (uniform() + uniform() + uniform() + uniform()) * 10.4f;
+        buf[i] = (uint16_t)lroundf(500.0f + noise);
+    }
+    // exp(-t/decay) - exp(-t) peaks at t = ln(decay) * decay / (decay - 1)
+    float tPeak = logf(decay) * decay / (decay - 1.0f);
+    float scale = amplitude / (expf(-tPeak / decay) - expf(-tPeak));
+    for (size_t start = 0; start + 64 <= n; start += 128) {
+        float phase = uniform() + 0.5f;
+        for (size_t k = 1; k < 64; k++) {
+            float t = k - phase;
+            buf[start + k] += (uint16_t)lroundf(scale * (expf(-t / decay) - expf(-t)));
+        }
+    }
+}
+
+/// Relative FWHM in percent from the height sums, assuming a Gaussian line.
+static float lineFwhmPercent(uint32_t count, double sum, double sumSquares) {
+    if (count < 2) return NAN;
+    double mean = sum / count;
+    double variance = sumSquares / count - mean * mean;
+    return variance > 0.0 && mean > 0.0 ? (float)(235.5 * sqrt(variance) / mean) : 0.0f;
+}
+
+void runSpectrumBenchmark(Print& out) {
+    const size_t n = 4096;
+    const int rounds = 50;
+    uint16_t* buf = (uint16_t*)heap_caps_aligned_alloc(16, n * sizeof(uint16_t), MALLOC_CAP_8BIT | MALLOC_CAP_INTERNAL);
+    int16_t* chunkMax = (int16_t*)malloc(n / PULSE_KERNEL_CHUNK * sizeof(int16_t));
+    int32_t* chunkSum = (int32_t*)malloc(n / PULSE_KERNEL_CHUNK * sizeof(int32_t));
+    if (!buf || !chunkMax || !chunkSum) {
+        out.println("Benchmark: out of memory");
+        heap_caps_free(buf);
+        free(chunkMax);
+        free(chunkSum);
+        return;
+    }
+
+    uint16_t heights[MAX_PULSES_PER_FRAME];
+    out.printf("Pulse kernel benchmark, %u samples x %d rounds (%s)\n", (unsigned)n, rounds,
+               pulseKernelVectorized() ? "PIE" : "scalar only");
+    // At 80 kS/s a spacing of 4 samples would be 20 k pulses/s; real shaped pulses need more
+    static const size_t spacings[] = {1024, 64, 16};
+    for (size_t s = 0; s < sizeof(spacings) / sizeof(spacings[0]); s++) {
+        makeTestSignal(buf, n, spacings[s]);
+        size_t pulsesScalar = 0, pulsesScreened = 0;
+
+        PulseHeightDetector scalar(SPECTRUM_THRESHOLD_DEFAULT);
+        int64_t t0 = esp_timer_get_time();
+        for (int r = 0; r < rounds; r++) {
+            pulsesScalar += scalar.process(buf, n, heights, MAX_PULSES_PER_FRAME);
+        }
+        int64_t tScalar = esp_timer_get_time() - t0;
+
+        PulseHeightDetector screened(SPECTRUM_THRESHOLD_DEFAULT);
+        t0 = esp_timer_get_time();
+        for (int r = 0; r < rounds; r++) {
+            pulseKernelSummarize(buf, n / PULSE_KERNEL_CHUNK, chunkMax, chunkSum);
+            pulsesScreened += screened.processScreened(buf, n, PULSE_KERNEL_CHUNK, chunkMax, chunkSum,
+                                                       heights, MAX_PULSES_PER_FRAME);
+        }
+        int64_t tScreened = esp_timer_get_time() - t0;
+
+        double samples = (double)n * rounds;
+        out.printf("  spacing %4u: scalar %.2f MS/s, screened %.2f MS/s (%u / %u pulses)\n",
+                   (unsigned)spacings[s], samples / tScalar, samples / tScreened,
+                   (unsigned)pulsesScalar, (unsigned)pulsesScreened);
+    }
+
+    // Kernel alone: vector unit against the portable loop
+    int64_t t0 = esp_timer_get_time();
+    for (int r = 0; r < rounds; r++) {
+        pulseKernelSummarizeScalar(buf, n / PULSE_KERNEL_CHUNK, chunkMax, chunkSum);
+    }
+    int64_t tScalar = esp_timer_get_time() - t0;
+    t0 = esp_timer_get_time();
+    for (int r = 0; r < rounds; r++) {
+        pulseKernelSummarize(buf, n / PULSE_KERNEL_CHUNK, chunkMax, chunkSum);
+    }
+    int64_t tVector = esp_timer_get_time() - t0;
+    out.printf("  kernel: scalar %.2f MS/s, %s %.2f MS/s\n", (double)n * rounds / tScalar,
+               pulseKernelVectorized() ? "PIE" : "scalar", (double)n * rounds / tVector);
+
+    // Resolution: a 662 keV line at the default calibration through the plain
+    // detector and through the trapezoid with the current shaping settings
+    // (enabled or not). Only noise and sampling phase widen this line; the
+    // crystal's own ~7% comes on top.
+    uint16_t* shapedBuf = (uint16_t*)heap_caps_aligned_alloc(16, n * sizeof(uint16_t), MALLOC_CAP_8BIT | MALLOC_CAP_INTERNAL);
+    static TrapezoidShaper benchShaper; // Off the caller's stack
+    SpectrumShaping settings = getSpectrumShaping();
+    if (shapedBuf && configureShaper(benchShaper, settings)) {
+        float amplitude = 662.0f / SPECTRUM_CAL_C1 * (4096.0f / SPECTRUM_CHANNELS);
+        uint32_t decayUs = settings.decayUs ? settings.decayUs : 40;
+        float decay = decayUs * (sampleRate / 1e6f);
+        if (decay < 1.5f) decay = 1.5f; // The generator's rise is one sample
+        PulseHeightDetector plain(SPECTRUM_THRESHOLD_DEFAULT);
+        PulseHeightDetector trapezoid(SPECTRUM_THRESHOLD_DEFAULT);
+        uint32_t seed = 12345;
+        uint32_t countPlain = 0, countTrap = 0;
+        double sumPlain = 0, squaresPlain = 0, sumTrap = 0, squaresTrap = 0;
+        int64_t tPlain = 0, tTrap = 0;
+        for (int r = 0; r < rounds; r++) {
+            makeLineSignal(buf, n, amplitude, decay, seed);
+            int64_t t1 = esp_timer_get_time();
+            pulseKernelSummarize(buf, n / PULSE_KERNEL_CHUNK, chunkMax, chunkSum);
+            size_t found = plain.processScreened(buf, n, PULSE_KERNEL_CHUNK, chunkMax, chunkSum,
+                                                 heights, MAX_PULSES_PER_FRAME);
+            tPlain += esp_timer_get_time() - t1;
+            for (size_t i = 0; i < found && i < MAX_PULSES_PER_FRAME; i++) {
+                countPlain++;
+                sumPlain += heights[i];
+                squaresPlain += (double)heights[i] * heights[i];
+            }
+
+            t1 = esp_timer_get_time();
+            benchShaper.process(buf, shapedBuf, n);
+            pulseKernelSummarize(shapedBuf, n / PULSE_KERNEL_CHUNK, chunkMax, chunkSum);
+            found = trapezoid.processScreened(shapedBuf, n, PULSE_KERNEL_CHUNK, chunkMax, chunkSum,
+                                              heights, MAX_PULSES_PER_FRAME);
+            tTrap += esp_timer_get_time() - t1;
+            for (size_t i = 0; i < found && i < MAX_PULSES_PER_FRAME; i++) {
+                countTrap++;
+                sumTrap += heights[i];
+                squaresTrap += (double)heights[i] * heights[i];
+            }
+        }
+        double samples = (double)n * rounds;
+        out.printf("  662 keV line (%.0f codes, pulse decay %lu us):\n", amplitude, (unsigned long)decayUs);
+        out.printf("    max-hold:  %.2f MS/s, %lu pulses, FWHM %.2f%%\n", samples / tPlain,
+                   (unsigned long)countPlain, lineFwhmPercent(countPlain, sumPlain, squaresPlain));
+        out.printf("    trapezoid: %.2f MS/s, %lu pulses, FWHM %.2f%% (rise %u, flat %u, decay %u us)\n",
+                   samples / tTrap, (unsigned long)countTrap, lineFwhmPercent(countTrap, sumTrap, squaresTrap),
+                   settings.riseUs, settings.flatUs, settings.decayUs);
+    } else {
+        out.println("  662 keV line: skipped (out of memory or shaping settings invalid)");
+    }
+
+    heap_caps_free(shapedBuf);
+    heap_caps_free(buf);
+    free(chunkMax);
+    free(chunkSum);
+}
+
+SpectrumAcqStats getSpectrumAcqStats() {
+    return acqStats;
+}
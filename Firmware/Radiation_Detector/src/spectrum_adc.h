@@ -0,0 +1,90 @@
+#ifndef SPECTRUM_ADC_H
+#define SPECTRUM_ADC_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "spectrum.h"
+#include "pulse_height.h"
+
+// Continuous (DMA) ADC acquisition for the scintillation channel.
+// A SpectrumSource (spectrum_source.h: ADC1, or an external ADC through
+// LCD_CAM) delivers the SiPM signal in blocks of samples; a pinned task runs the
+// pulse-height detector over every block and queues each pulse as a timestamped
+// event. pulseTask consumes the events (coincidence gating) and bins them into
+// the Spectrum, which makes it the histogram's only writer.
+// Pile-up is handled by the detector (pulse_height.h): rejected there, or
+// passed on flagged. Live time is the sampled time minus the time the detector
+// spent inside pulses, so rates per live second are corrected for dead time
+// and for the rejected pile-ups; real time is the time acquisition ran.
+
+struct SpectrumEvent {
+    uint32_t timestampUs; ///< esp_timer time of the sample that armed the pulse
+    uint16_t height;      ///< ADC codes above baseline
+    uint8_t flags;        ///< PulseFlags
+    uint8_t reserved;
+};
+
+struct SpectrumAcqStats {
+    bool running;        ///< ADC continuous mode started
+    uint32_t samples;    ///< Samples processed since start
+    uint32_t pulses;     ///< Pulses detected since start
+    uint32_t overruns;   ///< Frames the DMA ring overwrote before the task read them
+    uint16_t baseline;   ///< Current baseline in ADC codes
+    uint32_t sampleRate; ///< Samples per second of the source
+    uint32_t eventDrops; ///< Pulses lost because the event ring was full
+    uint32_t pileUps;    ///< Pulses found piled up (rejected or flagged)
+    uint8_t pileUpMode;  ///< PileUpMode
+    uint64_t liveUs;     ///< Since start: sampled time outside pulses
+    uint64_t realUs;     ///< Since start: time covered by the frames read, overruns included
+    bool shaping;        ///< The detector runs on the trapezoid (applied by the task)
+};
+
+// Trapezoidal shaping ahead of the detector (trapezoid_shaper.h). Times are
+// rounded to whole samples.
+struct SpectrumShaping {
+    bool enabled;
+    uint16_t riseUs;     ///< Rise (and fall) time of the trapezoid
+    uint16_t flatUs;     ///< Flat top
+    uint16_t decayUs;    ///< Fall time constant of the amplifier's pulse, 0 for short pulses
+};
+
+// Starts the SPECTRUM_SOURCE sample source and the acquisition task, whose
+// events are binned into @p spectrum. Returns false if the source could not
+// be started (pins not set, driver or memory failure).
+bool initSpectrumAdc(Spectrum& spectrum);
+
+// Sample width of the configured source, for Spectrum::begin(); and its name.
+uint8_t spectrumSampleBits();
+const char* spectrumSourceName();
+
+// Consumer side of the event ring (pulseTask only), oldest first.
+bool peekSpectrumEvent(SpectrumEvent& event);
+bool popSpectrumEvent(SpectrumEvent& event);
+
+// Live milliseconds (sampled, outside pulses) delivered since the previous call.
+uint32_t takeSpectrumLiveMs();
+
+// Real milliseconds of acquisition since the previous call.
+uint32_t takeSpectrumRealMs();
+
+// Pile-up handling (serial "spectrum pileup off|flag|reject").
+void setSpectrumPileUp(PileUpMode mode);
+
+// Changes the discriminator threshold (ADC codes above baseline).
+void setSpectrumThreshold(uint16_t threshold);
+
+// Switches shaping (serial "spectrum shaping"); the acquisition task applies
+// it at its next frame and restarts the baseline. Returns false, and changes
+// nothing, if the trapezoid does not fit the shaper's delay line.
+bool setSpectrumShaping(const SpectrumShaping& shaping);
+SpectrumShaping getSpectrumShaping();
+
+SpectrumAcqStats getSpectrumAcqStats();
+
+// Times the per-sample detector against the kernel-screened one on synthetic
+// pulse trains and prints the throughput; then runs a noisy 662 keV line
+// through the plain and the trapezoid-shaped detector and prints samples per
+// second and the resolution (FWHM) of each (serial "spectrum bench").
+void runSpectrumBenchmark(Print& out);
+
+#endif // SPECTRUM_ADC_H
@@ -0,0 +1,184 @@
+/**
+ * @file spectrum_analysis.cpp
+ * @brief Energy calibration storage and incremental peak fitting of reference lines.
+ *
+ * Each pass copies the histogram once, so all lines of a pass are fitted on the
+ * same counts while acquisition keeps binning. The fit window for a line is its
+ * expected channel +-4 sigma, with sigma from the detector resolution scaled as
+ * sqrt(E) and converted to channels through the local calibration slope. A fit
+ * is accepted only if it lands within two expected sigmas of the reference and
+ * its width is plausible for the detector, which rejects background wiggles the
+ * fit alone would take for a weak peak.
+ */
+
+#include "spectrum_analysis.h"
+#include "seqlock.h"
+#include "debug.h"
+#include <Preferences.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+struct ReferenceLine {
+    const char* isotope;
+    float keV;
+};
+
+static const ReferenceLine REFERENCE_LINES[SPECTRUM_LINE_COUNT] = {
+    {"Cs-137", 661.7f},
+    {"K-40", 1460.8f},
+};
+
+static const float FWHM_TO_SIGMA = 1.0f / 2.3548f;
+
+static const Spectrum* analysisSpectrum = nullptr;
+static uint32_t countsCopy[SPECTRUM_CHANNELS];
+static SeqLock<SpectrumAnalysis> analysisLock;
+static SemaphoreHandle_t calibrationMutex = nullptr;
+static EnergyCalibration calibration = {SPECTRUM_CAL_C0, SPECTRUM_CAL_C1, SPECTRUM_CAL_C2};
+
+/**
+ * @brief Expected Gaussian sigma in keV at @p keV for the configured resolution.
+ */
+static float expectedSigmaKeV(float keV) {
+    return SPECTRUM_RESOLUTION_662 * sqrtf(661.7f * keV) * FWHM_TO_SIGMA;
+}
+
+/**
+ * @brief Fits one reference line on the copied counts.
+ */
+static void analyseLine(const ReferenceLine& line, const EnergyCalibration& cal, size_t channels,
+                        SpectrumLineResult* result) {
+    memset(result, 0, sizeof(*result));
+    result->isotope = line.isotope;
+    result->referenceKeV = line.keV;
+
+    float expected = cal.channel(line.keV);
+    float slope = cal.slope(expected);
+    if (expected < 0.0f || slope <= 0.0f) return;
+    float sigmaCh = expectedSigmaKeV(line.keV) / slope;
+    if (sigmaCh < 2.0f) sigmaCh = 2.0f;
+
+    int lo = (int)(expected - 4.0f * sigmaCh);
+    int hi = (int)(expected + 4.0f * sigmaCh + 0.5f);
+    if (lo < 0 || hi >= (int)channels) return;
+
+    PeakFit fit;
+    if (!fitGaussianOnLinear(countsCopy, channels, lo, hi, &fit)) return;
+    if (fabsf(fit.centroid - expected) > 2.0f * sigmaCh) return;
+    if (fit.sigma < 0.4f * sigmaCh || fit.sigma > 2.5f * sigmaCh) return;
+
+    result->found = true;
+    result->centroid = fit.centroid;
+    result->energyKeV = cal.energy(fit.centroid);
+    result->fwhmKeV = 2.3548f * fit.sigma * cal.slope(fit.centroid);
+    result->netCounts = fit.netArea;
+    result->netError = fit.netAreaError;
+}
+
+/**
+ * @brief Analysis task: one snapshot per interval, one line fit per step.
+ */
+static void spectrumAnalysisTask(void* parameter) {
+    SpectrumAnalysis analysis = getSpectrumAnalysis(); // Seeded with the line table by init
+    uint32_t analysedTotal = UINT32_MAX;
+
+    for (;;) {
+        vTaskDelay(pdMS_TO_TICKS(SPECTRUM_ANALYSIS_INTERVAL_MS));
+
+        uint32_t total = analysisSpectrum->total();
+        if (total == analysedTotal) continue; // Nothing new binned
+        if (total < SPECTRUM_ANALYSIS_MIN_COUNTS) {
+            if (total < analysedTotal || analysedTotal == UINT32_MAX) {
+                // Cleared or not enough statistics yet: drop stale results
+                for (uint8_t i = 0; i < SPECTRUM_LINE_COUNT; i++) analysis.lines[i].found = false;
+                analysis.totalCounts = total;
+                analysisLock.publish(analysis);
+            }
+            analysedTotal = total;
+            continue;
+        }
+        analysedTotal = total;
+
+        size_t channels = analysisSpectrum->read(0, countsCopy, SPECTRUM_CHANNELS);
+        EnergyCalibration cal = getEnergyCalibration();
+        for (uint8_t i = 0; i < SPECTRUM_LINE_COUNT; i++) {
+            analyseLine(REFERENCE_LINES[i], cal, channels, &analysis.lines[i]);
+            vTaskDelay(1); // Let the web and history tasks in between fits
+        }
+        analysis.runs++;
+        analysis.totalCounts = total;
+        analysis.calibration = cal;
+        analysisLock.publish(analysis);
+    }
+}
+
+bool initSpectrumAnalysis(const Spectrum& spectrum) {
+    if (analysisSpectrum) return true;
+    if (!spectrum.ready()) return false;
+
+    calibrationMutex = xSemaphoreCreateMutex();
+    Preferences prefs;
+    prefs.begin("spectrum", true);
+    calibration.c0 = prefs.getFloat("cal_c0", SPECTRUM_CAL_C0);
+    calibration.c1 = prefs.getFloat("cal_c1", SPECTRUM_CAL_C1);
+    calibration.c2 = prefs.getFloat("cal_c2", SPECTRUM_CAL_C2);
+    prefs.end();
+
+    SpectrumAnalysis empty;
+    memset(&empty, 0, sizeof(empty));
+    empty.calibration = calibration;
+    for (uint8_t i = 0; i < SPECTRUM_LINE_COUNT; i++) {
+        empty.lines[i].isotope = REFERENCE_LINES[i].isotope;
+        empty.lines[i].referenceKeV = REFERENCE_LINES[i].keV;
+    }
+    analysisLock.publish(empty);
+
+    analysisSpectrum = &spectrum;
+    xTaskCreatePinnedToCore(spectrumAnalysisTask, "SpectrumFit", 4096, NULL,
+                            tskIDLE_PRIORITY + 1, NULL, 0);
+    DEBUG_PRINTF("Spectrum analysis: E = %.3f + %.4f*ch + %.3g*ch^2 keV\n",
+                 calibration.c0, calibration.c1, calibration.c2);
+    return true;
+}
+
+SpectrumAnalysis getSpectrumAnalysis() {
+    SpectrumAnalysis analysis;
+    memset(&analysis, 0, sizeof(analysis));
+    analysisLock.read(analysis);
+    return analysis;
+}
+
+EnergyCalibration getEnergyCalibration() {
+    if (calibrationMutex) xSemaphoreTake(calibrationMutex, portMAX_DELAY);
+    EnergyCalibration cal = calibration;
+    if (calibrationMutex) xSemaphoreGive(calibrationMutex);
+    return cal;
+}
+
+void setEnergyCalibration(const EnergyCalibration& cal) {
+    Preferences prefs;
+    prefs.begin("spectrum", false);
+    prefs.putFloat("cal_c0", cal.c0);
+    prefs.putFloat("cal_c1", cal.c1);
+    prefs.putFloat("cal_c2", cal.c2);
+    prefs.end();
+
+    if (calibrationMutex) xSemaphoreTake(calibrationMutex, portMAX_DELAY);
+    calibration = cal;
+    if (calibrationMutex) xSemaphoreGive(calibrationMutex);
+}
+
+bool calibrateFromReferenceLines() {
+    SpectrumAnalysis analysis = getSpectrumAnalysis();
+    const SpectrumLineResult& low = analysis.lines[0];
+    const SpectrumLineResult& high = analysis.lines[1];
+    if (!low.found || !high.found || high.centroid <= low.centroid) return false;
+
+    EnergyCalibration cal;
+    cal.c1 = (high.referenceKeV - low.referenceKeV) / (high.centroid - low.centroid);
+    cal.c0 = low.referenceKeV - cal.c1 * low.centroid;
+    cal.c2 = 0.0f;
+    setEnergyCalibration(cal);
+    return true;
+}
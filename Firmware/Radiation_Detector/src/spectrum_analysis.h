@@ -0,0 +1,51 @@
+#ifndef SPECTRUM_ANALYSIS_H
+#define SPECTRUM_ANALYSIS_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "spectrum.h"
+#include "spectrum_fit.h"
+
+// Background isotope identification on the pulse-height spectrum.
+// A low-priority task on core 0 snapshots the histogram every
+// SPECTRUM_ANALYSIS_INTERVAL_MS and fits a Gaussian on a linear background around
+// each reference line (one line per step, yielding in between), using the saved
+// energy calibration. Results are published wait-free for the UI and web tasks.
+
+static const uint8_t SPECTRUM_LINE_COUNT = 2;
+
+struct SpectrumLineResult {
+    const char* isotope;   ///< e.g. "Cs-137"
+    float referenceKeV;    ///< Tabulated line energy
+    bool found;            ///< Significant peak fitted in the window
+    float centroid;        ///< Fitted position in channels
+    float energyKeV;       ///< Calibrated centroid
+    float fwhmKeV;         ///< Calibrated full width at half maximum
+    float netCounts;       ///< Peak area above background
+    float netError;        ///< 1-sigma uncertainty of netCounts
+};
+
+struct SpectrumAnalysis {
+    uint32_t runs;               ///< Completed analysis passes
+    uint32_t totalCounts;        ///< Spectrum counts at the last pass
+    EnergyCalibration calibration;
+    SpectrumLineResult lines[SPECTRUM_LINE_COUNT];
+};
+
+// Loads the calibration from Preferences ("spectrum" namespace) and starts the
+// analysis task reading @p spectrum.
+bool initSpectrumAnalysis(const Spectrum& spectrum);
+
+// Latest published results (zeroed before the first pass).
+SpectrumAnalysis getSpectrumAnalysis();
+
+EnergyCalibration getEnergyCalibration();
+
+// Sets and saves the calibration; the next pass uses it.
+void setEnergyCalibration(const EnergyCalibration& calibration);
+
+// Two-point linear calibration from the last fitted Cs-137 and K-40 centroids.
+// Returns false (calibration unchanged) unless both lines were found.
+bool calibrateFromReferenceLines();
+
+#endif // SPECTRUM_ANALYSIS_H
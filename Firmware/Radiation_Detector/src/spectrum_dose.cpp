@@ -0,0 +1,252 @@
+/**
+ * @file spectrum_dose.cpp
+ * @brief G(E) spectrum-to-dose conversion with an incrementally applied channel table.
+ *
+ * The response model is the usual polynomial in log energy,
+ * ln G(E) = ln G(662) + b1*x + b2*x^2 with x = ln(E / 661.7 keV). The default
+ * b1 = 1 weighs a count by its deposited energy, a first-order approximation.
+ * Fitted coefficients of the crystal in use belong in SPECTRUM_DOSE_B1/B2 or
+ * "spectrum dose model".
+ *
+ * Everything except the model setter runs on pulseTask, which owns the
+ * tables, the window and the integrated dose. The table the adds use is
+ * never written: a rebuild fills the other one and then swaps. The
+ * calibration is taken from the analysis task's published results, not
+ * from getEnergyCalibration(), so pulseTask never waits on its mutex. A new
+ * calibration is therefore picked up with the next analysis pass.
+ */
+
+#include "spectrum_dose.h"
+#include "spectrum_analysis.h"
+#include "seqlock.h"
+#include "debug.h"
+#include <Preferences.h>
+#include <math.h>
+#include "esp_heap_caps.h"
+
+static const float REFERENCE_KEV = 661.7f;
+static const uint8_t WINDOW_SECONDS = 60;      ///< Same span as RATE_WINDOW_60S, the GM rate it is compared with
+static const float MIN_WINDOW_LIVE_S = 10.0f;  ///< Less live time gives no spectral rate
+static const float MS_PER_HOUR = 3600000.0f;
+
+struct WindowSlot {
+    float usv;
+    uint16_t liveMs;
+};
+
+static const Spectrum* doseSpectrum = nullptr;
+static float* tables[2] = {nullptr, nullptr};  ///< µSv per count, SPECTRUM_CHANNELS each
+static uint8_t activeTable = 0;                ///< The one spectrumDoseAdd() reads
+static EnergyCalibration tableCal;             ///< Inputs of the active table
+static uint32_t tableModelVersion = 0;
+
+static bool building = false;                  ///< Filling tables[activeTable ^ 1]
+static uint16_t buildNext = 0;
+static EnergyCalibration buildCal;
+static SpectrumDoseModel buildModel;
+static uint32_t buildModelVersion = 0;
+static uint32_t builds = 0;
+
+static double integratedUsv = 0.0;
+static float batchUsv = 0.0f;                  ///< Added to integratedUsv at the next batch
+static float secondUsv = 0.0f;
+static uint32_t secondLiveMs = 0;
+static uint32_t seenTotal = 0;                 ///< Spectrum total as of the last add; a drop means a clear
+static WindowSlot window[WINDOW_SECONDS];
+static uint8_t windowHead = 0;
+
+static SeqLock<SpectrumDoseModel> modelLock;   ///< Written by setSpectrumDoseModel() (uiTask)
+static SeqLock<SpectrumDoseStatus> statusLock; ///< Written by pulseTask
+
+/**
+ * @brief G(E) of one channel, evaluated at its centre.
+ */
+static float channelWeight(const EnergyCalibration& cal, const SpectrumDoseModel& model, uint16_t channel,
+                           uint16_t channels) {
+    if (channel + 1 >= channels || !cal.valid()) return 0.0f; // The last channel collects the overflow
+    float keV = cal.energy(channel + 0.5f);
+    if (keV <= 0.0f || keV < model.minKeV) return 0.0f;
+    float x = logf(keV / REFERENCE_KEV);
+    return model.usvPerCount662 * expf((model.b1 + model.b2 * x) * x);
+}
+
+/**
+ * @brief Integrated dose from the histogram and the active table (after a swap or at init).
+ */
+static void resum() {
+    const float* table = tables[activeTable];
+    uint32_t counts[64];
+    double sum = 0.0;
+    uint16_t channels = doseSpectrum->channels();
+    for (uint16_t first = 0; first < channels; first += 64) {
+        size_t n = doseSpectrum->read(first, counts, 64);
+        for (size_t i = 0; i < n; i++) sum += (double)counts[i] * table[first + i];
+    }
+    integratedUsv = sum;
+    batchUsv = 0.0f;
+    seenTotal = doseSpectrum->total();
+}
+
+static bool sameCalibration(const EnergyCalibration& a, const EnergyCalibration& b) {
+    return a.c0 == b.c0 && a.c1 == b.c1 && a.c2 == b.c2;
+}
+
+bool initSpectrumDose(const Spectrum& spectrum) {
+    if (doseSpectrum) return true;
+    if (!spectrum.ready()) return false;
+    size_t bytes = spectrum.channels() * sizeof(float);
+    for (uint8_t i = 0; i < 2; i++) {
+        tables[i] = (float*)heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        if (!tables[i]) tables[i] = (float*)heap_caps_malloc(bytes, MALLOC_CAP_8BIT);
+        if (!tables[i]) return false;
+    }
+
+    SpectrumDoseModel model;
+    Preferences prefs;
+    prefs.begin("spectrum", true);
+    model.usvPerCount662 = prefs.getFloat("dose_k", 1.0f / (3600.0f * SPECTRUM_DOSE_CPS_PER_USVH_662));
+    model.b1 = prefs.getFloat("dose_b1", SPECTRUM_DOSE_B1);
+    model.b2 = prefs.getFloat("dose_b2", SPECTRUM_DOSE_B2);
+    model.minKeV = prefs.getFloat("dose_min", SPECTRUM_DOSE_MIN_KEV);
+    prefs.end();
+    modelLock.publish(model);
+
+    // The first table is built here, before pulseTask bins; later ones on pulseTask
+    doseSpectrum = &spectrum;
+    tableCal = getEnergyCalibration();
+    tableModelVersion = modelLock.version();
+    for (uint16_t ch = 0; ch < spectrum.channels(); ch++) {
+        tables[activeTable][ch] = channelWeight(tableCal, model, ch, spectrum.channels());
+    }
+    builds = 1;
+    resum();
+    return true;
+}
+
+void spectrumDoseBatch(uint32_t liveMs) {
+    if (!doseSpectrum) return;
+    if (doseSpectrum->total() < seenTotal) {
+        integratedUsv = 0.0; // Cleared before this batch; the last batch's adds went with it
+    } else {
+        integratedUsv += batchUsv;
+    }
+    batchUsv = 0.0f;
+    seenTotal = doseSpectrum->total();
+    secondLiveMs += liveMs;
+
+    if (!building) return;
+    uint16_t channels = doseSpectrum->channels();
+    float* table = tables[activeTable ^ 1];
+    uint16_t end = buildNext + SPECTRUM_DOSE_BUILD_CHUNK < channels ? buildNext + SPECTRUM_DOSE_BUILD_CHUNK : channels;
+    for (uint16_t ch = buildNext; ch < end; ch++) {
+        table[ch] = channelWeight(buildCal, buildModel, ch, channels);
+    }
+    buildNext = end;
+    if (buildNext < channels) return;
+
+    activeTable ^= 1;
+    tableCal = buildCal;
+    tableModelVersion = buildModelVersion;
+    building = false;
+    builds++;
+    resum();
+}
+
+void spectrumDoseAdd(uint16_t channel) {
+    if (!doseSpectrum) return;
+    float usv = tables[activeTable][channel];
+    batchUsv += usv;
+    secondUsv += usv;
+    seenTotal++;
+}
+
+void spectrumDoseCloseSecond(float gmRateUsvH) {
+    if (!doseSpectrum) return;
+    window[windowHead].usv = secondUsv;
+    window[windowHead].liveMs = secondLiveMs < 0xFFFF ? secondLiveMs : 0xFFFF;
+    windowHead = (windowHead + 1) % WINDOW_SECONDS;
+    secondUsv = 0.0f;
+    secondLiveMs = 0;
+
+    float windowUsv = 0.0f;
+    uint32_t windowLiveMs = 0;
+    for (uint8_t i = 0; i < WINDOW_SECONDS; i++) {
+        windowUsv += window[i].usv;
+        windowLiveMs += window[i].liveMs;
+    }
+
+    // A changed calibration or model starts a rebuild; the old table serves until the swap
+    if (!building) {
+        EnergyCalibration cal = getSpectrumAnalysis().calibration;
+        uint32_t modelVersion = modelLock.version();
+        if (modelVersion != tableModelVersion || !sameCalibration(cal, tableCal)) {
+            SpectrumDoseModel model;
+            if (modelLock.read(model)) {
+                buildCal = cal;
+                buildModel = model;
+                buildModelVersion = modelVersion;
+                buildNext = 0;
+                building = true;
+            }
+        }
+    }
+
+    SpectrumDoseStatus status;
+    status.ready = !building;
+    status.windowLiveS = windowLiveMs / 1000.0f;
+    status.rateUsvH = status.windowLiveS >= MIN_WINDOW_LIVE_S ? windowUsv * MS_PER_HOUR / windowLiveMs : 0.0f;
+    status.gmRateUsvH = gmRateUsvH;
+    status.ratio = status.rateUsvH > 0.0f && gmRateUsvH > 0.0f ? status.rateUsvH / gmRateUsvH : 0.0f;
+    status.integratedUsv = integratedUsv;
+    uint32_t liveMs = doseSpectrum->liveMs();
+    status.averageUsvH = liveMs ? (float)(integratedUsv * MS_PER_HOUR / liveMs) : 0.0f;
+    status.builds = builds;
+    statusLock.publish(status);
+}
+
+SpectrumDoseStatus getSpectrumDoseStatus() {
+    SpectrumDoseStatus status;
+    memset(&status, 0, sizeof(status));
+    statusLock.read(status);
+    return status;
+}
+
+SpectrumDoseModel getSpectrumDoseModel() {
+    SpectrumDoseModel model;
+    memset(&model, 0, sizeof(model));
+    modelLock.read(model);
+    return model;
+}
+
+void setSpectrumDoseModel(const SpectrumDoseModel& model) {
+    Preferences prefs;
+    prefs.begin("spectrum", false);
+    prefs.putFloat("dose_k", model.usvPerCount662);
+    prefs.putFloat("dose_b1", model.b1);
+    prefs.putFloat("dose_b2", model.b2);
+    prefs.putFloat("dose_min", model.minKeV);
+    prefs.end();
+    modelLock.publish(model);
+}
+
+bool spectrumDoseCalibrate() {
+    SpectrumDoseStatus status = getSpectrumDoseStatus();
+    if (!status.ready || status.rateUsvH <= 0.0f || status.gmRateUsvH <= 0.0f) return false;
+    if (status.windowLiveS < WINDOW_SECONDS * 0.5f) return false;
+    SpectrumDoseModel model = getSpectrumDoseModel();
+    model.usvPerCount662 *= status.gmRateUsvH / status.rateUsvH;
+    setSpectrumDoseModel(model);
+    return true;
+}
+
+void printSpectrumDose(Print& out) {
+    SpectrumDoseStatus s = getSpectrumDoseStatus();
+    SpectrumDoseModel m = getSpectrumDoseModel();
+    out.printf("Spectral dose: %.3f uSv/h over %.0f s live, GM %.3f uSv/h, ratio %.2f%s\n", s.rateUsvH,
+               s.windowLiveS, s.gmRateUsvH, s.ratio, s.ready ? "" : " (table rebuilding)");
+    out.printf("  %.4f uSv since clear, %.3f uSv/h average; %lu table builds\n", s.integratedUsv, s.averageUsvH,
+               (unsigned long)s.builds);
+    out.printf("  Model: G(662) = %.3g uSv/count (%.0f cps per uSv/h), b1 %.3f, b2 %.3f, from %.0f keV\n",
+               m.usvPerCount662, m.usvPerCount662 > 0.0f ? 1.0f / (3600.0f * m.usvPerCount662) : 0.0f, m.b1, m.b2,
+               m.minKeV);
+}
@@ -0,0 +1,73 @@
+#ifndef SPECTRUM_DOSE_H
+#define SPECTRUM_DOSE_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "spectrum.h"
+
+// Energy-compensated dose rate from the scintillation spectrum (G(E) method).
+// The GM rate converts every count with one Cs-137 factor. Here each binned
+// pulse adds the dose its energy stands for, G(E), so sources with other
+// energies are weighted correctly.
+//
+// G(E) comes from a per-channel table built from the energy calibration and
+// the response model. On pulseTask a binned pulse costs one table lookup and
+// one add, so the dose stays current without a pass over the histogram.
+// When the calibration or the model changes, pulseTask rebuilds the table
+// SPECTRUM_DOSE_BUILD_CHUNK channels per poll. It then swaps it in and
+// re-sums the integrated dose from the histogram once.
+//
+// The spectral rate over the last minute of live time is published with the
+// GM rate of the same minute (RATE_WINDOW_60S) and their ratio. A ratio far
+// from 1 in a Cs-137 field means the model's scale is off
+// (spectrumDoseCalibrate()). In a field of other energies it shows how far
+// the GM reading is off.
+
+struct SpectrumDoseModel {
+    float usvPerCount662;  ///< G at 661.7 keV (Cs-137), µSv per count
+    float b1;              ///< ln G = ln(usvPerCount662) + b1*x + b2*x^2, x = ln(E / 661.7 keV)
+    float b2;
+    float minKeV;          ///< Channels below (noise, fluorescence) weigh nothing
+};
+
+struct SpectrumDoseStatus {
+    bool ready;            ///< Table built for the current calibration and model
+    float rateUsvH;        ///< Spectral rate over the window's live time
+    float gmRateUsvH;      ///< Dead-time corrected GM rate over the same minute
+    float ratio;           ///< rateUsvH / gmRateUsvH; 0 while either is unknown
+    float windowLiveS;     ///< Live time behind rateUsvH
+    double integratedUsv;  ///< Since the spectrum was cleared
+    float averageUsvH;     ///< integratedUsv over the spectrum's live time
+    uint32_t builds;       ///< Tables built since boot
+};
+
+// Loads the model from Preferences ("spectrum" namespace) and allocates the
+// tables. Call in setup() after initSpectrumAnalysis(), before pulseTask bins.
+bool initSpectrumDose(const Spectrum& spectrum);
+
+// pulseTask, after Spectrum::beginBatch(): notices a clear, advances a pending
+// table build and adds the batch's live time (0 while not accumulating).
+void spectrumDoseBatch(uint32_t liveMs);
+
+// pulseTask, for each pulse binned into @p channel (Spectrum::add()).
+void spectrumDoseAdd(uint16_t channel);
+
+// pulseTask, once per closed second: closes the window slot, publishes the
+// status and starts a rebuild if the calibration or the model changed.
+void spectrumDoseCloseSecond(float gmRateUsvH);
+
+SpectrumDoseStatus getSpectrumDoseStatus();
+
+SpectrumDoseModel getSpectrumDoseModel();
+
+// Saves and publishes @p model; pulseTask rebuilds the table. uiTask only.
+void setSpectrumDoseModel(const SpectrumDoseModel& model);
+
+// Scales usvPerCount662 so the spectral rate matches the GM rate. Only valid
+// in a Cs-137 field, which the GM conversion factor is calibrated for.
+// @return false without a full window of both rates
+bool spectrumDoseCalibrate();
+
+void printSpectrumDose(Print& out);
+
+#endif // SPECTRUM_DOSE_H
@@ -0,0 +1,246 @@
+/**
+ * @file spectrum_export.cpp
+ * @brief /api/spectrum: the live or a saved spectrum as N42 XML, CSV or raw counts.
+ *
+ * All three formats walk the channels in batches of EXPORT_BATCH through one
+ * reader that either copies from the live histogram (Spectrum::read, the
+ * same lock-free copy the plot uses) or from the decoded saved spectrum. Text
+ * goes through a ChunkWriter, so a 4096-channel N42 document (~30 KB) costs
+ * one 1 KB buffer on the web task's stack. The binary format announces its
+ * length up front; its header total is summed in a first pass over the live
+ * histogram, so counts that arrive while the body is sent can make the
+ * channels add up to slightly more than the header says.
+ */
+
+#include "spectrum_export.h"
+#include "spectrum_session.h"
+#include "spectrum_analysis.h"
+#include "chunk_writer.h"
+#include "supervisor.h"
+#include "esp_heap_caps.h"
+#include <time.h>
+
+static const uint16_t EXPORT_BATCH = 64;       ///< Channels per copy (256 bytes on the stack)
+
+static WebServer* exportServer = nullptr;
+static const Spectrum* exportSpectrum = nullptr;
+
+enum ExportFormat {
+    EXPORT_FORMAT_CSV,
+    EXPORT_FORMAT_N42,
+    EXPORT_FORMAT_BIN
+};
+
+struct ExportSource {
+    const uint32_t* saved;   ///< Decoded saved spectrum, nullptr for the live histogram
+    uint16_t channels;
+    uint32_t liveMs;
+    uint32_t realMs;
+    uint32_t startEpoch;     ///< 0 if the clock was not set
+    EnergyCalibration calibration;
+    char name[24];
+};
+
+static size_t readCounts(const ExportSource& source, uint16_t first, uint32_t* out, size_t count) {
+    if (!source.saved) return exportSpectrum->read(first, out, count);
+    if (first >= source.channels) return 0;
+    if (count > (size_t)(source.channels - first)) count = source.channels - first;
+    memcpy(out, source.saved + first, count * sizeof(uint32_t));
+    return count;
+}
+
+/**
+ * @brief Writes an xs:duration with millisecond resolution, e.g. PT3600.250S.
+ */
+static void printDuration(ChunkWriter& out, uint32_t ms) {
+    out.printf("PT%lu.%03luS", (unsigned long)(ms / 1000), (unsigned long)(ms % 1000));
+}
+
+static void streamCsv(WebServer& server, const ExportSource& source) {
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN); // Chunked transfer encoding
+    server.send(200, "text/csv", "");
+
+    ChunkWriter out(server);
+    const EnergyCalibration& cal = source.calibration;
+    out.printf("# name,%s\n", source.name);
+    out.printf("# start_epoch,%lu\n", (unsigned long)source.startEpoch);
+    out.printf("# live_s,%.3f\n# real_s,%.3f\n", source.liveMs / 1000.0, source.realMs / 1000.0);
+    if (cal.valid()) out.printf("# calibration_keV,%.6g,%.6g,%.6g\n", cal.c0, cal.c1, cal.c2);
+    out.printf("channel,energy_keV,counts\n");
+
+    uint32_t counts[EXPORT_BATCH];
+    for (uint16_t first = 0; first < source.channels; first += EXPORT_BATCH) {
+        size_t n = readCounts(source, first, counts, EXPORT_BATCH);
+        for (size_t i = 0; i < n; i++) {
+            uint16_t channel = first + i;
+            if (cal.valid()) out.printf("%u,%.2f,%lu\n", channel, cal.energy(channel), (unsigned long)counts[i]);
+            else out.printf("%u,,%lu\n", channel, (unsigned long)counts[i]);
+        }
+        if (!server.client().connected()) return;
+    }
+    out.flush();
+    server.sendContent(""); // Terminating zero-length chunk
+}
+
+static void streamN42(WebServer& server, const ExportSource& source) {
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN); // Chunked transfer encoding
+    server.send(200, "application/xml", "");
+
+    ChunkWriter out(server);
+    const EnergyCalibration& cal = source.calibration;
+    out.printf("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+               "<RadInstrumentData xmlns=\"http://physics.nist.gov/N42/2011/N42\">\n");
+    out.printf("<RadInstrumentDataCreatorName>ESP32-S3 Radiation Detector</RadInstrumentDataCreatorName>\n");
+    out.printf("<RadInstrumentInformation id=\"RadInstrumentInformation-1\">\n"
+               " <RadInstrumentManufacturerName>Open source</RadInstrumentManufacturerName>\n");
+    out.printf(" <RadInstrumentModelName>ESP32-S3 Radiation Detector</RadInstrumentModelName>\n"
+               " <RadInstrumentClassCode>Spectroscopic Personal Radiation Detector</RadInstrumentClassCode>\n"
+               "</RadInstrumentInformation>\n");
+    out.printf("<RadDetectorInformation id=\"RadDetectorInformation-1\">\n"
+               " <RadDetectorCategoryCode>Gamma</RadDetectorCategoryCode>\n"
+               " <RadDetectorKindCode>CsI</RadDetectorKindCode>\n"
+               "</RadDetectorInformation>\n");
+    if (cal.valid()) {
+        out.printf("<EnergyCalibration id=\"EnergyCalibration-1\">\n"
+                   " <CoefficientValues>%.6g %.6g %.6g</CoefficientValues>\n"
+                   "</EnergyCalibration>\n", cal.c0, cal.c1, cal.c2);
+    }
+
+    out.printf("<RadMeasurement id=\"RadMeasurement-1\">\n <Remark>%s</Remark>\n", source.name);
+    out.printf(" <MeasurementClassCode>Foreground</MeasurementClassCode>\n");
+    if (source.startEpoch) {
+        time_t start = (time_t)source.startEpoch;
+        struct tm parts;
+        gmtime_r(&start, &parts);
+        char text[24];
+        strftime(text, sizeof(text), "%Y-%m-%dT%H:%M:%SZ", &parts);
+        out.printf(" <StartDateTime>%s</StartDateTime>\n", text);
+    }
+    out.printf(" <RealTimeDuration>");
+    printDuration(out, source.realMs);
+    out.printf("</RealTimeDuration>\n"
+               " <Spectrum id=\"Spectrum-1\" radDetectorInformationReference=\"RadDetectorInformation-1\"%s>\n",
+               cal.valid() ? " energyCalibrationReference=\"EnergyCalibration-1\"" : "");
+    out.printf("  <LiveTimeDuration>");
+    printDuration(out, source.liveMs);
+    out.printf("</LiveTimeDuration>\n  <ChannelData compressionCode=\"None\">");
+
+    uint32_t counts[EXPORT_BATCH];
+    for (uint16_t first = 0; first < source.channels; first += EXPORT_BATCH) {
+        size_t n = readCounts(source, first, counts, EXPORT_BATCH);
+        for (size_t i = 0; i < n; i++) {
+            // 16 counts per line keeps the document readable in an editor
+            out.printf("%s%lu", (first + i) % 16 ? " " : "\n", (unsigned long)counts[i]);
+        }
+        if (!server.client().connected()) return;
+    }
+    out.printf("\n  </ChannelData>\n </Spectrum>\n</RadMeasurement>\n</RadInstrumentData>\n");
+    out.flush();
+    server.sendContent(""); // Terminating zero-length chunk
+}
+
+static void streamBinary(WebServer& server, const ExportSource& source) {
+    SpectrumFileHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = SPECTRUM_FILE_MAGIC;
+    header.version = SPECTRUM_FILE_VERSION;
+    header.channels = source.channels;
+    header.flags = SPECTRUM_FILE_RAW_COUNTS;
+    header.headerSize = sizeof(header);
+    header.liveMs = source.liveMs;
+    header.realSeconds = source.realMs / 1000;
+    header.startEpoch = source.startEpoch;
+    header.calibration[0] = source.calibration.c0;
+    header.calibration[1] = source.calibration.c1;
+    header.calibration[2] = source.calibration.c2;
+    header.payloadBytes = source.channels * sizeof(uint32_t);
+    memcpy(header.name, source.name, sizeof(header.name));
+
+    uint32_t counts[EXPORT_BATCH];
+    for (uint16_t first = 0; first < source.channels; first += EXPORT_BATCH) {
+        size_t n = readCounts(source, first, counts, EXPORT_BATCH);
+        for (size_t i = 0; i < n; i++) header.total += counts[i];
+    }
+    // The live histogram changes under the body; only a saved one has a stable CRC
+    if (source.saved) header.payloadCrc = spectrumFileCrc((const uint8_t*)source.saved, header.payloadBytes);
+
+    server.setContentLength(sizeof(header) + header.payloadBytes);
+    server.send(200, "application/octet-stream", "");
+    server.sendContent((const char*)&header, sizeof(header));
+    for (uint16_t first = 0; first < source.channels; first += EXPORT_BATCH) {
+        size_t n = readCounts(source, first, counts, EXPORT_BATCH);
+        server.sendContent((const char*)counts, n * sizeof(uint32_t)); // Little-endian like the header
+        supervisorHeartbeat();
+        if (!server.client().connected()) return;
+    }
+}
+
+/**
+ * @brief Handles GET /api/spectrum.
+ */
+static void handleSpectrumRequest() {
+    WebServer& server = *exportServer;
+    if (!exportSpectrum->ready()) {
+        server.send(503, "text/plain", "Spectrum not allocated");
+        return;
+    }
+
+    ExportFormat format = EXPORT_FORMAT_CSV;
+    String formatArg = server.arg("format");
+    if (formatArg == "n42") format = EXPORT_FORMAT_N42;
+    else if (formatArg == "bin") format = EXPORT_FORMAT_BIN;
+    else if (formatArg.length() && formatArg != "csv") {
+        server.send(400, "text/plain", "format must be n42, csv or bin");
+        return;
+    }
+
+    ExportSource source;
+    memset(&source, 0, sizeof(source));
+    source.channels = exportSpectrum->channels();
+    uint32_t* saved = nullptr;
+    if (server.hasArg("name")) {
+        saved = (uint32_t*)heap_caps_malloc(source.channels * sizeof(uint32_t), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        if (!saved) {
+            server.send(503, "text/plain", "Out of memory");
+            return;
+        }
+        SpectrumFileHeader header;
+        if (!spectrumSessionReadSaved(server.arg("name").c_str(), &header, saved)) {
+            heap_caps_free(saved);
+            server.send(404, "text/plain", "Saved spectrum not found");
+            return;
+        }
+        source.saved = saved;
+        source.liveMs = header.liveMs;
+        source.realMs = header.realSeconds * 1000;
+        source.startEpoch = header.startEpoch;
+        source.calibration.c0 = header.calibration[0];
+        source.calibration.c1 = header.calibration[1];
+        source.calibration.c2 = header.calibration[2];
+        memcpy(source.name, header.name, sizeof(source.name));
+        source.name[sizeof(source.name) - 1] = '\0';
+    } else {
+        SpectrumSessionInfo info = getSpectrumSessionInfo();
+        source.liveMs = exportSpectrum->liveMs();
+        source.realMs = exportSpectrum->realMs();
+        source.startEpoch = info.active ? info.startEpoch : 0;
+        source.calibration = getEnergyCalibration();
+        strncpy(source.name, info.active && info.name[0] ? info.name : "live", sizeof(source.name) - 1);
+    }
+
+    static const char* suffixes[] = {"csv", "n42", "bin"};
+    String disposition = String("attachment; filename=\"") + source.name + "." + suffixes[format] + "\"";
+    server.sendHeader("Content-Disposition", disposition);
+    server.sendHeader("Cache-Control", "no-store");
+    server.sendHeader("Access-Control-Allow-Origin", "*");
+    if (format == EXPORT_FORMAT_N42) streamN42(server, source);
+    else if (format == EXPORT_FORMAT_BIN) streamBinary(server, source);
+    else streamCsv(server, source);
+    heap_caps_free(saved);
+}
+
+void spectrumExportAttach(WebServer& server, const Spectrum& spectrum) {
+    exportServer = &server;
+    exportSpectrum = &spectrum;
+    server.on("/api/spectrum", HTTP_GET, handleSpectrumRequest);
+}
@@ -0,0 +1,28 @@
+#ifndef SPECTRUM_EXPORT_H
+#define SPECTRUM_EXPORT_H
+
+#include <Arduino.h>
+#include <WebServer.h>
+#include "spectrum.h"
+
+// Spectrum download for analysis software.
+//
+// GET /api/spectrum?format=n42|csv|bin&name=<saved>
+//   name    a saved spectrum (spectrum_session.h); without it the histogram
+//           as it is accumulating now
+//   format  n42: ANSI N42.42-2011 XML (RadInstrumentData with one
+//             RadMeasurement), readable by InterSpec, BecqMoni and the like
+//           csv (default): '#' metadata lines, then channel,energy_keV,counts
+//           bin: SpectrumFileHeader with SPECTRUM_FILE_RAW_COUNTS, then one
+//             little-endian uint32 per channel (exact Content-Length)
+// Every format carries live and real time, the start time when the clock was
+// set and the energy calibration (c0 + c1*ch + c2*ch^2 keV) the counts were
+// taken with. Text is streamed with chunked transfer encoding; the live
+// histogram is read in small batches straight from PSRAM, so it is never
+// copied whole and keeps accumulating while the response goes out. A saved
+// spectrum is decoded into a PSRAM buffer held for the request.
+
+// Registers /api/spectrum on @p server, serving @p spectrum and the saved ones.
+void spectrumExportAttach(WebServer& server, const Spectrum& spectrum);
+
+#endif // SPECTRUM_EXPORT_H
@@ -0,0 +1,106 @@
+#ifndef SPECTRUM_FILE_H
+#define SPECTRUM_FILE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Compact on-disk format for saved spectra (*.rds).
+//   SpectrumFileHeader (72 bytes, little-endian)
+//   payload: one LEB128 varint per channel count
+// Most channels of a gamma spectrum hold fewer than 128 counts, so a 1024-channel
+// spectrum typically takes 1-2 KB instead of 4 KB. No Arduino dependencies
+// (host-compilable).
+
+static const uint32_t SPECTRUM_FILE_MAGIC   = 0x50534452; ///< "RDSP"
+static const uint16_t SPECTRUM_FILE_VERSION = 1;
+
+enum SpectrumFileFlags {
+    SPECTRUM_FILE_ACTIVE = 0x0001,     ///< Checkpoint of a session that was still running
+    SPECTRUM_FILE_RAW_COUNTS = 0x0002  ///< Payload is one little-endian uint32 per channel (/api/spectrum
+                                       ///< downloads, never stored); payloadCrc is 0 for the live histogram
+};
+
+struct SpectrumFileHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t channels;
+    uint16_t flags;          ///< SpectrumFileFlags
+    uint16_t headerSize;     ///< sizeof(SpectrumFileHeader), payload follows
+    uint32_t liveMs;         ///< Sampled time behind the counts
+    uint32_t realSeconds;    ///< Wall time the session was running
+    uint32_t startEpoch;     ///< Session start (UTC), 0 if the clock was not set
+    uint32_t total;          ///< Sum of all channels
+    float calibration[3];    ///< Energy calibration c0, c1, c2 at save time
+    uint32_t payloadBytes;
+    uint32_t payloadCrc;     ///< CRC-32 of the payload
+    char name[24];           ///< Session name, NUL-terminated
+};
+
+static_assert(sizeof(SpectrumFileHeader) == 72, "spectrum file header is stored on disk");
+
+/// Worst-case payload size for @p channels counts.
+inline size_t spectrumPayloadCapacity(size_t channels) { return channels * 5; }
+
+/**
+ * @brief Varint-encodes @p count channel counts into @p out.
+ * @return Bytes written, or 0 if @p capacity is too small
+ */
+inline size_t spectrumEncodeCounts(const uint32_t* counts, size_t count, uint8_t* out, size_t capacity) {
+    size_t pos = 0;
+    for (size_t i = 0; i < count; i++) {
+        uint32_t v = counts[i];
+        do {
+            if (pos >= capacity) return 0;
+            uint8_t byte = v & 0x7F;
+            v >>= 7;
+            out[pos++] = v ? (byte | 0x80) : byte;
+        } while (v);
+    }
+    return pos;
+}
+
+/**
+ * @brief Decodes exactly @p count varints from @p in.
+ * @return false on truncated or trailing data
+ */
+inline bool spectrumDecodeCounts(const uint8_t* in, size_t length, uint32_t* counts, size_t count) {
+    size_t pos = 0;
+    for (size_t i = 0; i < count; i++) {
+        uint32_t v = 0;
+        uint8_t shift = 0;
+        for (;;) {
+            if (pos >= length || shift > 28) return false;
+            uint8_t byte = in[pos++];
+            v |= (uint32_t)(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) break;
+            shift += 7;
+        }
+        counts[i] = v;
+    }
+    return pos == length;
+}
+
+/// CRC-32 (IEEE, reflected) of @p length bytes.
+inline uint32_t spectrumFileCrc(const uint8_t* data, size_t length) {
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (int b = 0; b < 8; b++) crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+    }
+    return ~crc;
+}
+
+/**
+ * @brief Background-subtracted counts: gross - background * liveMs / backgroundLiveMs, floored at 0.
+ */
+inline void spectrumSubtractBackground(uint32_t* counts, const uint32_t* background, size_t count,
+                                       uint32_t liveMs, uint32_t backgroundLiveMs) {
+    if (backgroundLiveMs == 0) return;
+    float scale = (float)liveMs / (float)backgroundLiveMs;
+    for (size_t i = 0; i < count; i++) {
+        float net = (float)counts[i] - (float)background[i] * scale;
+        counts[i] = net > 0.0f ? (uint32_t)(net + 0.5f) : 0;
+    }
+}
+
+#endif // SPECTRUM_FILE_H
@@ -0,0 +1,208 @@
+#ifndef SPECTRUM_FIT_H
+#define SPECTRUM_FIT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <math.h>
+
+// Energy calibration and single-peak fitting for pulse-height spectra.
+// No Arduino dependencies (host-compilable).
+
+/**
+ * @brief Quadratic channel -> energy calibration, E(keV) = c0 + c1*ch + c2*ch^2.
+ */
+struct EnergyCalibration {
+    float c0;
+    float c1;
+    float c2;
+
+    float energy(float channel) const { return c0 + (c1 + c2 * channel) * channel; }
+
+    /// Slope dE/dch at a channel (keV per channel).
+    float slope(float channel) const { return c1 + 2.0f * c2 * channel; }
+
+    /// Inverse mapping; negative if the energy is below the calibrated range.
+    float channel(float keV) const {
+        if (fabsf(c2) < 1e-9f) return c1 != 0.0f ? (keV - c0) / c1 : -1.0f;
+        // Root of c2*ch^2 + c1*ch + (c0 - E) on the increasing branch
+        float disc = c1 * c1 - 4.0f * c2 * (c0 - keV);
+        if (disc < 0.0f) return -1.0f;
+        return (-c1 + sqrtf(disc)) / (2.0f * c2);
+    }
+
+    bool valid() const { return c1 > 0.0f; }
+};
+
+/**
+ * @brief Result of a Gaussian-on-linear-background fit over a region of interest.
+ */
+struct PeakFit {
+    bool valid;          ///< Converged with a significant, physical peak
+    float centroid;      ///< Peak position in channels
+    float sigma;         ///< Gaussian width in channels
+    float amplitude;     ///< Peak height above background (counts per channel)
+    float background;    ///< Background level at the centroid (counts per channel)
+    float slope;         ///< Background slope (counts per channel per channel)
+    float netArea;       ///< Peak area above background (counts)
+    float netAreaError;  ///< 1-sigma uncertainty of netArea
+    float reducedChi2;   ///< Poisson-weighted chi^2 per degree of freedom
+};
+
+namespace spectrum_fit_detail {
+
+/// Solves the n x n system a*x = b in place (Gaussian elimination, partial pivoting).
+inline bool solve(double a[5][5], double b[5], int n) {
+    for (int col = 0; col < n; col++) {
+        int pivot = col;
+        for (int r = col + 1; r < n; r++) {
+            if (fabs(a[r][col]) > fabs(a[pivot][col])) pivot = r;
+        }
+        if (fabs(a[pivot][col]) < 1e-12) return false;
+        if (pivot != col) {
+            for (int c = 0; c < n; c++) {
+                double t = a[col][c]; a[col][c] = a[pivot][c]; a[pivot][c] = t;
+            }
+            double t = b[col]; b[col] = b[pivot]; b[pivot] = t;
+        }
+        for (int r = col + 1; r < n; r++) {
+            double f = a[r][col] / a[col][col];
+            for (int c = col; c < n; c++) a[r][c] -= f * a[col][c];
+            b[r] -= f * b[col];
+        }
+    }
+    for (int r = n - 1; r >= 0; r--) {
+        double s = b[r];
+        for (int c = r + 1; c < n; c++) s -= a[r][c] * b[c];
+        b[r] = s / a[r][r];
+    }
+    return true;
+}
+
+/// Poisson-weighted chi^2 of the model p = {A, mu, sigma, bg, slope} over [lo, hi].
+inline double chi2(const uint32_t* y, int lo, int hi, double x0, const double p[5]) {
+    double sum = 0.0;
+    for (int x = lo; x <= hi; x++) {
+        double d = (x - p[1]) / p[2];
+        double f = p[0] * exp(-0.5 * d * d) + p[3] + p[4] * (x - x0);
+        double r = (double)y[x] - f;
+        sum += r * r / (y[x] > 1 ? (double)y[x] : 1.0);
+    }
+    return sum;
+}
+
+} // namespace spectrum_fit_detail
+
+/**
+ * @brief Fits A*exp(-(x-mu)^2/2s^2) + bg + slope*(x-x0) to channels [lo, hi].
+ *
+ * Starts from a background line through the ROI edges and the moments of the
+ * net counts, then runs up to @p iterations Levenberg-Marquardt steps with
+ * Poisson weights. The ROI should span roughly +-4 sigma around the peak; wider
+ * fits and peaks below 3 sigma significance are reported as not valid.
+ */
+inline bool fitGaussianOnLinear(const uint32_t* counts, size_t channels, int lo, int hi,
+                                PeakFit* out, int iterations = 20) {
+    using namespace spectrum_fit_detail;
+    out->valid = false;
+    if (lo < 0) lo = 0;
+    if (hi >= (int)channels) hi = (int)channels - 1;
+    int n = hi - lo + 1;
+    if (n < 8) return false;
+
+    // Background line from the mean of three channels at each edge
+    double x0 = 0.5 * (lo + hi);
+    double left = (counts[lo] + counts[lo + 1] + counts[lo + 2]) / 3.0;
+    double right = (counts[hi] + counts[hi - 1] + counts[hi - 2]) / 3.0;
+    double bgSlope = (right - left) / (hi - lo - 2);
+    double bgLevel = 0.5 * (left + right);
+
+    // Moments of the background-subtracted counts
+    double sum = 0.0, first = 0.0, peak = 0.0;
+    for (int x = lo; x <= hi; x++) {
+        double net = counts[x] - (bgLevel + bgSlope * (x - x0));
+        if (net <= 0.0) continue;
+        sum += net;
+        first += net * x;
+        if (net > peak) peak = net;
+    }
+    if (sum <= 0.0) return false;
+    double mu = first / sum;
+    double second = 0.0;
+    for (int x = lo; x <= hi; x++) {
+        double net = counts[x] - (bgLevel + bgSlope * (x - x0));
+        if (net > 0.0) second += net * (x - mu) * (x - mu);
+    }
+    double sigma = sqrt(second / sum);
+    if (sigma < 0.5) sigma = 0.5;
+
+    double p[5] = {peak, mu, sigma, bgLevel, bgSlope};
+    double lambda = 1e-3;
+    double current = chi2(counts, lo, hi, x0, p);
+    for (int it = 0; it < iterations; it++) {
+        double jtj[5][5] = {{0}};
+        double jtr[5] = {0};
+        for (int x = lo; x <= hi; x++) {
+            double d = (x - p[1]) / p[2];
+            double g = exp(-0.5 * d * d);
+            double f = p[0] * g + p[3] + p[4] * (x - x0);
+            double w = 1.0 / (counts[x] > 1 ? (double)counts[x] : 1.0);
+            double j[5] = {g, p[0] * g * d / p[2], p[0] * g * d * d / p[2], 1.0, x - x0};
+            double r = (double)counts[x] - f;
+            for (int a = 0; a < 5; a++) {
+                jtr[a] += w * j[a] * r;
+                for (int b = 0; b <= a; b++) jtj[a][b] += w * j[a] * j[b];
+            }
+        }
+        for (int a = 0; a < 5; a++) {
+            for (int b = a + 1; b < 5; b++) jtj[a][b] = jtj[b][a];
+        }
+
+        double step[5][5];
+        double delta[5];
+        for (int a = 0; a < 5; a++) {
+            for (int b = 0; b < 5; b++) step[a][b] = jtj[a][b];
+            step[a][a] *= 1.0 + lambda;
+            delta[a] = jtr[a];
+        }
+        if (!solve(step, delta, 5)) break;
+
+        double trial[5];
+        for (int a = 0; a < 5; a++) trial[a] = p[a] + delta[a];
+        if (trial[2] < 0.3) trial[2] = 0.3;
+        double next = chi2(counts, lo, hi, x0, trial);
+        if (next < current) {
+            for (int a = 0; a < 5; a++) p[a] = trial[a];
+            bool converged = current - next < 1e-4 * current;
+            current = next;
+            lambda *= 0.1;
+            if (converged) break;
+        } else {
+            lambda *= 10.0;
+            if (lambda > 1e6) break;
+        }
+    }
+
+    double area = p[0] * p[2] * 2.5066282746; // sqrt(2*pi)
+    double bgUnder = 0.0;
+    for (int x = lo; x <= hi; x++) {
+        double b = p[3] + p[4] * (x - x0);
+        if (b > 0.0) bgUnder += b;
+    }
+    // Poisson error of the net area with the background estimated from the same ROI
+    double areaError = sqrt((area > 0.0 ? area : 0.0) + 2.0 * bgUnder);
+
+    out->centroid = (float)p[1];
+    out->sigma = (float)fabs(p[2]);
+    out->amplitude = (float)p[0];
+    out->background = (float)(p[3] + p[4] * (p[1] - x0));
+    out->slope = (float)p[4];
+    out->netArea = (float)area;
+    out->netAreaError = (float)areaError;
+    out->reducedChi2 = (float)(current / (n > 5 ? n - 5 : 1));
+    // A peak wider than a third of the ROI is indistinguishable from background curvature
+    out->valid = p[0] > 0.0 && p[1] >= lo && p[1] <= hi && fabs(p[2]) < n / 6.0 &&
+                 area > 3.0 * areaError;
+    return out->valid;
+}
+
+#endif // SPECTRUM_FIT_H
@@ -0,0 +1,57 @@
+#ifndef SPECTRUM_REBIN_H
+#define SPECTRUM_REBIN_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <math.h>
+
+// Display mapping of a pulse-height histogram onto a fixed number of columns.
+// No Arduino dependencies (host-compilable).
+
+/**
+ * @brief Min/max decimation of @p channels counts into @p columns columns.
+ *
+ * Column c covers channels [c*channels/columns, (c+1)*channels/columns). Keeping
+ * both extremes means a narrow peak never disappears between columns and the
+ * noise floor stays visible as the lower envelope.
+ */
+inline void spectrumRebinMinMax(const uint32_t* counts, size_t channels, size_t columns,
+                                uint32_t* colMin, uint32_t* colMax) {
+    for (size_t c = 0; c < columns; c++) {
+        size_t first = c * channels / columns;
+        size_t last = (c + 1) * channels / columns;
+        if (last <= first) last = first + 1;
+        uint32_t lo = counts[first], hi = counts[first];
+        for (size_t i = first + 1; i < last && i < channels; i++) {
+            if (counts[i] < lo) lo = counts[i];
+            if (counts[i] > hi) hi = counts[i];
+        }
+        colMin[c] = lo;
+        colMax[c] = hi;
+    }
+}
+
+/**
+ * @brief Full-scale value for a given peak: next power of two (>= 16).
+ *
+ * Rounding up means the axis, and with it every column, is rescaled only when
+ * the peak doubles, not on every update.
+ */
+inline uint32_t spectrumFullScale(uint32_t peak) {
+    uint32_t scale = 16;
+    while (scale < peak && scale < 0x80000000u) scale <<= 1;
+    return scale;
+}
+
+/**
+ * @brief Maps a count onto 0..range, linearly or as log10(1 + count).
+ */
+inline int32_t spectrumScale(uint32_t value, uint32_t fullScale, bool logScale, int32_t range) {
+    if (value >= fullScale) return range;
+    if (logScale) {
+        return (int32_t)(range * log10f(1.0f + value) / log10f(1.0f + fullScale) + 0.5f);
+    }
+    return (int32_t)(((uint64_t)value * range + fullScale / 2) / fullScale);
+}
+
+#endif // SPECTRUM_REBIN_H
@@ -0,0 +1,362 @@
+/**
+ * @file spectrum_session.cpp
+ * @brief Spectrum sessions: start/stop, saved spectra, checkpoints and background subtraction.
+ *
+ * Files are written as <path>.tmp and then renamed over <path>, so a reset in the
+ * middle of a save leaves either the previous file or the temporary one, never a
+ * half-written spectrum under the real name (the header CRC catches the rest).
+ * On the SD card every access holds the shared SPI bus (when the card is on it).
+ *
+ * The histogram itself stays lock-free: pulseTask is its only writer,
+ * and sessions only toggle accumulation and request clears that the writer
+ * applies between frames. The session mutex guards the session state and the
+ * copy/encode buffers shared by the UI task, the web task and the checkpoint task,
+ * and is held across file I/O. The background spectrum has its own mutex, held
+ * only for copies, so the plot's net readout never waits for a checkpoint write.
+ */
+
+#include "spectrum_session.h"
+#include "spectrum_file.h"
+#include "spectrum_analysis.h"
+#include "history_log.h"
+#include "debug.h"
+#include "time_base.h"
+#include <FS.h>
+#include <LittleFS.h>
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+static const char* CHECKPOINT_NAME = "active";
+
+static Spectrum* sessionSpectrum = nullptr;
+static fs::FS* sessionFs = nullptr;
+static SemaphoreHandle_t sessionMutex = nullptr;
+static SemaphoreHandle_t backgroundMutex = nullptr;
+static uint32_t* countsBuffer = nullptr;     ///< Histogram copy for saving and net readout
+static uint32_t* backgroundCounts = nullptr;
+static uint8_t* payloadBuffer = nullptr;
+static uint32_t realBaseSeconds = 0;         ///< Session wall time before the current boot/resume
+static uint32_t runningSinceMs = 0;
+static uint32_t lastCheckpointMs = 0;
+
+static SpectrumSessionInfo info;
+
+static void storageBegin() {
+    if (info.onSd) sdCardBegin();
+}
+
+static void storageEnd() {
+    if (info.onSd) sdCardEnd();
+}
+
+/**
+ * @brief Accepts 1-20 characters of [A-Za-z0-9_-]; the checkpoint name is reserved.
+ */
+static bool validName(const char* name) {
+    size_t length = strlen(name);
+    if (length == 0 || length > 20 || strcmp(name, CHECKPOINT_NAME) == 0) return false;
+    for (size_t i = 0; i < length; i++) {
+        char c = name[i];
+        if (!isalnum((unsigned char)c) && c != '-' && c != '_') return false;
+    }
+    return true;
+}
+
+static String spectrumPath(const char* name, const char* suffix = ".rds") {
+    return String(SPECTRUM_SESSION_DIR) + "/" + name + suffix;
+}
+
+static uint32_t sessionRealSeconds() {
+    if (!info.active) return realBaseSeconds;
+    return realBaseSeconds + (millis() - runningSinceMs) / 1000;
+}
+
+/**
+ * @brief Writes the current histogram to @p fileName.rds. Session mutex must be held.
+ */
+static bool writeSpectrumFile(const char* fileName, const char* sessionName, uint16_t flags) {
+    uint16_t channels = sessionSpectrum->channels();
+    size_t copied = sessionSpectrum->read(0, countsBuffer, channels);
+    size_t payload = spectrumEncodeCounts(countsBuffer, copied, payloadBuffer,
+                                          spectrumPayloadCapacity(channels));
+    if (copied != channels || payload == 0) return false;
+
+    SpectrumFileHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = SPECTRUM_FILE_MAGIC;
+    header.version = SPECTRUM_FILE_VERSION;
+    header.channels = channels;
+    header.flags = flags;
+    header.headerSize = sizeof(header);
+    header.liveMs = sessionSpectrum->liveMs();
+    header.realSeconds = sessionRealSeconds();
+    header.startEpoch = info.startEpoch;
+    for (size_t i = 0; i < copied; i++) header.total += countsBuffer[i];
+    EnergyCalibration cal = getEnergyCalibration();
+    header.calibration[0] = cal.c0;
+    header.calibration[1] = cal.c1;
+    header.calibration[2] = cal.c2;
+    header.payloadBytes = payload;
+    header.payloadCrc = spectrumFileCrc(payloadBuffer, payload);
+    strncpy(header.name, sessionName, sizeof(header.name) - 1);
+
+    String path = spectrumPath(fileName);
+    String tmpPath = spectrumPath(fileName, ".tmp");
+    storageBegin();
+    bool ok = false;
+    File file = sessionFs->open(tmpPath, FILE_WRITE);
+    if (file) {
+        ok = file.write((const uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+             file.write(payloadBuffer, payload) == payload;
+        file.close();
+    }
+    if (ok) {
+        // FAT cannot rename over an existing file
+        if (sessionFs->exists(path)) sessionFs->remove(path);
+        ok = sessionFs->rename(tmpPath, path);
+    }
+    storageEnd();
+    return ok;
+}
+
+/**
+ * @brief Reads and validates a spectrum file into @p counts. Session mutex must be held.
+ */
+static bool readSpectrumFile(const String& path, SpectrumFileHeader* header, uint32_t* counts) {
+    uint16_t channels = sessionSpectrum->channels();
+    storageBegin();
+    bool ok = false;
+    File file = sessionFs->open(path, FILE_READ);
+    if (file) {
+        ok = file.read((uint8_t*)header, sizeof(*header)) == sizeof(*header) &&
+             header->magic == SPECTRUM_FILE_MAGIC && header->version == SPECTRUM_FILE_VERSION &&
+             header->headerSize == sizeof(*header) && header->channels == channels &&
+             header->payloadBytes <= spectrumPayloadCapacity(channels) &&
+             file.read(payloadBuffer, header->payloadBytes) == header->payloadBytes;
+        file.close();
+    }
+    storageEnd();
+    return ok && spectrumFileCrc(payloadBuffer, header->payloadBytes) == header->payloadCrc &&
+           spectrumDecodeCounts(payloadBuffer, header->payloadBytes, counts, channels);
+}
+
+static void removeCheckpoint() {
+    storageBegin();
+    String path = spectrumPath(CHECKPOINT_NAME);
+    if (sessionFs->exists(path)) sessionFs->remove(path);
+    storageEnd();
+}
+
+/**
+ * @brief Resumes a session left running before the last reset. Session mutex must be held.
+ */
+static void resumeCheckpoint() {
+    SpectrumFileHeader header;
+    // A reset during a checkpoint write can leave only the temporary file
+    if (!readSpectrumFile(spectrumPath(CHECKPOINT_NAME), &header, countsBuffer) &&
+        !readSpectrumFile(spectrumPath(CHECKPOINT_NAME, ".tmp"), &header, countsBuffer)) {
+        return;
+    }
+    if (!(header.flags & SPECTRUM_FILE_ACTIVE) ||
+        !sessionSpectrum->restore(countsBuffer, header.channels, header.liveMs)) {
+        return;
+    }
+
+    header.name[sizeof(header.name) - 1] = '\0';
+    strncpy(info.name, header.name, sizeof(info.name) - 1);
+    info.active = true;
+    info.resumed = true;
+    info.startEpoch = header.startEpoch;
+    realBaseSeconds = header.realSeconds;
+    runningSinceMs = millis();
+    lastCheckpointMs = runningSinceMs;
+    DEBUG_PRINTF("Spectrum session: resumed '%s' (%lu counts, %lu s live)\n", info.name,
+                 (unsigned long)header.total, (unsigned long)(header.liveMs / 1000));
+}
+
+/**
+ * @brief Checkpoint task: saves a running session every SPECTRUM_CHECKPOINT_S.
+ */
+static void spectrumCheckpointTask(void* parameter) {
+    for (;;) {
+        vTaskDelay(pdMS_TO_TICKS(1000));
+        xSemaphoreTake(sessionMutex, portMAX_DELAY);
+        if (info.active && millis() - lastCheckpointMs >= SPECTRUM_CHECKPOINT_S * 1000UL) {
+            lastCheckpointMs = millis();
+            if (writeSpectrumFile(CHECKPOINT_NAME, info.name, SPECTRUM_FILE_ACTIVE)) {
+                info.checkpoints++;
+            } else {
+                DEBUG_PRINTLN("Spectrum session: checkpoint write failed");
+            }
+        }
+        xSemaphoreGive(sessionMutex);
+    }
+}
+
+bool initSpectrumSession(Spectrum& spectrum) {
+    if (sessionSpectrum) return true;
+    if (!spectrum.ready()) return false;
+
+    memset(&info, 0, sizeof(info));
+    uint16_t channels = spectrum.channels();
+    countsBuffer = (uint32_t*)heap_caps_malloc(channels * sizeof(uint32_t), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    backgroundCounts = (uint32_t*)heap_caps_malloc(channels * sizeof(uint32_t), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    payloadBuffer = (uint8_t*)heap_caps_malloc(spectrumPayloadCapacity(channels), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    sessionMutex = xSemaphoreCreateMutex();
+    backgroundMutex = xSemaphoreCreateMutex();
+    if (!countsBuffer || !backgroundCounts || !payloadBuffer || !sessionMutex || !backgroundMutex) return false;
+    sessionSpectrum = &spectrum;
+
+    // The history log mounts the card before this runs; fall back to internal flash
+    info.onSd = sdCardMounted();
+    if (info.onSd) {
+        sessionFs = &sdCardFs();
+    } else if (LittleFS.begin(true)) {
+        sessionFs = &LittleFS;
+    } else {
+        DEBUG_PRINTLN("Spectrum session: no storage");
+        return false;
+    }
+    storageBegin();
+    if (!sessionFs->exists(SPECTRUM_SESSION_DIR)) sessionFs->mkdir(SPECTRUM_SESSION_DIR);
+    storageEnd();
+    info.storage = true;
+
+    xSemaphoreTake(sessionMutex, portMAX_DELAY);
+    resumeCheckpoint();
+    xSemaphoreGive(sessionMutex);
+
+    xTaskCreatePinnedToCore(spectrumCheckpointTask, "SpectrumSave", 4096, NULL,
+                            tskIDLE_PRIORITY + 1, NULL, 0);
+    return true;
+}
+
+bool spectrumSessionStart(const char* name) {
+    if (!sessionSpectrum || !validName(name)) return false;
+
+    xSemaphoreTake(sessionMutex, portMAX_DELAY);
+    sessionSpectrum->clear();
+    sessionSpectrum->setAccumulating(true);
+    memset(info.name, 0, sizeof(info.name));
+    strncpy(info.name, name, sizeof(info.name) - 1);
+    info.active = true;
+    info.resumed = false;
+    info.startEpoch = timeBaseUtcSeconds(); // 0 while UTC is not known
+    realBaseSeconds = 0;
+    runningSinceMs = millis();
+    lastCheckpointMs = runningSinceMs;
+    xSemaphoreGive(sessionMutex);
+    return true;
+}
+
+bool spectrumSessionStop() {
+    if (!sessionSpectrum || !info.active) return false;
+
+    xSemaphoreTake(sessionMutex, portMAX_DELAY);
+    sessionSpectrum->setAccumulating(false);
+    realBaseSeconds = sessionRealSeconds();
+    info.active = false;
+    bool ok = info.storage && writeSpectrumFile(info.name, info.name, 0);
+    if (ok) removeCheckpoint();
+    xSemaphoreGive(sessionMutex);
+    return ok;
+}
+
+bool spectrumSessionSave(const char* name) {
+    if (!sessionSpectrum || !info.storage || !validName(name)) return false;
+
+    xSemaphoreTake(sessionMutex, portMAX_DELAY);
+    bool ok = writeSpectrumFile(name, name, 0);
+    xSemaphoreGive(sessionMutex);
+    return ok;
+}
+
+bool spectrumSessionLoadBackground(const char* name) {
+    if (!sessionSpectrum || !info.storage || !validName(name)) return false;
+
+    xSemaphoreTake(sessionMutex, portMAX_DELAY);
+    SpectrumFileHeader header;
+    bool ok = readSpectrumFile(spectrumPath(name), &header, countsBuffer) && header.liveMs > 0;
+    if (ok) {
+        xSemaphoreTake(backgroundMutex, portMAX_DELAY);
+        memcpy(backgroundCounts, countsBuffer, header.channels * sizeof(uint32_t));
+        memset(info.backgroundName, 0, sizeof(info.backgroundName));
+        strncpy(info.backgroundName, name, sizeof(info.backgroundName) - 1);
+        info.backgroundLiveMs = header.liveMs;
+        info.background = true;
+        xSemaphoreGive(backgroundMutex);
+    }
+    xSemaphoreGive(sessionMutex);
+    return ok;
+}
+
+bool spectrumSessionReadSaved(const char* name, SpectrumFileHeader* header, uint32_t* counts) {
+    if (!sessionSpectrum || !info.storage || !validName(name)) return false;
+
+    xSemaphoreTake(sessionMutex, portMAX_DELAY);
+    bool ok = readSpectrumFile(spectrumPath(name), header, countsBuffer);
+    if (ok) memcpy(counts, countsBuffer, header->channels * sizeof(uint32_t));
+    xSemaphoreGive(sessionMutex);
+    return ok;
+}
+
+void spectrumSessionClearBackground() {
+    if (!sessionSpectrum) return;
+    xSemaphoreTake(backgroundMutex, portMAX_DELAY);
+    info.background = false;
+    xSemaphoreGive(backgroundMutex);
+}
+
+size_t spectrumSessionReadNet(uint32_t* out, size_t count) {
+    if (!sessionSpectrum) return 0;
+    uint32_t liveMs = sessionSpectrum->liveMs();
+    size_t copied = sessionSpectrum->read(0, out, count);
+    xSemaphoreTake(backgroundMutex, portMAX_DELAY);
+    if (info.background) {
+        spectrumSubtractBackground(out, backgroundCounts, copied, liveMs, info.backgroundLiveMs);
+    }
+    xSemaphoreGive(backgroundMutex);
+    return copied;
+}
+
+SpectrumSessionInfo getSpectrumSessionInfo() {
+    SpectrumSessionInfo copy;
+    memset(&copy, 0, sizeof(copy));
+    if (!sessionSpectrum) return copy;
+    xSemaphoreTake(sessionMutex, portMAX_DELAY);
+    copy = info;
+    copy.liveMs = sessionSpectrum->liveMs();
+    copy.realSeconds = sessionRealSeconds();
+    xSemaphoreGive(sessionMutex);
+    return copy;
+}
+
+void listSpectrumSessions(Print& out) {
+    if (!sessionSpectrum || !info.storage) {
+        out.println("No spectrum storage");
+        return;
+    }
+
+    xSemaphoreTake(sessionMutex, portMAX_DELAY);
+    storageBegin();
+    File dir = sessionFs->open(SPECTRUM_SESSION_DIR);
+    File entry = dir ? dir.openNextFile() : File();
+    while (entry) {
+        SpectrumFileHeader header;
+        String fileName = entry.name();
+        if (fileName.endsWith(".rds") &&
+            entry.read((uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+            header.magic == SPECTRUM_FILE_MAGIC) {
+            header.name[sizeof(header.name) - 1] = '\0';
+            out.printf("  %-20s %8lu counts, %7lu s live%s\n", header.name, (unsigned long)header.total,
+                       (unsigned long)(header.liveMs / 1000),
+                       header.flags & SPECTRUM_FILE_ACTIVE ? " (checkpoint)" : "");
+        }
+        entry.close();
+        entry = dir.openNextFile();
+    }
+    if (dir) dir.close();
+    storageEnd();
+    xSemaphoreGive(sessionMutex);
+}
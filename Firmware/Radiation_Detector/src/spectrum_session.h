@@ -0,0 +1,64 @@
+#ifndef SPECTRUM_SESSION_H
+#define SPECTRUM_SESSION_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "spectrum.h"
+#include "spectrum_file.h"
+
+// Named spectrum acquisition sessions with persistent storage.
+// A session clears the histogram, accumulates until stopped and is then saved
+// as SPECTRUM_SESSION_DIR/<name>.rds (see spectrum_file.h). While it runs, a
+// checkpoint is written every SPECTRUM_CHECKPOINT_S and resumed on the next boot,
+// so an overnight background run survives a reset. Any saved spectrum can be
+// loaded as background; it is then subtracted, scaled by live time, from the
+// spectrum shown on screen.
+
+struct SpectrumSessionInfo {
+    bool storage;             ///< SD card or LittleFS available
+    bool onSd;                ///< Files go to the SD card
+    bool active;              ///< A named session is accumulating
+    char name[24];            ///< Current (or last) session name
+    uint32_t liveMs;          ///< Live time of the counts in the histogram
+    uint32_t realSeconds;     ///< Wall time of the session
+    uint32_t startEpoch;      ///< Session start (UTC), 0 if the clock was not set
+    uint32_t checkpoints;     ///< Checkpoints written since boot
+    bool resumed;             ///< The session was restored from a checkpoint at boot
+    bool background;          ///< A background spectrum is loaded
+    char backgroundName[24];
+    uint32_t backgroundLiveMs;
+};
+
+// Selects the storage and resumes a checkpointed session into @p spectrum.
+// Call after spectrum.begin() and before initSpectrumAdc().
+bool initSpectrumSession(Spectrum& spectrum);
+
+// Clears the histogram and starts accumulating a session called @p name
+// (letters, digits, '-' and '_').
+bool spectrumSessionStart(const char* name);
+
+// Pauses accumulation and saves the session under its name.
+bool spectrumSessionStop();
+
+// Saves the histogram as it is now under @p name without touching the session.
+bool spectrumSessionSave(const char* name);
+
+// Loads a saved spectrum as background for subtraction; false if missing or of
+// another channel count.
+bool spectrumSessionLoadBackground(const char* name);
+void spectrumSessionClearBackground();
+
+// Copies the histogram with the loaded background subtracted (gross counts if
+// none is loaded). Returns channels copied.
+size_t spectrumSessionReadNet(uint32_t* out, size_t count);
+
+// Reads the saved spectrum @p name into @p counts (channels() entries) and
+// its header; false if missing, damaged or of another channel count.
+bool spectrumSessionReadSaved(const char* name, SpectrumFileHeader* header, uint32_t* counts);
+
+SpectrumSessionInfo getSpectrumSessionInfo();
+
+// Prints the saved spectra with their live time and counts.
+void listSpectrumSessions(Print& out);
+
+#endif // SPECTRUM_SESSION_H
@@ -0,0 +1,50 @@
+#ifndef SPECTRUM_SOURCE_H
+#define SPECTRUM_SOURCE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Sample sources of the scintillation channel. The acquisition task
+// (spectrum_adc.cpp) only sees this interface: it reads blocks of unsigned
+// samples, shapes them and runs the pulse-height detector, whichever
+// converter they come from. SPECTRUM_SOURCE in config.h picks the backend:
+//  - ADC1 continuous mode (spectrum_source_adc1.cpp): the internal SAR ADC
+//    with DMA, ~80 kS/s, so the pulse must be stretched by a shaping
+//    amplifier ahead of it;
+//  - external parallel ADC (spectrum_source_cam.cpp): the LCD_CAM peripheral
+//    in camera mode clocks the converter and GDMA streams its words into a
+//    PSRAM ring, at MS/s rates, enough to sample the scintillator's pulse
+//    itself.
+// A source is started once and read by one task only.
+
+class SpectrumSource {
+public:
+    virtual ~SpectrumSource() {}
+    virtual const char* name() const = 0;
+
+    /// Configures the hardware and starts sampling; false if it could not.
+    virtual bool begin() = 0;
+
+    /// Samples per second, valid after begin().
+    virtual uint32_t sampleRate() const = 0;
+
+    /// Width of a sample; heights stay below 2^bits.
+    virtual uint8_t bits() const = 0;
+
+    /**
+     * @brief Blocks for the next samples.
+     * @param samples  Receives up to @p capacity samples, in order
+     * @param readUs   esp_timer time of the last sample returned, or of the
+     *                 read (never earlier than that sample) if the source cannot tell
+     * @param lost     Set when samples were dropped before these (overrun):
+     *                 the stream is not continuous with the previous read
+     * @return Samples written; 0 on a transient error
+     */
+    virtual size_t read(uint16_t* samples, size_t capacity, uint32_t* readUs, bool* lost) = 0;
+};
+
+// The backends (one instance each, started by initSpectrumAdc()).
+SpectrumSource& spectrumAdc1Source();
+SpectrumSource& spectrumCamSource();
+
+#endif // SPECTRUM_SOURCE_H
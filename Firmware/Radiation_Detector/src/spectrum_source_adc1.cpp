@@ -0,0 +1,96 @@
+/**
+ * @file spectrum_source_adc1.cpp
+ * @brief Spectrum samples from ADC1 in continuous (DMA) mode.
+ *
+ * The ADC DMA engine fills SPECTRUM_ADC_FRAME_BYTES frames at SPECTRUM_SAMPLE_RATE
+ * without CPU involvement. read() blocks on adc_digi_read_bytes() and unpacks
+ * the TYPE2 results of one frame into plain samples. The driver cannot tell
+ * when the frame's last sample was taken, so the read time stands in for it;
+ * the acquisition task smooths that into a sample clock.
+ */
+
+#include "spectrum_source.h"
+#include "config.h"
+#include "debug.h"
+#include <Arduino.h>
+#include "esp_timer.h"
+#include "driver/adc.h"
+#include "freertos/FreeRTOS.h"
+
+class Adc1Source : public SpectrumSource {
+public:
+    Adc1Source() : channel_(0) {}
+
+    const char* name() const override { return "ADC1"; }
+    uint32_t sampleRate() const override { return SPECTRUM_SAMPLE_RATE; }
+    uint8_t bits() const override { return 12; }
+
+    bool begin() override {
+        int8_t channel = digitalPinToAnalogChannel(SPECTRUM_ADC_PIN);
+        if (channel < 0 || channel >= SOC_ADC_CHANNEL_NUM(0)) {
+            DEBUG_PRINTLN("Spectrum: SPECTRUM_ADC_PIN is not an ADC1 pin");
+            return false;
+        }
+        channel_ = channel;
+
+        adc_digi_init_config_t init;
+        memset(&init, 0, sizeof(init));
+        init.max_store_buf_size = SPECTRUM_ADC_FRAME_BYTES * 4; // Driver ring: 4 frames of slack
+        init.conv_num_each_intr = SPECTRUM_ADC_FRAME_BYTES;
+        init.adc1_chan_mask = BIT(channel_);
+        init.adc2_chan_mask = 0;
+        if (adc_digi_initialize(&init) != ESP_OK) {
+            DEBUG_PRINTLN("Spectrum: ADC continuous mode init failed");
+            return false;
+        }
+
+        adc_digi_pattern_config_t pattern;
+        memset(&pattern, 0, sizeof(pattern));
+        pattern.atten = ADC_ATTEN_DB_11;
+        pattern.channel = channel_;
+        pattern.unit = 0; // ADC1
+        pattern.bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+
+        adc_digi_configuration_t config;
+        memset(&config, 0, sizeof(config));
+        config.conv_limit_en = false;
+        config.pattern_num = 1;
+        config.adc_pattern = &pattern;
+        config.sample_freq_hz = SPECTRUM_SAMPLE_RATE;
+        config.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+        config.format = ADC_DIGI_OUTPUT_FORMAT_TYPE2;
+        if (adc_digi_controller_configure(&config) != ESP_OK || adc_digi_start() != ESP_OK) {
+            DEBUG_PRINTLN("Spectrum: ADC continuous mode start failed");
+            adc_digi_deinitialize();
+            return false;
+        }
+        DEBUG_PRINTF("Spectrum: ADC1 channel %d at %u S/s\n", channel_, (unsigned)SPECTRUM_SAMPLE_RATE);
+        return true;
+    }
+
+    size_t read(uint16_t* samples, size_t capacity, uint32_t* readUs, bool* lost) override {
+        uint32_t length = 0;
+        esp_err_t err = adc_digi_read_bytes(frame_, sizeof(frame_), &length, portMAX_DELAY);
+        *readUs = (uint32_t)esp_timer_get_time();
+        // ESP_ERR_INVALID_STATE: the driver's ring overflowed, samples were lost
+        *lost = err == ESP_ERR_INVALID_STATE;
+        if (err != ESP_OK && !*lost) return 0;
+
+        size_t n = 0;
+        for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= length && n < capacity; i += SOC_ADC_DIGI_RESULT_BYTES) {
+            const adc_digi_output_data_t* out = (const adc_digi_output_data_t*)&frame_[i];
+            if (out->type2.unit != 0 || out->type2.channel != channel_) continue;
+            samples[n++] = out->type2.data;
+        }
+        return n;
+    }
+
+private:
+    uint8_t channel_;
+    uint8_t frame_[SPECTRUM_ADC_FRAME_BYTES];
+};
+
+SpectrumSource& spectrumAdc1Source() {
+    static Adc1Source source;
+    return source;
+}
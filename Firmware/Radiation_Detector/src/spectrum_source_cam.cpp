@@ -0,0 +1,244 @@
+/**
+ * @file spectrum_source_cam.cpp
+ * @brief Spectrum samples from an external parallel ADC through LCD_CAM camera mode.
+ *
+ * The camera half of the LCD_CAM peripheral drives the converter's clock out
+ * of SPECTRUM_CAM_CLK_PIN (160 MHz divided down) and latches a 16-bit word
+ * from the data lines on every PCLK edge. VSYNC, HSYNC and DE are tied high
+ * inside the GPIO matrix, so it never waits for a frame or a line and simply
+ * streams. GDMA writes the words into a circular chain of
+ * SPECTRUM_CAM_RING_NODES descriptors whose buffers sit in PSRAM; the camera
+ * raises an EOF after every node's worth of bytes (cam_rec_data_bytelen),
+ * and the EOF interrupt stamps the node's end time, counts it and wakes the
+ * reader.
+ *
+ * read() hands the oldest complete node out in pieces of at most the
+ * caller's capacity: the cache lines of the node are invalidated first (the
+ * DMA writes PSRAM behind the cache), then the samples are masked to
+ * SPECTRUM_CAM_BITS while they are copied into the caller's internal-RAM
+ * block. Each piece's time follows from the node's EOF stamp and the sample
+ * clock. The DMA never waits for the reader: if it laps the ring, the reader
+ * jumps to the newest complete node and reports the gap as lost.
+ */
+
+#include "spectrum_source.h"
+#include "config.h"
+#include "debug.h"
+#include <Arduino.h>
+#include <atomic>
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#if CONFIG_IDF_TARGET_ESP32S3
+#include "driver/gpio.h"
+#include "driver/periph_ctrl.h"
+#include "esp_private/gdma.h"
+#include "esp_rom_gpio.h"
+#include "esp32s3/rom/cache.h"
+#include "hal/dma_types.h"
+#include "soc/gpio_sig_map.h"
+#include "soc/lcd_cam_struct.h"
+#endif
+
+static_assert(SPECTRUM_CAM_BITS >= 8 && SPECTRUM_CAM_BITS <= 12,
+              "The shaper and the histogram take samples of 12 bits at most");
+
+static const size_t NODE_BYTES = 4032;  ///< Under the descriptor's 4095 B, a multiple of the 64 B PSRAM burst
+static const size_t NODE_SAMPLES = NODE_BYTES / sizeof(uint16_t);
+static const uint32_t CAM_CLOCK_HZ = 160000000;
+static const uint16_t SAMPLE_MASK = (1u << SPECTRUM_CAM_BITS) - 1;
+
+#ifndef GPIO_MATRIX_CONST_ONE_INPUT
+#define GPIO_MATRIX_CONST_ONE_INPUT 0x38
+#endif
+#ifndef GPIO_MATRIX_CONST_ZERO_INPUT
+#define GPIO_MATRIX_CONST_ZERO_INPUT 0x3C
+#endif
+
+class CamSource : public SpectrumSource {
+public:
+    CamSource() : rate_(SPECTRUM_CAM_SAMPLE_RATE), ring_(nullptr), consumed_(0), offset_(0), filled_(0) {}
+
+    const char* name() const override { return "external ADC"; }
+    uint32_t sampleRate() const override { return rate_; }
+    uint8_t bits() const override { return SPECTRUM_CAM_BITS; }
+
+#if CONFIG_IDF_TARGET_ESP32S3
+    bool begin() override {
+        static const int8_t dataPins[] = SPECTRUM_CAM_DATA_PINS;
+        static_assert(sizeof(dataPins) / sizeof(dataPins[0]) >= SPECTRUM_CAM_BITS,
+                      "SPECTRUM_CAM_DATA_PINS needs SPECTRUM_CAM_BITS pins");
+        bool pinsSet = SPECTRUM_CAM_CLK_PIN >= 0;
+        for (uint8_t i = 0; i < SPECTRUM_CAM_BITS; i++) pinsSet = pinsSet && dataPins[i] >= 0;
+        if (!pinsSet) {
+            DEBUG_PRINTLN("Spectrum: SPECTRUM_CAM_CLK_PIN / SPECTRUM_CAM_DATA_PINS not set");
+            return false;
+        }
+        uint32_t divider = (CAM_CLOCK_HZ + SPECTRUM_CAM_SAMPLE_RATE / 2) / SPECTRUM_CAM_SAMPLE_RATE;
+        if (divider < 2) divider = 2;
+        if (divider > 255) divider = 255;
+        rate_ = CAM_CLOCK_HZ / divider;
+
+        ring_ = (uint16_t*)heap_caps_aligned_alloc(64, SPECTRUM_CAM_RING_NODES * NODE_BYTES, MALLOC_CAP_SPIRAM);
+        // GDMA fetches descriptors over the internal bus only
+        descriptors_ = (dma_descriptor_t*)heap_caps_aligned_alloc(4, SPECTRUM_CAM_RING_NODES * sizeof(dma_descriptor_t),
+                                                                  MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+        ready_ = xSemaphoreCreateBinary();
+        if (!ring_ || !descriptors_ || !ready_) {
+            DEBUG_PRINTLN("Spectrum: no memory for the external ADC ring");
+            heap_caps_free(ring_);
+            heap_caps_free(descriptors_);
+            if (ready_) vSemaphoreDelete(ready_);
+            ring_ = nullptr;
+            return false;
+        }
+        for (size_t i = 0; i < SPECTRUM_CAM_RING_NODES; i++) {
+            dma_descriptor_t& d = descriptors_[i];
+            d.dw0.size = NODE_BYTES;
+            d.dw0.length = 0;
+            d.dw0.suc_eof = 0;
+            d.dw0.owner = DMA_DESCRIPTOR_BUFFER_OWNER_DMA;
+            d.buffer = (uint8_t*)ring_ + i * NODE_BYTES;
+            d.next = &descriptors_[(i + 1) % SPECTRUM_CAM_RING_NODES];
+        }
+
+        // Clock out; PCLK in from the converter, or the same pad read back
+        gpio_num_t clk = (gpio_num_t)SPECTRUM_CAM_CLK_PIN;
+        gpio_num_t pclk = (gpio_num_t)(SPECTRUM_CAM_PCLK_PIN >= 0 ? SPECTRUM_CAM_PCLK_PIN : SPECTRUM_CAM_CLK_PIN);
+        esp_rom_gpio_pad_select_gpio(clk);
+        gpio_set_direction(clk, pclk == clk ? GPIO_MODE_INPUT_OUTPUT : GPIO_MODE_OUTPUT);
+        esp_rom_gpio_connect_out_signal(clk, CAM_CLK_IDX, false, false);
+        if (pclk != clk) {
+            esp_rom_gpio_pad_select_gpio(pclk);
+            gpio_set_direction(pclk, GPIO_MODE_INPUT);
+        }
+        esp_rom_gpio_connect_in_signal(pclk, CAM_PCLK_IDX, false);
+        for (uint8_t i = 0; i < 16; i++) {
+            if (i < SPECTRUM_CAM_BITS) {
+                esp_rom_gpio_pad_select_gpio(dataPins[i]);
+                gpio_set_direction((gpio_num_t)dataPins[i], GPIO_MODE_INPUT);
+                esp_rom_gpio_connect_in_signal(dataPins[i], CAM_DATA_IN0_IDX + i, false);
+            } else {
+                esp_rom_gpio_connect_in_signal(GPIO_MATRIX_CONST_ZERO_INPUT, CAM_DATA_IN0_IDX + i, false);
+            }
+        }
+        // Free running: no frame or line framing, every PCLK latches a word
+        esp_rom_gpio_connect_in_signal(GPIO_MATRIX_CONST_ONE_INPUT, CAM_V_SYNC_IDX, false);
+        esp_rom_gpio_connect_in_signal(GPIO_MATRIX_CONST_ONE_INPUT, CAM_H_SYNC_IDX, false);
+        esp_rom_gpio_connect_in_signal(GPIO_MATRIX_CONST_ONE_INPUT, CAM_H_ENABLE_IDX, false);
+
+        periph_module_enable(PERIPH_LCD_CAM_MODULE);
+        LCD_CAM.cam_ctrl.val = 0;
+        LCD_CAM.cam_ctrl.cam_clk_sel = 3; // PLL 160 MHz
+        LCD_CAM.cam_ctrl.cam_clkm_div_num = divider;
+        LCD_CAM.cam_ctrl.cam_clkm_div_a = 0;
+        LCD_CAM.cam_ctrl.cam_clkm_div_b = 0;
+        LCD_CAM.cam_ctrl.cam_vs_eof_en = 0; // EOF every cam_rec_data_bytelen + 1 bytes, not on VSYNC
+        LCD_CAM.cam_ctrl1.val = 0;
+        LCD_CAM.cam_ctrl1.cam_2byte_en = 1;
+        LCD_CAM.cam_ctrl1.cam_clk_inv = SPECTRUM_CAM_PCLK_INVERT;
+        LCD_CAM.cam_ctrl1.cam_rec_data_bytelen = NODE_BYTES - 1;
+        LCD_CAM.cam_rgb_yuv.val = 0;
+        LCD_CAM.cam_ctrl.cam_update = 1;
+
+        gdma_channel_alloc_config_t alloc;
+        memset(&alloc, 0, sizeof(alloc));
+        alloc.direction = GDMA_CHANNEL_DIRECTION_RX;
+        if (gdma_new_channel(&alloc, &dma_) != ESP_OK) {
+            DEBUG_PRINTLN("Spectrum: no GDMA channel for the external ADC");
+            return false;
+        }
+        gdma_connect(dma_, GDMA_MAKE_TRIGGER(GDMA_TRIG_PERIPH_CAM, 0));
+        gdma_transfer_ability_t ability;
+        memset(&ability, 0, sizeof(ability));
+        ability.sram_trans_align = 4;
+        ability.psram_trans_align = 64;
+        gdma_set_transfer_ability(dma_, &ability);
+        gdma_rx_event_callbacks_t callbacks;
+        memset(&callbacks, 0, sizeof(callbacks));
+        callbacks.on_recv_eof = onRecvEof;
+        gdma_register_rx_event_callbacks(dma_, &callbacks, this);
+
+        // Camera and its FIFO from reset, DMA on the first node, then go
+        LCD_CAM.cam_ctrl1.cam_reset = 1;
+        LCD_CAM.cam_ctrl1.cam_reset = 0;
+        LCD_CAM.cam_ctrl1.cam_afifo_reset = 1;
+        LCD_CAM.cam_ctrl1.cam_afifo_reset = 0;
+        gdma_start(dma_, (intptr_t)descriptors_);
+        LCD_CAM.cam_ctrl.cam_update = 1;
+        LCD_CAM.cam_ctrl1.cam_start = 1;
+
+        DEBUG_PRINTF("Spectrum: external %u-bit ADC at %lu S/s, %u KB PSRAM ring\n", SPECTRUM_CAM_BITS,
+                     (unsigned long)rate_, (unsigned)(SPECTRUM_CAM_RING_NODES * NODE_BYTES / 1024));
+        return true;
+    }
+
+    size_t read(uint16_t* samples, size_t capacity, uint32_t* readUs, bool* lost) override {
+        *lost = false;
+        if (offset_ == 0) {
+            for (;;) {
+                uint32_t filled = filled_.load(std::memory_order_acquire);
+                if (filled - consumed_ >= SPECTRUM_CAM_RING_NODES) {
+                    // Lapped: the oldest nodes are being overwritten, take the newest
+                    consumed_ = filled - 1;
+                    *lost = true;
+                }
+                if (filled != consumed_) break;
+                xSemaphoreTake(ready_, portMAX_DELAY);
+            }
+            Cache_Invalidate_Addr((uint32_t)(ring_ + (consumed_ % SPECTRUM_CAM_RING_NODES) * NODE_SAMPLES), NODE_BYTES);
+        }
+
+        uint32_t node = consumed_ % SPECTRUM_CAM_RING_NODES;
+        const uint16_t* in = ring_ + node * NODE_SAMPLES + offset_;
+        size_t n = NODE_SAMPLES - offset_;
+        if (n > capacity) n = capacity;
+        for (size_t i = 0; i < n; i++) samples[i] = in[i] & SAMPLE_MASK;
+        offset_ += n;
+        *readUs = eofUs_[node] - (uint32_t)((uint64_t)(NODE_SAMPLES - offset_) * 1000000ULL / rate_);
+        if (offset_ == NODE_SAMPLES) {
+            offset_ = 0;
+            consumed_++;
+        }
+        return n;
+    }
+
+private:
+    static bool IRAM_ATTR onRecvEof(gdma_channel_handle_t channel, gdma_event_data_t* event, void* user) {
+        CamSource* self = (CamSource*)user;
+        uint32_t filled = self->filled_.load(std::memory_order_relaxed);
+        self->eofUs_[filled % SPECTRUM_CAM_RING_NODES] = (uint32_t)esp_timer_get_time();
+        self->filled_.store(filled + 1, std::memory_order_release);
+        BaseType_t woken = pdFALSE;
+        xSemaphoreGiveFromISR(self->ready_, &woken);
+        return woken == pdTRUE;
+    }
+
+    dma_descriptor_t* descriptors_ = nullptr;
+    gdma_channel_handle_t dma_ = nullptr;
+#else
+    bool begin() override {
+        DEBUG_PRINTLN("Spectrum: the external ADC needs the ESP32-S3 LCD_CAM peripheral");
+        return false;
+    }
+
+    size_t read(uint16_t* samples, size_t capacity, uint32_t* readUs, bool* lost) override {
+        return 0;
+    }
+
+private:
+#endif
+    uint32_t rate_;
+    uint16_t* ring_;                     ///< PSRAM, SPECTRUM_CAM_RING_NODES x NODE_SAMPLES
+    SemaphoreHandle_t ready_ = nullptr;  ///< Given by every EOF
+    uint32_t consumed_;                  ///< Nodes read completely (wraps)
+    size_t offset_;                      ///< Samples of the current node already read
+    std::atomic<uint32_t> filled_;       ///< Nodes completed by the DMA (wraps)
+    uint32_t eofUs_[SPECTRUM_CAM_RING_NODES];
+};
+
+SpectrumSource& spectrumCamSource() {
+    static CamSource source;
+    return source;
+}
@@ -0,0 +1,171 @@
+/**
+ * @file spectrum_view.cpp
+ * @brief Incremental spectrum rendering on an LVGL line chart.
+ *
+ * Pushing every histogram channel into the chart and refreshing it would redraw
+ * the whole 392x192 plot on each update. Instead the chart reads two external
+ * arrays (upper and lower envelope). An update rebins the histogram, writes only
+ * the columns whose scaled value changed and invalidates the strips covering
+ * them and their neighbours, since those line segments also move. LVGL then
+ * renders just those strips. A full refresh happens when the Y scale steps to
+ * the next power of two, when log scale is toggled and when the screen is entered.
+ */
+
+#include "config.h"
+
+#if !HEADLESS
+
+#include "spectrum_view.h"
+#include "spectrum_rebin.h"
+#include "spectrum_session.h"
+#include "config.h"
+#include <string.h>
+
+static const uint16_t VIEW_COLUMNS = SPECTRUM_VIEW_COLUMNS;
+static const int32_t  VIEW_Y_RANGE = 1000;
+
+static lv_obj_t* viewChart = nullptr;
+static const Spectrum* viewSpectrum = nullptr;
+static lv_chart_series_t* maxSeries = nullptr;
+static lv_chart_series_t* minSeries = nullptr;
+static lv_obj_t* annotationLabel = nullptr;
+static char annotationText[96] = "";
+
+static lv_coord_t maxPoints[VIEW_COLUMNS];
+static lv_coord_t minPoints[VIEW_COLUMNS];
+static uint32_t channelCounts[SPECTRUM_CHANNELS];
+static uint32_t columnMin[VIEW_COLUMNS];
+static uint32_t columnMax[VIEW_COLUMNS];
+
+static bool logScale = true;
+static bool fullRedraw = true;
+static bool wasVisible = false;
+static uint32_t shownScale = 0;
+static uint32_t shownTotal = UINT32_MAX;
+static uint32_t lastUpdateMs = 0;
+
+static void chartClickedCb(lv_event_t* e) {
+    spectrumViewSetLog(!logScale);
+}
+
+/**
+ * @brief Invalidates the strip drawn by columns [first, last] plus the segments to their neighbours.
+ */
+static void invalidateColumns(uint16_t first, uint16_t last) {
+    lv_area_t content;
+    lv_obj_get_content_coords(viewChart, &content);
+    int32_t w = lv_area_get_width(&content);
+
+    // Same x mapping as the LVGL line chart: x = x1 + w * i / (points - 1)
+    int32_t from = first > 0 ? first - 1 : 0;
+    int32_t to = last + 1 < VIEW_COLUMNS ? last + 1 : VIEW_COLUMNS - 1;
+    lv_area_t strip;
+    strip.x1 = content.x1 + w * from / (VIEW_COLUMNS - 1) - 2; // Line width margin
+    strip.x2 = content.x1 + w * to / (VIEW_COLUMNS - 1) + 2;
+    strip.y1 = content.y1 - 2;
+    strip.y2 = content.y2 + 2;
+    lv_obj_invalidate_area(viewChart, &strip);
+}
+
+void spectrumViewAttach(lv_obj_t* chart, const Spectrum* spectrum) {
+    viewChart = chart;
+    viewSpectrum = spectrum;
+    wasVisible = false;
+    if (!chart) {
+        // The chart's screen is being deleted: its series and label go with it
+        maxSeries = nullptr;
+        minSeries = nullptr;
+        annotationLabel = nullptr;
+        return;
+    }
+
+    // Reuse the SquareLine series as the upper envelope and add a dim lower one
+    maxSeries = lv_chart_get_series_next(chart, NULL);
+    if (!maxSeries) maxSeries = lv_chart_add_series(chart, lv_color_hex(0xDEF100), LV_CHART_AXIS_PRIMARY_Y);
+    minSeries = lv_chart_add_series(chart, lv_color_hex(0x5E6600), LV_CHART_AXIS_PRIMARY_Y);
+
+    memset(maxPoints, 0, sizeof(maxPoints));
+    memset(minPoints, 0, sizeof(minPoints));
+    lv_chart_set_point_count(chart, VIEW_COLUMNS);
+    lv_chart_set_ext_y_array(chart, maxSeries, maxPoints);
+    lv_chart_set_ext_y_array(chart, minSeries, minPoints);
+    lv_chart_set_range(chart, LV_CHART_AXIS_PRIMARY_Y, 0, VIEW_Y_RANGE);
+    lv_obj_set_style_size(chart, 0, LV_PART_INDICATOR); // No point markers on 196 points
+
+    lv_obj_add_flag(chart, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_add_event_cb(chart, chartClickedCb, LV_EVENT_CLICKED, NULL);
+
+    // SquareLine has no result label on this screen; overlay one on the plot
+    annotationLabel = lv_label_create(chart);
+    lv_obj_set_style_text_color(annotationLabel, lv_color_hex(0xDEF100), LV_PART_MAIN);
+    lv_obj_set_style_text_align(annotationLabel, LV_TEXT_ALIGN_RIGHT, LV_PART_MAIN);
+    lv_obj_align(annotationLabel, LV_ALIGN_TOP_RIGHT, 0, 0);
+    lv_obj_clear_flag(annotationLabel, LV_OBJ_FLAG_CLICKABLE);
+    lv_label_set_text_static(annotationLabel, annotationText);
+    fullRedraw = true;
+}
+
+void spectrumViewSetAnnotation(const char* text) {
+    if (!annotationLabel || strncmp(annotationText, text, sizeof(annotationText)) == 0) return;
+    strncpy(annotationText, text, sizeof(annotationText) - 1);
+    annotationText[sizeof(annotationText) - 1] = '\0';
+    lv_label_set_text_static(annotationLabel, annotationText);
+}
+
+void spectrumViewSetLog(bool enabled) {
+    logScale = enabled;
+    fullRedraw = true;
+}
+
+void spectrumViewUpdate(uint32_t nowMs) {
+    if (!viewChart || !viewSpectrum || !viewSpectrum->ready()) return;
+
+    bool visible = lv_obj_get_screen(viewChart) == lv_scr_act();
+    if (visible && !wasVisible) fullRedraw = true; // Entering the screen: start clean
+    wasVisible = visible;
+    if (!visible || nowMs - lastUpdateMs < SPECTRUM_VIEW_INTERVAL_MS) return;
+    lastUpdateMs = nowMs;
+
+    uint32_t total = viewSpectrum->total();
+    if (total == shownTotal && !fullRedraw) return; // No new pulses binned
+    shownTotal = total;
+
+    // Background-subtracted when a background spectrum is loaded
+    size_t channels = spectrumSessionReadNet(channelCounts, SPECTRUM_CHANNELS);
+    if (channels == 0) channels = viewSpectrum->read(0, channelCounts, SPECTRUM_CHANNELS); // No session storage
+    spectrumRebinMinMax(channelCounts, channels, VIEW_COLUMNS, columnMin, columnMax);
+
+    uint32_t peak = 0;
+    for (uint16_t c = 0; c < VIEW_COLUMNS; c++) {
+        if (columnMax[c] > peak) peak = columnMax[c];
+    }
+    uint32_t scale = spectrumFullScale(peak);
+    if (scale != shownScale) {
+        shownScale = scale;
+        fullRedraw = true;
+    }
+
+    int32_t runStart = -1;
+    for (uint16_t c = 0; c < VIEW_COLUMNS; c++) {
+        lv_coord_t hi = spectrumScale(columnMax[c], scale, logScale, VIEW_Y_RANGE);
+        lv_coord_t lo = spectrumScale(columnMin[c], scale, logScale, VIEW_Y_RANGE);
+        bool changed = hi != maxPoints[c] || lo != minPoints[c];
+        maxPoints[c] = hi;
+        minPoints[c] = lo;
+
+        // Coalesce neighbouring changed columns into one invalidated strip
+        if (changed && runStart < 0) runStart = c;
+        if (!changed && runStart >= 0) {
+            if (!fullRedraw) invalidateColumns(runStart, c - 1);
+            runStart = -1;
+        }
+    }
+    if (runStart >= 0 && !fullRedraw) invalidateColumns(runStart, VIEW_COLUMNS - 1);
+
+    if (fullRedraw) {
+        lv_chart_refresh(viewChart);
+        fullRedraw = false;
+    }
+}
+
+#endif // !HEADLESS
@@ -0,0 +1,28 @@
+#ifndef SPECTRUM_VIEW_H
+#define SPECTRUM_VIEW_H
+
+#include <lvgl.h>
+#include "spectrum.h"
+
+// Live spectrum plot on a line chart (ui_Chart4).
+// The histogram is rebinned into SPECTRUM_VIEW_COLUMNS columns with min/max
+// decimation and drawn as two series (upper and lower envelope) backed by
+// external arrays. Only the strips around columns whose value changed are
+// invalidated; the chart is fully refreshed only when the Y scale changes.
+
+// Binds the chart and the histogram. Tapping the chart toggles log scale.
+// Call with a NULL chart before the chart's screen is deleted; the annotation
+// text is kept and shown again on the next attach.
+void spectrumViewAttach(lv_obj_t* chart, const Spectrum* spectrum);
+
+// Redraws changed columns at most every SPECTRUM_VIEW_INTERVAL_MS while the
+// chart is on the active screen. Call from the UI task.
+void spectrumViewUpdate(uint32_t nowMs);
+
+void spectrumViewSetLog(bool logScale);
+
+// Sets the peak annotation shown in the chart's top-right corner (empty hides it).
+// The label is only touched when the text changes.
+void spectrumViewSetAnnotation(const char* text);
+
+#endif // SPECTRUM_VIEW_H
@@ -0,0 +1,232 @@
+/**
+ * @file spectrum_waterfall.cpp
+ * @brief PSRAM ring of spectrum slices shown as a scrolling canvas.
+ *
+ * A slice is the difference of two readings of the histogram, rebinned into
+ * SPECTRUM_WATERFALL_CHANNELS bins and saturated to 16 bits; a clear in
+ * between makes the new reading itself the difference. A row is rendered by
+ * turning the slice's bins into colours once and stretching them over the
+ * canvas width, so its cost is one bin lookup per pixel. The canvas buffer
+ * lives in PSRAM as well; LVGL still redraws the whole canvas area after a
+ * scroll, since every pixel of it moved, but it only copies the buffer.
+ */
+
+#include "config.h"
+
+#if !HEADLESS
+
+#include "spectrum_waterfall.h"
+#include "config.h"
+#include "esp_heap_caps.h"
+#include <math.h>
+#include <string.h>
+
+static const uint16_t BINS = SPECTRUM_WATERFALL_CHANNELS;
+static const uint16_t SLICES = SPECTRUM_WATERFALL_SLICES;
+static const uint16_t READ_CHUNK = 64;
+
+static const Spectrum* source = nullptr;
+static uint16_t* ring = nullptr;           ///< SLICES x BINS, PSRAM
+static uint16_t head = 0;                  ///< Next slice written
+static uint16_t slices = 0;
+static uint32_t lastBins[BINS];            ///< Histogram at the last slice, rebinned
+static bool primed = false;
+static uint32_t lastSliceMs = 0;
+
+static lv_obj_t* canvas = nullptr;
+static lv_color_t* canvasBuf = nullptr;    ///< PSRAM
+static uint16_t canvasW = 0;
+static uint16_t canvasH = 0;
+static bool shown = false;
+static bool fullRender = true;
+static uint32_t shownRecorded = 0;         ///< stats.recorded when the canvas was last drawn
+static lv_color_t palette[256];
+
+static SpectrumWaterfallStats stats;
+
+// Black, blue, magenta, orange, pale yellow
+static void buildPalette() {
+    static const uint8_t stops[5][3] = {{0, 0, 0}, {0, 0, 160}, {160, 0, 160}, {255, 160, 0}, {255, 255, 160}};
+    for (uint16_t i = 0; i < 256; i++) {
+        uint8_t s = i < 255 ? i / 64 : 3;
+        uint16_t t = i - s * 64; // 0..64 within the segment
+        uint8_t rgb[3];
+        for (uint8_t k = 0; k < 3; k++) rgb[k] = stops[s][k] + (stops[s + 1][k] - stops[s][k]) * t / 64;
+        palette[i] = lv_color_make(rgb[0], rgb[1], rgb[2]);
+    }
+}
+
+// 0 stays black; one count is dim blue and every doubling a fixed step up,
+// saturating above ~250 counts per channel and interval
+static uint8_t colourIndex(uint16_t count) {
+    if (count == 0) return 0;
+    float index = 48.0f + 26.0f * log2f((float)count);
+    return index >= 255.0f ? 255 : (uint8_t)index;
+}
+
+bool initSpectrumWaterfall(const Spectrum& spectrum) {
+    if (!spectrum.ready()) return false;
+    size_t bytes = (size_t)SLICES * BINS * sizeof(uint16_t);
+    ring = (uint16_t*)heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!ring) return false;
+    memset(ring, 0, bytes);
+    source = &spectrum;
+    buildPalette();
+    shown = SPECTRUM_WATERFALL_SHOWN;
+    stats.ready = true;
+    return true;
+}
+
+/**
+ * @brief Appends the counts gained since the previous call as a slice.
+ * @return false on the first call, which only takes the starting point
+ */
+static bool recordSlice() {
+    static uint32_t bins[BINS];
+    uint32_t chunk[READ_CHUNK];
+    uint16_t channels = source->channels();
+    memset(bins, 0, sizeof(bins));
+    for (uint16_t first = 0; first < channels; first += READ_CHUNK) {
+        size_t n = source->read(first, chunk, READ_CHUNK);
+        for (size_t i = 0; i < n; i++) bins[(uint32_t)(first + i) * BINS / channels] += chunk[i];
+    }
+
+    bool record = primed;
+    primed = true;
+    uint16_t* row = ring + (size_t)head * BINS;
+    for (uint16_t b = 0; b < BINS; b++) {
+        uint32_t delta = bins[b] >= lastBins[b] ? bins[b] - lastBins[b] : bins[b]; // Cleared meanwhile
+        if (record) row[b] = delta > 0xFFFF ? 0xFFFF : (uint16_t)delta;
+        lastBins[b] = bins[b];
+    }
+    if (!record) return false;
+    head = (head + 1) % SLICES;
+    if (slices < SLICES) slices++;
+    stats.recorded++;
+    return true;
+}
+
+/**
+ * @brief Renders canvas row @p y from the slice @p age intervals old (0: newest).
+ */
+static void renderRow(uint16_t y, uint16_t age) {
+    lv_color_t* out = canvasBuf + (size_t)y * canvasW;
+    if (age >= slices) {
+        for (uint16_t x = 0; x < canvasW; x++) out[x] = palette[0];
+        return;
+    }
+    const uint16_t* row = ring + (size_t)((head + SLICES - 1 - age) % SLICES) * BINS;
+    lv_color_t colours[BINS];
+    for (uint16_t b = 0; b < BINS; b++) colours[b] = palette[colourIndex(row[b])];
+    for (uint16_t x = 0; x < canvasW; x++) out[x] = colours[(uint32_t)x * BINS / canvasW];
+}
+
+static void drawAll() {
+    uint32_t start = micros();
+    for (uint16_t y = 0; y < canvasH; y++) renderRow(y, y);
+    lv_obj_invalidate(canvas);
+    stats.fullRenders++;
+    stats.fullRenderUs = micros() - start;
+}
+
+static void scrollOne() {
+    uint32_t start = micros();
+    memmove(canvasBuf + canvasW, canvasBuf, (size_t)(canvasH - 1) * canvasW * sizeof(lv_color_t));
+    renderRow(0, 0);
+    lv_obj_invalidate(canvas);
+    stats.scrolls++;
+    stats.scrollUs = micros() - start;
+}
+
+static void chartLongPressedCb(lv_event_t* e) {
+    spectrumWaterfallSetShown(!shown);
+}
+
+void spectrumWaterfallAttach(lv_obj_t* chart) {
+    if (!chart) {
+        // The chart's screen is being deleted; the canvas goes with it
+        if (canvas) lv_obj_add_flag(canvas, LV_OBJ_FLAG_HIDDEN);
+        canvas = nullptr;
+        heap_caps_free(canvasBuf);
+        canvasBuf = nullptr;
+        canvasW = canvasH = 0;
+        return;
+    }
+    if (!ring) return;
+
+    lv_obj_update_layout(chart);
+    lv_area_t content;
+    lv_obj_get_content_coords(chart, &content);
+    uint16_t w = lv_area_get_width(&content);
+    uint16_t h = lv_area_get_height(&content);
+    if (h > SLICES) h = SLICES;
+    canvasBuf = (lv_color_t*)heap_caps_malloc((size_t)w * h * sizeof(lv_color_t), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!canvasBuf) return;
+    canvasW = w;
+    canvasH = h;
+
+    canvas = lv_canvas_create(chart);
+    lv_canvas_set_buffer(canvas, canvasBuf, canvasW, canvasH, LV_IMG_CF_TRUE_COLOR);
+    lv_obj_set_pos(canvas, 0, 0);
+    lv_obj_clear_flag(canvas, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_move_to_index(canvas, 0); // Below the peak annotation
+    if (!shown) lv_obj_add_flag(canvas, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_add_event_cb(chart, chartLongPressedCb, LV_EVENT_LONG_PRESSED, NULL);
+    fullRender = true;
+}
+
+void spectrumWaterfallSetShown(bool enabled) {
+    shown = enabled;
+    fullRender = true;
+    if (!canvas) return;
+    if (shown) lv_obj_clear_flag(canvas, LV_OBJ_FLAG_HIDDEN);
+    else lv_obj_add_flag(canvas, LV_OBJ_FLAG_HIDDEN);
+}
+
+bool spectrumWaterfallShown() {
+    return shown;
+}
+
+void spectrumWaterfallUpdate(uint32_t nowMs) {
+    if (!ring) return;
+    if (nowMs - lastSliceMs >= SPECTRUM_WATERFALL_SLICE_MS) {
+        lastSliceMs = nowMs;
+        recordSlice();
+    }
+
+    if (!canvas || !shown || lv_obj_get_screen(canvas) != lv_scr_act()) {
+        fullRender = true; // Rows are missed while not shown
+        return;
+    }
+    if (fullRender || stats.recorded - shownRecorded > 1) {
+        drawAll();
+        fullRender = false;
+    } else if (stats.recorded != shownRecorded) {
+        scrollOne();
+    }
+    shownRecorded = stats.recorded;
+}
+
+SpectrumWaterfallStats getSpectrumWaterfallStats() {
+    SpectrumWaterfallStats s = stats;
+    s.slices = slices;
+    s.width = canvasW;
+    s.height = canvasH;
+    return s;
+}
+
+void printSpectrumWaterfall(Print& out) {
+    SpectrumWaterfallStats s = getSpectrumWaterfallStats();
+    if (!s.ready) {
+        out.println("Waterfall: not allocated");
+        return;
+    }
+    out.printf("Waterfall: %s, %u of %u slices of %u ms, %u channels, %lu recorded\n", shown ? "SHOWN" : "hidden",
+               (unsigned)s.slices, (unsigned)SLICES, (unsigned)SPECTRUM_WATERFALL_SLICE_MS, (unsigned)BINS,
+               (unsigned long)s.recorded);
+    out.printf("  canvas %ux%u, %lu scrolls (last %lu us), %lu full renders (last %lu us)\n", (unsigned)s.width,
+               (unsigned)s.height, (unsigned long)s.scrolls, (unsigned long)s.scrollUs,
+               (unsigned long)s.fullRenders, (unsigned long)s.fullRenderUs);
+}
+
+#endif // !HEADLESS
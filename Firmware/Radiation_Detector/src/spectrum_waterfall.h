@@ -0,0 +1,50 @@
+#ifndef SPECTRUM_WATERFALL_H
+#define SPECTRUM_WATERFALL_H
+
+#include <Arduino.h>
+#include <lvgl.h>
+#include "spectrum.h"
+
+// Spectrum waterfall on the spectrum screen: one row per interval, newest on
+// top, colour for the counts each channel gained in that interval.
+// The slices are kept in a PSRAM ring of SPECTRUM_WATERFALL_SLICES x
+// SPECTRUM_WATERFALL_CHANNELS counts, recorded whether or not the screen is
+// shown. The view is a canvas over the chart's plot area. A new slice moves
+// the canvas pixels down one row (memmove) and renders only the new top row;
+// the whole canvas is rendered from the ring only when the view is shown or
+// rows were missed meanwhile. The colour of a count does not depend on the
+// other rows (log scale, fixed range), so history never needs re-rendering.
+
+// Allocates the ring; slices are taken from @p spectrum. Call in setup()
+// after spectrum.begin().
+bool initSpectrumWaterfall(const Spectrum& spectrum);
+
+// Creates the (hidden) canvas over @p chart's plot area; a long press on the
+// chart switches between the line plot and the waterfall. Call with NULL
+// before the chart's screen is deleted. UI task.
+void spectrumWaterfallAttach(lv_obj_t* chart);
+
+// Records a slice every SPECTRUM_WATERFALL_SLICE_MS and, while the waterfall
+// is on the active screen, scrolls it. Call every uiTask pass.
+void spectrumWaterfallUpdate(uint32_t nowMs);
+
+// Shows the waterfall instead of the line plot (kept across screen builds).
+void spectrumWaterfallSetShown(bool shown);
+bool spectrumWaterfallShown();
+
+struct SpectrumWaterfallStats {
+    bool ready;
+    uint16_t slices;          ///< In the ring (up to SPECTRUM_WATERFALL_SLICES)
+    uint32_t recorded;        ///< Slices since boot
+    uint32_t scrolls;         ///< One-row updates
+    uint32_t fullRenders;     ///< Canvas rendered from the ring
+    uint32_t scrollUs;        ///< Last one-row update (memmove and row)
+    uint32_t fullRenderUs;    ///< Last full render
+    uint16_t width, height;   ///< Canvas, 0 while not attached
+};
+
+SpectrumWaterfallStats getSpectrumWaterfallStats();
+
+void printSpectrumWaterfall(Print& out);
+
+#endif // SPECTRUM_WATERFALL_H
@@ -0,0 +1,46 @@
+/**
+ * @file spi_bus.cpp
+ * @brief Mutex-based arbitration of the SPI bus shared by panel, touch and SD card.
+ *
+ * TFT_eSPI drives DMA through the IDF SPI master while touch and SD go through
+ * the Arduino SPIClass on the same host. Neither knows about the other, so a touch
+ * or SD transfer started during a display DMA would corrupt both. Clients take a
+ * recursive mutex; a non-display client additionally runs the display's release
+ * hook, which waits for the DMA and deasserts the panel's chip select.
+ */
+
+#include "spi_bus.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+static SemaphoreHandle_t busMutex = nullptr;
+static void (*displayReleaseHook)() = nullptr;
+
+void spiBusInit() {
+    if (!busMutex) {
+        busMutex = xSemaphoreCreateRecursiveMutex();
+    }
+}
+
+void spiBusSetDisplayReleaseHook(void (*hook)()) {
+    displayReleaseHook = hook;
+}
+
+void spiBusAcquire(SpiBusClient client) {
+    if (busMutex) {
+        xSemaphoreTakeRecursive(busMutex, portMAX_DELAY);
+    }
+    if (client != SPI_BUS_DISPLAY && displayReleaseHook) {
+        displayReleaseHook();
+    }
+}
+
+void spiBusRelease() {
+    if (busMutex) {
+        xSemaphoreGiveRecursive(busMutex);
+    }
+}
+
+SemaphoreHandle_t spiBusMutex() {
+    return busMutex;
+}
@@ -0,0 +1,37 @@
+#ifndef SPI_BUS_H
+#define SPI_BUS_H
+
+#include <Arduino.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+// Arbitration for the shared SPI2 bus (ST7796 panel, XPT2046 touch, microSD).
+// Every transfer runs between spiBusAcquire() and spiBusRelease(). The display
+// keeps its write transaction open across the DMA stripes of a refresh and
+// holds the bus meanwhile; the release hook, run for every other client, waits
+// for a queued touch set and closes a transaction left open by that same task.
+
+enum SpiBusClient {
+    SPI_BUS_DISPLAY = 0,
+    SPI_BUS_TOUCH,
+    SPI_BUS_SD,
+    SPI_BUS_CLIENT_COUNT
+};
+
+// Creates the bus mutex. Call once in setup() before any device is started.
+void spiBusInit();
+
+// Registers the display's hook that completes pending DMA and ends its transaction.
+void spiBusSetDisplayReleaseHook(void (*hook)());
+
+// Takes the bus for a client (recursive, blocks until available).
+void spiBusAcquire(SpiBusClient client);
+
+// Gives the bus back.
+void spiBusRelease();
+
+// The bus mutex, for the supervisor's check that a task it restarts does not
+// hold it (supervisor.h). nullptr before spiBusInit().
+SemaphoreHandle_t spiBusMutex();
+
+#endif // SPI_BUS_H
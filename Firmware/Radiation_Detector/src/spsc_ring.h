@@ -0,0 +1,77 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+/**
+ * @brief Lock-free single-producer / single-consumer ring buffer.
+ *
+ * One context (typically an ISR) calls push(), one task calls pop(). Indices are
+ * free-running 32-bit counters so "full" and "empty" never need a spare slot.
+ * The methods are forced inline so that an IRAM_ATTR caller keeps the whole
+ * push path in IRAM.
+ *
+ * @tparam T Element type (should be trivially copyable)
+ * @tparam N Capacity, must be a power of two
+ */
+template <typename T, size_t N>
+class SpscRing {
+    static_assert(N > 0 && (N & (N - 1)) == 0, "SpscRing capacity must be a power of two");
+
+public:
+    /// Producer side. Returns false (and counts a drop) if the ring is full.
+    inline __attribute__((always_inline)) bool push(const T& value) {
+        uint32_t head = head_.load(std::memory_order_relaxed);
+        uint32_t tail = tail_.load(std::memory_order_acquire);
+        if (head - tail >= N) {
+            dropped_.store(dropped_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return false;
+        }
+        buffer_[head & (N - 1)] = value;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Consumer side. Returns false if the ring is empty.
+    inline __attribute__((always_inline)) bool pop(T& out) {
+        uint32_t tail = tail_.load(std::memory_order_relaxed);
+        uint32_t head = head_.load(std::memory_order_acquire);
+        if (head == tail) {
+            return false;
+        }
+        out = buffer_[tail & (N - 1)];
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Consumer side. Copies the oldest element without removing it; false if empty.
+    inline bool peek(T& out) const {
+        uint32_t tail = tail_.load(std::memory_order_relaxed);
+        uint32_t head = head_.load(std::memory_order_acquire);
+        if (head == tail) {
+            return false;
+        }
+        out = buffer_[tail & (N - 1)];
+        return true;
+    }
+
+    /// Number of elements currently queued (approximate when called concurrently).
+    size_t size() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+
+    /// Number of elements rejected because the ring was full.
+    uint32_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+    static constexpr size_t capacity() { return N; }
+
+private:
+    T buffer_[N];
+    std::atomic<uint32_t> head_{0};
+    std::atomic<uint32_t> tail_{0};
+    std::atomic<uint32_t> dropped_{0};
+};
+
+#endif // SPSC_RING_H
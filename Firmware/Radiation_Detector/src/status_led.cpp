@@ -0,0 +1,169 @@
+/**
+ * @file status_led.cpp
+ * @brief Status LED frames from the timer service task, sent by RMT or LEDC.
+ *
+ * pulseTask only stores the alarm level, the rate fraction and the time of
+ * the last pulse in atomics. The timer callback renders a frame from them;
+ * if it differs from the last one sent, it is gamma-corrected and put into
+ * wire order by Adafruit_NeoPixel, then expanded into one rmt_item32_t per
+ * bit (24 per pixel, so one pixel fits the channel's 48-item block and the
+ * driver needs no refill interrupt) and started with rmt_write_items()
+ * without waiting. A frame that finds the previous one still on the wire
+ * (30 us per pixel, 25 fps) is skipped rather than waited for.
+ */
+
+#include "status_led.h"
+#include "led_pattern.h"
+#include "debug.h"
+#include <Adafruit_NeoPixel.h>
+#include <atomic>
+#include "driver/rmt.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/timers.h"
+
+static const rmt_channel_t LED_CHANNEL = (rmt_channel_t)STATUS_LED_RMT_CHANNEL;
+static const uint8_t LED_CLOCK_DIV = 8;                    ///< 80 MHz APB / 8: 100 ns per tick
+static const uint32_t PLAIN_PWM_HZ = 5000;
+static const uint8_t PLAIN_PWM_BITS = 8;
+static const size_t FRAME_ITEMS = STATUS_LED_COUNT * 24;
+
+static_assert(STATUS_LED_RMT_CHANNEL >= 0 && STATUS_LED_RMT_CHANNEL <= 3, "Transmit channels are 0-3 on the ESP32-S3");
+static_assert(STATUS_LED_COUNT >= 1 && STATUS_LED_COUNT <= 16, "STATUS_LED_COUNT out of range");
+
+// WS2812 bits: 0 is 0.4 us high and 0.85 us low, 1 is 0.8 us high and 0.45 us low
+static const rmt_item32_t BIT0 = {{{4, 1, 8, 0}}};
+static const rmt_item32_t BIT1 = {{{8, 1, 4, 0}}};
+
+// Pin -1: the library never touches the GPIO, it only formats the frame
+static Adafruit_NeoPixel pixels(STATUS_LED_COUNT, -1, STATUS_LED_ORDER + NEO_KHZ800);
+static rmt_item32_t items[FRAME_ITEMS];
+static TimerHandle_t frameTimer = nullptr;
+static uint8_t plainChannel = 0;
+static bool running = false;
+
+// Written by pulseTask (and the UI for the brightness), read by the timer callback
+static std::atomic<uint8_t> alarmLevel(ALARM_LEVEL_NONE);
+static std::atomic<float> rateFraction(0.0f);
+static std::atomic<bool> anomalyActive(false);
+static std::atomic<uint32_t> lastPulseMs(0);
+static std::atomic<bool> sawPulse(false);
+static std::atomic<uint8_t> brightness(STATUS_LED_BRIGHTNESS);
+
+// Timer service task only
+static LedColor lastSent = {0, 0, 0};
+static bool sentOnce = false;
+static uint32_t frames = 0;
+static uint32_t sent = 0;
+static uint32_t busy = 0;
+
+/**
+ * @brief Encodes @p color into every pixel and starts the transfer.
+ */
+static void sendNeoPixel(LedColor color) {
+    // The previous frame is still going out: skip this one, never wait
+    if (rmt_wait_tx_done(LED_CHANNEL, 0) != ESP_OK) {
+        busy++;
+        return;
+    }
+    uint32_t packed = Adafruit_NeoPixel::gamma32(Adafruit_NeoPixel::Color(color.r, color.g, color.b));
+    for (uint16_t i = 0; i < STATUS_LED_COUNT; i++) pixels.setPixelColor(i, packed);
+    const uint8_t* bytes = pixels.getPixels();
+    size_t n = 0;
+    for (size_t b = 0; b < STATUS_LED_COUNT * 3; b++) {
+        for (uint8_t bit = 0x80; bit; bit >>= 1) items[n++] = (bytes[b] & bit) ? BIT1 : BIT0;
+    }
+    if (rmt_write_items(LED_CHANNEL, items, n, false) == ESP_OK) {
+        lastSent = color;
+        sent++;
+    }
+}
+
+static void sendPlain(LedColor color) {
+    uint8_t level = Adafruit_NeoPixel::gamma8(color.level());
+    ledcWrite(plainChannel, level);
+    lastSent = color;
+    sent++;
+}
+
+static void frameCallback(TimerHandle_t timer) {
+    frames++;
+    uint32_t nowMs = millis();
+    LedPatternInput in;
+    in.alarmLevel = alarmLevel.load(std::memory_order_relaxed);
+    in.rateFraction = rateFraction.load(std::memory_order_relaxed);
+    in.anomaly = anomalyActive.load(std::memory_order_relaxed);
+    in.pulseAgeMs = sawPulse.load(std::memory_order_relaxed) ? nowMs - lastPulseMs.load(std::memory_order_relaxed)
+                                                              : UINT32_MAX;
+    LedColor color = ledScale(ledPatternFrame(in, nowMs), brightness.load(std::memory_order_relaxed) / 255.0f);
+    if (sentOnce && color == lastSent) return;
+    sentOnce = true;
+    if (STATUS_LED_TYPE == STATUS_LED_TYPE_PLAIN) sendPlain(color);
+    else sendNeoPixel(color);
+}
+
+bool initStatusLed(uint8_t ledcChannel) {
+    if (STATUS_LED_PIN < 0) return false;
+
+    if (STATUS_LED_TYPE == STATUS_LED_TYPE_PLAIN) {
+        plainChannel = ledcChannel;
+        ledcSetup(plainChannel, PLAIN_PWM_HZ, PLAIN_PWM_BITS);
+        ledcAttachPin(STATUS_LED_PIN, plainChannel);
+        ledcWrite(plainChannel, 0);
+    } else {
+        rmt_config_t config = RMT_DEFAULT_CONFIG_TX((gpio_num_t)STATUS_LED_PIN, LED_CHANNEL);
+        config.clk_div = LED_CLOCK_DIV;
+        config.mem_block_num = 1;
+        config.tx_config.idle_output_en = true;
+        config.tx_config.idle_level = RMT_IDLE_LEVEL_LOW;
+        // Installed from setup(): the end-of-frame interrupt lands on that core
+        esp_err_t err = rmt_config(&config);
+        if (err == ESP_OK) err = rmt_driver_install(LED_CHANNEL, 0, 0);
+        if (err != ESP_OK) {
+            DEBUG_PRINTF("Status LED: RMT channel %d not available (%d)\n", (int)LED_CHANNEL, err);
+            return false;
+        }
+    }
+
+    frameTimer = xTimerCreate("StatusLed", pdMS_TO_TICKS(STATUS_LED_FRAME_MS), pdTRUE, nullptr, frameCallback);
+    if (!frameTimer || xTimerStart(frameTimer, 0) != pdPASS) return false;
+    running = true;
+    return true;
+}
+
+void statusLedSetState(uint8_t level, float fraction, bool anomaly) {
+    alarmLevel.store(level, std::memory_order_relaxed);
+    rateFraction.store(fraction, std::memory_order_relaxed);
+    anomalyActive.store(anomaly, std::memory_order_relaxed);
+}
+
+void statusLedPulse() {
+    lastPulseMs.store(millis(), std::memory_order_relaxed);
+    sawPulse.store(true, std::memory_order_relaxed);
+}
+
+void statusLedSetBrightness(uint8_t value) {
+    brightness.store(value, std::memory_order_relaxed);
+}
+
+StatusLedStats getStatusLedStats() {
+    StatusLedStats s;
+    s.running = running;
+    s.frames = frames;
+    s.sent = sent;
+    s.busy = busy;
+    return s;
+}
+
+void printStatusLed(Print& out) {
+    if (!running) {
+        out.println("Status LED: not fitted (STATUS_LED_PIN)");
+        return;
+    }
+    StatusLedStats s = getStatusLedStats();
+    out.printf("Status LED: %s on GPIO %d, %u ms frames, brightness %u\n",
+               STATUS_LED_TYPE == STATUS_LED_TYPE_PLAIN ? "plain LED (LEDC)" : "NeoPixel (RMT)", STATUS_LED_PIN,
+               (unsigned)STATUS_LED_FRAME_MS, (unsigned)brightness.load());
+    out.printf("  %lu frames, %lu sent, %lu skipped while busy; alarm %s, rate %.3f of the warning threshold%s\n",
+               (unsigned long)s.frames, (unsigned long)s.sent, (unsigned long)s.busy, alarmLevelName(alarmLevel.load()),
+               rateFraction.load(), anomalyActive.load() ? ", anomaly" : "");
+}
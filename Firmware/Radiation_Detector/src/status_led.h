@@ -0,0 +1,52 @@
+#ifndef STATUS_LED_H
+#define STATUS_LED_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Rate- and alarm-coloured status LED ("led").
+// The frame is rendered by the patterns of led_pattern.h on a FreeRTOS
+// software timer every STATUS_LED_FRAME_MS, i.e. on the timer service task at
+// the lowest priority: no LED work ever runs on the UI task, and the buzzer
+// and HV timers on the esp_timer task are not delayed by it.
+// STATUS_LED_TYPE_NEOPIXEL: WS2812-type pixels on STATUS_LED_PIN. The bundled
+// Adafruit_NeoPixel only orders and gamma-corrects the colours; its show()
+// is not used, as it bit-bangs or blocks on ESP32 and picks RMT channels on
+// its own. Instead a changed frame is encoded once into RMT items and handed
+// to STATUS_LED_RMT_CHANNEL without waiting: the hardware clocks the bits out
+// with interrupts enabled, pulse capture and display DMA carry on, and
+// unchanged frames are not sent at all.
+// STATUS_LED_TYPE_PLAIN: a single-colour LED on an LEDC channel, driven with
+// the brightness of the same frames.
+
+enum StatusLedType {
+    STATUS_LED_TYPE_NEOPIXEL = 0,
+    STATUS_LED_TYPE_PLAIN
+};
+
+struct StatusLedStats {
+    bool running;
+    uint32_t frames;        ///< Timer ticks rendered
+    uint32_t sent;          ///< Changed frames transmitted
+    uint32_t busy;          ///< Frames skipped, the previous one still in the RMT
+};
+
+// Sets up the output (RMT channel or LEDC @p ledcChannel) and starts the
+// timer. false if STATUS_LED_PIN is -1 or the driver cannot be installed.
+bool initStatusLed(uint8_t ledcChannel);
+
+// pulseTask, once per closed second: alarm level, dose rate over the rate
+// warning threshold and whether a rate anomaly is active. Cheap, lock-free.
+void statusLedSetState(uint8_t alarmLevel, float rateFraction, bool anomaly);
+
+// pulseTask: a Geiger pulse was counted (a short tick on the LED).
+void statusLedPulse();
+
+// Overall brightness 0-255 (default STATUS_LED_BRIGHTNESS); 0 turns it off.
+void statusLedSetBrightness(uint8_t brightness);
+
+StatusLedStats getStatusLedStats();
+
+void printStatusLed(Print& out);
+
+#endif // STATUS_LED_H
@@ -0,0 +1,285 @@
+/**
+ * @file supervisor.cpp
+ * @brief Heartbeats, TWDT subscription, stalled-task restarts and the reset log.
+ *
+ * Slots are claimed under a spinlock; a task's heartbeat fields are written by
+ * that task only and read without a lock by the supervisor and the printers
+ * (single words; a histogram read mid-update is off by one count at most).
+ * Deleting a task that holds a mutex would leave the mutex taken for good,
+ * which is why a holder of a watched lock is never restarted.
+ */
+
+#include "supervisor.h"
+#include "dose_checkpoint.h"
+#include "time_base.h"
+#include "debug.h"
+#include <Preferences.h>
+#include "esp_task_wdt.h"
+#include "esp_system.h"
+#include "esp_attr.h"
+#include "esp_rom_crc.h"
+
+static const uint32_t SUPERVISOR_RTC_MAGIC = 0x50535452;   ///< "RTSP"
+static const uint8_t SUPERVISOR_MAX_LOCKS = 4;
+static const char* NVS_NAMESPACE = "supervisor";
+static const char* NVS_KEY_LOG = "resets";
+
+struct SupervisedTask {
+    char name[12];
+    TaskHandle_t handle;           ///< nullptr while being restarted
+    uint32_t stallMs;
+    SupervisorRestartFn restart;
+    volatile uint32_t lastBeatMs;
+    uint32_t beats;
+    uint32_t maxIntervalMs;
+    uint32_t histogram[SUPERVISOR_HISTOGRAM_BUCKETS];
+    uint16_t restarts;
+};
+
+/// Kept in RTC memory; survives soft resets, not power cycles
+struct SupervisorRtc {
+    uint32_t magic;
+    uint32_t uptimeSeconds;
+    char suspect[12];
+    uint32_t crc;
+};
+
+/// Stored as one NVS blob
+struct ResetLog {
+    uint32_t boots;
+    uint8_t head;                  ///< Next entry to write
+    uint8_t count;
+    uint8_t reserved[2];
+    SupervisorResetEntry entries[SUPERVISOR_RESET_LOG_SIZE];
+};
+
+RTC_NOINIT_ATTR static SupervisorRtc rtcRecord;
+
+static SupervisedTask tasks[SUPERVISOR_MAX_TASKS];
+static uint8_t taskCount = 0;
+static portMUX_TYPE slotMux = portMUX_INITIALIZER_UNLOCKED;
+static SemaphoreHandle_t watchedLocks[SUPERVISOR_MAX_LOCKS];
+static uint8_t lockCount = 0;
+static uint32_t restartCount = 0;
+static SupervisorResetEntry thisBoot;   ///< Reset that started this boot
+static bool logWritten = false;
+static ResetLog resetLog;               ///< Supervisor (loopTask) only after setup()
+
+static uint32_t rtcCrc(const SupervisorRtc& record) {
+    return esp_rom_crc32_le(0, (const uint8_t*)&record, offsetof(SupervisorRtc, crc));
+}
+
+static void rtcStore(uint32_t uptimeSeconds, const char* suspect) {
+    rtcRecord.magic = SUPERVISOR_RTC_MAGIC;
+    rtcRecord.uptimeSeconds = uptimeSeconds;
+    if (suspect) strlcpy(rtcRecord.suspect, suspect, sizeof(rtcRecord.suspect));
+    rtcRecord.crc = rtcCrc(rtcRecord);
+}
+
+static SupervisedTask* slotOf(TaskHandle_t handle) {
+    for (uint8_t i = 0; i < taskCount; i++) {
+        if (tasks[i].handle == handle) return &tasks[i];
+    }
+    return nullptr;
+}
+
+bool initSupervisor() {
+    memset(&thisBoot, 0, sizeof(thisBoot));
+    esp_reset_reason_t reason = esp_reset_reason();
+    thisBoot.reason = (uint8_t)reason;
+    bool softReset = reason != ESP_RST_POWERON && reason != ESP_RST_BROWNOUT && reason != ESP_RST_UNKNOWN;
+    if (softReset && rtcRecord.magic == SUPERVISOR_RTC_MAGIC && rtcRecord.crc == rtcCrc(rtcRecord)) {
+        thisBoot.uptimeSeconds = rtcRecord.uptimeSeconds;
+        strlcpy(thisBoot.suspect, rtcRecord.suspect, sizeof(thisBoot.suspect));
+    }
+    rtcRecord.suspect[0] = '\0';
+    rtcStore(0, nullptr);
+
+    // Reconfigures the TWDT the core already started (idle task of core 0)
+    if (esp_task_wdt_init(SUPERVISOR_WDT_TIMEOUT_S, true) != ESP_OK) {
+        DEBUG_PRINTLN("Supervisor: TWDT not configured");
+        return false;
+    }
+    if (thisBoot.suspect[0]) {
+        DEBUG_PRINTF("Supervisor: previous boot ended (%s) after %s stalled\n",
+                     resetReasonName(thisBoot.reason), thisBoot.suspect);
+    }
+    return true;
+}
+
+bool supervisorAttach(const char* name, uint32_t stallMs, SupervisorRestartFn restart) {
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    SupervisedTask* slot = nullptr;
+    portENTER_CRITICAL(&slotMux);
+    for (uint8_t i = 0; i < taskCount && !slot; i++) {
+        if (strncmp(tasks[i].name, name, sizeof(tasks[i].name) - 1) == 0) slot = &tasks[i];
+    }
+    if (!slot && taskCount < SUPERVISOR_MAX_TASKS) {
+        slot = &tasks[taskCount++];
+        memset(slot, 0, sizeof(*slot));
+        strlcpy(slot->name, name, sizeof(slot->name));
+    }
+    if (slot) {
+        slot->stallMs = stallMs;
+        slot->restart = restart;
+        slot->lastBeatMs = millis();
+        slot->handle = self;
+    }
+    portEXIT_CRITICAL(&slotMux);
+    if (!slot) return false;
+    return esp_task_wdt_add(self) == ESP_OK;
+}
+
+void supervisorHeartbeat() {
+    SupervisedTask* slot = slotOf(xTaskGetCurrentTaskHandle());
+    if (!slot) return;
+    esp_task_wdt_reset();
+
+    uint32_t now = millis();
+    uint32_t interval = now - slot->lastBeatMs;
+    slot->lastBeatMs = now;
+    uint8_t bucket = 31 - __builtin_clz(interval | 1);
+    if (bucket >= SUPERVISOR_HISTOGRAM_BUCKETS) bucket = SUPERVISOR_HISTOGRAM_BUCKETS - 1;
+    slot->histogram[bucket]++;
+    slot->beats++;
+    if (interval > slot->maxIntervalMs) slot->maxIntervalMs = interval;
+}
+
+void supervisorWatchLock(SemaphoreHandle_t lock) {
+    if (lock && lockCount < SUPERVISOR_MAX_LOCKS) watchedLocks[lockCount++] = lock;
+}
+
+static bool holdsWatchedLock(TaskHandle_t task) {
+    for (uint8_t i = 0; i < lockCount; i++) {
+        if (xSemaphoreGetMutexHolder(watchedLocks[i]) == task) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Checkpoints the dose (unless a stalled task may still hold the chart
+ *        lock it needs) and restarts the chip.
+ */
+static void rebootFor(const char* name) {
+    DEBUG_PRINTF("Supervisor: %s stalled, rebooting\n", name);
+    rtcStore(timeBaseSeconds(), name);
+    bool locksFree = true;
+    for (uint8_t i = 0; i < lockCount; i++) {
+        if (xSemaphoreGetMutexHolder(watchedLocks[i]) != nullptr) locksFree = false;
+    }
+    if (locksFree) doseCheckpointSave();
+    debugLogFlush(200); // The reboot message above
+    ESP.restart();
+}
+
+static void checkTasks(uint32_t nowMs) {
+    for (uint8_t i = 0; i < taskCount; i++) {
+        SupervisedTask& slot = tasks[i];
+        TaskHandle_t handle = slot.handle;
+        if (!handle || !slot.stallMs || nowMs - slot.lastBeatMs < slot.stallMs) continue;
+
+        rtcStore(timeBaseSeconds(), slot.name);
+        if (!slot.restart || slot.restarts >= SUPERVISOR_MAX_RESTARTS || holdsWatchedLock(handle)) {
+            rebootFor(slot.name);
+        }
+        DEBUG_PRINTF("Supervisor: %s stalled for %lu ms, restarting it\n", slot.name,
+                     (unsigned long)(nowMs - slot.lastBeatMs));
+        esp_task_wdt_delete(handle);
+        portENTER_CRITICAL(&slotMux);
+        slot.handle = nullptr;
+        portEXIT_CRITICAL(&slotMux);
+        slot.restarts++;
+        restartCount++;
+        if (!slot.restart()) rebootFor(slot.name);
+        // The restarted task attaches again; until then the slot is not checked
+        rtcStore(timeBaseSeconds(), "");
+    }
+}
+
+static void writeResetLog() {
+    Preferences prefs;
+    if (!prefs.begin(NVS_NAMESPACE, false)) return;
+    memset(&resetLog, 0, sizeof(resetLog));
+    if (prefs.getBytesLength(NVS_KEY_LOG) == sizeof(resetLog)) prefs.getBytes(NVS_KEY_LOG, &resetLog, sizeof(resetLog));
+    if (resetLog.head >= SUPERVISOR_RESET_LOG_SIZE) memset(&resetLog, 0, sizeof(resetLog));
+    resetLog.boots++;
+    resetLog.entries[resetLog.head] = thisBoot;
+    resetLog.head = (resetLog.head + 1) % SUPERVISOR_RESET_LOG_SIZE;
+    if (resetLog.count < SUPERVISOR_RESET_LOG_SIZE) resetLog.count++;
+    prefs.putBytes(NVS_KEY_LOG, &resetLog, sizeof(resetLog));
+    prefs.end();
+}
+
+void supervisorLoop(uint32_t nowMs) {
+    // loopTask supervises the others; the TWDT supervises it
+    static bool attached = false;
+    if (!attached) attached = supervisorAttach("supervisor", 0, nullptr);
+    supervisorHeartbeat();
+
+    // Off the boot path: the NVS write waits for the first pass after setup()
+    if (!logWritten) {
+        logWritten = true;
+        writeResetLog();
+    }
+    checkTasks(nowMs);
+    rtcStore(timeBaseSeconds(), nullptr);
+}
+
+uint32_t supervisorRestarts() {
+    return restartCount;
+}
+
+size_t getSupervisorResetLog(SupervisorResetEntry* out, size_t maxEntries) {
+    size_t n = resetLog.count < maxEntries ? resetLog.count : maxEntries;
+    size_t start = (resetLog.head + SUPERVISOR_RESET_LOG_SIZE - resetLog.count) % SUPERVISOR_RESET_LOG_SIZE;
+    for (size_t i = 0; i < n; i++) {
+        out[i] = resetLog.entries[(start + resetLog.count - n + i) % SUPERVISOR_RESET_LOG_SIZE];
+    }
+    return n;
+}
+
+const char* resetReasonName(uint8_t reason) {
+    switch (reason) {
+        case ESP_RST_POWERON:   return "power-on";
+        case ESP_RST_EXT:       return "external";
+        case ESP_RST_SW:        return "software";
+        case ESP_RST_PANIC:     return "panic";
+        case ESP_RST_INT_WDT:   return "interrupt watchdog";
+        case ESP_RST_TASK_WDT:  return "task watchdog";
+        case ESP_RST_WDT:       return "watchdog";
+        case ESP_RST_DEEPSLEEP: return "deep sleep";
+        case ESP_RST_BROWNOUT:  return "brownout";
+        case ESP_RST_SDIO:      return "SDIO";
+        default:                return "unknown";
+    }
+}
+
+void printSupervisor(Print& out) {
+    out.printf("Supervisor: TWDT %u s, %lu subsystem restarts\n", (unsigned)SUPERVISOR_WDT_TIMEOUT_S,
+               (unsigned long)restartCount);
+    for (uint8_t i = 0; i < taskCount; i++) {
+        const SupervisedTask& slot = tasks[i];
+        out.printf("  %-11s stall %5lu ms, %lu beats, max %lu ms, %u restarts\n    ", slot.name,
+                   (unsigned long)slot.stallMs, (unsigned long)slot.beats, (unsigned long)slot.maxIntervalMs,
+                   slot.restarts);
+        // Only the populated range of the histogram
+        int8_t last = -1;
+        for (uint8_t b = 0; b < SUPERVISOR_HISTOGRAM_BUCKETS; b++) {
+            if (slot.histogram[b]) last = (int8_t)b;
+        }
+        for (int8_t b = 0; b <= last; b++) {
+            out.printf("<%lu:%lu ", 2UL << b, (unsigned long)slot.histogram[b]);
+        }
+        out.println(last < 0 ? "no heartbeats" : "ms");
+    }
+
+    SupervisorResetEntry entries[SUPERVISOR_RESET_LOG_SIZE];
+    size_t n = getSupervisorResetLog(entries, SUPERVISOR_RESET_LOG_SIZE);
+    out.printf("Resets (%lu boots logged, newest last):\n", (unsigned long)resetLog.boots);
+    for (size_t i = 0; i < n; i++) {
+        out.printf("  %-18s", resetReasonName(entries[i].reason));
+        if (entries[i].uptimeSeconds) out.printf(" after %lu s", (unsigned long)entries[i].uptimeSeconds);
+        if (entries[i].suspect[0]) out.printf(", stalled: %s", entries[i].suspect);
+        out.println();
+    }
+}
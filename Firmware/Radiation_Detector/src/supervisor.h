@@ -0,0 +1,74 @@
+#ifndef SUPERVISOR_H
+#define SUPERVISOR_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+// Task supervision on top of the task watchdog (TWDT).
+// pulseTask, uiTask and the web task attach themselves: each is subscribed to
+// the TWDT and feeds it with a heartbeat per loop pass, and the interval
+// between heartbeats goes into a log2 latency histogram per task. The
+// supervisor (Arduino's loopTask, which had nothing to do) checks the tasks
+// every SUPERVISOR_INTERVAL_MS:
+//  - a task without a heartbeat for its stall limit is restarted through its
+//    restart function (web server, UI), while pulseTask keeps counting;
+//  - a task that cannot be restarted safely (it holds one of the watched
+//    locks, it has no restart function, or it stalled SUPERVISOR_MAX_RESTARTS
+//    times) gets the device rebooted after a dose checkpoint;
+//  - if the supervisor itself hangs, the TWDT resets the chip after
+//    SUPERVISOR_WDT_TIMEOUT_S.
+// The task that was stalled and the uptime are kept in RTC memory; at the
+// next boot they are added to a reset log in NVS together with the reset
+// reason, so an unattended unit's resets can be read out later ("supervisor").
+
+static const uint8_t SUPERVISOR_MAX_TASKS = 6;
+static const uint8_t SUPERVISOR_HISTOGRAM_BUCKETS = 16;  ///< Bucket b: intervals below 2^(b+1) ms
+static const uint8_t SUPERVISOR_RESET_LOG_SIZE = 8;
+
+// Restarts a stalled task (runs on the supervisor). The supervisor has already
+// unsubscribed it from the TWDT; the new task attaches again under the same
+// name. @return false if the task cannot be restarted now (reboot instead)
+typedef bool (*SupervisorRestartFn)();
+
+struct SupervisorResetEntry {
+    uint8_t reason;          ///< esp_reset_reason_t
+    uint8_t reserved[3];
+    uint32_t uptimeSeconds;  ///< Of the boot that ended, 0 if unknown (power cycle)
+    char suspect[12];        ///< Task that had stalled before it ended, "" if none
+};
+
+// Configures the TWDT and reads the previous boot's RTC record. Call in setup()
+// before the supervised tasks are created.
+bool initSupervisor();
+
+// Subscribes the calling task to the TWDT and to stall supervision. A task
+// restarted under the same @p name keeps its slot and statistics.
+// @p stallMs 0: TWDT only. @p restart nullptr: a stall reboots the device
+bool supervisorAttach(const char* name, uint32_t stallMs, SupervisorRestartFn restart);
+
+// Heartbeat of the calling task: feeds the TWDT and records the interval.
+// Long-running handlers on a supervised task call it too. Unattached tasks: no-op.
+void supervisorHeartbeat();
+
+// A task the supervisor restarts must not hold @p lock (checked before a
+// restart; a holder is rebooted instead). Call in setup().
+void supervisorWatchLock(SemaphoreHandle_t lock);
+
+// Checks the tasks, refreshes the RTC record and writes the reset log once.
+// Call from loop().
+void supervisorLoop(uint32_t nowMs);
+
+// Subsystem restarts since boot (all tasks).
+uint32_t supervisorRestarts();
+
+// Reset log, oldest first. @return entries copied
+size_t getSupervisorResetLog(SupervisorResetEntry* out, size_t maxEntries);
+
+const char* resetReasonName(uint8_t reason);
+
+// Prints the heartbeat histograms, restarts and the reset log ("supervisor").
+void printSupervisor(Print& out);
+
+#endif // SUPERVISOR_H
@@ -0,0 +1,251 @@
+/**
+ * @file survey_track_view.cpp
+ * @brief Survey breadcrumb track drawn into a PSRAM canvas.
+ *
+ * Positions are projected onto a local plane around the track's centre:
+ * longitude differences shrink by cos(latitude), so a square on the ground
+ * stays a square on the screen. The frame is the track's bounding box with a
+ * margin of FRAME_MARGIN on every side, and it spans at least MIN_SPAN_M.
+ * Standing still therefore does not zoom into the GPS noise. The margin
+ * leaves room for the track to grow before it has to be re-framed.
+ */
+
+#include "config.h"
+
+#if !HEADLESS
+
+#include "survey_track_view.h"
+#include "gps_survey.h"
+#include "config.h"
+#include "esp_heap_caps.h"
+#include <math.h>
+#include <string.h>
+
+static const uint16_t POINTS = SURVEY_TRACK_POINTS;
+static const float FRAME_MARGIN = 0.25f;        ///< Of the track's extent, on every side
+static const float MIN_SPAN_M = 50.0f;
+static const float METRES_PER_DEGREE = 111320.0f;
+static const float LOG_MIN_USVH = -1.3f;        ///< log10 of the bottom of the colour scale (0.05 µSv/h)
+static const float LOG_MAX_USVH = 1.0f;         ///< ... top (10 µSv/h)
+static const uint8_t DOT = 3;                   ///< Dot size in pixels
+
+static SurveyPoint* ring = nullptr;             ///< POINTS, PSRAM
+static uint16_t head = 0;                       ///< Next point written
+static uint16_t count = 0;
+
+static lv_obj_t* canvas = nullptr;
+static lv_color_t* canvasBuf = nullptr;         ///< PSRAM
+static uint16_t canvasW = 0;
+static uint16_t canvasH = 0;
+static bool shown = false;
+static bool fullRender = true;
+static lv_color_t palette[64];
+
+// Frame: centre and scale of the projection
+static int32_t centreLatE7 = 0;
+static int32_t centreLonE7 = 0;
+static float lonScale = 1.0f;                   ///< cos(centre latitude)
+static float pixelsPerDegree = 0.0f;
+
+static uint32_t fullRenders = 0;
+static uint32_t fullRenderUs = 0;
+static uint32_t dots = 0;
+
+// Green, yellow, red, magenta
+static void buildPalette() {
+    static const uint8_t stops[4][3] = {{0, 200, 60}, {240, 230, 0}, {255, 40, 0}, {255, 0, 200}};
+    const uint8_t size = sizeof(palette) / sizeof(palette[0]);
+    for (uint8_t i = 0; i < size; i++) {
+        uint16_t position = (uint16_t)i * 3 * 256 / (size - 1); // 0..768 over three segments
+        uint8_t s = position >= 768 ? 2 : position / 256;
+        uint16_t t = position - s * 256;
+        uint8_t rgb[3];
+        for (uint8_t k = 0; k < 3; k++) rgb[k] = stops[s][k] + (stops[s + 1][k] - stops[s][k]) * t / 256;
+        palette[i] = lv_color_make(rgb[0], rgb[1], rgb[2]);
+    }
+}
+
+static lv_color_t colourOf(float doseRate) {
+    const uint8_t size = sizeof(palette) / sizeof(palette[0]);
+    float position = doseRate > 0.0f ? (log10f(doseRate) - LOG_MIN_USVH) / (LOG_MAX_USVH - LOG_MIN_USVH) : 0.0f;
+    if (!(position > 0.0f)) return palette[0];
+    return position >= 1.0f ? palette[size - 1] : palette[(uint8_t)(position * (size - 1))];
+}
+
+bool initSurveyTrackView() {
+    ring = (SurveyPoint*)heap_caps_malloc((size_t)POINTS * sizeof(SurveyPoint), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!ring) return false;
+    buildPalette();
+    shown = SURVEY_TRACK_SHOWN;
+    return true;
+}
+
+static const SurveyPoint& pointAt(uint16_t age) {
+    return ring[(head + POINTS - 1 - age) % POINTS];
+}
+
+static bool project(const SurveyPoint& point, int16_t* x, int16_t* y) {
+    float east = (point.lonE7 - centreLonE7) * 1e-7f * lonScale;
+    float north = (point.latE7 - centreLatE7) * 1e-7f;
+    float px = canvasW * 0.5f + east * pixelsPerDegree;
+    float py = canvasH * 0.5f - north * pixelsPerDegree;
+    if (!(px >= 0.0f && px < canvasW && py >= 0.0f && py < canvasH)) return false;
+    *x = (int16_t)px;
+    *y = (int16_t)py;
+    return true;
+}
+
+/**
+ * @brief Centres the frame on the track and scales it to fit, with margins.
+ */
+static void frameTrack() {
+    int32_t minLat = INT32_MAX, maxLat = INT32_MIN, minLon = INT32_MAX, maxLon = INT32_MIN;
+    for (uint16_t age = 0; age < count; age++) {
+        const SurveyPoint& p = pointAt(age);
+        if (p.latE7 < minLat) minLat = p.latE7;
+        if (p.latE7 > maxLat) maxLat = p.latE7;
+        if (p.lonE7 < minLon) minLon = p.lonE7;
+        if (p.lonE7 > maxLon) maxLon = p.lonE7;
+    }
+    centreLatE7 = minLat + (maxLat - minLat) / 2;
+    centreLonE7 = minLon + (maxLon - minLon) / 2;
+    lonScale = cosf(centreLatE7 * 1e-7f * (float)M_PI / 180.0f);
+    float spanNorth = (maxLat - minLat) * 1e-7f * (1.0f + 2.0f * FRAME_MARGIN);
+    float spanEast = (maxLon - minLon) * 1e-7f * lonScale * (1.0f + 2.0f * FRAME_MARGIN);
+    float minSpan = MIN_SPAN_M / METRES_PER_DEGREE;
+    if (spanNorth < minSpan) spanNorth = minSpan;
+    if (spanEast < minSpan) spanEast = minSpan;
+    float byWidth = canvasW / spanEast;
+    float byHeight = canvasH / spanNorth;
+    pixelsPerDegree = byWidth < byHeight ? byWidth : byHeight;
+}
+
+static void drawDot(int16_t x, int16_t y, lv_color_t colour) {
+    int16_t x0 = x - DOT / 2 < 0 ? 0 : x - DOT / 2;
+    int16_t y0 = y - DOT / 2 < 0 ? 0 : y - DOT / 2;
+    int16_t x1 = x0 + DOT > canvasW ? canvasW : x0 + DOT;
+    int16_t y1 = y0 + DOT > canvasH ? canvasH : y0 + DOT;
+    for (int16_t row = y0; row < y1; row++) {
+        lv_color_t* out = canvasBuf + (size_t)row * canvasW;
+        for (int16_t col = x0; col < x1; col++) out[col] = colour;
+    }
+}
+
+static void drawAll() {
+    uint32_t start = micros();
+    lv_color_t background = lv_color_black();
+    for (size_t i = 0; i < (size_t)canvasW * canvasH; i++) canvasBuf[i] = background;
+    if (count) frameTrack();
+    // Oldest first, so the newest dots lie on top where the track crosses itself
+    for (uint16_t age = count; age-- > 0;) {
+        const SurveyPoint& p = pointAt(age);
+        int16_t x, y;
+        if (project(p, &x, &y)) drawDot(x, y, colourOf(p.doseRate));
+    }
+    lv_obj_invalidate(canvas);
+    fullRenders++;
+    fullRenderUs = micros() - start;
+}
+
+/**
+ * @brief Draws the points added since the last pass.
+ * @return false if one lies outside the frame (the track must be re-framed)
+ */
+static bool drawNew(uint16_t added) {
+    lv_area_t coords;
+    lv_obj_get_coords(canvas, &coords);
+    for (uint16_t age = added; age-- > 0;) {
+        const SurveyPoint& p = pointAt(age);
+        int16_t x, y;
+        if (!project(p, &x, &y)) return false;
+        drawDot(x, y, colourOf(p.doseRate));
+        lv_area_t area = {(lv_coord_t)(coords.x1 + x - DOT / 2), (lv_coord_t)(coords.y1 + y - DOT / 2),
+                          (lv_coord_t)(coords.x1 + x + DOT / 2), (lv_coord_t)(coords.y1 + y + DOT / 2)};
+        lv_obj_invalidate_area(canvas, &area);
+        dots++;
+    }
+    return true;
+}
+
+static void chartLongPressedCb(lv_event_t* e) {
+    surveyTrackViewSetShown(!shown);
+}
+
+void surveyTrackViewAttach(lv_obj_t* chart) {
+    if (!chart) {
+        // The chart's screen is being deleted; the canvas goes with it
+        if (canvas) lv_obj_add_flag(canvas, LV_OBJ_FLAG_HIDDEN);
+        canvas = nullptr;
+        heap_caps_free(canvasBuf);
+        canvasBuf = nullptr;
+        canvasW = canvasH = 0;
+        return;
+    }
+    if (!ring) return;
+
+    lv_obj_update_layout(chart);
+    lv_area_t content;
+    lv_obj_get_content_coords(chart, &content);
+    uint16_t w = lv_area_get_width(&content);
+    uint16_t h = lv_area_get_height(&content);
+    canvasBuf = (lv_color_t*)heap_caps_malloc((size_t)w * h * sizeof(lv_color_t), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!canvasBuf) return;
+    canvasW = w;
+    canvasH = h;
+
+    canvas = lv_canvas_create(chart);
+    lv_canvas_set_buffer(canvas, canvasBuf, canvasW, canvasH, LV_IMG_CF_TRUE_COLOR);
+    lv_obj_set_pos(canvas, 0, 0);
+    lv_obj_clear_flag(canvas, LV_OBJ_FLAG_CLICKABLE);
+    if (!shown) lv_obj_add_flag(canvas, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_add_event_cb(chart, chartLongPressedCb, LV_EVENT_LONG_PRESSED, NULL);
+    fullRender = true;
+}
+
+void surveyTrackViewSetShown(bool enabled) {
+    shown = enabled;
+    fullRender = true;
+    if (!canvas) return;
+    if (shown) lv_obj_clear_flag(canvas, LV_OBJ_FLAG_HIDDEN);
+    else lv_obj_add_flag(canvas, LV_OBJ_FLAG_HIDDEN);
+}
+
+bool surveyTrackViewShown() {
+    return shown;
+}
+
+void surveyTrackViewUpdate(uint32_t nowMs) {
+    if (!ring) return;
+    SurveyPoint point;
+    uint16_t added = 0;
+    while (gpsSurveyPopPoint(point)) {
+        ring[head] = point;
+        head = (head + 1) % POINTS;
+        if (count < POINTS) count++;
+        added++;
+    }
+
+    if (!canvas || !shown || lv_obj_get_screen(canvas) != lv_scr_act()) {
+        fullRender = true; // Points are missed while not shown
+        return;
+    }
+    // More new points than the ring holds means the oldest drawn ones are gone
+    if (fullRender || added >= POINTS || !drawNew(added)) {
+        drawAll();
+        fullRender = false;
+    }
+}
+
+void printSurveyTrackView(Print& out) {
+    if (!ring) {
+        out.println("Survey track: not allocated");
+        return;
+    }
+    out.printf("Survey track: %s, %u of %u points, canvas %ux%u, %.1f m per pixel\n", shown ? "SHOWN" : "hidden",
+               (unsigned)count, (unsigned)POINTS, (unsigned)canvasW, (unsigned)canvasH,
+               pixelsPerDegree > 0.0f ? METRES_PER_DEGREE / pixelsPerDegree : 0.0f);
+    out.printf("  %lu dots, %lu full renders (last %lu us)\n", (unsigned long)dots, (unsigned long)fullRenders,
+               (unsigned long)fullRenderUs);
+}
+
+#endif // !HEADLESS
@@ -0,0 +1,34 @@
+#ifndef SURVEY_TRACK_VIEW_H
+#define SURVEY_TRACK_VIEW_H
+
+#include <Arduino.h>
+#include <lvgl.h>
+
+// Breadcrumb heat track of a survey on the 24 h chart screen: every
+// geo-tagged second (gps_survey.h) is a dot at its position, coloured by its
+// dose rate on a log scale. The last SURVEY_TRACK_POINTS points are kept in
+// PSRAM whether or not the track is shown. The view is a canvas over the
+// chart's plot area, scaled to fit the whole track (north up, equal metres on
+// both axes). A new point inside the current frame costs one dot and a dot-sized
+// invalidation. Only a point outside the frame re-frames the track and
+// redraws it whole.
+
+// Allocates the point ring. Call in setup() when the GPS is configured.
+bool initSurveyTrackView();
+
+// Creates the (hidden) canvas over @p chart's plot area; a long press on the
+// chart switches between the chart and the track. Call with NULL before the
+// chart's screen is deleted. UI task.
+void surveyTrackViewAttach(lv_obj_t* chart);
+
+// Takes the new points and, while the track is on the active screen, draws
+// them. Call every uiTask pass.
+void surveyTrackViewUpdate(uint32_t nowMs);
+
+// Shows the track instead of the chart (kept across screen builds).
+void surveyTrackViewSetShown(bool shown);
+bool surveyTrackViewShown();
+
+void printSurveyTrackView(Print& out);
+
+#endif // SURVEY_TRACK_VIEW_H
@@ -0,0 +1,456 @@
+/**
+ * @file sysinfo.cpp
+ * @brief Periodic task / heap sampler behind /api/sysinfo and the "perf" command.
+ *
+ * CPU load comes from the FreeRTOS run-time counters (esp_timer microseconds): a
+ * task's load is the growth of its counter between two samples divided by the
+ * wall time between them, and a core's load is 100% minus its idle task's share.
+ * The counters are 32-bit and wrap after ~71 minutes, which the unsigned
+ * differences over one 10-second interval absorb. Builds without run-time stats
+ * report -1 for every load and list only the watched tasks.
+ *
+ * All state is written by the sampler job and copied out under one mutex.
+ */
+
+#include "sysinfo.h"
+#include "debug.h"
+#include "energy_meter.h"
+#include "job_wheel.h"
+#include "lvgl_heap.h"
+#include "time_base.h"
+#include "json_arena.h"
+#include "web_arena.h"
+#include <ArduinoJson.h>
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+#if configUSE_TRACE_FACILITY && configGENERATE_RUN_TIME_STATS
+#define SYSINFO_RUN_TIME_STATS 1
+#else
+#define SYSINFO_RUN_TIME_STATS 0
+#endif
+
+struct WatchedTask {
+    TaskHandle_t handle;   ///< nullptr while the task is being restarted
+    uint32_t stackSize;
+    char name[16];
+};
+
+static WatchedTask watchedTasks[SYSINFO_WATCHED_TASKS];
+static uint8_t watchedCount = 0;
+
+static SysInfoSample history[SYSINFO_HISTORY_SIZE];
+static size_t historyHead = 0;   ///< Next slot to write
+static size_t historyCount = 0;
+static SysInfoSample latestSample;
+static uint32_t heapLargestMin = UINT32_MAX; ///< Smallest largest block since boot
+static float heapRatioMin = 1.0f;            ///< Lowest largest / free since boot
+static SysInfoTask taskTable[SYSINFO_MAX_TASKS];
+static size_t taskCount = 0;
+static SemaphoreHandle_t sysInfoMutex = nullptr;
+
+#if SYSINFO_RUN_TIME_STATS
+struct RunTimeMark {
+    TaskHandle_t handle;
+    uint32_t counter;
+};
+
+// Sampler job only
+static TaskStatus_t statusBuffer[SYSINFO_MAX_TASKS];
+static RunTimeMark previousMarks[SYSINFO_MAX_TASKS];
+static size_t previousCount = 0;
+static uint32_t previousTotal = 0;
+
+/**
+ * @brief Run-time counter of @p handle at the previous sample; false if the task is new.
+ */
+static bool previousCounter(TaskHandle_t handle, uint32_t* counter) {
+    for (size_t i = 0; i < previousCount; i++) {
+        if (previousMarks[i].handle == handle) {
+            *counter = previousMarks[i].counter;
+            return true;
+        }
+    }
+    return false;
+}
+#endif
+
+/**
+ * @brief Fills the task table and the per-core load of @p sample; returns the table size.
+ */
+static size_t sampleTasks(SysInfoSample& sample, SysInfoTask* table) {
+    sample.cpuLoad[0] = -1;
+    sample.cpuLoad[1] = -1;
+    size_t count = 0;
+
+#if SYSINFO_RUN_TIME_STATS
+    uint32_t total = 0;
+    // Returns 0 if there are more tasks than SYSINFO_MAX_TASKS slots
+    UBaseType_t n = uxTaskGetSystemState(statusBuffer, SYSINFO_MAX_TASKS, &total);
+    if (n > 0) {
+        uint32_t elapsed = total - previousTotal;
+        bool havePrevious = previousTotal != 0 && elapsed > 0;
+        for (UBaseType_t i = 0; i < n; i++) {
+            const TaskStatus_t& status = statusBuffer[i];
+            SysInfoTask& task = table[count++];
+            strlcpy(task.name, status.pcTaskName, sizeof(task.name));
+            task.priority = (uint8_t)status.uxCurrentPriority;
+#if configTASKLIST_INCLUDE_COREID
+            task.core = status.xCoreID == tskNO_AFFINITY ? -1 : (int8_t)status.xCoreID;
+#else
+            task.core = -1;
+#endif
+            task.stackFree = (uint16_t)status.usStackHighWaterMark;
+            task.cpu = -1;
+            uint32_t before;
+            if (havePrevious && previousCounter(status.xHandle, &before)) {
+                uint32_t pct = (uint32_t)((uint64_t)(status.ulRunTimeCounter - before) * 100 / elapsed);
+                task.cpu = (int8_t)(pct > 100 ? 100 : pct);
+                for (int core = 0; core < 2; core++) {
+                    if (status.xHandle == xTaskGetIdleTaskHandleForCPU(core)) {
+                        sample.cpuLoad[core] = 100 - task.cpu;
+                    }
+                }
+            }
+        }
+        for (UBaseType_t i = 0; i < n; i++) {
+            previousMarks[i].handle = statusBuffer[i].xHandle;
+            previousMarks[i].counter = statusBuffer[i].ulRunTimeCounter;
+        }
+        previousCount = n;
+        previousTotal = total;
+        return count;
+    }
+#endif
+
+    // No run-time stats (or too many tasks): the watched tasks only
+    for (uint8_t i = 0; i < watchedCount; i++) {
+        if (!watchedTasks[i].handle) continue;
+        SysInfoTask& task = table[count++];
+        strlcpy(task.name, pcTaskGetName(watchedTasks[i].handle), sizeof(task.name));
+        task.priority = (uint8_t)uxTaskPriorityGet(watchedTasks[i].handle);
+        task.core = -1;
+        task.stackFree = (uint16_t)uxTaskGetStackHighWaterMark(watchedTasks[i].handle);
+        task.cpu = -1;
+    }
+    return count;
+}
+
+/**
+ * @brief Takes one sample and appends it to the history ring.
+ */
+static void takeSample() {
+    static SysInfoTask table[SYSINFO_MAX_TASKS]; // Sampler job only
+    SysInfoSample sample;
+    memset(&sample, 0, sizeof(sample));
+    sample.uptimeSeconds = timeBaseSeconds();
+
+    // Held while the watched handles are used: the supervisor replaces a
+    // restarted task's handle under it
+    xSemaphoreTake(sysInfoMutex, portMAX_DELAY);
+    size_t count = sampleTasks(sample, table);
+    for (uint8_t i = 0; i < watchedCount; i++) {
+        if (watchedTasks[i].handle) sample.stackFree[i] = (uint16_t)uxTaskGetStackHighWaterMark(watchedTasks[i].handle);
+    }
+
+    multi_heap_info_t info;
+    heap_caps_get_info(&info, MALLOC_CAP_INTERNAL);
+    sample.heapFree = info.total_free_bytes;
+    sample.heapLargest = info.largest_free_block;
+    sample.heapMinFree = info.minimum_free_bytes;
+    if (sample.heapLargest < heapLargestMin) heapLargestMin = sample.heapLargest;
+    if (sample.heapFree && (float)sample.heapLargest / sample.heapFree < heapRatioMin) {
+        heapRatioMin = (float)sample.heapLargest / sample.heapFree;
+    }
+    heap_caps_get_info(&info, MALLOC_CAP_SPIRAM); // All zero without PSRAM
+    sample.psramFree = info.total_free_bytes;
+    sample.psramLargest = info.largest_free_block;
+
+    latestSample = sample;
+    memcpy(taskTable, table, count * sizeof(SysInfoTask));
+    taskCount = count;
+    history[historyHead] = sample;
+    historyHead = (historyHead + 1) % SYSINFO_HISTORY_SIZE;
+    if (historyCount < SYSINFO_HISTORY_SIZE) historyCount++;
+    xSemaphoreGive(sysInfoMutex);
+}
+
+/**
+ * @brief Sampler job (job_wheel.h).
+ */
+static void sysInfoJob(void* parameter) {
+    takeSample();
+}
+
+bool initSysInfo() {
+    if (sysInfoMutex) return true;
+    sysInfoMutex = xSemaphoreCreateMutex();
+    if (!sysInfoMutex) return false;
+    memset(&latestSample, 0, sizeof(latestSample));
+    return jobWheelAdd("sysinfo", SYSINFO_SAMPLE_INTERVAL_MS, 0, sysInfoJob, NULL);
+}
+
+bool sysInfoWatchTask(TaskHandle_t task, uint32_t stackSize) {
+    if (!task || !sysInfoMutex) return false;
+    xSemaphoreTake(sysInfoMutex, portMAX_DELAY);
+    bool added = watchedCount < SYSINFO_WATCHED_TASKS;
+    if (added) {
+        watchedTasks[watchedCount].handle = task;
+        watchedTasks[watchedCount].stackSize = stackSize;
+        strlcpy(watchedTasks[watchedCount].name, pcTaskGetName(task), sizeof(watchedTasks[watchedCount].name));
+        watchedCount++;
+    }
+    xSemaphoreGive(sysInfoMutex);
+    return added;
+}
+
+bool sysInfoReplaceTask(TaskHandle_t oldTask, TaskHandle_t newTask) {
+    if (!sysInfoMutex) return false;
+    xSemaphoreTake(sysInfoMutex, portMAX_DELAY);
+    bool found = false;
+    for (uint8_t i = 0; i < watchedCount && !found; i++) {
+        if (watchedTasks[i].handle != oldTask) continue;
+        watchedTasks[i].handle = newTask;
+        found = true;
+    }
+    xSemaphoreGive(sysInfoMutex);
+    return found;
+}
+
+SysInfoSample getSysInfoSample() {
+    SysInfoSample sample;
+    memset(&sample, 0, sizeof(sample));
+    if (!sysInfoMutex) return sample;
+    xSemaphoreTake(sysInfoMutex, portMAX_DELAY);
+    sample = latestSample;
+    xSemaphoreGive(sysInfoMutex);
+    return sample;
+}
+
+size_t getSysInfoTasks(SysInfoTask* out, size_t maxTasks) {
+    if (!sysInfoMutex) return 0;
+    xSemaphoreTake(sysInfoMutex, portMAX_DELAY);
+    size_t count = taskCount < maxTasks ? taskCount : maxTasks;
+    memcpy(out, taskTable, count * sizeof(SysInfoTask));
+    xSemaphoreGive(sysInfoMutex);
+    return count;
+}
+
+/**
+ * @brief Largest free block over the free heap: 1 when all of it is one
+ *        block, towards 0 as it breaks up into pieces no large buffer fits in.
+ */
+static float largestRatio(uint32_t freeBytes, uint32_t largest) {
+    return freeBytes ? (float)largest / (float)freeBytes : 1.0f;
+}
+
+/**
+ * @brief Fragmentation in percent: share of the free heap not usable as one block.
+ */
+static float fragmentation(uint32_t freeBytes, uint32_t largest) {
+    return 100.0f * (1.0f - largestRatio(freeBytes, largest));
+}
+
+typedef int32_t (*SampleField)(const SysInfoSample& sample, uint8_t index);
+
+static int32_t fieldUptime(const SysInfoSample& s, uint8_t) { return (int32_t)s.uptimeSeconds; }
+static int32_t fieldLoad(const SysInfoSample& s, uint8_t core) { return s.cpuLoad[core]; }
+static int32_t fieldHeapFree(const SysInfoSample& s, uint8_t) { return (int32_t)s.heapFree; }
+static int32_t fieldHeapLargest(const SysInfoSample& s, uint8_t) { return (int32_t)s.heapLargest; }
+static int32_t fieldHeapRatio(const SysInfoSample& s, uint8_t) {
+    return (int32_t)lroundf(1000.0f * largestRatio(s.heapFree, s.heapLargest));
+}
+static int32_t fieldPsramFree(const SysInfoSample& s, uint8_t) { return (int32_t)s.psramFree; }
+static int32_t fieldStackFree(const SysInfoSample& s, uint8_t task) { return s.stackFree[task]; }
+
+/**
+ * @brief Appends "key":[...] with one value per history sample, oldest first (mutex held).
+ *
+ * Written straight into the output instead of through a JsonDocument: a full
+ * ring is ~1500 values, which as document slots would take tens of KB of the
+ * very heap this endpoint is meant to watch.
+ */
+static void appendSeries(Print& json, const char* key, SampleField field, uint8_t index) {
+    json.print('"');
+    json.print(key);
+    json.print("\":[");
+    size_t start = (historyHead + SYSINFO_HISTORY_SIZE - historyCount) % SYSINFO_HISTORY_SIZE;
+    for (size_t i = 0; i < historyCount; i++) {
+        if (i) json.print(',');
+        json.print(field(history[(start + i) % SYSINFO_HISTORY_SIZE], index));
+    }
+    json.print(']');
+}
+
+/**
+ * @brief Passes everything through but the last character written.
+ */
+class WithoutLastChar : public Print {
+public:
+    explicit WithoutLastChar(Print& out) : out_(out), held_(-1) {}
+
+    size_t write(uint8_t c) override {
+        if (held_ >= 0) out_.write((uint8_t)held_);
+        held_ = c;
+        return 1;
+    }
+
+private:
+    Print& out_;
+    int held_;
+};
+
+void writeSysInfoJson(Print& json) {
+    JsonArenaLease lease;
+    JsonDocument doc(lease.allocator());
+    if (!sysInfoMutex) {
+        doc["error"] = "sysinfo not running";
+        serializeJson(doc, json);
+        return;
+    }
+
+    xSemaphoreTake(sysInfoMutex, portMAX_DELAY);
+    const SysInfoSample& s = latestSample;
+    doc["uptime_s"] = s.uptimeSeconds;
+    doc["interval_s"] = SYSINFO_SAMPLE_INTERVAL_MS / 1000;
+    JsonArray load = doc["cpu_load"].to<JsonArray>();
+    load.add(s.cpuLoad[0]);
+    load.add(s.cpuLoad[1]);
+
+    JsonObject heap = doc["heap"].to<JsonObject>();
+    heap["free"] = s.heapFree;
+    heap["largest"] = s.heapLargest;
+    heap["min_free"] = s.heapMinFree;
+    heap["frag_pct"] = fragmentation(s.heapFree, s.heapLargest);
+    heap["largest_ratio"] = largestRatio(s.heapFree, s.heapLargest);
+    heap["largest_ratio_min"] = heapRatioMin;
+    heap["largest_min"] = heapLargestMin == UINT32_MAX ? 0 : heapLargestMin;
+    JsonObject psram = doc["psram"].to<JsonObject>();
+    psram["size"] = ESP.getPsramSize();
+    psram["free"] = s.psramFree;
+    psram["largest"] = s.psramLargest;
+
+#if !HEADLESS
+    LvglHeapStats lvgl = getLvglHeapStats();
+    JsonObject lvglHeap = doc["lvgl_heap"].to<JsonObject>();
+    lvglHeap["pool_bytes"] = lvgl.poolBytes;
+    lvglHeap["internal"] = lvgl.internalBytes;
+    lvglHeap["internal_peak"] = lvgl.internalPeak;
+    lvglHeap["psram"] = lvgl.psramBytes;
+    lvglHeap["psram_peak"] = lvgl.psramPeak;
+    lvglHeap["allocs"] = lvgl.allocs;
+    lvglHeap["frees"] = lvgl.frees;
+    lvglHeap["spills"] = lvgl.spills;
+    lvglHeap["failures"] = lvgl.failures;
+    JsonArray classes = lvglHeap["classes"].to<JsonArray>();
+    for (uint8_t c = 0; c < LVGL_HEAP_CLASSES; c++) {
+        JsonObject cls = classes.add<JsonObject>();
+        cls["size"] = lvgl.classes[c].blockSize;
+        cls["blocks"] = lvgl.classes[c].blocks;
+        cls["used"] = lvgl.classes[c].used;
+        cls["peak"] = lvgl.classes[c].peak;
+    }
+#endif
+
+    WebArenaStats arena = getWebArenaStats();
+    JsonObject webArena = doc["web_arena"].to<JsonObject>();
+    webArena["bytes"] = arena.capacity;
+    webArena["peak"] = arena.peakBytes;
+    webArena["requests"] = arena.resets;
+    webArena["spills"] = arena.spills;
+    webArena["fallbacks"] = arena.fallbacks;
+
+    JsonArray tasks = doc["tasks"].to<JsonArray>();
+    for (size_t i = 0; i < taskCount; i++) {
+        const SysInfoTask& t = taskTable[i];
+        JsonObject task = tasks.add<JsonObject>();
+        task["name"] = t.name;
+        task["prio"] = t.priority;
+        task["core"] = t.core;
+        task["stack_free"] = t.stackFree;
+        task["cpu"] = t.cpu;
+    }
+
+    // History as one array per series, spliced in before the closing brace
+    WithoutLastChar body(json);
+    serializeJson(doc, body);
+    json.print(",\"history\":{");
+    appendSeries(json, "uptime_s", fieldUptime, 0);
+    json.print(',');
+    appendSeries(json, "load0", fieldLoad, 0);
+    json.print(',');
+    appendSeries(json, "load1", fieldLoad, 1);
+    json.print(',');
+    appendSeries(json, "heap_free", fieldHeapFree, 0);
+    json.print(',');
+    appendSeries(json, "heap_largest", fieldHeapLargest, 0);
+    json.print(',');
+    appendSeries(json, "heap_ratio_permille", fieldHeapRatio, 0);
+    json.print(',');
+    appendSeries(json, "psram_free", fieldPsramFree, 0);
+    json.print(",\"stacks\":[");
+    for (uint8_t w = 0; w < watchedCount; w++) {
+        if (w) json.print(',');
+        // FreeRTOS task names here are plain identifiers; no escaping needed
+        json.print("{\"name\":\"");
+        json.print(watchedTasks[w].name);
+        json.print("\",\"size\":");
+        json.print(watchedTasks[w].stackSize);
+        json.print(',');
+        appendSeries(json, "free", fieldStackFree, w);
+        json.print('}');
+    }
+    json.print("]},\"energy\":");
+    writeEnergyJson(json);
+    json.print('}');
+    xSemaphoreGive(sysInfoMutex);
+}
+
+void printSysInfo(Print& out) {
+    if (!sysInfoMutex) {
+        out.println("Performance sampling not running");
+        return;
+    }
+    SysInfoSample s = getSysInfoSample();
+    static SysInfoTask tasks[SYSINFO_MAX_TASKS]; // Only called from the serial handler
+    size_t count = getSysInfoTasks(tasks, SYSINFO_MAX_TASKS);
+
+    out.printf("=== Performance (sample at %lu s, every %u s) ===\n", (unsigned long)s.uptimeSeconds,
+               (unsigned)(SYSINFO_SAMPLE_INTERVAL_MS / 1000));
+    if (s.cpuLoad[0] < 0) {
+        out.println("CPU load: n/a (run-time stats not enabled in this build)");
+    } else {
+        out.printf("CPU load: core 0 %d%%, core 1 %d%%\n", s.cpuLoad[0], s.cpuLoad[1]);
+    }
+    out.printf("Heap: %lu free, largest block %lu (%.0f%% fragmented), min free %lu\n",
+               (unsigned long)s.heapFree, (unsigned long)s.heapLargest,
+               fragmentation(s.heapFree, s.heapLargest), (unsigned long)s.heapMinFree);
+    out.printf("  largest / free %.2f now, %.2f at worst; smallest largest block %lu\n",
+               largestRatio(s.heapFree, s.heapLargest), heapRatioMin,
+               (unsigned long)(heapLargestMin == UINT32_MAX ? 0 : heapLargestMin));
+    out.printf("PSRAM: %lu of %lu free, largest block %lu\n", (unsigned long)s.psramFree,
+               (unsigned long)ESP.getPsramSize(), (unsigned long)s.psramLargest);
+    printLvglHeapStats(out);
+
+    xSemaphoreTake(sysInfoMutex, portMAX_DELAY);
+    for (uint8_t w = 0; w < watchedCount; w++) {
+        uint32_t size = watchedTasks[w].stackSize;
+        uint32_t freeBytes = s.stackFree[w];
+        out.printf("Stack %-12s %5lu of %5lu bytes used (%lu free at worst)\n", watchedTasks[w].name,
+                   (unsigned long)(size > freeBytes ? size - freeBytes : 0), (unsigned long)size,
+                   (unsigned long)freeBytes);
+    }
+    xSemaphoreGive(sysInfoMutex);
+
+    out.printf("%-16s %4s %4s %10s %5s\n", "task", "prio", "core", "stack free", "cpu%");
+    for (size_t i = 0; i < count; i++) {
+        const SysInfoTask& t = tasks[i];
+        char core[4] = "-";
+        if (t.core >= 0) snprintf(core, sizeof(core), "%d", t.core);
+        char cpu[5] = "-";
+        if (t.cpu >= 0) snprintf(cpu, sizeof(cpu), "%d", t.cpu);
+        out.printf("%-16s %4u %4s %10u %5s\n", t.name, t.priority, core, t.stackFree, cpu);
+    }
+}
@@ -0,0 +1,61 @@
+#ifndef SYSINFO_H
+#define SYSINFO_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Runtime task and heap profiling.
+// A background job (job_wheel.h) takes a sample every SYSINFO_SAMPLE_INTERVAL_MS: per-core
+// CPU load (FreeRTOS run-time stats, idle time against wall time), the stack
+// high-water mark of each watched task and the internal / PSRAM heap state from
+// heap_caps_get_info(). The last SYSINFO_HISTORY_SIZE samples are kept so that
+// slow stack growth or heap fragmentation can be charted before a unit reboots.
+
+static const uint8_t SYSINFO_WATCHED_TASKS = 4;
+static const uint8_t SYSINFO_MAX_TASKS = 32;   ///< Tasks listed; more and run-time stats are skipped
+
+struct SysInfoSample {
+    uint32_t uptimeSeconds;
+    int8_t cpuLoad[2];                          ///< % per core over the interval, -1 without run-time stats
+    uint16_t stackFree[SYSINFO_WATCHED_TASKS];  ///< Bytes never used by each watched task
+    uint32_t heapFree;                          ///< Internal RAM
+    uint32_t heapLargest;                       ///< Largest free internal block
+    uint32_t heapMinFree;                       ///< Internal low-water mark since boot
+    uint32_t psramFree;
+    uint32_t psramLargest;
+};
+
+struct SysInfoTask {
+    char name[16];
+    uint8_t priority;
+    int8_t core;           ///< -1 if not pinned (or unknown)
+    uint16_t stackFree;    ///< High-water mark in bytes
+    int8_t cpu;            ///< % of one core over the last interval, -1 if unknown
+};
+
+// Adds the sampling job; after initJobWheel(). Register the tasks to chart with sysInfoWatchTask().
+bool initSysInfo();
+
+// Adds @p task (allocated with @p stackSize bytes) to the per-sample stack
+// history; at most SYSINFO_WATCHED_TASKS.
+bool sysInfoWatchTask(TaskHandle_t task, uint32_t stackSize);
+
+// Swaps a watched task's handle, keeping its slot in the history: @p newTask
+// nullptr before a restarted task is deleted, then (nullptr, new handle).
+bool sysInfoReplaceTask(TaskHandle_t oldTask, TaskHandle_t newTask);
+
+// Latest sample (zeroed before the first one).
+SysInfoSample getSysInfoSample();
+
+// Copies up to @p maxTasks entries of the task table from the latest sample.
+size_t getSysInfoTasks(SysInfoTask* out, size_t maxTasks);
+
+// Current status plus the sample history with one array per metric and the
+// energy estimate (energy_meter.h), written straight to @p out (web_arena.h
+// for /api/sysinfo).
+void writeSysInfoJson(Print& out);
+
+// Prints current load, stacks and heaps ("perf").
+void printSysInfo(Print& out);
+
+#endif // SYSINFO_H
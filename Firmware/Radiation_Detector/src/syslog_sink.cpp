@@ -0,0 +1,179 @@
+/**
+ * @file syslog_sink.cpp
+ * @brief Debug log lines batched into rate-limited RFC 5424 syslog datagrams.
+ *
+ * Everything but syslogSinkSetOnline() and the stats runs on the debug log
+ * task, through its sink and idle hooks.
+ */
+
+#include "syslog_sink.h"
+#include "debug_log.h"
+#include "mdns_service.h"
+#include "time_base.h"
+#include <WiFi.h>
+#include <WiFiUdp.h>
+#include <atomic>
+#include <time.h>
+
+static const uint32_t REFILL_MS = 60000 / (DEBUG_SYSLOG_MAX_PER_MIN > 0 ? DEBUG_SYSLOG_MAX_PER_MIN : 1);
+static const uint8_t BURST = DEBUG_SYSLOG_MAX_PER_MIN / 4 + 1;
+
+static std::atomic<bool> online(false);
+static SyslogSinkStats stats;
+
+// Debug log task only
+static char batch[DEBUG_SYSLOG_BATCH_BYTES];
+static size_t batchLength = 0;
+static uint16_t batchLines = 0;
+static uint32_t batchFirstMs = 0;
+static uint32_t unreported = 0;     ///< Rate-dropped lines not yet mentioned in a batch
+static bool resolved = false;
+static IPAddress collector;
+static WiFiUDP udp;
+static uint8_t tokens = BURST;
+static uint32_t refillMs = 0;
+static uint32_t sequence = 0;
+
+/**
+ * @brief Takes a datagram token if there is one.
+ */
+static bool takeToken(uint32_t nowMs) {
+    while (tokens < BURST && nowMs - refillMs >= REFILL_MS) {
+        tokens++;
+        refillMs += REFILL_MS;
+    }
+    if (tokens == BURST) refillMs = nowMs;
+    if (tokens == 0) return false;
+    tokens--;
+    return true;
+}
+
+static void clearBatch() {
+    batchLength = 0;
+    batchLines = 0;
+}
+
+/**
+ * @brief RFC 5424 TIMESTAMP of the batch's first line, "-" before SNTP has synced.
+ */
+static void formatTimestamp(char* out, size_t size, uint32_t nowMs) {
+    if (!timeBaseUtcValid()) {
+        strlcpy(out, "-", size);
+        return;
+    }
+    int64_t utcMs = timeBaseUtcUs() / 1000 - (int64_t)(nowMs - batchFirstMs);
+    time_t seconds = (time_t)(utcMs / 1000);
+    struct tm t;
+    gmtime_r(&seconds, &t);
+    snprintf(out, size, "%04d-%02d-%02dT%02d:%02d:%02d.%03dZ", t.tm_year + 1900, t.tm_mon + 1, t.tm_mday,
+             t.tm_hour, t.tm_min, t.tm_sec, (int)(utcMs % 1000));
+}
+
+/**
+ * @brief Sends the batch as one datagram. @return false (batch kept) if the rate limit allows none now
+ */
+static bool sendBatch(uint32_t nowMs) {
+    if (!takeToken(nowMs)) return false;
+    if (!resolved) resolved = WiFi.hostByName(DEBUG_SYSLOG_HOST, collector) == 1;
+
+    char timestamp[32];
+    formatTimestamp(timestamp, sizeof(timestamp), nowMs);
+    if (++sequence > 2147483647UL) sequence = 1;
+    char header[160];
+    // PRI 15 = user.debug; MSGID "debug"; meta sysUpTime in hundredths of a second
+    int headerLength = snprintf(header, sizeof(header), "<15>1 %s %s %s - debug [meta sequenceId=\"%lu\" sysUpTime=\"%lu\"] ",
+                                timestamp, mdnsHostname(), DEBUG_SYSLOG_TAG, (unsigned long)sequence,
+                                (unsigned long)(batchFirstMs / 10));
+    size_t bodyLength = batchLength > 0 && batch[batchLength - 1] == '\n' ? batchLength - 1 : batchLength;
+
+    if (resolved && headerLength > 0 && udp.beginPacket(collector, DEBUG_SYSLOG_PORT) &&
+        udp.write((const uint8_t*)header, headerLength) == (size_t)headerLength &&
+        udp.write((const uint8_t*)batch, bodyLength) == bodyLength && udp.endPacket()) {
+        stats.datagrams++;
+        stats.lines += batchLines;
+    } else {
+        stats.failures++;
+        resolved = false; // Looked up again for the next batch
+    }
+    clearBatch();
+    return true;
+}
+
+static void append(const char* text, size_t length) {
+    if (length > sizeof(batch) - batchLength) length = sizeof(batch) - batchLength;
+    memcpy(batch + batchLength, text, length);
+    batchLength += length;
+}
+
+static void sinkWrite(uint32_t ms, const char* text, size_t length) {
+    while (length > 0 && (text[length - 1] == '\n' || text[length - 1] == '\r')) length--;
+    if (length == 0) return;
+    if (!online.load(std::memory_order_relaxed)) {
+        stats.offlineDropped++;
+        return;
+    }
+
+    uint32_t seconds = ms / 1000;
+    char stamp[20];
+    int stampLength = snprintf(stamp, sizeof(stamp), "[%lu:%02u:%02u.%03u] ", (unsigned long)(seconds / 3600),
+                               (unsigned)(seconds / 60 % 60), (unsigned)(seconds % 60), (unsigned)(ms % 1000));
+    if (batchLength > 0 && batchLength + stampLength + length + 1 > sizeof(batch) && !sendBatch(millis())) {
+        stats.rateDropped++;
+        unreported++;
+        return;
+    }
+    if (batchLength == 0) {
+        batchFirstMs = ms;
+        if (unreported > 0) {
+            char note[48];
+            int noteLength = snprintf(note, sizeof(note), "[log] %lu lines not sent (rate limit)\n",
+                                      (unsigned long)unreported);
+            append(note, noteLength);
+            unreported = 0;
+        }
+    }
+    append(stamp, stampLength);
+    append(text, length);
+    append("\n", 1);
+    batchLines++;
+}
+
+static void sinkIdle(uint32_t nowMs) {
+    if (!online.load(std::memory_order_relaxed)) {
+        stats.offlineDropped += batchLines;
+        clearBatch();
+        resolved = false;
+        return;
+    }
+    if (batchLength > 0 && nowMs - batchFirstMs >= DEBUG_SYSLOG_BATCH_MS) sendBatch(nowMs);
+}
+
+void initSyslogSink() {
+    if (sizeof(DEBUG_SYSLOG_HOST) <= 1) return;
+    stats.enabled = true;
+    mdnsHostname(); // Formats the name here rather than on the debug log task
+    debugLogSetSink(sinkWrite, sinkIdle);
+}
+
+void syslogSinkSetOnline(bool value) {
+    online.store(value, std::memory_order_relaxed);
+}
+
+SyslogSinkStats getSyslogSinkStats() {
+    SyslogSinkStats s = stats;
+    s.online = online.load(std::memory_order_relaxed);
+    return s;
+}
+
+void printSyslogSink(Print& out) {
+    SyslogSinkStats s = getSyslogSinkStats();
+    if (!s.enabled) {
+        out.println("Syslog: off (DEBUG_SYSLOG_HOST not set)");
+        return;
+    }
+    out.printf("Syslog %s:%u (%s): %lu datagrams, %lu lines, %lu failed, dropped %lu over the rate limit, "
+               "%lu offline\n",
+               DEBUG_SYSLOG_HOST, (unsigned)DEBUG_SYSLOG_PORT, s.online ? "online" : "offline",
+               (unsigned long)s.datagrams, (unsigned long)s.lines, (unsigned long)s.failures,
+               (unsigned long)s.rateDropped, (unsigned long)s.offlineDropped);
+}
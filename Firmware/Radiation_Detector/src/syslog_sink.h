@@ -0,0 +1,41 @@
+#ifndef SYSLOG_SINK_H
+#define SYSLOG_SINK_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Remote syslog for headless installs, fed by the async debug log
+// (debug_log.h) on its task. Lines are batched: one RFC 5424 datagram
+// carries up to DEBUG_SYSLOG_BATCH_BYTES of them, one per line of MSG, each
+// with the device's uptime stamp as on serial; the header carries the UTC of
+// the first line (once SNTP has synced) and a [meta sequenceId sysUpTime]
+// element so a collector can spot lost datagrams. A batch goes out when the
+// next line would not fit or DEBUG_SYSLOG_BATCH_MS after its first line. A
+// token bucket allows DEBUG_SYSLOG_MAX_PER_MIN datagrams a minute; lines that
+// find a full batch and no token are dropped, and the next batch starts by
+// saying how many.
+//
+// Silent while offline: the WiFi state handler passes the state in, and
+// without a connection lines are discarded without touching the network
+// stack. The collector's name is resolved again after every reconnect.
+
+struct SyslogSinkStats {
+    bool enabled;              ///< DEBUG_SYSLOG_HOST set
+    bool online;
+    uint32_t datagrams;        ///< Sent
+    uint32_t lines;            ///< Sent in them
+    uint32_t failures;         ///< Not resolved or not sent
+    uint32_t rateDropped;      ///< Lines over the rate limit
+    uint32_t offlineDropped;   ///< Lines while WiFi was down
+};
+
+// Attaches to the debug log if DEBUG_SYSLOG_HOST is set. Call once in setup().
+void initSyslogSink();
+
+// From the WiFi state handler: true while connected.
+void syslogSinkSetOnline(bool online);
+
+SyslogSinkStats getSyslogSinkStats();
+void printSyslogSink(Print& out);
+
+#endif // SYSLOG_SINK_H
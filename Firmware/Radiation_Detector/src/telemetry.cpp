@@ -0,0 +1,484 @@
+/**
+ * @file telemetry.cpp
+ * @brief Telemetry publisher: flash-backed offline queue and batched line-protocol uploads.
+ *
+ * Records are produced on the UI task at chart-interval boundaries and handed
+ * over through a FreeRTOS queue. Until NTP has synchronised they stay in that
+ * queue (uptime stamps cannot be placed on a server timeline); afterwards the
+ * task converts them to epoch seconds through the disciplined UTC mapping
+ * (time_base.h) and appends them to the flash ring:
+ *
+ *   offset 0   RingHeader (magic, capacity, head, count)
+ *   offset 16  capacity slots of TelemetryRecord, used circularly
+ *
+ * The header is rewritten after every append and every acknowledged batch, so a
+ * reset loses at most the batch in flight (which is then sent twice). When the
+ * ring is full the oldest record is overwritten.
+ *
+ * Event records (telemetryEvent) share the slot layout and go out as their
+ * own measurement; one in the ring sends the batch without waiting for it
+ * to fill. Survey points (telemetrySurvey) share it too, with the position
+ * in place of the averages, and wait for their batch like intervals.
+ * Performance blocks (telemetryPerf) are packed into a slot of their own
+ * layout, PerfRecord, with the flags at the same offset.
+ */
+
+#include "telemetry.h"
+#include "debug.h"
+#include "ethernet_link.h"
+#include "wifi_power.h"
+#include "time_base.h"
+#include "fixed_format.h"
+#include <WiFi.h>
+#include <LittleFS.h>
+#include <HTTPClient.h>
+#include <Preferences.h>
+#include <stddef.h>
+#include "esp_ota_ops.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+
+static const uint32_t RING_MAGIC          = 0x32514C54; ///< "TLQ2": 24-byte slots with the averages
+static const uint32_t BACKOFF_MIN_MS      = 30000;
+static const uint32_t BACKOFF_MAX_MS      = 1800000;
+static const uint32_t REPLAY_GAP_MS       = 1000;       ///< Pause between backlog batches
+static const uint16_t HTTP_TIMEOUT_MS     = 5000;
+
+struct TelemetryRecord {
+    uint32_t timestamp; ///< timeBaseSeconds() while queued in RAM (unless RECORD_FLAG_UTC), epoch seconds on flash
+    float doseRate;     ///< µSv/h averaged over the interval (event: peak cps)
+    float cpm;          ///< Dead-time corrected CPM averaged over the interval (event: background cps)
+    uint16_t seconds;   ///< Interval length (event: seconds so far)
+    uint16_t flags;     ///< RECORD_FLAG_*
+    union {
+        struct {
+            float average1h;    ///< µSv/h, 1 h exponentially weighted average at the interval end
+            float average24h;   ///< ... 24 h
+        };
+        struct {
+            int32_t latE7;      ///< Survey point: degrees * 1e7 (doseRate µSv/h, cpm counts per second)
+            int32_t lonE7;
+        };
+    };
+};
+
+static const uint16_t RECORD_FLAG_UTC = 0x0001;   ///< Stamped with UTC when it was queued
+static const uint16_t RECORD_FLAG_EVENT = 0x0002; ///< Rate anomaly (anomaly_capture.h), not an interval
+static const uint16_t RECORD_FLAG_ENDED = 0x0004; ///< ... the event is over
+static const uint16_t RECORD_FLAG_SURVEY = 0x0008; ///< Geo-tagged survey point (gps_survey.h)
+static const uint16_t RECORD_FLAG_PERF = 0x0010;   ///< Performance block, a PerfRecord
+
+// TelemetryPerf in a ring slot: nine counters around the flags
+struct PerfRecord {
+    uint32_t timestamp;
+    uint16_t jitterP99Us;
+    uint16_t jitterMaxUs;
+    uint16_t flushKBps;
+    uint16_t heapFragPermille;
+    uint16_t heapMinFreeKb;
+    uint16_t flags;
+    uint16_t httpP95Ms;
+    uint16_t httpMaxMs;
+    uint16_t logDropped;
+    uint16_t deadTimePermille;
+};
+
+struct RingHeader {
+    uint32_t magic;
+    uint32_t capacity;
+    uint32_t head;      ///< Slot of the oldest record
+    uint32_t count;     ///< Records in the ring
+};
+
+static_assert(sizeof(TelemetryRecord) == 24, "ring slot layout is stored on flash");
+static_assert(sizeof(PerfRecord) == sizeof(TelemetryRecord) &&
+              offsetof(PerfRecord, flags) == offsetof(TelemetryRecord, flags), "a PerfRecord fills one slot");
+
+static File ringFile;
+static RingHeader ring = {RING_MAGIC, TELEMETRY_QUEUE_CAPACITY, 0, 0};
+static bool flushNow = false; ///< An event record is waiting: send without filling the batch
+static volatile bool flushRequested = false; ///< telemetryFlush(), taken by the task
+static QueueHandle_t telemetryQueue = nullptr;
+static SemaphoreHandle_t settingsMutex = nullptr;
+static String uploadUrl;
+static String uploadToken;
+static String deviceTag;
+static String firmwareTag;    ///< Running version, escaped for a line-protocol tag
+
+static TelemetryStats stats = {false, false, 0, 0, 0, 0, 0};
+
+static bool writeRingHeader() {
+    ringFile.seek(0);
+    bool ok = ringFile.write((const uint8_t*)&ring, sizeof(ring)) == sizeof(ring);
+    ringFile.flush();
+    return ok;
+}
+
+static size_t slotOffset(uint32_t slot) {
+    return sizeof(RingHeader) + (size_t)(slot % ring.capacity) * sizeof(TelemetryRecord);
+}
+
+/**
+ * @brief Opens the ring file, or creates it if missing or of another geometry.
+ */
+static bool openRing() {
+    if (!LittleFS.begin(true)) {
+        DEBUG_PRINTLN("Telemetry: LittleFS mount failed");
+        return false;
+    }
+
+    if (LittleFS.exists(TELEMETRY_QUEUE_PATH)) {
+        ringFile = LittleFS.open(TELEMETRY_QUEUE_PATH, "r+");
+        RingHeader stored;
+        if (ringFile && ringFile.read((uint8_t*)&stored, sizeof(stored)) == sizeof(stored) &&
+            stored.magic == RING_MAGIC && stored.capacity == TELEMETRY_QUEUE_CAPACITY &&
+            stored.head < stored.capacity && stored.count <= stored.capacity) {
+            ring = stored;
+            return true;
+        }
+        if (ringFile) ringFile.close();
+    }
+
+    // Only the header is written; slots are filled as records arrive
+    ringFile = LittleFS.open(TELEMETRY_QUEUE_PATH, "w+");
+    if (!ringFile) return false;
+    ring.head = 0;
+    ring.count = 0;
+    return writeRingHeader();
+}
+
+static void appendToRing(const TelemetryRecord& record) {
+    if (ring.count == ring.capacity) {
+        // Full: overwrite the oldest record
+        ring.head = (ring.head + 1) % ring.capacity;
+        ring.count--;
+        stats.dropped++;
+    }
+    ringFile.seek(slotOffset(ring.head + ring.count));
+    if (ringFile.write((const uint8_t*)&record, sizeof(record)) != sizeof(record)) {
+        stats.dropped++;
+        return;
+    }
+    ring.count++;
+    writeRingHeader();
+}
+
+static bool readRing(uint32_t index, TelemetryRecord* record) {
+    if (!ringFile.seek(slotOffset(ring.head + index))) return false;
+    return ringFile.read((uint8_t*)record, sizeof(*record)) == sizeof(*record);
+}
+
+/**
+ * @brief Moves records from the RAM queue to flash once wall-clock time is known.
+ */
+static void drainQueue() {
+    if (!timeBaseUtcValid()) return;
+
+    TelemetryRecord record;
+    while (xQueueReceive(telemetryQueue, &record, 0) == pdTRUE) {
+        // Same boot, so the monotonic stamp maps straight onto UTC
+        if (!(record.flags & RECORD_FLAG_UTC)) record.timestamp = timeBaseUtcAt(record.timestamp);
+        record.flags |= RECORD_FLAG_UTC;
+        appendToRing(record);
+        if (record.flags & RECORD_FLAG_EVENT) flushNow = true;
+    }
+}
+
+/**
+ * @brief POSTs up to TELEMETRY_BATCH_RECORDS of the oldest records.
+ * @return Records acknowledged by the server (0 on failure)
+ */
+static uint32_t sendBatch() {
+    xSemaphoreTake(settingsMutex, portMAX_DELAY);
+    String url = uploadUrl;
+    String token = uploadToken;
+    xSemaphoreGive(settingsMutex);
+
+    uint32_t batch = ring.count < TELEMETRY_BATCH_RECORDS ? ring.count : TELEMETRY_BATCH_RECORDS;
+    String body;
+    body.reserve(batch * 128);
+    char line[320];
+    TelemetryRecord record;
+    for (uint32_t i = 0; i < batch; i++) {
+        if (!readRing(i, &record)) {
+            batch = i;
+            break;
+        }
+        if (record.flags & RECORD_FLAG_PERF) {
+            // Tagged with the version sending it; fleet updates only run with the network up,
+            // so a block rarely waits across one
+            PerfRecord perf;
+            memcpy(&perf, &record, sizeof(perf));
+            char flush[24] = "";
+            if (perf.flushKBps) snprintf(flush, sizeof(flush), "flush_kbps=%ui,", perf.flushKBps);
+            snprintf(line, sizeof(line),
+                     "radiation_perf,device=%s,fw=%s jitter_p99_us=%ui,jitter_max_us=%ui,%s"
+                     "heap_frag_pm=%ui,heap_min_free_kb=%ui,http_p95_ms=%ui,http_max_ms=%ui,"
+                     "log_dropped=%ui,dead_time_pm=%ui %lu\n",
+                     deviceTag.c_str(), firmwareTag.c_str(), perf.jitterP99Us, perf.jitterMaxUs, flush,
+                     perf.heapFragPermille, perf.heapMinFreeKb, perf.httpP95Ms, perf.httpMaxMs, perf.logDropped,
+                     perf.deadTimePermille, (unsigned long)perf.timestamp);
+            body += line;
+            continue;
+        }
+        // Fixed-point fields without the printf float path (fixed_format.h)
+        char doseRate[16];
+        char cpm[16];
+        char average1h[16];
+        char average24h[16];
+        formatFixed<4>(doseRate, sizeof(doseRate), record.doseRate);
+        formatFixed<2>(cpm, sizeof(cpm), record.cpm);
+        formatFixed<4>(average1h, sizeof(average1h), record.average1h);
+        formatFixed<4>(average24h, sizeof(average24h), record.average24h);
+        if (record.flags & RECORD_FLAG_SURVEY) {
+            // Poisson 1-sigma of the rate from the counts behind it
+            char lat[16];
+            char lon[16];
+            char sigma[16];
+            formatScaled<6>(lat, sizeof(lat), (record.latE7 + (record.latE7 < 0 ? -5 : 5)) / 10);
+            formatScaled<6>(lon, sizeof(lon), (record.lonE7 + (record.lonE7 < 0 ? -5 : 5)) / 10);
+            float counts = record.cpm * record.seconds;
+            formatFixed<2>(sigma, sizeof(sigma), (counts > 1.0f ? sqrtf(counts) : 1.0f) / record.seconds);
+            snprintf(line, sizeof(line),
+                     "radiation_survey,device=%s lat=%s,lon=%s,dose_rate=%s,cps=%s,cps_sigma=%s,seconds=%ui %lu\n",
+                     deviceTag.c_str(), lat, lon, doseRate, cpm, sigma, record.seconds,
+                     (unsigned long)record.timestamp);
+            body += line;
+            continue;
+        }
+        if (record.flags & RECORD_FLAG_EVENT) {
+            snprintf(line, sizeof(line),
+                     "radiation_event,device=%s peak_cps=%s,background_cps=%s,seconds=%ui,ended=%s %lu\n",
+                     deviceTag.c_str(), doseRate, cpm, record.seconds,
+                     (record.flags & RECORD_FLAG_ENDED) ? "true" : "false", (unsigned long)record.timestamp);
+            body += line;
+            continue;
+        }
+        snprintf(line, sizeof(line),
+                 "radiation,device=%s dose_rate=%s,cpm=%s,avg_1h=%s,avg_24h=%s,seconds=%ui %lu\n",
+                 deviceTag.c_str(), doseRate, cpm, average1h, average24h, record.seconds,
+                 (unsigned long)record.timestamp);
+        body += line;
+    }
+    if (batch == 0) return 0;
+
+    HTTPClient http;
+    http.setTimeout(HTTP_TIMEOUT_MS);
+    if (!http.begin(url)) {
+        stats.lastStatus = -1;
+        return 0;
+    }
+    http.addHeader("Content-Type", "text/plain; charset=utf-8");
+    if (token.length()) http.addHeader("Authorization", "Token " + token);
+    int status = http.POST(body);
+    http.end();
+
+    stats.lastStatus = status;
+    return status >= 200 && status < 300 ? batch : 0;
+}
+
+/**
+ * @brief Telemetry task: stores records, uploads batches, replays the backlog with backoff.
+ */
+static void telemetryTask(void* parameter) {
+    uint32_t backoffMs = BACKOFF_MIN_MS;
+    uint64_t nextAttemptMs = 0; // 64-bit: a 32-bit 0 would read as "future" after 24.8 days
+
+    for (;;) {
+        if (!timeBaseUtcValid()) {
+            // Nothing can be stored or sent before NTP sync; records wait in the queue
+            vTaskDelay(pdMS_TO_TICKS(1000));
+            continue;
+        }
+
+        // Wakes on each new record, and at least once a second for the send checks
+        TelemetryRecord peeked;
+        xQueuePeek(telemetryQueue, &peeked, pdMS_TO_TICKS(1000));
+        drainQueue();
+        stats.queued = ring.count;
+        if (flushRequested) {
+            // The link is only up for a while: no batch filling, no backoff left from before
+            flushRequested = false;
+            flushNow = ring.count > 0;
+            nextAttemptMs = 0;
+            backoffMs = BACKOFF_MIN_MS;
+        }
+
+        uint64_t nowMs = timeBaseMs();
+        if (!stats.configured || ring.count == 0 || !networkOnline() ||
+            nowMs < nextAttemptMs) {
+            continue;
+        }
+
+        // Wait for a full batch unless the oldest record has waited long enough or an event is in
+        TelemetryRecord oldest;
+        uint32_t epoch = timeBaseUtcSeconds();
+        if (!flushNow && ring.count < TELEMETRY_BATCH_RECORDS && readRing(0, &oldest) &&
+            epoch - oldest.timestamp < TELEMETRY_FLUSH_INTERVAL_S) {
+            continue;
+        }
+
+        wifiPowerHold(WIFI_WAKE_TELEMETRY); // The response is not held back to the next listen interval
+        uint32_t acked = sendBatch();
+        wifiPowerRelease(WIFI_WAKE_TELEMETRY);
+        if (acked == 0) {
+            stats.failures++;
+            nextAttemptMs = timeBaseMs() + backoffMs;
+            DEBUG_PRINTF("Telemetry: upload failed (%d), retry in %lu s\n",
+                         stats.lastStatus, (unsigned long)(backoffMs / 1000));
+            backoffMs = backoffMs * 2 > BACKOFF_MAX_MS ? BACKOFF_MAX_MS : backoffMs * 2;
+            continue;
+        }
+
+        ring.head = (ring.head + acked) % ring.capacity;
+        ring.count -= acked;
+        if (ring.count == 0) flushNow = false;
+        writeRingHeader();
+        stats.sent += acked;
+        stats.queued = ring.count;
+        backoffMs = BACKOFF_MIN_MS;
+        // Replay a backlog without saturating the link or the server
+        nextAttemptMs = timeBaseMs() + (ring.count >= TELEMETRY_BATCH_RECORDS ? REPLAY_GAP_MS : 0);
+    }
+}
+
+bool initTelemetry() {
+#if TELEMETRY_ENABLED
+    if (telemetryQueue) return true;
+
+    settingsMutex = xSemaphoreCreateMutex();
+    Preferences prefs;
+    prefs.begin("telemetry", true);
+    uploadUrl = prefs.getString("url", "");
+    uploadToken = prefs.getString("token", "");
+    prefs.end();
+    stats.configured = uploadUrl.length() > 0;
+
+    uint8_t mac[6];
+    WiFi.macAddress(mac);
+    char tag[16];
+    snprintf(tag, sizeof(tag), "radscan-%02x%02x%02x", mac[3], mac[4], mac[5]);
+    deviceTag = tag;
+    // Spaces, commas and equals signs end a tag value unless escaped
+    for (const char* c = esp_ota_get_app_description()->version; *c; c++) {
+        if (*c == ' ' || *c == ',' || *c == '=') firmwareTag += '\\';
+        firmwareTag += *c;
+    }
+    if (firmwareTag.length() == 0) firmwareTag = "unknown";
+
+    stats.storage = openRing();
+    if (!stats.storage) return false;
+
+    telemetryQueue = xQueueCreate(TELEMETRY_RAM_QUEUE_DEPTH, sizeof(TelemetryRecord));
+    if (!telemetryQueue) return false;
+
+    xTaskCreatePinnedToCore(telemetryTask, "Telemetry", 6144, NULL,
+                            NETWORK_TASK_PRIORITY, NULL, TASK_CORE_NETWORK);
+    DEBUG_PRINTF("Telemetry: %lu queued records, uploads %s\n",
+                 (unsigned long)ring.count, stats.configured ? "enabled" : "not configured");
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool telemetryRecord(uint32_t timestamp, bool utc, float doseRate, float cpm, uint16_t seconds, float average1h,
+                     float average24h) {
+    if (!telemetryQueue) return false;
+
+    TelemetryRecord record;
+    record.timestamp = timestamp;
+    record.doseRate = doseRate;
+    record.cpm = cpm;
+    record.seconds = seconds;
+    record.flags = utc ? RECORD_FLAG_UTC : 0;
+    record.average1h = average1h;
+    record.average24h = average24h;
+    if (xQueueSend(telemetryQueue, &record, 0) != pdTRUE) {
+        stats.dropped++;
+        return false;
+    }
+    return true;
+}
+
+bool telemetryEvent(uint32_t timestamp, bool utc, float peakCps, float backgroundCps, uint16_t seconds, bool ended) {
+    if (!telemetryQueue) return false;
+
+    TelemetryRecord record = {};
+    record.timestamp = timestamp;
+    record.doseRate = peakCps;
+    record.cpm = backgroundCps;
+    record.seconds = seconds;
+    record.flags = RECORD_FLAG_EVENT | (utc ? RECORD_FLAG_UTC : 0) | (ended ? RECORD_FLAG_ENDED : 0);
+    if (xQueueSend(telemetryQueue, &record, 0) != pdTRUE) {
+        stats.dropped++;
+        return false;
+    }
+    return true;
+}
+
+bool telemetrySurvey(uint32_t timestamp, bool utc, int32_t latE7, int32_t lonE7, float doseRate, float cps,
+                     uint16_t seconds) {
+    if (!telemetryQueue || !seconds) return false;
+
+    TelemetryRecord record = {};
+    record.timestamp = timestamp;
+    record.doseRate = doseRate;
+    record.cpm = cps;
+    record.seconds = seconds;
+    record.flags = RECORD_FLAG_SURVEY | (utc ? RECORD_FLAG_UTC : 0);
+    record.latE7 = latE7;
+    record.lonE7 = lonE7;
+    if (xQueueSend(telemetryQueue, &record, 0) != pdTRUE) {
+        stats.dropped++;
+        return false;
+    }
+    return true;
+}
+
+bool telemetryPerf(uint32_t timestamp, bool utc, const TelemetryPerf& perf) {
+    if (!telemetryQueue) return false;
+
+    PerfRecord packed;
+    packed.timestamp = timestamp;
+    packed.jitterP99Us = perf.jitterP99Us;
+    packed.jitterMaxUs = perf.jitterMaxUs;
+    packed.flushKBps = perf.flushKBps;
+    packed.heapFragPermille = perf.heapFragPermille;
+    packed.heapMinFreeKb = perf.heapMinFreeKb;
+    packed.flags = RECORD_FLAG_PERF | (utc ? RECORD_FLAG_UTC : 0);
+    packed.httpP95Ms = perf.httpP95Ms;
+    packed.httpMaxMs = perf.httpMaxMs;
+    packed.logDropped = perf.logDropped;
+    packed.deadTimePermille = perf.deadTimePermille;
+    TelemetryRecord record;
+    memcpy(&record, &packed, sizeof(record));
+    if (xQueueSend(telemetryQueue, &record, 0) != pdTRUE) {
+        stats.dropped++;
+        return false;
+    }
+    return true;
+}
+
+void telemetryFlush() {
+    flushRequested = true;
+}
+
+void telemetryConfigure(const String& url, const String& token) {
+    Preferences prefs;
+    prefs.begin("telemetry", false);
+    prefs.putString("url", url);
+    prefs.putString("token", token);
+    prefs.end();
+
+    if (settingsMutex) xSemaphoreTake(settingsMutex, portMAX_DELAY);
+    uploadUrl = url;
+    uploadToken = token;
+    stats.configured = url.length() > 0;
+    if (settingsMutex) xSemaphoreGive(settingsMutex);
+}
+
+TelemetryStats getTelemetryStats() {
+    return stats;
+}
@@ -0,0 +1,74 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Batched telemetry upload in InfluxDB line protocol.
+// One record per closed chart interval is queued without blocking; a low-priority
+// task stamps it with wall-clock time and appends it to a bounded ring file on
+// the internal flash (LittleFS). When WiFi is up, full batches are POSTed to the
+// configured /api/v2/write URL; a backlog left from an outage is replayed one
+// batch at a time and paused with exponential backoff whenever a send fails.
+
+struct TelemetryStats {
+    bool storage;        ///< Flash ring file mounted
+    bool configured;     ///< Upload URL set
+    uint32_t queued;     ///< Records waiting in the flash ring
+    uint32_t sent;       ///< Records accepted by the server since boot
+    uint32_t dropped;    ///< Records lost (RAM queue full or ring overwritten)
+    uint32_t failures;   ///< Failed uploads since boot
+    int lastStatus;      ///< HTTP status (or negative HTTPClient error) of the last upload
+};
+
+// Performance counters of one unit (telemetryPerf). Since-boot figures
+// restart with every update, so each firmware version has its own.
+// Values saturate at 65535.
+struct TelemetryPerf {
+    uint16_t jitterP99Us;      ///< Pulse sampling past its deadline, since boot
+    uint16_t jitterMaxUs;
+    uint16_t flushKBps;        ///< History log writes and syncs over the period, kB/s; 0 without any
+    uint16_t heapFragPermille; ///< 1 - largest free block / free internal heap
+    uint16_t heapMinFreeKb;    ///< Internal heap low-water mark since boot
+    uint16_t httpP95Ms;        ///< Route lookup to response sent, since boot
+    uint16_t httpMaxMs;
+    uint16_t logDropped;       ///< Debug log lines dropped over the period
+    uint16_t deadTimePermille; ///< Live time lost to dead time (1 - raw / corrected rate)
+};
+
+// Mounts the flash ring, loads the upload settings and starts the telemetry task.
+bool initTelemetry();
+
+// Queues one interval record. Never blocks; false if it was dropped.
+// @p timestamp is Unix time with @p utc set; otherwise timeBaseSeconds(), which
+// is converted to UTC once the time base has it. @p average1h / @p average24h
+// are the exponentially weighted dose-rate averages (rate_ewma.h) at its end.
+bool telemetryRecord(uint32_t timestamp, bool utc, float doseRate, float cpm, uint16_t seconds, float average1h,
+                     float average24h);
+
+// Queues a rate anomaly (anomaly_capture.h) as a "radiation_event" line: sent
+// with the next upload without waiting for a full batch. Called when the
+// event starts and again with @p ended when it is over.
+bool telemetryEvent(uint32_t timestamp, bool utc, float peakCps, float backgroundCps, uint16_t seconds, bool ended);
+
+// Queues a geo-tagged survey point (gps_survey.h) as a "radiation_survey" line:
+// position in 1e-7 degrees, dose rate and dead-time corrected counts per
+// second averaged over @p seconds.
+bool telemetrySurvey(uint32_t timestamp, bool utc, int32_t latE7, int32_t lonE7, float doseRate, float cps,
+                     uint16_t seconds);
+
+// Queues a performance block as a "radiation_perf" line tagged with the
+// running firmware version, sent with the next batch.
+bool telemetryPerf(uint32_t timestamp, bool utc, const TelemetryPerf& perf);
+
+// Sends everything queued as soon as the network is up, without waiting for
+// a full batch or for the backoff of earlier failures (campaign upload slots).
+void telemetryFlush();
+
+// Sets the InfluxDB write URL (including org/bucket/precision=s) and API token.
+// Saved to Preferences ("telemetry" namespace); an empty URL disables uploads.
+void telemetryConfigure(const String& url, const String& token);
+
+TelemetryStats getTelemetryStats();
+
+#endif // TELEMETRY_H
@@ -0,0 +1,200 @@
+/**
+ * @file time_base.cpp
+ * @brief Monotonic microsecond clock, SNTP-disciplined UTC and its RTC memory copy.
+ *
+ * SNTP results arrive on the lwIP task through the sync notification; the
+ * mapping is shared with every task that stamps records, so it is read and
+ * written under a spinlock (the 64-bit fields are not atomic on the ESP32).
+ * The system clock is still set by SNTP as before; records take their UTC from
+ * the disciplined mapping only.
+ */
+
+#include "time_base.h"
+#include "utc_discipline.h"
+#include "debug.h"
+#include <sys/time.h>
+#include <time.h>
+#include "esp_timer.h"
+#include "esp_sntp.h"
+#include "esp_system.h"
+#include "esp_attr.h"
+#include "esp_rom_crc.h"
+
+static const uint32_t TIME_BASE_MAGIC = 0x54425452;    ///< "RTBT"
+static const int64_t MIN_VALID_UTC_US = 1600000000LL * 1000000LL; ///< Before this the clock is not set
+
+/// Mapping as kept in RTC memory; survives soft resets, not power cycles
+struct TimeBaseRtc {
+    uint32_t magic;
+    int64_t utcUs;      ///< UTC at the time of the copy
+    int32_t freqPpb;
+    uint32_t crc;
+};
+
+RTC_NOINIT_ATTR static TimeBaseRtc rtcCopy;
+
+static UtcDiscipline discipline;
+static portMUX_TYPE timeMux = portMUX_INITIALIZER_UNLOCKED;
+static bool restored = false;
+static bool sntpStarted = false;
+static uint64_t lastCopyMs = 0;
+
+static uint32_t rtcCrc(const TimeBaseRtc& copy) {
+    return esp_rom_crc32_le(0, (const uint8_t*)&copy, offsetof(TimeBaseRtc, crc));
+}
+
+/**
+ * @brief SNTP sync notification (lwIP task): @p tv has just been set as system time.
+ */
+static void onSntpSync(struct timeval* tv) {
+    int64_t mono = esp_timer_get_time();
+    int64_t utc = (int64_t)tv->tv_sec * 1000000LL + tv->tv_usec;
+    if (utc < MIN_VALID_UTC_US) return;
+
+    portENTER_CRITICAL(&timeMux);
+    bool stepped = discipline.sample(mono, utc);
+    int64_t error = discipline.lastErrorUs();
+    int32_t freq = discipline.freqPpb();
+    portEXIT_CRITICAL(&timeMux);
+
+    if (stepped) {
+        DEBUG_PRINTF("Time: UTC stepped (error %lld us)\n", (long long)error);
+    } else {
+        DEBUG_PRINTF("Time: slewing %lld us, frequency %ld ppb\n", (long long)error, (long)freq);
+    }
+}
+
+bool initTimeBase() {
+    sntp_set_time_sync_notification_cb(onSntpSync);
+
+    // Only a soft reset keeps RTC memory; after power-on it holds noise
+    esp_reset_reason_t reason = esp_reset_reason();
+    bool softReset = reason != ESP_RST_POWERON && reason != ESP_RST_BROWNOUT && reason != ESP_RST_UNKNOWN;
+    if (!softReset || rtcCopy.magic != TIME_BASE_MAGIC || rtcCopy.crc != rtcCrc(rtcCopy) ||
+        rtcCopy.utcUs < MIN_VALID_UTC_US) {
+        return false;
+    }
+
+    // The system clock runs on through a soft reset (RTC timer); when it did,
+    // it is better than the copy, which is up to a second old plus the reset
+    int64_t mono = esp_timer_get_time();
+    struct timeval tv;
+    gettimeofday(&tv, nullptr);
+    int64_t systemUs = (int64_t)tv.tv_sec * 1000000LL + tv.tv_usec;
+    int64_t utc = systemUs >= rtcCopy.utcUs ? systemUs : rtcCopy.utcUs + mono;
+
+    portENTER_CRITICAL(&timeMux);
+    discipline.restore(mono, utc, rtcCopy.freqPpb);
+    portEXIT_CRITICAL(&timeMux);
+    restored = true;
+    DEBUG_PRINTF("Time: UTC restored from RTC memory (%lu)\n", (unsigned long)(utc / 1000000));
+    return true;
+}
+
+void timeBaseStartSntp() {
+    if (sntpStarted) return;
+    sntp_set_sync_interval(TIME_SNTP_INTERVAL_S * 1000UL);
+    configTime(0, 0, TIME_SNTP_SERVER_1, TIME_SNTP_SERVER_2);
+    sntpStarted = true;
+}
+
+void timeBaseLoop() {
+    uint64_t now = timeBaseMs();
+    if (now - lastCopyMs < 1000) return;
+    lastCopyMs = now;
+
+    int64_t mono = esp_timer_get_time();
+    portENTER_CRITICAL(&timeMux);
+    bool valid = discipline.valid();
+    int64_t utc = discipline.utcAt(mono);
+    int32_t freq = discipline.freqPpb();
+    portEXIT_CRITICAL(&timeMux);
+    if (!valid) return;
+
+    TimeBaseRtc copy;
+    memset(&copy, 0, sizeof(copy));
+    copy.magic = TIME_BASE_MAGIC;
+    copy.utcUs = utc;
+    copy.freqPpb = freq;
+    copy.crc = rtcCrc(copy);
+    rtcCopy = copy;
+}
+
+int64_t timeBaseUs() {
+    return esp_timer_get_time();
+}
+
+uint64_t timeBaseMs() {
+    return (uint64_t)esp_timer_get_time() / 1000;
+}
+
+uint32_t timeBaseSeconds() {
+    return (uint32_t)(esp_timer_get_time() / 1000000);
+}
+
+bool timeBaseUtcValid() {
+    portENTER_CRITICAL(&timeMux);
+    bool valid = discipline.valid();
+    portEXIT_CRITICAL(&timeMux);
+    return valid;
+}
+
+int64_t timeBaseUtcUs() {
+    int64_t mono = esp_timer_get_time();
+    portENTER_CRITICAL(&timeMux);
+    int64_t utc = discipline.utcAt(mono);
+    portEXIT_CRITICAL(&timeMux);
+    return utc;
+}
+
+uint32_t timeBaseUtcSeconds() {
+    return (uint32_t)(timeBaseUtcUs() / 1000000);
+}
+
+uint32_t timeBaseUtcAt(uint32_t monotonicSeconds) {
+    portENTER_CRITICAL(&timeMux);
+    int64_t utc = discipline.utcAt((int64_t)monotonicSeconds * 1000000LL);
+    portEXIT_CRITICAL(&timeMux);
+    return (uint32_t)(utc / 1000000);
+}
+
+size_t timeBaseFormatUtc(char* out, size_t size) {
+    if (!timeBaseUtcValid()) return 0;
+    time_t utc = (time_t)timeBaseUtcSeconds();
+    struct tm fields;
+    gmtime_r(&utc, &fields);
+    return strftime(out, size, "%Y-%m-%d %H:%M:%S", &fields);
+}
+
+TimeBaseStatus getTimeBaseStatus() {
+    int64_t mono = esp_timer_get_time();
+    TimeBaseStatus status;
+    portENTER_CRITICAL(&timeMux);
+    status.utcValid = discipline.valid();
+    status.samples = discipline.samples();
+    status.steps = discipline.steps();
+    status.freqPpb = discipline.freqPpb();
+    status.lastErrorUs = (int32_t)discipline.lastErrorUs();
+    status.pendingSlewUs = (int32_t)discipline.pendingSlewUs(mono);
+    portEXIT_CRITICAL(&timeMux);
+    status.restored = restored;
+    return status;
+}
+
+void printTimeBase(Print& out) {
+    TimeBaseStatus status = getTimeBaseStatus();
+    out.printf("Time: uptime %llu s, UTC %s", (unsigned long long)(timeBaseUs() / 1000000),
+               status.utcValid ? "" : "not known");
+    if (status.utcValid) {
+        time_t utc = (time_t)timeBaseUtcSeconds();
+        struct tm parts;
+        gmtime_r(&utc, &parts);
+        char text[24];
+        strftime(text, sizeof(text), "%Y-%m-%d %H:%M:%S", &parts);
+        out.print(text);
+        if (status.restored) out.print(" (restored)");
+    }
+    out.printf("\n  %lu SNTP results, %lu stepped, last error %ld us, %ld us to slew, %+ld ppb\n",
+               (unsigned long)status.samples, (unsigned long)status.steps, (long)status.lastErrorUs,
+               (long)status.pendingSlewUs, (long)status.freqPpb);
+}
@@ -0,0 +1,58 @@
+#ifndef TIME_BASE_H
+#define TIME_BASE_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Time base of all records: a 64-bit monotonic microsecond clock
+// (esp_timer, does not wrap) and a UTC mapping on top of it.
+// SNTP results discipline the mapping (utc_discipline.h): small errors are
+// slewed, so UTC neither jumps nor runs backwards, and the oscillator's
+// frequency error is learned. The mapping is kept in RTC memory, so after a
+// soft reset (crash, watchdog, OTA restart) records carry UTC from the first
+// second, before WiFi and SNTP are back. Use the monotonic clock for
+// intervals and UTC only for timestamps that leave the device.
+
+struct TimeBaseStatus {
+    bool utcValid;
+    bool restored;           ///< The mapping came from RTC memory at boot
+    uint32_t samples;        ///< SNTP results since boot
+    uint32_t steps;          ///< Of those, stepped instead of slewed
+    int32_t freqPpb;         ///< Learned oscillator correction
+    int32_t lastErrorUs;     ///< Error of the mapping at the last SNTP result
+    int32_t pendingSlewUs;   ///< Error not yet slewed out
+};
+
+// Restores the mapping from RTC memory and hooks SNTP. Call early in setup().
+bool initTimeBase();
+
+// Starts SNTP (once; it keeps syncing in the background). Needs the network
+// stack, i.e. call after WiFi is initialised; it waits for a connection itself.
+void timeBaseStartSntp();
+
+// Refreshes the RTC memory copy of the mapping once a second (UI task).
+void timeBaseLoop();
+
+// Monotonic time since boot.
+int64_t timeBaseUs();
+uint64_t timeBaseMs();
+uint32_t timeBaseSeconds();
+
+// UTC as Unix time; 0 while the mapping is not valid.
+bool timeBaseUtcValid();
+int64_t timeBaseUtcUs();
+uint32_t timeBaseUtcSeconds();
+
+// UTC of an earlier monotonic instant (timeBaseSeconds() value); 0 if not valid.
+uint32_t timeBaseUtcAt(uint32_t monotonicSeconds);
+
+// Writes the current UTC as "YYYY-MM-DD HH:MM:SS" from the mapping; never
+// waits for SNTP. @return the length, 0 while the mapping is not valid
+size_t timeBaseFormatUtc(char* out, size_t size);
+
+TimeBaseStatus getTimeBaseStatus();
+
+// Prints the mapping and its discipline counters ("time" serial command).
+void printTimeBase(Print& out);
+
+#endif // TIME_BASE_H
@@ -0,0 +1,388 @@
+/**
+ * @file time_sync.cpp
+ * @brief Two-way time transfer over ESP-NOW and the mesh time mapping.
+ *
+ * A unit runs one exchange at a time as a client and answers one at a time
+ * as a server; a request that arrives while the previous answer's follow-up
+ * is still due is dropped, and its client times out and moves on. The send
+ * and receive stamps are taken on the WiFi task, everything else on the
+ * ESP-NOW task. The mapping is read by any task: the ESP-NOW task fits a copy
+ * and swaps it in under a spinlock.
+ */
+
+#include "time_sync.h"
+#include "espnow_link.h"
+#include "mesh_clock.h"
+#include "debug.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+
+static_assert(sizeof(TimeSyncFrame) == 40, "Time sync frame layout is on the air");
+
+typedef MeshClockN<TIME_SYNC_SAMPLES> MeshClock;
+
+static const uint8_t RX_QUEUE_DEPTH = 8;
+static const uint32_t EXCHANGE_TIMEOUT_MS = 500;
+static const uint32_t FOLLOW_UP_TIMEOUT_MS = 200;   ///< Server: the response never reported as sent
+static const uint32_t SERVER_TIMEOUT_MS = 3 * TIME_SYNC_INTERVAL_S * 1000UL;
+static const uint8_t BROADCAST[6] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+
+struct RxItem {
+    uint8_t from[6];
+    int64_t rxUs;
+    TimeSyncFrame frame;
+};
+
+static QueueHandle_t rxQueue = nullptr;
+
+// Send stamps, written on the WiFi task
+static portMUX_TYPE stampMux = portMUX_INITIALIZER_UNLOCKED;
+static int64_t requestSentUs = 0;
+static int64_t responseSentUs = 0;
+static bool requestStamped = false;
+static bool responseStamped = false;
+
+// Mapping, read by any task
+static portMUX_TYPE clockMux = portMUX_INITIALIZER_UNLOCKED;
+static MeshClock meshClock;
+static uint32_t lastSyncMs = 0;
+static volatile uint8_t currentRole = ESPNOW_ROLE_OFF;
+
+// ESP-NOW task only
+struct ServerEntry {
+    bool known;
+    uint8_t mac[6];
+    uint8_t stratum;
+    uint32_t heardMs;
+};
+static ServerEntry server;
+static const uint8_t* ownAddress = nullptr;
+static bool exchangeOpen = false;
+static bool gotResponse = false;
+static uint16_t exchangeSequence = 0;
+static uint32_t exchangeStartMs = 0;
+static int64_t responseReceivedUs = 0;
+static uint8_t burstLeft = 0;
+static bool burstRunning = false;
+static uint32_t lastBurstMs = 0;
+static bool bestValid = false;
+static int64_t bestLocalUs = 0;
+static int64_t bestOffsetUs = 0;
+static uint32_t bestDelayUs = 0;
+static bool followUpPending = false;
+static uint8_t followUpTo[6];
+static uint16_t followUpSequence = 0;
+static int64_t followUpT2 = 0;
+static uint32_t followUpSinceMs = 0;
+static uint32_t lastBeaconMs = 0;
+static TimeSyncStatus counters;
+
+static bool synced(uint32_t nowMs) {
+    if (currentRole == ESPNOW_ROLE_HUB) return true;
+    portENTER_CRITICAL(&clockMux);
+    bool valid = meshClock.valid();
+    uint32_t since = lastSyncMs;
+    portEXIT_CRITICAL(&clockMux);
+    return valid && currentRole == ESPNOW_ROLE_NODE && nowMs - since < TIME_SYNC_HOLDOVER_S * 1000UL;
+}
+
+static uint8_t ownStratum(uint32_t nowMs) {
+    if (currentRole == ESPNOW_ROLE_HUB) return 0;
+    if (!synced(nowMs) || !server.known) return TIME_SYNC_NO_STRATUM;
+    return server.stratum + 1;
+}
+
+/**
+ * @brief Mesh time of a local stamp for frames this unit serves (ESP-NOW task).
+ */
+static int64_t serveTime(int64_t localUs) {
+    if (currentRole == ESPNOW_ROLE_HUB) return localUs;
+    return meshClock.meshAt(localUs); // Only the ESP-NOW task writes it
+}
+
+void timeSyncReceive(const uint8_t* from, const uint8_t* data, int length, int64_t rxUs) {
+    if (length != sizeof(TimeSyncFrame) || !rxQueue) return;
+    RxItem item;
+    memcpy(item.from, from, sizeof(item.from));
+    item.rxUs = rxUs;
+    memcpy(&item.frame, data, sizeof(item.frame));
+    xQueueSend(rxQueue, &item, 0);
+}
+
+void timeSyncSent(uint8_t tag, int64_t txUs, bool ok) {
+    if (!ok) return;
+    portENTER_CRITICAL(&stampMux);
+    if (tag == TIME_SYNC_TAG_REQUEST) {
+        requestSentUs = txUs;
+        requestStamped = true;
+    } else if (tag == TIME_SYNC_TAG_RESPONSE) {
+        responseSentUs = txUs;
+        responseStamped = true;
+    }
+    portEXIT_CRITICAL(&stampMux);
+}
+
+static void sendFrame(uint8_t type, const uint8_t* to, uint16_t sequence, uint8_t stratum, uint8_t tag,
+                      int64_t t2Us = 0, int64_t t3Us = 0) {
+    TimeSyncFrame frame;
+    memset(&frame, 0, sizeof(frame));
+    frame.magic = TIME_SYNC_MAGIC;
+    frame.version = TIME_SYNC_VERSION;
+    frame.type = type;
+    memcpy(frame.from, ownAddress, 6);
+    memcpy(frame.to, to, 6);
+    frame.stratum = stratum;
+    frame.sequence = sequence;
+    frame.t2Us = t2Us;
+    frame.t3Us = t3Us;
+    espNowSendTagged(&frame, sizeof(frame), tag);
+}
+
+/**
+ * @brief Picks the time server: the lowest stratum heard, the current one while it is fresh.
+ */
+static void onBeacon(const TimeSyncFrame& frame, uint32_t nowMs) {
+    if (currentRole != ESPNOW_ROLE_NODE || frame.stratum >= TIME_SYNC_MAX_STRATUM) return;
+    bool current = server.known && memcmp(server.mac, frame.from, 6) == 0;
+    bool stale = !server.known || nowMs - server.heardMs >= SERVER_TIMEOUT_MS;
+    if (!current && !stale && frame.stratum >= server.stratum) return;
+    if (!current) {
+        DEBUG_PRINTF("Time sync: server %02X:%02X:%02X:%02X:%02X:%02X, stratum %u\n", frame.from[0],
+                     frame.from[1], frame.from[2], frame.from[3], frame.from[4], frame.from[5], frame.stratum);
+        exchangeOpen = false;
+        burstRunning = false;
+        burstLeft = 0;
+        lastBurstMs = nowMs - TIME_SYNC_INTERVAL_S * 1000UL; // Burst right away
+    }
+    server.known = true;
+    memcpy(server.mac, frame.from, 6);
+    server.stratum = frame.stratum;
+    server.heardMs = nowMs;
+}
+
+static void onRequest(const RxItem& item, uint32_t nowMs) {
+    uint8_t stratum = ownStratum(nowMs);
+    if (stratum >= TIME_SYNC_MAX_STRATUM || followUpPending) return;
+    followUpPending = true;
+    memcpy(followUpTo, item.from, 6);
+    followUpSequence = item.frame.sequence;
+    followUpT2 = serveTime(item.rxUs);
+    followUpSinceMs = nowMs;
+    portENTER_CRITICAL(&stampMux);
+    responseStamped = false;
+    portEXIT_CRITICAL(&stampMux);
+    sendFrame(TIME_SYNC_RESPONSE, item.from, item.frame.sequence, stratum, TIME_SYNC_TAG_RESPONSE);
+}
+
+static bool fromServer(const RxItem& item) {
+    return exchangeOpen && server.known && memcmp(item.from, server.mac, 6) == 0 &&
+           item.frame.sequence == exchangeSequence;
+}
+
+static void onFollowUp(const RxItem& item) {
+    if (!fromServer(item) || !gotResponse) return;
+    portENTER_CRITICAL(&stampMux);
+    bool stamped = requestStamped;
+    int64_t t1 = requestSentUs;
+    portEXIT_CRITICAL(&stampMux);
+    exchangeOpen = false;
+    if (!stamped) return;
+
+    int64_t t2 = item.frame.t2Us;
+    int64_t t3 = item.frame.t3Us;
+    int64_t t4 = responseReceivedUs;
+    int64_t delay = (t4 - t1) - (t3 - t2);
+    if (delay < 0 || delay > (int64_t)EXCHANGE_TIMEOUT_MS * 1000) return;
+    counters.exchanges++;
+    if (!bestValid || (uint32_t)delay < bestDelayUs) {
+        bestValid = true;
+        bestDelayUs = (uint32_t)delay;
+        bestOffsetUs = ((t2 - t1) + (t3 - t4)) / 2;
+        bestLocalUs = t1 + (t4 - t1) / 2;
+    }
+}
+
+/**
+ * @brief Feeds the burst's best exchange into a copy of the mapping and swaps it in.
+ */
+static void closeBurst(uint32_t nowMs) {
+    burstRunning = false;
+    if (!bestValid) return;
+    MeshClock next = meshClock;
+    bool restarted = next.add(bestLocalUs, bestOffsetUs, TIME_SYNC_STEP_US);
+    portENTER_CRITICAL(&clockMux);
+    meshClock = next;
+    lastSyncMs = nowMs;
+    portEXIT_CRITICAL(&clockMux);
+    counters.lastDelayUs = bestDelayUs;
+    counters.lastErrorUs = (int32_t)next.lastErrorUs();
+    if (restarted) {
+        DEBUG_PRINTF("Time sync: mesh offset %lld us (round trip %lu us)\n", (long long)bestOffsetUs,
+                     (unsigned long)bestDelayUs);
+    }
+}
+
+static void runClient(uint32_t nowMs) {
+    if (currentRole != ESPNOW_ROLE_NODE || !server.known || nowMs - server.heardMs >= SERVER_TIMEOUT_MS) return;
+    if (exchangeOpen && nowMs - exchangeStartMs >= EXCHANGE_TIMEOUT_MS) {
+        exchangeOpen = false;
+        counters.timeouts++;
+    }
+    if (!burstRunning && nowMs - lastBurstMs >= TIME_SYNC_INTERVAL_S * 1000UL) {
+        burstRunning = true;
+        burstLeft = TIME_SYNC_BURST;
+        bestValid = false;
+        lastBurstMs = nowMs;
+        counters.bursts++;
+    }
+    if (!burstRunning || exchangeOpen) return;
+    if (burstLeft == 0) {
+        closeBurst(nowMs);
+        return;
+    }
+    burstLeft--;
+    exchangeOpen = true;
+    gotResponse = false;
+    exchangeSequence++;
+    exchangeStartMs = nowMs;
+    portENTER_CRITICAL(&stampMux);
+    requestStamped = false;
+    portEXIT_CRITICAL(&stampMux);
+    sendFrame(TIME_SYNC_REQUEST, server.mac, exchangeSequence, TIME_SYNC_NO_STRATUM, TIME_SYNC_TAG_REQUEST);
+}
+
+static void runServer(uint32_t nowMs) {
+    if (followUpPending) {
+        portENTER_CRITICAL(&stampMux);
+        bool stamped = responseStamped;
+        int64_t t3 = responseSentUs;
+        portEXIT_CRITICAL(&stampMux);
+        if (stamped) {
+            sendFrame(TIME_SYNC_FOLLOW_UP, followUpTo, followUpSequence, ownStratum(nowMs), TIME_SYNC_TAG_NONE,
+                      followUpT2, serveTime(t3));
+            followUpPending = false;
+            counters.served++;
+        } else if (nowMs - followUpSinceMs >= FOLLOW_UP_TIMEOUT_MS) {
+            followUpPending = false;
+        }
+    }
+    uint8_t stratum = ownStratum(nowMs);
+    if (stratum < TIME_SYNC_MAX_STRATUM && nowMs - lastBeaconMs >= TIME_SYNC_INTERVAL_S * 1000UL) {
+        lastBeaconMs = nowMs;
+        sendFrame(TIME_SYNC_BEACON, BROADCAST, 0, stratum, TIME_SYNC_TAG_NONE);
+    }
+}
+
+void timeSyncPoll(uint8_t role, const uint8_t* ownMac, uint32_t nowMs) {
+    if (!rxQueue) {
+        rxQueue = xQueueCreate(RX_QUEUE_DEPTH, sizeof(RxItem));
+        if (!rxQueue) return;
+    }
+    currentRole = role;
+    ownAddress = ownMac;
+
+    RxItem item;
+    while (xQueueReceive(rxQueue, &item, 0) == pdTRUE) {
+        const TimeSyncFrame& frame = item.frame;
+        if (frame.magic != TIME_SYNC_MAGIC || frame.version != TIME_SYNC_VERSION) continue;
+        if (frame.type != TIME_SYNC_BEACON && memcmp(frame.to, ownMac, 6) != 0) continue;
+        switch (frame.type) {
+        case TIME_SYNC_BEACON:
+            onBeacon(frame, nowMs);
+            break;
+        case TIME_SYNC_REQUEST:
+            onRequest(item, nowMs);
+            break;
+        case TIME_SYNC_RESPONSE:
+            if (fromServer(item)) {
+                responseReceivedUs = item.rxUs;
+                gotResponse = true;
+            }
+            break;
+        case TIME_SYNC_FOLLOW_UP:
+            onFollowUp(item);
+            break;
+        }
+    }
+    runServer(nowMs);
+    runClient(nowMs);
+}
+
+bool timeSyncMeshAt(int64_t localUs, int64_t& meshUs) {
+    if (currentRole == ESPNOW_ROLE_HUB) {
+        meshUs = localUs;
+        return true;
+    }
+    if (!synced(millis())) return false;
+    portENTER_CRITICAL(&clockMux);
+    meshUs = meshClock.meshAt(localUs);
+    portEXIT_CRITICAL(&clockMux);
+    return true;
+}
+
+bool timeSyncMeshAt32(uint32_t localUs, int64_t& meshUs) {
+    int64_t now = esp_timer_get_time();
+    return timeSyncMeshAt(now - (uint32_t)((uint32_t)now - localUs), meshUs);
+}
+
+TimeSyncStatus getTimeSyncStatus() {
+    uint32_t nowMs = millis();
+    TimeSyncStatus s = counters;
+    s.synced = synced(nowMs);
+    s.stratum = ownStratum(nowMs);
+    memcpy(s.server, server.mac, 6);
+    s.serverStratum = server.known ? server.stratum : TIME_SYNC_NO_STRATUM;
+    int64_t now = esp_timer_get_time();
+    portENTER_CRITICAL(&clockMux);
+    bool valid = meshClock.valid();
+    s.offsetUs = valid && currentRole == ESPNOW_ROLE_NODE ? meshClock.offsetAt(now) : 0;
+    s.driftPpb = meshClock.driftPpb();
+    s.residualUs = meshClock.residualUs();
+    s.steps = meshClock.steps();
+    s.lastSyncAgeS = valid ? (nowMs - lastSyncMs) / 1000 : 0;
+    portEXIT_CRITICAL(&clockMux);
+    return s;
+}
+
+void buildTimeSyncJson(JsonObject obj) {
+    TimeSyncStatus s = getTimeSyncStatus();
+    obj["synced"] = s.synced;
+    if (s.stratum != TIME_SYNC_NO_STRATUM) obj["stratum"] = s.stratum;
+    if (currentRole == ESPNOW_ROLE_NODE && s.serverStratum != TIME_SYNC_NO_STRATUM) {
+        char mac[18];
+        snprintf(mac, sizeof(mac), "%02X:%02X:%02X:%02X:%02X:%02X", s.server[0], s.server[1], s.server[2],
+                 s.server[3], s.server[4], s.server[5]);
+        obj["server"] = mac;
+        obj["offset_us"] = s.offsetUs;
+        obj["drift_ppb"] = s.driftPpb;
+        obj["residual_us"] = s.residualUs;
+        obj["round_trip_us"] = s.lastDelayUs;
+        obj["age_s"] = s.lastSyncAgeS;
+    }
+    obj["exchanges"] = s.exchanges;
+    obj["timeouts"] = s.timeouts;
+    obj["served"] = s.served;
+}
+
+void printTimeSync(Print& out) {
+    TimeSyncStatus s = getTimeSyncStatus();
+    if (currentRole == ESPNOW_ROLE_HUB) {
+        out.printf("Mesh time: reference (stratum 0), %lu requests served\n", (unsigned long)s.served);
+        return;
+    }
+    if (s.serverStratum == TIME_SYNC_NO_STRATUM) {
+        out.println("Mesh time: no time server heard");
+        return;
+    }
+    out.printf("Mesh time: %s, server %02X:%02X:%02X:%02X:%02X:%02X (stratum %u)\n",
+               s.synced ? "synced" : "not synced", s.server[0], s.server[1], s.server[2], s.server[3], s.server[4],
+               s.server[5], s.serverStratum);
+    out.printf("  offset %lld us, drift %+ld ppb, fit residual %lu us, last error %ld us, round trip %lu us, "
+               "%lu s ago\n",
+               (long long)s.offsetUs, (long)s.driftPpb, (unsigned long)s.residualUs, (long)s.lastErrorUs,
+               (unsigned long)s.lastDelayUs, (unsigned long)s.lastSyncAgeS);
+    out.printf("  %lu bursts, %lu exchanges, %lu timeouts, %lu restarts, %lu served\n", (unsigned long)s.bursts,
+               (unsigned long)s.exchanges, (unsigned long)s.timeouts, (unsigned long)s.steps,
+               (unsigned long)s.served);
+}
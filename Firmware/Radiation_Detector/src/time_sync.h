@@ -0,0 +1,102 @@
+#ifndef TIME_SYNC_H
+#define TIME_SYNC_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "config.h"
+
+// Mesh time: one microsecond timebase shared by the units of an ESP-NOW ring
+// (espnow_link.h), for comparing per-pulse timestamps across detectors
+// (coincidences, localisation) far closer than SNTP over WiFi allows.
+// The hub's monotonic clock is the mesh time. Units hear who serves time
+// from beacons (the hub every TIME_SYNC_INTERVAL_S, and every synced node
+// one stratum further out), pick the server with the lowest stratum and run
+// PTP-style two-way exchanges with it:
+//   client REQUEST   sent at t1 (local)
+//   server           received at t2, answers at t3 (both mesh time)
+//   client RESPONSE  received at t4 (local); the FOLLOW_UP carries t2 and t3
+//   offset = ((t2 - t1) + (t3 - t4)) / 2,  round trip = (t4 - t1) - (t3 - t2)
+// Send times are taken in the ESP-NOW send callback, once the frame has
+// left, and receive times first thing in the receive callback, so both ends
+// see the same radio and WiFi task latencies and those cancel; the server's
+// own processing between t2 and t3 is taken out exactly. Each burst keeps
+// its shortest round trip and feeds the drift fit (mesh_clock.h).
+//
+// This disciplines a mapping, not the clock itself: esp_timer stays the
+// local monotonic time of every record, and timeSyncMeshAt() converts a local
+// timestamp (a pulse capture time, say) into mesh time while the unit is
+// synced. Mesh times of two synced units are directly comparable; the
+// expected error is the fit residual plus the round-trip asymmetry, tens of
+// microseconds between neighbours.
+
+#define TIME_SYNC_MAGIC   0x5354 // "TS"
+#define TIME_SYNC_VERSION 1
+#define TIME_SYNC_NO_STRATUM 255
+
+enum TimeSyncFrameType {
+    TIME_SYNC_BEACON = 1,
+    TIME_SYNC_REQUEST,
+    TIME_SYNC_RESPONSE,
+    TIME_SYNC_FOLLOW_UP
+};
+
+// On-air record, little-endian. Routed by its magic on the ESP-NOW link.
+struct TimeSyncFrame {
+    uint16_t magic;
+    uint8_t version;
+    uint8_t type;           ///< TimeSyncFrameType
+    uint8_t from[6];
+    uint8_t to[6];          ///< Broadcast for beacons
+    uint8_t stratum;        ///< Sender's: 0 for the hub
+    uint8_t reserved;
+    uint16_t sequence;      ///< Exchange, chosen by the client
+    uint32_t reserved2;
+    int64_t t2Us;           ///< FOLLOW_UP: request received, mesh time
+    int64_t t3Us;           ///< FOLLOW_UP: response sent, mesh time
+};
+
+struct TimeSyncStatus {
+    bool synced;            ///< Mapping fresher than TIME_SYNC_HOLDOVER_S (always on the hub)
+    uint8_t stratum;        ///< TIME_SYNC_NO_STRATUM if not synced
+    uint8_t server[6];
+    uint8_t serverStratum;
+    int64_t offsetUs;       ///< Mesh minus local time now
+    int32_t driftPpb;
+    uint32_t residualUs;    ///< RMS of the drift fit
+    int32_t lastErrorUs;    ///< Last burst against the prediction
+    uint32_t lastDelayUs;   ///< Round trip of the last burst's best exchange
+    uint32_t lastSyncAgeS;
+    uint32_t bursts;
+    uint32_t exchanges;     ///< Completed
+    uint32_t timeouts;
+    uint32_t steps;         ///< Fit restarts
+    uint32_t served;        ///< Requests answered
+};
+
+// Link hooks (espnow_link.cpp). Receive and send callbacks run on the WiFi
+// task and only stamp and queue; the rest runs from timeSyncPoll() on the
+// ESP-NOW task.
+void timeSyncReceive(const uint8_t* from, const uint8_t* data, int length, int64_t rxUs);
+void timeSyncSent(uint8_t tag, int64_t txUs, bool ok);
+void timeSyncPoll(uint8_t role, const uint8_t* ownMac, uint32_t nowMs);
+
+// Tags of the frames whose send time is needed (0: none).
+enum TimeSyncTag : uint8_t {
+    TIME_SYNC_TAG_NONE = 0,
+    TIME_SYNC_TAG_REQUEST,
+    TIME_SYNC_TAG_RESPONSE
+};
+
+// Mesh time at local monotonic @p localUs (esp_timer). false while not synced.
+bool timeSyncMeshAt(int64_t localUs, int64_t& meshUs);
+
+// Same for a 32-bit capture timestamp (pulse_capture.h) from the last ~71 minutes.
+bool timeSyncMeshAt32(uint32_t localUs, int64_t& meshUs);
+
+TimeSyncStatus getTimeSyncStatus();
+
+void buildTimeSyncJson(JsonObject obj);
+
+void printTimeSync(Print& out);
+
+#endif // TIME_SYNC_H
@@ -0,0 +1,435 @@
+/**
+ * @file timeseries_view.cpp
+ * @brief Min/max column renderer for the long count-rate history.
+ *
+ * lv_chart keeps one point per sample and redraws every bar and tick label on
+ * each refresh, which does not scale to 3600 one-second points. This view
+ * keeps one decimated slot per pixel column instead. Slot k covers the
+ * absolute time range [k * spc, (k + 1) * spc), so the same slot always holds
+ * the same data: when the right edge moves (new data, scrolling) the cached
+ * slots are shifted and only the ones that came into view are read from the
+ * history store. The newest slot is re-read while it is still filling.
+ *
+ * Drawing happens in the LV_EVENT_DRAW_MAIN handler: grid lines and columns
+ * are written straight into the draw buffer, clipped to the area being
+ * refreshed, and the cached label strings go through lv_draw_label(). While
+ * the right edge stays put only the strips of changed columns are invalidated.
+ */
+
+#include "config.h"
+
+#if !HEADLESS
+
+#include "timeseries_view.h"
+#include "history_range.h"
+#include "config.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+static const uint16_t MAX_COLUMNS = 400;
+static const lv_coord_t LABEL_WIDTH = 36;  ///< Y labels left of the plot
+static const lv_coord_t LABEL_HEIGHT = 16; ///< X labels below the plot
+static const uint8_t Y_TICKS = 5;         ///< Round steps for a 1, 2 or 5 top
+static const uint8_t X_TICKS = 4;        ///< Intervals; X_TICKS + 1 labels
+
+struct ZoomLevel {
+    uint32_t spanSeconds;
+    const char* name;
+};
+
+static const ZoomLevel ZOOMS[TIMESERIES_ZOOM_COUNT] = {
+    {3600, "1 h"}, {6 * 3600, "6 h"}, {24 * 3600, "24 h"},
+    {7 * 86400, "7 d"}, {30 * 86400, "30 d"}, {365 * 86400, "1 y"},
+};
+
+static lv_obj_t* view = nullptr;
+static lv_obj_t* overObj = nullptr;
+static const HistoryStore* store = nullptr;
+
+static TimeSeriesZoom zoom = TIMESERIES_ZOOM_1H;
+static HistoryLevel level = HISTORY_LEVEL_SECOND;
+static uint32_t spc = 10;          ///< Seconds per column
+static uint16_t columns = 0;       ///< Plot width in columns
+static bool following = true;      ///< The right edge tracks the newest data
+static bool cacheValid = false;
+static int32_t cacheEnd = 0;       ///< Slot shown in the rightmost column
+static int32_t newestSlot = 0;     ///< Slot of the newest second in the store
+
+// Per column: decimated bucket rates (cps) and their heights in pixels
+static float colMin[MAX_COLUMNS];
+static float colMax[MAX_COLUMNS];
+static float colMean[MAX_COLUMNS];
+static bool colHas[MAX_COLUMNS];
+static int16_t pxMin[MAX_COLUMNS];
+static int16_t pxMax[MAX_COLUMNS];
+static int16_t pxMean[MAX_COLUMNS];
+
+static float usvPerCps = 0.0f;
+static float scaleTop = 0.0f;      ///< µSv/h at the top of the plot
+static char yLabels[Y_TICKS + 1][8];
+static char xLabels[X_TICKS + 1][8];
+static char title[24];
+static int32_t labelOffset = -1;   ///< newestSlot - cacheEnd the x labels were formatted for
+static uint32_t lastUpdateMs = 0;
+
+static const lv_color_t COLOR_SPAN = LV_COLOR_MAKE(0x45, 0x6F, 0x08);
+static const lv_color_t COLOR_MEAN = LV_COLOR_MAKE(0x89, 0xDE, 0x10);
+static const lv_color_t COLOR_GRID = LV_COLOR_MAKE(0x40, 0x40, 0x40);
+
+static void plotArea(lv_area_t* plot) {
+    lv_obj_get_content_coords(view, plot);
+    plot->x1 += LABEL_WIDTH;
+    plot->y2 -= LABEL_HEIGHT;
+}
+
+/**
+ * @brief Reads the history buckets of @p slot into column @p index.
+ *
+ * The slot is one point of a HistoryRange with the slot length as step, the
+ * same kernel /api/history decimates with (history_range.h).
+ */
+static void decimate(int32_t slot, uint16_t index) {
+    colHas[index] = false;
+    if (slot < 0) return;
+    uint32_t start = (uint32_t)slot * spc;
+    HistoryRange range(*store, level, start, start + spc - 1, spc);
+    HistoryBucket point;
+    if (!range.next(&point) || point.seconds == 0) return;
+    colMin[index] = range.lowRate();
+    colMax[index] = range.highRate();
+    colMean[index] = point.meanCps();
+    colHas[index] = true;
+}
+
+/**
+ * @brief Moves the cached columns so that @p end is the rightmost slot and
+ *        decimates the slots that were not cached.
+ * @return true if every column moved (the whole plot needs a redraw)
+ */
+static bool syncColumns(int32_t end, uint16_t* dirtyFirst) {
+    int32_t shift = end - cacheEnd;
+    if (!cacheValid || shift >= columns || -shift >= columns) {
+        for (uint16_t i = 0; i < columns; i++) decimate(end - (columns - 1) + i, i);
+        cacheEnd = end;
+        cacheValid = true;
+        *dirtyFirst = 0;
+        return true;
+    }
+
+    uint16_t keep = columns - (uint16_t)(shift < 0 ? -shift : shift);
+    if (shift > 0) {
+        memmove(colMin, colMin + shift, keep * sizeof(colMin[0]));
+        memmove(colMax, colMax + shift, keep * sizeof(colMax[0]));
+        memmove(colMean, colMean + shift, keep * sizeof(colMean[0]));
+        memmove(colHas, colHas + shift, keep * sizeof(colHas[0]));
+    } else if (shift < 0) {
+        memmove(colMin - shift, colMin, keep * sizeof(colMin[0]));
+        memmove(colMax - shift, colMax, keep * sizeof(colMax[0]));
+        memmove(colMean - shift, colMean, keep * sizeof(colMean[0]));
+        memmove(colHas - shift, colHas, keep * sizeof(colHas[0]));
+        for (uint16_t i = 0; i < (uint16_t)-shift; i++) decimate(end - (columns - 1) + i, i);
+    }
+    cacheEnd = end;
+
+    // New slots on the right, plus the slot that was newest and may have filled up
+    int32_t first = shift > 0 ? keep - 1 : columns - 1;
+    if (first < 0) first = 0;
+    for (int32_t i = first; i < columns; i++) decimate(end - (columns - 1) + i, (uint16_t)i);
+    *dirtyFirst = (uint16_t)first;
+    return shift != 0;
+}
+
+/**
+ * @brief Top of the Y axis: 1, 2 or 5 times a power of ten above @p value.
+ */
+static float niceTop(float value) {
+    if (value <= 0.0f) return 0.1f;
+    float decade = powf(10.0f, floorf(log10f(value)));
+    float steps[] = {1.0f, 2.0f, 5.0f, 10.0f};
+    for (uint8_t i = 0; i < 4; i++) {
+        if (value <= steps[i] * decade) return steps[i] * decade;
+    }
+    return 10.0f * decade;
+}
+
+static void formatYLabels() {
+    for (uint8_t i = 0; i <= Y_TICKS; i++) {
+        float value = scaleTop * i / Y_TICKS;
+        int decimals = scaleTop < 1.0f ? 2 : (scaleTop < 10.0f ? 1 : 0);
+        snprintf(yLabels[i], sizeof(yLabels[i]), "%.*f", decimals, value);
+    }
+}
+
+static void formatAgo(char* out, size_t size, uint32_t seconds) {
+    if (seconds == 0) snprintf(out, size, "now");
+    else if (seconds < 3600) snprintf(out, size, "-%lum", (unsigned long)(seconds / 60));
+    else if (seconds < 2 * 86400) snprintf(out, size, "-%luh", (unsigned long)(seconds / 3600));
+    else snprintf(out, size, "-%lud", (unsigned long)(seconds / 86400));
+}
+
+static void formatXLabels() {
+    int32_t offset = newestSlot - cacheEnd;
+    for (uint8_t i = 0; i <= X_TICKS; i++) {
+        int32_t fromRight = (int32_t)(columns - 1) * (X_TICKS - i) / X_TICKS;
+        formatAgo(xLabels[i], sizeof(xLabels[i]), (uint32_t)(offset + fromRight) * spc);
+    }
+    snprintf(title, sizeof(title), "%s  uSv/h%s", ZOOMS[zoom].name, following ? "" : "  (hold)");
+    labelOffset = offset;
+}
+
+static void scaleColumn(uint16_t i, lv_coord_t height) {
+    if (!colHas[i] || scaleTop <= 0.0f) return;
+    float k = usvPerCps * (height - 1) / scaleTop;
+    pxMin[i] = (int16_t)lroundf(colMin[i] * k);
+    pxMax[i] = (int16_t)lroundf(colMax[i] * k);
+    pxMean[i] = (int16_t)lroundf(colMean[i] * k);
+    if (pxMax[i] > height - 1) pxMax[i] = height - 1;
+    if (pxMean[i] > height - 1) pxMean[i] = height - 1;
+    if (pxMin[i] > height - 1) pxMin[i] = height - 1;
+}
+
+/**
+ * @brief Picks the finest history level that still retains the zoom span and
+ *        the whole number of buckets per column closest to the span over the
+ *        plot width.
+ */
+static void selectLevel() {
+    uint32_t span = ZOOMS[zoom].spanSeconds;
+    level = HISTORY_LEVEL_HOUR;
+    for (uint8_t l = 0; l < HISTORY_LEVEL_COUNT; l++) {
+        HistoryLevel candidate = (HistoryLevel)l;
+        if (HistoryStore::capacity(candidate) * HistoryStore::bucketSeconds(candidate) >= span) {
+            level = candidate;
+            break;
+        }
+    }
+    uint32_t bucket = HistoryStore::bucketSeconds(level);
+    uint32_t width = columns ? columns : MAX_COLUMNS;
+    spc = (span / width + bucket / 2) / bucket * bucket; // Nearest whole number of buckets
+    if (spc == 0) spc = bucket;
+}
+
+/**
+ * @brief Brings the columns up to date and invalidates what changed. With
+ *        @p force set, the plot is redrawn even if no column changed.
+ */
+static void refresh(bool force) {
+    lv_area_t plot;
+    plotArea(&plot);
+    uint16_t width = (uint16_t)lv_area_get_width(&plot);
+    if (width > MAX_COLUMNS) width = MAX_COLUMNS;
+    if (width != columns) {
+        columns = width;
+        cacheValid = false;
+        selectLevel();
+    }
+    if (columns == 0) return;
+
+    HistoryBucket newest;
+    if (!store || !store->summarizeRecent(HISTORY_LEVEL_SECOND, 1, &newest)) return; // No data yet
+    newestSlot = (int32_t)(newest.startTime / spc);
+    int32_t end = following ? newestSlot : cacheEnd;
+
+    uint16_t dirtyFirst = columns;
+    bool moved = syncColumns(end, &dirtyFirst) || force;
+
+    float peak = 0.0f;
+    for (uint16_t i = 0; i < columns; i++) {
+        if (colHas[i] && colMax[i] > peak) peak = colMax[i];
+    }
+    float top = niceTop(peak * usvPerCps * 1.1f);
+    lv_coord_t height = lv_area_get_height(&plot);
+    if (top != scaleTop) {
+        scaleTop = top;
+        formatYLabels();
+        moved = true;
+    }
+    if (newestSlot - cacheEnd != labelOffset) {
+        formatXLabels();
+        moved = true;
+    }
+
+    if (moved) {
+        for (uint16_t i = 0; i < columns; i++) scaleColumn(i, height);
+        lv_obj_invalidate(view);
+    } else {
+        for (uint16_t i = dirtyFirst; i < columns; i++) scaleColumn(i, height);
+        lv_area_t strip = plot;
+        strip.x1 = plot.x1 + dirtyFirst;
+        lv_obj_invalidate_area(view, &strip);
+    }
+}
+
+/**
+ * @brief Writes a vertical span into the draw buffer, clipped to the refreshed area.
+ */
+static void drawSpan(lv_draw_ctx_t* ctx, lv_coord_t x, lv_coord_t y1, lv_coord_t y2, lv_color_t color) {
+    const lv_area_t* clip = ctx->clip_area;
+    if (x < clip->x1 || x > clip->x2) return;
+    if (y1 < clip->y1) y1 = clip->y1;
+    if (y2 > clip->y2) y2 = clip->y2;
+    lv_color_t* buf = (lv_color_t*)ctx->buf;
+    lv_coord_t stride = lv_area_get_width(ctx->buf_area);
+    lv_color_t* p = buf + (y1 - ctx->buf_area->y1) * stride + (x - ctx->buf_area->x1);
+    for (lv_coord_t y = y1; y <= y2; y++, p += stride) *p = color;
+}
+
+static void drawText(lv_draw_ctx_t* ctx, lv_draw_label_dsc_t* dsc, lv_coord_t x1, lv_coord_t y1,
+                     lv_coord_t x2, const char* text) {
+    lv_area_t area;
+    area.x1 = x1;
+    area.x2 = x2;
+    area.y1 = y1;
+    area.y2 = y1 + lv_font_get_line_height(dsc->font);
+    lv_draw_label(ctx, dsc, &area, text, NULL);
+}
+
+static void drawCb(lv_event_t* e) {
+    lv_draw_ctx_t* ctx = lv_event_get_draw_ctx(e);
+    lv_area_t plot;
+    plotArea(&plot);
+    lv_coord_t height = lv_area_get_height(&plot);
+
+    // Dotted grid at the Y ticks, then the columns
+    lv_area_t clip;
+    if (_lv_area_intersect(&clip, ctx->clip_area, &plot)) {
+        for (uint8_t t = 1; t <= Y_TICKS; t++) {
+            lv_coord_t y = plot.y2 - (height - 1) * t / Y_TICKS;
+            if (y < clip.y1 || y > clip.y2) continue;
+            lv_coord_t x = plot.x1 + (clip.x1 - plot.x1 + 3) / 4 * 4; // Every fourth pixel
+            for (; x <= clip.x2; x += 4) drawSpan(ctx, x, y, y, COLOR_GRID);
+        }
+        for (lv_coord_t x = clip.x1; x <= clip.x2; x++) {
+            uint16_t i = (uint16_t)(x - plot.x1);
+            if (i >= columns || !colHas[i]) continue;
+            drawSpan(ctx, x, plot.y2 - pxMax[i], plot.y2 - pxMin[i], COLOR_SPAN);
+            drawSpan(ctx, x, plot.y2 - pxMean[i], plot.y2 - pxMean[i], COLOR_MEAN);
+        }
+    }
+
+    // Cached labels
+    lv_draw_label_dsc_t dsc;
+    lv_draw_label_dsc_init(&dsc);
+    dsc.color = lv_color_white();
+    dsc.font = LV_FONT_DEFAULT;
+    lv_coord_t lineHeight = lv_font_get_line_height(dsc.font);
+    dsc.align = LV_TEXT_ALIGN_RIGHT;
+    for (uint8_t t = 0; t <= Y_TICKS; t++) {
+        lv_coord_t y = plot.y2 - (height - 1) * t / Y_TICKS - lineHeight / 2;
+        if (y < plot.y1) y = plot.y1;
+        drawText(ctx, &dsc, plot.x1 - LABEL_WIDTH, y, plot.x1 - 4, yLabels[t]);
+    }
+    for (uint8_t t = 0; t <= X_TICKS; t++) {
+        lv_coord_t x = plot.x1 + (lv_area_get_width(&plot) - 1) * t / X_TICKS;
+        if (t == 0) dsc.align = LV_TEXT_ALIGN_LEFT;
+        else if (t == X_TICKS) dsc.align = LV_TEXT_ALIGN_RIGHT;
+        else dsc.align = LV_TEXT_ALIGN_CENTER;
+        lv_coord_t x1 = t == 0 ? x : (t == X_TICKS ? x - 48 : x - 24);
+        drawText(ctx, &dsc, x1, plot.y2 + 2, x1 + 48, xLabels[t]);
+    }
+    dsc.align = LV_TEXT_ALIGN_RIGHT;
+    dsc.color = COLOR_MEAN;
+    drawText(ctx, &dsc, plot.x1, plot.y1, plot.x2 - 2, title);
+}
+
+static void eventCb(lv_event_t* e) {
+    lv_event_code_t code = lv_event_get_code(e);
+    if (code == LV_EVENT_SHORT_CLICKED) {
+        timeSeriesViewSetZoom((TimeSeriesZoom)((zoom + 1) % TIMESERIES_ZOOM_COUNT));
+    } else if (code == LV_EVENT_LONG_PRESSED) {
+        timeSeriesViewShow(false);
+    } else if (code == LV_EVENT_GESTURE) {
+        lv_dir_t dir = lv_indev_get_gesture_dir(lv_indev_get_act());
+        if (dir == LV_DIR_RIGHT) timeSeriesViewScroll(columns / 4);
+        if (dir == LV_DIR_LEFT) timeSeriesViewScroll(-(int32_t)(columns / 4));
+        lv_indev_wait_release(lv_indev_get_act());
+    } else if (code == LV_EVENT_DELETE) {
+        view = nullptr;
+        overObj = nullptr;
+        cacheValid = false;
+    }
+}
+
+static void overClickedCb(lv_event_t* e) {
+    timeSeriesViewShow(true);
+}
+
+void timeSeriesViewAttach(lv_obj_t* parent, lv_obj_t* over, const HistoryStore* history) {
+    store = history;
+    overObj = over;
+    lv_obj_update_layout(over); // Its size and position are read below
+    view = lv_obj_create(parent);
+    lv_obj_set_size(view, lv_obj_get_width(over), lv_obj_get_height(over));
+    lv_obj_align_to(view, over, LV_ALIGN_CENTER, 0, 0);
+    lv_obj_set_style_bg_color(view, lv_color_black(), LV_PART_MAIN);
+    lv_obj_set_style_pad_all(view, 4, LV_PART_MAIN);
+    lv_obj_clear_flag(view, LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_GESTURE_BUBBLE);
+    lv_obj_add_flag(view, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_add_event_cb(view, drawCb, LV_EVENT_DRAW_MAIN, NULL);
+    lv_obj_add_event_cb(view, eventCb, LV_EVENT_ALL, NULL);
+
+    lv_obj_add_flag(over, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_add_event_cb(over, overClickedCb, LV_EVENT_CLICKED, NULL);
+
+    cacheValid = false;
+    labelOffset = -1;
+    scaleTop = 0.0f;
+    timeSeriesViewSetZoom(zoom);
+}
+
+void timeSeriesViewShow(bool show) {
+    if (!view) return;
+    if (show) {
+        lv_obj_clear_flag(view, LV_OBJ_FLAG_HIDDEN);
+        if (overObj) lv_obj_add_flag(overObj, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_update_layout(view);
+        refresh(true);
+    } else {
+        lv_obj_add_flag(view, LV_OBJ_FLAG_HIDDEN);
+        if (overObj) lv_obj_clear_flag(overObj, LV_OBJ_FLAG_HIDDEN);
+    }
+}
+
+bool timeSeriesViewShown() {
+    return view && !lv_obj_has_flag(view, LV_OBJ_FLAG_HIDDEN);
+}
+
+void timeSeriesViewSetZoom(TimeSeriesZoom next) {
+    zoom = next < TIMESERIES_ZOOM_COUNT ? next : TIMESERIES_ZOOM_1H;
+    selectLevel();
+    following = true;
+    cacheValid = false;
+    labelOffset = -1;
+    if (timeSeriesViewShown()) refresh(true);
+}
+
+void timeSeriesViewScroll(int32_t delta) {
+    if (!timeSeriesViewShown() || !cacheValid) return;
+    int32_t end = cacheEnd - delta;
+
+    // Not past the oldest retained bucket, not beyond the newest slot
+    HistoryBucket oldest;
+    if (store->read(level, 0, &oldest, 1) == 1) {
+        int32_t oldestEnd = (int32_t)(oldest.startTime / spc) + columns - 1;
+        if (end < oldestEnd) end = oldestEnd;
+    }
+    following = end >= newestSlot;
+    if (following) end = newestSlot;
+
+    uint16_t dirtyFirst;
+    syncColumns(end, &dirtyFirst);
+    labelOffset = -1;
+    refresh(true);
+}
+
+void timeSeriesViewUpdate(uint32_t nowMs, float usvHPerCps) {
+    if (!timeSeriesViewShown()) return;
+    bool rescale = usvHPerCps != usvPerCps;
+    usvPerCps = usvHPerCps;
+    if (!rescale && nowMs - lastUpdateMs < TIMESERIES_VIEW_INTERVAL_MS) return;
+    lastUpdateMs = nowMs;
+    refresh(rescale);
+}
+
+#endif // !HEADLESS
@@ -0,0 +1,47 @@
+#ifndef TIMESERIES_VIEW_H
+#define TIMESERIES_VIEW_H
+
+#include <lvgl.h>
+#include "history_store.h"
+
+// Long time-series plot of the multi-resolution history (history_store.h).
+// Every pixel column is one time slot at the current zoom; its min/max bucket
+// rate and mean are decimated from the finest history level that covers the
+// span, cached, and drawn straight into LVGL's draw buffer as a vertical span
+// with the mean on top. Scrolling and following new data shift the cached
+// columns and decimate only the slots that came into view; the axis labels are
+// formatted only when the scale, zoom or scroll position changes.
+//
+// Touch: tap cycles the zoom (1 h ... 1 y), swipe left / right scrolls by a
+// quarter of the span, long press hides the view again. LVGL task only.
+
+enum TimeSeriesZoom {
+    TIMESERIES_ZOOM_1H = 0,
+    TIMESERIES_ZOOM_6H,
+    TIMESERIES_ZOOM_24H,
+    TIMESERIES_ZOOM_7D,
+    TIMESERIES_ZOOM_30D,
+    TIMESERIES_ZOOM_1Y,
+    TIMESERIES_ZOOM_COUNT
+};
+
+// Creates the (hidden) view on @p parent with the size and position of
+// @p over. The view removes itself when its screen is deleted.
+void timeSeriesViewAttach(lv_obj_t* parent, lv_obj_t* over, const HistoryStore* store);
+
+// Shows the view in front of @p over, or hides it.
+void timeSeriesViewShow(bool show);
+
+bool timeSeriesViewShown();
+
+void timeSeriesViewSetZoom(TimeSeriesZoom zoom);
+
+// Scrolls by @p columns pixel columns (positive: towards older data). Scrolling
+// back to the newest data resumes following it.
+void timeSeriesViewScroll(int32_t columns);
+
+// Follows new data at most every TIMESERIES_VIEW_INTERVAL_MS while shown.
+// @p usvHPerCps converts the count rate to the displayed dose rate.
+void timeSeriesViewUpdate(uint32_t nowMs, float usvHPerCps);
+
+#endif // TIMESERIES_VIEW_H
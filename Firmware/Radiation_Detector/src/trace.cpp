@@ -0,0 +1,133 @@
+/**
+ * @file trace.cpp
+ * @brief Trace ring storage and the text dump read by tools/trace_to_perfetto.py.
+ *
+ * Dump format, one record per line:
+ *
+ *   # rdtrace 1
+ *   # mhz <cpu clock>
+ *   # sync <core> <ccount> <esp_timer us>     taken on each core at dump time
+ *   # event <id> <phase> <name>               phase: B/E span, i instant, C counter
+ *   <core> <ccount> <id> <arg0> <arg1>        oldest first
+ *
+ * Each core has its own 32-bit cycle counter, which wraps every ~18 s at 240 MHz
+ * and is not aligned with the other core's. The converter walks each core's
+ * events backwards from its sync point, adding a wrap whenever the counter
+ * increases, and places both cores on the esp_timer timeline. pulseTask records
+ * at 20 Hz and uiTask at least every UI_TASK_MAX_SLEEP_MS (both on core 1 in
+ * the default topology, config.h); a core without events has nothing to place.
+ */
+
+#include "trace.h"
+#include "esp_ipc.h"
+
+TraceEvent traceRing[TRACE_RING_SIZE];
+std::atomic<uint32_t> traceHead(0);
+volatile bool traceRecording = TRACE_ENABLED;
+
+struct TraceEventInfo {
+    uint16_t id;
+    char phase;
+    const char* name;
+};
+
+static const TraceEventInfo TRACE_EVENTS[] = {
+    {TRACE_PULSE_POLL_BEGIN, 'B', "pulse_poll"},
+    {TRACE_PULSE_POLL_END, 'E', "pulse_poll"},
+    {TRACE_PULSE_BURST, 'i', "pulse_burst"},
+    {TRACE_PULSE_SECOND, 'C', "counts_per_second"},
+    {TRACE_SPECTRUM_BIN, 'C', "spectrum_binned"},
+    {TRACE_LVGL_BEGIN, 'B', "lv_timer_handler"},
+    {TRACE_LVGL_END, 'E', "lv_timer_handler"},
+    {TRACE_UI_UPDATE_BEGIN, 'B', "ui_update"},
+    {TRACE_UI_UPDATE_END, 'E', "ui_update"},
+    {TRACE_ALARM_STATE, 'C', "alarm"},
+    {TRACE_PULSE_RANGE, 'C', "counter_range"},
+};
+
+struct TraceSync {
+    uint32_t cycles;
+    int64_t timeUs;
+};
+
+/**
+ * @brief Runs on the target core's IPC task: reads its cycle counter and esp_timer together.
+ */
+static void takeSync(void* arg) {
+    TraceSync* sync = (TraceSync*)arg;
+    sync->timeUs = esp_timer_get_time();
+    sync->cycles = esp_cpu_get_ccount();
+}
+
+void traceSetRecording(bool on) {
+    traceRecording = on && TRACE_ENABLED;
+}
+
+void traceClear() {
+    bool was = traceRecording;
+    traceRecording = false;
+    traceHead.store(0, std::memory_order_relaxed);
+    traceRecording = was;
+}
+
+void traceDump(Print& out) {
+    bool was = traceRecording;
+    traceRecording = false;
+
+    out.println("# rdtrace 1");
+    out.printf("# mhz %lu\n", (unsigned long)getCpuFrequencyMhz());
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        TraceSync sync = {0, 0};
+        if (esp_ipc_call_blocking(core, takeSync, &sync) == ESP_OK) {
+            out.printf("# sync %d %lu %lld\n", core, (unsigned long)sync.cycles, (long long)sync.timeUs);
+        }
+    }
+    for (size_t i = 0; i < sizeof(TRACE_EVENTS) / sizeof(TRACE_EVENTS[0]); i++) {
+        out.printf("# event %u %c %s\n", TRACE_EVENTS[i].id, TRACE_EVENTS[i].phase, TRACE_EVENTS[i].name);
+    }
+
+    uint32_t head = traceHead.load(std::memory_order_relaxed);
+    uint32_t count = head < TRACE_RING_SIZE ? head : TRACE_RING_SIZE;
+    for (uint32_t n = head - count; n != head; n++) {
+        const TraceEvent& e = traceRing[n & (TRACE_RING_SIZE - 1)];
+        out.printf("%u %lu %u %lu %lu\n", e.core, (unsigned long)e.cycles, e.id, (unsigned long)e.arg0,
+                   (unsigned long)e.arg1);
+    }
+
+    traceRecording = was;
+}
+
+/**
+ * @brief Print adapter that sends its output as ~1 KB HTTP chunks.
+ */
+class ChunkedPrint : public Print {
+public:
+    explicit ChunkedPrint(WebServer& server) : server_(server), length_(0) {}
+
+    size_t write(uint8_t c) override {
+        buffer_[length_++] = (char)c;
+        if (length_ == sizeof(buffer_)) flush();
+        return 1;
+    }
+
+    void flush() override {
+        if (length_ == 0) return;
+        server_.sendContent(buffer_, length_);
+        length_ = 0;
+    }
+
+private:
+    WebServer& server_;
+    char buffer_[1024];
+    size_t length_;
+};
+
+void traceDumpHttp(WebServer& server) {
+    server.sendHeader("Access-Control-Allow-Origin", "*");
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN); // Chunked transfer encoding
+    server.send(200, "text/plain", "");
+    ChunkedPrint out(server);
+    traceDump(out);
+    out.flush();
+    server.sendContent(""); // Terminating zero-length chunk
+}
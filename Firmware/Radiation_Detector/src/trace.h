@@ -0,0 +1,81 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <Arduino.h>
+#include <WebServer.h>
+#include <atomic>
+#include "esp_cpu.h"
+#include "config.h"
+
+// Lightweight event trace for timing work in the hot paths.
+// TRACE_EVENT(id, arg0, arg1) stores the CPU cycle counter, the core and two
+// arguments in a RAM ring: no formatting, no locks, no I/O. The ring is dumped
+// as text over serial ("trace dump") or /api/trace and turned into a Chrome
+// trace / Perfetto file on the host by tools/trace_to_perfetto.py.
+//
+// Safe from tasks and regular interrupts on either core. Not from IRAM ISRs that
+// run while the flash cache is off: traceRecord() itself is not placed in IRAM.
+
+enum TraceEventId {
+    TRACE_PULSE_POLL_BEGIN = 1, ///< pulseTask poll
+    TRACE_PULSE_POLL_END,       ///< arg0: counts since the previous poll
+    TRACE_PULSE_BURST,          ///< arg0: counts in one poll (> 5)
+    TRACE_PULSE_SECOND,         ///< arg0: counts in the closed second
+    TRACE_SPECTRUM_BIN,         ///< arg0: pulses binned, arg1: 1 if some wait for the next poll
+    TRACE_LVGL_BEGIN,           ///< lv_timer_handler() on uiTask
+    TRACE_LVGL_END,
+    TRACE_UI_UPDATE_BEGIN,      ///< Stats, labels, charts and alarms on uiTask
+    TRACE_UI_UPDATE_END,
+    TRACE_ALARM_STATE,          ///< arg0: AlarmLevel now sounding (0 silent)
+    TRACE_PULSE_RANGE,          ///< arg0: 1 if the high-range tube is counted (counter_range.h)
+    TRACE_EVENT_COUNT
+};
+
+struct TraceEvent {
+    uint32_t cycles;  ///< CCOUNT of the recording core
+    uint16_t id;      ///< TraceEventId
+    uint8_t core;
+    uint8_t reserved;
+    uint32_t arg0;
+    uint32_t arg1;
+};
+
+extern TraceEvent traceRing[TRACE_RING_SIZE];
+extern std::atomic<uint32_t> traceHead; ///< Events ever recorded; slot = head % size
+extern volatile bool traceRecording;
+
+/**
+ * @brief Records one event. A slot is claimed with one atomic increment, so
+ *        concurrent writers on both cores never share a slot.
+ */
+inline void traceRecord(uint16_t id, uint32_t arg0, uint32_t arg1) {
+    if (!traceRecording) return;
+    uint32_t slot = traceHead.fetch_add(1, std::memory_order_relaxed) & (TRACE_RING_SIZE - 1);
+    TraceEvent& event = traceRing[slot];
+    event.cycles = esp_cpu_get_ccount();
+    event.id = id;
+    event.core = (uint8_t)xPortGetCoreID();
+    event.arg0 = arg0;
+    event.arg1 = arg1;
+}
+
+#if TRACE_ENABLED
+#define TRACE_EVENT(id, arg0, arg1) traceRecord((id), (uint32_t)(arg0), (uint32_t)(arg1))
+#else
+#define TRACE_EVENT(id, arg0, arg1) do {} while (0)
+#endif
+
+// Pauses or resumes recording (on at boot when TRACE_ENABLED).
+void traceSetRecording(bool on);
+
+// Discards recorded events.
+void traceClear();
+
+// Writes the ring, oldest first, with the header the host converter needs.
+// Recording pauses while the ring is read.
+void traceDump(Print& out);
+
+// Sends traceDump() as a chunked text/plain response.
+void traceDumpHttp(WebServer& server);
+
+#endif // TRACE_H
@@ -0,0 +1,147 @@
+#ifndef TRAPEZOID_SHAPER_H
+#define TRAPEZOID_SHAPER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <math.h>
+#include <string.h>
+
+// Recursive trapezoidal shaping filter (Jordanov & Knoll) for the ADC samples
+// of the scintillation channel, run ahead of the PulseHeightDetector.
+//
+// An exponential pulse A*exp(-n/tau) becomes a trapezoid of height A that
+// rises over `rise` samples, stays flat for `flat` samples and falls back over
+// `rise` samples. The height is an average over the whole rise window rather
+// than the single highest sample, so white noise on the trapezoid's top is
+// about sqrt(rise) times smaller than on the raw peak, and the flat top makes
+// the height insensitive to where in the pulse the maximum lands. The pole-zero
+// term `decay` (tau in samples, Q8) cancels the exponential tail; 0 treats the
+// input as short pulses, whose trapezoid height is then their area.
+//
+//   d[n] = v[n] - v[n-k] - v[n-k-m] + v[n-2k-m]   (k = rise, m = flat)
+//   p[n] = p[n-1] + d[n]
+//   s[n] = s[n-1] + p[n] + M*d[n]                  (M = 1/(exp(1/tau)-1))
+//   out  = s / (k * (M + 1))
+//
+// The difference d has no DC gain and the two accumulators are exact integers,
+// so a constant input gives exactly zero and nothing drifts: the whole filter
+// is equivalent to a finite response. Internally they wrap as uint32_t
+// (modular arithmetic), which is harmless as long as the true s fits into an
+// int32_t; configure() rejects settings where a full-scale 12-bit pulse
+// would not.
+//
+// Samples are handled in blocks of TRAPEZOID_BLOCK: the four-tap difference
+// runs over a contiguous window (the delay line followed by the block), which
+// the compiler vectorises; only the two accumulators are a serial loop.
+// The output is offset by TRAPEZOID_OFFSET and clamped to 0..32767, so the
+// detector sees an ordinary unipolar pulse on a flat baseline and the
+// pulse-kernel screening (int16 chunk maxima) still applies.
+// No Arduino dependencies (host-compilable).
+
+#define TRAPEZOID_MAX_DELAY 128  ///< 2 * rise + flat, samples
+#define TRAPEZOID_BLOCK 64
+#define TRAPEZOID_OFFSET 512     ///< Output baseline, codes
+
+class TrapezoidShaper {
+public:
+    TrapezoidShaper() : rise_(0), flat_(0), decayQ8_(0), mQ8_(0), primed_(false), p_(0), s_(0), recip_(0) {
+        configure(8, 4, 0);
+    }
+
+    /**
+     * @brief Sets the shape; the delay line restarts.
+     * @param rise    Rise (and fall) time in samples, >= 1
+     * @param flat    Flat-top length in samples
+     * @param decayQ8 Decay time constant of the input pulses in samples, Q8 (0: short pulses)
+     * @return false (and nothing changed) if the delay line is too short or the gain could overflow
+     */
+    bool configure(uint16_t rise, uint16_t flat, uint32_t decayQ8) {
+        if (!valid(rise, flat, decayQ8)) return false;
+        uint32_t mQ8 = poleZeroQ8(decayQ8);
+        rise_ = rise;
+        flat_ = flat;
+        decayQ8_ = decayQ8;
+        mQ8_ = mQ8;
+        recip_ = (uint32_t)((1ull << 32) / ((uint64_t)rise * (mQ8 + 256)));
+        reset();
+        return true;
+    }
+
+    /// True if configure() would accept these settings.
+    static bool valid(uint16_t rise, uint16_t flat, uint32_t decayQ8) {
+        if (rise == 0 || 2u * rise + flat > TRAPEZOID_MAX_DELAY) return false;
+        // Peak of s for a full-scale pulse: 4095 * k * (M + 1) * 256
+        return (uint64_t)4095 * rise * (poleZeroQ8(decayQ8) + 256) < 0x7FFFFFFFull;
+    }
+
+    uint16_t rise() const { return rise_; }
+    uint16_t flat() const { return flat_; }
+    uint32_t decayQ8() const { return decayQ8_; }
+
+    /// Forgets the delay line (e.g. after a gap in the sample stream).
+    void reset() { primed_ = false; }
+
+    /// Shapes @p count samples from @p in into @p out (may not alias).
+    void process(const uint16_t* in, uint16_t* out, size_t count) {
+        if (count == 0) return;
+        size_t delay = 2u * rise_ + flat_;
+        if (!primed_) {
+            // Start as if the first sample had been there forever: d = 0
+            for (size_t i = 0; i < delay; i++) window_[i] = in[0];
+            p_ = s_ = 0;
+            primed_ = true;
+        }
+        size_t k = rise_, l = rise_ + flat_;
+        while (count) {
+            size_t n = count < TRAPEZOID_BLOCK ? count : TRAPEZOID_BLOCK;
+            memcpy(window_ + delay, in, n * sizeof(uint16_t));
+            const uint16_t* v = window_ + delay; // v[i - j] is valid for j <= delay
+            for (size_t i = 0; i < n; i++) {
+                diff_[i] = (int32_t)v[i] - v[(ptrdiff_t)i - (ptrdiff_t)k] - v[(ptrdiff_t)i - (ptrdiff_t)l] +
+                           v[(ptrdiff_t)i - (ptrdiff_t)delay];
+            }
+            for (size_t i = 0; i < n; i++) {
+                uint32_t d = (uint32_t)diff_[i];
+                p_ += d;
+                s_ += (p_ << 8) + mQ8_ * d;
+                int32_t height = (int32_t)(((int64_t)(int32_t)s_ * recip_) >> 32) + TRAPEZOID_OFFSET;
+                out[i] = height < 0 ? 0 : height > 32767 ? 32767 : (uint16_t)height;
+            }
+            memmove(window_, window_ + n, delay * sizeof(uint16_t));
+            in += n;
+            out += n;
+            count -= n;
+        }
+    }
+
+    /**
+     * @brief Samples from the start of a pulse to the sample that armed the detector.
+     *
+     * The trapezoid rises linearly over the rise time, so a pulse of
+     * @p height crosses a trigger @p threshold after rise * threshold / height.
+     */
+    uint32_t armDelay(uint16_t height, uint16_t threshold) const {
+        if (height <= threshold) return rise_;
+        return ((uint32_t)rise_ * threshold + height / 2) / height;
+    }
+
+private:
+    /// M = 1 / (exp(1/tau) - 1) in Q8 for tau in samples (Q8); 0 for tau = 0.
+    static uint32_t poleZeroQ8(uint32_t tauQ8) {
+        if (tauQ8 == 0) return 0;
+        return (uint32_t)(256.0 / expm1(256.0 / tauQ8) + 0.5);
+    }
+
+    uint16_t rise_;
+    uint16_t flat_;
+    uint32_t decayQ8_;
+    uint32_t mQ8_;
+    bool primed_;
+    uint32_t p_;               ///< First accumulator (wraps)
+    uint32_t s_;               ///< Second accumulator, Q8 (wraps)
+    uint32_t recip_;           ///< 2^32 / (k * (M + 1) * 256)
+    uint16_t window_[TRAPEZOID_MAX_DELAY + TRAPEZOID_BLOCK];
+    int32_t diff_[TRAPEZOID_BLOCK];
+};
+
+#endif // TRAPEZOID_SHAPER_H
@@ -0,0 +1,318 @@
+/**
+ * @file tube_health.cpp
+ * @brief Inter-arrival histogram, tube checks, their web endpoint and serial report.
+ *
+ * Everything but the published report belongs to pulseTask: the histogram is
+ * fed from the timestamp drain and evaluated on the second close, so the
+ * pulse path costs one subtraction and a bin lookup. The report is about
+ * 500 bytes and is published through a SeqLock once per window.
+ */
+
+#include "tube_health.h"
+#include "command_bus.h"
+#include "device_config.h"
+#include "hv_control.h"
+#include "plateau_scan.h"
+#include "seqlock.h"
+#include "debug.h"
+#include "json_body.h"
+#include "json_arena.h"
+#include "web_arena.h"
+#include <ArduinoJson.h>
+
+static const uint32_t HV_DRIFT_SECONDS = 60;   ///< Off target this long before it counts
+static const float BASELINE_HOURS = 24.0f;     ///< Time constant of the rate baseline
+static const float MIN_SHORT_INTERVALS = 10.0f;
+static const uint32_t MIN_WINDOW_INTERVALS = 100;
+
+// pulseTask state
+static InterArrivalHistogram histogram;
+static IntervalMoments window;
+static RateBaseline rateBaseline;
+static uint32_t lastTimestampUs = 0;
+static bool haveLast = false;
+static bool sawTimestamps = false;
+static uint32_t windowCounts = 0;
+static uint32_t windowSeconds = 0;
+static uint32_t agingSeconds = 0;
+static uint32_t evaluatedSeconds = 0;
+static uint32_t hvDriftSeconds = 0;
+static uint8_t lastFlags = 0;
+
+static SeqLock<TubeHealthReport> reportLock;
+static WebServer* tubeServer = nullptr;
+
+void tubeHealthPulse(uint32_t timestampUs) {
+    if (haveLast) {
+        uint32_t us = timestampUs - lastTimestampUs;
+        histogram.add(us);
+        window.add(us);
+    }
+    lastTimestampUs = timestampUs;
+    haveLast = true;
+    sawTimestamps = true;
+}
+
+/**
+ * @brief Runs the checks over the histogram and the last window and publishes
+ *        the report.
+ */
+static void evaluate() {
+    static TubeHealthReport r; // About 500 bytes, kept off the stack
+    static PlateauScanStatus plateau; // About 1 KB
+    DeviceConfig config = getDeviceConfig();
+    float tau = config.deadTimeUs;
+    memset(&r, 0, sizeof(r));
+    r.timestamps = sawTimestamps;
+    r.seconds = evaluatedSeconds;
+    r.configuredDeadTimeUs = tau;
+    r.total = histogram.total();
+    r.meanUs = histogram.meanUs();
+    memcpy(r.bins, histogram.counts(), sizeof(r.bins));
+    uint8_t flags = 0;
+
+    if (tau > 0.0f && r.total > 0.0f) {
+        r.deadTime = estimateDeadTime(histogram, tau, TUBE_HEALTH_MIN_BELOW);
+        if (r.deadTime.valid) {
+            float allowed = fmaxf(0.25f * tau, 3.0f * r.deadTime.sigmaUs);
+            if (fabsf(r.deadTime.us - tau) > allowed) flags |= TUBE_FLAG_DEAD_TIME;
+        }
+
+        float expected = 0.0f;
+        float observed = shortIntervalExcess(histogram, tau, &expected);
+        r.afterpulseRatio = expected > 0.0f ? observed / expected : 0.0f;
+        if (expected > 0.0f && r.afterpulseRatio > TUBE_AFTERPULSE_RATIO &&
+            observed - expected > 5.0f * sqrtf(expected)) {
+            flags |= TUBE_FLAG_AFTERPULSING;
+        }
+
+        float shortCount = histogram.countBelowBin(InterArrivalHistogram::binAtOrAbove(0.5f * tau));
+        r.shortFraction = shortCount / r.total;
+        if (shortCount >= MIN_SHORT_INTERVALS && r.shortFraction > TUBE_DOUBLE_TRIGGER_FRACTION) {
+            flags |= TUBE_FLAG_DOUBLE_TRIGGER;
+        }
+    }
+
+    // A counting tube at m tau has CV 1 - m tau; discharge is nearly periodic
+    r.windowCps = windowSeconds ? (float)windowCounts / windowSeconds : 0.0f;
+    float busy = r.windowCps * tau * 1e-6f;
+    r.expectedCv = busy < 1.0f ? 1.0f - busy : 0.0f;
+    r.windowCv = window.cv();
+    if (window.count() >= MIN_WINDOW_INTERVALS && busy > 0.2f && r.windowCv < 0.5f * r.expectedCv) {
+        flags |= TUBE_FLAG_DISCHARGE;
+    }
+
+    r.baselineCps = rateBaseline.baselineCps();
+    r.rateRatio = rateBaseline.lastRatio();
+    r.rateZ = rateBaseline.lastZ();
+    r.baselineHours = rateBaseline.hours();
+    if (rateBaseline.shifted()) flags |= TUBE_FLAG_RATE_SHIFT;
+
+    HvStatus hv = getHvStatus();
+    if (hv.running) {
+        r.hvMeasuredV = hv.measuredV;
+        r.hvTargetV = hv.targetV;
+        if (hvDriftSeconds >= HV_DRIFT_SECONDS) flags |= TUBE_FLAG_HV_DRIFT;
+    }
+    plateau = getPlateauScanStatus();
+    if (plateau.fit.valid) {
+        r.kneeV = plateau.fit.kneeV;
+        if (config.hvTargetV < plateau.fit.kneeV) flags |= TUBE_FLAG_HV_BELOW_PLATEAU;
+    }
+
+    r.flags = flags;
+    if (flags & (TUBE_FLAG_AFTERPULSING | TUBE_FLAG_DOUBLE_TRIGGER | TUBE_FLAG_DISCHARGE)) {
+        r.state = TUBE_HEALTH_FAILING;
+    } else if (flags) {
+        r.state = TUBE_HEALTH_WARNING;
+    } else {
+        r.state = TUBE_HEALTH_OK;
+    }
+    r.version = reportLock.version() + 1;
+    reportLock.publish(r);
+
+    uint8_t raised = flags & ~lastFlags;
+    if (raised) {
+        char names[96];
+        tubeHealthFlagNames(raised, names, sizeof(names));
+        DEBUG_PRINTF("Tube health: %s (%s)\n", tubeHealthStateName(r.state), names);
+    }
+    lastFlags = flags;
+}
+
+void tubeHealthSecond(uint32_t counts, bool injected) {
+    if (injected) {
+        // The next real interval would span the injected train
+        haveLast = false;
+        return;
+    }
+    evaluatedSeconds++;
+    rateBaseline.addSecond(counts, TUBE_RATE_SHIFT_FRACTION, BASELINE_HOURS);
+    if (++agingSeconds >= TUBE_HEALTH_HALF_LIFE_S) {
+        histogram.age();
+        agingSeconds = 0;
+    }
+
+    HvStatus hv = getHvStatus();
+    bool drifting = hv.running && hv.state == HV_STATE_REGULATING && fabsf(hv.measuredV - hv.targetV) > TUBE_HV_DRIFT_V;
+    hvDriftSeconds = drifting ? hvDriftSeconds + 1 : 0;
+
+    windowCounts += counts;
+    if (++windowSeconds < TUBE_HEALTH_WINDOW_S) return;
+    evaluate();
+    window.reset();
+    windowCounts = 0;
+    windowSeconds = 0;
+}
+
+bool tubeHealthRequestReset() {
+    Command cmd = {};
+    cmd.type = COMMAND_RESET_TUBE_HEALTH;
+    return commandPost(COMMAND_TARGET_PULSE, cmd);
+}
+
+void tubeHealthReset() {
+    histogram.reset();
+    window.reset();
+    rateBaseline.reset();
+    haveLast = false;
+    windowCounts = 0;
+    windowSeconds = 0;
+    agingSeconds = 0;
+    evaluatedSeconds = 0;
+    hvDriftSeconds = 0;
+    lastFlags = 0;
+    evaluate();
+}
+
+TubeHealthReport getTubeHealthReport() {
+    TubeHealthReport r;
+    if (!reportLock.read(r)) memset(&r, 0, sizeof(r));
+    return r;
+}
+
+uint32_t tubeHealthVersion() {
+    return reportLock.version();
+}
+
+const char* tubeHealthStateName(uint8_t state) {
+    static const char* NAMES[] = {"ok", "warning", "failing"};
+    return state <= TUBE_HEALTH_FAILING ? NAMES[state] : "?";
+}
+
+void tubeHealthFlagNames(uint8_t flags, char* out, size_t size) {
+    static const char* NAMES[] = {"dead_time", "afterpulsing", "double_trigger", "discharge",
+                                  "rate_shift", "hv_drift", "hv_below_plateau"};
+    out[0] = '\0';
+    for (uint8_t i = 0; i < sizeof(NAMES) / sizeof(NAMES[0]); i++) {
+        if (!(flags & (1 << i))) continue;
+        if (out[0]) strlcat(out, ",", size);
+        strlcat(out, NAMES[i], size);
+    }
+    if (!out[0]) strlcpy(out, "none", size);
+}
+
+void buildTubeHealthJson(JsonDocument& doc) {
+    static TubeHealthReport r; // Web task only
+    r = getTubeHealthReport();
+    doc["state"] = tubeHealthStateName(r.state);
+    JsonArray flags = doc["flags"].to<JsonArray>();
+    for (uint8_t i = 0; i < 8; i++) {
+        if (!(r.flags & (1 << i))) continue;
+        char name[24];
+        tubeHealthFlagNames(1 << i, name, sizeof(name));
+        flags.add(name);
+    }
+    doc["timestamps"] = r.timestamps;
+    doc["seconds"] = r.seconds;
+    JsonObject dead = doc["dead_time"].to<JsonObject>();
+    dead["configured_us"] = r.configuredDeadTimeUs;
+    if (r.deadTime.valid) {
+        dead["estimate_us"] = r.deadTime.us;
+        dead["sigma_us"] = r.deadTime.sigmaUs;
+    }
+    dead["edge_us"] = r.deadTime.edgeUs;
+    dead["below"] = r.deadTime.below;
+    doc["afterpulse_ratio"] = r.afterpulseRatio;
+    doc["short_fraction"] = r.shortFraction;
+    doc["window_cps"] = r.windowCps;
+    doc["window_cv"] = r.windowCv;
+    doc["expected_cv"] = r.expectedCv;
+    JsonObject rate = doc["rate"].to<JsonObject>();
+    rate["baseline_cps"] = r.baselineCps;
+    rate["ratio"] = r.rateRatio;
+    rate["z"] = r.rateZ;
+    rate["hours"] = r.baselineHours;
+    JsonObject hv = doc["hv"].to<JsonObject>();
+    hv["measured_v"] = r.hvMeasuredV;
+    hv["target_v"] = r.hvTargetV;
+    hv["knee_v"] = r.kneeV;
+    // Quarter-octave bins from 1 us; trailing empty bins are left out
+    JsonObject h = doc["histogram"].to<JsonObject>();
+    h["bins_per_octave"] = 4;
+    h["first_us"] = 1;
+    h["total"] = r.total;
+    h["mean_us"] = r.meanUs;
+    uint8_t used = INTERARRIVAL_BINS;
+    while (used > 0 && r.bins[used - 1] <= 0.0f) used--;
+    JsonArray counts = h["counts"].to<JsonArray>();
+    for (uint8_t i = 0; i < used; i++) counts.add(roundf(r.bins[i] * 10.0f) / 10.0f);
+}
+
+/**
+ * @brief POST /api/tube with {"action":"reset"} or ?action=reset: queues the
+ *        reset for pulseTask.
+ */
+static void handleTubeControl(WebServer& server, JsonVariantConst body) {
+    String action = body["action"] | server.arg("action");
+    if (action != "reset") {
+        server.send(400, "text/plain", "action must be reset");
+        return;
+    }
+    if (!tubeHealthRequestReset()) {
+        server.send(503, "text/plain", "Command queue full");
+        return;
+    }
+    server.send(202, "text/plain", "Queued");
+}
+
+void tubeHealthAttach(WebServer& server) {
+    tubeServer = &server;
+    server.on("/api/tube", HTTP_GET, []() {
+        tubeServer->sendHeader("Cache-Control", "no-store");
+        tubeServer->sendHeader("Access-Control-Allow-Origin", "*");
+        JsonArenaLease lease;
+        JsonDocument doc(lease.allocator());
+        buildTubeHealthJson(doc);
+        webSendJson(*tubeServer, 200, doc);
+    });
+    jsonBodyOn(server, "/api/tube", JSON_BODY_ACTION_FILTER, handleTubeControl);
+}
+
+void printTubeHealth(Print& out) {
+    static TubeHealthReport r; // uiTask only
+    r = getTubeHealthReport();
+    char names[96];
+    tubeHealthFlagNames(r.flags, names, sizeof(names));
+    out.printf("Tube health: %s (%s), %lu s evaluated%s\n", tubeHealthStateName(r.state), names,
+               (unsigned long)r.seconds, r.timestamps ? "" : ", no pulse timestamps");
+    out.printf("  intervals: %.0f in the histogram, mean %.0f us (half-life %u s)\n", r.total, r.meanUs,
+               (unsigned)TUBE_HEALTH_HALF_LIFE_S);
+    if (r.deadTime.valid) {
+        out.printf("  dead time: %.1f +- %.1f us estimated, %.1f us configured (%.0f intervals below %.0f us)\n",
+                   r.deadTime.us, r.deadTime.sigmaUs, r.configuredDeadTimeUs, r.deadTime.below, r.deadTime.edgeUs);
+    } else {
+        out.printf("  dead time: %.1f us configured, no estimate (%.0f of %u intervals below %.0f us)\n",
+                   r.configuredDeadTimeUs, r.deadTime.below, (unsigned)TUBE_HEALTH_MIN_BELOW, r.deadTime.edgeUs);
+    }
+    out.printf("  afterpulses: %.2fx expected in 1...4 dead times, %.4f%% below half a dead time\n",
+               r.afterpulseRatio, r.shortFraction * 100.0f);
+    out.printf("  last %u s: %.1f cps, CV %.3f (%.3f expected)\n", (unsigned)TUBE_HEALTH_WINDOW_S, r.windowCps,
+               r.windowCv, r.expectedCv);
+    out.printf("  rate: baseline %.2f cps over %u h, last hour %.2fx (z %.1f)\n", r.baselineCps,
+               (unsigned)r.baselineHours, r.rateRatio, r.rateZ);
+    if (r.hvTargetV > 0.0f) out.printf("  HV: %.1f V measured, %.1f V target", r.hvMeasuredV, r.hvTargetV);
+    else out.print("  HV: fixed supply");
+    if (r.kneeV > 0.0f) out.printf(", plateau knee %.0f V", r.kneeV);
+    out.println();
+}
@@ -0,0 +1,102 @@
+#ifndef TUBE_HEALTH_H
+#define TUBE_HEALTH_H
+
+#include <Arduino.h>
+#include <WebServer.h>
+#include <ArduinoJson.h>
+#include "config.h"
+#include "interarrival.h"
+
+// Tube diagnostics from the per-pulse timestamps ("tube", /api/tube).
+// pulseTask adds the interval before every captured Geiger pulse to an
+// InterArrivalHistogram (interarrival.h) that halves every
+// TUBE_HEALTH_HALF_LIFE_S, and every TUBE_HEALTH_WINDOW_S evaluates it:
+//   dead time       estimated live and compared with the configured one
+//   afterpulsing    too many intervals within 4 dead times of the last pulse
+//   double trigger  intervals far below the dead time (ringing on the input)
+//   discharge       the last window far more regular than counting allows
+// plus two checks that the tube still sits on its plateau:
+//   rate shift      the hourly rate off its slow baseline for two hours
+//   HV drift        the measured HV off the target for a minute, or the
+//                   target below the knee of the last plateau scan
+// Afterpulsing, double triggers and discharge make the tube FAILING, the rest
+// WARNING. The dead-time estimate needs TUBE_HEALTH_MIN_BELOW short intervals
+// and is only tight at elevated rates: at background a check source helps.
+// Injected pulses (pulse_injector.h) are left out. Without PULSE_CAPTURE_ENABLED
+// there are no timestamps and only the rate and HV checks run.
+//   GET  /api/tube                   the report with the histogram
+//   POST /api/tube?action=reset      starts the statistics over
+
+enum TubeHealthState {
+    TUBE_HEALTH_OK = 0,
+    TUBE_HEALTH_WARNING,
+    TUBE_HEALTH_FAILING
+};
+
+enum TubeHealthFlag {
+    TUBE_FLAG_DEAD_TIME = 0x01,        ///< Estimate off the configured dead time
+    TUBE_FLAG_AFTERPULSING = 0x02,
+    TUBE_FLAG_DOUBLE_TRIGGER = 0x04,
+    TUBE_FLAG_DISCHARGE = 0x08,
+    TUBE_FLAG_RATE_SHIFT = 0x10,
+    TUBE_FLAG_HV_DRIFT = 0x20,
+    TUBE_FLAG_HV_BELOW_PLATEAU = 0x40
+};
+
+struct TubeHealthReport {
+    uint8_t state;              ///< TubeHealthState
+    uint8_t flags;              ///< TubeHealthFlag bits
+    bool timestamps;            ///< Pulse capture is running
+    uint32_t seconds;           ///< Seconds evaluated since the last reset
+    float configuredDeadTimeUs;
+    DeadTimeEstimate deadTime;
+    float afterpulseRatio;      ///< Observed / expected intervals in [tau, 4 tau)
+    float shortFraction;        ///< Intervals below tau / 2
+    float windowCv;             ///< Coefficient of variation of the last window
+    float expectedCv;           ///< 1 - m tau at the window's rate
+    float windowCps;
+    float baselineCps;          ///< Slow hourly baseline (0 before the first hour)
+    float rateRatio;            ///< Last hour against the baseline
+    float rateZ;
+    uint16_t baselineHours;
+    float hvMeasuredV;          ///< 0 without HV regulation
+    float hvTargetV;
+    float kneeV;                ///< Of the last plateau scan, 0 without a fit
+    float meanUs;
+    float total;                ///< Intervals in the histogram (after aging)
+    float bins[INTERARRIVAL_BINS];
+    uint32_t version;           ///< Changes with every published report
+};
+
+// pulseTask only: the interval to the previous captured pulse.
+void tubeHealthPulse(uint32_t timestampUs);
+
+// pulseTask only: one closed second with its counts; evaluates and publishes
+// every TUBE_HEALTH_WINDOW_S. @p injected: the pulse injector is running.
+void tubeHealthSecond(uint32_t counts, bool injected);
+
+// Any task: posts COMMAND_RESET_TUBE_HEALTH. @return false if the queue is full
+bool tubeHealthRequestReset();
+
+// pulseTask only (COMMAND_RESET_TUBE_HEALTH): starts the statistics over.
+void tubeHealthReset();
+
+// Consistent copy of the last report. Any task, lock-free.
+TubeHealthReport getTubeHealthReport();
+
+// Cheap change check for the diagnostics view.
+uint32_t tubeHealthVersion();
+
+const char* tubeHealthStateName(uint8_t state);
+
+// Comma-separated names of @p flags, "none" without any.
+void tubeHealthFlagNames(uint8_t flags, char* out, size_t size);
+
+void buildTubeHealthJson(JsonDocument& doc);
+
+// Registers /api/tube. Call while the other routes are set up.
+void tubeHealthAttach(WebServer& server);
+
+void printTubeHealth(Print& out);
+
+#endif // TUBE_HEALTH_H
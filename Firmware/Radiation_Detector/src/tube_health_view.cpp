@@ -0,0 +1,226 @@
+/**
+ * @file tube_health_view.cpp
+ * @brief Inter-arrival histogram and tube check renderer.
+ *
+ * The report is copied once per change and turned into bar heights and text
+ * lines right away; the draw handler only fills spans and draws the cached
+ * strings, clipped to the area being refreshed.
+ */
+
+#include "config.h"
+
+#if !HEADLESS
+
+#include "tube_health_view.h"
+#include "tube_health.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+static const uint8_t FIRST_BIN = 8;       ///< 4 us; nothing real is shorter
+static const uint8_t SHOWN_BINS = INTERARRIVAL_BINS - FIRST_BIN;
+static const lv_coord_t PLOT_HEIGHT = 140;
+static const lv_coord_t LABEL_HEIGHT = 16; ///< Decade labels below the plot
+static const uint8_t TEXT_LINES = 5;
+static const uint32_t UPDATE_INTERVAL_MS = 1000;
+
+static lv_obj_t* view = nullptr;
+static lv_obj_t* overObj = nullptr;
+static uint32_t shownVersion = UINT32_MAX;
+static uint32_t lastUpdateMs = 0;
+
+static int16_t barHeight[SHOWN_BINS];
+static float configuredUs = 0.0f;
+static float estimatedUs = 0.0f;          ///< 0 without an estimate
+static uint8_t state = TUBE_HEALTH_OK;
+static char lines[TEXT_LINES][64];
+
+static const lv_color_t COLOR_BAR = LV_COLOR_MAKE(0x45, 0x6F, 0x08);
+static const lv_color_t COLOR_GRID = LV_COLOR_MAKE(0x40, 0x40, 0x40);
+static const lv_color_t COLOR_ESTIMATE = LV_COLOR_MAKE(0xFF, 0x8C, 0x00);
+static const lv_color_t COLOR_STATE[] = {LV_COLOR_MAKE(0x89, 0xDE, 0x10), LV_COLOR_MAKE(0xFF, 0xC8, 0x00),
+                                         LV_COLOR_MAKE(0xFF, 0x30, 0x30)};
+
+static void plotArea(lv_area_t* plot) {
+    lv_obj_get_content_coords(view, plot);
+    plot->y2 = plot->y1 + PLOT_HEIGHT - 1;
+}
+
+/// X of time @p us on the log axis, from the first shown bin edge to 2^24 us.
+static lv_coord_t timeToX(const lv_area_t& plot, float us) {
+    float octaves = log2f(us) - FIRST_BIN / 4;
+    float span = INTERARRIVAL_OCTAVES - FIRST_BIN / 4;
+    if (octaves < 0.0f) octaves = 0.0f;
+    if (octaves > span) octaves = span;
+    return plot.x1 + (lv_coord_t)lroundf(octaves / span * (lv_area_get_width(&plot) - 1));
+}
+
+/**
+ * @brief Copies the report into bar heights and text lines and invalidates the view.
+ */
+static void refresh() {
+    static TubeHealthReport r; // About 500 bytes, kept off the stack
+    r = getTubeHealthReport();
+    shownVersion = r.version;
+
+    float peak = 0.0f;
+    for (uint8_t i = FIRST_BIN; i < INTERARRIVAL_BINS; i++) peak = fmaxf(peak, r.bins[i]);
+    float scale = peak > 0.0f ? (PLOT_HEIGHT - 1) / log10f(peak + 1.0f) : 0.0f;
+    for (uint8_t i = 0; i < SHOWN_BINS; i++) {
+        barHeight[i] = (int16_t)lroundf(log10f(r.bins[FIRST_BIN + i] + 1.0f) * scale);
+    }
+    configuredUs = r.configuredDeadTimeUs;
+    estimatedUs = r.deadTime.valid ? r.deadTime.us : 0.0f;
+    state = r.state <= TUBE_HEALTH_FAILING ? r.state : TUBE_HEALTH_FAILING;
+
+    char names[96];
+    tubeHealthFlagNames(r.flags, names, sizeof(names));
+    snprintf(lines[0], sizeof(lines[0]), "Tube %s: %s", tubeHealthStateName(r.state), names);
+    if (r.deadTime.valid) {
+        snprintf(lines[1], sizeof(lines[1]), "Dead time %.0f +- %.0f us (set %.0f us)", r.deadTime.us,
+                 r.deadTime.sigmaUs, r.configuredDeadTimeUs);
+    } else {
+        snprintf(lines[1], sizeof(lines[1]), "Dead time %.0f us, %s", r.configuredDeadTimeUs,
+                 r.timestamps ? "too few short intervals" : "no pulse timestamps");
+    }
+    snprintf(lines[2], sizeof(lines[2]), "Afterpulses %.2fx  Doubles %.3f%%  CV %.2f/%.2f", r.afterpulseRatio,
+             r.shortFraction * 100.0f, r.windowCv, r.expectedCv);
+    snprintf(lines[3], sizeof(lines[3]), "Rate %.2f cps, baseline %.2f cps (%u h) %.2fx", r.windowCps, r.baselineCps,
+             (unsigned)r.baselineHours, r.rateRatio);
+    if (r.hvTargetV > 0.0f) {
+        snprintf(lines[4], sizeof(lines[4]), "HV %.0f V / %.0f V, knee %.0f V", r.hvMeasuredV, r.hvTargetV, r.kneeV);
+    } else {
+        snprintf(lines[4], sizeof(lines[4]), "HV fixed supply");
+    }
+    lv_obj_invalidate(view);
+}
+
+/**
+ * @brief Writes a vertical span into the draw buffer, clipped to the refreshed area.
+ */
+static void drawSpan(lv_draw_ctx_t* ctx, lv_coord_t x, lv_coord_t y1, lv_coord_t y2, lv_color_t color) {
+    const lv_area_t* clip = ctx->clip_area;
+    if (x < clip->x1 || x > clip->x2) return;
+    if (y1 < clip->y1) y1 = clip->y1;
+    if (y2 > clip->y2) y2 = clip->y2;
+    lv_color_t* buf = (lv_color_t*)ctx->buf;
+    lv_coord_t stride = lv_area_get_width(ctx->buf_area);
+    lv_color_t* p = buf + (y1 - ctx->buf_area->y1) * stride + (x - ctx->buf_area->x1);
+    for (lv_coord_t y = y1; y <= y2; y++, p += stride) *p = color;
+}
+
+static void drawText(lv_draw_ctx_t* ctx, lv_draw_label_dsc_t* dsc, lv_coord_t x1, lv_coord_t y1,
+                     lv_coord_t x2, const char* text) {
+    lv_area_t area;
+    area.x1 = x1;
+    area.x2 = x2;
+    area.y1 = y1;
+    area.y2 = y1 + lv_font_get_line_height(dsc->font);
+    lv_draw_label(ctx, dsc, &area, text, NULL);
+}
+
+static void drawCb(lv_event_t* e) {
+    lv_draw_ctx_t* ctx = lv_event_get_draw_ctx(e);
+    lv_area_t plot;
+    plotArea(&plot);
+    static const char* DECADES[] = {"10us", "100us", "1ms", "10ms", "100ms", "1s", "10s"};
+
+    // Dotted decade grid, bars, then the dead time markers over them
+    lv_area_t clip;
+    if (_lv_area_intersect(&clip, ctx->clip_area, &plot)) {
+        float us = 10.0f;
+        for (uint8_t d = 0; d < 7; d++, us *= 10.0f) {
+            lv_coord_t x = timeToX(plot, us);
+            lv_coord_t y = plot.y1 + (clip.y1 - plot.y1 + 3) / 4 * 4; // Every fourth pixel
+            for (; y <= clip.y2; y += 4) drawSpan(ctx, x, y, y, COLOR_GRID);
+        }
+        for (uint8_t i = 0; i < SHOWN_BINS; i++) {
+            if (barHeight[i] <= 0) continue;
+            lv_coord_t x1 = timeToX(plot, InterArrivalHistogram::binLowerUs(FIRST_BIN + i));
+            lv_coord_t x2 = i + 1 < SHOWN_BINS ? timeToX(plot, InterArrivalHistogram::binLowerUs(FIRST_BIN + i + 1)) - 1
+                                               : plot.x2;
+            for (lv_coord_t x = x1; x <= x2; x++) drawSpan(ctx, x, plot.y2 - barHeight[i] + 1, plot.y2, COLOR_BAR);
+        }
+        if (configuredUs > 0.0f) drawSpan(ctx, timeToX(plot, configuredUs), plot.y1, plot.y2, lv_color_white());
+        if (estimatedUs > 0.0f) drawSpan(ctx, timeToX(plot, estimatedUs), plot.y1, plot.y2, COLOR_ESTIMATE);
+    }
+
+    lv_draw_label_dsc_t dsc;
+    lv_draw_label_dsc_init(&dsc);
+    dsc.color = lv_color_white();
+    dsc.font = LV_FONT_DEFAULT;
+    dsc.align = LV_TEXT_ALIGN_CENTER;
+    float us = 10.0f;
+    for (uint8_t d = 0; d < 7; d++, us *= 10.0f) {
+        lv_coord_t x = timeToX(plot, us);
+        drawText(ctx, &dsc, x - 24, plot.y2 + 2, x + 24, DECADES[d]);
+    }
+
+    lv_area_t content;
+    lv_obj_get_content_coords(view, &content);
+    lv_coord_t lineHeight = lv_font_get_line_height(dsc.font) + 2;
+    lv_coord_t y = plot.y2 + 2 + LABEL_HEIGHT + 4;
+    dsc.align = LV_TEXT_ALIGN_LEFT;
+    for (uint8_t i = 0; i < TEXT_LINES && y + lineHeight <= content.y2 + 1; i++, y += lineHeight) {
+        dsc.color = i == 0 ? COLOR_STATE[state] : lv_color_white();
+        drawText(ctx, &dsc, content.x1, y, content.x2, lines[i]);
+    }
+}
+
+static void eventCb(lv_event_t* e) {
+    lv_event_code_t code = lv_event_get_code(e);
+    if (code == LV_EVENT_SHORT_CLICKED || code == LV_EVENT_LONG_PRESSED) {
+        tubeHealthViewShow(false);
+    } else if (code == LV_EVENT_DELETE) {
+        view = nullptr;
+        overObj = nullptr;
+    }
+}
+
+static void overClickedCb(lv_event_t* e) {
+    tubeHealthViewShow(true);
+}
+
+void tubeHealthViewAttach(lv_obj_t* screen, lv_obj_t* over, lv_coord_t top) {
+    overObj = over;
+    view = lv_obj_create(screen);
+    lv_obj_set_size(view, lv_obj_get_width(screen), lv_obj_get_height(screen) - top);
+    lv_obj_align(view, LV_ALIGN_TOP_LEFT, 0, top);
+    lv_obj_set_style_bg_color(view, lv_color_black(), LV_PART_MAIN);
+    lv_obj_set_style_radius(view, 0, LV_PART_MAIN);
+    lv_obj_set_style_border_width(view, 0, LV_PART_MAIN);
+    lv_obj_set_style_pad_all(view, 6, LV_PART_MAIN);
+    lv_obj_clear_flag(view, LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_GESTURE_BUBBLE);
+    lv_obj_add_flag(view, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_add_event_cb(view, drawCb, LV_EVENT_DRAW_MAIN, NULL);
+    lv_obj_add_event_cb(view, eventCb, LV_EVENT_ALL, NULL);
+
+    lv_obj_add_flag(over, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_add_event_cb(over, overClickedCb, LV_EVENT_CLICKED, NULL);
+    shownVersion = UINT32_MAX;
+}
+
+void tubeHealthViewShow(bool show) {
+    if (!view) return;
+    if (show) {
+        lv_obj_clear_flag(view, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_move_foreground(view);
+        lv_obj_update_layout(view);
+        refresh();
+    } else {
+        lv_obj_add_flag(view, LV_OBJ_FLAG_HIDDEN);
+    }
+}
+
+bool tubeHealthViewShown() {
+    return view && !lv_obj_has_flag(view, LV_OBJ_FLAG_HIDDEN);
+}
+
+void tubeHealthViewUpdate(uint32_t nowMs) {
+    if (!tubeHealthViewShown()) return;
+    if (nowMs - lastUpdateMs < UPDATE_INTERVAL_MS) return;
+    lastUpdateMs = nowMs;
+    if (tubeHealthVersion() != shownVersion) refresh();
+}
+
+#endif // !HEADLESS
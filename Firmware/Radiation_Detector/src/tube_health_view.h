@@ -0,0 +1,26 @@
+#ifndef TUBE_HEALTH_VIEW_H
+#define TUBE_HEALTH_VIEW_H
+
+#include <lvgl.h>
+
+// Tube diagnostics over the voltage screen (tube_health.h).
+// Tapping the plateau chart opens it below the navigation bar: the
+// inter-arrival histogram as bars of log counts over log time, with the
+// configured dead time (white) and the live estimate (orange) marked, and
+// the state, flags and check values as text. Drawn straight into LVGL's draw
+// buffer like the history plot (timeseries_view.h) and redrawn only when a
+// new report was published. Tap or long press hides it. LVGL task only.
+
+// Creates the (hidden) view on @p screen, from @p top down to the bottom of
+// the screen; clicking @p over opens it. The view removes itself when its
+// screen is deleted.
+void tubeHealthViewAttach(lv_obj_t* screen, lv_obj_t* over, lv_coord_t top);
+
+void tubeHealthViewShow(bool show);
+
+bool tubeHealthViewShown();
+
+// Picks up a new report at most once a second while shown.
+void tubeHealthViewUpdate(uint32_t nowMs);
+
+#endif // TUBE_HEALTH_VIEW_H
@@ -0,0 +1,79 @@
+#ifndef TUBE_PROFILE_H
+#define TUBE_PROFILE_H
+
+#include "config.h"
+
+// Characteristics of the supported GM tubes. There is one TubeParams
+// specialisation per tube, and TUBE_MODEL (config.h) picks the one this build
+// is for (ActiveTube). The profile provides the defaults of the device
+// configuration: conversion factor, dead time and operating voltage. The
+// user can still override the conversion factor and dead time at run time
+// ("factor", "deadtime"), and the voltage through the voltage screen or a
+// plateau scan. Because of those overrides, the reciprocals that the hot paths
+// multiply by are derived from the configuration (DeviceConfig::usvHPerCpm),
+// not from the profile. TubeProfile checks the parameters at compile time.
+// Like dead_time.h this header has no Arduino dependencies.
+
+/**
+ * Conversion factors are for Cs-137 (662 keV), the usual calibration source.
+ * Below about 100 keV these tubes over-respond without an energy-compensating
+ * filter.
+ */
+template <int Model>
+struct TubeParams;
+
+template <>
+struct TubeParams<TUBE_SBM20> {
+    static constexpr const char* NAME = "SBM-20";
+    static constexpr float CPM_PER_USVH = 153.8f;
+    static constexpr float DEAD_TIME_US = 190.0f;
+    static constexpr float KNEE_V = 350.0f;          ///< Start of the counting plateau
+    static constexpr float PLATEAU_TOP_V = 475.0f;   ///< End of the plateau (onset of continuous discharge)
+    static constexpr float OPERATING_V = 400.0f;
+    static constexpr float ENERGY_MIN_KEV = 50.0f;     ///< Usable energy response range
+    static constexpr float ENERGY_MAX_KEV = 3000.0f;
+};
+
+template <>
+struct TubeParams<TUBE_M4011> {
+    static constexpr const char* NAME = "M4011";
+    static constexpr float CPM_PER_USVH = 151.5f;
+    static constexpr float DEAD_TIME_US = 190.0f;
+    static constexpr float KNEE_V = 350.0f;
+    static constexpr float PLATEAU_TOP_V = 480.0f;
+    static constexpr float OPERATING_V = 400.0f;
+    static constexpr float ENERGY_MIN_KEV = 20.0f;
+    static constexpr float ENERGY_MAX_KEV = 3000.0f;
+};
+
+template <>
+struct TubeParams<TUBE_J305> {
+    static constexpr const char* NAME = "J305";
+    static constexpr float CPM_PER_USVH = 123.1f;
+    static constexpr float DEAD_TIME_US = 100.0f;
+    static constexpr float KNEE_V = 360.0f;
+    static constexpr float PLATEAU_TOP_V = 440.0f;
+    static constexpr float OPERATING_V = 380.0f;
+    static constexpr float ENERGY_MIN_KEV = 20.0f;
+    static constexpr float ENERGY_MAX_KEV = 3000.0f;
+};
+
+/**
+ * @brief A tube's parameters, checked against each other and the HV and scan ranges.
+ */
+template <int Model>
+struct TubeProfile : TubeParams<Model> {
+    typedef TubeParams<Model> Params;
+
+    static_assert(Params::CPM_PER_USVH > 0.0f && Params::DEAD_TIME_US > 0.0f, "tube parameters must be positive");
+    static_assert(Params::KNEE_V < Params::OPERATING_V && Params::OPERATING_V < Params::PLATEAU_TOP_V,
+                  "operating voltage must lie on the plateau");
+    static_assert(Params::OPERATING_V >= HV_MIN_V && Params::OPERATING_V <= HV_MAX_V,
+                  "operating voltage outside the HV range");
+    static_assert(PLATEAU_START_V <= Params::KNEE_V && PLATEAU_END_V >= Params::PLATEAU_TOP_V,
+                  "the plateau scan range must cover the tube's plateau");
+};
+
+typedef TubeProfile<TUBE_MODEL> ActiveTube;
+
+#endif // TUBE_PROFILE_H
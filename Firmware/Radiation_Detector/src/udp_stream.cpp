@@ -0,0 +1,133 @@
+/**
+ * @file udp_stream.cpp
+ * @brief Per-second multicast datagrams, queued by pulseTask and sent by their own task.
+ *
+ * pulseTask only copies the second into a queue; the task adds the rate and
+ * alarm level and sends the datagram, so a slow network stack never delays the
+ * measurement.
+ */
+
+#include "udp_stream.h"
+#include "ethernet_link.h"
+#include "time_base.h"
+#include "debug.h"
+#include <WiFi.h>
+#include <WiFiUdp.h>
+#include <Preferences.h>
+#include "esp_random.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+
+static_assert(sizeof(UdpStreamRecord) == 44, "UDP stream record layout is on the wire");
+
+static const uint32_t TASK_STACK = 3072;
+static const uint8_t QUEUE_DEPTH = 8;
+
+struct SecondItem {
+    uint32_t second;
+    uint32_t counts;
+    uint32_t totalCounts;
+    uint32_t monotonic;     ///< timeBaseSeconds() at the close
+};
+
+static UdpStreamSource readingsSource = nullptr;
+static QueueHandle_t secondQueue = nullptr;
+static TaskHandle_t taskHandle = nullptr;
+static volatile bool enabled = UDP_STREAM_ENABLED;
+static UdpStreamStats stats;
+
+// UDP task only
+static WiFiUDP udp;
+static IPAddress group;
+static uint8_t deviceMac[6];
+static uint16_t bootId = 0;
+static uint32_t nextSequence = 1;
+
+static void sendSecond(const SecondItem& item) {
+    UdpStreamReadings readings;
+    readingsSource(readings);
+
+    UdpStreamRecord record;
+    memset(&record, 0, sizeof(record));
+    record.magic = UDP_STREAM_MAGIC;
+    record.version = UDP_STREAM_VERSION;
+    record.sequence = nextSequence++;
+    record.second = item.second;
+    if (timeBaseUtcValid()) {
+        record.utc = timeBaseUtcAt(item.monotonic - 1);
+        record.flags |= UDP_STREAM_FLAG_UTC;
+    }
+    record.counts = item.counts;
+    record.totalCounts = item.totalCounts;
+    record.cpm = readings.cpm;
+    record.doseRateUsvH = readings.doseRateUsvH;
+    record.bootId = bootId;
+    record.alarmLevel = readings.alarmLevel;
+    memcpy(record.device, deviceMac, sizeof(record.device));
+
+    if (udp.beginPacket(group, UDP_STREAM_PORT) && udp.write((const uint8_t*)&record, sizeof(record)) == sizeof(record) &&
+        udp.endPacket()) {
+        stats.sent++;
+    } else {
+        stats.failures++;
+    }
+}
+
+static void udpStreamTask(void* parameter) {
+    for (;;) {
+        SecondItem item;
+        if (xQueueReceive(secondQueue, &item, portMAX_DELAY) != pdTRUE) continue;
+        if (!enabled) continue;
+        if (!networkOnline()) {
+            stats.skipped++;
+            continue;
+        }
+        sendSecond(item);
+    }
+}
+
+void initUdpStream(UdpStreamSource source) {
+    if (taskHandle) return;
+    readingsSource = source;
+    Preferences prefs;
+    prefs.begin("udp", true);
+    enabled = prefs.getBool("on", UDP_STREAM_ENABLED);
+    prefs.end();
+
+    group.fromString(UDP_STREAM_GROUP);
+    WiFi.macAddress(deviceMac);
+    bootId = (uint16_t)esp_random();
+    secondQueue = xQueueCreate(QUEUE_DEPTH, sizeof(SecondItem));
+    if (!secondQueue) return;
+    if (xTaskCreatePinnedToCore(udpStreamTask, "UdpStream", TASK_STACK, NULL, NETWORK_TASK_PRIORITY, &taskHandle,
+                                TASK_CORE_NETWORK) != pdPASS) {
+        DEBUG_PRINTLN("Error: UDP stream task not created");
+    }
+}
+
+void udpStreamSecond(uint32_t second, uint32_t counts, uint32_t totalCounts) {
+    if (!secondQueue || !enabled) return;
+    SecondItem item = {second, counts, totalCounts, timeBaseSeconds()};
+    if (xQueueSend(secondQueue, &item, 0) != pdTRUE) stats.skipped++;
+}
+
+void udpStreamSetEnabled(bool on) {
+    Preferences prefs;
+    prefs.begin("udp", false);
+    prefs.putBool("on", on);
+    prefs.end();
+    enabled = on;
+}
+
+UdpStreamStats getUdpStreamStats() {
+    UdpStreamStats s = stats;
+    s.enabled = enabled;
+    return s;
+}
+
+void printUdpStream(Print& out) {
+    UdpStreamStats s = getUdpStreamStats();
+    out.printf("UDP stream: %s, %s:%u, %lu sent, %lu failed, %lu skipped\n", s.enabled ? "on" : "off",
+               UDP_STREAM_GROUP, (unsigned)UDP_STREAM_PORT, (unsigned long)s.sent, (unsigned long)s.failures,
+               (unsigned long)s.skipped);
+}
@@ -0,0 +1,75 @@
+#ifndef UDP_STREAM_H
+#define UDP_STREAM_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Per-second UDP multicast stream for any number of listeners on the LAN.
+// Every closed second is sent once as one UdpStreamRecord datagram to
+// UDP_STREAM_GROUP:UDP_STREAM_PORT, so the device's load is the same for one
+// listener or twenty (wall display, logger, SCADA bridge, ...). Listeners join
+// the group; nothing is sent back and nothing is retransmitted. The multicast
+// TTL is lwIP's default of 1, so the stream stays on the local subnet.
+//
+// Records are numbered per boot: a gap in sequence is a lost datagram, a new
+// bootId a restart. The second number is the device's own (as on the serial
+// SECOND frame); utc is filled once the time base has wall-clock time.
+//
+// Off by default; "udp on|off" switches it and is saved to Preferences ("udp").
+
+#define UDP_STREAM_MAGIC   0x5552 // "RU"
+#define UDP_STREAM_VERSION 1
+
+enum UdpStreamFlags {
+    UDP_STREAM_FLAG_UTC = 1 << 0    ///< utc is valid
+};
+
+// Datagram payload, little-endian.
+struct UdpStreamRecord {
+    uint16_t magic;
+    uint8_t version;
+    uint8_t flags;          ///< UdpStreamFlags
+    uint32_t sequence;      ///< Per boot, from 1
+    uint32_t second;        ///< Seconds closed since boot
+    uint32_t utc;           ///< Start of the second, UNIX time (0 if unknown)
+    uint32_t counts;        ///< In the second
+    uint32_t totalCounts;   ///< Since boot
+    float cpm;              ///< Dead-time corrected
+    float doseRateUsvH;
+    uint16_t bootId;        ///< Random per boot
+    uint8_t alarmLevel;     ///< AlarmLevel
+    uint8_t reserved;
+    uint8_t device[6];      ///< Station MAC
+    uint16_t reserved2;
+};
+
+// Readings that change slower than the counts, copied by the source (UDP task).
+struct UdpStreamReadings {
+    float cpm;
+    float doseRateUsvH;
+    uint8_t alarmLevel;
+};
+
+typedef void (*UdpStreamSource)(UdpStreamReadings& out);
+
+struct UdpStreamStats {
+    bool enabled;
+    uint32_t sent;
+    uint32_t failures;      ///< Datagrams the stack did not take
+    uint32_t skipped;       ///< Seconds while not connected or the queue was full
+};
+
+// Loads the setting and starts the task. Call in setup() after the WiFi manager.
+void initUdpStream(UdpStreamSource source);
+
+// pulseTask: a second closed. Never blocks.
+void udpStreamSecond(uint32_t second, uint32_t counts, uint32_t totalCounts);
+
+// Switches the stream and saves the setting. UI task.
+void udpStreamSetEnabled(bool enabled);
+
+UdpStreamStats getUdpStreamStats();
+
+void printUdpStream(Print& out);
+
+#endif // UDP_STREAM_H
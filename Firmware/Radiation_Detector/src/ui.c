@@ -584,14 +584,9 @@ void ui_init(void)
     lv_theme_t * theme = lv_theme_default_init(dispp, lv_palette_main(LV_PALETTE_BLUE), lv_palette_main(LV_PALETTE_RED),
                                                true, LV_FONT_DEFAULT);
     lv_disp_set_theme(dispp, theme);
-    ui_InitialScreen_screen_init();
-    ui_MainScreen_screen_init();
-    ui_Charts1h_screen_init();
-    ui_VoltageScreen_screen_init();
-    ui_Settings_screen_init();
-    ui_Charts24h_screen_init();
-    ui_ChartsSpectrum_screen_init();
+    // Only the startup screen is built here; the others are built by
+    // _ui_screen_change() on their first navigation
     ui_Startup_screen_screen_init();
     ui____initial_actions0 = lv_obj_create(NULL);
-    lv_disp_load_scr(ui_InitialScreen);
+    lv_disp_load_scr(ui_Startup_screen);
 }
@@ -0,0 +1,205 @@
+/**
+ * @file ui_async.cpp
+ * @brief Lock-free, coalescing request table drained by uiTask.
+ *
+ * Each slot moves FREE -> WRITING -> READY -> READING -> FREE. A producer
+ * claims a FREE slot, or a READY one with the same key to overwrite it, by
+ * compare-and-swap into WRITING, so no two writers and no reader ever share
+ * a slot. The drain moves every READY slot to READING, applies them in the
+ * order of their sequence numbers and frees them; slots published during the
+ * drain wait for the next pass, which their wake makes immediate. A ring
+ * would keep the order for free but cannot replace a request in the middle,
+ * hence the table and the sequence numbers.
+ */
+
+#include "config.h"
+
+#if !HEADLESS
+
+#include "ui_async.h"
+#include "ui_wake.h"
+#include <atomic>
+
+enum SlotState : uint8_t {
+    SLOT_FREE = 0,
+    SLOT_WRITING,
+    SLOT_READY,
+    SLOT_READING,
+};
+
+enum UiAsyncOp : uint8_t {
+    OP_CALL = 0,
+    OP_LABEL,
+    OP_INVALIDATE,
+    OP_HIDDEN,
+};
+
+// The key (op, key, fn) is atomic because producers compare it on slots they
+// do not own; the payload is only touched by the owner of the slot.
+struct Slot {
+    std::atomic<uint8_t> state;
+    std::atomic<uint8_t> op;
+    std::atomic<uintptr_t> key;   ///< The widget global (lv_obj_t**), or the call's arg
+    std::atomic<uintptr_t> fn;    ///< The call's function, 0 for widget requests
+    uint32_t seq;
+    bool hidden;
+    char text[UI_ASYNC_TEXT_MAX];
+};
+
+struct Request {
+    uint8_t op;
+    uintptr_t key;
+    uintptr_t fn;
+    bool hidden;
+    const char* text;
+};
+
+static_assert(UI_ASYNC_SLOTS <= 255, "uiAsyncDrain() orders the slots by uint8_t index");
+
+static Slot slots[UI_ASYNC_SLOTS];
+static std::atomic<uint32_t> nextSeq(0);
+static std::atomic<uint32_t> posted(0);
+static std::atomic<uint32_t> coalesced(0);
+static std::atomic<uint32_t> dropped(0);
+static uint32_t unbuilt = 0;       // uiTask only
+static uint32_t applied = 0;
+static uint16_t pendingPeak = 0;
+
+static bool matches(const Slot& slot, const Request& request) {
+    return slot.op.load(std::memory_order_relaxed) == request.op &&
+           slot.key.load(std::memory_order_relaxed) == request.key &&
+           slot.fn.load(std::memory_order_relaxed) == request.fn;
+}
+
+static void fill(Slot& slot, const Request& request) {
+    slot.hidden = request.hidden;
+    if (request.text) strlcpy(slot.text, request.text, sizeof(slot.text));
+    slot.seq = nextSeq.fetch_add(1, std::memory_order_relaxed);
+}
+
+static bool post(const Request& request) {
+    posted.fetch_add(1, std::memory_order_relaxed);
+
+    // Replace a pending request with the same key
+    for (Slot& slot : slots) {
+        if (slot.state.load(std::memory_order_acquire) != SLOT_READY || !matches(slot, request)) continue;
+        uint8_t expected = SLOT_READY;
+        if (!slot.state.compare_exchange_strong(expected, SLOT_WRITING, std::memory_order_acquire)) continue;
+        bool same = matches(slot, request); // It may have been drained and reused in between
+        if (same) fill(slot, request);
+        slot.state.store(SLOT_READY, std::memory_order_release);
+        if (same) {
+            coalesced.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        uiWakeNotify(UI_WAKE_ASYNC); // A drain may have skipped it while we held it
+    }
+
+    for (Slot& slot : slots) {
+        uint8_t expected = SLOT_FREE;
+        if (!slot.state.compare_exchange_strong(expected, SLOT_WRITING, std::memory_order_acquire)) continue;
+        slot.op.store(request.op, std::memory_order_relaxed);
+        slot.key.store(request.key, std::memory_order_relaxed);
+        slot.fn.store(request.fn, std::memory_order_relaxed);
+        fill(slot, request);
+        slot.state.store(SLOT_READY, std::memory_order_release);
+        uiWakeNotify(UI_WAKE_ASYNC);
+        return true;
+    }
+    dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+bool uiAsyncCall(void (*fn)(void*), void* arg) {
+    if (!fn) return false;
+    return post({OP_CALL, (uintptr_t)arg, (uintptr_t)fn, false, nullptr});
+}
+
+bool uiAsyncSetLabel(lv_obj_t** label, const char* text) {
+    if (!label || !text) return false;
+    return post({OP_LABEL, (uintptr_t)label, 0, false, text});
+}
+
+bool uiAsyncInvalidate(lv_obj_t** obj) {
+    if (!obj) return false;
+    return post({OP_INVALIDATE, (uintptr_t)obj, 0, false, nullptr});
+}
+
+bool uiAsyncSetHidden(lv_obj_t** obj, bool hidden) {
+    if (!obj) return false;
+    return post({OP_HIDDEN, (uintptr_t)obj, 0, hidden, nullptr});
+}
+
+static void apply(const Slot& slot) {
+    uint8_t op = slot.op.load(std::memory_order_relaxed);
+    uintptr_t key = slot.key.load(std::memory_order_relaxed);
+    if (op == OP_CALL) {
+        ((void (*)(void*))slot.fn.load(std::memory_order_relaxed))((void*)key);
+        applied++;
+        return;
+    }
+    lv_obj_t* obj = *(lv_obj_t**)key;
+    if (!obj) {
+        unbuilt++;
+        return;
+    }
+    switch (op) {
+        case OP_LABEL:
+            lv_label_set_text(obj, slot.text);
+            break;
+        case OP_INVALIDATE:
+            lv_obj_invalidate(obj);
+            break;
+        case OP_HIDDEN:
+            if (slot.hidden) lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+            else lv_obj_clear_flag(obj, LV_OBJ_FLAG_HIDDEN);
+            break;
+    }
+    applied++;
+}
+
+uint16_t uiAsyncDrain() {
+    // Take every published slot, sorted by sequence (insertion, at most
+    // UI_ASYNC_SLOTS entries)
+    uint8_t order[UI_ASYNC_SLOTS];
+    uint16_t count = 0;
+    for (uint16_t i = 0; i < UI_ASYNC_SLOTS; i++) {
+        uint8_t expected = SLOT_READY;
+        if (!slots[i].state.compare_exchange_strong(expected, SLOT_READING, std::memory_order_acquire)) continue;
+        uint16_t at = count++;
+        while (at > 0 && (int32_t)(slots[order[at - 1]].seq - slots[i].seq) > 0) {
+            order[at] = order[at - 1];
+            at--;
+        }
+        order[at] = i;
+    }
+    if (count > pendingPeak) pendingPeak = count;
+
+    for (uint16_t i = 0; i < count; i++) {
+        apply(slots[order[i]]);
+        slots[order[i]].state.store(SLOT_FREE, std::memory_order_release);
+    }
+    return count;
+}
+
+UiAsyncStats getUiAsyncStats() {
+    UiAsyncStats s;
+    s.posted = posted.load(std::memory_order_relaxed);
+    s.coalesced = coalesced.load(std::memory_order_relaxed);
+    s.dropped = dropped.load(std::memory_order_relaxed);
+    s.unbuilt = unbuilt;
+    s.applied = applied;
+    s.pendingPeak = pendingPeak;
+    s.capacity = UI_ASYNC_SLOTS;
+    return s;
+}
+
+void printUiAsyncStats(Print& out) {
+    UiAsyncStats s = getUiAsyncStats();
+    out.printf("UI requests: %lu posted, %lu coalesced, %lu applied, %lu for unbuilt widgets, %lu dropped (full)\n",
+               (unsigned long)s.posted, (unsigned long)s.coalesced, (unsigned long)s.applied,
+               (unsigned long)s.unbuilt, (unsigned long)s.dropped);
+    out.printf("  peak %u of %u slots pending\n", (unsigned)s.pendingPeak, (unsigned)s.capacity);
+}
+
+#endif // !HEADLESS
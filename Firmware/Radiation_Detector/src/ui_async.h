@@ -0,0 +1,57 @@
+#ifndef UI_ASYNC_H
+#define UI_ASYNC_H
+
+#include <Arduino.h>
+#include <lvgl.h>
+#include "config.h"
+
+// Widget access from tasks other than uiTask. LVGL is not thread-safe and
+// stays confined to uiTask; a global LVGL lock would make every producer
+// wait out a whole render. Instead a task queues a request here and uiTask
+// applies it at the top of its next pass, before anything else touches the
+// widgets, like lv_async_call() but safe to call from outside LVGL.
+//
+// The queue is a fixed table of UI_ASYNC_SLOTS slots claimed with atomic
+// compare-and-swap, so posting never blocks and never allocates. A request
+// for a widget (and operation) that is still pending replaces the pending
+// one instead of taking a second slot: a task setting the same label every
+// 100 ms costs one slot and one redraw per pass, whatever it posts. Requests
+// for different widgets run in the order they were posted. A full table
+// drops the request and counts it.
+//
+// Widgets are named by the address of their global (&ui_WIFIINFO) and read
+// at drain time, because screens are built on first use and rebuilt; a
+// request for a widget that does not exist then is dropped and counted.
+
+// Runs fn(arg) on uiTask. Identical calls (same fn and arg) still pending
+// run once.
+bool uiAsyncCall(void (*fn)(void*), void* arg);
+
+// lv_label_set_text(); the text is copied (up to UI_ASYNC_TEXT_MAX - 1 chars).
+bool uiAsyncSetLabel(lv_obj_t** label, const char* text);
+
+// lv_obj_invalidate(): redraws the widget.
+bool uiAsyncInvalidate(lv_obj_t** obj);
+
+// Sets or clears LV_OBJ_FLAG_HIDDEN.
+bool uiAsyncSetHidden(lv_obj_t** obj, bool hidden);
+
+// Applies the pending requests. uiTask only, at the top of each pass.
+// @return the number applied
+uint16_t uiAsyncDrain();
+
+struct UiAsyncStats {
+    uint32_t posted;
+    uint32_t coalesced;     ///< Merged into a pending request
+    uint32_t dropped;       ///< Table full
+    uint32_t unbuilt;       ///< Widget did not exist when applied
+    uint32_t applied;
+    uint16_t pendingPeak;   ///< Most slots in use at one drain
+    uint16_t capacity;      ///< UI_ASYNC_SLOTS
+};
+
+UiAsyncStats getUiAsyncStats();
+
+void printUiAsyncStats(Print& out);
+
+#endif // UI_ASYNC_H
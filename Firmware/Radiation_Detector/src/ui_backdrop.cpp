@@ -0,0 +1,155 @@
+/**
+ * @file ui_backdrop.cpp
+ * @brief Static layer of a screen snapshotted once into a PSRAM image.
+ *
+ * Nothing is hidden or restyled. Both the snapshot and later redraws go
+ * through lv_obj_redraw(), which draws an object (LV_EVENT_DRAW_MAIN_BEGIN to
+ * LV_EVENT_DRAW_POST_END) and then its children. A pre-process callback that
+ * stops those events skips the object's own drawing but not its children's,
+ * and stopping LV_EVENT_COVER_CHECK keeps LVGL from starting a redraw at an
+ * object that no longer draws. For the snapshot the callback sits on every
+ * live object; afterwards it moves to every static one, and the screen's own
+ * LV_EVENT_DRAW_MAIN copies the image instead of its background.
+ */
+
+#include "config.h"
+
+#if !HEADLESS
+
+#include "ui_backdrop.h"
+#include "esp_heap_caps.h"
+
+static const lv_obj_flag_t LIVE_FLAG = LV_OBJ_FLAG_USER_1;
+
+struct Backdrop {
+    lv_img_dsc_t image;     ///< Full screen, LV_IMG_CF_TRUE_COLOR
+    uint8_t* pixels;        ///< PSRAM
+};
+
+static bool enabled = UI_SCREEN_BACKDROPS;
+static UiBackdropStats stats;
+
+/**
+ * @brief An object whose look is fixed once built: a plain object, label, image or line.
+ */
+static bool bakeable(lv_obj_t* obj) {
+    if (lv_obj_has_flag_any(obj, LV_OBJ_FLAG_HIDDEN | LIVE_FLAG)) return false;
+    const lv_obj_class_t* cls = lv_obj_get_class(obj);
+    return cls == &lv_obj_class || cls == &lv_label_class || cls == &lv_img_class || cls == &lv_line_class;
+}
+
+/**
+ * @brief Pre-process callback: the object draws nothing of its own.
+ */
+static void skipDrawCb(lv_event_t* e) {
+    switch (lv_event_get_code(e)) {
+    case LV_EVENT_COVER_CHECK:
+        lv_event_set_cover_res(e, LV_COVER_RES_NOT_COVER);
+        lv_event_stop_processing(e);
+        break;
+    case LV_EVENT_DRAW_MAIN_BEGIN:
+    case LV_EVENT_DRAW_MAIN:
+    case LV_EVENT_DRAW_MAIN_END:
+    case LV_EVENT_DRAW_POST_BEGIN:
+    case LV_EVENT_DRAW_POST:
+    case LV_EVENT_DRAW_POST_END:
+        lv_event_stop_processing(e);
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief Adds or removes skipDrawCb on the live (or the static) objects below @p parent.
+ * @return objects changed
+ */
+static uint16_t setSkip(lv_obj_t* parent, bool live, bool add, bool parentLive) {
+    uint16_t changed = 0;
+    uint32_t children = lv_obj_get_child_cnt(parent);
+    for (uint32_t i = 0; i < children; i++) {
+        lv_obj_t* child = lv_obj_get_child(parent, i);
+        bool childLive = parentLive || !bakeable(child);
+        if (childLive == live) {
+            if (add) lv_obj_add_event_cb(child, skipDrawCb, (lv_event_code_t)(LV_EVENT_ALL | LV_EVENT_PREPROCESS), NULL);
+            else lv_obj_remove_event_cb(child, skipDrawCb);
+            changed++;
+        }
+        changed += setSkip(child, live, add, childLive);
+    }
+    return changed;
+}
+
+static void screenEventCb(lv_event_t* e) {
+    Backdrop* backdrop = (Backdrop*)lv_event_get_user_data(e);
+    if (lv_event_get_code(e) == LV_EVENT_DELETE) {
+        stats.screens--;
+        stats.bytes -= backdrop->image.data_size;
+        heap_caps_free(backdrop->pixels);
+        heap_caps_free(backdrop);
+        return;
+    }
+    // LV_EVENT_DRAW_MAIN: the image replaces the screen's background
+    lv_obj_t* screen = lv_event_get_target(e);
+    lv_draw_img_dsc_t dsc;
+    lv_draw_img_dsc_init(&dsc);
+    lv_draw_img(lv_event_get_draw_ctx(e), &dsc, &screen->coords, &backdrop->image);
+    lv_event_stop_processing(e);
+}
+
+void uiBackdropKeepLive(lv_obj_t* obj) {
+    if (obj) lv_obj_add_flag(obj, LIVE_FLAG);
+}
+
+bool uiBackdropBake(lv_obj_t* screen) {
+    if (!enabled || !screen) return false;
+    uint32_t start = micros();
+    uint32_t size = lv_snapshot_buf_size_needed(screen, LV_IMG_CF_TRUE_COLOR);
+    Backdrop* backdrop = (Backdrop*)heap_caps_malloc(sizeof(Backdrop), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    // Internal RAM is not spent on this; without PSRAM the screen draws as before
+    uint8_t* pixels = (uint8_t*)heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!backdrop || !pixels) {
+        heap_caps_free(backdrop);
+        heap_caps_free(pixels);
+        stats.failures++;
+        return false;
+    }
+
+    setSkip(screen, true, true, false);
+    lv_res_t res = lv_snapshot_take_to_buf(screen, LV_IMG_CF_TRUE_COLOR, &backdrop->image, pixels, size);
+    setSkip(screen, true, false, false);
+    if (res != LV_RES_OK) {
+        heap_caps_free(backdrop);
+        heap_caps_free(pixels);
+        stats.failures++;
+        return false;
+    }
+
+    backdrop->image.data_size = size; // Not set by lv_snapshot
+    backdrop->pixels = pixels;
+    stats.lastObjects = setSkip(screen, false, true, false);
+    lv_obj_add_event_cb(screen, screenEventCb, (lv_event_code_t)(LV_EVENT_DRAW_MAIN | LV_EVENT_PREPROCESS), backdrop);
+    lv_obj_add_event_cb(screen, screenEventCb, LV_EVENT_DELETE, backdrop);
+    lv_obj_invalidate(screen);
+    stats.screens++;
+    stats.bytes += backdrop->image.data_size;
+    stats.bakes++;
+    stats.lastUs = micros() - start;
+    return true;
+}
+
+void uiBackdropSetEnabled(bool value) {
+    enabled = value;
+}
+
+bool uiBackdropEnabled() {
+    return enabled;
+}
+
+UiBackdropStats getUiBackdropStats() {
+    UiBackdropStats s = stats;
+    s.enabled = enabled;
+    return s;
+}
+
+#endif // !HEADLESS
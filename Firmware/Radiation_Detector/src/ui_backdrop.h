@@ -0,0 +1,55 @@
+#ifndef UI_BACKDROP_H
+#define UI_BACKDROP_H
+
+#include <Arduino.h>
+#include <lvgl.h>
+#include "config.h"
+
+// Pre-rendered static layer of a screen ("screens backdrop"). Most of what the
+// main and chart screens draw never changes after the build: dividers,
+// captions, unit labels. After a screen is built and its created hook ran
+// (ui_screens.cpp), this renders everything but its live objects once with
+// lv_snapshot into a full-screen RGB565 image in PSRAM. The screen then draws
+// that image as its background, and the static objects skip their own drawing
+// through a pre-process event callback, so a redrawn area costs one image
+// copy plus the live objects in it. The objects themselves stay where they
+// are: layout, input, scrolling and the readout frames' overlap checks see
+// the same tree as before.
+//
+// Live, and drawn as usual with their whole subtree:
+//   - objects marked with uiBackdropKeepLive() (the application's values)
+//   - every object that is not a plain object, label, image or line
+//     (buttons show a pressed state, charts change)
+//   - objects hidden at the bake, which the application may show later
+//   - objects created after the bake (overlays, popups)
+// A static object that the application changes after the bake keeps its old
+// look until the screen is rebuilt, and one stacked above a live object ends
+// up below it; such objects have to be kept live. The image is freed with the
+// screen. LVGL task only.
+
+struct UiBackdropStats {
+    bool enabled;
+    uint8_t screens;           ///< Screens with a backdrop now
+    uint32_t bytes;            ///< PSRAM held by their images
+    uint32_t bakes;            ///< Since boot
+    uint32_t failures;         ///< No PSRAM or the snapshot failed
+    uint16_t lastObjects;      ///< Objects baked into the last image
+    uint32_t lastUs;           ///< Time of the last bake
+};
+
+// Keeps @p obj and its children out of the backdrop. Call from the created
+// hook, before the bake.
+void uiBackdropKeepLive(lv_obj_t* obj);
+
+// Renders the static objects of @p screen into its backdrop. Once per build.
+// @return false if the screen keeps drawing everything (disabled, no memory)
+bool uiBackdropBake(lv_obj_t* screen);
+
+// Enabled by default if UI_SCREEN_BACKDROPS; applies to screens built
+// afterwards ("screens backdrop on|off" rebuilds the active one to compare).
+void uiBackdropSetEnabled(bool enabled);
+bool uiBackdropEnabled();
+
+UiBackdropStats getUiBackdropStats();
+
+#endif // UI_BACKDROP_H
@@ -0,0 +1,110 @@
+/**
+ * @file ui_flatten.cpp
+ * @brief Dissolving of layout-only containers in the generated screens.
+ *
+ * Children are moved with lv_obj_set_parent(), which keeps their alignment
+ * and offsets but measures them from the new parent. After the move the
+ * offset is corrected by the distance the child jumped, found by laying it
+ * out again, so the result does not depend on how the child is aligned.
+ */
+
+#include "config.h"
+
+#if !HEADLESS
+
+#include "ui_flatten.h"
+
+static bool enabled = UI_FLATTEN_SCREENS;
+
+static bool invisible(lv_coord_t width, lv_opa_t opa) {
+    return width == 0 || opa <= LV_OPA_MIN;
+}
+
+/**
+ * @brief A plain object that draws nothing of its own and does nothing but hold children.
+ */
+static bool layoutOnly(lv_obj_t* obj) {
+    if (!lv_obj_check_type(obj, &lv_obj_class) || !lv_obj_get_parent(obj)) return false;
+    if (lv_obj_has_flag_any(obj, LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE)) return false;
+    if (obj->spec_attr && obj->spec_attr->event_dsc_cnt) return false;
+    if (lv_obj_get_style_layout(obj, LV_PART_MAIN)) return false;
+    if (lv_obj_get_style_opa(obj, LV_PART_MAIN) != LV_OPA_COVER) return false;
+    if (lv_obj_get_style_bg_opa(obj, LV_PART_MAIN) > LV_OPA_MIN) return false;
+    if (lv_obj_get_style_bg_img_src(obj, LV_PART_MAIN)) return false;
+    if (!invisible(lv_obj_get_style_border_width(obj, LV_PART_MAIN), lv_obj_get_style_border_opa(obj, LV_PART_MAIN)))
+        return false;
+    if (!invisible(lv_obj_get_style_outline_width(obj, LV_PART_MAIN), lv_obj_get_style_outline_opa(obj, LV_PART_MAIN)))
+        return false;
+    if (!invisible(lv_obj_get_style_shadow_width(obj, LV_PART_MAIN), lv_obj_get_style_shadow_opa(obj, LV_PART_MAIN)))
+        return false;
+    return true;
+}
+
+/**
+ * @brief The children can move: absolute sizes and offsets, and inside the
+ *        container, so its clipping never showed.
+ */
+static bool childrenMovable(lv_obj_t* container) {
+    uint32_t children = lv_obj_get_child_cnt(container);
+    for (uint32_t i = 0; i < children; i++) {
+        lv_obj_t* child = lv_obj_get_child(container, i);
+        if (LV_COORD_IS_PCT(lv_obj_get_style_width(child, LV_PART_MAIN)) ||
+            LV_COORD_IS_PCT(lv_obj_get_style_height(child, LV_PART_MAIN)) ||
+            LV_COORD_IS_PCT(lv_obj_get_style_x(child, LV_PART_MAIN)) ||
+            LV_COORD_IS_PCT(lv_obj_get_style_y(child, LV_PART_MAIN))) {
+            return false;
+        }
+        if (!_lv_area_is_in(&child->coords, &container->coords, 0)) return false;
+    }
+    return true;
+}
+
+static bool dissolve(lv_obj_t* container) {
+    if (!layoutOnly(container)) return false;
+    lv_obj_update_layout(container);
+    if (!childrenMovable(container)) return false;
+
+    lv_obj_t* parent = lv_obj_get_parent(container);
+    uint32_t index = lv_obj_get_index(container);
+    while (lv_obj_get_child_cnt(container)) {
+        lv_obj_t* child = lv_obj_get_child(container, 0);
+        lv_area_t before = child->coords;
+        lv_obj_set_parent(child, parent);
+        lv_obj_move_to_index(child, index++);
+        lv_obj_update_layout(child);
+        lv_obj_set_pos(child, lv_obj_get_x_aligned(child) + before.x1 - child->coords.x1,
+                       lv_obj_get_y_aligned(child) + before.y1 - child->coords.y1);
+    }
+    lv_obj_del(container);
+    return true;
+}
+
+uint8_t uiFlattenContainers(lv_obj_t** const* containers) {
+    if (!enabled || !containers) return 0;
+    uint8_t dissolved = 0;
+    for (; *containers; containers++) {
+        lv_obj_t** container = *containers;
+        if (*container && dissolve(*container)) {
+            *container = NULL;
+            dissolved++;
+        }
+    }
+    return dissolved;
+}
+
+void uiFlattenSetEnabled(bool value) {
+    enabled = value;
+}
+
+bool uiFlattenEnabled() {
+    return enabled;
+}
+
+uint32_t uiObjectCount(lv_obj_t* obj) {
+    uint32_t count = 1;
+    uint32_t children = lv_obj_get_child_cnt(obj);
+    for (uint32_t i = 0; i < children; i++) count += uiObjectCount(lv_obj_get_child(obj, i));
+    return count;
+}
+
+#endif // !HEADLESS
@@ -0,0 +1,33 @@
+#ifndef UI_FLATTEN_H
+#define UI_FLATTEN_H
+
+#include <Arduino.h>
+#include <lvgl.h>
+#include "config.h"
+
+// Flatter object trees for the screens that are up nearly all the time
+// ("screens flat"). SquareLine wraps the navigation bar and the chart range
+// buttons in containers that draw nothing and exist only to position their
+// children; every such level costs an object, a clip area and a layout and
+// invalidation step on each refresh. After a screen is built, ui_screens.cpp
+// dissolves the containers it lists for that screen: their children move to
+// the container's parent at the container's place in the drawing order, with
+// their offsets adjusted so they stay on the same pixels (alignment is kept,
+// so labels that change width stay centred), and the container is deleted
+// and its ui_* pointer cleared. A container is left alone unless it really
+// is layout only: a plain object that draws nothing, takes no input, has no
+// event callbacks or layout, and clips none of its children. So a later
+// SquareLine change that gives it a look or a role keeps it. LVGL task only.
+
+// Dissolves each container of the NULL-terminated list that qualifies.
+// @return the number dissolved
+uint8_t uiFlattenContainers(lv_obj_t** const* containers);
+
+// Enabled by default if UI_FLATTEN_SCREENS; applies to screens built afterwards.
+void uiFlattenSetEnabled(bool enabled);
+bool uiFlattenEnabled();
+
+// Objects in the tree of @p obj, itself included.
+uint32_t uiObjectCount(lv_obj_t* obj);
+
+#endif // UI_FLATTEN_H
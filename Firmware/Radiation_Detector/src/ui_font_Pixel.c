@@ -1,7 +1,9 @@
 /*******************************************************************************
  * Size: 30 px
  * Bpp: 1
- * Opts: --bpp 1 --size 30 --font C:/Users/pablo/OneDrive/Documentos/GitHub/Radiation-Detector/User Interface/SquareLineFiles/assets/VCR_OSD_MONO.ttf -o C:/Users/pablo/OneDrive/Documentos/GitHub/Radiation-Detector/User Interface/SquareLineFiles/assets\ui_font_Pixel.c --format lvgl -r 0x20-0x7f --no-compress --no-prefilter
+ * Generated by tools/subset_font.py from the SquareLine export - do not edit.
+ * Symbols:  +-.0123456789V
+ * Bitmaps: compressed
  ******************************************************************************/
 
 #include "ui.h"
@@ -21,578 +23,92 @@ static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {
     /* U+0020 " " */
     0x0,
 
-    /* U+0021 "!" */
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xf8, 0x3, 0xfe,
-
-    /* U+0022 "\"" */
-    0xf0, 0xff, 0xf, 0xf0, 0xff, 0xf, 0x60, 0x66,
-    0x6,
-
-    /* U+0023 "#" */
-    0x0, 0x70, 0x38, 0xe0, 0x71, 0xc0, 0xe3, 0xf1,
-    0xc7, 0xe3, 0xff, 0xff, 0xfc, 0x7f, 0xf8, 0xfc,
-    0x70, 0x38, 0xe0, 0x71, 0xf8, 0xe3, 0xf1, 0xff,
-    0xff, 0xfe, 0x3f, 0xfc, 0x7e, 0x38, 0x1c, 0x70,
-    0x38, 0xe0, 0x70, 0x0,
-
-    /* U+0024 "$" */
-    0x3, 0x80, 0x3f, 0xe0, 0x7f, 0xc1, 0xff, 0xc3,
-    0xbb, 0x9f, 0x77, 0xfe, 0xef, 0xf1, 0xc7, 0xfb,
-    0x80, 0x7f, 0xe0, 0x7f, 0xc0, 0xff, 0xc0, 0x3b,
-    0xfc, 0x71, 0xfe, 0xef, 0xfd, 0xdf, 0x3f, 0xf8,
-    0x7f, 0xf0, 0x7f, 0xc0, 0x1c, 0x0, 0x38, 0x0,
-
-    /* U+0025 "%" */
-    0x3c, 0xf, 0xfc, 0x1f, 0xf8, 0x3f, 0x70, 0x7e,
-    0xe0, 0xfd, 0xc7, 0xff, 0x9e, 0x1f, 0x30, 0x3d,
-    0xe0, 0x7, 0x80, 0xc, 0x0, 0x78, 0x1, 0xe7,
-    0x87, 0xbf, 0xcf, 0x7f, 0xf8, 0xe7, 0xe1, 0xcf,
-    0xc3, 0x9f, 0x87, 0xff, 0x3, 0xce, 0x7, 0x80,
-
-    /* U+0026 "&" */
-    0x7, 0x80, 0xf, 0x0, 0x7f, 0x3, 0x83, 0x87,
-    0x7, 0xe, 0xe, 0x1c, 0x1c, 0x38, 0x38, 0x70,
-    0x70, 0x3b, 0x80, 0x7f, 0x0, 0xfe, 0x7, 0xf8,
-    0xf, 0xf0, 0x3f, 0xe0, 0x71, 0xe7, 0xe1, 0xff,
-    0xc3, 0xff, 0x81, 0xe7, 0x83, 0xcf, 0x7, 0x8f,
-    0xff, 0xc7, 0xf3, 0x8f, 0xe7,
-
-    /* U+0027 "'" */
-    0xff, 0xff, 0x66,
-
-    /* U+0028 "(" */
-    0xe, 0x38, 0x73, 0x8e, 0x1c, 0x38, 0x70, 0xe1,
-    0xc3, 0x87, 0xe, 0x1c, 0x38, 0x70, 0xe1, 0xc3,
-    0x83, 0x87, 0x3, 0x83, 0x87,
-
-    /* U+0029 ")" */
-    0xe0, 0xe1, 0xc0, 0xe0, 0xe1, 0xc3, 0x87, 0xe,
-    0x1c, 0x38, 0x70, 0xe1, 0xc3, 0x87, 0xe, 0x1c,
-    0x38, 0xe1, 0xce, 0x38, 0x70,
-
-    /* U+002A "*" */
-    0xe, 0xc, 0xe3, 0xee, 0x7e, 0xe7, 0x3f, 0xc1,
-    0xf8, 0x1f, 0x83, 0xfc, 0xee, 0x7e, 0xe7, 0xce,
-    0x30, 0xe0, 0xe, 0x0,
-
     /* U+002B "+" */
-    0x3, 0x80, 0x7, 0x0, 0xe, 0x0, 0x1c, 0x0,
-    0x38, 0x0, 0x70, 0x3f, 0xff, 0xff, 0xff, 0xff,
-    0xfe, 0x7, 0x0, 0xe, 0x0, 0x1c, 0x0, 0x38,
-    0x0, 0x70, 0x0, 0xe0, 0x0,
-
-    /* U+002C "," */
-    0x1c, 0x71, 0xdc, 0xe3, 0x80,
+    0x3d, 0xc7, 0xff, 0xfc, 0xf7, 0xe2, 0xfc, 0x7f,
+    0xf4, 0xbf, 0x17, 0xe3, 0xff, 0xfe,
 
     /* U+002D "-" */
-    0xff, 0xff, 0xff, 0xff, 0xf0,
+    0xff, 0xf1, 0xff, 0xcc,
 
     /* U+002E "." */
-    0xff, 0x80,
-
-    /* U+002F "/" */
-    0x0, 0xe, 0x0, 0x1c, 0x0, 0x38, 0x0, 0x70,
-    0x0, 0xe0, 0x7, 0xc0, 0x1e, 0x0, 0x3c, 0x0,
-    0xf0, 0x7, 0x80, 0xe, 0x0, 0x3c, 0x1, 0xe0,
-    0x7, 0x80, 0xf, 0x0, 0x7c, 0x0, 0xe0, 0x1,
-    0xc0, 0x3, 0x80, 0x7, 0x0, 0xe, 0x0, 0x0,
+    0xe3, 0xc0,
 
     /* U+0030 "0" */
-    0x1f, 0xf0, 0x3f, 0xe1, 0xff, 0xe7, 0xc1, 0xff,
-    0x83, 0xfc, 0x1, 0xf8, 0x1f, 0xf0, 0x3f, 0xe1,
-    0xff, 0xc7, 0x9f, 0x9f, 0x3f, 0x3c, 0x7f, 0xf0,
-    0xff, 0x81, 0xff, 0x3, 0xf0, 0x7, 0xf8, 0x3f,
-    0xf0, 0x7d, 0xff, 0xe3, 0xff, 0xc1, 0xff, 0x0,
+    0x2f, 0xf8, 0xff, 0xe3, 0xe3, 0xfa, 0x26, 0xf8,
+    0xb1, 0xff, 0xc6, 0xc7, 0x63, 0xff, 0x71, 0xff,
+    0xcd, 0xc7, 0xfe, 0x96, 0x3f, 0x4f, 0xfe, 0x34,
+    0xfd, 0x8a, 0x7f, 0xec, 0x7f, 0xf3, 0x78, 0xff,
+    0xd8, 0xec, 0x7f, 0xf1, 0xa6, 0xf8, 0xb1, 0xff,
+    0xc4, 0xc7, 0xf4,
 
     /* U+0031 "1" */
-    0x1c, 0x3e, 0x1f, 0x1f, 0x8f, 0xc7, 0xe0, 0x70,
-    0x38, 0x1c, 0xe, 0x7, 0x3, 0x81, 0xc0, 0xe0,
-    0x70, 0x38, 0x1c, 0xe, 0x3f, 0xff, 0xff, 0xf8,
+    0x2e, 0x36, 0x3f, 0xf8, 0x73, 0xff, 0x9d, 0xc7,
+    0xff, 0xfc, 0xff, 0xe9, 0x71, 0x71, 0xff, 0xc6,
 
     /* U+0032 "2" */
-    0x1f, 0xf0, 0x7f, 0xf0, 0xff, 0xe7, 0xc1, 0xff,
-    0x83, 0xfc, 0x1, 0xc0, 0x3, 0x80, 0x1f, 0x0,
-    0x3e, 0x3f, 0xf0, 0xff, 0xc1, 0xff, 0x8f, 0x80,
-    0x1f, 0x0, 0x38, 0x0, 0x70, 0x0, 0xe0, 0x1,
-    0xc0, 0x3, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe0,
+    0x2f, 0xf8, 0xe9, 0xfd, 0x3f, 0xf8, 0xb8, 0xbe,
+    0x2c, 0x7f, 0xf1, 0xb1, 0xd8, 0xb8, 0xff, 0xe5,
+    0x63, 0xff, 0x93, 0xfc, 0x58, 0x4f, 0xe9, 0xff,
+    0xc5, 0xc5, 0xfc, 0x7f, 0xf2, 0x71, 0xff, 0xee,
+    0xff, 0xf1, 0xff, 0xd2,
 
     /* U+0033 "3" */
-    0x1f, 0xf0, 0xff, 0xf1, 0xff, 0xe7, 0xc1, 0xff,
-    0x83, 0xfc, 0x1, 0xc0, 0x3, 0x80, 0x1f, 0x0,
-    0x3e, 0x7, 0xf0, 0xf, 0xe0, 0x1f, 0xc0, 0x3,
-    0xe0, 0x1, 0xc0, 0x3, 0xf0, 0x7, 0xf0, 0x3f,
-    0xe0, 0x7d, 0xff, 0xe0, 0xff, 0x81, 0xff, 0x0,
+    0x2f, 0xf8, 0xd8, 0xfe, 0x9f, 0xfc, 0x59, 0xbe,
+    0x2c, 0x7f, 0xf1, 0xb1, 0xd8, 0xb8, 0xff, 0xe5,
+    0x63, 0xff, 0x99, 0xe2, 0xc7, 0xff, 0x63, 0xc5,
+    0x8f, 0xf6, 0x3f, 0xf8, 0xdc, 0x7f, 0xf0, 0xe7,
+    0xb1, 0xff, 0xc6, 0x97, 0xe2, 0xcc, 0x7f, 0x4f,
+    0xfe, 0x28,
 
     /* U+0034 "4" */
-    0x0, 0x70, 0x0, 0xe0, 0x7, 0xc0, 0x1f, 0x80,
-    0x3f, 0x1, 0xfe, 0x7, 0x9c, 0x1e, 0x38, 0x3c,
-    0x71, 0xf0, 0xe3, 0x81, 0xc7, 0x3, 0x8f, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0x80, 0x38, 0x0, 0x70,
-    0x0, 0xe0, 0x1, 0xc0, 0x3, 0x80, 0x7, 0x0,
+    0x3f, 0xb8, 0xff, 0xe6, 0xe3, 0xff, 0x4f, 0xfe,
+    0x7e, 0x3f, 0xf4, 0xb1, 0xfa, 0x53, 0xff, 0x97,
+    0x8a, 0x7f, 0xec, 0x7f, 0xf4, 0x3f, 0x17, 0x1f,
+    0xfd, 0x2f, 0xf8, 0xb8, 0xff, 0xff, 0x80,
 
     /* U+0035 "5" */
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x0, 0xe,
-    0x0, 0x1c, 0x0, 0x3f, 0xfc, 0x7f, 0xfc, 0xff,
-    0xf8, 0x0, 0x3c, 0x0, 0x78, 0x0, 0x70, 0x0,
-    0xe0, 0x1, 0xc0, 0x3, 0xf0, 0x7, 0xf8, 0x1f,
-    0xf0, 0x3d, 0xff, 0xe0, 0xff, 0x81, 0xff, 0x0,
+    0xff, 0xf8, 0x67, 0xff, 0x57, 0xff, 0xc7, 0xff,
+    0x57, 0xfe, 0x3f, 0xf8, 0x73, 0xff, 0x8b, 0xff,
+    0xc3, 0x1f, 0xfc, 0xe9, 0xff, 0xe4, 0xe3, 0xff,
+    0x87, 0x8f, 0x4f, 0xfe, 0x34, 0xdf, 0x86, 0x63,
+    0xfa, 0x7f, 0xf1, 0x40,
 
     /* U+0036 "6" */
-    0x1f, 0xf0, 0xff, 0xf1, 0xff, 0xe7, 0xc1, 0xff,
-    0x83, 0xfc, 0x1, 0xf8, 0x0, 0x70, 0x0, 0xe0,
-    0x1, 0xff, 0xe3, 0xff, 0xe7, 0xff, 0xce, 0x3,
-    0xfc, 0x7, 0xf8, 0x3, 0xf0, 0x7, 0xf8, 0x3f,
-    0xf0, 0x7d, 0xff, 0xe0, 0xff, 0x81, 0xff, 0x0,
+    0x2f, 0xf8, 0xd8, 0xfe, 0x9f, 0xfc, 0x59, 0xbe,
+    0x2c, 0x7f, 0xf1, 0xb1, 0xd8, 0xff, 0xe1, 0xf1,
+    0xff, 0xd5, 0xff, 0x8f, 0xfe, 0x1c, 0xff, 0xe4,
+    0x7f, 0x16, 0x3f, 0xf9, 0xb8, 0xff, 0xe4, 0xe3,
+    0xb1, 0xff, 0xc6, 0x9b, 0xe2, 0xcc, 0x7f, 0x4f,
+    0xfe, 0x28,
 
     /* U+0037 "7" */
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xf8, 0x0, 0x70,
-    0x0, 0xe0, 0x1, 0xc0, 0xf, 0x80, 0x1f, 0x0,
-    0x78, 0x1, 0xe0, 0x3, 0x80, 0x1f, 0x0, 0x38,
-    0x0, 0x70, 0x0, 0xe0, 0x1, 0xc0, 0x3, 0x80,
-    0x7, 0x0, 0xe, 0x0, 0x1c, 0x0, 0x38, 0x0,
+    0xff, 0xf8, 0x67, 0xff, 0x4b, 0xff, 0xc7, 0xff,
+    0x7f, 0x1f, 0xfc, 0xf9, 0x63, 0xf4, 0xa7, 0xff,
+    0x6, 0x7f, 0x63, 0xff, 0x89, 0x8f, 0xff, 0xf9,
+    0xff, 0xe5,
 
     /* U+0038 "8" */
-    0x1f, 0xf0, 0xff, 0xf1, 0xff, 0xe7, 0xc1, 0xfe,
-    0x0, 0xfc, 0x1, 0xf8, 0x3, 0xfc, 0x1f, 0xf8,
-    0x3e, 0xff, 0xf1, 0xff, 0xe3, 0xff, 0xcf, 0x83,
-    0xfc, 0x1, 0xf8, 0x3, 0xf0, 0x7, 0xf8, 0x3f,
-    0xf0, 0x7d, 0xff, 0xe0, 0xff, 0x81, 0xff, 0x0,
+    0x2f, 0xf8, 0xd8, 0xfe, 0x9f, 0xfc, 0x59, 0xbe,
+    0x2c, 0x58, 0xec, 0x7f, 0xf6, 0x31, 0xd8, 0xff,
+    0xe3, 0x4d, 0xf1, 0x63, 0xff, 0xa5, 0x37, 0xc5,
+    0x8b, 0x1d, 0x8f, 0xfe, 0xc6, 0x3b, 0x1f, 0xfc,
+    0x69, 0xbe, 0x2c, 0xc7, 0xf4, 0xff, 0xe2, 0x80,
 
     /* U+0039 "9" */
-    0x1f, 0xf0, 0xff, 0xf1, 0xff, 0xe7, 0xc1, 0xff,
-    0x83, 0xfc, 0x1, 0xf8, 0x3, 0xf0, 0x7, 0xf8,
-    0xe, 0xff, 0xfc, 0x7f, 0xf8, 0xff, 0xf0, 0x0,
-    0xe0, 0x1, 0xc0, 0x3, 0xf0, 0x7, 0xf8, 0x3f,
-    0xf0, 0x7d, 0xff, 0xe0, 0xff, 0x81, 0xff, 0x0,
-
-    /* U+003A ":" */
-    0xff, 0x80, 0x0, 0x0, 0xf, 0xf8,
-
-    /* U+003B ";" */
-    0x1c, 0x71, 0xc0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x1c, 0x71, 0xdc, 0xe3, 0x80,
-
-    /* U+003C "<" */
-    0x0, 0x70, 0x7, 0x1, 0xf0, 0x1c, 0x3, 0xc0,
-    0x78, 0x6, 0x1, 0xe0, 0x3c, 0x3, 0x80, 0xf8,
-    0xe, 0x0, 0xe0, 0xf, 0x80, 0x3c, 0x1, 0xc0,
-    0x1e, 0x0, 0x78, 0x3, 0xc0, 0x3c, 0x1, 0xf0,
-    0x7, 0x0, 0x70,
-
-    /* U+003D "=" */
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xf8, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x3f, 0xff, 0xff, 0xff, 0xff,
-    0xfe,
-
-    /* U+003E ">" */
-    0xe0, 0xe, 0x0, 0xf8, 0x3, 0x80, 0x3c, 0x1,
-    0xe0, 0x6, 0x0, 0x78, 0x3, 0xc0, 0x1c, 0x1,
-    0xf0, 0x7, 0x0, 0x70, 0x1f, 0x3, 0xc0, 0x38,
-    0x7, 0x81, 0xe0, 0x3c, 0x3, 0xc0, 0xf8, 0xe,
-    0x0, 0xe0, 0x0,
-
-    /* U+003F "?" */
-    0x1f, 0xf0, 0xff, 0xf1, 0xff, 0xe7, 0xc1, 0xff,
-    0x83, 0xfc, 0x1, 0xc0, 0x3, 0x80, 0x7, 0x0,
-    0x3e, 0x0, 0xf0, 0x3, 0xc0, 0x7, 0x80, 0x3e,
-    0x0, 0x70, 0x0, 0xe0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0xe, 0x0, 0x1c, 0x0, 0x38, 0x0,
-
-    /* U+0040 "@" */
-    0x1f, 0xf0, 0x60, 0x30, 0xc0, 0x67, 0x0, 0x7c,
-    0xe6, 0x79, 0xcc, 0xf7, 0x79, 0xee, 0xf3, 0xdd,
-    0xe7, 0xbb, 0xcf, 0x77, 0xbe, 0xef, 0x7c, 0xf1,
-    0x9c, 0x0, 0x38, 0x0, 0x18, 0xc, 0x1f, 0xf0,
-    0x3f, 0xe0,
-
-    /* U+0041 "A" */
-    0x3, 0x80, 0x7, 0x0, 0x3f, 0x0, 0xff, 0x81,
-    0xc7, 0x7, 0x8f, 0x3c, 0xf, 0xf0, 0x7, 0xe0,
-    0xf, 0xc0, 0x1f, 0x80, 0x3f, 0x0, 0x7f, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xf0, 0x7, 0xe0, 0xf,
-    0xc0, 0x1f, 0x80, 0x3f, 0x0, 0x7e, 0x0, 0xe0,
-
-    /* U+0042 "B" */
-    0xff, 0xf1, 0xff, 0xfb, 0xff, 0xf7, 0x1, 0xfe,
-    0x0, 0xfc, 0x1, 0xf8, 0x3, 0xf0, 0x1f, 0xe0,
-    0x3f, 0xff, 0xfb, 0xff, 0xf7, 0xff, 0xee, 0x3,
-    0xfc, 0x1, 0xf8, 0x3, 0xf0, 0x7, 0xe0, 0x3f,
-    0xc0, 0x7f, 0xff, 0xf7, 0xff, 0x8f, 0xff, 0x0,
-
-    /* U+0043 "C" */
-    0x1f, 0xf0, 0xff, 0xf1, 0xff, 0xe7, 0xc1, 0xff,
-    0x83, 0xfc, 0x1, 0xf8, 0x0, 0x70, 0x0, 0xe0,
-    0x1, 0xc0, 0x3, 0x80, 0x7, 0x0, 0xe, 0x0,
-    0x1c, 0x0, 0x38, 0x0, 0x70, 0x7, 0xf8, 0x3f,
-    0xf0, 0x7d, 0xff, 0xe0, 0xff, 0x81, 0xff, 0x0,
-
-    /* U+0044 "D" */
-    0xff, 0xf1, 0xff, 0xfb, 0xff, 0xf7, 0x0, 0xfe,
-    0x1, 0xfc, 0x1, 0xf8, 0x3, 0xf0, 0x7, 0xe0,
-    0xf, 0xc0, 0x1f, 0x80, 0x3f, 0x0, 0x7e, 0x0,
-    0xfc, 0x1, 0xf8, 0x3, 0xf0, 0x7, 0xe0, 0xf,
-    0xc0, 0x3f, 0xff, 0xf7, 0xff, 0x8f, 0xff, 0x0,
-
-    /* U+0045 "E" */
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x0, 0xe,
-    0x0, 0x1c, 0x0, 0x38, 0x0, 0x70, 0x0, 0xe0,
-    0x1, 0xff, 0xe3, 0xff, 0xc7, 0xff, 0x8e, 0x0,
-    0x1c, 0x0, 0x38, 0x0, 0x70, 0x0, 0xe0, 0x1,
-    0xc0, 0x3, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe0,
-
-    /* U+0046 "F" */
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x0, 0xe,
-    0x0, 0x1c, 0x0, 0x38, 0x0, 0x70, 0x0, 0xe0,
-    0x1, 0xff, 0xe3, 0xff, 0xc7, 0xff, 0x8e, 0x0,
-    0x1c, 0x0, 0x38, 0x0, 0x70, 0x0, 0xe0, 0x1,
-    0xc0, 0x3, 0x80, 0x7, 0x0, 0xe, 0x0, 0x0,
-
-    /* U+0047 "G" */
-    0x1f, 0xf0, 0xff, 0xf1, 0xff, 0xe7, 0xc1, 0xff,
-    0x83, 0xfc, 0x1, 0xf8, 0x0, 0x70, 0x0, 0xe0,
-    0x1, 0xc3, 0xff, 0x87, 0xff, 0xf, 0xfe, 0x0,
-    0xfc, 0x1, 0xf8, 0x3, 0xf0, 0x7, 0xf8, 0x3f,
-    0xf0, 0x7d, 0xff, 0xe0, 0xff, 0x81, 0xff, 0x0,
-
-    /* U+0048 "H" */
-    0xe0, 0xf, 0xc0, 0x1f, 0x80, 0x3f, 0x0, 0x7e,
-    0x0, 0xfc, 0x1, 0xf8, 0x3, 0xf0, 0x7, 0xe0,
-    0xf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe, 0x0,
-    0xfc, 0x1, 0xf8, 0x3, 0xf0, 0x7, 0xe0, 0xf,
-    0xc0, 0x1f, 0x80, 0x3f, 0x0, 0x7e, 0x0, 0xe0,
-
-    /* U+0049 "I" */
-    0xff, 0xff, 0xff, 0xe3, 0x81, 0xc0, 0xe0, 0x70,
-    0x38, 0x1c, 0xe, 0x7, 0x3, 0x81, 0xc0, 0xe0,
-    0x70, 0x38, 0x1c, 0xe, 0x3f, 0xff, 0xff, 0xf8,
-
-    /* U+004A "J" */
-    0x3, 0xfe, 0x7, 0xfc, 0xf, 0xf8, 0x3, 0x80,
-    0x7, 0x0, 0xe, 0x0, 0x1c, 0x0, 0x38, 0x0,
-    0x70, 0x0, 0xe0, 0x1, 0xc0, 0x3, 0x80, 0x7,
-    0x0, 0xe, 0x0, 0x1c, 0x70, 0x38, 0xf9, 0xf1,
-    0xf3, 0xe1, 0xff, 0x3, 0xfe, 0x1, 0xf8, 0x0,
-
-    /* U+004B "K" */
-    0xe0, 0xf, 0xc0, 0x1f, 0x80, 0xff, 0x3, 0xce,
-    0x7, 0x9c, 0x1e, 0x38, 0xf0, 0x73, 0xc0, 0xe7,
-    0x81, 0xfe, 0x3, 0xfc, 0x7, 0xf8, 0xe, 0x78,
-    0x1c, 0x70, 0x38, 0xf0, 0x70, 0x78, 0xe0, 0x79,
-    0xc0, 0xf3, 0x80, 0xff, 0x0, 0x7e, 0x0, 0xe0,
-
-    /* U+004C "L" */
-    0xe0, 0x1, 0xc0, 0x3, 0x80, 0x7, 0x0, 0xe,
-    0x0, 0x1c, 0x0, 0x38, 0x0, 0x70, 0x0, 0xe0,
-    0x1, 0xc0, 0x3, 0x80, 0x7, 0x0, 0xe, 0x0,
-    0x1c, 0x0, 0x38, 0x0, 0x70, 0x0, 0xe0, 0x1,
-    0xc0, 0x3, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe0,
-
-    /* U+004D "M" */
-    0xe0, 0xf, 0xc0, 0x1f, 0x80, 0x3f, 0x81, 0xff,
-    0x3, 0xff, 0x8f, 0xff, 0xff, 0xf7, 0xe7, 0xef,
-    0xcf, 0xc7, 0x1f, 0x8e, 0x3f, 0x1c, 0x7e, 0x0,
-    0xfc, 0x1, 0xf8, 0x3, 0xf0, 0x7, 0xe0, 0xf,
-    0xc0, 0x1f, 0x80, 0x3f, 0x0, 0x7e, 0x0, 0xe0,
-
-    /* U+004E "N" */
-    0xe0, 0xf, 0xc0, 0x1f, 0x80, 0x3f, 0x0, 0x7e,
-    0x0, 0xff, 0x1, 0xff, 0x3, 0xfe, 0x7, 0xff,
-    0xf, 0xcf, 0x1f, 0x8e, 0x3f, 0x1e, 0x7e, 0x1f,
-    0xfc, 0xf, 0xf8, 0x1f, 0xf0, 0x1f, 0xe0, 0xf,
-    0xc0, 0x1f, 0x80, 0x3f, 0x0, 0x7e, 0x0, 0xe0,
-
-    /* U+004F "O" */
-    0x1f, 0xf0, 0x3f, 0xe1, 0xff, 0xe7, 0xc1, 0xff,
-    0x83, 0xfc, 0x1, 0xf8, 0x3, 0xf0, 0x7, 0xe0,
-    0xf, 0xc0, 0x1f, 0x80, 0x3f, 0x0, 0x7e, 0x0,
-    0xfc, 0x1, 0xf8, 0x3, 0xf0, 0x7, 0xf8, 0x1f,
-    0xf0, 0x3d, 0xff, 0xe3, 0xff, 0xc1, 0xff, 0x0,
-
-    /* U+0050 "P" */
-    0xff, 0xf1, 0xff, 0xfb, 0xff, 0xf7, 0x1, 0xfe,
-    0x3, 0xfc, 0x1, 0xf8, 0x3, 0xf0, 0x1f, 0xe0,
-    0x3f, 0xff, 0xfb, 0xff, 0xc7, 0xff, 0x8e, 0x0,
-    0x1c, 0x0, 0x38, 0x0, 0x70, 0x0, 0xe0, 0x1,
-    0xc0, 0x3, 0x80, 0x7, 0x0, 0xe, 0x0, 0x0,
-
-    /* U+0051 "Q" */
-    0x1f, 0xf0, 0xff, 0xf1, 0xff, 0xe7, 0xc1, 0xff,
-    0x83, 0xfc, 0x1, 0xf8, 0x3, 0xf0, 0x7, 0xe0,
-    0xf, 0xc0, 0x1f, 0x80, 0x3f, 0x0, 0x7e, 0x38,
-    0xfc, 0x7d, 0xf8, 0xfb, 0xf0, 0xff, 0xf8, 0x79,
-    0xf0, 0xf1, 0xff, 0xf8, 0xfc, 0x71, 0xf8, 0xe0,
-
-    /* U+0052 "R" */
-    0xff, 0xf1, 0xff, 0xf3, 0xff, 0xe7, 0x1, 0xfe,
-    0x3, 0xfc, 0x1, 0xf8, 0x3, 0xf0, 0x1f, 0xe0,
-    0x3f, 0xff, 0xf3, 0xff, 0xc7, 0xff, 0x8e, 0x78,
-    0x1c, 0xf0, 0x38, 0xf0, 0x70, 0x78, 0xe0, 0xf9,
-    0xc0, 0xf3, 0x80, 0xff, 0x0, 0x7e, 0x0, 0xe0,
-
-    /* U+0053 "S" */
-    0x1f, 0xf0, 0x7f, 0xf0, 0xff, 0xe7, 0xc1, 0xff,
-    0x83, 0xfc, 0x1, 0xf8, 0x0, 0x7c, 0x0, 0xf8,
-    0x0, 0x7f, 0xe0, 0x7f, 0xe0, 0xff, 0xc0, 0x3,
-    0xe0, 0x7, 0xc0, 0x3, 0xf0, 0x7, 0xf8, 0x3f,
-    0xf0, 0x7c, 0xff, 0xe0, 0xff, 0x81, 0xff, 0x0,
-
-    /* U+0054 "T" */
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xf8, 0x1c, 0x0,
-    0x38, 0x0, 0x70, 0x0, 0xe0, 0x1, 0xc0, 0x3,
-    0x80, 0x7, 0x0, 0xe, 0x0, 0x1c, 0x0, 0x38,
-    0x0, 0x70, 0x0, 0xe0, 0x1, 0xc0, 0x3, 0x80,
-    0x7, 0x0, 0xe, 0x0, 0x1c, 0x0, 0x38, 0x0,
-
-    /* U+0055 "U" */
-    0xe0, 0xf, 0xc0, 0x1f, 0x80, 0x3f, 0x0, 0x7e,
-    0x0, 0xfc, 0x1, 0xf8, 0x3, 0xf0, 0x7, 0xe0,
-    0xf, 0xc0, 0x1f, 0x80, 0x3f, 0x0, 0x7e, 0x0,
-    0xfc, 0x1, 0xf8, 0x3, 0xf0, 0x7, 0xf8, 0x3f,
-    0xf0, 0x7d, 0xff, 0xe3, 0xff, 0xc1, 0xff, 0x0,
+    0x2f, 0xf8, 0xd8, 0xfe, 0x9f, 0xfc, 0x59, 0xbe,
+    0x2c, 0x7f, 0xf1, 0xb1, 0xd8, 0xff, 0xec, 0x63,
+    0xfd, 0x37, 0xf1, 0xb1, 0xff, 0xd2, 0xff, 0x8f,
+    0xfe, 0xaf, 0x1f, 0xfc, 0x3c, 0x76, 0x3f, 0xf8,
+    0xd3, 0x7c, 0x59, 0x8f, 0xe9, 0xff, 0xc5,
 
     /* U+0056 "V" */
-    0xe0, 0xf, 0xc0, 0x1f, 0x80, 0x3f, 0x0, 0x7e,
-    0x0, 0xfc, 0x1, 0xf8, 0x3, 0xf0, 0x7, 0xe0,
-    0xf, 0xc0, 0x1f, 0x80, 0x3f, 0x0, 0x7e, 0x0,
-    0xfc, 0x1, 0xfc, 0xf, 0x9e, 0x3c, 0x3c, 0x78,
-    0x3f, 0xe0, 0x3f, 0x0, 0x1c, 0x0, 0x38, 0x0,
-
-    /* U+0057 "W" */
-    0xe0, 0xf, 0xc0, 0x1f, 0x80, 0x3f, 0x0, 0x7e,
-    0x0, 0xfc, 0x1, 0xf8, 0x3, 0xf0, 0x7, 0xe0,
-    0xf, 0xc7, 0x1f, 0x8e, 0x3f, 0x1c, 0x7e, 0x38,
-    0xfc, 0x71, 0xf8, 0xe3, 0xf1, 0xc7, 0xe3, 0x8f,
-    0xff, 0xfd, 0xff, 0xe0, 0xe3, 0x81, 0xc7, 0x0,
-
-    /* U+0058 "X" */
-    0xe0, 0xf, 0xc0, 0x1f, 0x80, 0x3f, 0x0, 0x7e,
-    0x0, 0xfe, 0x7, 0xcf, 0x1e, 0xf, 0xf8, 0x1f,
-    0xf0, 0x1f, 0x80, 0x3f, 0x0, 0x7e, 0x1, 0xff,
-    0x7, 0x8f, 0xf, 0x1e, 0x78, 0x1f, 0xe0, 0xf,
-    0xc0, 0x1f, 0x80, 0x3f, 0x0, 0x7e, 0x0, 0xe0,
-
-    /* U+0059 "Y" */
-    0xe0, 0xf, 0xc0, 0x1f, 0x80, 0x3f, 0x0, 0x7e,
-    0x0, 0xfc, 0x1, 0xf8, 0x3, 0xf0, 0x7, 0xf0,
-    0x3e, 0x78, 0xf0, 0xf1, 0xe0, 0xff, 0x80, 0xfc,
-    0x0, 0x70, 0x0, 0xe0, 0x1, 0xc0, 0x3, 0x80,
-    0x7, 0x0, 0xe, 0x0, 0x1c, 0x0, 0x38, 0x0,
-
-    /* U+005A "Z" */
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xf8, 0x0, 0x70,
-    0x0, 0xe0, 0x7, 0xc0, 0x1e, 0x0, 0x3c, 0x0,
-    0xf0, 0x7, 0x80, 0xe, 0x0, 0x3c, 0x1, 0xe0,
-    0x7, 0x80, 0xf, 0x0, 0x7c, 0x0, 0xe0, 0x1,
-    0xc0, 0x3, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe0,
-
-    /* U+005B "[" */
-    0xff, 0xff, 0xff, 0xfc, 0xe, 0x7, 0x3, 0x81,
-    0xc0, 0xe0, 0x70, 0x38, 0x1c, 0xe, 0x7, 0x3,
-    0x81, 0xc0, 0xe0, 0x70, 0x38, 0x1c, 0xe, 0x7,
-    0xff, 0xff, 0xff,
-
-    /* U+005C "\\" */
-    0xe0, 0x1, 0xc0, 0x3, 0x80, 0x7, 0x0, 0xe,
-    0x0, 0x1f, 0x0, 0xf, 0x0, 0x1e, 0x0, 0x1e,
-    0x0, 0xf, 0x0, 0xe, 0x0, 0x1e, 0x0, 0xf,
-    0x0, 0xf, 0x0, 0x1e, 0x0, 0x1f, 0x0, 0xe,
-    0x0, 0x1c, 0x0, 0x38, 0x0, 0x70, 0x0, 0xe0,
-
-    /* U+005D "]" */
-    0xff, 0xff, 0xff, 0xe0, 0x70, 0x38, 0x1c, 0xe,
-    0x7, 0x3, 0x81, 0xc0, 0xe0, 0x70, 0x38, 0x1c,
-    0xe, 0x7, 0x3, 0x81, 0xc0, 0xe0, 0x70, 0x3f,
-    0xff, 0xff, 0xff,
-
-    /* U+005E "^" */
-    0x3, 0x80, 0x3f, 0x1, 0xff, 0x7, 0xfc, 0x3c,
-    0x7b, 0xc0, 0xff, 0x3, 0xc0,
-
-    /* U+005F "_" */
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfc,
-
-    /* U+0060 "`" */
-    0xf1, 0xe0, 0xf0, 0x70, 0xe0,
-
-    /* U+0061 "a" */
-    0x1f, 0xf0, 0x3f, 0xe0, 0x7f, 0xf0, 0x1, 0xf0,
-    0x3, 0xe0, 0x1, 0xc7, 0xf3, 0xbf, 0xff, 0x7f,
-    0xff, 0xe0, 0x7f, 0x80, 0x3f, 0x0, 0x7e, 0x0,
-    0xfe, 0x7, 0xfc, 0xf, 0xbf, 0xff, 0x1f, 0xce,
-    0x3f, 0x9c,
-
-    /* U+0062 "b" */
-    0xe0, 0x1, 0xc0, 0x3, 0x80, 0x7, 0x0, 0xe,
-    0x0, 0x1c, 0x78, 0x39, 0xfc, 0x73, 0xf8, 0xff,
-    0x79, 0xf8, 0x7f, 0xe0, 0x3f, 0xc0, 0x7f, 0x80,
-    0xff, 0x1, 0xfe, 0x3, 0xfe, 0x1f, 0xff, 0x79,
-    0xfe, 0xf3, 0x9f, 0xc7, 0x1e, 0xe, 0x3c, 0x0,
-
-    /* U+0063 "c" */
-    0x1f, 0xf0, 0xff, 0xf3, 0xff, 0xff, 0xc1, 0xfe,
-    0x0, 0xfc, 0x0, 0x38, 0x0, 0x70, 0x0, 0xe0,
-    0x1, 0xc0, 0x3, 0x80, 0x3f, 0xc1, 0xff, 0x83,
-    0xef, 0xff, 0x7, 0xfc, 0xf, 0xf8,
-
-    /* U+0064 "d" */
-    0x0, 0xe, 0x0, 0x1c, 0x0, 0x38, 0x0, 0x70,
-    0x0, 0xe0, 0xf1, 0xc7, 0xf3, 0x8f, 0xe7, 0x3d,
-    0xff, 0xf0, 0xff, 0x80, 0xff, 0x1, 0xfe, 0x3,
-    0xfc, 0x7, 0xf8, 0xf, 0xfc, 0x3f, 0x3d, 0xfe,
-    0x7b, 0xfc, 0x7f, 0x38, 0x3c, 0x70, 0x78, 0xe0,
-
-    /* U+0065 "e" */
-    0x1f, 0xf1, 0xff, 0xe7, 0xff, 0xbc, 0xf, 0xe0,
-    0xf, 0xff, 0xff, 0xff, 0xff, 0xfe, 0xe0, 0x3,
-    0x80, 0xe, 0x0, 0x3c, 0xf, 0xf0, 0x3d, 0xff,
-    0xe1, 0xff, 0x7, 0xfc,
-
-    /* U+0066 "f" */
-    0x3, 0xf0, 0x3f, 0xf, 0xf0, 0xe0, 0xe, 0xf,
-    0xff, 0xff, 0xff, 0xff, 0xe, 0x0, 0xe0, 0xe,
-    0x0, 0xe0, 0xe, 0x0, 0xe0, 0xe, 0x0, 0xe0,
-    0xe, 0x0, 0xe0, 0xe, 0x0, 0xe0, 0xe, 0x0,
-
-    /* U+0067 "g" */
-    0x1f, 0xf0, 0x3f, 0xe1, 0xff, 0xe7, 0x81, 0xff,
-    0x3, 0xfc, 0x1, 0xfc, 0xf, 0xbf, 0xff, 0x7f,
-    0xfe, 0x3f, 0x9c, 0x0, 0x38, 0x0, 0x70, 0x0,
-    0xee, 0x7, 0xdc, 0xf, 0xbf, 0xfc, 0x1f, 0xf0,
-    0x3f, 0xe0,
-
-    /* U+0068 "h" */
-    0xe0, 0x1, 0xc0, 0x3, 0x80, 0x7, 0x0, 0xe,
-    0x0, 0x1c, 0x78, 0x39, 0xfc, 0x73, 0xf8, 0xff,
-    0x79, 0xf8, 0x7f, 0xe0, 0x3f, 0xc0, 0x7e, 0x0,
-    0xfc, 0x1, 0xf8, 0x3, 0xf0, 0x7, 0xe0, 0xf,
-    0xc0, 0x1f, 0x80, 0x3f, 0x0, 0x7e, 0x0, 0xe0,
-
-    /* U+0069 "i" */
-    0x1c, 0xe, 0x7, 0x0, 0x0, 0x0, 0x3, 0xf1,
-    0xf8, 0xfc, 0xe, 0x7, 0x3, 0x81, 0xc0, 0xe0,
-    0x70, 0x3e, 0x1f, 0x7, 0xc3, 0xe0, 0x70,
-
-    /* U+006A "j" */
-    0x3, 0x81, 0xc0, 0xe0, 0x0, 0x0, 0x0, 0x0,
-    0x3f, 0x1f, 0x8f, 0xc0, 0xe0, 0x70, 0x38, 0x1c,
-    0xe, 0x7, 0x3, 0x81, 0xc0, 0xe0, 0xff, 0xf7,
-    0xfb, 0xf0,
-
-    /* U+006B "k" */
-    0xe0, 0x1, 0xc0, 0x3, 0x80, 0x7, 0x0, 0xe,
-    0x0, 0x1c, 0x1, 0xf8, 0xf, 0xf0, 0x1f, 0xe0,
-    0x79, 0xc1, 0xe3, 0x83, 0x7, 0x1e, 0xe, 0x78,
-    0x1c, 0xf0, 0x3f, 0xf0, 0x7e, 0x78, 0xf8, 0x79,
-    0xf0, 0xf3, 0x80, 0xff, 0x0, 0x7e, 0x0, 0xe0,
-
-    /* U+006C "l" */
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe,
-
-    /* U+006D "m" */
-    0xe7, 0xf1, 0xff, 0xfb, 0xff, 0xf7, 0xdd, 0xfe,
-    0x38, 0xfc, 0x71, 0xf8, 0xe3, 0xf1, 0xc7, 0xe3,
-    0x8f, 0xc7, 0x1f, 0x8e, 0x3f, 0x1c, 0x7e, 0x38,
-    0xfc, 0x71, 0xf8, 0xe3, 0xf1, 0xc7,
-
-    /* U+006E "n" */
-    0xe7, 0xf1, 0xff, 0xfb, 0xff, 0xf7, 0xc0, 0xfe,
-    0x0, 0xfc, 0x1, 0xf8, 0x3, 0xf0, 0x7, 0xe0,
-    0xf, 0xc0, 0x1f, 0x80, 0x3f, 0x0, 0x7e, 0x0,
-    0xfc, 0x1, 0xf8, 0x3, 0xf0, 0x7,
-
-    /* U+006F "o" */
-    0x1f, 0xf0, 0xff, 0xf1, 0xff, 0xe7, 0xc1, 0xfe,
-    0x0, 0xfc, 0x1, 0xf8, 0x3, 0xf0, 0x7, 0xe0,
-    0xf, 0xc0, 0x1f, 0x80, 0x3f, 0x0, 0x7f, 0x83,
-    0xef, 0xff, 0x7, 0xfc, 0xf, 0xf8,
-
-    /* U+0070 "p" */
-    0xe7, 0xf1, 0xcf, 0xe3, 0xff, 0xf7, 0xe0, 0xff,
-    0x80, 0xff, 0x1, 0xfe, 0x3, 0xfc, 0x7, 0xf8,
-    0xf, 0xf8, 0x3f, 0xff, 0xf7, 0xff, 0xee, 0x7f,
-    0x1c, 0x0, 0x38, 0x0, 0x70, 0x0, 0xe0, 0x1,
-    0xc0, 0x0,
-
-    /* U+0071 "q" */
-    0x1f, 0xce, 0x3f, 0x9d, 0xff, 0xff, 0xc3, 0xff,
-    0x87, 0xfc, 0x7, 0xf8, 0xf, 0xf0, 0x1f, 0xe0,
-    0x3f, 0xf0, 0xfd, 0xff, 0xfb, 0xff, 0xf1, 0xfb,
-    0xe0, 0x1, 0xc0, 0x3, 0x80, 0x7, 0x0, 0xe,
-    0x0, 0x1c,
-
-    /* U+0072 "r" */
-    0xe3, 0xf1, 0xc7, 0xe3, 0xbf, 0xe7, 0xf9, 0xff,
-    0xf3, 0xff, 0x81, 0xfc, 0x0, 0x70, 0x0, 0xe0,
-    0x1, 0xc0, 0x3, 0x80, 0x7, 0x0, 0xe, 0x0,
-    0x1c, 0x0, 0x38, 0x0, 0x70, 0x0,
-
-    /* U+0073 "s" */
-    0x1f, 0xf0, 0xff, 0xef, 0xff, 0xfc, 0xf, 0xf0,
-    0xc, 0xfe, 0x3, 0xf8, 0x1, 0xfc, 0x1, 0xf8,
-    0x7, 0xee, 0x3, 0xfe, 0xf, 0xf8, 0x3c, 0xff,
-    0xe1, 0xff, 0x7, 0xfc,
-
-    /* U+0074 "t" */
-    0x1c, 0xe, 0x7, 0x3, 0x81, 0xc7, 0xff, 0xff,
-    0xff, 0x1c, 0xe, 0x7, 0x3, 0x81, 0xc0, 0xe0,
-    0x70, 0x38, 0x1c, 0xf, 0x83, 0xe1, 0xf0, 0x38,
-
-    /* U+0075 "u" */
-    0xe0, 0xf, 0xc0, 0x1f, 0x80, 0x3f, 0x0, 0x7e,
-    0x0, 0xfc, 0x1, 0xf8, 0x3, 0xf0, 0x7, 0xe0,
-    0xf, 0xc0, 0x1f, 0x80, 0x3f, 0x0, 0x7f, 0x83,
-    0xef, 0xff, 0x1f, 0xfe, 0xf, 0xf8,
-
-    /* U+0076 "v" */
-    0xe0, 0xf, 0xc0, 0x1f, 0x80, 0x3f, 0x0, 0x7e,
-    0x0, 0xfc, 0x1, 0xf8, 0x3, 0xf0, 0x7, 0xe0,
-    0xf, 0xe0, 0x7c, 0xf1, 0xe1, 0xe3, 0xc1, 0xff,
-    0x1, 0xf8, 0x0, 0xe0, 0x1, 0xc0,
-
-    /* U+0077 "w" */
-    0xe0, 0xf, 0xc0, 0x1f, 0x80, 0x3f, 0x0, 0x7e,
-    0x0, 0xfc, 0x71, 0xf8, 0xe3, 0xf1, 0xc7, 0xe3,
-    0x8f, 0xc7, 0x1f, 0x8e, 0x3f, 0xdd, 0xff, 0xbb,
-    0xef, 0xff, 0x7, 0x1c, 0xe, 0x38,
-
-    /* U+0078 "x" */
-    0xe0, 0xf, 0xe0, 0x7f, 0xc0, 0xf9, 0xe3, 0xc1,
-    0xff, 0x1, 0xf8, 0x3, 0xf0, 0x1, 0xc0, 0x3,
-    0x80, 0x1f, 0x80, 0x7f, 0xc1, 0xe3, 0xc3, 0xc7,
-    0x9e, 0x7, 0xf8, 0x3, 0xf0, 0x7,
-
-    /* U+0079 "y" */
-    0xe0, 0xf, 0xc0, 0x1f, 0x80, 0x3f, 0x1, 0xfe,
-    0x3, 0xfc, 0x7, 0xf8, 0x1f, 0xfc, 0xff, 0xf9,
-    0xfe, 0xff, 0x9c, 0x7e, 0x38, 0xfc, 0x70, 0x0,
-    0xe0, 0x7, 0xc0, 0xf, 0x8f, 0xfe, 0x1f, 0xfc,
-    0x3f, 0xe0,
-
-    /* U+007A "z" */
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xc0, 0xf, 0x0,
-    0x78, 0x1, 0xe0, 0xf, 0x0, 0xf0, 0x7, 0x80,
-    0x1e, 0x1, 0xe0, 0xf, 0x0, 0x3c, 0x3, 0xff,
-    0xff, 0xff, 0xff, 0xff,
-
-    /* U+007B "{" */
-    0x7, 0x83, 0xc1, 0xe3, 0xf1, 0xc0, 0xe0, 0x70,
-    0x38, 0x1c, 0xe, 0x3c, 0x1e, 0xf, 0x0, 0xe0,
-    0x70, 0x38, 0x1c, 0xe, 0x7, 0x3, 0x81, 0xf8,
-    0x3c, 0x1e, 0xf,
-
-    /* U+007C "|" */
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff,
-
-    /* U+007D "}" */
-    0xf0, 0x78, 0x3c, 0x1f, 0x81, 0xc0, 0xe0, 0x70,
-    0x38, 0x1c, 0xe, 0x1, 0xe0, 0xf0, 0x78, 0xe0,
-    0x70, 0x38, 0x1c, 0xe, 0x7, 0x3, 0x8f, 0xc7,
-    0x83, 0xc1, 0xe0,
-
-    /* U+007E "~" */
-    0x1e, 0x4, 0xfe, 0x73, 0xf9, 0xf9, 0xfc, 0xc0,
-    0xe3, 0x3, 0x80
+    0xe3, 0xfb, 0x8f, 0xff, 0xf9, 0xff, 0xff, 0x3f,
+    0xfc, 0x93, 0xd8, 0xb0, 0xc5, 0x2c, 0x7f, 0xf1,
+    0x65, 0xc5, 0x3a, 0x7b, 0x1f, 0x62, 0x9f, 0xfc,
+    0x80,
+
+    /* decoder read-ahead */
+    0x0
 };
 
 
@@ -603,100 +119,20 @@ static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {
 static const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {
     {.bitmap_index = 0, .adv_w = 0, .box_w = 0, .box_h = 0, .ofs_x = 0, .ofs_y = 0} /* id = 0 reserved */,
     {.bitmap_index = 0, .adv_w = 281, .box_w = 1, .box_h = 1, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 1, .adv_w = 281, .box_w = 3, .box_h = 21, .ofs_x = 6, .ofs_y = 2},
-    {.bitmap_index = 9, .adv_w = 281, .box_w = 12, .box_h = 6, .ofs_x = 3, .ofs_y = 17},
-    {.bitmap_index = 18, .adv_w = 281, .box_w = 15, .box_h = 19, .ofs_x = 1, .ofs_y = 4},
-    {.bitmap_index = 54, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 94, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 134, .adv_w = 281, .box_w = 15, .box_h = 24, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 179, .adv_w = 281, .box_w = 4, .box_h = 6, .ofs_x = 6, .ofs_y = 17},
-    {.bitmap_index = 182, .adv_w = 281, .box_w = 7, .box_h = 24, .ofs_x = 4, .ofs_y = 2},
-    {.bitmap_index = 203, .adv_w = 281, .box_w = 7, .box_h = 24, .ofs_x = 6, .ofs_y = 2},
-    {.bitmap_index = 224, .adv_w = 281, .box_w = 12, .box_h = 13, .ofs_x = 3, .ofs_y = 11},
-    {.bitmap_index = 244, .adv_w = 281, .box_w = 15, .box_h = 15, .ofs_x = 1, .ofs_y = 5},
-    {.bitmap_index = 273, .adv_w = 281, .box_w = 6, .box_h = 6, .ofs_x = 4, .ofs_y = 2},
-    {.bitmap_index = 278, .adv_w = 281, .box_w = 12, .box_h = 3, .ofs_x = 3, .ofs_y = 11},
-    {.bitmap_index = 283, .adv_w = 281, .box_w = 3, .box_h = 3, .ofs_x = 6, .ofs_y = 2},
-    {.bitmap_index = 285, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 325, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 365, .adv_w = 281, .box_w = 9, .box_h = 21, .ofs_x = 4, .ofs_y = 2},
-    {.bitmap_index = 389, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 429, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 469, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 509, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 549, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 589, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 629, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 669, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 709, .adv_w = 281, .box_w = 3, .box_h = 15, .ofs_x = 6, .ofs_y = 5},
-    {.bitmap_index = 715, .adv_w = 281, .box_w = 6, .box_h = 18, .ofs_x = 3, .ofs_y = 1},
-    {.bitmap_index = 729, .adv_w = 281, .box_w = 12, .box_h = 23, .ofs_x = 3, .ofs_y = 2},
-    {.bitmap_index = 764, .adv_w = 281, .box_w = 15, .box_h = 9, .ofs_x = 1, .ofs_y = 8},
-    {.bitmap_index = 781, .adv_w = 281, .box_w = 12, .box_h = 23, .ofs_x = 3, .ofs_y = 2},
-    {.bitmap_index = 816, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 856, .adv_w = 281, .box_w = 15, .box_h = 18, .ofs_x = 1, .ofs_y = 3},
-    {.bitmap_index = 890, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 930, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 970, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 1010, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 1050, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 1090, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 1130, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 1170, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 1210, .adv_w = 281, .box_w = 9, .box_h = 21, .ofs_x = 4, .ofs_y = 2},
-    {.bitmap_index = 1234, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 1274, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 1314, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 1354, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 1394, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 1434, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 1474, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 1514, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 1554, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 1594, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 1634, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 1674, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 1714, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 1754, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 1794, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 1834, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 1874, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 1914, .adv_w = 281, .box_w = 9, .box_h = 24, .ofs_x = 6, .ofs_y = 2},
-    {.bitmap_index = 1941, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 1981, .adv_w = 281, .box_w = 9, .box_h = 24, .ofs_x = 3, .ofs_y = 2},
-    {.bitmap_index = 2008, .adv_w = 281, .box_w = 14, .box_h = 7, .ofs_x = 1, .ofs_y = 15},
-    {.bitmap_index = 2021, .adv_w = 281, .box_w = 18, .box_h = 3, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 2028, .adv_w = 281, .box_w = 7, .box_h = 5, .ofs_x = 4, .ofs_y = 18},
-    {.bitmap_index = 2033, .adv_w = 281, .box_w = 15, .box_h = 18, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 2067, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 2107, .adv_w = 281, .box_w = 15, .box_h = 16, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 2137, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 2177, .adv_w = 281, .box_w = 14, .box_h = 16, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 2205, .adv_w = 281, .box_w = 12, .box_h = 21, .ofs_x = 3, .ofs_y = 2},
-    {.bitmap_index = 2237, .adv_w = 281, .box_w = 15, .box_h = 18, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 2271, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 2311, .adv_w = 281, .box_w = 9, .box_h = 20, .ofs_x = 4, .ofs_y = 2},
-    {.bitmap_index = 2334, .adv_w = 281, .box_w = 9, .box_h = 23, .ofs_x = 4, .ofs_y = 2},
-    {.bitmap_index = 2360, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 2400, .adv_w = 281, .box_w = 3, .box_h = 21, .ofs_x = 7, .ofs_y = 2},
-    {.bitmap_index = 2408, .adv_w = 281, .box_w = 15, .box_h = 16, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 2438, .adv_w = 281, .box_w = 15, .box_h = 16, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 2468, .adv_w = 281, .box_w = 15, .box_h = 16, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 2498, .adv_w = 281, .box_w = 15, .box_h = 18, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 2532, .adv_w = 281, .box_w = 15, .box_h = 18, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 2566, .adv_w = 281, .box_w = 15, .box_h = 16, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 2596, .adv_w = 281, .box_w = 14, .box_h = 16, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 2624, .adv_w = 281, .box_w = 9, .box_h = 21, .ofs_x = 4, .ofs_y = 2},
-    {.bitmap_index = 2648, .adv_w = 281, .box_w = 15, .box_h = 16, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 2678, .adv_w = 281, .box_w = 15, .box_h = 16, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 2708, .adv_w = 281, .box_w = 15, .box_h = 16, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 2738, .adv_w = 281, .box_w = 15, .box_h = 16, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 2768, .adv_w = 281, .box_w = 15, .box_h = 18, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 2802, .adv_w = 281, .box_w = 14, .box_h = 16, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 2830, .adv_w = 281, .box_w = 9, .box_h = 24, .ofs_x = 4, .ofs_y = 2},
-    {.bitmap_index = 2857, .adv_w = 281, .box_w = 3, .box_h = 24, .ofs_x = 7, .ofs_y = 2},
-    {.bitmap_index = 2866, .adv_w = 281, .box_w = 9, .box_h = 24, .ofs_x = 4, .ofs_y = 2},
-    {.bitmap_index = 2893, .adv_w = 281, .box_w = 14, .box_h = 6, .ofs_x = 1, .ofs_y = 9}
+    {.bitmap_index = 1, .adv_w = 281, .box_w = 15, .box_h = 15, .ofs_x = 1, .ofs_y = 5},
+    {.bitmap_index = 15, .adv_w = 281, .box_w = 12, .box_h = 3, .ofs_x = 3, .ofs_y = 11},
+    {.bitmap_index = 19, .adv_w = 281, .box_w = 3, .box_h = 3, .ofs_x = 6, .ofs_y = 2},
+    {.bitmap_index = 21, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
+    {.bitmap_index = 64, .adv_w = 281, .box_w = 9, .box_h = 21, .ofs_x = 4, .ofs_y = 2},
+    {.bitmap_index = 80, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
+    {.bitmap_index = 116, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
+    {.bitmap_index = 158, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
+    {.bitmap_index = 189, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
+    {.bitmap_index = 225, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
+    {.bitmap_index = 267, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
+    {.bitmap_index = 293, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
+    {.bitmap_index = 333, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2},
+    {.bitmap_index = 372, .adv_w = 281, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 2}
 };
 
 /*---------------------
@@ -709,7 +145,23 @@ static const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {
 static const lv_font_fmt_txt_cmap_t cmaps[] =
 {
     {
-        .range_start = 32, .range_length = 95, .glyph_id_start = 1,
+        .range_start = 32, .range_length = 1, .glyph_id_start = 1,
+        .unicode_list = NULL, .glyph_id_ofs_list = NULL, .list_length = 0, .type = LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY
+    },
+    {
+        .range_start = 43, .range_length = 1, .glyph_id_start = 2,
+        .unicode_list = NULL, .glyph_id_ofs_list = NULL, .list_length = 0, .type = LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY
+    },
+    {
+        .range_start = 45, .range_length = 2, .glyph_id_start = 3,
+        .unicode_list = NULL, .glyph_id_ofs_list = NULL, .list_length = 0, .type = LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY
+    },
+    {
+        .range_start = 48, .range_length = 10, .glyph_id_start = 5,
+        .unicode_list = NULL, .glyph_id_ofs_list = NULL, .list_length = 0, .type = LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY
+    },
+    {
+        .range_start = 86, .range_length = 1, .glyph_id_start = 15,
         .unicode_list = NULL, .glyph_id_ofs_list = NULL, .list_length = 0, .type = LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY
     }
 };
@@ -735,10 +187,10 @@ static lv_font_fmt_txt_dsc_t font_dsc = {
     .cmaps = cmaps,
     .kern_dsc = NULL,
     .kern_scale = 0,
-    .cmap_num = 1,
+    .cmap_num = 5,
     .bpp = 1,
     .kern_classes = 0,
-    .bitmap_format = 0,
+    .bitmap_format = 1,
 #if LVGL_VERSION_MAJOR == 8
     .cache = &cache
 #endif
@@ -777,4 +229,3 @@ lv_font_t ui_font_Pixel = {
 
 
 #endif /*#if UI_FONT_PIXEL*/
-
@@ -1,7 +1,9 @@
 /*******************************************************************************
  * Size: 20 px
  * Bpp: 1
- * Opts: --bpp 1 --size 20 --font C:/Users/pablo/OneDrive/Documentos/GitHub/Radiation-Detector/User Interface/SquareLineFiles/assets/VCR_OSD_MONO.ttf -o C:/Users/pablo/OneDrive/Documentos/GitHub/Radiation-Detector/User Interface/SquareLineFiles/assets\ui_font_Pixel_20.c --format lvgl -r 0x20-0x7f --no-compress --no-prefilter
+ * Generated by tools/subset_font.py from the SquareLine export - do not edit.
+ * Symbols:  -.0123456789
+ * Bitmaps: plain
  ******************************************************************************/
 
 #include "ui.h"
@@ -21,65 +23,12 @@ static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {
     /* U+0020 " " */
     0x0,
 
-    /* U+0021 "!" */
-    0xff, 0xff, 0xf0, 0xf0,
-
-    /* U+0022 "\"" */
-    0xe7, 0xe7, 0xe7, 0x42,
-
-    /* U+0023 "#" */
-    0x3, 0xc, 0xc3, 0x3c, 0xff, 0xff, 0x3c, 0xc3,
-    0x30, 0xcf, 0x3f, 0xff, 0xcf, 0x30, 0xcc, 0x30,
-    0x0,
-
-    /* U+0024 "$" */
-    0xc, 0xf, 0xc7, 0xfb, 0xb7, 0xcc, 0xfb, 0x7,
-    0xf0, 0xfe, 0xd, 0xf3, 0x3e, 0xdd, 0xfe, 0x3f,
-    0x3, 0x0,
-
-    /* U+0025 "%" */
-    0x70, 0xfe, 0x3d, 0x8f, 0x67, 0xfb, 0x9d, 0xc0,
-    0xe0, 0x70, 0x3b, 0x9d, 0xfe, 0x6f, 0x1b, 0xc7,
-    0xf0, 0xe0,
-
-    /* U+0026 "&" */
-    0x1c, 0xf, 0x86, 0x31, 0x8c, 0x63, 0x18, 0xc3,
-    0x60, 0xf8, 0x7c, 0x3f, 0xc, 0xef, 0x1f, 0xc3,
-    0xb8, 0xe7, 0xfc, 0xfb,
-
-    /* U+0027 "'" */
-    0xff, 0xa0,
-
-    /* U+0028 "(" */
-    0x19, 0x99, 0x8c, 0x63, 0x18, 0xc6, 0x31, 0x8c,
-    0x30, 0xc3,
-
-    /* U+0029 ")" */
-    0xc3, 0xc, 0x31, 0x8c, 0x63, 0x18, 0xc6, 0x31,
-    0x99, 0x98,
-
-    /* U+002A "*" */
-    0x18, 0x99, 0xdb, 0x7e, 0x3c, 0x7e, 0xdb, 0x99,
-    0x18,
-
-    /* U+002B "+" */
-    0xc, 0x3, 0x0, 0xc0, 0x30, 0xff, 0xff, 0xf0,
-    0xc0, 0x30, 0xc, 0x3, 0x0,
-
-    /* U+002C "," */
-    0x33, 0x6c,
-
     /* U+002D "-" */
     0xff, 0xff,
 
     /* U+002E "." */
     0xf0,
 
-    /* U+002F "/" */
-    0x0, 0xc0, 0x30, 0xc, 0x7, 0x3, 0x81, 0xc0,
-    0xe0, 0x70, 0x38, 0x1c, 0xe, 0x3, 0x0, 0xc0,
-    0x30, 0x0,
-
     /* U+0030 "0" */
     0x3f, 0x1f, 0xee, 0x1f, 0x3, 0xc3, 0xf1, 0xfc,
     0xef, 0x73, 0xf8, 0xfc, 0x3c, 0xf, 0x87, 0x7f,
@@ -127,305 +76,7 @@ static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {
     /* U+0039 "9" */
     0x3f, 0x1f, 0xee, 0x1f, 0x3, 0xc0, 0xf8, 0x37,
     0xfc, 0xff, 0x0, 0xc0, 0x3c, 0xf, 0x87, 0x7f,
-    0x8f, 0xc0,
-
-    /* U+003A ":" */
-    0xf0, 0x0, 0xf0,
-
-    /* U+003B ";" */
-    0x33, 0x0, 0x0, 0x0, 0x33, 0x6c,
-
-    /* U+003C "<" */
-    0x3, 0x7, 0xe, 0x1c, 0x38, 0x70, 0xe0, 0xc0,
-    0xe0, 0x70, 0x38, 0x1c, 0xe, 0x7, 0x3,
-
-    /* U+003D "=" */
-    0xff, 0xff, 0xf0, 0x0, 0x0, 0xff, 0xff, 0xf0,
-
-    /* U+003E ">" */
-    0xc0, 0xe0, 0x70, 0x38, 0x1c, 0xe, 0x7, 0x3,
-    0x7, 0xe, 0x1c, 0x38, 0x70, 0xe0, 0xc0,
-
-    /* U+003F "?" */
-    0x3f, 0x1f, 0xee, 0x1f, 0x3, 0x0, 0xc0, 0x70,
-    0x38, 0x1c, 0xe, 0x3, 0x0, 0x0, 0x0, 0xc,
-    0x3, 0x0,
-
-    /* U+0040 "@" */
-    0x3f, 0x18, 0x6c, 0xe, 0x69, 0xb6, 0x6d, 0x9b,
-    0x66, 0xdb, 0x9d, 0xb0, 0x6, 0x18, 0xfc,
-
-    /* U+0041 "A" */
-    0xc, 0x7, 0x83, 0xf1, 0xce, 0xe1, 0xf0, 0x3c,
-    0xf, 0x3, 0xff, 0xff, 0xfc, 0xf, 0x3, 0xc0,
-    0xf0, 0x30,
-
-    /* U+0042 "B" */
-    0xff, 0x3f, 0xec, 0x1f, 0x3, 0xc0, 0xf0, 0x7f,
-    0xfb, 0xfe, 0xc1, 0xf0, 0x3c, 0xf, 0x7, 0xff,
-    0xbf, 0xc0,
-
-    /* U+0043 "C" */
-    0x3f, 0x1f, 0xee, 0x1f, 0x3, 0xc0, 0x30, 0xc,
-    0x3, 0x0, 0xc0, 0x30, 0xc, 0xf, 0x87, 0x7f,
-    0x8f, 0xc0,
-
-    /* U+0044 "D" */
-    0xff, 0x3f, 0xec, 0x1f, 0x3, 0xc0, 0xf0, 0x3c,
-    0xf, 0x3, 0xc0, 0xf0, 0x3c, 0xf, 0x7, 0xff,
-    0xbf, 0xc0,
-
-    /* U+0045 "E" */
-    0xff, 0xff, 0xfc, 0x3, 0x0, 0xc0, 0x30, 0xf,
-    0xf3, 0xfc, 0xc0, 0x30, 0xc, 0x3, 0x0, 0xff,
-    0xff, 0xf0,
-
-    /* U+0046 "F" */
-    0xff, 0xff, 0xfc, 0x3, 0x0, 0xc0, 0x30, 0xf,
-    0xf3, 0xfc, 0xc0, 0x30, 0xc, 0x3, 0x0, 0xc0,
-    0x30, 0x0,
-
-    /* U+0047 "G" */
-    0x3f, 0x1f, 0xee, 0x1f, 0x3, 0xc0, 0x30, 0xc,
-    0x7f, 0x1f, 0xc0, 0xf0, 0x3c, 0xf, 0x87, 0x7f,
-    0x8f, 0xc0,
-
-    /* U+0048 "H" */
-    0xc0, 0xf0, 0x3c, 0xf, 0x3, 0xc0, 0xf0, 0x3f,
-    0xff, 0xff, 0xc0, 0xf0, 0x3c, 0xf, 0x3, 0xc0,
-    0xf0, 0x30,
-
-    /* U+0049 "I" */
-    0xff, 0xf3, 0xc, 0x30, 0xc3, 0xc, 0x30, 0xc3,
-    0xc, 0xff, 0xf0,
-
-    /* U+004A "J" */
-    0xf, 0xc3, 0xf0, 0x30, 0xc, 0x3, 0x0, 0xc0,
-    0x30, 0xc, 0x3, 0x0, 0xcc, 0x33, 0x9c, 0x7e,
-    0xf, 0x0,
-
-    /* U+004B "K" */
-    0xc0, 0xf0, 0x7c, 0x3b, 0x1c, 0xce, 0x37, 0xf,
-    0x83, 0xe0, 0xdc, 0x33, 0x8c, 0x73, 0xe, 0xc1,
-    0xf0, 0x30,
-
-    /* U+004C "L" */
-    0xc0, 0x30, 0xc, 0x3, 0x0, 0xc0, 0x30, 0xc,
-    0x3, 0x0, 0xc0, 0x30, 0xc, 0x3, 0x0, 0xff,
-    0xff, 0xf0,
-
-    /* U+004D "M" */
-    0xc0, 0xf0, 0x3e, 0x1f, 0xcf, 0xff, 0xf7, 0xbc,
-    0xcf, 0x33, 0xc0, 0xf0, 0x3c, 0xf, 0x3, 0xc0,
-    0xf0, 0x30,
-
-    /* U+004E "N" */
-    0xc0, 0xf0, 0x3c, 0xf, 0x83, 0xf0, 0xfe, 0x3d,
-    0xcf, 0x3b, 0xc7, 0xf0, 0xfc, 0x1f, 0x3, 0xc0,
-    0xf0, 0x30,
-
-    /* U+004F "O" */
-    0x3f, 0x1f, 0xee, 0x1f, 0x3, 0xc0, 0xf0, 0x3c,
-    0xf, 0x3, 0xc0, 0xf0, 0x3c, 0xf, 0x87, 0x7f,
-    0x8f, 0xc0,
-
-    /* U+0050 "P" */
-    0xff, 0x3f, 0xec, 0x1f, 0x3, 0xc0, 0xf0, 0x7f,
-    0xfb, 0xfc, 0xc0, 0x30, 0xc, 0x3, 0x0, 0xc0,
-    0x30, 0x0,
-
-    /* U+0051 "Q" */
-    0x3f, 0x1f, 0xee, 0x1f, 0x3, 0xc0, 0xf0, 0x3c,
-    0xf, 0x3, 0xcc, 0xf3, 0xbc, 0x7f, 0x8e, 0x7f,
-    0xcf, 0x30,
-
-    /* U+0052 "R" */
-    0xff, 0x3f, 0xec, 0x1f, 0x3, 0xc0, 0xf0, 0x7f,
-    0xfb, 0xfc, 0xdc, 0x33, 0x8c, 0x73, 0xe, 0xc1,
-    0xf0, 0x30,
-
-    /* U+0053 "S" */
-    0x3f, 0x1f, 0xee, 0x1f, 0x3, 0xc0, 0x38, 0x7,
-    0xf0, 0xfe, 0x1, 0xc0, 0x3c, 0xf, 0x87, 0x7f,
-    0x8f, 0xc0,
-
-    /* U+0054 "T" */
-    0xff, 0xff, 0xf0, 0xc0, 0x30, 0xc, 0x3, 0x0,
-    0xc0, 0x30, 0xc, 0x3, 0x0, 0xc0, 0x30, 0xc,
-    0x3, 0x0,
-
-    /* U+0055 "U" */
-    0xc0, 0xf0, 0x3c, 0xf, 0x3, 0xc0, 0xf0, 0x3c,
-    0xf, 0x3, 0xc0, 0xf0, 0x3c, 0xf, 0x87, 0x7f,
-    0x8f, 0xc0,
-
-    /* U+0056 "V" */
-    0xc0, 0xf0, 0x3c, 0xf, 0x3, 0xc0, 0xf0, 0x3c,
-    0xf, 0x3, 0xc0, 0xf8, 0x77, 0x38, 0xfc, 0x1e,
-    0x3, 0x0,
-
-    /* U+0057 "W" */
-    0xc0, 0xf0, 0x3c, 0xf, 0x3, 0xc0, 0xf0, 0x3c,
-    0xcf, 0x33, 0xcc, 0xf3, 0x3c, 0xcf, 0xff, 0x7f,
-    0x8c, 0xc0,
-
-    /* U+0058 "X" */
-    0xc0, 0xf0, 0x3c, 0xf, 0x87, 0x73, 0x8f, 0xc1,
-    0xe0, 0x78, 0x3f, 0x1c, 0xee, 0x1f, 0x3, 0xc0,
-    0xf0, 0x30,
-
-    /* U+0059 "Y" */
-    0xc0, 0xf0, 0x3c, 0xf, 0x3, 0xc0, 0xf8, 0x77,
-    0x38, 0xfc, 0x1e, 0x3, 0x0, 0xc0, 0x30, 0xc,
-    0x3, 0x0,
-
-    /* U+005A "Z" */
-    0xff, 0xff, 0xf0, 0xc, 0x7, 0x3, 0x81, 0xc0,
-    0xe0, 0x70, 0x38, 0x1c, 0xe, 0x3, 0x0, 0xff,
-    0xff, 0xf0,
-
-    /* U+005B "[" */
-    0xff, 0xfc, 0x30, 0xc3, 0xc, 0x30, 0xc3, 0xc,
-    0x30, 0xc3, 0xf, 0xff,
-
-    /* U+005C "\\" */
-    0xc0, 0x30, 0xc, 0x3, 0x80, 0x70, 0xe, 0x1,
-    0xc0, 0x38, 0x7, 0x0, 0xe0, 0x1c, 0x3, 0x0,
-    0xc0, 0x30,
-
-    /* U+005D "]" */
-    0xff, 0xf0, 0xc3, 0xc, 0x30, 0xc3, 0xc, 0x30,
-    0xc3, 0xc, 0x3f, 0xff,
-
-    /* U+005E "^" */
-    0xc, 0x7, 0x83, 0xf1, 0xce, 0xe1, 0xc0,
-
-    /* U+005F "_" */
-    0xff, 0xff, 0xff,
-
-    /* U+0060 "`" */
-    0xe3, 0x86,
-
-    /* U+0061 "a" */
-    0x3f, 0xf, 0xe0, 0x1c, 0x3, 0x3e, 0xdf, 0xfe,
-    0x1f, 0x3, 0xc0, 0xf8, 0x77, 0xfc, 0xfb,
-
-    /* U+0062 "b" */
-    0xc0, 0x30, 0xc, 0x3, 0x38, 0xdf, 0x3e, 0xef,
-    0x1f, 0x83, 0xe0, 0xf8, 0x3f, 0x1f, 0xee, 0xdf,
-    0x33, 0x80,
-
-    /* U+0063 "c" */
-    0x3f, 0x1f, 0xee, 0x1f, 0x3, 0xc0, 0x30, 0xc,
-    0x3, 0x3, 0xe1, 0xdf, 0xe3, 0xf0,
-
-    /* U+0064 "d" */
-    0x0, 0xc0, 0x30, 0xc, 0x73, 0x3e, 0xdd, 0xfe,
-    0x3f, 0x7, 0xc1, 0xf0, 0x7e, 0x3d, 0xdf, 0x3e,
-    0xc7, 0x30,
-
-    /* U+0065 "e" */
-    0x3f, 0x1f, 0xee, 0x1f, 0x3, 0xff, 0xff, 0xec,
-    0x3, 0x0, 0xe1, 0xdf, 0xe3, 0xf0,
-
-    /* U+0066 "f" */
-    0xf, 0x1f, 0x18, 0xff, 0xff, 0x18, 0x18, 0x18,
-    0x18, 0x18, 0x18, 0x18, 0x18, 0x18,
-
-    /* U+0067 "g" */
-    0x3f, 0x1f, 0xee, 0x1f, 0x3, 0xe1, 0xdf, 0xf3,
-    0xec, 0x3, 0x0, 0xd8, 0x77, 0xf8, 0xfc,
-
-    /* U+0068 "h" */
-    0xc0, 0x30, 0xc, 0x3, 0x38, 0xdf, 0x3e, 0xef,
-    0x1f, 0x83, 0xc0, 0xf0, 0x3c, 0xf, 0x3, 0xc0,
-    0xf0, 0x30,
-
-    /* U+0069 "i" */
-    0x30, 0xc0, 0x0, 0xf3, 0xc3, 0xc, 0x30, 0xc3,
-    0x87, 0xc,
-
-    /* U+006A "j" */
-    0xc, 0x30, 0x0, 0x3c, 0xf0, 0xc3, 0xc, 0x30,
-    0xc3, 0x1f, 0xef, 0x0,
-
-    /* U+006B "k" */
-    0xc0, 0x30, 0xc, 0x3, 0x3, 0xc1, 0xf0, 0xec,
-    0x73, 0x38, 0xdc, 0x3f, 0x8f, 0x73, 0x8e, 0xc1,
-    0xf0, 0x30,
-
-    /* U+006C "l" */
-    0xff, 0xff, 0xff, 0xf0,
-
-    /* U+006D "m" */
-    0xdf, 0x3f, 0xee, 0xdf, 0x33, 0xcc, 0xf3, 0x3c,
-    0xcf, 0x33, 0xcc, 0xf3, 0x3c, 0xcc,
-
-    /* U+006E "n" */
-    0xdf, 0x3f, 0xee, 0x1f, 0x3, 0xc0, 0xf0, 0x3c,
-    0xf, 0x3, 0xc0, 0xf0, 0x3c, 0xc,
-
-    /* U+006F "o" */
-    0x3f, 0x1f, 0xee, 0x1f, 0x3, 0xc0, 0xf0, 0x3c,
-    0xf, 0x3, 0xe1, 0xdf, 0xe3, 0xf0,
-
-    /* U+0070 "p" */
-    0xdf, 0x3f, 0xef, 0x1f, 0x83, 0xe0, 0xf8, 0x3f,
-    0x1f, 0xfe, 0xdf, 0x30, 0xc, 0x3, 0x0,
-
-    /* U+0071 "q" */
-    0x3e, 0xdf, 0xfe, 0x3f, 0x7, 0xc1, 0xf0, 0x7e,
-    0x3d, 0xff, 0x3d, 0xc0, 0x30, 0xc, 0x3,
-
-    /* U+0072 "r" */
-    0xcf, 0x37, 0xef, 0x9f, 0xc3, 0xe0, 0x30, 0xc,
-    0x3, 0x0, 0xc0, 0x30, 0xc, 0x0,
-
-    /* U+0073 "s" */
-    0x3f, 0x1f, 0xee, 0x1f, 0x83, 0x7c, 0x7, 0xc0,
-    0x7b, 0x7, 0xe1, 0xdf, 0xe3, 0xf0,
-
-    /* U+0074 "t" */
-    0x30, 0xc3, 0x3f, 0xfc, 0xc3, 0xc, 0x30, 0xc3,
-    0xe, 0x1c, 0x30,
-
-    /* U+0075 "u" */
-    0xc0, 0xf0, 0x3c, 0xf, 0x3, 0xc0, 0xf0, 0x3c,
-    0xf, 0x3, 0xe1, 0xdf, 0xe3, 0xf0,
-
-    /* U+0076 "v" */
-    0xc0, 0xf0, 0x3c, 0xf, 0x3, 0xc0, 0xf0, 0x3e,
-    0x1d, 0xce, 0x3f, 0x7, 0x80, 0xc0,
-
-    /* U+0077 "w" */
-    0xc0, 0xf0, 0x3c, 0xf, 0x3, 0xcc, 0xf3, 0x3c,
-    0xcf, 0x33, 0xed, 0xdf, 0xe3, 0x30,
-
-    /* U+0078 "x" */
-    0xc0, 0xf8, 0x77, 0x38, 0xfc, 0x1e, 0x3, 0x1,
-    0xe0, 0xfc, 0x73, 0xb8, 0x7c, 0xc,
-
-    /* U+0079 "y" */
-    0xc0, 0xf0, 0x3c, 0x1f, 0x7, 0xc3, 0xf9, 0xf7,
-    0xec, 0xf3, 0x0, 0xc0, 0x73, 0xf8, 0xfc,
-
-    /* U+007A "z" */
-    0xff, 0xff, 0xf0, 0x1c, 0xe, 0x7, 0x3, 0x81,
-    0xc0, 0xe0, 0x70, 0x3f, 0xff, 0xfc,
-
-    /* U+007B "{" */
-    0x1c, 0x73, 0xcc, 0x30, 0xc3, 0x38, 0xe0, 0xc3,
-    0xc, 0x30, 0xf1, 0xc7,
-
-    /* U+007C "|" */
-    0xff, 0xff, 0xff, 0xff,
-
-    /* U+007D "}" */
-    0xe3, 0x8f, 0xc, 0x30, 0xc3, 0x7, 0x1c, 0xc3,
-    0xc, 0x33, 0xce, 0x38,
-
-    /* U+007E "~" */
-    0x38, 0x5f, 0x3c, 0xfa, 0x1c
+    0x8f, 0xc0
 };
 
 
@@ -436,100 +87,18 @@ static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {
 static const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {
     {.bitmap_index = 0, .adv_w = 0, .box_w = 0, .box_h = 0, .ofs_x = 0, .ofs_y = 0} /* id = 0 reserved */,
     {.bitmap_index = 0, .adv_w = 188, .box_w = 1, .box_h = 1, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 1, .adv_w = 188, .box_w = 2, .box_h = 14, .ofs_x = 4, .ofs_y = 1},
-    {.bitmap_index = 5, .adv_w = 188, .box_w = 8, .box_h = 4, .ofs_x = 2, .ofs_y = 11},
-    {.bitmap_index = 9, .adv_w = 188, .box_w = 10, .box_h = 13, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 26, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 44, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 62, .adv_w = 188, .box_w = 10, .box_h = 16, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 82, .adv_w = 188, .box_w = 3, .box_h = 4, .ofs_x = 4, .ofs_y = 11},
-    {.bitmap_index = 84, .adv_w = 188, .box_w = 5, .box_h = 16, .ofs_x = 3, .ofs_y = 1},
-    {.bitmap_index = 94, .adv_w = 188, .box_w = 5, .box_h = 16, .ofs_x = 4, .ofs_y = 1},
-    {.bitmap_index = 104, .adv_w = 188, .box_w = 8, .box_h = 9, .ofs_x = 2, .ofs_y = 7},
-    {.bitmap_index = 113, .adv_w = 188, .box_w = 10, .box_h = 10, .ofs_x = 1, .ofs_y = 3},
-    {.bitmap_index = 126, .adv_w = 188, .box_w = 4, .box_h = 4, .ofs_x = 3, .ofs_y = 1},
-    {.bitmap_index = 128, .adv_w = 188, .box_w = 8, .box_h = 2, .ofs_x = 2, .ofs_y = 7},
-    {.bitmap_index = 130, .adv_w = 188, .box_w = 2, .box_h = 2, .ofs_x = 4, .ofs_y = 1},
-    {.bitmap_index = 131, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 149, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 167, .adv_w = 188, .box_w = 6, .box_h = 14, .ofs_x = 3, .ofs_y = 1},
-    {.bitmap_index = 178, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 196, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 214, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 232, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 250, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 268, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 286, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 304, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 322, .adv_w = 188, .box_w = 2, .box_h = 10, .ofs_x = 4, .ofs_y = 3},
-    {.bitmap_index = 325, .adv_w = 188, .box_w = 4, .box_h = 12, .ofs_x = 2, .ofs_y = 1},
-    {.bitmap_index = 331, .adv_w = 188, .box_w = 8, .box_h = 15, .ofs_x = 2, .ofs_y = 1},
-    {.bitmap_index = 346, .adv_w = 188, .box_w = 10, .box_h = 6, .ofs_x = 1, .ofs_y = 5},
-    {.bitmap_index = 354, .adv_w = 188, .box_w = 8, .box_h = 15, .ofs_x = 2, .ofs_y = 1},
-    {.bitmap_index = 369, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 387, .adv_w = 188, .box_w = 10, .box_h = 12, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 402, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 420, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 438, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 456, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 474, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 492, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 510, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 528, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 546, .adv_w = 188, .box_w = 6, .box_h = 14, .ofs_x = 3, .ofs_y = 1},
-    {.bitmap_index = 557, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 575, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 593, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 611, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 629, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 647, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 665, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 683, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 701, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 719, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 737, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 755, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 773, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 791, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 809, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 827, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 845, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 863, .adv_w = 188, .box_w = 6, .box_h = 16, .ofs_x = 4, .ofs_y = 1},
-    {.bitmap_index = 875, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 893, .adv_w = 188, .box_w = 6, .box_h = 16, .ofs_x = 2, .ofs_y = 1},
-    {.bitmap_index = 905, .adv_w = 188, .box_w = 10, .box_h = 5, .ofs_x = 1, .ofs_y = 10},
-    {.bitmap_index = 912, .adv_w = 188, .box_w = 12, .box_h = 2, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 915, .adv_w = 188, .box_w = 5, .box_h = 3, .ofs_x = 3, .ofs_y = 12},
-    {.bitmap_index = 917, .adv_w = 188, .box_w = 10, .box_h = 12, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 932, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 950, .adv_w = 188, .box_w = 10, .box_h = 11, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 964, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 982, .adv_w = 188, .box_w = 10, .box_h = 11, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 996, .adv_w = 188, .box_w = 8, .box_h = 14, .ofs_x = 2, .ofs_y = 1},
-    {.bitmap_index = 1010, .adv_w = 188, .box_w = 10, .box_h = 12, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 1025, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 1043, .adv_w = 188, .box_w = 6, .box_h = 13, .ofs_x = 3, .ofs_y = 1},
-    {.bitmap_index = 1053, .adv_w = 188, .box_w = 6, .box_h = 15, .ofs_x = 3, .ofs_y = 1},
-    {.bitmap_index = 1065, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 1083, .adv_w = 188, .box_w = 2, .box_h = 14, .ofs_x = 5, .ofs_y = 1},
-    {.bitmap_index = 1087, .adv_w = 188, .box_w = 10, .box_h = 11, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 1101, .adv_w = 188, .box_w = 10, .box_h = 11, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 1115, .adv_w = 188, .box_w = 10, .box_h = 11, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 1129, .adv_w = 188, .box_w = 10, .box_h = 12, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 1144, .adv_w = 188, .box_w = 10, .box_h = 12, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 1159, .adv_w = 188, .box_w = 10, .box_h = 11, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 1173, .adv_w = 188, .box_w = 10, .box_h = 11, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 1187, .adv_w = 188, .box_w = 6, .box_h = 14, .ofs_x = 3, .ofs_y = 1},
-    {.bitmap_index = 1198, .adv_w = 188, .box_w = 10, .box_h = 11, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 1212, .adv_w = 188, .box_w = 10, .box_h = 11, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 1226, .adv_w = 188, .box_w = 10, .box_h = 11, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 1240, .adv_w = 188, .box_w = 10, .box_h = 11, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 1254, .adv_w = 188, .box_w = 10, .box_h = 12, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 1269, .adv_w = 188, .box_w = 10, .box_h = 11, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 1283, .adv_w = 188, .box_w = 6, .box_h = 16, .ofs_x = 3, .ofs_y = 1},
-    {.bitmap_index = 1295, .adv_w = 188, .box_w = 2, .box_h = 16, .ofs_x = 5, .ofs_y = 1},
-    {.bitmap_index = 1299, .adv_w = 188, .box_w = 6, .box_h = 16, .ofs_x = 3, .ofs_y = 1},
-    {.bitmap_index = 1311, .adv_w = 188, .box_w = 10, .box_h = 4, .ofs_x = 1, .ofs_y = 6}
+    {.bitmap_index = 1, .adv_w = 188, .box_w = 8, .box_h = 2, .ofs_x = 2, .ofs_y = 7},
+    {.bitmap_index = 3, .adv_w = 188, .box_w = 2, .box_h = 2, .ofs_x = 4, .ofs_y = 1},
+    {.bitmap_index = 4, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
+    {.bitmap_index = 22, .adv_w = 188, .box_w = 6, .box_h = 14, .ofs_x = 3, .ofs_y = 1},
+    {.bitmap_index = 33, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
+    {.bitmap_index = 51, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
+    {.bitmap_index = 69, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
+    {.bitmap_index = 87, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
+    {.bitmap_index = 105, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
+    {.bitmap_index = 123, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
+    {.bitmap_index = 141, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1},
+    {.bitmap_index = 159, .adv_w = 188, .box_w = 10, .box_h = 14, .ofs_x = 1, .ofs_y = 1}
 };
 
 /*---------------------
@@ -542,7 +111,15 @@ static const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {
 static const lv_font_fmt_txt_cmap_t cmaps[] =
 {
     {
-        .range_start = 32, .range_length = 95, .glyph_id_start = 1,
+        .range_start = 32, .range_length = 1, .glyph_id_start = 1,
+        .unicode_list = NULL, .glyph_id_ofs_list = NULL, .list_length = 0, .type = LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY
+    },
+    {
+        .range_start = 45, .range_length = 2, .glyph_id_start = 2,
+        .unicode_list = NULL, .glyph_id_ofs_list = NULL, .list_length = 0, .type = LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY
+    },
+    {
+        .range_start = 48, .range_length = 10, .glyph_id_start = 4,
         .unicode_list = NULL, .glyph_id_ofs_list = NULL, .list_length = 0, .type = LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY
     }
 };
@@ -568,7 +145,7 @@ static lv_font_fmt_txt_dsc_t font_dsc = {
     .cmaps = cmaps,
     .kern_dsc = NULL,
     .kern_scale = 0,
-    .cmap_num = 1,
+    .cmap_num = 3,
     .bpp = 1,
     .kern_classes = 0,
     .bitmap_format = 0,
@@ -610,4 +187,3 @@ lv_font_t ui_font_Pixel_20 = {
 
 
 #endif /*#if UI_FONT_PIXEL_20*/
-
@@ -1,7 +1,9 @@
 /*******************************************************************************
  * Size: 60 px
  * Bpp: 1
- * Opts: --bpp 1 --size 60 --font C:/Users/pablo/OneDrive/Documentos/GitHub/Radiation-Detector/User Interface/SquareLineFiles/assets/VCR_OSD_MONO.ttf -o C:/Users/pablo/OneDrive/Documentos/GitHub/Radiation-Detector/User Interface/SquareLineFiles/assets\ui_font_Pixel_60.c --format lvgl -r 0x20-0x7f --no-compress --no-prefilter
+ * Generated by tools/subset_font.py from the SquareLine export - do not edit.
+ * Symbols:  -.0123456789
+ * Bitmaps: compressed
  ******************************************************************************/
 
 #include "ui.h"
@@ -21,1608 +23,119 @@ static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {
     /* U+0020 " " */
     0x0,
 
-    /* U+0021 "!" */
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xfc, 0x0, 0x0,
-    0x0, 0x0, 0x3f, 0xff, 0xff, 0xff, 0xfc,
-
-    /* U+0022 "\"" */
-    0xff, 0x81, 0xff, 0xff, 0x81, 0xff, 0xff, 0x81,
-    0xff, 0xff, 0x81, 0xff, 0xff, 0x81, 0xff, 0xff,
-    0x81, 0xff, 0xff, 0x81, 0xff, 0xff, 0x81, 0xff,
-    0xff, 0x81, 0xff, 0x1c, 0x0, 0x38, 0x1c, 0x0,
-    0x38, 0x1c, 0x0, 0x38,
-
-    /* U+0023 "#" */
-    0x0, 0x0, 0x3f, 0x0, 0x0, 0x0, 0xfc, 0x0,
-    0x0, 0x3, 0xf0, 0x0, 0xfc, 0xf, 0xc0, 0x3,
-    0xf0, 0x3f, 0x0, 0xf, 0xc0, 0xfc, 0x0, 0x3f,
-    0x3, 0xff, 0xc0, 0xfc, 0xf, 0xff, 0x3, 0xf0,
-    0x3f, 0xfc, 0xf, 0xff, 0xff, 0xf0, 0x3f, 0xff,
-    0xff, 0xc0, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0x3, 0xff, 0xff, 0xfc, 0xf, 0xff, 0xff, 0xf0,
-    0x3f, 0xfc, 0xf, 0xc0, 0xff, 0xf0, 0x3f, 0x3,
-    0xff, 0xc0, 0xfc, 0x0, 0x3f, 0x3, 0xf0, 0x0,
-    0xfc, 0xf, 0xc0, 0x3, 0xf0, 0x3f, 0xfc, 0xf,
-    0xc0, 0xff, 0xf0, 0x3f, 0x3, 0xff, 0xc0, 0xff,
-    0xff, 0xff, 0x3, 0xff, 0xff, 0xfc, 0xf, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xf0, 0x3f, 0xff, 0xff,
-    0xc0, 0xff, 0xff, 0xff, 0x3, 0xff, 0xc0, 0xfc,
-    0xf, 0xff, 0x3, 0xf0, 0x3f, 0xfc, 0xf, 0xc0,
-    0x3, 0xf0, 0x3f, 0x0, 0xf, 0xc0, 0xfc, 0x0,
-    0x3f, 0x3, 0xf0, 0x0, 0xfc, 0x0, 0x0, 0x3,
-    0xf0, 0x0, 0x0, 0xf, 0xc0, 0x0, 0x0,
-
-    /* U+0024 "$" */
-    0x0, 0xf, 0xc0, 0x0, 0x0, 0x7e, 0x0, 0x0,
-    0x3, 0xf0, 0x0, 0x7, 0xff, 0xfe, 0x0, 0x3f,
-    0xff, 0xf0, 0x1, 0xff, 0xff, 0x80, 0x7f, 0xff,
-    0xff, 0x83, 0xff, 0xff, 0xfc, 0x1f, 0xff, 0xff,
-    0xe7, 0xfc, 0x7e, 0x3f, 0xff, 0xe3, 0xf1, 0xff,
-    0xff, 0x1f, 0x8f, 0xff, 0xc0, 0xfc, 0xf, 0xfe,
-    0x7, 0xe0, 0x7f, 0xf0, 0x3f, 0x3, 0xff, 0xf1,
-    0xf8, 0x0, 0xff, 0x8f, 0xc0, 0x7, 0xfc, 0x7e,
-    0x0, 0x7, 0xff, 0xff, 0xc0, 0x3f, 0xff, 0xfe,
-    0x0, 0x3f, 0xff, 0xf0, 0x1, 0xff, 0xff, 0xf0,
-    0xf, 0xff, 0xff, 0x80, 0x1, 0xf8, 0xff, 0x0,
-    0xf, 0xc7, 0xf8, 0x0, 0x7e, 0x3f, 0xff, 0x3,
-    0xf0, 0x3f, 0xf8, 0x1f, 0x81, 0xff, 0xc0, 0xfc,
-    0xf, 0xff, 0xc7, 0xe3, 0xff, 0xfe, 0x3f, 0x1f,
-    0xff, 0xf1, 0xf8, 0xff, 0x1f, 0xff, 0xff, 0xe0,
-    0xff, 0xff, 0xff, 0x7, 0xff, 0xff, 0xf8, 0x7,
-    0xff, 0xfe, 0x0, 0x3f, 0xff, 0xf0, 0x1, 0xff,
-    0xff, 0x80, 0x0, 0x3f, 0x0, 0x0, 0x1, 0xf8,
-    0x0, 0x0, 0xf, 0xc0, 0x0,
-
-    /* U+0025 "%" */
-    0x1f, 0xf0, 0x0, 0xf8, 0xff, 0x80, 0x7, 0xc7,
-    0xfc, 0x0, 0x3f, 0xff, 0xfc, 0x1, 0xff, 0xff,
-    0xe0, 0xf, 0xff, 0xff, 0x0, 0x7f, 0xf1, 0xf8,
-    0x3, 0xff, 0x8f, 0xc0, 0x1f, 0xfc, 0x7e, 0x0,
-    0xff, 0xe3, 0xf0, 0x3f, 0xff, 0x1f, 0x81, 0xff,
-    0xf8, 0xfc, 0xf, 0x8f, 0xff, 0xe3, 0xfc, 0x7f,
-    0xff, 0x1f, 0xe0, 0x7f, 0xc8, 0xfc, 0x3, 0xfe,
-    0x3f, 0xe0, 0x1f, 0xf1, 0xff, 0x0, 0xff, 0x8f,
-    0xf8, 0x0, 0x3, 0xfe, 0x0, 0x0, 0x1f, 0xf0,
-    0x0, 0x0, 0xff, 0x80, 0x0, 0x3f, 0xe0, 0x0,
-    0x1, 0xff, 0x0, 0x0, 0xf, 0xf8, 0x0, 0x3,
-    0xfe, 0x3f, 0xc0, 0x1f, 0xf1, 0xfe, 0x0, 0xff,
-    0x8f, 0xf0, 0x3f, 0xe3, 0xff, 0xf1, 0xff, 0x1f,
-    0xff, 0x8f, 0xf8, 0xff, 0xff, 0xfe, 0x7, 0xe3,
-    0xff, 0xf0, 0x3f, 0x1f, 0xfc, 0x1, 0xf8, 0xff,
-    0xe0, 0xf, 0xc7, 0xff, 0x0, 0x7e, 0x3f, 0xf8,
-    0x3, 0xff, 0xff, 0xc0, 0x1f, 0xff, 0xfe, 0x0,
-    0xff, 0xff, 0xf0, 0x0, 0xff, 0x1f, 0x80, 0x7,
-    0xf8, 0xfc, 0x0, 0x3f, 0xc0,
-
-    /* U+0026 "&" */
-    0x0, 0x7f, 0xc0, 0x0, 0x3, 0xfe, 0x0, 0x0,
-    0x1f, 0xf0, 0x0, 0x7, 0xff, 0xf0, 0x0, 0x3f,
-    0xff, 0x80, 0x1, 0xff, 0xfc, 0x0, 0x7e, 0x0,
-    0xf8, 0x3, 0xf0, 0x7, 0xc0, 0x1f, 0x80, 0x3e,
-    0x0, 0xfc, 0x1, 0xf0, 0x7, 0xe0, 0xf, 0x80,
-    0x3f, 0x0, 0x7c, 0x1, 0xf8, 0x3, 0xe0, 0xf,
-    0xc0, 0x1f, 0x0, 0x7e, 0x0, 0xf8, 0x3, 0xf0,
-    0x7, 0xc0, 0x1f, 0x80, 0x3e, 0x0, 0x1c, 0x1,
-    0xc0, 0x0, 0xfc, 0x7e, 0x0, 0x7, 0xe3, 0xf0,
-    0x0, 0x3f, 0x1f, 0x80, 0x1, 0xff, 0xfc, 0x0,
-    0xf, 0xff, 0xe0, 0x0, 0x7f, 0xf8, 0x0, 0x1f,
-    0xff, 0xc0, 0x0, 0xff, 0xfe, 0x0, 0x7, 0xff,
-    0xf0, 0x1, 0xff, 0xff, 0x80, 0xf, 0xff, 0xfc,
-    0x0, 0x7e, 0x7, 0xfc, 0xff, 0xf0, 0x3f, 0xe7,
-    0xff, 0x81, 0xff, 0x3f, 0xfc, 0x1, 0xf9, 0xff,
-    0xe0, 0xf, 0xff, 0xff, 0x0, 0x7f, 0xff, 0xf8,
-    0x0, 0x7f, 0xcf, 0xc0, 0x3, 0xfe, 0x7e, 0x0,
-    0x1f, 0xf3, 0xfe, 0x0, 0xff, 0x9f, 0xf0, 0x7,
-    0xfc, 0xff, 0x80, 0x3f, 0xe0, 0xff, 0xff, 0xff,
-    0xc7, 0xff, 0xff, 0xfe, 0x3f, 0xff, 0xff, 0xf0,
-    0x3f, 0xff, 0x9f, 0x81, 0xff, 0xfc, 0xfc, 0xf,
-    0xff, 0xe7, 0xe0,
-
-    /* U+0027 "'" */
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0x8e, 0x7, 0x3, 0x80,
-
-    /* U+0028 "(" */
-    0x0, 0x7e, 0x0, 0xfc, 0x1, 0xf8, 0x1f, 0x80,
-    0x3f, 0x0, 0x7e, 0x7, 0xe0, 0xf, 0xc0, 0x1f,
-    0x81, 0xf8, 0x3, 0xf0, 0x7, 0xe0, 0xf, 0xc0,
-    0x1f, 0x80, 0x3f, 0x0, 0x7e, 0x0, 0xfc, 0x1,
-    0xf8, 0x3, 0xf0, 0x7, 0xe0, 0xf, 0xc0, 0x1f,
-    0x80, 0x3f, 0x0, 0x7e, 0x0, 0xfc, 0x1, 0xf8,
-    0x3, 0xf0, 0x7, 0xe0, 0xf, 0xc0, 0x1f, 0x80,
-    0x3f, 0x0, 0x7e, 0x0, 0xfc, 0x1, 0xf8, 0x3,
-    0xf0, 0x7, 0xe0, 0xf, 0xc0, 0x1f, 0x80, 0x7,
-    0xe0, 0xf, 0xc0, 0x1f, 0x80, 0x7, 0xe0, 0xf,
-    0xc0, 0x1f, 0x80, 0x7, 0xe0, 0xf, 0xc0, 0x1f,
-    0x80,
-
-    /* U+0029 ")" */
-    0xfc, 0x1, 0xf8, 0x3, 0xf0, 0x0, 0xfc, 0x1,
-    0xf8, 0x3, 0xf0, 0x0, 0xfc, 0x1, 0xf8, 0x3,
-    0xf0, 0x0, 0xfc, 0x1, 0xf8, 0x3, 0xf0, 0x7,
-    0xe0, 0xf, 0xc0, 0x1f, 0x80, 0x3f, 0x0, 0x7e,
-    0x0, 0xfc, 0x1, 0xf8, 0x3, 0xf0, 0x7, 0xe0,
-    0xf, 0xc0, 0x1f, 0x80, 0x3f, 0x0, 0x7e, 0x0,
-    0xfc, 0x1, 0xf8, 0x3, 0xf0, 0x7, 0xe0, 0xf,
-    0xc0, 0x1f, 0x80, 0x3f, 0x0, 0x7e, 0x0, 0xfc,
-    0x1, 0xf8, 0x3, 0xf0, 0x7, 0xe0, 0xf, 0xc0,
-    0xfc, 0x1, 0xf8, 0x3, 0xf0, 0x3f, 0x0, 0x7e,
-    0x0, 0xfc, 0xf, 0xc0, 0x1f, 0x80, 0x3f, 0x0,
-    0x0,
-
-    /* U+002A "*" */
-    0x0, 0x7e, 0x0, 0x0, 0xfc, 0x0, 0x1, 0xf8,
-    0x7, 0x3, 0xf0, 0x3e, 0x7, 0xe0, 0x7c, 0xf,
-    0xc0, 0xff, 0x1f, 0x8f, 0xfe, 0x3f, 0x1f, 0xfc,
-    0x7e, 0x3e, 0x3f, 0xff, 0xf0, 0x7f, 0xff, 0xe0,
-    0xff, 0xff, 0xc0, 0x3f, 0xfc, 0x0, 0x7f, 0xf8,
-    0x0, 0xff, 0xf0, 0xf, 0xff, 0xfc, 0x1f, 0xff,
-    0xf8, 0x3f, 0xff, 0xf3, 0xf1, 0xf8, 0xff, 0xe3,
-    0xf1, 0xff, 0xc7, 0xe3, 0xfc, 0xf, 0xc0, 0xf8,
-    0x1f, 0x81, 0xf0, 0x3f, 0x3, 0x0, 0x7e, 0x0,
-    0x0, 0xfc, 0x0,
-
-    /* U+002B "+" */
-    0x0, 0xf, 0xc0, 0x0, 0x0, 0x7e, 0x0, 0x0,
-    0x3, 0xf0, 0x0, 0x0, 0x1f, 0x80, 0x0, 0x0,
-    0xfc, 0x0, 0x0, 0x7, 0xe0, 0x0, 0x0, 0x3f,
-    0x0, 0x0, 0x1, 0xf8, 0x0, 0x0, 0xf, 0xc0,
-    0x0, 0x0, 0x7e, 0x0, 0x0, 0x3, 0xf0, 0x1,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xf8, 0x0, 0x7e,
-    0x0, 0x0, 0x3, 0xf0, 0x0, 0x0, 0x1f, 0x80,
-    0x0, 0x0, 0xfc, 0x0, 0x0, 0x7, 0xe0, 0x0,
-    0x0, 0x3f, 0x0, 0x0, 0x1, 0xf8, 0x0, 0x0,
-    0xf, 0xc0, 0x0, 0x0, 0x7e, 0x0, 0x0, 0x3,
-    0xf0, 0x0, 0x0, 0x1f, 0x80, 0x0, 0x0, 0xfc,
-    0x0, 0x0,
-
-    /* U+002C "," */
-    0x3, 0xf0, 0x3f, 0x3, 0xf0, 0x3f, 0x3, 0xf0,
-    0x3f, 0x1f, 0x81, 0xf8, 0x1f, 0x8f, 0xc0, 0xfc,
-    0xf, 0xc0,
-
     /* U+002D "-" */
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xc0,
+    0xff, 0xf9, 0x67, 0xff, 0xfc, 0xff, 0xee, 0x0,
 
     /* U+002E "." */
-    0xff, 0xff, 0xff, 0xff, 0xf0,
-
-    /* U+002F "/" */
-    0x0, 0x0, 0x0, 0xf8, 0x0, 0x0, 0x7, 0xc0,
-    0x0, 0x0, 0x3e, 0x0, 0x0, 0x1, 0xf0, 0x0,
-    0x0, 0xf, 0x80, 0x0, 0x0, 0x7c, 0x0, 0x0,
-    0x3, 0xe0, 0x0, 0x0, 0x1f, 0x0, 0x0, 0x0,
-    0xf8, 0x0, 0x0, 0x3f, 0xc0, 0x0, 0x1, 0xfe,
-    0x0, 0x0, 0xf, 0x80, 0x0, 0x3, 0xfc, 0x0,
-    0x0, 0x1f, 0xe0, 0x0, 0x0, 0xff, 0x0, 0x0,
-    0x3f, 0xe0, 0x0, 0x1, 0xff, 0x0, 0x0, 0xf,
-    0xf8, 0x0, 0x3, 0xfe, 0x0, 0x0, 0x1f, 0xf0,
-    0x0, 0x7, 0xfc, 0x0, 0x0, 0x3f, 0xe0, 0x0,
-    0x1, 0xff, 0x0, 0x0, 0x7f, 0xc0, 0x0, 0x3,
-    0xfe, 0x0, 0x0, 0x1f, 0xf0, 0x0, 0x7, 0xff,
-    0x80, 0x0, 0x3f, 0xe0, 0x0, 0x1, 0xff, 0x0,
-    0x0, 0xf, 0xc0, 0x0, 0x3, 0xfe, 0x0, 0x0,
-    0x1f, 0xf0, 0x0, 0x0, 0xfc, 0x0, 0x0, 0x7,
-    0xe0, 0x0, 0x0, 0x3f, 0x0, 0x0, 0x1, 0xf8,
-    0x0, 0x0, 0xf, 0xc0, 0x0, 0x0, 0x7e, 0x0,
-    0x0, 0x3, 0xf0, 0x0, 0x0, 0x1f, 0x80, 0x0,
-    0x0, 0xfc, 0x0, 0x0, 0x0,
+    0xfc, 0x7f, 0xf4, 0x80,
 
     /* U+0030 "0" */
-    0x3, 0xff, 0xff, 0x0, 0x1f, 0xff, 0xf8, 0x0,
-    0xff, 0xff, 0xc0, 0x3f, 0xff, 0xff, 0x81, 0xff,
-    0xff, 0xfc, 0xf, 0xff, 0xff, 0xe3, 0xfe, 0x0,
-    0x1f, 0xff, 0xf0, 0x0, 0xff, 0xff, 0x80, 0x7,
-    0xff, 0xe0, 0x0, 0x7, 0xff, 0x0, 0x0, 0x3f,
-    0xf8, 0x0, 0x1, 0xff, 0xc0, 0x3, 0xff, 0xfe,
-    0x0, 0x1f, 0xff, 0xf0, 0x0, 0xff, 0xff, 0x80,
-    0x3f, 0xff, 0xfc, 0x1, 0xff, 0xff, 0xe0, 0xf,
-    0xff, 0xff, 0x3, 0xfe, 0x3f, 0xf8, 0x1f, 0xf1,
-    0xff, 0xc7, 0xff, 0x8f, 0xfe, 0x3f, 0xe0, 0x7f,
-    0xf1, 0xff, 0x3, 0xff, 0xff, 0xc0, 0x1f, 0xff,
-    0xfe, 0x0, 0xff, 0xff, 0xf0, 0x7, 0xff, 0xff,
-    0x80, 0x3f, 0xff, 0xe0, 0x1, 0xff, 0xff, 0x0,
-    0xf, 0xfe, 0x0, 0x0, 0x7f, 0xf0, 0x0, 0x3,
-    0xff, 0x80, 0x0, 0x1f, 0xff, 0x80, 0x7, 0xff,
-    0xfc, 0x0, 0x3f, 0xff, 0xe0, 0x1, 0xfe, 0x3f,
-    0xff, 0xff, 0x81, 0xff, 0xff, 0xfc, 0xf, 0xff,
-    0xff, 0xe0, 0xf, 0xff, 0xfc, 0x0, 0x7f, 0xff,
-    0xe0, 0x3, 0xff, 0xff, 0x0,
+    0x3d, 0xff, 0xf1, 0x8f, 0xff, 0xb7, 0x1f, 0xfc,
+    0x6c, 0x7f, 0xfc, 0x78, 0xf7, 0xff, 0x8e, 0xe3,
+    0xff, 0xe9, 0xc7, 0xfe, 0xe3, 0xff, 0xfe, 0x7b,
+    0xf1, 0xff, 0xff, 0x2e, 0x3f, 0xff, 0xe7, 0xb8,
+    0xf7, 0x1f, 0xfd, 0xfe, 0x3f, 0xfa, 0xfc, 0x7f,
+    0xf7, 0xf8, 0xf7, 0x1f, 0xff, 0xf3, 0xff, 0xaf,
+    0xc7, 0xff, 0x97, 0xf1, 0xff, 0xff, 0x3d, 0xc7,
+    0xfe, 0xe3, 0xff, 0xe7, 0xc7, 0xbf, 0xfc, 0x77,
+    0x1f, 0xff, 0x1e, 0x3f, 0xf8, 0xd8, 0xff, 0xf8,
+    0x80,
 
     /* U+0031 "1" */
-    0x3, 0xf0, 0x0, 0xfc, 0x0, 0x3f, 0x0, 0x7f,
-    0xc0, 0x1f, 0xf0, 0x7, 0xfc, 0xf, 0xff, 0x3,
-    0xff, 0xc0, 0xff, 0xf0, 0x3f, 0xfc, 0xf, 0xff,
-    0x3, 0xff, 0xc0, 0x3, 0xf0, 0x0, 0xfc, 0x0,
-    0x3f, 0x0, 0xf, 0xc0, 0x3, 0xf0, 0x0, 0xfc,
-    0x0, 0x3f, 0x0, 0xf, 0xc0, 0x3, 0xf0, 0x0,
-    0xfc, 0x0, 0x3f, 0x0, 0xf, 0xc0, 0x3, 0xf0,
-    0x0, 0xfc, 0x0, 0x3f, 0x0, 0xf, 0xc0, 0x3,
-    0xf0, 0x0, 0xfc, 0x0, 0x3f, 0x0, 0xf, 0xc0,
-    0x3, 0xf0, 0x0, 0xfc, 0x0, 0x3f, 0x3, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xc0,
+    0x3d, 0xf8, 0xff, 0xf0, 0xf1, 0xff, 0xe4, 0xe3,
+    0xff, 0xfe, 0x7f, 0xf4, 0xbf, 0x1f, 0xff, 0xf3,
+    0xff, 0xfe, 0x7f, 0xff, 0xcf, 0xff, 0xf9, 0xff,
+    0xff, 0x3f, 0xfa, 0xbf, 0x8f, 0x7e, 0x3f, 0xff,
+    0xe7, 0xff, 0xc,
 
     /* U+0032 "2" */
-    0x3, 0xff, 0xff, 0x0, 0x1f, 0xff, 0xf8, 0x0,
-    0xff, 0xff, 0xc0, 0x3f, 0xff, 0xff, 0xc1, 0xff,
-    0xff, 0xfe, 0xf, 0xff, 0xff, 0xf3, 0xfe, 0x0,
-    0x1f, 0xff, 0xf0, 0x0, 0xff, 0xff, 0x80, 0x7,
-    0xff, 0xe0, 0x0, 0x7, 0xff, 0x0, 0x0, 0x3f,
-    0xf8, 0x0, 0x1, 0xf0, 0x0, 0x0, 0xf, 0x80,
-    0x0, 0x0, 0x7c, 0x0, 0x0, 0x1f, 0xe0, 0x0,
-    0x0, 0xff, 0x0, 0x0, 0x7, 0xf8, 0x0, 0x0,
-    0x3f, 0x0, 0xff, 0xff, 0xf8, 0x7, 0xff, 0xff,
-    0xc1, 0xff, 0xff, 0xf0, 0xf, 0xff, 0xff, 0x80,
-    0x7f, 0xff, 0xfc, 0x3, 0xff, 0xff, 0xe0, 0xff,
-    0x80, 0x0, 0x7, 0xfc, 0x0, 0x0, 0x3f, 0x0,
-    0x0, 0x1, 0xf8, 0x0, 0x0, 0xf, 0xc0, 0x0,
-    0x0, 0x7e, 0x0, 0x0, 0x3, 0xf0, 0x0, 0x0,
-    0x1f, 0x80, 0x0, 0x0, 0xfc, 0x0, 0x0, 0x7,
-    0xe0, 0x0, 0x0, 0x3f, 0x0, 0x0, 0x1, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xf8,
+    0x3d, 0xff, 0xf1, 0x8f, 0xff, 0xb7, 0x1f, 0xfc,
+    0x6e, 0x3f, 0xfe, 0x1c, 0x7b, 0xff, 0xc7, 0xb1,
+    0xff, 0xf4, 0xe3, 0xff, 0x71, 0xff, 0xf3, 0xfc,
+    0x7f, 0xff, 0x78, 0xff, 0xff, 0x9f, 0xfc, 0x3c,
+    0x7b, 0xff, 0xe1, 0x9f, 0xfd, 0xce, 0x3f, 0xf8,
+    0xdc, 0x7f, 0xff, 0xcf, 0xfe, 0x17, 0x1e, 0xff,
+    0xf8, 0x67, 0xff, 0x73, 0x8f, 0xff, 0xf9, 0xff,
+    0xff, 0x3f, 0xff, 0xe7, 0xff, 0x57, 0xff, 0xe5,
+    0x9f, 0xff, 0xf3, 0xff, 0xf4,
 
     /* U+0033 "3" */
-    0x3, 0xff, 0xff, 0x0, 0x1f, 0xff, 0xf8, 0x0,
-    0xff, 0xff, 0xc0, 0x3f, 0xff, 0xff, 0x81, 0xff,
-    0xff, 0xfc, 0xf, 0xff, 0xff, 0xe3, 0xfc, 0x0,
-    0x1f, 0xff, 0xe0, 0x0, 0xff, 0xff, 0x0, 0x7,
-    0xff, 0xe0, 0x0, 0x7, 0xff, 0x0, 0x0, 0x3f,
-    0xf8, 0x0, 0x1, 0xf0, 0x0, 0x0, 0xf, 0x80,
-    0x0, 0x0, 0x7c, 0x0, 0x0, 0x3, 0xe0, 0x0,
-    0x0, 0xff, 0x0, 0x0, 0x7, 0xf8, 0x0, 0x0,
-    0x3e, 0x0, 0x7, 0xff, 0xf0, 0x0, 0x3f, 0xff,
-    0x80, 0x1, 0xff, 0xfc, 0x0, 0xf, 0xff, 0xe0,
-    0x0, 0x7f, 0xff, 0x0, 0x3, 0xff, 0xf8, 0x0,
-    0x0, 0x7, 0xf8, 0x0, 0x0, 0x3f, 0xc0, 0x0,
-    0x0, 0x3e, 0x0, 0x0, 0x1, 0xf0, 0x0, 0x0,
-    0xf, 0xfe, 0x0, 0x0, 0x7f, 0xf0, 0x0, 0x3,
-    0xff, 0x80, 0x0, 0x1f, 0xff, 0x0, 0x7, 0xff,
-    0xf8, 0x0, 0x3f, 0xff, 0xc0, 0x1, 0xfe, 0x3f,
-    0xff, 0xff, 0x81, 0xff, 0xff, 0xfc, 0xf, 0xff,
-    0xff, 0xe0, 0xf, 0xff, 0xfc, 0x0, 0x7f, 0xff,
-    0xe0, 0x3, 0xff, 0xff, 0x0,
+    0x3d, 0xff, 0xf1, 0x8f, 0xff, 0xb7, 0x1f, 0xfc,
+    0x6c, 0x7f, 0xfc, 0x78, 0xef, 0xff, 0x82, 0x77,
+    0x1f, 0xff, 0x4c, 0x7f, 0xf0, 0x78, 0xff, 0xf9,
+    0xfe, 0x3f, 0xff, 0xe7, 0xff, 0x3f, 0x8f, 0xff,
+    0x87, 0x1f, 0xf7, 0xfe, 0x3f, 0xff, 0xe7, 0xff,
+    0xfc, 0xff, 0xe1, 0x7f, 0xe3, 0xb8, 0xff, 0xf3,
+    0x71, 0xff, 0xf3, 0xfc, 0x7f, 0xff, 0xcf, 0xfd,
+    0x8f, 0xfe, 0xf, 0x1f, 0xff, 0x3e, 0x3b, 0xff,
+    0xe0, 0x9d, 0xc7, 0xff, 0xc7, 0x8f, 0xfe, 0x36,
+    0x3f, 0xfe, 0x20,
 
     /* U+0034 "4" */
-    0x0, 0x0, 0x7e, 0x0, 0x0, 0x1, 0xf8, 0x0,
-    0x0, 0x7, 0xe0, 0x0, 0x0, 0x7f, 0x80, 0x0,
-    0x1, 0xfe, 0x0, 0x0, 0x7, 0xf8, 0x0, 0x0,
-    0xff, 0xe0, 0x0, 0x3, 0xff, 0x80, 0x0, 0xf,
-    0xfe, 0x0, 0x1, 0xff, 0xf8, 0x0, 0x7, 0xff,
-    0xe0, 0x0, 0x1f, 0xff, 0x80, 0x3, 0xfe, 0x7e,
-    0x0, 0xf, 0xf9, 0xf8, 0x0, 0x3f, 0xe7, 0xe0,
-    0x7, 0xfc, 0x1f, 0x80, 0x1f, 0xf0, 0x7e, 0x0,
-    0x7f, 0xc1, 0xf8, 0xf, 0xf8, 0x7, 0xe0, 0x3f,
-    0xe0, 0x1f, 0x80, 0xff, 0x80, 0x7e, 0x3, 0xf0,
-    0x1, 0xf8, 0xf, 0xc0, 0x7, 0xe0, 0x3f, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xfc, 0x0, 0x1, 0xf8,
-    0x0, 0x0, 0x7, 0xe0, 0x0, 0x0, 0x1f, 0x80,
-    0x0, 0x0, 0x7e, 0x0, 0x0, 0x1, 0xf8, 0x0,
-    0x0, 0x7, 0xe0, 0x0, 0x0, 0x1f, 0x80, 0x0,
-    0x0, 0x7e, 0x0, 0x0, 0x1, 0xf8, 0x0, 0x0,
-    0x7, 0xe0, 0x0, 0x0, 0x1f, 0x80, 0x0, 0x0,
-    0x7e, 0x0,
+    0x3f, 0xf8, 0xbf, 0x8f, 0xff, 0xf9, 0xf6, 0x3f,
+    0xff, 0xe7, 0xfb, 0x8f, 0xff, 0xf9, 0xfd, 0xc7,
+    0xff, 0xfc, 0xfe, 0xe3, 0xd8, 0xff, 0xff, 0xb8,
+    0xf7, 0x1f, 0xff, 0xfe, 0x3d, 0xc7, 0xff, 0xfc,
+    0xfe, 0xe3, 0xff, 0xdb, 0xff, 0xc7, 0xbf, 0x8f,
+    0xff, 0xf9, 0xff, 0xff, 0xff, 0xf8, 0xa7, 0xbf,
+    0x8f, 0xff, 0xf9, 0xff, 0xff, 0x3f, 0xff, 0xe7,
+    0xff, 0xfc, 0xff, 0xe9, 0x0,
 
     /* U+0035 "5" */
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf0, 0x0,
-    0x0, 0x1f, 0x80, 0x0, 0x0, 0xfc, 0x0, 0x0,
-    0x7, 0xe0, 0x0, 0x0, 0x3f, 0x0, 0x0, 0x1,
-    0xf8, 0x0, 0x0, 0xf, 0xff, 0xff, 0xf0, 0x7f,
-    0xff, 0xff, 0x83, 0xff, 0xff, 0xfc, 0x1f, 0xff,
-    0xff, 0xf8, 0xff, 0xff, 0xff, 0xc7, 0xff, 0xff,
-    0xfe, 0x0, 0x0, 0x3, 0xfe, 0x0, 0x0, 0x1f,
-    0xf0, 0x0, 0x0, 0xff, 0x80, 0x0, 0x0, 0xfc,
-    0x0, 0x0, 0x7, 0xe0, 0x0, 0x0, 0x3f, 0x0,
-    0x0, 0x1, 0xf8, 0x0, 0x0, 0xf, 0xc0, 0x0,
-    0x0, 0x7e, 0x0, 0x0, 0x3, 0xf0, 0x0, 0x0,
-    0x1f, 0xfe, 0x0, 0x0, 0xff, 0xf0, 0x0, 0x7,
-    0xff, 0x80, 0x0, 0x3f, 0xff, 0x80, 0xf, 0xff,
-    0xfc, 0x0, 0x7f, 0xff, 0xe0, 0x3, 0xfe, 0x3f,
-    0xff, 0xff, 0x81, 0xff, 0xff, 0xfc, 0xf, 0xff,
-    0xff, 0xe0, 0xf, 0xff, 0xfc, 0x0, 0x7f, 0xff,
-    0xe0, 0x3, 0xff, 0xff, 0x0,
+    0xff, 0xfa, 0x27, 0xff, 0xfc, 0xff, 0xff, 0xbf,
+    0xfe, 0x59, 0xff, 0xff, 0x3f, 0xff, 0xef, 0xff,
+    0x8c, 0x7f, 0xff, 0xcf, 0xfd, 0x8f, 0xff, 0x8f,
+    0xff, 0xc8, 0x3d, 0xc7, 0xff, 0xfc, 0xb8, 0xff,
+    0xff, 0x9f, 0xff, 0xf3, 0xff, 0xdf, 0xf8, 0xff,
+    0xff, 0x9f, 0xfb, 0x8f, 0xfb, 0x8f, 0xff, 0xa7,
+    0x1e, 0xff, 0xe3, 0xdc, 0x7f, 0xfc, 0x78, 0xff,
+    0xe3, 0x63, 0xff, 0xe2,
 
     /* U+0036 "6" */
-    0x3, 0xff, 0xff, 0x0, 0x1f, 0xff, 0xf8, 0x0,
-    0xff, 0xff, 0xc0, 0x3f, 0xff, 0xff, 0x81, 0xff,
-    0xff, 0xfc, 0xf, 0xff, 0xff, 0xe3, 0xfe, 0x0,
-    0x1f, 0xff, 0xf0, 0x0, 0xff, 0xff, 0x80, 0x7,
-    0xff, 0xe0, 0x0, 0x7, 0xff, 0x0, 0x0, 0x3f,
-    0xf8, 0x0, 0x1, 0xff, 0xc0, 0x0, 0x0, 0x7e,
-    0x0, 0x0, 0x3, 0xf0, 0x0, 0x0, 0x1f, 0x80,
-    0x0, 0x0, 0xfc, 0x0, 0x0, 0x7, 0xe0, 0x0,
-    0x0, 0x3f, 0xff, 0xff, 0xc1, 0xff, 0xff, 0xfe,
-    0xf, 0xff, 0xff, 0xf0, 0x7f, 0xff, 0xff, 0xe3,
-    0xff, 0xff, 0xff, 0x1f, 0xff, 0xff, 0xf8, 0xfc,
-    0x0, 0x7, 0xff, 0xe0, 0x0, 0x3f, 0xff, 0x0,
-    0x1, 0xff, 0xf8, 0x0, 0x1, 0xff, 0xc0, 0x0,
-    0xf, 0xfe, 0x0, 0x0, 0x7f, 0xf0, 0x0, 0x3,
-    0xff, 0x80, 0x0, 0x1f, 0xff, 0x80, 0x7, 0xff,
-    0xfc, 0x0, 0x3f, 0xff, 0xe0, 0x1, 0xfe, 0x3f,
-    0xff, 0xff, 0x81, 0xff, 0xff, 0xfc, 0xf, 0xff,
-    0xff, 0xe0, 0xf, 0xff, 0xfc, 0x0, 0x7f, 0xff,
-    0xe0, 0x3, 0xff, 0xff, 0x0,
+    0x3d, 0xff, 0xf1, 0x8f, 0xff, 0xb7, 0x1f, 0xfc,
+    0x6c, 0x7f, 0xfc, 0x78, 0xf7, 0xff, 0x8e, 0xe3,
+    0xff, 0xe9, 0xc7, 0xfe, 0xe3, 0xff, 0xfe, 0x7f,
+    0xef, 0x8f, 0xff, 0xf9, 0xff, 0xff, 0x7f, 0xfc,
+    0x63, 0xff, 0xfe, 0x7f, 0xec, 0x7f, 0xfd, 0xff,
+    0xfe, 0x19, 0xdc, 0x7f, 0xff, 0xcd, 0xc7, 0xff,
+    0xfc, 0xff, 0xf4, 0x71, 0xff, 0xb8, 0xff, 0xf9,
+    0xf1, 0xef, 0xff, 0x1d, 0xc7, 0xff, 0xc7, 0x8f,
+    0xfe, 0x36, 0x3f, 0xfe, 0x20,
 
     /* U+0037 "7" */
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf0, 0x0,
-    0x0, 0xf, 0xc0, 0x0, 0x0, 0x3f, 0x0, 0x0,
-    0x0, 0xfc, 0x0, 0x0, 0x3, 0xf0, 0x0, 0x0,
-    0xf, 0xc0, 0x0, 0x0, 0x3f, 0x0, 0x0, 0x7,
-    0xfc, 0x0, 0x0, 0x1f, 0xf0, 0x0, 0x0, 0x7f,
-    0xc0, 0x0, 0xf, 0xf8, 0x0, 0x0, 0x3f, 0xe0,
-    0x0, 0x0, 0xff, 0x80, 0x0, 0x1f, 0xf0, 0x0,
-    0x0, 0x7f, 0xc0, 0x0, 0x1, 0xff, 0x0, 0x0,
-    0x3f, 0xe0, 0x0, 0x0, 0xff, 0x80, 0x0, 0x3,
-    0xfe, 0x0, 0x0, 0xf, 0xc0, 0x0, 0x0, 0x3f,
-    0x0, 0x0, 0x0, 0xfc, 0x0, 0x0, 0x3, 0xf0,
-    0x0, 0x0, 0xf, 0xc0, 0x0, 0x0, 0x3f, 0x0,
-    0x0, 0x0, 0xfc, 0x0, 0x0, 0x3, 0xf0, 0x0,
-    0x0, 0xf, 0xc0, 0x0, 0x0, 0x3f, 0x0, 0x0,
-    0x0, 0xfc, 0x0, 0x0, 0x3, 0xf0, 0x0, 0x0,
-    0xf, 0xc0, 0x0, 0x0, 0x3f, 0x0, 0x0, 0x0,
-    0xfc, 0x0, 0x0, 0x3, 0xf0, 0x0, 0x0, 0xf,
-    0xc0, 0x0,
+    0xff, 0xfa, 0x47, 0xff, 0xfc, 0xff, 0xff, 0xff,
+    0xfc, 0xc3, 0xff, 0xfe, 0x7f, 0xff, 0xcf, 0xfe,
+    0x7f, 0x1f, 0xff, 0xf3, 0xfb, 0x8f, 0x71, 0xff,
+    0xff, 0xe3, 0xdc, 0x7f, 0xff, 0xf8, 0xf7, 0x1f,
+    0xff, 0xf3, 0xfb, 0x8f, 0xff, 0xf9, 0xff, 0xff,
+    0x3f, 0xff, 0xe7, 0xff, 0xfc, 0xff, 0xff, 0x9f,
+    0xff, 0xf3, 0xff, 0xb6,
 
     /* U+0038 "8" */
-    0x3, 0xff, 0xff, 0x0, 0x1f, 0xff, 0xf8, 0x0,
-    0xff, 0xff, 0xc0, 0x3f, 0xff, 0xff, 0x81, 0xff,
-    0xff, 0xfc, 0xf, 0xff, 0xff, 0xe3, 0xfe, 0x0,
-    0x1f, 0xff, 0xf0, 0x0, 0xff, 0xff, 0x80, 0x7,
-    0xff, 0xe0, 0x0, 0x7, 0xff, 0x0, 0x0, 0x3f,
-    0xf8, 0x0, 0x1, 0xff, 0xc0, 0x0, 0xf, 0xfe,
-    0x0, 0x0, 0x7f, 0xf0, 0x0, 0x3, 0xff, 0xf0,
-    0x0, 0xff, 0xff, 0x80, 0x7, 0xf8, 0xfc, 0x0,
-    0x3e, 0x7, 0xff, 0xff, 0xf0, 0x3f, 0xff, 0xff,
-    0x81, 0xff, 0xff, 0xfc, 0xf, 0xff, 0xff, 0xe0,
-    0x7f, 0xff, 0xff, 0x3, 0xff, 0xff, 0xf8, 0xff,
-    0x80, 0x7, 0xff, 0xfc, 0x0, 0x3f, 0xff, 0x0,
-    0x0, 0x3f, 0xf8, 0x0, 0x1, 0xff, 0xc0, 0x0,
-    0xf, 0xfe, 0x0, 0x0, 0x7f, 0xf0, 0x0, 0x3,
-    0xff, 0x80, 0x0, 0x1f, 0xff, 0x80, 0x7, 0xff,
-    0xfc, 0x0, 0x3f, 0xff, 0xe0, 0x1, 0xfe, 0x3f,
-    0xff, 0xff, 0x81, 0xff, 0xff, 0xfc, 0xf, 0xff,
-    0xff, 0xe0, 0xf, 0xff, 0xfc, 0x0, 0x7f, 0xff,
-    0xe0, 0x3, 0xff, 0xff, 0x0,
+    0x3d, 0xff, 0xf1, 0x8f, 0xff, 0xb7, 0x1f, 0xfc,
+    0x6c, 0x7f, 0xfc, 0x78, 0xf7, 0xff, 0x8e, 0xe3,
+    0xff, 0xe9, 0xc7, 0xfe, 0xe3, 0xff, 0xfe, 0x7f,
+    0xff, 0xcf, 0x71, 0xff, 0xb8, 0xff, 0xeb, 0x71,
+    0xff, 0xcb, 0xe3, 0xfb, 0xff, 0xc7, 0xff, 0xfc,
+    0xff, 0xff, 0x97, 0x1e, 0xff, 0xf1, 0xdc, 0x7f,
+    0xf5, 0xf8, 0xff, 0xdc, 0x7f, 0xff, 0xcf, 0xff,
+    0xf9, 0xee, 0x3f, 0xf7, 0x1f, 0xff, 0x3e, 0x3d,
+    0xff, 0xe3, 0xb8, 0xff, 0xf8, 0xf1, 0xff, 0xc6,
+    0xc7, 0xff, 0xc4,
 
     /* U+0039 "9" */
-    0x3, 0xff, 0xff, 0x0, 0x1f, 0xff, 0xf8, 0x0,
-    0xff, 0xff, 0xc0, 0x3f, 0xff, 0xff, 0x81, 0xff,
-    0xff, 0xfc, 0xf, 0xff, 0xff, 0xe3, 0xfe, 0x0,
-    0x1f, 0xff, 0xf0, 0x0, 0xff, 0xff, 0x80, 0x7,
-    0xff, 0xe0, 0x0, 0x7, 0xff, 0x0, 0x0, 0x3f,
-    0xf8, 0x0, 0x1, 0xff, 0xc0, 0x0, 0xf, 0xfe,
-    0x0, 0x0, 0x7f, 0xfe, 0x0, 0x3, 0xff, 0xf0,
-    0x0, 0x1f, 0xff, 0x80, 0x0, 0xf8, 0xfc, 0x0,
-    0x7, 0xc7, 0xff, 0xff, 0xfe, 0x3f, 0xff, 0xff,
-    0xf0, 0x3f, 0xff, 0xff, 0x81, 0xff, 0xff, 0xfc,
-    0xf, 0xff, 0xff, 0xe0, 0x7f, 0xff, 0xff, 0x0,
-    0x0, 0x0, 0xf8, 0x0, 0x0, 0x7, 0xc0, 0x0,
-    0x0, 0x3e, 0x0, 0x0, 0x1, 0xf0, 0x0, 0x0,
-    0xf, 0xfe, 0x0, 0x0, 0x7f, 0xf0, 0x0, 0x3,
-    0xff, 0x80, 0x0, 0x1f, 0xff, 0x80, 0x7, 0xff,
-    0xfc, 0x0, 0x3f, 0xff, 0xe0, 0x1, 0xfe, 0x3f,
-    0xff, 0xff, 0x81, 0xff, 0xff, 0xfc, 0xf, 0xff,
-    0xff, 0xe0, 0xf, 0xff, 0xfc, 0x0, 0x7f, 0xff,
-    0xe0, 0x3, 0xff, 0xff, 0x0,
-
-    /* U+003A ":" */
-    0xff, 0xff, 0xff, 0xff, 0xf0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x3f, 0xff, 0xff, 0xff, 0xfc,
-
-    /* U+003B ";" */
-    0x3, 0xf0, 0x3f, 0x3, 0xf0, 0x3f, 0x3, 0xf0,
-    0x3f, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x3f, 0x3, 0xf0, 0x3f, 0x3,
-    0xf0, 0x3f, 0x3, 0xf1, 0xf8, 0x1f, 0x81, 0xf8,
-    0xfc, 0xf, 0xc0, 0xfc, 0x0,
-
-    /* U+003C "<" */
-    0x0, 0x0, 0x3e, 0x0, 0x0, 0x7c, 0x0, 0x0,
-    0xf8, 0x0, 0xf, 0xf0, 0x0, 0x1f, 0xe0, 0x0,
-    0x3f, 0xc0, 0x3, 0xfe, 0x0, 0x7, 0xfc, 0x0,
-    0xf, 0xf8, 0x0, 0xff, 0x80, 0x1, 0xff, 0x0,
-    0x3, 0xfe, 0x0, 0x3f, 0xe0, 0x0, 0x7f, 0xc0,
-    0x0, 0xff, 0x80, 0xf, 0xf8, 0x0, 0x1f, 0xf0,
-    0x0, 0x3f, 0xe0, 0x3, 0xfe, 0x0, 0x7, 0xfc,
-    0x0, 0xf, 0xf8, 0x0, 0x1f, 0x80, 0x0, 0x3f,
-    0x0, 0x0, 0x7f, 0xc0, 0x0, 0xff, 0x80, 0x1,
-    0xff, 0x0, 0x0, 0x7f, 0xc0, 0x0, 0xff, 0x80,
-    0x1, 0xff, 0x0, 0x0, 0x7f, 0xc0, 0x0, 0xff,
-    0x80, 0x1, 0xff, 0x0, 0x0, 0x7f, 0xc0, 0x0,
-    0xff, 0x80, 0x1, 0xff, 0x0, 0x0, 0x7f, 0xc0,
-    0x0, 0xff, 0x80, 0x1, 0xff, 0x0, 0x0, 0x7f,
-    0x80, 0x0, 0xff, 0x0, 0x1, 0xfe, 0x0, 0x0,
-    0x7c, 0x0, 0x0, 0xf8, 0x0, 0x1, 0xf0,
-
-    /* U+003D "=" */
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xfc, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0xf, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xc0,
-
-    /* U+003E ">" */
-    0xfc, 0x0, 0x1, 0xf8, 0x0, 0x3, 0xf0, 0x0,
-    0x7, 0xfc, 0x0, 0xf, 0xf8, 0x0, 0x1f, 0xf0,
-    0x0, 0x7, 0xfc, 0x0, 0xf, 0xf8, 0x0, 0x1f,
-    0xf0, 0x0, 0x7, 0xfc, 0x0, 0xf, 0xf8, 0x0,
-    0x1f, 0xf0, 0x0, 0x7, 0xfc, 0x0, 0xf, 0xf8,
-    0x0, 0x1f, 0xf0, 0x0, 0x7, 0xfc, 0x0, 0xf,
-    0xf8, 0x0, 0x1f, 0xf0, 0x0, 0x7, 0xf8, 0x0,
-    0xf, 0xf0, 0x0, 0x1f, 0xe0, 0x0, 0x7, 0xc0,
-    0x0, 0xf, 0x80, 0x0, 0xff, 0x0, 0x1, 0xfe,
-    0x0, 0x3, 0xfc, 0x0, 0x3f, 0xe0, 0x0, 0x7f,
-    0xc0, 0x0, 0xff, 0x80, 0xf, 0xf8, 0x0, 0x1f,
-    0xf0, 0x0, 0x3f, 0xe0, 0x3, 0xfe, 0x0, 0x7,
-    0xfc, 0x0, 0xf, 0xf8, 0x0, 0xff, 0x80, 0x1,
-    0xff, 0x0, 0x3, 0xfe, 0x0, 0x3f, 0xe0, 0x0,
-    0x7f, 0xc0, 0x0, 0xff, 0x80, 0x1, 0xf8, 0x0,
-    0x3, 0xf0, 0x0, 0x7, 0xe0, 0x0, 0x0,
-
-    /* U+003F "?" */
-    0x3, 0xff, 0xff, 0x0, 0x1f, 0xff, 0xf8, 0x0,
-    0xff, 0xff, 0xc0, 0x3f, 0xff, 0xff, 0x81, 0xff,
-    0xff, 0xfc, 0xf, 0xff, 0xff, 0xe3, 0xfe, 0x0,
-    0x1f, 0xff, 0xf0, 0x0, 0xff, 0xff, 0x80, 0x7,
-    0xff, 0xe0, 0x0, 0x7, 0xff, 0x0, 0x0, 0x3f,
-    0xf8, 0x0, 0x1, 0xf0, 0x0, 0x0, 0xf, 0x80,
-    0x0, 0x0, 0x7c, 0x0, 0x0, 0x3, 0xe0, 0x0,
-    0x0, 0xff, 0x0, 0x0, 0x7, 0xf8, 0x0, 0x0,
-    0x3e, 0x0, 0x0, 0xf, 0xf0, 0x0, 0x0, 0x7f,
-    0x80, 0x0, 0x1f, 0xf0, 0x0, 0x0, 0xff, 0x80,
-    0x0, 0x7, 0xfc, 0x0, 0x1, 0xff, 0x0, 0x0,
-    0xf, 0xf8, 0x0, 0x0, 0x7f, 0xc0, 0x0, 0x3,
-    0xfe, 0x0, 0x0, 0x1f, 0x80, 0x0, 0x0, 0xfc,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x1f, 0x80, 0x0, 0x0, 0xfc, 0x0, 0x0, 0x7,
-    0xe0, 0x0, 0x0, 0x3f, 0x0, 0x0, 0x1, 0xf8,
-    0x0, 0x0, 0xf, 0xc0, 0x0,
-
-    /* U+0040 "@" */
-    0x3, 0xff, 0xff, 0x0, 0x1f, 0xff, 0xf8, 0x0,
-    0xff, 0xff, 0xc0, 0x3f, 0x0, 0xf, 0x81, 0xf8,
-    0x0, 0x7c, 0xf, 0xc0, 0x3, 0xe3, 0xf0, 0x0,
-    0x3, 0xff, 0x80, 0x0, 0x1f, 0xfc, 0x0, 0x0,
-    0xff, 0x3, 0xf1, 0xc1, 0xf8, 0x1f, 0x8e, 0xf,
-    0xc0, 0xfc, 0x70, 0x7e, 0x3f, 0x1f, 0x83, 0xf1,
-    0xf8, 0xfc, 0x1f, 0x8f, 0xc7, 0xe0, 0xfc, 0x7e,
-    0x3f, 0x7, 0xe3, 0xf1, 0xf8, 0x3f, 0x1f, 0x8f,
-    0xc1, 0xf8, 0xfc, 0x7e, 0xf, 0xc7, 0xe3, 0xf0,
-    0x7e, 0x3f, 0x1f, 0x8f, 0xf1, 0xf8, 0xfc, 0x7f,
-    0x8f, 0xc7, 0xe3, 0xfc, 0xf, 0xf8, 0xf8, 0xe0,
-    0x7f, 0xc7, 0xc7, 0x3, 0xfe, 0x3e, 0x3f, 0x0,
-    0x0, 0x1, 0xf8, 0x0, 0x0, 0xf, 0xc0, 0x0,
-    0x0, 0xf, 0xc0, 0x3, 0xe0, 0x7e, 0x0, 0x1f,
-    0x3, 0xf0, 0x0, 0xf8, 0x3, 0xff, 0xff, 0x0,
-    0x1f, 0xff, 0xf8, 0x0, 0xff, 0xff, 0xc0,
-
-    /* U+0041 "A" */
-    0x0, 0xf, 0xc0, 0x0, 0x0, 0x7e, 0x0, 0x0,
-    0x3, 0xf0, 0x0, 0x0, 0xff, 0xf0, 0x0, 0x7,
-    0xff, 0x80, 0x0, 0x3f, 0xfc, 0x0, 0xf, 0xff,
-    0xfc, 0x0, 0x7f, 0xff, 0xe0, 0x3, 0xff, 0xff,
-    0x0, 0xff, 0x81, 0xfe, 0x7, 0xfc, 0xf, 0xf0,
-    0x3f, 0xe0, 0x7f, 0x8f, 0xf8, 0x0, 0x7f, 0xff,
-    0xc0, 0x3, 0xff, 0xfe, 0x0, 0x1f, 0xff, 0x80,
-    0x0, 0x1f, 0xfc, 0x0, 0x0, 0xff, 0xe0, 0x0,
-    0x7, 0xff, 0x0, 0x0, 0x3f, 0xf8, 0x0, 0x1,
-    0xff, 0xc0, 0x0, 0xf, 0xfe, 0x0, 0x0, 0x7f,
-    0xf0, 0x0, 0x3, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xfe, 0x0, 0x0, 0x7f, 0xf0, 0x0, 0x3,
-    0xff, 0x80, 0x0, 0x1f, 0xfc, 0x0, 0x0, 0xff,
-    0xe0, 0x0, 0x7, 0xff, 0x0, 0x0, 0x3f, 0xf8,
-    0x0, 0x1, 0xff, 0xc0, 0x0, 0xf, 0xfe, 0x0,
-    0x0, 0x7f, 0xf0, 0x0, 0x3, 0xff, 0x80, 0x0,
-    0x1f, 0xfc, 0x0, 0x0, 0xf8,
-
-    /* U+0042 "B" */
-    0xff, 0xff, 0xfe, 0x7, 0xff, 0xff, 0xf0, 0x3f,
-    0xff, 0xff, 0x81, 0xff, 0xff, 0xff, 0x8f, 0xff,
-    0xff, 0xfc, 0x7f, 0xff, 0xff, 0xe3, 0xf0, 0x0,
-    0x3f, 0xff, 0x80, 0x1, 0xff, 0xfc, 0x0, 0xf,
-    0xff, 0xe0, 0x0, 0xf, 0xff, 0x0, 0x0, 0x7f,
-    0xf8, 0x0, 0x3, 0xff, 0xc0, 0x0, 0x1f, 0xfe,
-    0x0, 0x0, 0xff, 0xf0, 0x0, 0x7, 0xff, 0x80,
-    0x1, 0xff, 0xfc, 0x0, 0xf, 0xff, 0xe0, 0x0,
-    0x7e, 0x3f, 0xff, 0xff, 0xf1, 0xff, 0xff, 0xff,
-    0x8f, 0xff, 0xff, 0xfc, 0x7f, 0xff, 0xff, 0xe3,
-    0xff, 0xff, 0xff, 0x1f, 0xff, 0xff, 0xf8, 0xfc,
-    0x0, 0xf, 0xff, 0xe0, 0x0, 0x7f, 0xff, 0x0,
-    0x0, 0x7f, 0xf8, 0x0, 0x3, 0xff, 0xc0, 0x0,
-    0x1f, 0xfe, 0x0, 0x0, 0xff, 0xf0, 0x0, 0x7,
-    0xff, 0x80, 0x0, 0x3f, 0xfc, 0x0, 0xf, 0xff,
-    0xe0, 0x0, 0x7f, 0xff, 0x0, 0x3, 0xff, 0xff,
-    0xff, 0xff, 0x8f, 0xff, 0xff, 0xfc, 0x7f, 0xff,
-    0xff, 0xe3, 0xff, 0xff, 0xf8, 0x1f, 0xff, 0xff,
-    0xc0, 0xff, 0xff, 0xfe, 0x0,
-
-    /* U+0043 "C" */
-    0x3, 0xff, 0xff, 0x0, 0x1f, 0xff, 0xf8, 0x0,
-    0xff, 0xff, 0xc0, 0x3f, 0xff, 0xff, 0x81, 0xff,
-    0xff, 0xfc, 0xf, 0xff, 0xff, 0xe3, 0xfe, 0x0,
-    0x1f, 0xff, 0xf0, 0x0, 0xff, 0xff, 0x80, 0x7,
-    0xff, 0xe0, 0x0, 0x7, 0xff, 0x0, 0x0, 0x3f,
-    0xf8, 0x0, 0x1, 0xff, 0xc0, 0x0, 0x0, 0x7e,
-    0x0, 0x0, 0x3, 0xf0, 0x0, 0x0, 0x1f, 0x80,
-    0x0, 0x0, 0xfc, 0x0, 0x0, 0x7, 0xe0, 0x0,
-    0x0, 0x3f, 0x0, 0x0, 0x1, 0xf8, 0x0, 0x0,
-    0xf, 0xc0, 0x0, 0x0, 0x7e, 0x0, 0x0, 0x3,
-    0xf0, 0x0, 0x0, 0x1f, 0x80, 0x0, 0x0, 0xfc,
-    0x0, 0x0, 0x7, 0xe0, 0x0, 0x0, 0x3f, 0x0,
-    0x0, 0x1, 0xf8, 0x0, 0x0, 0xf, 0xc0, 0x0,
-    0x0, 0x7e, 0x0, 0x0, 0x7f, 0xf0, 0x0, 0x3,
-    0xff, 0x80, 0x0, 0x1f, 0xff, 0x80, 0x7, 0xff,
-    0xfc, 0x0, 0x3f, 0xff, 0xe0, 0x1, 0xfe, 0x3f,
-    0xff, 0xff, 0x81, 0xff, 0xff, 0xfc, 0xf, 0xff,
-    0xff, 0xe0, 0xf, 0xff, 0xfc, 0x0, 0x7f, 0xff,
-    0xe0, 0x3, 0xff, 0xff, 0x0,
-
-    /* U+0044 "D" */
-    0xff, 0xff, 0xfe, 0x7, 0xff, 0xff, 0xf0, 0x3f,
-    0xff, 0xff, 0x81, 0xff, 0xff, 0xff, 0x8f, 0xff,
-    0xff, 0xfc, 0x7f, 0xff, 0xff, 0xe3, 0xf0, 0x0,
-    0x3f, 0xff, 0x80, 0x1, 0xff, 0xfc, 0x0, 0xf,
-    0xff, 0xe0, 0x0, 0xf, 0xff, 0x0, 0x0, 0x7f,
-    0xf8, 0x0, 0x3, 0xff, 0xc0, 0x0, 0x1f, 0xfe,
-    0x0, 0x0, 0xff, 0xf0, 0x0, 0x7, 0xff, 0x80,
-    0x0, 0x3f, 0xfc, 0x0, 0x1, 0xff, 0xe0, 0x0,
-    0xf, 0xff, 0x0, 0x0, 0x7f, 0xf8, 0x0, 0x3,
-    0xff, 0xc0, 0x0, 0x1f, 0xfe, 0x0, 0x0, 0xff,
-    0xf0, 0x0, 0x7, 0xff, 0x80, 0x0, 0x3f, 0xfc,
-    0x0, 0x1, 0xff, 0xe0, 0x0, 0xf, 0xff, 0x0,
-    0x0, 0x7f, 0xf8, 0x0, 0x3, 0xff, 0xc0, 0x0,
-    0x1f, 0xfe, 0x0, 0x0, 0xff, 0xf0, 0x0, 0x7,
-    0xff, 0x80, 0x0, 0x3f, 0xfc, 0x0, 0xf, 0xff,
-    0xe0, 0x0, 0x7f, 0xff, 0x0, 0x3, 0xff, 0xff,
-    0xff, 0xff, 0x8f, 0xff, 0xff, 0xfc, 0x7f, 0xff,
-    0xff, 0xe3, 0xff, 0xff, 0xf8, 0x1f, 0xff, 0xff,
-    0xc0, 0xff, 0xff, 0xfe, 0x0,
-
-    /* U+0045 "E" */
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xc0,
-    0x0, 0x0, 0x3f, 0x0, 0x0, 0x0, 0xfc, 0x0,
-    0x0, 0x3, 0xf0, 0x0, 0x0, 0xf, 0xc0, 0x0,
-    0x0, 0x3f, 0x0, 0x0, 0x0, 0xfc, 0x0, 0x0,
-    0x3, 0xf0, 0x0, 0x0, 0xf, 0xc0, 0x0, 0x0,
-    0x3f, 0x0, 0x0, 0x0, 0xfc, 0x0, 0x0, 0x3,
-    0xf0, 0x0, 0x0, 0xf, 0xff, 0xff, 0xf0, 0x3f,
-    0xff, 0xff, 0xc0, 0xff, 0xff, 0xff, 0x3, 0xff,
-    0xff, 0xfc, 0xf, 0xff, 0xff, 0xf0, 0x3f, 0xff,
-    0xff, 0xc0, 0xfc, 0x0, 0x0, 0x3, 0xf0, 0x0,
-    0x0, 0xf, 0xc0, 0x0, 0x0, 0x3f, 0x0, 0x0,
-    0x0, 0xfc, 0x0, 0x0, 0x3, 0xf0, 0x0, 0x0,
-    0xf, 0xc0, 0x0, 0x0, 0x3f, 0x0, 0x0, 0x0,
-    0xfc, 0x0, 0x0, 0x3, 0xf0, 0x0, 0x0, 0xf,
-    0xc0, 0x0, 0x0, 0x3f, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xfc,
-
-    /* U+0046 "F" */
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xc0,
-    0x0, 0x0, 0x3f, 0x0, 0x0, 0x0, 0xfc, 0x0,
-    0x0, 0x3, 0xf0, 0x0, 0x0, 0xf, 0xc0, 0x0,
-    0x0, 0x3f, 0x0, 0x0, 0x0, 0xfc, 0x0, 0x0,
-    0x3, 0xf0, 0x0, 0x0, 0xf, 0xc0, 0x0, 0x0,
-    0x3f, 0x0, 0x0, 0x0, 0xfc, 0x0, 0x0, 0x3,
-    0xf0, 0x0, 0x0, 0xf, 0xff, 0xff, 0xf0, 0x3f,
-    0xff, 0xff, 0xc0, 0xff, 0xff, 0xff, 0x3, 0xff,
-    0xff, 0xfc, 0xf, 0xff, 0xff, 0xf0, 0x3f, 0xff,
-    0xff, 0xc0, 0xfc, 0x0, 0x0, 0x3, 0xf0, 0x0,
-    0x0, 0xf, 0xc0, 0x0, 0x0, 0x3f, 0x0, 0x0,
-    0x0, 0xfc, 0x0, 0x0, 0x3, 0xf0, 0x0, 0x0,
-    0xf, 0xc0, 0x0, 0x0, 0x3f, 0x0, 0x0, 0x0,
-    0xfc, 0x0, 0x0, 0x3, 0xf0, 0x0, 0x0, 0xf,
-    0xc0, 0x0, 0x0, 0x3f, 0x0, 0x0, 0x0, 0xfc,
-    0x0, 0x0, 0x3, 0xf0, 0x0, 0x0, 0xf, 0xc0,
-    0x0, 0x0, 0x3f, 0x0, 0x0, 0x0, 0xfc, 0x0,
-    0x0, 0x0,
-
-    /* U+0047 "G" */
-    0x3, 0xff, 0xff, 0x0, 0x1f, 0xff, 0xf8, 0x0,
-    0xff, 0xff, 0xc0, 0x3f, 0xff, 0xff, 0x81, 0xff,
-    0xff, 0xfc, 0xf, 0xff, 0xff, 0xe3, 0xfe, 0x0,
-    0x1f, 0xff, 0xf0, 0x0, 0xff, 0xff, 0x80, 0x7,
-    0xff, 0xe0, 0x0, 0x7, 0xff, 0x0, 0x0, 0x3f,
-    0xf8, 0x0, 0x1, 0xff, 0xc0, 0x0, 0x0, 0x7e,
-    0x0, 0x0, 0x3, 0xf0, 0x0, 0x0, 0x1f, 0x80,
-    0x0, 0x0, 0xfc, 0x0, 0x0, 0x7, 0xe0, 0x0,
-    0x0, 0x3f, 0x0, 0x7f, 0xff, 0xf8, 0x3, 0xff,
-    0xff, 0xc0, 0x1f, 0xff, 0xfe, 0x0, 0xff, 0xff,
-    0xf0, 0x7, 0xff, 0xff, 0x80, 0x3f, 0xff, 0xfc,
-    0x0, 0x0, 0xff, 0xe0, 0x0, 0x7, 0xff, 0x0,
-    0x0, 0x3f, 0xf8, 0x0, 0x1, 0xff, 0xc0, 0x0,
-    0xf, 0xfe, 0x0, 0x0, 0x7f, 0xf0, 0x0, 0x3,
-    0xff, 0x80, 0x0, 0x1f, 0xff, 0x80, 0x7, 0xff,
-    0xfc, 0x0, 0x3f, 0xff, 0xe0, 0x1, 0xfe, 0x3f,
-    0xff, 0xff, 0x81, 0xff, 0xff, 0xfc, 0xf, 0xff,
-    0xff, 0xe0, 0xf, 0xff, 0xfc, 0x0, 0x7f, 0xff,
-    0xe0, 0x3, 0xff, 0xff, 0x0,
-
-    /* U+0048 "H" */
-    0xfc, 0x0, 0x1, 0xff, 0xe0, 0x0, 0xf, 0xff,
-    0x0, 0x0, 0x7f, 0xf8, 0x0, 0x3, 0xff, 0xc0,
-    0x0, 0x1f, 0xfe, 0x0, 0x0, 0xff, 0xf0, 0x0,
-    0x7, 0xff, 0x80, 0x0, 0x3f, 0xfc, 0x0, 0x1,
-    0xff, 0xe0, 0x0, 0xf, 0xff, 0x0, 0x0, 0x7f,
-    0xf8, 0x0, 0x3, 0xff, 0xc0, 0x0, 0x1f, 0xfe,
-    0x0, 0x0, 0xff, 0xf0, 0x0, 0x7, 0xff, 0x80,
-    0x0, 0x3f, 0xfc, 0x0, 0x1, 0xff, 0xe0, 0x0,
-    0xf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfc,
-    0x0, 0x1, 0xff, 0xe0, 0x0, 0xf, 0xff, 0x0,
-    0x0, 0x7f, 0xf8, 0x0, 0x3, 0xff, 0xc0, 0x0,
-    0x1f, 0xfe, 0x0, 0x0, 0xff, 0xf0, 0x0, 0x7,
-    0xff, 0x80, 0x0, 0x3f, 0xfc, 0x0, 0x1, 0xff,
-    0xe0, 0x0, 0xf, 0xff, 0x0, 0x0, 0x7f, 0xf8,
-    0x0, 0x3, 0xff, 0xc0, 0x0, 0x1f, 0xfe, 0x0,
-    0x0, 0xff, 0xf0, 0x0, 0x7, 0xff, 0x80, 0x0,
-    0x3f, 0xfc, 0x0, 0x1, 0xf8,
-
-    /* U+0049 "I" */
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xf0, 0x3f, 0x0,
-    0xf, 0xc0, 0x3, 0xf0, 0x0, 0xfc, 0x0, 0x3f,
-    0x0, 0xf, 0xc0, 0x3, 0xf0, 0x0, 0xfc, 0x0,
-    0x3f, 0x0, 0xf, 0xc0, 0x3, 0xf0, 0x0, 0xfc,
-    0x0, 0x3f, 0x0, 0xf, 0xc0, 0x3, 0xf0, 0x0,
-    0xfc, 0x0, 0x3f, 0x0, 0xf, 0xc0, 0x3, 0xf0,
-    0x0, 0xfc, 0x0, 0x3f, 0x0, 0xf, 0xc0, 0x3,
-    0xf0, 0x0, 0xfc, 0x0, 0x3f, 0x0, 0xf, 0xc0,
-    0x3, 0xf0, 0x0, 0xfc, 0x0, 0x3f, 0x3, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xc0,
-
-    /* U+004A "J" */
-    0x0, 0x1f, 0xff, 0xe0, 0x3, 0xff, 0xfc, 0x0,
-    0x7f, 0xff, 0x80, 0xf, 0xff, 0xf0, 0x1, 0xff,
-    0xfe, 0x0, 0x3f, 0xff, 0xc0, 0x0, 0x3f, 0x80,
-    0x0, 0x7, 0xf0, 0x0, 0x0, 0xfe, 0x0, 0x0,
-    0x1f, 0xc0, 0x0, 0x3, 0xf8, 0x0, 0x0, 0x7f,
-    0x0, 0x0, 0xf, 0xe0, 0x0, 0x1, 0xfc, 0x0,
-    0x0, 0x3f, 0x80, 0x0, 0x7, 0xf0, 0x0, 0x0,
-    0xfe, 0x0, 0x0, 0x1f, 0xc0, 0x0, 0x3, 0xf8,
-    0x0, 0x0, 0x7f, 0x0, 0x0, 0xf, 0xe0, 0x0,
-    0x1, 0xfc, 0x0, 0x0, 0x3f, 0x80, 0x0, 0x7,
-    0xf0, 0x0, 0x0, 0xfe, 0x0, 0x0, 0x1f, 0xc0,
-    0x0, 0x3, 0xf8, 0x0, 0x0, 0x7f, 0x0, 0x0,
-    0xf, 0xe1, 0xf8, 0x1, 0xfc, 0x3f, 0x0, 0x3f,
-    0x87, 0xe0, 0x7, 0xf0, 0xff, 0x83, 0xfe, 0x1f,
-    0xf0, 0x7f, 0xc3, 0xfe, 0xf, 0xf8, 0x3f, 0xff,
-    0xf0, 0x7, 0xff, 0xfe, 0x0, 0xff, 0xff, 0xc0,
-    0x0, 0xff, 0xf0, 0x0, 0x1f, 0xfe, 0x0, 0x3,
-    0xff, 0xc0, 0x0,
-
-    /* U+004B "K" */
-    0xfc, 0x0, 0x0, 0xff, 0xe0, 0x0, 0x7, 0xff,
-    0x0, 0x0, 0x3f, 0xf8, 0x0, 0xf, 0xff, 0xc0,
-    0x0, 0x7f, 0xfe, 0x0, 0x3, 0xff, 0xf0, 0x0,
-    0xff, 0x1f, 0x80, 0x7, 0xf8, 0xfc, 0x0, 0x3f,
-    0xc7, 0xe0, 0xf, 0xf8, 0x3f, 0x0, 0x7f, 0xc1,
-    0xf8, 0x3, 0xfe, 0xf, 0xc0, 0xff, 0x80, 0x7e,
-    0x7, 0xfc, 0x3, 0xf0, 0x3f, 0xe0, 0x1f, 0x8f,
-    0xf8, 0x0, 0xfc, 0x7f, 0xc0, 0x7, 0xe3, 0xfe,
-    0x0, 0x3f, 0xff, 0x80, 0x1, 0xff, 0xfc, 0x0,
-    0xf, 0xff, 0xe0, 0x0, 0x7f, 0xff, 0x0, 0x3,
-    0xff, 0xf8, 0x0, 0x1f, 0x8f, 0xf8, 0x0, 0xfc,
-    0x7f, 0xc0, 0x7, 0xe3, 0xfe, 0x0, 0x3f, 0x3,
-    0xfe, 0x1, 0xf8, 0x1f, 0xf0, 0xf, 0xc0, 0xff,
-    0x80, 0x7e, 0x0, 0xff, 0x83, 0xf0, 0x7, 0xfc,
-    0x1f, 0x80, 0x3f, 0xe0, 0xfc, 0x0, 0x3f, 0xc7,
-    0xe0, 0x1, 0xfe, 0x3f, 0x0, 0xf, 0xf1, 0xf8,
-    0x0, 0xf, 0xff, 0xc0, 0x0, 0x7f, 0xfe, 0x0,
-    0x3, 0xff, 0xf0, 0x0, 0x3, 0xff, 0x80, 0x0,
-    0x1f, 0xfc, 0x0, 0x0, 0xf8,
-
-    /* U+004C "L" */
-    0xfc, 0x0, 0x0, 0x3, 0xf0, 0x0, 0x0, 0xf,
-    0xc0, 0x0, 0x0, 0x3f, 0x0, 0x0, 0x0, 0xfc,
-    0x0, 0x0, 0x3, 0xf0, 0x0, 0x0, 0xf, 0xc0,
-    0x0, 0x0, 0x3f, 0x0, 0x0, 0x0, 0xfc, 0x0,
-    0x0, 0x3, 0xf0, 0x0, 0x0, 0xf, 0xc0, 0x0,
-    0x0, 0x3f, 0x0, 0x0, 0x0, 0xfc, 0x0, 0x0,
-    0x3, 0xf0, 0x0, 0x0, 0xf, 0xc0, 0x0, 0x0,
-    0x3f, 0x0, 0x0, 0x0, 0xfc, 0x0, 0x0, 0x3,
-    0xf0, 0x0, 0x0, 0xf, 0xc0, 0x0, 0x0, 0x3f,
-    0x0, 0x0, 0x0, 0xfc, 0x0, 0x0, 0x3, 0xf0,
-    0x0, 0x0, 0xf, 0xc0, 0x0, 0x0, 0x3f, 0x0,
-    0x0, 0x0, 0xfc, 0x0, 0x0, 0x3, 0xf0, 0x0,
-    0x0, 0xf, 0xc0, 0x0, 0x0, 0x3f, 0x0, 0x0,
-    0x0, 0xfc, 0x0, 0x0, 0x3, 0xf0, 0x0, 0x0,
-    0xf, 0xc0, 0x0, 0x0, 0x3f, 0x0, 0x0, 0x0,
-    0xfc, 0x0, 0x0, 0x3, 0xf0, 0x0, 0x0, 0xf,
-    0xc0, 0x0, 0x0, 0x3f, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xfc,
-
-    /* U+004D "M" */
-    0xfc, 0x0, 0x1, 0xff, 0xe0, 0x0, 0xf, 0xff,
-    0x0, 0x0, 0x7f, 0xf8, 0x0, 0x3, 0xff, 0xc0,
-    0x0, 0x1f, 0xfe, 0x0, 0x0, 0xff, 0xfe, 0x0,
-    0x1f, 0xff, 0xf0, 0x0, 0xff, 0xff, 0x80, 0x7,
-    0xff, 0xff, 0x81, 0xff, 0xff, 0xfc, 0xf, 0xff,
-    0xff, 0xe0, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x8f,
-    0xff, 0x3f, 0xfc, 0x7f, 0xf9, 0xff, 0xe3, 0xff,
-    0xcf, 0xff, 0x3, 0xf0, 0x7f, 0xf8, 0x1f, 0x83,
-    0xff, 0xc0, 0xfc, 0x1f, 0xfe, 0x7, 0xe0, 0xff,
-    0xf0, 0x3f, 0x7, 0xff, 0x80, 0x0, 0x3f, 0xfc,
-    0x0, 0x1, 0xff, 0xe0, 0x0, 0xf, 0xff, 0x0,
-    0x0, 0x7f, 0xf8, 0x0, 0x3, 0xff, 0xc0, 0x0,
-    0x1f, 0xfe, 0x0, 0x0, 0xff, 0xf0, 0x0, 0x7,
-    0xff, 0x80, 0x0, 0x3f, 0xfc, 0x0, 0x1, 0xff,
-    0xe0, 0x0, 0xf, 0xff, 0x0, 0x0, 0x7f, 0xf8,
-    0x0, 0x3, 0xff, 0xc0, 0x0, 0x1f, 0xfe, 0x0,
-    0x0, 0xff, 0xf0, 0x0, 0x7, 0xff, 0x80, 0x0,
-    0x3f, 0xfc, 0x0, 0x1, 0xf8,
-
-    /* U+004E "N" */
-    0xfc, 0x0, 0x1, 0xff, 0xe0, 0x0, 0xf, 0xff,
-    0x0, 0x0, 0x7f, 0xf8, 0x0, 0x3, 0xff, 0xc0,
-    0x0, 0x1f, 0xfe, 0x0, 0x0, 0xff, 0xf0, 0x0,
-    0x7, 0xff, 0x80, 0x0, 0x3f, 0xfc, 0x0, 0x1,
-    0xff, 0xfc, 0x0, 0xf, 0xff, 0xe0, 0x0, 0x7f,
-    0xff, 0x0, 0x3, 0xff, 0xff, 0x0, 0x1f, 0xff,
-    0xf8, 0x0, 0xff, 0xff, 0xc0, 0x7, 0xff, 0xff,
-    0xc0, 0x3f, 0xff, 0xfe, 0x1, 0xff, 0xff, 0xf0,
-    0xf, 0xff, 0x1f, 0xf0, 0x7f, 0xf8, 0xff, 0x83,
-    0xff, 0xc0, 0xff, 0x9f, 0xfe, 0x7, 0xfc, 0xff,
-    0xf0, 0x3f, 0xe7, 0xff, 0x80, 0x3f, 0xff, 0xfc,
-    0x1, 0xff, 0xff, 0xe0, 0xf, 0xff, 0xff, 0x0,
-    0x7f, 0xff, 0xf8, 0x0, 0x7f, 0xff, 0xc0, 0x3,
-    0xff, 0xfe, 0x0, 0x3, 0xff, 0xf0, 0x0, 0x1f,
-    0xff, 0x80, 0x0, 0xff, 0xfc, 0x0, 0x1, 0xff,
-    0xe0, 0x0, 0xf, 0xff, 0x0, 0x0, 0x7f, 0xf8,
-    0x0, 0x3, 0xff, 0xc0, 0x0, 0x1f, 0xfe, 0x0,
-    0x0, 0xff, 0xf0, 0x0, 0x7, 0xff, 0x80, 0x0,
-    0x3f, 0xfc, 0x0, 0x1, 0xf8,
-
-    /* U+004F "O" */
-    0x3, 0xff, 0xff, 0x0, 0x1f, 0xff, 0xf8, 0x0,
-    0xff, 0xff, 0xc0, 0x3f, 0xff, 0xff, 0x81, 0xff,
-    0xff, 0xfc, 0xf, 0xff, 0xff, 0xe3, 0xfe, 0x0,
-    0x1f, 0xff, 0xf0, 0x0, 0xff, 0xff, 0x80, 0x7,
-    0xff, 0xe0, 0x0, 0x7, 0xff, 0x0, 0x0, 0x3f,
-    0xf8, 0x0, 0x1, 0xff, 0xc0, 0x0, 0xf, 0xfe,
-    0x0, 0x0, 0x7f, 0xf0, 0x0, 0x3, 0xff, 0x80,
-    0x0, 0x1f, 0xfc, 0x0, 0x0, 0xff, 0xe0, 0x0,
-    0x7, 0xff, 0x0, 0x0, 0x3f, 0xf8, 0x0, 0x1,
-    0xff, 0xc0, 0x0, 0xf, 0xfe, 0x0, 0x0, 0x7f,
-    0xf0, 0x0, 0x3, 0xff, 0x80, 0x0, 0x1f, 0xfc,
-    0x0, 0x0, 0xff, 0xe0, 0x0, 0x7, 0xff, 0x0,
-    0x0, 0x3f, 0xf8, 0x0, 0x1, 0xff, 0xc0, 0x0,
-    0xf, 0xfe, 0x0, 0x0, 0x7f, 0xf0, 0x0, 0x3,
-    0xff, 0x80, 0x0, 0x1f, 0xff, 0x80, 0x7, 0xff,
-    0xfc, 0x0, 0x3f, 0xff, 0xe0, 0x1, 0xfe, 0x3f,
-    0xff, 0xff, 0x81, 0xff, 0xff, 0xfc, 0xf, 0xff,
-    0xff, 0xe0, 0xf, 0xff, 0xfc, 0x0, 0x7f, 0xff,
-    0xe0, 0x3, 0xff, 0xff, 0x0,
-
-    /* U+0050 "P" */
-    0xff, 0xff, 0xfe, 0x7, 0xff, 0xff, 0xf0, 0x3f,
-    0xff, 0xff, 0x81, 0xff, 0xff, 0xff, 0x8f, 0xff,
-    0xff, 0xfc, 0x7f, 0xff, 0xff, 0xe3, 0xf0, 0x0,
-    0x3f, 0xff, 0x80, 0x1, 0xff, 0xfc, 0x0, 0xf,
-    0xff, 0xe0, 0x0, 0xf, 0xff, 0x0, 0x0, 0x7f,
-    0xf8, 0x0, 0x3, 0xff, 0xc0, 0x0, 0x1f, 0xfe,
-    0x0, 0x0, 0xff, 0xf0, 0x0, 0x3f, 0xff, 0x80,
-    0x1, 0xff, 0xfc, 0x0, 0xf, 0xff, 0xe0, 0x0,
-    0x7e, 0x3f, 0xff, 0xff, 0xf1, 0xff, 0xff, 0xff,
-    0x8f, 0xff, 0xff, 0xe0, 0x7f, 0xff, 0xff, 0x3,
-    0xff, 0xff, 0xf8, 0x1f, 0xff, 0xff, 0xc0, 0xfc,
-    0x0, 0x0, 0x7, 0xe0, 0x0, 0x0, 0x3f, 0x0,
-    0x0, 0x1, 0xf8, 0x0, 0x0, 0xf, 0xc0, 0x0,
-    0x0, 0x7e, 0x0, 0x0, 0x3, 0xf0, 0x0, 0x0,
-    0x1f, 0x80, 0x0, 0x0, 0xfc, 0x0, 0x0, 0x7,
-    0xe0, 0x0, 0x0, 0x3f, 0x0, 0x0, 0x1, 0xf8,
-    0x0, 0x0, 0xf, 0xc0, 0x0, 0x0, 0x7e, 0x0,
-    0x0, 0x3, 0xf0, 0x0, 0x0, 0x1f, 0x80, 0x0,
-    0x0, 0xfc, 0x0, 0x0, 0x0,
-
-    /* U+0051 "Q" */
-    0x3, 0xff, 0xff, 0x0, 0x1f, 0xff, 0xf8, 0x0,
-    0xff, 0xff, 0xc0, 0x3f, 0xff, 0xff, 0x81, 0xff,
-    0xff, 0xfc, 0xf, 0xff, 0xff, 0xe3, 0xfe, 0x0,
-    0x1f, 0xff, 0xf0, 0x0, 0xff, 0xff, 0x80, 0x7,
-    0xff, 0xe0, 0x0, 0x7, 0xff, 0x0, 0x0, 0x3f,
-    0xf8, 0x0, 0x1, 0xff, 0xc0, 0x0, 0xf, 0xfe,
-    0x0, 0x0, 0x7f, 0xf0, 0x0, 0x3, 0xff, 0x80,
-    0x0, 0x1f, 0xfc, 0x0, 0x0, 0xff, 0xe0, 0x0,
-    0x7, 0xff, 0x0, 0x0, 0x3f, 0xf8, 0x0, 0x1,
-    0xff, 0xc0, 0x0, 0xf, 0xfe, 0x0, 0x0, 0x7f,
-    0xf0, 0x0, 0x3, 0xff, 0x81, 0xf8, 0x1f, 0xfc,
-    0xf, 0xc0, 0xff, 0xe0, 0x7e, 0x7, 0xff, 0x3,
-    0xfe, 0x3f, 0xf8, 0x1f, 0xf1, 0xff, 0xc0, 0xff,
-    0x8f, 0xfe, 0x0, 0xff, 0xff, 0xf0, 0x7, 0xff,
-    0xff, 0x80, 0x3f, 0xff, 0xff, 0x80, 0x3f, 0xc7,
-    0xfc, 0x1, 0xfe, 0x3f, 0xe0, 0xf, 0xf0, 0x3f,
-    0xff, 0xff, 0xf1, 0xff, 0xff, 0xff, 0x8f, 0xff,
-    0xff, 0xfc, 0xf, 0xff, 0x3, 0xe0, 0x7f, 0xf8,
-    0x1f, 0x3, 0xff, 0xc0, 0xf8,
-
-    /* U+0052 "R" */
-    0xff, 0xff, 0xff, 0x7, 0xff, 0xff, 0xf8, 0x3f,
-    0xff, 0xff, 0xc1, 0xff, 0xff, 0xff, 0x8f, 0xff,
-    0xff, 0xfc, 0x7f, 0xff, 0xff, 0xe3, 0xf0, 0x0,
-    0x1f, 0xff, 0x80, 0x0, 0xff, 0xfc, 0x0, 0x7,
-    0xff, 0xe0, 0x0, 0x7, 0xff, 0x0, 0x0, 0x3f,
-    0xf8, 0x0, 0x1, 0xff, 0xc0, 0x0, 0xf, 0xfe,
-    0x0, 0x0, 0x7f, 0xf0, 0x0, 0x1f, 0xff, 0x80,
-    0x0, 0xff, 0xfc, 0x0, 0x7, 0xff, 0xe0, 0x0,
-    0x3e, 0x3f, 0xff, 0xff, 0xf1, 0xff, 0xff, 0xff,
-    0x8f, 0xff, 0xff, 0xf0, 0x7f, 0xff, 0xff, 0x83,
-    0xff, 0xff, 0xfc, 0x1f, 0xff, 0xff, 0xe0, 0xfc,
-    0x7f, 0xc0, 0x7, 0xe3, 0xfe, 0x0, 0x3f, 0x3,
-    0xfe, 0x1, 0xf8, 0x1f, 0xf0, 0xf, 0xc0, 0xff,
-    0x80, 0x7e, 0x7, 0xfc, 0x3, 0xf0, 0x7, 0xfc,
-    0x1f, 0x80, 0x3f, 0xe0, 0xfc, 0x1, 0xff, 0xc7,
-    0xe0, 0x1, 0xfe, 0x3f, 0x0, 0xf, 0xf1, 0xf8,
-    0x0, 0xf, 0xff, 0xc0, 0x0, 0x7f, 0xfe, 0x0,
-    0x3, 0xff, 0xf0, 0x0, 0x3, 0xff, 0x80, 0x0,
-    0x1f, 0xfc, 0x0, 0x0, 0xf8,
-
-    /* U+0053 "S" */
-    0x3, 0xff, 0xff, 0x0, 0x1f, 0xff, 0xf8, 0x0,
-    0xff, 0xff, 0xc0, 0x3f, 0xff, 0xff, 0xc1, 0xff,
-    0xff, 0xfe, 0xf, 0xff, 0xff, 0xf3, 0xfe, 0x0,
-    0x1f, 0xff, 0xf0, 0x0, 0xff, 0xff, 0x80, 0x7,
-    0xff, 0xe0, 0x0, 0x7, 0xff, 0x0, 0x0, 0x3f,
-    0xf8, 0x0, 0x1, 0xff, 0xc0, 0x0, 0x0, 0x7e,
-    0x0, 0x0, 0x3, 0xfe, 0x0, 0x0, 0x1f, 0xf0,
-    0x0, 0x0, 0xff, 0x80, 0x0, 0x0, 0xfc, 0x0,
-    0x0, 0x7, 0xff, 0xff, 0xc0, 0x3f, 0xff, 0xfe,
-    0x0, 0x3f, 0xff, 0xf0, 0x1, 0xff, 0xff, 0xf0,
-    0xf, 0xff, 0xff, 0x80, 0x7f, 0xff, 0xfc, 0x0,
-    0x0, 0x7, 0xf8, 0x0, 0x0, 0x3f, 0xc0, 0x0,
-    0x1, 0xfe, 0x0, 0x0, 0x1, 0xf0, 0x0, 0x0,
-    0xf, 0xfe, 0x0, 0x0, 0x7f, 0xf0, 0x0, 0x3,
-    0xff, 0x80, 0x0, 0x1f, 0xff, 0x80, 0x7, 0xff,
-    0xfc, 0x0, 0x3f, 0xff, 0xe0, 0x1, 0xfe, 0x3f,
-    0xff, 0xff, 0xc1, 0xff, 0xff, 0xfe, 0xf, 0xff,
-    0xff, 0xf0, 0xf, 0xff, 0xfc, 0x0, 0x7f, 0xff,
-    0xe0, 0x3, 0xff, 0xff, 0x0,
-
-    /* U+0054 "T" */
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xfc, 0x0, 0x3f,
-    0x0, 0x0, 0x1, 0xf8, 0x0, 0x0, 0xf, 0xc0,
-    0x0, 0x0, 0x7e, 0x0, 0x0, 0x3, 0xf0, 0x0,
-    0x0, 0x1f, 0x80, 0x0, 0x0, 0xfc, 0x0, 0x0,
-    0x7, 0xe0, 0x0, 0x0, 0x3f, 0x0, 0x0, 0x1,
-    0xf8, 0x0, 0x0, 0xf, 0xc0, 0x0, 0x0, 0x7e,
-    0x0, 0x0, 0x3, 0xf0, 0x0, 0x0, 0x1f, 0x80,
-    0x0, 0x0, 0xfc, 0x0, 0x0, 0x7, 0xe0, 0x0,
-    0x0, 0x3f, 0x0, 0x0, 0x1, 0xf8, 0x0, 0x0,
-    0xf, 0xc0, 0x0, 0x0, 0x7e, 0x0, 0x0, 0x3,
-    0xf0, 0x0, 0x0, 0x1f, 0x80, 0x0, 0x0, 0xfc,
-    0x0, 0x0, 0x7, 0xe0, 0x0, 0x0, 0x3f, 0x0,
-    0x0, 0x1, 0xf8, 0x0, 0x0, 0xf, 0xc0, 0x0,
-    0x0, 0x7e, 0x0, 0x0, 0x3, 0xf0, 0x0, 0x0,
-    0x1f, 0x80, 0x0, 0x0, 0xfc, 0x0, 0x0, 0x7,
-    0xe0, 0x0, 0x0, 0x3f, 0x0, 0x0, 0x1, 0xf8,
-    0x0, 0x0, 0xf, 0xc0, 0x0,
-
-    /* U+0055 "U" */
-    0xfc, 0x0, 0x0, 0xff, 0xe0, 0x0, 0x7, 0xff,
-    0x0, 0x0, 0x3f, 0xf8, 0x0, 0x1, 0xff, 0xc0,
-    0x0, 0xf, 0xfe, 0x0, 0x0, 0x7f, 0xf0, 0x0,
-    0x3, 0xff, 0x80, 0x0, 0x1f, 0xfc, 0x0, 0x0,
-    0xff, 0xe0, 0x0, 0x7, 0xff, 0x0, 0x0, 0x3f,
-    0xf8, 0x0, 0x1, 0xff, 0xc0, 0x0, 0xf, 0xfe,
-    0x0, 0x0, 0x7f, 0xf0, 0x0, 0x3, 0xff, 0x80,
-    0x0, 0x1f, 0xfc, 0x0, 0x0, 0xff, 0xe0, 0x0,
-    0x7, 0xff, 0x0, 0x0, 0x3f, 0xf8, 0x0, 0x1,
-    0xff, 0xc0, 0x0, 0xf, 0xfe, 0x0, 0x0, 0x7f,
-    0xf0, 0x0, 0x3, 0xff, 0x80, 0x0, 0x1f, 0xfc,
-    0x0, 0x0, 0xff, 0xe0, 0x0, 0x7, 0xff, 0x0,
-    0x0, 0x3f, 0xf8, 0x0, 0x1, 0xff, 0xc0, 0x0,
-    0xf, 0xfe, 0x0, 0x0, 0x7f, 0xf0, 0x0, 0x3,
-    0xff, 0x80, 0x0, 0x1f, 0xff, 0x80, 0x7, 0xff,
-    0xfc, 0x0, 0x3f, 0xff, 0xe0, 0x1, 0xfe, 0x3f,
-    0xff, 0xff, 0x81, 0xff, 0xff, 0xfc, 0xf, 0xff,
-    0xff, 0xe0, 0xf, 0xff, 0xfc, 0x0, 0x7f, 0xff,
-    0xe0, 0x3, 0xff, 0xff, 0x0,
-
-    /* U+0056 "V" */
-    0xfc, 0x0, 0x0, 0xff, 0xe0, 0x0, 0x7, 0xff,
-    0x0, 0x0, 0x3f, 0xf8, 0x0, 0x1, 0xff, 0xc0,
-    0x0, 0xf, 0xfe, 0x0, 0x0, 0x7f, 0xf0, 0x0,
-    0x3, 0xff, 0x80, 0x0, 0x1f, 0xfc, 0x0, 0x0,
-    0xff, 0xe0, 0x0, 0x7, 0xff, 0x0, 0x0, 0x3f,
-    0xf8, 0x0, 0x1, 0xff, 0xc0, 0x0, 0xf, 0xfe,
-    0x0, 0x0, 0x7f, 0xf0, 0x0, 0x3, 0xff, 0x80,
-    0x0, 0x1f, 0xfc, 0x0, 0x0, 0xff, 0xe0, 0x0,
-    0x7, 0xff, 0x0, 0x0, 0x3f, 0xf8, 0x0, 0x1,
-    0xff, 0xc0, 0x0, 0xf, 0xfe, 0x0, 0x0, 0x7f,
-    0xf0, 0x0, 0x3, 0xff, 0x80, 0x0, 0x1f, 0xfc,
-    0x0, 0x0, 0xff, 0xe0, 0x0, 0x7, 0xff, 0xe0,
-    0x1, 0xff, 0xff, 0x0, 0xf, 0xff, 0xf8, 0x0,
-    0x7f, 0x8f, 0xf8, 0x1f, 0xe0, 0x7f, 0xc0, 0xff,
-    0x3, 0xfe, 0x7, 0xf8, 0x3, 0xff, 0xff, 0x0,
-    0x1f, 0xff, 0xf8, 0x0, 0xff, 0xff, 0xc0, 0x0,
-    0xff, 0xf0, 0x0, 0x7, 0xff, 0x80, 0x0, 0x3f,
-    0xfc, 0x0, 0x0, 0x3f, 0x0, 0x0, 0x1, 0xf8,
-    0x0, 0x0, 0xf, 0xc0, 0x0,
-
-    /* U+0057 "W" */
-    0xfc, 0x0, 0x1, 0xff, 0xe0, 0x0, 0xf, 0xff,
-    0x0, 0x0, 0x7f, 0xf8, 0x0, 0x3, 0xff, 0xc0,
-    0x0, 0x1f, 0xfe, 0x0, 0x0, 0xff, 0xf0, 0x0,
-    0x7, 0xff, 0x80, 0x0, 0x3f, 0xfc, 0x0, 0x1,
-    0xff, 0xe0, 0x0, 0xf, 0xff, 0x0, 0x0, 0x7f,
-    0xf8, 0x0, 0x3, 0xff, 0xc0, 0x0, 0x1f, 0xfe,
-    0x0, 0x0, 0xff, 0xf0, 0x0, 0x7, 0xff, 0x80,
-    0x0, 0x3f, 0xfc, 0x0, 0x1, 0xff, 0xe0, 0x0,
-    0xf, 0xff, 0x3, 0xf0, 0x7f, 0xf8, 0x1f, 0x83,
-    0xff, 0xc0, 0xfc, 0x1f, 0xfe, 0x7, 0xe0, 0xff,
-    0xf0, 0x3f, 0x7, 0xff, 0x81, 0xf8, 0x3f, 0xfc,
-    0xf, 0xc1, 0xff, 0xe0, 0x7e, 0xf, 0xff, 0x3,
-    0xf0, 0x7f, 0xf8, 0x1f, 0x83, 0xff, 0xc0, 0xfc,
-    0x1f, 0xfe, 0x7, 0xe0, 0xff, 0xf0, 0x3f, 0x7,
-    0xff, 0x81, 0xf8, 0x3f, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe, 0x3f,
-    0xff, 0xff, 0x81, 0xff, 0xff, 0xfc, 0xf, 0xff,
-    0xff, 0xe0, 0xf, 0xc0, 0xf8, 0x0, 0x7e, 0x7,
-    0xc0, 0x3, 0xf0, 0x3e, 0x0,
-
-    /* U+0058 "X" */
-    0xfc, 0x0, 0x0, 0xff, 0xe0, 0x0, 0x7, 0xff,
-    0x0, 0x0, 0x3f, 0xf8, 0x0, 0x1, 0xff, 0xc0,
-    0x0, 0xf, 0xfe, 0x0, 0x0, 0x7f, 0xf0, 0x0,
-    0x3, 0xff, 0x80, 0x0, 0x1f, 0xfc, 0x0, 0x0,
-    0xff, 0xfc, 0x0, 0x3f, 0xff, 0xe0, 0x1, 0xfe,
-    0x3f, 0x0, 0xf, 0x81, 0xff, 0x7, 0xfc, 0xf,
-    0xf8, 0x3f, 0xe0, 0x7f, 0xc1, 0xff, 0x0, 0x7f,
-    0xff, 0xe0, 0x3, 0xff, 0xff, 0x0, 0x1f, 0xff,
-    0xf8, 0x0, 0x1f, 0xfe, 0x0, 0x0, 0xff, 0xf0,
-    0x0, 0x7, 0xff, 0x80, 0x0, 0x3f, 0xfc, 0x0,
-    0x1, 0xff, 0xe0, 0x0, 0x7f, 0xff, 0xe0, 0x3,
-    0xff, 0xff, 0x0, 0x1f, 0xff, 0xf8, 0x7, 0xfc,
-    0x1f, 0xf0, 0x3f, 0xe0, 0xff, 0x81, 0xff, 0x7,
-    0xfc, 0xf, 0xc0, 0x3, 0xe3, 0xfe, 0x0, 0x1f,
-    0xff, 0xf0, 0x0, 0xff, 0xfc, 0x0, 0x0, 0xff,
-    0xe0, 0x0, 0x7, 0xff, 0x0, 0x0, 0x3f, 0xf8,
-    0x0, 0x1, 0xff, 0xc0, 0x0, 0xf, 0xfe, 0x0,
-    0x0, 0x7f, 0xf0, 0x0, 0x3, 0xff, 0x80, 0x0,
-    0x1f, 0xfc, 0x0, 0x0, 0xf8,
-
-    /* U+0059 "Y" */
-    0xfc, 0x0, 0x0, 0xff, 0xe0, 0x0, 0x7, 0xff,
-    0x0, 0x0, 0x3f, 0xf8, 0x0, 0x1, 0xff, 0xc0,
-    0x0, 0xf, 0xfe, 0x0, 0x0, 0x7f, 0xf0, 0x0,
-    0x3, 0xff, 0x80, 0x0, 0x1f, 0xfc, 0x0, 0x0,
-    0xff, 0xe0, 0x0, 0x7, 0xff, 0x0, 0x0, 0x3f,
-    0xf8, 0x0, 0x1, 0xff, 0xc0, 0x0, 0xf, 0xfe,
-    0x0, 0x0, 0x7f, 0xf0, 0x0, 0x3, 0xff, 0xf0,
-    0x0, 0xff, 0xff, 0x80, 0x7, 0xf8, 0xfc, 0x0,
-    0x3e, 0x7, 0xfc, 0xf, 0xf0, 0x3f, 0xe0, 0x7f,
-    0x81, 0xff, 0x3, 0xfc, 0x1, 0xff, 0xff, 0x80,
-    0xf, 0xff, 0xfc, 0x0, 0x7f, 0xff, 0xe0, 0x0,
-    0x7f, 0xf8, 0x0, 0x3, 0xff, 0xc0, 0x0, 0x1f,
-    0xfe, 0x0, 0x0, 0x1f, 0x80, 0x0, 0x0, 0xfc,
-    0x0, 0x0, 0x7, 0xe0, 0x0, 0x0, 0x3f, 0x0,
-    0x0, 0x1, 0xf8, 0x0, 0x0, 0xf, 0xc0, 0x0,
-    0x0, 0x7e, 0x0, 0x0, 0x3, 0xf0, 0x0, 0x0,
-    0x1f, 0x80, 0x0, 0x0, 0xfc, 0x0, 0x0, 0x7,
-    0xe0, 0x0, 0x0, 0x3f, 0x0, 0x0, 0x1, 0xf8,
-    0x0, 0x0, 0xf, 0xc0, 0x0,
-
-    /* U+005A "Z" */
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xfc, 0x0, 0x0,
-    0x3, 0xe0, 0x0, 0x0, 0x1f, 0x0, 0x0, 0x0,
-    0xf8, 0x0, 0x0, 0x3f, 0xc0, 0x0, 0x1, 0xfe,
-    0x0, 0x0, 0xf, 0xf0, 0x0, 0x3, 0xfc, 0x0,
-    0x0, 0x1f, 0xe0, 0x0, 0x0, 0xff, 0x0, 0x0,
-    0x3f, 0xe0, 0x0, 0x1, 0xff, 0x0, 0x0, 0xf,
-    0xf8, 0x0, 0x3, 0xfe, 0x0, 0x0, 0x1f, 0xf0,
-    0x0, 0x7, 0xfc, 0x0, 0x0, 0x3f, 0xe0, 0x0,
-    0x1, 0xff, 0x0, 0x0, 0x7f, 0xc0, 0x0, 0x3,
-    0xfe, 0x0, 0x0, 0x1f, 0xf0, 0x0, 0x7, 0xff,
-    0x80, 0x0, 0x3f, 0xe0, 0x0, 0x1, 0xff, 0x0,
-    0x0, 0x7f, 0xc0, 0x0, 0x3, 0xfe, 0x0, 0x0,
-    0x1f, 0xf0, 0x0, 0x0, 0xfc, 0x0, 0x0, 0x7,
-    0xe0, 0x0, 0x0, 0x3f, 0x0, 0x0, 0x1, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xf8,
-
-    /* U+005B "[" */
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xc0, 0x3,
-    0xf0, 0x0, 0xfc, 0x0, 0x3f, 0x0, 0xf, 0xc0,
-    0x3, 0xf0, 0x0, 0xfc, 0x0, 0x3f, 0x0, 0xf,
-    0xc0, 0x3, 0xf0, 0x0, 0xfc, 0x0, 0x3f, 0x0,
-    0xf, 0xc0, 0x3, 0xf0, 0x0, 0xfc, 0x0, 0x3f,
-    0x0, 0xf, 0xc0, 0x3, 0xf0, 0x0, 0xfc, 0x0,
-    0x3f, 0x0, 0xf, 0xc0, 0x3, 0xf0, 0x0, 0xfc,
-    0x0, 0x3f, 0x0, 0xf, 0xc0, 0x3, 0xf0, 0x0,
-    0xfc, 0x0, 0x3f, 0x0, 0xf, 0xc0, 0x3, 0xf0,
-    0x0, 0xfc, 0x0, 0x3f, 0x0, 0xf, 0xc0, 0x3,
-    0xf0, 0x0, 0xfc, 0x0, 0x3f, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xfc,
-
-    /* U+005C "\\" */
-    0xfc, 0x0, 0x0, 0x7, 0xe0, 0x0, 0x0, 0x3f,
-    0x0, 0x0, 0x1, 0xf8, 0x0, 0x0, 0xf, 0xc0,
-    0x0, 0x0, 0x7e, 0x0, 0x0, 0x3, 0xf0, 0x0,
-    0x0, 0x1f, 0x80, 0x0, 0x0, 0xfc, 0x0, 0x0,
-    0x7, 0xfc, 0x0, 0x0, 0x3f, 0xe0, 0x0, 0x0,
-    0x3f, 0x0, 0x0, 0x1, 0xff, 0x0, 0x0, 0xf,
-    0xf8, 0x0, 0x0, 0x7f, 0xc0, 0x0, 0x0, 0x7f,
-    0xc0, 0x0, 0x3, 0xfe, 0x0, 0x0, 0x1f, 0xf0,
-    0x0, 0x0, 0x1f, 0xf0, 0x0, 0x0, 0xff, 0x80,
-    0x0, 0x0, 0xff, 0x80, 0x0, 0x7, 0xfc, 0x0,
-    0x0, 0x3f, 0xe0, 0x0, 0x0, 0x3f, 0xe0, 0x0,
-    0x1, 0xff, 0x0, 0x0, 0xf, 0xf8, 0x0, 0x0,
-    0x7f, 0xf0, 0x0, 0x0, 0x7f, 0x80, 0x0, 0x3,
-    0xfc, 0x0, 0x0, 0x3, 0xe0, 0x0, 0x0, 0x1f,
-    0xe0, 0x0, 0x0, 0xff, 0x0, 0x0, 0x0, 0xf8,
-    0x0, 0x0, 0x7, 0xc0, 0x0, 0x0, 0x3e, 0x0,
-    0x0, 0x1, 0xf0, 0x0, 0x0, 0xf, 0x80, 0x0,
-    0x0, 0x7c, 0x0, 0x0, 0x3, 0xe0, 0x0, 0x0,
-    0x1f, 0x0, 0x0, 0x0, 0xf8,
-
-    /* U+005D "]" */
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xf0, 0x0, 0xfc,
-    0x0, 0x3f, 0x0, 0xf, 0xc0, 0x3, 0xf0, 0x0,
-    0xfc, 0x0, 0x3f, 0x0, 0xf, 0xc0, 0x3, 0xf0,
-    0x0, 0xfc, 0x0, 0x3f, 0x0, 0xf, 0xc0, 0x3,
-    0xf0, 0x0, 0xfc, 0x0, 0x3f, 0x0, 0xf, 0xc0,
-    0x3, 0xf0, 0x0, 0xfc, 0x0, 0x3f, 0x0, 0xf,
-    0xc0, 0x3, 0xf0, 0x0, 0xfc, 0x0, 0x3f, 0x0,
-    0xf, 0xc0, 0x3, 0xf0, 0x0, 0xfc, 0x0, 0x3f,
-    0x0, 0xf, 0xc0, 0x3, 0xf0, 0x0, 0xfc, 0x0,
-    0x3f, 0x0, 0xf, 0xc0, 0x3, 0xf0, 0x0, 0xfc,
-    0x0, 0x3f, 0x0, 0xf, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xfc,
-
-    /* U+005E "^" */
-    0x0, 0xf, 0xc0, 0x0, 0x0, 0x7e, 0x0, 0x0,
-    0x3, 0xf0, 0x0, 0x0, 0xff, 0xf0, 0x0, 0x7,
-    0xff, 0x80, 0x0, 0x3f, 0xfc, 0x0, 0xf, 0xff,
-    0xfc, 0x0, 0x7f, 0xff, 0xe0, 0x3, 0xff, 0xff,
-    0x0, 0xff, 0x81, 0xfe, 0x7, 0xfc, 0xf, 0xf0,
-    0x3f, 0xe0, 0x7f, 0x8f, 0xf8, 0x0, 0x7f, 0xff,
-    0xc0, 0x3, 0xff, 0xfe, 0x0, 0x1f, 0xe0,
-
-    /* U+005F "_" */
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xc0,
-
-    /* U+0060 "`" */
-    0xff, 0x81, 0xff, 0x3, 0xfe, 0x0, 0xff, 0x81,
-    0xff, 0x3, 0xfe, 0x0, 0x1f, 0x80, 0x3f, 0x0,
-    0x7e,
-
-    /* U+0061 "a" */
-    0x3, 0xff, 0xff, 0x0, 0x1f, 0xff, 0xf8, 0x0,
-    0xff, 0xff, 0xc0, 0x7, 0xff, 0xff, 0xc0, 0x3f,
-    0xff, 0xfe, 0x1, 0xff, 0xff, 0xf0, 0x0, 0x0,
-    0x1f, 0xe0, 0x0, 0x0, 0xff, 0x0, 0x0, 0x7,
-    0xf8, 0x0, 0x0, 0x7, 0xc0, 0x0, 0x0, 0x3e,
-    0x0, 0x0, 0x1, 0xf0, 0x3f, 0xff, 0x8f, 0x81,
-    0xff, 0xfc, 0x7c, 0xf, 0xff, 0xe3, 0xe3, 0xff,
-    0xff, 0xff, 0x1f, 0xff, 0xff, 0xf8, 0xff, 0xff,
-    0xff, 0xff, 0xe0, 0x1, 0xff, 0xff, 0x0, 0xf,
-    0xff, 0xf8, 0x0, 0x7f, 0xfe, 0x0, 0x0, 0x7f,
-    0xf0, 0x0, 0x3, 0xff, 0x80, 0x0, 0x1f, 0xfc,
-    0x0, 0x0, 0xff, 0xe0, 0x0, 0x7, 0xff, 0xe0,
-    0x1, 0xff, 0xff, 0x0, 0xf, 0xff, 0xf8, 0x0,
-    0x7f, 0x8f, 0xff, 0xff, 0xfc, 0x7f, 0xff, 0xff,
-    0xe3, 0xff, 0xff, 0xff, 0x3, 0xff, 0xf8, 0xf8,
-    0x1f, 0xff, 0xc7, 0xc0, 0xff, 0xfe, 0x3e,
-
-    /* U+0062 "b" */
-    0xfc, 0x0, 0x0, 0x7, 0xe0, 0x0, 0x0, 0x3f,
-    0x0, 0x0, 0x1, 0xf8, 0x0, 0x0, 0xf, 0xc0,
-    0x0, 0x0, 0x7e, 0x0, 0x0, 0x3, 0xf0, 0x0,
-    0x0, 0x1f, 0x80, 0x0, 0x0, 0xfc, 0x0, 0x0,
-    0x7, 0xe0, 0x7f, 0xc0, 0x3f, 0x3, 0xfe, 0x1,
-    0xf8, 0x1f, 0xf0, 0xf, 0xc7, 0xff, 0xf0, 0x7e,
-    0x3f, 0xff, 0x83, 0xf1, 0xff, 0xfc, 0x1f, 0xff,
-    0xcf, 0xf8, 0xff, 0xfe, 0x7f, 0xc7, 0xff, 0xf3,
-    0xfe, 0x3f, 0xfc, 0x1, 0xff, 0xff, 0xe0, 0xf,
-    0xff, 0xff, 0x0, 0x7f, 0xff, 0xc0, 0x0, 0x7f,
-    0xfe, 0x0, 0x3, 0xff, 0xf0, 0x0, 0x1f, 0xff,
-    0x80, 0x0, 0xff, 0xfc, 0x0, 0x7, 0xff, 0xe0,
-    0x0, 0x3f, 0xff, 0x0, 0x1, 0xff, 0xf8, 0x0,
-    0xf, 0xff, 0xf8, 0x3, 0xff, 0xff, 0xc0, 0x1f,
-    0xff, 0xfe, 0x0, 0xff, 0xff, 0xfe, 0x7f, 0xc7,
-    0xff, 0xf3, 0xfe, 0x3f, 0xff, 0x9f, 0xf1, 0xf8,
-    0xff, 0xfe, 0xf, 0xc7, 0xff, 0xf0, 0x7e, 0x3f,
-    0xff, 0x83, 0xf0, 0x3f, 0xe0, 0x1f, 0x81, 0xff,
-    0x0, 0xfc, 0xf, 0xf8, 0x0,
-
-    /* U+0063 "c" */
-    0x3, 0xff, 0xff, 0x0, 0x1f, 0xff, 0xf8, 0x0,
-    0xff, 0xff, 0xc0, 0x3f, 0xff, 0xff, 0x81, 0xff,
-    0xff, 0xfc, 0xf, 0xff, 0xff, 0xe3, 0xfe, 0x0,
-    0x1f, 0xff, 0xf0, 0x0, 0xff, 0xff, 0x80, 0x7,
-    0xff, 0xe0, 0x0, 0x7, 0xff, 0x0, 0x0, 0x3f,
-    0xf8, 0x0, 0x1, 0xff, 0xc0, 0x0, 0x0, 0x7e,
-    0x0, 0x0, 0x3, 0xf0, 0x0, 0x0, 0x1f, 0x80,
-    0x0, 0x0, 0xfc, 0x0, 0x0, 0x7, 0xe0, 0x0,
-    0x0, 0x3f, 0x0, 0x0, 0x1, 0xf8, 0x0, 0x0,
-    0xf, 0xc0, 0x0, 0xf, 0xfe, 0x0, 0x0, 0x7f,
-    0xf0, 0x0, 0x3, 0xff, 0xf0, 0x0, 0xff, 0xff,
-    0x80, 0x7, 0xff, 0xfc, 0x0, 0x3f, 0xc7, 0xff,
-    0xff, 0xf0, 0x3f, 0xff, 0xff, 0x81, 0xff, 0xff,
-    0xfc, 0x1, 0xff, 0xff, 0x80, 0xf, 0xff, 0xfc,
-    0x0, 0x7f, 0xff, 0xe0,
-
-    /* U+0064 "d" */
-    0x0, 0x0, 0x1, 0xf8, 0x0, 0x0, 0xf, 0xc0,
-    0x0, 0x0, 0x7e, 0x0, 0x0, 0x3, 0xf0, 0x0,
-    0x0, 0x1f, 0x80, 0x0, 0x0, 0xfc, 0x0, 0x0,
-    0x7, 0xe0, 0x0, 0x0, 0x3f, 0x0, 0x0, 0x1,
-    0xf8, 0x3, 0xfe, 0xf, 0xc0, 0x1f, 0xf0, 0x7e,
-    0x0, 0xff, 0x83, 0xf0, 0x3f, 0xff, 0x9f, 0x81,
-    0xff, 0xfc, 0xfc, 0xf, 0xff, 0xe7, 0xe3, 0xfe,
-    0x3f, 0xff, 0x1f, 0xf1, 0xff, 0xf8, 0xff, 0x8f,
-    0xff, 0xff, 0xe0, 0xf, 0xff, 0xff, 0x0, 0x7f,
-    0xff, 0xf8, 0x3, 0xff, 0xfe, 0x0, 0x3, 0xff,
-    0xf0, 0x0, 0x1f, 0xff, 0x80, 0x0, 0xff, 0xfc,
-    0x0, 0x7, 0xff, 0xe0, 0x0, 0x3f, 0xff, 0x0,
-    0x1, 0xff, 0xf8, 0x0, 0xf, 0xff, 0xc0, 0x0,
-    0x7f, 0xff, 0xc0, 0x1f, 0xff, 0xfe, 0x0, 0xff,
-    0xff, 0xf0, 0x7, 0xff, 0x1f, 0xf1, 0xff, 0xf8,
-    0xff, 0x8f, 0xff, 0xc7, 0xfc, 0x7f, 0xfe, 0x7,
-    0xff, 0xf3, 0xf0, 0x3f, 0xff, 0x9f, 0x81, 0xff,
-    0xfc, 0xfc, 0x1, 0xff, 0x7, 0xe0, 0xf, 0xf8,
-    0x3f, 0x0, 0x7f, 0xc1, 0xf8,
-
-    /* U+0065 "e" */
-    0x3, 0xff, 0xff, 0x0, 0x1f, 0xff, 0xf8, 0x0,
-    0xff, 0xff, 0xc0, 0x3f, 0xff, 0xff, 0x81, 0xff,
-    0xff, 0xfc, 0xf, 0xff, 0xff, 0xe3, 0xfe, 0x0,
-    0x3f, 0xff, 0xf0, 0x1, 0xff, 0xff, 0x80, 0xf,
-    0xff, 0xe0, 0x0, 0x7, 0xff, 0x0, 0x0, 0x3f,
-    0xf8, 0x0, 0x1, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xf8, 0xff, 0xff, 0xff, 0xc7, 0xff, 0xff,
-    0xfe, 0x3f, 0x0, 0x0, 0x1, 0xf8, 0x0, 0x0,
-    0xf, 0xc0, 0x0, 0x0, 0x7e, 0x0, 0x0, 0x3,
-    0xf0, 0x0, 0x0, 0x1f, 0xf0, 0x1, 0xff, 0xff,
-    0x80, 0xf, 0xff, 0xfc, 0x0, 0x7f, 0xc7, 0xff,
-    0xff, 0xf0, 0x3f, 0xff, 0xff, 0x81, 0xff, 0xff,
-    0xfc, 0x1, 0xff, 0xff, 0x80, 0xf, 0xff, 0xfc,
-    0x0, 0x7f, 0xff, 0xe0,
-
-    /* U+0066 "f" */
-    0x0, 0xf, 0xff, 0x0, 0xf, 0xff, 0x0, 0xf,
-    0xff, 0x0, 0x7f, 0xff, 0x0, 0x7f, 0xff, 0x0,
-    0x7f, 0xff, 0x0, 0x7e, 0x0, 0x0, 0x7e, 0x0,
-    0x0, 0x7e, 0x0, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0x0, 0x7e, 0x0,
-    0x0, 0x7e, 0x0, 0x0, 0x7e, 0x0, 0x0, 0x7e,
-    0x0, 0x0, 0x7e, 0x0, 0x0, 0x7e, 0x0, 0x0,
-    0x7e, 0x0, 0x0, 0x7e, 0x0, 0x0, 0x7e, 0x0,
-    0x0, 0x7e, 0x0, 0x0, 0x7e, 0x0, 0x0, 0x7e,
-    0x0, 0x0, 0x7e, 0x0, 0x0, 0x7e, 0x0, 0x0,
-    0x7e, 0x0, 0x0, 0x7e, 0x0, 0x0, 0x7e, 0x0,
-    0x0, 0x7e, 0x0, 0x0, 0x7e, 0x0, 0x0, 0x7e,
-    0x0, 0x0, 0x7e, 0x0, 0x0, 0x7e, 0x0, 0x0,
-    0x7e, 0x0, 0x0, 0x7e, 0x0, 0x0, 0x7e, 0x0,
-    0x0, 0x7e, 0x0,
-
-    /* U+0067 "g" */
-    0x3, 0xff, 0xff, 0x0, 0x1f, 0xff, 0xf8, 0x0,
-    0xff, 0xff, 0xc0, 0x3f, 0xff, 0xff, 0x81, 0xff,
-    0xff, 0xfc, 0xf, 0xff, 0xff, 0xe3, 0xfe, 0x0,
-    0x1f, 0xff, 0xf0, 0x0, 0xff, 0xff, 0x80, 0x7,
-    0xff, 0xe0, 0x0, 0x7, 0xff, 0x0, 0x0, 0x3f,
-    0xff, 0x0, 0xf, 0xff, 0xf8, 0x0, 0x7f, 0xff,
-    0xc0, 0x3, 0xff, 0xfe, 0x0, 0x1f, 0xe3, 0xff,
-    0xff, 0xff, 0x1f, 0xff, 0xff, 0xf8, 0x1f, 0xff,
-    0xc7, 0xc0, 0xff, 0xfe, 0x3e, 0x7, 0xff, 0xf1,
-    0xf0, 0x3f, 0xff, 0x8f, 0x80, 0x0, 0x0, 0x7c,
-    0x0, 0x0, 0x3, 0xe0, 0x0, 0x0, 0x1f, 0x0,
-    0x0, 0x0, 0xf8, 0x0, 0x0, 0x7, 0xc7, 0xe0,
-    0x1, 0xfe, 0x3f, 0x0, 0xf, 0xf1, 0xf8, 0x0,
-    0x7f, 0x8f, 0xff, 0xff, 0xe0, 0x7f, 0xff, 0xff,
-    0x3, 0xff, 0xff, 0xf8, 0x3, 0xff, 0xff, 0x0,
-    0x1f, 0xff, 0xf8, 0x0, 0xff, 0xff, 0xc0,
-
-    /* U+0068 "h" */
-    0xfc, 0x0, 0x0, 0x7, 0xe0, 0x0, 0x0, 0x3f,
-    0x0, 0x0, 0x1, 0xf8, 0x0, 0x0, 0xf, 0xc0,
-    0x0, 0x0, 0x7e, 0x0, 0x0, 0x3, 0xf0, 0x0,
-    0x0, 0x1f, 0x80, 0x0, 0x0, 0xfc, 0x0, 0x0,
-    0x7, 0xe0, 0x7f, 0xc0, 0x3f, 0x3, 0xfe, 0x1,
-    0xf8, 0x1f, 0xf0, 0xf, 0xc7, 0xff, 0xf0, 0x7e,
-    0x3f, 0xff, 0x83, 0xf1, 0xff, 0xfc, 0x1f, 0xff,
-    0xcf, 0xf8, 0xff, 0xfe, 0x7f, 0xc7, 0xff, 0xf3,
-    0xfe, 0x3f, 0xfc, 0x1, 0xff, 0xff, 0xe0, 0xf,
-    0xff, 0xff, 0x0, 0x7f, 0xff, 0xc0, 0x0, 0x7f,
-    0xfe, 0x0, 0x3, 0xff, 0xf0, 0x0, 0x1f, 0xfc,
-    0x0, 0x0, 0xff, 0xe0, 0x0, 0x7, 0xff, 0x0,
-    0x0, 0x3f, 0xf8, 0x0, 0x1, 0xff, 0xc0, 0x0,
-    0xf, 0xfe, 0x0, 0x0, 0x7f, 0xf0, 0x0, 0x3,
-    0xff, 0x80, 0x0, 0x1f, 0xfc, 0x0, 0x0, 0xff,
-    0xe0, 0x0, 0x7, 0xff, 0x0, 0x0, 0x3f, 0xf8,
-    0x0, 0x1, 0xff, 0xc0, 0x0, 0xf, 0xfe, 0x0,
-    0x0, 0x7f, 0xf0, 0x0, 0x3, 0xff, 0x80, 0x0,
-    0x1f, 0xfc, 0x0, 0x0, 0xf8,
-
-    /* U+0069 "i" */
-    0x3, 0xf0, 0x0, 0xfc, 0x0, 0x3f, 0x0, 0xf,
-    0xc0, 0x3, 0xf0, 0x0, 0xfc, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0xff, 0xf0, 0x3f, 0xfc, 0xf,
-    0xff, 0x3, 0xff, 0xc0, 0xff, 0xf0, 0x3f, 0xfc,
-    0x0, 0x3f, 0x0, 0xf, 0xc0, 0x3, 0xf0, 0x0,
-    0xfc, 0x0, 0x3f, 0x0, 0xf, 0xc0, 0x3, 0xf0,
-    0x0, 0xfc, 0x0, 0x3f, 0x0, 0xf, 0xc0, 0x3,
-    0xf0, 0x0, 0xff, 0x80, 0x3f, 0xe0, 0xf, 0xf8,
-    0x0, 0x7f, 0xc0, 0x1f, 0xf0, 0x7, 0xfc, 0x0,
-    0x3f, 0x0, 0xf, 0xc0, 0x3, 0xf0,
-
-    /* U+006A "j" */
-    0x0, 0xf, 0xc0, 0x3, 0xf0, 0x0, 0xfc, 0x0,
-    0x3f, 0x0, 0xf, 0xc0, 0x3, 0xf0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x3, 0xff, 0xc0, 0xff, 0xf0,
-    0x3f, 0xfc, 0xf, 0xff, 0x3, 0xff, 0xc0, 0xff,
-    0xf0, 0x0, 0xfc, 0x0, 0x3f, 0x0, 0xf, 0xc0,
-    0x3, 0xf0, 0x0, 0xfc, 0x0, 0x3f, 0x0, 0xf,
-    0xc0, 0x3, 0xf0, 0x0, 0xfc, 0x0, 0x3f, 0x0,
-    0xf, 0xc0, 0x3, 0xf0, 0x0, 0xfc, 0x0, 0x3f,
-    0x0, 0xf, 0xc0, 0x3, 0xf0, 0x0, 0xfc, 0x1,
-    0xff, 0x0, 0x7f, 0xc0, 0x1f, 0xff, 0xff, 0xe3,
-    0xff, 0xf8, 0xff, 0xfe, 0x3f, 0xfc, 0xf, 0xff,
-    0x3, 0xff, 0xc0,
-
-    /* U+006B "k" */
-    0xfc, 0x0, 0x0, 0x7, 0xe0, 0x0, 0x0, 0x3f,
-    0x0, 0x0, 0x1, 0xf8, 0x0, 0x0, 0xf, 0xc0,
-    0x0, 0x0, 0x7e, 0x0, 0x0, 0x3, 0xf0, 0x0,
-    0x0, 0x1f, 0x80, 0x0, 0x0, 0xfc, 0x0, 0x0,
-    0x7, 0xe0, 0x0, 0x7, 0xff, 0x0, 0x0, 0x3f,
-    0xf8, 0x0, 0x1, 0xff, 0xc0, 0x0, 0x7f, 0xfe,
-    0x0, 0x3, 0xff, 0xf0, 0x0, 0x1f, 0xff, 0x80,
-    0x7, 0xf8, 0xfc, 0x0, 0x3f, 0xc7, 0xe0, 0x1,
-    0xfe, 0x3f, 0x0, 0x7f, 0xc1, 0xf8, 0x3, 0xfe,
-    0xf, 0xc0, 0xff, 0x80, 0x7e, 0x7, 0xfc, 0x3,
-    0xf0, 0x3f, 0xe0, 0x1f, 0x8f, 0xf8, 0x0, 0xfc,
-    0x7f, 0xc0, 0x7, 0xe3, 0xfe, 0x0, 0x3f, 0xff,
-    0xfe, 0x1, 0xff, 0xff, 0xf0, 0xf, 0xff, 0xff,
-    0x80, 0x7f, 0xf8, 0xff, 0x83, 0xff, 0xc7, 0xfc,
-    0x1f, 0xfe, 0x3f, 0xe0, 0xff, 0x80, 0x3f, 0xc7,
-    0xfc, 0x1, 0xfe, 0x3f, 0xe0, 0xf, 0xf1, 0xf8,
-    0x0, 0xf, 0xff, 0xc0, 0x0, 0x7f, 0xfe, 0x0,
-    0x3, 0xff, 0xf0, 0x0, 0x3, 0xff, 0x80, 0x0,
-    0x1f, 0xfc, 0x0, 0x0, 0xf8,
-
-    /* U+006C "l" */
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfc,
-
-    /* U+006D "m" */
-    0xfc, 0x7f, 0xff, 0x7, 0xe3, 0xff, 0xf8, 0x3f,
-    0x1f, 0xff, 0xc1, 0xff, 0xff, 0xff, 0xcf, 0xff,
-    0xff, 0xfe, 0x7f, 0xff, 0xff, 0xf3, 0xfe, 0x3f,
-    0x1f, 0xff, 0xf1, 0xf8, 0xff, 0xff, 0x8f, 0xc7,
-    0xff, 0xe0, 0x7e, 0x7, 0xff, 0x3, 0xf0, 0x3f,
-    0xf8, 0x1f, 0x81, 0xff, 0xc0, 0xfc, 0xf, 0xfe,
-    0x7, 0xe0, 0x7f, 0xf0, 0x3f, 0x3, 0xff, 0x81,
-    0xf8, 0x1f, 0xfc, 0xf, 0xc0, 0xff, 0xe0, 0x7e,
-    0x7, 0xff, 0x3, 0xf0, 0x3f, 0xf8, 0x1f, 0x81,
-    0xff, 0xc0, 0xfc, 0xf, 0xfe, 0x7, 0xe0, 0x7f,
-    0xf0, 0x3f, 0x3, 0xff, 0x81, 0xf8, 0x1f, 0xfc,
-    0xf, 0xc0, 0xff, 0xe0, 0x7e, 0x7, 0xff, 0x3,
-    0xf0, 0x3f, 0xf8, 0x1f, 0x81, 0xff, 0xc0, 0xfc,
-    0xf, 0xfe, 0x7, 0xe0, 0x7f, 0xf0, 0x3f, 0x3,
-    0xff, 0x81, 0xf8, 0x1f,
-
-    /* U+006E "n" */
-    0xfc, 0x7f, 0xff, 0x7, 0xe3, 0xff, 0xf8, 0x3f,
-    0x1f, 0xff, 0xc1, 0xff, 0xff, 0xff, 0xcf, 0xff,
-    0xff, 0xfe, 0x7f, 0xff, 0xff, 0xf3, 0xfe, 0x0,
-    0x1f, 0xff, 0xf0, 0x0, 0xff, 0xff, 0x80, 0x7,
-    0xff, 0xe0, 0x0, 0x7, 0xff, 0x0, 0x0, 0x3f,
-    0xf8, 0x0, 0x1, 0xff, 0xc0, 0x0, 0xf, 0xfe,
-    0x0, 0x0, 0x7f, 0xf0, 0x0, 0x3, 0xff, 0x80,
-    0x0, 0x1f, 0xfc, 0x0, 0x0, 0xff, 0xe0, 0x0,
-    0x7, 0xff, 0x0, 0x0, 0x3f, 0xf8, 0x0, 0x1,
-    0xff, 0xc0, 0x0, 0xf, 0xfe, 0x0, 0x0, 0x7f,
-    0xf0, 0x0, 0x3, 0xff, 0x80, 0x0, 0x1f, 0xfc,
-    0x0, 0x0, 0xff, 0xe0, 0x0, 0x7, 0xff, 0x0,
-    0x0, 0x3f, 0xf8, 0x0, 0x1, 0xff, 0xc0, 0x0,
-    0xf, 0xfe, 0x0, 0x0, 0x7f, 0xf0, 0x0, 0x3,
-    0xff, 0x80, 0x0, 0x1f,
-
-    /* U+006F "o" */
-    0x3, 0xff, 0xff, 0x0, 0x1f, 0xff, 0xf8, 0x0,
-    0xff, 0xff, 0xc0, 0x3f, 0xff, 0xff, 0x81, 0xff,
-    0xff, 0xfc, 0xf, 0xff, 0xff, 0xe3, 0xfe, 0x0,
-    0x1f, 0xff, 0xf0, 0x0, 0xff, 0xff, 0x80, 0x7,
-    0xff, 0xe0, 0x0, 0x7, 0xff, 0x0, 0x0, 0x3f,
-    0xf8, 0x0, 0x1, 0xff, 0xc0, 0x0, 0xf, 0xfe,
-    0x0, 0x0, 0x7f, 0xf0, 0x0, 0x3, 0xff, 0x80,
-    0x0, 0x1f, 0xfc, 0x0, 0x0, 0xff, 0xe0, 0x0,
-    0x7, 0xff, 0x0, 0x0, 0x3f, 0xf8, 0x0, 0x1,
-    0xff, 0xc0, 0x0, 0xf, 0xfe, 0x0, 0x0, 0x7f,
-    0xf0, 0x0, 0x3, 0xff, 0xf0, 0x0, 0xff, 0xff,
-    0x80, 0x7, 0xff, 0xfc, 0x0, 0x3f, 0xc7, 0xff,
-    0xff, 0xf0, 0x3f, 0xff, 0xff, 0x81, 0xff, 0xff,
-    0xfc, 0x1, 0xff, 0xff, 0x80, 0xf, 0xff, 0xfc,
-    0x0, 0x7f, 0xff, 0xe0,
-
-    /* U+0070 "p" */
-    0xfc, 0x7f, 0xff, 0x7, 0xe3, 0xff, 0xf8, 0x3f,
-    0x1f, 0xff, 0xc1, 0xff, 0xff, 0xff, 0xcf, 0xff,
-    0xff, 0xfe, 0x7f, 0xff, 0xff, 0xf3, 0xff, 0xc0,
-    0x1f, 0xff, 0xfe, 0x0, 0xff, 0xff, 0xf0, 0x7,
-    0xff, 0xfc, 0x0, 0x7, 0xff, 0xe0, 0x0, 0x3f,
-    0xff, 0x0, 0x1, 0xff, 0xf8, 0x0, 0xf, 0xff,
-    0xc0, 0x0, 0x7f, 0xfe, 0x0, 0x3, 0xff, 0xf0,
-    0x0, 0x1f, 0xff, 0x80, 0x0, 0xff, 0xff, 0x80,
-    0x3f, 0xff, 0xfc, 0x1, 0xff, 0xff, 0xe0, 0xf,
-    0xff, 0xff, 0xff, 0xfe, 0x7f, 0xff, 0xff, 0xf3,
-    0xff, 0xff, 0xff, 0x9f, 0x8f, 0xff, 0xe0, 0xfc,
-    0x7f, 0xff, 0x7, 0xe3, 0xff, 0xf8, 0x3f, 0x0,
-    0x0, 0x1, 0xf8, 0x0, 0x0, 0xf, 0xc0, 0x0,
-    0x0, 0x7e, 0x0, 0x0, 0x3, 0xf0, 0x0, 0x0,
-    0x1f, 0x80, 0x0, 0x0, 0xfc, 0x0, 0x0, 0x7,
-    0xe0, 0x0, 0x0, 0x3f, 0x0, 0x0, 0x0,
-
-    /* U+0071 "q" */
-    0x3, 0xff, 0xf9, 0xf8, 0x1f, 0xff, 0xcf, 0xc0,
-    0xff, 0xfe, 0x7e, 0x3f, 0xff, 0xff, 0xf1, 0xff,
-    0xff, 0xff, 0x8f, 0xff, 0xff, 0xff, 0xfe, 0x0,
-    0xff, 0xff, 0xf0, 0x7, 0xff, 0xff, 0x80, 0x3f,
-    0xff, 0xe0, 0x0, 0x3f, 0xff, 0x0, 0x1, 0xff,
-    0xf8, 0x0, 0xf, 0xff, 0xc0, 0x0, 0x7f, 0xfe,
-    0x0, 0x3, 0xff, 0xf0, 0x0, 0x1f, 0xff, 0x80,
-    0x0, 0xff, 0xfc, 0x0, 0x7, 0xff, 0xfc, 0x1,
-    0xff, 0xff, 0xe0, 0xf, 0xff, 0xff, 0x0, 0x7f,
-    0xf1, 0xff, 0xff, 0xff, 0x8f, 0xff, 0xff, 0xfc,
-    0x7f, 0xff, 0xff, 0xe0, 0x7f, 0xf8, 0xff, 0x3,
-    0xff, 0xc7, 0xf8, 0x1f, 0xfe, 0x3f, 0xc0, 0x0,
-    0x0, 0x7e, 0x0, 0x0, 0x3, 0xf0, 0x0, 0x0,
-    0x1f, 0x80, 0x0, 0x0, 0xfc, 0x0, 0x0, 0x7,
-    0xe0, 0x0, 0x0, 0x3f, 0x0, 0x0, 0x1, 0xf8,
-    0x0, 0x0, 0xf, 0xc0, 0x0, 0x0, 0x7e,
-
-    /* U+0072 "r" */
-    0xfc, 0xf, 0xff, 0x7, 0xe0, 0x7f, 0xf8, 0x3f,
-    0x3, 0xff, 0xc1, 0xf8, 0xff, 0xff, 0xcf, 0xc7,
-    0xff, 0xfe, 0x7e, 0x3f, 0xff, 0xf3, 0xff, 0xf8,
-    0x1f, 0xff, 0xff, 0xc0, 0xff, 0xff, 0xfe, 0x7,
-    0xff, 0xff, 0x80, 0x7, 0xff, 0xfc, 0x0, 0x3f,
-    0xff, 0xe0, 0x1, 0xff, 0xf8, 0x0, 0x0, 0x7f,
-    0xc0, 0x0, 0x3, 0xfe, 0x0, 0x0, 0x1f, 0x80,
-    0x0, 0x0, 0xfc, 0x0, 0x0, 0x7, 0xe0, 0x0,
-    0x0, 0x3f, 0x0, 0x0, 0x1, 0xf8, 0x0, 0x0,
-    0xf, 0xc0, 0x0, 0x0, 0x7e, 0x0, 0x0, 0x3,
-    0xf0, 0x0, 0x0, 0x1f, 0x80, 0x0, 0x0, 0xfc,
-    0x0, 0x0, 0x7, 0xe0, 0x0, 0x0, 0x3f, 0x0,
-    0x0, 0x1, 0xf8, 0x0, 0x0, 0xf, 0xc0, 0x0,
-    0x0, 0x7e, 0x0, 0x0, 0x3, 0xf0, 0x0, 0x0,
-    0x1f, 0x80, 0x0, 0x0,
-
-    /* U+0073 "s" */
-    0x3, 0xff, 0xff, 0x0, 0x1f, 0xff, 0xf8, 0x0,
-    0xff, 0xff, 0xc0, 0x3f, 0xff, 0xff, 0x81, 0xff,
-    0xff, 0xfc, 0xf, 0xff, 0xff, 0xe3, 0xfe, 0x0,
-    0x3f, 0xff, 0xf0, 0x1, 0xff, 0xff, 0x80, 0xf,
-    0xff, 0xfc, 0x0, 0x7, 0xff, 0xe0, 0x0, 0x3f,
-    0xff, 0x0, 0x1, 0xf1, 0xff, 0xfc, 0x0, 0xf,
-    0xff, 0xe0, 0x0, 0x1, 0xff, 0xfc, 0x0, 0xf,
-    0xff, 0xe0, 0x0, 0x7f, 0xff, 0x0, 0x3, 0xff,
-    0xf8, 0x0, 0x0, 0xff, 0xf0, 0x0, 0x7, 0xff,
-    0x8f, 0xc0, 0x0, 0xff, 0xfe, 0x0, 0x7, 0xff,
-    0xf0, 0x0, 0x3f, 0xff, 0xf0, 0x1, 0xff, 0xff,
-    0x80, 0xf, 0xff, 0xfc, 0x0, 0x7f, 0xc7, 0xff,
-    0xff, 0xf0, 0x3f, 0xff, 0xff, 0x81, 0xff, 0xff,
-    0xfc, 0x1, 0xff, 0xff, 0x80, 0xf, 0xff, 0xfc,
-    0x0, 0x7f, 0xff, 0xe0,
-
-    /* U+0074 "t" */
-    0x3, 0xf0, 0x0, 0xfc, 0x0, 0x3f, 0x0, 0xf,
-    0xc0, 0x3, 0xf0, 0x0, 0xfc, 0x0, 0x3f, 0x0,
-    0xf, 0xc0, 0x3, 0xf0, 0x3f, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xfc, 0xf, 0xc0, 0x3, 0xf0, 0x0, 0xfc,
-    0x0, 0x3f, 0x0, 0xf, 0xc0, 0x3, 0xf0, 0x0,
-    0xfc, 0x0, 0x3f, 0x0, 0xf, 0xc0, 0x3, 0xf0,
-    0x0, 0xfc, 0x0, 0x3f, 0x0, 0xf, 0xc0, 0x3,
-    0xf0, 0x0, 0xfc, 0x0, 0x3f, 0x0, 0xf, 0xc0,
-    0x3, 0xfe, 0x0, 0xff, 0x80, 0x3f, 0xe0, 0x1,
-    0xff, 0x0, 0x7f, 0xc0, 0x1f, 0xf0, 0x0, 0xfc,
-    0x0, 0x3f, 0x0, 0xf, 0xc0,
-
-    /* U+0075 "u" */
-    0xfc, 0x0, 0x0, 0xff, 0xe0, 0x0, 0x7, 0xff,
-    0x0, 0x0, 0x3f, 0xf8, 0x0, 0x1, 0xff, 0xc0,
-    0x0, 0xf, 0xfe, 0x0, 0x0, 0x7f, 0xf0, 0x0,
-    0x3, 0xff, 0x80, 0x0, 0x1f, 0xfc, 0x0, 0x0,
-    0xff, 0xe0, 0x0, 0x7, 0xff, 0x0, 0x0, 0x3f,
-    0xf8, 0x0, 0x1, 0xff, 0xc0, 0x0, 0xf, 0xfe,
-    0x0, 0x0, 0x7f, 0xf0, 0x0, 0x3, 0xff, 0x80,
-    0x0, 0x1f, 0xfc, 0x0, 0x0, 0xff, 0xe0, 0x0,
-    0x7, 0xff, 0x0, 0x0, 0x3f, 0xf8, 0x0, 0x1,
-    0xff, 0xc0, 0x0, 0xf, 0xfe, 0x0, 0x0, 0x7f,
-    0xf0, 0x0, 0x3, 0xff, 0xf0, 0x0, 0xff, 0xff,
-    0x80, 0x7, 0xff, 0xfc, 0x0, 0x3f, 0xc7, 0xff,
-    0xff, 0xf0, 0x3f, 0xff, 0xff, 0x81, 0xff, 0xff,
-    0xfc, 0x1, 0xff, 0xff, 0x80, 0xf, 0xff, 0xfc,
-    0x0, 0x7f, 0xff, 0xe0,
-
-    /* U+0076 "v" */
-    0xfc, 0x0, 0x0, 0xff, 0xe0, 0x0, 0x7, 0xff,
-    0x0, 0x0, 0x3f, 0xf8, 0x0, 0x1, 0xff, 0xc0,
-    0x0, 0xf, 0xfe, 0x0, 0x0, 0x7f, 0xf0, 0x0,
-    0x3, 0xff, 0x80, 0x0, 0x1f, 0xfc, 0x0, 0x0,
-    0xff, 0xe0, 0x0, 0x7, 0xff, 0x0, 0x0, 0x3f,
-    0xf8, 0x0, 0x1, 0xff, 0xc0, 0x0, 0xf, 0xfe,
-    0x0, 0x0, 0x7f, 0xf0, 0x0, 0x3, 0xff, 0x80,
-    0x0, 0x1f, 0xfc, 0x0, 0x0, 0xff, 0xfc, 0x0,
-    0x3f, 0xff, 0xe0, 0x1, 0xff, 0xff, 0x0, 0xf,
-    0xf1, 0xff, 0x3, 0xfc, 0xf, 0xf8, 0x1f, 0xe0,
-    0x7f, 0xc0, 0xff, 0x0, 0x7f, 0xff, 0xe0, 0x3,
-    0xff, 0xff, 0x0, 0x1f, 0xff, 0xf8, 0x0, 0x1f,
-    0xfe, 0x0, 0x0, 0xff, 0xf0, 0x0, 0x7, 0xff,
-    0x80, 0x0, 0x7, 0xe0, 0x0, 0x0, 0x3f, 0x0,
-    0x0, 0x1, 0xf8, 0x0,
-
-    /* U+0077 "w" */
-    0xfc, 0x0, 0x1, 0xff, 0xe0, 0x0, 0xf, 0xff,
-    0x0, 0x0, 0x7f, 0xf8, 0x0, 0x3, 0xff, 0xc0,
-    0x0, 0x1f, 0xfe, 0x0, 0x0, 0xff, 0xf0, 0x0,
-    0x7, 0xff, 0x80, 0x0, 0x3f, 0xfc, 0x0, 0x1,
-    0xff, 0xe0, 0x0, 0xf, 0xff, 0x0, 0x0, 0x7f,
-    0xf8, 0x0, 0x3, 0xff, 0xc0, 0xfc, 0x1f, 0xfe,
-    0x7, 0xe0, 0xff, 0xf0, 0x3f, 0x7, 0xff, 0x81,
-    0xf8, 0x3f, 0xfc, 0xf, 0xc1, 0xff, 0xe0, 0x7e,
-    0xf, 0xff, 0x3, 0xf0, 0x7f, 0xf8, 0x1f, 0x83,
-    0xff, 0xc0, 0xfc, 0x1f, 0xfe, 0x7, 0xe0, 0xff,
-    0xf0, 0x3f, 0x7, 0xff, 0xf1, 0xf9, 0xff, 0xff,
-    0x8f, 0xcf, 0xff, 0xfc, 0x7e, 0x7f, 0xc7, 0xff,
-    0xff, 0xf0, 0x3f, 0xff, 0xff, 0x81, 0xff, 0xff,
-    0xfc, 0x1, 0xf8, 0x1f, 0x0, 0xf, 0xc0, 0xf8,
-    0x0, 0x7e, 0x7, 0xc0,
-
-    /* U+0078 "x" */
-    0xfc, 0x0, 0x0, 0xff, 0xe0, 0x0, 0x7, 0xff,
-    0x0, 0x0, 0x3f, 0xff, 0x0, 0xf, 0xff, 0xf8,
-    0x0, 0x7f, 0xff, 0xc0, 0x3, 0xfc, 0x7f, 0xc0,
-    0xff, 0x3, 0xfe, 0x7, 0xf8, 0x1f, 0xf0, 0x3f,
-    0xc0, 0x1f, 0xff, 0xf8, 0x0, 0xff, 0xff, 0xc0,
-    0x7, 0xff, 0xfe, 0x0, 0x7, 0xff, 0x80, 0x0,
-    0x3f, 0xfc, 0x0, 0x1, 0xff, 0xe0, 0x0, 0x1,
-    0xf8, 0x0, 0x0, 0xf, 0xc0, 0x0, 0x3, 0xff,
-    0xc0, 0x0, 0x1f, 0xfe, 0x0, 0x0, 0xff, 0xf0,
-    0x0, 0x3f, 0xff, 0xf0, 0x1, 0xff, 0xff, 0x80,
-    0xf, 0xff, 0xfc, 0x3, 0xfe, 0x7, 0xf8, 0x1f,
-    0xf0, 0x3f, 0xc0, 0xff, 0x81, 0xfe, 0x3f, 0xe0,
-    0x1, 0xff, 0xff, 0x0, 0xf, 0xff, 0xf8, 0x0,
-    0x7f, 0xfe, 0x0, 0x0, 0x7f, 0xf0, 0x0, 0x3,
-    0xff, 0x80, 0x0, 0x1f,
-
-    /* U+0079 "y" */
-    0xfc, 0x0, 0x0, 0xff, 0xe0, 0x0, 0x7, 0xff,
-    0x0, 0x0, 0x3f, 0xf8, 0x0, 0x1, 0xff, 0xc0,
-    0x0, 0xf, 0xfe, 0x0, 0x0, 0x7f, 0xf0, 0x0,
-    0x1f, 0xff, 0x80, 0x0, 0xff, 0xfc, 0x0, 0x7,
-    0xff, 0xe0, 0x0, 0x3f, 0xff, 0x0, 0x1, 0xff,
-    0xf8, 0x0, 0xf, 0xff, 0xc0, 0x3, 0xff, 0xfe,
-    0x0, 0x1f, 0xff, 0xfe, 0x7, 0xff, 0xff, 0xf0,
-    0x3f, 0xff, 0xff, 0x81, 0xff, 0xf8, 0xff, 0xff,
-    0xc7, 0xc7, 0xff, 0xfe, 0x3e, 0x3f, 0xff, 0xf1,
-    0xf1, 0xff, 0xff, 0x8f, 0x81, 0xff, 0xe0, 0x7c,
-    0xf, 0xff, 0x3, 0xe0, 0x0, 0x0, 0x1f, 0x0,
-    0x0, 0x0, 0xf8, 0x0, 0x0, 0x7, 0xc0, 0x0,
-    0x1, 0xfe, 0x0, 0x0, 0xf, 0xf0, 0x0, 0x0,
-    0x7f, 0x81, 0xff, 0xff, 0xf0, 0xf, 0xff, 0xff,
-    0x80, 0x7f, 0xff, 0xfc, 0x3, 0xff, 0xff, 0x0,
-    0x1f, 0xff, 0xf8, 0x0, 0xff, 0xff, 0xc0,
-
-    /* U+007A "z" */
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xfc, 0x0, 0x0,
-    0x1f, 0xe0, 0x0, 0x0, 0xff, 0x0, 0x0, 0x7,
-    0xf8, 0x0, 0x1, 0xfe, 0x0, 0x0, 0xf, 0xf0,
-    0x0, 0x3, 0xfe, 0x0, 0x0, 0x1f, 0xf0, 0x0,
-    0x0, 0xff, 0x80, 0x0, 0x3f, 0xe0, 0x0, 0x1,
-    0xff, 0x0, 0x0, 0xf, 0xf8, 0x0, 0x3, 0xff,
-    0xc0, 0x0, 0x1f, 0xf0, 0x0, 0x0, 0xff, 0x80,
-    0x0, 0x3f, 0xe0, 0x0, 0x1, 0xff, 0x0, 0x0,
-    0xf, 0xf8, 0x0, 0x3, 0xfe, 0x0, 0x0, 0x1f,
-    0xf0, 0x0, 0x0, 0xff, 0x80, 0x0, 0x3f, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff,
-
-    /* U+007B "{" */
-    0x0, 0x7f, 0xc0, 0x1f, 0xf0, 0x7, 0xfc, 0x1,
-    0xff, 0x0, 0x7f, 0xc0, 0x1f, 0xf0, 0x3f, 0xfc,
-    0xf, 0xff, 0x3, 0xff, 0xc0, 0xfc, 0x0, 0x3f,
-    0x0, 0xf, 0xc0, 0x3, 0xf0, 0x0, 0xfc, 0x0,
-    0x3f, 0x0, 0xf, 0xc0, 0x3, 0xf0, 0x0, 0xfc,
-    0x0, 0x3f, 0x0, 0xf, 0xc0, 0x3, 0xf0, 0x3f,
-    0xe0, 0xf, 0xf8, 0x3, 0xfe, 0x0, 0xff, 0x80,
-    0x3f, 0xe0, 0xf, 0xf8, 0x0, 0xf, 0xc0, 0x3,
-    0xf0, 0x0, 0xfc, 0x0, 0x3f, 0x0, 0xf, 0xc0,
-    0x3, 0xf0, 0x0, 0xfc, 0x0, 0x3f, 0x0, 0xf,
-    0xc0, 0x3, 0xf0, 0x0, 0xfc, 0x0, 0x3f, 0xfc,
-    0xf, 0xff, 0x3, 0xff, 0xc0, 0x1f, 0xf0, 0x7,
-    0xfc, 0x1, 0xff, 0x0, 0x7f, 0xc0, 0x1f, 0xf0,
-    0x7, 0xfc,
-
-    /* U+007C "|" */
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xc0,
-
-    /* U+007D "}" */
-    0xff, 0x80, 0x3f, 0xe0, 0xf, 0xf8, 0x3, 0xfe,
-    0x0, 0xff, 0x80, 0x3f, 0xe0, 0xf, 0xff, 0x3,
-    0xff, 0xc0, 0xff, 0xf0, 0x0, 0xfc, 0x0, 0x3f,
-    0x0, 0xf, 0xc0, 0x3, 0xf0, 0x0, 0xfc, 0x0,
-    0x3f, 0x0, 0xf, 0xc0, 0x3, 0xf0, 0x0, 0xfc,
-    0x0, 0x3f, 0x0, 0xf, 0xc0, 0x3, 0xf0, 0x0,
-    0x1f, 0xf0, 0x7, 0xfc, 0x1, 0xff, 0x0, 0x7f,
-    0xc0, 0x1f, 0xf0, 0x7, 0xfc, 0xf, 0xc0, 0x3,
-    0xf0, 0x0, 0xfc, 0x0, 0x3f, 0x0, 0xf, 0xc0,
-    0x3, 0xf0, 0x0, 0xfc, 0x0, 0x3f, 0x0, 0xf,
-    0xc0, 0x3, 0xf0, 0x0, 0xfc, 0xf, 0xff, 0x3,
-    0xff, 0xc0, 0xff, 0xf0, 0x3f, 0xe0, 0xf, 0xf8,
-    0x3, 0xfe, 0x0, 0xff, 0x80, 0x3f, 0xe0, 0xf,
-    0xf8, 0x0,
-
-    /* U+007E "~" */
-    0x3, 0xfe, 0x0, 0x18, 0x1f, 0xf0, 0x0, 0xc0,
-    0xff, 0x80, 0x6, 0x3f, 0xff, 0x81, 0xf1, 0xff,
-    0xfc, 0xf, 0x8f, 0xff, 0xe0, 0x7f, 0xf0, 0x3f,
-    0xff, 0x9f, 0x81, 0xff, 0xfc, 0xfc, 0xf, 0xff,
-    0xe7, 0x0, 0xf, 0xf8, 0x38, 0x0, 0x7f, 0xc1,
-    0xc0, 0x3, 0xfe, 0x0
+    0x3d, 0xff, 0xf1, 0x8f, 0xff, 0xb7, 0x1f, 0xfc,
+    0x6c, 0x7f, 0xfc, 0x78, 0xf7, 0xff, 0x8e, 0xe3,
+    0xff, 0xe9, 0xc7, 0xfe, 0xe3, 0xff, 0xfe, 0x7f,
+    0xfa, 0x38, 0xff, 0xff, 0x97, 0x1f, 0xfd, 0x7f,
+    0xff, 0x86, 0x7f, 0xf6, 0x78, 0xff, 0xff, 0x9f,
+    0xfd, 0xdf, 0xff, 0x8c, 0x7f, 0xff, 0xcf, 0xff,
+    0x17, 0xe3, 0xff, 0xfe, 0x7f, 0xee, 0x3f, 0xf7,
+    0x1f, 0xff, 0x3e, 0x3d, 0xff, 0xe3, 0xb8, 0xff,
+    0xf8, 0xf1, 0xff, 0xc6, 0xc7, 0xff, 0xc4,
+
+    /* decoder read-ahead */
+    0x0
 };
 
 
@@ -1633,100 +146,18 @@ static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {
 static const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {
     {.bitmap_index = 0, .adv_w = 0, .box_w = 0, .box_h = 0, .ofs_x = 0, .ofs_y = 0} /* id = 0 reserved */,
     {.bitmap_index = 0, .adv_w = 563, .box_w = 1, .box_h = 1, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 1, .adv_w = 563, .box_w = 6, .box_h = 41, .ofs_x = 12, .ofs_y = 3},
-    {.bitmap_index = 32, .adv_w = 563, .box_w = 24, .box_h = 12, .ofs_x = 6, .ofs_y = 32},
-    {.bitmap_index = 68, .adv_w = 563, .box_w = 30, .box_h = 38, .ofs_x = 3, .ofs_y = 6},
-    {.bitmap_index = 211, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 360, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 509, .adv_w = 563, .box_w = 29, .box_h = 47, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 680, .adv_w = 563, .box_w = 9, .box_h = 12, .ofs_x = 12, .ofs_y = 32},
-    {.bitmap_index = 694, .adv_w = 563, .box_w = 15, .box_h = 47, .ofs_x = 9, .ofs_y = 3},
-    {.bitmap_index = 783, .adv_w = 563, .box_w = 15, .box_h = 47, .ofs_x = 12, .ofs_y = 3},
-    {.bitmap_index = 872, .adv_w = 563, .box_w = 23, .box_h = 26, .ofs_x = 6, .ofs_y = 21},
-    {.bitmap_index = 947, .adv_w = 563, .box_w = 29, .box_h = 29, .ofs_x = 3, .ofs_y = 9},
-    {.bitmap_index = 1053, .adv_w = 563, .box_w = 12, .box_h = 12, .ofs_x = 9, .ofs_y = 3},
-    {.bitmap_index = 1071, .adv_w = 563, .box_w = 23, .box_h = 6, .ofs_x = 6, .ofs_y = 20},
-    {.bitmap_index = 1089, .adv_w = 563, .box_w = 6, .box_h = 6, .ofs_x = 12, .ofs_y = 3},
-    {.bitmap_index = 1094, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 1243, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 1392, .adv_w = 563, .box_w = 18, .box_h = 41, .ofs_x = 9, .ofs_y = 3},
-    {.bitmap_index = 1485, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 1634, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 1783, .adv_w = 563, .box_w = 30, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 1937, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 2086, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 2235, .adv_w = 563, .box_w = 30, .box_h = 41, .ofs_x = 2, .ofs_y = 3},
-    {.bitmap_index = 2389, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 2538, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 2687, .adv_w = 563, .box_w = 6, .box_h = 29, .ofs_x = 12, .ofs_y = 9},
-    {.bitmap_index = 2709, .adv_w = 563, .box_w = 12, .box_h = 35, .ofs_x = 6, .ofs_y = 3},
-    {.bitmap_index = 2762, .adv_w = 563, .box_w = 23, .box_h = 44, .ofs_x = 6, .ofs_y = 3},
-    {.bitmap_index = 2889, .adv_w = 563, .box_w = 29, .box_h = 18, .ofs_x = 3, .ofs_y = 15},
-    {.bitmap_index = 2955, .adv_w = 563, .box_w = 23, .box_h = 44, .ofs_x = 6, .ofs_y = 3},
-    {.bitmap_index = 3082, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 3231, .adv_w = 563, .box_w = 29, .box_h = 35, .ofs_x = 3, .ofs_y = 6},
-    {.bitmap_index = 3358, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 3507, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 3656, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 3805, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 3954, .adv_w = 563, .box_w = 30, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 4108, .adv_w = 563, .box_w = 30, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 4262, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 4411, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 4560, .adv_w = 563, .box_w = 18, .box_h = 41, .ofs_x = 9, .ofs_y = 3},
-    {.bitmap_index = 4653, .adv_w = 563, .box_w = 27, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 4792, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 4941, .adv_w = 563, .box_w = 30, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 5095, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 5244, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 5393, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 5542, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 5691, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 5840, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 5989, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 6138, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 6287, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 6436, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 6585, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 6734, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 6883, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 7032, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 7181, .adv_w = 563, .box_w = 18, .box_h = 47, .ofs_x = 12, .ofs_y = 3},
-    {.bitmap_index = 7287, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 7436, .adv_w = 563, .box_w = 18, .box_h = 47, .ofs_x = 5, .ofs_y = 3},
-    {.bitmap_index = 7542, .adv_w = 563, .box_w = 29, .box_h = 15, .ofs_x = 3, .ofs_y = 29},
-    {.bitmap_index = 7597, .adv_w = 563, .box_w = 35, .box_h = 6, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 7624, .adv_w = 563, .box_w = 15, .box_h = 9, .ofs_x = 9, .ofs_y = 35},
-    {.bitmap_index = 7641, .adv_w = 563, .box_w = 29, .box_h = 35, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 7768, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 7917, .adv_w = 563, .box_w = 29, .box_h = 32, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 8033, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 8182, .adv_w = 563, .box_w = 29, .box_h = 32, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 8298, .adv_w = 563, .box_w = 24, .box_h = 41, .ofs_x = 6, .ofs_y = 3},
-    {.bitmap_index = 8421, .adv_w = 563, .box_w = 29, .box_h = 35, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 8548, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 8697, .adv_w = 563, .box_w = 18, .box_h = 38, .ofs_x = 9, .ofs_y = 3},
-    {.bitmap_index = 8783, .adv_w = 563, .box_w = 18, .box_h = 44, .ofs_x = 9, .ofs_y = 3},
-    {.bitmap_index = 8882, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 9031, .adv_w = 563, .box_w = 6, .box_h = 41, .ofs_x = 15, .ofs_y = 3},
-    {.bitmap_index = 9062, .adv_w = 563, .box_w = 29, .box_h = 32, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 9178, .adv_w = 563, .box_w = 29, .box_h = 32, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 9294, .adv_w = 563, .box_w = 29, .box_h = 32, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 9410, .adv_w = 563, .box_w = 29, .box_h = 35, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 9537, .adv_w = 563, .box_w = 29, .box_h = 35, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 9664, .adv_w = 563, .box_w = 29, .box_h = 32, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 9780, .adv_w = 563, .box_w = 29, .box_h = 32, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 9896, .adv_w = 563, .box_w = 18, .box_h = 41, .ofs_x = 9, .ofs_y = 3},
-    {.bitmap_index = 9989, .adv_w = 563, .box_w = 29, .box_h = 32, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 10105, .adv_w = 563, .box_w = 29, .box_h = 32, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 10221, .adv_w = 563, .box_w = 29, .box_h = 32, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 10337, .adv_w = 563, .box_w = 29, .box_h = 32, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 10453, .adv_w = 563, .box_w = 29, .box_h = 35, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 10580, .adv_w = 563, .box_w = 29, .box_h = 32, .ofs_x = 3, .ofs_y = 3},
-    {.bitmap_index = 10696, .adv_w = 563, .box_w = 18, .box_h = 47, .ofs_x = 9, .ofs_y = 3},
-    {.bitmap_index = 10802, .adv_w = 563, .box_w = 6, .box_h = 47, .ofs_x = 15, .ofs_y = 3},
-    {.bitmap_index = 10838, .adv_w = 563, .box_w = 18, .box_h = 47, .ofs_x = 9, .ofs_y = 3},
-    {.bitmap_index = 10944, .adv_w = 563, .box_w = 29, .box_h = 12, .ofs_x = 3, .ofs_y = 18}
+    {.bitmap_index = 1, .adv_w = 563, .box_w = 23, .box_h = 6, .ofs_x = 6, .ofs_y = 20},
+    {.bitmap_index = 9, .adv_w = 563, .box_w = 6, .box_h = 6, .ofs_x = 12, .ofs_y = 3},
+    {.bitmap_index = 13, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
+    {.bitmap_index = 86, .adv_w = 563, .box_w = 18, .box_h = 41, .ofs_x = 9, .ofs_y = 3},
+    {.bitmap_index = 121, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
+    {.bitmap_index = 190, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
+    {.bitmap_index = 265, .adv_w = 563, .box_w = 30, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
+    {.bitmap_index = 326, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
+    {.bitmap_index = 386, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
+    {.bitmap_index = 455, .adv_w = 563, .box_w = 30, .box_h = 41, .ofs_x = 2, .ofs_y = 3},
+    {.bitmap_index = 507, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3},
+    {.bitmap_index = 582, .adv_w = 563, .box_w = 29, .box_h = 41, .ofs_x = 3, .ofs_y = 3}
 };
 
 /*---------------------
@@ -1739,7 +170,15 @@ static const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {
 static const lv_font_fmt_txt_cmap_t cmaps[] =
 {
     {
-        .range_start = 32, .range_length = 95, .glyph_id_start = 1,
+        .range_start = 32, .range_length = 1, .glyph_id_start = 1,
+        .unicode_list = NULL, .glyph_id_ofs_list = NULL, .list_length = 0, .type = LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY
+    },
+    {
+        .range_start = 45, .range_length = 2, .glyph_id_start = 2,
+        .unicode_list = NULL, .glyph_id_ofs_list = NULL, .list_length = 0, .type = LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY
+    },
+    {
+        .range_start = 48, .range_length = 10, .glyph_id_start = 4,
         .unicode_list = NULL, .glyph_id_ofs_list = NULL, .list_length = 0, .type = LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY
     }
 };
@@ -1765,10 +204,10 @@ static lv_font_fmt_txt_dsc_t font_dsc = {
     .cmaps = cmaps,
     .kern_dsc = NULL,
     .kern_scale = 0,
-    .cmap_num = 1,
+    .cmap_num = 3,
     .bpp = 1,
     .kern_classes = 0,
-    .bitmap_format = 0,
+    .bitmap_format = 1,
 #if LVGL_VERSION_MAJOR == 8
     .cache = &cache
 #endif
@@ -1807,4 +246,3 @@ lv_font_t ui_font_Pixel_60 = {
 
 
 #endif /*#if UI_FONT_PIXEL_60*/
-
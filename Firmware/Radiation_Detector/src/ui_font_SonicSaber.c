@@ -1,7 +1,9 @@
 /*******************************************************************************
  * Size: 28 px
  * Bpp: 1
- * Opts: --bpp 1 --size 28 --font C:/Users/pablo/OneDrive/Documentos/GitHub/Geiger_Counter/SquareLineFiles/assets/SonicSaberPersonalUse-Regular.ttf -o C:/Users/pablo/OneDrive/Documentos/GitHub/Geiger_Counter/SquareLineFiles/assets\ui_font_SonicSaber.c --format lvgl -r 0x20-0x7f --no-compress --no-prefilter
+ * Generated by tools/subset_font.py from the SquareLine export - do not edit.
+ * Symbols:  ARST
+ * Bitmaps: compressed
  ******************************************************************************/
 
 #include "ui.h"
@@ -21,637 +23,39 @@ static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {
     /* U+0020 " " */
     0x0,
 
-    /* U+0021 "!" */
-    0x6f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf6,
-    0xf, 0xff,
-
-    /* U+0022 "\"" */
-    0xed, 0xfb, 0xf3, 0x6c, 0xc0,
-
-    /* U+0023 "#" */
-    0x6, 0x60, 0xf, 0xf0, 0xf, 0xf0, 0xf, 0xf0,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf, 0xf0,
-    0xf, 0xf0, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xf, 0xf0, 0xf, 0xf0, 0xf, 0xf0, 0x6, 0x60,
-
-    /* U+0024 "$" */
-    0x3, 0x0, 0x3c, 0x1, 0xe0, 0xf, 0x3, 0xfe,
-    0x3f, 0xfb, 0xff, 0xfe, 0xff, 0xf7, 0xff, 0xbd,
-    0xbd, 0xe1, 0xff, 0xc7, 0xff, 0x1f, 0xfc, 0x1f,
-    0xe0, 0xff, 0x7, 0xff, 0xbf, 0xfd, 0xff, 0xef,
-    0xff, 0xff, 0xbf, 0xf8, 0xff, 0x80, 0xf0, 0x3,
-    0x80,
-
-    /* U+0025 "%" */
-    0x0, 0x0, 0x0, 0x1c, 0x0, 0x3c, 0x0, 0x38,
-    0x0, 0x78, 0x0, 0x78, 0x78, 0x70, 0xfc, 0xf0,
-    0xcc, 0xe0, 0xcd, 0xe0, 0xfd, 0xc0, 0x7b, 0xc0,
-    0x3, 0xde, 0x3, 0xbf, 0x7, 0xb3, 0x7, 0x33,
-    0xf, 0x3f, 0xf, 0x1e, 0xe, 0x0, 0x1e, 0x0,
-    0x1c, 0x0, 0x3c, 0x0, 0x38, 0x0, 0x0, 0x0,
-
-    /* U+0026 "&" */
-    0x7, 0xc0, 0xf, 0xf0, 0x1f, 0xf8, 0x3c, 0x78,
-    0x3c, 0x78, 0x3c, 0x78, 0x1f, 0xf0, 0x1f, 0xe0,
-    0xf, 0xcc, 0xf, 0x1e, 0x1f, 0x1e, 0x3f, 0x9e,
-    0x7b, 0xde, 0xf9, 0xde, 0xf0, 0xfe, 0xf0, 0xfc,
-    0xf0, 0x7c, 0xf8, 0xfe, 0x7f, 0xfe, 0x3f, 0xff,
-    0x1f, 0x8e,
-
-    /* U+0027 "'" */
-    0xff, 0xbc,
-
-    /* U+0028 "(" */
-    0x1c, 0xfd, 0xf7, 0x8f, 0x1e, 0x3c, 0x78, 0xf1,
-    0xe3, 0xc7, 0x8f, 0x1e, 0x3c, 0x78, 0xf1, 0xe3,
-    0xc7, 0x87, 0xcf, 0xc7, 0x0,
-
-    /* U+0029 ")" */
-    0x78, 0xfc, 0x7e, 0x1f, 0xf, 0xf, 0xf, 0xf,
-    0xf, 0xf, 0xf, 0xf, 0xf, 0xf, 0xf, 0xf,
-    0xf, 0xf, 0xf, 0x1f, 0x7e, 0xfc, 0x78,
-
-    /* U+002A "*" */
-    0x3, 0x0, 0x3c, 0x19, 0xe7, 0xef, 0x77, 0xff,
-    0x9f, 0xf8, 0x7f, 0x81, 0xf8, 0xf, 0xc0, 0xff,
-    0xf, 0xfc, 0xff, 0xf7, 0x7b, 0xb3, 0xcc, 0x1e,
-    0x0, 0x60,
-
-    /* U+002B "+" */
-    0x1, 0x80, 0x3, 0xc0, 0x3, 0xc0, 0x3, 0xc0,
-    0x3, 0xc0, 0x3, 0xc0, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0x3, 0xc0, 0x3, 0xc0, 0x3, 0xc0,
-    0x3, 0xc0, 0x3, 0xc0, 0x3, 0xc0, 0x1, 0x80,
-
-    /* U+002C "," */
-    0xdf, 0xbc,
-
-    /* U+002D "-" */
-    0xff, 0xff, 0xff, 0xff, 0x80,
-
-    /* U+002E "." */
-    0xff, 0xe0,
-
-    /* U+002F "/" */
-    0x0, 0x60, 0x1c, 0x3, 0x80, 0xf0, 0x1c, 0x7,
-    0x80, 0xf0, 0x1c, 0x7, 0x80, 0xe0, 0x3c, 0x7,
-    0x0, 0xe0, 0x3c, 0x7, 0x1, 0xe0, 0x38, 0xf,
-    0x1, 0xe0, 0x38, 0xf, 0x1, 0xc0, 0x38, 0x0,
-
-    /* U+0030 "0" */
-    0x3, 0xf0, 0x7, 0xfe, 0x7, 0xff, 0x87, 0xc7,
-    0xc7, 0xc1, 0xf3, 0xc0, 0x7b, 0xe0, 0x3f, 0xe0,
-    0xf, 0xf0, 0x7, 0xf8, 0x3, 0xfc, 0x1, 0xfe,
-    0x0, 0xff, 0x0, 0x7f, 0xc0, 0x7d, 0xe0, 0x3c,
-    0xf8, 0x3e, 0x3e, 0x3e, 0x1f, 0xfe, 0x3, 0xfe,
-    0x0, 0xfe, 0x0,
-
-    /* U+0031 "1" */
-    0x3, 0xc3, 0xfd, 0xff, 0xff, 0xff, 0xfe, 0xf,
-    0xc1, 0xf8, 0x3f, 0x7, 0xe0, 0xfc, 0x1f, 0x83,
-    0xf0, 0x7e, 0xf, 0xc1, 0xf8, 0x3f, 0x7, 0xe0,
-    0xfc, 0x1f, 0x83, 0xf0, 0x3c,
-
-    /* U+0032 "2" */
-    0x7, 0xf8, 0xf, 0xff, 0x1f, 0xff, 0xcf, 0x81,
-    0xff, 0x0, 0x7f, 0x80, 0x3f, 0xc0, 0x1f, 0xe0,
-    0x1f, 0x60, 0x1f, 0x0, 0x1f, 0x0, 0x1f, 0x80,
-    0x1f, 0x80, 0x1f, 0x80, 0x1f, 0x80, 0x1f, 0x80,
-    0x1f, 0x80, 0x1f, 0x80, 0x3f, 0x80, 0x3f, 0xff,
-    0xdf, 0xff, 0xf7, 0xff, 0xf0,
-
-    /* U+0033 "3" */
-    0x7, 0xe0, 0x1f, 0xfc, 0x7f, 0xfe, 0x7c, 0x3e,
-    0xf8, 0xf, 0xf0, 0xf, 0x70, 0xf, 0x0, 0x1f,
-    0x0, 0x3e, 0x7, 0xfe, 0x7, 0xfc, 0x7, 0xfe,
-    0x0, 0x3e, 0x0, 0x1f, 0x60, 0xf, 0xf0, 0xf,
-    0xf0, 0xf, 0xf8, 0x3e, 0x7f, 0xfe, 0x3f, 0xf8,
-    0xf, 0xe0,
-
-    /* U+0034 "4" */
-    0x0, 0x38, 0x0, 0x3e, 0x0, 0x3f, 0x0, 0x3f,
-    0x80, 0x3f, 0xc0, 0x1f, 0xe0, 0x1f, 0xf0, 0x1f,
-    0xf8, 0x1f, 0xbc, 0x1f, 0x9e, 0x1f, 0x8f, 0x1f,
-    0xff, 0xef, 0xff, 0xfb, 0xff, 0xf8, 0x0, 0xf0,
-    0x0, 0x78, 0x0, 0x3c, 0x0, 0x1e, 0x0, 0xf,
-    0x0, 0x7, 0x80, 0x1, 0x80,
-
-    /* U+0035 "5" */
-    0x1f, 0xf8, 0x7f, 0xf9, 0xff, 0xe3, 0xc0, 0x7,
-    0x80, 0xf, 0x0, 0x1e, 0x0, 0x3f, 0xe0, 0xff,
-    0xf1, 0xff, 0xf1, 0xe1, 0xf0, 0x1, 0xe0, 0x1,
-    0xe0, 0x3, 0xd8, 0x7, 0xf8, 0xf, 0xf0, 0x3d,
-    0xf0, 0xf9, 0xff, 0xe1, 0xff, 0x80, 0xfc, 0x0,
-
-    /* U+0036 "6" */
-    0x0, 0x70, 0x3, 0xf0, 0xf, 0xe0, 0x3f, 0x80,
-    0x7c, 0x1, 0xf0, 0x7, 0xe0, 0x1f, 0x80, 0x3f,
-    0xc0, 0xff, 0xe1, 0xff, 0xe3, 0xc3, 0xef, 0x3,
-    0xfe, 0x3, 0xfc, 0x7, 0xf8, 0xf, 0xf0, 0x1e,
-    0xf0, 0xf9, 0xff, 0xf1, 0xff, 0xc0, 0xfc, 0x0,
-
-    /* U+0037 "7" */
-    0x7f, 0xfd, 0xff, 0xfd, 0xff, 0xf8, 0x3, 0xe0,
-    0xf, 0xc0, 0x1f, 0x0, 0x7e, 0x0, 0xf8, 0x3,
-    0xf0, 0x7, 0xc0, 0x1f, 0x80, 0x3e, 0x0, 0xfc,
-    0x1, 0xf0, 0x7, 0xe0, 0xf, 0x80, 0x3f, 0x0,
-    0x7c, 0x1, 0xf8, 0x3, 0xe0, 0x3, 0x80, 0x0,
-
-    /* U+0038 "8" */
-    0x7, 0xe0, 0x1f, 0xf8, 0x3f, 0xfc, 0x3e, 0x3c,
-    0x7c, 0x1e, 0x78, 0x1e, 0x78, 0x1e, 0x78, 0x1e,
-    0x7c, 0x3e, 0x3f, 0xfc, 0x1f, 0xf8, 0x3f, 0xfe,
-    0x7c, 0x3e, 0xf8, 0xf, 0xf0, 0xf, 0xf0, 0xf,
-    0xf0, 0xf, 0xf8, 0x3e, 0x7f, 0xfe, 0x3f, 0xfc,
-    0xf, 0xe0,
-
-    /* U+0039 "9" */
-    0x7, 0xe0, 0x3f, 0xf1, 0xff, 0xf3, 0xe3, 0xef,
-    0x1, 0xfe, 0x3, 0xfc, 0x7, 0xf8, 0xf, 0xf8,
-    0x1e, 0xf8, 0x78, 0xff, 0xf0, 0xff, 0xe0, 0x7f,
-    0x80, 0x3f, 0x0, 0x7c, 0x1, 0xf0, 0x7, 0xc0,
-    0x1f, 0x80, 0xfe, 0x1, 0xf8, 0x1, 0xc0, 0x0,
-
-    /* U+003A ":" */
-    0xff, 0xe0, 0xff, 0xe0,
-
-    /* U+003B ";" */
-    0xff, 0x8f, 0xfb, 0x40,
-
-    /* U+003C "<" */
-    0x1, 0xc0, 0xf0, 0x7c, 0x3e, 0x3f, 0x1f, 0xf,
-    0x83, 0xc0, 0xf8, 0x1f, 0x3, 0xf0, 0x3e, 0x7,
-    0xc0, 0xf0, 0x1c,
-
-    /* U+003D "=" */
-    0xff, 0xff, 0xff, 0xff, 0x80, 0x0, 0x0, 0x0,
-    0x3f, 0xff, 0xff, 0xff, 0xe0,
-
-    /* U+003E ">" */
-    0xe0, 0x3c, 0xf, 0x81, 0xf0, 0x3e, 0x3, 0xe0,
-    0x7c, 0xf, 0x7, 0xc3, 0xe3, 0xf1, 0xf0, 0xf8,
-    0x3c, 0xe, 0x0,
-
-    /* U+003F "?" */
-    0xf, 0x83, 0xfc, 0x7f, 0xef, 0x9f, 0xf0, 0xff,
-    0xf, 0xf0, 0xfe, 0x1f, 0x1, 0xe0, 0x3e, 0x7,
-    0xc0, 0xf8, 0xf, 0x1, 0xf0, 0x1e, 0x1, 0xe0,
-    0x1e, 0x0, 0x0, 0x1e, 0x1, 0xe0, 0x1c, 0x0,
-
-    /* U+0040 "@" */
-    0x1, 0xfc, 0x0, 0xff, 0xf0, 0x1f, 0xff, 0x83,
-    0xe0, 0x7c, 0x78, 0x3, 0xe7, 0xf, 0x9e, 0xf3,
-    0xfc, 0xfe, 0x7f, 0xef, 0xef, 0xbe, 0xfe, 0xf3,
-    0xef, 0xef, 0x7e, 0xfe, 0x7f, 0xef, 0xf7, 0xff,
-    0xf7, 0x3e, 0xfe, 0x78, 0xf, 0xe3, 0xe0, 0x7c,
-    0x1f, 0xf3, 0x80, 0xff, 0x80, 0x3, 0xf0, 0x0,
-
     /* U+0041 "A" */
-    0x0, 0xe0, 0x0, 0x3e, 0x0, 0x7, 0xc0, 0x1,
-    0xfc, 0x0, 0x3f, 0x80, 0x7, 0xf0, 0x1, 0xff,
-    0x0, 0x3d, 0xe0, 0xf, 0xbe, 0x1, 0xf7, 0xc0,
-    0x7c, 0x78, 0xf, 0x8f, 0x81, 0xff, 0xf0, 0x7f,
-    0xff, 0xf, 0xff, 0xe3, 0xe0, 0x3e, 0x7c, 0x7,
-    0xcf, 0x0, 0x7b, 0xe0, 0xf, 0xf8, 0x0, 0xf7,
-    0x0, 0x1c,
-
-    /* U+0042 "B" */
-    0x7f, 0xf8, 0x3f, 0xff, 0x8f, 0xff, 0xfb, 0xc0,
-    0x3e, 0xf0, 0x7, 0xfc, 0x0, 0xff, 0x0, 0x3f,
-    0xc0, 0x1f, 0xf0, 0xf, 0xbf, 0xff, 0xcf, 0xff,
-    0xc3, 0xff, 0xfc, 0xff, 0xff, 0xbc, 0x3, 0xff,
-    0x0, 0x3f, 0xc0, 0xf, 0xf0, 0x3, 0xfc, 0x3,
-    0xef, 0xff, 0xfb, 0xff, 0xf8, 0x7f, 0xf8, 0x0,
-
-    /* U+0043 "C" */
-    0xf, 0xfc, 0xf, 0xff, 0xc7, 0xff, 0xfb, 0xe0,
-    0x1f, 0xf0, 0x3, 0xfc, 0x0, 0xff, 0x0, 0x3,
-    0xc0, 0x0, 0xf0, 0x0, 0x3c, 0x0, 0xf, 0x0,
-    0x3, 0xc0, 0x0, 0xf0, 0x0, 0x3c, 0x0, 0xf,
-    0x0, 0x3, 0xc0, 0xf, 0xf0, 0x3, 0xfe, 0x1,
-    0xf7, 0xff, 0xf8, 0xff, 0xfc, 0xf, 0xfc, 0x0,
-
-    /* U+0044 "D" */
-    0x7f, 0xf8, 0x1f, 0xff, 0xc3, 0xff, 0xfc, 0x78,
-    0xf, 0xcf, 0x0, 0x7d, 0xe0, 0x7, 0xbc, 0x0,
-    0xf7, 0x80, 0xf, 0xf0, 0x1, 0xfe, 0x0, 0x3f,
-    0xc0, 0x7, 0xf8, 0x0, 0xff, 0x0, 0x1f, 0xe0,
-    0x7, 0xfc, 0x0, 0xf7, 0x80, 0x1e, 0xf0, 0x7,
-    0x9e, 0x3, 0xf3, 0xff, 0xfc, 0x7f, 0xff, 0x7,
-    0xff, 0x0,
-
-    /* U+0045 "E" */
-    0xf, 0xfc, 0xf, 0xff, 0xc7, 0xff, 0xfb, 0xe0,
-    0x1f, 0xf0, 0x3, 0xfc, 0x0, 0xff, 0x0, 0x1b,
-    0xc0, 0x0, 0xf0, 0x0, 0x3c, 0x0, 0xf, 0xff,
-    0xc3, 0xff, 0xf0, 0xff, 0xfc, 0x3c, 0x0, 0xf,
-    0x0, 0x3, 0xc0, 0xf, 0xf0, 0x3, 0xfe, 0x1,
-    0xf7, 0xff, 0xf8, 0xff, 0xfc, 0xf, 0xfc, 0x0,
-
-    /* U+0046 "F" */
-    0x7f, 0xff, 0x7f, 0xff, 0xff, 0xff, 0xde, 0x0,
-    0xf, 0x0, 0x7, 0x80, 0x3, 0xc0, 0x1, 0xe0,
-    0x0, 0xf0, 0x0, 0x78, 0x0, 0x3f, 0xff, 0x1f,
-    0xff, 0xcf, 0xff, 0xc7, 0x80, 0x3, 0xc0, 0x1,
-    0xe0, 0x0, 0xf0, 0x0, 0x78, 0x0, 0x3c, 0x0,
-    0x1e, 0x0, 0x6, 0x0, 0x0,
-
-    /* U+0047 "G" */
-    0xf, 0xfc, 0xf, 0xff, 0xc7, 0xff, 0xfb, 0xe0,
-    0x1f, 0xf0, 0x3, 0xfc, 0x0, 0xff, 0x0, 0x1b,
-    0xc0, 0x0, 0xf0, 0x0, 0x3c, 0x0, 0xf, 0x7,
-    0xfb, 0xc1, 0xff, 0xf0, 0x7f, 0xfc, 0x0, 0xff,
-    0x0, 0x3f, 0xc0, 0xf, 0xf0, 0x3, 0xfe, 0x1,
-    0xf7, 0xff, 0xfc, 0xff, 0xff, 0xf, 0xff, 0x80,
-
-    /* U+0048 "H" */
-    0x60, 0x1, 0xbc, 0x0, 0xff, 0x0, 0x3f, 0xc0,
-    0xf, 0xf0, 0x3, 0xfc, 0x0, 0xff, 0x0, 0x3f,
-    0xc0, 0xf, 0xf0, 0x3, 0xfc, 0x0, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xfc, 0x0, 0xff,
-    0x0, 0x3f, 0xc0, 0xf, 0xf0, 0x3, 0xfc, 0x0,
-    0xff, 0x0, 0x3f, 0xc0, 0xf, 0x60, 0x1, 0x80,
-
-    /* U+0049 "I" */
-    0x77, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xf7, 0x0,
-
-    /* U+004A "J" */
-    0x0, 0x6, 0x0, 0xf, 0x0, 0xf, 0x0, 0xf,
-    0x0, 0xf, 0x0, 0xf, 0x0, 0xf, 0x0, 0xf,
-    0x0, 0xf, 0x0, 0xf, 0x0, 0xf, 0x0, 0xf,
-    0x0, 0xf, 0x0, 0xf, 0x0, 0xf, 0xf0, 0xf,
-    0xf0, 0xf, 0xf8, 0x1f, 0x7f, 0xfe, 0x3f, 0xfc,
-    0xf, 0xf0,
-
-    /* U+004B "K" */
-    0x60, 0x7, 0x78, 0xf, 0xfc, 0xf, 0xfe, 0x1f,
-    0xcf, 0x1f, 0xc7, 0xbf, 0x83, 0xff, 0x81, 0xff,
-    0x80, 0xff, 0x0, 0x7f, 0x0, 0x3f, 0xc0, 0x1f,
-    0xf0, 0xf, 0xfc, 0x7, 0xbf, 0x3, 0xcf, 0xc1,
-    0xe3, 0xf0, 0xf0, 0xfc, 0x78, 0x3f, 0x3c, 0xf,
-    0xfe, 0x3, 0xf6, 0x0, 0x70,
-
-    /* U+004C "L" */
-    0x60, 0x0, 0xf0, 0x0, 0xf0, 0x0, 0xf0, 0x0,
-    0xf0, 0x0, 0xf0, 0x0, 0xf0, 0x0, 0xf0, 0x0,
-    0xf0, 0x0, 0xf0, 0x0, 0xf0, 0x0, 0xf0, 0x0,
-    0xf0, 0x0, 0xf0, 0x0, 0xf0, 0x0, 0xf0, 0x0,
-    0xf0, 0x0, 0xf0, 0x0, 0xff, 0xfe, 0xff, 0xff,
-    0x7f, 0xfe,
-
-    /* U+004D "M" */
-    0x70, 0x0, 0x1b, 0xc0, 0x0, 0xff, 0x80, 0x7,
-    0xfe, 0x0, 0x1f, 0xfc, 0x0, 0xff, 0xf0, 0x3,
-    0xff, 0xe0, 0x1f, 0xff, 0x80, 0x7f, 0xff, 0x3,
-    0xff, 0xfc, 0xf, 0xff, 0xf8, 0x7f, 0xfd, 0xe1,
-    0xef, 0xf7, 0xcf, 0xbf, 0xcf, 0x3c, 0xff, 0x3f,
-    0xf3, 0xfc, 0x7f, 0x8f, 0xf1, 0xfe, 0x3f, 0xc3,
-    0xf0, 0xff, 0x7, 0xc3, 0xfc, 0x1e, 0xf, 0x60,
-    0x30, 0x18,
-
-    /* U+004E "N" */
-    0xf0, 0x1, 0xbe, 0x0, 0xff, 0x80, 0x3f, 0xf0,
-    0xf, 0xfe, 0x3, 0xff, 0xc0, 0xff, 0xf8, 0x3f,
-    0xfe, 0xf, 0xf7, 0xc3, 0xfc, 0xf8, 0xff, 0x3f,
-    0x3f, 0xc7, 0xcf, 0xf0, 0xfb, 0xfc, 0x1f, 0xff,
-    0x7, 0xff, 0xc0, 0xff, 0xf0, 0x1f, 0xfc, 0x3,
-    0xff, 0x0, 0x7f, 0xc0, 0x1f, 0x60, 0x3, 0xc0,
-
-    /* U+004F "O" */
-    0xf, 0xfc, 0xf, 0xff, 0xc7, 0xff, 0xfb, 0xe0,
-    0x1f, 0xf0, 0x3, 0xfc, 0x0, 0xff, 0x0, 0x3f,
-    0xc0, 0xf, 0xf0, 0x3, 0xfc, 0x0, 0xff, 0x0,
-    0x3f, 0xc0, 0xf, 0xf0, 0x3, 0xfc, 0x0, 0xff,
-    0x0, 0x3f, 0xc0, 0xf, 0xf0, 0x3, 0xfe, 0x1,
-    0xf7, 0xff, 0xf8, 0xff, 0xfc, 0xf, 0xfc, 0x0,
-
-    /* U+0050 "P" */
-    0x7f, 0xfc, 0x3f, 0xff, 0xcf, 0xff, 0xfb, 0xc0,
-    0x1f, 0xf0, 0x3, 0xfc, 0x0, 0xff, 0x0, 0x3f,
-    0xc0, 0x1f, 0xff, 0xff, 0xbf, 0xff, 0xcf, 0xff,
-    0xc3, 0xc0, 0x0, 0xf0, 0x0, 0x3c, 0x0, 0xf,
-    0x0, 0x3, 0xc0, 0x0, 0xf0, 0x0, 0x3c, 0x0,
-    0xf, 0x0, 0x3, 0xc0, 0x0, 0x60, 0x0, 0x0,
-
-    /* U+0051 "Q" */
-    0xf, 0xfe, 0x3, 0xff, 0xf8, 0x7f, 0xff, 0xcf,
-    0x80, 0x3e, 0xf0, 0x1, 0xef, 0x0, 0x1e, 0xf0,
-    0x1, 0xef, 0x0, 0x1e, 0xf0, 0x1, 0xef, 0x0,
-    0x1e, 0xf0, 0x1, 0xef, 0x0, 0x1e, 0xf0, 0x1,
-    0xef, 0x0, 0x1e, 0xf0, 0x9, 0xef, 0x3, 0xde,
-    0xf0, 0x3f, 0xef, 0x83, 0xfe, 0x7f, 0xff, 0xc3,
-    0xff, 0xfe, 0xf, 0xff, 0xe0, 0x0, 0x1e, 0x0,
-    0x0, 0x0,
+    0x3f, 0x71, 0xff, 0xc3, 0x94, 0xff, 0xea, 0x4e,
+    0x9f, 0xfe, 0x59, 0xf4, 0xff, 0xe1, 0x4f, 0xfe,
+    0xc, 0xfe, 0x9f, 0xfc, 0xe9, 0xa9, 0xff, 0xcb,
+    0x9f, 0xf7, 0x1f, 0xe9, 0xff, 0xc1, 0x9f, 0xfc,
+    0xa9, 0xbf, 0x8d, 0x3f, 0xf9, 0xb3, 0xe9, 0xd3,
+    0xff, 0x8b, 0x34, 0xfe, 0x9a, 0x7f, 0xf1, 0x60,
 
     /* U+0052 "R" */
-    0x7f, 0xfc, 0x3f, 0xff, 0xcf, 0xff, 0xfb, 0xc0,
-    0x1f, 0xf0, 0x3, 0xfc, 0x0, 0xff, 0x0, 0x3f,
-    0xc0, 0x1f, 0xff, 0xff, 0xbf, 0xff, 0xcf, 0xff,
-    0xc3, 0xc7, 0xc0, 0xf1, 0xf8, 0x3c, 0x3f, 0xf,
-    0x7, 0xc3, 0xc0, 0xf8, 0xf0, 0x3f, 0x3c, 0x7,
-    0xcf, 0x0, 0xfb, 0xc0, 0x1e, 0x60, 0x7, 0x80,
+    0x7f, 0xfc, 0x13, 0x4f, 0xfe, 0xe, 0x3f, 0xf8,
+    0xd3, 0xbf, 0xe3, 0x4f, 0xfe, 0xc, 0xff, 0xf4,
+    0xcf, 0xdf, 0xf1, 0xa7, 0xff, 0x12, 0x7f, 0xf0,
+    0xf1, 0xee, 0x3b, 0x1f, 0xfc, 0x49, 0xff, 0xa7,
+    0x4f, 0xfd, 0x3f, 0xf8, 0xd3, 0x4f, 0xfe, 0x34,
+    0xff, 0xd3, 0xff, 0x8d, 0x34, 0xff, 0xe0, 0xce,
+    0x89, 0xff, 0xc2,
 
     /* U+0053 "S" */
-    0xf, 0xfc, 0xf, 0xff, 0xc7, 0xff, 0xfb, 0xe0,
-    0x1f, 0xf0, 0x3, 0xfc, 0x0, 0xff, 0x0, 0x3,
-    0xe0, 0x0, 0x7f, 0xfc, 0xf, 0xff, 0xc0, 0xff,
-    0xf8, 0x0, 0x1f, 0x0, 0x3, 0xc0, 0x0, 0xf6,
-    0x0, 0x3f, 0xc0, 0xf, 0xf0, 0x3, 0xfe, 0x1,
-    0xf7, 0xff, 0xf8, 0xff, 0xfc, 0xf, 0xfc, 0x0,
+    0x37, 0xfe, 0x3d, 0x8f, 0xf6, 0x29, 0xff, 0xc2,
+    0xa6, 0xff, 0x1a, 0x69, 0xfa, 0x7f, 0xf6, 0x3c,
+    0x69, 0xff, 0xc1, 0x9b, 0xfe, 0x3a, 0x7f, 0xec,
+    0x6c, 0x7f, 0xe9, 0xdf, 0xf1, 0xa7, 0xff, 0x6,
+    0x7f, 0xf2, 0xf1, 0xff, 0xc3, 0x89, 0xff, 0xd8,
+    0x9f, 0xa6, 0x9b, 0xfc, 0x6a, 0x7f, 0xf0, 0xa5,
+    0x8f, 0xf6, 0x0,
 
     /* U+0054 "T" */
-    0x7f, 0xff, 0xdf, 0xff, 0xfd, 0xff, 0xff, 0x0,
-    0xf0, 0x0, 0x1e, 0x0, 0x3, 0xc0, 0x0, 0x78,
-    0x0, 0xf, 0x0, 0x1, 0xe0, 0x0, 0x3c, 0x0,
-    0x7, 0x80, 0x0, 0xf0, 0x0, 0x1e, 0x0, 0x3,
-    0xc0, 0x0, 0x78, 0x0, 0xf, 0x0, 0x1, 0xe0,
-    0x0, 0x3c, 0x0, 0x7, 0x80, 0x0, 0xf0, 0x0,
-    0xc, 0x0,
-
-    /* U+0055 "U" */
-    0x60, 0x1, 0xbc, 0x0, 0xff, 0x0, 0x3f, 0xc0,
-    0xf, 0xf0, 0x3, 0xfc, 0x0, 0xff, 0x0, 0x3f,
-    0xc0, 0xf, 0xf0, 0x3, 0xfc, 0x0, 0xff, 0x0,
-    0x3f, 0xc0, 0xf, 0xf0, 0x3, 0xfc, 0x0, 0xff,
-    0x0, 0x3f, 0xc0, 0xf, 0xf0, 0x3, 0xfe, 0x1,
-    0xf7, 0xff, 0xf8, 0xff, 0xfc, 0xf, 0xfc, 0x0,
+    0x7f, 0xfc, 0x54, 0xff, 0xe2, 0xe3, 0xff, 0x8b,
+    0x7e, 0x37, 0xf1, 0xff, 0xff, 0x3f, 0xff, 0xe7,
+    0xff, 0xfc, 0xff, 0xff, 0x9f, 0xfa, 0x27, 0xe0,
 
-    /* U+0056 "V" */
-    0x70, 0x1, 0xde, 0x0, 0x7f, 0xe0, 0xf, 0xbc,
-    0x1, 0xe7, 0xc0, 0x7c, 0xf8, 0xf, 0xf, 0x83,
-    0xe1, 0xf0, 0x7c, 0x1e, 0xf, 0x3, 0xe3, 0xe0,
-    0x3c, 0x78, 0x7, 0xdf, 0x0, 0xfb, 0xe0, 0xf,
-    0x78, 0x1, 0xff, 0x0, 0x1f, 0xc0, 0x3, 0xf8,
-    0x0, 0x7f, 0x0, 0x7, 0xc0, 0x0, 0xf8, 0x0,
-    0xe, 0x0,
-
-    /* U+0057 "W" */
-    0x70, 0x38, 0x1f, 0xe0, 0xf8, 0x3f, 0xc1, 0xf0,
-    0x7f, 0xc7, 0xe1, 0xff, 0x8f, 0xe3, 0xef, 0x1f,
-    0xc7, 0x9e, 0x7f, 0x8f, 0x3c, 0xff, 0x9e, 0x79,
-    0xef, 0x3c, 0xf7, 0xdf, 0xf9, 0xff, 0x3f, 0xf3,
-    0xfe, 0x3f, 0xc3, 0xfc, 0x7f, 0x87, 0xf0, 0x7f,
-    0xf, 0xe0, 0xfe, 0x1f, 0x81, 0xfc, 0x3f, 0x1,
-    0xf8, 0x7e, 0x3, 0xe0, 0x78, 0x3, 0xc0, 0xf0,
-    0x7, 0x81, 0xc0, 0x6, 0x0,
-
-    /* U+0058 "X" */
-    0x70, 0x3, 0xbe, 0x1, 0xff, 0x80, 0xfd, 0xf0,
-    0x3e, 0x3e, 0x1f, 0x7, 0xcf, 0x81, 0xff, 0xc0,
-    0x3f, 0xf0, 0x7, 0xf8, 0x0, 0xfc, 0x0, 0x3f,
-    0x0, 0x1f, 0xc0, 0x7, 0xf8, 0x3, 0xff, 0x1,
-    0xf3, 0xe0, 0xfc, 0xf8, 0x3e, 0x1f, 0x1f, 0x3,
-    0xef, 0x80, 0x7f, 0xe0, 0x1f, 0x70, 0x3, 0x80,
-
-    /* U+0059 "Y" */
-    0x70, 0x3, 0xbe, 0x1, 0xf7, 0xc0, 0xfd, 0xf0,
-    0x3e, 0x3e, 0x1f, 0x7, 0xcf, 0x80, 0xff, 0xc0,
-    0x3f, 0xf0, 0x7, 0xf8, 0x0, 0xfc, 0x0, 0x1e,
-    0x0, 0x7, 0x80, 0x1, 0xe0, 0x0, 0x78, 0x0,
-    0x1e, 0x0, 0x7, 0x80, 0x1, 0xe0, 0x0, 0x78,
-    0x0, 0x1e, 0x0, 0x7, 0x80, 0x0, 0xc0, 0x0,
-
-    /* U+005A "Z" */
-    0xff, 0xff, 0xdf, 0xff, 0xff, 0xff, 0xff, 0x80,
-    0x7, 0xe0, 0x0, 0xf8, 0x0, 0x3e, 0x0, 0xf,
-    0xc0, 0x3, 0xf0, 0x0, 0xfc, 0x0, 0x1f, 0x0,
-    0x7, 0xc0, 0x1, 0xf8, 0x0, 0x7e, 0x0, 0x1f,
-    0x80, 0x7, 0xe0, 0x0, 0xf8, 0x0, 0x3e, 0x0,
-    0xf, 0xc0, 0x3, 0xff, 0xff, 0xff, 0xff, 0xf7,
-    0xff, 0xfe,
-
-    /* U+005B "[" */
-    0xff, 0xff, 0xff, 0x8f, 0x1e, 0x3c, 0x78, 0xf1,
-    0xe3, 0xc7, 0x8f, 0x1e, 0x3c, 0x78, 0xf1, 0xe3,
-    0xc7, 0x8f, 0xff, 0xff, 0x80,
-
-    /* U+005C "\\" */
-    0xe0, 0xe, 0x0, 0xf0, 0x7, 0x0, 0x78, 0x7,
-    0x80, 0x38, 0x3, 0xc0, 0x1c, 0x1, 0xe0, 0xe,
-    0x0, 0xf0, 0xf, 0x0, 0x70, 0x7, 0x80, 0x38,
-    0x3, 0xc0, 0x3c, 0x1, 0xc0, 0x1e, 0x0, 0xe0,
-    0xe, 0x0, 0x60,
-
-    /* U+005D "]" */
-    0xff, 0xff, 0xff, 0xf, 0xf, 0xf, 0xf, 0xf,
-    0xf, 0xf, 0xf, 0xf, 0xf, 0xf, 0xf, 0xf,
-    0xf, 0xf, 0xf, 0xf, 0xff, 0xff, 0xff,
-
-    /* U+005E "^" */
-    0x18, 0x79, 0xf3, 0xfe, 0xec, 0xc0,
-
-    /* U+005F "_" */
-    0xff, 0xff, 0xff, 0xff, 0xfe,
-
-    /* U+0060 "`" */
-    0x7, 0x3d, 0xe7, 0xbc, 0xe0,
-
-    /* U+0061 "a" */
-    0x7f, 0xfc, 0x3f, 0xff, 0x9f, 0xff, 0xe0, 0x0,
-    0xf0, 0x0, 0x78, 0x7f, 0xfd, 0xff, 0xff, 0xff,
-    0xff, 0xf0, 0x7, 0xf8, 0x3, 0xfc, 0x1, 0xfe,
-    0x0, 0xff, 0x0, 0x7f, 0xff, 0xfd, 0xff, 0xfc,
-    0x3f, 0xf8,
-
-    /* U+0062 "b" */
-    0xe0, 0x0, 0x78, 0x0, 0x3c, 0x0, 0x1e, 0x0,
-    0xf, 0x0, 0x7, 0xff, 0xc3, 0xff, 0xfd, 0xff,
-    0xff, 0xf0, 0x7, 0xf8, 0x3, 0xfc, 0x1, 0xfe,
-    0x0, 0xff, 0x0, 0x7f, 0x80, 0x3f, 0xc0, 0x1f,
-    0xe0, 0xf, 0xf0, 0x7, 0xf8, 0x3, 0xff, 0xff,
-    0xff, 0xff, 0xe7, 0xff, 0xc0,
-
-    /* U+0063 "c" */
-    0x1f, 0xfc, 0x3f, 0xff, 0xbf, 0xff, 0xfe, 0x0,
-    0xff, 0x0, 0x7f, 0x80, 0x3, 0xc0, 0x1, 0xe0,
-    0x0, 0xf0, 0x0, 0x78, 0x0, 0x3c, 0x0, 0x9e,
-    0x0, 0xff, 0x0, 0x7f, 0xff, 0xfd, 0xff, 0xfc,
-    0x3f, 0xf8,
-
-    /* U+0064 "d" */
-    0x0, 0x3, 0x0, 0x3, 0xc0, 0x1, 0xe0, 0x0,
-    0xf0, 0x0, 0x78, 0x7f, 0xfd, 0xff, 0xff, 0xff,
-    0xff, 0xf0, 0x7, 0xf8, 0x3, 0xfc, 0x1, 0xfe,
-    0x0, 0xff, 0x0, 0x7f, 0x80, 0x3f, 0xc0, 0x1f,
-    0xe0, 0xf, 0xf0, 0x7, 0xf8, 0x3, 0xff, 0xff,
-    0xef, 0xff, 0xf1, 0xff, 0xf0,
-
-    /* U+0065 "e" */
-    0x1f, 0xfc, 0x3f, 0xff, 0x3f, 0xff, 0xde, 0x0,
-    0xff, 0x0, 0x7f, 0x80, 0x3f, 0xc0, 0x1f, 0xff,
-    0xfe, 0xff, 0xfe, 0x7f, 0xfe, 0x3c, 0x0, 0x1e,
-    0x0, 0xff, 0x0, 0x7f, 0xff, 0xfd, 0xff, 0xfc,
-    0x3f, 0xf8,
-
-    /* U+0066 "f" */
-    0x3, 0xfe, 0xf, 0xff, 0x1f, 0xfe, 0x3f, 0x0,
-    0x3e, 0x0, 0x3e, 0x0, 0x3e, 0x0, 0xff, 0xfe,
-    0xff, 0xff, 0xff, 0xfe, 0x3e, 0x0, 0x3e, 0x0,
-    0x3e, 0x0, 0x3e, 0x0, 0x3e, 0x0, 0x3e, 0x0,
-    0x3e, 0x0, 0x3e, 0x0, 0x3e, 0x0, 0x3e, 0x0,
-    0x1c, 0x0,
-
-    /* U+0067 "g" */
-    0x1f, 0xff, 0x3f, 0xff, 0xff, 0xff, 0xfe, 0x0,
-    0xff, 0x0, 0x7f, 0x80, 0x3f, 0xc0, 0x1f, 0xe0,
-    0xf, 0xf0, 0x7, 0xf8, 0x3, 0xfc, 0x1, 0xfe,
-    0x0, 0xff, 0x0, 0x7f, 0xff, 0xfd, 0xff, 0xfe,
-    0x1f, 0xff, 0x0, 0x7, 0xbc, 0x3, 0xde, 0x1,
-    0xef, 0xff, 0xf3, 0xff, 0xf0, 0x7f, 0xc0,
-
-    /* U+0068 "h" */
-    0x60, 0x0, 0x78, 0x0, 0x3c, 0x0, 0x1e, 0x0,
-    0xf, 0x0, 0x7, 0xff, 0xc3, 0xff, 0xfd, 0xff,
-    0xfe, 0xf0, 0x7, 0xf8, 0x3, 0xfc, 0x1, 0xfe,
-    0x0, 0xff, 0x0, 0x7f, 0x80, 0x3f, 0xc0, 0x1f,
-    0xe0, 0xf, 0xf0, 0x7, 0xf8, 0x3, 0xfc, 0x1,
-    0xfe, 0x0, 0xf6, 0x0, 0x30,
-
-    /* U+0069 "i" */
-    0xff, 0xf0, 0x6, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0x60,
-
-    /* U+006A "j" */
-    0x3, 0x81, 0xf0, 0x38, 0x0, 0x0, 0x0, 0xe0,
-    0x7c, 0x1f, 0x7, 0xc1, 0xf0, 0x7c, 0x1f, 0x7,
-    0xc1, 0xf0, 0x7c, 0x1f, 0x7, 0xc1, 0xf0, 0x7c,
-    0x1f, 0x7, 0xc1, 0xf0, 0x7c, 0x1f, 0x7f, 0xff,
-    0xc7, 0xc0,
-
-    /* U+006B "k" */
-    0x60, 0x0, 0x78, 0x0, 0x3c, 0x0, 0x1e, 0x0,
-    0xf, 0x0, 0x7, 0x80, 0x3b, 0xc0, 0x3f, 0xe0,
-    0x7f, 0xf0, 0xfe, 0x78, 0xfe, 0x3d, 0xfc, 0x1f,
-    0xfc, 0xf, 0xfc, 0x7, 0xff, 0x3, 0xff, 0xc1,
-    0xe3, 0xf0, 0xf0, 0x7c, 0x78, 0x1f, 0x3c, 0x7,
-    0xde, 0x1, 0xf6, 0x0, 0x70,
-
-    /* U+006C "l" */
-    0x6f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0x60,
-
-    /* U+006D "m" */
-    0x1f, 0xcf, 0xe1, 0xff, 0xff, 0xef, 0xff, 0xff,
-    0xfc, 0x1e, 0xf, 0xf0, 0x78, 0x3f, 0xc1, 0xe0,
-    0xff, 0x7, 0x83, 0xfc, 0x1e, 0xf, 0xf0, 0x78,
-    0x3f, 0xc1, 0xe0, 0xff, 0x7, 0x83, 0xfc, 0x1e,
-    0xf, 0xf0, 0x78, 0x3f, 0xc1, 0xe0, 0xff, 0x7,
-    0x83, 0xd8, 0xc, 0x6,
-
-    /* U+006E "n" */
-    0x1f, 0xfc, 0x1f, 0xff, 0xef, 0xff, 0xff, 0xc0,
-    0xf, 0xf0, 0x3, 0xfc, 0x0, 0xff, 0x0, 0x3f,
-    0xc0, 0xf, 0xf0, 0x3, 0xfc, 0x0, 0xff, 0x0,
-    0x3f, 0xc0, 0xf, 0xf0, 0x3, 0xfc, 0x0, 0xff,
-    0x0, 0x3d, 0x80, 0x6,
-
-    /* U+006F "o" */
-    0x1f, 0xfe, 0x1f, 0xff, 0xef, 0xff, 0xff, 0xc0,
-    0xf, 0xf0, 0x3, 0xfc, 0x0, 0xff, 0x0, 0x3f,
-    0xc0, 0xf, 0xf0, 0x3, 0xfc, 0x0, 0xff, 0x0,
-    0x3f, 0xc0, 0xf, 0xf0, 0x3, 0xff, 0xff, 0xf7,
-    0xff, 0xf8, 0x7f, 0xf8,
-
-    /* U+0070 "p" */
-    0x7f, 0xfc, 0x7f, 0xff, 0xbf, 0xff, 0xfe, 0x0,
-    0xff, 0x0, 0x7f, 0x80, 0x3f, 0xc0, 0x1f, 0xe0,
-    0xf, 0xf0, 0x7, 0xf8, 0x3, 0xfc, 0x1, 0xfe,
-    0x0, 0xff, 0x0, 0x7f, 0xff, 0xff, 0xff, 0xfd,
-    0xff, 0xf0, 0xf0, 0x0, 0x78, 0x0, 0x3c, 0x0,
-    0x1e, 0x0, 0xf, 0x0, 0x3, 0x0, 0x0,
-
-    /* U+0071 "q" */
-    0xf, 0xff, 0x3f, 0xff, 0xff, 0xff, 0xfe, 0x0,
-    0xff, 0x0, 0x7f, 0x80, 0x3f, 0xc0, 0x1f, 0xe0,
-    0xf, 0xf0, 0x7, 0xf8, 0x3, 0xfc, 0x1, 0xfe,
-    0x0, 0xff, 0x0, 0x7f, 0xff, 0xfd, 0xff, 0xfe,
-    0x3f, 0xff, 0x0, 0x7, 0x80, 0x3, 0xc0, 0x1,
-    0xe0, 0x0, 0xf0, 0x0, 0x78, 0x0, 0x18,
-
-    /* U+0072 "r" */
-    0x7f, 0xfe, 0xff, 0xff, 0xff, 0xfe, 0xf8, 0x0,
-    0xf8, 0x0, 0xf8, 0x0, 0xf8, 0x0, 0xf8, 0x0,
-    0xf8, 0x0, 0xf8, 0x0, 0xf8, 0x0, 0xf8, 0x0,
-    0xf8, 0x0, 0xf8, 0x0, 0xf8, 0x0, 0x70, 0x0,
-
-    /* U+0073 "s" */
-    0x1f, 0xfe, 0x1f, 0xff, 0xef, 0xff, 0xff, 0xc0,
-    0xf, 0xf0, 0x3, 0xfc, 0x0, 0xf, 0xff, 0xe1,
-    0xff, 0xfe, 0x1f, 0xff, 0x80, 0x0, 0xf6, 0x0,
-    0x3f, 0xc0, 0xf, 0xf0, 0x3, 0xdf, 0xff, 0xe7,
-    0xff, 0xf8, 0x7f, 0xf8,
-
-    /* U+0074 "t" */
-    0x3, 0x80, 0xf, 0x80, 0x1f, 0x0, 0x3e, 0x0,
-    0x7c, 0xf, 0xff, 0xbf, 0xff, 0xbf, 0xfe, 0x7,
-    0xc0, 0xf, 0x80, 0x1f, 0x0, 0x3e, 0x0, 0x7c,
-    0x0, 0xf8, 0x1, 0xf0, 0x3, 0xe0, 0x7, 0xc0,
-    0xf, 0x80, 0xf, 0xf0, 0xf, 0xe0, 0x7, 0xc0,
-
-    /* U+0075 "u" */
-    0x60, 0x1, 0xbc, 0x0, 0xff, 0x0, 0x3f, 0xc0,
-    0xf, 0xf0, 0x3, 0xfc, 0x0, 0xff, 0x0, 0x3f,
-    0xc0, 0xf, 0xf0, 0x3, 0xfc, 0x0, 0xff, 0x0,
-    0x3f, 0xc0, 0xf, 0xf0, 0x3, 0xff, 0xff, 0xf7,
-    0xff, 0xf8, 0x7f, 0xf8,
-
-    /* U+0076 "v" */
-    0x70, 0x1, 0xde, 0x0, 0x7f, 0xe0, 0xf, 0xbe,
-    0x3, 0xe7, 0xc0, 0x78, 0x7c, 0x1f, 0x7, 0x87,
-    0xc0, 0xf8, 0xf8, 0xf, 0x3e, 0x1, 0xf7, 0xc0,
-    0x1f, 0xf0, 0x3, 0xfc, 0x0, 0x3f, 0x80, 0x3,
-    0xe0, 0x0, 0x7c, 0x0, 0x7, 0x0,
-
-    /* U+0077 "w" */
-    0x60, 0x30, 0x1b, 0xc1, 0xe0, 0xff, 0x7, 0x83,
-    0xfc, 0x1e, 0xf, 0xf0, 0x78, 0x3f, 0xc1, 0xe0,
-    0xff, 0x7, 0x83, 0xfc, 0x1e, 0xf, 0xf0, 0x78,
-    0x3f, 0xc1, 0xe0, 0xff, 0x7, 0x83, 0xfc, 0x1e,
-    0xf, 0xf0, 0x78, 0x3f, 0xff, 0xff, 0xf7, 0xff,
-    0xff, 0x87, 0xf3, 0xf8,
-
-    /* U+0078 "x" */
-    0x70, 0x7, 0x7c, 0x7, 0xff, 0x7, 0xef, 0xc7,
-    0xe3, 0xf7, 0xe0, 0xff, 0xe0, 0x3f, 0xe0, 0xf,
-    0xe0, 0x7, 0xf0, 0x7, 0xfc, 0x7, 0xff, 0x7,
-    0xef, 0xc7, 0xe3, 0xf7, 0xe0, 0xff, 0xe0, 0x3e,
-    0xe0, 0xe,
-
-    /* U+0079 "y" */
-    0x60, 0x3, 0x78, 0x3, 0xfc, 0x1, 0xfe, 0x0,
-    0xff, 0x0, 0x7f, 0x80, 0x3f, 0xc0, 0x1f, 0xe0,
-    0xf, 0xf0, 0x7, 0xf8, 0x3, 0xfc, 0x1, 0xfe,
-    0x0, 0xff, 0x0, 0x7f, 0xff, 0xfd, 0xff, 0xfe,
-    0x3f, 0xff, 0x0, 0x7, 0xbc, 0x3, 0xde, 0x1,
-    0xef, 0xff, 0xf3, 0xff, 0xf0, 0x7f, 0xe0,
-
-    /* U+007A "z" */
-    0x1f, 0xfe, 0x1f, 0xff, 0xef, 0xff, 0xff, 0xc0,
-    0xf, 0xf0, 0x3, 0xd0, 0x0, 0xf1, 0xff, 0xfd,
-    0xff, 0xfe, 0xff, 0xfe, 0x3c, 0x0, 0xf, 0x0,
-    0x1b, 0xc0, 0xf, 0xf0, 0x3, 0xff, 0xff, 0xe7,
-    0xff, 0xf0, 0x7f, 0xf8,
-
-    /* U+007B "{" */
-    0xf, 0xe1, 0xfc, 0x3f, 0x87, 0x80, 0xf0, 0x1e,
-    0x3, 0xc0, 0x78, 0xf, 0x7, 0xe1, 0xfc, 0x3f,
-    0x7, 0xf0, 0x3e, 0x3, 0xc0, 0x78, 0xf, 0x1,
-    0xe0, 0x3c, 0x7, 0x80, 0xfe, 0x1f, 0xc3, 0xf8,
-
-    /* U+007C "|" */
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff,
-
-    /* U+007D "}" */
-    0xff, 0x1f, 0xe3, 0xfc, 0x7, 0x80, 0xf0, 0x1e,
-    0x3, 0xc0, 0x78, 0xf, 0x1, 0xf0, 0x3f, 0x3,
-    0xe0, 0xfc, 0x1f, 0x3, 0xc0, 0x78, 0xf, 0x1,
-    0xe0, 0x3c, 0x7, 0x8f, 0xf1, 0xfe, 0x3f, 0xc0,
-
-    /* U+007E "~" */
-    0x1e, 0x0, 0xfe, 0x1f, 0xff, 0x7f, 0xff, 0xfe,
-    0x3f, 0xc8, 0x1f, 0x0
+    /* decoder read-ahead */
+    0x0
 };
 
 
@@ -662,100 +66,10 @@ static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {
 static const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {
     {.bitmap_index = 0, .adv_w = 0, .box_w = 0, .box_h = 0, .ofs_x = 0, .ofs_y = 0} /* id = 0 reserved */,
     {.bitmap_index = 0, .adv_w = 152, .box_w = 1, .box_h = 1, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 1, .adv_w = 83, .box_w = 4, .box_h = 20, .ofs_x = 1, .ofs_y = 1},
-    {.bitmap_index = 11, .adv_w = 140, .box_w = 7, .box_h = 5, .ofs_x = 1, .ofs_y = 17},
-    {.bitmap_index = 16, .adv_w = 285, .box_w = 16, .box_h = 16, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 48, .adv_w = 239, .box_w = 13, .box_h = 25, .ofs_x = 1, .ofs_y = -2},
-    {.bitmap_index = 89, .adv_w = 287, .box_w = 16, .box_h = 24, .ofs_x = 1, .ofs_y = -2},
-    {.bitmap_index = 137, .adv_w = 274, .box_w = 16, .box_h = 21, .ofs_x = 1, .ofs_y = 0},
-    {.bitmap_index = 179, .adv_w = 83, .box_w = 3, .box_h = 5, .ofs_x = 1, .ofs_y = 17},
-    {.bitmap_index = 181, .adv_w = 137, .box_w = 7, .box_h = 23, .ofs_x = 1, .ofs_y = -2},
-    {.bitmap_index = 202, .adv_w = 137, .box_w = 8, .box_h = 23, .ofs_x = 0, .ofs_y = -2},
-    {.bitmap_index = 225, .adv_w = 231, .box_w = 13, .box_h = 16, .ofs_x = 0, .ofs_y = 2},
-    {.bitmap_index = 251, .adv_w = 285, .box_w = 16, .box_h = 16, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 283, .adv_w = 83, .box_w = 3, .box_h = 5, .ofs_x = 1, .ofs_y = -2},
-    {.bitmap_index = 285, .adv_w = 213, .box_w = 11, .box_h = 3, .ofs_x = 1, .ofs_y = 7},
-    {.bitmap_index = 290, .adv_w = 83, .box_w = 4, .box_h = 3, .ofs_x = 1, .ofs_y = -1},
-    {.bitmap_index = 292, .adv_w = 214, .box_w = 11, .box_h = 23, .ofs_x = 1, .ofs_y = -1},
-    {.bitmap_index = 324, .adv_w = 296, .box_w = 17, .box_h = 20, .ofs_x = 1, .ofs_y = 0},
-    {.bitmap_index = 367, .adv_w = 192, .box_w = 11, .box_h = 21, .ofs_x = 1, .ofs_y = 0},
-    {.bitmap_index = 396, .adv_w = 295, .box_w = 17, .box_h = 21, .ofs_x = 1, .ofs_y = 0},
-    {.bitmap_index = 441, .adv_w = 280, .box_w = 16, .box_h = 21, .ofs_x = 1, .ofs_y = 0},
-    {.bitmap_index = 483, .adv_w = 289, .box_w = 17, .box_h = 21, .ofs_x = 1, .ofs_y = 0},
-    {.bitmap_index = 528, .adv_w = 271, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 0},
-    {.bitmap_index = 568, .adv_w = 267, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 0},
-    {.bitmap_index = 608, .adv_w = 250, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 0},
-    {.bitmap_index = 648, .adv_w = 281, .box_w = 16, .box_h = 21, .ofs_x = 1, .ofs_y = 0},
-    {.bitmap_index = 690, .adv_w = 266, .box_w = 15, .box_h = 21, .ofs_x = 1, .ofs_y = 0},
-    {.bitmap_index = 730, .adv_w = 84, .box_w = 4, .box_h = 7, .ofs_x = 1, .ofs_y = 6},
-    {.bitmap_index = 734, .adv_w = 85, .box_w = 3, .box_h = 9, .ofs_x = 1, .ofs_y = 4},
-    {.bitmap_index = 738, .adv_w = 193, .box_w = 10, .box_h = 15, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 757, .adv_w = 213, .box_w = 11, .box_h = 9, .ofs_x = 1, .ofs_y = 5},
-    {.bitmap_index = 770, .adv_w = 193, .box_w = 10, .box_h = 15, .ofs_x = 1, .ofs_y = 2},
-    {.bitmap_index = 789, .adv_w = 217, .box_w = 12, .box_h = 21, .ofs_x = 1, .ofs_y = 0},
-    {.bitmap_index = 821, .adv_w = 342, .box_w = 20, .box_h = 19, .ofs_x = 1, .ofs_y = 0},
-    {.bitmap_index = 869, .adv_w = 327, .box_w = 19, .box_h = 21, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 919, .adv_w = 315, .box_w = 18, .box_h = 21, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 967, .adv_w = 317, .box_w = 18, .box_h = 21, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 1015, .adv_w = 334, .box_w = 19, .box_h = 21, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 1065, .adv_w = 316, .box_w = 18, .box_h = 21, .ofs_x = 1, .ofs_y = 0},
-    {.bitmap_index = 1113, .adv_w = 297, .box_w = 17, .box_h = 21, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 1158, .adv_w = 319, .box_w = 18, .box_h = 21, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 1206, .adv_w = 316, .box_w = 18, .box_h = 21, .ofs_x = 1, .ofs_y = 0},
-    {.bitmap_index = 1254, .adv_w = 100, .box_w = 5, .box_h = 21, .ofs_x = 1, .ofs_y = 0},
-    {.bitmap_index = 1268, .adv_w = 280, .box_w = 16, .box_h = 21, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 1310, .adv_w = 295, .box_w = 17, .box_h = 21, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 1355, .adv_w = 281, .box_w = 16, .box_h = 21, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 1397, .adv_w = 383, .box_w = 22, .box_h = 21, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 1455, .adv_w = 317, .box_w = 18, .box_h = 21, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 1503, .adv_w = 317, .box_w = 18, .box_h = 21, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 1551, .adv_w = 311, .box_w = 18, .box_h = 21, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 1599, .adv_w = 335, .box_w = 20, .box_h = 23, .ofs_x = 0, .ofs_y = -2},
-    {.bitmap_index = 1657, .adv_w = 314, .box_w = 18, .box_h = 21, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 1705, .adv_w = 320, .box_w = 18, .box_h = 21, .ofs_x = 1, .ofs_y = 0},
-    {.bitmap_index = 1753, .adv_w = 323, .box_w = 19, .box_h = 21, .ofs_x = 1, .ofs_y = 0},
-    {.bitmap_index = 1803, .adv_w = 319, .box_w = 18, .box_h = 21, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 1851, .adv_w = 322, .box_w = 19, .box_h = 21, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 1901, .adv_w = 385, .box_w = 23, .box_h = 21, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 1962, .adv_w = 308, .box_w = 18, .box_h = 21, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 2010, .adv_w = 310, .box_w = 18, .box_h = 21, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 2058, .adv_w = 319, .box_w = 19, .box_h = 21, .ofs_x = 1, .ofs_y = 0},
-    {.bitmap_index = 2108, .adv_w = 144, .box_w = 7, .box_h = 23, .ofs_x = 1, .ofs_y = -2},
-    {.bitmap_index = 2129, .adv_w = 214, .box_w = 12, .box_h = 23, .ofs_x = 1, .ofs_y = -1},
-    {.bitmap_index = 2164, .adv_w = 144, .box_w = 8, .box_h = 23, .ofs_x = 1, .ofs_y = -2},
-    {.bitmap_index = 2187, .adv_w = 135, .box_w = 7, .box_h = 6, .ofs_x = 0, .ofs_y = 17},
-    {.bitmap_index = 2193, .adv_w = 239, .box_w = 13, .box_h = 3, .ofs_x = 1, .ofs_y = -2},
-    {.bitmap_index = 2198, .adv_w = 107, .box_w = 5, .box_h = 7, .ofs_x = 1, .ofs_y = 16},
-    {.bitmap_index = 2203, .adv_w = 294, .box_w = 17, .box_h = 16, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 2237, .adv_w = 295, .box_w = 17, .box_h = 21, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 2282, .adv_w = 302, .box_w = 17, .box_h = 16, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 2316, .adv_w = 296, .box_w = 17, .box_h = 21, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 2361, .adv_w = 306, .box_w = 17, .box_h = 16, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 2395, .adv_w = 276, .box_w = 16, .box_h = 21, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 2437, .adv_w = 295, .box_w = 17, .box_h = 22, .ofs_x = 1, .ofs_y = -6},
-    {.bitmap_index = 2484, .adv_w = 300, .box_w = 17, .box_h = 21, .ofs_x = 1, .ofs_y = 0},
-    {.bitmap_index = 2529, .adv_w = 95, .box_w = 4, .box_h = 21, .ofs_x = 1, .ofs_y = 0},
-    {.bitmap_index = 2540, .adv_w = 175, .box_w = 10, .box_h = 27, .ofs_x = 0, .ofs_y = -6},
-    {.bitmap_index = 2574, .adv_w = 302, .box_w = 17, .box_h = 21, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 2619, .adv_w = 92, .box_w = 4, .box_h = 21, .ofs_x = 1, .ofs_y = 0},
-    {.bitmap_index = 2630, .adv_w = 380, .box_w = 22, .box_h = 16, .ofs_x = 1, .ofs_y = 0},
-    {.bitmap_index = 2674, .adv_w = 312, .box_w = 18, .box_h = 16, .ofs_x = 1, .ofs_y = 0},
-    {.bitmap_index = 2710, .adv_w = 315, .box_w = 18, .box_h = 16, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 2746, .adv_w = 295, .box_w = 17, .box_h = 22, .ofs_x = 1, .ofs_y = -6},
-    {.bitmap_index = 2793, .adv_w = 295, .box_w = 17, .box_h = 22, .ofs_x = 1, .ofs_y = -6},
-    {.bitmap_index = 2840, .adv_w = 269, .box_w = 16, .box_h = 16, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 2872, .adv_w = 319, .box_w = 18, .box_h = 16, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 2908, .adv_w = 262, .box_w = 15, .box_h = 21, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 2948, .adv_w = 314, .box_w = 18, .box_h = 16, .ofs_x = 1, .ofs_y = 0},
-    {.bitmap_index = 2984, .adv_w = 323, .box_w = 19, .box_h = 16, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 3022, .adv_w = 382, .box_w = 22, .box_h = 16, .ofs_x = 1, .ofs_y = 0},
-    {.bitmap_index = 3066, .adv_w = 299, .box_w = 17, .box_h = 16, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 3100, .adv_w = 295, .box_w = 17, .box_h = 22, .ofs_x = 0, .ofs_y = -6},
-    {.bitmap_index = 3147, .adv_w = 319, .box_w = 18, .box_h = 16, .ofs_x = 0, .ofs_y = 0},
-    {.bitmap_index = 3183, .adv_w = 197, .box_w = 11, .box_h = 23, .ofs_x = 0, .ofs_y = -2},
-    {.bitmap_index = 3215, .adv_w = 84, .box_w = 3, .box_h = 24, .ofs_x = 1, .ofs_y = -3},
-    {.bitmap_index = 3224, .adv_w = 197, .box_w = 11, .box_h = 23, .ofs_x = 1, .ofs_y = -2},
-    {.bitmap_index = 3256, .adv_w = 278, .box_w = 15, .box_h = 6, .ofs_x = 1, .ofs_y = 6}
+    {.bitmap_index = 1, .adv_w = 327, .box_w = 19, .box_h = 21, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 49, .adv_w = 314, .box_w = 18, .box_h = 21, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 100, .adv_w = 320, .box_w = 18, .box_h = 21, .ofs_x = 1, .ofs_y = 0},
+    {.bitmap_index = 151, .adv_w = 323, .box_w = 19, .box_h = 21, .ofs_x = 1, .ofs_y = 0}
 };
 
 /*---------------------
@@ -768,11 +82,20 @@ static const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {
 static const lv_font_fmt_txt_cmap_t cmaps[] =
 {
     {
-        .range_start = 32, .range_length = 95, .glyph_id_start = 1,
+        .range_start = 32, .range_length = 1, .glyph_id_start = 1,
+        .unicode_list = NULL, .glyph_id_ofs_list = NULL, .list_length = 0, .type = LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY
+    },
+    {
+        .range_start = 65, .range_length = 1, .glyph_id_start = 2,
+        .unicode_list = NULL, .glyph_id_ofs_list = NULL, .list_length = 0, .type = LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY
+    },
+    {
+        .range_start = 82, .range_length = 3, .glyph_id_start = 3,
         .unicode_list = NULL, .glyph_id_ofs_list = NULL, .list_length = 0, .type = LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY
     }
 };
 
+
 /*-----------------
  *    KERNING
  *----------------*/
@@ -781,405 +104,23 @@ static const lv_font_fmt_txt_cmap_t cmaps[] =
 /*Pair left and right glyphs for kerning*/
 static const uint8_t kern_pair_glyph_ids[] =
 {
-    17, 18,
-    17, 19,
-    17, 20,
-    17, 22,
-    17, 23,
-    17, 24,
-    17, 25,
-    17, 26,
-    18, 17,
-    18, 19,
-    18, 20,
-    18, 22,
-    18, 23,
-    18, 24,
-    18, 25,
-    18, 26,
-    19, 17,
-    19, 21,
-    19, 22,
-    19, 23,
-    19, 24,
-    19, 25,
-    19, 26,
-    20, 17,
-    20, 18,
-    20, 19,
-    20, 21,
-    20, 22,
-    20, 24,
-    20, 25,
-    21, 17,
-    21, 18,
-    21, 19,
-    21, 20,
-    21, 21,
-    21, 22,
-    21, 23,
-    21, 24,
-    21, 25,
-    21, 26,
-    22, 18,
-    22, 19,
-    22, 24,
-    22, 26,
-    23, 17,
-    23, 18,
-    23, 19,
-    23, 21,
-    23, 24,
-    23, 26,
-    24, 17,
-    24, 18,
-    24, 19,
-    24, 20,
-    24, 21,
-    24, 22,
-    24, 23,
-    24, 25,
-    24, 26,
-    25, 18,
-    25, 19,
-    25, 23,
-    25, 24,
-    25, 26,
-    26, 17,
-    26, 18,
-    26, 21,
-    26, 22,
-    26, 23,
-    26, 24,
-    26, 25,
-    26, 26,
-    34, 34,
-    34, 36,
-    34, 38,
-    34, 39,
-    34, 43,
-    34, 48,
-    34, 50,
-    34, 52,
-    34, 53,
-    34, 54,
-    34, 55,
-    34, 56,
-    34, 58,
-    34, 68,
-    34, 71,
-    34, 75,
-    34, 84,
-    34, 85,
-    34, 86,
-    34, 87,
-    34, 88,
-    34, 90,
-    34, 91,
-    35, 34,
-    35, 53,
-    35, 55,
-    35, 58,
-    35, 75,
-    36, 53,
-    36, 58,
-    36, 75,
-    37, 34,
-    37, 43,
-    37, 53,
-    37, 55,
-    37, 56,
-    37, 58,
-    37, 75,
-    38, 55,
-    38, 75,
-    39, 34,
-    39, 43,
-    39, 55,
-    39, 75,
-    40, 55,
-    40, 58,
-    40, 75,
-    41, 75,
-    42, 75,
-    43, 71,
-    43, 75,
-    43, 85,
-    44, 43,
-    44, 75,
-    45, 34,
-    45, 35,
-    45, 36,
-    45, 37,
-    45, 38,
-    45, 39,
-    45, 40,
-    45, 43,
-    45, 48,
-    45, 49,
-    45, 50,
-    45, 52,
-    45, 53,
-    45, 54,
-    45, 55,
-    45, 56,
-    45, 58,
-    45, 59,
-    45, 66,
-    45, 68,
-    45, 69,
-    45, 70,
-    45, 71,
-    45, 75,
-    45, 85,
-    45, 86,
-    45, 87,
-    45, 88,
-    45, 89,
-    45, 90,
-    45, 91,
-    46, 75,
-    47, 75,
-    48, 53,
-    48, 75,
-    49, 34,
-    49, 36,
-    49, 43,
-    49, 53,
-    49, 55,
-    49, 56,
-    49, 57,
-    49, 58,
-    49, 59,
-    49, 66,
-    49, 68,
-    49, 69,
-    49, 70,
-    49, 71,
-    49, 72,
-    49, 73,
-    49, 74,
-    49, 75,
-    49, 79,
-    49, 80,
-    49, 81,
-    49, 82,
-    49, 83,
-    49, 84,
-    49, 85,
-    49, 86,
-    49, 87,
-    49, 88,
-    49, 89,
-    49, 90,
-    49, 91,
-    50, 53,
-    50, 55,
-    50, 56,
-    50, 58,
-    50, 75,
-    51, 34,
-    51, 43,
-    51, 53,
-    51, 55,
-    51, 58,
-    51, 75,
-    52, 53,
-    52, 55,
-    52, 58,
-    52, 75,
-    53, 34,
-    53, 36,
-    53, 40,
-    53, 43,
-    53, 48,
-    53, 50,
-    53, 52,
-    53, 53,
-    53, 66,
-    53, 68,
-    53, 69,
-    53, 70,
-    53, 71,
-    53, 72,
-    53, 75,
-    53, 78,
-    53, 79,
-    53, 80,
-    53, 81,
-    53, 82,
-    53, 83,
-    53, 84,
-    53, 85,
-    53, 86,
-    53, 87,
-    53, 88,
-    53, 89,
-    53, 90,
-    53, 91,
-    54, 75,
-    55, 34,
-    55, 36,
-    55, 38,
-    55, 40,
-    55, 42,
-    55, 43,
-    55, 44,
-    55, 48,
-    55, 50,
-    55, 52,
-    55, 53,
-    55, 58,
-    55, 59,
-    55, 66,
-    55, 67,
-    55, 68,
-    55, 69,
-    55, 70,
-    55, 71,
-    55, 72,
-    55, 75,
-    55, 78,
-    55, 79,
-    55, 80,
-    55, 81,
-    55, 82,
-    55, 83,
-    55, 84,
-    55, 85,
-    55, 86,
-    55, 87,
-    55, 88,
-    55, 89,
-    55, 90,
-    55, 91,
-    56, 34,
-    56, 43,
-    56, 53,
-    56, 66,
-    56, 68,
-    56, 69,
-    56, 70,
-    56, 71,
-    56, 72,
-    56, 75,
-    56, 78,
-    56, 79,
-    56, 80,
-    56, 81,
-    56, 82,
-    56, 83,
-    56, 84,
-    56, 85,
-    56, 86,
-    56, 87,
-    56, 88,
-    56, 89,
-    56, 90,
-    56, 91,
-    57, 75,
-    58, 34,
-    58, 36,
-    58, 43,
-    58, 48,
-    58, 50,
-    58, 51,
-    58, 52,
-    58, 66,
-    58, 68,
-    58, 69,
-    58, 70,
-    58, 71,
-    58, 72,
-    58, 75,
-    58, 78,
-    58, 79,
-    58, 80,
-    58, 81,
-    58, 82,
-    58, 83,
-    58, 84,
-    58, 85,
-    58, 86,
-    58, 87,
-    58, 88,
-    58, 89,
-    58, 90,
-    58, 91,
-    59, 43,
-    59, 75,
-    66, 75,
-    67, 75,
-    68, 75,
-    69, 75,
-    70, 75,
-    71, 75,
-    73, 75,
-    74, 75,
-    76, 75,
-    77, 75,
-    78, 75,
-    79, 75,
-    80, 75,
-    81, 75,
-    83, 75,
-    84, 75,
-    85, 75,
-    86, 75,
-    87, 75,
-    88, 75,
-    89, 75,
-    91, 75
+    2, 2,
+    2, 4,
+    2, 5,
+    3, 2,
+    3, 5,
+    4, 5,
+    5, 2,
+    5, 4,
+    5, 5
 };
 
 /* Kerning between the respective left and right glyphs
  * 4.4 format which needs to scaled with `kern_scale`*/
 static const int8_t kern_pair_values[] =
 {
-    -20, -2, -4, -2, -2, -22, -2, -2,
-    7, 2, 2, 2, 2, 2, 2, 4,
-    -7, -26, -2, -11, -4, -4, -2, -2,
-    -4, -2, -4, -2, -13, -2, -2, -22,
-    -20, -13, -2, -9, -2, -20, -2, -15,
-    -15, -2, -4, -15, -2, -24, -11, -2,
-    -13, -24, -24, -2, -9, -13, -52, -11,
-    -44, -15, -13, -11, -2, 2, -11, -9,
-    -4, -2, -15, -4, -24, -9, -4, -2,
-    -2, -2, -2, -2, -2, -2, -2, -2,
-    -68, -7, -66, -22, -66, -2, -22, -44,
-    -2, -48, -2, -46, -2, -2, -2, -2,
-    -11, -2, -4, -42, -4, -4, -44, -20,
-    -9, -22, -9, -2, -17, -50, -2, -48,
-    -70, -59, -2, -52, -4, -2, -42, -42,
-    -42, -2, -44, -4, -2, -48, -2, -2,
-    -4, -2, -4, -2, -4, -4, -2, -2,
-    -4, -2, -72, -4, -66, -20, -68, 2,
-    -2, -4, -4, -2, -22, -52, -50, -2,
-    -66, -2, -2, -2, -2, -42, -44, -4,
-    -46, -55, -2, -66, -9, -4, -2, -4,
-    -7, -2, -7, -4, -4, -4, -7, -2,
-    -2, -2, -48, -2, -2, -2, -4, -4,
-    -7, -7, -2, -2, -2, -4, -2, -4,
-    -7, -4, -4, -4, -44, -2, -2, -9,
-    -2, -4, -44, -4, -2, -4, -42, -68,
-    -2, -4, -68, -2, -7, -2, -2, -44,
-    -44, -46, -44, -26, -42, -57, -42, -42,
-    -42, -42, -39, -39, -42, -24, -42, -42,
-    -42, -44, -42, -46, -42, -63, -4, -4,
-    -4, -2, -55, 2, -2, -4, -7, -2,
-    -2, -2, -20, -2, -11, -13, -13, -15,
-    -13, -48, -11, -15, -15, -13, -15, -11,
-    -17, -15, -9, -13, -15, -13, -11, -13,
-    -28, -17, -2, -11, -7, -7, -9, -13,
-    -7, -42, -4, -7, -7, -4, -4, -4,
-    -7, -7, -4, -7, -7, -4, -4, -7,
-    -42, -66, -2, -61, -2, -2, -2, -4,
-    -26, -28, -26, -24, -24, -20, -48, -22,
-    -22, -22, -22, -22, -22, -22, -24, -17,
-    -22, -22, -22, -24, -22, -4, -48, -42,
-    -44, -46, -42, -42, -50, -44, -39, -48,
-    -42, -48, -48, -44, -42, -46, -44, -44,
-    -44, -50, -46, -42, -48
+    -2, -2, -68, -2, -9, -4, -68, -2,
+    -2
 };
 
 /*Collect the kern pair's data in one place*/
@@ -1187,10 +128,12 @@ static const lv_font_fmt_txt_kern_pair_t kern_pairs =
 {
     .glyph_ids = kern_pair_glyph_ids,
     .values = kern_pair_values,
-    .pair_cnt = 349,
+    .pair_cnt = 9,
     .glyph_ids_size = 0
 };
 
+
+
 /*--------------------
  *  ALL CUSTOM DATA
  *--------------------*/
@@ -1210,10 +153,10 @@ static lv_font_fmt_txt_dsc_t font_dsc = {
     .cmaps = cmaps,
     .kern_dsc = &kern_pairs,
     .kern_scale = 16,
-    .cmap_num = 1,
+    .cmap_num = 3,
     .bpp = 1,
     .kern_classes = 0,
-    .bitmap_format = 0,
+    .bitmap_format = 1,
 #if LVGL_VERSION_MAJOR == 8
     .cache = &cache
 #endif
@@ -1252,4 +195,3 @@ lv_font_t ui_font_SonicSaber = {
 
 
 #endif /*#if UI_FONT_SONICSABER*/
-
@@ -49,18 +49,25 @@ void _ui_slider_set_property(lv_obj_t * target, int id, int val)
 }
 
 
+__attribute__((weak)) void _ui_screen_created(lv_obj_t ** target)
+{
+    LV_UNUSED(target);
+}
+
 void _ui_screen_change(lv_obj_t ** target, lv_scr_load_anim_t fademode, int spd, int delay, void (*target_init)(void))
 {
-    if(*target == NULL)
+    if(*target == NULL) {
         target_init();
+        _ui_screen_created(target);
+    }
     lv_scr_load_anim(*target, fademode, spd, delay, false);
 }
 
 void _ui_screen_delete(lv_obj_t ** target)
 {
-    if(*target == NULL) {
+    if(*target != NULL) {
         lv_obj_del(*target);
-        target = NULL;
+        *target = NULL;
     }
 }
 
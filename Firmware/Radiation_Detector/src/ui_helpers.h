@@ -40,6 +40,9 @@ void _ui_roller_set_property(lv_obj_t * target, int id, int val);
 #define _UI_SLIDER_PROPERTY_VALUE_WITH_ANIM 1
 void _ui_slider_set_property(lv_obj_t * target, int id, int val);
 
+// Called by _ui_screen_change() after it built *target; the application overrides it
+void _ui_screen_created(lv_obj_t ** target);
+
 void _ui_screen_change(lv_obj_t ** target, lv_scr_load_anim_t fademode, int spd, int delay, void (*target_init)(void));
 
 void _ui_screen_delete(lv_obj_t ** target);
@@ -0,0 +1,85 @@
+// Generated by tools/pack_assets.py from assets/images - do not edit.
+// The pixels are in the asset partition (asset_pack.h); .data names the
+// pack entry and LV_IMG_CF_USER_ENCODED_0 routes the image to its decoder.
+
+#include "ui.h"
+
+// assets/bar-chart.png
+const lv_img_dsc_t ui_img_1345346577 = {
+    .header.always_zero = 0,
+    .header.w = 45,
+    .header.h = 45,
+    .data_size = 0,
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)"ui_img_1345346577"
+};
+
+// assets/GMtube (100 x 100 px) (4).png
+const lv_img_dsc_t ui_img_176188083 = {
+    .header.always_zero = 0,
+    .header.w = 100,
+    .header.h = 100,
+    .data_size = 0,
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)"ui_img_176188083"
+};
+
+// assets/reiniciar (1).png
+const lv_img_dsc_t ui_img_584212719 = {
+    .header.always_zero = 0,
+    .header.w = 40,
+    .header.h = 40,
+    .data_size = 0,
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)"ui_img_584212719"
+};
+
+// assets/electricity.png
+const lv_img_dsc_t ui_img_electricity_png = {
+    .header.always_zero = 0,
+    .header.w = 45,
+    .header.h = 45,
+    .data_size = 0,
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)"ui_img_electricity_png"
+};
+
+// assets/radiation.png
+const lv_img_dsc_t ui_img_radiation_png = {
+    .header.always_zero = 0,
+    .header.w = 45,
+    .header.h = 45,
+    .data_size = 0,
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)"ui_img_radiation_png"
+};
+
+// assets/RadScan200x200.png
+const lv_img_dsc_t ui_img_radscan200x200_png = {
+    .header.always_zero = 0,
+    .header.w = 200,
+    .header.h = 200,
+    .data_size = 0,
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)"ui_img_radscan200x200_png"
+};
+
+// assets/settings.png
+const lv_img_dsc_t ui_img_settings_png = {
+    .header.always_zero = 0,
+    .header.w = 45,
+    .header.h = 45,
+    .data_size = 0,
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)"ui_img_settings_png"
+};
+
+// assets/star.png
+const lv_img_dsc_t ui_img_star_png = {
+    .header.always_zero = 0,
+    .header.w = 80,
+    .header.h = 80,
+    .data_size = 0,
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)"ui_img_star_png"
+};
@@ -0,0 +1,267 @@
+/**
+ * @file ui_screens.cpp
+ * @brief Lazy construction and teardown of the SquareLine screens.
+ *
+ * The generated code keeps one global per screen and builds a screen whenever
+ * that global is NULL. This module owns those globals after ui_init(): it
+ * watches every built screen for LV_EVENT_SCREEN_UNLOADED and LV_EVENT_DELETE,
+ * runs the application hooks and sets the global back to NULL, so the next
+ * navigation builds a fresh screen. A screen unloaded from inside one of its
+ * own event handlers (every SquareLine navigation button) cannot be deleted
+ * synchronously; delete-on-leave screens are detached at once and deleted by
+ * lv_obj_del_async() on the next lv_timer_handler(). Before the created hook
+ * runs, the screen's layout-only containers are dissolved (ui_flatten.h) and
+ * its local styles replaced by shared ones (ui_style_share.h); the LVGL heap
+ * released by that is recorded per screen. After the hook, the screens that
+ * stay up get their static layer baked into a backdrop (ui_backdrop.h).
+ * LV_EVENT_SCREEN_LOAD_START runs the "shown" hook; in lv_scr_load() it comes
+ * before the screen is made the active one, so the hooks refresh their
+ * widgets without asking uiScreenShown().
+ */
+
+#include "config.h"
+
+#if !HEADLESS
+
+#include "ui_screens.h"
+#include "ui.h"
+#include "lvgl_heap.h"
+#include "ui_style_share.h"
+#include "ui_flatten.h"
+#include "ui_backdrop.h"
+
+// Layout-only containers dissolved after a build (ui_flatten.h): the
+// navigation bar and the range buttons of the screens that stay up
+static lv_obj_t** const mainLayoutOnly[] = {&ui_Container3, NULL};
+static lv_obj_t** const charts1hLayoutOnly[] = {&ui_Container1, &ui_Container6, NULL};
+static lv_obj_t** const charts24hLayoutOnly[] = {&ui_Container5, &ui_Container7, NULL};
+static lv_obj_t** const spectrumLayoutOnly[] = {&ui_Container8, &ui_Container9, NULL};
+
+struct ScreenEntry {
+    const char* name;
+    lv_obj_t** screen;
+    void (*init)(void);
+    lv_obj_t** const* layoutOnly;
+    bool backdrop;             ///< Static layer baked after the created hook (ui_backdrop.h)
+    UiScreenHook created;
+    UiScreenHook destroyed;
+    UiScreenHook shown;
+    bool deleteOnLeave;
+    uint16_t builds;
+    uint16_t objects;          ///< At the last build, after flattening
+    uint8_t flattened;         ///< Containers dissolved at the last build
+    uint16_t sharedLocals;     ///< Local styles replaced at the last build
+    int32_t sharedBytes;       ///< LVGL heap released by that
+    uint32_t shareUs;
+    uint32_t shows;            ///< Loads since boot
+    bool baked;                ///< The last build has a backdrop
+};
+
+static ScreenEntry entries[UI_SCREEN_COUNT] = {
+    {"startup", &ui_Startup_screen, ui_Startup_screen_screen_init, NULL, false, nullptr, nullptr, nullptr, false, 0, 0, 0,
+     0, 0, 0, 0, false},
+    {"initial", &ui_InitialScreen, ui_InitialScreen_screen_init, NULL, false, nullptr, nullptr, nullptr, false, 0, 0, 0, 0,
+     0, 0, 0, false},
+    {"main", &ui_MainScreen, ui_MainScreen_screen_init, mainLayoutOnly, true, nullptr, nullptr, nullptr, false, 0, 0, 0, 0,
+     0, 0, 0, false},
+    {"charts1h", &ui_Charts1h, ui_Charts1h_screen_init, charts1hLayoutOnly, true, nullptr, nullptr, nullptr, false, 0, 0,
+     0, 0, 0, 0, 0, false},
+    {"charts24h", &ui_Charts24h, ui_Charts24h_screen_init, charts24hLayoutOnly, true, nullptr, nullptr, nullptr, false, 0,
+     0, 0, 0, 0, 0, 0, false},
+    {"spectrum", &ui_ChartsSpectrum, ui_ChartsSpectrum_screen_init, spectrumLayoutOnly, false, nullptr, nullptr, nullptr,
+     false, 0, 0, 0, 0, 0, 0, 0, false},
+    {"voltage", &ui_VoltageScreen, ui_VoltageScreen_screen_init, NULL, false, nullptr, nullptr, nullptr, false, 0, 0, 0, 0,
+     0, 0, 0, false},
+    {"settings", &ui_Settings, ui_Settings_screen_init, NULL, false, nullptr, nullptr, nullptr, false, 0, 0, 0, 0, 0, 0, 0,
+     false},
+};
+
+static ScreenEntry* findEntry(lv_obj_t** screen) {
+    for (size_t i = 0; i < UI_SCREEN_COUNT; i++) {
+        if (entries[i].screen == screen) return &entries[i];
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Runs the destroyed hook and forgets the screen; the object itself is
+ *        deleted by the caller (or is being deleted already).
+ */
+static void detach(ScreenEntry* entry, lv_obj_t* screen) {
+    if (*entry->screen != screen) return; // Already detached, a newer build is live
+    if (entry->destroyed) entry->destroyed(screen);
+    *entry->screen = NULL;
+}
+
+static void screenEventCb(lv_event_t* e) {
+    ScreenEntry* entry = (ScreenEntry*)lv_event_get_user_data(e);
+    lv_obj_t* screen = lv_event_get_target(e);
+    lv_event_code_t code = lv_event_get_code(e);
+    if (code == LV_EVENT_DELETE) {
+        detach(entry, screen);
+    } else if (code == LV_EVENT_SCREEN_LOAD_START && *entry->screen == screen) {
+        entry->shows++;
+        if (entry->shown) entry->shown(screen);
+    } else if (code == LV_EVENT_SCREEN_UNLOADED && entry->deleteOnLeave && *entry->screen == screen) {
+        detach(entry, screen);
+        lv_obj_del_async(screen);
+    }
+}
+
+/**
+ * @brief Bytes currently allocated through lv_mem_alloc() (pool blocks counted whole).
+ */
+static uint32_t lvglHeapUsed() {
+#if LV_MEM_CUSTOM
+    LvglHeapStats s = getLvglHeapStats();
+    uint32_t used = s.internalBytes + s.psramBytes;
+    for (uint8_t i = 0; i < LVGL_HEAP_CLASSES; i++) used += (uint32_t)s.classes[i].used * s.classes[i].blockSize;
+    return used;
+#else
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.total_size - mon.free_size;
+#endif
+}
+
+/**
+ * @brief Takes over a screen that was just built, flattens it, shares its
+ *        styles and runs its created hook.
+ */
+static void adopt(ScreenEntry* entry) {
+    lv_obj_t* screen = *entry->screen;
+    lv_obj_add_event_cb(screen, screenEventCb, LV_EVENT_DELETE, entry);
+    lv_obj_add_event_cb(screen, screenEventCb, LV_EVENT_SCREEN_UNLOADED, entry);
+    lv_obj_add_event_cb(screen, screenEventCb, LV_EVENT_SCREEN_LOAD_START, entry);
+    entry->builds++;
+    entry->flattened = uiFlattenContainers(entry->layoutOnly);
+    entry->objects = (uint16_t)uiObjectCount(screen);
+    uint32_t heapBefore = lvglHeapUsed();
+    uint32_t start = micros();
+    UiStyleShareResult shared = uiStyleShare(screen);
+    entry->shareUs = micros() - start;
+    entry->sharedLocals = shared.locals;
+    entry->sharedBytes = (int32_t)(heapBefore - lvglHeapUsed());
+    if (entry->created) entry->created(screen);
+    // After the hook, which marks the widgets it keeps updating
+    entry->baked = entry->backdrop && uiBackdropBake(screen);
+}
+
+/**
+ * @brief Hook of the generated _ui_screen_change() (ui_helpers.h).
+ */
+extern "C" void _ui_screen_created(lv_obj_t** target) {
+    ScreenEntry* entry = findEntry(target);
+    if (entry) adopt(entry);
+}
+
+void uiScreensBegin() {
+    for (size_t i = 0; i < UI_SCREEN_COUNT; i++) {
+        if (*entries[i].screen && entries[i].builds == 0) adopt(&entries[i]);
+    }
+}
+
+void uiScreenSetHooks(UiScreenId id, UiScreenHook created, UiScreenHook destroyed) {
+    if (id >= UI_SCREEN_COUNT) return;
+    entries[id].created = created;
+    entries[id].destroyed = destroyed;
+    if (created && *entries[id].screen) created(*entries[id].screen);
+}
+
+void uiScreenSetDeleteOnLeave(UiScreenId id, bool enabled) {
+    if (id < UI_SCREEN_COUNT) entries[id].deleteOnLeave = enabled;
+}
+
+void uiScreenSetShowHook(UiScreenId id, UiScreenHook shown) {
+    if (id >= UI_SCREEN_COUNT) return;
+    entries[id].shown = shown;
+    if (shown && uiScreenShown(id)) shown(*entries[id].screen);
+}
+
+bool uiScreenShown(UiScreenId id) {
+    return id < UI_SCREEN_COUNT && *entries[id].screen && *entries[id].screen == lv_scr_act();
+}
+
+lv_obj_t* uiScreenGet(UiScreenId id) {
+    if (id >= UI_SCREEN_COUNT) return NULL;
+    ScreenEntry* entry = &entries[id];
+    if (!*entry->screen) {
+        entry->init();
+        adopt(entry);
+    }
+    return *entry->screen;
+}
+
+lv_obj_t* uiScreenIfBuilt(UiScreenId id) {
+    return id < UI_SCREEN_COUNT ? *entries[id].screen : NULL;
+}
+
+void uiScreenLoad(UiScreenId id) {
+    lv_obj_t* screen = uiScreenGet(id);
+    if (screen) lv_scr_load(screen);
+}
+
+void uiScreenRebuild(UiScreenId id) {
+    if (id >= UI_SCREEN_COUNT) return;
+    ScreenEntry* entry = &entries[id];
+    lv_obj_t* old = *entry->screen;
+    if (!old) return;
+    bool active = old == lv_scr_act();
+    detach(entry, old);
+    entry->init();
+    adopt(entry);
+    if (active) lv_scr_load(*entry->screen);
+    lv_obj_del(old);
+}
+
+UiScreenId uiScreenActive() {
+    lv_obj_t* active = lv_scr_act();
+    for (size_t i = 0; i < UI_SCREEN_COUNT; i++) {
+        if (active && *entries[i].screen == active) return (UiScreenId)i;
+    }
+    return UI_SCREEN_COUNT;
+}
+
+const char* uiScreenName(UiScreenId id) {
+    return id < UI_SCREEN_COUNT ? entries[id].name : "other";
+}
+
+void printUiScreens(Print& out) {
+    UiScreenId active = uiScreenActive();
+    for (size_t i = 0; i < UI_SCREEN_COUNT; i++) {
+        const ScreenEntry& entry = entries[i];
+        out.printf("%-10s %-5s builds %u, shown %lu%s%s\n", entry.name, *entry.screen ? "built" : "-",
+                   (unsigned)entry.builds, (unsigned long)entry.shows, entry.deleteOnLeave ? ", deleted on leave" : "",
+                   (UiScreenId)i == active ? ", active" : "");
+        if (entry.builds) {
+            out.printf("           %u objects at the last build, %u layout-only containers dissolved\n",
+                       (unsigned)entry.objects, (unsigned)entry.flattened);
+        }
+        if (entry.builds && entry.baked) out.println("           static layer drawn from its backdrop");
+        if (entry.builds && entry.sharedLocals) {
+            out.printf("           %u local styles shared at the last build, %ld bytes released, %lu us\n",
+                       (unsigned)entry.sharedLocals, (long)entry.sharedBytes, (unsigned long)entry.shareUs);
+        }
+    }
+    out.printf("Flattening %s\n", uiFlattenEnabled() ? "on" : "off (new builds)");
+    UiBackdropStats backdrops = getUiBackdropStats();
+    out.printf("Backdrops %s: %u screens, %lu KB of PSRAM, %lu baked, %lu failed; last %u objects in %lu us\n",
+               backdrops.enabled ? "on" : "off (new builds)", (unsigned)backdrops.screens,
+               (unsigned long)(backdrops.bytes / 1024), (unsigned long)backdrops.bakes, (unsigned long)backdrops.failures,
+               (unsigned)backdrops.lastObjects, (unsigned long)backdrops.lastUs);
+    UiStyleShareStats styles = getUiStyleShareStats();
+    out.printf("Style sharing %s: %u of %u shared styles, %lu local styles replaced, %lu left local\n",
+               styles.enabled ? "on" : "off (new builds)", (unsigned)styles.shared, (unsigned)styles.capacity,
+               (unsigned long)styles.replaced, (unsigned long)styles.skipped);
+#if LV_MEM_CUSTOM
+    printLvglHeapStats(out);
+#else
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    out.printf("LVGL pool: %lu of %lu bytes used (%u%%), largest free %lu\n",
+               (unsigned long)(mon.total_size - mon.free_size), (unsigned long)mon.total_size,
+               (unsigned)mon.used_pct, (unsigned long)mon.free_biggest_size);
+#endif
+}
+
+#endif // !HEADLESS
@@ -0,0 +1,72 @@
+#ifndef UI_SCREENS_H
+#define UI_SCREENS_H
+
+#include <Arduino.h>
+#include <lvgl.h>
+
+// Lifecycle of the SquareLine screens. ui_init() only builds the startup
+// screen; every other screen is built on its first navigation, either by the
+// generated _ui_screen_change() or by uiScreenGet() / uiScreenLoad() from
+// application code. After a screen was built its "created" hook attaches the
+// application state (label bindings, chart series, event callbacks); before it
+// is deleted its "destroyed" hook detaches it again and clears the widget
+// pointers the application uses, so nothing outside the screen dangles.
+// Screens marked delete-on-leave are deleted (asynchronously) when another
+// screen is loaded. LVGL task only.
+//
+// Hidden screens get no updates: the application writes a screen's widgets
+// only while uiScreenShown() says it is active, and its "shown" hook brings
+// it up to date from the data model as it is loaded. The cost of the UI loop
+// then depends on the shown screen, not on how many screens are built.
+
+enum UiScreenId {
+    UI_SCREEN_STARTUP = 0,
+    UI_SCREEN_INITIAL,
+    UI_SCREEN_MAIN,
+    UI_SCREEN_CHARTS1H,
+    UI_SCREEN_CHARTS24H,
+    UI_SCREEN_SPECTRUM,
+    UI_SCREEN_VOLTAGE,
+    UI_SCREEN_SETTINGS,
+    UI_SCREEN_COUNT
+};
+
+typedef void (*UiScreenHook)(lv_obj_t* screen);
+
+// Takes over the screens ui_init() already built. Call once right after it.
+void uiScreensBegin();
+
+// Registers the hooks of a screen. If it is already built, @p created runs now.
+void uiScreenSetHooks(UiScreenId id, UiScreenHook created, UiScreenHook destroyed);
+
+void uiScreenSetDeleteOnLeave(UiScreenId id, bool enabled);
+
+// Registers the hook run each time the screen starts loading, before its
+// first frame is drawn. If the screen is active already, it runs now.
+void uiScreenSetShowHook(UiScreenId id, UiScreenHook shown);
+
+// True while the screen is the active one (also while it animates in).
+bool uiScreenShown(UiScreenId id);
+
+// The screen object, built (and its created hook run) if needed.
+lv_obj_t* uiScreenGet(UiScreenId id);
+
+// The screen object, or NULL while it is not built.
+lv_obj_t* uiScreenIfBuilt(UiScreenId id);
+
+// Builds the screen if needed and loads it without animation.
+void uiScreenLoad(UiScreenId id);
+
+// Builds the screen anew and loads the new one if the old one was active;
+// the old one is deleted. For comparing build options on the same screen.
+void uiScreenRebuild(UiScreenId id);
+
+// The active screen, or UI_SCREEN_COUNT if it is not one of the SquareLine screens.
+UiScreenId uiScreenActive();
+
+const char* uiScreenName(UiScreenId id);
+
+// Built state and build count of every screen, and the LVGL heap usage.
+void printUiScreens(Print& out);
+
+#endif // UI_SCREENS_H
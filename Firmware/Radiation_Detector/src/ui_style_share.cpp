@@ -0,0 +1,202 @@
+/**
+ * @file ui_style_share.cpp
+ * @brief Interning of the local styles of the generated screens.
+ *
+ * A local style is identified by its set of properties and values only; the
+ * selector stays with the object's style entry, so one shared style serves
+ * every part and state that sets the same properties. Candidates are found by
+ * an order-independent hash and confirmed property by property. The entry is
+ * switched to the shared style in place and the local style freed the way
+ * lv_obj_remove_style() frees it. Shared styles are never modified or freed,
+ * so no object can be left pointing at a changed or dangling style.
+ */
+
+#include "config.h"
+
+#if !HEADLESS
+
+#include "ui_style_share.h"
+#include <string.h>
+
+static lv_style_t sharedStyles[UI_STYLE_SHARE_MAX];
+static uint32_t sharedHashes[UI_STYLE_SHARE_MAX];
+static uint16_t sharedCount = 0;
+static uint32_t replaced = 0;
+static uint32_t skipped = 0;
+static bool enabled = UI_STYLE_SHARING;
+
+static bool isColorProp(uint16_t prop) {
+    switch (prop) {
+        case LV_STYLE_BG_COLOR:
+        case LV_STYLE_BG_GRAD_COLOR:
+        case LV_STYLE_BORDER_COLOR:
+        case LV_STYLE_OUTLINE_COLOR:
+        case LV_STYLE_SHADOW_COLOR:
+        case LV_STYLE_IMG_RECOLOR:
+        case LV_STYLE_LINE_COLOR:
+        case LV_STYLE_ARC_COLOR:
+        case LV_STYLE_TEXT_COLOR:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief The value as one word; colours leave the rest of the union unset.
+ */
+static uint32_t valueWord(uint16_t prop, lv_style_value_t value) {
+    if (isColorProp(prop)) return lv_color_to32(value.color);
+    return (uint32_t)(uintptr_t)value.ptr; // num and ptr share the 32 bits
+}
+
+/**
+ * @brief Property @p i of a non-constant style, with its meta bits.
+ */
+static void styleProp(const lv_style_t* style, uint8_t i, uint16_t* prop, lv_style_value_t* value) {
+    if (style->prop_cnt == 1) {
+        *prop = style->prop1;
+        *value = style->v_p.value1;
+        return;
+    }
+    const lv_style_value_t* values = (const lv_style_value_t*)style->v_p.values_and_props;
+    const uint16_t* props = (const uint16_t*)(style->v_p.values_and_props + style->prop_cnt * sizeof(lv_style_value_t));
+    *prop = props[i];
+    *value = values[i];
+}
+
+/**
+ * @brief Order-independent hash of the properties, or 0 if the style cannot
+ *        be shared (constant, empty, or using inherit/initial meta values).
+ */
+static uint32_t styleHash(const lv_style_t* style) {
+    if (style->prop1 == LV_STYLE_PROP_ANY || style->prop_cnt == 0) return 0;
+    uint32_t hash = style->prop_cnt;
+    for (uint8_t i = 0; i < style->prop_cnt; i++) {
+        uint16_t prop;
+        lv_style_value_t value;
+        styleProp(style, i, &prop, &value);
+        if (prop != LV_STYLE_PROP_ID_MASK(prop)) return 0;
+        uint32_t x = prop * 0x9E3779B1u ^ valueWord(prop, value);
+        x ^= x >> 15;
+        x *= 0x85EBCA6Bu;
+        x ^= x >> 13;
+        hash += x;
+    }
+    return hash ? hash : 1;
+}
+
+static bool sameStyle(const lv_style_t* a, const lv_style_t* b) {
+    if (a->prop_cnt != b->prop_cnt) return false;
+    for (uint8_t i = 0; i < a->prop_cnt; i++) {
+        uint16_t prop;
+        lv_style_value_t value, other;
+        styleProp(a, i, &prop, &value);
+        if (lv_style_get_prop(b, (lv_style_prop_t)prop, &other) != LV_STYLE_RES_FOUND) return false;
+        if (valueWord(prop, value) != valueWord(prop, other)) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief The shared copy of @p local, created if needed; NULL if the table is full.
+ */
+static lv_style_t* intern(const lv_style_t* local, uint32_t hash, bool* created) {
+    for (uint16_t i = 0; i < sharedCount; i++) {
+        if (sharedHashes[i] == hash && sameStyle(local, &sharedStyles[i])) return &sharedStyles[i];
+    }
+    if (sharedCount >= UI_STYLE_SHARE_MAX) return NULL;
+    lv_style_t* style = &sharedStyles[sharedCount];
+    lv_style_init(style);
+    for (uint8_t i = 0; i < local->prop_cnt; i++) {
+        uint16_t prop;
+        lv_style_value_t value;
+        styleProp(local, i, &prop, &value);
+        lv_style_set_prop(style, (lv_style_prop_t)prop, value);
+    }
+    sharedHashes[sharedCount++] = hash;
+    *created = true;
+    return style;
+}
+
+static void shareObject(lv_obj_t* obj, UiStyleShareResult& result) {
+    for (uint32_t i = 0; i < obj->style_cnt; i++) {
+        _lv_obj_style_t* entry = &obj->styles[i];
+        if (!entry->is_local || entry->is_trans) continue;
+        uint32_t hash = styleHash(entry->style);
+        if (!hash) continue;
+        bool created = false;
+        lv_style_t* shared = intern(entry->style, hash, &created);
+        if (!shared) {
+            skipped++;
+            continue;
+        }
+        lv_style_t* local = entry->style;
+        entry->style = shared;
+        entry->is_local = 0;
+        lv_style_reset(local);
+        lv_mem_free(local);
+        result.locals++;
+        if (created) result.created++;
+    }
+    uint32_t children = lv_obj_get_child_cnt(obj);
+    for (uint32_t i = 0; i < children; i++) shareObject(lv_obj_get_child(obj, i), result);
+}
+
+UiStyleShareResult uiStyleShare(lv_obj_t* screen) {
+    UiStyleShareResult result = {0, 0};
+    if (!enabled || !screen) return result;
+    shareObject(screen, result);
+    replaced += result.locals;
+    return result;
+}
+
+void uiStyleShareSetEnabled(bool value) {
+    enabled = value;
+}
+
+bool uiStyleShareEnabled() {
+    return enabled;
+}
+
+UiStyleShareStats getUiStyleShareStats() {
+    UiStyleShareStats s;
+    s.enabled = enabled;
+    s.shared = sharedCount;
+    s.capacity = UI_STYLE_SHARE_MAX;
+    s.replaced = replaced;
+    s.skipped = skipped;
+    return s;
+}
+
+static void countStyles(lv_obj_t* obj, uint32_t& objects, uint32_t& entries, uint32_t& locals) {
+    objects++;
+    entries += obj->style_cnt;
+    for (uint32_t i = 0; i < obj->style_cnt; i++) {
+        if (obj->styles[i].is_local) locals++;
+    }
+    uint32_t children = lv_obj_get_child_cnt(obj);
+    for (uint32_t i = 0; i < children; i++) countStyles(lv_obj_get_child(obj, i), objects, entries, locals);
+}
+
+void uiStyleDrawBench(Print& out, uint8_t frames) {
+    lv_obj_t* screen = lv_scr_act();
+    if (!screen || frames == 0) return;
+    uint32_t objects = 0, entries = 0, locals = 0;
+    countStyles(screen, objects, entries, locals);
+
+    uint32_t total = 0, best = UINT32_MAX;
+    for (uint8_t i = 0; i < frames; i++) {
+        lv_obj_invalidate(screen);
+        uint32_t start = micros();
+        lv_refr_now(NULL);
+        uint32_t us = micros() - start;
+        total += us;
+        if (us < best) best = us;
+    }
+    out.printf("Full redraw: %lu us average, %lu us best of %u; %lu objects, %lu style entries, %lu local\n",
+               (unsigned long)(total / frames), (unsigned long)best, (unsigned)frames, (unsigned long)objects,
+               (unsigned long)entries, (unsigned long)locals);
+}
+
+#endif // !HEADLESS
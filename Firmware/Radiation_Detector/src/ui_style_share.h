@@ -0,0 +1,49 @@
+#ifndef UI_STYLE_SHARE_H
+#define UI_STYLE_SHARE_H
+
+#include <Arduino.h>
+#include <lvgl.h>
+#include "config.h"
+
+// Shared styles for the SquareLine screens ("screens styles").
+// The generated code sets every property with lv_obj_set_style_*(), which
+// gives each object and selector its own local lv_style_t plus a property
+// array on the LVGL heap, and builds them again on every screen build. After
+// a screen is built (ui_screens.cpp) this walks its objects and replaces each
+// local style by an interned, immutable style with the same properties and
+// values: one per distinct property set for the whole UI, kept for the
+// lifetime of the firmware, so a rebuilt screen keeps no styles of its own.
+// The object keeps the style at the same position in its list, so the
+// cascade and every resolved value are unchanged. An lv_obj_set_style_*()
+// from the application later on adds a new local style in front, as LVGL
+// always does (so would an lv_obj_add_style(), which the application does not
+// use on these screens). Regenerating the UI needs no edits. LVGL task only.
+
+struct UiStyleShareResult {
+    uint16_t locals;            ///< Local styles replaced
+    uint16_t created;           ///< New shared styles among them
+};
+
+struct UiStyleShareStats {
+    bool enabled;
+    uint16_t shared;            ///< Distinct shared styles
+    uint16_t capacity;          ///< UI_STYLE_SHARE_MAX
+    uint32_t replaced;          ///< Local styles replaced since boot
+    uint32_t skipped;           ///< Left local (table full)
+};
+
+// Replaces the local styles of @p screen and all its children.
+UiStyleShareResult uiStyleShare(lv_obj_t* screen);
+
+// Enabled by default if UI_STYLE_SHARING; applies to screens built afterwards
+// ("screens styles on|off" rebuilds the active one to compare).
+void uiStyleShareSetEnabled(bool enabled);
+bool uiStyleShareEnabled();
+
+UiStyleShareStats getUiStyleShareStats();
+
+// Forces @p frames full redraws of the active screen and prints the average
+// time of one (render and flush). Blocks the LVGL task meanwhile.
+void uiStyleDrawBench(Print& out, uint8_t frames);
+
+#endif // UI_STYLE_SHARE_H
@@ -0,0 +1,58 @@
+/**
+ * @file ui_wake.cpp
+ * @brief Notification-based wait of the UI task.
+ *
+ * The sources are bits of uiTask's notification value (eSetBits), so several
+ * events between two passes collapse into one wake and every source is seen.
+ */
+
+#include "ui_wake.h"
+#include "config.h"
+
+static TaskHandle_t uiTaskHandle = nullptr;
+static UiWakeStats stats;
+
+void uiWakeBegin(TaskHandle_t uiTask) {
+    uiTaskHandle = uiTask;
+}
+
+void uiWakeNotify(UiWakeSource source) {
+    if (uiTaskHandle) xTaskNotify(uiTaskHandle, source, eSetBits);
+}
+
+void IRAM_ATTR uiWakeNotifyFromIsr(UiWakeSource source) {
+    if (!uiTaskHandle) return;
+    BaseType_t woken = pdFALSE;
+    xTaskNotifyFromISR(uiTaskHandle, source, eSetBits, &woken);
+    if (woken) portYIELD_FROM_ISR();
+}
+
+uint32_t uiWakeWait(uint32_t timeoutMs) {
+    if (timeoutMs > UI_TASK_MAX_SLEEP_MS) timeoutMs = UI_TASK_MAX_SLEEP_MS;
+    TickType_t ticks = pdMS_TO_TICKS(timeoutMs);
+    if (ticks == 0) ticks = 1; // Lets the lower-priority tasks on this core run
+
+    uint32_t startMs = millis();
+    uint32_t bits = 0;
+    if (xTaskNotifyWait(0, UINT32_MAX, &bits, ticks) != pdTRUE) bits = 0;
+    stats.sleptMs += millis() - startMs;
+    stats.passes++;
+    if (bits & UI_WAKE_TOUCH) stats.touchWakes++;
+    if (bits & UI_WAKE_DATA) stats.dataWakes++;
+    if (bits & UI_WAKE_ASYNC) stats.asyncWakes++;
+    if (!bits) stats.deadlineWakes++;
+    return bits;
+}
+
+UiWakeStats getUiWakeStats() {
+    return stats;
+}
+
+void printUiWakeStats(Print& out) {
+    UiWakeStats s = getUiWakeStats();
+    out.printf("UI task: %lu passes, woken by touch %lu, data %lu, requests %lu, deadline %lu\n",
+               (unsigned long)s.passes, (unsigned long)s.touchWakes, (unsigned long)s.dataWakes,
+               (unsigned long)s.asyncWakes, (unsigned long)s.deadlineWakes);
+    out.printf("  blocked %lu ms in total, %.1f ms per pass\n", (unsigned long)s.sleptMs,
+               s.passes ? (float)s.sleptMs / s.passes : 0.0f);
+}
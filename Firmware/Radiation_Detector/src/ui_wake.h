@@ -0,0 +1,48 @@
+#ifndef UI_WAKE_H
+#define UI_WAKE_H
+
+#include <Arduino.h>
+
+// Event-driven scheduling of uiTask. Between passes the task blocks on its
+// FreeRTOS notification instead of a fixed delay. It is woken by
+//  - a touch (T_IRQ, TOUCH_IRQ_PIN) or another input,
+//  - pulseTask closing a second (new rates, dose and alarm status),
+//  - a widget request from another task (ui_async.h),
+//  - the deadline lv_timer_handler() returns: the next due LVGL timer. The
+//    refresh timer is paused while nothing is invalidated, so an idle screen
+//    has no deadline of its own,
+// and at the latest after UI_TASK_MAX_SLEEP_MS (serial commands, WiFi state
+// machine, battery), so no work of the pass is starved.
+
+enum UiWakeSource {
+    UI_WAKE_TOUCH = 1 << 0,
+    UI_WAKE_DATA  = 1 << 1,
+    UI_WAKE_ASYNC = 1 << 2,
+};
+
+struct UiWakeStats {
+    uint32_t passes;       ///< Waits completed
+    uint32_t touchWakes;
+    uint32_t dataWakes;
+    uint32_t asyncWakes;
+    uint32_t deadlineWakes; ///< LVGL timer or UI_TASK_MAX_SLEEP_MS
+    uint32_t sleptMs;      ///< Total time blocked
+};
+
+// Binds the notifications to @p uiTask. Call before the wake sources run.
+void uiWakeBegin(TaskHandle_t uiTask);
+
+// Wakes uiTask early; any task, and from an ISR.
+void uiWakeNotify(UiWakeSource source);
+void IRAM_ATTR uiWakeNotifyFromIsr(UiWakeSource source);
+
+// Blocks uiTask for up to @p timeoutMs (capped at UI_TASK_MAX_SLEEP_MS, at
+// least one tick) or until notified. uiTask only.
+// @return the UiWakeSource bits that woke it, 0 at the deadline
+uint32_t uiWakeWait(uint32_t timeoutMs);
+
+UiWakeStats getUiWakeStats();
+
+void printUiWakeStats(Print& out);
+
+#endif // UI_WAKE_H
@@ -0,0 +1,193 @@
+/**
+ * @file usb_drive.cpp
+ * @brief TinyUSB mass-storage glue for the virtual FAT view of the history log.
+ *
+ * The read callback runs on the TinyUSB task. It renders metadata sectors
+ * itself. Runs of HISTORY.BIN sectors go to the card as one read, which
+ * historyLogRawRead() slices so the display is never held up for long. A
+ * mutex keeps a new snapshot from being laid out under a read in progress.
+ * Every write is refused: the medium reports itself write-protected, and
+ * a host that writes anyway gets an error.
+ */
+
+#include "usb_drive.h"
+#include "virtual_fat.h"
+#include "history_log.h"
+#include "time_base.h"
+#include "debug.h"
+#include <time.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+#if USB_DRIVE_ENABLED && CONFIG_TINYUSB_MSC_ENABLED
+#include <USB.h>
+#include <USBMSC.h>
+#define USB_DRIVE_BUILT 1
+#else
+#define USB_DRIVE_BUILT 0
+#endif
+
+static UsbDriveStats stats;
+
+#if USB_DRIVE_BUILT
+static const uint8_t README_FILE = 0;
+static const uint8_t LOG_FILE = 1;
+
+static VirtualFat volume;
+static char readme[512];
+static SemaphoreHandle_t driveMutex = nullptr;
+static USBMSC msc; ///< Constructed before USB starts, so the interface is in the descriptor from boot
+
+/**
+ * @brief Fills @p count sectors from @p lba: metadata rendered, file data read in runs.
+ */
+static bool readSectors(uint32_t lba, uint8_t* out, uint32_t count) {
+    bool ok = true;
+    for (uint32_t done = 0; done < count;) {
+        uint8_t* sector = out + done * VirtualFat::SECTOR_BYTES;
+        uint8_t index;
+        uint32_t offset;
+        if (volume.render(lba + done, sector, &index, &offset)) {
+            done++;
+            continue;
+        }
+        const VirtualFatFile& file = volume.file(index);
+        if (index == README_FILE) {
+            size_t n = file.size - offset < VirtualFat::SECTOR_BYTES ? file.size - offset : VirtualFat::SECTOR_BYTES;
+            memcpy(sector, readme + offset, n);
+            done++;
+            continue;
+        }
+        // The rest of the request, up to the end of the file, in one read
+        uint32_t sectors = count - done;
+        uint32_t remaining = file.size - offset;
+        size_t length = sectors * VirtualFat::SECTOR_BYTES < remaining ? sectors * VirtualFat::SECTOR_BYTES : remaining;
+        if (historyLogRawRead(offset, sector, length) != length) ok = false;
+        done += (length + VirtualFat::SECTOR_BYTES - 1) / VirtualFat::SECTOR_BYTES;
+    }
+    return ok;
+}
+
+static int32_t onMscRead(uint32_t lba, uint32_t offset, void* buffer, uint32_t bufsize) {
+    if (offset != 0 || bufsize % VirtualFat::SECTOR_BYTES) return -1; // TinyUSB asks for whole sectors
+    uint32_t start = micros();
+    xSemaphoreTake(driveMutex, portMAX_DELAY);
+    bool ok = readSectors(lba, (uint8_t*)buffer, bufsize / VirtualFat::SECTOR_BYTES);
+    xSemaphoreGive(driveMutex);
+    stats.sectorsRead += bufsize / VirtualFat::SECTOR_BYTES;
+    stats.readUs += micros() - start;
+    if (!ok) {
+        stats.readErrors++;
+        return -1;
+    }
+    return bufsize;
+}
+
+static int32_t onMscWrite(uint32_t lba, uint32_t offset, uint8_t* buffer, uint32_t bufsize) {
+    return -1; // Read-only
+}
+
+static bool onMscStartStop(uint8_t powerCondition, bool start, bool loadEject) {
+    if (loadEject && !start) usbDriveShow(false); // Ejected on the host
+    return true;
+}
+
+/**
+ * @brief Lays out README.TXT and HISTORY.BIN for a new snapshot. Drive mutex held.
+ */
+static void buildSnapshot() {
+    uint16_t date = 0, time = 0;
+    char when[32] = "uptime";
+    if (timeBaseUtcValid()) {
+        time_t utc = (time_t)timeBaseUtcSeconds();
+        struct tm parts;
+        gmtime_r(&utc, &parts);
+        date = VirtualFat::fatDate(parts.tm_year + 1900, parts.tm_mon + 1, parts.tm_mday);
+        time = VirtualFat::fatTime(parts.tm_hour, parts.tm_min, parts.tm_sec);
+        strftime(when, sizeof(when), "%Y-%m-%d %H:%M:%S UTC", &parts);
+    } else {
+        snprintf(when, sizeof(when), "uptime %lu s", (unsigned long)timeBaseSeconds());
+    }
+
+    historyLogRawClose();
+    uint32_t logBytes = historyLogRawOpen();
+    HistoryLogStats log = getHistoryLogStats();
+    int length = snprintf(readme, sizeof(readme),
+                          "Radiation detector history log, snapshot of %s\r\n\r\n"
+                          "HISTORY.BIN: the binary log as it was on the card, %lu blocks, %lu records.\r\n"
+                          "Decode it with: python3 tools/decode_history_log.py HISTORY.BIN > history.csv\r\n\r\n"
+                          "The drive is read-only and does not change while shown. Logging continues;\r\n"
+                          "\"usbdrive on\" on the serial console, or a re-plug, shows a fresh snapshot.\r\n",
+                          when, (unsigned long)(logBytes ? logBytes / 512 - 1 : 0), (unsigned long)log.records);
+    if (length < 0 || length >= (int)sizeof(readme)) length = sizeof(readme) - 1;
+
+    volume.reset("RADLOG", date, time);
+    volume.addFile("README.TXT", length);
+    if (volume.addFile("HISTORY.BIN", logBytes) < 0) {
+        volume.addFile("HISTORY.BIN", 0); // Past 2 GB; the HTTP export still has it
+    }
+    stats.logBytes = volume.file(LOG_FILE).size;
+    stats.snapshots++;
+}
+#endif
+
+bool initUsbDrive() {
+#if USB_DRIVE_BUILT
+    driveMutex = xSemaphoreCreateMutex();
+    if (!driveMutex) return false;
+    msc.vendorID("RadDet");
+    msc.productID("History log");
+    msc.productRevision("1.0");
+    msc.onRead(onMscRead);
+    msc.onWrite(onMscWrite);
+    msc.onStartStop(onMscStartStop);
+    msc.isWritable(false);
+    msc.mediaPresent(false);
+    if (!msc.begin(VirtualFat::TOTAL_SECTORS, VirtualFat::SECTOR_BYTES)) return false;
+    USB.begin(); // No-op if the console already started it
+    stats.available = true;
+    if (USB_DRIVE_SHOWN) usbDriveShow(true);
+    DEBUG_PRINTF("USB drive: registered, %lu sectors\n", (unsigned long)VirtualFat::TOTAL_SECTORS);
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool usbDriveShow(bool shown) {
+#if USB_DRIVE_BUILT
+    if (!stats.available) return false;
+    // The host must see the medium go before its contents change
+    msc.mediaPresent(false);
+    stats.shown = false;
+    if (shown) flushHistoryLog(); // Buffered blocks land in the next snapshot
+    xSemaphoreTake(driveMutex, portMAX_DELAY);
+    if (shown) buildSnapshot();
+    else historyLogRawClose();
+    xSemaphoreGive(driveMutex);
+    if (shown) {
+        msc.mediaPresent(true);
+        stats.shown = true;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+UsbDriveStats getUsbDriveStats() {
+    return stats;
+}
+
+void printUsbDrive(Print& out) {
+    UsbDriveStats s = getUsbDriveStats();
+    if (!s.available) {
+        out.println("USB drive: not available (USB_DRIVE_ENABLED and a TinyUSB / USB-OTG build)");
+        return;
+    }
+    out.printf("USB drive: %s, HISTORY.BIN %lu bytes (snapshot %lu)\n", s.shown ? "SHOWN" : "hidden",
+               (unsigned long)s.logBytes, (unsigned long)s.snapshots);
+    float seconds = s.readUs / 1e6f;
+    out.printf("  %lu sectors read, %lu errors, %.2f MB/s while reading\n", (unsigned long)s.sectorsRead,
+               (unsigned long)s.readErrors, seconds > 0.0f ? s.sectorsRead * 512.0f / 1e6f / seconds : 0.0f);
+}
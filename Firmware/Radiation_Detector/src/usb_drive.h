@@ -0,0 +1,47 @@
+#ifndef USB_DRIVE_H
+#define USB_DRIVE_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Read-only USB drive with the history log, for bulk download at the end of a
+// campaign over the S3's native USB instead of WiFi.
+// The drive is a virtual FAT16 volume (virtual_fat.h) holding README.TXT
+// and HISTORY.BIN. HISTORY.BIN is the raw log file, decoded on the host by
+// tools/decode_history_log.py. Sectors are rendered when the host reads
+// them; file data comes straight from the card through a separate read
+// handle. The card stays mounted by the firmware and logging and counting
+// carry on.
+//
+// The host sees the log as it was when the drive was shown. "usbdrive on"
+// again (or a re-plug) presents a fresh snapshot; blocks logged meanwhile
+// only appear then.
+//
+// Needs USB_DRIVE_ENABLED and a build with TinyUSB on the native port
+// (ARDUINO_USB_MODE=0, "USB-OTG"); otherwise every call reports "not
+// available". The MSC interface is registered at boot with no medium, so
+// showing the drive does not re-enumerate the port or drop the serial
+// console.
+
+struct UsbDriveStats {
+    bool available;          ///< Built in and registered
+    bool shown;              ///< Medium present to the host
+    uint32_t logBytes;       ///< HISTORY.BIN in the current snapshot
+    uint32_t snapshots;      ///< Times the drive was shown
+    uint32_t sectorsRead;
+    uint32_t readErrors;
+    uint32_t readUs;         ///< Time spent in read callbacks
+};
+
+// Sets up the MSC callbacks (no medium yet). Call in setup() after
+// initHistoryLog(). Shows the drive if USB_DRIVE_SHOWN.
+bool initUsbDrive();
+
+// Takes a snapshot of the log and presents the medium, or withdraws it.
+bool usbDriveShow(bool shown);
+
+UsbDriveStats getUsbDriveStats();
+
+void printUsbDrive(Print& out);
+
+#endif // USB_DRIVE_H
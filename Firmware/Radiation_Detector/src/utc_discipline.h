@@ -0,0 +1,131 @@
+#ifndef UTC_DISCIPLINE_H
+#define UTC_DISCIPLINE_H
+
+#include <stdint.h>
+
+// Maps the 64-bit monotonic microsecond clock onto UTC.
+// Each time sample (SNTP) is compared with the mapping's prediction for the
+// same instant. Small errors are slewed out at MAX_SLEW_PPM and also adjust a
+// frequency correction, so the local oscillator's drift stops accumulating
+// between samples; only an error above STEP_US (or the first sample) steps the
+// mapping. Between steps UTC never runs backwards and never jumps, which keeps
+// interval arithmetic on records valid. No Arduino dependencies (host-compilable).
+
+class UtcDiscipline {
+public:
+    static const int64_t STEP_US = 2000000;      ///< Larger errors are stepped, not slewed
+    static const int32_t MAX_SLEW_PPM = 500;     ///< Rate at which an error is slewed out
+    static const int32_t MAX_FREQ_PPB = 500000;  ///< Frequency correction limit (500 ppm)
+    static const int64_t MIN_FREQ_INTERVAL_US = 60000000; ///< Shorter sample gaps do not train the frequency
+
+    UtcDiscipline() { clear(); }
+
+    void clear() {
+        valid_ = false;
+        anchorMonoUs_ = 0;
+        anchorUtcUs_ = 0;
+        slewUs_ = 0;
+        freqPpb_ = 0;
+        lastSampleMonoUs_ = 0;
+        lastErrorUs_ = 0;
+        samples_ = 0;
+        steps_ = 0;
+    }
+
+    /**
+     * @brief Feeds one reference time: @p utcUs was true at monotonic @p monoUs.
+     * @return true if the mapping was stepped (first sample or a large error)
+     */
+    bool sample(int64_t monoUs, int64_t utcUs) {
+        samples_++;
+        if (!valid_) {
+            anchor(monoUs, utcUs);
+            valid_ = true;
+            steps_++;
+            return true;
+        }
+        int64_t predicted = utcAt(monoUs);
+        int64_t error = utcUs - predicted;
+        lastErrorUs_ = error;
+        if (error > STEP_US || error < -STEP_US) {
+            anchor(monoUs, utcUs);
+            steps_++;
+            return true;
+        }
+        // A quarter of the drift rate since the last sample goes into the
+        // frequency; the part of the last error not yet slewed out is not drift
+        int64_t interval = monoUs - lastSampleMonoUs_;
+        if (interval >= MIN_FREQ_INTERVAL_US) {
+            int64_t drift = error - pendingSlewUs(monoUs);
+            int64_t freq = freqPpb_ + drift * 1000000000LL / interval / 4;
+            if (freq > MAX_FREQ_PPB) freq = MAX_FREQ_PPB;
+            if (freq < -MAX_FREQ_PPB) freq = -MAX_FREQ_PPB;
+            freqPpb_ = (int32_t)freq;
+        }
+        // Re-anchor at the predicted time (continuous) and slew the error out from there
+        anchorMonoUs_ = monoUs;
+        anchorUtcUs_ = predicted;
+        slewUs_ = error;
+        lastSampleMonoUs_ = monoUs;
+        return false;
+    }
+
+    /**
+     * @brief Takes over a mapping that is known to be close (e.g. kept in RTC
+     *        memory over a reset) without counting it as a reference sample.
+     */
+    void restore(int64_t monoUs, int64_t utcUs, int32_t freqPpb) {
+        anchor(monoUs, utcUs);
+        freqPpb_ = freqPpb;
+        valid_ = true;
+    }
+
+    /// UTC in µs at monotonic @p monoUs (0 before the first sample).
+    int64_t utcAt(int64_t monoUs) const {
+        if (!valid_) return 0;
+        int64_t dt = monoUs - anchorMonoUs_;
+        int64_t utc = anchorUtcUs_ + dt + dt * freqPpb_ / 1000000000LL;
+        // The slew runs for |slew| / MAX_SLEW_PPM after the anchor, then holds
+        int64_t slewed = dt > 0 ? dt * MAX_SLEW_PPM / 1000000 : 0;
+        if (slewUs_ >= 0) {
+            utc += slewed < slewUs_ ? slewed : slewUs_;
+        } else {
+            utc -= slewed < -slewUs_ ? slewed : -slewUs_;
+        }
+        return utc;
+    }
+
+    bool valid() const { return valid_; }
+    int32_t freqPpb() const { return freqPpb_; }
+    int64_t lastErrorUs() const { return lastErrorUs_; }
+    uint32_t samples() const { return samples_; }
+    uint32_t steps() const { return steps_; }
+
+    /// Error still to be slewed out at @p monoUs.
+    int64_t pendingSlewUs(int64_t monoUs) const {
+        int64_t dt = monoUs - anchorMonoUs_;
+        int64_t slewed = dt > 0 ? dt * MAX_SLEW_PPM / 1000000 : 0;
+        if (slewUs_ >= 0) return slewed < slewUs_ ? slewUs_ - slewed : 0;
+        return slewed < -slewUs_ ? slewUs_ + slewed : 0;
+    }
+
+private:
+    void anchor(int64_t monoUs, int64_t utcUs) {
+        anchorMonoUs_ = monoUs;
+        anchorUtcUs_ = utcUs;
+        slewUs_ = 0;
+        lastSampleMonoUs_ = monoUs;
+    }
+
+    bool valid_;
+    int64_t anchorMonoUs_;
+    int64_t anchorUtcUs_;
+    int64_t slewUs_;         ///< Error being slewed in from the anchor on
+    int32_t freqPpb_;        ///< Oscillator correction, parts per billion
+    int64_t lastSampleMonoUs_;
+    int64_t lastErrorUs_;
+    uint32_t samples_;
+    uint32_t steps_;
+};
+
+#endif // UTC_DISCIPLINE_H
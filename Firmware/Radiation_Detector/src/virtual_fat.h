@@ -0,0 +1,204 @@
+#ifndef VIRTUAL_FAT_H
+#define VIRTUAL_FAT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Read-only FAT16 volume that exists only as a file table. Every sector is
+// rendered when the host asks for it: the boot sector, the FAT and the root
+// directory from the table, and data sectors as a (file, byte offset) the
+// caller fills from wherever the file lives. Files take consecutive clusters
+// in the order they were added, so a file's data is one contiguous sector
+// range and a large read maps to one read of the source.
+//
+// Geometry is fixed: 512-byte sectors, 32 KB clusters, one FAT and a single
+// root directory sector, 65000 clusters (just under 2 GB of file data, which
+// is what makes it FAT16 to every host). Sectors beyond the files read as
+// zeros. No Arduino dependencies (host-compilable).
+
+struct VirtualFatFile {
+    char name[11];             ///< 8.3 without the dot, space padded ("README  TXT")
+    uint32_t size;
+    uint32_t firstCluster;     ///< 0 for an empty file
+};
+
+class VirtualFat {
+public:
+    static const uint16_t SECTOR_BYTES = 512;
+    static const uint8_t SECTORS_PER_CLUSTER = 64;
+    static const uint32_t CLUSTER_BYTES = (uint32_t)SECTOR_BYTES * SECTORS_PER_CLUSTER;
+    static const uint32_t CLUSTERS = 65000;
+    static const uint16_t FAT_SECTORS = (CLUSTERS + 2 + 255) / 256;   ///< 256 16-bit entries per sector
+    static const uint32_t ROOT_SECTOR = 1 + FAT_SECTORS;
+    static const uint32_t DATA_SECTOR = ROOT_SECTOR + 1;
+    static const uint32_t TOTAL_SECTORS = DATA_SECTOR + CLUSTERS * SECTORS_PER_CLUSTER;
+    static const uint8_t MAX_FILES = 15;                               ///< Root sector minus the volume label
+
+    VirtualFat() { reset("", 0, 0); }
+
+    /**
+     * @brief Empties the table.
+     * @param label       Volume label (up to 11 characters)
+     * @param fatDate     Date stamp of every entry, FAT encoding (fatDate())
+     * @param fatTime     Time stamp of every entry, FAT encoding (fatTime())
+     */
+    void reset(const char* label, uint16_t fatDate, uint16_t fatTime) {
+        memset(label_, ' ', sizeof(label_));
+        memcpy(label_, label, strnlen(label, sizeof(label_)));
+        date_ = fatDate;
+        time_ = fatTime;
+        fileCount_ = 0;
+        nextCluster_ = 2;
+    }
+
+    /**
+     * @brief Adds a file after the previous ones.
+     * @param name 8.3 name, e.g. "README.TXT" (upper case)
+     * @return Its index, or -1 if the table or the volume is full
+     */
+    int addFile(const char* name, uint32_t size) {
+        if (fileCount_ >= MAX_FILES) return -1;
+        uint32_t clusters = (size + CLUSTER_BYTES - 1) / CLUSTER_BYTES;
+        if (nextCluster_ + clusters > CLUSTERS + 2) return -1;
+        VirtualFatFile& file = files_[fileCount_];
+        memset(file.name, ' ', sizeof(file.name));
+        const char* dot = strchr(name, '.');
+        size_t base = dot ? (size_t)(dot - name) : strlen(name);
+        memcpy(file.name, name, base < 8 ? base : 8);
+        if (dot) memcpy(file.name + 8, dot + 1, strnlen(dot + 1, 3));
+        file.size = size;
+        file.firstCluster = clusters ? nextCluster_ : 0;
+        nextCluster_ += clusters;
+        return fileCount_++;
+    }
+
+    uint8_t fileCount() const { return fileCount_; }
+    const VirtualFatFile& file(uint8_t index) const { return files_[index]; }
+
+    /// First sector of file @p index's data.
+    uint32_t fileSector(uint8_t index) const {
+        return DATA_SECTOR + (files_[index].firstCluster - 2) * SECTORS_PER_CLUSTER;
+    }
+
+    /**
+     * @brief Renders sector @p lba into @p out, unless it holds file data.
+     * @return true if @p out now holds the sector; false if it is file data
+     *         at byte @p offset of file @p index, which the caller reads
+     */
+    bool render(uint32_t lba, uint8_t* out, uint8_t* index, uint32_t* offset) const {
+        memset(out, 0, SECTOR_BYTES);
+        if (lba == 0) {
+            renderBoot(out);
+        } else if (lba < ROOT_SECTOR) {
+            renderFat(lba - 1, out);
+        } else if (lba == ROOT_SECTOR) {
+            renderRoot(out);
+        } else if (lba < TOTAL_SECTORS) {
+            uint32_t cluster = (lba - DATA_SECTOR) / SECTORS_PER_CLUSTER + 2;
+            for (uint8_t i = 0; i < fileCount_; i++) {
+                const VirtualFatFile& f = files_[i];
+                if (!f.firstCluster || cluster < f.firstCluster) continue;
+                uint32_t at = (lba - fileSector(i)) * SECTOR_BYTES;
+                if (at >= f.size) continue; // Slack of the last cluster reads as zeros
+                *index = i;
+                *offset = at;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static uint16_t fatDate(uint16_t year, uint8_t month, uint8_t day) {
+        return year < 1980 ? 0 : (uint16_t)(((year - 1980) << 9) | (month << 5) | day);
+    }
+
+    static uint16_t fatTime(uint8_t hour, uint8_t minute, uint8_t second) {
+        return (uint16_t)((hour << 11) | (minute << 5) | (second / 2));
+    }
+
+private:
+    static void put16(uint8_t* p, uint16_t v) {
+        p[0] = v & 0xFF;
+        p[1] = v >> 8;
+    }
+
+    static void put32(uint8_t* p, uint32_t v) {
+        put16(p, v & 0xFFFF);
+        put16(p + 2, v >> 16);
+    }
+
+    void renderBoot(uint8_t* out) const {
+        static const uint8_t jump[3] = {0xEB, 0x3C, 0x90};
+        memcpy(out, jump, 3);
+        memcpy(out + 3, "MSDOS5.0", 8);
+        put16(out + 11, SECTOR_BYTES);
+        out[13] = SECTORS_PER_CLUSTER;
+        put16(out + 14, 1);                    // Reserved sectors: the boot sector
+        out[16] = 1;                           // FATs
+        put16(out + 17, SECTOR_BYTES / 32);    // Root directory entries
+        put16(out + 19, 0);                    // Total sectors in the 32-bit field
+        out[21] = 0xF8;                        // Fixed disk
+        put16(out + 22, FAT_SECTORS);
+        put16(out + 24, 63);                   // Sectors per track and heads, unused
+        put16(out + 26, 255);
+        put32(out + 32, TOTAL_SECTORS);
+        out[36] = 0x80;
+        out[38] = 0x29;                        // Extended boot signature
+        put32(out + 39, ((uint32_t)date_ << 16) | time_); // Volume serial: changes with every snapshot
+        memcpy(out + 43, label_, sizeof(label_));
+        memcpy(out + 54, "FAT16   ", 8);
+        out[510] = 0x55;
+        out[511] = 0xAA;
+    }
+
+    void renderFat(uint32_t fatSector, uint8_t* out) const {
+        uint32_t first = fatSector * (SECTOR_BYTES / 2);
+        for (uint32_t e = 0; e < SECTOR_BYTES / 2; e++) {
+            uint32_t cluster = first + e;
+            uint16_t value = 0;
+            if (cluster == 0) {
+                value = 0xFFF8;                // Media byte
+            } else if (cluster == 1) {
+                value = 0xFFFF;
+            } else {
+                for (uint8_t i = 0; i < fileCount_; i++) {
+                    const VirtualFatFile& f = files_[i];
+                    uint32_t clusters = (f.size + CLUSTER_BYTES - 1) / CLUSTER_BYTES;
+                    if (!f.firstCluster || cluster < f.firstCluster || cluster >= f.firstCluster + clusters) continue;
+                    value = cluster + 1 == f.firstCluster + clusters ? 0xFFFF : (uint16_t)(cluster + 1);
+                    break;
+                }
+            }
+            put16(out + e * 2, value);
+        }
+    }
+
+    void renderRoot(uint8_t* out) const {
+        memcpy(out, label_, sizeof(label_));
+        out[11] = 0x08;                        // Volume label
+        put16(out + 22, time_);
+        put16(out + 24, date_);
+        for (uint8_t i = 0; i < fileCount_; i++) {
+            uint8_t* entry = out + 32 * (i + 1);
+            memcpy(entry, files_[i].name, 11);
+            entry[11] = 0x01;                  // Read-only
+            put16(entry + 14, time_);          // Created
+            put16(entry + 16, date_);
+            put16(entry + 18, date_);          // Accessed
+            put16(entry + 22, time_);          // Written
+            put16(entry + 24, date_);
+            put16(entry + 26, (uint16_t)files_[i].firstCluster);
+            put32(entry + 28, files_[i].size);
+        }
+    }
+
+    char label_[11];
+    uint16_t date_;
+    uint16_t time_;
+    VirtualFatFile files_[MAX_FILES];
+    uint8_t fileCount_;
+    uint32_t nextCluster_;
+};
+
+#endif // VIRTUAL_FAT_H
@@ -0,0 +1,124 @@
+// Minimal canvas charts for the dashboard, served from flash (no CDN):
+// line charts over a zero-based axis with a light grid, and a half-ring gauge.
+// MiniChart.line(canvas, {labels, color, fill, unit}).set(values)
+// MiniChart.gauge(canvas).set(value, max, color)
+(function (w) {
+  'use strict';
+  // Sizes the backing store to the CSS size times devicePixelRatio
+  function fit(canvas, aspect) {
+    const ratio = w.devicePixelRatio || 1;
+    canvas.style.width = '100%';
+    const width = canvas.clientWidth || 300;
+    const height = Math.round(width * aspect);
+    canvas.style.height = height + 'px';
+    canvas.width = width * ratio;
+    canvas.height = height * ratio;
+    const g = canvas.getContext('2d');
+    g.setTransform(ratio, 0, 0, ratio, 0, 0);
+    return { g: g, width: width, height: height };
+  }
+  // 1, 2 or 5 times a power of ten at or above v
+  function niceMax(v) {
+    if (!(v > 0)) return 1;
+    const p = Math.pow(10, Math.floor(Math.log10(v)));
+    const m = v / p;
+    return (m <= 1 ? 1 : m <= 2 ? 2 : m <= 5 ? 5 : 10) * p;
+  }
+  function redrawOnResize(chart) {
+    let pending = 0;
+    w.addEventListener('resize', function () {
+      clearTimeout(pending);
+      pending = setTimeout(function () { chart.draw(); }, 100);
+    });
+  }
+
+  function Line(canvas, options) {
+    this.canvas = canvas;
+    this.o = options;
+    this.data = [];
+    redrawOnResize(this);
+    this.draw();
+  }
+  Line.prototype.set = function (data) {
+    this.data = data || [];
+    this.draw();
+  };
+  Line.prototype.draw = function () {
+    const f = fit(this.canvas, 0.5), g = f.g, o = this.o, d = this.data;
+    const n = Math.max(o.labels.length, 2);
+    const left = 44, right = 10, top = 22, bottom = 22;
+    const pw = f.width - left - right, ph = f.height - top - bottom;
+    const max = niceMax(Math.max.apply(null, d.concat([0])));
+    const x = function (i) { return left + pw * i / (n - 1); };
+    const y = function (v) { return top + ph - ph * Math.min(v, max) / max; };
+    g.clearRect(0, 0, f.width, f.height);
+    g.font = '11px sans-serif';
+    g.lineWidth = 1;
+    g.strokeStyle = 'rgba(255, 255, 255, 0.1)';
+    g.fillStyle = '#fff';
+    g.textAlign = 'right';
+    for (let i = 0; i <= 4; i++) {
+      const yy = Math.round(y(max * i / 4)) + 0.5;
+      g.beginPath();
+      g.moveTo(left, yy);
+      g.lineTo(left + pw, yy);
+      g.stroke();
+      g.fillText(+(max * i / 4).toPrecision(3), left - 6, yy + 4);
+    }
+    g.textAlign = 'center';
+    const every = Math.ceil(o.labels.length / 8);
+    for (let i = 0; i < o.labels.length; i += every) g.fillText(o.labels[i], x(i), f.height - 6);
+    g.textAlign = 'left';
+    g.fillText(o.unit || '', left, 12);
+    if (!d.length) return;
+    g.beginPath();
+    g.moveTo(x(0), y(d[0]));
+    for (let i = 1; i < d.length; i++) g.lineTo(x(i), y(d[i]));
+    g.strokeStyle = o.color;
+    g.lineWidth = 2;
+    g.stroke();
+    g.lineTo(x(d.length - 1), top + ph);
+    g.lineTo(x(0), top + ph);
+    g.closePath();
+    g.fillStyle = o.fill;
+    g.fill();
+  };
+
+  function Gauge(canvas) {
+    this.canvas = canvas;
+    this.value = 0;
+    this.max = 10;
+    this.color = '#7274ee';
+    redrawOnResize(this);
+    this.draw();
+  }
+  Gauge.prototype.set = function (value, max, color) {
+    if (value === this.value && max === this.max && color === this.color) return;
+    this.value = value;
+    this.max = max;
+    this.color = color;
+    this.draw();
+  };
+  Gauge.prototype.draw = function () {
+    const f = fit(this.canvas, 0.5), g = f.g;
+    const r = Math.min(f.width / 2, f.height) - 4, cx = f.width / 2, cy = f.height - 2;
+    const share = Math.max(0, Math.min(this.value / this.max, 1));
+    g.clearRect(0, 0, f.width, f.height);
+    g.lineWidth = r * 0.3;
+    g.beginPath();
+    g.arc(cx, cy, r * 0.85, Math.PI, 2 * Math.PI);
+    g.strokeStyle = '#0d1912';
+    g.stroke();
+    if (share > 0) {
+      g.beginPath();
+      g.arc(cx, cy, r * 0.85, Math.PI, Math.PI * (1 + share));
+      g.strokeStyle = this.color;
+      g.stroke();
+    }
+  };
+
+  w.MiniChart = {
+    line: function (canvas, options) { return new Line(canvas, options); },
+    gauge: function (canvas) { return new Gauge(canvas); }
+  };
+})(window);
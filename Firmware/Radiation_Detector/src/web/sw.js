@@ -0,0 +1,44 @@
+// Service worker of the dashboard: keeps the page, its chart script and the
+// manifest in a cache named after their versions, and answers them from
+// there, so the dashboard opens at once and also without the device. The
+// embed script writes the versions in; new firmware means a new worker, a
+// new cache and the old one deleted. Everything else (/api, /events, OTA)
+// goes to the network untouched.
+'use strict';
+const CACHE = 'radscan-{{PAGE_ETAG}}';
+const SHELL = ['/', '{{CHARTS_JS}}', '/manifest.webmanifest'];
+
+self.addEventListener('install', function (event) {
+  event.waitUntil(caches.open(CACHE).then(function (cache) {
+    return cache.addAll(SHELL);
+  }).then(function () {
+    return self.skipWaiting();
+  }));
+});
+
+self.addEventListener('activate', function (event) {
+  event.waitUntil(caches.keys().then(function (names) {
+    return Promise.all(names.filter(function (name) {
+      return name.indexOf('radscan-') === 0 && name !== CACHE;
+    }).map(function (name) {
+      return caches.delete(name);
+    }));
+  }).then(function () {
+    return self.clients.claim();
+  }));
+});
+
+self.addEventListener('fetch', function (event) {
+  const request = event.request;
+  if (request.method !== 'GET') return;
+  const url = new URL(request.url);
+  if (url.origin !== self.location.origin || SHELL.indexOf(url.pathname) < 0) return;
+  event.respondWith(caches.open(CACHE).then(function (cache) {
+    return cache.match(url.pathname).then(function (hit) {
+      return hit || fetch(request).then(function (response) {
+        if (response.ok) cache.put(url.pathname, response.clone());
+        return response;
+      });
+    });
+  }));
+});
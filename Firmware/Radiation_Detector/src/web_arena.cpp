@@ -0,0 +1,137 @@
+/**
+ * @file web_arena.cpp
+ * @brief The response arena of the web task and the senders built on it.
+ *
+ * Only the web task allocates from the arena and resets it, so the bump
+ * pointer needs no lock; the counters are read by "perf" and /api/sysinfo
+ * (single words, a stale value is harmless). The HTTPS front end relays its
+ * requests through the same server, so they are covered too.
+ */
+
+#include "web_arena.h"
+#include "config.h"
+#include "esp_heap_caps.h"
+
+static uint8_t* base = nullptr;
+static size_t capacity = 0;
+static size_t used = 0;
+static bool textOpen = false;
+static WebArenaStats stats;
+
+static size_t align8(size_t size) {
+    return (size + 7) & ~(size_t)7;
+}
+
+static void notePeak(size_t bytes) {
+    if (bytes > stats.peakBytes) stats.peakBytes = bytes;
+}
+
+bool initWebArena() {
+    if (base) return true;
+    base = (uint8_t*)heap_caps_malloc(WEB_ARENA_BYTES, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!base) base = (uint8_t*)heap_caps_malloc(WEB_ARENA_BYTES, MALLOC_CAP_8BIT);
+    capacity = base ? WEB_ARENA_BYTES : 0;
+    stats.capacity = capacity;
+    return base != nullptr;
+}
+
+void* webArenaAlloc(size_t size) {
+    size = align8(size);
+    if (!base || textOpen || size > capacity - used) return nullptr;
+    void* block = base + used;
+    used += size;
+    notePeak(used);
+    return block;
+}
+
+void webArenaReset() {
+    if (used) stats.resets++;
+    used = 0;
+    textOpen = false;
+}
+
+WebArenaText::WebArenaText() : buffer_(nullptr), room_(0), length_(0), spilled_(false) {
+    if (base && !textOpen && used < capacity) {
+        textOpen = true;
+        buffer_ = (char*)base + used;
+        room_ = capacity - used;
+    } else {
+        spilled_ = true;
+        stats.fallbacks++;
+    }
+}
+
+WebArenaText::~WebArenaText() {
+    if (!buffer_) return;
+    // The text stays readable until the reset; only the top is released for other blocks
+    if (!spilled_) used += align8(length_ + 1);
+    textOpen = false;
+}
+
+void WebArenaText::spill(size_t extra) {
+    spilled_ = true;
+    stats.spills++;
+    spill_.reserve(length_ + extra + length_ / 2);
+    spill_.concat(buffer_, length_);
+}
+
+size_t WebArenaText::write(const uint8_t* data, size_t size) {
+    if (!spilled_) {
+        if (length_ + size < room_) {
+            memcpy(buffer_ + length_, data, size);
+            length_ += size;
+            notePeak(used + length_ + 1);
+            return size;
+        }
+        spill(size);
+    }
+    return spill_.concat((const char*)data, size) ? size : 0;
+}
+
+void WebArenaText::trim(size_t count) {
+    if (spilled_) {
+        spill_.remove(spill_.length() > count ? spill_.length() - count : 0);
+    } else {
+        length_ = length_ > count ? length_ - count : 0;
+    }
+}
+
+const char* WebArenaText::c_str() {
+    if (spilled_) return spill_.c_str();
+    buffer_[length_] = '\0';
+    return buffer_;
+}
+
+void webSendText(WebServer& server, int code, const char* contentType, WebArenaText& text) {
+    server.send_P(code, contentType, text.c_str(), text.length());
+}
+
+void webSendJson(WebServer& server, int code, JsonVariantConst doc) {
+    size_t length = measureJson(doc);
+    char* body = (char*)webArenaAlloc(length + 1);
+    if (body) {
+        serializeJson(doc, body, length + 1);
+        server.send_P(code, "application/json", body, length);
+        return;
+    }
+    stats.fallbacks++;
+    String json;
+    json.reserve(length + 1);
+    serializeJson(doc, json);
+    server.send(code, "application/json", json);
+}
+
+WebArenaStats getWebArenaStats() {
+    return stats;
+}
+
+void printWebArena(Print& out) {
+    WebArenaStats s = getWebArenaStats();
+    if (!s.capacity) {
+        out.println("Web arena: not allocated, responses built on the heap");
+        return;
+    }
+    out.printf("Web arena: %lu requests, peak %lu of %lu bytes, %lu spilled to the heap, %lu built on the heap\n",
+               (unsigned long)s.resets, (unsigned long)s.peakBytes, (unsigned long)s.capacity,
+               (unsigned long)s.spills, (unsigned long)s.fallbacks);
+}
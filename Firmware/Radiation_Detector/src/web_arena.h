@@ -0,0 +1,85 @@
+#ifndef WEB_ARENA_H
+#define WEB_ARENA_H
+
+#include <Arduino.h>
+#include <WebServer.h>
+#include <ArduinoJson.h>
+
+// Per-request arena for response bodies on the web task.
+// One block of WEB_ARENA_BYTES is allocated once, from PSRAM when there is
+// any, and handed out by bumping a pointer. The web task resets it after
+// every handleClient(), so each request starts with the whole block and
+// nothing a handler builds survives its response. Handlers serialise their
+// JsonDocument (itself on the JSON arena, json_arena.h) straight into it
+// with webSendJson(), or compose text in a WebArenaText, instead of growing
+// a String on the heap for every response.
+//
+// A body that does not fit is moved to a heap String and still sent; these
+// spills are counted, like requests served without the arena, so the size
+// can be checked in "perf" and /api/sysinfo. WebServer's own header and
+// argument Strings are not covered.
+
+struct WebArenaStats {
+    uint32_t capacity;     ///< 0 if the block could not be allocated
+    uint32_t resets;       ///< Requests that used the arena
+    uint32_t peakBytes;
+    uint32_t spills;       ///< Bodies moved to the heap because the arena was full
+    uint32_t fallbacks;    ///< Bodies built on the heap: no arena, or one already being written
+};
+
+// Allocates the block. Called by webServiceBegin().
+bool initWebArena();
+
+// @p size bytes, 8-byte aligned, valid until the response is sent. Web task
+// only. @return nullptr if the arena is full
+void* webArenaAlloc(size_t size);
+
+// Releases everything. The web task calls it after each handleClient().
+void webArenaReset();
+
+/**
+ * @brief Response text built at the top of the arena; Print, so
+ *        serializeJson() and printf() write into it.
+ *
+ * One at a time: it grows in place until it is destroyed. Past the end of the
+ * arena (or while another one is open) it continues in a heap String.
+ */
+class WebArenaText : public Print {
+public:
+    WebArenaText();
+    ~WebArenaText();
+
+    WebArenaText(const WebArenaText&) = delete;
+    WebArenaText& operator=(const WebArenaText&) = delete;
+
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t* data, size_t size) override;
+
+    // Drops the last @p count characters.
+    void trim(size_t count);
+
+    const char* c_str();
+    size_t length() const { return spilled_ ? spill_.length() : length_; }
+
+private:
+    void spill(size_t extra);
+
+    char* buffer_;
+    size_t room_;          ///< Bytes of the arena it may use, including the terminator
+    size_t length_;
+    bool spilled_;
+    String spill_;
+};
+
+// Sends @p text as the body.
+void webSendText(WebServer& server, int code, const char* contentType, WebArenaText& text);
+
+// Serialises @p doc into the arena (a heap String if it does not fit) and sends it.
+void webSendJson(WebServer& server, int code, JsonVariantConst doc);
+
+WebArenaStats getWebArenaStats();
+
+// One line: size, peak, spills and fallbacks ("perf").
+void printWebArena(Print& out);
+
+#endif // WEB_ARENA_H
@@ -0,0 +1,110 @@
+/**
+ * @file web_rate_limit.cpp
+ * @brief Client table, the route-chain gate and the "webrate" report.
+ *
+ * The table is shared by the web task and the HTTPS task. Both call
+ * webRateAdmit() once per request, and it takes a spinlock for a lookup in at
+ * most WEB_RATE_CLIENTS entries. The counters live under the same lock.
+ */
+
+#include "web_rate_limit.h"
+#include "config.h"
+#include "web_service.h"
+#include "ota_guard.h"
+#include "freertos/FreeRTOS.h"
+
+static ClientRateTable<WEB_RATE_CLIENTS> table({WEB_RATE_API_PER_MIN, WEB_RATE_API_BURST},
+                                               {WEB_RATE_BULK_PER_MIN, WEB_RATE_BULK_BURST});
+static WebRateStats stats;
+static portMUX_TYPE rateLock = portMUX_INITIALIZER_UNLOCKED;
+
+uint32_t webRateAdmit(uint32_t ip, const char* uri) {
+    uint8_t cls = webTrafficClass(uri);
+    // Refused before the table so the upload's own polling keeps its budget
+    bool shed = cls == WEB_TRAFFIC_BULK && otaGuardActive();
+    uint32_t nowMs = millis();
+
+    portENTER_CRITICAL(&rateLock);
+    uint32_t wait = 0;
+    if (shed) {
+        wait = WEB_RATE_OTA_RETRY_S;
+        stats.shed++;
+    } else if (WEB_RATE_LIMIT_ENABLED) {
+        wait = table.admit(ip, cls, nowMs);
+    }
+    if (wait && !shed) stats.limited[cls]++;
+    else if (!wait) stats.admitted[cls]++;
+    portEXIT_CRITICAL(&rateLock);
+    return wait;
+}
+
+void webRateReject(WebServer& server, uint32_t retryAfterS) {
+    server.sendHeader("Retry-After", String(retryAfterS));
+    server.sendHeader("Access-Control-Allow-Origin", "*");
+    server.send(429, "text/plain", "Too many requests");
+}
+
+/**
+ * @brief Claims the requests over budget and answers them with 429.
+ *
+ * WebServer asks the handlers in order whether they take a request, before it
+ * reads the headers. Admitted requests are passed on to the routes.
+ */
+class RateGate : public RequestHandler {
+public:
+    bool canHandle(HTTPMethod method, String uri) override {
+        IPAddress remote = server_->client().remoteIP();
+        if (remote[0] == 127) return false; // The HTTPS front end, which checked the client itself
+        retryAfterS_ = webRateAdmit((uint32_t)remote, uri.c_str());
+        return retryAfterS_ != 0;
+    }
+
+    bool handle(WebServer& server, HTTPMethod method, String uri) override {
+        webRateReject(server, retryAfterS_);
+        return true;
+    }
+
+    void bind(WebServer& server) { server_ = &server; }
+
+private:
+    WebServer* server_ = nullptr;
+    uint32_t retryAfterS_ = 0;  ///< Web task only, from canHandle() to handle()
+};
+
+static RateGate gate;
+
+RequestHandler& webRateLimitHandler() {
+    gate.bind(webServer());
+    return gate;
+}
+
+WebRateStats getWebRateStats() {
+    portENTER_CRITICAL(&rateLock);
+    WebRateStats s = stats;
+    s.clients = table.clients();
+    s.evictions = table.evictions();
+    const ClientRateTable<WEB_RATE_CLIENTS>::Entry* worst = table.worst();
+    s.worstIp = worst ? worst->ip : 0;
+    s.worstLimited = worst ? worst->limited : 0;
+    portEXIT_CRITICAL(&rateLock);
+    return s;
+}
+
+void printWebRateLimit(Print& out) {
+    static const char* CLASS_NAMES[WEB_TRAFFIC_CLASSES] = {"priority", "api", "bulk"};
+    WebRateStats s = getWebRateStats();
+    out.printf("Web rate limit: %s, API %u/min (burst %u), bulk %u/min (burst %u), %u of %u clients tracked\n",
+               WEB_RATE_LIMIT_ENABLED ? "ON" : "OFF", (unsigned)WEB_RATE_API_PER_MIN, (unsigned)WEB_RATE_API_BURST,
+               (unsigned)WEB_RATE_BULK_PER_MIN, (unsigned)WEB_RATE_BULK_BURST, (unsigned)s.clients,
+               (unsigned)WEB_RATE_CLIENTS);
+    for (uint8_t c = 0; c < WEB_TRAFFIC_CLASSES; c++) {
+        out.printf("  %-8s %8lu admitted %8lu limited\n", CLASS_NAMES[c], (unsigned long)s.admitted[c],
+                   (unsigned long)s.limited[c]);
+    }
+    out.printf("  %lu bulk refused during OTA, %lu clients evicted\n", (unsigned long)s.shed,
+               (unsigned long)s.evictions);
+    if (s.worstIp) {
+        out.printf("  most limited: %s (%lu refused)\n", IPAddress(s.worstIp).toString().c_str(),
+                   (unsigned long)s.worstLimited);
+    }
+}
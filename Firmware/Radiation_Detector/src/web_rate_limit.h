@@ -0,0 +1,49 @@
+#ifndef WEB_RATE_LIMIT_H
+#define WEB_RATE_LIMIT_H
+
+#include <Arduino.h>
+#include <WebServer.h>
+#include "rate_limit.h"
+
+// Per-client rate limits and traffic priority for the web server
+// (WEB_RATE_LIMIT_ENABLED). The server answers one client at a time, so a
+// single aggressive poller could keep it busy and delay everyone else.
+// Requests over a client's budget get 429 with Retry-After. That answer costs
+// about as much as a 304, and the handler never runs. While a firmware upload
+// runs, bulk exports are refused outright, so the upload gets the network
+// task and the flash. The dashboard page and OTA are never limited
+// (classes: rate_limit.h).
+//
+// The check happens as the server looks up the route, before any handler
+// runs. Plain HTTP clients are checked by address in the web task. HTTPS
+// clients reach the server over loopback, so the HTTPS front end
+// (https_service.h) checks them by their real address before passing the
+// request on. Measurement and the UI run at higher priority or on the other
+// core, so refused requests cost them nothing.
+
+struct WebRateStats {
+    uint32_t admitted[WEB_TRAFFIC_CLASSES];
+    uint32_t limited[WEB_TRAFFIC_CLASSES];  ///< 429 for an empty bucket
+    uint32_t shed;                          ///< Bulk requests refused during an OTA upload
+    uint32_t evictions;                     ///< Clients dropped from the table for a new one
+    uint8_t clients;                        ///< Addresses in the table
+    uint32_t worstIp;                       ///< Client with the most refusals (network order), 0 if none
+    uint32_t worstLimited;
+};
+
+// Charges a request for @p uri from @p ip (network order) to its budget.
+// Safe from any task.
+// @return 0 if admitted, else the seconds to send in Retry-After
+uint32_t webRateAdmit(uint32_t ip, const char* uri);
+
+// Answers 429 with Retry-After on @p server.
+void webRateReject(WebServer& server, uint32_t retryAfterS);
+
+// First handler in the route chain after the request counter (web_service.cpp).
+RequestHandler& webRateLimitHandler();
+
+WebRateStats getWebRateStats();
+
+void printWebRateLimit(Print& out);
+
+#endif // WEB_RATE_LIMIT_H
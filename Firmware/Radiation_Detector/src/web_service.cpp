@@ -0,0 +1,230 @@
+/**
+ * @file web_service.cpp
+ * @brief Route registry, shared response headers and the web task.
+ */
+
+#include "web_service.h"
+#include "config.h"
+#include "dashboard.h"
+#include "sysinfo.h"
+#include "supervisor.h"
+#include "ota_guard.h"
+#include "web_rate_limit.h"
+#include "web_arena.h"
+#include "ethernet_link.h"
+#include "debug.h"
+#include <WiFi.h>
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <atomic>
+
+// The web server runs on its own task on the network core, away from LVGL and the
+// measurement. WebServer serves one client at a time, which also bounds the work
+// a burst of requests can cause.
+static const uint32_t WEB_TASK_STACK       = 8192;
+static const TickType_t WEB_TASK_POLL      = pdMS_TO_TICKS(2);
+
+static WebServer server(80);
+static WebRoutesFn routeTable[WEB_SERVICE_MAX_ROUTES];
+static uint8_t routeCount = 0;
+static WebPollFn pollTable[WEB_SERVICE_MAX_POLLS];
+static uint8_t pollCount = 0;
+static bool running = false;
+static TaskHandle_t webTaskHandle = NULL;
+
+static std::atomic<uint32_t> requestCount(0);
+static std::atomic<uint32_t> lastRequestMs(0);
+static WebLatencyHistogram requestLatency;   ///< Web task writes
+static int64_t requestStartUs = 0;           ///< Web task: the request being handled, 0 if none
+
+/**
+ * @brief First handler in the chain: notes every request and handles none.
+ *
+ * WebServer asks each handler in turn whether it takes a request, so this
+ * sees all of them without a line in every route.
+ */
+class RequestCounter : public RequestHandler {
+public:
+    bool canHandle(HTTPMethod method, String uri) override {
+        lastRequestMs.store(millis());
+        requestCount.fetch_add(1);
+        requestStartUs = esp_timer_get_time();
+        return false;
+    }
+};
+
+static RequestCounter requestCounter;
+
+/**
+ * @brief With HTTPS_ONLY, sends every client but the HTTPS front end
+ *        (https_service.h), which connects over loopback, to the same URL over HTTPS.
+ *
+ * 308 keeps the method and the body, so API clients follow it as well as browsers.
+ */
+class HttpsRedirect : public RequestHandler {
+public:
+    bool canHandle(HTTPMethod method, String uri) override {
+        return HTTPS_ENABLED && HTTPS_ONLY && server.client().remoteIP()[0] != 127;
+    }
+
+    bool handle(WebServer& s, HTTPMethod method, String uri) override {
+        String host = s.hostHeader();
+        int colon = host.indexOf(':');
+        if (colon >= 0) host.remove(colon);
+        if (host.length() == 0) host = networkLocalIP().toString();
+        String location = "https://" + host;
+        if (HTTPS_PORT != 443) location += ":" + String(HTTPS_PORT);
+        location += uri;
+        char separator = '?';
+        for (int i = 0; i < s.args(); i++) {
+            if (s.argName(i) == "plain") continue; // The body, not the query
+            location += separator;
+            location += s.argName(i) + "=" + s.arg(i);
+            separator = '&';
+        }
+        s.sendHeader("Location", location);
+        s.send(308, "text/plain", "");
+        return true;
+    }
+};
+
+static HttpsRedirect httpsRedirect;
+
+// Each set is "<first name>" and "<first value>\r\n<more lines>"; built once in webServiceBegin()
+static String headerName[WEB_HEADERS_COUNT];
+static String headerValue[WEB_HEADERS_COUNT];
+
+static void buildHeaders() {
+    for (uint8_t i = 0; i < WEB_HEADERS_COUNT; i++) headerName[i] = "Access-Control-Allow-Origin";
+    headerValue[WEB_HEADERS_CORS] = "*";
+    headerValue[WEB_HEADERS_NO_CACHE] = "*\r\nCache-Control: no-cache";
+    headerValue[WEB_HEADERS_NO_STORE] = "*\r\nCache-Control: no-store";
+    headerValue[WEB_HEADERS_LIVE] = "*\r\n"
+                                    "Access-Control-Allow-Methods: GET\r\n"
+                                    "Access-Control-Allow-Headers: Content-Type\r\n"
+                                    "Access-Control-Expose-Headers: ETag\r\n"
+                                    "Cache-Control: no-cache\r\n"
+                                    "Vary: Accept";
+}
+
+/**
+ * @brief Serves HTTP requests and OTA uploads independently of the UI loop.
+ *
+ * A slow client or a firmware upload only occupies this task; LVGL and the
+ * alarms keep running.
+ */
+static bool restartWebTask();
+
+static void webTask(void *parameter) {
+    DEBUG_PRINTF("Web server task started on Core %d\n", xPortGetCoreID());
+    supervisorAttach("web", SUPERVISOR_WEB_STALL_MS, restartWebTask);
+
+    while (true) {
+        supervisorHeartbeat();
+        server.handleClient();
+        if (requestStartUs) {
+            requestLatency.add((uint32_t)(esp_timer_get_time() - requestStartUs));
+            requestStartUs = 0;
+        }
+        webArenaReset(); // The response is out; the next request starts with the whole arena
+        uint32_t nowMs = millis();
+        for (uint8_t i = 0; i < pollCount; i++) pollTable[i](nowMs);
+        vTaskDelay(WEB_TASK_POLL);
+    }
+}
+
+static bool startWebTask() {
+    return xTaskCreatePinnedToCore(webTask, "WebTask", WEB_TASK_STACK, NULL,
+                                   NETWORK_TASK_PRIORITY, &webTaskHandle, TASK_CORE_NETWORK) == pdPASS;
+}
+
+/**
+ * @brief Supervisor restart of a stalled web task (supervisor.h): a client
+ *        that never finishes its request no longer blocks every other one.
+ *
+ * The routes stay attached; the listener and the stuck connection are closed
+ * and a fresh task serves from the next request on.
+ */
+static bool restartWebTask() {
+    // An unfinished upload is left to the reboot; the old image stays the boot partition
+    if (!webTaskHandle || otaGuardActive()) return false;
+    TaskHandle_t stalled = webTaskHandle;
+    sysInfoReplaceTask(stalled, nullptr);
+    vTaskDelete(stalled);
+    webTaskHandle = NULL;
+
+    server.client().stop();
+    server.begin(); // Closes and reopens the listener
+    if (!startWebTask()) {
+        DEBUG_PRINTLN("Error: web task not restarted");
+        return false;
+    }
+    sysInfoReplaceTask(nullptr, webTaskHandle);
+    return true;
+}
+
+bool webServiceRoutes(WebRoutesFn routes) {
+    if (running || routeCount >= WEB_SERVICE_MAX_ROUTES) return false;
+    routeTable[routeCount++] = routes;
+    return true;
+}
+
+bool webServicePoll(WebPollFn poll) {
+    if (running || pollCount >= WEB_SERVICE_MAX_POLLS) return false;
+    pollTable[pollCount++] = poll;
+    return true;
+}
+
+bool webServiceBegin() {
+    if (running) return webTaskHandle != NULL;
+    buildHeaders();
+    if (!initWebArena()) DEBUG_PRINTLN("Web service: no response arena, bodies built on the heap");
+    collectRequestHeaders(server);
+    server.addHandler(&requestCounter);
+    server.addHandler(&webRateLimitHandler()); // Refused requests never reach a route
+    server.addHandler(&httpsRedirect);
+    for (uint8_t i = 0; i < routeCount; i++) routeTable[i](server);
+    server.begin();
+    running = true; // The routes are attached; never again
+
+    // From here on requests are handled by the web task, not the UI loop
+    if (!startWebTask()) {
+        DEBUG_PRINTLN("Error: web task not created");
+        return false;
+    }
+    sysInfoWatchTask(webTaskHandle, WEB_TASK_STACK);
+    DEBUG_PRINTF("Web service: %u route groups, %u loop hooks\n", (unsigned)routeCount, (unsigned)pollCount);
+    return true;
+}
+
+bool webServiceRunning() {
+    return running;
+}
+
+uint32_t webServiceRequests() {
+    return requestCount.load();
+}
+
+uint32_t webServiceLastRequestMs() {
+    return lastRequestMs.load();
+}
+
+WebLatencyHistogram webServiceLatency() {
+    return requestLatency;
+}
+
+WebServer& webServer() {
+    return server;
+}
+
+void webSendHeaders(WebServer& target, WebHeaders set) {
+    target.sendHeader(headerName[set], headerValue[set]);
+}
+
+bool webNotModified(WebServer& target, const char* etag) {
+    target.sendHeader("ETag", etag);
+    if (!target.hasHeader("If-None-Match") || target.header("If-None-Match") != etag) return false;
+    target.send(304);
+    return true;
+}
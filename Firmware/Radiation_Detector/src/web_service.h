@@ -0,0 +1,68 @@
+#ifndef WEB_SERVICE_H
+#define WEB_SERVICE_H
+
+#include <Arduino.h>
+#include <WebServer.h>
+#include "latency_histogram.h"
+
+// The HTTP server, its route table and the web task.
+// Modules register a function that adds their routes and, if they need one, a
+// function the web task calls after every handleClient(). Everything is
+// registered in setup(); webServiceBegin() then attaches the routes in
+// registration order, starts the server and the task, once, on the first
+// WiFi connection. Later reconnects keep the same listener.
+// The web task is supervised (supervisor.h): if a request stalls it, the task
+// is replaced and the listener reopened, with the routes kept.
+//
+// Headers shared by many handlers are built once and sent with one
+// sendHeader() call (WebServer appends each call to its response header
+// string, so one call per set instead of one per line).
+
+#define WEB_SERVICE_MAX_ROUTES 16
+#define WEB_SERVICE_MAX_POLLS  4
+
+typedef LatencyHistogramN<24> WebLatencyHistogram;   ///< Up to ~17 s
+
+typedef void (*WebRoutesFn)(WebServer& server);
+typedef void (*WebPollFn)(uint32_t nowMs);
+
+enum WebHeaders {
+    WEB_HEADERS_CORS = 0,   ///< Access-Control-Allow-Origin: *
+    WEB_HEADERS_NO_CACHE,   ///< CORS, Cache-Control: no-cache
+    WEB_HEADERS_NO_STORE,   ///< CORS, Cache-Control: no-store
+    WEB_HEADERS_LIVE,       ///< CORS for GET, revalidate by ETag, Vary: Accept (/api/data)
+    WEB_HEADERS_COUNT
+};
+
+// Adds a route group. @return false once the service runs or the table is full
+bool webServiceRoutes(WebRoutesFn routes);
+
+// Adds a function for the web task loop. @return false once the service runs or the table is full
+bool webServicePoll(WebPollFn poll);
+
+// Attaches the routes, starts the server and the web task. Later calls do nothing.
+// @return true if the service is running
+bool webServiceBegin();
+
+bool webServiceRunning();
+
+// Requests seen since boot and millis() of the last one (wifi_power.h sessions).
+// Counted as the server looks up a route, before the handler runs.
+uint32_t webServiceRequests();
+uint32_t webServiceLastRequestMs();
+
+// Time from the route lookup to the response sent, of every request since
+// boot (a copy; the web task writes it).
+WebLatencyHistogram webServiceLatency();
+
+// The server object, for handlers that answer outside their route function.
+WebServer& webServer();
+
+// Queues a header set for the next response of @p server.
+void webSendHeaders(WebServer& server, WebHeaders set);
+
+// Queues "ETag: @p etag" and answers 304 if the request's If-None-Match is that tag.
+// @return true if the 304 was sent and the handler is done
+bool webNotModified(WebServer& server, const char* etag);
+
+#endif // WEB_SERVICE_H
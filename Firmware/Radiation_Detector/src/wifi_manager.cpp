@@ -0,0 +1,580 @@
+/**
+ * @file wifi_manager.cpp
+ * @brief Event-driven WiFi connection state machine with reconnect backoff.
+ *
+ * The WiFi event callback runs on the system event task and only sets flags;
+ * all state transitions, timeouts and the state handler run in
+ * wifiManagerLoop() on the UI task, which keeps LVGL calls on one thread.
+ * The event callback also stamps association and IP times, so the measured
+ * durations do not include the UI task's polling interval.
+ *
+ * The RTC copy of the link cache is valid only after a soft reset or a wake
+ * from sleep, as in time_base.cpp. After a power cycle, the BSSID and channel
+ * come from Preferences; the address does, too, but without a lease time it
+ * is not reused. Preferences are written only when the link itself changes
+ * (a new access point or address), not on every connection.
+ *
+ * Scans use the Arduino asynchronous scan: the driver hops channels on its
+ * own, and WiFiScanClass has the records by the time the scan-done event
+ * reaches onWifiEvent(), which condenses them into the cache under a spinlock
+ * and frees them. A connection attempt stops a running scan and asks for
+ * another one, which starts once the attempt is over.
+ */
+
+#include "wifi_manager.h"
+#include "config.h"
+#include "time_base.h"
+#include "wifi_power.h"
+#include "debug.h"
+#include <WiFi.h>
+#include <Preferences.h>
+#include "esp_wifi.h"
+#include "esp_timer.h"
+#include "esp_system.h"
+#include "esp_attr.h"
+#include "esp_rom_crc.h"
+
+static const uint32_t CONNECT_TIMEOUT_MS = 10000;  ///< Same budget as the old 20 x 500 ms loop
+static const uint32_t BACKOFF_MIN_MS     = 2000;
+static const uint32_t BACKOFF_MAX_MS     = 60000;
+static const uint32_t LINK_CACHE_MAGIC   = 0x57465452;  ///< "RTFW"
+static const uint32_t SCAN_TIMEOUT_MS    = 15000;  ///< A scan-done event that never came
+
+/// Last connection's link, as kept in RTC memory and Preferences
+struct WifiLinkCache {
+    uint32_t magic;
+    uint32_t ssidCrc;       ///< The network the link belongs to
+    uint8_t bssid[6];
+    uint8_t channel;
+    uint8_t reserved;
+    uint32_t ip;            ///< Network byte order, as IPAddress stores it
+    uint32_t gateway;
+    uint32_t subnet;
+    uint32_t dns;
+    uint32_t leaseUtc;      ///< When DHCP gave the address; 0 if unknown (never in Preferences)
+    uint32_t crc;
+};
+
+RTC_NOINIT_ATTR static WifiLinkCache rtcLink;
+
+static WifiState state = WIFI_STATE_IDLE;
+static WifiStateHandler stateHandler = nullptr;
+static volatile bool gotIpEvent = false;
+static volatile bool disconnectedEvent = false;
+static volatile int64_t associatedUs = 0;   ///< Stamped by the event callback; 0 until associated
+static volatile int64_t gotIpUs = 0;
+
+static WifiLinkCache link;                  ///< Valid when link.magic == LINK_CACHE_MAGIC
+static bool linkRestored = false;
+static bool fastAttempt = false;            ///< Current attempt uses the cached link
+static bool staticAttempt = false;          ///< ... and its address
+static bool staticLease = false;            ///< Connected on a reused address; back to DHCP at the window's end
+static int64_t attemptStartUs = 0;          ///< First try of the current attempt, fast or not
+static int64_t tryStartUs = 0;
+static uint32_t fastFallbacks = 0;
+static WifiConnectStats lastStats;
+static WifiConnectStats bootStats;
+static bool haveBootStats = false;
+
+static String targetSsid;
+static String targetPassword;
+static bool persistOnConnect = false;
+static uint32_t stateSinceMs = 0;
+static uint32_t backoffMs = BACKOFF_MIN_MS;
+
+static portMUX_TYPE scanLock = portMUX_INITIALIZER_UNLOCKED;
+static WifiNetwork networks[WIFI_SCAN_MAX_NETWORKS];  ///< scanLock
+static uint8_t networkCount = 0;                     ///< scanLock
+static uint32_t scanVersion = 0;                     ///< scanLock
+static uint32_t scanDoneMs = 0;                      ///< scanLock
+static volatile bool scanRequested = false;
+static volatile bool scanRunning = false;
+static uint32_t scanStartMs = 0;
+
+static uint8_t suspendedBy = 0;             ///< WifiSuspendSource bits
+static bool suspended = false;
+static bool resumeWanted = false;           ///< A connection to retake on resume
+
+/**
+ * @brief Condenses WiFiScanClass's results into the cache; on the event task.
+ */
+static void collectScan() {
+    int16_t found = WiFi.scanComplete();
+    if (found < 0) {
+        scanRunning = false; // Failed or stopped; the cache keeps the last results
+        return;
+    }
+    WifiNetwork next[WIFI_SCAN_MAX_NETWORKS];
+    uint8_t count = 0;
+    for (int16_t i = 0; i < found; i++) {
+        String ssid = WiFi.SSID(i);
+        if (ssid.length() == 0 || ssid.length() >= sizeof(next[0].ssid)) continue;
+        int8_t rssi = (int8_t)WiFi.RSSI(i);
+        uint8_t j = 0;
+        while (j < count && strcmp(next[j].ssid, ssid.c_str()) != 0) j++;
+        if (j < count) {
+            if (rssi <= next[j].rssi) continue; // A weaker access point of a listed SSID
+            memmove(&next[j], &next[j + 1], (count - j - 1) * sizeof(WifiNetwork));
+            count--;
+        } else if (count == WIFI_SCAN_MAX_NETWORKS) {
+            if (rssi <= next[count - 1].rssi) continue;
+            count--; // The weakest makes room
+        }
+        // Insert in RSSI order
+        j = count;
+        while (j > 0 && next[j - 1].rssi < rssi) j--;
+        memmove(&next[j + 1], &next[j], (count - j) * sizeof(WifiNetwork));
+        strlcpy(next[j].ssid, ssid.c_str(), sizeof(next[j].ssid));
+        next[j].rssi = rssi;
+        next[j].channel = (uint8_t)WiFi.channel(i);
+        next[j].secure = WiFi.encryptionType(i) != WIFI_AUTH_OPEN;
+        count++;
+    }
+    WiFi.scanDelete();
+
+    portENTER_CRITICAL(&scanLock);
+    if (count) memcpy(networks, next, count * sizeof(WifiNetwork));
+    networkCount = count;
+    scanVersion++;
+    scanDoneMs = millis();
+    portEXIT_CRITICAL(&scanLock);
+    scanRunning = false;
+}
+
+/**
+ * @brief Stops a running scan before an attempt; the request stands for afterwards.
+ */
+static void stopScan() {
+    if (!scanRunning) return;
+    esp_wifi_scan_stop();
+    scanRunning = false;
+    scanRequested = true;
+}
+
+static void onWifiEvent(WiFiEvent_t event) {
+    switch (event) {
+        case ARDUINO_EVENT_WIFI_STA_CONNECTED:
+            associatedUs = esp_timer_get_time();
+            break;
+        case ARDUINO_EVENT_WIFI_STA_GOT_IP:
+            gotIpUs = esp_timer_get_time();
+            gotIpEvent = true;
+            break;
+        case ARDUINO_EVENT_WIFI_STA_DISCONNECTED:
+        case ARDUINO_EVENT_WIFI_STA_LOST_IP:
+            disconnectedEvent = true;
+            break;
+        case ARDUINO_EVENT_WIFI_SCAN_DONE:
+            if (scanRunning) collectScan();
+            break;
+        default:
+            break;
+    }
+}
+
+static void setState(WifiState next, uint32_t nowMs) {
+    state = next;
+    stateSinceMs = nowMs;
+    if (stateHandler) {
+        stateHandler(next);
+    }
+}
+
+static uint32_t linkCrc(const WifiLinkCache& cache) {
+    return esp_rom_crc32_le(0, (const uint8_t*)&cache, offsetof(WifiLinkCache, crc));
+}
+
+static uint32_t ssidCrc(const String& ssid) {
+    return esp_rom_crc32_le(0, (const uint8_t*)ssid.c_str(), ssid.length());
+}
+
+/**
+ * @brief Loads the link cache once: RTC memory after a soft reset, Preferences otherwise.
+ */
+static void restoreLink() {
+    if (linkRestored) return;
+    linkRestored = true;
+    esp_reset_reason_t reason = esp_reset_reason();
+    bool softReset = reason != ESP_RST_POWERON && reason != ESP_RST_BROWNOUT && reason != ESP_RST_UNKNOWN;
+    if (softReset && rtcLink.magic == LINK_CACHE_MAGIC && rtcLink.crc == linkCrc(rtcLink)) {
+        link = rtcLink;
+        return;
+    }
+    memset(&link, 0, sizeof(link));
+    Preferences prefs;
+    prefs.begin("wifi", true);
+    if (prefs.getBytesLength("link") == sizeof(link)) {
+        prefs.getBytes("link", &link, sizeof(link));
+        if (link.magic != LINK_CACHE_MAGIC || link.crc != linkCrc(link)) memset(&link, 0, sizeof(link));
+    }
+    prefs.end();
+}
+
+static void dropLink() {
+    link.magic = 0;
+    rtcLink.magic = 0;
+}
+
+/**
+ * @brief Caches the link just connected; Preferences only when it differs from the stored one.
+ */
+static void saveLink(bool staticIp) {
+    WifiLinkCache next;
+    memset(&next, 0, sizeof(next));
+    next.magic = LINK_CACHE_MAGIC;
+    next.ssidCrc = ssidCrc(targetSsid);
+    const uint8_t* bssid = WiFi.BSSID();
+    if (bssid) memcpy(next.bssid, bssid, sizeof(next.bssid));
+    next.channel = (uint8_t)WiFi.channel();
+    next.ip = (uint32_t)WiFi.localIP();
+    next.gateway = (uint32_t)WiFi.gatewayIP();
+    next.subnet = (uint32_t)WiFi.subnetMask();
+    next.dns = (uint32_t)WiFi.dnsIP();
+
+    bool sameLink = link.magic == LINK_CACHE_MAGIC && link.ssidCrc == next.ssidCrc &&
+                    memcmp(link.bssid, next.bssid, sizeof(next.bssid)) == 0 && link.channel == next.channel &&
+                    link.ip == next.ip && link.gateway == next.gateway && link.subnet == next.subnet &&
+                    link.dns == next.dns;
+    if (!sameLink) {
+        next.crc = linkCrc(next);
+        Preferences prefs;
+        prefs.begin("wifi", false);
+        prefs.putBytes("link", &next, sizeof(next));
+        prefs.end();
+    }
+
+    // A reused address keeps the lease time of the DHCP exchange that gave it
+    if (staticIp && sameLink) {
+        next.leaseUtc = link.leaseUtc;
+    } else {
+        next.leaseUtc = timeBaseUtcValid() ? timeBaseUtcSeconds() : 0;
+    }
+    next.crc = linkCrc(next);
+    link = next;
+    rtcLink = next;
+}
+
+static bool leaseReusable() {
+    if (link.leaseUtc == 0 || link.ip == 0 || !timeBaseUtcValid()) return false;
+    uint32_t now = timeBaseUtcSeconds();
+    return now >= link.leaseUtc && now - link.leaseUtc < WIFI_FAST_LEASE_REUSE_S;
+}
+
+static void beginTry(bool fast) {
+    gotIpEvent = false;
+    disconnectedEvent = false;
+    associatedUs = 0;
+    gotIpUs = 0;
+    stopScan();
+    WiFi.disconnect();
+
+    fastAttempt = fast && link.magic == LINK_CACHE_MAGIC && link.ssidCrc == ssidCrc(targetSsid) &&
+                  link.channel != 0;
+    staticAttempt = fastAttempt && leaseReusable();
+    if (staticAttempt) {
+        WiFi.config(IPAddress(link.ip), IPAddress(link.gateway), IPAddress(link.subnet), IPAddress(link.dns));
+    } else {
+        WiFi.config(IPAddress((uint32_t)0), IPAddress((uint32_t)0), IPAddress((uint32_t)0)); // DHCP
+    }
+    tryStartUs = esp_timer_get_time();
+    if (fastAttempt) {
+        WiFi.begin(targetSsid.c_str(), targetPassword.c_str(), link.channel, link.bssid, false);
+    } else {
+        WiFi.begin(targetSsid.c_str(), targetPassword.c_str(), 0, nullptr, false);
+    }
+    // WiFi.begin() leaves the listen interval at the SDK default; it is only read at association
+    wifi_config_t conf;
+    if (esp_wifi_get_config(WIFI_IF_STA, &conf) == ESP_OK) {
+        conf.sta.listen_interval = wifiPowerListenInterval();
+        esp_wifi_set_config(WIFI_IF_STA, &conf);
+    }
+    esp_wifi_connect();
+}
+
+static void startAttempt(uint32_t nowMs) {
+    restoreLink();
+    attemptStartUs = esp_timer_get_time();
+    beginTry(true);
+    setState(WIFI_STATE_CONNECTING, nowMs);
+}
+
+static void recordConnect() {
+    int64_t ipUs = gotIpUs ? gotIpUs : esp_timer_get_time();
+    int64_t assocUs = associatedUs && associatedUs <= ipUs ? associatedUs : ipUs;
+    WifiConnectStats stats;
+    stats.fastPath = fastAttempt;
+    stats.staticIp = staticAttempt;
+    stats.associateMs = (uint32_t)((assocUs - tryStartUs) / 1000);
+    stats.ipMs = (uint32_t)((ipUs - assocUs) / 1000);
+    stats.totalMs = (uint32_t)((ipUs - attemptStartUs) / 1000);
+    lastStats = stats;
+    if (!haveBootStats) {
+        bootStats = stats;
+        haveBootStats = true;
+    }
+    DEBUG_PRINTF("WiFi: associated in %lu ms (%s), IP in %lu ms (%s), %lu ms total\n",
+                 (unsigned long)stats.associateMs, stats.fastPath ? "cached BSSID" : "scan",
+                 (unsigned long)stats.ipMs, stats.staticIp ? "cached lease" : "DHCP", (unsigned long)stats.totalMs);
+}
+
+static void scheduleRetry(uint32_t nowMs) {
+    DEBUG_PRINTF("WiFi: retry in %lu ms\n", (unsigned long)backoffMs);
+    setState(WIFI_STATE_BACKOFF, nowMs);
+}
+
+void wifiManagerBegin(WifiStateHandler handler) {
+    stateHandler = handler;
+    WiFi.mode(WIFI_STA);
+    WiFi.setAutoReconnect(false); // Retries are paced by the backoff below
+    WiFi.onEvent(onWifiEvent);
+}
+
+void wifiManagerConnect(const char* ssid, const char* password, bool persist) {
+    targetSsid = ssid;
+    targetPassword = password;
+    persistOnConnect = persist;
+    backoffMs = BACKOFF_MIN_MS;
+    if (suspended) {
+        resumeWanted = true; // Another link is up; joined on resume
+        return;
+    }
+    DEBUG_PRINTF("WiFi: connecting to %s\n", ssid);
+    startAttempt(millis());
+}
+
+bool wifiManagerConnectSaved() {
+    Preferences prefs;
+    prefs.begin("wifi", true);
+    String ssid = prefs.getString("ssid", "");
+    String password = prefs.getString("password", "");
+    prefs.end();
+
+    if (ssid.length() == 0) return false;
+    wifiManagerConnect(ssid.c_str(), password.c_str(), false);
+    return true;
+}
+
+bool wifiManagerSaveCredentials(const char* ssid, const char* password) {
+    Preferences prefs;
+    if (!prefs.begin("wifi", false)) return false;
+    bool ok = prefs.putString("ssid", ssid) == strlen(ssid);
+    ok = prefs.putString("password", password) == strlen(password) && ok;
+    prefs.end();
+    return ok;
+}
+
+String wifiManagerSavedSsid(bool* hasPassword) {
+    Preferences prefs;
+    if (!prefs.begin("wifi", true)) {
+        if (hasPassword) *hasPassword = false;
+        return String();
+    }
+    String ssid = prefs.getString("ssid", "");
+    if (hasPassword) *hasPassword = prefs.getString("password", "").length() > 0;
+    prefs.end();
+    return ssid;
+}
+
+void wifiManagerLoop(uint32_t nowMs) {
+    switch (state) {
+        case WIFI_STATE_CONNECTING:
+            if (gotIpEvent) {
+                gotIpEvent = false;
+                disconnectedEvent = false;
+                backoffMs = BACKOFF_MIN_MS;
+                recordConnect();
+                saveLink(staticAttempt);
+                staticLease = staticAttempt;
+                if (persistOnConnect) {
+                    Preferences prefs;
+                    prefs.begin("wifi", false);
+                    prefs.putString("ssid", targetSsid);
+                    prefs.putString("password", targetPassword);
+                    prefs.end();
+                    persistOnConnect = false;
+                }
+                setState(WIFI_STATE_CONNECTED, nowMs);
+            } else if (fastAttempt && (esp_timer_get_time() - tryStartUs) / 1000 >= WIFI_FAST_CONNECT_TIMEOUT_MS) {
+                // The access point moved or the address is gone; scan and use DHCP instead
+                DEBUG_PRINTLN("WiFi: fast path failed, scanning");
+                fastFallbacks++;
+                dropLink();
+                beginTry(false);
+                stateSinceMs = nowMs; // The full attempt gets the whole timeout
+            } else if (nowMs - stateSinceMs >= CONNECT_TIMEOUT_MS) {
+                // Disconnect events during association are normal; only the timeout fails
+                scheduleRetry(nowMs);
+            }
+            break;
+
+        case WIFI_STATE_CONNECTED:
+            if (gotIpEvent) {
+                gotIpEvent = false; // Renewed through DHCP; the lease time starts again
+                saveLink(false);
+            }
+            if (disconnectedEvent) {
+                disconnectedEvent = false;
+                DEBUG_PRINTLN("WiFi: connection lost");
+                staticLease = false;
+                scheduleRetry(nowMs);
+            } else if (staticLease && !leaseReusable()) {
+                // Renew through DHCP before the server may reassign the address
+                staticLease = false;
+                link.leaseUtc = 0;
+                rtcLink = link;
+                rtcLink.crc = linkCrc(rtcLink);
+                WiFi.config(IPAddress((uint32_t)0), IPAddress((uint32_t)0), IPAddress((uint32_t)0));
+                DEBUG_PRINTLN("WiFi: cached lease expired, renewing through DHCP");
+            }
+            break;
+
+        case WIFI_STATE_BACKOFF:
+            if (nowMs - stateSinceMs >= backoffMs) {
+                backoffMs = backoffMs * 2 > BACKOFF_MAX_MS ? BACKOFF_MAX_MS : backoffMs * 2;
+                startAttempt(nowMs);
+            }
+            break;
+
+        case WIFI_STATE_IDLE:
+        default:
+            break;
+    }
+
+    if (scanRunning && nowMs - scanStartMs >= SCAN_TIMEOUT_MS) {
+        DEBUG_PRINTLN("WiFi: scan timed out");
+        WiFi.scanDelete();
+        scanRunning = false;
+    }
+    if (scanRequested && !scanRunning && !suspended && state != WIFI_STATE_CONNECTING) {
+        scanRequested = false;
+        scanStartMs = nowMs;
+        scanRunning = true;
+        if (WiFi.scanNetworks(true) != WIFI_SCAN_RUNNING) {
+            DEBUG_PRINTLN("WiFi: scan could not start");
+            scanRunning = false;
+        }
+    }
+}
+
+void wifiManagerScan() {
+    scanRequested = true;
+}
+
+bool wifiManagerScanPending() {
+    return scanRequested || scanRunning;
+}
+
+size_t wifiManagerNetworks(WifiNetwork* out, size_t max, uint32_t* version) {
+    portENTER_CRITICAL(&scanLock);
+    size_t n = networkCount < max ? networkCount : max;
+    if (n) memcpy(out, networks, n * sizeof(WifiNetwork));
+    if (version) *version = scanVersion;
+    portEXIT_CRITICAL(&scanLock);
+    return n;
+}
+
+uint32_t wifiManagerScanAgeMs(uint32_t nowMs) {
+    portENTER_CRITICAL(&scanLock);
+    uint32_t age = scanVersion ? nowMs - scanDoneMs : UINT32_MAX;
+    portEXIT_CRITICAL(&scanLock);
+    return age;
+}
+
+WifiState wifiManagerState() {
+    return state;
+}
+
+void wifiManagerSuspend(uint8_t source, bool suspend) {
+    suspendedBy = suspend ? suspendedBy | source : suspendedBy & ~source;
+    suspend = suspendedBy != 0;
+    if (suspend == suspended) return;
+    uint32_t nowMs = millis();
+    suspended = suspend;
+    if (suspend) {
+        resumeWanted = state != WIFI_STATE_IDLE;
+        stopScan();
+        scanRequested = false;
+        staticLease = false;
+        WiFi.disconnect(true);
+        WiFi.mode(WIFI_OFF);
+        DEBUG_PRINTLN("WiFi: off while another link is up");
+        if (state != WIFI_STATE_IDLE) setState(WIFI_STATE_IDLE, nowMs);
+        return;
+    }
+    WiFi.mode(WIFI_STA);
+    gotIpEvent = false;
+    disconnectedEvent = false; // Left over from the disconnect above
+    DEBUG_PRINTLN("WiFi: back on");
+    if (resumeWanted && targetSsid.length()) {
+        backoffMs = BACKOFF_MIN_MS;
+        startAttempt(nowMs);
+    }
+    resumeWanted = false;
+}
+
+bool wifiManagerSuspended() {
+    return suspended;
+}
+
+uint32_t wifiManagerRetryInMs(uint32_t nowMs) {
+    if (state != WIFI_STATE_BACKOFF) return 0;
+    uint32_t elapsed = nowMs - stateSinceMs;
+    return elapsed >= backoffMs ? 0 : backoffMs - elapsed;
+}
+
+bool wifiManagerBootStats(WifiConnectStats* stats) {
+    if (!haveBootStats) return false;
+    *stats = bootStats;
+    return true;
+}
+
+static void printConnectStats(Print& out, const char* name, const WifiConnectStats& s) {
+    out.printf("  %s: associated in %lu ms (%s), IP in %lu ms (%s), %lu ms total\n", name,
+               (unsigned long)s.associateMs, s.fastPath ? "cached BSSID" : "scan", (unsigned long)s.ipMs,
+               s.staticIp ? "cached lease" : "DHCP", (unsigned long)s.totalMs);
+}
+
+void printWifiStats(Print& out) {
+    restoreLink();
+    out.printf("WiFi connect: %lu fast path fallbacks\n", (unsigned long)fastFallbacks);
+    if (suspended) {
+        out.printf("  Radio off:%s%s\n", suspendedBy & WIFI_SUSPEND_ETHERNET ? " Ethernet up" : "",
+                   suspendedBy & WIFI_SUSPEND_CAMPAIGN ? " campaign outside an upload slot" : "");
+    }
+    if (haveBootStats) {
+        printConnectStats(out, "First", bootStats);
+        printConnectStats(out, "Last", lastStats);
+    } else {
+        out.println("  No connection since boot");
+    }
+    if (link.magic == LINK_CACHE_MAGIC) {
+        out.printf("  Cached link: %02X:%02X:%02X:%02X:%02X:%02X channel %u, %s", link.bssid[0], link.bssid[1],
+                   link.bssid[2], link.bssid[3], link.bssid[4], link.bssid[5], link.channel,
+                   IPAddress(link.ip).toString().c_str());
+        if (leaseReusable()) {
+            out.printf(", lease reusable for %lu s\n",
+                       (unsigned long)(WIFI_FAST_LEASE_REUSE_S - (timeBaseUtcSeconds() - link.leaseUtc)));
+        } else {
+            out.println(", lease not reusable");
+        }
+    } else {
+        out.println("  No cached link");
+    }
+}
+
+void printWifiScan(Print& out) {
+    WifiNetwork list[WIFI_SCAN_MAX_NETWORKS];
+    uint32_t version = 0;
+    size_t n = wifiManagerNetworks(list, WIFI_SCAN_MAX_NETWORKS, &version);
+    uint32_t age = wifiManagerScanAgeMs(millis());
+    if (age == UINT32_MAX) {
+        out.printf("WiFi scan: no results yet%s\n", wifiManagerScanPending() ? ", scanning" : "");
+        return;
+    }
+    out.printf("WiFi scan: %u networks, %lu s ago%s\n", (unsigned)n, (unsigned long)(age / 1000),
+               wifiManagerScanPending() ? ", scanning" : "");
+    for (size_t i = 0; i < n; i++) {
+        out.printf("  %4d dBm  ch %2u  %s  %s\n", list[i].rssi, list[i].channel, list[i].secure ? "WPA " : "open",
+                   list[i].ssid);
+    }
+}
@@ -0,0 +1,120 @@
+#ifndef WIFI_MANAGER_H
+#define WIFI_MANAGER_H
+
+#include <Arduino.h>
+
+// Non-blocking WiFi station manager.
+// WiFi.begin() is started and then tracked through WiFi events; wifiManagerLoop()
+// advances the state machine from the UI task, so no caller ever waits for the
+// network. Lost or failed connections are retried with exponential backoff.
+//
+// Fast reconnect: the BSSID, channel and IP configuration of the last
+// connection are kept in RTC memory and, without the lease time, in
+// Preferences. An attempt to the same SSID first associates directly to that
+// access point on that channel, skipping the scan. After a soft reset or a
+// wake from sleep, while the lease is younger than WIFI_FAST_LEASE_REUSE_S, it
+// also configures the cached address statically, skipping DHCP. The reuse
+// window ends with a switch back to DHCP, so the lease is renewed before the
+// server can hand the address out again. If the fast path does not get an IP
+// within WIFI_FAST_CONNECT_TIMEOUT_MS, the cache is dropped and the same
+// attempt continues with a full scan and DHCP.
+
+enum WifiState {
+    WIFI_STATE_IDLE = 0,   ///< No connection requested
+    WIFI_STATE_CONNECTING, ///< WiFi.begin() issued, waiting for an IP
+    WIFI_STATE_CONNECTED,  ///< Station has an IP address
+    WIFI_STATE_BACKOFF     ///< Attempt failed or link lost; retry scheduled
+};
+
+// Called on the UI task whenever the state changes.
+typedef void (*WifiStateHandler)(WifiState state);
+
+// Registers the WiFi event handler. Call once in setup().
+void wifiManagerBegin(WifiStateHandler handler);
+
+// Starts connecting to a network. When persist is true the credentials are saved
+// to Preferences ("wifi" namespace) once the connection succeeds.
+void wifiManagerConnect(const char* ssid, const char* password, bool persist);
+
+// Connects with the credentials saved in Preferences. Returns false if none are stored.
+bool wifiManagerConnectSaved();
+
+// Replaces the saved credentials without connecting (provisioning, config_api.h).
+// @return false if they could not be written
+bool wifiManagerSaveCredentials(const char* ssid, const char* password);
+
+// Saved SSID ("" if none) and whether a password is stored with it.
+String wifiManagerSavedSsid(bool* hasPassword);
+
+// Advances timeouts and retries; call from the UI task loop.
+void wifiManagerLoop(uint32_t nowMs);
+
+WifiState wifiManagerState();
+
+// Reasons to keep the radio off (wifiManagerSuspend()).
+enum WifiSuspendSource {
+    WIFI_SUSPEND_ETHERNET = 1 << 0,   ///< The cable carries the network (ethernet_link.h)
+    WIFI_SUSPEND_CAMPAIGN = 1 << 1    ///< Between upload slots (campaign.h)
+};
+
+// Turns the radio off for @p source, and back on once no source holds it off.
+// While suspended the state stays IDLE, no scan starts and a
+// wifiManagerConnect() only records the network; on resume the connection
+// that was wanted (connected, connecting or retrying) is attempted again.
+// UI task.
+void wifiManagerSuspend(uint8_t source, bool suspend);
+
+bool wifiManagerSuspended();
+
+// Durations of one connection, measured from the start of its attempt.
+struct WifiConnectStats {
+    bool fastPath;          ///< Associated to the cached BSSID and channel
+    bool staticIp;          ///< Cached address configured; no DHCP exchange
+    uint32_t associateMs;   ///< Until the station associated
+    uint32_t ipMs;          ///< From association until the IP (DHCP or static)
+    uint32_t totalMs;       ///< Including a failed fast path, if any
+};
+
+// First connection since boot; false until there was one.
+bool wifiManagerBootStats(WifiConnectStats* stats);
+
+void printWifiStats(Print& out);
+
+// Milliseconds until the next retry while in WIFI_STATE_BACKOFF (0 otherwise).
+uint32_t wifiManagerRetryInMs(uint32_t nowMs);
+
+// Network scan. wifiManagerScan() only asks for one; wifiManagerLoop() starts
+// it with the driver's asynchronous scan when no connection attempt is
+// associating (a scan would hold the radio off the target channel), and the
+// scan-done event copies the results into a cache on the event task: one
+// entry per SSID at its strongest access point, strongest first, hidden
+// networks left out. Readers copy the cache, so nobody waits for the radio.
+// A join from the list goes through wifiManagerConnect() like any other.
+
+static const uint8_t WIFI_SCAN_MAX_NETWORKS = 16;
+
+struct WifiNetwork {
+    char ssid[33];
+    int8_t rssi;            ///< dBm, strongest access point of the SSID
+    uint8_t channel;
+    bool secure;            ///< Needs a password
+};
+
+// Asks for a scan; any task. A scan already asked for or running is not repeated.
+void wifiManagerScan();
+
+// True from the request until the results are in.
+bool wifiManagerScanPending();
+
+// Copies up to @p max cached networks, strongest first.
+// @param version  Set to the cache version, which changes with every completed scan
+// @return the number copied
+size_t wifiManagerNetworks(WifiNetwork* out, size_t max, uint32_t* version);
+
+// Milliseconds since the cache was filled; UINT32_MAX before the first scan.
+uint32_t wifiManagerScanAgeMs(uint32_t nowMs);
+
+// Cached networks ("wifiscan" serial command).
+void printWifiScan(Print& out);
+
+#endif // WIFI_MANAGER_H
@@ -0,0 +1,159 @@
+/**
+ * @file wifi_power.cpp
+ * @brief Modem-sleep policy, wake windows and per-mode time and current.
+ *
+ * Holds come from the telemetry task, the web task's request hook and the UI
+ * task, so the mode is chosen and applied under one mutex. esp_wifi_set_ps()
+ * may block briefly and cannot be called inside a critical section. The
+ * statistics are only touched by wifiPowerLoop() on the UI task.
+ */
+
+#include "wifi_power.h"
+#include "wifi_manager.h"
+#include "web_service.h"
+#include "live_events.h"
+#include "screen_mirror.h"
+#include "ota_guard.h"
+#include "debug.h"
+#include <Preferences.h>
+#include <atomic>
+#include "esp_wifi.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+static const uint32_t CURRENT_SAMPLE_MS = 100;   ///< Same period as the power bench
+static const uint8_t MODE_SLOTS = 4;             ///< WIFI_PS_NONE, _MIN_MODEM, _MAX_MODEM, disconnected
+static const uint8_t SLOT_DISCONNECTED = 3;
+
+static const char* const POLICY_NAMES[WIFI_POWER_POLICY_COUNT] = {"awake", "modem", "scheduled"};
+static const char* const SLOT_NAMES[MODE_SLOTS] = {"awake", "modem (DTIM)", "modem (listen)", "not connected"};
+
+static SemaphoreHandle_t psMutex = nullptr;
+static WifiPowerPolicy policy = (WifiPowerPolicy)WIFI_POWER_POLICY;
+static std::atomic<uint8_t> holds(0);
+static int8_t appliedPs = -1;                    ///< wifi_ps_type_t in effect, -1 before the first apply
+
+static uint32_t lastLoopMs = 0;
+static uint32_t lastSampleMs = 0;
+static uint64_t slotMs[MODE_SLOTS];
+static double slotCurrentSum[MODE_SLOTS];
+static uint32_t slotSamples[MODE_SLOTS];
+static uint32_t windows = 0;                     ///< Wake windows opened since boot
+
+static wifi_ps_type_t wantedPs() {
+    switch (policy) {
+        case WIFI_POWER_AWAKE:
+            return WIFI_PS_NONE;
+        case WIFI_POWER_MODEM:
+            return WIFI_PS_MIN_MODEM;
+        case WIFI_POWER_SCHEDULED:
+        default:
+            return holds.load() ? WIFI_PS_NONE : WIFI_PS_MAX_MODEM;
+    }
+}
+
+/**
+ * @brief Applies the mode the policy and the holds ask for, if it changed.
+ */
+static void apply() {
+    if (!psMutex || wifiManagerState() == WIFI_STATE_IDLE) return;
+    xSemaphoreTake(psMutex, portMAX_DELAY);
+    wifi_ps_type_t ps = wantedPs();
+    if ((int8_t)ps != appliedPs && esp_wifi_set_ps(ps) == ESP_OK) {
+        if (ps == WIFI_PS_NONE && appliedPs == WIFI_PS_MAX_MODEM) windows++;
+        appliedPs = (int8_t)ps;
+    }
+    xSemaphoreGive(psMutex);
+}
+
+void initWifiPower() {
+    if (psMutex) return;
+    psMutex = xSemaphoreCreateMutex();
+    Preferences prefs;
+    prefs.begin("wifi", true);
+    uint8_t saved = prefs.getUChar("power", WIFI_POWER_POLICY);
+    prefs.end();
+    if (saved < WIFI_POWER_POLICY_COUNT) policy = (WifiPowerPolicy)saved;
+}
+
+void wifiPowerHold(uint8_t source) {
+    if ((holds.fetch_or(source) & source) == 0) apply();
+}
+
+void wifiPowerRelease(uint8_t source) {
+    if (holds.fetch_and((uint8_t)~source) & source) apply();
+}
+
+void wifiPowerLoop(uint32_t nowMs) {
+#if HEADLESS
+    uint8_t mirrorViewers = 0; // No panel to mirror
+#else
+    uint8_t mirrorViewers = screenMirrorViewerCount();
+#endif
+    bool session = liveEventsClientCount() > 0 || mirrorViewers > 0 ||
+                   (webServiceRequests() > 0 && nowMs - webServiceLastRequestMs() < WIFI_SESSION_HOLD_MS);
+    if (session) wifiPowerHold(WIFI_WAKE_SESSION);
+    else wifiPowerRelease(WIFI_WAKE_SESSION);
+    if (otaGuardActive()) wifiPowerHold(WIFI_WAKE_OTA);
+    else wifiPowerRelease(WIFI_WAKE_OTA);
+
+    bool connected = wifiManagerState() == WIFI_STATE_CONNECTED;
+    if (connected && appliedPs < 0) apply(); // First connection
+    uint8_t slot = connected && appliedPs >= 0 ? (uint8_t)appliedPs : SLOT_DISCONNECTED;
+    if (lastLoopMs) slotMs[slot] += nowMs - lastLoopMs;
+    lastLoopMs = nowMs;
+
+    if (POWER_BENCH_CURRENT_PIN >= 0 && nowMs - lastSampleMs >= CURRENT_SAMPLE_MS) {
+        lastSampleMs = nowMs;
+        slotCurrentSum[slot] += analogReadMilliVolts(POWER_BENCH_CURRENT_PIN) / POWER_BENCH_MV_PER_MA;
+        slotSamples[slot]++;
+    }
+}
+
+int8_t wifiPowerAppliedMode() {
+    return wifiManagerState() == WIFI_STATE_CONNECTED ? appliedPs : -1;
+}
+
+void wifiPowerSetPolicy(WifiPowerPolicy next) {
+    if (next >= WIFI_POWER_POLICY_COUNT) return;
+    Preferences prefs;
+    prefs.begin("wifi", false);
+    prefs.putUChar("power", (uint8_t)next);
+    prefs.end();
+    policy = next;
+    apply();
+}
+
+WifiPowerPolicy wifiPowerPolicy() {
+    return policy;
+}
+
+const char* wifiPowerPolicyName(uint8_t value) {
+    return value < WIFI_POWER_POLICY_COUNT ? POLICY_NAMES[value] : "?";
+}
+
+uint16_t wifiPowerListenInterval() {
+    return policy == WIFI_POWER_SCHEDULED ? WIFI_LISTEN_INTERVAL : 0;
+}
+
+void printWifiPower(Print& out) {
+    uint8_t held = holds.load();
+    out.printf("WiFi power: %s, listen interval %u beacons, %lu wake windows", wifiPowerPolicyName(policy),
+               (unsigned)wifiPowerListenInterval(), (unsigned long)windows);
+    if (held) {
+        out.printf(", awake for%s%s%s%s", held & WIFI_WAKE_TELEMETRY ? " telemetry" : "",
+                   held & WIFI_WAKE_SESSION ? " session" : "", held & WIFI_WAKE_OTA ? " OTA" : "",
+                   held & WIFI_WAKE_ESPNOW ? " ESP-NOW" : "");
+    }
+    out.println();
+
+    uint64_t totalMs = 0;
+    for (uint8_t i = 0; i < MODE_SLOTS; i++) totalMs += slotMs[i];
+    for (uint8_t i = 0; i < MODE_SLOTS; i++) {
+        if (slotMs[i] == 0) continue;
+        out.printf("  %-15s %8.1f s (%4.1f %%)", SLOT_NAMES[i], slotMs[i] / 1000.0,
+                   totalMs ? 100.0 * slotMs[i] / totalMs : 0.0);
+        if (slotSamples[i]) out.printf(", %.1f mA", slotCurrentSum[i] / slotSamples[i]);
+        out.println();
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef WIFI_POWER_H
+#define WIFI_POWER_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// WiFi modem-sleep policy.
+// The station's power-save mode follows what the network is used for:
+//  - awake:     WIFI_PS_NONE, the radio always listens (lowest latency).
+//  - modem:     WIFI_PS_MIN_MODEM, wakes for every DTIM beacon.
+//  - scheduled: WIFI_PS_MAX_MODEM between wake windows. The station wakes every
+//               WIFI_LISTEN_INTERVAL beacons, and the access point buffers
+//               frames for it in between. During a wake window it is WIFI_PS_NONE.
+//
+// Wake windows are held by their sources: the telemetry task around a batch
+// upload, an OTA update while it runs, and a dashboard session. A session
+// lasts while an event stream or a screen mirror is open or for
+// WIFI_SESSION_HOLD_MS after the last HTTP request (web_service.h). The first
+// request of a session waits for the next listen interval; the ones after it
+// are served at full speed.
+//
+// The listen interval is part of the association, so a changed interval takes
+// effect at the next connection (wifi_manager.h). The power-save mode itself
+// changes at once.
+//
+// Time and, with POWER_BENCH_CURRENT_PIN wired, mean supply current are
+// accumulated per applied mode ("power wifi").
+
+enum WifiPowerPolicy {
+    WIFI_POWER_AWAKE = 0,
+    WIFI_POWER_MODEM,
+    WIFI_POWER_SCHEDULED,
+    WIFI_POWER_POLICY_COUNT
+};
+
+// Wake window sources (bit masks for wifiPowerHold()).
+enum WifiWakeSource {
+    WIFI_WAKE_TELEMETRY = 1 << 0,
+    WIFI_WAKE_SESSION   = 1 << 1,
+    WIFI_WAKE_OTA       = 1 << 2,
+    WIFI_WAKE_ESPNOW    = 1 << 3   ///< Held while the ESP-NOW link runs (espnow_link.h)
+};
+
+// Loads the policy from Preferences ("wifi" namespace). Call in setup() before
+// the first connection.
+void initWifiPower();
+
+// Opens or closes a wake window. Any task.
+void wifiPowerHold(uint8_t source);
+void wifiPowerRelease(uint8_t source);
+
+// Follows sessions and OTA, applies the mode and accumulates the statistics.
+// Call from the UI task loop.
+void wifiPowerLoop(uint32_t nowMs);
+
+// Saves and applies @p policy. UI task.
+void wifiPowerSetPolicy(WifiPowerPolicy policy);
+WifiPowerPolicy wifiPowerPolicy();
+const char* wifiPowerPolicyName(uint8_t policy);
+
+// wifi_ps_type_t in effect while connected, -1 while not (energy_meter.h). Any task.
+int8_t wifiPowerAppliedMode();
+
+// Listen interval for the next association, in beacon intervals (0: SDK default).
+uint16_t wifiPowerListenInterval();
+
+// Policy, wake windows and the time and current per mode.
+void printWifiPower(Print& out);
+
+#endif // WIFI_POWER_H
@@ -0,0 +1,193 @@
+/**
+ * @file wifi_scan_view.cpp
+ * @brief Network picker on the settings screen.
+ *
+ * The rows are buttons in a scrolling flex column (lv_list is left out of
+ * the build, lv_conf.h), rebuilt from a copy of the scan cache whenever its
+ * version moves; a row's user data is its index in that copy, which changes
+ * only together with the rows. No scans are asked for while another screen
+ * is loaded, even if the panel was left open.
+ */
+
+#include "config.h"
+
+#if !HEADLESS
+
+#include "wifi_scan_view.h"
+#include <stdio.h>
+
+static const uint32_t UPDATE_INTERVAL_MS = 1000;
+static const lv_coord_t ROW = 36;
+static const lv_coord_t GAP = 10;
+
+static lv_obj_t* screen = nullptr;
+static lv_coord_t panelTop = 0;
+static WifiScanSelectFn selectFn = nullptr;
+static lv_obj_t* view = nullptr;
+static lv_obj_t* status = nullptr;
+static lv_obj_t* list = nullptr;
+static WifiNetwork shown[WIFI_SCAN_MAX_NETWORKS];
+static size_t shownCount = 0;
+static uint32_t shownVersion = UINT32_MAX;
+static uint32_t lastUpdateMs = 0;
+
+/**
+ * @brief Asks for a scan when the cache is missing or too old.
+ */
+static void refreshScan(uint32_t nowMs) {
+    if (!wifiManagerScanPending() && wifiManagerScanAgeMs(nowMs) >= WIFI_SCAN_REFRESH_S * 1000UL) {
+        wifiManagerScan();
+    }
+}
+
+static void rowCb(lv_event_t* e) {
+    if (lv_event_get_code(e) != LV_EVENT_CLICKED) return;
+    size_t index = (size_t)(intptr_t)lv_event_get_user_data(e);
+    if (index >= shownCount) return;
+    WifiNetwork network = shown[index];
+    wifiScanViewShow(false);
+    if (selectFn) selectFn(network);
+}
+
+/**
+ * @brief Rebuilds the rows from the cache.
+ */
+static void refreshList() {
+    shownCount = wifiManagerNetworks(shown, WIFI_SCAN_MAX_NETWORKS, &shownVersion);
+    lv_obj_clean(list);
+    for (size_t i = 0; i < shownCount; i++) {
+        char text[64];
+        snprintf(text, sizeof(text), LV_SYMBOL_WIFI " %4d dBm  %s%s", shown[i].rssi, shown[i].ssid,
+                 shown[i].secure ? "  " LV_SYMBOL_EYE_CLOSE : "");
+        lv_obj_t* row = lv_btn_create(list);
+        lv_obj_set_size(row, lv_pct(100), ROW);
+        lv_obj_add_event_cb(row, rowCb, LV_EVENT_CLICKED, (void*)(intptr_t)i);
+        lv_obj_t* l = lv_label_create(row);
+        lv_label_set_text(l, text);
+        lv_obj_align(l, LV_ALIGN_LEFT_MID, 0, 0);
+    }
+}
+
+static void refreshStatus(uint32_t nowMs) {
+    uint32_t age = wifiManagerScanAgeMs(nowMs);
+    char text[40];
+    if (age == UINT32_MAX) {
+        lv_label_set_text_static(status, "Scanning...");
+        return;
+    }
+    snprintf(text, sizeof(text), "%u networks%s", (unsigned)shownCount,
+             wifiManagerScanPending() ? ", scanning..." : "");
+    lv_label_set_text(status, text);
+}
+
+static void closeCb(lv_event_t* e) {
+    if (lv_event_get_code(e) != LV_EVENT_CLICKED) return;
+    wifiScanViewShow(false);
+}
+
+static void rescanCb(lv_event_t* e) {
+    if (lv_event_get_code(e) != LV_EVENT_CLICKED) return;
+    wifiManagerScan();
+    refreshStatus(millis());
+}
+
+static void openCb(lv_event_t* e) {
+    wifiScanViewShow(true);
+}
+
+static void screenDeletedCb(lv_event_t* e) {
+    screen = view = status = list = nullptr;
+}
+
+static lv_obj_t* addButton(lv_obj_t* parent, const char* label, lv_coord_t w, lv_event_cb_t cb) {
+    lv_obj_t* btn = lv_btn_create(parent);
+    lv_obj_set_size(btn, w, ROW);
+    lv_obj_add_event_cb(btn, cb, LV_EVENT_ALL, NULL);
+    lv_obj_t* l = lv_label_create(btn);
+    lv_label_set_text_static(l, label);
+    lv_obj_center(l);
+    return btn;
+}
+
+/**
+ * @brief Builds the panel on the first open.
+ */
+static void createView() {
+    view = lv_obj_create(screen);
+    lv_obj_set_size(view, lv_obj_get_width(screen), lv_obj_get_height(screen) - panelTop);
+    lv_obj_align(view, LV_ALIGN_TOP_LEFT, 0, panelTop);
+    lv_obj_set_style_bg_color(view, lv_color_black(), LV_PART_MAIN);
+    lv_obj_set_style_radius(view, 0, LV_PART_MAIN);
+    lv_obj_set_style_border_width(view, 0, LV_PART_MAIN);
+    lv_obj_set_style_pad_all(view, 6, LV_PART_MAIN);
+    lv_obj_clear_flag(view, LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_GESTURE_BUBBLE);
+
+    status = lv_label_create(view);
+    lv_obj_set_style_text_color(status, lv_color_white(), LV_PART_MAIN);
+    lv_obj_set_pos(status, 0, 10);
+
+    lv_obj_t* rescan = addButton(view, "SCAN", 100, rescanCb);
+    lv_obj_align(rescan, LV_ALIGN_TOP_RIGHT, -100 - GAP, 0);
+    lv_obj_t* close = addButton(view, "CLOSE", 100, closeCb);
+    lv_obj_align(close, LV_ALIGN_TOP_RIGHT, 0, 0);
+
+    list = lv_obj_create(view);
+    lv_obj_set_size(list, lv_pct(100), lv_obj_get_height(view) - 12 - ROW - GAP);
+    lv_obj_set_pos(list, 0, ROW + GAP);
+    lv_obj_set_style_bg_opa(list, LV_OPA_TRANSP, LV_PART_MAIN);
+    lv_obj_set_style_border_width(list, 0, LV_PART_MAIN);
+    lv_obj_set_style_pad_all(list, 0, LV_PART_MAIN);
+    lv_obj_set_style_pad_row(list, 4, LV_PART_MAIN);
+    lv_obj_set_flex_flow(list, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_scroll_dir(list, LV_DIR_VER);
+    lv_obj_clear_flag(list, LV_OBJ_FLAG_GESTURE_BUBBLE);
+    shownVersion = UINT32_MAX;
+}
+
+void wifiScanViewAttach(lv_obj_t* screenObj, lv_coord_t top, WifiScanSelectFn onSelect) {
+    screen = screenObj;
+    panelTop = top;
+    selectFn = onSelect;
+    view = status = list = nullptr;
+    shownCount = 0;
+
+    lv_obj_t* open = lv_btn_create(screen);
+    lv_obj_set_size(open, 80, ROW);
+    lv_obj_align(open, LV_ALIGN_BOTTOM_RIGHT, -20 - 2 * (80 + GAP), -50); // Left of LOG
+    lv_obj_t* openLabel = lv_label_create(open);
+    lv_label_set_text_static(openLabel, "WIFI");
+    lv_obj_center(openLabel);
+    lv_obj_add_event_cb(open, openCb, LV_EVENT_CLICKED, NULL);
+    lv_obj_add_event_cb(screen, screenDeletedCb, LV_EVENT_DELETE, NULL);
+}
+
+void wifiScanViewShow(bool show) {
+    if (!screen) return;
+    if (show) {
+        if (!view) createView();
+        lv_obj_clear_flag(view, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_move_foreground(view);
+        uint32_t now = millis();
+        refreshScan(now);
+        uint32_t version;
+        wifiManagerNetworks(nullptr, 0, &version);
+        if (version != shownVersion) refreshList();
+        refreshStatus(now);
+        lastUpdateMs = now;
+    } else if (view) {
+        lv_obj_add_flag(view, LV_OBJ_FLAG_HIDDEN);
+    }
+}
+
+void wifiScanViewUpdate(uint32_t nowMs) {
+    if (!view || lv_obj_has_flag(view, LV_OBJ_FLAG_HIDDEN) || lv_scr_act() != screen) return;
+    if (nowMs - lastUpdateMs < UPDATE_INTERVAL_MS) return;
+    lastUpdateMs = nowMs;
+    refreshScan(nowMs);
+    uint32_t version;
+    wifiManagerNetworks(nullptr, 0, &version);
+    if (version != shownVersion) refreshList();
+    refreshStatus(nowMs);
+}
+
+#endif // !HEADLESS
@@ -0,0 +1,27 @@
+#ifndef WIFI_SCAN_VIEW_H
+#define WIFI_SCAN_VIEW_H
+
+#include <lvgl.h>
+#include "wifi_manager.h"
+
+// Network picker over the settings screen. A WIFI button left of LOG opens a
+// list of the scanned networks (wifi_manager.h), strongest first, with the
+// signal and a lock for those that need a password. The panel is built on
+// the first open and the list only from the scan cache: opening it asks for a
+// scan when the cache is missing or older than WIFI_SCAN_REFRESH_S, and while
+// it stays open the cache is refreshed at that age and the rows rebuilt when
+// a scan completes. Nothing here waits for the radio. LVGL task only.
+
+// Called with the picked network; the panel has closed.
+typedef void (*WifiScanSelectFn)(const WifiNetwork& network);
+
+// Creates the WIFI button on @p screen; the panel goes from @p top down to the
+// bottom of the screen. Both are removed with their screen.
+void wifiScanViewAttach(lv_obj_t* screen, lv_coord_t top, WifiScanSelectFn onSelect);
+
+void wifiScanViewShow(bool show);
+
+// Refreshes the scan and the rows at most once a second while shown.
+void wifiScanViewUpdate(uint32_t nowMs);
+
+#endif // WIFI_SCAN_VIEW_H
@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+"""Decodes the SD card history log (src/history_log.h) to CSV.
+
+Accepts the log file copied from the card (rdlog.bin, format 2, or a kept
+rdlog.bin.v1) or the block stream of /api/history?src=log, e.g.
+    python3 tools/decode_history_log.py rdlog.bin > log.csv
+    curl -s "http://radscan-xxxxxx.local/api/history?src=log&from=1700000000" \\
+        | python3 tools/decode_history_log.py - > log.csv
+The log file is a ring; its blocks are put back in sequence order. The
+summary files of the compaction job (rdlog.bin.1m, rdlog.bin.1h,
+src/log_compaction.h) are decoded to the summary CSV.
+Blocks that fail their CRC are skipped with a note on stderr.
+"""
+import argparse
+import struct
+import sys
+import zlib
+
+FILE_MAGIC, BLOCK_MAGIC = 0x474C4452, 0x424C4452
+SUMMARY_FILE_MAGIC, SUMMARY_SECTOR_MAGIC = 0x534C4452, 0x4D4C4452
+BLOCK_SIZE = 512
+BLOCK_HEADER = struct.Struct("<IHHIIIIII4HI")  # 44 bytes, see HISTORY_LOG_BLOCK_HEADER
+RAW_RECORD = struct.Struct("<IIHHI")
+SUMMARY_SECTOR = struct.Struct("<IHHIII")  # 20 bytes, then 24 summaries
+SUMMARY = struct.Struct("<IIIIHH")         # HistoryBucket
+SUMMARIES_PER_SECTOR = 24
+
+
+def varints(data):
+    i = 0
+    while i < len(data):
+        value, shift = 0, 0
+        while True:
+            byte = data[i]
+            i += 1
+            value |= (byte & 0x7F) << shift
+            shift += 7
+            if not byte & 0x80:
+                break
+        yield value
+
+
+def unzigzag(value):
+    return (value >> 1) ^ -(value & 1)
+
+
+def runs(data):
+    it = varints(data)
+    for run in it:
+        value = next(it)
+        for _ in range(run):
+            yield value
+
+
+def decode_block(header, payload):
+    """Yields (timestamp, counts, seconds, flags, sequence) of one columnar block."""
+    (_, count, _, first_seq, first_ts, _, _, _, _, l0, l1, l2, l3, _) = header
+    columns, offset = [], 0
+    for length in (l0, l1, l2, l3):
+        columns.append(payload[offset:offset + length])
+        offset += length
+    timestamp, delta, counts = first_ts, 0, 0
+    dods = runs(columns[0])
+    count_deltas = varints(columns[1])
+    seconds = runs(columns[2])
+    flags = runs(columns[3])
+    for i in range(count):
+        dod = unzigzag(next(dods))
+        if i:
+            delta += dod
+            timestamp += delta
+        counts += unzigzag(next(count_deltas))
+        yield timestamp, counts, next(seconds), next(flags), first_seq + i
+
+
+def block_crc(raw_header, payload):
+    # Header after the magic up to the crc field, then the payload
+    return zlib.crc32(payload, zlib.crc32(raw_header[4:BLOCK_HEADER.size - 4])) & 0xFFFFFFFF
+
+
+def columnar_blocks(data, step):
+    """Walks blocks at fixed @p step (the file) or back to back (step None, the stream)."""
+    offset = 0
+    while offset + BLOCK_HEADER.size <= len(data):
+        raw = data[offset:offset + BLOCK_HEADER.size]
+        header = BLOCK_HEADER.unpack(raw)
+        payload = data[offset + BLOCK_HEADER.size:offset + BLOCK_HEADER.size + header[2]]
+        valid = header[0] == BLOCK_MAGIC and header[1] and block_crc(raw, payload) == header[13]
+        if valid:
+            yield header, payload
+        else:
+            print("# skipped damaged block at offset %d" % offset, file=sys.stderr)
+            if step is None:
+                return  # A stream cannot be resynchronised
+        offset += step if step else BLOCK_HEADER.size + header[2]
+
+
+def records(data):
+    magic, fmt = struct.unpack_from("<IH", data) if len(data) >= 6 else (0, 0)
+    if magic != FILE_MAGIC:
+        for header, payload in columnar_blocks(data, None):
+            yield from decode_block(header, payload)
+    elif fmt == 2:
+        # Oldest first: once the ring has wrapped, the file runs newest lap, then previous lap
+        blocks = sorted(columnar_blocks(data[BLOCK_SIZE:], BLOCK_SIZE), key=lambda block: block[0][3])
+        for header, payload in blocks:
+            yield from decode_block(header, payload)
+    elif fmt == 1:
+        # 16-byte block header (magic, count, reserved, first sequence, crc) + 31 raw records
+        for offset in range(BLOCK_SIZE, len(data) - BLOCK_SIZE + 1, BLOCK_SIZE):
+            block_magic, count = struct.unpack_from("<IH", data, offset)
+            if block_magic != BLOCK_MAGIC or not 0 < count <= 31:
+                continue
+            for i in range(count):
+                yield RAW_RECORD.unpack_from(data, offset + 16 + i * RAW_RECORD.size)
+    else:
+        sys.exit("unknown log format %d" % fmt)
+
+
+def summaries(data):
+    """Yields the summaries (start, counts, min_cps, max_cps, seconds, flags) of a summary file, oldest first."""
+    sectors = []
+    for offset in range(BLOCK_SIZE, len(data) - BLOCK_SIZE + 1, BLOCK_SIZE):
+        magic, count, _, first, _, crc = SUMMARY_SECTOR.unpack_from(data, offset)
+        body = data[offset + SUMMARY_SECTOR.size:offset + SUMMARY_SECTOR.size + SUMMARIES_PER_SECTOR * SUMMARY.size]
+        valid = (magic == SUMMARY_SECTOR_MAGIC and 0 < count <= SUMMARIES_PER_SECTOR and
+                 zlib.crc32(body, zlib.crc32(data[offset + 4:offset + 16])) & 0xFFFFFFFF == crc)
+        if valid:
+            sectors.append((first, count, body))
+        elif magic or count:
+            print("# skipped damaged sector at offset %d" % offset, file=sys.stderr)
+    for _, count, body in sorted(sectors):
+        for i in range(count):
+            yield SUMMARY.unpack_from(body, i * SUMMARY.size)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("input", help="log file or block stream, - for stdin")
+    parser.add_argument("--sequence", action="store_true", help="add the record sequence column")
+    args = parser.parse_args()
+
+    data = sys.stdin.buffer.read() if args.input == "-" else open(args.input, "rb").read()
+    out = sys.stdout
+    if len(data) >= 4 and struct.unpack_from("<I", data)[0] == SUMMARY_FILE_MAGIC:
+        out.write("start,counts,min_cps,max_cps,seconds,flags\n")
+        for summary in summaries(data):
+            out.write("%d,%d,%d,%d,%d,%d\n" % summary)
+        return
+    out.write("timestamp,counts,seconds,flags" + (",sequence\n" if args.sequence else "\n"))
+    for timestamp, counts, seconds, flags, sequence in records(data):
+        if args.sequence:
+            out.write("%d,%d,%d,%d,%d\n" % (timestamp, counts, seconds, flags, sequence))
+        else:
+            out.write("%d,%d,%d,%d\n" % (timestamp, counts, seconds, flags))
+
+
+if __name__ == "__main__":
+    main()
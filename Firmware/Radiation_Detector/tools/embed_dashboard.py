@@ -0,0 +1,126 @@
+#!/usr/bin/env python3
+"""Compress the dashboard (src/web) into src/dashboard_page.h.
+
+Run after editing the dashboard page or the chart script:
+    python3 tools/embed_dashboard.py
+The header holds the gzip bytes in PROGMEM and an ETag derived from them. The
+chart script is minified and gets a URL with its hash ({{CHARTS_JS}} in the
+page), so it can be cached as immutable: a changed script is a new URL.
+The service worker (sw.js) gets the page ETag and the script URL written in,
+so every page change installs a new worker with a fresh offline cache; it
+and the web app manifest are compressed as they are.
+The provisioning portal page (portal.html) goes into src/portal_page.h of its
+own, so the portal does not pull the dashboard's arrays in and vice versa.
+"""
+import gzip
+import os
+import zlib
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SRC = os.path.join(ROOT, "src", "web", "dashboard.html")
+CHARTS = os.path.join(ROOT, "src", "web", "charts.js")
+WORKER = os.path.join(ROOT, "src", "web", "sw.js")
+MANIFEST = os.path.join(ROOT, "src", "web", "manifest.webmanifest")
+DST = os.path.join(ROOT, "src", "dashboard_page.h")
+PORTAL = os.path.join(ROOT, "src", "web", "portal.html")
+PORTAL_DST = os.path.join(ROOT, "src", "portal_page.h")
+
+
+def minify_js(source):
+    """Drops comment lines, indentation and blank lines (the script keeps its semicolons)."""
+    lines = []
+    for line in source.decode("utf-8").splitlines():
+        line = line.strip()
+        if line and not line.startswith("//"):
+            lines.append(line)
+    return "\n".join(lines).encode("utf-8")
+
+
+def byte_array(name, data):
+    lines = ["static const uint8_t %s[] PROGMEM = {" % name]
+    for i in range(0, len(data), 16):
+        lines.append("    " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    lines.append("};")
+    return lines
+
+
+def main():
+    with open(CHARTS, "rb") as f:
+        charts = minify_js(f.read())
+    charts_gz = gzip.compress(charts, compresslevel=9, mtime=0)
+    charts_path = "/charts.%08x.js" % (zlib.crc32(charts_gz) & 0xFFFFFFFF)
+
+    with open(SRC, "rb") as f:
+        html = f.read().replace(b"{{CHARTS_JS}}", charts_path.encode())
+    # mtime=0 keeps the output (and the ETag) reproducible
+    gz = gzip.compress(html, compresslevel=9, mtime=0)
+    etag = '"%08x"' % (zlib.crc32(gz) & 0xFFFFFFFF)
+
+    with open(WORKER, "rb") as f:
+        worker = minify_js(f.read().replace(b"{{PAGE_ETAG}}", etag.strip('"').encode())
+                           .replace(b"{{CHARTS_JS}}", charts_path.encode()))
+    worker_gz = gzip.compress(worker, compresslevel=9, mtime=0)
+    with open(MANIFEST, "rb") as f:
+        manifest_gz = gzip.compress(f.read(), compresslevel=9, mtime=0)
+
+    lines = [
+        "#ifndef DASHBOARD_PAGE_H",
+        "#define DASHBOARD_PAGE_H",
+        "",
+        "// Generated by tools/embed_dashboard.py from src/web/dashboard.html,",
+        "// src/web/charts.js, src/web/sw.js and src/web/manifest.webmanifest - do not edit.",
+        "// %d bytes of HTML, %d bytes gzip-compressed; chart script %d -> %d bytes;" % (
+            len(html), len(gz), len(charts), len(charts_gz)),
+        "// service worker %d -> %d bytes." % (len(worker), len(worker_gz)),
+        "",
+        "#include <Arduino.h>",
+        "",
+        "#define DASHBOARD_PAGE_ETAG \"%s\"" % etag.replace('"', '\\"'),
+        "static const size_t DASHBOARD_PAGE_GZ_LEN = %d;" % len(gz),
+    ]
+    lines += byte_array("DASHBOARD_PAGE_GZ", gz)
+    lines += [
+        "",
+        "#define DASHBOARD_CHARTS_PATH \"%s\"" % charts_path,
+        "static const size_t DASHBOARD_CHARTS_GZ_LEN = %d;" % len(charts_gz),
+    ]
+    lines += byte_array("DASHBOARD_CHARTS_GZ", charts_gz)
+    lines += [
+        "",
+        "static const size_t DASHBOARD_WORKER_GZ_LEN = %d;" % len(worker_gz),
+    ]
+    lines += byte_array("DASHBOARD_WORKER_GZ", worker_gz)
+    lines += [
+        "",
+        "static const size_t DASHBOARD_MANIFEST_GZ_LEN = %d;" % len(manifest_gz),
+    ]
+    lines += byte_array("DASHBOARD_MANIFEST_GZ", manifest_gz)
+    lines += ["", "#endif // DASHBOARD_PAGE_H", ""]
+
+    with open(DST, "w") as f:
+        f.write("\n".join(lines))
+    print("%s: %d -> %d bytes, ETag %s" % (os.path.relpath(DST, ROOT), len(html), len(gz), etag))
+
+    with open(PORTAL, "rb") as f:
+        portal = f.read()
+    portal_gz = gzip.compress(portal, compresslevel=9, mtime=0)
+    lines = [
+        "#ifndef PORTAL_PAGE_H",
+        "#define PORTAL_PAGE_H",
+        "",
+        "// Generated by tools/embed_dashboard.py from src/web/portal.html - do not edit.",
+        "// %d bytes of HTML, %d bytes gzip-compressed." % (len(portal), len(portal_gz)),
+        "",
+        "#include <Arduino.h>",
+        "",
+        "static const size_t PORTAL_PAGE_GZ_LEN = %d;" % len(portal_gz),
+    ]
+    lines += byte_array("PORTAL_PAGE_GZ", portal_gz)
+    lines += ["", "#endif // PORTAL_PAGE_H", ""]
+    with open(PORTAL_DST, "w") as f:
+        f.write("\n".join(lines))
+    print("%s: %d -> %d bytes" % (os.path.relpath(PORTAL_DST, ROOT), len(portal), len(portal_gz)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,321 @@
+/**
+ * @file http_fuzz.cpp
+ * @brief Host fuzz harness and parse benchmark for the JSON request bodies.
+ *
+ * Runs request bodies through the code the web task uses for the POST routes
+ * of json_body.h: JsonBodyReceiver collecting the chunks into a buffer of
+ * JSON_BODY_MAX_BYTES, jsonBodyParse() with the route's filter into a
+ * document on a JsonArena of JSON_BODY_DOC_BYTES, and the "action" lookup the
+ * command handlers make. The first input byte picks the route and how the
+ * body is split into chunks; the rest is the body. Each run checks that
+ *   - the status is 200, 400 or 413, with a message unless 200
+ *   - a body over the buffer is refused, and nothing else is
+ *   - the arena never hands out more than it has
+ *   - a filtered document holds the action and nothing else
+ *   - an unfiltered document serializes to JSON that parses to the same text
+ * and aborts otherwise, so libFuzzer and the sanitizers report the input.
+ *
+ * The route table mirrors the jsonBodyOn() registrations (anomaly_capture.cpp,
+ * plateau_scan.cpp, tube_health.cpp) plus an unfiltered route.
+ *
+ * Build and run from Firmware/Radiation_Detector:
+ *     g++ -std=gnu++11 -O2 -Isrc -Ilib/ArduinoJson/src tools/http_fuzz.cpp -o http_fuzz
+ *     ./http_fuzz --iterations 2000000 --seed 1
+ *     ./http_fuzz --bench 5
+ *     ./http_fuzz crash-input.bin
+ * or with libFuzzer and the sanitizers:
+ *     clang++ -std=gnu++11 -g -O1 -fsanitize=fuzzer,address,undefined -DHTTP_FUZZ_LIBFUZZER \
+ *         -Isrc -Ilib/ArduinoJson/src tools/http_fuzz.cpp -o http_fuzz
+ *     ./http_fuzz -max_len=20000 corpus/
+ *
+ * The built-in fuzzer mutates a small seed corpus (bit flips, inserted JSON
+ * tokens, splices, truncation, growth past the buffer) and prints the status
+ * counts; --bench prints parses per second and the p99 time of receive plus
+ * parse for each seed. A failing input is written to http_fuzz_crash.bin.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+// The ESP32's slot ids and pool size, so a pool fits the arena as on the
+// device; slots are still twice as large on a 64-bit host, so documents
+// overflow the arena earlier than they would there (-m32 matches exactly)
+#define ARDUINOJSON_SLOT_ID_SIZE 2
+
+#include "config.h"
+#include "json_arena.h"
+#include "json_body_parse.h"
+
+struct FuzzRoute {
+    const char* uri;
+    const char* filter;           ///< nullptr: unfiltered
+    const char* actions[4];       ///< Accepted actions, nullptr-terminated
+};
+
+static const FuzzRoute ROUTES[] = {
+    {"/api/anomaly", JSON_BODY_ACTION_FILTER, {"arm", "disarm", "reset", nullptr}},
+    {"/api/plateau", JSON_BODY_ACTION_FILTER, {"start", "stop", nullptr}},
+    {"/api/tube", JSON_BODY_ACTION_FILTER, {"reset", nullptr}},
+    {"(unfiltered)", nullptr, {nullptr}},
+};
+static const size_t ROUTE_COUNT = sizeof(ROUTES) / sizeof(ROUTES[0]);
+
+static const char* SEEDS[] = {
+    "{\"action\":\"reset\"}",
+    "{\"action\":\"arm\",\"extra\":[1,2,3],\"nested\":{\"a\":{\"b\":null}}}",
+    "{\"other\":true,\"action\":\"start\"}",
+    "{\"action\":\"st\\u0061rt\"}",
+    "{\"action\":123}",
+    "[{\"action\":\"stop\"}]",
+    "{\"a\":[[[[[[[[[[[[1]]]]]]]]]]]]}",
+    "{\"n\":-0.0e-0,\"m\":1e308,\"o\":18446744073709551616,\"p\":-9223372036854775809}",
+    "{\"s\":\"\\ud83d\\ude00\\n\\t\\\"\",\"t\":\"",
+    "  \r\n{ \"action\" : \"disarm\" } trailing",
+    "null",
+    "",
+};
+static const size_t SEED_COUNT = sizeof(SEEDS) / sizeof(SEEDS[0]);
+
+static const char* TOKENS[] = {"{", "}", "[", "]", "\"", ":", ",", "\\u", "\\", "true", "null", "1e999",
+                               "-", "\"action\"", "/*", "*/", "//", "\n", "\x00", "\xff"};
+static const size_t TOKEN_COUNT = sizeof(TOKENS) / sizeof(TOKENS[0]);
+
+static JsonDocument* filters[ROUTE_COUNT];
+static JsonArena<JSON_BODY_DOC_BYTES> arena;
+static char receiveBuffer[JSON_BODY_MAX_BYTES];
+static JsonBodyReceiver receiver;
+static std::vector<uint8_t> currentInput;
+
+static void setup() {
+    static bool done = false;
+    if (done) return;
+    done = true;
+    for (size_t r = 0; r < ROUTE_COUNT; r++) {
+        if (!ROUTES[r].filter) continue;
+        filters[r] = new JsonDocument();
+        if (deserializeJson(*filters[r], ROUTES[r].filter)) {
+            fprintf(stderr, "filter of %s does not parse\n", ROUTES[r].uri);
+            exit(2);
+        }
+    }
+    receiver.attach(receiveBuffer, sizeof(receiveBuffer));
+}
+
+static void fail(const char* what, size_t route) {
+    fprintf(stderr, "FAIL %s: %s (%zu input bytes)\n", ROUTES[route].uri, what, currentInput.size());
+    FILE* f = fopen("http_fuzz_crash.bin", "wb");
+    if (f) {
+        fwrite(currentInput.data(), 1, currentInput.size(), f);
+        fclose(f);
+        fprintf(stderr, "input written to http_fuzz_crash.bin\n");
+    }
+    abort();
+}
+
+/**
+ * @brief One request: @p control picks route and chunking, @p body is the body.
+ * @return the HTTP status the route answered with
+ */
+static int runRequest(uint8_t control, const uint8_t* body, size_t length) {
+    size_t route = control % ROUTE_COUNT;
+    size_t chunk = (size_t)1 << (control / ROUTE_COUNT % 12); // 1 B ... 2 KB, like HTTP_RAW_BUFLEN
+
+    receiver.start();
+    for (size_t done = 0; done < length; done += chunk) {
+        receiver.write(body + done, std::min(chunk, length - done));
+    }
+    const char* received;
+    size_t receivedLength;
+    bool complete = receiver.take(&received, &receivedLength);
+    if (complete != (length <= JSON_BODY_MAX_BYTES)) fail("receiver accepted the wrong bodies", route);
+    if (!complete) return 413;
+    if (receivedLength != length || memcmp(received, body, length) != 0) fail("receiver changed the body", route);
+
+    arena.reset();
+    JsonDocument doc(&arena);
+    JsonBodyResult result = jsonBodyParse(doc, received, receivedLength, filters[route]);
+    if (arena.used() > JSON_BODY_DOC_BYTES) fail("arena overrun", route);
+    if (result.status != 200) {
+        if ((result.status != 400 && result.status != 413) || !result.message) fail("unexpected status", route);
+        return result.status;
+    }
+
+    if (filters[route]) {
+        JsonVariantConst variant = doc.as<JsonVariantConst>();
+        if (!variant.isNull()) {
+            JsonObjectConst object = variant.as<JsonObjectConst>();
+            if (object.isNull() || object.size() > 1) fail("filter let other fields through", route);
+            if (object.size() == 1 && !object["action"].is<JsonVariantConst>()) fail("filter kept the wrong field", route);
+        }
+        // The handlers' lookup; an unknown or missing action is answered with 400
+        const char* action = doc["action"] | "";
+        for (const char* const* a = ROUTES[route].actions; *a; a++) {
+            if (strcmp(action, *a) == 0) return 200;
+        }
+        return 400;
+    }
+
+    std::string text;
+    serializeJson(doc, text);
+    JsonDocument again;
+    if (deserializeJson(again, text)) fail("serialized document does not parse", route);
+    std::string textAgain;
+    serializeJson(again, textAgain);
+    if (text != textAgain) fail("serialization is not stable", route);
+    return 200;
+}
+
+static int runInput(const uint8_t* data, size_t size) {
+    setup();
+    if (size == 0) return 0;
+    currentInput.assign(data, data + size);
+    return runRequest(data[0], data + 1, size - 1);
+}
+
+#ifdef HTTP_FUZZ_LIBFUZZER
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    runInput(data, size);
+    return 0;
+}
+
+#else
+
+static void mutate(std::vector<uint8_t>& input, std::mt19937& rng) {
+    uint32_t rounds = 1 + rng() % 4;
+    for (uint32_t i = 0; i < rounds; i++) {
+        size_t size = input.size();
+        size_t at = size > 1 ? 1 + rng() % (size - 1) : 1;
+        switch (rng() % 7) {
+            case 0: // Flip a bit of the body, or change the route and chunking
+                if (size) input[rng() % size] ^= (uint8_t)(1u << (rng() % 8));
+                break;
+            case 1: { // Insert a JSON token
+                const char* token = TOKENS[rng() % TOKEN_COUNT];
+                size_t length = token[0] ? strlen(token) : 1;
+                input.insert(input.begin() + std::min(at, size), token, token + length);
+                break;
+            }
+            case 2: // Delete a run
+                if (size > 1) input.erase(input.begin() + at, input.begin() + std::min(size, at + 1 + rng() % 8));
+                break;
+            case 3: { // Splice in another seed
+                const char* seed = SEEDS[rng() % SEED_COUNT];
+                input.insert(input.begin() + std::min(at, size), seed, seed + strlen(seed));
+                break;
+            }
+            case 4: // Truncate
+                if (size > 1) input.resize(at);
+                break;
+            case 5: { // Repeat a region: deep nesting, long strings, many fields
+                if (size < 2) break;
+                size_t length = 1 + rng() % std::min<size_t>(16, size - at);
+                std::vector<uint8_t> region(input.begin() + at, input.begin() + at + length);
+                uint32_t copies = 1 + rng() % 64;
+                for (uint32_t c = 0; c < copies && input.size() < 2 * JSON_BODY_MAX_BYTES; c++) {
+                    input.insert(input.begin() + at, region.begin(), region.end());
+                }
+                break;
+            }
+            default: // Random byte
+                input.insert(input.begin() + std::min(at, size), (uint8_t)rng());
+                break;
+        }
+    }
+    if (rng() % 4096 == 0) input.resize(JSON_BODY_MAX_BYTES + 1 + rng() % 64, ' '); // Just over the buffer
+}
+
+static std::vector<uint8_t> seedInput(size_t seed, uint8_t control) {
+    std::vector<uint8_t> input(1, control);
+    input.insert(input.end(), SEEDS[seed], SEEDS[seed] + strlen(SEEDS[seed]));
+    return input;
+}
+
+static void fuzz(uint64_t iterations, uint32_t seed) {
+    std::mt19937 rng(seed);
+    uint64_t statuses[3] = {0, 0, 0}; // 200, 400, 413
+    size_t largest = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < iterations; i++) {
+        std::vector<uint8_t> input = seedInput(rng() % SEED_COUNT, (uint8_t)rng());
+        mutate(input, rng);
+        largest = std::max(largest, input.size());
+        int status = runInput(input.data(), input.size());
+        statuses[status == 200 ? 0 : status == 400 ? 1 : 2]++;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("%llu inputs in %.1f s (%.0f/s), largest %zu bytes: %llu accepted, %llu 400, %llu 413\n",
+           (unsigned long long)iterations, seconds, iterations / seconds, largest, (unsigned long long)statuses[0],
+           (unsigned long long)statuses[1], (unsigned long long)statuses[2]);
+}
+
+static void bench(double seconds) {
+    printf("route           seed  bytes  status   parses/s   p99 us\n");
+    for (size_t route = 0; route < ROUTE_COUNT; route++) {
+        for (size_t s = 0; s < SEED_COUNT; s++) {
+            // 1 KB chunks, as WebServer delivers a body
+            std::vector<uint8_t> input = seedInput(s, (uint8_t)(route + ROUTE_COUNT * 10));
+            std::vector<double> times;
+            int status = 0;
+            auto end = std::chrono::steady_clock::now() + std::chrono::duration<double>(seconds / (ROUTE_COUNT * SEED_COUNT));
+            while (std::chrono::steady_clock::now() < end || times.size() < 100) {
+                auto t0 = std::chrono::steady_clock::now();
+                status = runInput(input.data(), input.size());
+                times.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count());
+            }
+            double total = 0;
+            for (double t : times) total += t;
+            std::sort(times.begin(), times.end());
+            printf("%-15s %4zu %6zu %7d %10.0f %8.2f\n", ROUTES[route].uri, s, input.size() - 1, status,
+                   times.size() / (total / 1e6), times[times.size() * 99 / 100]);
+        }
+    }
+}
+
+static bool readFile(const char* path, std::vector<uint8_t>& data) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    uint8_t buffer[4096];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), f)) > 0) data.insert(data.end(), buffer, buffer + n);
+    fclose(f);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    uint64_t iterations = 0;
+    uint32_t seed = 1;
+    double benchSeconds = 0;
+    std::vector<const char*> files;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--iterations") && i + 1 < argc) iterations = strtoull(argv[++i], NULL, 10);
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc) seed = strtoul(argv[++i], NULL, 10);
+        else if (!strcmp(argv[i], "--bench") && i + 1 < argc) benchSeconds = atof(argv[++i]);
+        else if (argv[i][0] != '-') files.push_back(argv[i]);
+        else {
+            fprintf(stderr, "usage: %s [--iterations N] [--seed S] [--bench SECONDS] [input files...]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (!iterations && !benchSeconds && files.empty()) iterations = 200000;
+
+    for (const char* path : files) {
+        std::vector<uint8_t> data;
+        if (!readFile(path, data)) {
+            fprintf(stderr, "cannot read %s\n", path);
+            return 1;
+        }
+        printf("%s: %d\n", path, runInput(data.data(), data.size()));
+    }
+    if (iterations) fuzz(iterations, seed);
+    if (benchSeconds > 0) bench(benchSeconds);
+    return 0;
+}
+
+#endif // HTTP_FUZZ_LIBFUZZER
@@ -0,0 +1,185 @@
+#!/usr/bin/env python3
+"""Load test of the device's HTTP server: how many scrapers before counting suffers.
+
+Runs rounds of 1, 2, 4, ... concurrent clients, each fetching a mix of the
+read-only endpoints back to back, e.g.
+    python3 tools/http_load.py http://radscan-xxxxxx.local --clients 1,2,4,8,16 --seconds 30
+and prints per round the requests per second, the p50 / p99 / max latency,
+the errors, the internal heap change per request and the pulse pipeline
+timing over the round. The timing comes from the /metrics histograms of the
+sampling jitter and the reading-to-pulseTask hand-over ("latency" on serial),
+taken as the difference of a scrape before and after the round. An idle
+round first gives the baseline. A round degrades measurement if readings were
+dropped or the p99 of either histogram exceeds twice the baseline plus
+--slack-us. The last round before the first degraded one is reported as the
+number of scrapers the unit tolerates.
+
+--bodies adds POSTs of an unknown action to /api/tube, which the route refuses
+with 400 after parsing, so the JSON body path is loaded without changing state.
+The heap figures come from the sysinfo sample, which is refreshed every 10 s
+(SYSINFO_SAMPLE_INTERVAL_MS), so each round waits --settle seconds before its
+closing scrape. Standard library only.
+"""
+import argparse
+import re
+import sys
+import threading
+import time
+import urllib.error
+import urllib.request
+
+PATHS = ["/api/data", "/metrics", "/api/history?res=1m&limit=60&format=json", "/api/sysinfo"]
+BODY_PATH, BODY = "/api/tube", b'{"action":"load-test"}'
+SAMPLE = re.compile(r'^radscan_(\w+?)(?:\{le="([^"]+)"\})? (\S+)$')
+HISTOGRAMS = ("pulse_sample_jitter_us", "pulse_handoff_us")
+
+
+def scrape(base, timeout):
+    """Returns the /metrics samples: plain values by name, histograms as [(le, cumulative)]."""
+    with urllib.request.urlopen(base + "/metrics", timeout=timeout) as response:
+        text = response.read().decode()
+    values, buckets = {}, {}
+    for line in text.splitlines():
+        match = SAMPLE.match(line)
+        if not match:
+            continue
+        name, le, value = match.groups()
+        if le is not None:
+            bound = float("inf") if le == "+Inf" else float(le)
+            buckets.setdefault(name[:-len("_bucket")], []).append((bound, float(value)))
+        else:
+            values[name] = float(value)
+    return values, buckets
+
+
+def window_percentile(before, after, fraction):
+    """Upper bucket bound holding the given fraction of the samples added between two scrapes."""
+    deltas = [(bound, a - b) for (bound, a), (_, b) in zip(after, before)]
+    total = deltas[-1][1] if deltas else 0
+    if total <= 0:
+        return 0.0, 0
+    for bound, cumulative in deltas:
+        if cumulative >= fraction * total:
+            return bound, int(total)
+    return float("inf"), int(total)
+
+
+def percentile(sorted_values, fraction):
+    if not sorted_values:
+        return 0.0
+    return sorted_values[min(len(sorted_values) - 1, int(len(sorted_values) * fraction))]
+
+
+def client(base, timeout, bodies, stop, index, results, lock):
+    paths = PATHS + ([None] if bodies else [])
+    i = index
+    latencies, errors = [], 0
+    while not stop.is_set():
+        path = paths[i % len(paths)]
+        i += 1
+        if path is None:
+            request = urllib.request.Request(base + BODY_PATH, data=BODY, method="POST",
+                                             headers={"Content-Type": "application/json"})
+        else:
+            request = urllib.request.Request(base + path)
+        start = time.perf_counter()
+        try:
+            with urllib.request.urlopen(request, timeout=timeout) as response:
+                response.read()
+            ok = True
+        except urllib.error.HTTPError as error:
+            error.read()
+            ok = path is None and error.code == 400  # The refused action is the expected answer
+        except (urllib.error.URLError, OSError):
+            ok = False
+        elapsed = time.perf_counter() - start
+        if ok:
+            latencies.append(elapsed)
+        else:
+            errors += 1
+    with lock:
+        results["latencies"].extend(latencies)
+        results["errors"] += errors
+
+
+def run_round(base, clients, seconds, settle, timeout, bodies):
+    before_values, before_buckets = scrape(base, timeout)
+    results, lock, stop = {"latencies": [], "errors": 0}, threading.Lock(), threading.Event()
+    threads = [threading.Thread(target=client, args=(base, timeout, bodies, stop, i, results, lock))
+               for i in range(clients)]
+    start = time.perf_counter()
+    for thread in threads:
+        thread.start()
+    time.sleep(seconds)
+    stop.set()
+    for thread in threads:
+        thread.join()
+    elapsed = time.perf_counter() - start
+    time.sleep(settle)
+    after_values, after_buckets = scrape(base, timeout)
+
+    latencies = sorted(results["latencies"])
+    requests = len(latencies) + results["errors"]
+    row = {
+        "clients": clients,
+        "rps": len(latencies) / elapsed,
+        "p50_ms": percentile(latencies, 0.50) * 1000,
+        "p99_ms": percentile(latencies, 0.99) * 1000,
+        "max_ms": (latencies[-1] if latencies else 0) * 1000,
+        "errors": results["errors"],
+        "heap_per_request": ((after_values.get("heap_free_bytes", 0) - before_values.get("heap_free_bytes", 0))
+                             / requests if requests else 0.0),
+        "heap_min_free": after_values.get("heap_min_free_bytes", 0),
+        "dropped": int(after_values.get("pulse_readings_dropped_total", 0)
+                       - before_values.get("pulse_readings_dropped_total", 0)),
+    }
+    for name in HISTOGRAMS:
+        row[name] = window_percentile(before_buckets.get(name, []), after_buckets.get(name, []), 0.99)[0]
+    return row
+
+
+def degraded(row, baseline, slack_us):
+    if row["dropped"] > 0:
+        return True
+    return any(row[name] > 2 * baseline[name] + slack_us for name in HISTOGRAMS)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("url", help="device base URL, e.g. http://192.168.1.50")
+    parser.add_argument("--clients", default="1,2,4,8,16", help="comma-separated concurrent clients per round")
+    parser.add_argument("--seconds", type=float, default=30, help="length of each round")
+    parser.add_argument("--settle", type=float, default=11, help="wait before the closing scrape of a round")
+    parser.add_argument("--timeout", type=float, default=10, help="per-request timeout")
+    parser.add_argument("--slack-us", type=float, default=1000, help="jitter allowed above twice the baseline")
+    parser.add_argument("--bodies", action="store_true", help="also POST JSON bodies (refused, no state change)")
+    args = parser.parse_args()
+    base = args.url.rstrip("/")
+
+    try:
+        baseline = run_round(base, 0, args.seconds, args.settle, args.timeout, False)
+    except (urllib.error.URLError, OSError) as error:
+        sys.exit(f"cannot scrape {base}/metrics: {error}")
+    print("clients    req/s   p50 ms   p99 ms   max ms  errors  heap B/req  heap min  "
+          "jitter p99  handoff p99  dropped")
+
+    def show(row, note=""):
+        print(f"{row['clients']:7d} {row['rps']:8.1f} {row['p50_ms']:8.1f} {row['p99_ms']:8.1f} "
+              f"{row['max_ms']:8.1f} {row['errors']:7d} {row['heap_per_request']:11.1f} "
+              f"{row['heap_min_free']:9.0f} {row['pulse_sample_jitter_us']:9.0f}us "
+              f"{row['pulse_handoff_us']:10.0f}us {row['dropped']:8d}{note}")
+
+    show(baseline, "  (idle baseline)")
+    tolerated = 0
+    for clients in (int(c) for c in args.clients.split(",")):
+        row = run_round(base, clients, args.seconds, args.settle, args.timeout, args.bodies)
+        bad = degraded(row, baseline, args.slack_us)
+        show(row, "  measurement timing degraded" if bad else "")
+        if bad:
+            break
+        tolerated = clients
+    print(f"tolerates {tolerated} concurrent scrapers" if tolerated else "degraded with a single scraper")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,58 @@
+#!/usr/bin/env python3
+"""Sign a firmware image for installation from the microSD card.
+
+The device checks CARD_UPDATE_PATH (default /firmware.rdu) at boot, verifies
+the signature against CARD_UPDATE_PUBLIC_KEY and installs the image (see
+src/card_update.h for the container). The key is an ECDSA P-256 key; the
+public half goes into CARD_UPDATE_PUBLIC_KEY as a PEM string:
+
+    openssl ecparam -name prime256v1 -genkey -noout -out update_key.pem
+    openssl ec -in update_key.pem -pubout
+    python3 tools/make_card_update.py .pio/build/esp32s3/firmware.bin \\
+        --key update_key.pem -o /media/card/firmware.rdu
+
+Signs with the openssl command line tool.
+"""
+import argparse
+import hashlib
+import struct
+import subprocess
+import sys
+
+MAGIC = b"RDU1"
+SIGNATURE_MAX = 72
+HEADER_SIZE = 128
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("image", help="firmware.bin to install")
+    parser.add_argument("--key", required=True, help="PEM private key (ECDSA P-256)")
+    parser.add_argument("-o", "--output", required=True)
+    args = parser.parse_args()
+
+    with open(args.image, "rb") as f:
+        image = f.read()
+    if not image or image[0] != 0xE9:
+        sys.exit("%s is not an ESP32 app image" % args.image)
+
+    digest = hashlib.sha256(image).digest()
+    # pkeyutl signs its input as it is: the device verifies over the digest
+    result = subprocess.run(["openssl", "pkeyutl", "-sign", "-inkey", args.key], input=digest,
+                            stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+    if result.returncode != 0:
+        sys.exit("openssl: " + result.stderr.decode(errors="replace").strip())
+    signature = result.stdout
+    if not 8 <= len(signature) <= SIGNATURE_MAX or signature[0] != 0x30:
+        sys.exit("the key must be ECDSA P-256")
+    header = MAGIC + struct.pack("<IB3x", len(image), len(signature)) + digest
+    header += signature.ljust(SIGNATURE_MAX, b"\0") + bytes(12)
+    assert len(header) == HEADER_SIZE
+
+    with open(args.output, "wb") as f:
+        f.write(header + image)
+    print("wrote %s: %d bytes, SHA-256 %s" % (args.output, len(image), digest.hex()))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,130 @@
+#!/usr/bin/env python3
+"""Build a compressed or delta firmware image for POST /ota/stream.
+
+The device inflates the zlib stream as it arrives and writes the result into
+the OTA partition (see src/ota_stream.h for the container). Without --base the
+stream is the full image; with --base (the firmware the devices are running)
+it is a delta of copy / insert operations against it (src/ota_delta.h). The
+smaller of the two is written unless --full or --delta forces one.
+
+    python3 tools/make_ota_image.py .pio/build/esp32s3/firmware.bin \\
+        --base old/firmware.bin -o firmware.rdz
+    curl -F "firmware=@firmware.rdz" http://<device>/ota/stream
+"""
+import argparse
+import hashlib
+import struct
+import sys
+import zlib
+
+MAGIC = b"RDZ1"
+KIND_FULL = 0
+KIND_DELTA = 1
+OP_COPY = 0x01
+OP_INSERT = 0x02
+
+BLOCK = 32      # Shortest copy worth an operation (9 bytes of header)
+STRIDE = 8      # Base positions indexed; every target position is probed
+
+
+def make_delta(base, target):
+    """Greedy copy / insert operations that rebuild target from base."""
+    index = {}
+    for offset in range(0, len(base) - BLOCK + 1, STRIDE):
+        index.setdefault(base[offset:offset + BLOCK], offset)
+
+    ops = bytearray()
+    literal_start = 0
+    pos = 0
+
+    def flush_literal(end):
+        if end > literal_start:
+            ops.extend(struct.pack("<BI", OP_INSERT, end - literal_start))
+            ops.extend(target[literal_start:end])
+
+    while pos + BLOCK <= len(target):
+        src = index.get(target[pos:pos + BLOCK])
+        if src is None:
+            pos += 1
+            continue
+        # Extend the match forwards, then backwards into the pending literal
+        length = BLOCK
+        while pos + length < len(target) and src + length < len(base) and \
+                target[pos + length] == base[src + length]:
+            length += 1
+        while pos > literal_start and src > 0 and target[pos - 1] == base[src - 1]:
+            pos -= 1
+            src -= 1
+            length += 1
+        flush_literal(pos)
+        ops.extend(struct.pack("<BII", OP_COPY, src, length))
+        pos += length
+        literal_start = pos
+    flush_literal(len(target))
+    return bytes(ops)
+
+
+def apply_delta(base, ops):
+    """Reference decoder, used to check every delta before it is written."""
+    out = bytearray()
+    i = 0
+    while i < len(ops):
+        op = ops[i]
+        if op == OP_COPY:
+            offset, length = struct.unpack_from("<II", ops, i + 1)
+            out.extend(base[offset:offset + length])
+            i += 9
+        elif op == OP_INSERT:
+            (length,) = struct.unpack_from("<I", ops, i + 1)
+            out.extend(ops[i + 5:i + 5 + length])
+            i += 5 + length
+        else:
+            raise ValueError("bad operation")
+    return bytes(out)
+
+
+def container(kind, target, base, stream):
+    base_size = len(base) if base is not None else 0
+    base_digest = hashlib.sha256(base).digest() if base is not None else bytes(32)
+    header = MAGIC + struct.pack("<B3xII", kind, len(target), base_size)
+    header += hashlib.sha256(target).digest() + base_digest
+    assert len(header) == 80
+    return header + zlib.compress(stream, 9)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("image", help="new firmware.bin")
+    parser.add_argument("--base", help="firmware.bin the devices are running")
+    parser.add_argument("-o", "--output", required=True)
+    group = parser.add_mutually_exclusive_group()
+    group.add_argument("--full", action="store_true", help="always write the compressed full image")
+    group.add_argument("--delta", action="store_true", help="always write the delta")
+    args = parser.parse_args()
+
+    with open(args.image, "rb") as f:
+        target = f.read()
+    candidates = []
+    if not args.delta:
+        candidates.append(("full", container(KIND_FULL, target, None, target)))
+    if args.base:
+        with open(args.base, "rb") as f:
+            base = f.read()
+        ops = make_delta(base, target)
+        if apply_delta(base, ops) != target:
+            sys.exit("delta does not reproduce the image")
+        if not args.full:
+            candidates.append(("delta", container(KIND_DELTA, target, base, ops)))
+    elif args.delta:
+        sys.exit("--delta needs --base")
+
+    for name, data in candidates:
+        print("%-5s %8d bytes (%.1f %% of %d)" % (name, len(data), 100.0 * len(data) / len(target), len(target)))
+    name, data = min(candidates, key=lambda c: len(c[1]))
+    with open(args.output, "wb") as f:
+        f.write(data)
+    print("wrote %s image to %s" % (name, args.output))
+
+
+if __name__ == "__main__":
+    main()
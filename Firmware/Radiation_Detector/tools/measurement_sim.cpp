@@ -0,0 +1,203 @@
+/**
+ * @file measurement_sim.cpp
+ * @brief Host simulation of the dose-rate pipeline with a synthetic Geiger source.
+ *
+ * Runs PulseAccumulator, the rate estimators, DoseStats, DoseAccumulator and
+ * the aligned chart interval counters from src/ exactly as pulseTask and uiTask do
+ * (50 ms polls), against a simulated clock, so a 24-hour chart scenario
+ * finishes in seconds.
+ *
+ * The source draws Poisson arrivals at a piecewise-constant true rate and drops
+ * every arrival within the tube dead time of the last registered pulse
+ * (non-paralyzable), which reproduces saturation at high rates.
+ *
+ * Build and run from Firmware/Radiation_Detector:
+ *     g++ -std=gnu++11 -O2 -Isrc tools/measurement_sim.cpp -o measurement_sim
+ *     ./measurement_sim --hours 24 --cpm 30 --step 3600:3000 --step 7200:30
+ *
+ * Output is CSV on stdout: one line per closed chart interval
+ * ("chart,end_s,usvh,true_usvh") and a summary on stderr. The simulated clock
+ * starts at 0 and has no UTC, so the intervals align to the monotonic clock.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <random>
+#include <vector>
+
+#include "measurement.h"
+#include "dead_time.h"
+#include "ring_history.h"
+#include "tube_profile.h"
+
+static const uint32_t POLL_MS = 50;              ///< pulseTask and uiTask period
+static const float CONVERSION_FACTOR = ActiveTube::CPM_PER_USVH; ///< Default of the build's tube
+static const int CHART1_INTERVAL_SECONDS = 180;
+static const int CHART3_INTERVAL_SECONDS = 3600;
+
+struct RateStep {
+    double startSeconds;
+    double cpm;
+};
+
+/**
+ * @brief Poisson pulse train with steps in rate and non-paralyzable dead time.
+ */
+class SimulatedSource : public MeasurementHal {
+public:
+    SimulatedSource(const std::vector<RateStep>& steps, double deadTimeUs, uint32_t seed)
+        : steps_(steps), deadTimeSec_(deadTimeUs * 1e-6), rng_(seed), nowMs_(0),
+          registered_(0), nextArrival_(0.0), lastRegistered_(-1.0) {
+        nextArrival_ = drawInterval(0.0);
+    }
+
+    uint32_t nowMs() { return nowMs_; }
+    uint32_t pulseCount() { return registered_; }
+
+    /// Advances the clock, registering every arrival up to the new time.
+    void advance(uint32_t ms) {
+        nowMs_ += ms;
+        double now = nowMs_ / 1000.0;
+        while (nextArrival_ <= now) {
+            if (lastRegistered_ < 0.0 || nextArrival_ - lastRegistered_ >= deadTimeSec_) {
+                registered_++;
+                lastRegistered_ = nextArrival_;
+            }
+            nextArrival_ += drawInterval(nextArrival_);
+        }
+    }
+
+    /// True rate in CPM at @p seconds.
+    double trueCpm(double seconds) const {
+        double cpm = 0.0;
+        for (size_t i = 0; i < steps_.size(); i++) {
+            if (steps_[i].startSeconds <= seconds) cpm = steps_[i].cpm;
+        }
+        return cpm;
+    }
+
+private:
+    // Exponential gap at the rate in force at @p t (a step takes effect from the next arrival)
+    double drawInterval(double t) {
+        double cps = trueCpm(t) / 60.0;
+        if (cps <= 0.0) return 1.0;
+        std::exponential_distribution<double> gap(cps);
+        return gap(rng_);
+    }
+
+    std::vector<RateStep> steps_;
+    double deadTimeSec_;
+    std::mt19937_64 rng_;
+    uint32_t nowMs_;
+    uint32_t registered_;
+    double nextArrival_;
+    double lastRegistered_;
+};
+
+static void usage(const char* argv0) {
+    fprintf(stderr,
+            "usage: %s [--hours H] [--cpm CPM] [--step SECONDS:CPM]... [--dead-time-us US] [--seed N]\n",
+            argv0);
+}
+
+int main(int argc, char** argv) {
+    double hours = 24.0;
+    double deadTimeUs = ActiveTube::DEAD_TIME_US; // DEAD_TIME_DEFAULT_US
+    uint32_t seed = 1;
+    std::vector<RateStep> steps;
+    RateStep base = {0.0, 30.0};
+    steps.push_back(base);
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--hours") && i + 1 < argc) {
+            hours = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--cpm") && i + 1 < argc) {
+            steps[0].cpm = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--step") && i + 1 < argc) {
+            RateStep step;
+            if (sscanf(argv[++i], "%lf:%lf", &step.startSeconds, &step.cpm) != 2) {
+                usage(argv[0]);
+                return 1;
+            }
+            steps.push_back(step);
+        } else if (!strcmp(argv[i], "--dead-time-us") && i + 1 < argc) {
+            deadTimeUs = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--seed") && i + 1 < argc) {
+            seed = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    SimulatedSource source(steps, deadTimeUs, seed);
+    RateWindows windows;
+    AdaptiveRateEstimator adaptive;
+    PulseAccumulator pulses(windows, adaptive);
+    DoseStats dose;
+    DoseAccumulator cumulative;
+    AlignedIntervalCounter chart1(CHART1_INTERVAL_SECONDS);
+    AlignedIntervalCounter chart3(CHART3_INTERVAL_SECONDS);
+    RingHistory<float, 20> chart1History;
+    RingHistory<float, 24> chart3History;
+    // True-rate integrals over the same intervals, for comparison
+    double chart1True = 0.0, chart3True = 0.0;
+
+    pulses.begin(source);
+    printf("chart,end_s,usvh,true_usvh\n");
+    uint64_t endMs = (uint64_t)(hours * 3600000.0);
+    uint32_t adaptiveChanges = 0;
+    for (uint64_t t = 0; t < endMs; t += POLL_MS) {
+        source.advance(POLL_MS);
+        bool secondClosed = false;
+        pulses.poll(source, &secondClosed);
+        AlignedInterval interval;
+        bool chart1Closed = false, chart3Closed = false;
+        float chart1Usvh = 0.0f, chart3Usvh = 0.0f;
+        if (secondClosed) {
+            uint32_t counts = pulses.lastSecondCounts();
+            uint32_t nowSeconds = source.nowMs() / 1000;
+            cumulative.addSecond(counts, deadTimeUs * 1e-6f, 1.0f / CONVERSION_FACTOR);
+            if (chart1.addSecond(nowSeconds, 0, counts, true, &interval)) {
+                chart1Closed = true;
+                chart1Usvh = correctDeadTimeCpm(interval.cps() * 60.0f, deadTimeUs * 1e-6f) / CONVERSION_FACTOR;
+            }
+            if (chart3.addSecond(nowSeconds, 0, counts, true, &interval)) {
+                chart3Closed = true;
+                chart3Usvh = correctDeadTimeCpm(interval.cps() * 60.0f, deadTimeUs * 1e-6f) / CONVERSION_FACTOR;
+            }
+        }
+
+        // uiTask side, same order as the firmware loop
+        float correctedCpm = correctDeadTimeCpm(adaptive.cpm(), deadTimeUs * 1e-6f);
+        float dtSec = POLL_MS / 1000.0f;
+        dose.update(correctedCpm, pulses.totalCounts(), source.nowMs(), 1.0f / CONVERSION_FACTOR);
+
+        double trueCpm = source.trueCpm(source.nowMs() / 1000.0);
+        chart1True += trueCpm * dtSec;
+        chart3True += trueCpm * dtSec;
+        if (chart1Closed) {
+            chart1History.push(chart1Usvh);
+            printf("1h,%u,%.4f,%.4f\n", source.nowMs() / 1000, chart1Usvh,
+                   chart1True / CHART1_INTERVAL_SECONDS / CONVERSION_FACTOR);
+            chart1True = 0.0;
+        }
+        if (chart3Closed) {
+            chart3History.push(chart3Usvh);
+            printf("24h,%u,%.4f,%.4f\n", source.nowMs() / 1000, chart3Usvh,
+                   chart3True / CHART3_INTERVAL_SECONDS / CONVERSION_FACTOR);
+            chart3True = 0.0;
+        }
+        adaptiveChanges = adaptive.changeCount();
+    }
+
+    fprintf(stderr, "Simulated %.1f h: %u counts registered, %u adaptive change points\n", hours,
+            pulses.totalCounts(), adaptiveChanges);
+    fprintf(stderr, "Dose: current %.3f, average %.3f, max %.3f uSv/h, cumulative %.5f mSv\n",
+            dose.current, dose.average, dose.maximum, cumulative.msv());
+    fprintf(stderr, "Chart scale: 1h %.0f, 24h %.0f\n", chartScaleMax(chart1History.max()),
+            chartScaleMax(chart3History.max()));
+    return 0;
+}
@@ -0,0 +1,168 @@
+#!/usr/bin/env python3
+"""Pack the SquareLine images into assets/assets.bin for the "assets" partition.
+
+SquareLine exports every image as a C array (ui_img_*.c). Those exports are
+kept in assets/images instead of src, and this script turns them into an
+asset pack (see src/asset_pack.h for the format) plus src/ui_img_assets.c,
+which defines the same lv_img_dsc_t symbols as placeholders that the asset
+pack decoder resolves at run time. The app image no longer carries pixels.
+
+Run after exporting images from SquareLine (move the new ui_img_*.c files
+from src to assets/images first):
+    python3 tools/pack_assets.py
+and flash the pack into the partition from partitions.csv, either over USB
+    parttool.py write_partition --partition-name assets --input assets/assets.bin
+or over the air with ElegantOTA's "Filesystem" mode, which writes the first
+SPIFFS-type partition (the asset partition is placed before the LittleFS one).
+"""
+import glob
+import os
+import re
+import struct
+import zlib
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SRC = os.path.join(ROOT, "assets", "images")
+PACK = os.path.join(ROOT, "assets", "assets.bin")
+STUBS = os.path.join(ROOT, "src", "ui_img_assets.c")
+
+MAGIC = b"LVAP"
+VERSION = 1
+NAME_LEN = 32
+PARTITION_SIZE = 0x100000  # partitions.csv
+
+ENCODING_RAW = 0  # LVGL's own layout, drawn straight from the flash mapping
+ENCODING_RLE = 1  # Pixel runs, expanded into PSRAM when the image is opened
+RLE_MIN_BYTES = 8192  # Smaller images stay raw: they are drawn on every screen
+
+# Bytes per pixel of the color formats that can be run-length encoded (16-bit color)
+PIXEL_BYTES = {"LV_IMG_CF_TRUE_COLOR": 2, "LV_IMG_CF_TRUE_COLOR_ALPHA": 3}
+# Values of lv_img_cf_t (lvgl/src/draw/lv_img_buf.h)
+COLOR_FORMATS = {
+    "LV_IMG_CF_TRUE_COLOR": 4,
+    "LV_IMG_CF_TRUE_COLOR_ALPHA": 5,
+    "LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED": 6,
+    "LV_IMG_CF_INDEXED_1BIT": 7,
+    "LV_IMG_CF_INDEXED_2BIT": 8,
+    "LV_IMG_CF_INDEXED_4BIT": 9,
+    "LV_IMG_CF_INDEXED_8BIT": 10,
+    "LV_IMG_CF_ALPHA_1BIT": 11,
+    "LV_IMG_CF_ALPHA_2BIT": 12,
+    "LV_IMG_CF_ALPHA_4BIT": 13,
+    "LV_IMG_CF_ALPHA_8BIT": 14,
+}
+
+
+def parse(path):
+    with open(path) as f:
+        text = f.read()
+    name = re.search(r"const lv_img_dsc_t (\w+) =", text).group(1)
+    source = re.search(r"// IMAGE DATA: (.*)", text).group(1).strip()
+    array = text[text.index("_data[] = {"):text.index("};", text.index("_data[] = {"))]
+    data = bytes(int(v, 16) for v in re.findall(r"0x[0-9a-fA-F]+", array))
+    w = int(re.search(r"\.header\.w = (\d+)", text).group(1))
+    h = int(re.search(r"\.header\.h = (\d+)", text).group(1))
+    cf = re.search(r"\.header\.cf = (\w+)", text).group(1)
+    return {"name": name, "source": source, "data": data, "w": w, "h": h, "cf": cf}
+
+
+def rle(data, unit):
+    """Packets of a control byte and pixels: 0x80 | (n - 1) before one pixel
+    repeated n times, n - 1 before n literal pixels (n <= 128)."""
+    pixels = [data[i:i + unit] for i in range(0, len(data), unit)]
+    out = bytearray()
+    literal = []
+    i = 0
+    while i < len(pixels):
+        run = 1
+        while i + run < len(pixels) and run < 128 and pixels[i + run] == pixels[i]:
+            run += 1
+        if run >= 2:
+            if literal:
+                out.append(len(literal) - 1)
+                out += b"".join(literal)
+                literal = []
+            out.append(0x80 | (run - 1))
+            out += pixels[i]
+            i += run
+            continue
+        literal.append(pixels[i])
+        i += 1
+        if len(literal) == 128:
+            out.append(127)
+            out += b"".join(literal)
+            literal = []
+    if literal:
+        out.append(len(literal) - 1)
+        out += b"".join(literal)
+    return bytes(out)
+
+
+def main():
+    images = [parse(p) for p in sorted(glob.glob(os.path.join(SRC, "ui_img_*.c")))]
+    header_size = 16
+    entry_size = NAME_LEN + 20
+    offset = header_size + entry_size * len(images)
+    entries = b""
+    blobs = b""
+    lines = []
+    for img in images:
+        if len(img["name"]) >= NAME_LEN:
+            raise ValueError("%s: name longer than %d characters" % (img["name"], NAME_LEN - 1))
+        expected = img["w"] * img["h"] * PIXEL_BYTES.get(img["cf"], 0)
+        if expected and len(img["data"]) != expected:
+            raise ValueError("%s: %d bytes, expected %d" % (img["name"], len(img["data"]), expected))
+        stored = img["data"]
+        encoding = ENCODING_RAW
+        if img["cf"] in PIXEL_BYTES and len(img["data"]) >= RLE_MIN_BYTES:
+            packed = rle(img["data"], PIXEL_BYTES[img["cf"]])
+            if len(packed) * 2 <= len(img["data"]):
+                stored = packed
+                encoding = ENCODING_RLE
+        pad = -(offset + len(blobs)) % 4  # Raw pixels stay 4-byte aligned in the mapping
+        blobs += b"\0" * pad
+        entries += struct.pack("<%dsHHBBHIII" % NAME_LEN, img["name"].encode(), img["w"], img["h"],
+                               COLOR_FORMATS[img["cf"]], encoding, 0, offset + len(blobs), len(stored),
+                               len(img["data"]))
+        blobs += stored
+        lines.append("%-28s %3dx%-3d %6d -> %6d bytes (%s)" % (img["name"], img["w"], img["h"], len(img["data"]),
+                                                             len(stored), "rle" if encoding else "raw"))
+    body = entries + blobs
+    total = header_size + len(body)
+    if total > PARTITION_SIZE:
+        raise ValueError("pack of %d bytes does not fit the %d-byte partition" % (total, PARTITION_SIZE))
+    pack = MAGIC + struct.pack("<HHII", VERSION, len(images), total, zlib.crc32(body) & 0xFFFFFFFF) + body
+    with open(PACK, "wb") as f:
+        f.write(pack)
+
+    stubs = [
+        "// Generated by tools/pack_assets.py from assets/images - do not edit.",
+        "// The pixels are in the asset partition (asset_pack.h); .data names the",
+        "// pack entry and LV_IMG_CF_USER_ENCODED_0 routes the image to its decoder.",
+        "",
+        "#include \"ui.h\"",
+    ]
+    for img in images:
+        stubs += [
+            "",
+            "// %s" % img["source"],
+            "const lv_img_dsc_t %s = {" % img["name"],
+            "    .header.always_zero = 0,",
+            "    .header.w = %d," % img["w"],
+            "    .header.h = %d," % img["h"],
+            "    .data_size = 0,",
+            "    .header.cf = LV_IMG_CF_USER_ENCODED_0,",
+            "    .data = (const uint8_t *)\"%s\"" % img["name"],
+            "};",
+        ]
+    with open(STUBS, "w") as f:
+        f.write("\n".join(stubs) + "\n")
+
+    for line in lines:
+        print(line)
+    print("%s: %d images, %d bytes, CRC %08x" % (os.path.relpath(PACK, ROOT), len(images), total,
+                                                zlib.crc32(body) & 0xFFFFFFFF))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,282 @@
+/**
+ * @file pulse_replay.cpp
+ * @brief Host replay of pulse traces recorded with "pulsetrace record".
+ *
+ * Runs a .rpt file (src/pulse_trace.h) through PulseReplay (src/pulse_replay.h),
+ * the same PulseAccumulator, DoseAccumulator and AlarmEngine code as pulseTask
+ * and the on-device replay, so the checksum printed here matches the one of
+ * "pulsetrace replay" for the same file and firmware sources. A change to the
+ * pipeline shows up as a different checksum; --csv shows the seconds where
+ * it diverges.
+ *
+ * --synth writes a trace of Poisson arrivals (non-paralyzable dead time) with
+ * 50 ms samples, for benchmarks and for trying a change without a source.
+ *
+ * Build and run from Firmware/Radiation_Detector:
+ *     g++ -std=gnu++11 -O2 -Isrc tools/pulse_replay.cpp -o pulse_replay
+ *     ./pulse_replay --synth bench.rpt --seconds 3600 --cpm 600000
+ *     ./pulse_replay bench.rpt --csv > seconds.csv
+ *     ./pulse_replay bench.rpt --bench 20
+ *
+ * Output: with --csv one line per closed second on stdout
+ * ("second,ms,counts,pulses,cpm10,cpm60,adaptive_cpm,rate_usvh,dose_msv,alarm");
+ * the summary and checksum on stderr. --speed X paces the replay at X times
+ * real time by the recorded sample clock.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "tube_profile.h"
+#include "config.h"
+#include "pulse_trace.h"
+#include "pulse_replay.h"
+
+static const uint32_t SAMPLE_MS = 50; ///< Sampling task period without event wakes
+
+static void usage(const char* argv0) {
+    fprintf(stderr,
+            "usage: %s trace.rpt [--csv] [--bench N] [--speed X]\n"
+            "       %s --synth out.rpt [--seconds S] [--cpm C] [--dead-time-us T] [--seed N]\n",
+            argv0, argv0);
+    exit(2);
+}
+
+static double nowSeconds() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static bool readFile(const char* path, std::vector<uint8_t>& bytes) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return false;
+    uint8_t buffer[65536];
+    size_t got;
+    while ((got = fread(buffer, 1, sizeof(buffer), file)) > 0) bytes.insert(bytes.end(), buffer, buffer + got);
+    fclose(file);
+    return true;
+}
+
+/**
+ * @brief Writes a synthetic trace in chunk-sized pieces, as the recorder does.
+ */
+static int synthesize(const char* path, double seconds, double cpm, double deadTimeUs, uint32_t seed) {
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        perror(path);
+        return 1;
+    }
+    PulseTraceHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = PULSE_TRACE_MAGIC;
+    header.version = PULSE_TRACE_VERSION;
+    header.headerBytes = sizeof(header);
+    header.deadTimeUs = (float)deadTimeUs;
+    header.cpmPerUsvH = ActiveTube::CPM_PER_USVH;
+    header.rateAlarmUsvH = 1.0f;
+    header.doseAlarmMsv = 1.0f;
+    header.warnFraction = ALARM_WARN_FRACTION;
+    header.dangerFactor = ALARM_DANGER_FACTOR;
+    fwrite(&header, sizeof(header), 1, file);
+
+    std::mt19937 rng(seed);
+    std::exponential_distribution<double> gap(cpm / 60e6); // Per microsecond
+    std::vector<uint8_t> chunk(PULSE_TRACE_CHUNK_BYTES);
+    PulseTraceWriter writer;
+    writer.begin(chunk.data(), chunk.size());
+    writer.sync(0);
+
+    double arrivalUs = gap(rng);
+    double lastRegisteredUs = -1e12;
+    uint32_t count = 0;
+    uint64_t pulses = 0;
+    uint64_t endUs = (uint64_t)(seconds * 1e6);
+    for (uint64_t sampleUs = SAMPLE_MS * 1000; sampleUs <= endUs; sampleUs += SAMPLE_MS * 1000) {
+        while (arrivalUs < sampleUs) {
+            if (arrivalUs - lastRegisteredUs >= deadTimeUs) {
+                lastRegisteredUs = arrivalUs;
+                if (!writer.hasRoom()) {
+                    fwrite(chunk.data(), 1, writer.length(), file);
+                    writer.begin(chunk.data(), chunk.size());
+                    writer.sync(0);
+                }
+                writer.pulse((uint32_t)(uint64_t)arrivalUs);
+                count++;
+                pulses++;
+            }
+            arrivalUs += gap(rng);
+        }
+        if (!writer.hasRoom()) {
+            fwrite(chunk.data(), 1, writer.length(), file);
+            writer.begin(chunk.data(), chunk.size());
+            writer.sync(0);
+        }
+        writer.sample((uint32_t)(sampleUs / 1000), count);
+    }
+    if (!writer.hasRoom()) {
+        fwrite(chunk.data(), 1, writer.length(), file);
+        writer.begin(chunk.data(), chunk.size());
+    }
+    writer.end();
+    fwrite(chunk.data(), 1, writer.length(), file);
+    long bytes = ftell(file);
+    fclose(file);
+    fprintf(stderr, "Wrote %s: %.0f s, %llu pulses, %ld bytes (%.2f bytes/pulse)\n", path, seconds,
+            (unsigned long long)pulses, bytes, pulses ? (double)bytes / pulses : 0.0);
+    return 0;
+}
+
+struct ReplayTotals {
+    uint32_t checksum;
+    uint32_t seconds;
+    uint32_t samples;
+    uint32_t pulses;
+    uint32_t dropped;
+    uint64_t events;
+    double doseMsv;
+    uint8_t maxAlarmLevel;
+};
+
+/**
+ * @brief One replay of the in-memory trace.
+ * @param csv Print every closed second
+ * @param speed Pace at this multiple of real time (0: as fast as possible)
+ */
+static ReplayTotals replay(const PulseTraceHeader& header, const uint8_t* events, size_t length, bool csv,
+                           double speed) {
+    PulseReplay* pipeline = new PulseReplay();
+    pipeline->begin(header);
+    PulseTraceReader reader;
+    reader.setBuffer(events, length);
+    PulseTraceEvent event;
+    PulseReplaySecond second;
+    ReplayTotals totals = {};
+    bool haveFirst = false;
+    uint32_t firstMs = 0;
+    double start = nowSeconds();
+
+    while (reader.next(event)) {
+        totals.events++;
+        if (event.type == PULSE_TRACE_END) break;
+        if (event.type == PULSE_TRACE_SAMPLE && !haveFirst) {
+            firstMs = event.ms;
+            haveFirst = true;
+        }
+        if (!pipeline->feed(event, &second)) continue;
+        totals.doseMsv = second.doseMsv;
+        if (second.alarmLevel > totals.maxAlarmLevel) totals.maxAlarmLevel = second.alarmLevel;
+        if (speed > 0.0) {
+            double ahead = start + (uint32_t)(second.ms - firstMs) / 1000.0 / speed - nowSeconds();
+            if (ahead > 0.0) std::this_thread::sleep_for(std::chrono::duration<double>(ahead));
+        }
+        if (csv) {
+            printf("second,%u,%u,%u,%.2f,%.2f,%.2f,%.5f,%.6f,%s\n", second.ms, second.counts, second.pulses,
+                   second.cpm10, second.cpm60, second.adaptiveCpm, second.rateUsvH, second.doseMsv,
+                   alarmLevelName(second.alarmLevel));
+        }
+    }
+    totals.checksum = pipeline->checksum();
+    totals.seconds = pipeline->seconds();
+    totals.samples = pipeline->samples();
+    totals.pulses = pipeline->pulses();
+    totals.dropped = pipeline->droppedEvents();
+    delete pipeline;
+    return totals;
+}
+
+int main(int argc, char** argv) {
+    const char* tracePath = nullptr;
+    const char* synthPath = nullptr;
+    bool csv = false;
+    int benchRuns = 0;
+    double speed = 0.0;
+    double seconds = 600.0;
+    double cpm = 30.0;
+    double deadTimeUs = ActiveTube::DEAD_TIME_US;
+    uint32_t seed = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--csv")) {
+            csv = true;
+        } else if (!strcmp(argv[i], "--bench") && i + 1 < argc) {
+            benchRuns = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--speed") && i + 1 < argc) {
+            speed = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--synth") && i + 1 < argc) {
+            synthPath = argv[++i];
+        } else if (!strcmp(argv[i], "--seconds") && i + 1 < argc) {
+            seconds = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--cpm") && i + 1 < argc) {
+            cpm = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--dead-time-us") && i + 1 < argc) {
+            deadTimeUs = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--seed") && i + 1 < argc) {
+            seed = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (argv[i][0] != '-' && !tracePath) {
+            tracePath = argv[i];
+        } else {
+            usage(argv[0]);
+        }
+    }
+    if (synthPath) return synthesize(synthPath, seconds, cpm, deadTimeUs, seed);
+    if (!tracePath) usage(argv[0]);
+
+    std::vector<uint8_t> bytes;
+    if (!readFile(tracePath, bytes)) {
+        perror(tracePath);
+        return 1;
+    }
+    PulseTraceHeader header;
+    if (bytes.size() < sizeof(header)) {
+        fprintf(stderr, "%s: too short for a pulse trace\n", tracePath);
+        return 1;
+    }
+    memcpy(&header, bytes.data(), sizeof(header));
+    if (header.magic != PULSE_TRACE_MAGIC || header.version != PULSE_TRACE_VERSION ||
+        header.headerBytes != sizeof(header)) {
+        fprintf(stderr, "%s: not a version %d pulse trace\n", tracePath, PULSE_TRACE_VERSION);
+        return 1;
+    }
+    const uint8_t* events = bytes.data() + header.headerBytes;
+    size_t length = bytes.size() - header.headerBytes;
+
+    if (csv) printf("second,ms,counts,pulses,cpm10,cpm60,adaptive_cpm,rate_usvh,dose_msv,alarm\n");
+    double start = nowSeconds();
+    ReplayTotals totals = replay(header, events, length, csv, speed);
+    double elapsed = nowSeconds() - start;
+    fprintf(stderr,
+            "%s: %u s, %u samples, %u pulses, %u dropped events, dead time %.1f us, %.1f CPM per uSv/h\n"
+            "Final dose %.6f mSv, max alarm %s\n"
+            "Checksum %08x\n",
+            tracePath, totals.seconds, totals.samples, totals.pulses, totals.dropped, header.deadTimeUs,
+            header.cpmPerUsvH, totals.doseMsv, alarmLevelName(totals.maxAlarmLevel), totals.checksum);
+    if (speed == 0.0 && !csv) {
+        fprintf(stderr, "Replayed in %.3f s (%.2f Mpulses/s)\n", elapsed, totals.pulses / elapsed / 1e6);
+    }
+
+    for (int run = 0; run < benchRuns; run++) {
+        // Decode and pipeline together, then the decode alone
+        double runStart = nowSeconds();
+        ReplayTotals again = replay(header, events, length, false, 0.0);
+        double pipeline = nowSeconds() - runStart;
+
+        runStart = nowSeconds();
+        PulseTraceReader reader;
+        reader.setBuffer(events, length);
+        PulseTraceEvent event;
+        uint64_t decoded = 0;
+        while (reader.next(event)) decoded++;
+        double decode = nowSeconds() - runStart;
+
+        fprintf(stderr, "bench %d: pipeline %.2f Mpulses/s (%.2f Mevents/s), decode %.2f Mevents/s%s\n", run + 1,
+                again.pulses / pipeline / 1e6, again.events / pipeline / 1e6, decoded / decode / 1e6,
+                again.checksum == totals.checksum ? "" : ", CHECKSUM MISMATCH");
+        if (again.checksum != totals.checksum) return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,289 @@
+/**
+ * @file rate_bench.cpp
+ * @brief Host comparison of the rate estimators (src/rate_estimator.h) on recorded traces.
+ *
+ * Each .rpt file (src/pulse_trace.h, "pulsetrace record") is replayed through
+ * PulseReplay (src/pulse_replay.h) to get the 1-second buckets pulseTask
+ * closed; without a trace, --cpm/--seconds make Poisson buckets instead. Every
+ * estimator then runs over the buckets, and the bench scores:
+ *  - noise: the RMS deviation of the estimate from the centred --ref-window
+ *    mean of the buckets (a hindsight reference), relative to it, after the
+ *    first --warmup seconds;
+ *  - rise / fall: a step of --step-cps Poisson counts is added to the buckets
+ *    from --step-at for --step-for seconds; the rise time is the seconds until
+ *    the estimate first covers 90 % of the step, the fall time the seconds
+ *    after its end until it is back within 10 % of it;
+ *  - cost: nanoseconds (and TSC cycles on x86) per closed second, over
+ *    --runs passes of the buckets.
+ * The same estimator classes run on the device ("estimators"), where the
+ * bank counts ESP32-S3 cycles; the host cost ranks them, the device gives
+ * the absolute numbers.
+ *
+ * Build and run from Firmware/Radiation_Detector:
+ *     g++ -std=gnu++11 -O2 -Isrc tools/rate_bench.cpp -o rate_bench
+ *     ./rate_bench background.rpt --step-cps 5
+ *     ./rate_bench --cpm 30 --seconds 7200 --step-cps 2 --csv > estimates.csv
+ *
+ * Output: the score table on stdout; with --csv one line per second instead
+ * ("second,counts,reference,<estimator>...", step included).
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <random>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "config.h"
+#include "pulse_trace.h"
+#include "pulse_replay.h"
+#include "rate_estimator.h"
+
+static void usage(const char* argv0) {
+    fprintf(stderr,
+            "usage: %s [trace.rpt ...] [--cpm C --seconds S] [--step-cps X] [--step-at S] [--step-for S]\n"
+            "          [--ref-window S] [--warmup S] [--runs N] [--seed N] [--csv]\n",
+            argv0);
+    exit(2);
+}
+
+static double nowSeconds() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static uint64_t cycles() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Appends the buckets of one trace. @return false if it is not a trace
+ */
+static bool readBuckets(const char* path, std::vector<uint32_t>& buckets) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        perror(path);
+        return false;
+    }
+    std::vector<uint8_t> bytes;
+    uint8_t buffer[65536];
+    size_t got;
+    while ((got = fread(buffer, 1, sizeof(buffer), file)) > 0) bytes.insert(bytes.end(), buffer, buffer + got);
+    fclose(file);
+
+    PulseTraceHeader header;
+    if (bytes.size() < sizeof(header)) return false;
+    memcpy(&header, bytes.data(), sizeof(header));
+    if (header.magic != PULSE_TRACE_MAGIC || header.version != PULSE_TRACE_VERSION ||
+        header.headerBytes != sizeof(header)) {
+        fprintf(stderr, "%s: not a version %d pulse trace\n", path, PULSE_TRACE_VERSION);
+        return false;
+    }
+    PulseReplay* pipeline = new PulseReplay();
+    pipeline->begin(header);
+    PulseTraceReader reader;
+    reader.setBuffer(bytes.data() + header.headerBytes, bytes.size() - header.headerBytes);
+    PulseTraceEvent event;
+    PulseReplaySecond second;
+    while (reader.next(event) && event.type != PULSE_TRACE_END) {
+        if (pipeline->feed(event, &second)) buckets.push_back(second.counts);
+    }
+    delete pipeline;
+    return true;
+}
+
+/**
+ * @brief Centred mean over @p window seconds (shorter at the ends).
+ */
+static std::vector<double> reference(const std::vector<uint32_t>& buckets, size_t window) {
+    std::vector<double> prefix(buckets.size() + 1, 0.0);
+    for (size_t i = 0; i < buckets.size(); i++) prefix[i + 1] = prefix[i] + buckets[i];
+    std::vector<double> ref(buckets.size());
+    for (size_t i = 0; i < buckets.size(); i++) {
+        size_t from = i >= window / 2 ? i - window / 2 : 0;
+        size_t to = i + window / 2 + 1 < buckets.size() ? i + window / 2 + 1 : buckets.size();
+        ref[i] = (prefix[to] - prefix[from]) / (to - from);
+    }
+    return ref;
+}
+
+struct Score {
+    double noise;        ///< Relative RMS deviation from the reference
+    double riseS;        ///< -1: never reached
+    double fallS;
+    double nsPerSecond;
+    double cyclesPerSecond;
+};
+
+/**
+ * @brief Noise on the plain buckets, rise and fall on the stepped ones.
+ */
+static Score score(RateEstimator& estimator, const std::vector<uint32_t>& plain, const std::vector<double>& ref,
+                   const std::vector<uint32_t>& stepped, size_t warmup, size_t stepAt, size_t stepFor,
+                   double stepCps) {
+    Score s = {0.0, -1.0, -1.0, 0.0, 0.0};
+    estimator.reset();
+    double squares = 0.0;
+    size_t n = 0;
+    for (size_t i = 0; i < plain.size(); i++) {
+        estimator.addSecond(plain[i]);
+        if (i < warmup || ref[i] <= 0.0) continue;
+        double d = (estimator.cps() - ref[i]) / ref[i];
+        squares += d * d;
+        n++;
+    }
+    s.noise = n ? sqrt(squares / n) : 0.0;
+
+    if (stepCps <= 0.0 || stepAt >= stepped.size()) return s;
+    estimator.reset();
+    size_t stepEnd = stepAt + stepFor;
+    for (size_t i = 0; i < stepped.size(); i++) {
+        estimator.addSecond(stepped[i]);
+        double base = ref[i];
+        if (i >= stepAt && i < stepEnd && s.riseS < 0.0 && estimator.cps() - base >= 0.9 * stepCps) {
+            s.riseS = (double)(i + 1 - stepAt);
+        }
+        if (i >= stepEnd && s.fallS < 0.0 && estimator.cps() - base <= 0.1 * stepCps) {
+            s.fallS = (double)(i + 1 - stepEnd);
+        }
+    }
+    return s;
+}
+
+/**
+ * @brief Time per closed second over @p runs passes.
+ */
+static void cost(RateEstimator& estimator, const std::vector<uint32_t>& buckets, int runs, Score& s) {
+    volatile float sink = 0.0f;
+    double start = nowSeconds();
+    uint64_t startCycles = cycles();
+    for (int run = 0; run < runs; run++) {
+        estimator.reset();
+        for (uint32_t counts : buckets) estimator.addSecond(counts);
+        sink = sink + estimator.cps();
+    }
+    double ticks = (double)buckets.size() * runs;
+    s.nsPerSecond = ticks ? (nowSeconds() - start) * 1e9 / ticks : 0.0;
+    s.cyclesPerSecond = ticks ? (double)(cycles() - startCycles) / ticks : 0.0;
+}
+
+int main(int argc, char** argv) {
+    std::vector<const char*> traces;
+    double cpm = 30.0;
+    double seconds = 3600.0;
+    double stepCps = 0.0;
+    double stepAt = -1.0;
+    double stepFor = 300.0;
+    double refWindow = 900.0;
+    double warmup = 300.0;
+    int runs = 20;
+    uint32_t seed = 1;
+    bool csv = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--csv")) {
+            csv = true;
+        } else if (!strcmp(argv[i], "--cpm") && i + 1 < argc) {
+            cpm = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--seconds") && i + 1 < argc) {
+            seconds = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--step-cps") && i + 1 < argc) {
+            stepCps = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--step-at") && i + 1 < argc) {
+            stepAt = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--step-for") && i + 1 < argc) {
+            stepFor = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--ref-window") && i + 1 < argc) {
+            refWindow = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--warmup") && i + 1 < argc) {
+            warmup = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--runs") && i + 1 < argc) {
+            runs = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--seed") && i + 1 < argc) {
+            seed = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (argv[i][0] != '-') {
+            traces.push_back(argv[i]);
+        } else {
+            usage(argv[0]);
+        }
+    }
+
+    std::vector<uint32_t> buckets;
+    std::mt19937 rng(seed);
+    if (traces.empty()) {
+        std::poisson_distribution<uint32_t> poisson(cpm / 60.0);
+        for (size_t i = 0; i < (size_t)seconds; i++) buckets.push_back(poisson(rng));
+    }
+    for (const char* path : traces) {
+        if (!readBuckets(path, buckets)) return 1;
+    }
+    if (buckets.empty()) {
+        fprintf(stderr, "No closed seconds to score\n");
+        return 1;
+    }
+
+    // The step is added to the recorded counts, so its size and timing are known exactly
+    size_t at = stepAt >= 0.0 ? (size_t)stepAt : buckets.size() / 2;
+    size_t length = (size_t)stepFor;
+    std::vector<uint32_t> stepped(buckets);
+    if (stepCps > 0.0) {
+        std::poisson_distribution<uint32_t> extra(stepCps);
+        for (size_t i = at; i < at + length && i < stepped.size(); i++) stepped[i] += extra(rng);
+    }
+    std::vector<double> ref = reference(buckets, (size_t)refWindow);
+
+    // The candidates, with the parameters of the device build
+    SlidingWindowEstimator window10(RATE_WINDOW_10S);
+    SlidingWindowEstimator window60(RATE_WINDOW_60S);
+    SlidingWindowEstimator window300(RATE_WINDOW_300S);
+    AdaptiveWindowEstimator adaptive;
+    EwmaEstimator ewma(RATE_ESTIMATOR_TAU_S);
+    BayesEstimator bayes(RATE_ESTIMATOR_TAU_S, 0.0f, 0.0f);
+    KalmanEstimator kalman(RATE_ESTIMATOR_KALMAN_DRIFT);
+    RateEstimator* estimators[] = {&window10, &window60, &window300, &adaptive, &ewma, &bayes, &kalman};
+    const size_t count = sizeof(estimators) / sizeof(estimators[0]);
+
+    if (csv) {
+        printf("second,counts,reference");
+        for (RateEstimator* e : estimators) printf(",%s", e->name());
+        printf("\n");
+        for (RateEstimator* e : estimators) e->reset();
+        for (size_t i = 0; i < stepped.size(); i++) {
+            printf("%zu,%u,%.4f", i, stepped[i], ref[i]);
+            for (RateEstimator* e : estimators) {
+                e->addSecond(stepped[i]);
+                printf(",%.4f", e->cps());
+            }
+            printf("\n");
+        }
+        return 0;
+    }
+
+    double total = 0.0;
+    for (uint32_t counts : buckets) total += counts;
+    printf("%zu s, mean %.2f CPM", buckets.size(), total * 60.0 / buckets.size());
+    if (stepCps > 0.0) printf(", step +%.2f cps at %zu s for %zu s", stepCps, at, length);
+    printf(", reference %.0f s centred mean\n", refWindow);
+    printf("%-12s %9s %8s %8s %10s %12s\n", "Estimator", "Noise %", "Rise s", "Fall s", "ns/second",
+           "cycles/second");
+    for (size_t i = 0; i < count; i++) {
+        Score s = score(*estimators[i], buckets, ref, stepped, (size_t)warmup, at, length, stepCps);
+        cost(*estimators[i], buckets, runs, s);
+        char rise[16], fall[16];
+        if (s.riseS < 0.0) strcpy(rise, "-");
+        else snprintf(rise, sizeof(rise), "%.0f", s.riseS);
+        if (s.fallS < 0.0) strcpy(fall, "-");
+        else snprintf(fall, sizeof(fall), "%.0f", s.fallS);
+        printf("%-12s %9.2f %8s %8s %10.1f %12.0f\n", estimators[i]->name(), s.noise * 100.0, rise, fall,
+               s.nsPerSecond, s.cyclesPerSecond);
+    }
+    return 0;
+}
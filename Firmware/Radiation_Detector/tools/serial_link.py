@@ -0,0 +1,142 @@
+#!/usr/bin/env python3
+"""Host side of the binary serial protocol (src/serial_link.h).
+
+Enables the requested streams and prints every frame as one line, e.g.
+    python3 tools/serial_link.py /dev/ttyACM0 --seconds --pulses
+    python3 tools/serial_link.py /dev/ttyACM0 --text "status"
+Text output of the device (command replies, debug log) is printed with a
+"# " prefix. Needs pyserial.
+"""
+import argparse
+import struct
+import sys
+
+import serial
+
+CMD_PING, CMD_STREAM, CMD_STATUS, CMD_TEXT = 0x01, 0x02, 0x03, 0x04
+MSG_HELLO, MSG_ACK, MSG_STATUS, MSG_SECOND, MSG_PULSES, MSG_SPECTRUM = range(0x81, 0x87)
+STREAM_SECONDS, STREAM_PULSES, STREAM_SPECTRUM = 1, 2, 4
+
+
+def crc16(data, crc=0xFFFF):
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_encode(data):
+    out = bytearray([0])
+    code_index, code = 0, 1
+    for byte in data:
+        if byte == 0:
+            out[code_index] = code
+            code_index, code = len(out), 1
+            out.append(0)
+            continue
+        out.append(byte)
+        code += 1
+        if code == 0xFF:
+            out[code_index] = code
+            code_index, code = len(out), 1
+            out.append(0)
+    out[code_index] = code
+    return bytes(out)
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            return None
+        out.extend(data[i + 1:i + code])
+        i += code
+        if code != 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def frame(kind, seq, payload=b""):
+    raw = bytes([kind, seq & 0xFF]) + payload
+    return b"\0" + cobs_encode(raw + struct.pack("<H", crc16(raw))) + b"\0"
+
+
+def parse(piece):
+    """Returns (type, sequence, payload) for a valid frame, else None."""
+    raw = cobs_decode(piece)
+    if raw is None or len(raw) < 4 or crc16(raw[:-2]) != struct.unpack("<H", raw[-2:])[0]:
+        return None
+    return raw[0], raw[1], raw[2:-2]
+
+
+def describe(kind, payload):
+    if kind == MSG_HELLO:
+        return "hello protocol %d streams %#x firmware %s" % (payload[0], payload[1], payload[2:].decode(errors="replace"))
+    if kind == MSG_ACK:
+        return "ack %#04x %s" % (payload[0], "ok" if payload[1] else "rejected")
+    if kind == MSG_STATUS:
+        up, total, cpm, usv, msv, alarm = struct.unpack("<IIfffB", payload)
+        return "status up %d s, %d counts, %.1f cpm, %.3f uSv/h, %.4f mSv, alarm %d" % (up, total, cpm, usv, msv, alarm)
+    if kind == MSG_SECOND:
+        return "second %d counts %d total %d pulses dropped %d" % struct.unpack("<IIII", payload)
+    if kind == MSG_PULSES:
+        stamps = struct.unpack("<%dI" % (len(payload) // 4), payload)
+        return "pulses %d: %s" % (len(stamps), " ".join(str(t) for t in stamps))
+    if kind == MSG_SPECTRUM:
+        first, channels, live_ms, total = struct.unpack_from("<HHII", payload)
+        counts = struct.unpack_from("<%dI" % ((len(payload) - 12) // 4), payload, 12)
+        return "spectrum %d..%d of %d live %d ms total %d: %s" % (
+            first, first + len(counts) - 1, channels, live_ms, total, " ".join(str(c) for c in counts))
+    return "frame %#04x %s" % (kind, payload.hex())
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("port")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--seconds", action="store_true", help="per-second counts")
+    parser.add_argument("--pulses", action="store_true", help="per-pulse timestamps")
+    parser.add_argument("--spectrum", action="store_true", help="spectrum snapshots")
+    parser.add_argument("--text", help="run one text command through a TEXT frame")
+    args = parser.parse_args()
+
+    mask = (STREAM_SECONDS if args.seconds else 0) | (STREAM_PULSES if args.pulses else 0) | \
+        (STREAM_SPECTRUM if args.spectrum else 0)
+    port = serial.Serial(args.port, args.baud, timeout=0.1)
+    seq = 0
+    port.write(frame(CMD_PING, seq))
+    port.write(frame(CMD_STREAM, seq + 1, bytes([mask])))
+    if args.text:
+        port.write(frame(CMD_TEXT, seq + 2, args.text.encode()))
+
+    expected = None
+    pending = b""
+    try:
+        while True:
+            pending += port.read(4096)
+            *pieces, pending = pending.split(b"\0")
+            for piece in pieces:
+                if not piece:
+                    continue
+                parsed = parse(piece)
+                if parsed is None:
+                    for line in piece.decode(errors="replace").splitlines():
+                        if line.strip():
+                            print("# " + line)
+                    continue
+                kind, sequence, payload = parsed
+                if expected is not None and sequence != expected:
+                    print("# %d frames lost" % ((sequence - expected) & 0xFF))
+                expected = (sequence + 1) & 0xFF
+                print(describe(kind, payload))
+            sys.stdout.flush()
+    except KeyboardInterrupt:
+        port.write(frame(CMD_STREAM, seq + 3, b"\0"))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,425 @@
+#!/usr/bin/env python3
+"""Regenerate src/ui_font_*.c with only the glyphs the firmware draws.
+
+SquareLine exports its fonts with the whole printable ASCII range
+(lv_font_conv -r 0x20-0x7f --no-compress --no-prefilter), but the labels
+using them only ever show numbers, a few signs and a unit. This keeps those
+glyphs and stores them with LVGL's font compression (RLE, optionally with the
+XOR line prefilter) whenever that is smaller than the plain bitmaps; compressed
+fonts need LV_USE_FONT_COMPRESSED in lv_conf.h.
+
+Run after exporting the fonts from SquareLine or changing SYMBOLS:
+    python3 tools/subset_font.py
+The full exports in "User Interface/SquareLineFiles/assets" are the input.
+Rendering the same subset straight from the TTF is equivalent to
+    lv_font_conv --bpp 1 --size 60 --font VCR_OSD_MONO.ttf --symbols " -.0123456789" \\
+                 --format lvgl -o ui_font_Pixel_60.c
+"""
+import os
+import re
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+ASSETS = os.path.join(ROOT, "..", "..", "User Interface", "SquareLineFiles", "assets")
+DST = os.path.join(ROOT, "src")
+
+# Characters each font has to render; keep in sync with the labels using them
+SYMBOLS = {
+    "ui_font_Pixel": " +-.0123456789V",      # Average / maximum dose rate, voltages, +/- buttons
+    "ui_font_Pixel_20": " -.0123456789",     # Cumulative dose, alarm thresholds
+    "ui_font_Pixel_60": " -.0123456789",     # Current dose rate (digit sprites, see digit_sprites.h)
+    "ui_font_SonicSaber": " ARST",           # "START"
+}
+
+FORMAT_PLAIN = 0
+FORMAT_COMPRESSED = 1              # RLE with the XOR line prefilter
+FORMAT_COMPRESSED_NO_PREFILTER = 2
+FORMAT_NAMES = {
+    FORMAT_PLAIN: "plain",
+    FORMAT_COMPRESSED: "compressed",
+    FORMAT_COMPRESSED_NO_PREFILTER: "compressed, no prefilter",
+}
+
+
+def field(text, name):
+    m = re.search(r"\.%s\s*=\s*(-?\d+)" % name, text)
+    if not m:
+        raise ValueError("no .%s in font" % name)
+    return int(m.group(1))
+
+
+def parse(path):
+    with open(path) as f:
+        text = f.read()
+
+    header = text[:text.index("*/") + 2]
+    bpp = int(re.search(r"\* Bpp: (\d+)", header).group(1))
+    size = int(re.search(r"\* Size: (\d+)", header).group(1))
+    if re.search(r"\.kern_classes = 1", text) or re.search(r"\.glyph_ids_size = 1", text):
+        raise ValueError("%s: only 8-bit kerning pairs are supported" % path)
+    if field(text, "bitmap_format") != FORMAT_PLAIN:
+        raise ValueError("%s: input must be an uncompressed export" % path)
+
+    bitmap_src = text[text.index("glyph_bitmap[] = {"):text.index("};", text.index("glyph_bitmap[] = {"))]
+    bitmaps = {}
+    for m in re.finditer(r"/\* U\+([0-9A-F]+) .*?\*/([^/]*)", bitmap_src):
+        bitmaps[int(m.group(1), 16)] = bytes(int(v, 16) for v in re.findall(r"0x[0-9a-f]+", m.group(2)))
+
+    dsc_src = text[text.index("glyph_dsc[] = {"):text.index("};", text.index("glyph_dsc[] = {"))]
+    glyphs = []
+    for m in re.finditer(r"\{\.bitmap_index = (\d+), \.adv_w = (\d+), \.box_w = (\d+), \.box_h = (\d+), "
+                         r"\.ofs_x = (-?\d+), \.ofs_y = (-?\d+)\}", dsc_src):
+        glyphs.append(tuple(int(v) for v in m.groups()))
+
+    cmaps = re.findall(r"\.range_start = (\d+), \.range_length = (\d+), \.glyph_id_start = (\d+),\s*"
+                       r"\.unicode_list = NULL, \.glyph_id_ofs_list = NULL", text)
+    if len(cmaps) != field(text, "cmap_num"):
+        raise ValueError("%s: only FORMAT0_TINY character maps are supported" % path)
+    font = {
+        "bpp": bpp,
+        "size": size,
+        "line_height": field(text, "line_height"),
+        "base_line": field(text, "base_line"),
+        "underline_position": field(text, "underline_position"),
+        "underline_thickness": field(text, "underline_thickness"),
+        "kern_scale": field(text, "kern_scale"),
+        "glyphs": {},
+        "kerning": {},
+    }
+    codes = {}
+    for start, length, first_id in cmaps:
+        for i in range(int(length)):
+            code = int(start) + i
+            codes[int(first_id) + i] = code
+            index, adv_w, box_w, box_h, ofs_x, ofs_y = glyphs[int(first_id) + i]
+            font["glyphs"][code] = {
+                "adv_w": adv_w, "box_w": box_w, "box_h": box_h, "ofs_x": ofs_x, "ofs_y": ofs_y,
+                "bitmap": bitmaps[code],
+            }
+    if "kern_pair_glyph_ids[] =" in text:
+        ids = re.findall(r"\d+", text[text.index("kern_pair_glyph_ids[] ="):].split("};")[0].split("=", 1)[1])
+        values = re.findall(r"-?\d+", text[text.index("kern_pair_values[] ="):].split("};")[0].split("=", 1)[1])
+        for n, value in enumerate(values):
+            pair = (codes[int(ids[2 * n])], codes[int(ids[2 * n + 1])])
+            font["kerning"][pair] = int(value)
+    return font
+
+
+def unpack(bitmap, bpp, w, h):
+    """Pixel values of a glyph, row by row (rows are not byte aligned)."""
+    pixels = []
+    for i in range(w * h):
+        bit = i * bpp
+        pixels.append((bitmap[bit >> 3] >> (8 - (bit & 7) - bpp)) & ((1 << bpp) - 1))
+    return pixels
+
+
+class BitWriter:
+    def __init__(self):
+        self.bits = []
+
+    def write(self, value, length):
+        for i in range(length - 1, -1, -1):
+            self.bits.append((value >> i) & 1)
+
+    def bytes(self):
+        bits = self.bits + [0] * (-len(self.bits) % 8)
+        return bytes(int("".join(map(str, bits[i:i + 8])), 2) for i in range(0, len(bits), 8))
+
+
+def rle(pixels, bpp):
+    """Encode for the decoder in lvgl/src/font/lv_font_fmt_txt.c (rle_next).
+
+    A value equal to the value before it starts a repeat: every further copy
+    costs a 1 bit, and the 11th one is followed by a 6-bit count of the rest
+    of the run. A 0 bit (or the count running out) is followed by the next
+    value. The encoder walks the decoder's states pixel by pixel.
+    """
+    out = BitWriter()
+    n = len(pixels)
+    i = 0
+    prev = None
+    repeat = False
+    count = 0
+    while i < n:
+        if not repeat:
+            out.write(pixels[i], bpp)
+            repeat = i > 0 and pixels[i] == prev
+            count = 0
+            prev = pixels[i]
+            i += 1
+            continue
+        count += 1
+        if pixels[i] != prev:
+            out.write(0, 1)
+            out.write(pixels[i], bpp)
+            prev = pixels[i]
+            i += 1
+            repeat = False
+            continue
+        out.write(1, 1)
+        i += 1
+        if count == 11:
+            run = 0
+            while i + run < n and pixels[i + run] == prev:
+                run += 1
+            counter = min(run + 1, 63)
+            out.write(counter, 6)
+            # counter - 1 more copies, then an explicit value if a pixel is left
+            i += counter - 1
+            if i < n:
+                out.write(pixels[i], bpp)
+                prev = pixels[i]
+                i += 1
+            repeat = False
+    return out.bytes()
+
+
+def encode(glyph, bpp, fmt):
+    if fmt == FORMAT_PLAIN:
+        return glyph["bitmap"]
+    w, h = glyph["box_w"], glyph["box_h"]
+    pixels = unpack(glyph["bitmap"], bpp, w, h)
+    if fmt == FORMAT_COMPRESSED:
+        pixels = pixels[:w] + [pixels[i] ^ pixels[i - w] for i in range(w, w * h)]
+    return rle(pixels, bpp)
+
+
+def escape(code):
+    c = chr(code)
+    return "\\" + c if c in "\\\"" else c
+
+
+def cmap_ranges(codes):
+    """Consecutive runs of code points, each a FORMAT0_TINY map."""
+    ranges = []
+    for code in codes:
+        if ranges and code == ranges[-1][0] + ranges[-1][1]:
+            ranges[-1][1] += 1
+        else:
+            ranges.append([code, 1])
+    return ranges
+
+
+def generate(name, font, symbols, fmt, bitmaps):
+    guard = name.upper()
+    codes = sorted(font["glyphs"])
+    ranges = cmap_ranges(codes)
+    lines = [
+        "/*******************************************************************************",
+        " * Size: %d px" % font["size"],
+        " * Bpp: %d" % font["bpp"],
+        " * Generated by tools/subset_font.py from the SquareLine export - do not edit.",
+        " * Symbols: %s" % symbols,
+        " * Bitmaps: %s" % FORMAT_NAMES[fmt],
+        " ******************************************************************************/",
+        "",
+        "#include \"ui.h\"",
+        "",
+        "#ifndef %s" % guard,
+        "#define %s 1" % guard,
+        "#endif",
+        "",
+        "#if %s" % guard,
+        "",
+        "/*-----------------",
+        " *    BITMAPS",
+        " *----------------*/",
+        "",
+        "/*Store the image of the glyphs*/",
+        "static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {",
+    ]
+    index = 0
+    indices = {}
+    for n, code in enumerate(codes):
+        data = bitmaps[code]
+        indices[code] = index
+        index += len(data)
+        lines.append("    /* U+%04X \"%s\" */" % (code, escape(code)))
+        for i in range(0, len(data), 8):
+            lines.append("    " + ", ".join("0x%x" % b for b in data[i:i + 8]) + ",")
+        if n + 1 < len(codes):
+            lines.append("")
+    if fmt != FORMAT_PLAIN:
+        # rle_next() reads bit fields as 16-bit words, one byte past the last glyph
+        lines += ["", "    /* decoder read-ahead */", "    0x0"]
+    else:
+        lines[-1] = lines[-1].rstrip(",")
+    lines += [
+        "};",
+        "",
+        "",
+        "/*---------------------",
+        " *  GLYPH DESCRIPTION",
+        " *--------------------*/",
+        "",
+        "static const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {",
+        "    {.bitmap_index = 0, .adv_w = 0, .box_w = 0, .box_h = 0, .ofs_x = 0, .ofs_y = 0} /* id = 0 reserved */,",
+    ]
+    for n, code in enumerate(codes):
+        g = font["glyphs"][code]
+        lines.append("    {.bitmap_index = %d, .adv_w = %d, .box_w = %d, .box_h = %d, .ofs_x = %d, .ofs_y = %d}%s"
+                     % (indices[code], g["adv_w"], g["box_w"], g["box_h"], g["ofs_x"], g["ofs_y"],
+                        "," if n + 1 < len(codes) else ""))
+    lines += [
+        "};",
+        "",
+        "/*---------------------",
+        " *  CHARACTER MAPPING",
+        " *--------------------*/",
+        "",
+        "",
+        "",
+        "/*Collect the unicode lists and glyph_id offsets*/",
+        "static const lv_font_fmt_txt_cmap_t cmaps[] =",
+        "{",
+    ]
+    glyph_id = 1
+    for n, (start, length) in enumerate(ranges):
+        lines += [
+            "    {",
+            "        .range_start = %d, .range_length = %d, .glyph_id_start = %d," % (start, length, glyph_id),
+            "        .unicode_list = NULL, .glyph_id_ofs_list = NULL, .list_length = 0, "
+            ".type = LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY",
+            "    }" + ("," if n + 1 < len(ranges) else ""),
+        ]
+        glyph_id += length
+    lines.append("};")
+    ids = {code: n + 1 for n, code in enumerate(codes)}
+    pairs = sorted((ids[l], ids[r], v) for (l, r), v in font["kerning"].items() if l in ids and r in ids)
+    if pairs:
+        lines += [
+            "",
+            "",
+            "/*-----------------",
+            " *    KERNING",
+            " *----------------*/",
+            "",
+            "",
+            "/*Pair left and right glyphs for kerning*/",
+            "static const uint8_t kern_pair_glyph_ids[] =",
+            "{",
+        ]
+        lines += ["    %d, %d%s" % (l, r, "," if n + 1 < len(pairs) else "") for n, (l, r, v) in enumerate(pairs)]
+        lines += [
+            "};",
+            "",
+            "/* Kerning between the respective left and right glyphs",
+            " * 4.4 format which needs to scaled with `kern_scale`*/",
+            "static const int8_t kern_pair_values[] =",
+            "{",
+        ]
+        values = [str(v) for l, r, v in pairs]
+        for i in range(0, len(values), 8):
+            lines.append("    " + ", ".join(values[i:i + 8]) + ("," if i + 8 < len(values) else ""))
+        lines += [
+            "};",
+            "",
+            "/*Collect the kern pair's data in one place*/",
+            "static const lv_font_fmt_txt_kern_pair_t kern_pairs =",
+            "{",
+            "    .glyph_ids = kern_pair_glyph_ids,",
+            "    .values = kern_pair_values,",
+            "    .pair_cnt = %d," % len(pairs),
+            "    .glyph_ids_size = 0",
+            "};",
+        ]
+    lines += [
+        "",
+        "",
+        "",
+        "/*--------------------",
+        " *  ALL CUSTOM DATA",
+        " *--------------------*/",
+        "",
+        "#if LVGL_VERSION_MAJOR == 8",
+        "/*Store all the custom data of the font*/",
+        "static  lv_font_fmt_txt_glyph_cache_t cache;",
+        "#endif",
+        "",
+        "#if LVGL_VERSION_MAJOR >= 8",
+        "static const lv_font_fmt_txt_dsc_t font_dsc = {",
+        "#else",
+        "static lv_font_fmt_txt_dsc_t font_dsc = {",
+        "#endif",
+        "    .glyph_bitmap = glyph_bitmap,",
+        "    .glyph_dsc = glyph_dsc,",
+        "    .cmaps = cmaps,",
+        "    .kern_dsc = %s," % ("&kern_pairs" if pairs else "NULL"),
+        "    .kern_scale = %d," % (font["kern_scale"] if pairs else 0),
+        "    .cmap_num = %d," % len(ranges),
+        "    .bpp = %d," % font["bpp"],
+        "    .kern_classes = 0,",
+        "    .bitmap_format = %d," % fmt,
+        "#if LVGL_VERSION_MAJOR == 8",
+        "    .cache = &cache",
+        "#endif",
+        "};",
+        "",
+        "",
+        "",
+        "/*-----------------",
+        " *  PUBLIC FONT",
+        " *----------------*/",
+        "",
+        "/*Initialize a public general font descriptor*/",
+        "#if LVGL_VERSION_MAJOR >= 8",
+        "const lv_font_t %s = {" % name,
+        "#else",
+        "lv_font_t %s = {" % name,
+        "#endif",
+        "    .get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt,    /*Function pointer to get glyph's data*/",
+        "    .get_glyph_bitmap = lv_font_get_bitmap_fmt_txt,    /*Function pointer to get glyph's bitmap*/",
+        "    .line_height = %d,          /*The maximum line height required by the font*/" % font["line_height"],
+        "    .base_line = %d,             /*Baseline measured from the bottom of the line*/" % font["base_line"],
+        "#if !(LVGL_VERSION_MAJOR == 6 && LVGL_VERSION_MINOR == 0)",
+        "    .subpx = LV_FONT_SUBPX_NONE,",
+        "#endif",
+        "#if LV_VERSION_CHECK(7, 4, 0) || LVGL_VERSION_MAJOR >= 8",
+        "    .underline_position = %d," % font["underline_position"],
+        "    .underline_thickness = %d," % font["underline_thickness"],
+        "#endif",
+        "    .dsc = &font_dsc,          /*The custom font data. Will be accessed by `get_glyph_bitmap/dsc` */",
+        "#if LV_VERSION_CHECK(8, 2, 0) || LVGL_VERSION_MAJOR >= 9",
+        "    .fallback = NULL,",
+        "#endif",
+        "    .user_data = NULL,",
+        "};",
+        "",
+        "",
+        "",
+        "#endif /*#if %s*/" % guard,
+        "",
+    ]
+    return "\n".join(lines)
+
+
+def main():
+    for name, symbols in sorted(SYMBOLS.items()):
+        src = os.path.join(ASSETS, name + ".c")
+        font = parse(src)
+        full = sum(len(g["bitmap"]) for g in font["glyphs"].values())
+        missing = [c for c in symbols if ord(c) not in font["glyphs"]]
+        if missing:
+            raise ValueError("%s has no glyph for %r" % (name, "".join(missing)))
+        font["glyphs"] = {ord(c): font["glyphs"][ord(c)] for c in symbols}
+
+        formats = [FORMAT_PLAIN]
+        if font["bpp"] in (1, 2, 4):
+            formats += [FORMAT_COMPRESSED, FORMAT_COMPRESSED_NO_PREFILTER]
+        best = None
+        for fmt in formats:
+            bitmaps = {code: encode(g, font["bpp"], fmt) for code, g in font["glyphs"].items()}
+            size = sum(len(b) for b in bitmaps.values())
+            if best is None or size < best[1]:
+                best = (fmt, size, bitmaps)
+        fmt, size, bitmaps = best
+
+        dst = os.path.join(DST, name + ".c")
+        with open(dst, "w") as f:
+            f.write(generate(name, font, symbols, fmt, bitmaps))
+        print("%s: %d -> %d glyphs, %d -> %d bitmap bytes (%s)" % (
+            os.path.relpath(dst, ROOT), len(parse(src)["glyphs"]), len(symbols), full, size, FORMAT_NAMES[fmt]))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+"""Convert a firmware event trace dump into Chrome trace JSON (opens in Perfetto).
+
+Capture the dump over serial ("trace dump", the log may contain other lines)
+or over HTTP, then convert it:
+    curl http://radscan-XXXXXX.local/api/trace > trace.txt
+    python3 tools/trace_to_perfetto.py trace.txt trace.json
+and open trace.json in https://ui.perfetto.dev or chrome://tracing.
+The dump format is described in src/trace.cpp.
+"""
+import json
+import sys
+
+WRAP = 1 << 32
+
+
+def parse(lines):
+    mhz = 240
+    syncs = {}
+    names = {}
+    events = []
+    for line in lines:
+        parts = line.split()
+        if not parts:
+            continue
+        if parts[0] == "#":
+            if len(parts) >= 3 and parts[1] == "mhz":
+                mhz = int(parts[2])
+            elif len(parts) >= 5 and parts[1] == "sync":
+                syncs[int(parts[2])] = (int(parts[3]), int(parts[4]))
+            elif len(parts) >= 5 and parts[1] == "event":
+                names[int(parts[2])] = (parts[3], parts[4])
+            continue
+        if len(parts) != 5 or not all(p.isdigit() for p in parts):
+            continue  # Unrelated serial output
+        core, cycles, event_id, arg0, arg1 = (int(p) for p in parts)
+        events.append((core, cycles, event_id, arg0, arg1))
+    return mhz, syncs, names, events
+
+
+def timestamps(mhz, syncs, events):
+    """Microsecond esp_timer time of each event, unwrapping each core's counter backwards from its sync."""
+    times = [None] * len(events)
+    for core, (sync_cycles, sync_us) in syncs.items():
+        later = sync_cycles
+        back = 0
+        for i in range(len(events) - 1, -1, -1):
+            if events[i][0] != core:
+                continue
+            back += (later - events[i][1]) % WRAP
+            later = events[i][1]
+            times[i] = sync_us - back / float(mhz)
+    return times
+
+
+def convert(mhz, syncs, names, events):
+    times = timestamps(mhz, syncs, events)
+    out = []
+    for core in sorted(syncs):
+        out.append({"name": "thread_name", "ph": "M", "pid": 1, "tid": core,
+                    "args": {"name": "core %d" % core}})
+    open_spans = set()
+    order = sorted((t, i) for i, t in enumerate(times) if t is not None)
+    for ts, i in order:
+        core, _, event_id, arg0, arg1 = events[i]
+        phase, name = names.get(event_id, ("i", "event_%d" % event_id))
+        record = {"name": name, "ph": phase, "ts": round(ts, 3), "pid": 1, "tid": core}
+        if phase == "B":
+            open_spans.add((core, name))
+        elif phase == "E":
+            if (core, name) not in open_spans:
+                continue  # Its begin fell out of the ring
+            open_spans.discard((core, name))
+            record["args"] = {"arg0": arg0, "arg1": arg1}
+        elif phase == "C":
+            record["args"] = {name: arg0}
+        else:
+            record["ph"] = "i"
+            record["s"] = "t"
+            record["args"] = {"arg0": arg0, "arg1": arg1}
+        out.append(record)
+    return {"traceEvents": out, "displayTimeUnit": "ms"}
+
+
+def main():
+    if len(sys.argv) != 3:
+        print("usage: %s <dump.txt> <trace.json>" % sys.argv[0])
+        return 1
+    with open(sys.argv[1]) as f:
+        mhz, syncs, names, events = parse(f)
+    if not syncs:
+        print("no '# sync' lines: not a trace dump")
+        return 1
+    trace = convert(mhz, syncs, names, events)
+    with open(sys.argv[2], "w") as f:
+        json.dump(trace, f)
+    print("%d events -> %s" % (len(events), sys.argv[2]))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
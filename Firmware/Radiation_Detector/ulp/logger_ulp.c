@@ -0,0 +1,74 @@
+/**
+ * @file logger_ulp.c
+ * @brief ULP RISC-V program of logger mode (src/logger_mode.h): counts tube
+ *        pulses while the main cores are in deep sleep.
+ *
+ * Built for the ULP, not the main cores; ESP-IDF embeds it with
+ *     ulp_embed_binary(ulp_logger "../ulp/logger_ulp.c" "logger_mode.cpp")
+ * which also generates ulp_logger.h, the main program's view of the globals
+ * below (ulp_<name>).
+ *
+ * The program never halts: it polls the pulse input, counts rising edges and
+ * closes an interval every cycles_per_interval ULP cycles into a ring. The
+ * main program reads the ring from `tail` to `head` and advances `tail`; the
+ * ULP only writes `head` after the slot, so the two never race. The main
+ * cores are woken once wake_intervals closed intervals are waiting, and right
+ * away when the open interval reaches alarm_counts.
+ */
+
+#include <stdint.h>
+#include "ulp_riscv.h"
+#include "ulp_riscv_utils.h"
+#include "ulp_riscv_gpio.h"
+
+#define RING_SIZE 128 /* LOGGER_ULP_RING; checked by logger_mode.cpp */
+
+/* Set by the main program before the ULP starts */
+volatile uint32_t pulse_gpio;
+volatile uint32_t cycles_per_interval;
+volatile uint32_t wake_intervals;
+volatile uint32_t alarm_counts;        /* 0: no alarm wake */
+
+/* Shared */
+volatile uint32_t ring[RING_SIZE];
+volatile uint32_t head;                /* Intervals closed; written by the ULP */
+volatile uint32_t tail;                /* Intervals read; written by the main program */
+volatile uint32_t current;             /* Counts in the open interval */
+volatile uint32_t overflows;           /* Intervals dropped with the ring full */
+volatile uint32_t alarm;               /* Set with the alarm wake, cleared by the main program */
+
+int main(void)
+{
+    ulp_riscv_gpio_init((gpio_num_t)pulse_gpio);
+    ulp_riscv_gpio_input_enable((gpio_num_t)pulse_gpio);
+
+    uint32_t last = ulp_riscv_gpio_get_level((gpio_num_t)pulse_gpio);
+    uint32_t start = ULP_RISCV_GET_CCOUNT();
+    for (;;) {
+        uint32_t level = ulp_riscv_gpio_get_level((gpio_num_t)pulse_gpio);
+        if (level && !last) {
+            current++;
+            if (alarm_counts && current >= alarm_counts && !alarm) {
+                alarm = 1;
+                ulp_riscv_wakeup_main_processor();
+            }
+        }
+        last = level;
+
+        if (ULP_RISCV_GET_CCOUNT() - start >= cycles_per_interval) {
+            start += cycles_per_interval;
+            uint32_t waiting = head - tail;
+            if (waiting >= RING_SIZE) {
+                overflows++;
+            } else {
+                ring[head % RING_SIZE] = current;
+                head++;
+                waiting++;
+            }
+            current = 0;
+            /* Once per batch; the main program drains it before the next one */
+            if (waiting == wake_intervals) ulp_riscv_wakeup_main_processor();
+        }
+    }
+    return 0;
+}